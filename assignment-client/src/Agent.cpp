@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
+#include <QtCore/QJsonObject>
 #include <QtCore/QStandardPaths>
 #include <QtNetwork/QNetworkDiskCache>
 #include <QtNetwork/QNetworkRequest>
@@ -26,6 +27,7 @@
 #include <MessagesClient.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
+#include <PathUtils.h>
 #include <udt/PacketHeaders.h>
 #include <ResourceCache.h>
 #include <ScriptCache.h>
@@ -62,6 +64,8 @@ Agent::Agent(ReceivedMessage& message) :
 
     DependencyManager::set<ResourceCacheSharedItems>();
     DependencyManager::set<SoundCache>();
+    // every agent on this host shares the decoded sounds, and the pages they map
+    DependencyManager::get<SoundCache>()->setDecodedSoundCacheDirectory(PathUtils::getAppLocalDataFilePath("decoded-sounds"));
     DependencyManager::set<AudioScriptingInterface>();
     DependencyManager::set<AudioInjectorManager>();
     DependencyManager::set<recording::Deck>();
@@ -106,7 +110,7 @@ void Agent::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNo
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
             int piggyBackedSizeWithHeader = message->getSize() - statsMessageLength;
 
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
@@ -330,7 +334,6 @@ void Agent::executeScript() {
     // setup an Avatar for the script to use
     auto scriptedAvatar = DependencyManager::get<ScriptableAvatar>();
 
-    connect(_scriptEngine.get(), SIGNAL(update(float)), scriptedAvatar.data(), SLOT(update(float)), Qt::ConnectionType::QueuedConnection);
     scriptedAvatar->setForceFaceTrackerConnected(true);
 
     // call model URL setters with empty URLs so our avatar, if user, will have the default models
@@ -441,25 +444,15 @@ void Agent::executeScript() {
 
     DependencyManager::set<AssignmentParentFinder>(_entityViewer.getTree());
 
-    // 100Hz timer for audio
+    // 100Hz timer for the avatar's ticks
     AvatarAudioTimer* audioTimerWorker = new AvatarAudioTimer();
     audioTimerWorker->moveToThread(&_avatarAudioTimerThread);
-    connect(audioTimerWorker, &AvatarAudioTimer::avatarTick, this, &Agent::processAgentAvatarAudio);
+    connect(audioTimerWorker, &AvatarAudioTimer::avatarTick, this, &Agent::processAgentTick);
     connect(this, &Agent::startAvatarAudioTimer, audioTimerWorker, &AvatarAudioTimer::start);
-    connect(this, &Agent::stopAvatarAudioTimer, audioTimerWorker, &AvatarAudioTimer::stop);
+    connect(this, &Agent::stopAvatarAudioTimer, audioTimerWorker, &AvatarAudioTimer::stop, Qt::DirectConnection);
     connect(&_avatarAudioTimerThread, &QThread::finished, audioTimerWorker, &QObject::deleteLater);
     _avatarAudioTimerThread.start();
 
-    // Agents should run at 45hz
-    static const int AVATAR_DATA_HZ = 45;
-    static const int AVATAR_DATA_IN_MSECS = MSECS_PER_SECOND / AVATAR_DATA_HZ;
-    QTimer* avatarDataTimer = new QTimer(this);
-    connect(avatarDataTimer, &QTimer::timeout, this, &Agent::processAgentAvatar);
-    avatarDataTimer->setSingleShot(false);
-    avatarDataTimer->setInterval(AVATAR_DATA_IN_MSECS);
-    avatarDataTimer->setTimerType(Qt::PreciseTimer);
-    avatarDataTimer->start();
-
     _scriptEngine->run();
 
     Frame::clearFrameHandler(AUDIO_FRAME_TYPE);
@@ -524,7 +517,8 @@ void Agent::setIsAvatar(bool isAvatar) {
         // start the timers
         _avatarIdentityTimer->start(AVATAR_IDENTITY_PACKET_SEND_INTERVAL_MSECS);
 
-        // tell the avatarAudioTimer to start ticking
+        // tell the avatarAudioTimer to start ticking, on a new schedule
+        _tickStartTime = 0;
         emit startAvatarAudioTimer();
 
     }
@@ -565,6 +559,94 @@ void Agent::sendAvatarIdentityPacket() {
     }
 }
 
+// An avatar's tick is a fixed 10ms step: its animation and avatar data, when a 45Hz avatar frame is due, then its
+// audio. The ticks are kept on the schedule they started on, rather than on when the timer's signals get here, so a
+// script holding up this thread doesn't make the avatar drift: the ticks due since are run together, up to a limit.
+static const quint64 AGENT_TICK_USECS = AudioConstants::NETWORK_FRAME_USECS;
+static const int AVATAR_DATA_HZ = 45;
+static const quint64 AVATAR_FRAME_USECS = USECS_PER_SECOND / AVATAR_DATA_HZ;
+static const int MAX_BATCHED_TICKS = 10; // 100ms, later than which audio may as well be dropped
+
+void Agent::processAgentTick() {
+    quint64 now = usecTimestampNow();
+    if (_tickStartTime == 0) {
+        _tickStartTime = now;
+        _numTicks = 0;
+        _lastAvatarFrameTime = now;
+        _nextAvatarFrameTime = now;
+    }
+
+    // signals queued up behind a busy script find their ticks already run
+    quint64 numDueTicks = (now - _tickStartTime) / AGENT_TICK_USECS + 1;
+    if (numDueTicks <= _numTicks) {
+        return;
+    }
+    quint64 numTicks = numDueTicks - _numTicks;
+    if (numTicks > MAX_BATCHED_TICKS) {
+        _tickStats.numDroppedTicks += (int)(numTicks - MAX_BATCHED_TICKS);
+        _numTicks += numTicks - MAX_BATCHED_TICKS;
+        numTicks = MAX_BATCHED_TICKS;
+    }
+    _tickStats.numTicks += (int)numTicks;
+    _tickStats.numBatchedTicks += (int)numTicks - 1;
+
+    // of the ticks run together, the last due an avatar frame has it, as the others would only be sent over
+    quint64 lastTickTime = _tickStartTime + (_numTicks + numTicks - 1) * AGENT_TICK_USECS;
+    bool isAvatarFrameDue = lastTickTime >= _nextAvatarFrameTime;
+
+    for (quint64 i = 0; i < numTicks; i++) {
+        quint64 tickTime = _tickStartTime + _numTicks * AGENT_TICK_USECS;
+        _numTicks++;
+
+        if (isAvatarFrameDue && i == numTicks - 1) {
+            while (_nextAvatarFrameTime <= tickTime) {
+                _nextAvatarFrameTime += AVATAR_FRAME_USECS;
+            }
+
+            quint64 stageStart = usecTimestampNow();
+            auto scriptedAvatar = DependencyManager::get<ScriptableAvatar>();
+            scriptedAvatar->update((float)(tickTime - _lastAvatarFrameTime) / (float)USECS_PER_SECOND);
+            _lastAvatarFrameTime = tickTime;
+
+            quint64 stageEnd = usecTimestampNow();
+            _tickStats.avatarUpdateUsecs += stageEnd - stageStart;
+
+            processAgentAvatar();
+            _tickStats.avatarDataUsecs += usecTimestampNow() - stageEnd;
+            _tickStats.numAvatarFrames++;
+        }
+
+        quint64 stageStart = usecTimestampNow();
+        processAgentAvatarAudio();
+        _tickStats.audioUsecs += usecTimestampNow() - stageStart;
+    }
+}
+
+void Agent::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    if (_tickStats.numTicks > 0) {
+        QJsonObject tickStats;
+        tickStats["ticks"] = _tickStats.numTicks;
+        tickStats["batched_ticks"] = _tickStats.numBatchedTicks;
+        tickStats["dropped_ticks"] = _tickStats.numDroppedTicks;
+        tickStats["avatar_frames"] = _tickStats.numAvatarFrames;
+        if (_tickStats.numAvatarFrames > 0) {
+            tickStats["avg_avatar_update_usecs"] = (double)_tickStats.avatarUpdateUsecs / _tickStats.numAvatarFrames;
+            tickStats["avg_avatar_data_usecs"] = (double)_tickStats.avatarDataUsecs / _tickStats.numAvatarFrames;
+        }
+        tickStats["avg_audio_usecs"] = (double)_tickStats.audioUsecs / _tickStats.numTicks;
+        statsObject["avatar_ticks"] = tickStats;
+    }
+    _tickStats = TickStats();
+
+    if (_scriptEngine) {
+        statsObject["script_memory"] = QJsonObject::fromVariantMap(_scriptEngine->getMemoryStats());
+    }
+
+    addPacketStatsAndSendStatsPacket(statsObject);
+}
+
 void Agent::processAgentAvatar() {
     if (!_scriptEngine->isFinished() && _isAvatar) {
         auto scriptedAvatar = DependencyManager::get<ScriptableAvatar>();
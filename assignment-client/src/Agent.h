@@ -65,6 +65,7 @@ public:
 public slots:
     void run() override;
     void playAvatarSound(SharedSoundPointer avatarSound);
+    void sendStatsPacket() override;
 
 private slots:
     void requestScript();
@@ -78,8 +79,7 @@ private slots:
 
     void nodeActivated(SharedNodePointer activatedNode);
 
-    void processAgentAvatar();
-    void processAgentAvatarAudio();
+    void processAgentTick();
 
 signals:
     void startAvatarAudioTimer();
@@ -90,6 +90,10 @@ private:
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     void computeLoudness(const QByteArray* decodedBuffer, QSharedPointer<ScriptableAvatar>);
 
+    // the stages of a tick
+    void processAgentAvatar();
+    void processAgentAvatarAudio();
+
     std::unique_ptr<ScriptEngine> _scriptEngine;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
@@ -119,6 +123,23 @@ private:
     Encoder* _encoder { nullptr };
     QThread _avatarAudioTimerThread;
     bool _flushEncoder { false };
+
+    // the avatar's fixed step ticks, on the schedule they started on
+    quint64 _tickStartTime { 0 };
+    quint64 _numTicks { 0 };
+    quint64 _lastAvatarFrameTime { 0 };
+    quint64 _nextAvatarFrameTime { 0 };
+
+    struct TickStats {
+        int numTicks { 0 };
+        int numBatchedTicks { 0 }; // run late, with others, to catch up
+        int numDroppedTicks { 0 }; // too late to catch up with
+        int numAvatarFrames { 0 };
+        quint64 avatarUpdateUsecs { 0 };
+        quint64 avatarDataUsecs { 0 };
+        quint64 audioUsecs { 0 };
+    };
+    TickStats _tickStats; // since the last stats packet
 };
 
 #endif // hifi_Agent_h
@@ -25,6 +25,7 @@
 #include <LogUtils.h>
 #include <LimitedNodeList.h>
 #include <NodeList.h>
+#include <plugins/PluginManager.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
@@ -116,6 +117,9 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
     connect(&_requestTimer, SIGNAL(timeout()), SLOT(sendAssignmentRequest()));
     _requestTimer.start(ASSIGNMENT_REQUEST_INTERVAL_MSECS);
 
+    // ask for the first assignment once the event loop runs, not an interval from now
+    QMetaObject::invokeMethod(this, "sendAssignmentRequest", Qt::QueuedConnection);
+
     // connections to AccountManager for authentication
     connect(DependencyManager::get<AccountManager>().data(), &AccountManager::authRequired,
             this, &AssignmentClient::handleAuthenticationRequest);
@@ -123,6 +127,10 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
     // Create Singleton objects on main thread
     NetworkAccessManager::getInstance();
 
+    // load the codecs while this client waits for an assignment, rather than when a mixer needs them, so that a spare
+    // started by the monitor takes over a mixer's assignment as soon as it gets it
+    PluginManager::getInstance()->getCodecPlugins();
+
     // did we get an assignment-client monitor port?
     if (assignmentMonitorPort > 0) {
         _assignmentClientMonitorSocket = HifiSockAddr(DEFAULT_ASSIGNMENT_CLIENT_MONITOR_HOSTNAME, assignmentMonitorPort);
@@ -342,4 +350,7 @@ void AssignmentClient::assignmentCompleted() {
     nodeList->resetNodeInterestSet();
     
     _isAssigned = false;
+
+    // the domain-server may have the next assignment waiting already
+    sendAssignmentRequest();
 }
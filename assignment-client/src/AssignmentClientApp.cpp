@@ -78,6 +78,10 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     const QCommandLineOption maxChildsOption(ASSIGNMENT_MAX_FORKS_OPTION, "maximum number of children", "child-count");
     parser.addOption(maxChildsOption);
 
+    const QCommandLineOption sparesOption(ASSIGNMENT_NUM_SPARES_OPTION,
+                                          "number of idle children kept ready to take an assignment", "child-count");
+    parser.addOption(sparesOption);
+
     const QCommandLineOption monitorPortOption(ASSIGNMENT_CLIENT_MONITOR_PORT_OPTION, "assignment-client monitor port", "port");
     parser.addOption(monitorPortOption);
 
@@ -115,6 +119,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         maxForks = parser.value(maxChildsOption).toInt();
     }
 
+    unsigned int numSpares = 1;
+    if (parser.isSet(sparesOption)) {
+        numSpares = qMax(parser.value(sparesOption).toInt(), 1);
+    }
+
     unsigned short monitorPort = 0;
     if (parser.isSet(monitorPortOption)) {
         monitorPort = parser.value(monitorPortOption).toUShort();
@@ -204,7 +213,7 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
 
     if (numForks || minForks || maxForks) {
-        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks,
+        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks, numSpares,
                                                                         requestAssignmentType, assignmentPool,
                                                                         listenPort, walletUUID, assignmentServerHostname,
                                                                         assignmentServerPort, httpStatusPort, logDirectory);
@@ -31,6 +31,7 @@ const int WAIT_FOR_CHILD_MSECS = 1000;
 AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmentClientForks,
                                                  const unsigned int minAssignmentClientForks,
                                                  const unsigned int maxAssignmentClientForks,
+                                                 const unsigned int numSpareAssignmentClients,
                                                  Assignment::Type requestAssignmentType, QString assignmentPool,
                                                  quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
                                                  quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory) :
@@ -38,6 +39,7 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
     _numAssignmentClientForks(numAssignmentClientForks),
     _minAssignmentClientForks(minAssignmentClientForks),
     _maxAssignmentClientForks(maxAssignmentClientForks),
+    _numSpareAssignmentClients(numSpareAssignmentClients),
     _requestAssignmentType(requestAssignmentType),
     _assignmentPool(assignmentPool),
     _walletUUID(walletUUID),
@@ -94,6 +96,9 @@ void AssignmentClientMonitor::simultaneousWaitOnChildren(int waitMsecs) {
 void AssignmentClientMonitor::childProcessFinished(qint64 pid) {
     if (_childProcesses.remove(pid)) {
         qDebug() << "Child process" << pid << "has finished. Removed from internal map.";
+
+        // a child that crashed took its assignment with it, have its replacement ready without waiting for the timer
+        checkSpares();
     }
 }
 
@@ -244,15 +249,23 @@ void AssignmentClientMonitor::checkSpares() {
         }
     });
 
+    // the children that were spawned but haven't reported yet will be spares
+    unsigned int numProcesses = (unsigned int)_childProcesses.size();
+    unsigned int numStarting = numProcesses > totalCount ? numProcesses - totalCount : 0;
+
     // Spawn or kill children, as needed.  If --min or --max weren't specified, allow the child count
     // to drift up or down as far as needed.
-    if (spareCount < 1 || totalCount < _minAssignmentClientForks) {
-        if (!_maxAssignmentClientForks || totalCount < _maxAssignmentClientForks) {
-            spawnChildClient();
+    unsigned int numSpawning = 0;
+    while (spareCount + numStarting + numSpawning < _numSpareAssignmentClients ||
+           totalCount + numStarting + numSpawning < _minAssignmentClientForks) {
+        if (_maxAssignmentClientForks && totalCount + numStarting + numSpawning >= _maxAssignmentClientForks) {
+            break;
         }
+        spawnChildClient();
+        ++numSpawning;
     }
 
-    if (spareCount > 1) {
+    if (spareCount > _numSpareAssignmentClients && !aSpareId.isNull()) {
         if (!_minAssignmentClientForks || totalCount > _minAssignmentClientForks) {
             // kill aSpareId
             qDebug() << "asking child" << aSpareId << "to exit.";
@@ -311,10 +324,17 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
         quint8 assignmentType;
         message->readPrimitive(&assignmentType);
 
+        bool tookAssignment = childData->getChildType() == Assignment::Type::AllTypes
+            && Assignment::Type(assignmentType) != Assignment::Type::AllTypes;
         childData->setChildType(Assignment::Type(assignmentType));
 
         // note when this child talked
         matchingNode->setLastHeardMicrostamp(usecTimestampNow());
+
+        // a spare was used up, warm up another one now rather than when the next assignment is waiting for it
+        if (tookAssignment) {
+            checkSpares();
+        }
     }
 }
 
@@ -36,7 +36,8 @@ class AssignmentClientMonitor : public QObject, public HTTPRequestHandler {
     Q_OBJECT
 public:
     AssignmentClientMonitor(const unsigned int numAssignmentClientForks, const unsigned int minAssignmentClientForks,
-                            const unsigned int maxAssignmentClientForks, Assignment::Type requestAssignmentType,
+                            const unsigned int maxAssignmentClientForks, const unsigned int numSpareAssignmentClients,
+                            Assignment::Type requestAssignmentType,
                             QString assignmentPool, quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
                             quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory);
     ~AssignmentClientMonitor();
@@ -65,6 +66,7 @@ private:
     const unsigned int _numAssignmentClientForks;
     const unsigned int _minAssignmentClientForks;
     const unsigned int _maxAssignmentClientForks;
+    const unsigned int _numSpareAssignmentClients; // idle children, ready to take over an assignment at once
 
     Assignment::Type _requestAssignmentType;
     QString _assignmentPool;
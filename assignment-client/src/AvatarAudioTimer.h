@@ -12,6 +12,8 @@
 #ifndef hifi_AvatarAudioTimer_h
 #define hifi_AvatarAudioTimer_h
 
+#include <atomic>
+
 #include <QtCore/QObject>
 
 class AvatarAudioTimer : public QObject {
@@ -22,10 +24,10 @@ signals:
 
 public slots:
     void start();
-    void stop() { _quit = true; }
+    void stop() { _quit = true; } // connect directly, as start() doesn't return to its event loop while ticking
 
 private:
-    bool _quit { false };
+    std::atomic<bool> _quit { false };
 };
 
 #endif //hifi_AvatarAudioTimer_h
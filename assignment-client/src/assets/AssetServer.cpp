@@ -23,11 +23,13 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QString>
 
+#include <Metrics.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
 
 #include "NetworkLogging.h"
 #include "NodeType.h"
+#include "BakeAssetTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
 #include <ClientServerUtils.h>
@@ -74,7 +76,9 @@ void updateConsumedCores() {
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
-    _taskPool(this)
+    _taskPool(this),
+    _getsMetric(metrics::Registry::getInstance().counter("asset_server_gets_total")),
+    _uploadsMetric(metrics::Registry::getInstance().counter("asset_server_uploads_total"))
 {
 
     // Most of the work will be I/O bound, reading from disk and constructing packet objects,
@@ -85,7 +89,7 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
     packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
-    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload");
+    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload", true);
     packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
     
 #ifdef Q_OS_WIN
@@ -145,6 +149,22 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    static const QString CONGESTION_CONTROL_OPTION = "congestion_control";
+    auto congestionControlName = assetServerObject[CONGESTION_CONTROL_OPTION].toString();
+
+    if (!congestionControlName.isEmpty()) {
+        auto ccFactory = udt::congestionControlFactoryForName(congestionControlName.toStdString());
+        if (ccFactory) {
+            nodeList->setCongestionControlFactory(std::move(ccFactory));
+            qInfo() << "Using" << congestionControlName << "congestion control for new connections.";
+        } else {
+            qWarning() << "Unknown congestion control" << congestionControlName << "- keeping the default.";
+        }
+    }
+
+    static const QString ENABLE_BAKING_OPTION = "enable_baking";
+    _bakingEnabled = assetServerObject[ENABLE_BAKING_OPTION].toBool(false);
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -193,6 +213,12 @@ void AssetServer::completeSetup() {
             cleanupUnmappedFiles();
         }
 
+        // bake whatever was mapped before baking was turned on, or before a bake could complete
+        auto mappings = _fileMappings;
+        for (auto it = mappings.cbegin(); it != mappings.cend(); ++it) {
+            maybeBake(it.key(), it.value().toString());
+        }
+
         nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
     } else {
         qCritical() << "Asset Server assignment will not continue because mapping file could not be loaded.";
@@ -280,13 +306,21 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, SharedNode
 void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket) {
     replyPacket.writePrimitive(AssetServerError::NoError);
 
+    // the baked content is served by its own mappings but kept out of the listing
     auto count = _fileMappings.size();
+    for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++it) {
+        if (isBakedContentPath(it.key())) {
+            --count;
+        }
+    }
 
     replyPacket.writePrimitive(count);
 
     for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++ it) {
-        replyPacket.writeString(it.key());
-        replyPacket.write(QByteArray::fromHex(it.value().toString().toUtf8()));
+        if (!isBakedContentPath(it.key())) {
+            replyPacket.writeString(it.key());
+            replyPacket.write(QByteArray::fromHex(it.value().toString().toUtf8()));
+        }
     }
 }
 
@@ -379,6 +413,7 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
 }
 
 void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    _getsMetric.increment();
 
     auto minSize = qint64(sizeof(MessageID) + SHA256_HASH_LENGTH + sizeof(DataOffset) + sizeof(DataOffset));
 
@@ -394,11 +429,12 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
 
 void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
 
+    _uploadsMetric.increment();
+
     if (senderNode->getCanWriteToAssetServer()) {
         qDebug() << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory);
-        _taskPool.start(task);
+        UploadAssetTask::start(message, senderNode, _filesDirectory, _taskPool);
     } else {
         // this is a node the domain told us is not allowed to rez entities
         // for now this also means it isn't allowed to add assets
@@ -584,6 +620,7 @@ bool AssetServer::setMapping(AssetPath path, AssetHash hash) {
     if (writeMappingsToFile()) {
         // persistence succeeded, we are good to go
         qDebug() << "Set mapping:" << path << "=>" << hash;
+        maybeBake(path, hash);
         return true;
     } else {
         // failed to persist this mapping to file - put back the old one in our in-memory representation
@@ -666,6 +703,22 @@ bool AssetServer::deleteMappings(AssetPathList& paths) {
             }
         }
 
+        // the baked versions of the unmapped hashes go with them
+        bool removedBakedMappings = false;
+        for (auto& hash : QSet<QString>(hashesToCheckForDeletion)) {
+            auto bakedMapping = _fileMappings.take(getBakedTexturePath(hash));
+            if (!bakedMapping.isNull()) {
+                removedBakedMappings = true;
+                auto bakedHash = bakedMapping.toString();
+                if (!_fileMappings.values().contains(bakedHash)) {
+                    hashesToCheckForDeletion << bakedHash;
+                }
+            }
+        }
+        if (removedBakedMappings && !writeMappingsToFile()) {
+            qWarning() << "Failed to persist the removal of baked mappings, they are dropped on the next start";
+        }
+
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
@@ -689,6 +742,31 @@ bool AssetServer::deleteMappings(AssetPathList& paths) {
     }
 }
 
+void AssetServer::maybeBake(const AssetPath& path, const AssetHash& hash) {
+    if (!_bakingEnabled || !isBakeableTexturePath(path) || _pendingBakes.contains(hash)
+        || _fileMappings.contains(getBakedTexturePath(hash))) {
+        return;
+    }
+
+    _pendingBakes.insert(hash);
+    auto task = new BakeAssetTask(this, hash, _filesDirectory);
+    _taskPool.start(task);
+}
+
+void AssetServer::handleCompletedBake(QString originalHash, QString bakedHash) {
+    _pendingBakes.remove(originalHash);
+
+    // the original may have been unmapped while it baked
+    if (!_fileMappings.values().contains(originalHash)) {
+        if (!_fileMappings.values().contains(bakedHash)) {
+            QFile::remove(_filesDirectory.absoluteFilePath(bakedHash));
+        }
+        return;
+    }
+
+    setMapping(getBakedTexturePath(originalHash), bakedHash);
+}
+
 bool AssetServer::renameMapping(AssetPath oldPath, AssetPath newPath) {
     oldPath = oldPath.trimmed();
     newPath = newPath.trimmed();
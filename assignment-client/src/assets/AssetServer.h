@@ -13,6 +13,7 @@
 #define hifi_AssetServer_h
 
 #include <QtCore/QDir>
+#include <QtCore/QSet>
 #include <QtCore/QThreadPool>
 
 #include <ThreadedAssignment.h>
@@ -38,6 +39,8 @@ private slots:
 
     void sendStatsPacket() override;
 
+    void handleCompletedBake(QString originalHash, QString bakedHash);
+
 private:
     using Mappings = QVariantHash;
 
@@ -63,11 +66,20 @@ private:
     // deletes any unmapped files from the local asset directory
     void cleanupUnmappedFiles();
 
+    /// Start baking the asset mapped at `path` unless it isn't bakeable or already has a baked version
+    void maybeBake(const AssetPath& path, const AssetHash& hash);
+
     Mappings _fileMappings;
 
+    bool _bakingEnabled { false };
+    QSet<AssetHash> _pendingBakes;
+
     QDir _resourcesDirectory;
     QDir _filesDirectory;
     QThreadPool _taskPool;
+
+    metrics::Counter& _getsMetric;
+    metrics::Counter& _uploadsMetric;
 };
 
 #endif
@@ -0,0 +1,77 @@
+//
+//  BakeAssetTask.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeAssetTask.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtGui/QImage>
+
+#include <gpu/Texture.h>
+#include <ktx/KTX.h>
+#include <model/TextureMap.h>
+
+BakeAssetTask::BakeAssetTask(QObject* assetServer, const AssetHash& hash, const QDir& filesDirectory) :
+    _assetServer(assetServer),
+    _hash(hash),
+    _filesDirectory(filesDirectory)
+{
+
+}
+
+void BakeAssetTask::run() {
+    QFile file { _filesDirectory.filePath(_hash) };
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open asset" << _hash << "to bake it";
+        return;
+    }
+
+    QImage image = QImage::fromData(file.readAll());
+    file.close();
+    if (image.isNull()) {
+        qWarning() << "Could not read asset" << _hash << "as a texture to bake it";
+        return;
+    }
+
+    // the same processing as the clients give to a color texture, compressing the mips
+    std::unique_ptr<gpu::Texture> texture { model::TextureUsage::createAlbedoTextureFromImage(image, _hash.toStdString()) };
+    ktx::Header header;
+    ktx::Images images;
+    ktx::KeyValues keyValues;
+    if (!texture || !gpu::Texture::evalKTXDescription(*texture, header, images, keyValues)) {
+        qWarning() << "Failed to bake asset" << _hash << "into a KTX";
+        return;
+    }
+
+    // the KTX is streamed from the mips twice, to hash it and then to write it under its hash, rather than copied whole
+    QCryptographicHash hasher { QCryptographicHash::Sha256 };
+    ktx::KTX::write([&](const ktx::Byte* bytes, size_t byteSize) {
+        hasher.addData(reinterpret_cast<const char*>(bytes), (int)byteSize);
+        return true;
+    }, header, images, keyValues);
+    AssetHash bakedHash = hasher.result().toHex();
+
+    QSaveFile bakedFile { _filesDirectory.filePath(bakedHash) };
+    if (!QFile::exists(bakedFile.fileName())) {
+        auto writeBytes = [&](const ktx::Byte* bytes, size_t byteSize) {
+            return bakedFile.write(reinterpret_cast<const char*>(bytes), (qint64)byteSize) == (qint64)byteSize;
+        };
+        if (!bakedFile.open(QIODevice::WriteOnly) || !ktx::KTX::write(writeBytes, header, images, keyValues) || !bakedFile.commit()) {
+            qWarning() << "Failed to write the baked asset" << bakedHash << "of" << _hash;
+            return;
+        }
+    }
+
+    qDebug() << "Baked asset" << _hash << "into" << bakedHash;
+
+    QMetaObject::invokeMethod(_assetServer, "handleCompletedBake", Qt::QueuedConnection,
+                              Q_ARG(QString, _hash), Q_ARG(QString, bakedHash));
+}
@@ -0,0 +1,36 @@
+//
+//  BakeAssetTask.h
+//  assignment-client/src/assets
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BakeAssetTask_h
+#define hifi_BakeAssetTask_h
+
+#include <QtCore/QDir>
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+
+#include <AssetUtils.h>
+
+// Bakes a texture asset into a KTX of compressed mips, stored in the files directory by its own hash,
+// and hands both hashes back to the asset-server to map the baked file
+class BakeAssetTask : public QRunnable {
+public:
+    BakeAssetTask(QObject* assetServer, const AssetHash& hash, const QDir& filesDirectory);
+
+    void run() override;
+
+private:
+    QObject* _assetServer;
+    AssetHash _hash;
+    QDir _filesDirectory;
+};
+
+#endif // hifi_BakeAssetTask_h
@@ -11,8 +11,13 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QThreadPool>
+
+#include <atomic>
+#include <memory>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
@@ -21,39 +26,133 @@
 #include "ClientServerUtils.h"
 
 
-UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir) :
-    _receivedMessage(receivedMessage),
-    _senderNode(senderNode),
-    _resourcesDir(resourcesDir)
+class UploadAssetTask::Upload {
+public:
+    Upload(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir) :
+        _receivedMessage(message),
+        _senderNode(senderNode),
+        _resourcesDir(resourcesDir) {}
+
+    // Queue a task for the packets arrived, unless one is already reading them
+    void schedule(const UploadPointer& self, QThreadPool& pool);
+    bool finishRun() { return --_pendingRuns > 0; }
+
+    void read();
+
+private:
+    bool readHeader();
+    void finish();
+
+    QSharedPointer<ReceivedMessage> _receivedMessage;
+    QSharedPointer<Node> _senderNode;
+    QDir _resourcesDir;
+
+    std::atomic<int> _pendingRuns { 0 };
+
+    bool _hasReadHeader { false };
+    bool _isFinished { false };
+    MessageID _messageID { 0 };
+    uint64_t _fileSize { 0 };
+    uint64_t _bytesRead { 0 };
+    QCryptographicHash _hasher { QCryptographicHash::Sha256 };
+    std::unique_ptr<QTemporaryFile> _tempFile;
+    bool _wroteTempFile { true };
+};
+
+void UploadAssetTask::start(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode,
+                            const QDir& resourcesDir, QThreadPool& pool) {
+    auto upload = UploadPointer::create(message, senderNode, resourcesDir);
+    QThreadPool* poolPointer = &pool;
+
+    if (!message->isComplete()) {
+        // the connections hold on to the upload until it finishes and disconnects them
+        QObject::connect(message.data(), &ReceivedMessage::progress, [upload, poolPointer](qint64 size) {
+            upload->schedule(upload, *poolPointer);
+        });
+        QObject::connect(message.data(), &ReceivedMessage::completed, [upload, poolPointer]() {
+            upload->schedule(upload, *poolPointer);
+        });
+    }
+    upload->schedule(upload, pool);
+}
+
+UploadAssetTask::UploadAssetTask(const UploadPointer& upload) :
+    _upload(upload)
 {
-    
 }
 
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
-    MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
-    
-    uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
-    
-    qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from"
+    // read again if more packets arrived while reading
+    do {
+        _upload->read();
+    } while (_upload->finishRun());
+}
+
+void UploadAssetTask::Upload::schedule(const UploadPointer& self, QThreadPool& pool) {
+    if (_pendingRuns++ == 0) {
+        pool.start(new UploadAssetTask(self));
+    }
+}
+
+bool UploadAssetTask::Upload::readHeader() {
+    if (_receivedMessage->getBytesLeftToRead() < qint64(sizeof(MessageID) + sizeof(uint64_t))) {
+        return false;
+    }
+    _receivedMessage->readPrimitive(&_messageID);
+    _receivedMessage->readPrimitive(&_fileSize);
+    _hasReadHeader = true;
+
+    qDebug() << "UploadAssetTask reading a file of " << _fileSize << "bytes from"
         << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
-    
+
+    if (_fileSize <= MAX_UPLOAD_SIZE) {
+        _tempFile.reset(new QTemporaryFile(_resourcesDir.filePath("upload-XXXXXX")));
+        _wroteTempFile = _tempFile->open();
+    }
+    return true;
+}
+
+void UploadAssetTask::Upload::read() {
+    if (_isFinished || (!_hasReadHeader && !readHeader())) {
+        if (!_isFinished && _receivedMessage->isComplete()) {
+            finish();
+        }
+        return;
+    }
+
+    if (_fileSize > MAX_UPLOAD_SIZE) {
+        finish();
+        return;
+    }
+
+    // stream the upload straight from the packets it arrives in to the temporary file, hashing as we go,
+    // and let go of the packets read so the upload isn't held in memory
+    auto bytesRead = _receivedMessage->readSegments(_fileSize - _bytesRead, [&](const char* data, qint64 size) {
+        _hasher.addData(data, size);
+        _wroteTempFile = _wroteTempFile && _tempFile->write(data, size) == size;
+        return true;
+    });
+    _bytesRead += bytesRead;
+    _receivedMessage->releaseReadSegments();
+
+    if (_receivedMessage->isComplete() && (_bytesRead == _fileSize || _receivedMessage->getBytesLeftToRead() == 0)) {
+        finish();
+    }
+}
+
+void UploadAssetTask::Upload::finish() {
+    _isFinished = true;
+    _receivedMessage->disconnect();
+
     auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
-    replyPacket->writePrimitive(messageID);
-    
-    if (fileSize > MAX_UPLOAD_SIZE) {
+    replyPacket->writePrimitive(_messageID);
+
+    if (_fileSize > MAX_UPLOAD_SIZE) {
         replyPacket->writePrimitive(AssetServerError::AssetTooLarge);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = hashData(fileData);
+        bool wroteTempFile = _tempFile && _wroteTempFile && !_receivedMessage->failed() && _bytesRead == _fileSize;
+
+        auto hash = _hasher.result();
         auto hexHash = hash.toHex();
         
         qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
@@ -63,9 +162,10 @@ void UploadAssetTask::run() {
 
         bool existingCorrectFile = false;
         
-        if (file.exists()) {
+        if (wroteTempFile && file.exists()) {
             // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && hashData(file.readAll()) == hash) {
+            QCryptographicHash fileHasher { QCryptographicHash::Sha256 };
+            if (file.open(QIODevice::ReadOnly) && fileHasher.addData(&file) && fileHasher.result() == hash) {
                 qDebug() << "Not overwriting existing verified file: " << hexHash;
 
                 existingCorrectFile = true;
@@ -79,27 +179,24 @@ void UploadAssetTask::run() {
         }
 
         if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            if (_tempFile) {
+                _tempFile->close();
+            }
+
+            if (wroteTempFile && (!file.exists() || file.remove()) && _tempFile->rename(file.fileName())) {
+                _tempFile->setAutoRemove(false);
+
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
 
                 replyPacket->writePrimitive(AssetServerError::NoError);
                 replyPacket->write(hash);
             } else {
+                // the temporary file is removed along with the upload
                 qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
-
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
-
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
                 
                 replyPacket->writePrimitive(AssetServerError::FileOperationFailed);
             }
         }
-
-
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
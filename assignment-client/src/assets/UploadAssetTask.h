@@ -23,17 +23,26 @@
 
 class NLPacketList;
 class Node;
+class QThreadPool;
 
+// Reads an upload as its packets arrive, hashing it and writing it to a temporary file on the way,
+// then moves the file into place under its hash once the upload is complete.
+// A task runs on the pool for the packets arrived since the last one ran, one task at a time.
 class UploadAssetTask : public QRunnable {
 public:
-    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir);
+    class Upload;
+    using UploadPointer = QSharedPointer<Upload>;
+
+    // Start reading the upload in the message, which may still be arriving
+    static void start(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode,
+                      const QDir& resourcesDir, QThreadPool& pool);
 
     void run() override;
 
 private:
-    QSharedPointer<ReceivedMessage> _receivedMessage;
-    QSharedPointer<Node> _senderNode;
-    QDir _resourcesDir;
+    UploadAssetTask(const UploadPointer& upload);
+
+    UploadPointer _upload;
 };
 
 #endif // hifi_UploadAssetTask_h
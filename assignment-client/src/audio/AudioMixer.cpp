@@ -17,6 +17,7 @@
 #include <QtCore/QJsonValue>
 
 #include <LogHandler.h>
+#include <Metrics.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
@@ -24,6 +25,7 @@
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <StDev.h>
 #include <UUID.h>
@@ -52,6 +54,8 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 QHash<QString, AABox> AudioMixer::_audioZones;
 QVector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 QVector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+AudioMixerClusters AudioMixer::_clusters;
+AudioMixerBridge AudioMixer::_bridge;
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message) {
@@ -85,6 +89,7 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
     packetReceiver.registerListener(PacketType::NodeMuteRequest, this, "handleNodeMuteRequestPacket");
     packetReceiver.registerListener(PacketType::KillAvatar, this, "handleKillAvatarPacket");
+    packetReceiver.registerListener(PacketType::AudioMixerBed, this, "handleAudioMixerBedPacket");
 
     connect(nodeList.data(), &NodeList::nodeKilled, this, &AudioMixer::handleNodeKilled);
 }
@@ -157,7 +162,15 @@ const std::pair<QString, CodecPluginPointer> AudioMixer::negotiateCodec(std::vec
     return std::make_pair(selectedCodecName, _availableCodecs[selectedCodecName]);
 }
 
+void AudioMixer::handleAudioMixerBedPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    _bridge.processBed(*message, sendingNode);
+}
+
 void AudioMixer::handleNodeKilled(SharedNodePointer killedNode) {
+    if (killedNode->getType() == NodeType::AudioMixer) {
+        _bridge.removePeer(killedNode->getUUID());
+    }
+
     // enumerate the connected listeners to remove HRTF objects for the disconnected node
     auto nodeList = DependencyManager::get<NodeList>();
 
@@ -238,6 +251,10 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
+    statsObject["predictive_throttled_frames"] = _numPredictiveThrottledFrames;
+    statsObject["avg_predictive_throttling_ratio"] = _numPredictiveThrottledFrames > 0 ?
+        _sumPredictiveThrottlingRatio / _numPredictiveThrottledFrames : 0.0f;
+    statsObject["us_per_mix_pair"] = _mixCostPerPair;
 
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
@@ -263,6 +280,20 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_eventsTiming, "events");
     addTiming(_packetsTiming, "packets");
 
+    // stages are summed over slave threads, so they add up to more than the frame with several threads
+    auto addStageTiming = [&](uint64_t nanoseconds, std::string name) {
+        timingStats[("us_cpu_per_" + name).c_str()] = (qint64)(nanoseconds / NSECS_PER_USEC / _numStatFrames);
+    };
+    addStageTiming(_stats.packetsTime, "stage_packets");
+    addStageTiming(_stats.prepareMixTime, "stage_prepare_mix");
+    addStageTiming(_stats.streamTime, "stage_hrtf");
+    addStageTiming(_stats.encodeTime, "stage_encode");
+    addStageTiming(_stats.sendTime, "stage_send");
+
+    uint64_t listenerTime = _stats.prepareMixTime + _stats.encodeTime + _stats.sendTime;
+    timingStats["us_cpu_per_listener"] = (_stats.sumListeners > 0) ?
+        (qint64)(listenerTime / NSECS_PER_USEC / _stats.sumListeners) : 0;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -279,12 +310,21 @@ void AudioMixer::sendStatsPacket() {
     mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
     mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
 
+    mixStats["cluster_mixes"] = _stats.clusterMixes;
+    mixStats["avg_cluster_renders_per_block"] = _stats.clusterRenders / _numStatFrames;
+    mixStats["avg_bridge_renders_per_block"] = _stats.bridgeRenders / _numStatFrames;
+
+    mixStats["encoded_mixes"] = _stats.encodedMixes;
+    mixStats["shared_encoded_mixes"] = _stats.sharedEncodedMixes;
+
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
     statsObject["mix_stats"] = mixStats;
 
     _numStatFrames = _numSilentPackets = 0;
+    _numPredictiveThrottledFrames = 0;
+    _sumPredictiveThrottlingRatio = 0.0f;
     _stats.reset();
 
     // add stats for each listerner
@@ -344,6 +384,12 @@ void AudioMixer::start() {
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
     nodeList->linkedDataCreateCallback = [&](Node* node) { getOrCreateClientData(node); };
 
+    // silent frames, mute and environment packets are small - pack them per listener, flushed after every mix
+    nodeList->setPacketCoalescingEnabled(true);
+
+    // every inbound packet is hash verified, keep that off the thread reading the socket
+    nodeList->setPacketFilterOnWorkerThread(true);
+
     // parse out any AudioMixer settings
     {
         DomainHandler& domainHandler = nodeList->getDomainHandler();
@@ -351,10 +397,21 @@ void AudioMixer::start() {
         parseSettingsObject(settingsObject);
     }
 
+    // the mixers of a domain split into regions exchange the beds of their regions
+    if (_bridge.isEnabled()) {
+        nodeList->removeSoloNodeType(NodeType::AudioMixer);
+        nodeList->addNodeTypeToInterestSet(NodeType::AudioMixer);
+    }
+
     // mix state
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
 
+    auto& metricsRegistry = metrics::Registry::getInstance();
+    auto& listenersMetric = metricsRegistry.gauge("audio_mixer_listeners");
+    auto& streamsMetric = metricsRegistry.gauge("audio_mixer_streams");
+    auto& mixUsecsMetric = metricsRegistry.histogram("audio_mixer_mix_usecs", { 500, 1000, 2000, 5000, 10000 });
+
     while (!_isFinished) {
         auto ticTimer = _ticTiming.timer();
 
@@ -362,26 +419,68 @@ void AudioMixer::start() {
             auto timer = _sleepTiming.timer();
             auto frameDuration = timeFrame(frameTimestamp);
             throttle(frameDuration, frame);
+            recordFrame(frameDuration.count());
         }
 
         auto frameTimer = _frameTiming.timer();
+        auto frameStart = p_high_resolution_clock::now();
 
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // prepare frames; pop off any new audio from their streams
+            int numStreams = 0;
             {
                 auto prepareTimer = _prepareTiming.timer();
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
-                    _stats.sumStreams += prepareFrame(node, frame);
+                    numStreams += prepareFrame(node, frame);
                 });
+                _stats.sumStreams += numStreams;
+                listenersMetric.set(std::distance(cbegin, cend));
+                streamsMetric.set(numStreams);
+
+                // premix distant streams once for all listeners
+                _clusters.prepare(cbegin, cend);
+
+                // premix the streams for the other regions, and sum the beds they sent
+                _bridge.sendBeds(cbegin, cend, frame);
+                _bridge.prepare();
             }
 
             // mix across slave threads
             {
                 auto mixTimer = _mixTiming.timer();
-                _slavePool.mix(cbegin, cend, frame, _throttlingRatio);
+
+                // every listener mixes (or throttles) every stream
+                int numPairs = (int)std::distance(cbegin, cend) * numStreams;
+                float throttlingRatio = std::max(_throttlingRatio, predictThrottlingRatio(frameStart, numPairs));
+
+                auto mixStart = p_high_resolution_clock::now();
+                _slavePool.mix(cbegin, cend, frame, throttlingRatio);
+                auto mixDuration = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - mixStart);
+
+                updateMixCost(mixDuration, numPairs, throttlingRatio);
+                mixUsecsMetric.observe((double)mixDuration.count());
             }
         });
 
+        // process queued events (networking, global audio packets, &c.)
+        {
+            auto eventsTimer = _eventsTiming.timer();
+
+            // since we're a while loop we need to yield to qt's event processing
+            QCoreApplication::processEvents();
+        }
+
+        // process (node-isolated) audio packets across slave threads, decoding the next frame's audio
+        // while this thread writes out all of the packets the slaves queued for this frame
+        nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            auto packetsTimer = _packetsTiming.timer();
+            _slavePool.processPackets(cbegin, cend, [&] {
+                auto flushStart = p_high_resolution_clock::now();
+                nodeList->flushQueuedPackets();
+                _lastFlushTime = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - flushStart).count();
+            });
+        });
+
         // gather stats
         _slavePool.each([&](AudioMixerSlave& slave) {
             _stats.accumulate(slave.stats);
@@ -391,22 +490,6 @@ void AudioMixer::start() {
         ++frame;
         ++_numStatFrames;
 
-        // process queued events (networking, global audio packets, &c.)
-        {
-            auto eventsTimer = _eventsTiming.timer();
-
-            // since we're a while loop we need to yield to qt's event processing
-            QCoreApplication::processEvents();
-
-            // process (node-isolated) audio packets across slave threads
-            {
-                nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
-                    auto packetsTimer = _packetsTiming.timer();
-                    _slavePool.processPackets(cbegin, cend);
-                });
-            }
-        }
-
         if (_isFinished) {
             // alert qt eventing that this is finished
             QCoreApplication::sendPostedEvents(this, QEvent::DeferredDelete);
@@ -481,6 +564,50 @@ void AudioMixer::throttle(std::chrono::microseconds duration, int frame) {
     }
 }
 
+float AudioMixer::predictThrottlingRatio(p_high_resolution_clock::time_point frameStart, int numPairs) {
+    // leave the same headroom as the trailing controller targets
+    const float TARGET_FRAME_TIME = 0.9f * AudioConstants::NETWORK_FRAME_USECS;
+
+    if (_mixCostPerPair <= 0.0f || numPairs == 0) {
+        return 0.0f;
+    }
+
+    // what is left once this frame's preparation and last frame's flush are accounted for
+    float elapsed = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - frameStart).count();
+    float budget = TARGET_FRAME_TIME - elapsed - _lastFlushTime;
+    float predictedMixTime = _mixCostPerPair * numPairs;
+
+    if (predictedMixTime <= budget) {
+        return 0.0f;
+    }
+
+    // throttling is linear in the streams, and drops the least audible ones first
+    float ratio = budget > 0.0f ? 1.0f - budget / predictedMixTime : 1.0f;
+    _sumPredictiveThrottlingRatio += ratio;
+    ++_numPredictiveThrottledFrames;
+    return ratio;
+}
+
+void AudioMixer::updateMixCost(std::chrono::microseconds mixDuration, int numPairs, float throttlingRatio) {
+    // learn quickly enough to catch a crowd arriving, slowly enough to ride out a single slow frame
+    const float CURRENT_FRAME_WEIGHT = 0.1f;
+    // when nearly everything was throttled, the frame says little about the cost of a full mix
+    const float MIN_MIXED_RATIO = 0.1f;
+
+    float mixedRatio = 1.0f - throttlingRatio;
+    if (numPairs == 0 || mixedRatio < MIN_MIXED_RATIO) {
+        return;
+    }
+
+    // throttled streams are not free, so this overestimates the cost a little while throttling: err on the safe side
+    float cost = mixDuration.count() / (numPairs * mixedRatio);
+    if (_mixCostPerPair == 0.0f) {
+        _mixCostPerPair = cost;
+    } else {
+        _mixCostPerPair = (1.0f - CURRENT_FRAME_WEIGHT) * _mixCostPerPair + CURRENT_FRAME_WEIGHT * cost;
+    }
+}
+
 int AudioMixer::prepareFrame(const SharedNodePointer& node, unsigned int frame) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data == nullptr) {
@@ -505,6 +632,9 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                 _slavePool.setNumThreads(numThreads);
             }
         }
+
+        const QString PIN_THREADS = "pin_threads";
+        _slavePool.setPinThreads(audioThreadingGroupObject[PIN_THREADS].toBool());
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -581,6 +711,41 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             qDebug() << "Codec preference order changed to" << _codecPreferenceOrder;
         }
 
+        // the settings of the encoders of the listeners' mixes, taken by the codecs that have them
+        QVariantMap codecSettings;
+        const QString CODEC_COMPLEXITY = "codec_complexity";
+        if (audioEnvGroupObject[CODEC_COMPLEXITY].isString()) {
+            bool ok = false;
+            int complexity = audioEnvGroupObject[CODEC_COMPLEXITY].toString().toInt(&ok);
+            if (ok) {
+                codecSettings["complexity"] = complexity;
+            }
+        }
+        const QString CODEC_BITRATE = "codec_bitrate";
+        if (audioEnvGroupObject[CODEC_BITRATE].isString()) {
+            bool ok = false;
+            int bitrate = audioEnvGroupObject[CODEC_BITRATE].toString().toInt(&ok);
+            if (ok) {
+                codecSettings["bitrate"] = bitrate;
+            }
+        }
+        const QString CODEC_FRAME_SIZE = "codec_frame_size";
+        if (audioEnvGroupObject[CODEC_FRAME_SIZE].isString()) {
+            bool ok = false;
+            float frameSizeMsecs = audioEnvGroupObject[CODEC_FRAME_SIZE].toString().toFloat(&ok);
+            if (ok) {
+                codecSettings["frameSizeMsecs"] = frameSizeMsecs;
+            }
+        }
+        if (!codecSettings.isEmpty()) {
+            for (auto& codec : _availableCodecs) {
+                if (codec.second) {
+                    codec.second->configure(codecSettings);
+                }
+            }
+            qDebug() << "Codec settings changed to" << codecSettings;
+        }
+
         const QString ATTENATION_PER_DOULING_IN_DISTANCE = "attenuation_per_doubling_in_distance";
         if (audioEnvGroupObject[ATTENATION_PER_DOULING_IN_DISTANCE].isString()) {
             bool ok = false;
@@ -601,6 +766,80 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             }
         }
 
+        const QString ENABLE_CLUSTERS = "enable_clusters";
+        _clusters.setEnabled(audioEnvGroupObject[ENABLE_CLUSTERS].toBool());
+        if (_clusters.isEnabled()) {
+            bool ok = false;
+
+            const QString CLUSTER_RADIUS = "cluster_radius";
+            float radius = audioEnvGroupObject[CLUSTER_RADIUS].toString().toFloat(&ok);
+            if (ok && radius > 0.0f) {
+                _clusters.setRadius(radius);
+            }
+
+            const QString CLUSTER_CELL_SIZE = "cluster_cell_size";
+            float cellSize = audioEnvGroupObject[CLUSTER_CELL_SIZE].toString().toFloat(&ok);
+            if (ok && cellSize > 0.0f) {
+                _clusters.setCellSize(cellSize);
+            }
+
+            qDebug() << "Clustering streams further than" << _clusters.getRadius() << "m in cells of"
+                << _clusters.getCellSize() << "m";
+        }
+
+        const QString MIXER_REGIONS = "mixer_regions";
+        if (audioEnvGroupObject[MIXER_REGIONS].isArray()) {
+            const QJsonArray& regions = audioEnvGroupObject[MIXER_REGIONS].toArray();
+
+            // the regions are columns of the domain, the domain server assigns a mixer to each one
+            const QString X_MIN = "x_min";
+            const QString X_MAX = "x_max";
+            const QString Z_MIN = "z_min";
+            const QString Z_MAX = "z_max";
+            QVector<AABox> regionBoxes;
+            for (int i = 0; i < regions.count(); ++i) {
+                QJsonObject regionObject = regions[i].toObject();
+
+                float xMin, xMax, zMin, zMax;
+                bool ok, allOk = true;
+                xMin = regionObject.value(X_MIN).toString().toFloat(&ok);
+                allOk &= ok;
+                xMax = regionObject.value(X_MAX).toString().toFloat(&ok);
+                allOk &= ok;
+                zMin = regionObject.value(Z_MIN).toString().toFloat(&ok);
+                allOk &= ok;
+                zMax = regionObject.value(Z_MAX).toString().toFloat(&ok);
+                allOk &= ok;
+
+                if (!allOk) {
+                    qDebug() << "Invalid mixer region" << i << "- the domain is mixed as one region";
+                    regionBoxes.clear();
+                    break;
+                }
+                glm::vec3 corner(xMin, -HALF_TREE_SCALE, zMin);
+                glm::vec3 dimensions(xMax - xMin, TREE_SCALE, zMax - zMin);
+                regionBoxes.push_back(AABox(corner, dimensions));
+            }
+            _bridge.setRegions(regionBoxes);
+
+            // the region of this mixer is in the payload of its assignment
+            const QString REGION_OPTION = "--region";
+            QStringList payloadArguments = QString(getPayload()).split(' ', QString::SkipEmptyParts);
+            int regionOptionIndex = payloadArguments.indexOf(REGION_OPTION);
+            if (regionOptionIndex >= 0 && regionOptionIndex + 1 < payloadArguments.size()) {
+                bool ok;
+                int region = payloadArguments[regionOptionIndex + 1].toInt(&ok);
+                if (ok) {
+                    _bridge.setRegion(region);
+                }
+            }
+
+            if (_bridge.isEnabled()) {
+                qDebug() << "Mixing region" << _bridge.getRegion() << "of" << regionBoxes.size()
+                    << "and bridging to the others";
+            }
+        }
+
         const QString AUDIO_ZONES = "zones";
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
@@ -697,6 +936,7 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                     if (okReverbTime && okWetLevel && _audioZones.contains(zone)) {
                         ReverbSettings settings;
                         settings.zone = zone;
+                        settings.zoneBox = _audioZones.value(zone);
                         settings.reverbTime = reverbTime;
                         settings.wetLevel = wetLevel;
 
@@ -18,6 +18,8 @@
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
+#include "AudioMixerBridge.h"
+#include "AudioMixerClusters.h"
 #include "AudioMixerStats.h"
 #include "AudioMixerSlavePool.h"
 
@@ -39,6 +41,7 @@ public:
     };
     struct ReverbSettings {
         QString zone;
+        AABox zoneBox; // resolved from _audioZones when the settings are parsed, rather than per listener
         float reverbTime;
         float wetLevel;
     };
@@ -49,6 +52,8 @@ public:
     static const QHash<QString, AABox>& getAudioZones() { return _audioZones; }
     static const QVector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const QVector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static const AudioMixerClusters& getClusters() { return _clusters; }
+    static const AudioMixerBridge& getBridge() { return _bridge; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
 public slots:
@@ -61,6 +66,7 @@ private slots:
     void handleNodeMuteRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleNodeKilled(SharedNodePointer killedNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleAudioMixerBedPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
 
     void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void removeHRTFsForFinishedInjector(const QUuid& streamID);
@@ -70,6 +76,9 @@ private:
     // mixing helpers
     std::chrono::microseconds timeFrame(p_high_resolution_clock::time_point& timestamp);
     void throttle(std::chrono::microseconds frameDuration, int frame);
+    // predicts the time left for mixing this frame, and returns the ratio of streams to throttle to stay within it
+    float predictThrottlingRatio(p_high_resolution_clock::time_point frameStart, int numPairs);
+    void updateMixCost(std::chrono::microseconds mixDuration, int numPairs, float throttlingRatio);
     // pop a frame from any streams on the node
     // returns the number of available streams
     int prepareFrame(const SharedNodePointer& node, unsigned int frame);
@@ -83,6 +92,12 @@ private:
     float _trailingMixRatio { 0.0f };
     float _throttlingRatio { 0.0f };
 
+    // predictive throttling, on top of the trailing controller in throttle
+    float _mixCostPerPair { 0.0f }; // usecs to mix one stream for one listener, unthrottled
+    float _lastFlushTime { 0.0f }; // usecs
+    float _sumPredictiveThrottlingRatio { 0.0f };
+    int _numPredictiveThrottledFrames { 0 };
+
     int _numSilentPackets { 0 };
 
     int _numStatFrames { 0 };
@@ -127,6 +142,8 @@ private:
     static QHash<QString, AABox> _audioZones;
     static QVector<ZoneSettings> _zoneSettings;
     static QVector<ReverbSettings> _zoneReverbSettings;
+    static AudioMixerClusters _clusters;
+    static AudioMixerBridge _bridge;
 
 };
 
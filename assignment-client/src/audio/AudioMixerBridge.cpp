@@ -0,0 +1,197 @@
+//
+//  AudioMixerBridge.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <GLMHelpers.h>
+#include <udt/PacketHeaders.h>
+
+#include "AudioMixerClientData.h"
+#include "AudioMixerClusters.h"
+#include "AudioMixerSlave.h"
+
+#include "AudioMixerBridge.h"
+
+// a bed doesn't fit in one packet, it is sent in two halves of two channels each
+static const quint8 NUM_BED_HALVES = 2;
+// a half that only tells the receiver the region of the sender, for it to premix the beds it sends back
+static const quint8 ANNOUNCEMENT = 0xFF;
+
+// the beds are quantized, leave headroom for the loud regions
+static const float BED_HEADROOM = 4.0f;
+
+float AudioMixerBridge::getBedHeadroom() {
+    return BED_HEADROOM;
+}
+
+void AudioMixerBridge::sendBeds(ConstIter begin, ConstIter end, unsigned int frame) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const int HALF_BED_BYTES = 2 * NUM_FRAMES * sizeof(int16_t);
+    const unsigned int ANNOUNCEMENT_INTERVAL_FRAMES = (unsigned int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
+    quint8 region = (quint8)_region;
+    quint16 sequence = (quint16)frame;
+
+    auto sendHalf = [&](const SharedNodePointer& peerNode, quint8 half) {
+        int size = sizeof(quint8) + sizeof(quint8) + sizeof(quint16) + (half == ANNOUNCEMENT ? 0 : HALF_BED_BYTES);
+        auto packet = NLPacket::create(PacketType::AudioMixerBed, size);
+        packet->writePrimitive(region);
+        packet->writePrimitive(half);
+        packet->writePrimitive(sequence);
+        if (half != ANNOUNCEMENT) {
+            int16_t halfSamples[2 * NUM_FRAMES];
+            for (int i = 0; i < NUM_FRAMES; ++i) {
+                halfSamples[2*i+0] = _premixSamples[4*i + 2*half + 0];
+                halfSamples[2*i+1] = _premixSamples[4*i + 2*half + 1];
+            }
+            packet->write(reinterpret_cast<const char*>(halfSamples), HALF_BED_BYTES);
+        }
+        nodeList->queuePacket(std::move(packet), *peerNode);
+    };
+
+    int16_t samples[NUM_FRAMES];
+
+    std::for_each(begin, end, [&](const SharedNodePointer& peerNode) {
+        if (peerNode->getType() != NodeType::AudioMixer || !peerNode->getActiveSocket()) {
+            return;
+        }
+
+        auto peer = _peers.find(peerNode->getUUID());
+        int peerRegion = peer != _peers.end() ? peer->second.region : NO_REGION;
+        if (peerRegion == NO_REGION || peerRegion == _region) {
+            sendHalf(peerNode, ANNOUNCEMENT);
+            return;
+        }
+
+        // the streams as heard from the center of the peer's region (ambiX: W, Y, Z, X)
+        memset(_premix, 0, sizeof(_premix));
+        glm::vec3 center = _regions[peerRegion].calcCenter();
+        bool hasAudio = false;
+
+        std::for_each(begin, end, [&](const SharedNodePointer& node) {
+            AudioMixerClientData* nodeData = dynamic_cast<AudioMixerClientData*>(node->getLinkedData());
+            if (!nodeData) {
+                return;
+            }
+
+            for (auto& streamPair : nodeData->getAudioStreams()) {
+                const PositionalAudioStream* stream = streamPair.second.get();
+                if (!stream->lastPopSucceeded() || stream->isStereo() || stream->getLastPopOutputLoudness() == 0.0f) {
+                    continue;
+                }
+
+                glm::vec3 relativePosition = stream->getPosition() - center;
+                float distance = glm::max(glm::length(relativePosition), EPSILON);
+                glm::vec3 direction = relativePosition / distance;
+
+                float gain = AudioMixerClusters::premixGain(*stream) / AudioConstants::MAX_SAMPLE_VALUE;
+                gain *= computeDistanceAttenuation(center, stream->getPosition(), distance);
+
+                // world coordinates to ambisonic (X front, Y left, Z up)
+                float w = gain;
+                float y = gain * -direction.x;
+                float z = gain * direction.y;
+                float x = gain * -direction.z;
+
+                AudioRingBuffer::ConstIterator streamPopOutput = stream->getLastPopOutput();
+                streamPopOutput.readSamples(samples, NUM_FRAMES);
+                for (int i = 0; i < NUM_FRAMES; ++i) {
+                    _premix[4*i+0] += w * samples[i];
+                    _premix[4*i+1] += y * samples[i];
+                    _premix[4*i+2] += z * samples[i];
+                    _premix[4*i+3] += x * samples[i];
+                }
+                hasAudio = true;
+            }
+        });
+
+        if (!hasAudio) {
+            if (frame % ANNOUNCEMENT_INTERVAL_FRAMES == 0) {
+                sendHalf(peerNode, ANNOUNCEMENT);
+            }
+            return;
+        }
+
+        const float SCALE = AudioConstants::MAX_SAMPLE_VALUE / BED_HEADROOM;
+        for (int i = 0; i < NUM_BED_SAMPLES; ++i) {
+            float sample = glm::clamp(_premix[i] * SCALE, (float)AudioConstants::MIN_SAMPLE_VALUE,
+                                      (float)AudioConstants::MAX_SAMPLE_VALUE);
+            _premixSamples[i] = (int16_t)sample;
+        }
+        for (quint8 half = 0; half < NUM_BED_HALVES; ++half) {
+            sendHalf(peerNode, half);
+        }
+    });
+}
+
+void AudioMixerBridge::processBed(ReceivedMessage& message, const SharedNodePointer& sendingNode) {
+    quint8 region;
+    quint8 half;
+    quint16 sequence;
+    message.readPrimitive(&region);
+    message.readPrimitive(&half);
+    message.readPrimitive(&sequence);
+    if (!isEnabled() || region >= _regions.size()) {
+        return;
+    }
+
+    Peer& peer = _peers[sendingNode->getUUID()];
+    peer.region = region;
+    if (half >= NUM_BED_HALVES) {
+        return;
+    }
+
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    int16_t halfSamples[2 * NUM_FRAMES];
+    if (message.read(reinterpret_cast<char*>(halfSamples), sizeof(halfSamples)) != (qint64)sizeof(halfSamples)) {
+        return;
+    }
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        peer.samples[4*i + 2*half + 0] = halfSamples[2*i+0];
+        peer.samples[4*i + 2*half + 1] = halfSamples[2*i+1];
+    }
+    peer.sequences[half] = sequence;
+    peer.isMixed = false;
+}
+
+void AudioMixerBridge::prepare() {
+    _hasBed = false;
+    if (!isEnabled()) {
+        return;
+    }
+
+    // a bed is heard once, when both of its halves arrived; late or lost halves leave a gap rather than a repeat
+    for (auto& peerPair : _peers) {
+        Peer& peer = peerPair.second;
+        if (peer.isMixed || peer.sequences[0] != peer.sequences[1]) {
+            continue;
+        }
+        if (!_hasBed) {
+            memset(_bed, 0, sizeof(_bed));
+            _hasBed = true;
+        }
+        for (int i = 0; i < NUM_BED_SAMPLES; ++i) {
+            _bed[i] += peer.samples[i];
+        }
+        peer.isMixed = true;
+    }
+
+    if (_hasBed) {
+        for (int i = 0; i < NUM_BED_SAMPLES; ++i) {
+            _bedSamples[i] = (int16_t)glm::clamp(_bed[i], (float)AudioConstants::MIN_SAMPLE_VALUE,
+                                                 (float)AudioConstants::MAX_SAMPLE_VALUE);
+        }
+    }
+}
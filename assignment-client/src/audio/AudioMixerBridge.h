@@ -0,0 +1,79 @@
+//
+//  AudioMixerBridge.h
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerBridge_h
+#define hifi_AudioMixerBridge_h
+
+#include <unordered_map>
+
+#include <QtCore/QVector>
+
+#include <AABox.h>
+#include <AudioConstants.h>
+#include <NodeList.h>
+#include <ReceivedMessage.h>
+#include <UUIDHasher.h>
+
+// Regional beds exchanged between the audio mixers of a domain split into regions
+//   Each mixer mixes the listeners of its region as usual, and they hear the other regions through the beds the other
+//   mixers send: every frame, each mixer premixes its mono streams into a first-order ambisonic bed, in world
+//   coordinates, as heard from the center of the region of the mixer it sends it to. A listener hears all of the beds
+//   its mixer received through one AudioFOA decode.
+//   sendBeds and prepare are called from the mixer thread before mixing, and the beds are received on it between
+//   frames; during the mix the slaves only read.
+class AudioMixerBridge {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    static const int NO_REGION = -1;
+    static const int NUM_BED_SAMPLES = 4 * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    // the regions of the domain, the same for all of its mixers, and the one of this mixer
+    void setRegions(const QVector<AABox>& regions) { _regions = regions; }
+    void setRegion(int region) { _region = region; }
+    int getRegion() const { return _region; }
+    bool isEnabled() const { return _region >= 0 && _region < _regions.size() && _regions.size() > 1; }
+
+    // premix this frame's streams into a bed for each of the other mixers and queue them
+    // (requires streams to have been popped for the frame)
+    void sendBeds(ConstIter begin, ConstIter end, unsigned int frame);
+
+    void processBed(ReceivedMessage& message, const SharedNodePointer& sendingNode);
+    void removePeer(const QUuid& peerID) { _peers.erase(peerID); }
+
+    // sum the beds received since the last frame
+    void prepare();
+
+    // the sum of the beds, in world coordinates, quantized for AudioFOA with getBedHeadroom() of headroom
+    bool hasBed() const { return _hasBed; }
+    const int16_t* getBed() const { return _bedSamples; }
+    static float getBedHeadroom();
+
+private:
+    struct Peer {
+        int region { NO_REGION };
+        quint16 sequences[2] {}; // of the halves of the bed stored in samples
+        bool isMixed { true };
+        int16_t samples[NUM_BED_SAMPLES];
+    };
+
+    QVector<AABox> _regions;
+    int _region { NO_REGION };
+
+    std::unordered_map<QUuid, Peer> _peers;
+
+    float _premix[NUM_BED_SAMPLES];
+    int16_t _premixSamples[NUM_BED_SAMPLES];
+    bool _hasBed { false };
+    float _bed[NUM_BED_SAMPLES];
+    int16_t _bedSamples[NUM_BED_SAMPLES];
+};
+
+#endif // hifi_AudioMixerBridge_h
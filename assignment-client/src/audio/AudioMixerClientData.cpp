@@ -147,6 +147,17 @@ AvatarAudioStream* AudioMixerClientData::getAvatarAudioStream() {
     return NULL;
 }
 
+float AudioMixerClientData::gainAdjustmentForStream(const QUuid& nodeID, const QUuid& streamID) const {
+    auto nodeIt = _nodeSourcesHRTFMap.find(nodeID);
+    if (nodeIt != _nodeSourcesHRTFMap.end()) {
+        auto streamIt = nodeIt->second.find(streamID);
+        if (streamIt != nodeIt->second.end()) {
+            return streamIt->second.getGainAdjustment() / HRTF_GAIN;
+        }
+    }
+    return 1.0f;
+}
+
 void AudioMixerClientData::removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID) {
     auto it = _nodeSourcesHRTFMap.find(nodeID);
     if (it != _nodeSourcesHRTFMap.end()) {
@@ -17,6 +17,7 @@
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -53,6 +54,9 @@ public:
     // returns a new or existing HRTF object for the given stream from the given node
     AudioHRTF& hrtfForStream(const QUuid& nodeID, const QUuid& streamID = QUuid()) { return _nodeSourcesHRTFMap[nodeID][streamID]; }
 
+    // returns the gain adjustment set for the given stream, without creating an HRTF object for it
+    float gainAdjustmentForStream(const QUuid& nodeID, const QUuid& streamID = QUuid()) const;
+
     // removes an AudioHRTF object for a given stream
     void removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid());
 
@@ -84,8 +88,18 @@ public:
     // uses randomization to have the AudioMixer send a stats packet to this node around every second
     bool shouldSendStats(int frameNumber);
 
+    // time spent mixing for this listener last frame, used to balance the next frame across slaves
+    uint64_t getMixTime() const { return _mixTime; }
+    void setMixTime(uint64_t mixTime) { _mixTime = mixTime; }
+
     AudioLimiter audioLimiter;
 
+    // decodes the ambisonic bed of the distant clusters this node hears (see AudioMixerClusters)
+    AudioFOA clusterFOA;
+
+    // decodes the beds of the other regions of the domain (see AudioMixerBridge)
+    AudioFOA bridgeFOA;
+
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
     void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
@@ -99,6 +113,11 @@ public:
     }
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
+    void setShouldFlushEncoder(bool shouldFlush) { _shouldFlushEncoder = shouldFlush; }
+
+    // clients with the same shareable encoder (see Encoder::isShareable) and the same mix can share the encoded
+    // frame (nullptr is the raw PCM passthrough)
+    Encoder* getEncoder() const { return _encoder; }
 
     QString getCodecName() { return _selectedCodecName; }
 
@@ -172,6 +191,8 @@ private:
 
     int _frameToSendStats { 0 };
 
+    uint64_t _mixTime { 0 }; // nanoseconds
+
     CodecPluginPointer _codec;
     QString _selectedCodecName;
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
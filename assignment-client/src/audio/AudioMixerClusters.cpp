@@ -0,0 +1,102 @@
+//
+//  AudioMixerClusters.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "AudioMixerClientData.h"
+#include "InjectedAudioStream.h"
+
+#include "AudioMixerClusters.h"
+
+// avatars are attenuated as they turn away from the listener (see computeGain), which is unknown for a premix:
+// use the attenuation of a source facing sideways
+static const float CLUSTER_OFF_AXIS_ATTENUATION = 0.6f;
+
+static uint64_t packCellCoordinates(const glm::ivec3& coordinates) {
+    const uint64_t MASK = (1 << 21) - 1;
+    return (((uint64_t)coordinates.x & MASK) << 42) | (((uint64_t)coordinates.y & MASK) << 21) | ((uint64_t)coordinates.z & MASK);
+}
+
+void AudioMixerClusters::prepare(ConstIter begin, ConstIter end) {
+    _cells.clear();
+    _cellIndices.clear();
+    _streamCells.clear();
+
+    if (!_isEnabled) {
+        return;
+    }
+
+    int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        for (auto& streamPair : nodeData->getAudioStreams()) {
+            const PositionalAudioStream* stream = streamPair.second.get();
+
+            // stereo streams are not spatialized, and repeated or faded frames are left to the regular mix
+            if (!stream->lastPopSucceeded() || stream->isStereo()) {
+                continue;
+            }
+
+            glm::ivec3 coordinates { glm::floor(stream->getPosition() / _cellSize) };
+            auto key = packCellCoordinates(coordinates);
+
+            auto it = _cellIndices.find(key);
+            if (it == _cellIndices.end()) {
+                it = _cellIndices.insert({ key, (int)_cells.size() }).first;
+                _cells.emplace_back();
+                _cells.back().position = glm::vec3(0.0f);
+                memset(_cells.back().samples, 0, sizeof(_cells.back().samples));
+            }
+
+            int index = it->second;
+            Cell& cell = _cells[index];
+            cell.position += stream->getPosition();
+            cell.streams.push_back(stream);
+            _streamCells[stream] = index;
+
+            if (stream->getLastPopOutputLoudness() > 0.0f) {
+                AudioRingBuffer::ConstIterator streamPopOutput = stream->getLastPopOutput();
+                streamPopOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+                float gain = premixGain(*stream) / AudioConstants::MAX_SAMPLE_VALUE;
+                for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+                    cell.samples[i] += samples[i] * gain;
+                }
+            }
+        }
+    });
+
+    for (auto& cell : _cells) {
+        cell.position /= (float)cell.streams.size();
+    }
+}
+
+int AudioMixerClusters::cellForStream(const PositionalAudioStream* stream) const {
+    auto it = _streamCells.find(stream);
+    return it != _streamCells.end() ? it->second : NO_CELL;
+}
+
+bool AudioMixerClusters::isCellDistant(int index, const glm::vec3& listenerPosition) const {
+    return glm::distance(_cells[index].position, listenerPosition) > _radius;
+}
+
+float AudioMixerClusters::premixGain(const PositionalAudioStream& stream) {
+    // only injectors carry their own attenuation, and only InjectedAudioStreams are of the Injector type
+    if (stream.getType() == PositionalAudioStream::Injector) {
+        return static_cast<const InjectedAudioStream&>(stream).getAttenuationRatio();
+    }
+    return CLUSTER_OFF_AXIS_ATTENUATION;
+}
@@ -0,0 +1,76 @@
+//
+//  AudioMixerClusters.h
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerClusters_h
+#define hifi_AudioMixerClusters_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AudioConstants.h>
+#include <NodeList.h>
+
+class PositionalAudioStream;
+
+// Shared "mix-once" premixes of distant streams, for large crowds
+//   Mono streams are binned into the cells of a grid, and once per frame each cell's streams are summed into a premix
+//   (with the parts of their gain that do not depend on the listener). Listeners beyond the cluster radius of a cell
+//   hear its premix through a first-order ambisonic bed, one AudioFOA decode for all of their distant cells,
+//   instead of one HRTF per stream.
+//   prepare is called from the mixer thread before mixing; during the mix the slaves only read.
+class AudioMixerClusters {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Cell {
+        glm::vec3 position; // average position of the cell's streams
+        std::vector<const PositionalAudioStream*> streams;
+        float samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    };
+
+    static const int NO_CELL = -1;
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    // cells closer than this to a listener are mixed stream by stream
+    void setRadius(float radius) { _radius = radius; }
+    float getRadius() const { return _radius; }
+
+    void setCellSize(float cellSize) { _cellSize = cellSize; }
+    float getCellSize() const { return _cellSize; }
+
+    // bin this frame's streams and premix each cell (requires streams to have been popped for the frame)
+    void prepare(ConstIter begin, ConstIter end);
+
+    int getNumCells() const { return (int)_cells.size(); }
+    const Cell& getCell(int index) const { return _cells[index]; }
+
+    // returns the cell a stream was premixed into this frame, or NO_CELL if it must be mixed on its own
+    int cellForStream(const PositionalAudioStream* stream) const;
+
+    bool isCellDistant(int index, const glm::vec3& listenerPosition) const;
+
+    // the gain applied to a stream in its cell's premix
+    static float premixGain(const PositionalAudioStream& stream);
+
+private:
+    bool _isEnabled { false };
+    float _radius { 20.0f };
+    float _cellSize { 10.0f };
+
+    std::vector<Cell> _cells;
+    std::unordered_map<uint64_t, int> _cellIndices; // packed grid coordinates to index in _cells
+    std::unordered_map<const PositionalAudioStream*, int> _streamCells;
+};
+
+#endif // hifi_AudioMixerClusters_h
@@ -20,6 +20,7 @@
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
+#include <PortableHighResolutionClock.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
@@ -33,12 +34,33 @@
 #include "AvatarAudioStream.h"
 #include "InjectedAudioStream.h"
 #include "AudioHelpers.h"
+#include "AudioMixerClusters.h"
 
 #include "AudioMixerSlave.h"
 
 using AudioStreamMap = AudioMixerClientData::AudioStreamMap;
 
 // packet helpers
+void AudioMixerSlave::mixBridge(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream) {
+    AudioMixerStats::StageTimer timer(stats.streamTime);
+    auto& bridge = AudioMixer::getBridge();
+
+    memcpy(_bridgeBedSamples, bridge.getBed(), sizeof(_bridgeBedSamples));
+
+    // the bed is in world coordinates, rotate it to the listener's (and from Y-up to the Z-up of ambisonics)
+    glm::quat relativeOrientation = glm::inverse(listenerStream.getOrientation());
+    float qw = relativeOrientation.w;
+    float qx = -relativeOrientation.z;
+    float qy = -relativeOrientation.x;
+    float qz = relativeOrientation.y;
+
+    const int FOA_DATASET_INDEX = 1;
+    listenerData.bridgeFOA.render(_bridgeBedSamples, _mixSamples, FOA_DATASET_INDEX, qw, qx, qy, qz,
+                                  AudioMixerBridge::getBedHeadroom(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    ++stats.bridgeRenders;
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
 void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
 void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
@@ -56,15 +78,42 @@ inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
+        AudioMixerStats::StageTimer timer(stats.packetsTime);
         data->processPackets();
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+bool EncodedMixCache::find(Encoder* encoder, const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto range = _entries.equal_range(qHash(decodedBuffer));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.encoder == encoder && it->second.decodedBuffer == decodedBuffer) {
+            encodedBuffer = it->second.encodedBuffer;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EncodedMixCache::insert(Encoder* encoder, const QByteArray& decodedBuffer, const QByteArray& encodedBuffer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.emplace(qHash(decodedBuffer), Entry { encoder, decodedBuffer, encodedBuffer });
+}
+
+void EncodedMixCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
+
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+        EncodedMixCache* encodedMixCache) {
     _begin = begin;
     _end = end;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _encodedMixCache = encodedMixCache;
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -80,8 +129,11 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         return;
     }
 
+    auto listenerMixStart = p_high_resolution_clock::now();
+
     // send mute packet, if necessary
     if (AudioMixer::shouldMute(avatarStream->getQuietestFrameLoudness()) || data->shouldMuteClient()) {
+        AudioMixerStats::StageTimer timer(stats.sendTime);
         sendMutePacket(node, *data);
     }
 
@@ -90,26 +142,50 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         ++stats.sumListeners;
 
         // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        bool mixHasAudio;
+        {
+            AudioMixerStats::StageTimer timer(stats.prepareMixTime);
+            mixHasAudio = prepareMix(node);
+        }
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
             QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
+            {
+                AudioMixerStats::StageTimer timer(stats.encodeTime);
+                if (mixHasAudio) {
+                    QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+
+                    // stateful encoders are created per listener and can never match another listener, and the cheap
+                    // ones cost less to run than to look up, so only the shareable ones go through the cache
+                    Encoder* encoder = data->getEncoder();
+                    EncodedMixCache* encodedMixCache = (encoder && encoder->isShareable()) ? _encodedMixCache : nullptr;
+                    if (encodedMixCache && encodedMixCache->find(encoder, decodedBuffer, encodedBuffer)) {
+                        data->setShouldFlushEncoder(true);
+                        ++stats.sharedEncodedMixes;
+                    } else {
+                        data->encode(decodedBuffer, encodedBuffer);
+                        ++stats.encodedMixes;
+                        if (encodedMixCache) {
+                            encodedMixCache->insert(encoder, decodedBuffer, encodedBuffer);
+                        }
+                    }
+                } else {
+                    // time to flush (resets shouldFlush until the next encode)
+                    data->encodeFrameOfZeros(encodedBuffer);
+                }
             }
 
+            AudioMixerStats::StageTimer timer(stats.sendTime);
             sendMixPacket(node, *data, encodedBuffer);
         } else {
             ++stats.sumListenersSilent;
+            AudioMixerStats::StageTimer timer(stats.sendTime);
             sendSilentPacket(node, *data);
         }
 
+        AudioMixerStats::StageTimer timer(stats.sendTime);
+
         // send environment packet
         sendEnvironmentPacket(node, *data);
 
@@ -119,6 +195,9 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
             data->sendAudioStreamStatsPackets(node);
         }
     }
+
+    auto listenerMixTime = p_high_resolution_clock::now() - listenerMixStart;
+    data->setMixTime(std::chrono::duration_cast<std::chrono::nanoseconds>(listenerMixTime).count());
 }
 
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
@@ -131,16 +210,37 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     bool isThrottling = _throttlingRatio > 0.0f;
     std::vector<std::pair<float, SharedNodePointer>> throttledNodes;
 
+    bool isClustering = prepareClusters(*listenerAudioStream);
+
     typedef void (AudioMixerSlave::*MixFunctor)(
             AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const PositionalAudioStream&);
     auto forAllStreams = [&](const SharedNodePointer& node, AudioMixerClientData* nodeData, MixFunctor mixFunctor) {
         auto nodeID = node->getUUID();
         for (auto& streamPair : nodeData->getAudioStreams()) {
             auto nodeStream = streamPair.second;
+
+            if (isClustering && isInDistantCluster(*nodeStream)) {
+                // heard through its cluster, unless the listener adjusted its gain
+                if (listenerData->gainAdjustmentForStream(nodeID, nodeStream->getStreamIdentifier()) == 1.0f) {
+                    ++stats.clusterMixes;
+                    continue;
+                }
+                excludeFromClusters(*nodeStream);
+            }
+
             (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, *nodeStream);
         }
     };
 
+    // the listener's own streams and ignored streams can not be heard through the clusters either
+    auto excludeAllStreams = [&](AudioMixerClientData* nodeData) {
+        for (auto& streamPair : nodeData->getAudioStreams()) {
+            if (isInDistantCluster(*streamPair.second)) {
+                excludeFromClusters(*streamPair.second);
+            }
+        }
+    };
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     auto mixStart = p_high_resolution_clock::now();
 #endif
@@ -159,6 +259,10 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                     mixStream(*listenerData, node->getUUID(), *listenerAudioStream, *nodeStream);
                 }
             }
+
+            if (isClustering) {
+                excludeAllStreams(nodeData);
+            }
         } else if (!listenerData->shouldIgnore(listener, node, _frame)) {
             if (!isThrottling) {
                 forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
@@ -166,10 +270,15 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 auto nodeID = node->getUUID();
 
                 // compute the node's max relative volume
-                float nodeVolume;
+                float nodeVolume = 0.0f;
                 for (auto& streamPair : nodeData->getAudioStreams()) {
                     auto nodeStream = streamPair.second;
 
+                    // clustered streams do not count towards the node's volume
+                    if (isClustering && isInDistantCluster(*nodeStream)) {
+                        continue;
+                    }
+
                     // approximate the gain
                     glm::vec3 relativePosition = nodeStream->getPosition() - listenerAudioStream->getPosition();
                     float gain = approximateGain(*listenerAudioStream, *nodeStream, relativePosition);
@@ -188,6 +297,8 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                     std::push_heap(throttledNodes.begin(), throttledNodes.end());
                 }
             }
+        } else if (isClustering) {
+            excludeAllStreams(nodeData);
         }
     });
 
@@ -216,6 +327,14 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         }
     }
 
+    if (isClustering) {
+        mixClusters(*listenerData, *listenerAudioStream);
+    }
+
+    if (AudioMixer::getBridge().hasBed()) {
+        mixBridge(*listenerData, *listenerAudioStream);
+    }
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     auto mixEnd = p_high_resolution_clock::now();
     auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
@@ -251,6 +370,7 @@ void AudioMixerSlave::mixStream(AudioMixerClientData& listenerNodeData, const QU
 void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
         const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         bool throttle) {
+    AudioMixerStats::StageTimer timer(stats.streamTime);
     ++stats.totalMixes;
 
     // to reduce artifacts we call the HRTF functor for every source, even if throttled or silent
@@ -357,6 +477,103 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     ++stats.hrtfRenders;
 }
 
+bool AudioMixerSlave::prepareClusters(const AvatarAudioStream& listenerStream) {
+    auto& clusters = AudioMixer::getClusters();
+
+    _excludedClusterStreams.clear();
+    _distantCells.assign(clusters.getNumCells(), false);
+
+    bool hasDistantCells = false;
+    for (int i = 0; i < clusters.getNumCells(); ++i) {
+        if (clusters.isCellDistant(i, listenerStream.getPosition())) {
+            _distantCells[i] = true;
+            hasDistantCells = true;
+        }
+    }
+
+    return hasDistantCells;
+}
+
+bool AudioMixerSlave::isInDistantCluster(const PositionalAudioStream& streamer) const {
+    int cell = AudioMixer::getClusters().cellForStream(&streamer);
+    return cell != AudioMixerClusters::NO_CELL && _distantCells[cell];
+}
+
+void AudioMixerSlave::excludeFromClusters(const PositionalAudioStream& streamer) {
+    _excludedClusterStreams.push_back(&streamer);
+}
+
+void AudioMixerSlave::mixClusters(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream) {
+    AudioMixerStats::StageTimer timer(stats.streamTime);
+    auto& clusters = AudioMixer::getClusters();
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    // the bed is quantized for AudioFOA, leave headroom for loud crowds
+    const float BED_HEADROOM = 4.0f;
+
+    memset(_clusterBed, 0, sizeof(_clusterBed));
+
+    glm::quat inverseOrientation = glm::inverse(listenerStream.getOrientation());
+
+    // encodes a cell's direction into the ambisonic bed (ambiX: W, Y, Z, X)
+    auto encode = [&](int cellIndex, const float* samples, float gain) {
+        glm::vec3 relativePosition = clusters.getCell(cellIndex).position - listenerStream.getPosition();
+        float distance = glm::max(glm::length(relativePosition), EPSILON);
+        glm::vec3 direction = inverseOrientation * (relativePosition / distance);
+
+        gain *= computeDistanceAttenuation(listenerStream.getPosition(), clusters.getCell(cellIndex).position, distance);
+
+        // listener coordinates to ambisonic (X front, Y left, Z up)
+        float w = gain;
+        float y = gain * -direction.x;
+        float z = gain * direction.y;
+        float x = gain * -direction.z;
+
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            _clusterBed[4*i+0] += w * samples[i];
+            _clusterBed[4*i+1] += y * samples[i];
+            _clusterBed[4*i+2] += z * samples[i];
+            _clusterBed[4*i+3] += x * samples[i];
+        }
+    };
+
+    for (int i = 0; i < clusters.getNumCells(); ++i) {
+        if (_distantCells[i]) {
+            encode(i, clusters.getCell(i).samples, 1.0f);
+        }
+    }
+
+    // take out what the listener must not hear, or hears on its own
+    float excludedSamples[NUM_FRAMES];
+    for (auto stream : _excludedClusterStreams) {
+        if (stream->getLastPopOutputLoudness() == 0.0f) {
+            continue;
+        }
+
+        AudioRingBuffer::ConstIterator streamPopOutput = stream->getLastPopOutput();
+        streamPopOutput.readSamples(_bufferSamples, NUM_FRAMES);
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            excludedSamples[i] = _bufferSamples[i] / (float)AudioConstants::MAX_SAMPLE_VALUE;
+        }
+
+        encode(clusters.cellForStream(stream), excludedSamples, -AudioMixerClusters::premixGain(*stream));
+    }
+
+    const float SCALE = AudioConstants::MAX_SAMPLE_VALUE / BED_HEADROOM;
+    for (int i = 0; i < 4 * NUM_FRAMES; ++i) {
+        float sample = glm::clamp(_clusterBed[i] * SCALE, (float)AudioConstants::MIN_SAMPLE_VALUE,
+                                  (float)AudioConstants::MAX_SAMPLE_VALUE);
+        _clusterBedSamples[i] = (int16_t)sample;
+    }
+
+    // the bed is already in listener coordinates
+    const int FOA_DATASET_INDEX = 1;
+    listenerData.clusterFOA.render(_clusterBedSamples, _mixSamples, FOA_DATASET_INDEX, 1.0f, 0.0f, 0.0f, 0.0f,
+                                   BED_HEADROOM, NUM_FRAMES);
+
+    ++stats.clusterRenders;
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -374,8 +591,8 @@ void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QB
     // pack samples
     mixPacket->write(buffer.constData(), buffer.size());
 
-    // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    // queue packet, it is sent with the rest of this frame's mix
+    DependencyManager::get<NodeList>()->queuePacket(std::move(mixPacket), *node);
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
@@ -389,14 +606,14 @@ void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data)
     // pack number of samples
     mixPacket->writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
-    // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    // queue packet, it is sent with the rest of this frame's mix
+    DependencyManager::get<NodeList>()->queuePacket(std::move(mixPacket), *node);
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData& data) {
     auto mutePacket = NLPacket::create(PacketType::NoisyMute, 0);
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mutePacket), *node);
+    DependencyManager::get<NodeList>()->queuePacket(std::move(mutePacket), *node);
 
     // probably now we just reset the flag, once should do it (?)
     data.setShouldMuteClient(false);
@@ -407,15 +624,13 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
     float reverbTime, wetLevel;
 
     auto& reverbSettings = AudioMixer::getReverbSettings();
-    auto& audioZones = AudioMixer::getAudioZones();
 
     AvatarAudioStream* stream = data.getAvatarAudioStream();
     glm::vec3 streamPosition = stream->getPosition();
 
     // find reverb properties
     for (int i = 0; i < reverbSettings.size(); ++i) {
-        AABox box = audioZones[reverbSettings[i].zone];
-        if (box.contains(streamPosition)) {
+        if (reverbSettings[i].zoneBox.contains(streamPosition)) {
             hasReverb = true;
             reverbTime = reverbSettings[i].reverbTime;
             wetLevel = reverbSettings[i].wetLevel;
@@ -459,7 +674,7 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
         }
 
         // send the packet
-        DependencyManager::get<NodeList>()->sendPacket(std::move(envPacket), *node);
+        DependencyManager::get<NodeList>()->queuePacket(std::move(envPacket), *node);
     }
 }
 
@@ -504,14 +719,21 @@ float computeGain(const AvatarAudioStream& listeningNodeStream, const Positional
         gain *= offAxisCoefficient;
     }
 
+    gain *= computeDistanceAttenuation(listeningNodeStream.getPosition(), streamToAdd.getPosition(),
+                                       glm::length(relativePosition));
+
+    return gain;
+}
+
+float computeDistanceAttenuation(const glm::vec3& listenerPosition, const glm::vec3& sourcePosition, float distance) {
     auto& audioZones = AudioMixer::getAudioZones();
     auto& zoneSettings = AudioMixer::getZoneSettings();
 
     // find distance attenuation coefficient
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (int i = 0; i < zoneSettings.length(); ++i) {
-        if (audioZones[zoneSettings[i].source].contains(streamToAdd.getPosition()) &&
-            audioZones[zoneSettings[i].listener].contains(listeningNodeStream.getPosition())) {
+        if (audioZones[zoneSettings[i].source].contains(sourcePosition) &&
+            audioZones[zoneSettings[i].listener].contains(listenerPosition)) {
             attenuationPerDoublingInDistance = zoneSettings[i].coefficient;
             break;
         }
@@ -519,7 +741,6 @@ float computeGain(const AvatarAudioStream& listeningNodeStream, const Positional
 
     // distance attenuation
     const float ATTENUATION_START_DISTANCE = 1.0f;
-    float distance = glm::length(relativePosition);
     assert(ATTENUATION_START_DISTANCE > EPSILON);
     if (distance >= ATTENUATION_START_DISTANCE) {
 
@@ -528,13 +749,10 @@ float computeGain(const AvatarAudioStream& listeningNodeStream, const Positional
         g = glm::clamp(g, EPSILON, 1.0f);
 
         // calculate the distance coefficient using the distance to this node
-        float distanceCoefficient = fastExp2f(fastLog2f(g) * fastLog2f(distance/ATTENUATION_START_DISTANCE));
-
-        // multiply the current attenuation coefficient by the distance coefficient
-        gain *= distanceCoefficient;
+        return fastExp2f(fastLog2f(g) * fastLog2f(distance/ATTENUATION_START_DISTANCE));
     }
 
-    return gain;
+    return 1.0f;
 }
 
 float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
@@ -12,12 +12,16 @@
 #ifndef hifi_AudioMixerSlave_h
 #define hifi_AudioMixerSlave_h
 
+#include <mutex>
+#include <unordered_map>
+
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 #include <NodeList.h>
+#include <plugins/CodecPlugin.h>
 
 #include "AudioMixerStats.h"
 
@@ -26,6 +30,29 @@ class AvatarAudioStream;
 class AudioHRTF;
 class AudioMixerClientData;
 
+// Frames encoded by shareable encoders (see Encoder::isShareable) during a round of mixing, so that listeners with
+// identical mixes (everyone in the same spot hearing the same sources, or the same unattenuated zone) are only
+// encoded once.
+// Safe to use from all slaves at once.
+class EncodedMixCache {
+public:
+    // returns true and the encoded frame if this mix was already encoded with this encoder
+    bool find(Encoder* encoder, const QByteArray& decodedBuffer, QByteArray& encodedBuffer);
+    void insert(Encoder* encoder, const QByteArray& decodedBuffer, const QByteArray& encodedBuffer);
+
+    void clear();
+
+private:
+    struct Entry {
+        Encoder* encoder;
+        QByteArray decodedBuffer;
+        QByteArray encodedBuffer;
+    };
+
+    std::mutex _mutex;
+    std::unordered_multimap<uint, Entry> _entries;
+};
+
 class AudioMixerSlave {
 public:
     using ConstIter = NodeList::const_iterator;
@@ -34,7 +61,8 @@ public:
     void processPackets(const SharedNodePointer& node);
 
     // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+            EncodedMixCache* encodedMixCache = nullptr);
 
     // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
     // returns true if a mixed packet was sent to the node
@@ -53,15 +81,35 @@ private:
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
             bool throttle);
 
+    // distant clusters (see AudioMixerClusters), returns true if the listener has any
+    bool prepareClusters(const AvatarAudioStream& listenerStream);
+    bool isInDistantCluster(const PositionalAudioStream& streamer) const;
+    void excludeFromClusters(const PositionalAudioStream& streamer);
+    void mixClusters(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream);
+
+    // the beds of the other regions (see AudioMixerBridge)
+    void mixBridge(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream);
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // cluster state, per listener
+    std::vector<bool> _distantCells;
+    std::vector<const PositionalAudioStream*> _excludedClusterStreams; // premixed streams the listener must not hear
+    float _clusterBed[4 * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    int16_t _clusterBedSamples[4 * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    int16_t _bridgeBedSamples[4 * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    EncodedMixCache* _encodedMixCache { nullptr };
 };
 
+// the attenuation of a source at a distance from a listener, with the coefficients of their audio zones
+float computeDistanceAttenuation(const glm::vec3& listenerPosition, const glm::vec3& sourcePosition, float distance);
+
 #endif // hifi_AudioMixerSlave_h
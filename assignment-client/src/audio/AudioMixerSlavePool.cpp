@@ -11,9 +11,50 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <queue>
+
+#include <QtCore/QtGlobal>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "AudioMixerClientData.h"
 
 #include "AudioMixerSlavePool.h"
 
+// returns false if the platform does not support it (macOS only has affinity hints)
+static bool setCurrentThreadAffinity(int core, bool pin) {
+    int numCores = QThread::idealThreadCount();
+    if (numCores < 1) {
+        return false;
+    }
+    core %= numCores;
+
+#if defined(Q_OS_WIN)
+    DWORD_PTR processAffinity = 0, systemAffinity = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &processAffinity, &systemAffinity);
+    DWORD_PTR mask = pin ? ((DWORD_PTR)1 << core) : processAffinity;
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(Q_OS_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (pin) {
+        CPU_SET(core, &cpuSet);
+    } else {
+        for (int i = 0; i < numCores; ++i) {
+            CPU_SET(i, &cpuSet);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    return false;
+#endif
+}
+
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
@@ -46,6 +87,8 @@ void AudioMixerSlaveThread::wait() {
         _pool._configure(*this);
     }
     _function = _pool._function;
+
+    updateAffinity();
 }
 
 void AudioMixerSlaveThread::notify(bool stopping) {
@@ -61,31 +104,75 @@ void AudioMixerSlaveThread::notify(bool stopping) {
 }
 
 bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        if (!_queue.empty()) {
+            node = std::move(_queue.front());
+            _queue.pop_front();
+            return true;
+        }
+    }
+
+    return try_steal(node);
+}
+
+bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node) {
+    // start with the next slave, so that thieves spread out over their victims
+    int numSlaves = (int)_pool._slaves.size();
+    for (int i = 1; i < numSlaves; ++i) {
+        auto& victim = *_pool._slaves[(_index + i) % numSlaves];
+
+        std::lock_guard<std::mutex> lock(victim._queueMutex);
+        if (!victim._queue.empty()) {
+            // the back holds the victim's cheapest nodes, which keeps the imbalance from a steal small
+            node = std::move(victim._queue.back());
+            victim._queue.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AudioMixerSlaveThread::updateAffinity() {
+    bool shouldPin = _pool._pinThreads;
+    if (shouldPin != _isPinned) {
+        if (!setCurrentThreadAffinity(_index, shouldPin) && shouldPin) {
+            qWarning("%s: could not pin slave %d", __FUNCTION__, _index);
+        }
+        _isPinned = shouldPin;
+    }
 }
 
 #ifdef AUDIO_SINGLE_THREADED
 static AudioMixerSlave slave;
 #endif
 
-void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end, std::function<void()> overlap) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    // the cost of a node's packets is not tracked, so nodes are simply spread evenly
+    _cost = [](const SharedNodePointer& node) -> uint64_t { return 1; };
+    run(begin, end, overlap);
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
     _function = &AudioMixerSlave::mix;
     _configure = [&](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, _frame, _throttlingRatio);
+        slave.configureMix(_begin, _end, _frame, _throttlingRatio, &_encodedMixCache);
+    };
+    _cost = [](const SharedNodePointer& node) -> uint64_t {
+        auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        return data ? data->getMixTime() : 0;
     };
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _encodedMixCache.clear();
 
     run(begin, end);
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, std::function<void()> overlap) {
     _begin = begin;
     _end = end;
 
@@ -94,11 +181,11 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
     std::for_each(begin, end, [&](const SharedNodePointer& node) {
         _function(slave, node);
     });
+    if (overlap) {
+        overlap();
+    }
 #else
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.emplace(node);
-    });
+    partition(_begin, _end);
 
     {
         Lock lock(_mutex);
@@ -106,6 +193,15 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         // run
         _numStarted = _numFinished = 0;
         _slaveCondition.notify_all();
+    }
+
+    // work on this thread while the slaves run
+    if (overlap) {
+        overlap();
+    }
+
+    {
+        Lock lock(_mutex);
 
         // wait
         _poolCondition.wait(lock, [&] {
@@ -116,8 +212,42 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+#ifndef NDEBUG
+    for (auto& slave : _slaves) {
+        assert(slave->_queue.empty());
+    }
 #endif
+#endif
+}
+
+void AudioMixerSlavePool::partition(ConstIter begin, ConstIter end) {
+    // longest processing time first: the most expensive node goes to the least loaded slave
+    std::vector<std::pair<uint64_t, SharedNodePointer>> nodes;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        // nodes without a cost yet still count for something, so they are spread out
+        nodes.emplace_back(std::max<uint64_t>(_cost(node), 1), node);
+    });
+    std::stable_sort(nodes.begin(), nodes.end(), [](const std::pair<uint64_t, SharedNodePointer>& a,
+            const std::pair<uint64_t, SharedNodePointer>& b) {
+        return a.first > b.first;
+    });
+
+    using Load = std::pair<uint64_t, int>; // total cost, slave index
+    std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+    for (int i = 0; i < (int)_slaves.size(); ++i) {
+        loads.emplace(0, i);
+    }
+
+    for (auto& node : nodes) {
+        auto load = loads.top();
+        loads.pop();
+
+        // slaves are waiting, their queues need no lock here
+        _slaves[load.second]->_queue.push_back(std::move(node.second));
+
+        load.first += node.first;
+        loads.push(load);
+    }
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -163,7 +293,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this);
+            auto slave = new AudioMixerSlaveThread(*this, (int)_slaves.size());
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -13,11 +13,10 @@
 #define hifi_AudioMixerSlavePool_h
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <vector>
 
-#include <tbb/concurrent_queue.h>
-
 #include <QThread>
 
 #include "AudioMixerSlave.h"
@@ -31,7 +30,7 @@ class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool) : _pool(pool) {}
+    AudioMixerSlaveThread(AudioMixerSlavePool& pool, int index) : _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -40,17 +39,29 @@ private:
 
     void wait();
     void notify(bool stopping);
+
+    // takes the next node from this slave's queue, or steals one from another slave once it is empty
     bool try_pop(SharedNodePointer& node);
+    bool try_steal(SharedNodePointer& node);
+
+    void updateAffinity();
 
     AudioMixerSlavePool& _pool;
+    const int _index;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
+    bool _isPinned { false };
+
+    // filled by the pool before each run: this slave pops from the front, others steal from the back
+    std::deque<SharedNodePointer> _queue;
+    std::mutex _queueMutex;
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
+//   Nodes are partitioned across slaves by their cost last frame (heaviest first, onto the least loaded slave), and
+//   slaves that run out of nodes steal from the others.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -61,8 +72,8 @@ public:
     AudioMixerSlavePool(int numThreads = QThread::idealThreadCount()) { setNumThreads(numThreads); }
     ~AudioMixerSlavePool() { resize(0); }
 
-    // process packets on slave threads
-    void processPackets(ConstIter begin, ConstIter end);
+    // process packets on slave threads, calling overlap on this thread meanwhile (it must not touch the nodes' data)
+    void processPackets(ConstIter begin, ConstIter end, std::function<void()> overlap = nullptr);
 
     // mix on slave threads
     void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
@@ -73,15 +84,21 @@ public:
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
+    // pin each slave thread to its own core (slaves beyond the core count wrap around)
+    void setPinThreads(bool pinThreads) { _pinThreads = pinThreads; }
+    bool getPinThreads() const { return _pinThreads; }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, std::function<void()> overlap = nullptr);
+    void partition(ConstIter begin, ConstIter end);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
 
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node);
+    friend void AudioMixerSlaveThread::updateAffinity();
 
     // synchronization state
     Mutex _mutex;
@@ -89,15 +106,17 @@ private:
     ConditionVariable _poolCondition;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node);
     std::function<void(AudioMixerSlave&)> _configure;
+    std::function<uint64_t(const SharedNodePointer& node)> _cost;
+    bool _pinThreads { false };
     int _numThreads { 0 };
     int _numStarted { 0 }; // guarded by _mutex
     int _numFinished { 0 }; // guarded by _mutex
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    EncodedMixCache _encodedMixCache;
     ConstIter _begin;
     ConstIter _end;
 };
@@ -21,6 +21,16 @@ void AudioMixerStats::reset() {
     hrtfThrottleRenders = 0;
     manualStereoMixes = 0;
     manualEchoMixes = 0;
+    clusterMixes = 0;
+    clusterRenders = 0;
+    bridgeRenders = 0;
+    encodedMixes = 0;
+    sharedEncodedMixes = 0;
+    packetsTime = 0;
+    prepareMixTime = 0;
+    streamTime = 0;
+    encodeTime = 0;
+    sendTime = 0;
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -36,6 +46,16 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfThrottleRenders += otherStats.hrtfThrottleRenders;
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
+    clusterMixes += otherStats.clusterMixes;
+    clusterRenders += otherStats.clusterRenders;
+    bridgeRenders += otherStats.bridgeRenders;
+    encodedMixes += otherStats.encodedMixes;
+    sharedEncodedMixes += otherStats.sharedEncodedMixes;
+    packetsTime += otherStats.packetsTime;
+    prepareMixTime += otherStats.prepareMixTime;
+    streamTime += otherStats.streamTime;
+    encodeTime += otherStats.encodeTime;
+    sendTime += otherStats.sendTime;
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
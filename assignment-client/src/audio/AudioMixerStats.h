@@ -12,9 +12,9 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
+
+#include <PortableHighResolutionClock.h>
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -30,12 +30,38 @@ struct AudioMixerStats {
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    int clusterMixes { 0 }; // streams heard through a cluster premix instead of their own HRTF
+    int clusterRenders { 0 };
+    int bridgeRenders { 0 }; // listeners who heard the beds of other regions
+
+    int encodedMixes { 0 };
+    int sharedEncodedMixes { 0 }; // mixes identical to one already encoded this frame with the same encoder
+
+    // time spent in each stage, in nanoseconds summed over slaves (streamTime is a part of prepareMixTime)
+    uint64_t packetsTime { 0 };
+    uint64_t prepareMixTime { 0 };
+    uint64_t streamTime { 0 }; // gains and HRTF (or cluster) renders
+    uint64_t encodeTime { 0 };
+    uint64_t sendTime { 0 };
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
 
     void reset();
     void accumulate(const AudioMixerStats& otherStats);
+
+    // adds the time spent in its scope to one of the stage times
+    class StageTimer {
+    public:
+        StageTimer(uint64_t& sum) : _sum(sum), _start(p_high_resolution_clock::now()) {}
+        ~StageTimer() {
+            _sum += std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - _start).count();
+        }
+    private:
+        uint64_t& _sum;
+        p_high_resolution_clock::time_point _start;
+    };
 };
 
 #endif // hifi_AudioMixerStats_h
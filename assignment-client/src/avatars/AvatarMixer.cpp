@@ -25,6 +25,7 @@
 #include <AABox.h>
 #include <AvatarLogging.h>
 #include <LogHandler.h>
+#include <Metrics.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
@@ -53,6 +54,11 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::NodeIgnoreRequest, this, "handleNodeIgnoreRequestPacket");
     packetReceiver.registerListener(PacketType::RadiusIgnoreRequest, this, "handleRadiusIgnoreRequestPacket");
     packetReceiver.registerListener(PacketType::RequestsDomainListData, this, "handleRequestsDomainListDataPacket");
+    packetReceiver.registerListener(PacketType::ForwardedAvatarData, this, "handleForwardedAvatarDataPacket");
+
+    _federation.linkedDataCreateCallback = [this](const SharedNodePointer& node) {
+        getOrCreateClientData(node);
+    };
 
     auto nodeList = DependencyManager::get<NodeList>();
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
@@ -70,12 +76,9 @@ AvatarMixer::~AvatarMixer() {
 }
 
 void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
-    QByteArray individualData = nodeData->getAvatar().identityByteArray();
-
-    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size());
-
-    individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122());
+    const QByteArray& individualData = nodeData->getIdentityPacketData();
 
+    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size(), true);
     identityPacket->write(individualData);
 
     DependencyManager::get<NodeList>()->sendPacket(std::move(identityPacket), *destinationNode);
@@ -83,6 +86,40 @@ void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const Shar
     ++_sumIdentityPackets;
 }
 
+// identities are larger than avatar data and rarely urgent, so a crowd arriving at once is introduced over a few frames
+static const int MAX_IDENTITY_PACKETS_PER_NODE_PER_FRAME = 4;
+
+void AvatarMixer::sendQueuedIdentityPackets(NodeList::const_iterator begin, NodeList::const_iterator end) {
+    // the node list is already locked, so look the other avatars up here rather than through nodeWithUUID
+    std::unordered_map<QUuid, AvatarMixerClientData*> avatars;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+        if (nodeData) {
+            avatars[node->getUUID()] = nodeData;
+        }
+    });
+    for (const auto& node : _federation.getRemoteNodes()) {
+        avatars[node->getUUID()] = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+    }
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+        if (!nodeData || !node->getActiveSocket()) {
+            return;
+        }
+
+        QUuid otherID;
+        int numSent = 0;
+        while (numSent < MAX_IDENTITY_PACKETS_PER_NODE_PER_FRAME && nodeData->dequeueIdentityPacket(otherID)) {
+            auto it = avatars.find(otherID);
+            if (it != avatars.end()) {
+                sendIdentityPacket(it->second, node);
+                ++numSent;
+            }
+        }
+    });
+}
+
 std::chrono::microseconds AvatarMixer::timeFrame(p_high_resolution_clock::time_point& timestamp) {
     // advance the next frame
     auto nextTimestamp = timestamp + std::chrono::microseconds((int)((float)USECS_PER_SECOND / (float)AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND));
@@ -107,13 +144,30 @@ void AvatarMixer::start() {
 
     auto nodeList = DependencyManager::get<NodeList>();
 
+    // kill and bubble packets are small - pack them per avatar, flushed after every broadcast
+    nodeList->setPacketCoalescingEnabled(true);
+
+    // every inbound packet is hash verified, keep that off the thread reading the socket
+    nodeList->setPacketFilterOnWorkerThread(true);
+
+    // the mixers of a federation are all connected to each other
+    if (_federation.isEnabled()) {
+        nodeList->removeSoloNodeType(NodeType::AvatarMixer);
+    }
+
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
 
+    auto& metricsRegistry = metrics::Registry::getInstance();
+    auto& avatarsMetric = metricsRegistry.gauge("avatar_mixer_avatars");
+    auto& remoteAvatarsMetric = metricsRegistry.gauge("avatar_mixer_remote_avatars");
+    auto& broadcastUsecsMetric = metricsRegistry.histogram("avatar_mixer_broadcast_usecs", { 500, 1000, 2000, 5000, 10000 });
+
     while (!_isFinished) {
 
         auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
         throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
+        recordFrame(frameDuration.count());
 
         int lockWait, nodeTransform, functor;
 
@@ -150,9 +204,33 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
-                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
+
+                // the encodings cached while broadcasting the last frame are stale now that packets were processed
+                auto clearAvatarDataCache = [](const SharedNodePointer& node) {
+                    auto nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+                    if (nodeData) {
+                        nodeData->clearAvatarDataCache();
+                    }
+                };
+                std::for_each(cbegin, cend, clearAvatarDataCache);
+
+                const auto& remoteNodes = _federation.getRemoteNodes();
+                avatarsMetric.set(std::distance(cbegin, cend));
+                remoteAvatarsMetric.set(remoteNodes.size());
+                std::for_each(remoteNodes.cbegin(), remoteNodes.cend(), clearAvatarDataCache);
+
+                _grid.prepare(cbegin, cend);
+                for (const auto& remoteNode : remoteNodes) {
+                    _grid.addNode(remoteNode);
+                }
+                _slavePool.broadcastAvatarData(cbegin, cend, _grid, remoteNodes, _lastFrameTimestamp,
+                    _maxKbpsPerNode, _throttlingRatio);
+
+                // the other mixers get the same encodings the listeners just got, when they are the same
+                _federation.forwardAvatars(cbegin, cend);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
+                broadcastUsecsMetric.observe((double)(end - start));
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
@@ -160,6 +238,19 @@ void AvatarMixer::start() {
             _broadcastAvatarDataLockWait += lockWait;
             _broadcastAvatarDataNodeTransform += nodeTransform;
             _broadcastAvatarDataNodeFunctor += functor;
+
+            // write out all of the avatar data the slaves queued for this frame
+            nodeList->flushQueuedPackets();
+        }
+
+        // send the identities the slaves found out of date, now that the avatar data is on its way
+        {
+            auto start = usecTimestampNow();
+            nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                sendQueuedIdentityPackets(cbegin, cend);
+            }, &lockWait, &nodeTransform, &functor);
+            auto end = usecTimestampNow();
+            _sendIdentityPacketsElapsedTime += (end - start);
         }
 
         ++frame;
@@ -272,8 +363,6 @@ void AvatarMixer::throttle(std::chrono::microseconds duration, int frame) {
 void AvatarMixer::nodeKilled(SharedNodePointer killedNode) {
     if (killedNode->getType() == NodeType::Agent
         && killedNode->getLinkedData()) {
-        auto nodeList = DependencyManager::get<NodeList>();
-
         {  // decrement sessionDisplayNames table and possibly remove
            QMutexLocker nodeDataLocker(&killedNode->getLinkedData()->getMutex());
            AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(killedNode->getLinkedData());
@@ -284,36 +373,52 @@ void AvatarMixer::nodeKilled(SharedNodePointer killedNode) {
            }
         }
 
-        // this was an avatar we were sending to other people
-        // send a kill packet for it to our other nodes
-        auto killPacket = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason));
-        killPacket->write(killedNode->getUUID().toRfc4122());
-        killPacket->writePrimitive(KillAvatarReason::AvatarDisconnected);
+        // this was an avatar we were sending to other people, and to the other mixers
+        _federation.removeLocalAvatar(killedNode->getUUID());
+        NodeSet destinationTypes = NodeSet() << NodeType::Agent;
+        if (_federation.isEnabled()) {
+            destinationTypes << NodeType::AvatarMixer;
+        }
+        avatarLeft(killedNode->getUUID(), destinationTypes);
+    } else if (killedNode->getType() == NodeType::AvatarMixer) {
+        // the avatars of that mixer went with it
+        for (const auto& avatarID : _federation.removePeer(killedNode->getUUID())) {
+            avatarLeft(avatarID, NodeSet() << NodeType::Agent);
+        }
+    }
+}
 
-        nodeList->broadcastToNodes(std::move(killPacket), NodeSet() << NodeType::Agent);
+void AvatarMixer::avatarLeft(const QUuid& avatarID, const NodeSet& destinationTypes) {
+    auto nodeList = DependencyManager::get<NodeList>();
 
-        // we also want to remove sequence number data for this avatar on our other avatars
-        // so invoke the appropriate method on the AvatarMixerClientData for other avatars
-        nodeList->eachMatchingNode(
-            [&](const SharedNodePointer& node)->bool {
-                if (!node->getLinkedData()) {
-                    return false;
-                }
+    // send a kill packet for it to our other nodes
+    auto killPacket = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason));
+    killPacket->write(avatarID.toRfc4122());
+    killPacket->writePrimitive(KillAvatarReason::AvatarDisconnected);
 
-                if (node->getUUID() == killedNode->getUUID()) {
-                    return false;
-                }
+    nodeList->broadcastToNodes(std::move(killPacket), destinationTypes);
 
-                return true;
-            },
-            [&](const SharedNodePointer& node) {
-                QMetaObject::invokeMethod(node->getLinkedData(),
-                                         "cleanupKilledNode",
-                                          Qt::AutoConnection,
-                                          Q_ARG(const QUuid&, QUuid(killedNode->getUUID())));
+    // we also want to remove sequence number data for this avatar on our other avatars
+    // so invoke the appropriate method on the AvatarMixerClientData for other avatars
+    nodeList->eachMatchingNode(
+        [&](const SharedNodePointer& node)->bool {
+            if (!node->getLinkedData()) {
+                return false;
             }
-        );
-    }
+
+            if (node->getUUID() == avatarID) {
+                return false;
+            }
+
+            return true;
+        },
+        [&](const SharedNodePointer& node) {
+            QMetaObject::invokeMethod(node->getLinkedData(),
+                                     "cleanupKilledNode",
+                                      Qt::AutoConnection,
+                                      Q_ARG(const QUuid&, avatarID));
+        }
+    );
 }
 
 
@@ -394,6 +499,14 @@ void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMess
 
 void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
+
+    // the identity of one of the avatars of another mixer
+    if (senderNode->getType() == NodeType::AvatarMixer) {
+        _federation.processForwardedIdentity(*message, senderNode);
+        _handleAvatarIdentityPacketElapsedTime += (usecTimestampNow() - start);
+        return;
+    }
+
     auto nodeList = DependencyManager::get<NodeList>();
     getOrCreateClientData(senderNode);
 
@@ -421,13 +534,27 @@ void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> mes
     _handleAvatarIdentityPacketElapsedTime += (end - start);
 }
 
-void AvatarMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message) {
+void AvatarMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
-    DependencyManager::get<NodeList>()->processKillNode(*message);
+    if (senderNode->getType() == NodeType::AvatarMixer) {
+        // one of the avatars of another mixer left
+        QUuid avatarID = _federation.processForwardedKill(*message, senderNode);
+        if (!avatarID.isNull()) {
+            avatarLeft(avatarID, NodeSet() << NodeType::Agent);
+        }
+    } else {
+        DependencyManager::get<NodeList>()->processKillNode(*message);
+    }
     auto end = usecTimestampNow();
     _handleKillAvatarPacketElapsedTime += (end - start);
 }
 
+void AvatarMixer::handleForwardedAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (senderNode->getType() == NodeType::AvatarMixer) {
+        _federation.processForwardedAvatarData(*message, senderNode);
+    }
+}
+
 void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
     auto nodeList = DependencyManager::get<NodeList>();
@@ -446,8 +573,14 @@ void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage>
         // so the AvatarMixer knows it'll have to send identity data about the ignorer
         // to the ignored if the ignorer unignores.
         auto ignoredNode = nodeList->nodeWithUUID(ignoredUUID);
-        AvatarMixerClientData* ignoredNodeData = reinterpret_cast<AvatarMixerClientData*>(ignoredNode->getLinkedData());
-        ignoredNodeData->setLastBroadcastTime(senderNode->getUUID(), 0);
+        if (!ignoredNode) {
+            ignoredNode = _federation.remoteNodeWithUUID(ignoredUUID);
+        }
+        AvatarMixerClientData* ignoredNodeData = ignoredNode ?
+            reinterpret_cast<AvatarMixerClientData*>(ignoredNode->getLinkedData()) : nullptr;
+        if (ignoredNodeData) {
+            ignoredNodeData->setLastBroadcastTime(senderNode->getUUID(), 0);
+        }
 
         if (addToIgnore) {
             senderNode->addIgnoredNode(ignoredUUID);
@@ -476,6 +609,7 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["threads"] = _slavePool.numThreads();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
+    statsObject["remote_avatars"] = (int)_federation.getRemoteNodes().size();
 
     // this things all occur on the frequency of the tight loop
     int tightLoopFrames = _numTightLoopFrames;
@@ -523,6 +657,10 @@ void AvatarMixer::sendStatsPacket() {
     displayNameManagementStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_displayNameManagementElapsedTime);
     parallelTasks["displayNameManagement"] = displayNameManagementStats;
 
+    QJsonObject sendIdentityPacketsStats;
+    sendIdentityPacketsStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_sendIdentityPacketsElapsedTime);
+    parallelTasks["sendIdentityPackets"] = sendIdentityPacketsStats;
+
     statsObject["parallelTasks"] = parallelTasks;
 
 
@@ -553,6 +691,10 @@ void AvatarMixer::sendStatsPacket() {
 
         float averageOverBudgetAvatars = averageNodes ? stats.overBudgetAvatars / averageNodes : 0.0f;
         slaveObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
+        slaveObject["sent_8_toByteArrayCacheHits"] = TIGHT_LOOP_STAT(stats.toByteArrayCacheHits);
+
+        float averageDeferredAvatars = averageNodes ? stats.deferredAvatars / averageNodes : 0.0f;
+        slaveObject["sent_9_averageDeferredAvatars"] = TIGHT_LOOP_STAT(averageDeferredAvatars);
 
         slaveObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(stats.processIncomingPacketsElapsedTime);
         slaveObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(stats.ignoreCalculationElapsedTime);
@@ -586,6 +728,10 @@ void AvatarMixer::sendStatsPacket() {
 
     float averageOverBudgetAvatars = averageNodes ? aggregateStats.overBudgetAvatars / averageNodes : 0.0f;
     slavesAggregatObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
+    slavesAggregatObject["sent_8_toByteArrayCacheHits"] = TIGHT_LOOP_STAT(aggregateStats.toByteArrayCacheHits);
+
+    float averageDeferredAvatars = averageNodes ? aggregateStats.deferredAvatars / averageNodes : 0.0f;
+    slavesAggregatObject["sent_9_averageDeferredAvatars"] = TIGHT_LOOP_STAT(averageDeferredAvatars);
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -653,6 +799,7 @@ void AvatarMixer::sendStatsPacket() {
     _broadcastAvatarDataNodeFunctor = 0;
 
     _displayNameManagementElapsedTime = 0;
+    _sendIdentityPacketsElapsedTime = 0;
     _ignoreCalculationElapsedTime = 0;
     _avatarDataPackingElapsedTime = 0;
     _packetSendingElapsedTime = 0;
@@ -695,6 +842,13 @@ void AvatarMixer::domainSettingsRequestComplete() {
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 
+    // the domain server gives each of the mixers of a federation an index, and connects them to each other
+    const QString FEDERATION_INDEX_OPTION = "--federationIndex";
+    _federation.setEnabled(QString(getPayload()).split(' ', QString::SkipEmptyParts).contains(FEDERATION_INDEX_OPTION));
+    if (_federation.isEnabled()) {
+        nodeList->addNodeTypeToInterestSet(NodeType::AvatarMixer);
+    }
+
     // parse the settings to pull out the values we need
     parseDomainServerSettings(nodeList->getDomainHandler().getSettingsObject());
     
@@ -21,6 +21,8 @@
 #include <ThreadedAssignment.h>
 #include "AvatarMixerClientData.h"
 
+#include "AvatarMixerFederation.h"
+#include "AvatarMixerGrid.h"
 #include "AvatarMixerSlavePool.h"
 
 /// Handles assignments of type AvatarMixer - distribution of avatar data to various clients
@@ -42,7 +44,8 @@ private slots:
     void handleAdjustAvatarSorting(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleViewFrustumPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
-    void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleForwardedAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleRadiusIgnoreRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -58,9 +61,13 @@ private:
 
     void parseDomainServerSettings(const QJsonObject& domainSettings);
     void sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
+    void sendQueuedIdentityPackets(NodeList::const_iterator begin, NodeList::const_iterator end);
 
     void manageDisplayName(const SharedNodePointer& node);
 
+    // tell the nodes an avatar left, and forget what was sent of it
+    void avatarLeft(const QUuid& avatarID, const NodeSet& destinationTypes);
+
     p_high_resolution_clock::time_point _lastFrameTimestamp;
 
     // FIXME - new throttling - use these values somehow
@@ -83,6 +90,7 @@ private:
     QHash<QString, QPair<int, int>> _sessionDisplayNames;
 
     quint64 _displayNameManagementElapsedTime { 0 }; // total time spent in broadcastAvatarData/display name management... since last stats window
+    quint64 _sendIdentityPacketsElapsedTime { 0 };
     quint64 _ignoreCalculationElapsedTime { 0 };
     quint64 _avatarDataPackingElapsedTime { 0 };
     quint64 _packetSendingElapsedTime { 0 };
@@ -112,6 +120,8 @@ private:
 
 
     AvatarMixerSlavePool _slavePool;
+    AvatarMixerGrid _grid;
+    AvatarMixerFederation _federation;
 
 };
 
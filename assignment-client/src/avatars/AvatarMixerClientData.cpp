@@ -50,21 +50,129 @@ int AvatarMixerClientData::processPackets() {
     return packetsProcessed;
 }
 
+static const size_t MAX_CACHED_AVATAR_DATA = 16;
+
+static bool isSameJointData(const QVector<JointData>& lhs, const QVector<JointData>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (int i = 0; i < lhs.size(); i++) {
+        if (lhs[i].rotation != rhs[i].rotation || lhs[i].rotationSet != rhs[i].rotationSet ||
+            lhs[i].translation != rhs[i].translation || lhs[i].translationSet != rhs[i].translationSet) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QByteArray AvatarMixerClientData::encodeAvatarDataForListener(AvatarData::AvatarDataDetail detail, quint64 lastSentTime,
+        QVector<JointData>& lastSentJoints, AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking,
+        const glm::vec3& viewerPosition, bool* cacheHitOut) const {
+
+    // only the parts of the listener's state that toByteArray reads for this detail are part of the key
+    bool usesLastSentTime = (detail == AvatarData::CullSmallData || detail == AvatarData::MinimumData);
+    bool usesJoints = (detail == AvatarData::CullSmallData || detail == AvatarData::SendAllData);
+
+    CachedAvatarData key;
+    key.detail = detail;
+    key.dropFaceTracking = dropFaceTracking;
+    key.lastSentTime = usesLastSentTime ? lastSentTime : 0;
+    key.rotationBitsPerComponent = usesJoints ? _avatar->getDistanceBasedRotationBitsPerComponent(viewerPosition) : 0;
+    key.minRotationDOT = usesJoints ? _avatar->getDistanceBasedMinRotationDOT(viewerPosition) : 0.0f;
+    key.jointLOD = usesJoints ? _avatar->getDistanceBasedJointLOD(viewerPosition) : AvatarData::AllJoints;
+
+    // hold the lock while encoding, so that the other slaves wait for this encoding instead of making their own
+    std::lock_guard<std::mutex> lock(_avatarDataCacheMutex);
+
+    for (const auto& cached : _avatarDataCache) {
+        if (cached.detail == key.detail && cached.dropFaceTracking == key.dropFaceTracking &&
+            cached.lastSentTime == key.lastSentTime && cached.rotationBitsPerComponent == key.rotationBitsPerComponent &&
+            cached.minRotationDOT == key.minRotationDOT && cached.jointLOD == key.jointLOD &&
+            (!usesJoints || isSameJointData(cached.lastSentJoints, lastSentJoints))) {
+            if (usesJoints) {
+                lastSentJoints = cached.sentJoints;
+            }
+            hasFlagsOut = cached.hasFlags;
+            if (cacheHitOut) {
+                *cacheHitOut = true;
+            }
+            return cached.bytes;
+        }
+    }
+
+    if (usesJoints) {
+        key.lastSentJoints = lastSentJoints;
+    }
+    key.bytes = _avatar->toByteArray(detail, lastSentTime, lastSentJoints, key.hasFlags, dropFaceTracking,
+        true, viewerPosition, &lastSentJoints);
+    key.sentJoints = lastSentJoints;
+
+    hasFlagsOut = key.hasFlags;
+    if (cacheHitOut) {
+        *cacheHitOut = false;
+    }
+
+    // listeners that were last sent this avatar in the same frame share encodings, so there are only a few of them;
+    // past that the lookup would cost more than it saves
+    if (_avatarDataCache.size() < MAX_CACHED_AVATAR_DATA) {
+        _avatarDataCache.push_back(key);
+    }
+    return key.bytes;
+}
+
+void AvatarMixerClientData::clearAvatarDataCache() {
+    std::lock_guard<std::mutex> lock(_avatarDataCacheMutex);
+    _avatarDataCache.clear();
+}
+
 int AvatarMixerClientData::parseData(ReceivedMessage& message) {
 
     // pull the sequence number from the data first
     uint16_t sequenceNumber;
 
     message.readPrimitive(&sequenceNumber);
-    
+
+    // compute the offset to the data payload
+    return parseAvatarData(sequenceNumber, message.readWithoutCopy(message.getBytesLeftToRead()));
+}
+
+int AvatarMixerClientData::parseAvatarData(uint16_t sequenceNumber, const QByteArray& data) {
     if (sequenceNumber < _lastReceivedSequenceNumber && _lastReceivedSequenceNumber != UINT16_MAX) {
         incrementNumOutOfOrderSends();
     }
     _lastReceivedSequenceNumber = sequenceNumber;
 
-    // compute the offset to the data payload
-    return _avatar->parseDataFromBuffer(message.readWithoutCopy(message.getBytesLeftToRead()));
+    return _avatar->parseDataFromBuffer(data);
+}
+const QByteArray& AvatarMixerClientData::getIdentityPacketData() {
+    if (!_hasIdentityPacketData || _identityPacketDataTimestamp != _identityChangeTimestamp) {
+        _identityPacketData = _avatar->identityByteArray();
+        _identityPacketData.replace(0, NUM_BYTES_RFC4122_UUID, getNodeID().toRfc4122()); // FIXME, this looks suspicious
+        _identityPacketDataTimestamp = _identityChangeTimestamp;
+        _hasIdentityPacketData = true;
+    }
+    return _identityPacketData;
+}
+
+void AvatarMixerClientData::queueIdentityPacket(const QUuid& otherAvatar) {
+    if (_queuedIdentities.insert(otherAvatar).second) {
+        _identityQueue.push_back(otherAvatar);
+    }
+}
+
+bool AvatarMixerClientData::dequeueIdentityPacket(QUuid& otherAvatar) {
+    while (!_identityQueue.empty()) {
+        otherAvatar = _identityQueue.front();
+        _identityQueue.pop_front();
+
+        // skip avatars that were killed while they were queued
+        if (_queuedIdentities.erase(otherAvatar) > 0) {
+            return true;
+        }
+    }
+    return false;
 }
+
 uint64_t AvatarMixerClientData::getLastBroadcastTime(const QUuid& nodeUUID) const {
     // return the matching PacketSequenceNumber, or the default if we don't have it
     auto nodeMatch = _lastBroadcastTimes.find(nodeUUID);
@@ -128,4 +236,22 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["av_data_receive_rate"] = _avatar->getReceiveRate();
     jsonObject["recent_other_av_in_view"] = _recentOtherAvatarsInView;
     jsonObject["recent_other_av_out_of_view"] = _recentOtherAvatarsOutOfView;
+
+    // how well the scheduler kept up with the update rates the other avatars' priorities asked for
+    float totalTargetRate = 0.0f;
+    float totalUpdateRate = 0.0f;
+    float minUpdateRatio = 1.0f;
+    int numScheduled = 0;
+    for (const auto& schedule : _otherAvatarSchedules) {
+        if (schedule.second.targetRate > 0.0f) {
+            float updateRate = schedule.second.updateRate.rate();
+            totalTargetRate += schedule.second.targetRate;
+            totalUpdateRate += updateRate;
+            minUpdateRatio = std::min(minUpdateRatio, updateRate / schedule.second.targetRate);
+            ++numScheduled;
+        }
+    }
+    jsonObject["avg_other_av_target_rate_hz"] = numScheduled ? totalTargetRate / numScheduled : 0.0f;
+    jsonObject["avg_other_av_update_rate_hz"] = numScheduled ? totalUpdateRate / numScheduled : 0.0f;
+    jsonObject["min_other_av_update_to_target_ratio"] = numScheduled ? minUpdateRatio : 1.0f;
 }
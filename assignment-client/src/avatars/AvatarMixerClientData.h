@@ -14,6 +14,8 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <deque>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
@@ -27,6 +29,7 @@
 #include <udt/PacketHeaders.h>
 #include <PortableHighResolutionClock.h>
 #include <SimpleMovingAverage.h>
+#include <shared/RateCounter.h>
 #include <UUIDHasher.h>
 #include <ViewFrustum.h>
 
@@ -36,11 +39,23 @@ const QString INBOUND_AVATAR_DATA_STATS_KEY = "inbound_av_data_kbps";
 class AvatarMixerClientData : public NodeData {
     Q_OBJECT
 public:
+    // how this node's bandwidth is shared with another avatar, see AvatarMixerSlave::broadcastAvatarData
+    struct OtherAvatarSchedule {
+        float credit { 0.0f }; // deficit round robin credit, in bytes
+        int lastUpdateSize { 0 }; // bytes of the last update sent, what the next one is expected to cost
+        float targetRate { 0.0f }; // updates per second the other avatar's priority asks for
+        RateCounter<> updateRate; // updates per second actually sent
+        quint64 lastKeepAliveTime { 0 }; // when the avatar was last considered while outside the queried grid cells
+    };
+
     AvatarMixerClientData(const QUuid& nodeID = QUuid()) : NodeData(nodeID) { _currentViewFrustum.invalidate(); }
     virtual ~AvatarMixerClientData() {}
     using HRCTime = p_high_resolution_clock::time_point;
 
     int parseData(ReceivedMessage& message) override;
+
+    // an AvatarData payload without its sequence number, as another avatar mixer forwards it
+    int parseAvatarData(uint16_t sequenceNumber, const QByteArray& data);
     AvatarData& getAvatar() { return *_avatar; }
     const AvatarData* getConstAvatarData() const { return _avatar.get(); }
     AvatarSharedPointer getAvatarSharedPointer() const { return _avatar; }
@@ -57,12 +72,22 @@ public:
     Q_INVOKABLE void cleanupKilledNode(const QUuid& nodeUUID) {
         removeLastBroadcastSequenceNumber(nodeUUID);
         removeLastBroadcastTime(nodeUUID);
+        _otherAvatarSchedules.erase(nodeUUID);
+        _queuedIdentities.erase(nodeUUID);
     }
 
     uint16_t getLastReceivedSequenceNumber() const { return _lastReceivedSequenceNumber; }
 
     uint64_t getIdentityChangeTimestamp() const { return _identityChangeTimestamp; }
     void flagIdentityChange() { _identityChangeTimestamp = usecTimestampNow(); }
+
+    // this avatar's AvatarIdentity payload, serialized once per identity change however many nodes it is sent to
+    // (mixer thread only)
+    const QByteArray& getIdentityPacketData();
+
+    // identities of other avatars waiting to be sent to this node, see AvatarMixer::sendQueuedIdentityPackets
+    void queueIdentityPacket(const QUuid& otherAvatar);
+    bool dequeueIdentityPacket(QUuid& otherAvatar);
     bool getAvatarSessionDisplayNameMustChange() const { return _avatarSessionDisplayNameMustChange; }
     void setAvatarSessionDisplayNameMustChange(bool set = true) { _avatarSessionDisplayNameMustChange = set; }
 
@@ -93,6 +118,7 @@ public:
     glm::vec3 getGlobalBoundingBoxCorner() const { return _avatar ? _avatar->getGlobalBoundingBoxCorner() : glm::vec3(0); }
     bool isRadiusIgnoring(const QUuid& other) const { return _radiusIgnoredOthers.find(other) != _radiusIgnoredOthers.end(); }
     void addToRadiusIgnoringSet(const QUuid& other) { _radiusIgnoredOthers.insert(other); }
+    const std::unordered_set<QUuid>& getRadiusIgnoredOthers() const { return _radiusIgnoredOthers; }
     void removeFromRadiusIgnoringSet(SharedNodePointer self, const QUuid& other);
     void ignoreOther(SharedNodePointer self, SharedNodePointer other);
 
@@ -110,15 +136,17 @@ public:
 
     ViewFrustum getViewFrustom() const { return _currentViewFrustum; }
 
-    quint64 getLastOtherAvatarEncodeTime(QUuid otherAvatar) {
+    quint64 getLastOtherAvatarEncodeTime(QUuid otherAvatar, quint64 encodeTime = usecTimestampNow()) {
         quint64 result = 0;
         if (_lastOtherAvatarEncodeTime.find(otherAvatar) != _lastOtherAvatarEncodeTime.end()) {
             result = _lastOtherAvatarEncodeTime[otherAvatar];
         }
-        _lastOtherAvatarEncodeTime[otherAvatar] = usecTimestampNow();
+        _lastOtherAvatarEncodeTime[otherAvatar] = encodeTime;
         return result;
     }
 
+    OtherAvatarSchedule& getOtherAvatarSchedule(const QUuid& otherAvatar) { return _otherAvatarSchedules[otherAvatar]; }
+
     QVector<JointData>& getLastOtherAvatarSentJoints(QUuid otherAvatar) {
         _lastOtherAvatarSentJoints[otherAvatar].resize(_avatar->getJointCount());
         return _lastOtherAvatarSentJoints[otherAvatar];
@@ -127,7 +155,29 @@ public:
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(); // returns number of packets processed
 
+    // encodes this avatar for a listener (as AvatarData::toByteArray with distanceAdjust), reusing the encoding made
+    // for another listener this frame when it would be identical; safe to call from several slaves at once
+    QByteArray encodeAvatarDataForListener(AvatarData::AvatarDataDetail detail, quint64 lastSentTime,
+        QVector<JointData>& lastSentJoints, AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking,
+        const glm::vec3& viewerPosition, bool* cacheHitOut = nullptr) const;
+
+    // the encodings are only valid until this avatar processes its next packets
+    void clearAvatarDataCache();
+
 private:
+    struct CachedAvatarData {
+        AvatarData::AvatarDataDetail detail;
+        bool dropFaceTracking;
+        quint64 lastSentTime;
+        int rotationBitsPerComponent;
+        float minRotationDOT;
+        AvatarData::JointLOD jointLOD;
+        QVector<JointData> lastSentJoints;
+        QVector<JointData> sentJoints;
+        AvatarDataPacket::HasFlags hasFlags;
+        QByteArray bytes;
+    };
+
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
     };
@@ -143,8 +193,19 @@ private:
     // sending to "this" node
     std::unordered_map<QUuid, quint64> _lastOtherAvatarEncodeTime;
     std::unordered_map<QUuid, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<QUuid, OtherAvatarSchedule> _otherAvatarSchedules;
+
+    mutable std::mutex _avatarDataCacheMutex;
+    mutable std::vector<CachedAvatarData> _avatarDataCache; // guarded by _avatarDataCacheMutex
 
     uint64_t _identityChangeTimestamp;
+    QByteArray _identityPacketData;
+    uint64_t _identityPacketDataTimestamp { 0 };
+    bool _hasIdentityPacketData { false };
+
+    // queued by this node's slave during the broadcast, sent by the mixer thread after it
+    std::deque<QUuid> _identityQueue;
+    std::unordered_set<QUuid> _queuedIdentities; // what is in _identityQueue, so an avatar is only queued once
     bool _avatarSessionDisplayNameMustChange{ false };
 
     int _numAvatarsSentLastFrame = 0;
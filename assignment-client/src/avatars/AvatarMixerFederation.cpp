@@ -0,0 +1,212 @@
+//
+//  AvatarMixerFederation.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include <AvatarLogging.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+#include <udt/PacketHeaders.h>
+
+#include "AvatarMixerClientData.h"
+
+#include "AvatarMixerFederation.h"
+
+// an avatar is forwarded whole in a segment of a packet, after its ID and sequence number
+static const int MAX_FORWARDED_AVATAR_DATA = 1400 - NUM_BYTES_RFC4122_UUID - (int)sizeof(uint16_t);
+
+void AvatarMixerFederation::forwardAvatars(ConstIter begin, ConstIter end) {
+    if (!_isEnabled) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    quint64 now = usecTimestampNow();
+
+    std::for_each(begin, end, [&](const SharedNodePointer& peerNode) {
+        if (peerNode->getType() != NodeType::AvatarMixer || !peerNode->getActiveSocket()) {
+            return;
+        }
+
+        ForwardedAvatars& forwardedAvatars = _peers[peerNode->getUUID()];
+        auto avatarPacketList = NLPacketList::create(PacketType::ForwardedAvatarData);
+        bool hasAvatars = false;
+
+        std::for_each(begin, end, [&](const SharedNodePointer& node) {
+            auto nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+            if (!nodeData || node->getType() != NodeType::Agent) {
+                return;
+            }
+
+            ForwardedAvatar& forwarded = forwardedAvatars[node->getUUID()];
+
+            // the identity goes reliably, ahead of the data, as it does to the listeners
+            if (!forwarded.hasSentIdentity || forwarded.identityChangeTimestamp != nodeData->getIdentityChangeTimestamp()) {
+                const QByteArray& identityData = nodeData->getIdentityPacketData();
+                auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, identityData.size(), true);
+                identityPacket->write(identityData);
+                nodeList->sendPacket(std::move(identityPacket), *peerNode);
+
+                forwarded.hasSentIdentity = true;
+                forwarded.identityChangeTimestamp = nodeData->getIdentityChangeTimestamp();
+            }
+
+            uint16_t sequenceNumber = nodeData->getLastReceivedSequenceNumber();
+            if (forwarded.hasSentData && forwarded.lastSequenceNumber == sequenceNumber) {
+                return;
+            }
+
+            // the peer keeps the whole avatar, so most updates only carry what changed, and some all of it in case
+            // one of those was lost; the joints are at the precision of a listener standing on the avatar
+            AvatarData::AvatarDataDetail detail = (!forwarded.hasSentData || randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO) ?
+                AvatarData::SendAllData : AvatarData::CullSmallData;
+            forwarded.lastSentJoints.resize(nodeData->getConstAvatarData()->getJointCount());
+            glm::vec3 viewerPosition = nodeData->getPosition();
+            AvatarDataPacket::HasFlags hasFlags;
+
+            QByteArray bytes = nodeData->encodeAvatarDataForListener(detail, forwarded.lastSentTime,
+                forwarded.lastSentJoints, hasFlags, false, viewerPosition);
+            if (bytes.size() > MAX_FORWARDED_AVATAR_DATA) {
+                bytes = nodeData->encodeAvatarDataForListener(detail, forwarded.lastSentTime,
+                    forwarded.lastSentJoints, hasFlags, true, viewerPosition);
+            }
+            if (bytes.size() > MAX_FORWARDED_AVATAR_DATA) {
+                qCWarning(avatars) << "Avatar" << node->getUUID() << "is too large to forward:" << bytes.size();
+                return;
+            }
+
+            avatarPacketList->startSegment();
+            avatarPacketList->write(node->getUUID().toRfc4122());
+            avatarPacketList->writePrimitive(sequenceNumber);
+            avatarPacketList->write(bytes);
+            avatarPacketList->endSegment();
+            hasAvatars = true;
+
+            forwarded.hasSentData = true;
+            forwarded.lastSequenceNumber = sequenceNumber;
+            forwarded.lastSentTime = now;
+        });
+
+        if (hasAvatars) {
+            avatarPacketList->closeCurrentPacket();
+            nodeList->queuePacketList(std::move(avatarPacketList), *peerNode);
+        }
+    });
+}
+
+void AvatarMixerFederation::processForwardedAvatarData(ReceivedMessage& message, const SharedNodePointer& peerNode) {
+    if (!_isEnabled) {
+        return;
+    }
+
+    while (message.getBytesLeftToRead()) {
+        QUuid avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        uint16_t sequenceNumber;
+        message.readPrimitive(&sequenceNumber);
+
+        auto remoteNode = getOrCreateRemoteNode(avatarID, peerNode->getUUID());
+        auto remoteData = reinterpret_cast<AvatarMixerClientData*>(remoteNode->getLinkedData());
+
+        int positionBeforeRead = message.getPosition();
+        int bytesRead = remoteData->parseAvatarData(sequenceNumber, message.readWithoutCopy(message.getBytesLeftToRead()));
+        message.seek(positionBeforeRead + bytesRead);
+    }
+}
+
+void AvatarMixerFederation::processForwardedIdentity(ReceivedMessage& message, const SharedNodePointer& peerNode) {
+    if (!_isEnabled) {
+        return;
+    }
+
+    AvatarData::Identity identity;
+    AvatarData::parseAvatarIdentityPacket(message.getMessage(), identity);
+
+    auto remoteNode = getOrCreateRemoteNode(identity.uuid, peerNode->getUUID());
+    auto remoteData = reinterpret_cast<AvatarMixerClientData*>(remoteNode->getLinkedData());
+    AvatarData& avatar = remoteData->getAvatar();
+
+    // the peer made the session display name, it isn't made again here
+    bool identityChanged = false;
+    bool displayNameChanged = false;
+    avatar.processAvatarIdentity(identity, identityChanged, displayNameChanged);
+    if (avatar.getSessionDisplayName() != identity.sessionDisplayName) {
+        avatar.setSessionDisplayName(identity.sessionDisplayName);
+        identityChanged = true;
+    }
+    if (identityChanged) {
+        remoteData->flagIdentityChange();
+    }
+}
+
+QUuid AvatarMixerFederation::processForwardedKill(ReceivedMessage& message, const SharedNodePointer& peerNode) {
+    QUuid avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+    auto it = _remoteAvatars.find(avatarID);
+    if (it == _remoteAvatars.end() || it->second.peerID != peerNode->getUUID()) {
+        return QUuid();
+    }
+    removeRemoteAvatar(avatarID);
+    return avatarID;
+}
+
+void AvatarMixerFederation::removeLocalAvatar(const QUuid& avatarID) {
+    for (auto& peer : _peers) {
+        peer.second.erase(avatarID);
+    }
+}
+
+std::vector<QUuid> AvatarMixerFederation::removePeer(const QUuid& peerID) {
+    _peers.erase(peerID);
+
+    std::vector<QUuid> removedAvatars;
+    for (const auto& remoteAvatar : _remoteAvatars) {
+        if (remoteAvatar.second.peerID == peerID) {
+            removedAvatars.push_back(remoteAvatar.first);
+        }
+    }
+    for (const auto& avatarID : removedAvatars) {
+        removeRemoteAvatar(avatarID);
+    }
+    return removedAvatars;
+}
+
+SharedNodePointer AvatarMixerFederation::remoteNodeWithUUID(const QUuid& avatarID) const {
+    auto it = _remoteAvatars.find(avatarID);
+    return it != _remoteAvatars.end() ? it->second.node : SharedNodePointer();
+}
+
+SharedNodePointer AvatarMixerFederation::getOrCreateRemoteNode(const QUuid& avatarID, const QUuid& peerID) {
+    auto it = _remoteAvatars.find(avatarID);
+    if (it != _remoteAvatars.end()) {
+        // the avatar moved over to that mixer
+        it->second.peerID = peerID;
+        return it->second.node;
+    }
+
+    // the remote avatars have no sockets, so they are never broadcast to
+    SharedNodePointer remoteNode(new Node(avatarID, NodeType::Agent, HifiSockAddr(), HifiSockAddr(), NodePermissions()),
+                                 &QObject::deleteLater);
+    if (linkedDataCreateCallback) {
+        linkedDataCreateCallback(remoteNode);
+    }
+
+    _remoteAvatars[avatarID] = { peerID, remoteNode };
+    _remoteNodes.push_back(remoteNode);
+    return remoteNode;
+}
+
+void AvatarMixerFederation::removeRemoteAvatar(const QUuid& avatarID) {
+    auto it = _remoteAvatars.find(avatarID);
+    if (it == _remoteAvatars.end()) {
+        return;
+    }
+    _remoteNodes.erase(std::remove(_remoteNodes.begin(), _remoteNodes.end(), it->second.node), _remoteNodes.end());
+    _remoteAvatars.erase(it);
+}
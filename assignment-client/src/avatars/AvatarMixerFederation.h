@@ -0,0 +1,89 @@
+//
+//  AvatarMixerFederation.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarMixerFederation_h
+#define hifi_AvatarMixerFederation_h
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include <JointData.h>
+#include <NodeList.h>
+#include <ReceivedMessage.h>
+#include <UUIDHasher.h>
+
+// The avatars exchanged between the avatar mixers of a domain that has several of them
+//   Each node uploads its avatar to one of the mixers, which forwards it to the others as it would send it to a
+//   listener: the AvatarData encoding, at full precision, with only the joints that changed most of the time. Each
+//   mixer keeps the avatars of the others as nodes outside of the node list, and its listeners get them as they get
+//   the local ones.
+//   forwardAvatars is called from the mixer thread after the broadcast, and the forwarded avatars are received on it
+//   between frames; during the broadcast the slaves only read the remote nodes.
+class AvatarMixerFederation {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    // creates the linked data of a remote avatar's node, as the mixer would for a node of its own
+    std::function<void(const SharedNodePointer&)> linkedDataCreateCallback;
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    // forward this frame's updates of the local avatars, and their identities when they changed, to the other mixers
+    // (requires the avatars' packets to have been processed for the frame)
+    void forwardAvatars(ConstIter begin, ConstIter end);
+
+    void processForwardedAvatarData(ReceivedMessage& message, const SharedNodePointer& peerNode);
+    void processForwardedIdentity(ReceivedMessage& message, const SharedNodePointer& peerNode);
+
+    // returns the remote avatar the peer killed, or a null ID
+    QUuid processForwardedKill(ReceivedMessage& message, const SharedNodePointer& peerNode);
+
+    // forget what was forwarded of a local avatar that left
+    void removeLocalAvatar(const QUuid& avatarID);
+
+    // forget a mixer that left, returns the remote avatars that left with it
+    std::vector<QUuid> removePeer(const QUuid& peerID);
+
+    // the avatars of the other mixers
+    const std::vector<SharedNodePointer>& getRemoteNodes() const { return _remoteNodes; }
+    SharedNodePointer remoteNodeWithUUID(const QUuid& avatarID) const;
+
+private:
+    // what a peer was last sent of a local avatar
+    struct ForwardedAvatar {
+        bool hasSentData { false };
+        uint16_t lastSequenceNumber { 0 };
+        quint64 lastSentTime { 0 };
+        QVector<JointData> lastSentJoints;
+        bool hasSentIdentity { false };
+        uint64_t identityChangeTimestamp { 0 };
+    };
+    using ForwardedAvatars = std::unordered_map<QUuid, ForwardedAvatar>;
+
+    struct RemoteAvatar {
+        QUuid peerID;
+        SharedNodePointer node;
+    };
+
+    SharedNodePointer getOrCreateRemoteNode(const QUuid& avatarID, const QUuid& peerID);
+    void removeRemoteAvatar(const QUuid& avatarID);
+
+    bool _isEnabled { false };
+
+    std::unordered_map<QUuid, ForwardedAvatars> _peers;
+    std::unordered_map<QUuid, RemoteAvatar> _remoteAvatars;
+    std::vector<SharedNodePointer> _remoteNodes; // the nodes of _remoteAvatars, for the slaves to iterate
+};
+
+#endif // hifi_AvatarMixerFederation_h
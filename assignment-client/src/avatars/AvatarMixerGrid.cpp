@@ -0,0 +1,86 @@
+//
+//  AvatarMixerGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include "AvatarMixerClientData.h"
+
+#include "AvatarMixerGrid.h"
+
+static uint64_t packCellCoordinates(const glm::ivec3& coordinates) {
+    const uint64_t MASK = (1 << 21) - 1;
+    return (((uint64_t)coordinates.x & MASK) << 42) | (((uint64_t)coordinates.y & MASK) << 21) | ((uint64_t)coordinates.z & MASK);
+}
+
+void AvatarMixerGrid::prepare(ConstIter begin, ConstIter end) {
+    _cells.clear();
+    _cellIndices.clear();
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        addNode(node);
+    });
+}
+
+void AvatarMixerGrid::addNode(const SharedNodePointer& node) {
+    const AvatarMixerClientData* nodeData = reinterpret_cast<const AvatarMixerClientData*>(node->getLinkedData());
+
+    // nodes without data yet are skipped by the broadcast as well
+    if (!nodeData) {
+        return;
+    }
+
+    glm::vec3 boundingBoxCorner = nodeData->getGlobalBoundingBoxCorner();
+    AABox box = avatarBox(nodeData->getConstAvatarData()->getClientGlobalPosition(), boundingBoxCorner);
+    AABox bubble = bubbleBox(nodeData->getPosition(), boundingBoxCorner);
+
+    glm::ivec3 coordinates { glm::floor(box.calcCenter() / _cellSize) };
+    auto key = packCellCoordinates(coordinates);
+
+    auto it = _cellIndices.find(key);
+    if (it == _cellIndices.end()) {
+        it = _cellIndices.insert({ key, (int)_cells.size() }).first;
+        _cells.emplace_back();
+        _cells.back().bounds = box;
+        _cells.back().bubbleBounds = bubble;
+    } else {
+        Cell& cell = _cells[it->second];
+        cell.bounds += box;
+        cell.bubbleBounds += bubble;
+    }
+
+    _cells[it->second].nodes.push_back(node);
+}
+
+void AvatarMixerGrid::query(const ViewFrustum& view, const AABox& bubbleBox,
+                            std::function<void(const SharedNodePointer&)> functor) const {
+    for (auto& cell : _cells) {
+        if (bubbleBox.touches(cell.bubbleBounds) || view.boxIntersectsKeyhole(cell.bounds)) {
+            std::for_each(cell.nodes.cbegin(), cell.nodes.cend(), functor);
+        }
+    }
+}
+
+AABox AvatarMixerGrid::avatarBox(const glm::vec3& position, const glm::vec3& boundingBoxCorner) {
+    return AABox(boundingBoxCorner, (position - boundingBoxCorner) * 2.0f);
+}
+
+AABox AvatarMixerGrid::bubbleBox(const glm::vec3& position, const glm::vec3& boundingBoxCorner) {
+    // Define the minimum bubble size
+    static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
+
+    AABox box = avatarBox(position, boundingBoxCorner);
+    // Clamp the size of the bounding box to a minimum scale
+    if (glm::any(glm::lessThan(box.getScale(), minBubbleSize))) {
+        box.setScaleStayCentered(minBubbleSize);
+    }
+    // Quadruple the scale of the bounding box
+    box.embiggen(4.0f);
+    return box;
+}
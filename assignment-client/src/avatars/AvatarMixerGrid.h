@@ -0,0 +1,62 @@
+//
+//  AvatarMixerGrid.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarMixerGrid_h
+#define hifi_AvatarMixerGrid_h
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <AABox.h>
+#include <NodeList.h>
+#include <ViewFrustum.h>
+
+// A uniform grid of this frame's avatars, so that listeners only consider avatars they could see or bump into
+//   Avatars are binned by the center of their bounding box, and each cell keeps the bounds of its avatars
+//   (and of their space bubbles), so a whole cell is culled with a single keyhole or bubble test.
+//   prepare is called from the mixer thread before the broadcast; during the broadcast the slaves only read.
+class AvatarMixerGrid {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Cell {
+        AABox bounds; // union of the bounding boxes of the cell's avatars
+        AABox bubbleBounds; // union of the space bubbles of the cell's avatars
+        std::vector<SharedNodePointer> nodes;
+    };
+
+    void setCellSize(float cellSize) { _cellSize = cellSize; }
+    float getCellSize() const { return _cellSize; }
+
+    // bin this frame's avatars (requires their packets to have been processed for the frame)
+    void prepare(ConstIter begin, ConstIter end);
+
+    // bin an avatar that isn't in the node list, after prepare (see AvatarMixerFederation)
+    void addNode(const SharedNodePointer& node);
+
+    int getNumCells() const { return (int)_cells.size(); }
+    const Cell& getCell(int index) const { return _cells[index]; }
+
+    // calls functor for each avatar in a cell that intersects the view keyhole or touches the bubble box
+    void query(const ViewFrustum& view, const AABox& bubbleBox, std::function<void(const SharedNodePointer&)> functor) const;
+
+    // the bounding box the mixer uses for an avatar, and the same box grown into the avatar's space bubble
+    static AABox avatarBox(const glm::vec3& position, const glm::vec3& boundingBoxCorner);
+    static AABox bubbleBox(const glm::vec3& position, const glm::vec3& boundingBoxCorner);
+
+private:
+    float _cellSize { 10.0f };
+
+    std::vector<Cell> _cells;
+    std::unordered_map<uint64_t, int> _cellIndices; // packed grid coordinates to index in _cells
+};
+
+#endif // hifi_AvatarMixerGrid_h
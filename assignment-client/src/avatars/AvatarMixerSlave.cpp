@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <random>
+#include <unordered_set>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -30,6 +31,7 @@
 
 #include "AvatarMixer.h"
 #include "AvatarMixerClientData.h"
+#include "AvatarMixerGrid.h"
 #include "AvatarMixerSlave.h"
 
 
@@ -38,11 +40,15 @@ void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
     _end = end;
 }
 
-void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end, 
+void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end, const AvatarMixerGrid& grid,
+                                const std::vector<SharedNodePointer>& remoteNodes, quint64 broadcastTime,
                                 p_high_resolution_clock::time_point lastFrameTimestamp,
                                 float maxKbpsPerNode, float throttlingRatio) {
     _begin = begin;
     _end = end;
+    _grid = &grid;
+    _remoteNodes = &remoteNodes;
+    _broadcastTime = broadcastTime;
     _lastFrameTimestamp = lastFrameTimestamp;
     _maxKbpsPerNode = maxKbpsPerNode;
     _throttlingRatio = throttlingRatio;
@@ -66,20 +72,37 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
 }
 
 
-int AvatarMixerSlave::sendIdentityPacket(const AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
-    int bytesSent = 0;
-    QByteArray individualData = nodeData->getConstAvatarData()->identityByteArray();
-    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size());
-    individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122()); // FIXME, this looks suspicious
-    bytesSent += individualData.size();
-    identityPacket->write(individualData);
-    DependencyManager::get<NodeList>()->sendPacket(std::move(identityPacket), *destinationNode);
-    _stats.numIdentityPackets++;
-    return bytesSent;
-}
-
 static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
+// the update rates that the scheduler aims for before it shares out the budget, see targetUpdateRate
+static const float MAX_TARGET_UPDATE_RATE = (float)AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+static const float MIN_TARGET_UPDATE_RATE = 2.0f;
+static const float FULL_RATE_DISTANCE = 5.0f; // meters
+static const float TALKING_LOUDNESS = 50.0f;
+
+static const int MAX_ALLOWED_AVATAR_DATA = (1400 - NUM_BYTES_RFC4122_UUID);
+
+// deficit round robin credit is capped, so that an avatar can't save up for more than a couple of updates
+static const float MAX_SCHEDULE_CREDIT = 2.0f * MAX_ALLOWED_AVATAR_DATA;
+
+// how often an avatar outside the grid cells a listener queries is still sent, well inside AvatarData::shouldDie()
+static const quint64 AVATAR_KEEP_ALIVE_INTERVAL_USECS = USECS_PER_SECOND;
+
+// how often a listener should hear about an avatar in its view: closer to the listener and the center of its view,
+// and talking, is more often, but never less than MIN_TARGET_UPDATE_RATE
+static float targetUpdateRate(const ViewFrustum& view, const AvatarData& otherAvatar) {
+    glm::vec3 offset = otherAvatar.getClientGlobalPosition() - view.getPosition();
+    float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
+    float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+
+    float rate = MAX_TARGET_UPDATE_RATE * (FULL_RATE_DISTANCE / std::max(distance, FULL_RATE_DISTANCE));
+    rate *= 0.5f + 0.5f * std::max(cosineAngle, 0.0f);
+    if (otherAvatar.getAudioLoudness() > TALKING_LOUDNESS) {
+        rate *= 2.0f;
+    }
+    return glm::clamp(rate, MIN_TARGET_UPDATE_RATE, MAX_TARGET_UPDATE_RATE);
+}
+
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
     quint64 start = usecTimestampNow();
 
@@ -111,7 +134,6 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
         // keep track of outbound data rate specifically for avatar data
         int numAvatarDataBytes = 0;
-        int identityBytesSent = 0;
 
         // max number of avatarBytes per frame
         auto maxAvatarBytesPerFrame = (_maxKbpsPerNode * BYTES_PER_KILOBIT) / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
@@ -143,26 +165,18 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
         // setup a PacketList for the avatarPackets
         auto avatarPacketList = NLPacketList::create(PacketType::BulkAvatarData);
 
-        // Define the minimum bubble size
-        static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
-        // Define the scale of the box for the current node
-        glm::vec3 nodeBoxScale = (nodeData->getPosition() - nodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-        // Set up the bounding box for the current node
-        AABox nodeBox(nodeData->getGlobalBoundingBoxCorner(), nodeBoxScale);
-        // Clamp the size of the bounding box to a minimum scale
-        if (glm::any(glm::lessThan(nodeBoxScale, minBubbleSize))) {
-            nodeBox.setScaleStayCentered(minBubbleSize);
-        }
-        // Quadruple the scale of both bounding boxes
-        nodeBox.embiggen(4.0f);
+        // Set up the space bubble for the current node
+        AABox nodeBox = AvatarMixerGrid::bubbleBox(nodeData->getPosition(), nodeData->getGlobalBoundingBoxCorner());
 
+        ViewFrustum cameraView = nodeData->getViewFrustom();
 
         // setup list of AvatarData as well as maps to map betweeen the AvatarData and the original nodes
         // for calling the AvatarData::sortAvatars() function and getting our sorted list of client nodes
         QList<AvatarSharedPointer> avatarList;
         std::unordered_map<AvatarSharedPointer, SharedNodePointer> avatarDataToNodes;
+        std::unordered_set<QUuid> consideredNodeIDs;
 
-        std::for_each(_begin, _end, [&](const SharedNodePointer& otherNode) {
+        auto addOtherNode = [&](const SharedNodePointer& otherNode) {
             const AvatarMixerClientData* otherNodeData = reinterpret_cast<const AvatarMixerClientData*>(otherNode->getLinkedData());
 
             // theoretically it's possible for a Node to be in the NodeList (and therefore end up here),
@@ -172,11 +186,45 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
                 AvatarSharedPointer otherAvatar = otherNodeData->getAvatarSharedPointer();
                 avatarList << otherAvatar;
                 avatarDataToNodes[otherAvatar] = otherNode;
+                consideredNodeIDs.insert(otherNode->getUUID());
             }
-        });
+        };
+
+        if (PALIsOpen) {
+            // the PAL lists everyone, so every avatar gets at least PALMinimum
+            std::for_each(_begin, _end, addOtherNode);
+            std::for_each(_remoteNodes->cbegin(), _remoteNodes->cend(), addOtherNode);
+        } else {
+            // everyone else would get NoData, so only consider the avatars in cells that are in view or in our bubble
+            _grid->query(cameraView, nodeBox, addOtherNode);
+
+            // avatars in no such cell are out of our bubble as well
+            std::vector<QUuid> exitedBubble;
+            for (const QUuid& otherID : nodeData->getRadiusIgnoredOthers()) {
+                if (consideredNodeIDs.find(otherID) == consideredNodeIDs.end()) {
+                    exitedBubble.push_back(otherID);
+                }
+            }
+            for (const QUuid& otherID : exitedBubble) {
+                nodeData->removeFromRadiusIgnoringSet(node, otherID);
+            }
+
+            // the avatars in no such cell still need their NoData now and then, and any identity change: the
+            // client lets an avatar it hasn't heard of for a while die, and would remake it when it comes in view
+            auto addKeptAliveNode = [&](const SharedNodePointer& otherNode) {
+                if (otherNode->getLinkedData() && consideredNodeIDs.find(otherNode->getUUID()) == consideredNodeIDs.end()) {
+                    auto& schedule = nodeData->getOtherAvatarSchedule(otherNode->getUUID());
+                    if (start - schedule.lastKeepAliveTime >= AVATAR_KEEP_ALIVE_INTERVAL_USECS) {
+                        schedule.lastKeepAliveTime = start;
+                        addOtherNode(otherNode);
+                    }
+                }
+            };
+            std::for_each(_begin, _end, addKeptAliveNode);
+            std::for_each(_remoteNodes->cbegin(), _remoteNodes->cend(), addKeptAliveNode);
+        }
 
         AvatarSharedPointer thisAvatar = nodeData->getAvatarSharedPointer();
-        ViewFrustum cameraView = nodeData->getViewFrustom();
         std::priority_queue<AvatarPriority> sortedAvatars;
         AvatarData::sortAvatars(avatarList, cameraView, sortedAvatars,
 
@@ -225,16 +273,9 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
                         // Don't bother with these checks if the other avatar has their bubble enabled and we're gettingAnyIgnored
                         if (node->isIgnoreRadiusEnabled() || (avatarNode->isIgnoreRadiusEnabled() && !getsAnyIgnored)) {
 
-                            // Define the scale of the box for the current other node
-                            glm::vec3 otherNodeBoxScale = (avatarNodeData->getPosition() - avatarNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-                            // Set up the bounding box for the current other node
-                            AABox otherNodeBox(avatarNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-                            // Clamp the size of the bounding box to a minimum scale
-                            if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
-                                otherNodeBox.setScaleStayCentered(minBubbleSize);
-                            }
-                            // Quadruple the scale of both bounding boxes
-                            otherNodeBox.embiggen(4.0f);
+                            // Set up the space bubble for the current other node
+                            AABox otherNodeBox = AvatarMixerGrid::bubbleBox(avatarNodeData->getPosition(),
+                                avatarNodeData->getGlobalBoundingBoxCorner());
 
                             // Perform the collision check between the two bounding boxes
                             if (nodeBox.touches(otherNodeBox)) {
@@ -275,25 +316,60 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
                     return shouldIgnore;
                 });
 
-        // loop through our sorted avatars and allocate our bandwidth to them accordingly
-        int avatarRank = 0;
+        // schedule the avatars in view: each one gets a target update rate from its priority, and when their
+        // updates don't all fit in the budget it is shared out by deficit round robin, in proportion to those rates
+        struct ScheduledAvatar {
+            SharedNodePointer node;
+            bool isInView;
+            AvatarMixerClientData::OtherAvatarSchedule* schedule;
+        };
+        std::vector<ScheduledAvatar> scheduledAvatars;
+        scheduledAvatars.reserve(sortedAvatars.size());
 
-        // this is overly conservative, because it includes some avatars we might not consider
-        int remainingAvatars = (int)sortedAvatars.size(); 
+        float totalTargetRate = 0.0f;
+        int expectedUpdateBytes = 0;
 
         while (!sortedAvatars.empty()) {
-            AvatarPriority sortData = sortedAvatars.top();
+            auto otherNode = avatarDataToNodes[sortedAvatars.top().avatar];
+            assert(otherNode); // we can't have gotten here without the avatarData being a valid key in the map
             sortedAvatars.pop();
-            const auto& avatarData = sortData.avatar;
-            avatarRank++;
-            remainingAvatars--;
 
-            auto otherNode = avatarDataToNodes[avatarData];
-            assert(otherNode); // we can't have gotten here without the avatarData being a valid key in the map
+            const AvatarMixerClientData* otherNodeData = reinterpret_cast<const AvatarMixerClientData*>(otherNode->getLinkedData());
+            const AvatarData* otherAvatar = otherNodeData->getConstAvatarData();
+
+            // determine if avatar is in view, to determine how much data to include...
+            AABox otherNodeBox = AvatarMixerGrid::avatarBox(otherAvatar->getClientGlobalPosition(),
+                otherNodeData->getGlobalBoundingBoxCorner());
+            bool isInView = nodeData->otherAvatarInView(otherNodeBox);
+
+            auto& schedule = nodeData->getOtherAvatarSchedule(otherNode->getUUID());
+            schedule.targetRate = isInView ? targetUpdateRate(cameraView, *otherAvatar) : 0.0f;
+            if (isInView) {
+                totalTargetRate += schedule.targetRate;
+                expectedUpdateBytes += std::max(schedule.lastUpdateSize, minimumBytesPerAvatar);
+            } else {
+                expectedUpdateBytes += minimumBytesPerAvatar;
+            }
+
+            scheduledAvatars.push_back({ otherNode, isInView, &schedule });
+        }
+
+        // only share out the budget when it is short, otherwise every avatar in view is sent every frame
+        int numScheduledAvatars = (int)scheduledAvatars.size();
+        float scheduledBytes = maxAvatarBytesPerFrame - minimumBytesPerAvatar * numScheduledAvatars;
+        bool isCongested = expectedUpdateBytes > maxAvatarBytesPerFrame;
+
+        // loop through our sorted avatars and allocate our bandwidth to them accordingly
+        int remainingAvatars = numScheduledAvatars;
+
+        for (auto& scheduledAvatar : scheduledAvatars) {
+            const auto& otherNode = scheduledAvatar.node;
+            auto& schedule = *scheduledAvatar.schedule;
+            remainingAvatars--;
 
             // NOTE: Here's where we determine if we are over budget and drop to bare minimum data
             int minimRemainingAvatarBytes = minimumBytesPerAvatar * remainingAvatars;
-            bool overBudget = (identityBytesSent + numAvatarDataBytes + minimRemainingAvatarBytes) > maxAvatarBytesPerFrame;
+            bool overBudget = (numAvatarDataBytes + minimRemainingAvatarBytes) > maxAvatarBytesPerFrame;
 
             quint64 startAvatarDataPacking = usecTimestampNow();
 
@@ -303,17 +379,22 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
             // If the time that the mixer sent AVATAR DATA about Avatar B to Avatar A is BEFORE OR EQUAL TO
             // the time that Avatar B flagged an IDENTITY DATA change, send IDENTITY DATA about Avatar B to Avatar A.
+            // The identity is sent reliably by the mixer after the broadcast, outside of the avatar data budget.
             if (nodeData->getLastBroadcastTime(otherNode->getUUID()) <= otherNodeData->getIdentityChangeTimestamp()) {
-                identityBytesSent += sendIdentityPacket(otherNodeData, node);
+                nodeData->queueIdentityPacket(otherNode->getUUID());
+                _stats.numIdentityPackets++;
             }
 
-            const AvatarData* otherAvatar = otherNodeData->getConstAvatarData();
-            glm::vec3 otherPosition = otherAvatar->getClientGlobalPosition();
+            bool isInView = scheduledAvatar.isInView;
 
-            // determine if avatar is in view, to determine how much data to include...
-            glm::vec3 otherNodeBoxScale = (otherPosition - otherNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-            AABox otherNodeBox(otherNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-            bool isInView = nodeData->otherAvatarInView(otherNodeBox);
+            // this avatar's share of the budget this frame
+            bool isScheduled = true;
+            if (isInView && isCongested) {
+                float quantum = totalTargetRate > 0.0f ?
+                    std::max(scheduledBytes, 0.0f) * schedule.targetRate / totalTargetRate : 0.0f;
+                schedule.credit = std::min(schedule.credit + quantum, MAX_SCHEDULE_CREDIT);
+                isScheduled = schedule.credit >= (float)schedule.lastUpdateSize;
+            }
 
             // start a new segment in the PacketList for this avatar
             avatarPacketList->startSegment();
@@ -327,6 +408,11 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
             } else if (!isInView) {
                 detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::NoData;
                 nodeData->incrementAvatarOutOfView();
+            } else if (!isScheduled) {
+                // the avatar has used up its share for now, it will catch up as its credit builds
+                detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::NoData;
+                _stats.deferredAvatars++;
+                nodeData->incrementAvatarInView();
             } else {
                 detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO
                     ? AvatarData::SendAllData : AvatarData::CullSmallData;
@@ -334,31 +420,38 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
             }
 
             bool includeThisAvatar = true;
-            auto lastEncodeForOther = nodeData->getLastOtherAvatarEncodeTime(otherNode->getUUID());
+            // the minimal details don't depend on what was sent before, so they must not move the baseline either:
+            // a deferred avatar's changes are still sent once it is scheduled again
+            bool isMinimalDetail = (detail == AvatarData::NoData || detail == AvatarData::PALMinimum);
+            auto lastEncodeForOther = isMinimalDetail ? 0 :
+                nodeData->getLastOtherAvatarEncodeTime(otherNode->getUUID(), _broadcastTime);
             QVector<JointData>& lastSentJointsForOther = nodeData->getLastOtherAvatarSentJoints(otherNode->getUUID());
-            bool distanceAdjust = true;
             glm::vec3 viewerPosition = myPosition;
             AvatarDataPacket::HasFlags hasFlagsOut; // the result of the toByteArray
             bool dropFaceTracking = false;
+            bool cacheHit = false;
 
+            // other listeners may have needed the exact same encoding of this avatar this frame
             quint64 start = usecTimestampNow();
-            QByteArray bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther, 
-                                            hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+            QByteArray bytes = otherNodeData->encodeAvatarDataForListener(detail, lastEncodeForOther, lastSentJointsForOther,
+                                            hasFlagsOut, dropFaceTracking, viewerPosition, &cacheHit);
+            if (cacheHit) {
+                _stats.toByteArrayCacheHits++;
+            }
             quint64 end = usecTimestampNow();
             _stats.toByteArrayElapsedTime += (end - start);
 
-            static const int MAX_ALLOWED_AVATAR_DATA = (1400 - NUM_BYTES_RFC4122_UUID);
             if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
                 qCWarning(avatars) << "otherAvatar.toByteArray() resulted in very large buffer:" << bytes.size() << "... attempt to drop facial data";
 
                 dropFaceTracking = true; // first try dropping the facial data
-                bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+                bytes = otherNodeData->encodeAvatarDataForListener(detail, lastEncodeForOther, lastSentJointsForOther,
+                    hasFlagsOut, dropFaceTracking, viewerPosition);
 
                 if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
                     qCWarning(avatars) << "otherAvatar.toByteArray() without facial data resulted in very large buffer:" << bytes.size() << "... reduce to MinimumData";
-                    bytes = otherAvatar->toByteArray(AvatarData::MinimumData, lastEncodeForOther, lastSentJointsForOther,
-                        hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+                    bytes = otherNodeData->encodeAvatarDataForListener(AvatarData::MinimumData, lastEncodeForOther,
+                        lastSentJointsForOther, hasFlagsOut, dropFaceTracking, viewerPosition);
                 }
 
                 if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
@@ -384,6 +477,14 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
                     // remember the last time we sent details about this other node to the receiver
                     nodeData->setLastBroadcastTime(otherNode->getUUID(), start);
                 }
+
+                if (!isMinimalDetail) {
+                    schedule.lastUpdateSize = bytes.size();
+                    schedule.updateRate.increment();
+                    if (isCongested) {
+                        schedule.credit -= bytes.size();
+                    }
+                }
             }
 
             avatarPacketList->endSegment();
@@ -400,8 +501,8 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
         _stats.numPacketsSent += (int)avatarPacketList->getNumPackets();
         _stats.numBytesSent += numAvatarDataBytes;
 
-        // send the avatar data PacketList
-        nodeList->sendPacketList(std::move(avatarPacketList), *node);
+        // queue the avatar data PacketList, the mixer flushes it with the rest of this frame's packets
+        nodeList->queuePacketList(std::move(avatarPacketList), *node);
 
         // record the bytes sent for other avatar data in the AvatarMixerClientData
         nodeData->recordSentAvatarData(numAvatarDataBytes);
@@ -12,7 +12,10 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <vector>
+
 class AvatarMixerClientData;
+class AvatarMixerGrid;
 
 class AvatarMixerSlaveStats {
 public:
@@ -26,6 +29,8 @@ public:
     int numIdentityPackets { 0 };
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
+    int toByteArrayCacheHits { 0 };
+    int deferredAvatars { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -46,6 +51,8 @@ public:
         numIdentityPackets = 0;
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
+        toByteArrayCacheHits = 0;
+        deferredAvatars = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -65,6 +72,8 @@ public:
         numIdentityPackets += rhs.numIdentityPackets;
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
+        toByteArrayCacheHits += rhs.toByteArrayCacheHits;
+        deferredAvatars += rhs.deferredAvatars;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -81,7 +90,9 @@ public:
     using ConstIter = NodeList::const_iterator;
 
     void configure(ConstIter begin, ConstIter end);
-    void configureBroadcast(ConstIter begin, ConstIter end, 
+    // remoteNodes are the avatars of the other mixers of a federation, also in the grid
+    void configureBroadcast(ConstIter begin, ConstIter end, const AvatarMixerGrid& grid,
+                    const std::vector<SharedNodePointer>& remoteNodes, quint64 broadcastTime,
                     p_high_resolution_clock::time_point lastFrameTimestamp, 
                     float maxKbpsPerNode, float throttlingRatio);
 
@@ -91,11 +102,12 @@ public:
     void harvestStats(AvatarMixerSlaveStats& stats);
 
 private:
-    int sendIdentityPacket(const AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
-
     // frame state
     ConstIter _begin;
     ConstIter _end;
+    const AvatarMixerGrid* _grid { nullptr };
+    const std::vector<SharedNodePointer>* _remoteNodes { nullptr };
+    quint64 _broadcastTime { 0 }; // shared by all of this frame's encodings, so listeners can share them
 
     p_high_resolution_clock::time_point _lastFrameTimestamp;
     float _maxKbpsPerNode { 0.0f };
@@ -75,12 +75,15 @@ void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end
     run(begin, end);
 }
 
-void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
+void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, const AvatarMixerGrid& grid,
+                                     const std::vector<SharedNodePointer>& remoteNodes,
                                      p_high_resolution_clock::time_point lastFrameTimestamp, 
                                      float maxKbpsPerNode, float throttlingRatio) {
     _function = &AvatarMixerSlave::broadcastAvatarData;
+    auto broadcastTime = usecTimestampNow();
     _configure = [&](AvatarMixerSlave& slave) { 
-        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio);
+        slave.configureBroadcast(begin, end, grid, remoteNodes, broadcastTime, lastFrameTimestamp,
+            maxKbpsPerNode, throttlingRatio);
    };
     run(begin, end);
 }
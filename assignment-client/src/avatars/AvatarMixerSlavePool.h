@@ -65,8 +65,8 @@ public:
 
     // Jobs the slave pool can do...
     void processIncomingPackets(ConstIter begin, ConstIter end);
-    void broadcastAvatarData(ConstIter begin, ConstIter end, 
-                    p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio);
+    void broadcastAvatarData(ConstIter begin, ConstIter end, const AvatarMixerGrid& grid,
+                    const std::vector<SharedNodePointer>& remoteNodes, p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio);
 
     // iterate over all slaves
     void each(std::function<void(AvatarMixerSlave& slave)> functor);
@@ -31,8 +31,8 @@ public:
     virtual QByteArray toByteArrayStateful(AvatarDataDetail dataDetail) override;
 
     
-private slots:
-    void update(float deltatime);
+public slots:
+    void update(float deltatime); // the agent calls this each avatar frame, before sending the avatar's data
     
 private:
     AnimationPointer _animation;
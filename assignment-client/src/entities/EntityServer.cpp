@@ -9,18 +9,24 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QtCore/QEventLoop>
 #include <QTimer>
 #include <EntityTree.h>
+#include <Gzip.h>
 #include <SimpleEntitySimulation.h>
 #include <ResourceCache.h>
 #include <ScriptCache.h>
 #include <EntityEditFilters.h>
+#include <PhysicsHelpers.h>
 
 #include "AssignmentParentFinder.h"
 #include "EntityNodeData.h"
 #include "EntityServer.h"
 #include "EntityServerConsts.h"
+#include "EntityServerPhysics.h"
+#include "EntityServerSimulation.h"
 #include "EntityTreeSendThread.h"
 
 const char* MODEL_SERVER_NAME = "Entity";
@@ -45,6 +51,15 @@ EntityServer::~EntityServer() {
         _pruneDeletedEntitiesTimer->stop();
         _pruneDeletedEntitiesTimer->deleteLater();
     }
+    if (_trainCompressionDictionaryTimer) {
+        _trainCompressionDictionaryTimer->stop();
+        _trainCompressionDictionaryTimer->deleteLater();
+    }
+    if (_serverPhysicsTimer) {
+        _serverPhysicsTimer->stop();
+        _serverPhysicsTimer->deleteLater();
+    }
+    _serverPhysics.reset();
 
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
     tree->removeNewlyCreatedHook(this);
@@ -65,7 +80,7 @@ OctreePointer EntityServer::createTree() {
     tree->createRootElement();
     tree->addNewlyCreatedHook(this);
     if (!_entitySimulation) {
-        SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
+        SimpleEntitySimulationPointer simpleSimulation { new EntityServerSimulation() };
         simpleSimulation->setEntityTree(tree);
         tree->setSimulation(simpleSimulation);
         _entitySimulation = simpleSimulation;
@@ -87,13 +102,46 @@ void EntityServer::beforeRun() {
     connect(_pruneDeletedEntitiesTimer, SIGNAL(timeout()), this, SLOT(pruneDeletedEntities()));
     const int PRUNE_DELETED_MODELS_INTERVAL_MSECS = 1 * 1000; // once every second
     _pruneDeletedEntitiesTimer->start(PRUNE_DELETED_MODELS_INTERVAL_MSECS);
+
+    if (_wantCompressionDictionary) {
+        _trainCompressionDictionaryTimer = new QTimer();
+        connect(_trainCompressionDictionaryTimer, SIGNAL(timeout()), this, SLOT(trainCompressionDictionary()));
+        const int TRAIN_COMPRESSION_DICTIONARY_CHECK_MSECS = 10 * 1000; // once every ten seconds
+        _trainCompressionDictionaryTimer->start(TRAIN_COMPRESSION_DICTIONARY_CHECK_MSECS);
+    }
+
+    if (_wantServerPhysics && !_serverPhysicsZoneIDs.isEmpty()) {
+        EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+        auto simulation = std::static_pointer_cast<EntityServerSimulation>(_entitySimulation);
+        _serverPhysics.reset(new EntityServerPhysics(tree, simulation, _serverPhysicsZoneIDs));
+
+        // the entities are owned by the session of the entity server, which it only has once in the domain
+        auto nodeList = DependencyManager::get<NodeList>();
+        _serverPhysics->setSessionUUID(nodeList->getSessionUUID());
+        connect(nodeList.data(), &LimitedNodeList::uuidChanged, this, [this](const QUuid& sessionID, const QUuid& oldSessionID) {
+            if (_serverPhysics) {
+                _serverPhysics->setSessionUUID(sessionID);
+            }
+        });
+
+        _serverPhysicsTimer = new QTimer();
+        connect(_serverPhysicsTimer, SIGNAL(timeout()), this, SLOT(stepServerPhysics()));
+        _serverPhysicsTimer->setTimerType(Qt::PreciseTimer);
+        _serverPhysicsTimer->start((int)(PHYSICS_ENGINE_FIXED_SUBSTEP * MSECS_PER_SECOND));
+    }
+}
+
+void EntityServer::stepServerPhysics() {
+    if (_serverPhysics) {
+        _serverPhysics->step();
+    }
 }
 
 void EntityServer::entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
 }
 
 
-// EntityServer will use the "special packets" to send list of recently deleted entities
+// EntityServer will use the "special packets" to send list of recently deleted entities, and its compression dictionary
 bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
     bool shouldSendDeletedEntities = false;
 
@@ -112,7 +160,38 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
         #endif
     }
 
-    return shouldSendDeletedEntities;
+    bool shouldSendCompressionDictionary = false;
+    OctreeQueryNode* queryNode = static_cast<OctreeQueryNode*>(node->getLinkedData());
+    if (queryNode) {
+        QReadLocker locker(&_compressionDictionaryLock);
+        shouldSendCompressionDictionary = queryNode->getSentCompressionDictionaryID() != _compressionDictionaryID;
+    }
+
+    return shouldSendDeletedEntities || shouldSendCompressionDictionary;
+}
+
+int EntityServer::sendCompressionDictionary(const SharedNodePointer& node, OctreeQueryNode* queryNode) {
+    quint32 dictionaryID;
+    QByteArray dictionary;
+    {
+        QReadLocker locker(&_compressionDictionaryLock);
+        dictionaryID = _compressionDictionaryID;
+        dictionary = _compressionDictionary;
+    }
+    if (queryNode->getSentCompressionDictionaryID() == dictionaryID) {
+        return 0;
+    }
+
+    // until the node's query says it has this one, its packets aren't compressed with a dictionary
+    queryNode->setSentCompressionDictionary(dictionaryID, dictionary);
+    if (dictionary.isEmpty()) {
+        return 0;
+    }
+
+    auto dictionaryPacketList = NLPacketList::create(PacketType::EntityCompressionDictionary, QByteArray(), true, true);
+    dictionaryPacketList->write(dictionary);
+    DependencyManager::get<NodeList>()->sendPacketList(std::move(dictionaryPacketList), *node);
+    return dictionary.size();
 }
 
 // FIXME - most of the old code for this was encapsulated in EntityTree, I liked that design from a data
@@ -120,20 +199,19 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
 // of entities being deleted at the same time. I'd like to look to move this back into EntityTree but
 // for now this works and addresses the bug.
 int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) {
-    int totalBytes = 0;
+    int totalBytes = sendCompressionDictionary(node, queryNode);
+    packetsSent = 0;
 
     EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
-    if (nodeData) {
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    if (nodeData && tree->hasEntitiesDeletedSince(nodeData->getLastDeletedEntitiesSentAt())) {
 
         quint64 deletedEntitiesSentAt = nodeData->getLastDeletedEntitiesSentAt();
         quint64 considerEntitiesSince = EntityTree::getAdjustedConsiderSince(deletedEntitiesSentAt);
 
         quint64 deletePacketSentAt = usecTimestampNow();
-        EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
         auto recentlyDeleted = tree->getRecentlyDeletedEntityIDs();
 
-        packetsSent = 0;
-
         // create a new special packet
         std::unique_ptr<NLPacket> deletesPacket = NLPacket::create(PacketType::EntityErase);
 
@@ -254,6 +332,102 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
 }
 
 
+void EntityServer::trainCompressionDictionary() {
+    const quint64 RETRAIN_COMPRESSION_DICTIONARY_USECS = 10 * 60 * USECS_PER_SECOND; // every ten minutes
+    const int MAX_COMPRESSION_DICTIONARY_BYTES = 32 * 1024; // zlib's window
+    const int MIN_COMPRESSION_DICTIONARY_STRING_BYTES = 8;
+    const int MAX_COMPRESSION_DICTIONARY_SAMPLED_ENTITIES = 1000;
+
+    quint64 now = usecTimestampNow();
+    if (_lastCompressionDictionaryTraining != 0 && now - _lastCompressionDictionaryTraining < RETRAIN_COMPRESSION_DICTIONARY_USECS) {
+        return;
+    }
+
+    // count the strings the entities share, and the directories their URLs share
+    QHash<QByteArray, int> stringCounts;
+    auto countString = [&](const QString& value) {
+        QByteArray utf8 = value.toUtf8();
+        if (utf8.size() >= MIN_COMPRESSION_DICTIONARY_STRING_BYTES) {
+            stringCounts[utf8]++;
+            int lastSlash = utf8.lastIndexOf('/');
+            if (lastSlash >= MIN_COMPRESSION_DICTIONARY_STRING_BYTES && lastSlash < utf8.size() - 1) {
+                stringCounts[utf8.left(lastSlash + 1)]++;
+            }
+        }
+    };
+
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    QVector<EntityItemPointer> entities;
+    tree->withReadLock([&] {
+        tree->findEntities(AACube(glm::vec3(-HALF_TREE_SCALE), TREE_SCALE), entities);
+    });
+    if (entities.isEmpty()) {
+        return;
+    }
+
+    // the strings worth having are shared by many entities, so a sample spread across the tree finds them without
+    // copying out the properties of every entity in a big domain
+    int sampleStride = (entities.size() + MAX_COMPRESSION_DICTIONARY_SAMPLED_ENTITIES - 1)
+        / MAX_COMPRESSION_DICTIONARY_SAMPLED_ENTITIES;
+    int numSampled = 0;
+    for (int i = 0; i < entities.size(); i += sampleStride) {
+        EntityItemProperties properties = entities[i]->getProperties();
+        numSampled++;
+        countString(properties.getName());
+        countString(properties.getDescription());
+        countString(properties.getHref());
+        countString(properties.getScript());
+        countString(properties.getServerScripts());
+        countString(properties.getUserData());
+        countString(properties.getMarketplaceID());
+        countString(properties.getCollisionSoundURL());
+        countString(properties.getModelURL());
+        countString(properties.getCompoundShapeURL());
+        countString(properties.getTextures());
+        countString(properties.getSourceUrl());
+        countString(properties.getText());
+        countString(properties.getXTextureURL());
+        countString(properties.getYTextureURL());
+        countString(properties.getZTextureURL());
+    }
+    _lastCompressionDictionaryTraining = now;
+
+    // the strings worth the most (the bytes they would save) that fit, with the best last, where zlib reaches them
+    // with the shortest distances
+    std::vector<std::pair<qint64, QByteArray>> scoredStrings;
+    for (auto it = stringCounts.constBegin(); it != stringCounts.constEnd(); ++it) {
+        if (it.value() > 1) {
+            scoredStrings.emplace_back((qint64)it.value() * it.key().size(), it.key());
+        }
+    }
+    std::sort(scoredStrings.begin(), scoredStrings.end(), [](const std::pair<qint64, QByteArray>& a,
+                                                             const std::pair<qint64, QByteArray>& b) {
+        return a.first > b.first;
+    });
+    std::vector<QByteArray> dictionaryStrings;
+    int dictionarySize = 0;
+    for (const auto& scoredString : scoredStrings) {
+        if (dictionarySize + scoredString.second.size() <= MAX_COMPRESSION_DICTIONARY_BYTES) {
+            dictionaryStrings.push_back(scoredString.second);
+            dictionarySize += scoredString.second.size();
+        }
+    }
+    QByteArray dictionary;
+    dictionary.reserve(dictionarySize);
+    for (auto it = dictionaryStrings.rbegin(); it != dictionaryStrings.rend(); ++it) {
+        dictionary.append(*it);
+    }
+    quint32 dictionaryID = dictionary.isEmpty() ? 0 : compressionDictionaryID(dictionary);
+
+    QWriteLocker locker(&_compressionDictionaryLock);
+    if (dictionaryID != _compressionDictionaryID) {
+        qDebug() << "Trained a" << dictionary.size() << "byte compression dictionary from" << numSampled << "of"
+            << entities.size() << "entities, ID" << dictionaryID;
+        _compressionDictionaryID = dictionaryID;
+        _compressionDictionary = dictionary;
+    }
+}
+
 void EntityServer::pruneDeletedEntities() {
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
     if (tree->hasAnyDeletedEntities()) {
@@ -309,6 +483,35 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
         
         entityEditFilters->addFilter(EntityItemID(), filterURL);
     }
+
+    readOptionBool(QString("compressionDictionary"), settingsSectionObject, _wantCompressionDictionary);
+    qDebug("compressionDictionary=%s", debug::valueOf(_wantCompressionDictionary));
+
+    readOptionBool(QString("serverPhysics"), settingsSectionObject, _wantServerPhysics);
+    qDebug("serverPhysics=%s", debug::valueOf(_wantServerPhysics));
+
+    QString serverPhysicsZones;
+    _serverPhysicsZoneIDs.clear();
+    if (readOptionString("serverPhysicsZones", settingsSectionObject, serverPhysicsZones)) {
+        for (auto& zoneID : serverPhysicsZones.split(',', QString::SkipEmptyParts)) {
+            QUuid id(zoneID.trimmed());
+            if (!id.isNull()) {
+                _serverPhysicsZoneIDs.push_back(id);
+            }
+        }
+    }
+    qDebug() << "serverPhysicsZones=" << _serverPhysicsZoneIDs;
+
+    QString congestionControlName;
+    if (readOptionString("congestionControl", settingsSectionObject, congestionControlName) && !congestionControlName.isEmpty()) {
+        auto ccFactory = udt::congestionControlFactoryForName(congestionControlName.toStdString());
+        if (ccFactory) {
+            DependencyManager::get<NodeList>()->setCongestionControlFactory(std::move(ccFactory));
+            qDebug() << "congestionControl=" << congestionControlName;
+        } else {
+            qWarning() << "Unknown congestionControl" << congestionControlName << "- keeping the default.";
+        }
+    }
 }
 
 void EntityServer::entityFilterAdded(EntityItemID id, bool success) {
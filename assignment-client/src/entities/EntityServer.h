@@ -29,6 +29,7 @@ struct ViewerSendingStats {
 
 class SimpleEntitySimulation;
 using SimpleEntitySimulationPointer = std::shared_ptr<SimpleEntitySimulation>;
+class EntityServerPhysics;
 
 
 class EntityServer : public OctreeServer, public NewlyCreatedEntityHook {
@@ -63,6 +64,8 @@ public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
     void pruneDeletedEntities();
+    void trainCompressionDictionary();
+    void stepServerPhysics();
     void entityFilterAdded(EntityItemID id, bool success);
 
 protected:
@@ -73,9 +76,25 @@ private slots:
     void handleEntityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
+    int sendCompressionDictionary(const SharedNodePointer& node, OctreeQueryNode* queryNode);
+
     SimpleEntitySimulationPointer _entitySimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
+    // a zlib preset dictionary of the strings the entities share, for compressing the packets of clients that have it
+    bool _wantCompressionDictionary { true };
+    QTimer* _trainCompressionDictionaryTimer = nullptr;
+    quint64 _lastCompressionDictionaryTraining { 0 };
+    QReadWriteLock _compressionDictionaryLock;
+    quint32 _compressionDictionaryID { 0 };
+    QByteArray _compressionDictionary;
+
+    // the dynamic entities in these zones are simulated by the entity server rather than by the interfaces
+    bool _wantServerPhysics { false };
+    QVector<QUuid> _serverPhysicsZoneIDs;
+    std::unique_ptr<EntityServerPhysics> _serverPhysics;
+    QTimer* _serverPhysicsTimer = nullptr;
+
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 };
@@ -0,0 +1,216 @@
+//
+//  EntityServerPhysics.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityServerPhysics.h"
+
+#include <QSet>
+
+#include <DirtyOctreeElementOperator.h>
+#include <MovingEntitiesOperator.h>
+#include <PhysicsHelpers.h>
+#include <SharedUtil.h>
+#include <SimulationOwner.h>
+
+static const quint64 ZONE_SCAN_PERIOD = USECS_PER_SECOND; // entities are taken in and out of the zones this often
+
+EntityServerPhysics::EntityServerPhysics(EntityTreePointer tree, EntityServerSimulationPointer simulation,
+                                         const QVector<QUuid>& zoneIDs) :
+    _tree(tree),
+    _simulation(simulation),
+    _zoneIDs(zoneIDs)
+{
+    ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine = std::make_shared<PhysicsEngine>(Vectors::ZERO);
+    _physicsEngine->init();
+}
+
+EntityServerPhysics::~EntityServerPhysics() {
+    // the interfaces take over the simulation of the entities we let go
+    _tree->withWriteLock([&] {
+        for (auto motionState : _motionStates.values()) {
+            removeEntity(motionState);
+        }
+    });
+    _physicsEngine.reset();
+}
+
+void EntityServerPhysics::setSessionUUID(const QUuid& sessionID) {
+    _sessionID = sessionID;
+    Physics::setSessionUUID(sessionID);
+}
+
+bool EntityServerPhysics::isOwned(const EntityItemPointer& entity) const {
+    return !_sessionID.isNull() && entity->getSimulatorID() == _sessionID;
+}
+
+void EntityServerPhysics::step() {
+    if (_sessionID.isNull()) {
+        return;
+    }
+
+    _tree->withWriteLock([&] {
+        quint64 now = usecTimestampNow();
+        if (now > _nextZoneScan) {
+            _nextZoneScan = now + ZONE_SCAN_PERIOD;
+            updateEntitiesInZones();
+        }
+
+        for (auto motionState : _motionStates.values()) {
+            if (motionState->getEntity()->isDead()) {
+                removeEntity(motionState);
+            }
+        }
+
+        // the edits of interfaces and scripts, which the simulation kept in the dirty flags of the entities
+        SetOfEntities changedEntities;
+        _simulation->takePhysicalEntitiesChanged(changedEntities);
+        VectorOfMotionStates changes;
+        for (auto& entity : changedEntities) {
+            EntityMotionState* motionState = _motionStates.value(entity->getEntityItemID());
+            if (motionState && motionState->getIncomingDirtyFlags() & DIRTY_PHYSICS_FLAGS) {
+                changes.push_back(motionState);
+            }
+        }
+        _physicsEngine->changeObjects(changes);
+
+        _physicsEngine->stepSimulation();
+        if (!_physicsEngine->hasOutgoingChanges()) {
+            return;
+        }
+
+        // the motion states have already moved the entities, which are sorted and broadcast from here
+        SetOfEntities movedEntities;
+        for (auto motionState : _physicsEngine->getChangedMotionStates()) {
+            EntityItemPointer entity = static_cast<EntityMotionState*>(motionState)->getEntity();
+            if (isOwned(entity)) {
+                movedEntities.insert(entity);
+            }
+        }
+        for (auto motionState : _physicsEngine->getDeactivatedMotionStates()) {
+            EntityItemPointer entity = static_cast<EntityMotionState*>(motionState)->getEntity();
+            if (isOwned(entity)) {
+                entity->setVelocity(Vectors::ZERO);
+                entity->setAngularVelocity(Vectors::ZERO);
+                movedEntities.insert(entity);
+            }
+        }
+        // there are no scripts on the entity server to tell of collisions, this only prunes the contacts
+        _physicsEngine->getCollisionEvents();
+
+        MovingEntitiesOperator moveOperator(_tree);
+        for (auto entity : movedEntities) {
+            entity->computePuffedQueryAACube();
+            bool success;
+            AACube newCube = entity->getQueryAACube(success);
+            if (success) {
+                moveOperator.addEntityToMoveList(entity, newCube);
+            }
+        }
+        if (moveOperator.hasMovingEntities()) {
+            _tree->recurseTreeWithOperator(&moveOperator);
+        }
+        for (auto entity : movedEntities) {
+            broadcastEntity(entity);
+        }
+    });
+}
+
+void EntityServerPhysics::updateEntitiesInZones() {
+    QSet<EntityItemID> entitiesInZones;
+    for (auto& zoneID : _zoneIDs) {
+        EntityItemPointer zone = _tree->findEntityByID(zoneID);
+        if (!zone || zone->getType() != EntityTypes::Zone) {
+            continue;
+        }
+        bool success;
+        AABox zoneBox = zone->getAABox(success);
+        if (!success) {
+            continue;
+        }
+        QVector<EntityItemPointer> foundEntities;
+        _tree->findEntities(zoneBox, foundEntities);
+        for (auto& entity : foundEntities) {
+            if (entity->isDead() || !entity->shouldBePhysical()) {
+                continue;
+            }
+            // the dynamic entities are simulated while inside, the others only need to touch the zone to be collided with
+            if (entity->getDynamic() && !zone->contains(entity->getPosition())) {
+                continue;
+            }
+            entitiesInZones.insert(entity->getEntityItemID());
+            if (!_motionStates.contains(entity->getEntityItemID())) {
+                addEntity(entity);
+            }
+        }
+    }
+
+    for (auto motionState : _motionStates.values()) {
+        EntityItemPointer entity = motionState->getEntity();
+        if (!entitiesInZones.contains(entity->getEntityItemID())) {
+            removeEntity(motionState);
+        } else if (entity->getDynamic() && !isOwned(entity)) {
+            claimEntity(entity);
+        } else if (!entity->getDynamic() && isOwned(entity)) {
+            releaseEntity(entity);
+        }
+    }
+}
+
+void EntityServerPhysics::addEntity(EntityItemPointer entity) {
+    if (entity->getPhysicsInfo() || !entity->isReadyToComputeShape()) {
+        return;
+    }
+    ShapeInfo shapeInfo;
+    entity->computeShapeInfo(shapeInfo);
+    if (shapeInfo.getType() == SHAPE_TYPE_COMPOUND || shapeInfo.getType() == SHAPE_TYPE_STATIC_MESH) {
+        // the hulls and meshes come from models, which the entity server doesn't load
+        return;
+    }
+    btCollisionShape* shape = const_cast<btCollisionShape*>(_shapeManager.getShape(shapeInfo));
+    if (!shape) {
+        return;
+    }
+
+    EntityMotionState* motionState = new EntityMotionState(shape, entity);
+    entity->setPhysicsInfo(static_cast<void*>(motionState));
+    _motionStates.insert(entity->getEntityItemID(), motionState);
+    if (entity->getDynamic()) {
+        claimEntity(entity);
+    }
+    _physicsEngine->addObjects(VectorOfMotionStates({ motionState }));
+}
+
+void EntityServerPhysics::removeEntity(EntityMotionState* motionState) {
+    EntityItemPointer entity = motionState->getEntity();
+    _physicsEngine->removeObjects(VectorOfMotionStates({ motionState }));
+    if (isOwned(entity) && !entity->isDead()) {
+        releaseEntity(entity);
+    }
+    entity->setPhysicsInfo(nullptr);
+    _motionStates.remove(entity->getEntityItemID());
+    delete motionState;
+}
+
+void EntityServerPhysics::claimEntity(EntityItemPointer entity) {
+    entity->setSimulationOwner(_sessionID, SERVER_SIMULATION_PRIORITY);
+    broadcastEntity(entity);
+}
+
+void EntityServerPhysics::releaseEntity(EntityItemPointer entity) {
+    entity->clearSimulationOwnership();
+    broadcastEntity(entity);
+}
+
+void EntityServerPhysics::broadcastEntity(EntityItemPointer entity) {
+    // the send threads pick up what has changed since they last sent, as for any edit
+    entity->setLastEdited(usecTimestampNow());
+    DirtyOctreeElementOperator op(entity->getElement());
+    _tree->recurseTreeWithOperator(&op);
+}
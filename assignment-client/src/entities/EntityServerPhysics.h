@@ -0,0 +1,60 @@
+//
+//  EntityServerPhysics.h
+//  assignment-client/src/entities
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityServerPhysics_h
+#define hifi_EntityServerPhysics_h
+
+#include <QHash>
+#include <QUuid>
+#include <QVector>
+
+#include <EntityMotionState.h>
+#include <EntityTree.h>
+#include <PhysicsEngine.h>
+#include <ShapeManager.h>
+
+#include "EntityServerSimulation.h"
+
+/// Simulates the dynamic entities in the configured zones on the entity server, which owns them at
+/// SERVER_SIMULATION_PRIORITY: interfaces neither bid for them nor send their updates, they get the
+/// server's changes along with every other change to the tree.  The other collidable entities in the zones
+/// are in the simulation for the dynamic ones to collide with.
+class EntityServerPhysics {
+public:
+    EntityServerPhysics(EntityTreePointer tree, EntityServerSimulationPointer simulation, const QVector<QUuid>& zoneIDs);
+    ~EntityServerPhysics();
+
+    /// \param sessionID the entity server's own, as the owner of the entities it simulates
+    void setSessionUUID(const QUuid& sessionID);
+
+    void step();
+
+private:
+    void updateEntitiesInZones();
+    void addEntity(EntityItemPointer entity);
+    void removeEntity(EntityMotionState* motionState);
+    void claimEntity(EntityItemPointer entity);
+    void releaseEntity(EntityItemPointer entity);
+    void broadcastEntity(EntityItemPointer entity);
+    bool isOwned(const EntityItemPointer& entity) const;
+
+    EntityTreePointer _tree;
+    EntityServerSimulationPointer _simulation;
+    QVector<QUuid> _zoneIDs;
+    QUuid _sessionID;
+
+    // the ShapeManager outlives the PhysicsEngine and the EntityMotionStates, which release their shapes to it
+    ShapeManager _shapeManager;
+    PhysicsEnginePointer _physicsEngine;
+    QHash<EntityItemID, EntityMotionState*> _motionStates;
+    quint64 _nextZoneScan { 0 };
+};
+
+#endif // hifi_EntityServerPhysics_h
@@ -0,0 +1,42 @@
+//
+//  EntityServerSimulation.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityServerSimulation.h"
+
+#include <ObjectMotionState.h>
+
+void EntityServerSimulation::takePhysicalEntitiesChanged(SetOfEntities& entitiesOut) {
+    QMutexLocker lock(&_mutex);
+    entitiesOut.swap(_physicalEntitiesChanged);
+    _physicalEntitiesChanged.clear();
+}
+
+void EntityServerSimulation::changeEntityInternal(EntityItemPointer entity) {
+    uint32_t physicsFlags = entity->getPhysicsInfo() ? (entity->getDirtyFlags() & DIRTY_PHYSICS_FLAGS) : 0;
+    SimpleEntitySimulation::changeEntityInternal(entity);
+    if (physicsFlags) {
+        // left for EntityServerPhysics, which hands them to its engine on its next step
+        entity->markDirtyFlags(physicsFlags);
+        QMutexLocker lock(&_mutex);
+        _physicalEntitiesChanged.insert(entity);
+    }
+}
+
+void EntityServerSimulation::removeEntityInternal(EntityItemPointer entity) {
+    SimpleEntitySimulation::removeEntityInternal(entity);
+    QMutexLocker lock(&_mutex);
+    _physicalEntitiesChanged.remove(entity);
+}
+
+void EntityServerSimulation::clearEntitiesInternal() {
+    SimpleEntitySimulation::clearEntitiesInternal();
+    QMutexLocker lock(&_mutex);
+    _physicalEntitiesChanged.clear();
+}
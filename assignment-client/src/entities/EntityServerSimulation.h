@@ -0,0 +1,34 @@
+//
+//  EntityServerSimulation.h
+//  assignment-client/src/entities
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityServerSimulation_h
+#define hifi_EntityServerSimulation_h
+
+#include <SimpleEntitySimulation.h>
+
+class EntityServerSimulation;
+using EntityServerSimulationPointer = std::shared_ptr<EntityServerSimulation>;
+
+/// The entity server's simulation: a SimpleEntitySimulation that also keeps the edits of the entities simulated by
+/// EntityServerPhysics, whose physics dirty flags it would otherwise clear before the physics engine sees them.
+class EntityServerSimulation : public SimpleEntitySimulation {
+public:
+    /// the entities with physics info that were changed since the last call, their physics dirty flags still set
+    void takePhysicalEntitiesChanged(SetOfEntities& entitiesOut);
+
+protected:
+    virtual void changeEntityInternal(EntityItemPointer entity) override;
+    virtual void removeEntityInternal(EntityItemPointer entity) override;
+    virtual void clearEntitiesInternal() override;
+
+    SetOfEntities _physicalEntitiesChanged;
+};
+
+#endif // hifi_EntityServerSimulation_h
@@ -11,10 +11,13 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
+#include <QtCore/QThread>
 #include <QBuffer>
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 #include "MessagesMixer.h"
 
@@ -24,44 +27,80 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 {
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &MessagesMixer::nodeKilled);
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::MessagesData, this, "handleMessages");
-    packetReceiver.registerListener(PacketType::MessagesSubscribe, this, "handleMessagesSubscribe");
-    packetReceiver.registerListener(PacketType::MessagesUnsubscribe, this, "handleMessagesUnsubscribe");
+    packetReceiver.registerShardedListener(PacketType::MessagesData, this,
+        [this](QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+            handleMessages(message, senderNode);
+        });
+    packetReceiver.registerShardedListener(PacketType::MessagesSubscribe, this,
+        [this](QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+            handleMessagesSubscribe(message, senderNode);
+        });
+    packetReceiver.registerShardedListener(PacketType::MessagesUnsubscribe, this,
+        [this](QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+            handleMessagesUnsubscribe(message, senderNode);
+        });
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
+    QWriteLocker locker(&_channelSubscribersLock);
     for (auto& channel : _channelSubscribers) {
         channel.remove(killedNode->getUUID());
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    // the subscribers get the message exactly as it was sent, text or binary, so only its channel is decoded
+    QString channel = MessagesClient::decodeMessagesChannel(receivedMessage);
+    QByteArray payload = receivedMessage->getMessage();
 
     auto nodeList = DependencyManager::get<NodeList>();
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    QSet<QUuid> subscribers;
+    {
+        QReadLocker locker(&_channelSubscribersLock);
+        subscribers = _channelSubscribers.value(channel);
+    }
+
+    int numSent = 0;
+    if (!subscribers.isEmpty()) {
+        nodeList->eachMatchingNode(
+            [&](const SharedNodePointer& node)->bool {
+            return node->getActiveSocket() && subscribers.contains(node->getUUID());
+        },
+            [&](const SharedNodePointer& node) {
+            // the reliable lists are sequenced per connection, only their payload is shared
+            auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+            packetList->write(payload);
+            nodeList->sendPacketList(std::move(packetList), *node);
+            numSent++;
+        });
+    }
+
+    QMutexLocker locker(&_channelStatsLock);
+    ChannelStats& stats = _channelStats[channel];
+    stats.messagesIn++;
+    stats.bytesIn += payload.size();
+    stats.messagesOut += numSent;
+    stats.bytesOut += (quint64)numSent * payload.size();
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (!senderNode) {
+        return;
+    }
+
     QString channel = QString::fromUtf8(message->getMessage());
+    QWriteLocker locker(&_channelSubscribersLock);
     _channelSubscribers[channel] << senderNode->getUUID();
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (!senderNode) {
+        return;
+    }
+
     QString channel = QString::fromUtf8(message->getMessage());
+    QWriteLocker locker(&_channelSubscribersLock);
     if (_channelSubscribers.contains(channel)) {
         _channelSubscribers[channel].remove(senderNode->getUUID());
     }
@@ -80,6 +119,30 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // the rates of each channel since the last stats
+    quint64 now = usecTimestampNow();
+    float secondsSinceLastStats = (float)(now - _lastStatsTime) / (float)USECS_PER_SECOND;
+    _lastStatsTime = now;
+    QHash<QString, ChannelStats> channelStats;
+    {
+        QMutexLocker locker(&_channelStatsLock);
+        channelStats.swap(_channelStats);
+    }
+    QJsonObject channelsObject;
+    if (secondsSinceLastStats > 0.0f) {
+        for (auto it = channelStats.cbegin(); it != channelStats.cend(); ++it) {
+            const ChannelStats& stats = it.value();
+            QJsonObject channelObject;
+            channelObject["messages_in_per_second"] = stats.messagesIn / secondsSinceLastStats;
+            channelObject["messages_out_per_second"] = stats.messagesOut / secondsSinceLastStats;
+            channelObject["inbound_kbps"] = (stats.bytesIn * BITS_IN_BYTE) / (secondsSinceLastStats * BYTES_PER_KILOBYTE);
+            channelObject["outbound_kbps"] = (stats.bytesOut * BITS_IN_BYTE) / (secondsSinceLastStats * BYTES_PER_KILOBYTE);
+            channelsObject[it.key()] = channelObject;
+        }
+    }
+    statsObject["channels"] = channelsObject;
+
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -87,4 +150,13 @@ void MessagesMixer::run() {
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
+
+    // fan out inbound messages across worker threads, leaving one core for the node list and socket
+    const int MIN_DISPATCH_SHARDS = 1;
+    nodeList->getPacketReceiver().setNumDispatchShards(std::max(QThread::idealThreadCount() - 1, MIN_DISPATCH_SHARDS));
+}
+
+void MessagesMixer::aboutToFinish() {
+    // stop the dispatch shards now so that no handler runs against this mixer once it is gone
+    DependencyManager::get<NodeList>()->getPacketReceiver().setNumDispatchShards(0);
 }
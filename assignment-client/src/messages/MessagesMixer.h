@@ -15,6 +15,10 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <QtCore/QMutex>
+#include <QtCore/QReadWriteLock>
+
+#include <SharedUtil.h>
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -25,16 +29,28 @@ public:
 
 public slots:
     void run() override;
+    void aboutToFinish() override;
     void nodeKilled(SharedNodePointer killedNode);
     void sendStatsPacket() override;
 
-private slots:
+private:
+    // these are called on the packet receiver's dispatch shards, so _channelSubscribers is guarded by a lock
     void handleMessages(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
-private:
+    QReadWriteLock _channelSubscribersLock;
     QHash<QString,QSet<QUuid>> _channelSubscribers;
+
+    struct ChannelStats {
+        quint64 messagesIn { 0 };
+        quint64 bytesIn { 0 };
+        quint64 messagesOut { 0 };
+        quint64 bytesOut { 0 };
+    };
+    QMutex _channelStatsLock;
+    QHash<QString, ChannelStats> _channelStats; // since the last stats packet
+    quint64 _lastStatsTime { usecTimestampNow() };
 };
 
 #endif // hifi_MessagesMixer_h
@@ -75,12 +75,85 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+void OctreeInboundPacketProcessor::setNumEditLanes(int numLanes) {
+    numLanes = std::max(numLanes, 0);
+
+    if (getNumEditLanes() == numLanes) {
+        return;
+    }
+
+    qDebug() << "Changing number of edit lanes from" << getNumEditLanes() << "to" << numLanes;
+
+    std::vector<std::unique_ptr<EditLane>> editLanes;
+    editLanes.reserve(numLanes);
+    for (int i = 0; i < numLanes; ++i) {
+        editLanes.emplace_back(new EditLane([this](QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+            processEditMessage(message, sendingNode);
+
+            QMutexLocker locker(&_editLanesLock);
+            auto it = _lanePacketCounts.find(sendingNode->getUUID());
+            if (it != _lanePacketCounts.end() && --it.value() <= 0) {
+                _lanePacketCounts.erase(it);
+            }
+        }));
+    }
+
+    {
+        QMutexLocker locker(&_editLanesLock);
+        _editLanes.swap(editLanes);
+    }
+
+    // each old lane drains its queue before its thread is joined, so nothing already handed to it is dropped.
+    // This happens outside of the lock, since the lanes take it as they finish each packet.
+    editLanes.clear();
+}
+
+void OctreeInboundPacketProcessor::terminating() {
+    _shuttingDown = true;
+
+    // the lanes skip whatever is still queued once we're shutting down, so this doesn't wait on any edits
+    std::vector<std::unique_ptr<EditLane>> editLanes;
+    {
+        QMutexLocker locker(&_editLanesLock);
+        _editLanes.swap(editLanes);
+        _lanePacketCounts.clear();
+    }
+    editLanes.clear();
+
+    ReceivedPacketProcessor::terminating();
+}
+
+bool OctreeInboundPacketProcessor::hasLanePacketsFrom(const QUuid& nodeUUID) {
+    QMutexLocker locker(&_editLanesLock);
+    return _lanePacketCounts.value(nodeUUID) > 0;
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
         return;
     }
 
+    if (sendingNode) {
+        QMutexLocker locker(&_editLanesLock);
+        if (!_editLanes.empty()) {
+            // pick the lane by sender so that everything from one sender is applied on the same thread, in order
+            const QUuid& nodeUUID = sendingNode->getUUID();
+            _lanePacketCounts[nodeUUID]++;
+            _editLanes[qHash(nodeUUID) % _editLanes.size()]->push({ sendingNode, message });
+            return;
+        }
+    }
+
+    processEditMessage(message, sendingNode);
+}
+
+void OctreeInboundPacketProcessor::processEditMessage(QSharedPointer<ReceivedMessage> message,
+                                                      SharedNodePointer sendingNode) {
+    if (_shuttingDown) {
+        return;
+    }
+
     bool debugProcessPacket = _myServer->wantsVerboseDebug();
 
     if (debugProcessPacket) {
@@ -157,13 +230,12 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+            // the tree takes its own write lock, for only as long as it's changing, so the send threads aren't
+            // held up by the decoding and filtering of each edit
+            quint64 thisLockWaitTime = 0;
+            quint64 startProcess = usecTimestampNow();
+            int editDataBytesRead =
+                _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode, thisLockWaitTime);
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
@@ -172,8 +244,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
 
             editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
+            quint64 thisProcessTime = endProcess - startProcess - thisLockWaitTime;
             processTime += thisProcessTime;
             lockWaitTime += thisLockWaitTime;
 
@@ -261,7 +332,7 @@ int OctreeInboundPacketProcessor::sendNackPackets() {
 
         // if there are packets from _node that are waiting to be processed,
         // don't send a NACK since the missing packets may be among those waiting packets.
-        if (hasPacketsToProcessFrom(nodeUUID)) {
+        if (hasPacketsToProcessFrom(nodeUUID) || hasLanePacketsFrom(nodeUUID)) {
             ++i;
             continue;
         }
@@ -309,6 +380,34 @@ int OctreeInboundPacketProcessor::sendNackPackets() {
 }
 
 
+OctreeInboundPacketProcessor::EditLane::EditLane(Handler handler) :
+    _handler(handler),
+    _thread([this] { run(); })
+{
+}
+
+OctreeInboundPacketProcessor::EditLane::~EditLane() {
+    // an empty packet tells the lane thread to stop
+    _packets.push(NodeSharedReceivedMessagePair());
+    _thread.join();
+}
+
+void OctreeInboundPacketProcessor::EditLane::run() {
+    NodeSharedReceivedMessagePair packet;
+    while (true) {
+        _packets.pop(packet);
+
+        if (!packet.second) {
+            return;
+        }
+
+        _handler(packet.second, packet.first);
+
+        // release our references now rather than holding them until the next packet arrives
+        packet = NodeSharedReceivedMessagePair();
+    }
+}
+
 SingleSenderStats::SingleSenderStats()
     : _totalTransitTime(0),
     _totalProcessTime(0),
@@ -14,6 +14,13 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <tbb/concurrent_queue.h>
+
 #include <ReceivedPacketProcessor.h>
 
 #include "SequenceNumberStats.h"
@@ -74,7 +81,13 @@ public:
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
 
-    virtual void terminating() override { _shuttingDown = true; ReceivedPacketProcessor::terminating(); }
+    // With edit lanes, edit packets are applied on that many threads instead of this one. The lane is picked by
+    // sender, so each sender's edits are still applied in the order they were sent. With no lanes (the default)
+    // every edit is applied on this thread.
+    void setNumEditLanes(int numLanes);
+    int getNumEditLanes() const { return (int)_editLanes.size(); }
+
+    virtual void terminating() override;
 
 protected:
 
@@ -88,11 +101,31 @@ private:
     int sendNackPackets();
 
 private:
+    class EditLane {
+    public:
+        using Handler = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+
+        EditLane(Handler handler);
+        ~EditLane();
+
+        void push(NodeSharedReceivedMessagePair packet) { _packets.push(std::move(packet)); }
+
+    private:
+        void run();
+
+        Handler _handler;
+        tbb::concurrent_bounded_queue<NodeSharedReceivedMessagePair> _packets;
+        std::thread _thread;
+    };
+
+    void processEditMessage(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    bool hasLanePacketsFrom(const QUuid& nodeUUID);
+
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
 
     OctreeServer* _myServer;
-    int _receivedPacketCount;
+    std::atomic<int> _receivedPacketCount;
     
     std::atomic<uint64_t> _totalTransitTime;
     std::atomic<uint64_t> _totalProcessTime;
@@ -104,6 +137,10 @@ private:
     QReadWriteLock _senderStatsLock;
 
     std::atomic<uint64_t> _lastNackTime;
-    bool _shuttingDown;
+    std::atomic<bool> _shuttingDown;
+
+    QMutex _editLanesLock;
+    std::vector<std::unique_ptr<EditLane>> _editLanes; // guarded by _editLanesLock
+    QHash<QUuid, int> _lanePacketCounts; // guarded by _editLanesLock
 };
 #endif // hifi_OctreeInboundPacketProcessor_h
@@ -26,6 +26,11 @@
 quint64 startSceneSleepTime = 0;
 quint64 endSceneSleepTime = 0;
 
+// subtrees closer than this are ranked as if they were this far away, so that the one around the viewer doesn't
+// outrank everything else by orders of magnitude
+const float MIN_PRIORITY_DISTANCE = 1.0f; // meters
+const float OUT_OF_VIEW_PRIORITY_SCALE = 0.1f;
+
 OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     _myServer(myServer),
     _node(node),
@@ -351,7 +356,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     int targetSize = MAX_OCTREE_PACKET_DATA_SIZE;
     targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
 
-    _packetData.changeSettings(true, targetSize); // FIXME - eventually support only compressed packets
+    // FIXME - eventually support only compressed packets
+    _packetData.changeSettings(true, targetSize, nodeData->getCompressionDictionary());
 
     // If the current view frustum has changed OR we have nothing to send, then search against
     // the current view frustum for things to send.
@@ -391,6 +397,20 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         nodeData->stats.sceneStarted(isFullScene, viewFrustumChanged,
                                      _myServer->getOctree()->getRoot(), _myServer->getJurisdiction());
 
+        // rank the subtrees that didn't fit in a packet by how large they look from the viewer, so that what is in
+        // front of them arrives first rather than whatever the traversal reaches first
+        if (nodeData->getUsesFrustum()) {
+            ViewFrustum viewFrustum;
+            nodeData->copyCurrentViewFrustum(viewFrustum);
+            nodeData->elementBag.setPriorityFunction([viewFrustum](const OctreeElementPointer& element) {
+                float distance = std::max(element->distanceToCamera(viewFrustum), MIN_PRIORITY_DISTANCE);
+                float priority = element->getScale() / distance;
+                return element->isInView(viewFrustum) ? priority : priority * OUT_OF_VIEW_PRIORITY_SCALE;
+            });
+        } else {
+            nodeData->elementBag.setPriorityFunction(nullptr);
+        }
+
         // This is the start of "resending" the scene.
         bool dontRestartSceneOnMove = false; // this is experimental
         if (dontRestartSceneOnMove) {
@@ -542,7 +562,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                     // a larger compressed size then uncompressed size
                     targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE) - COMPRESS_PADDING;
                 }
-                _packetData.changeSettings(true, targetSize); // will do reset - NOTE: Always compressed
+                // will do reset - NOTE: Always compressed
+                _packetData.changeSettings(true, targetSize, nodeData->getCompressionDictionary());
 
             }
             OctreeServer::trackTreeWaitTime(lockWaitElapsedUsec);
@@ -19,6 +19,7 @@
 #include <AccountManager.h>
 #include <HTTPConnection.h>
 #include <LogHandler.h>
+#include <Metrics.h>
 #include <shared/NetworkUtils.h>
 #include <NetworkingConstants.h>
 #include <NumericalConstants.h>
@@ -1060,6 +1061,15 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
 
         _persistAsFileType = "json.gz";
+        QString persistFileType;
+        if (readOptionString("persistFileType", settingsSectionObject, persistFileType)) {
+            if (persistFileType == "json.gz" || persistFileType == "bin") {
+                _persistAsFileType = persistFileType;
+            } else {
+                qWarning() << "Unknown persistFileType" << persistFileType << "- using" << _persistAsFileType;
+            }
+        }
+        qDebug() << "persistFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         readOptionInt(QString("persistInterval"), settingsSectionObject, _persistInterval);
@@ -1156,6 +1166,18 @@ void OctreeServer::domainSettingsRequestComplete() {
     connect(nodeList.data(), SIGNAL(nodeAdded(SharedNodePointer)), SLOT(nodeAdded(SharedNodePointer)));
     connect(nodeList.data(), SIGNAL(nodeKilled(SharedNodePointer)), SLOT(nodeKilled(SharedNodePointer)));
 
+    // the send threads count their packets already
+    auto& metricsRegistry = metrics::Registry::getInstance();
+    metricsRegistry.addCollectedCounter("octree_server_packets_sent_total", [] {
+        return (uint64_t)OctreeSendThread::_totalPackets;
+    });
+    metricsRegistry.addCollectedCounter("octree_server_bytes_sent_total", [] {
+        return (uint64_t)OctreeSendThread::_totalBytes;
+    });
+    metricsRegistry.addCollectedGauge("octree_server_clients", [] {
+        return (int64_t)getCurrentClientCount();
+    });
+
 #ifndef WIN32
     setvbuf(stdout, NULL, _IOLBF, 0);
 #endif
@@ -1279,6 +1301,12 @@ void OctreeServer::domainSettingsRequestComplete() {
     // set up our OctreeServerPacketProcessor
     _octreeInboundPacketProcessor = new OctreeInboundPacketProcessor(this);
     _octreeInboundPacketProcessor->initialize(true);
+
+    int editProcessingThreads = 0;
+    if (readOptionInt(QString("editProcessingThreads"), _settings, editProcessingThreads)) {
+        qDebug("editProcessingThreads=%d", editProcessingThreads);
+        _octreeInboundPacketProcessor->setNumEditLanes(editProcessingThreads);
+    }
     
     // Convert now to tm struct for local timezone
     tm* localtm = localtime(&_started);
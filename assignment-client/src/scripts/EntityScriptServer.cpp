@@ -13,6 +13,9 @@
 
 #include <mutex>
 
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
@@ -104,7 +107,7 @@ void EntityScriptServer::handleReloadEntityServerScriptPacket(QSharedPointer<Rec
 
         if (_entityViewer.getTree() && !_shuttingDown) {
             qCDebug(entity_script_server) << "Reloading: " << entityID;
-            _entitiesScriptEngine->unloadEntityScript(entityID);
+            unloadEntityScript(entityID);
             checkAndCallPreload(entityID, true);
         }
     }
@@ -122,7 +125,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = getScriptEngineForEntity(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -164,10 +168,35 @@ void EntityScriptServer::handleSettings() {
 
     qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+
+    static const QString NUM_SCRIPT_ENGINES_OPTION = "entity_script_engines";
+    int numEngines = std::max(1, entityScriptServerSettings[NUM_SCRIPT_ENGINES_OPTION].toInt(DEFAULT_NUM_ENTITY_SCRIPT_ENGINES));
+    if (numEngines != _numEntitiesScriptEngines) {
+        qDebug() << "Running server entity scripts in" << numEngines << "script engines";
+        _numEntitiesScriptEngines = numEngines;
+
+        // move the running scripts to their engines in the new set
+        QList<QUuid> entityIDs;
+        {
+            Lock lock(_entitiesScriptEnginesLock);
+            entityIDs = _entityScriptEngines.keys();
+        }
+        for (auto& engine : _entitiesScriptEngines) {
+            engine->unloadAllEntityScripts();
+            engine->stop();
+        }
+        resetEntitiesScriptEngines();
+        for (auto& entityID : entityIDs) {
+            checkAndCallPreload(entityID, true);
+        }
+    }
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = 0;
+    for (auto& engine : _entitiesScriptEngines) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplaction would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -254,8 +283,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     // we need to make sure that init has been called for our EntityScriptingInterface
     // so that it actually has a jurisdiction listener when we ask it for it next
@@ -414,7 +443,28 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    std::vector<QSharedPointer<ScriptEngine>> newEngines;
+    for (int i = 0; i < _numEntitiesScriptEngines; i++) {
+        // one engine drives the viewer's queries and the tree's simulation, for all of them
+        newEngines.push_back(createEntitiesScriptEngine(i == 0));
+    }
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(this);
+
+    for (auto& engine : _entitiesScriptEngines) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    }
+    {
+        Lock lock(_entitiesScriptEnginesLock);
+        _entitiesScriptEngines.swap(newEngines);
+        _entityScriptEngines.clear();
+    }
+    for (auto& engine : _entitiesScriptEngines) {
+        connect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    }
+}
+
+QSharedPointer<ScriptEngine> EntityScriptServer::createEntitiesScriptEngine(bool isUpdater) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = QSharedPointer<ScriptEngine>(new ScriptEngine(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName),
                                                   &ScriptEngine::deleteLater);
@@ -431,40 +481,88 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->update();
-    });
+    if (isUpdater) {
+        connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->update();
+        });
+    }
 
 
     newEngine->runInThread();
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngine.data());
+    return newEngine;
+}
+
+QSharedPointer<ScriptEngine> EntityScriptServer::getScriptEngineForEntity(const EntityItemID& entityID) {
+    Lock lock(_entitiesScriptEnginesLock);
+    return _entityScriptEngines.value(entityID);
+}
 
-    disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+QSharedPointer<ScriptEngine> EntityScriptServer::getScriptEngineForScript(const QString& scriptURL) {
+    Lock lock(_entitiesScriptEnginesLock);
+    if (_entitiesScriptEngines.empty()) {
+        return QSharedPointer<ScriptEngine>();
+    }
+    return _entitiesScriptEngines[qHash(scriptURL) % _entitiesScriptEngines.size()];
+}
+
+void EntityScriptServer::unloadEntityScript(const EntityItemID& entityID, bool shouldRemoveFromMap) {
+    QSharedPointer<ScriptEngine> engine;
+    {
+        Lock lock(_entitiesScriptEnginesLock);
+        engine = _entityScriptEngines.take(entityID);
+    }
+    if (engine) {
+        engine->unloadEntityScript(entityID, shouldRemoveFromMap);
+    }
+}
+
+void EntityScriptServer::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params) {
+    auto engine = getScriptEngineForEntity(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params);
+    }
+}
+
+QFuture<QVariant> EntityScriptServer::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getScriptEngineForEntity(entityID);
+    if (!engine) {
+        // any engine answers for an entity it isn't running
+        Lock lock(_entitiesScriptEnginesLock);
+        if (_entitiesScriptEngines.empty()) {
+            return QFuture<QVariant>();
+        }
+        engine = _entitiesScriptEngines.front();
+    }
+    return engine->getLocalEntityScriptDetails(entityID);
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    // unload and stop the engines
+    for (auto& engine : _entitiesScriptEngines) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
+        engine->unloadAllEntityScripts();
+        engine->stop();
     }
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
+    } else {
+        DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(nullptr);
+        Lock lock(_entitiesScriptEnginesLock);
+        _entityScriptEngines.clear();
+        _entitiesScriptEngines.clear();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (auto& engine : _entitiesScriptEngines) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -476,37 +574,57 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        unloadEntityScript(entityID, true);
     }
 }
 
 void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID, const bool reload) {
     if (_entityViewer.getTree() && !_shuttingDown) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+        unloadEntityScript(entityID, true);
         checkAndCallPreload(entityID, reload);
     }
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, const bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && !_entitiesScriptEngines.empty()) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool notRunning = !_entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        auto runningEngine = getScriptEngineForEntity(entityID);
+        bool notRunning = !runningEngine || !runningEngine->getEntityScriptDetails(entityID, details);
         if (entity && (reload || notRunning || details.scriptText != entity->getServerScripts())) {
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = ResourceManager::normalizeURL(scriptUrl);
+                auto engine = getScriptEngineForScript(scriptUrl);
+                if (runningEngine && runningEngine != engine) {
+                    runningEngine->unloadEntityScript(entityID, true);
+                }
+                {
+                    Lock lock(_entitiesScriptEnginesLock);
+                    _entityScriptEngines.insert(entityID, engine);
+                }
                 qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID;
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, reload);
+                engine->loadEntityScript(entityID, scriptUrl, reload);
             }
         }
     }
 }
 
 void EntityScriptServer::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    QJsonArray engineStats;
+    {
+        Lock lock(_entitiesScriptEnginesLock);
+        for (auto& engine : _entitiesScriptEngines) {
+            engineStats.append(QJsonObject::fromVariantMap(engine->getMemoryStats()));
+        }
+    }
+    statsObject["script_memory"] = engineStats;
 
+    addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -519,7 +637,7 @@ void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> mess
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
             int piggyBackedSizeWithHeader = message->getSize() - statsMessageLength;
 
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
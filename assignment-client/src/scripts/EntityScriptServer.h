@@ -12,12 +12,15 @@
 #ifndef hifi_EntityScriptServer_h
 #define hifi_EntityScriptServer_h
 
+#include <mutex>
 #include <set>
 #include <vector>
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtCore/QUuid>
 
+#include <EntitiesScriptEngineProvider.h>
 #include <EntityEditPacketSender.h>
 #include <EntityTreeHeadlessViewer.h>
 #include <plugins/CodecPlugin.h>
@@ -26,8 +29,12 @@
 
 static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
+static const int DEFAULT_NUM_ENTITY_SCRIPT_ENGINES = 1;
 
-class EntityScriptServer : public ThreadedAssignment {
+// Runs the server entity scripts, spread across one or more script engines, each on its own thread.  An entity's
+// script runs in the engine its URL hashes to, so entities sharing a script share its engine and module cache.
+// Entities.callEntityMethod is routed to the engine running the target entity, and Messages reaches every engine.
+class EntityScriptServer : public ThreadedAssignment, public EntitiesScriptEngineProvider {
     Q_OBJECT
 
 public:
@@ -36,6 +43,11 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // EntitiesScriptEngineProvider, called from the script engines' threads
+    virtual void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                        const QStringList& params = QStringList()) override;
+    virtual QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
 public slots:
     void run() override;
     void nodeActivated(SharedNodePointer activatedNode);
@@ -61,7 +73,11 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    QSharedPointer<ScriptEngine> createEntitiesScriptEngine(bool isUpdater);
+    QSharedPointer<ScriptEngine> getScriptEngineForEntity(const EntityItemID& entityID);
+    QSharedPointer<ScriptEngine> getScriptEngineForScript(const QString& scriptURL);
+    void unloadEntityScript(const EntityItemID& entityID, bool shouldRemoveFromMap = false);
     void clear();
     void shutdownScriptEngine();
 
@@ -75,7 +91,10 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    QSharedPointer<ScriptEngine> _entitiesScriptEngine;
+    int _numEntitiesScriptEngines { DEFAULT_NUM_ENTITY_SCRIPT_ENGINES };
+    std::vector<QSharedPointer<ScriptEngine>> _entitiesScriptEngines;
+    QHash<QUuid, QSharedPointer<ScriptEngine>> _entityScriptEngines; // the engine running each entity's script
+    std::mutex _entitiesScriptEnginesLock; // for both, which the engines' threads read
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
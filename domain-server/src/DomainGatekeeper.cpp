@@ -346,6 +346,12 @@ SharedNodePointer DomainGatekeeper::processAssignmentConnectRequest(const NodeCo
 
     nodeData->setWasAssigned(true);
 
+    if (nodeConnection.nodeType == NodeType::AudioMixer) {
+        nodeData->setAudioMixerRegion(DomainServer::audioMixerRegionFromPayload(matchingQueuedAssignment->getPayload()));
+    } else if (nodeConnection.nodeType == NodeType::AvatarMixer) {
+        nodeData->setAvatarMixerIndex(DomainServer::avatarMixerIndexFromPayload(matchingQueuedAssignment->getPayload()));
+    }
+
     // cleanup the PendingAssignedNodeData for this assignment now that it's connecting
     _pendingAssignedNodes.erase(it);
 
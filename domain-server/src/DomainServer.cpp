@@ -31,15 +31,18 @@
 #include <HifiConfigVariantMap.h>
 #include <HTTPConnection.h>
 #include <LogUtils.h>
+#include <Metrics.h>
 #include <NetworkingConstants.h>
 #include <udt/PacketHeaders.h>
 #include <SettingHandle.h>
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
+#include <StreamUtils.h>
 #include <UUID.h>
 #include <LogHandler.h>
 #include <PathUtils.h>
 #include <NumericalConstants.h>
+#include <OctalCode.h>
 
 #include "DomainServerNodeData.h"
 #include "NodeConnectionData.h"
@@ -483,6 +486,14 @@ void DomainServer::setupNodeListAndAssignments() {
 
     auto nodeList = DependencyManager::set<LimitedNodeList>(domainServerPort, domainServerDTLSPort);
 
+    // the audio mixers of the regions are all connected at once, as are the avatar mixers of a federation
+    if (!_audioMixerRegions.isEmpty()) {
+        nodeList->removeSoloNodeType(NodeType::AudioMixer);
+    }
+    if (_numAvatarMixers > 1) {
+        nodeList->removeSoloNodeType(NodeType::AvatarMixer);
+    }
+
     // no matter the local port, save it to shared mem so that local assignment clients can ask what it is
     nodeList->putLocalPortIntoSharedMemory(DOMAIN_SERVER_LOCAL_PORT_SMEM_KEY, this, nodeList->getSocketLocalPort());
 
@@ -527,6 +538,7 @@ void DomainServer::setupNodeListAndAssignments() {
     packetReceiver.registerListener(PacketType::DomainListRequest, this, "processListRequestPacket");
     packetReceiver.registerListener(PacketType::DomainServerPathQuery, this, "processPathQueryPacket");
     packetReceiver.registerListener(PacketType::NodeJsonStats, this, "processNodeJSONStatsPacket");
+    packetReceiver.registerListener(PacketType::NodeMetrics, this, "processNodeMetricsPacket");
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest, this, "processNodeDisconnectRequestPacket");
 
     // NodeList won't be available to the settings manager when it is created, so call registerListener here
@@ -821,6 +833,34 @@ void DomainServer::populateDefaultStaticAssignmentsExcludingTypes(const QSet<Ass
                 }
             }
 
+            if (defaultedType == Assignment::AudioMixerType) {
+                parseAudioMixerRegions();
+                if (!_audioMixerRegions.isEmpty()) {
+                    createAudioMixerRegionAssignments();
+                    continue;
+                }
+            }
+
+            if (defaultedType == Assignment::AvatarMixerType) {
+                static const QString AVATAR_MIXER_NUM_MIXERS_KEYPATH = "avatar_mixer.num_mixers";
+
+                int numMixers = _settingsManager.valueOrDefaultValueForKeyPath(AVATAR_MIXER_NUM_MIXERS_KEYPATH).toInt();
+                if (numMixers > 1) {
+                    createAvatarMixerFederationAssignments(numMixers);
+                    continue;
+                }
+            }
+
+            if (defaultedType == Assignment::EntityServerType) {
+                static const QString ENTITY_SERVER_SHARDS_KEYPATH = "entity_server_settings.shards";
+
+                int numShards = _settingsManager.valueOrDefaultValueForKeyPath(ENTITY_SERVER_SHARDS_KEYPATH).toInt();
+                if (numShards > 1) {
+                    createEntityServerShardAssignments(numShards);
+                    continue;
+                }
+            }
+
             // type has not been set from a command line or config file config, use the default
             // by clearing whatever exists and writing a single default assignment with no payload
             Assignment* newAssignment = new Assignment(Assignment::CreateCommand, (Assignment::Type) defaultedType);
@@ -829,11 +869,172 @@ void DomainServer::populateDefaultStaticAssignmentsExcludingTypes(const QSet<Ass
     }
 }
 
+void DomainServer::createEntityServerShardAssignments(int numShards) {
+    // the shards split the octree by its top level octants: each of the others takes one of the first octants whole,
+    // and the first takes the root, less those octants
+    const int MAX_ENTITY_SERVER_SHARDS = 8;
+    numShards = qMin(numShards, MAX_ENTITY_SERVER_SHARDS);
+
+    QStringList octantCodes;
+    for (int i = 1; i < numShards; ++i) {
+        unsigned char* octantCode = childOctalCode(nullptr, i);
+        octantCodes << octalCodeToHexString(octantCode);
+        delete[] octantCode;
+    }
+
+    // every shard persists its entities to a file of its own, next to where the single server would have
+    static const QString PERSIST_FILE_PATH_KEYPATH = "entity_server_settings.persistFilePath";
+    static const QString PERSIST_FILE_EXTENSION = ".json.gz";
+    QString persistFilePath = _settingsManager.valueOrDefaultValueForKeyPath(PERSIST_FILE_PATH_KEYPATH).toString();
+    if (persistFilePath.endsWith(PERSIST_FILE_EXTENSION)) {
+        persistFilePath.chop(PERSIST_FILE_EXTENSION.size());
+    }
+
+    qDebug() << "Splitting the entities between" << numShards << "entity servers";
+
+    Assignment* rootAssignment = new Assignment(Assignment::CreateCommand, Assignment::EntityServerType);
+    rootAssignment->setPayload(QString("--jurisdictionRoot 00 --jurisdictionEndNodes %1")
+        .arg(octantCodes.join(',')).toUtf8());
+    addStaticAssignmentToAssignmentHash(rootAssignment);
+
+    for (int i = 0; i < octantCodes.size(); ++i) {
+        Assignment* octantAssignment = new Assignment(Assignment::CreateCommand, Assignment::EntityServerType);
+        octantAssignment->setPayload(QString("--jurisdictionRoot %1 --persistFilePath %2-shard%3%4")
+            .arg(octantCodes[i]).arg(persistFilePath).arg(i + 1).arg(PERSIST_FILE_EXTENSION).toUtf8());
+        addStaticAssignmentToAssignmentHash(octantAssignment);
+    }
+}
+
+static const QString AUDIO_MIXER_REGION_OPTION = "--region";
+static const QString AVATAR_MIXER_FEDERATION_INDEX_OPTION = "--federationIndex";
+
+static int intOptionFromPayload(const QByteArray& payload, const QString& option) {
+    QStringList payloadArguments = QString(payload).split(' ', QString::SkipEmptyParts);
+    int optionIndex = payloadArguments.indexOf(option);
+    if (optionIndex < 0 || optionIndex + 1 >= payloadArguments.size()) {
+        return -1;
+    }
+    bool ok;
+    int value = payloadArguments[optionIndex + 1].toInt(&ok);
+    return ok ? value : -1;
+}
+
+void DomainServer::createAvatarMixerFederationAssignments(int numMixers) {
+    qDebug() << "Splitting the avatars between" << numMixers << "avatar mixers";
+
+    _numAvatarMixers = numMixers;
+    for (int i = 0; i < numMixers; ++i) {
+        Assignment* federationAssignment = new Assignment(Assignment::CreateCommand, Assignment::AvatarMixerType);
+        federationAssignment->setPayload(QString("%1 %2").arg(AVATAR_MIXER_FEDERATION_INDEX_OPTION).arg(i).toUtf8());
+        addStaticAssignmentToAssignmentHash(federationAssignment);
+    }
+}
+
+int DomainServer::avatarMixerIndexFromPayload(const QByteArray& payload) {
+    return intOptionFromPayload(payload, AVATAR_MIXER_FEDERATION_INDEX_OPTION);
+}
+
+int DomainServer::avatarMixerIndexForNode(const QUuid& nodeID) const {
+    // the uploading nodes are spread over the mixers by their session, which they keep as long as they're connected
+    return (int)(qHash(nodeID) % (uint)_numAvatarMixers);
+}
+
+void DomainServer::parseAudioMixerRegions() {
+    static const QString MIXER_REGIONS_KEYPATH = "audio_env.mixer_regions";
+    _audioMixerRegions.clear();
+
+    const QVariant* regionsVariant = valueForKeyPath(_settingsManager.getSettingsMap(), MIXER_REGIONS_KEYPATH);
+    if (!regionsVariant) {
+        return;
+    }
+
+    // the regions are columns of the domain, as the audio mixers read them
+    const QString X_MIN = "x_min";
+    const QString X_MAX = "x_max";
+    const QString Z_MIN = "z_min";
+    const QString Z_MAX = "z_max";
+    for (const QVariant& regionVariant : regionsVariant->toList()) {
+        QVariantMap regionMap = regionVariant.toMap();
+
+        float xMin, xMax, zMin, zMax;
+        bool ok, allOk = true;
+        xMin = regionMap.value(X_MIN).toString().toFloat(&ok);
+        allOk &= ok;
+        xMax = regionMap.value(X_MAX).toString().toFloat(&ok);
+        allOk &= ok;
+        zMin = regionMap.value(Z_MIN).toString().toFloat(&ok);
+        allOk &= ok;
+        zMax = regionMap.value(Z_MAX).toString().toFloat(&ok);
+        allOk &= ok;
+
+        if (!allOk) {
+            qWarning() << "Invalid audio mixer region" << regionMap << "- the domain has a single audio mixer";
+            _audioMixerRegions.clear();
+            return;
+        }
+        _audioMixerRegions.push_back(AABox(glm::vec3(xMin, 0.0f, zMin), glm::vec3(xMax - xMin, 0.0f, zMax - zMin)));
+    }
+
+    // one region is the whole domain
+    if (_audioMixerRegions.size() < 2) {
+        _audioMixerRegions.clear();
+    }
+}
+
+void DomainServer::createAudioMixerRegionAssignments() {
+    qDebug() << "Splitting the audio between" << _audioMixerRegions.size() << "audio mixers";
+
+    for (int i = 0; i < _audioMixerRegions.size(); ++i) {
+        Assignment* regionAssignment = new Assignment(Assignment::CreateCommand, Assignment::AudioMixerType);
+        regionAssignment->setPayload(QString("%1 %2").arg(AUDIO_MIXER_REGION_OPTION).arg(i).toUtf8());
+        addStaticAssignmentToAssignmentHash(regionAssignment);
+    }
+}
+
+int DomainServer::audioMixerRegionFromPayload(const QByteArray& payload) {
+    return intOptionFromPayload(payload, AUDIO_MIXER_REGION_OPTION);
+}
+
+int DomainServer::audioMixerRegionForPosition(const glm::vec3& position, int currentRegion) const {
+    // the distance across the regions, in the horizontal plane
+    auto distanceToRegion = [&](int region) {
+        const AABox& box = _audioMixerRegions[region];
+        glm::vec2 corner(box.getCorner().x, box.getCorner().z);
+        glm::vec2 point(position.x, position.z);
+        glm::vec2 closest = glm::clamp(point, corner, corner + glm::vec2(box.getScale().x, box.getScale().z));
+        return glm::distance(point, closest);
+    };
+
+    int nearestRegion = 0;
+    float nearestDistance = distanceToRegion(0);
+    for (int i = 1; i < _audioMixerRegions.size(); ++i) {
+        float distance = distanceToRegion(i);
+        if (distance < nearestDistance) {
+            nearestRegion = i;
+            nearestDistance = distance;
+        }
+    }
+
+    // switching mixers drops a little audio, so a node walking along a border stays on its mixer for a while
+    const float REGION_HYSTERESIS = 5.0f; // meters
+    if (currentRegion >= 0 && currentRegion < _audioMixerRegions.size() &&
+        distanceToRegion(currentRegion) <= nearestDistance + REGION_HYSTERESIS) {
+        return currentRegion;
+    }
+    return nearestRegion;
+}
+
 void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
 
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
+    quint32 ackedListVersion;
+    packetStream >> ackedListVersion;
+
+    glm::vec3 position;
+    packetStream >> position;
+
     // update this node's sockets in case they have changed
     sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
     sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
@@ -852,7 +1053,12 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    nodeData->setPosition(position);
+    if (!_audioMixerRegions.isEmpty() && sendingNode->getType() != NodeType::AudioMixer) {
+        nodeData->setAudioMixerRegion(audioMixerRegionForPosition(position, nodeData->getAudioMixerRegion()));
+    }
+
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), ackedListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -882,6 +1088,19 @@ bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedN
             return false;
         }
 
+        // in a domain split into regions, the nodes other than the mixers get the audio mixer of their region only
+        if (!_audioMixerRegions.isEmpty() && nodeB->getType() == NodeType::AudioMixer
+            && nodeA->getType() != NodeType::AudioMixer && nodeBData) {
+            int regionA = std::max(nodeAData->getAudioMixerRegion(), 0);
+            return nodeBData->getAudioMixerRegion() == regionA;
+        }
+
+        // in a federation of avatar mixers, the nodes other than the mixers upload to one of them only
+        if (_numAvatarMixers > 1 && nodeB->getType() == NodeType::AvatarMixer
+            && nodeA->getType() != NodeType::AvatarMixer && nodeBData) {
+            return nodeBData->getAvatarMixerIndex() == avatarMixerIndexForNode(nodeA->getUUID());
+        }
+
         bool isScriptServerForIneffectiveAgent =
             (nodeA->getType() == NodeType::EntityScriptServer && nodeB->getType() == NodeType::Agent)
             && ((nodeBData && !nodeBData->getNodeInterestSet().contains(NodeType::EntityScriptServer))
@@ -962,9 +1181,21 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
+static const uint NODE_HASH_SEED = 0x9e3779b9;
+
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint32 ackedListVersion) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
 
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    // a node that missed a list, or never had one, gets all of the nodes again
+    auto& sentNodeHashes = nodeData->getSentNodeHashes();
+    if (ackedListVersion == 0 || ackedListVersion != nodeData->getDomainListVersion()) {
+        sentNodeHashes.clear();
+    }
+    quint32 listVersion = nodeData->nextDomainListVersion();
+
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
@@ -975,14 +1206,10 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << listVersion;
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
-    // always send the node their own UUID back
-    QDataStream domainListStream(domainListPackets.get());
-
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
@@ -992,19 +1219,35 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
         if (nodeData->isAuthenticated()) {
             // if this authenticated node has any interest types, send back those nodes as well
             limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+                if (otherNode->getUUID() == node->getUUID()) {
+                    return;
+                }
+                if (!isInInterestSet(node, otherNode)) {
+                    // the node forgets those that leave its interest, it's sent them again if they come back
+                    sentNodeHashes.remove(otherNode->getUUID());
+                    return;
+                }
+                QByteArray nodeBytes;
+                QDataStream nodeStream(&nodeBytes, QIODevice::WriteOnly);
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+                // don't send avatar nodes to other avatars, that will come from avatar mixer
+                nodeStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+                // pack the secret that these two nodes will use to communicate with each other
+                nodeStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
+                // skip the nodes that haven't changed since the node was last sent them
+                quint64 nodeHash = ((quint64)qHash(nodeBytes, 0) << 32) | qHash(nodeBytes, NODE_HASH_SEED);
+                auto sentNodeHash = sentNodeHashes.find(otherNode->getUUID());
+                if (sentNodeHash != sentNodeHashes.end() && sentNodeHash.value() == nodeHash) {
+                    return;
                 }
+                sentNodeHashes[otherNode->getUUID()] = nodeHash;
+
+                // the node goes whole in a segment
+                domainListPackets->startSegment();
+                domainListPackets->write(nodeBytes);
+                domainListPackets->endSegment();
             });
         }
     }
@@ -1549,6 +1792,13 @@ void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> pa
     }
 }
 
+void DomainServer::processNodeMetricsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    auto nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
+    if (nodeData) {
+        nodeData->setSerializedMetrics(packetList->getMessage());
+    }
+}
+
 QJsonObject DomainServer::jsonForSocket(const HifiSockAddr& socket) {
     QJsonObject socketJSON;
 
@@ -1639,6 +1889,7 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
     const QString URI_ASSIGNMENT = "/assignment";
     const QString URI_NODES = "/nodes";
+    const QString URI_METRICS = "/metrics";
     const QString URI_SETTINGS = "/settings";
 
     const QString UUID_REGEX_STRING = "[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}";
@@ -1794,6 +2045,28 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             // send the response
             connection->respond(HTTPConnection::StatusCode200, nodesDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == URI_METRICS) {
+            // the metrics the nodes last sent, labelled with their type and UUID, in the Prometheus text format
+            metrics::TextWriter metricsWriter;
+            metricsWriter.add(metrics::Registry::getInstance().serialize(), "type=\"domain-server\"");
+
+            nodeList->eachNode([&metricsWriter](const SharedNodePointer& node) {
+                auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+                if (!nodeData || nodeData->getSerializedMetrics().isEmpty()) {
+                    return;
+                }
+
+                QString nodeTypeName = NodeType::getNodeTypeName(node->getType()).toLower();
+                nodeTypeName.replace(' ', '-');
+                QByteArray labels = "type=\"" + nodeTypeName.toUtf8() + "\",uuid=\"" +
+                    uuidStringWithoutCurlyBraces(node->getUUID()).toUtf8() + "\"";
+                if (!metricsWriter.add(nodeData->getSerializedMetrics(), labels)) {
+                    qDebug() << "Could not read the metrics of" << node->getUUID();
+                }
+            });
+
+            connection->respond(HTTPConnection::StatusCode200, metricsWriter.toText(), "text/plain; version=0.0.4");
             return true;
         } else {
             // check if this is for json stats for a node
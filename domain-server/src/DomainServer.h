@@ -21,6 +21,7 @@
 #include <QtCore/QUrl>
 #include <QAbstractNativeEventFilter>
 
+#include <AABox.h>
 #include <Assignment.h>
 #include <HTTPSConnection.h>
 #include <LimitedNodeList.h>
@@ -56,6 +57,12 @@ public:
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
     bool handleHTTPSRequest(HTTPSConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
+    // the region of an audio mixer's assignment, or -1 if it mixes the whole domain
+    static int audioMixerRegionFromPayload(const QByteArray& payload);
+
+    // the index of an avatar mixer's assignment in a federation of avatar mixers, or -1 if it is the only one
+    static int avatarMixerIndexFromPayload(const QByteArray& payload);
+
 public slots:
     /// Called by NodeList to inform us a node has been added
     void nodeAdded(SharedNodePointer node);
@@ -69,6 +76,7 @@ public slots:
     void processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> packet);
     void processListRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
+    void processNodeMetricsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
     void processPathQueryPacket(QSharedPointer<ReceivedMessage> packet);
     void processNodeDisconnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message);
@@ -130,7 +138,9 @@ private:
 
     void handleKillNode(SharedNodePointer nodeToKill);
 
-    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    // the node is sent the nodes that changed since the list of ackedListVersion, all of them if it doesn't have that one
+    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr,
+                              quint32 ackedListVersion = 0);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -141,6 +151,16 @@ private:
     void addStaticAssignmentToAssignmentHash(Assignment* newAssignment);
     void createStaticAssignmentsForType(Assignment::Type type, const QVariantList& configList);
     void populateDefaultStaticAssignmentsExcludingTypes(const QSet<Assignment::Type>& excludedTypes);
+    void createEntityServerShardAssignments(int numShards);
+
+    // a domain can be split into regions, each mixed by an audio mixer of its own (see AudioMixerBridge)
+    void parseAudioMixerRegions();
+    void createAudioMixerRegionAssignments();
+    int audioMixerRegionForPosition(const glm::vec3& position, int currentRegion) const;
+
+    // a domain can have several avatar mixers, each with a share of the avatars (see AvatarMixerFederation)
+    void createAvatarMixerFederationAssignments(int numMixers);
+    int avatarMixerIndexForNode(const QUuid& nodeID) const;
     void populateStaticScriptedAssignmentsFromSettings();
 
     SharedAssignmentPointer dequeueMatchingAssignment(const QUuid& checkInUUID, NodeType_t nodeType);
@@ -169,6 +189,8 @@ private:
     HTTPSManager* _httpsManager;
 
     QHash<QUuid, SharedAssignmentPointer> _allAssignments;
+    QVector<AABox> _audioMixerRegions;
+    int _numAvatarMixers { 1 };
     QQueue<SharedAssignmentPointer> _unfulfilledAssignments;
     TransactionHash _pendingAssignmentCredits;
 
@@ -16,6 +16,8 @@
 #include <QtCore/QHash>
 #include <QtCore/QUuid>
 
+#include <glm/glm.hpp>
+
 #include <HifiSockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
@@ -29,6 +31,10 @@ public:
 
     void updateJSONStats(QByteArray statsByteArray);
 
+    // the metrics the node last sent, as metrics::Registry serialized them
+    const QByteArray& getSerializedMetrics() const { return _serializedMetrics; }
+    void setSerializedMetrics(const QByteArray& serializedMetrics) { _serializedMetrics = serializedMetrics; }
+
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
 
@@ -48,6 +54,11 @@ public:
 
     QHash<QUuid, QUuid>& getSessionSecretHash() { return _sessionSecretHash; }
 
+    // the version of the last domain list sent to this node, and the hashes of each node in the lists up to it
+    quint32 getDomainListVersion() const { return _domainListVersion; }
+    quint32 nextDomainListVersion() { return ++_domainListVersion; }
+    QHash<QUuid, quint64>& getSentNodeHashes() { return _sentNodeHashes; }
+
     const NodeSet& getNodeInterestSet() const { return _nodeInterestSet; }
     void setNodeInterestSet(const NodeSet& nodeInterestSet) { _nodeInterestSet = nodeInterestSet; }
     
@@ -68,12 +79,26 @@ public:
 
     bool wasAssigned() const { return _wasAssigned; };
     void setWasAssigned(bool wasAssigned) { _wasAssigned = wasAssigned; }
+
+    // where the node last said it was, for the audio mixer regions
+    const glm::vec3& getPosition() const { return _position; }
+    void setPosition(const glm::vec3& position) { _position = position; }
+
+    // the region an audio mixer mixes, or the one whose mixer another node is sent, in a domain split into regions
+    int getAudioMixerRegion() const { return _audioMixerRegion; }
+    void setAudioMixerRegion(int audioMixerRegion) { _audioMixerRegion = audioMixerRegion; }
+
+    // the index of an avatar mixer in a federation of avatar mixers
+    int getAvatarMixerIndex() const { return _avatarMixerIndex; }
+    void setAvatarMixerIndex(int avatarMixerIndex) { _avatarMixerIndex = avatarMixerIndex; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
     QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
     
     QHash<QUuid, QUuid> _sessionSecretHash;
+    quint32 _domainListVersion { 0 };
+    QHash<QUuid, quint64> _sentNodeHashes;
     QUuid _assignmentUUID;
     QUuid _walletUUID;
     QString _username;
@@ -81,6 +106,7 @@ private:
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
     QJsonObject _statsJSONObject;
+    QByteArray _serializedMetrics;
     static StringPairHash _overrideHash;
     
     HifiSockAddr _sendingSockAddr;
@@ -93,6 +119,10 @@ private:
     QString _placeName;
 
     bool _wasAssigned { false };
+
+    glm::vec3 _position;
+    int _audioMixerRegion { -1 };
+    int _avatarMixerIndex { -1 };
 };
 
 #endif // hifi_DomainServerNodeData_h
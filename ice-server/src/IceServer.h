@@ -12,50 +12,33 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
-#include <QtCore/QCoreApplication>
-#include <QtCore/QSharedPointer>
-#include <QUdpSocket>
-
-#include <openssl/rsa.h>
+#include <vector>
 
-#include <UUIDHasher.h>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
 
-#include <NetworkPeer.h>
-#include <HTTPConnection.h>
-#include <HTTPManager.h>
 #include <NLPacket.h>
 #include <udt/Socket.h>
 
-class QNetworkReply;
+#include "IceServerShard.h"
 
 class IceServer : public QCoreApplication {
     Q_OBJECT
 public:
     IceServer(int argc, char* argv[]);
+    ~IceServer();
 private slots:
-    void clearInactivePeers();
-    void publicKeyReplyFinished(QNetworkReply* reply);
+    void sendShardPackets();
 private:
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
-    
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
-    void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr);
-
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
-    void requestDomainPublicKey(const QUuid& domainID);
 
     QUuid _id;
     udt::Socket _serverSocket;
 
-    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
-    NetworkPeerHash _activePeers;
-
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
-    DomainPublicKeyHash _domainPublicKeys;
-
-    QSet<QUuid> _pendingPublicKeyRequests;
+    // the peers are split between the shards by ID, each on a thread of its own
+    std::vector<IceServerShard*> _shards;
+    std::vector<QThread*> _shardThreads;
 };
 
 #endif // hifi_IceServer_h
@@ -0,0 +1,366 @@
+//
+//  IceServerShard.cpp
+//  ice-server/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IceServerShard.h"
+
+#include <algorithm>
+
+#include <openssl/x509.h>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <NetworkAccessManager.h>
+#include <NetworkingConstants.h>
+#include <NumericalConstants.h>
+#include <udt/PacketHeaders.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+const quint64 PEER_SILENCE_THRESHOLD_USECS = 5 * USECS_PER_SECOND;
+
+// the wheel turns a slot per tick and spans the silence threshold, a peer is looked at once per threshold at most
+const int EXPIRY_TICK_MSECS = 250;
+const quint64 EXPIRY_TICK_USECS = EXPIRY_TICK_MSECS * USECS_PER_MSEC;
+const size_t NUM_EXPIRY_SLOTS = PEER_SILENCE_THRESHOLD_USECS / EXPIRY_TICK_USECS + 1;
+
+void IceServerShard::start() {
+    _expiryWheel.resize(NUM_EXPIRY_SLOTS);
+    _lastExpiredTick = usecTimestampNow() / EXPIRY_TICK_USECS;
+
+    QTimer* expiryTimer = new QTimer(this);
+    connect(expiryTimer, &QTimer::timeout, this, &IceServerShard::expirePeers);
+    expiryTimer->start(EXPIRY_TICK_MSECS);
+
+    // the network access manager is per thread, the public keys are requested from this one
+    auto& networkAccessManager = NetworkAccessManager::getInstance();
+    connect(&networkAccessManager, &QNetworkAccessManager::finished, this, &IceServerShard::publicKeyReplyFinished);
+}
+
+void IceServerShard::queuePacket(std::unique_ptr<NLPacket> packet) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(_packetsMutex);
+        wasEmpty = _incomingPackets.empty();
+        _incomingPackets.push_back(std::move(packet));
+    }
+
+    // the packets that arrive before the shard gets to them are handled with these
+    if (wasEmpty) {
+        QMetaObject::invokeMethod(this, "processQueuedPackets", Qt::QueuedConnection);
+    }
+}
+
+std::vector<IceServerShard::OutgoingPacket> IceServerShard::takeOutgoingPackets() {
+    std::vector<OutgoingPacket> packets;
+    std::lock_guard<std::mutex> lock(_packetsMutex);
+    packets.swap(_outgoingPackets);
+    return packets;
+}
+
+void IceServerShard::processQueuedPackets() {
+    std::vector<std::unique_ptr<NLPacket>> packets;
+    {
+        std::lock_guard<std::mutex> lock(_packetsMutex);
+        packets.swap(_incomingPackets);
+    }
+
+    for (auto& packet : packets) {
+        if (packet->getType() == PacketType::ICEServerHeartbeat) {
+            processHeartbeat(*packet);
+        } else if (packet->getType() == PacketType::ICEServerQuery) {
+            processQuery(*packet);
+        }
+    }
+}
+
+void IceServerShard::processHeartbeat(NLPacket& packet) {
+    SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(packet);
+    if (peer) {
+        // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+        peer->activateMatchingOrNewSymmetricSocket(packet.getSenderSockAddr());
+
+        // we have an active and verified heartbeating peer
+        // send them an ACK packet so they know that they are being heard and ready for ICE
+        sendPacket(NLPacket::create(PacketType::ICEServerHeartbeatACK), packet.getSenderSockAddr());
+    } else {
+        // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+        sendPacket(NLPacket::create(PacketType::ICEServerHeartbeatDenied), packet.getSenderSockAddr());
+    }
+}
+
+void IceServerShard::processQuery(NLPacket& packet) {
+    QDataStream heartbeatStream(&packet);
+
+    // this is a node hoping to connect to a heartbeating peer - do we have the heartbeating peer?
+    QUuid senderUUID;
+    heartbeatStream >> senderUUID;
+
+    // pull the public and private sock addrs for this peer
+    HifiSockAddr publicSocket, localSocket;
+    heartbeatStream >> publicSocket >> localSocket;
+
+    // check if this node also included a UUID that they would like to connect to
+    QUuid connectRequestID;
+    heartbeatStream >> connectRequestID;
+
+    auto it = _activePeers.find(connectRequestID);
+
+    if (it != _activePeers.end() && it->second.peer->getActiveSocket()) {
+        const NetworkPeer& matchingPeer = *it->second.peer;
+
+        qDebug() << "Sending information for peer" << connectRequestID << "to peer" << senderUUID;
+
+        // we have the peer they want to connect to - send them pack the information for that peer
+        sendPeerInformationPacket(matchingPeer, packet.getSenderSockAddr());
+
+        // we also need to send them to the active peer they are hoping to connect to
+        // create a dummy peer object we can pass to sendPeerInformationPacket
+
+        NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
+        sendPeerInformationPacket(dummyPeer, *matchingPeer.getActiveSocket());
+    } else {
+        qDebug() << "Peer" << senderUUID << "asked for" << connectRequestID << "but no matching peer found";
+    }
+}
+
+SharedNetworkPeer IceServerShard::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
+
+    // pull the UUID, public and private sock addrs for this peer
+    QUuid senderUUID;
+    HifiSockAddr publicSocket, localSocket;
+    QByteArray signature;
+
+    QDataStream heartbeatStream(&packet);
+    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
+
+    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
+    heartbeatStream >> signature;
+
+    // make sure this is a verified heartbeat before performing any more processing
+    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
+        // make sure we have this sender in our peer hash
+        auto it = _activePeers.find(senderUUID);
+
+        if (it == _activePeers.end()) {
+            // if we don't have this sender we need to create them now
+            Peer& newPeer = _activePeers[senderUUID];
+            newPeer.peer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
+            newPeer.peer->setLastHeardMicrostamp(usecTimestampNow());
+            schedulePeerExpiry(newPeer);
+
+            qDebug() << "Added a new network peer" << *newPeer.peer;
+            return newPeer.peer;
+        }
+
+        // we already had the peer so just potentially update their sockets
+        SharedNetworkPeer matchingPeer = it->second.peer;
+        matchingPeer->setPublicSocket(publicSocket);
+        matchingPeer->setLocalSocket(localSocket);
+
+        // update our last heard microstamp for this network peer to now, the wheel catches up when it gets to them
+        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
+
+        return matchingPeer;
+    } else {
+        // not verified, return the empty peer object
+        return SharedNetworkPeer();
+    }
+}
+
+bool IceServerShard::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
+    // make sure we're not already waiting for a public key for this domain-server
+    if (!_pendingPublicKeyRequests.contains(domainID)) {
+        // check if we have a public key for this domain ID - if we do not then fire off the request for it
+        auto it = _domainPublicKeys.find(domainID);
+        if (it != _domainPublicKeys.end()) {
+
+            // attempt to verify the signature for this heartbeat
+            const auto rsaPublicKey = it->second.get();
+
+            if (rsaPublicKey) {
+                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+                int verificationResult = RSA_verify(NID_sha256,
+                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                                    hashedPlaintext.size(),
+                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
+                                                    signature.size(),
+                                                    rsaPublicKey);
+
+                if (verificationResult == 1) {
+                    // this is the only success case - we return true here to indicate that the heartbeat is verified
+                    return true;
+                } else {
+                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
+                }
+
+            } else {
+                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
+                qWarning() << "Re-requesting public key from API";
+            }
+        }
+
+        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
+        // ask the metaverse API for the right public key and return false to indicate that this is not verified
+        requestDomainPublicKey(domainID);
+    }
+
+    return false;
+}
+
+void IceServerShard::requestDomainPublicKey(const QUuid& domainID) {
+    // send a request to the metaverse API for the public key for this domain
+    auto& networkAccessManager = NetworkAccessManager::getInstance();
+
+    QUrl publicKeyURL { NetworkingConstants::METAVERSE_SERVER_URL };
+    QString publicKeyPath = QString("/api/v1/domains/%1/public_key").arg(uuidStringWithoutCurlyBraces(domainID));
+    publicKeyURL.setPath(publicKeyPath);
+
+    QNetworkRequest publicKeyRequest { publicKeyURL };
+    publicKeyRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    publicKeyRequest.setAttribute(QNetworkRequest::User, domainID);
+
+    qDebug() << "Requesting public key for domain with ID" << domainID;
+
+    // add this to the set of pending public key requests
+    _pendingPublicKeyRequests.insert(domainID);
+
+    networkAccessManager.get(publicKeyRequest);
+}
+
+void IceServerShard::publicKeyReplyFinished(QNetworkReply* reply) {
+    // get the domain ID from the QNetworkReply attribute
+    QUuid domainID = reply->request().attribute(QNetworkRequest::User).toUuid();
+
+    if (reply->error() == QNetworkReply::NoError) {
+        // pull out the public key and store it for this domain
+
+        // the response should be JSON
+        QJsonDocument responseDocument = QJsonDocument::fromJson(reply->readAll());
+
+        static const QString DATA_KEY = "data";
+        static const QString PUBLIC_KEY_KEY = "public_key";
+        static const QString STATUS_KEY = "status";
+        static const QString SUCCESS_VALUE = "success";
+
+        auto responseObject = responseDocument.object();
+        if (responseObject[STATUS_KEY].toString() == SUCCESS_VALUE) {
+            auto dataObject = responseObject[DATA_KEY].toObject();
+            if (dataObject.contains(PUBLIC_KEY_KEY)) {
+
+                // grab the base 64 public key from the API response
+                auto apiPublicKey = QByteArray::fromBase64(dataObject[PUBLIC_KEY_KEY].toString().toUtf8());
+
+                // convert the downloaded public key to an RSA struct, if possible
+                const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(apiPublicKey.constData());
+
+                RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
+
+                if (rsaPublicKey) {
+                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                } else {
+                    qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
+                    qWarning() << "Public key will be re-requested on next heartbeat.";
+                }
+
+            } else {
+                qWarning() << "There was no public key present in response for domain with ID" << domainID;
+            }
+        } else {
+            qWarning() << "The metaverse API did not return success for public key request for domain with ID" << domainID;
+        }
+
+    } else {
+        // there was a problem getting the public key for the domain
+        // log it since it will be re-requested on the next heartbeat
+
+        qWarning() << "Error retreiving public key for domain with ID" << domainID << "-" <<  reply->errorString();
+    }
+
+    // remove this domain ID from the list of pending public key requests
+    _pendingPublicKeyRequests.remove(domainID);
+
+    reply->deleteLater();
+}
+
+void IceServerShard::sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& destinationSockAddr) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(_packetsMutex);
+        wasEmpty = _outgoingPackets.empty();
+        _outgoingPackets.emplace_back(std::move(packet), destinationSockAddr);
+    }
+
+    if (wasEmpty) {
+        emit packetsReady();
+    }
+}
+
+void IceServerShard::sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr& destinationSockAddr) {
+    auto peerPacket = NLPacket::create(PacketType::ICEServerPeerInformation);
+
+    // get the byte array for this peer
+    peerPacket->write(peer.toByteArray());
+
+    sendPacket(std::move(peerPacket), destinationSockAddr);
+}
+
+void IceServerShard::schedulePeerExpiry(Peer& peer) {
+    quint64 expiryTick = (peer.peer->getLastHeardMicrostamp() + PEER_SILENCE_THRESHOLD_USECS) / EXPIRY_TICK_USECS;
+
+    // never in a slot the wheel already turned past
+    peer.expiryTick = std::max(expiryTick, _lastExpiredTick + 1);
+    _expiryWheel[peer.expiryTick % NUM_EXPIRY_SLOTS].push_back(peer.peer->getUUID());
+}
+
+void IceServerShard::expirePeers() {
+    quint64 now = usecTimestampNow();
+    quint64 currentTick = now / EXPIRY_TICK_USECS;
+
+    // a late timer turns the wheel several slots, at most once around
+    quint64 firstTick = std::max(_lastExpiredTick + 1, currentTick >= NUM_EXPIRY_SLOTS ? currentTick - NUM_EXPIRY_SLOTS + 1 : 0);
+    _lastExpiredTick = currentTick;
+
+    for (quint64 tick = firstTick; tick <= currentTick; ++tick) {
+        std::vector<QUuid>& slot = _expiryWheel[tick % NUM_EXPIRY_SLOTS];
+        std::vector<QUuid> dueIDs;
+        dueIDs.swap(slot);
+
+        // each peer is in the slot of its expiry tick only, it is moved when that comes rather than when it is heard
+        for (const QUuid& peerID : dueIDs) {
+            auto it = _activePeers.find(peerID);
+            if (it == _activePeers.end()) {
+                continue;
+            }
+
+            Peer& peer = it->second;
+            if (peer.expiryTick > tick) {
+                // rescheduled into this slot while the wheel caught up
+                slot.push_back(peerID);
+            } else if ((now - peer.peer->getLastHeardMicrostamp()) > PEER_SILENCE_THRESHOLD_USECS) {
+                qDebug() << "Removing peer from memory for inactivity -" << *peer.peer;
+
+                // if we had a public key for this domain, remove it now
+                _domainPublicKeys.erase(peerID);
+
+                // remove the peer object
+                _activePeers.erase(it);
+            } else {
+                schedulePeerExpiry(peer);
+            }
+        }
+    }
+}
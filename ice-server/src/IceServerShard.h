@@ -0,0 +1,90 @@
+//
+//  IceServerShard.h
+//  ice-server/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_IceServerShard_h
+#define hifi_IceServerShard_h
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+
+#include <openssl/rsa.h>
+
+#include <UUIDHasher.h>
+
+#include <NetworkPeer.h>
+#include <NLPacket.h>
+
+class QNetworkReply;
+
+// The heartbeating peers whose IDs hash to one shard of the ice-server, on a thread of their own
+//   The socket thread hands the shard the heartbeats of its peers, and the queries for them, and the shard handles
+//   everything that arrived since it last ran in one go. Its replies are handed back the same way, for the socket
+//   thread to send. Silent peers expire through a timer wheel, so only the peers that are due are looked at.
+class IceServerShard : public QObject {
+    Q_OBJECT
+public:
+    using OutgoingPacket = std::pair<std::unique_ptr<NLPacket>, HifiSockAddr>;
+
+    // can be called from any thread
+    void queuePacket(std::unique_ptr<NLPacket> packet);
+    std::vector<OutgoingPacket> takeOutgoingPackets();
+
+public slots:
+    void start();
+
+signals:
+    // there are packets to take, emitted once until they are taken
+    void packetsReady();
+
+private slots:
+    void processQueuedPackets();
+    void expirePeers();
+    void publicKeyReplyFinished(QNetworkReply* reply);
+
+private:
+    struct Peer {
+        SharedNetworkPeer peer;
+        quint64 expiryTick; // the slot of the wheel the peer is in
+    };
+
+    void processHeartbeat(NLPacket& packet);
+    void processQuery(NLPacket& packet);
+    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& packet);
+
+    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
+    void requestDomainPublicKey(const QUuid& domainID);
+
+    void sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& destinationSockAddr);
+    void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr& destinationSockAddr);
+
+    void schedulePeerExpiry(Peer& peer);
+
+    std::mutex _packetsMutex;
+    std::vector<std::unique_ptr<NLPacket>> _incomingPackets;
+    std::vector<OutgoingPacket> _outgoingPackets;
+
+    std::unordered_map<QUuid, Peer> _activePeers;
+
+    std::vector<std::vector<QUuid>> _expiryWheel;
+    quint64 _lastExpiredTick { 0 };
+
+    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
+    std::unordered_map<QUuid, RSAUniquePtr> _domainPublicKeys;
+
+    QSet<QUuid> _pendingPublicKeyRequests;
+};
+
+#endif // hifi_IceServerShard_h
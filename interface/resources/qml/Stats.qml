@@ -79,6 +79,19 @@ Item {
                     StatText {
                         text: "Avatar Simrate: " + root.avatarSimrate
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Physics Step: " + root.physicsStepTime.toFixed(2) + " ms"
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Physics Bodies: " + root.physicsBodies + " (active " + root.physicsActiveBodies +
+                            ", owned " + root.physicsOwnedBodies + ", islands " + root.physicsIslands + ")"
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Physics Pairs/Contacts: " + root.physicsPairs + "/" + root.physicsContacts
+                    }
                     StatText {
                         text: "Missed Frame Count: " + root.appdropped;
                         visible: root.appdropped > 0;
@@ -9,13 +9,14 @@
 uniform sampler2D sampler;
 
 struct OverlayData {
-    mat4 mvp;
+    mat4 mvps[2];
     vec4 glowPoints;
     vec4 glowColors[2];
     vec4 resolutionRadiusAlpha;
 
     vec4 extraGlowColor;
     vec2 extraGlowPoint;
+    float eyeWidth;
 };
 
 layout(std140) uniform overlayBuffer {
@@ -33,6 +34,7 @@ vec4 extraGlowColor = overlay.extraGlowColor;
 
 in vec3 vPosition;
 in vec2 vTexCoord;
+flat in int vEye;
 
 out vec4 FragColor;
 
@@ -46,6 +48,11 @@ float easeInOutCubic(float f) {
 }
 
 void main() {
+    // Keep each eye in its half of the composite
+    if ((gl_FragCoord.x < overlay.eyeWidth) != (vEye == 0)) {
+        discard;
+    }
+
     FragColor = texture(sampler, vTexCoord);
 
     vec2 aspect = resolution;
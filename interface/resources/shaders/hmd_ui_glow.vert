@@ -7,29 +7,33 @@
 //
 
 struct OverlayData {
-    mat4 mvp;
+    mat4 mvps[2];
     vec4 glowPoints;
     vec4 glowColors[2];
     vec4 resolutionRadiusAlpha;
 
     vec4 extraGlowColor;
     vec2 extraGlowPoint;
+    float eyeWidth;
 };
 
 layout(std140) uniform overlayBuffer {
     OverlayData overlay;
 };
 
-mat4 mvp = overlay.mvp;
-
 layout(location = 0) in vec3 Position;
 layout(location = 3) in vec2 TexCoord;
 
 out vec3 vPosition;
 out vec2 vTexCoord;
+flat out int vEye;
 
 void main() {
-  gl_Position = mvp * vec4(Position, 1);
+  // Both eyes are drawn at once, an instance each, squeezed in their half of the composite
+  vEye = gl_InstanceID;
+  vec4 clipPos = overlay.mvps[vEye] * vec4(Position, 1);
+  clipPos.x = clipPos.x * 0.5 + (float(vEye) - 0.5) * clipPos.w;
+  gl_Position = clipPos;
   vTexCoord = TexCoord;
   vPosition = Position;
 }
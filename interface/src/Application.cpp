@@ -71,6 +71,7 @@
 #include <FramebufferCache.h>
 #include <gpu/Batch.h>
 #include <gpu/Context.h>
+#include <gpu/FrameIO.h>
 #include <gpu/gl/GLBackend.h>
 #include <HFActionEvent.h>
 #include <HFBackEvent.h>
@@ -143,6 +144,7 @@
 #include "LODManager.h"
 #include "ModelPackager.h"
 #include "networking/HFWebEngineProfile.h"
+#include "raypick/PickManager.h"
 #include "scripting/TestScriptingInterface.h"
 #include "scripting/AccountScriptingInterface.h"
 #include "scripting/AssetMappingsScriptingInterface.h"
@@ -489,6 +491,7 @@ bool setupEssentials(int& argc, char** argv) {
     DependencyManager::set<ResourceCacheSharedItems>();
     DependencyManager::set<DesktopScriptingInterface>();
     DependencyManager::set<EntityScriptingInterface>(true);
+    DependencyManager::set<PickManager>();
     DependencyManager::set<RecordingScriptingInterface>();
     DependencyManager::set<WindowScriptingInterface>();
     DependencyManager::set<HMDScriptingInterface>();
@@ -604,6 +607,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         }
     }
 
+    markStartupPhase("essentials");
+
     // make sure the debug draw singleton is initialized on the main thread.
     DebugDraw::getInstance().removeMarker("");
 
@@ -682,16 +687,9 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         determinedSandboxState = true;
     });
 
-    // SandboxUtils::runLocalSandbox currently has 2 sec delay after spawning sandbox, so 4
-    // sec here is ok I guess.  TODO: ping sandbox so we know it is up, perhaps?
-    quint64 MAX_WAIT_TIME = USECS_PER_SECOND * 4;
-    auto startWaiting = usecTimestampNow();
-    while (!determinedSandboxState && (usecTimestampNow() - startWaiting <= MAX_WAIT_TIME)) {
-        QCoreApplication::processEvents();
-        // updateHeartbeat() while polling so we don't scare the deadlock watchdog
-        updateHeartbeat();
-        usleep(USECS_PER_MSEC * 50); // 20hz
-    }
+    // the answer is only needed to pick where to go once everything else is up, it is waited for there
+    auto startWaitingForSandbox = usecTimestampNow();
+    markStartupPhase("version logging and sandbox check");
 
     _bookmarks = new Bookmarks();  // Before setting up the menu
 
@@ -776,6 +774,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     messagesClient->moveToThread(messagesThread);
     connect(messagesThread, &QThread::started, messagesClient.data(), &MessagesClient::init);
     messagesThread->start();
+    markStartupPhase("network and audio threads");
 
     const DomainHandler& domainHandler = nodeList->getDomainHandler();
 
@@ -921,6 +920,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     initializeGL();
     // Make sure we don't time out during slow operations at startup
     updateHeartbeat();
+    markStartupPhase("initializeGL");
 
 
     // sessionRunTime will be reset soon by loadSettings. Grab it now to get previous session value.
@@ -1150,8 +1150,10 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     scriptEngines->loadScripts();
     // Make sure we don't time out during slow operations at startup
     updateHeartbeat();
+    markStartupPhase("scripts loading");
 
     loadSettings();
+    markStartupPhase("settings");
 
     // Now that we've loaded the menu and thus switched to the previous display plugin
     // we can unlock the desktop repositioning code, since all the positions will be
@@ -1421,6 +1423,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     entityPacketSender->setMyAvatar(myAvatar.get());
 
     connect(this, &Application::applicationStateChanged, this, &Application::activeChanged);
+    markStartupPhase("rest of the constructor");
     qCDebug(interfaceapp, "Startup time: %4.2f seconds.", (double)startupTimer.elapsed() / 1000.0);
 
     auto textureCache = DependencyManager::get<TextureCache>();
@@ -1445,6 +1448,18 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         const auto testScript = property(hifi::properties::TEST).toUrl();
         scriptEngines->loadScript(testScript, false);
     } else {
+        // SandboxUtils::runLocalSandbox currently has 2 sec delay after spawning sandbox, so 4
+        // sec here is ok I guess.  TODO: ping sandbox so we know it is up, perhaps?
+        // (by now the rest of the startup has used up most of that, if not all)
+        quint64 MAX_WAIT_TIME = USECS_PER_SECOND * 4;
+        while (!determinedSandboxState && (usecTimestampNow() - startWaitingForSandbox <= MAX_WAIT_TIME)) {
+            QCoreApplication::processEvents();
+            // updateHeartbeat() while polling so we don't scare the deadlock watchdog
+            updateHeartbeat();
+            usleep(USECS_PER_MSEC * 50); // 20hz
+        }
+        markStartupPhase("sandbox check answered");
+
         // Get sandbox content set version, if available
         auto acDirPath = PathUtils::getAppDataPath() + "../../" + BuildInfo::MODIFIED_ORGANIZATION + "/assignment-client/";
         auto contentVersionPath = acDirPath + "content-version.txt";
@@ -1790,6 +1805,7 @@ Application::~Application() {
 
     _octreeProcessor.terminate();
     _entityEditSender.terminate();
+    _physicsThread.terminate();
 
     _physicsEngine->setCharacterController(nullptr);
 
@@ -1799,6 +1815,7 @@ Application::~Application() {
     DependencyManager::get<AvatarManager>()->getObjectsToRemoveFromPhysics(motionStates);
     _physicsEngine->removeObjects(motionStates);
 
+    DependencyManager::destroy<PickManager>();
     DependencyManager::destroy<AvatarManager>();
     DependencyManager::destroy<AnimationCache>();
     DependencyManager::destroy<FramebufferCache>();
@@ -1837,6 +1854,16 @@ Application::~Application() {
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
 }
 
+void Application::markStartupPhase(const char* phase) {
+    // from the start of the process, for the first phase
+    qint64 now = _sessionRunTimer.elapsed();
+    qint64 phaseTime = now - _lastStartupPhaseEnd;
+    _lastStartupPhaseEnd = now;
+
+    qCDebug(interfaceapp, "Startup phase %s: %lld ms (%lld ms in)", phase, phaseTime, now);
+    PROFILE_INSTANT(app, QString("Startup: ") + phase, "g", { { "phase_ms", phaseTime }, { "elapsed_ms", now } });
+}
+
 void Application::initializeGL() {
     qCDebug(interfaceapp) << "Created Display Window.";
 
@@ -1858,6 +1885,8 @@ void Application::initializeGL() {
     gpu::Context::init<gpu::gl::GLBackend>();
     qApp->setProperty(hifi::properties::gl::MAKE_PROGRAM_CALLBACK,
         QVariant::fromValue((void*)(&gpu::gl::GLBackend::makeProgram)));
+    qApp->setProperty(hifi::properties::gl::MAKE_PROGRAM_ASYNC_CALLBACK,
+        QVariant::fromValue((void*)(&gpu::gl::GLBackend::makeProgramAsync)));
     _gpuContext = std::make_shared<gpu::Context>();
     // The gpu context can make child contexts for transfers, so
     // we need to restore primary rendering context
@@ -1879,6 +1908,7 @@ void Application::initializeGL() {
     }
     _renderEngine->load();
     _renderEngine->registerScene(_main3DScene);
+    markStartupPhase("display and render engine");
 
     // The UI can't be created until the primary OpenGL
     // context is created, because it needs to share
@@ -1886,6 +1916,7 @@ void Application::initializeGL() {
     // Needs to happen AFTER the render engine initialization to access its configuration
     initializeUi();
     qCDebug(interfaceapp, "Initialized Offscreen UI.");
+    markStartupPhase("offscreen UI");
     _glWidget->makeCurrent();
 
 
@@ -1895,6 +1926,7 @@ void Application::initializeGL() {
 
     init();
     qCDebug(interfaceapp, "init() complete.");
+    markStartupPhase("init");
 
     // create thread for parsing of octree data independent of the main network and rendering threads
     _octreeProcessor.initialize(_enableProcessOctreeThread);
@@ -2292,6 +2324,14 @@ void Application::paintGL() {
         DependencyManager::get<FramebufferCache>()->releaseFramebuffer(framebuffer);
     };
     frame->overlay = _applicationOverlay.getOverlayTexture();
+    if (_captureFrameRequested.exchange(false)) {
+        QString capturePath = PathUtils::getAppLocalDataPath() + "frames/";
+        QDir().mkpath(capturePath);
+        capturePath += QString("frame-%1.gpuframe").arg(_frameCount);
+        if (gpu::writeFrame(capturePath.toStdString(), *frame)) {
+            qCDebug(interfaceapp) << "Captured frame" << _frameCount << "to" << capturePath;
+        }
+    }
     // deliver final scene rendering commands to the display plugin
     {
         PROFILE_RANGE(render, "/pluginOutput");
@@ -2312,6 +2352,7 @@ void Application::paintGL() {
 
     uint64_t lastPaintDuration = usecTimestampNow() - lastPaintBegin;
     _frameTimingsScriptingInterface.addValue(lastPaintDuration);
+    _lastPaintDuration = lastPaintDuration;
 }
 
 void Application::perFrameUpdateLeoEngine()const
@@ -3668,7 +3709,9 @@ void Application::idle(float nsecsElapsed) {
         PerformanceTimer perfTimer("update");
         PerformanceWarning warn(showWarnings, "Application::idle()... update()");
         static const float BIGGEST_DELTA_TIME_SECS = 0.25f;
+        uint64_t updateBegin = usecTimestampNow();
         update(glm::clamp(secondsSinceLastUpdate, 0.0f, BIGGEST_DELTA_TIME_SECS));
+        _lastUpdateDuration = usecTimestampNow() - updateBegin;
     }
 
 
@@ -4018,6 +4061,8 @@ void Application::init() {
 
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
+    _physicsThread.setObjectName("Physics");
+    _physicsThread.initialize(true, QThread::HighPriority);
 
     EntityTreePointer tree = getEntities()->getTree();
     _entitySimulation->init(tree, _physicsEngine, &_entityEditSender);
@@ -4056,11 +4101,17 @@ void Application::init() {
     }, Qt::QueuedConnection);
 }
 
-void Application::updateLOD() const {
+void Application::updateLOD(float deltaTime) const {
     PerformanceTimer perfTimer("LOD");
     // adjust it unless we were asked to disable this feature, or if we're currently in throttleRendering mode
     if (!isThrottleRendering()) {
-        DependencyManager::get<LODManager>()->autoAdjustLOD(_frameCounter.rate());
+        // the costs of the last frame
+        LODFrameTimes frameTimes;
+        frameTimes.gpu = (float)_gpuContext->getFrameTimerGPUAverage();
+        frameTimes.render = (float)_lastPaintDuration / USECS_PER_MSEC;
+        frameTimes.simulation = (float)_lastUpdateDuration / USECS_PER_MSEC;
+        DependencyManager::get<LODManager>()->autoAdjustLOD(_frameCounter.rate(), deltaTime, getTargetFrameRate(),
+                                                            frameTimes);
     } else {
         DependencyManager::get<LODManager>()->resetLODAdjust();
     }
@@ -4404,7 +4455,7 @@ void Application::update(float deltaTime) {
     bool showWarnings = Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
     PerformanceWarning warn(showWarnings, "Application::update()");
 
-    updateLOD();
+    updateLOD(deltaTime);
 
     if (!_physicsEnabled) {
         if (!domainLoadingInProgress) {
@@ -4446,41 +4497,6 @@ void Application::update(float deltaTime) {
         PROFILE_ASYNC_END(app, "Scene Loading", "");
     }
 
-    {
-        PerformanceTimer perfTimer("devices");
-        DeviceTracker::updateAll();
-
-        FaceTracker* tracker = getSelectedFaceTracker();
-        if (tracker && Menu::getInstance()->isOptionChecked(MenuOption::MuteFaceTracking) != tracker->isMuted()) {
-            tracker->toggleMute();
-        }
-
-        tracker = getActiveFaceTracker();
-        if (tracker && !tracker->isMuted()) {
-            tracker->update(deltaTime);
-
-            // Auto-mute microphone after losing face tracking?
-            if (tracker->isTracking()) {
-                _lastFaceTrackerUpdate = usecTimestampNow();
-            } else {
-                const quint64 MUTE_MICROPHONE_AFTER_USECS = 5000000;  //5 secs
-                Menu* menu = Menu::getInstance();
-                if (menu->isOptionChecked(MenuOption::AutoMuteAudio) && !menu->isOptionChecked(MenuOption::MuteAudio)) {
-                    if (_lastFaceTrackerUpdate > 0
-                        && ((usecTimestampNow() - _lastFaceTrackerUpdate) > MUTE_MICROPHONE_AFTER_USECS)) {
-                        menu->triggerOption(MenuOption::MuteAudio);
-                        _lastFaceTrackerUpdate = 0;
-                    }
-                } else {
-                    _lastFaceTrackerUpdate = 0;
-                }
-            }
-        } else {
-            _lastFaceTrackerUpdate = 0;
-        }
-
-    }
-
     auto myAvatar = getMyAvatar();
     auto userInputMapper = DependencyManager::get<UserInputMapper>();
 
@@ -4546,6 +4562,7 @@ void Application::update(float deltaTime) {
 
             PerformanceTimer perfTimer("updateStates)");
             static VectorOfMotionStates motionStates;
+            _entitySimulation->setPhysicsScope(myAvatar->getPosition(), DEFAULT_PHYSICS_SCOPE_RADIUS);
             _entitySimulation->getObjectsToRemoveFromPhysics(motionStates);
             _physicsEngine->removeObjects(motionStates);
             _entitySimulation->deleteObjectsRemovedFromPhysics();
@@ -4578,10 +4595,29 @@ void Application::update(float deltaTime) {
         {
             PROFILE_RANGE_EX(simulation_physics, "StepSimulation", 0xffff8000, (uint64_t)getActiveDisplayPlugin()->presentCount());
             PerformanceTimer perfTimer("stepSimulation");
-            getEntities()->getTree()->withWriteLock([&] {
-                _physicsEngine->stepSimulation();
+            EntityTreePointer tree = getEntities()->getTree();
+            _physicsThread.beginStep([this, tree] {
+                tree->withWriteLock([&] {
+                    _physicsEngine->stepSimulation();
+                });
             });
         }
+        // the work below shares nothing with the step, so it runs as the physics thread steps
+        {
+            // the other avatars are only ever read by the step when it saves the kinematic states, through
+            // their own locks
+            PerformanceTimer perfTimer("AvatarManager");
+            _avatarSimCounter.increment();
+            PROFILE_RANGE_EX(simulation, "OtherAvatars", 0xffff00ff, (uint64_t)getActiveDisplayPlugin()->presentCount());
+            avatarManager->updateOtherAvatars(deltaTime);
+        }
+        updateDevices(deltaTime);
+        sendPeriodicPackets();
+        {
+            PROFILE_RANGE_EX(simulation_physics, "WaitForStep", 0xffff8000, (uint64_t)getActiveDisplayPlugin()->presentCount());
+            PerformanceTimer perfTimer("waitForStep");
+            _physicsThread.waitForStep();
+        }
         {
             PROFILE_RANGE_EX(simulation_physics, "HarvestChanges", 0xffffff00, (uint64_t)getActiveDisplayPlugin()->presentCount());
             PerformanceTimer perfTimer("harvestChanges");
@@ -4615,6 +4651,23 @@ void Application::update(float deltaTime) {
 
                 myAvatar->harvestResultsFromPhysicsSimulation(deltaTime);
 
+                const PhysicsStats& physicsStats = _physicsEngine->getStats();
+                PROFILE_COUNTER(simulation_physics, "physicsTime", {
+                    { "step", (int)physicsStats.stepTime },
+                    { "synchronize", (int)physicsStats.synchronizeTime }
+                });
+                PROFILE_COUNTER(simulation_physics, "physicsBodies", {
+                    { "total", (int)physicsStats.numBodies },
+                    { "active", (int)physicsStats.numActiveBodies },
+                    { "owned", (int)physicsStats.numOwnedBodies },
+                    { "islands", (int)physicsStats.numIslands }
+                });
+                PROFILE_COUNTER(simulation_physics_detail, "physicsCollisions", {
+                    { "pairs", (int)physicsStats.numOverlappingPairs },
+                    { "contacts", (int)physicsStats.numContacts },
+                    { "solverIterations", (int)physicsStats.numSolverIterations }
+                });
+
                 if (Menu::getInstance()->isOptionChecked(MenuOption::DisplayDebugTimingDetails) &&
                         Menu::getInstance()->isOptionChecked(MenuOption::ExpandPhysicsSimulationTiming)) {
                     _physicsEngine->harvestPerformanceStats();
@@ -4625,12 +4678,17 @@ void Application::update(float deltaTime) {
         }
     }
 
+    if (!_physicsEnabled) {
+        updateDevices(deltaTime);
+        sendPeriodicPackets();
+    }
+
     // AvatarManager update
     {
         PerformanceTimer perfTimer("AvatarManager");
-        _avatarSimCounter.increment();
+        if (!_physicsEnabled) {
+            _avatarSimCounter.increment();
 
-        {
             PROFILE_RANGE_EX(simulation, "OtherAvatars", 0xffff00ff, (uint64_t)getActiveDisplayPlugin()->presentCount());
             avatarManager->updateOtherAvatars(deltaTime);
         }
@@ -4649,6 +4707,12 @@ void Application::update(float deltaTime) {
         _overlays.update(deltaTime);
     }
 
+    {
+        // after the avatar and the overlays moved, so that the picks see them where they'll be drawn
+        PROFILE_RANGE_EX(app, "Picks", 0xffff0000, (uint64_t)getActiveDisplayPlugin()->presentCount());
+        DependencyManager::get<PickManager>()->update();
+    }
+
     // Update _viewFrustum with latest camera and view frustum data...
     // NOTE: we get this from the view frustum, to make it simpler, since the
     // loadViewFrumstum() method will get the correct details from the camera
@@ -4682,6 +4746,58 @@ void Application::update(float deltaTime) {
         }
     }
 
+    avatarManager->postUpdate(deltaTime);
+
+    {
+        PROFILE_RANGE_EX(app, "PreRenderLambdas", 0xffff0000, (uint64_t)0);
+
+        std::unique_lock<std::mutex> guard(_postUpdateLambdasLock);
+        for (auto& iter : _postUpdateLambdas) {
+            iter.second();
+        }
+        _postUpdateLambdas.clear();
+    }
+
+    AnimDebugDraw::getInstance().update();
+}
+
+void Application::updateDevices(float deltaTime) {
+    PerformanceTimer perfTimer("devices");
+    DeviceTracker::updateAll();
+
+    FaceTracker* tracker = getSelectedFaceTracker();
+    if (tracker && Menu::getInstance()->isOptionChecked(MenuOption::MuteFaceTracking) != tracker->isMuted()) {
+        tracker->toggleMute();
+    }
+
+    tracker = getActiveFaceTracker();
+    if (tracker && !tracker->isMuted()) {
+        tracker->update(deltaTime);
+
+        // Auto-mute microphone after losing face tracking?
+        if (tracker->isTracking()) {
+            _lastFaceTrackerUpdate = usecTimestampNow();
+        } else {
+            const quint64 MUTE_MICROPHONE_AFTER_USECS = 5000000;  //5 secs
+            Menu* menu = Menu::getInstance();
+            if (menu->isOptionChecked(MenuOption::AutoMuteAudio) && !menu->isOptionChecked(MenuOption::MuteAudio)) {
+                if (_lastFaceTrackerUpdate > 0
+                    && ((usecTimestampNow() - _lastFaceTrackerUpdate) > MUTE_MICROPHONE_AFTER_USECS)) {
+                    menu->triggerOption(MenuOption::MuteAudio);
+                    _lastFaceTrackerUpdate = 0;
+                }
+            } else {
+                _lastFaceTrackerUpdate = 0;
+            }
+        }
+    } else {
+        _lastFaceTrackerUpdate = 0;
+    }
+}
+
+void Application::sendPeriodicPackets() {
+    quint64 now = usecTimestampNow();
+
     // sent nack packets containing missing sequence numbers of received packets from nodes
     {
         quint64 sinceLastNack = now - _lastNackTime;
@@ -4701,20 +4817,6 @@ void Application::update(float deltaTime) {
             QMetaObject::invokeMethod(DependencyManager::get<AudioClient>().data(), "sendDownstreamAudioStatsPacket", Qt::QueuedConnection);
         }
     }
-
-    avatarManager->postUpdate(deltaTime);
-
-    {
-        PROFILE_RANGE_EX(app, "PreRenderLambdas", 0xffff0000, (uint64_t)0);
-
-        std::unique_lock<std::mutex> guard(_postUpdateLambdasLock);
-        for (auto& iter : _postUpdateLambdas) {
-            iter.second();
-        }
-        _postUpdateLambdas.clear();
-    }
-
-    AnimDebugDraw::getInstance().update();
 }
 
 void Application::sendAvatarViewFrustum() {
@@ -4943,6 +5045,9 @@ void Application::queryOctree(NodeType_t serverType, PacketType packetType, Node
                 _octreeQuery.setCameraFarClip(0.1f);
             }
 
+            // let the server know which of its compression dictionaries we have
+            _octreeQuery.setCompressionDictionaryID(OctreePacketData::getCompressionDictionaryID(nodeUUID));
+
             // encode the query data
             int packetSize = _octreeQuery.getBroadcastData(reinterpret_cast<unsigned char*>(queryPacket->getPayload()));
             queryPacket->setPayloadSize(packetSize);
@@ -5232,7 +5337,7 @@ void Application::displaySide(RenderArgs* renderArgs, Camera& theCamera, bool se
 
     {
         PerformanceTimer perfTimer("SceneProcessPendingChanges");
-        _main3DScene->enqueuePendingChanges(pendingChanges);
+        _main3DScene->enqueuePendingChanges(std::move(pendingChanges));
 
         _main3DScene->processPendingChangesQueue();
     }
@@ -5586,6 +5691,7 @@ void Application::registerScriptEngineWithApplicationServices(ScriptEngine* scri
     getMyAvatar()->registerMetaTypes(scriptEngine);
 
     scriptEngine->registerGlobalObject("AvatarList", DependencyManager::get<AvatarManager>().data());
+    scriptEngine->registerGlobalObject("Picks", DependencyManager::get<PickManager>().data());
 
     scriptEngine->registerGlobalObject("Camera", &_myCamera);
 
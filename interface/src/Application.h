@@ -35,6 +35,7 @@
 #include <OctreeQuery.h>
 #include <PhysicalEntitySimulation.h>
 #include <PhysicsEngine.h>
+#include <PhysicsThread.h>
 #include <plugins/Forward.h>
 #include <plugins/DisplayPlugin.h>
 #include <ui-plugins/PluginContainer.h>
@@ -282,6 +283,7 @@ public:
 
     float getAvatarSimrate() const { return _avatarSimCounter.rate(); }
     float getAverageSimsPerSecond() const { return _simCounter.rate(); }
+    const PhysicsStats& getPhysicsStats() const { return _physicsEngine->getStats(); }
     
     void takeSnapshot(bool notify, bool includeAnimated = false, float aspectRatio = 0.0f);
     void shareSnapshot(const QString& filename, const QUrl& href = QUrl(""));
@@ -380,6 +382,9 @@ public slots:
 
     void reloadResourceCaches();
 
+    // Writes the next frame rendered to a file, for tests/render-frame-replay to profile
+    void captureFrame() { _captureFrameRequested = true; }
+
     void updateHeartbeat() const;
 
     static void deadlockApplication();
@@ -449,14 +454,19 @@ private:
 
     void cleanupBeforeQuit();
 
+    // logs, and traces, the time taken since the last phase of the startup
+    void markStartupPhase(const char* phase);
+
     bool shouldPaint(float nsecsElapsed);
     void idle(float nsecsElapsed);
     void update(float deltaTime);
 
     // Various helper functions called during update()
-    void updateLOD() const;
+    void updateLOD(float deltaTime) const;
     void updateThreads(float deltaTime);
     void updateDialogs(float deltaTime) const;
+    void updateDevices(float deltaTime);
+    void sendPeriodicPackets();
 
     void queryOctree(NodeType_t serverType, PacketType packetType, NodeToJurisdictionMap& jurisdictions, bool forceResend = false);
     static void loadViewFrustum(Camera& camera, ViewFrustum& viewFrustum);
@@ -512,6 +522,7 @@ private:
 
     MainWindow* _window;
     QElapsedTimer& _sessionRunTimer;
+    qint64 _lastStartupPhaseEnd { 0 };
 
     bool _previousSessionCrashed;
 
@@ -526,9 +537,12 @@ private:
     UndoStackScriptingInterface _undoStackScriptingInterface;
 
     uint32_t _frameCount { 0 };
+    std::atomic<bool> _captureFrameRequested { false };
 
     // Frame Rate Measurement
     RateCounter<> _frameCounter;
+    uint64_t _lastPaintDuration { 0 }; // usecs, for the LOD
+    uint64_t _lastUpdateDuration { 0 };
     RateCounter<> _avatarSimCounter;
     RateCounter<> _simCounter;
 
@@ -538,6 +552,7 @@ private:
     ShapeManager _shapeManager;
     PhysicalEntitySimulationPointer _entitySimulation;
     PhysicsEnginePointer _physicsEngine;
+    PhysicsThread _physicsThread;
 
     EntityTreeRenderer _entityClipboardRenderer;
     EntityTreePointer _entityClipboard;
@@ -11,6 +11,7 @@
 
 #include <SettingHandle.h>
 #include <OctreeUtils.h>
+#include <Profile.h>
 #include <Util.h>
 
 #include "Application.h"
@@ -39,8 +40,48 @@ float LODManager::getLODIncreaseFPS() {
     return getDesktopLODIncreaseFPS();
 }
 
-void LODManager::autoAdjustLOD(float currentFPS) {
-    
+// an LOD falls in proportion to how far its cost is over its budget, and rises slowly once well under it
+static float adjustForLoad(float lod, float load, float deltaTime, float minLOD, float maxLOD) {
+    float rate = 0.0f;
+    if (load > 1.0f) {
+        rate = -LOD_FALL_RATE * glm::min(load - 1.0f, 1.0f);
+    } else if (load > 0.0f && load < FRAME_BUDGET_HEADROOM) {
+        rate = LOD_RISE_RATE * (FRAME_BUDGET_HEADROOM - load) / FRAME_BUDGET_HEADROOM;
+    }
+    return glm::clamp(lod * expf(rate * deltaTime), minLOD, maxLOD);
+}
+
+void LODManager::autoAdjustLOD(float currentFPS, float deltaTime, float targetFrameRate, const LODFrameTimes& frameTimes) {
+    bool hasFrameTimes = frameTimes.gpu > 0.0f || frameTimes.render > 0.0f;
+
+    if (_automaticLODAdjust && targetFrameRate > 0.0f && deltaTime > 0.0f) {
+        float framePeriod = MSECS_PER_SECOND / targetFrameRate;
+        float renderLoad = glm::max(frameTimes.gpu / (GPU_FRAME_BUDGET * framePeriod),
+                                    frameTimes.render / (RENDER_FRAME_BUDGET * framePeriod));
+        float simulationLoad = frameTimes.simulation / (SIMULATION_FRAME_BUDGET * framePeriod);
+
+        if (hasFrameTimes) {
+            _octreeSizeScale = adjustForLoad(_octreeSizeScale, renderLoad, deltaTime,
+                                             ADJUST_LOD_MIN_SIZE_SCALE, ADJUST_LOD_MAX_SIZE_SCALE);
+        }
+        _avatarLODScale = adjustForLoad(_avatarLODScale, simulationLoad, deltaTime, MIN_AVATAR_LOD_SCALE, 1.0f);
+
+        PROFILE_COUNTER(app, "lodLoad", { { "render", renderLoad }, { "simulation", simulationLoad } });
+        PROFILE_COUNTER(app, "lod", { { "sizeScale", _octreeSizeScale / DEFAULT_OCTREE_SIZE_SCALE },
+                                      { "avatars", _avatarLODScale } });
+
+        // tell of the continuous changes in steps, as the frame rate thresholds would have
+        if (_octreeSizeScale < _lastNotifiedSizeScale * ADJUST_LOD_DOWN_BY) {
+            _lastNotifiedSizeScale = _octreeSizeScale;
+            emit LODDecreased();
+            notifyLODChanged();
+        } else if (_octreeSizeScale > _lastNotifiedSizeScale * ADJUST_LOD_UP_BY) {
+            _lastNotifiedSizeScale = _octreeSizeScale;
+            emit LODIncreased();
+            notifyLODChanged();
+        }
+    }
+
     // NOTE: our first ~100 samples at app startup are completely all over the place, and we don't
     // really want to count them in our average, so we will ignore the real frame rates and stuff
     // our moving average with simulated good data
@@ -120,13 +161,14 @@ void LODManager::autoAdjustLOD(float currentFPS) {
 
                 _lastDownShift = now;
                 _isDownshifting = true;
+                _lastNotifiedSizeScale = _octreeSizeScale;
 
                 emit LODDecreased();
             }
         } else {
     
-            // LOD Upward adjustment
-            if (elapsedSinceUpShift > UP_SHIFT_ELPASED) {
+            // LOD Upward adjustment, the budgets take care of it when the frame's costs are measured
+            if (!hasFrameTimes && elapsedSinceUpShift > UP_SHIFT_ELPASED) {
             
                 if (_fpsAverageUpWindow.getAverage() > getLODIncreaseFPS()) {
 
@@ -153,6 +195,7 @@ void LODManager::autoAdjustLOD(float currentFPS) {
 
                     _lastUpShift = now;
                     _isDownshifting = false;
+                    _lastNotifiedSizeScale = _octreeSizeScale;
 
                     emit LODIncreased();
                 }
@@ -160,20 +203,25 @@ void LODManager::autoAdjustLOD(float currentFPS) {
         }
     
         if (changed) {
-            auto lodToolsDialog = DependencyManager::get<DialogsManager>()->getLodToolsDialog();
-            if (lodToolsDialog) {
-                lodToolsDialog->reloadSliders();
-            }
+            notifyLODChanged();
         }
     }
 }
 
+void LODManager::notifyLODChanged() {
+    auto lodToolsDialog = DependencyManager::get<DialogsManager>()->getLodToolsDialog();
+    if (lodToolsDialog) {
+        lodToolsDialog->reloadSliders();
+    }
+}
+
 void LODManager::resetLODAdjust() {
     _fpsAverageStartWindow.reset();
     _fpsAverageDownWindow.reset();
     _fpsAverageUpWindow.reset();
     _lastUpShift = _lastDownShift = usecTimestampNow();
     _isDownshifting = false;
+    _avatarLODScale = 1.0f;
 }
 
 QString LODManager::getLODFeedbackText() {
@@ -223,6 +271,7 @@ bool LODManager::shouldRender(const RenderArgs* args, const AABox& bounds) {
 
 void LODManager::setOctreeSizeScale(float sizeScale) {
     _octreeSizeScale = sizeScale;
+    _lastNotifiedSizeScale = sizeScale;
 }
 
 void LODManager::setBoundaryLevelAdjust(int boundaryLevelAdjust) {
@@ -45,6 +45,25 @@ const float ADJUST_LOD_MAX_SIZE_SCALE = DEFAULT_OCTREE_SIZE_SCALE;
 // This controls how low the auto-adjust LOD will go. We want a minimum vision of ~20:500 or 0.04 of default
 const float ADJUST_LOD_MIN_SIZE_SCALE = DEFAULT_OCTREE_SIZE_SCALE * 0.04f;
 
+// The shares of the frame period the costs of a frame are held to. The main thread both updates and builds the frame.
+const float GPU_FRAME_BUDGET = 0.9f;
+const float RENDER_FRAME_BUDGET = 0.5f;
+const float SIMULATION_FRAME_BUDGET = 0.35f;
+// a cost has to fall below this share of its budget for its LOD to rise again
+const float FRAME_BUDGET_HEADROOM = 0.8f;
+// how fast an LOD falls when its cost is twice its budget, in e-folds per second, it rises a quarter as fast
+const float LOD_FALL_RATE = 2.0f;
+const float LOD_RISE_RATE = 0.5f;
+// the scaled down distance at which the other avatars are posed less often goes no lower than this
+const float MIN_AVATAR_LOD_SCALE = 0.25f;
+
+// The costs of the last frame, in milliseconds, 0 when not measured
+struct LODFrameTimes {
+    float gpu { 0.0f }; // from the GPU timer queries
+    float render { 0.0f }; // the main thread building the frame
+    float simulation { 0.0f }; // the main thread updating the simulation
+};
+
 class RenderArgs;
 class AABox;
 
@@ -75,8 +94,15 @@ public:
     Q_INVOKABLE float getLODDecreaseFPS();
     Q_INVOKABLE float getLODIncreaseFPS();
     
+    // 1 at full detail, lower as the simulation runs over its budget: the other avatars are posed as if that much nearer
+    Q_INVOKABLE float getAvatarLODScale() const { return _avatarLODScale; }
+
     static bool shouldRender(const RenderArgs* args, const AABox& bounds);
-    void autoAdjustLOD(float currentFPS);
+
+    // Holds the frame's costs within their budgets at the target frame rate: the GPU and render costs set the
+    // octree size scale, the simulation cost the avatar LOD. The frame rate thresholds still shift the octree size
+    // scale down when the frame rate falls below them, and up when the costs aren't measured.
+    void autoAdjustLOD(float currentFPS, float deltaTime, float targetFrameRate, const LODFrameTimes& frameTimes);
     
     void loadSettings();
     void saveSettings();
@@ -88,6 +114,8 @@ signals:
     
 private:
     LODManager();
+
+    void notifyLODChanged();
     
     bool _automaticLODAdjust = true;
     float _desktopLODDecreaseFPS = DEFAULT_DESKTOP_LOD_DOWN_FPS;
@@ -95,6 +123,9 @@ private:
 
     float _octreeSizeScale = DEFAULT_OCTREE_SIZE_SCALE;
     int _boundaryLevelAdjust = 0;
+    float _avatarLODScale = 1.0f;
+
+    float _lastNotifiedSizeScale = DEFAULT_OCTREE_SIZE_SCALE; // the budget adjusts continuously, it is told in steps
     
     quint64 _lastDownShift = 0;
     quint64 _lastUpShift = 0;
@@ -330,6 +330,9 @@ Menu::Menu() {
     // Developer > Render > OpenVR threaded submit
     addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::OpenVrThreadedSubmit, 0, true);
 
+    // Developer > Render > Capture Frame
+    addActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::CaptureFrame, 0, qApp, SLOT(captureFrame()));
+
     // Developer > Render > Resolution
     MenuWrapper* resolutionMenu = renderOptionsMenu->addMenu(MenuOption::RenderResolution);
     QActionGroup* resolutionGroup = new QActionGroup(resolutionMenu);
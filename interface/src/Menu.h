@@ -52,6 +52,7 @@ namespace MenuOption {
     const QString BookmarkLocation = "Bookmark Location";
     const QString Bookmarks = "Bookmarks";
     const QString CalibrateCamera = "Calibrate Camera";
+    const QString CaptureFrame = "Capture Frame";
     const QString CameraEntityMode = "Entity Mode";
     const QString CenterPlayerInView = "Center Player In View";
     const QString Chat = "Chat...";
@@ -344,12 +344,28 @@ void Avatar::simulate(float deltaTime, bool inView) {
 
 
     PerformanceTimer perfTimer("simulate");
+    uint64_t now = usecTimestampNow();
+    if (!_jitterBuffer.isEmpty()) {
+        glm::vec3 position = getLocalPosition();
+        glm::quat orientation = getLocalOrientation();
+        _jitterBuffer.sampleRoot(now, position, orientation);
+        setLocalPosition(position);
+        setLocalOrientation(orientation);
+        if (_motionState) {
+            _motionState->addDirtyFlags(Simulation::DIRTY_POSITION);
+        }
+    }
     {
         PROFILE_RANGE(simulation, "updateJoints");
-        if (inView && _hasNewJointData) {
-            _skeletonModel->getRig()->copyJointsFromJointData(_jointData);
-            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-            _skeletonModel->getRig()->computeExternalPoses(rootTransform);
+        if (inView && (_hasComputedJointPoses || needsJointPoses(now))) {
+            _lastJointPoseTime = now;
+            if (!_hasComputedJointPoses) {
+                updatePlaybackJointData(now);
+                _skeletonModel->getRig()->copyJointsFromJointData(_playbackJointData);
+                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+                _skeletonModel->getRig()->computeExternalPoses(rootTransform);
+            }
+            _hasComputedJointPoses = false;
             _jointDataSimulationRate.increment();
 
             _skeletonModel->simulate(deltaTime, true);
@@ -401,6 +417,22 @@ void Avatar::simulate(float deltaTime, bool inView) {
     }
 }
 
+void Avatar::computeJointPosesFromJointData() {
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    updatePlaybackJointData(usecTimestampNow());
+    _skeletonModel->getRig()->computeExternalPosesFromJointData(_playbackJointData, rootTransform);
+    _hasComputedJointPoses = true;
+}
+
+void Avatar::updatePlaybackJointData(uint64_t now) {
+    if (_jitterBuffer.isEmpty()) {
+        QReadLocker readLock(&_jointDataLock);
+        _playbackJointData = _jointData;
+    } else {
+        _jitterBuffer.sampleJoints(now, _playbackJointData);
+    }
+}
+
 float Avatar::getSimulationRate(const QString& rateName) const {
     if (rateName == "") {
         return _simulationRate.rate();
@@ -1015,7 +1047,14 @@ glm::vec3 Avatar::getAbsoluteJointTranslationInObjectFrame(int index) const {
 
 int Avatar::getJointIndex(const QString& name) const {
     if (QThread::currentThread() != thread()) {
-        int result;
+        int result = getFauxJointIndex(name);
+        if (result != -1) {
+            return result;
+        }
+        auto snapshot = getJointSnapshot();
+        if (snapshot) {
+            return snapshot->indices.value(name, -1);
+        }
         QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointIndex", Qt::BlockingQueuedConnection,
             Q_RETURN_ARG(int, result), Q_ARG(const QString&, name));
         return result;
@@ -1029,6 +1068,10 @@ int Avatar::getJointIndex(const QString& name) const {
 
 QStringList Avatar::getJointNames() const {
     if (QThread::currentThread() != thread()) {
+        auto snapshot = getJointSnapshot();
+        if (snapshot) {
+            return snapshot->names;
+        }
         QStringList result;
         QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointNames", Qt::BlockingQueuedConnection,
             Q_RETURN_ARG(QStringList, result));
@@ -1039,6 +1082,10 @@ QStringList Avatar::getJointNames() const {
 
 glm::vec3 Avatar::getJointPosition(int index) const {
     if (QThread::currentThread() != thread()) {
+        auto snapshot = getJointSnapshot();
+        if (snapshot && index >= 0) {
+            return index < snapshot->positions.size() ? snapshot->positions[index] : glm::vec3();
+        }
         glm::vec3 position;
         QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointPosition", Qt::BlockingQueuedConnection,
                                   Q_RETURN_ARG(glm::vec3, position), Q_ARG(const int, index));
@@ -1051,6 +1098,10 @@ glm::vec3 Avatar::getJointPosition(int index) const {
 
 glm::vec3 Avatar::getJointPosition(const QString& name) const {
     if (QThread::currentThread() != thread()) {
+        auto snapshot = getJointSnapshot();
+        if (snapshot) {
+            return getJointPosition(getJointIndex(name));
+        }
         glm::vec3 position;
         QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointPosition", Qt::BlockingQueuedConnection,
                                   Q_RETURN_ARG(glm::vec3, position), Q_ARG(const QString&, name));
@@ -1139,6 +1190,20 @@ int Avatar::parseDataFromBuffer(const QByteArray& buffer) {
         init();
     }
 
+    // The root is played back from the jitter buffer, so the latest root received goes back in before the packet is
+    // parsed: the orientation is only sent when it changes, and a packet without it must leave the latest received,
+    // not the one played back, as the newest state.
+    bool isPlayingBack = !_jitterBuffer.isEmpty();
+    glm::vec3 playbackPosition = getLocalPosition();
+    glm::quat playbackOrientation = getLocalOrientation();
+    if (isPlayingBack) {
+        glm::vec3 position = playbackPosition;
+        glm::quat orientation = playbackOrientation;
+        _jitterBuffer.getLatestRoot(position, orientation);
+        setLocalPosition(position);
+        setLocalOrientation(orientation);
+    }
+
     // change in position implies movement
     glm::vec3 oldPosition = getPosition();
 
@@ -1146,6 +1211,20 @@ int Avatar::parseDataFromBuffer(const QByteArray& buffer) {
 
     const float MOVE_DISTANCE_THRESHOLD = 0.001f;
     _moving = glm::distance(oldPosition, getPosition()) > MOVE_DISTANCE_THRESHOLD;
+
+    if (hasParent()) {
+        _jitterBuffer.clear();
+    } else {
+        {
+            QReadLocker readLock(&_jointDataLock);
+            _jitterBuffer.addState(usecTimestampNow(), getLocalPosition(), getLocalOrientation(), _jointData);
+        }
+        if (isPlayingBack) {
+            // until simulate samples the buffer again
+            setLocalPosition(playbackPosition);
+            setLocalOrientation(playbackOrientation);
+        }
+    }
     if (_moving && _motionState) {
         _motionState->addDirtyFlags(Simulation::DIRTY_POSITION);
     }
@@ -1359,6 +1438,47 @@ void Avatar::updatePalms() {
     _rightPalmRotationCache.set(getUncachedRightPalmRotation());
     _leftPalmPositionCache.set(getUncachedLeftPalmPosition());
     _rightPalmPositionCache.set(getUncachedRightPalmPosition());
+    updateJointSnapshot();
+}
+
+void Avatar::updateJointSnapshot() {
+    if (!_jointSnapshotRequested.exchange(false)) {
+        return;
+    }
+    auto snapshot = std::make_shared<JointSnapshot>();
+    snapshot->timestamp = usecTimestampNow();
+    if (_skeletonModel->isActive()) {
+        const FBXGeometry& geometry = _skeletonModel->getFBXGeometry();
+        auto previous = _jointSnapshot.get();
+        snapshot->geometry = &geometry;
+        if (previous && previous->geometry == &geometry) {
+            // the joint names only change with the model
+            snapshot->names = previous->names;
+            snapshot->indices = previous->indices;
+        } else {
+            snapshot->names = geometry.getJointNames();
+            for (int i = 0; i < snapshot->names.size(); i++) {
+                snapshot->indices.insert(snapshot->names[i], i);
+            }
+        }
+        int numJoints = _skeletonModel->getJointStateCount();
+        snapshot->positions.resize(numJoints);
+        for (int i = 0; i < numJoints; i++) {
+            _skeletonModel->getJointPositionInWorldFrame(i, snapshot->positions[i]);
+        }
+    }
+    _jointSnapshot.set(snapshot);
+}
+
+Avatar::JointSnapshotPointer Avatar::getJointSnapshot() const {
+    // asks for the snapshot to be kept up to date, and returns it if it's recent enough to use
+    static const quint64 MAX_JOINT_SNAPSHOT_AGE = 100 * USECS_PER_MSEC;
+    _jointSnapshotRequested = true;
+    auto snapshot = _jointSnapshot.get();
+    if (snapshot && usecTimestampNow() - snapshot->timestamp < MAX_JOINT_SNAPSHOT_AGE) {
+        return snapshot;
+    }
+    return JointSnapshotPointer();
 }
 
 void Avatar::setParentID(const QUuid& parentID) {
@@ -11,6 +11,9 @@
 #ifndef hifi_Avatar_h
 #define hifi_Avatar_h
 
+#include <atomic>
+#include <memory>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -22,6 +25,7 @@
 
 #include <render/Scene.h>
 
+#include "AvatarJitterBuffer.h"
 #include "Head.h"
 #include "SkeletonModel.h"
 #include "world.h"
@@ -67,6 +71,11 @@ public:
     void init();
     void updateAvatarEntities();
     void simulate(float deltaTime, bool inView);
+
+    // poses the rig from new joint data ahead of simulate, which then skips it; safe to call for several avatars
+    // at once from worker threads while the main thread waits, see AvatarManager::updateOtherAvatars
+    void computeJointPosesFromJointData();
+
     virtual void simulateAttachments(float deltaTime);
 
     virtual void render(RenderArgs* renderArgs, const glm::vec3& cameraPosition);
@@ -185,6 +194,12 @@ public:
 
     bool hasNewJointData() const { return _hasNewJointData; }
 
+    // distant avatars are posed from their joint data at a lower rate, the data waits for the next update meanwhile
+    void setJointPoseInterval(uint64_t interval) { _jointPoseInterval = interval; }
+    bool needsJointPoses(uint64_t now) const {
+        return (_hasNewJointData || _jitterBuffer.isPlaying(now)) && now - _lastJointPoseTime >= _jointPoseInterval;
+    }
+
 public slots:
 
     // FIXME - these should be migrated to use Pose data instead
@@ -258,6 +273,21 @@ protected:
     ThreadSafeValueCache<glm::vec3> _rightPalmPositionCache { glm::vec3() };
     ThreadSafeValueCache<glm::quat> _rightPalmRotationCache { glm::quat() };
 
+    // The skeleton's joints as of the last frame, for script threads to read without blocking on the main thread.
+    // It's only kept up to date while scripts are reading it, and readers fall back to the main thread if it's stale.
+    struct JointSnapshot {
+        quint64 timestamp { 0 };
+        const void* geometry { nullptr };
+        QStringList names;
+        QHash<QString, int> indices;
+        QVector<glm::vec3> positions; // world frame
+    };
+    using JointSnapshotPointer = std::shared_ptr<const JointSnapshot>;
+    void updateJointSnapshot();
+    JointSnapshotPointer getJointSnapshot() const;
+    ThreadSafeValueCache<JointSnapshotPointer> _jointSnapshot;
+    mutable std::atomic<bool> _jointSnapshotRequested { false };
+
     void addToScene(AvatarSharedPointer self);
     void ensureInScene(AvatarSharedPointer self);
 
@@ -280,6 +310,8 @@ private:
     MapOfAvatarEntityDataHashes _avatarEntityDataHashes;
 
     uint64_t _lastRenderUpdateTime { 0 };
+    uint64_t _lastJointPoseTime { 0 };
+    uint64_t _jointPoseInterval { 0 };
     int _leftPointerGeometryID { 0 };
     int _rightPointerGeometryID { 0 };
     int _nameRectGeometryID { 0 };
@@ -287,6 +319,12 @@ private:
     bool _isLookAtTarget { false };
     bool _inScene { false };
     bool _isAnimatingScale { false };
+    bool _hasComputedJointPoses { false }; // the rig was posed from the current joint data before simulate
+
+    // the states of a remote avatar are played back from here, a little late but smoothly, when it has no parent
+    AvatarJitterBuffer _jitterBuffer;
+    QVector<JointData> _playbackJointData; // what the rig is posed from, the joint data played back at the time
+    void updatePlaybackJointData(uint64_t now);
 
     float getBoundingRadius() const;
 
@@ -0,0 +1,219 @@
+//
+//  AvatarJitterBuffer.cpp
+//  interface/src/avatar/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarJitterBuffer.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+
+namespace {
+    const size_t MAX_STATES = 8;
+    const float AVERAGING_FACTOR = 0.1f; // of each new interval in the averages
+    const float MAX_AVERAGED_INTERVAL = 0.5f; // seconds, the pauses of still avatars don't count for more
+    const float JITTER_FACTOR = 2.0f; // deviations of the interval the playback waits for
+    const float MAX_PLAYBACK_DELAY = 0.25f; // seconds
+    const float MAX_EXTRAPOLATION = 0.25f; // seconds
+    const float MAX_INTERPOLATED_DISTANCE = 10.0f; // meters, further moves between states are teleports
+
+    // cubic hermite between p1 and p2, with the tangents of catmull-rom for segments of different durations:
+    // d0, d1 and d2 are the durations from p0 to p1, p1 to p2 and p2 to p3
+    template <typename T>
+    T hermite(const T& p0, const T& p1, const T& p2, const T& p3, float d0, float d1, float d2, float s) {
+        T m1 = (p2 - p0) * (d1 / (d0 + d1));
+        T m2 = (p3 - p1) * (d1 / (d1 + d2));
+        float s2 = s * s;
+        float s3 = s2 * s;
+        return (2.0f * s3 - 3.0f * s2 + 1.0f) * p1 + (s3 - 2.0f * s2 + s) * m1 +
+            (-2.0f * s3 + 3.0f * s2) * p2 + (s3 - s2) * m2;
+    }
+
+    glm::vec4 quatToVec4(const glm::quat& q, const glm::vec4& hemisphere) {
+        glm::vec4 v(q.x, q.y, q.z, q.w);
+        return glm::dot(v, hemisphere) < 0.0f ? -v : v;
+    }
+
+    // the quaternions are interpolated component-wise in the hemisphere of the first, then normalized
+    glm::quat hermite(const glm::quat& q0, const glm::quat& q1, const glm::quat& q2, const glm::quat& q3,
+                      float d0, float d1, float d2, float s) {
+        glm::vec4 v1(q1.x, q1.y, q1.z, q1.w);
+        glm::vec4 v0 = quatToVec4(q0, v1);
+        glm::vec4 v2 = quatToVec4(q2, v1);
+        glm::vec4 v3 = quatToVec4(q3, v2);
+        glm::vec4 v = glm::normalize(hermite(v0, v1, v2, v3, d0, d1, d2, s));
+        return glm::quat(v.w, v.x, v.y, v.z);
+    }
+
+    float secondsBetween(uint64_t earlier, uint64_t later) {
+        return (float)(later - earlier) / (float)USECS_PER_SECOND;
+    }
+}
+
+void AvatarJitterBuffer::addState(uint64_t now, const glm::vec3& position, const glm::quat& orientation,
+                                  const QVector<JointData>& jointData) {
+    if (!_states.empty()) {
+        const State& latest = _states.back();
+        if (now <= latest.time) {
+            // several in the same frame, the last one holds
+            _states.back() = { latest.time, position, orientation, jointData };
+            return;
+        }
+        if (glm::distance(position, latest.position) > MAX_INTERPOLATED_DISTANCE) {
+            _states.clear();
+        } else {
+            float interval = std::min(secondsBetween(latest.time, now), MAX_AVERAGED_INTERVAL);
+            if (_averageInterval == 0.0f) {
+                _averageInterval = interval;
+            } else {
+                _averageJitter += AVERAGING_FACTOR * (fabsf(interval - _averageInterval) - _averageJitter);
+                _averageInterval += AVERAGING_FACTOR * (interval - _averageInterval);
+            }
+        }
+    }
+
+    _states.push_back({ now, position, orientation, jointData });
+    while (_states.size() > MAX_STATES) {
+        _states.pop_front();
+    }
+}
+
+void AvatarJitterBuffer::clear() {
+    _states.clear();
+    _averageInterval = 0.0f;
+    _averageJitter = 0.0f;
+}
+
+void AvatarJitterBuffer::getLatestRoot(glm::vec3& positionOut, glm::quat& orientationOut) const {
+    if (!_states.empty()) {
+        positionOut = _states.back().position;
+        orientationOut = _states.back().orientation;
+    }
+}
+
+uint64_t AvatarJitterBuffer::getPlaybackTime(uint64_t now) const {
+    float delay = std::min(_averageInterval + JITTER_FACTOR * _averageJitter, MAX_PLAYBACK_DELAY);
+    uint64_t delayUsecs = (uint64_t)(delay * USECS_PER_SECOND);
+    return now > delayUsecs ? now - delayUsecs : 0;
+}
+
+bool AvatarJitterBuffer::isPlaying(uint64_t now) const {
+    return _states.size() > 1 && getPlaybackTime(now) < _states.back().time;
+}
+
+bool AvatarJitterBuffer::findSegment(uint64_t playbackTime, int& previous, int& next, float& fraction) const {
+    if (playbackTime <= _states.front().time) {
+        previous = next = 0;
+        fraction = 0.0f;
+        return true;
+    }
+    for (int i = 1; i < (int)_states.size(); i++) {
+        if (playbackTime < _states[i].time) {
+            previous = i - 1;
+            next = i;
+            fraction = secondsBetween(_states[previous].time, playbackTime) /
+                secondsBetween(_states[previous].time, _states[next].time);
+            return true;
+        }
+    }
+    previous = next = (int)_states.size() - 1;
+    fraction = 0.0f;
+    return false;
+}
+
+void AvatarJitterBuffer::sampleRoot(uint64_t now, glm::vec3& positionOut, glm::quat& orientationOut) const {
+    if (_states.empty()) {
+        return;
+    }
+
+    uint64_t playbackTime = getPlaybackTime(now);
+    int previous, next;
+    float fraction;
+    if (!findSegment(playbackTime, previous, next, fraction)) {
+        // the next state is late, the avatar carries on as it was going meanwhile
+        const State& latest = _states.back();
+        positionOut = latest.position;
+        orientationOut = latest.orientation;
+        if (_states.size() > 1) {
+            const State& before = _states[_states.size() - 2];
+            glm::vec3 velocity = (latest.position - before.position) / secondsBetween(before.time, latest.time);
+            positionOut += velocity * std::min(secondsBetween(latest.time, playbackTime), MAX_EXTRAPOLATION);
+        }
+        return;
+    }
+    if (previous == next) {
+        positionOut = _states[previous].position;
+        orientationOut = _states[previous].orientation;
+        return;
+    }
+
+    // the positions beyond the segment are reflected when there aren't any states there yet, for a straight tangent
+    const State& a = _states[previous];
+    const State& b = _states[next];
+    float d1 = secondsBetween(a.time, b.time);
+    bool hasBefore = previous > 0;
+    bool hasAfter = next + 1 < (int)_states.size();
+    float d0 = hasBefore ? secondsBetween(_states[previous - 1].time, a.time) : d1;
+    float d2 = hasAfter ? secondsBetween(b.time, _states[next + 1].time) : d1;
+
+    glm::vec3 p0 = hasBefore ? _states[previous - 1].position : 2.0f * a.position - b.position;
+    glm::vec3 p3 = hasAfter ? _states[next + 1].position : 2.0f * b.position - a.position;
+    positionOut = hermite(p0, a.position, b.position, p3, d0, d1, d2, fraction);
+
+    glm::quat q0 = hasBefore ? _states[previous - 1].orientation : a.orientation;
+    glm::quat q3 = hasAfter ? _states[next + 1].orientation : b.orientation;
+    orientationOut = hermite(q0, a.orientation, b.orientation, q3, d0, d1, d2, fraction);
+}
+
+void AvatarJitterBuffer::sampleJoints(uint64_t now, QVector<JointData>& jointDataOut) const {
+    if (_states.empty()) {
+        return;
+    }
+
+    int previous, next;
+    float fraction;
+    findSegment(getPlaybackTime(now), previous, next, fraction);
+    const State& a = _states[previous];
+    const State& b = _states[next];
+    int numJoints = a.jointData.size();
+    if (previous == next || b.jointData.size() != numJoints) {
+        jointDataOut = a.jointData;
+        return;
+    }
+
+    float d1 = secondsBetween(a.time, b.time);
+    const State* before = (previous > 0 && _states[previous - 1].jointData.size() == numJoints) ?
+        &_states[previous - 1] : nullptr;
+    const State* after = (next + 1 < (int)_states.size() && _states[next + 1].jointData.size() == numJoints) ?
+        &_states[next + 1] : nullptr;
+    float d0 = before ? secondsBetween(before->time, a.time) : d1;
+    float d2 = after ? secondsBetween(b.time, after->time) : d1;
+
+    jointDataOut.resize(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        const JointData& jointA = a.jointData[i];
+        const JointData& jointB = b.jointData[i];
+        JointData& joint = jointDataOut[i];
+        joint = jointB;
+        if (jointA.rotationSet && jointB.rotationSet) {
+            const glm::quat& q0 = (before && before->jointData[i].rotationSet) ?
+                before->jointData[i].rotation : jointA.rotation;
+            const glm::quat& q3 = (after && after->jointData[i].rotationSet) ?
+                after->jointData[i].rotation : jointB.rotation;
+            joint.rotation = hermite(q0, jointA.rotation, jointB.rotation, q3, d0, d1, d2, fraction);
+        }
+        if (jointA.translationSet && jointB.translationSet) {
+            glm::vec3 p0 = (before && before->jointData[i].translationSet) ?
+                before->jointData[i].translation : 2.0f * jointA.translation - jointB.translation;
+            glm::vec3 p3 = (after && after->jointData[i].translationSet) ?
+                after->jointData[i].translation : 2.0f * jointB.translation - jointA.translation;
+            joint.translation = hermite(p0, jointA.translation, jointB.translation, p3, d0, d1, d2, fraction);
+        }
+    }
+}
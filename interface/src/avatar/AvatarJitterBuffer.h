@@ -0,0 +1,63 @@
+//
+//  AvatarJitterBuffer.h
+//  interface/src/avatar/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarJitterBuffer_h
+#define hifi_AvatarJitterBuffer_h
+
+#include <deque>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <QtCore/QVector>
+
+#include <JointData.h>
+
+// Plays back the states of a remote avatar as they arrived, a little in the past: far enough behind the latest
+// state to have the next one most of the time in spite of the jitter of their arrival.  The root and the joints are
+// hermite interpolated between the states around the playback time, and when the next state is late the root carries
+// on at its last velocity for a while, so the avatars move smoothly at low update rates.
+class AvatarJitterBuffer {
+public:
+    void addState(uint64_t now, const glm::vec3& position, const glm::quat& orientation,
+                  const QVector<JointData>& jointData);
+    void clear();
+
+    bool isEmpty() const { return _states.empty(); }
+
+    // the root of the latest state, as received
+    void getLatestRoot(glm::vec3& positionOut, glm::quat& orientationOut) const;
+
+    // whether the playback hasn't reached the latest state yet, so the joints keep changing without new data
+    bool isPlaying(uint64_t now) const;
+
+    void sampleRoot(uint64_t now, glm::vec3& positionOut, glm::quat& orientationOut) const;
+    void sampleJoints(uint64_t now, QVector<JointData>& jointDataOut) const;
+
+private:
+    struct State {
+        uint64_t time; // usec, when it was received
+        glm::vec3 position;
+        glm::quat orientation;
+        QVector<JointData> jointData;
+    };
+
+    uint64_t getPlaybackTime(uint64_t now) const;
+
+    // the states of the segment the playback time falls into, as indices of _states, with the fraction of the way
+    // from the first to the second, false once past the latest state
+    bool findSegment(uint64_t playbackTime, int& previous, int& next, float& fraction) const;
+
+    std::deque<State> _states;
+    float _averageInterval { 0.0f }; // seconds between the states as they arrive
+    float _averageJitter { 0.0f }; // seconds of deviation from that interval
+};
+
+#endif // hifi_AvatarJitterBuffer_h
@@ -12,6 +12,7 @@
 #include <string>
 
 #include <QScriptEngine>
+#include <QtConcurrent/QtConcurrentMap>
 
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
@@ -37,6 +38,7 @@
 #include "Avatar.h"
 #include "AvatarManager.h"
 #include "InterfaceLogging.h"
+#include "LODManager.h"
 #include "Menu.h"
 #include "MyAvatar.h"
 #include "SceneScriptingInterface.h"
@@ -46,6 +48,9 @@
 // what we want
 const int CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 50;
 static const quint64 MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+// while MyAvatar stands still it only sends often enough to repair lost packets and keep viewers' copies fresh
+const int CLIENT_TO_AVATAR_MIXER_IDLE_FRAMES_PER_SECOND = 5;
+static const quint64 MAX_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_IDLE_FRAMES_PER_SECOND;
 
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
@@ -98,6 +103,7 @@ void AvatarManager::init() {
     {
         QWriteLocker locker(&_hashLock);
         _avatarHash.insert(MY_AVATAR_KEY, _myAvatar);
+        publishHashSnapshot();
     }
 
     connect(DependencyManager::get<SceneScriptingInterface>().data(), &SceneScriptingInterface::shouldRenderAvatarsChanged,
@@ -121,11 +127,20 @@ void AvatarManager::updateMyAvatar(float deltaTime) {
     quint64 dt = now - _lastSendAvatarDataTime;
 
     if (dt > MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS) {
-        // send head/hand data to the avatar mixer and voxel server
-        PerformanceTimer perfTimer("send");
-        _myAvatar->sendAvatarDataPacket();
-        _lastSendAvatarDataTime = now;
-        _myAvatarSendRate.increment();
+        // send at the full rate while the avatar visibly moves, and at the idle rate while it doesn't
+        bool isMoving = _myAvatar->hasChangedVisiblySinceLastSent();
+        if (isMoving || dt > MAX_TIME_BETWEEN_MY_AVATAR_DATA_SENDS) {
+            // the first send after coming to rest is a full update, so that viewers that lost the last
+            // moving packet don't keep the avatar mid-gesture until the next random full update
+            bool sendAll = !isMoving && _myAvatarWasMoving;
+
+            // send head/hand data to the avatar mixer and voxel server
+            PerformanceTimer perfTimer("send");
+            _myAvatar->sendAvatarDataPacket(sendAll);
+            _lastSendAvatarDataTime = now;
+            _myAvatarWasMoving = isMoving;
+            _myAvatarSendRate.increment();
+        }
     }
 }
 
@@ -148,18 +163,30 @@ float AvatarManager::getAvatarSimulationRate(const QUuid& sessionID, const QStri
 }
 
 
+// the farther an avatar is, the less its joints are seen to move, so the less often it is posed
+static uint64_t computeJointPoseInterval(float distance) {
+    const float NEAR_AVATAR_DISTANCE = 10.0f; // meters
+    const float MIDDLE_AVATAR_DISTANCE = 30.0f; // meters
+    const uint64_t MIDDLE_AVATAR_JOINT_POSE_INTERVAL = USECS_PER_SECOND / 30;
+    const uint64_t FAR_AVATAR_JOINT_POSE_INTERVAL = USECS_PER_SECOND / 10;
+    if (distance < NEAR_AVATAR_DISTANCE) {
+        return 0;
+    } else if (distance < MIDDLE_AVATAR_DISTANCE) {
+        return MIDDLE_AVATAR_JOINT_POSE_INTERVAL;
+    }
+    return FAR_AVATAR_JOINT_POSE_INTERVAL;
+}
+
 void AvatarManager::updateOtherAvatars(float deltaTime) {
-    // lock the hash for read to check the size
-    QReadLocker lock(&_hashLock);
-    if (_avatarHash.size() < 2 && _avatarFades.isEmpty()) {
+    // everything below works on this snapshot, avatars added or removed meanwhile are picked up next frame
+    auto avatarMap = getHashSnapshot();
+    if (avatarMap->size() < 2 && _avatarFades.isEmpty()) {
         return;
     }
-    lock.unlock();
 
     PerformanceTimer perfTimer("otherAvatars");
 
-    auto avatarMap = getHashCopy();
-    QList<AvatarSharedPointer> avatarList = avatarMap.values();
+    QList<AvatarSharedPointer> avatarList = avatarMap->values();
     ViewFrustum cameraView;
     qApp->copyDisplayViewFrustum(cameraView);
 
@@ -192,13 +219,44 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             return false;
         });
 
+    const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
+
     render::PendingChanges pendingChanges;
     uint64_t startTime = usecTimestampNow();
     const uint64_t UPDATE_BUDGET = 2000; // usec
     uint64_t updateExpiry = startTime + UPDATE_BUDGET;
 
+    // pose the rigs of all the avatars in view with new joint data in one pass across the thread pool, the rest of
+    // their simulation stays on this thread below (and within its budget)
+    {
+        PerformanceTimer perfTimer("jointPoses");
+        std::vector<Avatar*> avatarsToPose;
+        auto avatarsInOrder = sortedAvatars;
+        glm::vec3 cameraPosition = cameraView.getPosition();
+        // when the simulation runs over its budget the avatars are posed as if they were farther
+        float avatarLODScale = DependencyManager::get<LODManager>()->getAvatarLODScale();
+        while (!avatarsInOrder.empty() && avatarsInOrder.top().priority > OUT_OF_VIEW_THRESHOLD) {
+            auto avatar = std::static_pointer_cast<Avatar>(avatarsInOrder.top().avatar).get();
+            float distance = glm::distance(cameraPosition, avatar->getPosition()) / avatarLODScale;
+            avatar->setJointPoseInterval(computeJointPoseInterval(distance));
+            if (avatar->needsJointPoses(startTime)) {
+                avatarsToPose.push_back(avatar);
+            }
+            avatarsInOrder.pop();
+        }
+
+        if (avatarsToPose.size() > 1) {
+            QtConcurrent::blockingMap(avatarsToPose, [](Avatar* avatar) {
+                avatar->computeJointPosesFromJointData();
+            });
+        } else if (!avatarsToPose.empty()) {
+            avatarsToPose.front()->computeJointPosesFromJointData();
+        }
+    }
+
     int numAvatarsUpdated = 0;
     int numAVatarsNotUpdated = 0;
+    std::vector<SkeletonModel*> skeletonModelsToSkin;
     while (!sortedAvatars.empty()) {
         const AvatarPriority& sortData = sortedAvatars.top();
         const auto& avatar = std::static_pointer_cast<Avatar>(sortData.avatar);
@@ -219,7 +277,6 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
         avatar->animateScaleChanges(deltaTime);
 
-        const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
         uint64_t now = usecTimestampNow();
         if (now < updateExpiry) {
             // we're within budget
@@ -230,6 +287,9 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             avatar->simulate(deltaTime, inView);
             avatar->updateRenderItem(pendingChanges);
             avatar->setLastRenderUpdateTime(startTime);
+            if (inView) {
+                skeletonModelsToSkin.push_back(avatar->getSkeletonModel().get());
+            }
         } else {
             // we've spent our full time budget --> bail on the rest of the avatar updates
             // --> more avatars may freeze until their priority trickles up
@@ -259,6 +319,15 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         sortedAvatars.pop();
     }
 
+    // the cluster matrices of the avatars that were posed are computed across the thread pool as well, the render
+    // updates after this frame only upload them
+    if (skeletonModelsToSkin.size() > 1) {
+        PerformanceTimer perfTimer("clusterMatrices");
+        QtConcurrent::blockingMap(skeletonModelsToSkin, [](SkeletonModel* skeletonModel) {
+            skeletonModel->computeClusterMatrices();
+        });
+    }
+
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAVatarsNotUpdated;
@@ -268,10 +337,9 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 }
 
 void AvatarManager::postUpdate(float deltaTime) {
-    auto hashCopy = getHashCopy();
-    AvatarHash::iterator avatarIterator = hashCopy.begin();
-    for (avatarIterator = hashCopy.begin(); avatarIterator != hashCopy.end(); avatarIterator++) {
-        auto avatar = std::static_pointer_cast<Avatar>(avatarIterator.value());
+    auto avatarHash = getHashSnapshot();
+    for (auto avatarData : *avatarHash) {
+        auto avatar = std::static_pointer_cast<Avatar>(avatarData);
         avatar->postUpdate(deltaTime);
     }
 }
@@ -324,6 +392,7 @@ void AvatarManager::removeAvatar(const QUuid& sessionUUID, KillAvatarReason remo
 
     auto removedAvatar = _avatarHash.take(sessionUUID);
     if (removedAvatar) {
+        publishHashSnapshot();
         handleRemovedAvatar(removedAvatar, removalReason);
     }
 }
@@ -369,6 +438,7 @@ void AvatarManager::clearOtherAvatars() {
         } else {
             auto removedAvatar = avatarIterator.value();
             avatarIterator = _avatarHash.erase(avatarIterator);
+            publishHashSnapshot();
 
             handleRemovedAvatar(removedAvatar);
         }
@@ -475,8 +545,9 @@ void AvatarManager::handleCollisionEvents(const CollisionEvents& collisionEvents
 }
 
 void AvatarManager::updateAvatarRenderStatus(bool shouldRenderAvatars) {
+    auto avatarHash = getHashSnapshot();
     if (DependencyManager::get<SceneScriptingInterface>()->shouldRenderAvatars()) {
-        for (auto avatarData : _avatarHash) {
+        for (auto avatarData : *avatarHash) {
             auto avatar = std::static_pointer_cast<Avatar>(avatarData);
             render::ScenePointer scene = qApp->getMain3DScene();
             render::PendingChanges pendingChanges;
@@ -484,7 +555,7 @@ void AvatarManager::updateAvatarRenderStatus(bool shouldRenderAvatars) {
             scene->enqueuePendingChanges(pendingChanges);
         }
     } else {
-        for (auto avatarData : _avatarHash) {
+        for (auto avatarData : *avatarHash) {
             auto avatar = std::static_pointer_cast<Avatar>(avatarData);
             render::ScenePointer scene = qApp->getMain3DScene();
             render::PendingChanges pendingChanges;
@@ -519,9 +590,17 @@ RayToAvatarIntersectionResult AvatarManager::findRayIntersection(const PickRay&
     QVector<EntityItemID> avatarsToInclude = qVectorEntityItemIDFromScriptValue(avatarIdsToInclude);
     QVector<EntityItemID> avatarsToDiscard = qVectorEntityItemIDFromScriptValue(avatarIdsToDiscard);
 
+    return findRayIntersectionVector(ray, avatarsToInclude, avatarsToDiscard);
+}
+
+RayToAvatarIntersectionResult AvatarManager::findRayIntersectionVector(const PickRay& ray,
+                                                                       const QVector<EntityItemID>& avatarsToInclude,
+                                                                       const QVector<EntityItemID>& avatarsToDiscard) {
+    RayToAvatarIntersectionResult result;
     glm::vec3 normDirection = glm::normalize(ray.direction);
 
-    for (auto avatarData : _avatarHash) {
+    auto avatarHash = getHashSnapshot();
+    for (auto avatarData : *avatarHash) {
         auto avatar = std::static_pointer_cast<Avatar>(avatarData);
         if ((avatarsToInclude.size() > 0 && !avatarsToInclude.contains(avatar->getID())) ||
             (avatarsToDiscard.size() > 0 && avatarsToDiscard.contains(avatar->getID()))) {
@@ -80,6 +80,10 @@ public:
     Q_INVOKABLE RayToAvatarIntersectionResult findRayIntersection(const PickRay& ray,
                                                                   const QScriptValue& avatarIdsToInclude = QScriptValue(),
                                                                   const QScriptValue& avatarIdsToDiscard = QScriptValue());
+    // the same without the script values, for the picks (on the main thread)
+    RayToAvatarIntersectionResult findRayIntersectionVector(const PickRay& ray,
+                                                            const QVector<EntityItemID>& avatarsToInclude,
+                                                            const QVector<EntityItemID>& avatarsToDiscard);
 
     // TODO: remove this HACK once we settle on optimal default sort coefficients
     Q_INVOKABLE float getAvatarSortCoefficient(const QString& name);
@@ -108,6 +112,7 @@ private:
     QVector<AvatarSharedPointer> _avatarFades;
     std::shared_ptr<MyAvatar> _myAvatar;
     quint64 _lastSendAvatarDataTime = 0; // Controls MyAvatar send data rate.
+    bool _myAvatarWasMoving { false };
 
     QVector<AvatarManager::LocalLight> _localLights;
 
@@ -22,7 +22,7 @@ CauterizedMeshPartPayload::CauterizedMeshPartPayload(Model* model, int meshIndex
 
 void CauterizedMeshPartPayload::updateTransformForCauterizedMesh(
         const Transform& renderTransform,
-        const gpu::BufferPointer& buffer) {
+        const gpu::BufferView& buffer) {
     _cauterizedTransform = renderTransform;
     _cauterizedClusterBuffer = buffer;
 }
@@ -33,12 +33,12 @@ void CauterizedMeshPartPayload::bindTransform(gpu::Batch& batch, const render::S
     bool useCauterizedMesh = (renderMode != RenderArgs::RenderMode::SHADOW_RENDER_MODE) && skeleton->getEnableCauterization();
 
     if (useCauterizedMesh) {
-        if (_cauterizedClusterBuffer) {
+        if (_cauterizedClusterBuffer._buffer) {
             batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::SKINNING, _cauterizedClusterBuffer);
         }
         batch.setModelTransform(_cauterizedTransform);
     } else {
-        if (_clusterBuffer) {
+        if (_clusterBuffer._buffer) {
             batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::SKINNING, _clusterBuffer);
         }
         batch.setModelTransform(_transform);
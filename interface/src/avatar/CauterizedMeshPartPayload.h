@@ -18,12 +18,12 @@ class CauterizedMeshPartPayload : public ModelMeshPartPayload {
 public:
     CauterizedMeshPartPayload(Model* model, int meshIndex, int partIndex, int shapeIndex, const Transform& transform, const Transform& offsetTransform);
 
-    void updateTransformForCauterizedMesh(const Transform& renderTransform, const gpu::BufferPointer& buffer);
+    void updateTransformForCauterizedMesh(const Transform& renderTransform, const gpu::BufferView& buffer);
 
     void bindTransform(gpu::Batch& batch, const render::ShapePipeline::LocationsPointer locations, RenderArgs::RenderMode renderMode) const override;
 
 private:
-    gpu::BufferPointer _cauterizedClusterBuffer;
+    gpu::BufferView _cauterizedClusterBuffer;
     Transform _cauterizedTransform;
 };
 
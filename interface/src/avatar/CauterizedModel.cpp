@@ -95,38 +95,17 @@ void CauterizedModel::createCollisionRenderItemSet() {
     Model::createCollisionRenderItemSet();
 }
 
-void CauterizedModel::updateClusterMatrices() {
-    PerformanceTimer perfTimer("CauterizedModel::updateClusterMatrices");
+void CauterizedModel::computeClusterMatrices() {
+    PerformanceTimer perfTimer("CauterizedModel::computeClusterMatrices");
 
     if (!_needsUpdateClusterMatrices || !isLoaded()) {
         return;
     }
-    _needsUpdateClusterMatrices = false;
-    const FBXGeometry& geometry = getFBXGeometry();
-
-    for (int i = 0; i < _meshStates.size(); i++) {
-        Model::MeshState& state = _meshStates[i];
-        const FBXMesh& mesh = geometry.meshes.at(i);
-        for (int j = 0; j < mesh.clusters.size(); j++) {
-            const FBXCluster& cluster = mesh.clusters.at(j);
-            auto jointMatrix = _rig->getJointTransform(cluster.jointIndex);
-            glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
-        }
-
-        // Once computed the cluster matrices, update the buffer(s)
-        if (mesh.clusters.size() > 1) {
-            if (!state.clusterBuffer) {
-                state.clusterBuffer = std::make_shared<gpu::Buffer>(state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                                    (const gpu::Byte*) state.clusterMatrices.constData());
-            } else {
-                state.clusterBuffer->setSubData(0, state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                (const gpu::Byte*) state.clusterMatrices.constData());
-            }
-        }
-    }
+    Model::computeClusterMatrices();
 
     // as an optimization, don't build cautrizedClusterMatrices if the boneSet is empty.
     if (!_cauterizeBoneSet.empty()) {
+        const FBXGeometry& geometry = getFBXGeometry();
         static const glm::mat4 zeroScale(
             glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
             glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
@@ -145,16 +124,35 @@ void CauterizedModel::updateClusterMatrices() {
                 }
                 glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
             }
+        }
+    }
+}
 
-            if (!_cauterizeBoneSet.empty() && (state.clusterMatrices.size() > 1)) {
-                if (!state.clusterBuffer) {
-                    state.clusterBuffer =
-                        std::make_shared<gpu::Buffer>(state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                      (const gpu::Byte*) state.clusterMatrices.constData());
-                } else {
-                    state.clusterBuffer->setSubData(0, state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                              (const gpu::Byte*) state.clusterMatrices.constData());
-                }
+void CauterizedModel::updateClusterMatrices() {
+    PerformanceTimer perfTimer("CauterizedModel::updateClusterMatrices");
+
+    if (!_needsUpdateClusterMatrices || !isLoaded()) {
+        return;
+    }
+    if (!_hasComputedClusterMatrices) {
+        computeClusterMatrices();
+    }
+    _needsUpdateClusterMatrices = false;
+    _hasComputedClusterMatrices = false;
+    const FBXGeometry& geometry = getFBXGeometry();
+
+    for (int i = 0; i < _meshStates.size(); i++) {
+        // Once computed the cluster matrices, update the buffer(s)
+        if (geometry.meshes.at(i).clusters.size() > 1) {
+            _meshStates[i].updateClusterBuffer();
+        }
+    }
+
+    if (!_cauterizeBoneSet.empty()) {
+        for (int i = 0; i < _cauterizeMeshStates.size(); i++) {
+            Model::MeshState& state = _cauterizeMeshStates[i];
+            if (state.clusterMatrices.size() > 1) {
+                state.updateClusterBuffer();
             }
         }
     }
@@ -38,6 +38,7 @@ public:
     void createCollisionRenderItemSet() override;
 
     virtual void updateClusterMatrices() override;
+    virtual void computeClusterMatrices() override;
     void updateRenderItems() override;
 
     const Model::MeshState& getCauterizeMeshState(int index) const;
@@ -65,13 +65,7 @@ void SoftAttachmentModel::updateClusterMatrices() {
 
         // Once computed the cluster matrices, update the buffer(s)
         if (mesh.clusters.size() > 1) {
-            if (!state.clusterBuffer) {
-                state.clusterBuffer = std::make_shared<gpu::Buffer>(state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                                    (const gpu::Byte*) state.clusterMatrices.constData());
-            } else {
-                state.clusterBuffer->setSubData(0, state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                (const gpu::Byte*) state.clusterMatrices.constData());
-            }
+            state.updateClusterBuffer();
         }
     }
 
@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <OctreePacketData.h>
 #include <PerfStat.h>
 
 #include "Application.h"
@@ -21,12 +22,19 @@ OctreePacketProcessor::OctreePacketProcessor() {
     
     packetReceiver.registerDirectListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
                                                   this, "handleOctreePacket");
+    packetReceiver.registerListener(PacketType::EntityCompressionDictionary, this, "handleCompressionDictionary");
 }
 
 void OctreePacketProcessor::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     queueReceivedPacket(message, senderNode);
 }
 
+void OctreePacketProcessor::handleCompressionDictionary(QSharedPointer<ReceivedMessage> message,
+                                                        SharedNodePointer senderNode) {
+    // our next query tells the server we have it, and it compresses what it sends us with it from then on
+    OctreePacketData::setCompressionDictionary(senderNode->getUUID(), message->getMessage());
+}
+
 void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     PerformanceWarning warn(Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings),
                             "OctreePacketProcessor::processPacket()");
@@ -52,7 +60,7 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         
         if (piggybackBytes) {
             // construct a new packet from the piggybacked one
-            auto buffer = std::unique_ptr<char[]>(new char[piggybackBytes]);
+            auto buffer = udt::PacketPool::allocate(piggybackBytes);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggybackBytes);
             
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggybackBytes, message->getSenderSockAddr());
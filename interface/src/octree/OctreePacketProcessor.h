@@ -30,5 +30,6 @@ protected:
 
 private slots:
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleCompressionDictionary(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 };
 #endif // hifi_OctreePacketProcessor_h
@@ -0,0 +1,487 @@
+//
+//  PickManager.cpp
+//  interface/src/raypick
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PickManager.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include <GeometryUtil.h>
+#include <GLMHelpers.h>
+#include <PerfStat.h>
+
+#include "Application.h"
+#include "avatar/Avatar.h"
+#include "avatar/AvatarManager.h"
+#include "avatar/MyAvatar.h"
+#include "ui/overlays/Base3DOverlay.h"
+
+static const float DEFAULT_PARABOLA_MAX_DISTANCE = 20.0f;
+static const float DEFAULT_PARABOLA_SPEED = 10.0f;
+static const glm::vec3 DEFAULT_PARABOLA_ACCELERATION { 0.0f, -9.8f, 0.0f };
+static const int NUM_PARABOLA_SEGMENTS = 16;
+
+QVariantMap PickManager::PickResult::toVariantMap() const {
+    QVariantMap searchRayMap;
+    searchRayMap["origin"] = vec3toVariant(searchRay.origin);
+    searchRayMap["direction"] = vec3toVariant(searchRay.direction);
+
+    QVariantMap result;
+    result["type"] = (int)type;
+    result["objectID"] = objectID;
+    result["distance"] = distance;
+    result["intersection"] = vec3toVariant(intersection);
+    result["surfaceNormal"] = vec3toVariant(surfaceNormal);
+    result["searchRay"] = searchRayMap;
+    if (!objectIDs.isEmpty()) {
+        QVariantList objectIDList;
+        for (const auto& id : objectIDs) {
+            objectIDList.push_back(id);
+        }
+        result["objectIDs"] = objectIDList;
+    }
+    return result;
+}
+
+unsigned int PickManager::createPick(unsigned int type, const QVariantMap& properties) {
+    if (type > ParabolaPick) {
+        return 0;
+    }
+
+    auto pick = std::make_shared<Pick>();
+    pick->type = (PickType)type;
+    pick->enabled = properties["enabled"].toBool();
+    if (properties.contains("filter")) {
+        pick->filter = properties["filter"].toUInt();
+    }
+    pick->maxDistance = properties["maxDistance"].toFloat();
+    pick->joint = properties["joint"].toString();
+    pick->position = properties.contains("position") ? vec3FromVariant(properties["position"]) : Vectors::ZERO;
+    pick->direction = properties.contains("direction") ? vec3FromVariant(properties["direction"]) : Vectors::FRONT;
+    if (glm::length(pick->direction) < EPSILON) {
+        return 0;
+    }
+    pick->direction = glm::normalize(pick->direction);
+
+    switch (pick->type) {
+        case SpherePick:
+            pick->radius = properties["radius"].toFloat();
+            if (pick->radius <= 0.0f) {
+                return 0;
+            }
+            break;
+
+        case ParabolaPick:
+            pick->speed = properties.contains("speed") ? properties["speed"].toFloat() : DEFAULT_PARABOLA_SPEED;
+            pick->acceleration = properties.contains("acceleration") ?
+                vec3FromVariant(properties["acceleration"]) : DEFAULT_PARABOLA_ACCELERATION;
+            if (pick->speed <= 0.0f) {
+                return 0;
+            }
+            if (pick->maxDistance <= 0.0f) {
+                pick->maxDistance = DEFAULT_PARABOLA_MAX_DISTANCE;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    unsigned int uid;
+    withWriteLock([&] {
+        uid = _nextUID++;
+        _picks[uid] = pick;
+    });
+    return uid;
+}
+
+void PickManager::removePick(unsigned int uid) {
+    withWriteLock([&] {
+        _picks.erase(uid);
+    });
+}
+
+void PickManager::enablePick(unsigned int uid) {
+    if (auto pick = findPick(uid)) {
+        pick->withWriteLock([&] {
+            pick->enabled = true;
+        });
+    }
+}
+
+void PickManager::disablePick(unsigned int uid) {
+    if (auto pick = findPick(uid)) {
+        pick->withWriteLock([&] {
+            pick->enabled = false;
+            pick->result = PickResult();
+        });
+    }
+}
+
+PickManager::PickResult PickManager::getPickResult(unsigned int uid) const {
+    PickResult result;
+    if (auto pick = findPick(uid)) {
+        pick->withReadLock([&] {
+            result = pick->result;
+        });
+    }
+    return result;
+}
+
+QVariantMap PickManager::getPrevPickResult(unsigned int uid) {
+    return getPickResult(uid).toVariantMap();
+}
+
+void PickManager::setPrecisionPicking(unsigned int uid, bool precisionPicking) {
+    if (auto pick = findPick(uid)) {
+        pick->withWriteLock([&] {
+            if (precisionPicking) {
+                pick->filter &= ~PickCoarse;
+            } else {
+                pick->filter |= PickCoarse;
+            }
+        });
+    }
+}
+
+void PickManager::setIgnoreItems(unsigned int uid, const QScriptValue& ignoreItems) {
+    QVector<QUuid> ids = qVectorQUuidFromScriptValue(ignoreItems);
+    if (auto pick = findPick(uid)) {
+        pick->withWriteLock([&] {
+            pick->entitiesToDiscard.clear();
+            pick->overlaysToDiscard.clear();
+            for (const auto& id : ids) {
+                pick->entitiesToDiscard.push_back(id);
+                pick->overlaysToDiscard.push_back(id);
+            }
+        });
+    }
+}
+
+void PickManager::setIncludeItems(unsigned int uid, const QScriptValue& includeItems) {
+    QVector<QUuid> ids = qVectorQUuidFromScriptValue(includeItems);
+    if (auto pick = findPick(uid)) {
+        pick->withWriteLock([&] {
+            pick->entitiesToInclude.clear();
+            pick->overlaysToInclude.clear();
+            for (const auto& id : ids) {
+                pick->entitiesToInclude.push_back(id);
+                pick->overlaysToInclude.push_back(id);
+            }
+        });
+    }
+}
+
+PickManager::PickPointer PickManager::findPick(unsigned int uid) const {
+    PickPointer pick;
+    withReadLock([&] {
+        auto it = _picks.find(uid);
+        if (it != _picks.end()) {
+            pick = it->second;
+        }
+    });
+    return pick;
+}
+
+void PickManager::update() {
+    PerformanceTimer perfTimer("picks");
+
+    std::vector<PickPointer> picks;
+    withReadLock([&] {
+        picks.reserve(_picks.size());
+        for (const auto& pick : _picks) {
+            picks.push_back(pick.second);
+        }
+    });
+
+    std::vector<Query> queries;
+    queries.reserve(picks.size());
+    for (const auto& pick : picks) {
+        pick->withReadLock([&] {
+            if (!pick->enabled) {
+                return;
+            }
+            Query query;
+            query.pick = pick;
+            query.type = pick->type;
+            query.filter = pick->filter;
+            query.radius = pick->radius;
+            query.entitiesToInclude = pick->entitiesToInclude;
+            query.entitiesToDiscard = pick->entitiesToDiscard;
+            query.overlaysToInclude = pick->overlaysToInclude;
+            query.overlaysToDiscard = pick->overlaysToDiscard;
+            query.hasSearchRay = computeSearchRay(*pick, query.searchRay);
+            if (query.hasSearchRay) {
+                computeSegments(*pick, query);
+            }
+            query.result.searchRay = query.searchRay;
+            query.result.distance = FLT_MAX;
+            queries.push_back(std::move(query));
+        });
+    }
+    if (queries.empty()) {
+        return;
+    }
+
+    evaluateEntities(queries);
+    evaluateOverlays(queries);
+    evaluateAvatars(queries);
+
+    for (auto& query : queries) {
+        if (query.result.type == IntersectedNone) {
+            query.result.distance = 0.0f;
+        }
+        query.pick->withWriteLock([&] {
+            if (query.pick->enabled) {
+                query.pick->result = query.result;
+            }
+        });
+    }
+}
+
+bool PickManager::computeSearchRay(const Pick& pick, PickRay& searchRay) const {
+    glm::vec3 jointPosition;
+    glm::quat jointRotation;
+
+    if (pick.joint.isEmpty()) {
+        searchRay = PickRay(pick.position, pick.direction);
+        return true;
+    }
+
+    if (pick.joint == "Mouse") {
+        glm::vec2 reticlePosition = qApp->getApplicationCompositor().getReticlePosition();
+        searchRay = qApp->computePickRay(reticlePosition.x, reticlePosition.y);
+        searchRay.direction = glm::normalize(searchRay.direction);
+        return true;
+    }
+
+    if (pick.joint == "_CAMERA") {
+        jointPosition = qApp->getCamera()->getPosition();
+        jointRotation = qApp->getCamera()->getOrientation();
+    } else {
+        auto myAvatar = DependencyManager::get<AvatarManager>()->getMyAvatar();
+        if (pick.joint == "_CONTROLLER_LEFTHAND" || pick.joint == "_CONTROLLER_RIGHTHAND") {
+            controller::Pose pose = (pick.joint == "_CONTROLLER_LEFTHAND") ?
+                myAvatar->getLeftHandControllerPoseInWorldFrame() : myAvatar->getRightHandControllerPoseInWorldFrame();
+            if (!pose.isValid()) {
+                return false;
+            }
+            jointPosition = pose.getTranslation();
+            jointRotation = pose.getRotation();
+        } else {
+            int jointIndex = myAvatar->getJointIndex(pick.joint);
+            if (jointIndex < 0) {
+                return false;
+            }
+            jointPosition = myAvatar->getJointPosition(jointIndex);
+            jointRotation = myAvatar->getOrientation() * myAvatar->getAbsoluteJointRotationInObjectFrame(jointIndex);
+        }
+    }
+
+    searchRay = PickRay(jointPosition + jointRotation * pick.position, jointRotation * pick.direction);
+    return true;
+}
+
+void PickManager::computeSegments(const Pick& pick, Query& query) const {
+    float maxDistance = pick.maxDistance > 0.0f ? pick.maxDistance : FLT_MAX;
+
+    if (pick.type == RayPick) {
+        query.segments.push_back({ query.searchRay, maxDistance, 0.0f });
+
+    } else if (pick.type == ParabolaPick) {
+        // steps of the time it takes the start of the parabola to go the whole distance, which the rest of it
+        // may not (the last segment is shortened to end there)
+        glm::vec3 velocity = query.searchRay.direction * pick.speed;
+        float timeStep = maxDistance / (pick.speed * NUM_PARABOLA_SEGMENTS);
+        glm::vec3 start = query.searchRay.origin;
+        float startDistance = 0.0f;
+        for (int i = 1; i <= NUM_PARABOLA_SEGMENTS && startDistance < maxDistance; ++i) {
+            float time = timeStep * i;
+            glm::vec3 end = query.searchRay.origin + velocity * time + 0.5f * pick.acceleration * time * time;
+            float length = glm::distance(start, end);
+            if (length > EPSILON) {
+                length = std::min(length, maxDistance - startDistance);
+                query.segments.push_back({ PickRay(start, glm::normalize(end - start)), length, startDistance });
+                startDistance += length;
+            }
+            start = end;
+        }
+    }
+}
+
+void PickManager::evaluateEntities(std::vector<Query>& queries) const {
+    auto entityTree = qApp->getEntities()->getTree();
+    if (!entityTree) {
+        return;
+    }
+
+    // the tree is locked the once for all of the picks; the lock is recursive, so the finds just count it
+    QVector<EntityItemPointer> foundEntities;
+    entityTree->withReadLock([&] {
+        for (auto& query : queries) {
+            if (!query.hasSearchRay || !(query.filter & PickEntities)) {
+                continue;
+            }
+            bool visibleOnly = !(query.filter & PickIncludeInvisible);
+            bool collidableOnly = !(query.filter & PickIncludeNoncollidable);
+
+            if (query.type == SpherePick) {
+                entityTree->findEntities(query.searchRay.origin, query.radius, foundEntities);
+                for (const auto& entity : foundEntities) {
+                    const EntityItemID& id = entity->getEntityItemID();
+                    if ((!query.entitiesToInclude.isEmpty() && !query.entitiesToInclude.contains(id)) ||
+                            query.entitiesToDiscard.contains(id) || (visibleOnly && !entity->getVisible()) ||
+                            (collidableOnly && entity->getCollisionless())) {
+                        continue;
+                    }
+                    float distance = glm::distance(query.searchRay.origin, entity->getPosition());
+                    query.result.objectIDs.push_back(id);
+                    if (distance < query.result.distance) {
+                        query.result.type = IntersectedEntity;
+                        query.result.objectID = id;
+                        query.result.distance = distance;
+                        query.result.intersection = entity->getPosition();
+                    }
+                }
+                continue;
+            }
+
+            for (const auto& segment : query.segments) {
+                if (segment.startDistance >= query.result.distance) {
+                    break;
+                }
+                OctreeElementPointer element;
+                EntityItemPointer entity;
+                float distance;
+                BoxFace face;
+                glm::vec3 surfaceNormal;
+                if (entityTree->findRayIntersection(segment.ray.origin, segment.ray.direction,
+                        query.entitiesToInclude, query.entitiesToDiscard, visibleOnly, collidableOnly,
+                        !(query.filter & PickCoarse), element, distance, face, surfaceNormal,
+                        (void**)&entity, Octree::Lock) && entity && distance <= segment.length) {
+                    query.result.type = IntersectedEntity;
+                    query.result.objectID = entity->getEntityItemID();
+                    query.result.distance = segment.startDistance + distance;
+                    query.result.intersection = segment.ray.origin + segment.ray.direction * distance;
+                    query.result.surfaceNormal = surfaceNormal;
+                    break;
+                }
+            }
+        }
+    });
+}
+
+void PickManager::evaluateOverlays(std::vector<Query>& queries) const {
+    Overlays& overlays = qApp->getOverlays();
+
+    for (auto& query : queries) {
+        if (!query.hasSearchRay || !(query.filter & PickOverlays)) {
+            continue;
+        }
+        bool visibleOnly = !(query.filter & PickIncludeInvisible);
+        bool collidableOnly = !(query.filter & PickIncludeNoncollidable);
+
+        if (query.type == SpherePick) {
+            for (const auto& id : overlays.findOverlays(query.searchRay.origin, query.radius)) {
+                if ((!query.overlaysToInclude.isEmpty() && !query.overlaysToInclude.contains(id)) ||
+                        query.overlaysToDiscard.contains(id)) {
+                    continue;
+                }
+                query.result.objectIDs.push_back(id);
+                auto overlay = std::dynamic_pointer_cast<Base3DOverlay>(overlays.getOverlay(id));
+                if (!overlay) {
+                    continue;
+                }
+                float distance = glm::distance(query.searchRay.origin, overlay->getPosition());
+                if (distance < query.result.distance) {
+                    query.result.type = IntersectedOverlay;
+                    query.result.objectID = id;
+                    query.result.distance = distance;
+                    query.result.intersection = overlay->getPosition();
+                }
+            }
+            continue;
+        }
+
+        for (const auto& segment : query.segments) {
+            if (segment.startDistance >= query.result.distance) {
+                break;
+            }
+            RayToOverlayIntersectionResult result = overlays.findRayIntersectionInternal(segment.ray,
+                !(query.filter & PickCoarse), query.overlaysToInclude, query.overlaysToDiscard, visibleOnly, collidableOnly);
+            if (result.intersects && result.distance <= segment.length &&
+                    segment.startDistance + result.distance < query.result.distance) {
+                query.result.type = IntersectedOverlay;
+                query.result.objectID = result.overlayID;
+                query.result.distance = segment.startDistance + result.distance;
+                query.result.intersection = result.intersection;
+                query.result.surfaceNormal = result.surfaceNormal;
+                break;
+            }
+        }
+    }
+}
+
+void PickManager::evaluateAvatars(std::vector<Query>& queries) const {
+    auto avatarManager = DependencyManager::get<AvatarManager>();
+
+    for (auto& query : queries) {
+        if (!query.hasSearchRay || !(query.filter & PickAvatars)) {
+            continue;
+        }
+
+        if (query.type == SpherePick) {
+            auto avatarHash = avatarManager->getHashSnapshot();
+            for (const auto& avatarData : *avatarHash) {
+                auto avatar = std::static_pointer_cast<Avatar>(avatarData);
+                QUuid id = avatar->getID();
+                if ((!query.entitiesToInclude.isEmpty() && !query.entitiesToInclude.contains(id)) ||
+                        query.entitiesToDiscard.contains(id)) {
+                    continue;
+                }
+                glm::vec3 start;
+                glm::vec3 end;
+                float radius;
+                avatar->getCapsule(start, end, radius);
+                glm::vec3 toCapsule = computeVectorFromPointToSegment(query.searchRay.origin, start, end);
+                float distance = glm::length(toCapsule) - radius;
+                if (distance > query.radius) {
+                    continue;
+                }
+                query.result.objectIDs.push_back(id);
+                distance = std::max(distance, 0.0f);
+                if (distance < query.result.distance) {
+                    query.result.type = IntersectedAvatar;
+                    query.result.objectID = id;
+                    query.result.distance = distance;
+                    query.result.intersection = avatar->getPosition();
+                }
+            }
+            continue;
+        }
+
+        for (const auto& segment : query.segments) {
+            if (segment.startDistance >= query.result.distance) {
+                break;
+            }
+            RayToAvatarIntersectionResult result = avatarManager->findRayIntersectionVector(segment.ray,
+                query.entitiesToInclude, query.entitiesToDiscard);
+            if (result.intersects && result.distance <= segment.length &&
+                    segment.startDistance + result.distance < query.result.distance) {
+                query.result.type = IntersectedAvatar;
+                query.result.objectID = result.avatarID;
+                query.result.distance = segment.startDistance + result.distance;
+                query.result.intersection = result.intersection;
+                query.result.surfaceNormal = glm::vec3();
+                break;
+            }
+        }
+    }
+}
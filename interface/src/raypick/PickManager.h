@@ -0,0 +1,219 @@
+//
+//  PickManager.h
+//  interface/src/raypick
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PickManager_h
+#define hifi_PickManager_h
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QUuid>
+#include <QtCore/QVariant>
+#include <QtScript/QScriptValue>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <DependencyManager.h>
+#include <EntityItemID.h>
+#include <RegisteredMetaTypes.h>
+#include <shared/ReadWriteLockable.h>
+
+#include "ui/overlays/Overlay.h"
+
+/**jsdoc
+ * The picks of the scripts and the controllers, that are evaluated together once a frame, so that a script reads
+ * the last result of its picks rather than waiting on the entity tree for a ray cast of its own.
+ *
+ * @namespace Picks
+ */
+
+// The persistent picks of the scripts and the controllers
+//   A pick is a ray, a sphere or a parabola, from a fixed place or from the mouse, a hand controller or a joint of
+//   the avatar, and a filter of what it hits. The enabled picks are evaluated on the main thread during the update,
+//   each kind of object for all of the picks at once (the entity tree is locked the once), and their results are
+//   kept for any thread to read without waiting on the evaluation.
+class PickManager : public QObject, public Dependency, protected ReadWriteLockable {
+    Q_OBJECT
+    SINGLETON_DEPENDENCY
+
+    Q_PROPERTY(unsigned int PICK_RAY READ PICK_RAY CONSTANT)
+    Q_PROPERTY(unsigned int PICK_SPHERE READ PICK_SPHERE CONSTANT)
+    Q_PROPERTY(unsigned int PICK_PARABOLA READ PICK_PARABOLA CONSTANT)
+
+    Q_PROPERTY(unsigned int PICK_NOTHING READ PICK_NOTHING CONSTANT)
+    Q_PROPERTY(unsigned int PICK_ENTITIES READ PICK_ENTITIES CONSTANT)
+    Q_PROPERTY(unsigned int PICK_OVERLAYS READ PICK_OVERLAYS CONSTANT)
+    Q_PROPERTY(unsigned int PICK_AVATARS READ PICK_AVATARS CONSTANT)
+    Q_PROPERTY(unsigned int PICK_INCLUDE_INVISIBLE READ PICK_INCLUDE_INVISIBLE CONSTANT)
+    Q_PROPERTY(unsigned int PICK_INCLUDE_NONCOLLIDABLE READ PICK_INCLUDE_NONCOLLIDABLE CONSTANT)
+    Q_PROPERTY(unsigned int PICK_COARSE READ PICK_COARSE CONSTANT)
+
+    Q_PROPERTY(unsigned int INTERSECTED_NONE READ INTERSECTED_NONE CONSTANT)
+    Q_PROPERTY(unsigned int INTERSECTED_ENTITY READ INTERSECTED_ENTITY CONSTANT)
+    Q_PROPERTY(unsigned int INTERSECTED_OVERLAY READ INTERSECTED_OVERLAY CONSTANT)
+    Q_PROPERTY(unsigned int INTERSECTED_AVATAR READ INTERSECTED_AVATAR CONSTANT)
+
+public:
+    enum PickType {
+        RayPick = 0,
+        SpherePick,
+        ParabolaPick
+    };
+
+    enum FilterFlags {
+        PickNothing = 0,
+        PickEntities = 1 << 0,
+        PickOverlays = 1 << 1,
+        PickAvatars = 1 << 2,
+        PickIncludeInvisible = 1 << 3,
+        PickIncludeNoncollidable = 1 << 4,
+        PickCoarse = 1 << 5 // the bounds of the models rather than their triangles
+    };
+
+    enum IntersectionType {
+        IntersectedNone = 0,
+        IntersectedEntity,
+        IntersectedOverlay,
+        IntersectedAvatar
+    };
+
+    struct PickResult {
+        IntersectionType type { IntersectedNone };
+        QUuid objectID;
+        float distance { 0.0f }; // along the path of the pick, from its start
+        glm::vec3 intersection;
+        glm::vec3 surfaceNormal;
+        PickRay searchRay; // where the pick started, and in which direction
+        QVector<QUuid> objectIDs; // everything a sphere touches
+
+        QVariantMap toVariantMap() const;
+    };
+
+    // evaluate the enabled picks, called once a frame from the main thread's update
+    void update();
+
+    // the picks of the C++ controllers, without the conversions of the script interface (can be called from any thread)
+    PickResult getPickResult(unsigned int uid) const;
+
+    unsigned int PICK_RAY() const { return RayPick; }
+    unsigned int PICK_SPHERE() const { return SpherePick; }
+    unsigned int PICK_PARABOLA() const { return ParabolaPick; }
+
+    unsigned int PICK_NOTHING() const { return PickNothing; }
+    unsigned int PICK_ENTITIES() const { return PickEntities; }
+    unsigned int PICK_OVERLAYS() const { return PickOverlays; }
+    unsigned int PICK_AVATARS() const { return PickAvatars; }
+    unsigned int PICK_INCLUDE_INVISIBLE() const { return PickIncludeInvisible; }
+    unsigned int PICK_INCLUDE_NONCOLLIDABLE() const { return PickIncludeNoncollidable; }
+    unsigned int PICK_COARSE() const { return PickCoarse; }
+
+    unsigned int INTERSECTED_NONE() const { return IntersectedNone; }
+    unsigned int INTERSECTED_ENTITY() const { return IntersectedEntity; }
+    unsigned int INTERSECTED_OVERLAY() const { return IntersectedOverlay; }
+    unsigned int INTERSECTED_AVATAR() const { return IntersectedAvatar; }
+
+    /**jsdoc
+     * Create a pick, that is evaluated once a frame while it's enabled.
+     *
+     * @function Picks.createPick
+     * @param {Picks.PickType} type PICK_RAY, PICK_SPHERE or PICK_PARABOLA.
+     * @param {object} properties
+     * @param {string} [properties.joint] "Mouse", "_CONTROLLER_LEFTHAND", "_CONTROLLER_RIGHTHAND", "_CAMERA" or the
+     *     name of a joint of the avatar; without one the pick stays where position and direction put it.
+     * @param {Vec3} [properties.position] The start of the pick, in the frame of the joint when there's one.
+     * @param {Vec3} [properties.direction] The direction of the pick, in the frame of the joint when there's one.
+     * @param {number} [properties.filter] The PICK_ flags of what the pick hits.
+     * @param {number} [properties.maxDistance] How far the pick reaches, along its path.
+     * @param {number} [properties.radius] The radius of a sphere pick.
+     * @param {number} [properties.speed] The initial speed of a parabola pick.
+     * @param {Vec3} [properties.acceleration] The acceleration of a parabola pick, gravity if not given.
+     * @param {boolean} [properties.enabled=false]
+     * @returns {number} The ID of the pick, 0 if the properties are invalid.
+     */
+    Q_INVOKABLE unsigned int createPick(unsigned int type, const QVariantMap& properties);
+    Q_INVOKABLE void removePick(unsigned int uid);
+    Q_INVOKABLE void enablePick(unsigned int uid);
+    Q_INVOKABLE void disablePick(unsigned int uid);
+
+    /**jsdoc
+     * The result of the last evaluation of the pick, without waiting for the next one.
+     *
+     * @function Picks.getPrevPickResult
+     * @param {number} uid
+     * @returns {object} type, objectID, distance, intersection, surfaceNormal, searchRay and, for a sphere, objectIDs.
+     */
+    Q_INVOKABLE QVariantMap getPrevPickResult(unsigned int uid);
+
+    Q_INVOKABLE void setPrecisionPicking(unsigned int uid, bool precisionPicking);
+    Q_INVOKABLE void setIgnoreItems(unsigned int uid, const QScriptValue& ignoreItems);
+    Q_INVOKABLE void setIncludeItems(unsigned int uid, const QScriptValue& includeItems);
+
+private:
+    // the path of a ray or parabola pick, in straight segments
+    struct Segment {
+        PickRay ray; // with a unit direction
+        float length;
+        float startDistance; // along the whole path
+    };
+
+    struct Pick : public ReadWriteLockable {
+        PickType type;
+        bool enabled { false };
+        unsigned int filter { PickEntities | PickOverlays | PickAvatars };
+        float maxDistance { 0.0f };
+        float radius { 0.0f };
+        float speed { 0.0f };
+        glm::vec3 acceleration;
+
+        QString joint;
+        glm::vec3 position;
+        glm::vec3 direction;
+
+        QVector<EntityItemID> entitiesToInclude;
+        QVector<EntityItemID> entitiesToDiscard;
+        QVector<OverlayID> overlaysToInclude;
+        QVector<OverlayID> overlaysToDiscard;
+
+        PickResult result;
+    };
+    using PickPointer = std::shared_ptr<Pick>;
+
+    // what one pick is looking for this frame, copied out of the pick so that its lock isn't held while evaluating
+    struct Query {
+        PickPointer pick;
+        PickType type;
+        unsigned int filter;
+        bool hasSearchRay; // false if the joint it starts from isn't there
+        PickRay searchRay;
+        float radius;
+        std::vector<Segment> segments;
+        QVector<EntityItemID> entitiesToInclude;
+        QVector<EntityItemID> entitiesToDiscard;
+        QVector<OverlayID> overlaysToInclude;
+        QVector<OverlayID> overlaysToDiscard;
+        PickResult result;
+    };
+
+    PickPointer findPick(unsigned int uid) const;
+    bool computeSearchRay(const Pick& pick, PickRay& searchRay) const;
+    void computeSegments(const Pick& pick, Query& query) const;
+
+    void evaluateEntities(std::vector<Query>& queries) const;
+    void evaluateOverlays(std::vector<Query>& queries) const;
+    void evaluateAvatars(std::vector<Query>& queries) const;
+
+    std::unordered_map<unsigned int, PickPointer> _picks;
+    unsigned int _nextUID { 1 }; // 0 is no pick
+};
+
+#endif // hifi_PickManager_h
@@ -97,6 +97,32 @@ bool TestScriptingInterface::stopTracing(QString filename) {
     return true;
 }
 
+bool TestScriptingInterface::startFlightRecording(float seconds, QString logrules) {
+    if (!logrules.isEmpty()) {
+        QLoggingCategory::setFilterRules(logrules);
+    }
+
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    DependencyManager::get<tracing::Tracer>()->startFlightRecording(seconds);
+    return true;
+}
+
+bool TestScriptingInterface::dumpFlightRecording(QString filename) {
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (!tracer->isFlightRecording()) {
+        return false;
+    }
+    tracer->serialize(filename);
+    return true;
+}
+
 void TestScriptingInterface::clear() {
     qApp->postLambdaEvent([] {
         qApp->getEntities()->clear();
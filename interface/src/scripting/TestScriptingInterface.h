@@ -67,6 +67,18 @@ public slots:
     */
     bool stopTracing(QString filename);
 
+    /**jsdoc
+    * Keep recording Chrome compatible tracing events, only those of the last seconds, until tracing stops
+    * logRules can be used to specify a set of logging category rules to limit what gets captured
+    */
+    bool startFlightRecording(float seconds, QString logrules = "");
+
+    /**jsdoc
+    * Serialize the events of the last seconds of the flight recording to a file, which carries on recording
+    * Using a filename with a .gz extension will automatically compress the output file
+    */
+    bool dumpFlightRecording(QString filename);
+
     void startTraceEvent(QString name);
 
     void endTraceEvent(QString name);
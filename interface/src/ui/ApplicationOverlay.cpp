@@ -63,6 +63,20 @@ void ApplicationOverlay::renderOverlay(RenderArgs* renderArgs) {
         return; // we can't do anything without our frame buffer.
     }
 
+    // The overlay is only drawn again when the UI has a new texture, or when it has content that's drawn from the
+    // state of the application, so that an idle UI costs the frame nothing
+    bool newUiTexture = updateUiTexture();
+    auto nodeList = DependencyManager::get<NodeList>();
+    bool domainConnected = nodeList && nodeList->getDomainHandler().isConnected();
+    bool hasLiveContent = qApp->getOverlays().hasHUDOverlays() || DependencyManager::get<AudioScope>()->getVisible();
+    auto overlayTexture = getOverlayTexture();
+    if (!newUiTexture && !hasLiveContent && overlayTexture == _renderedOverlayTexture &&
+        domainConnected == _renderedDomainConnected) {
+        return;
+    }
+    _renderedOverlayTexture = overlayTexture;
+    _renderedDomainConnected = domainConnected;
+
     // Execute the batch into our framebuffer
     doInBatch(renderArgs->_context, [&](gpu::Batch& batch) {
         PROFILE_RANGE_BATCH(batch, "ApplicationOverlayRender");
@@ -91,9 +105,7 @@ void ApplicationOverlay::renderOverlay(RenderArgs* renderArgs) {
     renderArgs->_batch = nullptr; // so future users of renderArgs don't try to use our batch
 }
 
-void ApplicationOverlay::renderQmlUi(RenderArgs* renderArgs) {
-    PROFILE_RANGE(app, __FUNCTION__);
-
+bool ApplicationOverlay::updateUiTexture() {
     if (!_uiTexture) {
         _uiTexture = gpu::TexturePointer(gpu::Texture::createExternal(OffscreenQmlSurface::getDiscardLambda()));
         _uiTexture->setSource(__FUNCTION__);
@@ -109,6 +121,12 @@ void ApplicationOverlay::renderQmlUi(RenderArgs* renderArgs) {
     if (newTextureAvailable) {
         _uiTexture->setExternalTexture(newTextureAndFence.first, newTextureAndFence.second);
     }
+    return newTextureAvailable;
+}
+
+void ApplicationOverlay::renderQmlUi(RenderArgs* renderArgs) {
+    PROFILE_RANGE(app, __FUNCTION__);
+
     auto geometryCache = DependencyManager::get<GeometryCache>();
     gpu::Batch& batch = *renderArgs->_batch;
     geometryCache->useSimpleDrawPipeline(batch);
@@ -35,6 +35,7 @@ private:
     void renderAudioScope(RenderArgs* renderArgs);
     void renderOverlays(RenderArgs* renderArgs);
     void buildFramebufferObject();
+    bool updateUiTexture();
 
     float _alpha{ 1.0f };
     float _trailingAudioLoudness{ 0.0f };
@@ -49,6 +50,10 @@ private:
     gpu::TexturePointer _overlayColorTexture;
     gpu::FramebufferPointer _overlayFramebuffer;
     int _qmlGeometryId { 0 };
+
+    // what the overlay was last drawn with, to draw it again only when it can have changed
+    gpu::TexturePointer _renderedOverlayTexture;
+    bool _renderedDomainConnected { false };
 };
 
 #endif // hifi_ApplicationOverlay_h
@@ -149,6 +149,14 @@ void Stats::updateStats(bool force) {
     }
     STAT_UPDATE(simrate, (int)qApp->getAverageSimsPerSecond());
     STAT_UPDATE(avatarSimrate, (int)qApp->getAvatarSimrate());
+    const PhysicsStats& physicsStats = qApp->getPhysicsStats();
+    STAT_UPDATE_FLOAT(physicsStepTime, (float)physicsStats.stepTime / (float)USECS_PER_MSEC, 0.01f);
+    STAT_UPDATE(physicsBodies, (int)physicsStats.numBodies);
+    STAT_UPDATE(physicsActiveBodies, (int)physicsStats.numActiveBodies);
+    STAT_UPDATE(physicsOwnedBodies, (int)physicsStats.numOwnedBodies);
+    STAT_UPDATE(physicsIslands, (int)physicsStats.numIslands);
+    STAT_UPDATE(physicsPairs, (int)physicsStats.numOverlappingPairs);
+    STAT_UPDATE(physicsContacts, (int)physicsStats.numContacts);
 
     auto bandwidthRecorder = DependencyManager::get<BandwidthRecorder>();
     STAT_UPDATE(packetInCount, bandwidthRecorder->getCachedTotalAverageInputPacketsPerSecond());
@@ -48,6 +48,13 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, presentdroprate, 0)
     STATS_PROPERTY(int, simrate, 0)
     STATS_PROPERTY(int, avatarSimrate, 0)
+    STATS_PROPERTY(float, physicsStepTime, 0)
+    STATS_PROPERTY(int, physicsBodies, 0)
+    STATS_PROPERTY(int, physicsActiveBodies, 0)
+    STATS_PROPERTY(int, physicsOwnedBodies, 0)
+    STATS_PROPERTY(int, physicsIslands, 0)
+    STATS_PROPERTY(int, physicsPairs, 0)
+    STATS_PROPERTY(int, physicsContacts, 0)
     STATS_PROPERTY(int, avatarCount, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
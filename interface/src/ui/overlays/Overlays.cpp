@@ -126,6 +126,11 @@ void Overlays::renderHUD(RenderArgs* renderArgs) {
     }
 }
 
+bool Overlays::hasHUDOverlays() {
+    QReadLocker lock(&_lock);
+    return !_overlaysHUD.isEmpty();
+}
+
 void Overlays::disable() {
     QWriteLocker lock(&_lock);
     _enabled = false;
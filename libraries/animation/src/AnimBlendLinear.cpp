@@ -9,6 +9,10 @@
 //
 
 #include "AnimBlendLinear.h"
+
+#include <PerfStat.h>
+#include <Profile.h>
+
 #include "GLMHelpers.h"
 #include "AnimationLogging.h"
 #include "AnimUtil.h"
@@ -25,6 +29,8 @@ AnimBlendLinear::~AnimBlendLinear() {
 }
 
 const AnimPoseVec& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+    PROFILE_RANGE(simulation_animation_detail, _id);
+    PerformanceTimer perfTimer(_id);
 
     _alpha = animVars.lookup(_alphaVar, _alpha);
 
@@ -9,6 +9,10 @@
 //
 
 #include "AnimBlendLinearMove.h"
+
+#include <PerfStat.h>
+#include <Profile.h>
+
 #include <GLMHelpers.h>
 #include "AnimationLogging.h"
 #include "AnimUtil.h"
@@ -27,6 +31,8 @@ AnimBlendLinearMove::~AnimBlendLinearMove() {
 }
 
 const AnimPoseVec& AnimBlendLinearMove::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+    PROFILE_RANGE(simulation_animation_detail, _id);
+    PerformanceTimer perfTimer(_id);
 
     assert(_children.size() == _characteristicSpeeds.size());
 
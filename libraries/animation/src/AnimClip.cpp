@@ -8,6 +8,13 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include <PerfStat.h>
+#include <Profile.h>
+
 #include "GLMHelpers.h"
 #include "AnimClip.h"
 #include "AnimationLogging.h"
@@ -15,6 +22,71 @@
 
 bool AnimClip::usePreAndPostPoseFromAnim = true;
 
+// the clips of every graph are shared by url, skeleton, mirroring and the pre and post rotation mode they were built in
+using AnimClipDataKey = std::tuple<QString, const AnimSkeleton*, bool, bool>;
+static std::mutex animClipDataMutex;
+static std::map<AnimClipDataKey, std::weak_ptr<const AnimClipData>> animClipDataCache;
+
+static AnimClipData::Pointer findAnimClipData(const AnimClipDataKey& key) {
+    std::lock_guard<std::mutex> lock(animClipDataMutex);
+    auto itr = animClipDataCache.find(key);
+    return itr != animClipDataCache.end() ? itr->second.lock() : AnimClipData::Pointer();
+}
+
+static void addAnimClipData(const AnimClipDataKey& key, AnimClipData::Pointer animClipData) {
+    std::lock_guard<std::mutex> lock(animClipDataMutex);
+    for (auto itr = animClipDataCache.begin(); itr != animClipDataCache.end();) {
+        if (itr->second.expired()) {
+            itr = animClipDataCache.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    animClipDataCache[key] = animClipData;
+}
+
+AnimClipData::AnimClipData(AnimSkeleton::ConstPointer skeleton, const std::vector<AnimPoseVec>& anim) :
+    _skeleton(skeleton),
+    _numFrames((int)anim.size())
+{
+    assert(_numFrames > 0);
+    const AnimPoseVec& firstFrame = anim[0];
+    _constantPoses = firstFrame;
+
+    // a joint is animated if it moves away from where it starts by more than the noise of the exporters
+    const float EPSILON = 1.0e-5f;
+    for (int joint = 0; joint < (int)firstFrame.size(); joint++) {
+        const AnimPose& firstPose = firstFrame[joint];
+        for (int frame = 1; frame < _numFrames; frame++) {
+            const AnimPose& pose = anim[frame][joint];
+            if (glm::any(glm::greaterThan(glm::abs(pose.trans() - firstPose.trans()), glm::vec3(EPSILON))) ||
+                glm::any(glm::greaterThan(glm::abs(pose.scale() - firstPose.scale()), glm::vec3(EPSILON))) ||
+                fabsf(glm::dot(pose.rot(), firstPose.rot())) < 1.0f - EPSILON) {
+                _animatedJoints.push_back(joint);
+                break;
+            }
+        }
+    }
+
+    _frames.reserve(_numFrames * _animatedJoints.size());
+    for (int frame = 0; frame < _numFrames; frame++) {
+        for (int joint : _animatedJoints) {
+            _frames.push_back(anim[frame][joint]);
+        }
+    }
+}
+
+std::vector<AnimPoseVec> AnimClipData::decompress() const {
+    std::vector<AnimPoseVec> anim(_numFrames, _constantPoses);
+    for (int frame = 0; frame < _numFrames; frame++) {
+        const AnimPose* animatedPoses = getFrame(frame);
+        for (size_t i = 0; i < _animatedJoints.size(); i++) {
+            anim[frame][_animatedJoints[i]] = animatedPoses[i];
+        }
+    }
+    return anim;
+}
+
 AnimClip::AnimClip(const QString& id, const QString& url, float startFrame, float endFrame, float timeScale, bool loopFlag, bool mirrorFlag) :
     AnimNode(AnimNode::Type::Clip, id),
     _startFrame(startFrame),
@@ -32,6 +104,8 @@ AnimClip::~AnimClip() {
 }
 
 const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+    PROFILE_RANGE(simulation_animation_detail, _id);
+    PerformanceTimer perfTimer(_id);
 
     // lookup parameters from animVars, using current instance variables as defaults.
     _startFrame = animVars.lookup(_startFrameVar, _startFrame);
@@ -50,12 +124,19 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
         _networkAnim.reset();
     }
 
-    if (_anim.size()) {
+    if (_anim) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorAnim) {
             buildMirrorAnim();
         }
+        const AnimClipData& anim = _mirrorFlag ? *_mirrorAnim : *_anim;
+
+        // the joints that hold still are posed once, when the animation starts or is mirrored
+        if (_posedAnim != &anim) {
+            _poses = anim.getConstantPoses();
+            _posedAnim = &anim;
+        }
 
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex;
@@ -67,15 +148,19 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = anim.getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
-        float alpha = glm::fract(_frame);
-
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        const std::vector<int>& animatedJoints = anim.getAnimatedJoints();
+        if (!animatedJoints.empty()) {
+            float alpha = glm::fract(_frame);
+            _animatedPoses.resize(animatedJoints.size());
+            ::blend(animatedJoints.size(), anim.getFrame(prevIndex), anim.getFrame(nextIndex), alpha, &_animatedPoses[0]);
+            for (size_t i = 0; i < animatedJoints.size(); i++) {
+                _poses[animatedJoints[i]] = _animatedPoses[i];
+            }
+        }
     }
 
     return _poses;
@@ -96,14 +181,25 @@ void AnimClip::setCurrentFrameInternal(float frame) {
 
 void AnimClip::copyFromNetworkAnim() {
     assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
+    _anim.reset();
+    _mirrorAnim.reset();
+    _posedAnim = nullptr;
+
+    const auto skeletonJointCount = _skeleton->getNumJoints();
+    _poses.resize(skeletonJointCount);
+
+    // another clip of the graph may already have this animation on this skeleton
+    AnimClipDataKey key(_url, _skeleton.get(), false, usePreAndPostPoseFromAnim);
+    _anim = findAnimClipData(key);
+    if (_anim) {
+        return;
+    }
 
     // build a mapping from animation joint indices to skeleton joint indices.
     // by matching joints with the same name.
     const FBXGeometry& geom = _networkAnim->getGeometry();
     AnimSkeleton animSkeleton(geom);
     const auto animJointCount = animSkeleton.getNumJoints();
-    const auto skeletonJointCount = _skeleton->getNumJoints();
     std::vector<int> jointMap;
     jointMap.reserve(animJointCount);
     for (int i = 0; i < animJointCount; i++) {
@@ -115,7 +211,11 @@ void AnimClip::copyFromNetworkAnim() {
     }
 
     const int frameCount = geom.animationFrames.size();
-    _anim.resize(frameCount);
+    if (frameCount == 0) {
+        return;
+    }
+    // _anim[frame][joint], until it is compressed
+    std::vector<AnimPoseVec> anim(frameCount);
 
     for (int frame = 0; frame < frameCount; frame++) {
 
@@ -123,10 +223,7 @@ void AnimClip::copyFromNetworkAnim() {
 
         // init all joints in animation to default pose
         // this will give us a resonable result for bones in the model skeleton but not in the animation.
-        _anim[frame].reserve(skeletonJointCount);
-        for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
-            _anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
-        }
+        anim[frame] = _skeleton->getRelativeDefaultPoses();
 
         for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
             int skeletonJoint = jointMap[animJoint];
@@ -165,26 +262,31 @@ void AnimClip::copyFromNetworkAnim() {
 
                 AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans() + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
 
-                _anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
+                anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
             }
         }
     }
 
     // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
-
-    _poses.resize(skeletonJointCount);
+    _anim = std::make_shared<const AnimClipData>(_skeleton, anim);
+    addAnimClipData(key, _anim);
 }
 
 void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+    assert(_skeleton && _anim);
+
+    AnimClipDataKey key(_url, _skeleton.get(), true, usePreAndPostPoseFromAnim);
+    _mirrorAnim = findAnimClipData(key);
+    if (_mirrorAnim) {
+        return;
+    }
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    std::vector<AnimPoseVec> mirrorAnim = _anim->decompress();
+    for (auto& relPoses : mirrorAnim) {
+        _skeleton->mirrorRelativePoses(relPoses);
     }
+    _mirrorAnim = std::make_shared<const AnimClipData>(_skeleton, mirrorAnim);
+    addAnimClipData(key, _mirrorAnim);
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
@@ -15,6 +15,32 @@
 #include "AnimationCache.h"
 #include "AnimNode.h"
 
+// The frames of an animation retargeted to a skeleton, shared by all the clips that play the same url on the same skeleton.
+// The joints that hold still through the whole animation, most often those it doesn't have, keep a single pose.
+class AnimClipData {
+public:
+    using Pointer = std::shared_ptr<const AnimClipData>;
+
+    AnimClipData(AnimSkeleton::ConstPointer skeleton, const std::vector<AnimPoseVec>& anim);
+
+    int getNumFrames() const { return _numFrames; }
+    const AnimPoseVec& getConstantPoses() const { return _constantPoses; }
+    const std::vector<int>& getAnimatedJoints() const { return _animatedJoints; }
+
+    // the poses of the animated joints in the order of getAnimatedJoints()
+    const AnimPose* getFrame(int frame) const { return &_frames[frame * _animatedJoints.size()]; }
+
+    // _anim[frame][joint] again, for building the mirrored animation
+    std::vector<AnimPoseVec> decompress() const;
+
+private:
+    AnimSkeleton::ConstPointer _skeleton; // kept alive so that no other skeleton can take its address in the cache
+    int _numFrames { 0 };
+    AnimPoseVec _constantPoses; // of every joint, those of the animated joints are never used
+    std::vector<int> _animatedJoints;
+    AnimPoseVec _frames;
+};
+
 // Playback a single animation timeline.
 // url determines the location of the fbx file to use within this clip.
 // startFrame and endFrame are in frames 1/30th of a second.
@@ -67,9 +93,10 @@ protected:
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    AnimClipData::Pointer _anim;
+    AnimClipData::Pointer _mirrorAnim;
+    const AnimClipData* _posedAnim { nullptr }; // whose constant poses are in _poses
+    AnimPoseVec _animatedPoses; // the blend of the animated joints, before they are put in _poses
 
     QString _url;
     float _startFrame;
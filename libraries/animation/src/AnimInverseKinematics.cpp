@@ -12,6 +12,7 @@
 #include <GeometryUtil.h>
 #include <GLMHelpers.h>
 #include <NumericalConstants.h>
+#include <PerfStat.h>
 #include <SharedUtil.h>
 #include <shared/NsightHelpers.h>
 
@@ -136,7 +137,7 @@ void AnimInverseKinematics::computeTargets(const AnimVariantMap& animVars, std::
 
 void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<IKTarget>& targets) {
     // compute absolute poses that correspond to relative target poses
-    AnimPoseVec absolutePoses;
+    AnimPoseVec& absolutePoses = _absolutePoses;
     absolutePoses.resize(_relativePoses.size());
     computeAbsolutePoses(absolutePoses);
 
@@ -155,7 +156,8 @@ void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<I
         // solve all targets
         int lowestMovedIndex = (int)_relativePoses.size();
         for (auto& target: targets) {
-            int lowIndex = solveTargetWithCCD(target, absolutePoses);
+            int lowIndex = _solver == Solver::FABRIK ?
+                solveTargetWithFABRIK(target, absolutePoses) : solveTargetWithCCD(target, absolutePoses);
             if (lowIndex < lowestMovedIndex) {
                 lowestMovedIndex = lowIndex;
             }
@@ -377,6 +379,80 @@ int AnimInverseKinematics::solveTargetWithCCD(const IKTarget& target, AnimPoseVe
     return lowestMovedIndex;
 }
 
+int AnimInverseKinematics::solveTargetWithFABRIK(const IKTarget& target, AnimPoseVec& absolutePoses) {
+    IKTarget::Type targetType = target.getType();
+    if (targetType != IKTarget::Type::RotationAndPosition &&
+        targetType != IKTarget::Type::HipsRelativeRotationAndPosition) {
+        // only positions are reached by FABRIK, the head and rotation only targets are solved as before
+        return solveTargetWithCCD(target, absolutePoses);
+    }
+
+    // gather the chain from the tip up to its base, which stays put: the joint below the hips, or the lower-spine
+    // for every target but the head (which the hands must not bend too much, lest they drive the hips too far)
+    int tipIndex = target.getIndex();
+    _chain.clear();
+    _chain.push_back(tipIndex);
+    int pivotIndex = _skeleton->getParentIndex(tipIndex);
+    while (pivotIndex != -1 && pivotIndex != _hipsIndex && _skeleton->getParentIndex(pivotIndex) != -1) {
+        _chain.push_back(pivotIndex);
+        RotationConstraint* constraint = getConstraint(pivotIndex);
+        if (constraint && constraint->isLowerSpine() && tipIndex != _headIndex) {
+            break;
+        }
+        pivotIndex = _skeleton->getParentIndex(pivotIndex);
+    }
+    int numJoints = (int)_chain.size();
+    if (numJoints < 2) {
+        return solveTargetWithCCD(target, absolutePoses);
+    }
+
+    // one backward and forward pass over the positions of the chain: the loops of the solver repeat it until it converges
+    const float MIN_BONE_LENGTH = 1.0e-4f;
+    _chainPositions.resize(numJoints);
+    std::vector<glm::vec3>& positions = _chainPositions;
+    positions[0] = target.getTranslation();
+    for (int i = 1; i < numJoints - 1; ++i) {
+        glm::vec3 bone = absolutePoses[_chain[i]].trans() - absolutePoses[_chain[i - 1]].trans();
+        glm::vec3 direction = absolutePoses[_chain[i]].trans() - positions[i - 1];
+        float directionLength = glm::length(direction);
+        positions[i] = positions[i - 1] + (directionLength > MIN_BONE_LENGTH ? (glm::length(bone) / directionLength) * direction : bone);
+    }
+    positions[numJoints - 1] = absolutePoses[_chain[numJoints - 1]].trans();
+    for (int i = numJoints - 2; i >= 0; --i) {
+        glm::vec3 bone = absolutePoses[_chain[i]].trans() - absolutePoses[_chain[i + 1]].trans();
+        glm::vec3 direction = positions[i] - positions[i + 1];
+        float directionLength = glm::length(direction);
+        positions[i] = positions[i + 1] + (directionLength > MIN_BONE_LENGTH ? (glm::length(bone) / directionLength) * direction : bone);
+    }
+
+    // swing each joint from the base out so that its child lies toward the new position, projecting onto its constraint
+    int baseIndex = _chain[numJoints - 1];
+    glm::quat parentRotation = absolutePoses[_skeleton->getParentIndex(baseIndex)].rot();
+    glm::quat deltaRotation; // of the joints above, in the model-frame
+    glm::vec3 jointPosition = absolutePoses[baseIndex].trans();
+    int lowestMovedIndex = (int)_relativePoses.size();
+    for (int i = numJoints - 1; i > 0; --i) {
+        int jointIndex = _chain[i];
+        const AnimPose& jointPose = absolutePoses[jointIndex];
+        glm::vec3 bone = deltaRotation * (absolutePoses[_chain[i - 1]].trans() - jointPose.trans());
+        glm::quat newRotation = glm::normalize(rotationBetween(bone, positions[i - 1] - jointPosition) * deltaRotation * jointPose.rot());
+
+        glm::quat newRelativeRotation = glm::normalize(glm::inverse(parentRotation) * newRotation);
+        RotationConstraint* constraint = getConstraint(jointIndex);
+        if (constraint && constraint->apply(newRelativeRotation)) {
+            newRotation = parentRotation * newRelativeRotation;
+        }
+        _accumulators[jointIndex].add(newRelativeRotation, target.getWeight());
+        lowestMovedIndex = std::min(lowestMovedIndex, jointIndex);
+
+        // the child where it actually went, which is where the next joint swings from
+        deltaRotation = glm::normalize(newRotation * glm::inverse(jointPose.rot()));
+        jointPosition += deltaRotation * (absolutePoses[_chain[i - 1]].trans() - jointPose.trans());
+        parentRotation = newRotation;
+    }
+    return lowestMovedIndex;
+}
+
 //virtual
 const AnimPoseVec& AnimInverseKinematics::evaluate(const AnimVariantMap& animVars, float dt, AnimNode::Triggers& triggersOut) {
     // don't call this function, call overlay() instead
@@ -386,6 +462,8 @@ const AnimPoseVec& AnimInverseKinematics::evaluate(const AnimVariantMap& animVar
 
 //virtual
 const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars, float dt, Triggers& triggersOut, const AnimPoseVec& underPoses) {
+    PROFILE_RANGE(simulation_animation_detail, _id);
+    PerformanceTimer perfTimer(_id);
 
     const float MAX_OVERLAY_DT = 1.0f / 30.0f; // what to clamp delta-time to in AnimInverseKinematics::overlay
     if (dt > MAX_OVERLAY_DT) {
@@ -433,7 +511,8 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
     if (!_relativePoses.empty()) {
 
         // build a list of targets from _targetVarVec
-        std::vector<IKTarget> targets;
+        std::vector<IKTarget>& targets = _targets;
+        targets.clear();
         {
             PROFILE_RANGE_EX(simulation_animation, "ik/computeTargets", 0xffff00ff, 0);
             computeTargets(animVars, targets, underPoses);
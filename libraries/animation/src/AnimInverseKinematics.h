@@ -25,6 +25,12 @@ class RotationConstraint;
 class AnimInverseKinematics : public AnimNode {
 public:
 
+    // how the positions of the targets are reached, the rotations of the tips are enforced after either
+    enum class Solver {
+        CyclicCoordinateDescent = 0,
+        FABRIK // forward and backward reaching, converges in fewer loops on long chains like the spine
+    };
+
     explicit AnimInverseKinematics(const QString& id);
     virtual ~AnimInverseKinematics() override;
 
@@ -41,12 +47,16 @@ public:
 
     void setMaxHipsOffsetLength(float maxLength);
 
+    void setSolver(Solver solver) { _solver = solver; }
+    Solver getSolver() const { return _solver; }
+
     float getMaxErrorOnLastSolve() { return _maxErrorOnLastSolve; }
 
 protected:
     void computeTargets(const AnimVariantMap& animVars, std::vector<IKTarget>& targets, const AnimPoseVec& underPoses);
     void solveWithCyclicCoordinateDescent(const std::vector<IKTarget>& targets);
     int solveTargetWithCCD(const IKTarget& target, AnimPoseVec& absolutePoses);
+    int solveTargetWithFABRIK(const IKTarget& target, AnimPoseVec& absolutePoses);
     virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) override;
 
     // for AnimDebugDraw rendering
@@ -85,6 +95,14 @@ protected:
     AnimPoseVec _defaultRelativePoses; // poses of the relaxed state
     AnimPoseVec _relativePoses; // current relative poses
 
+    // scratch of every frame, kept so that their memory is reused rather than reallocated
+    AnimPoseVec _absolutePoses;
+    std::vector<IKTarget> _targets;
+    std::vector<int> _chain;
+    std::vector<glm::vec3> _chainPositions;
+
+    Solver _solver { Solver::CyclicCoordinateDescent };
+
     // experimental data for moving hips during IK
     glm::vec3 _hipsOffset { Vectors::ZERO };
     float _maxHipsOffsetLength{ FLT_MAX };
@@ -9,6 +9,10 @@
 //
 
 #include "AnimManipulator.h"
+
+#include <PerfStat.h>
+#include <Profile.h>
+
 #include "AnimUtil.h"
 #include "AnimationLogging.h"
 
@@ -27,6 +31,9 @@ const AnimPoseVec& AnimManipulator::evaluate(const AnimVariantMap& animVars, flo
 }
 
 const AnimPoseVec& AnimManipulator::overlay(const AnimVariantMap& animVars, float dt, Triggers& triggersOut, const AnimPoseVec& underPoses) {
+    PROFILE_RANGE(simulation_animation_detail, _id);
+    PerformanceTimer perfTimer(_id);
+
     _alpha = animVars.lookup(_alphaVar, _alpha);
 
     _poses = underPoses;
@@ -448,6 +448,13 @@ AnimNode::Pointer loadInverseKinematicsNode(const QJsonObject& jsonObj, const QS
         node->setTargetVars(jointName, positionVar, rotationVar, typeVar);
     };
 
+    READ_OPTIONAL_STRING(solver, jsonObj);
+    if (solver == "fabrik") {
+        node->setSolver(AnimInverseKinematics::Solver::FABRIK);
+    } else if (!solver.isEmpty() && solver != "ccd") {
+        qCWarning(animation) << "AnimNodeLoader, unknown solver" << solver << "in inverseKinematics node, using ccd, id =" << id << ", url =" << jsonUrl.toDisplayString();
+    }
+
     return node;
 }
 
@@ -9,6 +9,10 @@
 //
 
 #include "AnimOverlay.h"
+
+#include <PerfStat.h>
+#include <Profile.h>
+
 #include "AnimUtil.h"
 #include <queue>
 
@@ -40,6 +44,8 @@ void AnimOverlay::buildBoneSet(BoneSet boneSet) {
 }
 
 const AnimPoseVec& AnimOverlay::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+    PROFILE_RANGE(simulation_animation_detail, _id);
+    PerformanceTimer perfTimer(_id);
 
     // lookup parameters from animVars, using current instance variables as defaults.
     // NOTE: switching bonesets can be an expensive operation, let's try to avoid it.
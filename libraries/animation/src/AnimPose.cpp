@@ -49,13 +49,26 @@ glm::vec3 AnimPose::xformVector(const glm::vec3& rhs) const {
     return transInvMat * rhs;
 }
 
+bool AnimPose::hasUniformScale() const {
+    return _scale.x == _scale.y && _scale.x == _scale.z && _scale.x != 0.0f;
+}
+
 AnimPose AnimPose::operator*(const AnimPose& rhs) const {
+    if (hasUniformScale()) {
+        // a uniform scale commutes with the rotation of rhs, so the parts compose without going through matrices.
+        return AnimPose(_scale.x * rhs._scale, _rot * rhs._rot, _trans + _rot * (_scale.x * rhs._trans));
+    }
     glm::mat4 result;
     glm_mat4u_mul(*this, rhs, result);
     return AnimPose(result);
 }
 
 AnimPose AnimPose::inverse() const {
+    if (hasUniformScale()) {
+        float invScale = 1.0f / _scale.x;
+        glm::quat invRot = glm::conjugate(_rot);
+        return AnimPose(glm::vec3(invScale), invRot, -invScale * (invRot * _trans));
+    }
     return AnimPose(glm::inverse(static_cast<glm::mat4>(*this)));
 }
 
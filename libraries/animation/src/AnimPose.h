@@ -44,6 +44,9 @@ public:
     glm::vec3& trans() { return _trans; }
 
 private:
+    // most joints aren't scaled, or scaled the same along every axis, which keeps the products and inverses exact
+    bool hasUniformScale() const;
+
     friend QDebug operator<<(QDebug debug, const AnimPose& pose);
     glm::vec3 _scale { 1.0f };
     glm::quat _rot;
@@ -9,6 +9,10 @@
 //
 
 #include "AnimStateMachine.h"
+
+#include <PerfStat.h>
+#include <Profile.h>
+
 #include "AnimUtil.h"
 #include "AnimationLogging.h"
 
@@ -22,6 +26,8 @@ AnimStateMachine::~AnimStateMachine() {
 }
 
 const AnimPoseVec& AnimStateMachine::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+    PROFILE_RANGE(simulation_animation_detail, _id);
+    PerformanceTimer perfTimer(_id);
 
     QString desiredStateID = animVars.lookup(_currentStateVar, _currentState->getID());
     if (_currentState->getID() != desiredStateID) {
@@ -52,9 +58,8 @@ const AnimPoseVec& AnimStateMachine::evaluate(const AnimVariantMap& animVars, fl
     if (_duringInterp) {
         _alpha += _alphaVel * dt;
         if (_alpha < 1.0f) {
-            AnimPoseVec* nextPoses = nullptr;
-            AnimPoseVec* prevPoses = nullptr;
-            AnimPoseVec localNextPoses;
+            const AnimPoseVec* nextPoses = nullptr;
+            const AnimPoseVec* prevPoses = nullptr;
             if (_interpType == InterpType::SnapshotBoth) {
                 // interp between both snapshots
                 prevPoses = &_prevPoses;
@@ -62,9 +67,9 @@ const AnimPoseVec& AnimStateMachine::evaluate(const AnimVariantMap& animVars, fl
             } else if (_interpType == InterpType::SnapshotPrev) {
                 // interp between the prev snapshot and evaluated next target.
                 // this is useful for interping into a blend
-                localNextPoses = currentStateNode->evaluate(animVars, dt, triggersOut);
+                // the poses of the node stay put until it is evaluated again, so they're blended where they are
                 prevPoses = &_prevPoses;
-                nextPoses = &localNextPoses;
+                nextPoses = &currentStateNode->evaluate(animVars, dt, triggersOut);
             } else {
                 assert(false);
             }
@@ -9,27 +9,49 @@
 //
 
 #include "AnimUtil.h"
-#include "GLMHelpers.h"
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+#include <algorithm>
+
+#include "GLMHelpers.h"
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    // the ends of a blend are the poses themselves, which the fades of the state machine and overlays spend many frames at
+    if (alpha == 0.0f) {
+        if (result != a) {
+            std::copy(a, a + numPoses, result);
+        }
+        return;
+    } else if (alpha == 1.0f) {
+        if (result != b) {
+            std::copy(b, b + numPoses, result);
+        }
+        return;
+    }
+
+    // the quaternions are mixed component by component without branches, so the loop vectorizes.
+    // result may be a or b, so each pose is read whole before it is written.
+    const float beta = 1.0f - alpha;
     for (size_t i = 0; i < numPoses; i++) {
-        const AnimPose& aPose = a[i];
-        const AnimPose& bPose = b[i];
+        const glm::vec3 aScale = a[i].scale();
+        const glm::quat aRot = a[i].rot();
+        const glm::vec3 aTrans = a[i].trans();
+        const glm::vec3 bScale = b[i].scale();
+        const glm::quat bRot = b[i].rot();
+        const glm::vec3 bTrans = b[i].trans();
 
-        // adjust signs if necessary
-        const glm::quat& q1 = aPose.rot();
-        glm::quat q2 = bPose.rot();
-        float dot = glm::dot(q1, q2);
-        if (dot < 0.0f) {
-            q2 = -q2;
-        }
+        // take the shorter way around by flipping the sign of b when the rotations are more than 180 degrees apart
+        float dot = aRot.x * bRot.x + aRot.y * bRot.y + aRot.z * bRot.z + aRot.w * bRot.w;
+        float bWeight = dot < 0.0f ? -alpha : alpha;
+
+        float x = beta * aRot.x + bWeight * bRot.x;
+        float y = beta * aRot.y + bWeight * bRot.y;
+        float z = beta * aRot.z + bWeight * bRot.z;
+        float w = beta * aRot.w + bWeight * bRot.w;
+        float invLength = 1.0f / sqrtf(x * x + y * y + z * z + w * w);
 
-        result[i].scale() = lerp(aPose.scale(), bPose.scale(), alpha);
-        result[i].rot() = glm::normalize(glm::lerp(aPose.rot(), q2, alpha));
-        result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+        result[i].scale() = beta * aScale + alpha * bScale;
+        result[i].rot() = glm::quat(w * invLength, x * invLength, y * invLength, z * invLength);
+        result[i].trans() = beta * aTrans + alpha * bTrans;
     }
 }
 
@@ -17,6 +17,9 @@
 #include <glm/gtx/quaternion.hpp>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <QHash>
 #include <QScriptValue>
 #include <StreamUtils.h>
 #include <GLMHelpers.h>
@@ -114,6 +117,11 @@ protected:
     } _val;
 };
 
+// the names of the vars are hashed rather than ordered, the graph looks up hundreds of them every frame
+struct AnimVariantKeyHash {
+    size_t operator()(const QString& key) const { return qHash(key); }
+};
+
 class AnimVariantMap {
 public:
 
@@ -257,8 +265,8 @@ public:
 #endif
 
 protected:
-    std::map<QString, AnimVariant> _map;
-    std::set<QString> _triggers;
+    std::unordered_map<QString, AnimVariant, AnimVariantKeyHash> _map;
+    std::unordered_set<QString, AnimVariantKeyHash> _triggers;
     glm::mat4 _rigToGeometryMat;
     glm::quat _rigToGeometryRot;
 };
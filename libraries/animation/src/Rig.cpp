@@ -1251,6 +1251,10 @@ void Rig::applyOverridePoses() {
 
 void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& absolutePosesOut) {
     PerformanceTimer perfTimer("buildAbsolute");
+    composeAbsoluteRigPoses(relativePoses, absolutePosesOut);
+}
+
+void Rig::composeAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& absolutePosesOut) const {
     if (!_animSkeleton) {
         return;
     }
@@ -1264,8 +1268,20 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
         if (parentIndex == -1) {
             // transform all root absolute poses into rig space
             absolutePosesOut[i] = geometryToRigTransform * relativePoses[i];
+            continue;
+        }
+
+        const AnimPose& parent = absolutePosesOut[parentIndex];
+        const AnimPose& relative = relativePoses[i];
+        const glm::vec3& parentScale = parent.scale();
+        if (relative.scale() == Vectors::ONE && parentScale.x == parentScale.y && parentScale.x == parentScale.z) {
+            // the common case (joint data carries no scale): compose directly instead of through a matrix and back
+            AnimPose& absolute = absolutePosesOut[i];
+            absolute.rot() = parent.rot() * relative.rot();
+            absolute.trans() = parent.trans() + parent.rot() * (parentScale * relative.trans());
+            absolute.scale() = parentScale;
         } else {
-            absolutePosesOut[i] = absolutePosesOut[parentIndex] * relativePoses[i];
+            absolutePosesOut[i] = parent * relative;
         }
     }
 }
@@ -1307,6 +1323,10 @@ void Rig::copyJointsIntoJointData(QVector<JointData>& jointDataVec) const {
 void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     PerformanceTimer perfTimer("copyJoints");
     PROFILE_RANGE(simulation_animation_detail, "copyJoints");
+    setRelativePosesFromJointData(jointDataVec);
+}
+
+void Rig::setRelativePosesFromJointData(const QVector<JointData>& jointDataVec) {
     if (!_animSkeleton) {
         return;
     }
@@ -1318,7 +1338,8 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     }
 
     // make a vector of rotations in absolute-geometry-frame
-    std::vector<glm::quat> rotations;
+    std::vector<glm::quat>& rotations = _jointDataRotations;
+    rotations.clear();
     rotations.reserve(numJoints);
     const glm::quat rigToGeometryRot(glmExtractRotation(_rigToGeometryTransform));
     for (int i = 0; i < numJoints; i++) {
@@ -1353,11 +1374,26 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
 }
 
 void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
+    setModelOffsetTransforms(modelOffsetMat);
+    buildAbsoluteRigPoses(_internalPoseSet._relativePoses, _internalPoseSet._absolutePoses);
+    copyInternalPosesToExternal();
+}
+
+void Rig::computeExternalPosesFromJointData(const QVector<JointData>& jointDataVec, const glm::mat4& modelOffsetMat) {
+    PROFILE_RANGE(simulation_animation_detail, "computeExternalPosesFromJointData");
+    setRelativePosesFromJointData(jointDataVec);
+    setModelOffsetTransforms(modelOffsetMat);
+    composeAbsoluteRigPoses(_internalPoseSet._relativePoses, _internalPoseSet._absolutePoses);
+    copyInternalPosesToExternal();
+}
+
+void Rig::setModelOffsetTransforms(const glm::mat4& modelOffsetMat) {
     _modelOffset = AnimPose(modelOffsetMat);
     _geometryToRigTransform = _modelOffset * _geometryOffset;
     _rigToGeometryTransform = glm::inverse(_geometryToRigTransform);
+}
 
-    buildAbsoluteRigPoses(_internalPoseSet._relativePoses, _internalPoseSet._absolutePoses);
+void Rig::copyInternalPosesToExternal() {
     QWriteLocker writeLock(&_externalPoseSetLock);
     _externalPoseSet = _internalPoseSet;
 }
@@ -212,6 +212,11 @@ public:
     void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
 
+    // copyJointsFromJointData followed by computeExternalPoses, for the rigs of other avatars.
+    // Only this rig is touched (and no PerformanceTimer), so the rigs of several avatars can be posed
+    // on worker threads at once while the main thread waits, see AvatarManager::updateOtherAvatars
+    void computeExternalPosesFromJointData(const QVector<JointData>& jointDataVec, const glm::mat4& modelOffsetMat);
+
     void computeAvatarBoundingCapsule(const FBXGeometry& geometry, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
 
     void setEnableInverseKinematics(bool enable);
@@ -227,6 +232,10 @@ protected:
     void updateAnimationStateHandlers();
     void applyOverridePoses();
     void buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& absolutePosesOut);
+    void composeAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& absolutePosesOut) const;
+    void setRelativePosesFromJointData(const QVector<JointData>& jointDataVec);
+    void setModelOffsetTransforms(const glm::mat4& modelOffsetMat);
+    void copyInternalPosesToExternal();
 
     void updateNeckJoint(int index, const HeadParameters& params);
     void computeHeadNeckAnimVars(const AnimPose& hmdPose, glm::vec3& headPositionOut, glm::quat& headOrientationOut,
@@ -245,7 +254,7 @@ protected:
         std::vector<bool> _overrideFlags;
     };
 
-    // Only accessed by the main thread
+    // Only accessed by the main thread (or by computeExternalPosesFromJointData while the main thread waits for it)
     PoseSet _internalPoseSet;
 
     // Copy of the _poseSet for external threads.
@@ -254,6 +263,8 @@ protected:
 
     AnimPoseVec _absoluteDefaultPoses; // rig space, not relative to parent.
 
+    std::vector<glm::quat> _jointDataRotations; // scratch for setRelativePosesFromJointData
+
     glm::mat4 _geometryToRigTransform;
     glm::mat4 _rigToGeometryTransform;
 
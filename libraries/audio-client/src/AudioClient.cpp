@@ -66,6 +66,16 @@ static const bool DEFAULT_STARVE_DETECTION_ENABLED = true;
 static const int STARVE_DETECTION_THRESHOLD = 3;
 static const int STARVE_DETECTION_PERIOD = 10 * 1000; // 10 Seconds
 
+static const bool DEFAULT_LOW_LATENCY_ENABLED = false;
+// in low latency mode, try a frame less of output buffer after this long without starves
+static const int LOW_LATENCY_SHRINK_PERIOD = 30 * 1000; // 30 Seconds
+// and drop old inbound frames sooner
+static const int LOW_LATENCY_MAX_FRAMES_OVER_DESIRED = 2;
+
+static int maxFramesOverDesired(bool lowLatencyEnabled) {
+    return lowLatencyEnabled ? LOW_LATENCY_MAX_FRAMES_OVER_DESIRED : InboundAudioStream::MAX_FRAMES_OVER_DESIRED;
+}
+
 Setting::Handle<bool> dynamicJitterBufferEnabled("dynamicJitterBuffersEnabled",
     InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED);
 Setting::Handle<int> staticJitterBufferFrames("staticJitterBufferFrames",
@@ -160,7 +170,7 @@ AudioClient::AudioClient() :
     _loopbackAudioOutput(NULL),
     _loopbackOutputDevice(NULL),
     _inputRingBuffer(0),
-    _localInjectorsStream(0, 1),
+    _localInjectorsStream(0),
     _receivedAudioStream(RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES),
     _isStereoInput(false),
     _outputStarveDetectionStartTimeMsec(0),
@@ -168,6 +178,7 @@ AudioClient::AudioClient() :
     _outputBufferSizeFrames("audioOutputBufferFrames", DEFAULT_BUFFER_FRAMES),
     _sessionOutputBufferSizeFrames(_outputBufferSizeFrames.get()),
     _outputStarveDetectionEnabled("audioOutputStarveDetectionEnabled", DEFAULT_STARVE_DETECTION_ENABLED),
+    _outputLowLatencyEnabled("audioOutputLowLatencyEnabled", DEFAULT_LOW_LATENCY_ENABLED),
     _lastInputLoudness(0.0f),
     _timeSinceLastClip(-1.0f),
     _muted(false),
@@ -187,7 +198,7 @@ AudioClient::AudioClient() :
     _positionGetter(DEFAULT_POSITION_GETTER),
     _orientationGetter(DEFAULT_ORIENTATION_GETTER) {
     // avoid putting a lock in the device callback
-    assert(_localSamplesAvailable.is_lock_free());
+    assert(_localInjectorsStream.isLockFree());
 
     // deprecate legacy settings
     {
@@ -1113,11 +1124,11 @@ void AudioClient::prepareLocalAudioInjectors() {
 
     int samplesNeeded = std::numeric_limits<int>::max();
     while (samplesNeeded > 0) {
-        // lock for every write to avoid locking out the device callback
-        // this lock is intentional - the buffer is only lock-free in its use in the device callback
+        // lock for every write to avoid locking out device changes
+        // the device callback never takes this lock, it only reads from the lock-free buffer
         RecursiveLock lock(_localAudioMutex);
 
-        samplesNeeded = bufferCapacity - _localSamplesAvailable.load(std::memory_order_relaxed);
+        samplesNeeded = bufferCapacity - _localInjectorsStream.samplesAvailable();
         if (samplesNeeded <= 0) {
             break;
         }
@@ -1149,7 +1160,6 @@ void AudioClient::prepareLocalAudioInjectors() {
                 AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
         }
 
-        _localSamplesAvailable.fetch_add(samples, std::memory_order_release);
         samplesNeeded -= samples;
     }
 }
@@ -1424,7 +1434,8 @@ void AudioClient::outputNotify() {
     if (recentUnfulfilled > 0) {
         qCDebug(audioclient, "Starve detected, %d new unfulfilled reads", recentUnfulfilled);
 
-        if (_outputStarveDetectionEnabled.get()) {
+        // growing the buffer is also what keeps low latency mode from starving repeatedly
+        if (_outputStarveDetectionEnabled.get() || _outputLowLatencyEnabled.get()) {
             quint64 now = usecTimestampNow() / 1000;
             int dt = (int)(now - _outputStarveDetectionStartTimeMsec);
             if (dt > STARVE_DETECTION_PERIOD) {
@@ -1446,6 +1457,26 @@ void AudioClient::outputNotify() {
                 }
             }
         }
+
+        // restart the wait before shrinking
+        _outputLowLatencyCheckTimeMsec = usecTimestampNow() / 1000;
+    } else if (_outputLowLatencyEnabled.get()) {
+        quint64 now = usecTimestampNow() / 1000;
+        if (_outputLowLatencyCheckTimeMsec == 0) {
+            _outputLowLatencyCheckTimeMsec = now;
+        } else if ((int)(now - _outputLowLatencyCheckTimeMsec) > LOW_LATENCY_SHRINK_PERIOD) {
+            _outputLowLatencyCheckTimeMsec = now;
+
+            // shrink by a frame, as long as what is left still covers the device callback jitter
+            int newOutputBufferSizeFrames = _sessionOutputBufferSizeFrames - 1;
+            float jitterMsecs = _stats.getOutputCallbackJitterMs();
+            if (newOutputBufferSizeFrames >= MIN_BUFFER_FRAMES &&
+                newOutputBufferSizeFrames * AudioConstants::NETWORK_FRAME_MSECS > jitterMsecs) {
+                qCDebug(audioclient, "No starves in %d ms (%.1f ms callback jitter), shrinking output buffer",
+                        LOW_LATENCY_SHRINK_PERIOD, (double)jitterMsecs);
+                setOutputBufferSize(newOutputBufferSizeFrames, false);
+            }
+        }
     }
 }
 
@@ -1453,7 +1484,6 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
     bool supportedFormat = false;
 
     RecursiveLock lock(_localAudioMutex);
-    _localSamplesAvailable.exchange(0, std::memory_order_release);
 
     // cleanup any previously initialized device
     if (_audioOutput) {
@@ -1476,6 +1506,9 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
         _localOutputMixBuffer = NULL;
     }
 
+    // the device callback is stopped and the local injectors thread is locked out
+    _localInjectorsStream.clear();
+
     if (_networkToOutputResampler) {
         // if we were using an input to network resampler, delete it here
         delete _networkToOutputResampler;
@@ -1530,7 +1563,11 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
                     _networkPeriod = _localToOutputResampler->getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
                     _localOutputMixBuffer = new float[_networkPeriod];
                     int localPeriod = _outputPeriod * 2;
-                    _localInjectorsStream.resizeForFrameSize(localPeriod);
+                    {
+                        // lock out the local injectors thread, the device callback runs on this thread
+                        RecursiveLock lock(_localAudioMutex);
+                        _localInjectorsStream.resize(localPeriod);
+                    }
 
                     int bufferSize = _audioOutput->bufferSize();
                     int bufferSamples = bufferSize / AudioConstants::SAMPLE_SIZE;
@@ -1567,6 +1604,12 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
     return supportedFormat;
 }
 
+void AudioClient::setOutputLowLatencyEnabled(bool enabled) {
+    _outputLowLatencyEnabled.set(enabled);
+    _outputLowLatencyCheckTimeMsec = 0;
+    _receivedAudioStream.setMaxFramesOverDesired(maxFramesOverDesired(enabled));
+}
+
 int AudioClient::setOutputBufferSize(int numFrames, bool persist) {
     numFrames = std::min(std::max(numFrames, MIN_BUFFER_FRAMES), MAX_BUFFER_FRAMES);
     if (numFrames != _sessionOutputBufferSizeFrames) {
@@ -1657,6 +1700,13 @@ float AudioClient::gainForSource(float distance, float volume) {
 
 qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
 
+    // track the device callback jitter, which the output buffer has to cover
+    quint64 now = usecTimestampNow();
+    if (_lastReadTime != 0) {
+        _audio->_stats.updateOutputCallbackIntervalMs((now - _lastReadTime) / (float)USECS_PER_MSEC);
+    }
+    _lastReadTime = now;
+
     // samples requested from OUTPUT_CHANNEL_COUNT
     int deviceChannelCount = _audio->_outputFormat.channelCount();
     int samplesRequested = (int)(maxSize / AudioConstants::SAMPLE_SIZE) * OUTPUT_CHANNEL_COUNT / deviceChannelCount;
@@ -1681,11 +1731,9 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
 
     int injectorSamplesPopped = 0;
     {
-        RecursiveLock lock(_audio->_localAudioMutex);
+        // wait-free, the local injectors thread writes to the other end
         bool append = networkSamplesPopped > 0;
-        samplesRequested = std::min(samplesRequested, _audio->_localSamplesAvailable.load(std::memory_order_acquire));
         if ((injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested, append)) > 0) {
-            _audio->_localSamplesAvailable.fetch_sub(injectorSamplesPopped, std::memory_order_release);
             qCDebug(audiostream, "Read %d samples from injectors (%d available, %d requested)", injectorSamplesPopped, _localInjectorsStream.samplesAvailable(), samplesRequested);
         }
     }
@@ -1746,6 +1794,7 @@ void AudioClient::checkDevices() {
 void AudioClient::loadSettings() {
     _receivedAudioStream.setDynamicJitterBufferEnabled(dynamicJitterBufferEnabled.get());
     _receivedAudioStream.setStaticJitterBufferFrames(staticJitterBufferFrames.get());
+    _receivedAudioStream.setMaxFramesOverDesired(maxFramesOverDesired(_outputLowLatencyEnabled.get()));
 
     qCDebug(audioclient) << "---- Initializing Audio Client ----";
     auto codecPlugins = PluginManager::getInstance()->getCodecPlugins();
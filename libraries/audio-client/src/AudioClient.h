@@ -46,6 +46,7 @@
 #include <AudioLimiter.h>
 #include <AudioConstants.h>
 #include <AudioNoiseGate.h>
+#include <AudioSPSCRingBuffer.h>
 
 #include <shared/RateCounter.h>
 
@@ -88,7 +89,7 @@ class AudioClient : public AbstractAudioInterface, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
 
-    using LocalInjectorsStream = AudioMixRingBuffer;
+    using LocalInjectorsStream = AudioSPSCMixRingBuffer;
 public:
     static const int MIN_BUFFER_FRAMES;
     static const int MAX_BUFFER_FRAMES;
@@ -108,7 +109,7 @@ public:
             _localInjectorsStream(localInjectorsStream), _receivedAudioStream(receivedAudioStream),
             _audio(audio), _unfulfilledReads(0) {}
 
-        void start() { open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
+        void start() { _lastReadTime = 0; open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
         void stop() { close(); }
         qint64 readData(char * data, qint64 maxSize) override;
         qint64 writeData(const char * data, qint64 maxSize) override { return 0; }
@@ -118,6 +119,7 @@ public:
         MixedProcessedAudioStream& _receivedAudioStream;
         AudioClient* _audio;
         int _unfulfilledReads;
+        quint64 _lastReadTime { 0 };
     };
 
     void negotiateAudioFormat();
@@ -147,6 +149,10 @@ public:
     bool getOutputStarveDetectionEnabled() { return _outputStarveDetectionEnabled.get(); }
     void setOutputStarveDetectionEnabled(bool enabled) { _outputStarveDetectionEnabled.set(enabled); }
 
+    // shrinks the output buffer while the device callback keeps up, and caps how far the jitter buffer may run ahead
+    bool getOutputLowLatencyEnabled() { return _outputLowLatencyEnabled.get(); }
+    void setOutputLowLatencyEnabled(bool enabled);
+
     bool isSimulatingJitter() { return _gate.isSimulatingJitter(); }
     void setIsSimulatingJitter(bool enable) { _gate.setIsSimulatingJitter(enable); }
 
@@ -295,10 +301,8 @@ private:
     QAudioOutput* _loopbackAudioOutput;
     QIODevice* _loopbackOutputDevice;
     AudioRingBuffer _inputRingBuffer;
+    // a lock-free pipe from the local injectors thread (producer) to the device callback (consumer)
     LocalInjectorsStream _localInjectorsStream;
-    // In order to use _localInjectorsStream as a lock-free pipe,
-    // use it with a single producer/consumer, and track available samples
-    std::atomic<int> _localSamplesAvailable { 0 };
     MixedProcessedAudioStream _receivedAudioStream;
     bool _isStereoInput;
 
@@ -311,6 +315,8 @@ private:
     Setting::Handle<int> _outputBufferSizeFrames;
     int _sessionOutputBufferSizeFrames;
     Setting::Handle<bool> _outputStarveDetectionEnabled;
+    Setting::Handle<bool> _outputLowLatencyEnabled;
+    quint64 _outputLowLatencyCheckTimeMsec { 0 };
 
     StDev _stdev;
     QElapsedTimer _timeSinceLastReceived;
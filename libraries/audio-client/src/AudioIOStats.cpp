@@ -23,6 +23,10 @@ static const int INPUT_READS_WINDOW = 5;
 static const int INPUT_UNPLAYED_WINDOW = 5;
 static const int OUTPUT_UNPLAYED_WINDOW = 5;
 
+// device callbacks come every few ms, window over the last ~500
+static const int OUTPUT_CALLBACKS_PER_INTERVAL = 100;
+static const int OUTPUT_CALLBACK_WINDOW = 5;
+
 static const int APPROXIMATELY_30_SECONDS_OF_AUDIO_PACKETS = (int)(30.0f * 1000.0f / AudioConstants::NETWORK_FRAME_MSECS);
 
 
@@ -31,6 +35,7 @@ AudioIOStats::AudioIOStats(MixedProcessedAudioStream* receivedAudioStream) :
     _inputMsRead(1, INPUT_READS_WINDOW),
     _inputMsUnplayed(1, INPUT_UNPLAYED_WINDOW),
     _outputMsUnplayed(1, OUTPUT_UNPLAYED_WINDOW),
+    _outputCallbackIntervalMs(OUTPUT_CALLBACKS_PER_INTERVAL, OUTPUT_CALLBACK_WINDOW),
     _lastSentPacketTime(0),
     _packetTimegaps(1, APPROXIMATELY_30_SECONDS_OF_AUDIO_PACKETS),
     _receivedAudioStream(receivedAudioStream)
@@ -44,9 +49,11 @@ void AudioIOStats::reset() {
     _inputMsRead.reset();
     _inputMsUnplayed.reset();
     _outputMsUnplayed.reset();
+    _outputCallbackIntervalMs.reset();
     _packetTimegaps.reset();
 
-    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, getOutputCallbackJitterMs(),
+        _packetTimegaps);
     _interface->updateMixerStream(AudioStreamStats());
     _interface->updateClientStream(AudioStreamStats());
     _interface->updateInjectorStreams(QHash<QUuid, AudioStreamStats>());
@@ -64,6 +71,11 @@ void AudioIOStats::sentPacket() const {
     }
 }
 
+float AudioIOStats::getOutputCallbackJitterMs() const {
+    // callbacks may come in bursts, so measure the worst gap against the average rather than the device period
+    return std::max((float)(_outputCallbackIntervalMs.getWindowMax() - _outputCallbackIntervalMs.getWindowAverage()), 0.0f);
+}
+
 void AudioIOStats::processStreamStatsPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     // parse the appendFlag, clear injected audio stream stats if 0
     quint8 appendFlag;
@@ -111,8 +123,10 @@ void AudioIOStats::publish() {
     AudioStreamStats stats = _receivedAudioStream->getAudioStreamStats();
 
     // update the interface
-    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, getOutputCallbackJitterMs(),
+        _packetTimegaps);
     _interface->updateClientStream(stats);
+    _interface->updateMouthToEar();
 
     // prepare a packet to the mixer
     int statsPacketSize = sizeof(appendFlag) + sizeof(numStreamStatsToPack) + sizeof(stats);
@@ -167,6 +181,7 @@ AudioStatsInterface::AudioStatsInterface(QObject* parent) :
 void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& inputMsRead,
     const MovingMinMaxAvg<float>& inputMsUnplayed,
     const MovingMinMaxAvg<float>& outputMsUnplayed,
+    float outputCallbackJitterMs,
     const MovingMinMaxAvg<quint64>& timegaps) {
     if (SharedNodePointer audioNode = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::AudioMixer)) {
         pingMs(audioNode->getPingMs());
@@ -175,6 +190,7 @@ void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& input
     inputReadMsMax(inputMsRead.getWindowMax());
     inputUnplayedMsMax(inputMsUnplayed.getWindowMax());
     outputUnplayedMsMax(outputMsUnplayed.getWindowMax());
+    outputCallbackJitterMsMax(outputCallbackJitterMs);
 
     sentTimegapMsMax(timegaps.getMax() / USECS_PER_MSEC);
     sentTimegapMsAvg(timegaps.getAverage() / USECS_PER_MSEC);
@@ -182,6 +198,15 @@ void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& input
     sentTimegapMsAvgWindow(timegaps.getWindowAverage() / USECS_PER_MSEC);
 }
 
+void AudioStatsInterface::updateMouthToEar() {
+    // a local source on the way to a remote listener (or the reverse) goes through the same buffers:
+    // input, upstream network, the mixer's ring, one mix frame, downstream network, the client's ring and the device
+    mouthToEarMs(inputReadMsMax() + inputUnplayedMsMax() +
+        pingMs() +
+        _mixer->unplayedMsMax() + AudioConstants::NETWORK_FRAME_MSECS +
+        _client->unplayedMsMax() + outputUnplayedMsMax());
+}
+
 void AudioStatsInterface::updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats) {
     // Get existing injectors
     auto injectorIds = _injectors->dynamicPropertyNames();
@@ -73,6 +73,10 @@ class AudioStatsInterface : public QObject {
     AUDIO_PROPERTY(float, inputReadMsMax);
     AUDIO_PROPERTY(float, inputUnplayedMsMax);
     AUDIO_PROPERTY(float, outputUnplayedMsMax);
+    AUDIO_PROPERTY(float, outputCallbackJitterMsMax);
+
+    // estimated mouth-to-ear latency through the mixer, the sum of the pipeline's buffers and the round trip
+    AUDIO_PROPERTY(float, mouthToEarMs);
 
     AUDIO_PROPERTY(quint64, sentTimegapMsMax);
     AUDIO_PROPERTY(quint64, sentTimegapMsAvg);
@@ -91,7 +95,9 @@ public:
     void updateLocalBuffers(const MovingMinMaxAvg<float>& inputMsRead,
                             const MovingMinMaxAvg<float>& inputMsUnplayed,
                             const MovingMinMaxAvg<float>& outputMsUnplayed,
+                            float outputCallbackJitterMs,
                             const MovingMinMaxAvg<quint64>& timegaps);
+    void updateMouthToEar();
     void updateMixerStream(const AudioStreamStats& stats) { _mixer->updateStream(stats); emit mixerStreamChanged(); }
     void updateClientStream(const AudioStreamStats& stats) { _client->updateStream(stats); emit clientStreamChanged(); }
     void updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats);
@@ -121,8 +127,12 @@ public:
     void updateInputMsRead(float ms) const { _inputMsRead.update(ms); }
     void updateInputMsUnplayed(float ms) const { _inputMsUnplayed.update(ms); }
     void updateOutputMsUnplayed(float ms) const { _outputMsUnplayed.update(ms); }
+    void updateOutputCallbackIntervalMs(float ms) const { _outputCallbackIntervalMs.update(ms); }
     void sentPacket() const;
 
+    // how much later than usual the device callback has recently been (the device buffer has to cover this)
+    float getOutputCallbackJitterMs() const;
+
     void publish();
 
 public slots:
@@ -134,6 +144,7 @@ private:
     mutable MovingMinMaxAvg<float> _inputMsRead;
     mutable MovingMinMaxAvg<float> _inputMsUnplayed;
     mutable MovingMinMaxAvg<float> _outputMsUnplayed;
+    mutable MovingMinMaxAvg<float> _outputCallbackIntervalMs;
 
     mutable quint64 _lastSentPacketTime;
     mutable MovingMinMaxAvg<quint64> _packetTimegaps;
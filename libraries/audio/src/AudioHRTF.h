@@ -48,7 +48,7 @@ public:
     // HRTF local gain adjustment in amplitude (1.0 == unity)
     //
     void setGainAdjustment(float gain) { _gainAdjust = HRTF_GAIN * gain; };
-    float getGainAdjustment() { return _gainAdjust; }
+    float getGainAdjustment() const { return _gainAdjust; }
 
 private:
     AudioHRTF(const AudioHRTF&) = delete;
@@ -314,7 +314,7 @@ int64_t AudioInjector::injectNextFrame() {
     //  Measure the loudness of this frame
     _loudness = 0.0f;
     for (int i = 0; i < totalBytesLeftToCopy; i += sizeof(int16_t)) {
-        _loudness += abs(*reinterpret_cast<int16_t*>(_audioData.data() + ((_currentSendOffset + i) % _audioData.size()))) /
+        _loudness += abs(*reinterpret_cast<const int16_t*>(_audioData.constData() + ((_currentSendOffset + i) % _audioData.size()))) /
             (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
     }
     _loudness /= (float)(totalBytesLeftToCopy/ sizeof(int16_t));
@@ -343,7 +343,7 @@ int64_t AudioInjector::injectNextFrame() {
     while (totalBytesLeftToCopy > 0) {
         int bytesToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
 
-        decodedAudio.append(_audioData.data() + _currentSendOffset, bytesToCopy);
+        decodedAudio.append(_audioData.constData() + _currentSendOffset, bytesToCopy);
         _currentSendOffset += bytesToCopy;
         totalBytesLeftToCopy -= bytesToCopy;
         if (_options.loop && _currentSendOffset >= _audioData.size()) {
@@ -445,7 +445,7 @@ AudioInjector* AudioInjector::playSound(SharedSoundPointer sound, const float vo
     const int maxOutputFrames = resampler.getMaxOutput(nInputFrames);
     QByteArray resampled(maxOutputFrames * channelCount * sizeof(int16_t), '\0');
 
-    int nOutputFrames = resampler.render(reinterpret_cast<const int16_t*>(samples.data()),
+    int nOutputFrames = resampler.render(reinterpret_cast<const int16_t*>(samples.constData()),
                                          reinterpret_cast<int16_t*>(resampled.data()),
                                          nInputFrames);
 
@@ -34,7 +34,7 @@ public:
 private:
     qint64 recursiveReadFromFront(char* data, qint64 maxSize);
 
-    QByteArray _rawAudioArray;
+    QByteArray _rawAudioArray; // shared with the Sound (possibly a mapping), only ever read through constData()
     bool _shouldLoop;
     bool _isStopped;
 
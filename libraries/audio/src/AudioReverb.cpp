@@ -630,15 +630,102 @@ void PZShelf(double coef[3], double w0, double dbgain, int isHigh) {
     coef[2] = a1 * scale;
 }
 
+//
+// Two lanes of float, for running a pair of identical filters as one.
+// The reverb is mostly symmetric pairs (the left and right early reflections, two pairs of late branches),
+// so each pair is processed together. Filter state is kept in float[2], to not depend on the alignment of ReverbImpl.
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+class Float2 {
+
+    __m128 _v;
+
+    explicit Float2(__m128 v) : _v(v) {}
+
+public:
+    Float2() : _v(_mm_setzero_ps()) {}
+    explicit Float2(float f) : _v(_mm_set1_ps(f)) {}
+    Float2(float f0, float f1) : _v(_mm_setr_ps(f0, f1, 0.0f, 0.0f)) {}
+
+    // from p[0], p[1]
+    static Float2 load(const float* p) {
+        return Float2(_mm_castpd_ps(_mm_load_sd((const double*)p)));
+    }
+
+    // from *p0, *p1
+    static Float2 gather(const float* p0, const float* p1) {
+        return Float2(_mm_unpacklo_ps(_mm_load_ss(p0), _mm_load_ss(p1)));
+    }
+
+    // to p[0], p[1]
+    void store(float* p) const {
+        _mm_store_sd((double*)p, _mm_castps_pd(_v));
+    }
+
+    float get0() const { return _mm_cvtss_f32(_v); }
+    float get1() const { return _mm_cvtss_f32(_mm_shuffle_ps(_v, _v, _MM_SHUFFLE(1,1,1,1))); }
+
+    Float2 swapped() const { return Float2(_mm_shuffle_ps(_v, _v, _MM_SHUFFLE(3,2,0,1))); }
+    Float2 broadcast0() const { return Float2(_mm_shuffle_ps(_v, _v, _MM_SHUFFLE(0,0,0,0))); }
+    Float2 broadcast1() const { return Float2(_mm_shuffle_ps(_v, _v, _MM_SHUFFLE(1,1,1,1))); }
+    Float2 negated1() const { return Float2(_mm_xor_ps(_v, _mm_setr_ps(0.0f, -0.0f, 0.0f, 0.0f))); }
+
+    Float2 operator-() const { return Float2(_mm_xor_ps(_v, _mm_set1_ps(-0.0f))); }
+    Float2 operator+(const Float2& b) const { return Float2(_mm_add_ps(_v, b._v)); }
+    Float2 operator-(const Float2& b) const { return Float2(_mm_sub_ps(_v, b._v)); }
+    Float2 operator*(const Float2& b) const { return Float2(_mm_mul_ps(_v, b._v)); }
+};
+
+#else
+
+class Float2 {
+
+    float _v0;
+    float _v1;
+
+public:
+    Float2() : _v0(0.0f), _v1(0.0f) {}
+    explicit Float2(float f) : _v0(f), _v1(f) {}
+    Float2(float f0, float f1) : _v0(f0), _v1(f1) {}
+
+    // from p[0], p[1]
+    static Float2 load(const float* p) { return Float2(p[0], p[1]); }
+
+    // from *p0, *p1
+    static Float2 gather(const float* p0, const float* p1) { return Float2(*p0, *p1); }
+
+    // to p[0], p[1]
+    void store(float* p) const {
+        p[0] = _v0;
+        p[1] = _v1;
+    }
+
+    float get0() const { return _v0; }
+    float get1() const { return _v1; }
+
+    Float2 swapped() const { return Float2(_v1, _v0); }
+    Float2 broadcast0() const { return Float2(_v0, _v0); }
+    Float2 broadcast1() const { return Float2(_v1, _v1); }
+    Float2 negated1() const { return Float2(_v0, -_v1); }
+
+    Float2 operator-() const { return Float2(-_v0, -_v1); }
+    Float2 operator+(const Float2& b) const { return Float2(_v0 + b._v0, _v1 + b._v1); }
+    Float2 operator-(const Float2& b) const { return Float2(_v0 - b._v0, _v1 - b._v1); }
+    Float2 operator*(const Float2& b) const { return Float2(_v0 * b._v0, _v1 * b._v1); }
+};
+
+#endif
+
 class BandwidthEQ {
 
-    float _buffer[4] {};
+    float _buffer[4] {};    // both stages, interleaved by channel
 
-    float _output0 = 0.0f;
-    float _output1 = 0.0f;
+    float _output[2] {};
 
-    float _dcL = 0.0f;
-    float _dcR = 0.0f;
+    float _dc[2] {};
 
     float _b0 = 1.0f;
     float _b1 = 0.0f;
@@ -665,96 +752,95 @@ public:
         _alpha = 1.0f - expf(-TWOPI * 10.0f / sampleRate);
     }
 
-    void process(float input0, float input1, float& output0, float& output1) {
-        output0 = _output0;
-        output1 = _output1;
+    void process(Float2 input, Float2& output) {
+        output = Float2::load(_output);
 
         // prevent denormalized zero-input limit cycles in the reverb
-        input0 += 1.0e-20f;
-        input1 += 1.0e-20f;
+        input = input + Float2(1.0e-20f);
 
         // remove DC
-        input0 -= _dcL;
-        input1 -= _dcR;
+        Float2 dc = Float2::load(_dc);
+        input = input - dc;
 
-        _dcL += _alpha * input0;
-        _dcR += _alpha * input1;
+        dc = dc + Float2(_alpha) * input;
+        dc.store(_dc);
 
         // transposed Direct Form II
-        _output0   = _b0 * input0 + _buffer[0];
-        _buffer[0] = _b1 * input0 - _a1 * _output0 + _buffer[1];
-        _buffer[1] = _b2 * input0 - _a2 * _output0;
-
-        _output1   = _b0 * input1 + _buffer[2];
-        _buffer[2] = _b1 * input1 - _a1 * _output1 + _buffer[3];
-        _buffer[3] = _b2 * input1 - _a2 * _output1;
+        Float2 y = Float2(_b0) * input + Float2::load(&_buffer[0]);
+        (Float2(_b1) * input - Float2(_a1) * y + Float2::load(&_buffer[2])).store(&_buffer[0]);
+        (Float2(_b2) * input - Float2(_a2) * y).store(&_buffer[2]);
+        y.store(_output);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output0 = 0.0f;
-        _output1 = 0.0f;
-        _dcL = 0.0f;
-        _dcR = 0.0f;
+        memset(_output, 0, sizeof(_output));
+        memset(_dc, 0, sizeof(_dc));
     }
 };
 
+//
+// The filters below each run two independent lines, one per lane, sharing a write index.
+// The buffers interleave the lanes, so a sample of both lanes is written at once.
+//
+
 template<int N>
 class DelayLine {
 
-    float _buffer[N] {};
+    float _buffer[2*N] {};
 
-    float _output = 0.0f;
+    float _output[2] {};
 
     int _index = 0;
-    int _delay = N;
+    int _delay[2] = { N, N };
 
 public:
-    void setDelay(int d) {
+    void setDelay(int lane, int d) {
         d = MIN(MAX(d, 1), N);
 
-        _delay = d;
+        _delay[lane] = d;
     }
 
-    void process(float input, float& output) {
-        output = _output;
+    void process(Float2 input, Float2& output) {
+        output = Float2::load(_output);
 
-        int k = (_index - _delay) & (N - 1);
+        int k0 = (_index - _delay[0]) & (N - 1);
+        int k1 = (_index - _delay[1]) & (N - 1);
 
-        _output = _buffer[k];
+        Float2::gather(&_buffer[2*k0 + 0], &_buffer[2*k1 + 1]).store(_output);
 
-        _buffer[_index] = input;
+        input.store(&_buffer[2*_index]);
         _index = (_index + 1) & (N - 1);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output = 0.0f;
+        memset(_output, 0, sizeof(_output));
     }
 };
 
 template<int N>
 class Allpass {
 
-    float _buffer[N] {};
+    float _buffer[2*N] {};
 
-    float _output = 0.0f;
+    float _output[2] {};
     float _coef = 0.5f;
 
     int _index0 = 0;
-    int _index1 = 0;
-    int _delay = N;
+    int _index1[2] = { 0, 0 };
+    int _delay[2] = { N, N };
 
 public:
-    void setDelay(int d) {   
+    void setDelay(int lane, int d) {
         d = MIN(MAX(d, 1), N);
 
-        _index1 = (_index0 - d) & (N - 1);
-        _delay = d; 
+        _index1[lane] = (_index0 - d) & (N - 1);
+        _delay[lane] = d;
     }
 
-    int getDelay() {
-        return _delay;
+    int getDelay(int lane) {
+        return _delay[lane];
     }
 
     void setCoef(float coef) {
@@ -763,23 +849,28 @@ public:
         _coef = coef;
     }
 
-    void process(float input, float& output) {
-        output = _output;
+    void process(Float2 input, Float2& output) {
+        output = Float2::load(_output);
+
+        Float2 coef(_coef);
+        Float2 delayed = Float2::gather(&_buffer[2*_index1[0] + 0], &_buffer[2*_index1[1] + 1]);
 
-        _output = _buffer[_index1] - _coef * input; // feedforward path
-        _buffer[_index0] = input + _coef * _output; // feedback path
+        Float2 y = delayed - coef * input;          // feedforward path
+        (input + coef * y).store(&_buffer[2*_index0]);  // feedback path
+        y.store(_output);
 
         _index0 = (_index0 + 1) & (N - 1);
-        _index1 = (_index1 + 1) & (N - 1);
+        _index1[0] = (_index1[0] + 1) & (N - 1);
+        _index1[1] = (_index1[1] + 1) & (N - 1);
     }
 
-    void getOutput(float& output) {
-        output = _output;
+    void getOutput(Float2& output) {
+        output = Float2::load(_output);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output = 0.0f;
+        memset(_output, 0, sizeof(_output));
     }
 };
 
@@ -869,23 +960,23 @@ public:
 template<int N>
 class AllPassMod {
 
-    float _buffer[N] {};
+    float _buffer[2*N] {};
 
-    float _output = 0.0f;
+    float _output[2] {};
     float _coef = 0.5f;
 
     int _index = 0;
-    int _delay = N;
+    int _delay[2] = { N, N };
 
 public:
-    void setDelay(int d) {   
+    void setDelay(int lane, int d) {
         d = MIN(MAX(d, 1), N);
 
-        _delay = d; 
+        _delay[lane] = d;
     }
 
-    int getDelay() {
-        return _delay;
+    int getDelay(int lane) {
+        return _delay[lane];
     }
 
     void setCoef(float coef) {
@@ -894,50 +985,52 @@ public:
         _coef = coef;
     }
 
-    void process(float input, int32_t mod, float& output) {
-        output = _output;
+    void process(Float2 input, int32_t mod0, int32_t mod1, Float2& output) {
+        output = Float2::load(_output);
 
         // add modulation to delay
-        int32_t offset = _delay + (mod >> MOD_FRACBITS);
-        float frac = (mod & MOD_FRACMASK) * QMOD_TO_FLOAT;
+        int32_t offset0 = _delay[0] + (mod0 >> MOD_FRACBITS);
+        int32_t offset1 = _delay[1] + (mod1 >> MOD_FRACBITS);
+        Float2 frac((mod0 & MOD_FRACMASK) * QMOD_TO_FLOAT, (mod1 & MOD_FRACMASK) * QMOD_TO_FLOAT);
 
         // 3rd-order Lagrange interpolation
-        int k0 = (_index - (offset-1)) & (N - 1);
-        int k1 = (_index - (offset+0)) & (N - 1);
-        int k2 = (_index - (offset+1)) & (N - 1);
-        int k3 = (_index - (offset+2)) & (N - 1);
-
-        float x0 = _buffer[k0];
-        float x1 = _buffer[k1];
-        float x2 = _buffer[k2];
-        float x3 = _buffer[k3];
+        Float2 x0 = Float2::gather(&_buffer[2*((_index - (offset0-1)) & (N - 1)) + 0],
+                                   &_buffer[2*((_index - (offset1-1)) & (N - 1)) + 1]);
+        Float2 x1 = Float2::gather(&_buffer[2*((_index - (offset0+0)) & (N - 1)) + 0],
+                                   &_buffer[2*((_index - (offset1+0)) & (N - 1)) + 1]);
+        Float2 x2 = Float2::gather(&_buffer[2*((_index - (offset0+1)) & (N - 1)) + 0],
+                                   &_buffer[2*((_index - (offset1+1)) & (N - 1)) + 1]);
+        Float2 x3 = Float2::gather(&_buffer[2*((_index - (offset0+2)) & (N - 1)) + 0],
+                                   &_buffer[2*((_index - (offset1+2)) & (N - 1)) + 1]);
 
         // compute the polynomial coefficients
-        float c0 = (1/6.0f) * (x3 - x0) + (1/2.0f) * (x1 - x2);
-        float c1 = (1/2.0f) * (x0 + x2) - x1;
-        float c2 = x2 - (1/3.0f) * x0 - (1/2.0f) * x1 - (1/6.0f) * x3;
-        float c3 = x1;
+        Float2 c0 = Float2(1/6.0f) * (x3 - x0) + Float2(1/2.0f) * (x1 - x2);
+        Float2 c1 = Float2(1/2.0f) * (x0 + x2) - x1;
+        Float2 c2 = x2 - Float2(1/3.0f) * x0 - Float2(1/2.0f) * x1 - Float2(1/6.0f) * x3;
+        Float2 c3 = x1;
 
         // compute the polynomial
-        float delayMod = ((c0 * frac + c1) * frac + c2) * frac + c3;
+        Float2 delayMod = ((c0 * frac + c1) * frac + c2) * frac + c3;
 
-        _output = delayMod - _coef * input;         // feedforward path
-        _buffer[_index] = input + _coef * _output;  // feedback path
+        Float2 coef(_coef);
+        Float2 y = delayMod - coef * input;                 // feedforward path
+        (input + coef * y).store(&_buffer[2*_index]);       // feedback path
+        y.store(_output);
 
         _index = (_index + 1) & (N - 1);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output = 0.0f;
+        memset(_output, 0, sizeof(_output));
     }
 };
 
 class LowpassEQ {
 
-    float _buffer[2] {};
+    float _buffer[4] {};    // both taps, interleaved by lane
 
-    float _output = 0.0f;
+    float _output[2] {};
 
     float _b0 = 1.0f;
     float _b1 = 0.0f;
@@ -954,25 +1047,26 @@ public:
         _b2 = 0.5f - _b1;
     }
 
-    void process(float input, float& output) {
-        output = _output;
+    void process(Float2 input, Float2& output) {
+        output = Float2::load(_output);
 
-        _output = _b0 * input + _b1 * _buffer[0] + _b2 * _buffer[1];
-        _buffer[1] = _buffer[0];
-        _buffer[0] = input;
+        Float2 x1 = Float2::load(&_buffer[0]);
+        (Float2(_b0) * input + Float2(_b1) * x1 + Float2(_b2) * Float2::load(&_buffer[2])).store(_output);
+        x1.store(&_buffer[2]);
+        input.store(&_buffer[0]);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output = 0.0f;
+        memset(_output, 0, sizeof(_output));
     }
 };
 
 class DampingEQ {
 
-    float _buffer[2] {};
+    float _buffer[4] {};    // both stages, interleaved by lane
 
-    float _output = 0.0f;
+    float _output[2] {};
 
     float _b0 = 1.0f;
     float _b1 = 0.0f;
@@ -999,213 +1093,196 @@ public:
         _a2 = (float)(coefLo[2] * coefHi[2]);
     }
 
-    void process(float input, float& output) {
-        output = _output;
+    void process(Float2 input, Float2& output) {
+        output = Float2::load(_output);
 
         // transposed Direct Form II
-        _output    = _b0 * input + _buffer[0];
-        _buffer[0] = _b1 * input - _a1 * _output + _buffer[1];
-        _buffer[1] = _b2 * input - _a2 * _output;
+        Float2 y = Float2(_b0) * input + Float2::load(&_buffer[0]);
+        (Float2(_b1) * input - Float2(_a1) * y + Float2::load(&_buffer[2])).store(&_buffer[0]);
+        (Float2(_b2) * input - Float2(_a2) * y).store(&_buffer[2]);
+        y.store(_output);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output = 0.0f;
+        memset(_output, 0, sizeof(_output));
     }
 };
 
 template<int N>
 class MultiTap2 {
 
-    float _buffer[N] {};
+    float _buffer[2*N] {};
 
-    float _output0 = 0.0f;
-    float _output1 = 0.0f;
+    float _output0[2] {};
+    float _output1[2] {};
 
-    float _gain0 = 1.0f;
-    float _gain1 = 1.0f;
+    float _gain0[2] = { 1.0f, 1.0f };
+    float _gain1[2] = { 1.0f, 1.0f };
 
     int _index = 0;
-    int _delay0 = N;
-    int _delay1 = N;
+    int _delay0[2] = { N, N };
+    int _delay1[2] = { N, N };
 
 public:
-    void setDelay(int d0, int d1) {
+    void setDelay(int lane, int d0, int d1) {
         d0 = MIN(MAX(d0, 1), N);
         d1 = MIN(MAX(d1, 1), N);
 
-        _delay0 = d0;
-        _delay1 = d1;
+        _delay0[lane] = d0;
+        _delay1[lane] = d1;
     }
 
-    int getDelay(int k) {
+    int getDelay(int lane, int k) {
         switch (k) {
-            case 0: return _delay0;
-            case 1: return _delay1;
+            case 0: return _delay0[lane];
+            case 1: return _delay1[lane];
             default: return 0;
         }
     }
 
-    void setGain(float g0, float g1) {
-        _gain0 = g0;
-        _gain1 = g1;
+    void setGain(int lane, float g0, float g1) {
+        _gain0[lane] = g0;
+        _gain1[lane] = g1;
     }
 
-    void process(float input, float& output0, float& output1) {
-        output0 = _output0;
-        output1 = _output1;
+    void process(Float2 input, Float2& output0, Float2& output1) {
+        output0 = Float2::load(_output0);
+        output1 = Float2::load(_output1);
 
-        int k0 = (_index - _delay0) & (N - 1);
-        int k1 = (_index - _delay1) & (N - 1);
+        int k00 = (_index - _delay0[0]) & (N - 1);
+        int k01 = (_index - _delay0[1]) & (N - 1);
+        int k10 = (_index - _delay1[0]) & (N - 1);
+        int k11 = (_index - _delay1[1]) & (N - 1);
 
-        _output0 = _gain0 * _buffer[k0];
-        _output1 = _gain1 * _buffer[k1];
+        (Float2::load(_gain0) * Float2::gather(&_buffer[2*k00 + 0], &_buffer[2*k01 + 1])).store(_output0);
+        (Float2::load(_gain1) * Float2::gather(&_buffer[2*k10 + 0], &_buffer[2*k11 + 1])).store(_output1);
 
-        _buffer[_index] = input;
+        input.store(&_buffer[2*_index]);
         _index = (_index + 1) & (N - 1);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output0 = 0.0f;
-        _output1 = 0.0f;
+        memset(_output0, 0, sizeof(_output0));
+        memset(_output1, 0, sizeof(_output1));
     }
 };
 
 template<int N>
 class MultiTap3 {
 
-    float _buffer[N] {};
+    float _buffer[2*N] {};
 
-    float _output0 = 0.0f;
-    float _output1 = 0.0f;
-    float _output2 = 0.0f;
+    float _output0[2] {};
+    float _output1[2] {};
+    float _output2[2] {};
 
-    float _gain0 = 1.0f;
-    float _gain1 = 1.0f;
-    float _gain2 = 1.0f;
+    float _gain0[2] = { 1.0f, 1.0f };
+    float _gain1[2] = { 1.0f, 1.0f };
+    float _gain2[2] = { 1.0f, 1.0f };
 
     int _index = 0;
-    int _delay0 = N;
-    int _delay1 = N;
-    int _delay2 = N;
+    int _delay0[2] = { N, N };
+    int _delay1[2] = { N, N };
+    int _delay2[2] = { N, N };
 
 public:
-    void setDelay(int d0, int d2) {
+    void setDelay(int lane, int d0, int d2) {
         d0 = MIN(MAX(d0, 1), N);
         d2 = MIN(MAX(d2, 1), N);
 
-        _delay0 = d0;
-        _delay1 = d0 - 1;
-        _delay2 = d2;
+        _delay0[lane] = d0;
+        _delay1[lane] = d0 - 1;
+        _delay2[lane] = d2;
     }
 
-    int getDelay(int k) {
+    int getDelay(int lane, int k) {
         switch (k) {
-            case 0: return _delay0;
-            case 1: return _delay1;
-            case 2: return _delay2;
+            case 0: return _delay0[lane];
+            case 1: return _delay1[lane];
+            case 2: return _delay2[lane];
             default: return 0;
         }
     }
 
-    void setGain(float g0, float g1, float g2) {
-        _gain0 = g0;
-        _gain1 = g1;
-        _gain2 = g2;
+    void setGain(int lane, float g0, float g1, float g2) {
+        _gain0[lane] = g0;
+        _gain1[lane] = g1;
+        _gain2[lane] = g2;
     }
 
-    void process(float input, float& output0, float& output1, float& output2) {
-        output0 = _output0;
-        output1 = _output1;
-        output2 = _output2;
+    void process(Float2 input, Float2& output0, Float2& output1, Float2& output2) {
+        output0 = Float2::load(_output0);
+        output1 = Float2::load(_output1);
+        output2 = Float2::load(_output2);
 
-        int k0 = (_index - _delay0) & (N - 1);
-        int k1 = (_index - _delay1) & (N - 1);
-        int k2 = (_index - _delay2) & (N - 1);
+        int k00 = (_index - _delay0[0]) & (N - 1);
+        int k01 = (_index - _delay0[1]) & (N - 1);
+        int k10 = (_index - _delay1[0]) & (N - 1);
+        int k11 = (_index - _delay1[1]) & (N - 1);
+        int k20 = (_index - _delay2[0]) & (N - 1);
+        int k21 = (_index - _delay2[1]) & (N - 1);
 
-        _output0 = _gain0 * _buffer[k0];
-        _output1 = _gain1 * _buffer[k1];
-        _output2 = _gain2 * _buffer[k2];
+        (Float2::load(_gain0) * Float2::gather(&_buffer[2*k00 + 0], &_buffer[2*k01 + 1])).store(_output0);
+        (Float2::load(_gain1) * Float2::gather(&_buffer[2*k10 + 0], &_buffer[2*k11 + 1])).store(_output1);
+        (Float2::load(_gain2) * Float2::gather(&_buffer[2*k20 + 0], &_buffer[2*k21 + 1])).store(_output2);
 
-        _buffer[_index] = input;
+        input.store(&_buffer[2*_index]);
         _index = (_index + 1) & (N - 1);
     }
 
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
-        _output0 = 0.0f;
-        _output1 = 0.0f;
-        _output2 = 0.0f;
+        memset(_output0, 0, sizeof(_output0));
+        memset(_output1, 0, sizeof(_output1));
+        memset(_output2, 0, sizeof(_output2));
     }
 };
 
 //
 // Stereo Reverb
 //
+// The symmetric halves of the network are paired into the lanes of its filters:
+// the early reflections are left (lane 0) and right (lane 1), the late branches are 0 and 1 in one set of filters,
+// 2 and 3 in another, and the output diffusers are left and right.
+//
 class ReverbImpl {
 
     // Preprocess
     BandwidthEQ _bw;
-    DelayLine<NEXTPOW2(M_PD0)> _dl0;
-    DelayLine<NEXTPOW2(M_PD0)> _dl1;
-
-    // Early Left
-    float _earlyMix1L = 0.0f;
-    float _earlyMix2L = 0.0f;
+    DelayLine<NEXTPOW2(M_PD0)> _dl;
 
-    MultiTap3<NEXTPOW2(M_MT0)> _mt0;
-    Allpass<NEXTPOW2(M_AP0)> _ap0;
-    MultiTap3<NEXTPOW2(M_MT1_MAX)> _mt1;
-    Allpass<NEXTPOW2(M_AP1)> _ap1;
-    Allpass<NEXTPOW2(M_AP2)> _ap2;
-    MultiTap2<NEXTPOW2(M_MT2)> _mt2;
+    // Early
+    float _earlyMix1[2] {};
+    float _earlyMix2[2] {};
 
-    // Early Right
-    float _earlyMix1R = 0.0f;
-    float _earlyMix2R = 0.0f;
-
-    MultiTap3<NEXTPOW2(M_MT3)> _mt3;
-    Allpass<NEXTPOW2(M_AP3)> _ap3;
-    MultiTap3<NEXTPOW2(M_MT4_MAX)> _mt4;
-    Allpass<NEXTPOW2(M_AP4)> _ap4;
-    Allpass<NEXTPOW2(M_AP5)> _ap5;
-    MultiTap2<NEXTPOW2(M_MT5)> _mt5;
+    MultiTap3<NEXTPOW2(MAX(M_MT0, M_MT3))> _mt0;
+    Allpass<NEXTPOW2(MAX(M_AP0, M_AP3))> _ap0;
+    MultiTap3<NEXTPOW2(MAX(M_MT1_MAX, M_MT4_MAX))> _mt1;
+    Allpass<NEXTPOW2(MAX(M_AP1, M_AP4))> _ap1;
+    Allpass<NEXTPOW2(MAX(M_AP2, M_AP5))> _ap2;
+    MultiTap2<NEXTPOW2(MAX(M_MT2, M_MT5))> _mt2;
 
     RandomLFO _lfo;
 
-    // Late
-    Allpass<NEXTPOW2(M_AP6)> _ap6;
-    AllPassMod<NEXTPOW2(M_AP7_MAX)> _ap7;
+    // Late, branches 0 and 1
+    Allpass<NEXTPOW2(MAX(M_AP6, M_AP8))> _ap6;
+    AllPassMod<NEXTPOW2(MAX(M_AP7_MAX, M_AP9_MAX))> _ap7;
     DampingEQ _eq0;
-    MultiTap2<NEXTPOW2(M_MT6_MAX)> _mt6;
-
-    Allpass<NEXTPOW2(M_AP8)> _ap8;
-    AllPassMod<NEXTPOW2(M_AP9_MAX)> _ap9;
-    DampingEQ _eq1;
-    MultiTap2<NEXTPOW2(M_MT7_MAX)> _mt7;
-
-    Allpass<NEXTPOW2(M_AP10)> _ap10;
-    Allpass<NEXTPOW2(M_AP11)> _ap11;
-    Allpass<NEXTPOW2(M_AP12)> _ap12;
-    Allpass<NEXTPOW2(M_AP13)> _ap13;
-    MultiTap2<NEXTPOW2(M_MT8_MAX)> _mt8;
+    MultiTap2<NEXTPOW2(MAX(M_MT6_MAX, M_MT7_MAX))> _mt6;
+
+    // Late, branches 2 and 3
+    Allpass<NEXTPOW2(MAX(M_AP10, M_AP14))> _ap10;
+    Allpass<NEXTPOW2(MAX(M_AP11, M_AP15))> _ap11;
+    Allpass<NEXTPOW2(MAX(M_AP12, M_AP16))> _ap12;
+    Allpass<NEXTPOW2(MAX(M_AP13, M_AP17))> _ap13;
+    MultiTap2<NEXTPOW2(MAX(M_MT8_MAX, M_MT9_MAX))> _mt8;
     LowpassEQ _lp0;
 
-    Allpass<NEXTPOW2(M_AP14)> _ap14;
-    Allpass<NEXTPOW2(M_AP15)> _ap15;
-    Allpass<NEXTPOW2(M_AP16)> _ap16;
-    Allpass<NEXTPOW2(M_AP17)> _ap17;
-    MultiTap2<NEXTPOW2(M_MT9_MAX)> _mt9;
-    LowpassEQ _lp1;
-
-    // Output Left
-    Allpass<NEXTPOW2(M_AP18)> _ap18;
-    Allpass<NEXTPOW2(M_AP19)> _ap19;
-
-    // Output Right
-    Allpass<NEXTPOW2(M_AP20)> _ap20;
-    Allpass<NEXTPOW2(M_AP21)> _ap21;
+    // Output
+    Allpass<NEXTPOW2(MAX(M_AP18, M_AP20))> _ap18;
+    Allpass<NEXTPOW2(MAX(M_AP19, M_AP21))> _ap19;
 
     float _earlyGain = 0.0f;
     float _wetDryMix = 0.0f;
@@ -1417,8 +1494,8 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     //
     int preDelay = (int)(p->preDelay * (1/1000.0f) * sampleRate + 0.5f);
     preDelay = MIN(MAX(preDelay, 1), M_PD0);
-    _dl0.setDelay(preDelay);
-    _dl1.setDelay(preDelay);
+    _dl.setDelay(0, preDelay);
+    _dl.setDelay(1, preDelay);
 
     // RoomSize scalefactor
     float roomSize = interpolateTable(roomSizeTable, p->roomSize);
@@ -1434,66 +1511,60 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     density3 = MIN(MAX(density3, 0.0f), 1.0f);
 
     // Early delays
-    _ap0.setDelay(scaleDelay(M_AP0 * 1.0f, sampleRate));
-    _ap1.setDelay(scaleDelay(M_AP1 * 1.0f, sampleRate));
-    _ap2.setDelay(scaleDelay(M_AP2 * 1.0f, sampleRate));
-    _ap3.setDelay(scaleDelay(M_AP3 * 1.0f, sampleRate));
-    _ap4.setDelay(scaleDelay(M_AP4 * 1.0f, sampleRate));
-    _ap5.setDelay(scaleDelay(M_AP5 * 1.0f, sampleRate));
-
-    _mt0.setDelay(scaleDelay(M_MT0 * roomSize, sampleRate), 1);
-    _mt1.setDelay(scaleDelay(M_MT1 * roomSize, sampleRate), scaleDelay(M_MT1_2 * 1.0f, sampleRate));
-    _mt2.setDelay(scaleDelay(M_MT2 * roomSize, sampleRate), 1);
-    _mt3.setDelay(scaleDelay(M_MT3 * roomSize, sampleRate), 1);
-    _mt4.setDelay(scaleDelay(M_MT4 * roomSize, sampleRate), scaleDelay(M_MT4_2 * 1.0f, sampleRate));
-    _mt5.setDelay(scaleDelay(M_MT5 * roomSize, sampleRate), 1);
+    _ap0.setDelay(0, scaleDelay(M_AP0 * 1.0f, sampleRate));
+    _ap1.setDelay(0, scaleDelay(M_AP1 * 1.0f, sampleRate));
+    _ap2.setDelay(0, scaleDelay(M_AP2 * 1.0f, sampleRate));
+    _ap0.setDelay(1, scaleDelay(M_AP3 * 1.0f, sampleRate));
+    _ap1.setDelay(1, scaleDelay(M_AP4 * 1.0f, sampleRate));
+    _ap2.setDelay(1, scaleDelay(M_AP5 * 1.0f, sampleRate));
+
+    _mt0.setDelay(0, scaleDelay(M_MT0 * roomSize, sampleRate), 1);
+    _mt1.setDelay(0, scaleDelay(M_MT1 * roomSize, sampleRate), scaleDelay(M_MT1_2 * 1.0f, sampleRate));
+    _mt2.setDelay(0, scaleDelay(M_MT2 * roomSize, sampleRate), 1);
+    _mt0.setDelay(1, scaleDelay(M_MT3 * roomSize, sampleRate), 1);
+    _mt1.setDelay(1, scaleDelay(M_MT4 * roomSize, sampleRate), scaleDelay(M_MT4_2 * 1.0f, sampleRate));
+    _mt2.setDelay(1, scaleDelay(M_MT5 * roomSize, sampleRate), 1);
 
     // Late delays
-    _ap6.setDelay(scaleDelay(M_AP6 * roomSize * density3, sampleRate));
-    _ap7.setDelay(scaleDelay(M_AP7 * roomSize, sampleRate));
-    _ap8.setDelay(scaleDelay(M_AP8 * roomSize * density3, sampleRate));
-    _ap9.setDelay(scaleDelay(M_AP9 * roomSize, sampleRate));
-    _ap10.setDelay(scaleDelay(M_AP10 * roomSize * density1, sampleRate));
-    _ap11.setDelay(scaleDelay(M_AP11 * roomSize * density2, sampleRate));
-    _ap12.setDelay(scaleDelay(M_AP12 * roomSize, sampleRate));
-    _ap13.setDelay(scaleDelay(M_AP13 * roomSize * density3, sampleRate));
-    _ap14.setDelay(scaleDelay(M_AP14 * roomSize * density1, sampleRate));
-    _ap15.setDelay(scaleDelay(M_AP15 * roomSize * density2, sampleRate));
-    _ap16.setDelay(scaleDelay(M_AP16 * roomSize * density3, sampleRate));
-    _ap17.setDelay(scaleDelay(M_AP17 * roomSize * density3, sampleRate));
+    _ap6.setDelay(0, scaleDelay(M_AP6 * roomSize * density3, sampleRate));
+    _ap7.setDelay(0, scaleDelay(M_AP7 * roomSize, sampleRate));
+    _ap6.setDelay(1, scaleDelay(M_AP8 * roomSize * density3, sampleRate));
+    _ap7.setDelay(1, scaleDelay(M_AP9 * roomSize, sampleRate));
+    _ap10.setDelay(0, scaleDelay(M_AP10 * roomSize * density1, sampleRate));
+    _ap11.setDelay(0, scaleDelay(M_AP11 * roomSize * density2, sampleRate));
+    _ap12.setDelay(0, scaleDelay(M_AP12 * roomSize, sampleRate));
+    _ap13.setDelay(0, scaleDelay(M_AP13 * roomSize * density3, sampleRate));
+    _ap10.setDelay(1, scaleDelay(M_AP14 * roomSize * density1, sampleRate));
+    _ap11.setDelay(1, scaleDelay(M_AP15 * roomSize * density2, sampleRate));
+    _ap12.setDelay(1, scaleDelay(M_AP16 * roomSize * density3, sampleRate));
+    _ap13.setDelay(1, scaleDelay(M_AP17 * roomSize * density3, sampleRate));
 
     int lateDelay = scaleDelay(p->lateDelay * (1/1000.0f) * 48000, sampleRate);
     lateDelay = MIN(MAX(lateDelay, 1), M_LD0);
 
-    _mt6.setDelay(scaleDelay(M_MT6 * roomSize * density3, sampleRate), lateDelay);
-    _mt7.setDelay(scaleDelay(M_MT7 * roomSize * density2, sampleRate), lateDelay);
-    _mt8.setDelay(scaleDelay(M_MT8 * roomSize * density0, sampleRate), lateDelay);
-    _mt9.setDelay(scaleDelay(M_MT9 * roomSize, sampleRate), lateDelay);
+    _mt6.setDelay(0, scaleDelay(M_MT6 * roomSize * density3, sampleRate), lateDelay);
+    _mt6.setDelay(1, scaleDelay(M_MT7 * roomSize * density2, sampleRate), lateDelay);
+    _mt8.setDelay(0, scaleDelay(M_MT8 * roomSize * density0, sampleRate), lateDelay);
+    _mt8.setDelay(1, scaleDelay(M_MT9 * roomSize, sampleRate), lateDelay);
 
     // Output delays
-    _ap18.setDelay(scaleDelay(M_AP18 * 1.0f, sampleRate));
-    _ap19.setDelay(scaleDelay(M_AP19 * 1.0f, sampleRate));
-    _ap20.setDelay(scaleDelay(M_AP20 * 1.0f, sampleRate));
-    _ap21.setDelay(scaleDelay(M_AP21 * 1.0f, sampleRate));
+    _ap18.setDelay(0, scaleDelay(M_AP18 * 1.0f, sampleRate));
+    _ap19.setDelay(0, scaleDelay(M_AP19 * 1.0f, sampleRate));
+    _ap18.setDelay(1, scaleDelay(M_AP20 * 1.0f, sampleRate));
+    _ap19.setDelay(1, scaleDelay(M_AP21 * 1.0f, sampleRate));
 
     // RT60 is determined by mean delay of feedback paths
-    int loopDelay;
-    loopDelay = _ap6.getDelay();
-    loopDelay += _ap7.getDelay();
-    loopDelay += _ap8.getDelay();
-    loopDelay += _ap9.getDelay();
-    loopDelay += _ap10.getDelay();
-    loopDelay += _ap11.getDelay();
-    loopDelay += _ap12.getDelay();
-    loopDelay += _ap13.getDelay();
-    loopDelay += _ap14.getDelay();
-    loopDelay += _ap15.getDelay();
-    loopDelay += _ap16.getDelay();
-    loopDelay += _ap17.getDelay();
-    loopDelay += _mt6.getDelay(0);
-    loopDelay += _mt7.getDelay(0);
-    loopDelay += _mt8.getDelay(0);
-    loopDelay += _mt9.getDelay(0);
+    int loopDelay = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        loopDelay += _ap6.getDelay(lane);
+        loopDelay += _ap7.getDelay(lane);
+        loopDelay += _ap10.getDelay(lane);
+        loopDelay += _ap11.getDelay(lane);
+        loopDelay += _ap12.getDelay(lane);
+        loopDelay += _ap13.getDelay(lane);
+        loopDelay += _mt6.getDelay(lane, 0);
+        loopDelay += _mt8.getDelay(lane, 0);
+    }
     loopDelay /= 2;
 
     //
@@ -1510,41 +1581,35 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
 
     // Damping
     _eq0.setCoef(bassGain, p->highGain, p->bassFreq, p->highFreq, sampleRate);
-    _eq1.setCoef(bassGain, p->highGain, p->bassFreq, p->highFreq, sampleRate);
     _lp0.setFreq(sampleRate);
-    _lp1.setFreq(sampleRate);
 
     float earlyDiffusionCoef = interpolateTable(diffusionCoefTable, p->earlyDiffusion);
 
-    // Early Left
-    _earlyMix1L = interpolateTable(earlyMix1Table, p->earlyMixRight);
-    _earlyMix2L = interpolateTable(earlyMix2Table, p->earlyMixLeft);
-
-    _mt0.setGain(0.2f, 0.4f, interpolateTable(earlyMix0Table, p->earlyMixLeft));
-
     _ap0.setCoef(earlyDiffusionCoef);
     _ap1.setCoef(earlyDiffusionCoef);
     _ap2.setCoef(earlyDiffusionCoef);
 
-    _mt1.setGain(0.2f, 0.6f, interpolateTable(lateMix0Table, p->lateMixLeft) * 0.125f);
+    // Early Left
+    _earlyMix1[0] = interpolateTable(earlyMix1Table, p->earlyMixRight);
+    _earlyMix2[0] = interpolateTable(earlyMix2Table, p->earlyMixLeft);
 
-    _mt2.setGain(interpolateTable(lateMix1Table, p->lateMixLeft) * loopGain2, 
-                 interpolateTable(lateMix2Table, p->lateMixLeft) * loopGain2);
+    _mt0.setGain(0, 0.2f, 0.4f, interpolateTable(earlyMix0Table, p->earlyMixLeft));
 
-    // Early Right
-    _earlyMix1R = interpolateTable(earlyMix1Table, p->earlyMixLeft);
-    _earlyMix2R = interpolateTable(earlyMix2Table, p->earlyMixRight);
+    _mt1.setGain(0, 0.2f, 0.6f, interpolateTable(lateMix0Table, p->lateMixLeft) * 0.125f);
 
-    _mt3.setGain(0.2f, 0.4f, interpolateTable(earlyMix0Table, p->earlyMixRight));
+    _mt2.setGain(0, interpolateTable(lateMix1Table, p->lateMixLeft) * loopGain2, 
+                    interpolateTable(lateMix2Table, p->lateMixLeft) * loopGain2);
 
-    _ap3.setCoef(earlyDiffusionCoef);
-    _ap4.setCoef(earlyDiffusionCoef);
-    _ap5.setCoef(earlyDiffusionCoef);
+    // Early Right
+    _earlyMix1[1] = interpolateTable(earlyMix1Table, p->earlyMixLeft);
+    _earlyMix2[1] = interpolateTable(earlyMix2Table, p->earlyMixRight);
+
+    _mt0.setGain(1, 0.2f, 0.4f, interpolateTable(earlyMix0Table, p->earlyMixRight));
 
-    _mt4.setGain(0.2f, 0.6f, interpolateTable(lateMix0Table, p->lateMixRight) * 0.125f);
+    _mt1.setGain(1, 0.2f, 0.6f, interpolateTable(lateMix0Table, p->lateMixRight) * 0.125f);
 
-    _mt5.setGain(interpolateTable(lateMix1Table, p->lateMixRight) * loopGain2, 
-                 interpolateTable(lateMix2Table, p->lateMixRight) * loopGain2);
+    _mt2.setGain(1, interpolateTable(lateMix1Table, p->lateMixRight) * loopGain2, 
+                    interpolateTable(lateMix2Table, p->lateMixRight) * loopGain2);
 
     _earlyGain = dBToGain(p->earlyGain);
 
@@ -1552,31 +1617,22 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     float lateDiffusionCoef = interpolateTable(diffusionCoefTable, p->lateDiffusion);
     _ap6.setCoef(lateDiffusionCoef);
     _ap7.setCoef(lateDiffusionCoef);
-    _ap8.setCoef(lateDiffusionCoef);
-    _ap9.setCoef(lateDiffusionCoef);
 
     _ap10.setCoef(PHI);
     _ap11.setCoef(PHI);
     _ap12.setCoef(lateDiffusionCoef);
     _ap13.setCoef(lateDiffusionCoef);
 
-    _ap14.setCoef(PHI);
-    _ap15.setCoef(PHI);
-    _ap16.setCoef(lateDiffusionCoef);
-    _ap17.setCoef(lateDiffusionCoef);
-
     float lateGain = dBToGain(p->lateGain) * 2.0f;
-    _mt6.setGain(loopGain1, lateGain * interpolateTable(lateMix0Table, p->lateMixLeft));
-    _mt7.setGain(loopGain1, lateGain * interpolateTable(lateMix0Table, p->lateMixRight));
-    _mt8.setGain(loopGain1, lateGain * interpolateTable(lateMix2Table, p->lateMixLeft) * loopGain2 * 0.125f);
-    _mt9.setGain(loopGain1, lateGain * interpolateTable(lateMix2Table, p->lateMixRight) * loopGain2 * 0.125f);
+    _mt6.setGain(0, loopGain1, lateGain * interpolateTable(lateMix0Table, p->lateMixLeft));
+    _mt6.setGain(1, loopGain1, lateGain * interpolateTable(lateMix0Table, p->lateMixRight));
+    _mt8.setGain(0, loopGain1, lateGain * interpolateTable(lateMix2Table, p->lateMixLeft) * loopGain2 * 0.125f);
+    _mt8.setGain(1, loopGain1, lateGain * interpolateTable(lateMix2Table, p->lateMixRight) * loopGain2 * 0.125f);
 
     // Output
     float outputDiffusionCoef = lateDiffusionCoef * 0.6f;
     _ap18.setCoef(outputDiffusionCoef);
     _ap19.setCoef(outputDiffusionCoef);
-    _ap20.setCoef(outputDiffusionCoef);
-    _ap21.setCoef(outputDiffusionCoef);
 
     _wetDryMix = p->wetDryMix * (1/100.0f);
     _wetDryMix = MIN(MAX(_wetDryMix, 0.0f), 1.0f);
@@ -1584,91 +1640,63 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
 
 void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
 
+    Float2 earlyMix1 = Float2::load(_earlyMix1);
+    Float2 earlyMix2 = Float2::load(_earlyMix2);
+    Float2 earlyGain(_earlyGain);
+    Float2 wetDryMix(_wetDryMix);
+
     for (int i = 0; i < numFrames; i++) {
-        float x0, x1, y0, y1, y2, y3;
+        Float2 x0, x1, y0, y1, y2;
 
         // Preprocess
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        _bw.process(x0, x1, x0, x1);
+        Float2 input(inputs[0][i], inputs[1][i]);
+        _bw.process(input, x0);
 
-        float preL, preR;
-        _dl0.process(x0, preL);
-        _dl1.process(x1, preR);
+        Float2 pre;
+        _dl.process(x0, pre);
 
-        // Early Left
-        float early0L, early1L, early2L, earlyOutL;
-        _mt0.process(preL, x0, x1, y0);
+        // Early
+        Float2 early0, early1, early2, earlyOut;
+        _mt0.process(pre, x0, x1, y0);
         _ap0.process(x0 + x1, y1);
-        _mt1.process(y1, x0, x1, early0L);
+        _mt1.process(y1, x0, x1, early0);
         _ap1.process(x0 + x1, y2);
         _ap2.process(y2, x0);
-        _mt2.process(x0, early1L, early2L);
+        _mt2.process(x0, early1, early2);
 
-        earlyOutL = (y0 + y1 * _earlyMix1L + y2 * _earlyMix2L) * _earlyGain;
-
-        // Early Right
-        float early0R, early1R, early2R, earlyOutR;
-        _mt3.process(preR, x0, x1, y0);
-        _ap3.process(x0 + x1, y1);
-        _mt4.process(y1, x0, x1, early0R);
-        _ap4.process(x0 + x1, y2);
-        _ap5.process(y2, x0);
-        _mt5.process(x0, early1R, early2R);
-
-        earlyOutR = (y0 + y1 * _earlyMix1R + y2 * _earlyMix2R) * _earlyGain;
+        earlyOut = (y0 + y1 * earlyMix1 + y2 * earlyMix2) * earlyGain;
 
         // LFO update
         int32_t lfoSin, lfoCos;
         _lfo.process(lfoSin, lfoCos);
 
-        // Late
-        float lateOut0;
+        // Late, branches 0 and 1
+        Float2 lateOut01, loop01;
         _ap6.getOutput(x0);
-        _ap7.process(x0, lfoSin, x0);
-        _eq0.process(-early0L + x0, x0);
-        _mt6.process(x0, y0, lateOut0);
+        _ap7.process(x0, lfoSin, lfoCos, x0);
+        _eq0.process(-early0 + x0, x0);
+        _mt6.process(x0, loop01, lateOut01);
 
-        float lateOut1;
-        _ap8.getOutput(x0);
-        _ap9.process(x0, lfoCos, x0);
-        _eq1.process(-early0R + x0, x0);
-        _mt7.process(x0, y1, lateOut1);
-
-        float lateOut2;
+        // Late, branches 2 and 3
+        Float2 lateOut23, loop23;
         _ap10.getOutput(x0);
-        _ap11.process(-early2L + x0, x0);
+        _ap11.process(-early2 + x0, x0);
         _ap12.process(x0, x0);
-        _ap13.process(-early2L - x0, x0);
-        _mt8.process(-early0L + x0, x0, lateOut2);
-        _lp0.process(x0, y2);
-
-        float lateOut3;
-        _ap14.getOutput(x0);
-        _ap15.process(-early2R + x0, x0);
-        _ap16.process(x0, x0);
-        _ap17.process(-early2R - x0, x0);
-        _mt9.process(-early0R + x0, x0, lateOut3);
-        _lp1.process(x0, y3);
+        _ap13.process(-early2 - x0, x0);
+        _mt8.process(-early0 + x0, x0, lateOut23);
+        _lp0.process(x0, loop23);
 
         // Feedback matrix
-        _ap6.process(early1L + y2 - y3, x0);
-        _ap8.process(early1R - y2 - y3, x0);
-        _ap10.process(-early2R + y0 + y1, x0);
-        _ap14.process(-early2L - y0 + y1, x0);
+        _ap6.process(early1 + loop23.broadcast0().negated1() - loop23.broadcast1(), x0);
+        _ap10.process(-early2.swapped() + loop01.broadcast0().negated1() + loop01.broadcast1(), x0);
 
-        // Output Left
-        _ap18.process(-earlyOutL + lateOut0 + lateOut3, x0);
+        // Output, left from late branches 0 and 3, right from late branches 1 and 2
+        _ap18.process(-earlyOut + lateOut01 + lateOut23.swapped(), x0);
         _ap19.process(x0, y0);
 
-        // Output Right
-        _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
-        _ap21.process(x1, y1);
-
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        outputs[0][i] = x0 + (y0 - x0) * _wetDryMix;
-        outputs[1][i] = x1 + (y1 - x1) * _wetDryMix;
+        Float2 output = input + (y0 - input) * wetDryMix;
+        outputs[0][i] = output.get0();
+        outputs[1][i] = output.get1();
     }
 }
 
@@ -1677,48 +1705,29 @@ void ReverbImpl::reset() {
 
     _bw.reset();
 
-    _dl0.reset();
-    _dl1.reset();
+    _dl.reset();
 
     _mt0.reset();
     _mt1.reset();
     _mt2.reset();
-    _mt3.reset();
-    _mt4.reset();
-    _mt5.reset();
     _mt6.reset();
-    _mt7.reset();
     _mt8.reset();
-    _mt9.reset();
 
     _ap0.reset();
     _ap1.reset();
     _ap2.reset();
-    _ap3.reset();
-    _ap4.reset();
-    _ap5.reset();
     _ap6.reset();
     _ap7.reset();
-    _ap8.reset();
-    _ap9.reset();
     _ap10.reset();
     _ap11.reset();
     _ap12.reset();
     _ap13.reset();
-    _ap14.reset();
-    _ap15.reset();
-    _ap16.reset();
-    _ap17.reset();
     _ap18.reset();
     _ap19.reset();
-    _ap20.reset();
-    _ap21.reset();
 
     _eq0.reset();
-    _eq1.reset();
 
     _lp0.reset();
-    _lp1.reset();
 }
 
 //
@@ -0,0 +1,131 @@
+//
+//  AudioSPSCRingBuffer.cpp
+//  libraries/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "AudioSPSCRingBuffer.h"
+
+template <class T>
+AudioSPSCRingBufferTemplate<T>::AudioSPSCRingBufferTemplate(int sampleCapacity) {
+    resize(sampleCapacity);
+}
+
+template <class T>
+AudioSPSCRingBufferTemplate<T>::~AudioSPSCRingBufferTemplate() {
+    delete[] _buffer;
+}
+
+template <class T>
+void AudioSPSCRingBufferTemplate<T>::resize(int sampleCapacity) {
+    delete[] _buffer;
+    _sampleCapacity = std::max(sampleCapacity, 0);
+    _bufferLength = _sampleCapacity + 1;
+
+    _buffer = new Sample[_bufferLength];
+    memset(_buffer, 0, _bufferLength * SampleSize);
+
+    _readIndex.store(0, std::memory_order_relaxed);
+    _writeIndex.store(0, std::memory_order_release);
+}
+
+template <class T>
+void AudioSPSCRingBufferTemplate<T>::clear() {
+    _readIndex.store(_writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+template <class T>
+uint32_t AudioSPSCRingBufferTemplate<T>::advance(uint32_t index, int numSamples) const {
+    index += numSamples;
+    return index >= (uint32_t)_bufferLength ? index - _bufferLength : index;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::distance(uint32_t readIndex, uint32_t writeIndex) const {
+    return writeIndex >= readIndex ? writeIndex - readIndex : writeIndex + _bufferLength - readIndex;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::samplesAvailable() const {
+    // each load is only ever behind the other thread, so this is never more than what is actually available
+    return distance(_readIndex.load(std::memory_order_acquire), _writeIndex.load(std::memory_order_acquire));
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::writeSamples(const Sample* source, int maxSamples) {
+    uint32_t writeIndex = _writeIndex.load(std::memory_order_relaxed);
+    uint32_t readIndex = _readIndex.load(std::memory_order_acquire);
+
+    int numSamples = std::min(maxSamples, _sampleCapacity - distance(readIndex, writeIndex));
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    // write to the end of the buffer, then the rest from the beginning
+    int numSamplesToEnd = std::min(numSamples, _bufferLength - (int)writeIndex);
+    memcpy(_buffer + writeIndex, source, numSamplesToEnd * SampleSize);
+    memcpy(_buffer, source + numSamplesToEnd, (numSamples - numSamplesToEnd) * SampleSize);
+
+    // publish the samples to the consumer
+    _writeIndex.store(advance(writeIndex, numSamples), std::memory_order_release);
+
+    return numSamples;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::readSamples(Sample* destination, int maxSamples) {
+    return appendSamples(destination, maxSamples, false);
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::appendSamples(Sample* destination, int maxSamples, bool append) {
+    uint32_t readIndex = _readIndex.load(std::memory_order_relaxed);
+    uint32_t writeIndex = _writeIndex.load(std::memory_order_acquire);
+
+    int numSamples = std::min(maxSamples, distance(readIndex, writeIndex));
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    // read to the end of the buffer, then the rest from the beginning
+    int numSamplesToEnd = std::min(numSamples, _bufferLength - (int)readIndex);
+    const Sample* output = _buffer + readIndex;
+    if (append) {
+        for (int i = 0; i < numSamplesToEnd; i++) {
+            destination[i] += output[i];
+        }
+        for (int i = numSamplesToEnd; i < numSamples; i++) {
+            destination[i] += _buffer[i - numSamplesToEnd];
+        }
+    } else {
+        memcpy(destination, output, numSamplesToEnd * SampleSize);
+        memcpy(destination + numSamplesToEnd, _buffer, (numSamples - numSamplesToEnd) * SampleSize);
+    }
+
+    // release the space to the producer
+    _readIndex.store(advance(readIndex, numSamples), std::memory_order_release);
+
+    return numSamples;
+}
+
+template <class T>
+void AudioSPSCRingBufferTemplate<T>::skipSamples(int maxSamples) {
+    uint32_t readIndex = _readIndex.load(std::memory_order_relaxed);
+    uint32_t writeIndex = _writeIndex.load(std::memory_order_acquire);
+
+    int numSamples = std::min(maxSamples, distance(readIndex, writeIndex));
+    if (numSamples > 0) {
+        _readIndex.store(advance(readIndex, numSamples), std::memory_order_release);
+    }
+}
+
+// explicit instantiations for scratch/mix buffers
+template class AudioSPSCRingBufferTemplate<int16_t>;
+template class AudioSPSCRingBufferTemplate<float>;
@@ -0,0 +1,87 @@
+//
+//  AudioSPSCRingBuffer.h
+//  libraries/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSPSCRingBuffer_h
+#define hifi_AudioSPSCRingBuffer_h
+
+#include <atomic>
+#include <cstdint>
+
+// A wait-free ring buffer for a single producer thread and a single consumer thread,
+// such as a worker thread feeding the audio device callback.
+//   writeSamples may only be called from the producer; readSamples, appendSamples, skipSamples and clear
+//   only from the consumer. Neither side ever blocks, reads and writes are truncated to what is available.
+//   resize is not thread-safe, neither side may be running while it is called.
+template <class T>
+class AudioSPSCRingBufferTemplate {
+    using Sample = T;
+    static const int SampleSize = sizeof(Sample);
+
+public:
+    AudioSPSCRingBufferTemplate(int sampleCapacity = 0);
+    ~AudioSPSCRingBufferTemplate();
+
+    // disallow copying
+    AudioSPSCRingBufferTemplate(const AudioSPSCRingBufferTemplate&) = delete;
+    AudioSPSCRingBufferTemplate(AudioSPSCRingBufferTemplate&&) = delete;
+    AudioSPSCRingBufferTemplate& operator=(const AudioSPSCRingBufferTemplate&) = delete;
+
+    /// Resize the buffer (discards any data in the buffer)
+    void resize(int sampleCapacity);
+
+    /// Discard any data in the buffer (consumer only)
+    void clear();
+
+    /// Write up to maxSamples from source (will only write up to samplesFree())
+    /// Returns number of written samples
+    int writeSamples(const Sample* source, int maxSamples);
+
+    /// Read up to maxSamples into destination (will only read up to samplesAvailable())
+    /// Returns number of read samples
+    int readSamples(Sample* destination, int maxSamples);
+
+    /// Add up to maxSamples into destination (will only read up to samplesAvailable())
+    /// If append == false, behaves as readSamples
+    /// Returns number of appended samples
+    int appendSamples(Sample* destination, int maxSamples, bool append = true);
+
+    /// Skip up to maxSamples (will only skip up to samplesAvailable())
+    void skipSamples(int maxSamples);
+
+    int samplesAvailable() const;
+    int samplesFree() const { return _sampleCapacity - samplesAvailable(); }
+    int getSampleCapacity() const { return _sampleCapacity; }
+
+    bool isLockFree() const { return _readIndex.is_lock_free() && _writeIndex.is_lock_free(); }
+
+private:
+    static const int CACHE_LINE_SIZE = 64;
+    using Index = std::atomic<uint32_t>;
+
+    uint32_t advance(uint32_t index, int numSamples) const;
+    int distance(uint32_t readIndex, uint32_t writeIndex) const;
+
+    Sample* _buffer { nullptr };
+    int _sampleCapacity { 0 };
+    int _bufferLength { 0 }; // actual _buffer length (_sampleCapacity + 1), so that a full buffer is not empty
+
+    // the indices are written by different threads, keep them on separate cache lines
+    char _beforeReadPadding[CACHE_LINE_SIZE];
+    Index _readIndex { 0 }; // written by the consumer
+    char _afterReadPadding[CACHE_LINE_SIZE - sizeof(Index)];
+    Index _writeIndex { 0 }; // written by the producer
+    char _afterWritePadding[CACHE_LINE_SIZE - sizeof(Index)];
+};
+
+// expose explicit instantiations for scratch/mix buffers
+using AudioSPSCRingBuffer = AudioSPSCRingBufferTemplate<int16_t>;
+using AudioSPSCMixRingBuffer = AudioSPSCRingBufferTemplate<float>;
+
+#endif // hifi_AudioSPSCRingBuffer_h
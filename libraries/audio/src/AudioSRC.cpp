@@ -427,6 +427,310 @@ int AudioSRC::multirateFilter4_ref(const float* input0, const float* input1, con
 
 #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 
+//
+// SSE2 versions, for x86 without AVX2
+//
+#include <emmintrin.h>  // SSE2
+
+int AudioSRC::multirateFilter1_SSE(const float* input0, float* output0, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                //float coef = c0[j];
+                __m128 coef0 = _mm_load_ps(&c0[j + 0]);  // aligned
+                __m128 coef1 = _mm_load_ps(&c0[j + 4]);  // aligned
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+            }
+            acc0 = _mm_add_ps(acc0, acc1);
+
+            // horizontal sum
+            acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+            acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1,1,1,1)));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            __m128 frac = _mm_set1_ps((f & SRC_FRACMASK) * QFRAC_TO_FLOAT);
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                __m128 coef0 = _mm_load_ps(&c0[j + 0]);  // aligned
+                __m128 coef1 = _mm_load_ps(&c0[j + 4]);  // aligned
+                __m128 coef2 = _mm_load_ps(&c1[j + 0]);  // aligned
+                __m128 coef3 = _mm_load_ps(&c1[j + 4]);  // aligned
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                coef0 = _mm_add_ps(coef0, _mm_mul_ps(_mm_sub_ps(coef2, coef0), frac));
+                coef1 = _mm_add_ps(coef1, _mm_mul_ps(_mm_sub_ps(coef3, coef1), frac));
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+            }
+            acc0 = _mm_add_ps(acc0, acc1);
+
+            // horizontal sum
+            acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+            acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1,1,1,1)));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
+int AudioSRC::multirateFilter2_SSE(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                //float coef = c0[j];
+                __m128 coef0 = _mm_load_ps(&c0[j + 0]);  // aligned
+                __m128 coef1 = _mm_load_ps(&c0[j + 4]);  // aligned
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            __m128 t0 = _mm_add_ps(_mm_unpacklo_ps(acc0, acc1), _mm_unpackhi_ps(acc0, acc1));
+            t0 = _mm_add_ps(t0, _mm_movehl_ps(t0, t0));
+
+            _mm_store_ss(&output0[outputFrames], t0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(1,1,1,1)));
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            __m128 frac = _mm_set1_ps((f & SRC_FRACMASK) * QFRAC_TO_FLOAT);
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                __m128 coef0 = _mm_load_ps(&c0[j + 0]);  // aligned
+                __m128 coef1 = _mm_load_ps(&c0[j + 4]);  // aligned
+                __m128 coef2 = _mm_load_ps(&c1[j + 0]);  // aligned
+                __m128 coef3 = _mm_load_ps(&c1[j + 4]);  // aligned
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                coef0 = _mm_add_ps(coef0, _mm_mul_ps(_mm_sub_ps(coef2, coef0), frac));
+                coef1 = _mm_add_ps(coef1, _mm_mul_ps(_mm_sub_ps(coef3, coef1), frac));
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            __m128 t0 = _mm_add_ps(_mm_unpacklo_ps(acc0, acc1), _mm_unpackhi_ps(acc0, acc1));
+            t0 = _mm_add_ps(t0, _mm_movehl_ps(t0, t0));
+
+            _mm_store_ss(&output0[outputFrames], t0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(1,1,1,1)));
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
+int AudioSRC::multirateFilter4_SSE(const float* input0, const float* input1, const float* input2, const float* input3, 
+                                   float* output0, float* output1, float* output2, float* output3, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            __m128 acc2 = _mm_setzero_ps();
+            __m128 acc3 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                //float coef = c0[j];
+                __m128 coef0 = _mm_load_ps(&c0[j + 0]);  // aligned
+                __m128 coef1 = _mm_load_ps(&c0[j + 4]);  // aligned
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 0]), coef0));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 4]), coef1));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+            acc0 = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1,1,1,1)));
+            _mm_store_ss(&output2[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(2,2,2,2)));
+            _mm_store_ss(&output3[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(3,3,3,3)));
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            __m128 frac = _mm_set1_ps((f & SRC_FRACMASK) * QFRAC_TO_FLOAT);
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            __m128 acc2 = _mm_setzero_ps();
+            __m128 acc3 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                __m128 coef0 = _mm_load_ps(&c0[j + 0]);  // aligned
+                __m128 coef1 = _mm_load_ps(&c0[j + 4]);  // aligned
+                __m128 coef2 = _mm_load_ps(&c1[j + 0]);  // aligned
+                __m128 coef3 = _mm_load_ps(&c1[j + 4]);  // aligned
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                coef0 = _mm_add_ps(coef0, _mm_mul_ps(_mm_sub_ps(coef2, coef0), frac));
+                coef1 = _mm_add_ps(coef1, _mm_mul_ps(_mm_sub_ps(coef3, coef1), frac));
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 0]), coef0));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 4]), coef1));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+            acc0 = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1,1,1,1)));
+            _mm_store_ss(&output2[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(2,2,2,2)));
+            _mm_store_ss(&output3[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(3,3,3,3)));
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
 //
 // Runtime CPU dispatch
 //
@@ -434,18 +738,18 @@ int AudioSRC::multirateFilter4_ref(const float* input0, const float* input1, con
 #include "CPUDetect.h"
 
 int AudioSRC::multirateFilter1(const float* input0, float* output0, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter1_AVX2 : &AudioSRC::multirateFilter1_ref;
+    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter1_AVX2 : &AudioSRC::multirateFilter1_SSE;
     return (this->*f)(input0, output0, inputFrames);    // dispatch
 }
 
 int AudioSRC::multirateFilter2(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter2_AVX2 : &AudioSRC::multirateFilter2_ref;
+    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter2_AVX2 : &AudioSRC::multirateFilter2_SSE;
     return (this->*f)(input0, input1, output0, output1, inputFrames);   // dispatch
 }
 
 int AudioSRC::multirateFilter4(const float* input0, const float* input1, const float* input2, const float* input3, 
                                float* output0, float* output1, float* output2, float* output3, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter4_AVX2 : &AudioSRC::multirateFilter4_ref;
+    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter4_AVX2 : &AudioSRC::multirateFilter4_SSE;
     return (this->*f)(input0, input1, input2, input3, output0, output1, output2, output3, inputFrames); // dispatch
 }
 
@@ -1169,6 +1473,274 @@ void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
     }
 }
 
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+// convert int16_t to float, deinterleave stereo
+void AudioSRC::convertInput(const int16_t* input, float** outputs, int numFrames) {
+    const float scale = 1/32768.0f;
+
+    if (_numChannels == 1) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            int16x4_t a0 = vld1_s16(&input[i]);
+
+            vst1q_f32(&outputs[0][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a0)), scale));
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[i] * scale;
+        }
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleave
+            int16x4x2_t a0 = vld2_s16(&input[2*i]);
+
+            vst1q_f32(&outputs[0][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a0.val[0])), scale));
+            vst1q_f32(&outputs[1][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a0.val[1])), scale));
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[2*i + 0] * scale;
+            outputs[1][i] = (float)input[2*i + 1] * scale;
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleave
+            int16x4x4_t a0 = vld4_s16(&input[4*i]);
+
+            vst1q_f32(&outputs[0][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a0.val[0])), scale));
+            vst1q_f32(&outputs[1][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a0.val[1])), scale));
+            vst1q_f32(&outputs[2][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a0.val[2])), scale));
+            vst1q_f32(&outputs[3][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a0.val[3])), scale));
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[4*i + 0] * scale;
+            outputs[1][i] = (float)input[4*i + 1] * scale;
+            outputs[2][i] = (float)input[4*i + 2] * scale;
+            outputs[3][i] = (float)input[4*i + 3] * scale;
+        }
+    }
+}
+
+// fast TPDF dither in [-1.0f, 1.0f]
+static inline float32x4_t dither4() {
+    static const int16_t mul[8] = { -3495, 30185, -27591, 19445, -23279, -5975, -25511, 25173 };
+    static const int16_t add[8] = { 28013, -13225, -32679, -7701, -19675, 105, -32767, 13849 };
+    static int16x8_t rz = vdupq_n_s16(0);
+
+    // update the 8 different maximum-length LCGs
+    rz = vmlaq_s16(vld1q_s16(add), rz, vld1q_s16(mul));
+
+    // promote to 32-bit
+    uint16x8_t ru = vreinterpretq_u16_s16(rz);
+    int32x4_t r0 = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(ru)));
+    int32x4_t r1 = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(ru)));
+
+    // return (r0 - r1) * (1/65536.0f);
+    return vmulq_n_f32(vcvtq_f32_s32(vsubq_s32(r0, r1)), 1/65536.0f);
+}
+
+// round and saturate
+static inline int16x4_t roundToInt16(float32x4_t f) {
+    // round half away from zero, conversion truncates and saturates
+    uint32x4_t isNegative = vcltq_f32(f, vdupq_n_f32(0.0f));
+    f = vaddq_f32(f, vbslq_f32(isNegative, vdupq_n_f32(-0.5f), vdupq_n_f32(+0.5f)));
+    return vqmovn_s32(vcvtq_s32_f32(f));
+}
+
+// convert float to int16_t with dither, interleave stereo
+void AudioSRC::convertOutput(float** inputs, int16_t* output, int numFrames) {
+    const float scale = 32768.0f;
+
+    if (_numChannels == 1) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+
+            f0 = vaddq_f32(f0, dither4());
+
+            vst1_s16(&output[i], roundToInt16(f0));
+        }
+        for (; i < numFrames; i++) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_dup_f32(&inputs[0][i]), scale);
+
+            f0 = vaddq_f32(f0, dither4());
+
+            vst1_lane_s16(&output[i], roundToInt16(f0), 0);
+        }
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+            float32x4_t f1 = vmulq_n_f32(vld1q_f32(&inputs[1][i]), scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+
+            // interleave
+            int16x4x2_t a0;
+            a0.val[0] = roundToInt16(f0);
+            a0.val[1] = roundToInt16(f1);
+            vst2_s16(&output[2*i], a0);
+        }
+        for (; i < numFrames; i++) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_dup_f32(&inputs[0][i]), scale);
+            float32x4_t f1 = vmulq_n_f32(vld1q_dup_f32(&inputs[1][i]), scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+
+            // interleave
+            vst1_lane_s16(&output[2*i + 0], roundToInt16(f0), 0);
+            vst1_lane_s16(&output[2*i + 1], roundToInt16(f1), 0);
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+            float32x4_t f1 = vmulq_n_f32(vld1q_f32(&inputs[1][i]), scale);
+            float32x4_t f2 = vmulq_n_f32(vld1q_f32(&inputs[2][i]), scale);
+            float32x4_t f3 = vmulq_n_f32(vld1q_f32(&inputs[3][i]), scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+            f2 = vaddq_f32(f2, d0);
+            f3 = vaddq_f32(f3, d0);
+
+            // interleave
+            int16x4x4_t a0;
+            a0.val[0] = roundToInt16(f0);
+            a0.val[1] = roundToInt16(f1);
+            a0.val[2] = roundToInt16(f2);
+            a0.val[3] = roundToInt16(f3);
+            vst4_s16(&output[4*i], a0);
+        }
+        for (; i < numFrames; i++) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_dup_f32(&inputs[0][i]), scale);
+            float32x4_t f1 = vmulq_n_f32(vld1q_dup_f32(&inputs[1][i]), scale);
+            float32x4_t f2 = vmulq_n_f32(vld1q_dup_f32(&inputs[2][i]), scale);
+            float32x4_t f3 = vmulq_n_f32(vld1q_dup_f32(&inputs[3][i]), scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+            f2 = vaddq_f32(f2, d0);
+            f3 = vaddq_f32(f3, d0);
+
+            // interleave
+            vst1_lane_s16(&output[4*i + 0], roundToInt16(f0), 0);
+            vst1_lane_s16(&output[4*i + 1], roundToInt16(f1), 0);
+            vst1_lane_s16(&output[4*i + 2], roundToInt16(f2), 0);
+            vst1_lane_s16(&output[4*i + 3], roundToInt16(f3), 0);
+        }
+    }
+}
+
+// deinterleave stereo
+void AudioSRC::convertInput(const float* input, float** outputs, int numFrames) {
+
+    if (_numChannels == 1) {
+
+        memcpy(outputs[0], input, numFrames * sizeof(float));
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleave
+            float32x4x2_t f0 = vld2q_f32(&input[2*i]);
+
+            vst1q_f32(&outputs[0][i], f0.val[0]);
+            vst1q_f32(&outputs[1][i], f0.val[1]);
+        }
+        for (; i < numFrames; i++) {
+            // deinterleave
+            outputs[0][i] = input[2*i + 0];
+            outputs[1][i] = input[2*i + 1];
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleave
+            float32x4x4_t f0 = vld4q_f32(&input[4*i]);
+
+            vst1q_f32(&outputs[0][i], f0.val[0]);
+            vst1q_f32(&outputs[1][i], f0.val[1]);
+            vst1q_f32(&outputs[2][i], f0.val[2]);
+            vst1q_f32(&outputs[3][i], f0.val[3]);
+        }
+        for (; i < numFrames; i++) {
+            // deinterleave
+            outputs[0][i] = input[4*i + 0];
+            outputs[1][i] = input[4*i + 1];
+            outputs[2][i] = input[4*i + 2];
+            outputs[3][i] = input[4*i + 3];
+        }
+    }
+}
+
+// interleave stereo
+void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
+
+    if (_numChannels == 1) {
+
+        memcpy(output, inputs[0], numFrames * sizeof(float));
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // interleave
+            float32x4x2_t f0;
+            f0.val[0] = vld1q_f32(&inputs[0][i]);
+            f0.val[1] = vld1q_f32(&inputs[1][i]);
+            vst2q_f32(&output[2*i], f0);
+        }
+        for (; i < numFrames; i++) {
+            // interleave
+            output[2*i + 0] = inputs[0][i];
+            output[2*i + 1] = inputs[1][i];
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // interleave
+            float32x4x4_t f0;
+            f0.val[0] = vld1q_f32(&inputs[0][i]);
+            f0.val[1] = vld1q_f32(&inputs[1][i]);
+            f0.val[2] = vld1q_f32(&inputs[2][i]);
+            f0.val[3] = vld1q_f32(&inputs[3][i]);
+            vst4q_f32(&output[4*i], f0);
+        }
+        for (; i < numFrames; i++) {
+            // interleave
+            output[4*i + 0] = inputs[0][i];
+            output[4*i + 1] = inputs[1][i];
+            output[4*i + 2] = inputs[2][i];
+            output[4*i + 3] = inputs[3][i];
+        }
+    }
+}
+
 #else   // portable reference code
 
 // convert int16_t to float, deinterleave stereo
@@ -188,7 +188,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     }
     // if the ringbuffer exceeds the desired size by more than the threshold specified,
     // drop the oldest frames so the ringbuffer is down to the desired size.
-    if (framesAvailable > _desiredJitterBufferFrames + MAX_FRAMES_OVER_DESIRED) {
+    if (framesAvailable > _desiredJitterBufferFrames + _maxFramesOverDesired) {
         int framesToDrop = framesAvailable - (_desiredJitterBufferFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING);
         _ringBuffer.shiftReadPosition(framesToDrop * _ringBuffer.getNumFrameSamples());
         
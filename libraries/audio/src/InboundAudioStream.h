@@ -69,6 +69,10 @@ public:
     void setDynamicJitterBufferEnabled(bool enable);
     void setStaticJitterBufferFrames(int staticJitterBufferFrames);
 
+    /// frames buffered beyond the desired jitter buffer frames before the oldest are dropped (caps added latency)
+    void setMaxFramesOverDesired(int maxFramesOverDesired) { _maxFramesOverDesired = maxFramesOverDesired; }
+    int getMaxFramesOverDesired() const { return _maxFramesOverDesired; }
+
     virtual AudioStreamStats getAudioStreamStats() const;
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
@@ -149,6 +153,7 @@ protected:
     bool _dynamicJitterBufferEnabled { DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED };
     int _staticJitterBufferFrames { DEFAULT_STATIC_JITTER_FRAMES };
     int _desiredJitterBufferFrames;
+    int _maxFramesOverDesired { MAX_FRAMES_OVER_DESIRED };
 
     bool _isStarved { true };
     bool _hasStarted { false };
@@ -10,11 +10,20 @@
 //
 
 #include <stdint.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include <glm/glm.hpp>
 
 #include <QDataStream>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QHash>
+#include <QtCore/QSaveFile>
 #include <QtNetwork/QNetworkRequest>
 #include <QtNetwork/QNetworkReply>
 #include <qendian.h>
@@ -53,6 +62,19 @@ Sound::Sound(const QUrl& url, bool isStereo, bool isAmbisonic) :
 }
 
 void Sound::downloadFinished(const QByteArray& data) {
+    // another process (or an earlier run) may already have decoded this sound
+    QString decodedCacheFilePath;
+    if (!_decodedCacheDirectory.isEmpty()) {
+        decodedCacheFilePath = this->decodedCacheFilePath(data);
+        if (readDecodedCache(decodedCacheFilePath)) {
+            finishedLoading(true);
+
+            _isReady = true;
+            emit ready();
+            return;
+        }
+    }
+
     // replace our byte array with the downloaded data
     QByteArray rawAudioByteArray = QByteArray(data);
     QString fileName = getURL().fileName().toLower();
@@ -81,6 +103,10 @@ void Sound::downloadFinished(const QByteArray& data) {
         qCDebug(audio) << "Unknown sound file type";
     }
 
+    if (!decodedCacheFilePath.isEmpty() && !_byteArray.isEmpty()) {
+        writeDecodedCache(decodedCacheFilePath);
+    }
+
     finishedLoading(true);
 
     _isReady = true;
@@ -253,3 +279,133 @@ int Sound::interpretAsWav(const QByteArray& inputAudioByteArray, QByteArray& out
     _duration = (float)(outputAudioByteArraySize / (wave.sampleRate * wave.numChannels * wave.bitsPerSample / 8.0f));
     return wave.sampleRate;
 }
+
+// The decoded cache holds one file per sound: this header, then the PCM data at AudioConstants::SAMPLE_RATE
+struct DecodedSoundHeader {
+    char        id[4];          // "HFDS"
+    quint32     version;
+    quint32     sampleRate;
+    quint32     numChannels;
+    quint32     numBytes;
+    float       duration;
+    quint32     reserved[2];    // keeps the samples 32-byte aligned in the mapping
+};
+
+static const char DECODED_SOUND_ID[4] = { 'H', 'F', 'D', 'S' };
+static const quint32 DECODED_SOUND_VERSION = 1;
+
+// past this, the sounds read least recently are removed from the decoded cache
+static const qint64 MAX_DECODED_CACHE_BYTES = 512 * 1024 * 1024;
+
+static void evictDecodedCache(const QString& directory) {
+    QFileInfoList files = QDir(directory).entryInfoList(QStringList() << "*.pcm", QDir::Files);
+    qint64 cacheSize = 0;
+    for (const auto& file : files) {
+        cacheSize += file.size();
+    }
+    if (cacheSize <= MAX_DECODED_CACHE_BYTES) {
+        return;
+    }
+
+    // every process maps the files it reads, which marks them read, so their access times order them for all of them
+    std::sort(files.begin(), files.end(), [](const QFileInfo& a, const QFileInfo& b) {
+        return a.lastRead() < b.lastRead();
+    });
+    for (const auto& file : files) {
+        if (cacheSize <= MAX_DECODED_CACHE_BYTES) {
+            break;
+        }
+        // the processes that mapped a removed file keep its pages, it is only decoded again by those that load it next
+        if (QFile::remove(file.absoluteFilePath())) {
+            cacheSize -= file.size();
+        }
+    }
+    qCDebug(audio) << "Evicted decoded sounds down to" << cacheSize << "bytes in" << directory;
+}
+
+QString Sound::decodedCacheFilePath(const QByteArray& rawAudioByteArray) const {
+    // the file name decides how raw files are interpreted, so it is part of the key along with the content
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(getURL().fileName().toLower().toUtf8());
+    hash.addData(rawAudioByteArray);
+    return QDir(_decodedCacheDirectory).absoluteFilePath(hash.result().toHex() + ".pcm");
+}
+
+bool Sound::readDecodedCache(const QString& filePath) {
+    // Mappings are kept for the lifetime of the process: injectors hold copies of the byte array, which reference the
+    // mapped pages directly and can outlive this Sound. Each file is only mapped once per process.
+    struct Mapping {
+        QFile* file;
+        const uchar* data;
+    };
+    static std::mutex mappingsMutex;
+    static QHash<QString, Mapping> mappings;
+
+    std::lock_guard<std::mutex> lock(mappingsMutex);
+
+    auto it = mappings.find(filePath);
+    if (it == mappings.end()) {
+        std::unique_ptr<QFile> file(new QFile(filePath));
+        if (!file->open(QIODevice::ReadOnly) || file->size() < (qint64)sizeof(DecodedSoundHeader)) {
+            return false;
+        }
+        const uchar* data = file->map(0, file->size());
+        if (!data) {
+            qCWarning(audio) << "Could not map decoded sound" << filePath << file->errorString();
+            return false;
+        }
+        it = mappings.insert(filePath, { file.release(), data });
+    }
+
+    const uchar* mapping = it->data;
+    qint64 mappingSize = it->file->size();
+
+    DecodedSoundHeader header;
+    memcpy(&header, mapping, sizeof(header));
+
+    if (memcmp(header.id, DECODED_SOUND_ID, sizeof(DECODED_SOUND_ID)) != 0 || header.version != DECODED_SOUND_VERSION ||
+        header.sampleRate != (quint32)AudioConstants::SAMPLE_RATE ||
+        header.numBytes > (quint64)mappingSize - sizeof(DecodedSoundHeader)) {
+        qCWarning(audio) << "Ignoring invalid decoded sound" << filePath;
+        return false;
+    }
+
+    _isStereo = header.numChannels == AudioConstants::STEREO;
+    _isAmbisonic = header.numChannels == AudioConstants::AMBISONIC;
+    _duration = header.duration;
+    _byteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(mapping + sizeof(header)), header.numBytes);
+    return true;
+}
+
+void Sound::writeDecodedCache(const QString& filePath) {
+    if (!QDir().mkpath(_decodedCacheDirectory)) {
+        qCWarning(audio) << "Could not create the decoded sound cache in" << _decodedCacheDirectory;
+        return;
+    }
+
+    DecodedSoundHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.id, DECODED_SOUND_ID, sizeof(DECODED_SOUND_ID));
+    header.version = DECODED_SOUND_VERSION;
+    header.sampleRate = AudioConstants::SAMPLE_RATE;
+    header.numChannels = _isAmbisonic ? AudioConstants::AMBISONIC : (_isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
+    header.numBytes = _byteArray.size();
+    header.duration = _duration;
+
+    // written aside and renamed, so that other processes never see a partial file
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(_byteArray.constData(), _byteArray.size());
+    if (!file.commit()) {
+        qCWarning(audio) << "Could not write decoded sound" << filePath << file.errorString();
+        return;
+    }
+
+    // drop our decoded copy for the shared pages
+    readDecodedCache(filePath);
+
+    evictDecodedCache(_decodedCacheDirectory);
+}
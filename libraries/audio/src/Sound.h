@@ -23,6 +23,11 @@ class Sound : public Resource {
 
 public:
     Sound(const QUrl& url, bool isStereo = false, bool isAmbisonic = false);
+
+    // directory of decoded PCM (at AudioConstants::SAMPLE_RATE) shared by every process using it, empty to disable
+    //   sounds found there are memory-mapped instead of decoded, so processes playing the same sounds share the pages
+    //   it is kept to 512MB, removing the sounds read least recently
+    void setDecodedCacheDirectory(const QString& directory) { _decodedCacheDirectory = directory; }
     
     bool isStereo() const { return _isStereo; }    
     bool isAmbisonic() const { return _isAmbisonic; }    
@@ -30,6 +35,7 @@ public:
     float getDuration() const { return _duration; }
 
  
+    // may reference a mapping of the decoded cache: use constData() to read it without a private copy
     const QByteArray& getByteArray() const { return _byteArray; }
 
 signals:
@@ -40,10 +46,15 @@ private:
     bool _isStereo;
     bool _isAmbisonic;
     bool _isReady;
-    float _duration; // In seconds
+    float _duration { 0.0f }; // In seconds
+    QString _decodedCacheDirectory;
     
     void downSample(const QByteArray& rawAudioByteArray, int sampleRate);
     int interpretAsWav(const QByteArray& inputAudioByteArray, QByteArray& outputAudioByteArray);
+
+    QString decodedCacheFilePath(const QByteArray& rawAudioByteArray) const;
+    bool readDecodedCache(const QString& filePath);
+    void writeDecodedCache(const QString& filePath);
     
     virtual void downloadFinished(const QByteArray& data) override;
 };
@@ -37,5 +37,7 @@ SharedSoundPointer SoundCache::getSound(const QUrl& url) {
 QSharedPointer<Resource> SoundCache::createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
     const void* extra) {
     qCDebug(audio) << "Requesting sound at" << url.toString();
-    return QSharedPointer<Resource>(new Sound(url), &Resource::deleter);
+    auto sound = new Sound(url);
+    sound->setDecodedCacheDirectory(_decodedSoundCacheDirectory);
+    return QSharedPointer<Resource>(sound, &Resource::deleter);
 }
@@ -24,11 +24,16 @@ class SoundCache : public ResourceCache, public Dependency {
 public:
     Q_INVOKABLE SharedSoundPointer getSound(const QUrl& url);
 
+    // see Sound::setDecodedCacheDirectory, applies to sounds requested afterwards
+    void setDecodedSoundCacheDirectory(const QString& directory) { _decodedSoundCacheDirectory = directory; }
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
         const void* extra) override;
 private:
     SoundCache(QObject* parent = NULL);
+
+    QString _decodedSoundCacheDirectory;
 };
 
 #endif // hifi_SoundCache_h
@@ -91,4 +91,36 @@ void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3
     _mm256_zeroupper();
 }
 
+// crossfade 4 inputs into 2 outputs with accumulation (interleaved)
+void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    // each frame's window value applies to both channels of the output pair
+    const __m256i duplicate = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m256 f0 = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&win[i])), duplicate);
+
+        __m256 x0 = _mm256_loadu_ps(&src[4*i+0]);   // frames 0,1 as { 0 1 2 3 }
+        __m256 x1 = _mm256_loadu_ps(&src[4*i+8]);   // frames 2,3 as { 0 1 2 3 }
+
+        __m256 y0 = _mm256_loadu_ps(&dst[2*i]);
+
+        // gather channel pairs {0 1} and {2 3}, as frame order 0,2,1,3 then restore to 0,1,2,3
+        __m256 a = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(1,0,1,0));
+        __m256 b = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3,2,3,2));
+        a = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(a), _MM_SHUFFLE(3,1,2,0)));
+        b = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(b), _MM_SHUFFLE(3,1,2,0)));
+
+        // crossfade and accumulate
+        y0 = _mm256_add_ps(y0, _mm256_fmadd_ps(f0, _mm256_sub_ps(a, b), b));
+
+        _mm256_storeu_ps(&dst[2*i], y0);
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
@@ -17,6 +17,7 @@
 #include <stdint.h>
 
 #include <QtCore/QDataStream>
+#include <QtCore/QSet>
 #include <QtCore/QThread>
 #include <QtCore/QUuid>
 #include <QtCore/QJsonDocument>
@@ -53,6 +54,69 @@ static const int TRANSLATION_COMPRESSION_RADIX = 12;
 static const int SENSOR_TO_WORLD_SCALE_RADIX = 10;
 static const float AUDIO_LOUDNESS_SCALE = 1024.0f;
 
+namespace {
+    // joint rotations are bit packed most significant bit first, so their precision need not be a whole number of bytes
+    class BitPacker {
+    public:
+        BitPacker(unsigned char* destination) : _destination(destination) {}
+
+        void write(uint64_t value, int numBits) {
+            for (int i = numBits - 1; i >= 0; i--) {
+                _accumulator = (_accumulator << 1) | ((value >> i) & 1);
+                if (++_numBits == BITS_IN_BYTE) {
+                    *_destination++ = (unsigned char)_accumulator;
+                    _accumulator = 0;
+                    _numBits = 0;
+                }
+            }
+        }
+
+        // pads the last byte with zeros, returns the position after it
+        unsigned char* flush() {
+            if (_numBits > 0) {
+                *_destination++ = (unsigned char)(_accumulator << (BITS_IN_BYTE - _numBits));
+                _accumulator = 0;
+                _numBits = 0;
+            }
+            return _destination;
+        }
+
+    private:
+        unsigned char* _destination;
+        uint32_t _accumulator { 0 };
+        int _numBits { 0 };
+    };
+
+    class BitUnpacker {
+    public:
+        BitUnpacker(const unsigned char* source) : _source(source) {}
+
+        uint64_t read(int numBits) {
+            uint64_t value = 0;
+            for (int i = 0; i < numBits; i++) {
+                if (_numBits == 0) {
+                    _byte = *_source++;
+                    _numBits = BITS_IN_BYTE;
+                }
+                value = (value << 1) | ((_byte >> --_numBits) & 1);
+            }
+            return value;
+        }
+
+        const unsigned char* position() const { return _source; }
+
+    private:
+        const unsigned char* _source;
+        unsigned char _byte { 0 };
+        int _numBits { 0 };
+    };
+
+    int numBytesForPackedRotations(int numRotations, int bitsPerComponent) {
+        int numBits = numRotations * numBitsForQuantizedOrientationQuat(bitsPerComponent);
+        return (numBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    }
+}
+
 #define ASSERT(COND)  do { if (!(COND)) { abort(); } } while(0)
 
 AvatarData::AvatarData() :
@@ -161,16 +225,61 @@ float AvatarData::getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const
     return result;
 }
 
+int AvatarData::getDistanceBasedRotationBitsPerComponent(glm::vec3 viewerPosition) const {
+    auto distance = glm::distance(_globalPosition, viewerPosition);
+    int result = AVATAR_MIN_ROTATION_BITS_PER_COMPONENT; // assume worst
+    if (distance < AVATAR_DISTANCE_LEVEL_1) {
+        result = AVATAR_MAX_ROTATION_BITS_PER_COMPONENT;
+    } else if (distance < AVATAR_DISTANCE_LEVEL_2) {
+        result = 12;
+    } else if (distance < AVATAR_DISTANCE_LEVEL_3) {
+        result = 10;
+    }
+    return result;
+}
+
 float AvatarData::getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const {
     return AVATAR_MIN_TRANSLATION; // Eventually make this distance sensitive as well
 }
 
+AvatarData::JointLOD AvatarData::getDistanceBasedJointLOD(glm::vec3 viewerPosition) const {
+    float size = 2.0f * glm::length(_globalBoundingBoxDimensions);
+    if (size == 0.0f) {
+        size = AVATAR_DEFAULT_LOD_SIZE;
+    }
+    float distance = glm::distance(_globalPosition, viewerPosition);
+    if (size > AVATAR_ALL_JOINTS_MIN_ANGULAR_SIZE * distance) {
+        return AllJoints;
+    } else if (size > AVATAR_BODY_JOINTS_MIN_ANGULAR_SIZE * distance) {
+        return BodyJoints;
+    }
+    return CoreJoints;
+}
+
+static AvatarData::JointLOD jointLODForName(const QString& jointName) {
+    static const QSet<QString> CORE_JOINTS { "Hips", "Head", "LeftHand", "RightHand" };
+    static const QSet<QString> BODY_JOINTS {
+        "Spine", "Spine1", "Spine2", "Neck",
+        "LeftShoulder", "LeftArm", "LeftForeArm", "RightShoulder", "RightArm", "RightForeArm",
+        "LeftUpLeg", "LeftLeg", "LeftFoot", "RightUpLeg", "RightLeg", "RightFoot"
+    };
+    if (CORE_JOINTS.contains(jointName)) {
+        return AvatarData::CoreJoints;
+    } else if (BODY_JOINTS.contains(jointName)) {
+        return AvatarData::BodyJoints;
+    }
+    return AvatarData::AllJoints;
+}
+
 
 // we want to track outbound data in this case...
 QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail) {
     AvatarDataPacket::HasFlags hasFlagsOut;
     auto lastSentTime = _lastToByteArray;
     _lastToByteArray = usecTimestampNow();
+    _lastSentPosition = getPosition();
+    _lastSentOrientation = getOrientation();
+    _lastSentAudioLoudness = getAudioLoudness();
     return AvatarData::toByteArray(dataDetail, lastSentTime, getLastSentJointData(), 
                         hasFlagsOut, false, false, glm::vec3(0), nullptr,
                         &_outboundDataRate);
@@ -487,6 +596,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         }
         float minRotationDOT = !distanceAdjust ? AVATAR_MIN_ROTATION_DOT : getDistanceBasedMinRotationDOT(viewerPosition);
 
+        // joints above the viewer's level of detail aren't sent at all, its copy keeps their last or default pose
+        JointLOD jointLOD = !distanceAdjust ? AllJoints : getDistanceBasedJointLOD(viewerPosition);
+        bool cullJointsByLOD = (jointLOD != AllJoints && _jointLODs.size() == _jointData.size());
+
         for (int i = 0; i < _jointData.size(); i++) {
             const JointData& data = _jointData[i];
 
@@ -494,9 +607,11 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             // So if the dot() is less than the value, then the rotation is a larger angle of rotation
             bool largeEnoughRotation = fabsf(glm::dot(data.rotation, lastSentJointData[i].rotation)) < minRotationDOT;
 
+            bool isInLOD = !cullJointsByLOD || _jointLODs[i] <= jointLOD;
+
             if (sendAll || lastSentJointData[i].rotation != data.rotation) {
                 if (sendAll || !cullSmallChanges || largeEnoughRotation) {
-                    if (data.rotationSet) {
+                    if (data.rotationSet && isInLOD) {
                         validity |= (1 << validityBit);
 #ifdef WANT_DEBUG
                         rotationSentCount++;
@@ -518,18 +633,26 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             *destinationBuffer++ = validity;
         }
 
+        // far away viewers can't tell small errors in joint rotations apart, so they get fewer bits per component
+        int rotationBitsPerComponent = !distanceAdjust ? AVATAR_MAX_ROTATION_BITS_PER_COMPONENT :
+            getDistanceBasedRotationBitsPerComponent(viewerPosition);
+        *destinationBuffer++ = (uint8_t)rotationBitsPerComponent;
+
+        BitPacker rotationPacker(destinationBuffer);
+        int rotationBits = numBitsForQuantizedOrientationQuat(rotationBitsPerComponent);
         validityBit = 0;
         validity = *validityPosition++;
         for (int i = 0; i < _jointData.size(); i++) {
             const JointData& data = _jointData[i];
             if (validity & (1 << validityBit)) {
-                destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                rotationPacker.write(quantizeOrientationQuat(data.rotation, rotationBitsPerComponent), rotationBits);
             }
             if (++validityBit == BITS_IN_BYTE) {
                 validityBit = 0;
                 validity = *validityPosition++;
             }
         }
+        destinationBuffer = rotationPacker.flush();
 
 
         // joint translation data
@@ -547,11 +670,12 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         float maxTranslationDimension = 0.0;
         for (int i = 0; i < _jointData.size(); i++) {
             const JointData& data = _jointData[i];
+            bool isInLOD = !cullJointsByLOD || _jointLODs[i] <= jointLOD;
             if (sendAll || lastSentJointData[i].translation != data.translation) {
                 if (sendAll ||
                     !cullSmallChanges ||
                     glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation) {
-                    if (data.translationSet) {
+                    if (data.translationSet && isInLOD) {
                         validity |= (1 << validityBit);
 #ifdef WANT_DEBUG
                         translationSentCount++;
@@ -624,6 +748,34 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     int avatarDataSize = destinationBuffer - startPosition;
     return avatarDataByteArray.left(avatarDataSize);
 }
+bool AvatarData::hasChangedVisiblySinceLastSent() const {
+    if (glm::distance(getPosition(), _lastSentPosition) > AVATAR_MIN_SEND_TRANSLATION ||
+        fabsf(glm::dot(getOrientation(), _lastSentOrientation)) < AVATAR_MIN_SEND_ROTATION_DOT) {
+        return true;
+    }
+
+    // the mouth follows the loudness, so talking counts as moving
+    float audioLoudness = getAudioLoudness();
+    if (fabsf(audioLoudness - _lastSentAudioLoudness) >
+        AVATAR_MIN_SEND_LOUDNESS_CHANGE * std::max(audioLoudness, _lastSentAudioLoudness)) {
+        return true;
+    }
+
+    QReadLocker readLock(&_jointDataLock);
+    if (_lastSentJointData.size() != _jointData.size()) {
+        return true;
+    }
+    for (int i = 0; i < _jointData.size(); i++) {
+        const JointData& data = _jointData[i];
+        const JointData& lastSentData = _lastSentJointData[i];
+        if ((data.rotationSet && fabsf(glm::dot(data.rotation, lastSentData.rotation)) < AVATAR_MIN_SEND_ROTATION_DOT) ||
+            (data.translationSet && glm::distance(data.translation, lastSentData.translation) > AVATAR_MIN_SEND_TRANSLATION)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // NOTE: This is never used in a "distanceAdjust" mode, so it's ok that it doesn't use a variable minimum rotation/translation
 void AvatarData::doneEncoding(bool cullSmallChanges) {
     // The server has finished sending this version of the joint-data to other nodes.  Update _lastSentJointData.
@@ -1000,20 +1152,33 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
             }
         }
 
-        // each joint rotation is stored in 6 bytes.
+        // each joint rotation is bit packed with the precision chosen by the sender
+        PACKET_READ_CHECK(JointRotationBitsPerComponent, sizeof(uint8_t));
+        int rotationBitsPerComponent = *sourceBuffer++;
+        if (rotationBitsPerComponent < AVATAR_MIN_ROTATION_BITS_PER_COMPONENT ||
+            rotationBitsPerComponent > AVATAR_MAX_ROTATION_BITS_PER_COMPONENT) {
+            if (shouldLogError(now)) {
+                qCWarning(avatars) << "AvatarData packet has invalid joint rotation precision" << rotationBitsPerComponent
+                    << getSessionUUID();
+            }
+            return buffer.size();
+        }
+
         QWriteLocker writeLock(&_jointDataLock);
         _jointData.resize(numJoints);
 
-        const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
+        PACKET_READ_CHECK(JointRotations, numBytesForPackedRotations(numValidJointRotations, rotationBitsPerComponent));
+        BitUnpacker rotationUnpacker(sourceBuffer);
+        int rotationBits = numBitsForQuantizedOrientationQuat(rotationBitsPerComponent);
         for (int i = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                data.rotation = dequantizeOrientationQuat(rotationUnpacker.read(rotationBits), rotationBitsPerComponent);
                 _hasNewJointData = true;
                 data.rotationSet = true;
             }
         }
+        sourceBuffer = rotationUnpacker.position();
 
         PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
 
@@ -1374,10 +1539,9 @@ QVector<glm::quat> AvatarData::getJointRotations() const {
 
 void AvatarData::setJointRotations(QVector<glm::quat> jointRotations) {
     if (QThread::currentThread() != thread()) {
-        QVector<glm::quat> result;
-        QMetaObject::invokeMethod(const_cast<AvatarData*>(this),
-                                  "setJointRotations", Qt::BlockingQueuedConnection,
-                                  Q_ARG(QVector<glm::quat>, jointRotations));
+        // queued rather than blocking, like the other joint setters, so it's applied with them on the next frame
+        QMetaObject::invokeMethod(this, "setJointRotations", Q_ARG(QVector<glm::quat>, jointRotations));
+        return;
     }
     QWriteLocker writeLock(&_jointDataLock);
     if (_jointData.size() < jointRotations.size()) {
@@ -1392,10 +1556,9 @@ void AvatarData::setJointRotations(QVector<glm::quat> jointRotations) {
 
 void AvatarData::setJointTranslations(QVector<glm::vec3> jointTranslations) {
     if (QThread::currentThread() != thread()) {
-        QVector<glm::quat> result;
-        QMetaObject::invokeMethod(const_cast<AvatarData*>(this),
-                                  "setJointTranslations", Qt::BlockingQueuedConnection,
-                                  Q_ARG(QVector<glm::vec3>, jointTranslations));
+        // queued rather than blocking, like the other joint setters, so it's applied with them on the next frame
+        QMetaObject::invokeMethod(this, "setJointTranslations", Q_ARG(QVector<glm::vec3>, jointTranslations));
+        return;
     }
     QWriteLocker writeLock(&_jointDataLock);
     if (_jointData.size() < jointTranslations.size()) {
@@ -1644,21 +1807,23 @@ void AvatarData::setJointMappingsFromNetworkReply() {
                 _jointNames[jointIndex] = jointName;
             }
         }
+        _jointLODs.resize(_jointNames.size());
         for (int i = 0; i < _jointNames.size(); i++) {
             _jointIndices.insert(_jointNames.at(i), i + 1);
+            _jointLODs[i] = jointLODForName(_jointNames.at(i));
         }
     }
 
     networkReply->deleteLater();
 }
 
-void AvatarData::sendAvatarDataPacket() {
+void AvatarData::sendAvatarDataPacket(bool sendAll) {
     auto nodeList = DependencyManager::get<NodeList>();
 
     // about 2% of the time, we send a full update (meaning, we transmit all the joint data), even if nothing has changed.
     // this is to guard against a joint moving once, the packet getting lost, and the joint never moving again.
 
-    bool cullSmallData = (randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO);
+    bool cullSmallData = sendAll || (randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO);
     auto dataDetail = cullSmallData ? SendAllData : CullSmallData;
     QByteArray avatarByteArray = toByteArrayStateful(dataDetail);
     doneEncoding(cullSmallData);
@@ -1695,6 +1860,7 @@ void AvatarData::updateJointMappings() {
         QWriteLocker writeLock(&_jointDataLock);
         _jointIndices.clear();
         _jointNames.clear();
+        _jointLODs.clear();
         _jointData.clear();
     }
 
@@ -234,7 +234,8 @@ namespace AvatarDataPacket {
     struct JointData {
         uint8_t numJoints;
         uint8_t rotationValidityBits[ceil(numJoints / 8)];     // one bit per joint, if true then a compressed rotation follows.
-        SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes()
+        uint8_t rotationBitsPerComponent;                      // precision of the rotations, lower for distant viewers
+        uint8_t rotation[ceil(numValidRotations * (2 + 3 * rotationBitsPerComponent) / 8)]; // bit packed by quantizeOrientationQuat()
         uint8_t translationValidityBits[ceil(numJoints / 8)];  // one bit per joint, if true then a compressed translation follows.
         SixByteTrans translation[numValidTranslations];        // encodeded and compressed by packFloatVec3ToSignedTwoByteFixed()
     };
@@ -257,6 +258,11 @@ const float AVATAR_SEND_FULL_UPDATE_RATIO = 0.02f;
 const float AVATAR_MIN_ROTATION_DOT = 0.9999999f;
 const float AVATAR_MIN_TRANSLATION = 0.0001f;
 
+// changes smaller than these don't need an avatar data send of their own, they go out with the next one
+const float AVATAR_MIN_SEND_ROTATION_DOT = 0.99999f; // about half a degree
+const float AVATAR_MIN_SEND_TRANSLATION = 0.005f; // meters
+const float AVATAR_MIN_SEND_LOUDNESS_CHANGE = 0.1f; // fraction of the louder of the two loudnesses
+
 const float ROTATION_CHANGE_15D = 0.9914449f;
 const float ROTATION_CHANGE_45D = 0.9238795f;
 const float ROTATION_CHANGE_90D = 0.7071068f;
@@ -267,6 +273,16 @@ const float AVATAR_DISTANCE_LEVEL_2 = 100.0f;
 const float AVATAR_DISTANCE_LEVEL_3 = 1000.0f;
 const float AVATAR_DISTANCE_LEVEL_4 = 10000.0f;
 
+// how large an avatar must look to a viewer, about its size over its distance, for the viewer to get more of its joints
+const float AVATAR_ALL_JOINTS_MIN_ANGULAR_SIZE = 0.05f; // a 2m avatar at 40m
+const float AVATAR_BODY_JOINTS_MIN_ANGULAR_SIZE = 0.015f; // a 2m avatar at about 130m
+// avatars that haven't sent their bounding box yet are taken to be this size
+const float AVATAR_DEFAULT_LOD_SIZE = 2.0f;
+
+// range of bits per smallest-three component in the joint rotations of avatar data
+const int AVATAR_MAX_ROTATION_BITS_PER_COMPONENT = 15;
+const int AVATAR_MIN_ROTATION_BITS_PER_COMPONENT = 8;
+
 
 // Where one's own Avatar begins in the world (will be overwritten if avatar data file is found).
 // This is the start location in the Sandbox (xyz: 6270, 211, 6000).
@@ -383,6 +399,13 @@ public:
         SendAllData
     } AvatarDataDetail;
 
+    // which joints a viewer gets, chosen by how large the avatar looks to it: crowds far away only need their posture
+    enum JointLOD : uint8_t {
+        CoreJoints, // hips, head and hands
+        BodyJoints, // and the spine, neck, shoulders and limbs
+        AllJoints // and the fingers, toes, eyes and any joints of the avatar's own
+    };
+
     virtual QByteArray toByteArrayStateful(AvatarDataDetail dataDetail);
 
     virtual QByteArray toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
@@ -612,10 +635,19 @@ public:
     static float _avatarSortCoefficientCenter;
     static float _avatarSortCoefficientAge;
 
+    // whether the avatar moved, gestured or talked enough since its data was last sent for viewers to notice
+    bool hasChangedVisiblySinceLastSent() const;
+
+    // what a viewer at this position gets of the joints, the mixer shares encodings between viewers that get the same
+    float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
+    int getDistanceBasedRotationBitsPerComponent(glm::vec3 viewerPosition) const;
+    float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
+    JointLOD getDistanceBasedJointLOD(glm::vec3 viewerPosition) const;
+
 
 
 public slots:
-    void sendAvatarDataPacket();
+    void sendAvatarDataPacket(bool sendAll = false);
     void sendIdentityPacket();
 
     void setJointMappingsFromNetworkReply();
@@ -633,9 +665,6 @@ public slots:
 protected:
     void lazyInitHeadData() const;
 
-    float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
-    float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
-
     bool avatarBoundingBoxChangedSince(quint64 time) const { return _avatarBoundingBoxChanged >= time; }
     bool avatarScaleChangedSince(quint64 time) const { return _avatarScaleChanged >= time; }
     bool lookAtPositionChangedSince(quint64 time) const { return _headData->lookAtPositionChangedSince(time); }
@@ -685,6 +714,7 @@ protected:
 
     QHash<QString, int> _jointIndices; ///< 1-based, since zero is returned for missing keys
     QStringList _jointNames; ///< in order of depth-first traversal
+    QVector<JointLOD> _jointLODs; ///< the lowest level of detail each joint is sent at, empty if the names are unknown
 
     quint64 _errorLogExpiry; ///< time in future when to log an error
 
@@ -715,6 +745,9 @@ protected:
     quint64 _parentChanged { 0 };
 
     quint64  _lastToByteArray { 0 }; // tracks the last time we did a toByteArray
+    glm::vec3 _lastSentPosition;
+    glm::quat _lastSentOrientation;
+    float _lastSentAudioLoudness { 0.0f };
 
     // Some rate data for incoming data in bytes
     RateCounter<> _parseBufferRate;
@@ -26,8 +26,7 @@ AvatarHashMap::AvatarHashMap() {
 }
 
 QVector<QUuid> AvatarHashMap::getAvatarIdentifiers() {
-    QReadLocker locker(&_hashLock);
-    return _avatarHash.keys().toVector();
+    return getHashSnapshot()->keys().toVector();
 }
 
 AvatarData* AvatarHashMap::getAvatar(QUuid avatarID) {
@@ -73,15 +72,22 @@ AvatarSharedPointer AvatarHashMap::addAvatar(const QUuid& sessionUUID, const QWe
     avatar->setOwningAvatarMixer(mixerWeakPointer);
 
     _avatarHash.insert(sessionUUID, avatar);
+    publishHashSnapshot();
     emit avatarAddedEvent(sessionUUID);
 
     return avatar;
 }
 
 AvatarSharedPointer AvatarHashMap::newOrExistingAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer) {
+    // almost every packet is for an avatar we already have, that doesn't need the lock
+    auto avatar = getHashSnapshot()->value(sessionUUID);
+    if (avatar) {
+        return avatar;
+    }
+
     QWriteLocker locker(&_hashLock);
 
-    auto avatar = _avatarHash.value(sessionUUID);
+    avatar = _avatarHash.value(sessionUUID);
 
     if (!avatar) {
         avatar = addAvatar(sessionUUID, mixerWeakPointer);
@@ -91,11 +97,7 @@ AvatarSharedPointer AvatarHashMap::newOrExistingAvatar(const QUuid& sessionUUID,
 }
 
 AvatarSharedPointer AvatarHashMap::findAvatar(const QUuid& sessionUUID) const {
-    QReadLocker locker(&_hashLock);
-    if (_avatarHash.contains(sessionUUID)) {
-        return _avatarHash.value(sessionUUID);
-    }
-    return nullptr;
+    return getHashSnapshot()->value(sessionUUID);
 }
 
 void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -136,9 +138,9 @@ void AvatarHashMap::processAvatarIdentityPacket(QSharedPointer<ReceivedMessage>
     static auto EMPTY = QUuid();
 
     {
-        QReadLocker locker(&_hashLock);
-        auto me = _avatarHash.find(EMPTY);
-        if ((me != _avatarHash.end()) && (identity.uuid == me.value()->getSessionUUID())) {
+        auto snapshot = getHashSnapshot();
+        auto me = snapshot->find(EMPTY);
+        if ((me != snapshot->end()) && (identity.uuid == me.value()->getSessionUUID())) {
             // We add MyAvatar to _avatarHash with an empty UUID. Code relies on this. In order to correctly handle an
             // identity packet for ourself (such as when we are assigned a sessionDisplayName by the mixer upon joining),
             // we make things match here.
@@ -176,6 +178,7 @@ void AvatarHashMap::removeAvatar(const QUuid& sessionUUID, KillAvatarReason remo
     auto removedAvatar = _avatarHash.take(sessionUUID);
 
     if (removedAvatar) {
+        publishHashSnapshot();
         handleRemovedAvatar(removedAvatar, removalReason);
     }
 }
@@ -16,6 +16,7 @@
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUuid>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 
@@ -32,8 +33,13 @@ class AvatarHashMap : public QObject, public Dependency {
     SINGLETON_DEPENDENCY
 
 public:
-    AvatarHash getHashCopy() { QReadLocker lock(&_hashLock); return _avatarHash; }
-    int size() { return _avatarHash.size(); }
+    // an immutable view of the avatars, readers never wait for writers (removed avatars live on in older snapshots
+    // until the last reader lets go of them)
+    using AvatarHashSnapshot = std::shared_ptr<const AvatarHash>;
+    AvatarHashSnapshot getHashSnapshot() const { return std::atomic_load(&_avatarHashSnapshot); }
+
+    AvatarHash getHashCopy() const { return *getHashSnapshot(); }
+    int size() const { return getHashSnapshot()->size(); }
 
     // Currently, your own avatar will be included as the null avatar id.
     Q_INVOKABLE QVector<QUuid> getAvatarIdentifiers();
@@ -64,17 +70,21 @@ protected:
     virtual AvatarSharedPointer newSharedAvatar();
     virtual AvatarSharedPointer addAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer);
     AvatarSharedPointer newOrExistingAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer);
-    virtual AvatarSharedPointer findAvatar(const QUuid& sessionUUID) const; // uses a QReadLocker on the hashLock
+    virtual AvatarSharedPointer findAvatar(const QUuid& sessionUUID) const; // reads the current snapshot
     virtual void removeAvatar(const QUuid& sessionUUID, KillAvatarReason removalReason = KillAvatarReason::NoReason);
     
     virtual void handleRemovedAvatar(const AvatarSharedPointer& removedAvatar, KillAvatarReason removalReason = KillAvatarReason::NoReason);
 
+    // publishes _avatarHash to readers, call with _hashLock write-locked after every change to _avatarHash
+    void publishHashSnapshot() { std::atomic_store(&_avatarHashSnapshot, std::make_shared<const AvatarHash>(_avatarHash)); }
+
+    // _avatarHash is the writers' copy: only touch it with _hashLock write-locked, and publish the changes.
+    // Everyone else reads from a snapshot, without locking. (Scripted write access is not supported).
     AvatarHash _avatarHash;
-    // "Case-based safety": Most access to the _avatarHash is on the same thread. Write access is protected by a write-lock.
-    // If you read from a different thread, you must read-lock the _hashLock. (Scripted write access is not supported).
     mutable QReadWriteLock _hashLock;
 
 private:
+    AvatarHashSnapshot _avatarHashSnapshot { std::make_shared<const AvatarHash>() }; // use std::atomic_load/store
     QUuid _lastOwnerSessionUUID;
 };
 
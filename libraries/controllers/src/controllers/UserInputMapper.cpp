@@ -8,6 +8,7 @@
 
 #include "UserInputMapper.h"
 
+#include <algorithm>
 #include <set>
 
 #include <QtCore/QThread>
@@ -455,20 +456,27 @@ void UserInputMapper::runMappings() {
     if (debugRoutes) {
         qCDebug(controllers) << "Beginning mapping frame";
     }
-    for (auto endpointEntry : this->_endpointsByInput) {
+    for (const auto& endpointEntry : _endpointsByInput) {
         endpointEntry.second->reset();
     }
 
+    _isRunningMappings = true;
+
     if (debugRoutes) {
         qCDebug(controllers) << "Processing device routes";
     }
     // Now process the current values for each level of the stack
-    applyRoutes(_deviceRoutes);
+    applyRoutes(_compiledDeviceRoutes);
 
     if (debugRoutes) {
         qCDebug(controllers) << "Processing standard routes";
     }
-    applyRoutes(_standardRoutes);
+    applyRoutes(_compiledStandardRoutes);
+
+    _isRunningMappings = false;
+    if (_areCompiledRoutesStale) {
+        compileRoutes();
+    }
 
     if (debugRoutes) {
         qCDebug(controllers) << "Done with mappings";
@@ -477,50 +485,47 @@ void UserInputMapper::runMappings() {
 }
 
 // Encapsulate the logic that routes should not be read before they are written
-void UserInputMapper::applyRoutes(const Route::List& routes) {
-    Route::List deferredRoutes;
-
-    for (const auto& route : routes) {
-        if (!route) {
-            continue;
-        }
+void UserInputMapper::applyRoutes(const CompiledRoutes& routes) {
+    // the routes whose source isn't written yet are retried before each of the next routes, and forced at the end
+    _deferredRoutes.clear();
 
+    for (const auto route : routes) {
         // Try all the deferred routes
-        deferredRoutes.remove_if([](Route::Pointer route) {
-            return UserInputMapper::applyRoute(route);
-        });
+        _deferredRoutes.erase(std::remove_if(_deferredRoutes.begin(), _deferredRoutes.end(), [](const Route* deferredRoute) {
+            return UserInputMapper::applyRoute(*deferredRoute);
+        }), _deferredRoutes.end());
 
-        if (!applyRoute(route)) {
-            deferredRoutes.push_back(route);
+        if (!applyRoute(*route)) {
+            _deferredRoutes.push_back(route);
         }
     }
 
     bool force = true;
-    for (const auto& route : deferredRoutes) {
-        UserInputMapper::applyRoute(route, force);
+    for (const auto route : _deferredRoutes) {
+        UserInputMapper::applyRoute(*route, force);
     }
 }
 
 
-bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
-    if (debugRoutes && route->debug) {
-        qCDebug(controllers) << "Applying route " << route->json;
+bool UserInputMapper::applyRoute(const Route& route, bool force) {
+    if (debugRoutes && route.debug) {
+        qCDebug(controllers) << "Applying route " << route.json;
     }
 
     // If the source hasn't been written yet, defer processing of this route
-    auto source = route->source;
+    const auto& source = route.source;
     auto sourceInput = source->getInput();
     if (sourceInput.device == STANDARD_DEVICE && !force && source->writeable()) {
-        if (debugRoutes && route->debug) {
+        if (debugRoutes && route.debug) {
             qCDebug(controllers) << "Source not yet written, deferring";
         }
         return false;
     }
 
-    if (route->conditional) {
+    if (route.conditional) {
         // FIXME for endpoint conditionals we need to check if they've been written
-        if (!route->conditional->satisfied()) {
-            if (debugRoutes && route->debug) {
+        if (!route.conditional->satisfied()) {
+            if (debugRoutes && route.debug) {
                 qCDebug(controllers) << "Conditional failed";
             }
             return true;
@@ -533,25 +538,25 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
     // and someone else wires it to CONTEXT_MENU, I don't want both to occur when 
     // I press the button.  The exception is if I'm wiring a control back to itself
     // in order to adjust my interface, like inverting the Y axis on an analog stick
-    if (!route->peek && !source->readable()) {
-        if (debugRoutes && route->debug) {
+    if (!route.peek && !source->readable()) {
+        if (debugRoutes && route.debug) {
             qCDebug(controllers) << "Source unreadable";
         }
         return true;
     }
 
-    auto destination = route->destination;
+    const auto& destination = route.destination;
     // THis could happen if the route destination failed to create
     // FIXME: Maybe do not create the route if the destination failed and avoid this case ?
     if (!destination) {
-        if (debugRoutes && route->debug) {
+        if (debugRoutes && route.debug) {
             qCDebug(controllers) << "Bad Destination";
         }
         return true;
     }
 
     if (!destination->writeable()) {
-        if (debugRoutes && route->debug) {
+        if (debugRoutes && route.debug) {
             qCDebug(controllers) << "Destination unwritable";
         }
         return true;
@@ -559,9 +564,9 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
 
     // Fetch the value, may have been overriden by previous loopback routes
     if (source->isPose()) {
-        Pose value = getPose(source, route->peek);
+        Pose value = getPose(source, route.peek);
         static const Pose IDENTITY_POSE { vec3(), quat() };
-        if (debugRoutes && route->debug) {
+        if (debugRoutes && route.debug) {
             if (!value.valid) {
                 qCDebug(controllers) << "Applying invalid pose";
             } else if (value == IDENTITY_POSE) {
@@ -574,17 +579,17 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
         destination->apply(value, source);
     } else {
         // Fetch the value, may have been overriden by previous loopback routes
-        float value = getValue(source, route->peek);
+        float value = getValue(source, route.peek);
 
-        if (debugRoutes && route->debug) {
+        if (debugRoutes && route.debug) {
             qCDebug(controllers) << "Value was " << value;
         }
         // Apply each of the filters.
-        for (const auto& filter : route->filters) {
+        for (const auto& filter : route.filters) {
             value = filter->apply(value);
         }
 
-        if (debugRoutes && route->debug) {
+        if (debugRoutes && route.debug) {
             qCDebug(controllers) << "Filtered value was " << value;
         }
 
@@ -1163,12 +1168,36 @@ void UserInputMapper::enableMapping(const Mapping::Pointer& mapping) {
         return (value->source->getInput().device == STANDARD_DEVICE);
     });
     _deviceRoutes.insert(_deviceRoutes.begin(), deviceRoutes.begin(), deviceRoutes.end());
+    compileRoutes();
 
     if (!debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
     }
 }
 
+void UserInputMapper::compileRoutes() {
+    // the routes are run every frame, from arrays rather than the lists they are edited in; the lists keep them alive.
+    // A mapping changed by an endpoint while the routes run is compiled once they are done
+    if (_isRunningMappings) {
+        _areCompiledRoutesStale = true;
+        return;
+    }
+    _areCompiledRoutesStale = false;
+
+    auto compile = [](const Route::List& routes, CompiledRoutes& compiledRoutes) {
+        compiledRoutes.clear();
+        compiledRoutes.reserve(routes.size());
+        for (const auto& route : routes) {
+            if (route) {
+                compiledRoutes.push_back(route.get());
+            }
+        }
+    };
+    compile(_deviceRoutes, _compiledDeviceRoutes);
+    compile(_standardRoutes, _compiledStandardRoutes);
+    _deferredRoutes.reserve(std::max(_compiledDeviceRoutes.size(), _compiledStandardRoutes.size()));
+}
+
 void UserInputMapper::disableMapping(const Mapping::Pointer& mapping) {
     Locker locker(_lock);
     const auto& deviceRoutes = mapping->routes;
@@ -1179,6 +1208,7 @@ void UserInputMapper::disableMapping(const Mapping::Pointer& mapping) {
     _standardRoutes.remove_if([&](const Route::Pointer& value) {
         return routeSet.count(value) != 0;
     });
+    compileRoutes();
 
     if (debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
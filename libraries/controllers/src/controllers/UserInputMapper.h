@@ -16,6 +16,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtQml/QJSValue>
 #include <QtScript/QScriptValue>
@@ -151,10 +152,13 @@ namespace controller {
 
         void runMappings();
 
-        static void applyRoutes(const RouteList& route);
-        static bool applyRoute(const RoutePointer& route, bool force = false);
+        using CompiledRoutes = std::vector<Route*>;
+
+        void applyRoutes(const CompiledRoutes& routes);
+        static bool applyRoute(const Route& route, bool force = false);
         void enableMapping(const MappingPointer& mapping);
         void disableMapping(const MappingPointer& mapping);
+        void compileRoutes();
         EndpointPointer endpointFor(const QJSValue& endpoint);
         EndpointPointer endpointFor(const QScriptValue& endpoint);
         EndpointPointer endpointFor(const Input& endpoint) const;
@@ -184,6 +188,11 @@ namespace controller {
 
         RouteList _deviceRoutes;
         RouteList _standardRoutes;
+        CompiledRoutes _compiledDeviceRoutes;
+        CompiledRoutes _compiledStandardRoutes;
+        CompiledRoutes _deferredRoutes;
+        bool _isRunningMappings { false };
+        bool _areCompiledRoutesStale { false };
 
         QSet<QString> _loadedRouteJsonFiles;
 
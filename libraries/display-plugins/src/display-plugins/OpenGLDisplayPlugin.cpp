@@ -507,6 +507,10 @@ void OpenGLDisplayPlugin::updateFrameData() {
 }
 
 void OpenGLDisplayPlugin::compositeOverlay() {
+    if (!_currentFrame->overlay) {
+        return;
+    }
+
     render([&](gpu::Batch& batch){
         batch.enableStereo(false);
         batch.setFramebuffer(_compositeFramebuffer);
@@ -615,23 +619,34 @@ void OpenGLDisplayPlugin::present() {
     }
 
     if (_currentFrame) {
-        {
-            withPresentThreadLock([&] {
-                _renderRate.increment();
-                if (_currentFrame.get() != _lastFrame) {
-                    _newFrameRate.increment();
-                }
-                _lastFrame = _currentFrame.get();
-            });
-            // Execute the frame rendering commands
-            PROFILE_RANGE_EX(render, "execute", 0xff00ff00, frameId)
-            _gpuContext->executeFrame(_currentFrame);
+        bool isNewFrame = false;
+        withPresentThreadLock([&] {
+            _renderRate.increment();
+            isNewFrame = (_currentFrame.get() != _lastFrame);
+            if (isNewFrame) {
+                _newFrameRate.increment();
+            }
+            _lastFrame = _currentFrame.get();
+        });
+
+        bool reprojected = false;
+        if (!isNewFrame) {
+            PROFILE_RANGE_EX(render, "reproject", 0xff00ffff, frameId)
+            reprojected = reprojectLastFrame();
         }
 
-        // Write all layers to a local framebuffer
-        {
-            PROFILE_RANGE_EX(render, "composite", 0xff00ffff, frameId)
-            compositeLayers();
+        if (!reprojected) {
+            {
+                // Execute the frame rendering commands
+                PROFILE_RANGE_EX(render, "execute", 0xff00ff00, frameId)
+                _gpuContext->executeFrame(_currentFrame);
+            }
+
+            // Write all layers to a local framebuffer
+            {
+                PROFILE_RANGE_EX(render, "composite", 0xff00ffff, frameId)
+                compositeLayers();
+            }
         }
 
         // Take the composite framebuffer and send it to the output device
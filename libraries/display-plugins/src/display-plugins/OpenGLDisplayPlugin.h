@@ -105,6 +105,10 @@ protected:
 
     virtual void updateFrameData();
 
+    // Called on the present thread when no new frame arrived since the last present, returns true if the composite
+    // was redrawn from the last one, in place of executing the frame and compositing it again
+    virtual bool reprojectLastFrame() { return false; }
+
     void withMainThreadContext(std::function<void()> f) const;
 
     void present();
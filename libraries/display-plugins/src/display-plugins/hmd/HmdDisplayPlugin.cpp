@@ -55,6 +55,62 @@ struct HandLaserData {
     vec4 color;
 };
 
+struct ReprojectionData {
+    mat4 projections[2];
+    mat4 inverseProjections[2];
+    mat4 reprojection;
+};
+
+// Rotates each eye's half of the composite: the ray through a pixel at the present pose is turned into the pose the
+// composite was made for, and the composite is sampled where that ray lands
+static const char* HMD_REPROJECTION_FRAG = R"SCRIBE(
+
+uniform sampler2D colorMap;
+
+struct ReprojectionData {
+    mat4 projections[2];
+    mat4 inverseProjections[2];
+    mat4 reprojection;
+};
+
+layout(std140) uniform reprojectionBuffer {
+    ReprojectionData data;
+};
+
+in vec2 varTexCoord0;
+
+out vec4 outFragColor;
+
+void main(void) {
+    int eye = (varTexCoord0.x < 0.5) ? 0 : 1;
+    float xoffset = (eye == 0) ? 1.0 : -1.0;
+    vec2 uvmin = vec2(0.5 * float(eye), 0.0);
+    vec2 uvmax = vec2(0.5 + 0.5 * float(eye), 1.0);
+
+    // the eye's NDC, from the NDC of the side by side composite
+    vec4 ndcSpace = vec4(varTexCoord0 * 2.0 - 1.0, 0.0, 1.0);
+    ndcSpace.x = ndcSpace.x * 2.0 + xoffset;
+
+    vec4 eyeSpace = data.inverseProjections[eye] * ndcSpace;
+    eyeSpace /= eyeSpace.w;
+
+    vec3 ray = mat3(data.reprojection) * normalize(eyeSpace.xyz);
+    eyeSpace.xyz = ray * (eyeSpace.z / ray.z);
+
+    ndcSpace = data.projections[eye] * eyeSpace;
+    ndcSpace /= ndcSpace.w;
+    ndcSpace.x = (ndcSpace.x - xoffset) / 2.0;
+
+    vec2 uv = (ndcSpace.xy / 2.0) + 0.5;
+    if (any(greaterThan(uv, uvmax)) || any(lessThan(uv, uvmin))) {
+        outFragColor = vec4(0.0, 0.0, 0.0, 1.0);
+    } else {
+        outFragColor = texture(colorMap, uv);
+    }
+}
+
+)SCRIBE";
+
 static QString readFile(const QString& filename) {
     QFile file(filename);
     file.open(QFile::Text | QFile::ReadOnly);
@@ -118,6 +174,7 @@ void HmdDisplayPlugin::internalDeactivate() {
 }
 
 static const int32_t LINE_DATA_SLOT = 1;
+static const int32_t REPROJECTION_DATA_SLOT = 1;
 
 void HmdDisplayPlugin::customizeContext() {
     Parent::customizeContext();
@@ -142,6 +199,19 @@ void HmdDisplayPlugin::customizeContext() {
         _extraLaserUniforms = std::make_shared<gpu::Buffer>();
     };
 
+    {
+        auto state = std::make_shared<gpu::State>();
+        auto VS = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+        auto PS = gpu::Shader::createPixel(std::string(HMD_REPROJECTION_FRAG));
+        auto program = gpu::Shader::createProgram(VS, PS);
+        state->setDepthTest(gpu::State::DepthTest(false));
+
+        gpu::Shader::BindingSet bindings;
+        bindings.insert({ "reprojectionBuffer", REPROJECTION_DATA_SLOT });
+        gpu::Shader::makeProgram(*program, bindings);
+        _reprojectionPipeline = gpu::Pipeline::create(program, state);
+        _reprojectionUniforms = std::make_shared<gpu::Buffer>(sizeof(ReprojectionData), nullptr);
+    }
 }
 
 void HmdDisplayPlugin::uncustomizeContext() {
@@ -160,6 +230,9 @@ void HmdDisplayPlugin::uncustomizeContext() {
     _handLaserUniforms[1].reset();
     _extraLaserUniforms.reset();
     _glowLinePipeline.reset();
+    _reprojectionSourceFramebuffer.reset();
+    _reprojectionPipeline.reset();
+    _reprojectionUniforms.reset();
     Parent::uncustomizeContext();
 }
 
@@ -492,7 +565,7 @@ void HmdDisplayPlugin::updateFrameData() {
 
     for_each_eye([&](Eye eye) {
         auto modelView = glm::inverse(_currentPresentFrameInfo.presentPose * getEyeToHeadTransform(eye)) * modelMat;
-        _overlayRenderer.mvps[eye] = _eyeProjections[eye] * modelView;
+        _overlayRenderer.uniforms.mvps[eye] = _eyeProjections[eye] * modelView;
     });
 
     // Setup the uniforms
@@ -563,8 +636,7 @@ void HmdDisplayPlugin::OverlayRenderer::build() {
     format = std::make_shared<gpu::Stream::Format>(); // 1 for everyone
     format->setAttribute(gpu::Stream::POSITION, gpu::Stream::POSITION, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
     format->setAttribute(gpu::Stream::TEXCOORD, gpu::Stream::TEXCOORD, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV));
-    uniformBuffers[0] = std::make_shared<gpu::Buffer>(sizeof(Uniforms), nullptr);
-    uniformBuffers[1] = std::make_shared<gpu::Buffer>(sizeof(Uniforms), nullptr);
+    uniformBuffer = std::make_shared<gpu::Buffer>(sizeof(Uniforms), nullptr);
     updatePipeline();
 }
 
@@ -605,10 +677,8 @@ void HmdDisplayPlugin::OverlayRenderer::updatePipeline() {
 
 void HmdDisplayPlugin::OverlayRenderer::render(HmdDisplayPlugin& plugin) {
     updatePipeline();
-    for_each_eye([&](Eye eye){
-        uniforms.mvp = mvps[eye];
-        uniformBuffers[eye]->setSubData(0, uniforms);
-    });
+    uniforms.eyeWidth = (float)plugin.eyeViewport(Eye::Right).x;
+    uniformBuffer->setSubData(0, uniforms);
     plugin.render([&](gpu::Batch& batch) {
         batch.enableStereo(false);
         batch.setFramebuffer(plugin._compositeFramebuffer);
@@ -620,12 +690,9 @@ void HmdDisplayPlugin::OverlayRenderer::render(HmdDisplayPlugin& plugin) {
         batch.setInputBuffer(gpu::Stream::TEXCOORD, uvView);
         batch.setIndexBuffer(gpu::UINT16, indices, 0);
         batch.setResourceTexture(0, plugin._currentFrame->overlay);
-        // FIXME use stereo information input to set both MVPs in the uniforms
-        for_each_eye([&](Eye eye) {
-            batch.setUniformBuffer(uniformsLocation, uniformBuffers[eye]);
-            batch.setViewportTransform(plugin.eyeViewport(eye));
-            batch.drawIndexed(gpu::TRIANGLES, indexCount);
-        });
+        batch.setUniformBuffer(uniformsLocation, uniformBuffer);
+        batch.setViewportTransform(ivec4(uvec2(), plugin._compositeFramebuffer->getSize()));
+        batch.drawIndexedInstanced(2, gpu::TRIANGLES, indexCount);
     });
 }
 
@@ -653,11 +720,70 @@ void HmdDisplayPlugin::compositePointer() {
     });
 }
 
+void HmdDisplayPlugin::compositeLayers() {
+    Parent::compositeLayers();
+
+    if (!wantsReprojection()) {
+        return;
+    }
+
+    // keep the composite, the next presents may have to warp it
+    auto size = _compositeFramebuffer->getSize();
+    if (!_reprojectionSourceFramebuffer || _reprojectionSourceFramebuffer->getSize() != size) {
+        _reprojectionSourceFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("HmdDisplayPlugin::reprojectionSource",
+            gpu::Element::COLOR_RGBA_32, size.x, size.y));
+    }
+    render([&](gpu::Batch& batch) {
+        ivec4 rect(uvec2(), size);
+        batch.blit(_compositeFramebuffer, rect, _reprojectionSourceFramebuffer, rect);
+    });
+    _reprojectionSourcePose = _currentPresentFrameInfo.presentPose;
+}
+
+bool HmdDisplayPlugin::reprojectLastFrame() {
+    if (!wantsReprojection() || !_reprojectionSourceFramebuffer ||
+        _reprojectionSourceFramebuffer->getSize() != _compositeFramebuffer->getSize()) {
+        return false;
+    }
+
+    // only the rotation is corrected, the eyes moving within a frame barely shifts the scene
+    _currentPresentFrameInfo.presentReprojection =
+        glm::inverse(mat3(_reprojectionSourcePose)) * mat3(_currentPresentFrameInfo.presentPose);
+
+    ReprojectionData data;
+    for_each_eye([&](Eye eye) {
+        data.projections[eye] = _eyeProjections[eye];
+        data.inverseProjections[eye] = _eyeInverseProjections[eye];
+    });
+    data.reprojection = mat4(_currentPresentFrameInfo.presentReprojection);
+    _reprojectionUniforms->setSubData(0, data);
+
+    render([&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+        batch.resetViewTransform();
+        batch.setProjectionTransform(mat4());
+        batch.setFramebuffer(_compositeFramebuffer);
+        batch.setViewportTransform(ivec4(uvec2(), _compositeFramebuffer->getSize()));
+        batch.setPipeline(_reprojectionPipeline);
+        batch.setResourceTexture(0, _reprojectionSourceFramebuffer->getRenderBuffer(0));
+        batch.setUniformBuffer(REPROJECTION_DATA_SLOT, _reprojectionUniforms);
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+    });
+    return true;
+}
+
 void HmdDisplayPlugin::compositeOverlay() {
     if (!_currentFrame || !_currentFrame->overlay) {
         return;
     }
 
+    // a faded out overlay only draws the glow of the lasers on it
+    static const float OUT_OF_BOUNDS = -1;
+    const auto& uniforms = _overlayRenderer.uniforms;
+    if (uniforms.alpha <= 0.0f && uniforms.glowPoints == vec4(OUT_OF_BOUNDS) && uniforms.extraGlowPoint == vec2(OUT_OF_BOUNDS)) {
+        return;
+    }
+
     _overlayRenderer.render(*this);
 }
 
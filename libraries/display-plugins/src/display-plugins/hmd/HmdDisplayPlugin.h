@@ -55,14 +55,20 @@ protected:
     bool beginFrameRender(uint32_t frameIndex) override;
     bool internalActivate() override;
     void internalDeactivate() override;
+    void compositeLayers() override;
     void compositeOverlay() override;
     void compositePointer() override;
+    bool reprojectLastFrame() override;
     void internalPresent() override;
     void customizeContext() override;
     void uncustomizeContext() override;
     void updateFrameData() override;
     void compositeExtra() override;
 
+    // Whether the last composite is rotated to the latest head pose when there's no new frame to present, for the
+    // displays whose runtime doesn't reproject
+    virtual bool wantsReprojection() const { return !hasAsyncReprojection(); }
+
     struct HandLaserInfo {
         HandLaserMode mode { HandLaserMode::None };
         vec4 color { 1.0f };
@@ -124,6 +130,12 @@ private:
     gpu::TexturePointer _previewTexture;
     glm::vec2 _lastWindowSize;
 
+    // the last composite of a new frame, and the head pose it was composited for
+    gpu::FramebufferPointer _reprojectionSourceFramebuffer;
+    mat4 _reprojectionSourcePose;
+    gpu::PipelinePointer _reprojectionPipeline;
+    gpu::BufferPointer _reprojectionUniforms;
+
     struct OverlayRenderer {
         gpu::Stream::FormatPointer format;
         gpu::BufferPointer vertices;
@@ -132,12 +144,11 @@ private:
         gpu::PipelinePointer pipeline;
         int32_t uniformsLocation { -1 };
 
-        // FIXME this is stupid, use the built in transformation pipeline
-        std::array<gpu::BufferPointer, 2> uniformBuffers;
-        std::array<mat4, 2> mvps;
+        gpu::BufferPointer uniformBuffer;
 
+        // Both eyes are drawn in one instanced draw, indexing their mvp
         struct Uniforms {
-            mat4 mvp;
+            mat4 mvps[2];
             vec4 glowPoints { -1 };
             vec4 glowColors[2];
             vec2 resolution { CompositorHelper::VIRTUAL_SCREEN_SIZE };
@@ -146,6 +157,7 @@ private:
 
             vec4 extraGlowColor;
             vec2 extraGlowPoint { -1 };
+            float eyeWidth { 0.0f };
         } uniforms;
         
         struct Vertex {
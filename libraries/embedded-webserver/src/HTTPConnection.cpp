@@ -13,6 +13,9 @@
 #include <QBuffer>
 #include <QCryptographicHash>
 #include <QTcpSocket>
+#include <QTimer>
+
+#include <Gzip.h>
 
 #include "HTTPConnection.h"
 #include "EmbeddedWebserverLogging.h"
@@ -28,20 +31,35 @@ const char* HTTPConnection::StatusCode404 = "404 Not Found";
 const char* HTTPConnection::StatusCode500 = "500 Internal server error";
 const char* HTTPConnection::DefaultContentType = "text/plain; charset=ISO-8859-1";
 
+// the connections kept alive are closed after this long without a request
+const int IDLE_CONNECTION_TIMEOUT_MSECS = 30 * 1000;
+
+// the smaller content isn't worth the CPU of compressing it
+const int MIN_GZIPPED_CONTENT_SIZE = 4 * 1024;
+
+static bool isCompressibleContentType(const QByteArray& contentType) {
+    return contentType.startsWith("application/json") || contentType.startsWith("application/javascript") ||
+        contentType.startsWith("text/");
+}
+
 HTTPConnection::HTTPConnection (QTcpSocket* socket, HTTPManager* parentManager) :
-    QObject(parentManager),
     _parentManager(parentManager),
     _socket(socket),
     _stream(socket),
     _address(socket->peerAddress())
 {
-    // take over ownership of the socket
+    // take over ownership of the socket, which moves to the connection thread with us
     _socket->setParent(this);
 
+    _idleTimer = new QTimer(this);
+    _idleTimer->setSingleShot(true);
+    connect(_idleTimer, SIGNAL(timeout()), SLOT(closeConnection()));
+    _idleTimer->start(IDLE_CONNECTION_TIMEOUT_MSECS);
+
     // connect initial slots
     connect(socket, SIGNAL(readyRead()), SLOT(readRequest()));
-    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(deleteLater()));
-    connect(socket, SIGNAL(disconnected()), SLOT(deleteLater()));
+    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(closeConnection()));
+    connect(socket, SIGNAL(disconnected()), SLOT(closeConnection()));
 }
 
 HTTPConnection::~HTTPConnection() {
@@ -108,39 +126,192 @@ QList<FormData> HTTPConnection::parseFormData() const {
     return data;
 }
 
+static QByteArray toHeaderLines(const Headers& headers) {
+    QByteArray headerLines;
+    for (Headers::const_iterator it = headers.constBegin(), end = headers.constEnd();
+            it != end; it++) {
+        headerLines += it.key() + ": " + it.value() + "\r\n";
+    }
+    return headerLines;
+}
+
 void HTTPConnection::respond(const char* code, const QByteArray& content, const char* contentType, const Headers& headers) {
+    // called from the manager's thread, the socket is written on ours
+    QMetaObject::invokeMethod(this, "writeResponse", Qt::QueuedConnection, Q_ARG(QByteArray, QByteArray(code)),
+        Q_ARG(QByteArray, content), Q_ARG(QByteArray, QByteArray(contentType)), Q_ARG(QByteArray, toHeaderLines(headers)));
+}
+
+void HTTPConnection::respondChunked(const char* code, const char* contentType, const Headers& headers) {
+    QMetaObject::invokeMethod(this, "writeChunkedResponseHead", Qt::QueuedConnection, Q_ARG(QByteArray, QByteArray(code)),
+        Q_ARG(QByteArray, QByteArray(contentType)), Q_ARG(QByteArray, toHeaderLines(headers)));
+}
+
+void HTTPConnection::writeChunk(const QByteArray& chunk) {
+    if (!chunk.isEmpty()) {
+        QMetaObject::invokeMethod(this, "writeResponseChunk", Qt::QueuedConnection, Q_ARG(QByteArray, chunk));
+    }
+}
+
+void HTTPConnection::endChunkedResponse() {
+    QMetaObject::invokeMethod(this, "writeResponseChunk", Qt::QueuedConnection, Q_ARG(QByteArray, QByteArray()));
+}
+
+void HTTPConnection::writeResponseHead(const QByteArray& code, const QByteArray& headerLines) {
+    _hasResponded = true;
+
     _socket->write("HTTP/1.1 ");
     _socket->write(code);
     _socket->write("\r\n");
+    _socket->write(headerLines);
+    _socket->write(_keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
+}
 
-    int csize = content.size();
+void HTTPConnection::writeResponse(const QByteArray& code, const QByteArray& content, const QByteArray& contentType,
+                                   const QByteArray& headerLines) {
+    if (_hasResponded) {
+        qCWarning(embeddedwebserver) << "Ignoring a second response to a request." << _address << code;
+        return;
+    }
 
-    for (Headers::const_iterator it = headers.constBegin(), end = headers.constEnd();
-            it != end; it++) {
-        _socket->write(it.key());
-        _socket->write(": ");
-        _socket->write(it.value());
-        _socket->write("\r\n");
+    QByteArray body = content;
+    QByteArray contentHeaderLines = headerLines;
+    if (_acceptsGzip && content.size() >= MIN_GZIPPED_CONTENT_SIZE && isCompressibleContentType(contentType) &&
+            !headerLines.contains("Content-Encoding")) {
+        QByteArray compressed;
+        if (gzip(content, compressed)) {
+            body = compressed;
+            contentHeaderLines += "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n";
+        }
     }
+
+    int csize = body.size();
     if (csize > 0) {
-        _socket->write("Content-Length: ");
-        _socket->write(QByteArray::number(csize));
-        _socket->write("\r\n");
+        contentHeaderLines += "Content-Length: " + QByteArray::number(csize) + "\r\n";
+        contentHeaderLines += "Content-Type: " + contentType + "\r\n";
+    } else if (_keepAlive) {
+        // the client can't tell where an empty response ends otherwise
+        contentHeaderLines += "Content-Length: 0\r\n";
+    }
+
+    writeResponseHead(code, contentHeaderLines);
+    _socket->write("\r\n");
+
+    if (csize > 0) {
+        _socket->write(body);
+    }
+
+    _isResponseComplete = true;
+    completeRequest();
+}
 
-        _socket->write("Content-Type: ");
-        _socket->write(contentType);
+void HTTPConnection::writeChunkedResponseHead(const QByteArray& code, const QByteArray& contentType,
+                                              const QByteArray& headerLines) {
+    if (_hasResponded) {
+        qCWarning(embeddedwebserver) << "Ignoring a second response to a request." << _address << code;
+        return;
+    }
+
+    // the HTTP/1.0 clients don't know about chunks, the end of the content is the end of the connection for them
+    _isChunked = true;
+    if (!_isHTTP11) {
+        _keepAlive = false;
+    }
+
+    QByteArray contentHeaderLines = headerLines;
+    contentHeaderLines += "Content-Type: " + contentType + "\r\n";
+    if (_isHTTP11) {
+        contentHeaderLines += "Transfer-Encoding: chunked\r\n";
+    }
+    writeResponseHead(code, contentHeaderLines);
+    _socket->write("\r\n");
+}
+
+void HTTPConnection::writeResponseChunk(const QByteArray& chunk) {
+    if (!_isChunked || _isResponseComplete) {
+        return;
+    }
+
+    if (_isHTTP11) {
+        _socket->write(QByteArray::number(chunk.size(), 16));
         _socket->write("\r\n");
+        _socket->write(chunk);
+        _socket->write("\r\n");
+    } else {
+        _socket->write(chunk);
     }
-    _socket->write("Connection: close\r\n\r\n");
 
-    if (csize > 0) {
-        _socket->write(content);
+    if (chunk.isEmpty()) {
+        _isChunked = false;
+        _isResponseComplete = true;
+        completeRequest();
+    }
+}
+
+void HTTPConnection::completeRequest() {
+    if (_isHandlingRequest || !_isResponseComplete) {
+        return;
+    }
+
+    if (_isClosing) {
+        deleteLater();
+        return;
     }
 
-    // make sure we receive no further read notifications
+    if (!_keepAlive) {
+        // make sure we receive no further read notifications
+        _socket->disconnect(SIGNAL(readyRead()), this);
+
+        _socket->disconnectFromHost();
+        return;
+    }
+
+    // wait for the next request, which may have arrived already
+    _requestHeaders.clear();
+    _lastRequestHeader.clear();
+    _requestContent.clear();
+    _hasResponded = false;
+
+    _idleTimer->start(IDLE_CONNECTION_TIMEOUT_MSECS);
     _socket->disconnect(SIGNAL(readyRead()), this);
+    connect(_socket, SIGNAL(readyRead()), SLOT(readRequest()));
+    readRequest();
+}
+
+void HTTPConnection::dispatchRequest(const QUrl& url) {
+    _idleTimer->stop();
+    _isHandlingRequest = true;
+    _isResponseComplete = false;
+
+    QByteArray connection = _requestHeaders.value("Connection").toLower();
+    _keepAlive = _isHTTP11 ? !connection.contains("close") : connection.contains("keep-alive");
+    _acceptsGzip = _requestHeaders.value("Accept-Encoding").contains("gzip");
 
-    _socket->disconnectFromHost();
+    QMetaObject::invokeMethod(_parentManager, "handleQueuedRequest", Qt::QueuedConnection,
+        Q_ARG(HTTPConnection*, this), Q_ARG(QUrl, url));
+}
+
+void HTTPConnection::requestHandled() {
+    _isHandlingRequest = false;
+
+    if (!_hasResponded) {
+        qCWarning(embeddedwebserver) << "Request was not responded to." << _address << _requestUrl;
+        _keepAlive = false;
+        writeResponse(StatusCode500, QByteArray(), DefaultContentType, QByteArray());
+        return;
+    }
+    completeRequest();
+}
+
+void HTTPConnection::closeConnection() {
+    // the request being handled still has the connection, it's deleted once it's done with
+    _isClosing = true;
+    _idleTimer->stop();
+    _socket->disconnect(SIGNAL(readyRead()), this);
+
+    if (_socket->state() != QAbstractSocket::UnconnectedState) {
+        _socket->disconnectFromHost();
+    }
+    completeRequest();
 }
 
 void HTTPConnection::readRequest() {
@@ -166,11 +337,14 @@ void HTTPConnection::readRequest() {
 
     } else {
         qWarning() << "Unrecognized HTTP operation." << _address << line;
+        _socket->disconnect(this, SLOT(readRequest()));
+        _keepAlive = false;
         respond("400 Bad Request", "Unrecognized operation.");
         return;
     }
     int idx = line.indexOf(' ') + 1;
     _requestUrl.setUrl(line.mid(idx, line.lastIndexOf(' ') - idx));
+    _isHTTP11 = line.endsWith("HTTP/1.1");
 
     // switch to reading the header
     _socket->disconnect(this, SLOT(readRequest()));
@@ -189,7 +363,7 @@ void HTTPConnection::readHeaders() {
 
             QByteArray clength = _requestHeaders.value("Content-Length");
             if (clength.isEmpty()) {
-                _parentManager->handleHTTPRequest(this, _requestUrl);
+                dispatchRequest(_requestUrl);
 
             } else {
                 _requestContent.resize(clength.toInt());
@@ -208,6 +382,8 @@ void HTTPConnection::readHeaders() {
         int idx = trimmed.indexOf(':');
         if (idx == -1) {
             qWarning() << "Invalid header." << _address << trimmed;
+            _socket->disconnect(this, SLOT(readHeaders()));
+            _keepAlive = false;
             respond("400 Bad Request", "The header was malformed.");
             return;
         }
@@ -228,5 +404,5 @@ void HTTPConnection::readContent() {
     _socket->read(_requestContent.data(), size);
     _socket->disconnect(this, SLOT(readContent()));
 
-    _parentManager->handleHTTPRequest(this, _requestUrl.path());
+    dispatchRequest(_requestUrl.path());
 }
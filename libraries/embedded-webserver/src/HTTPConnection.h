@@ -27,6 +27,7 @@
 #include <QUrl>
 
 class QTcpSocket;
+class QTimer;
 class HTTPManager;
 class MaskFilter;
 class ServerApp;
@@ -37,7 +38,9 @@ typedef QHash<QByteArray, QByteArray> Headers;
 /// A form data element
 typedef QPair<Headers, QByteArray> FormData;
 
-/// Handles a single HTTP connection.
+/// Handles a single HTTP connection, on the connection thread of its manager.
+/// The requests are handled on the manager's thread, one at a time, and the connection is kept alive between them
+/// when the client asks for it.
 class HTTPConnection : public QObject {
    Q_OBJECT
 
@@ -79,11 +82,23 @@ public:
     /// Parses the request content as form data, returning a list of header/content pairs.
     QList<FormData> parseFormData () const;
 
-    /// Sends a response and closes the connection.
+    /// Sends a response, and closes the connection unless it is kept alive. The JSON and text content that is large
+    /// enough is gzipped for the clients that accept it.
     void respond (const char* code, const QByteArray& content = QByteArray(),
         const char* contentType = DefaultContentType,
         const Headers& headers = Headers());
 
+    /// Starts a response whose content is sent in chunks as it is made, until endChunkedResponse; the connection
+    /// stays open until then.
+    void respondChunked (const char* code, const char* contentType = DefaultContentType,
+        const Headers& headers = Headers());
+
+    /// Sends a chunk of a chunked response.
+    void writeChunk (const QByteArray& chunk);
+
+    /// Ends a chunked response.
+    void endChunkedResponse ();
+
 protected slots:
 
     /// Reads the request line.
@@ -95,8 +110,33 @@ protected slots:
     /// Reads the content.
     void readContent ();
 
+    /// Called once the manager is done with the request.
+    void requestHandled ();
+
+    /// Closes the connection, once the request being handled is done with.
+    void closeConnection ();
+
+    /// Writes a whole response.
+    void writeResponse (const QByteArray& code, const QByteArray& content, const QByteArray& contentType,
+        const QByteArray& headerLines);
+
+    /// Writes the head of a chunked response.
+    void writeChunkedResponseHead (const QByteArray& code, const QByteArray& contentType, const QByteArray& headerLines);
+
+    /// Writes a chunk of a chunked response, the last one if empty.
+    void writeResponseChunk (const QByteArray& chunk);
+
 protected:
 
+    /// Hands the request to the manager.
+    void dispatchRequest (const QUrl& url);
+
+    /// Writes the status line and the headers shared by the responses.
+    void writeResponseHead (const QByteArray& code, const QByteArray& headerLines);
+
+    /// Waits for the next request, or closes the connection, once the request and its response are done.
+    void completeRequest ();
+
     /// The parent HTTP manager
     HTTPManager* _parentManager;
 
@@ -123,6 +163,31 @@ protected:
 
     /// The content of the request.
     QByteArray _requestContent;
+
+    /// Whether the request is HTTP/1.1.
+    bool _isHTTP11 { false };
+
+    /// Whether the connection is kept alive after the response.
+    bool _keepAlive { false };
+
+    /// Whether the client accepts gzipped content.
+    bool _acceptsGzip { false };
+
+    /// Whether the manager is handling the request.
+    bool _isHandlingRequest { false };
+
+    /// Whether the response to the request was started, and whether it was all written.
+    bool _hasResponded { false };
+    bool _isResponseComplete { true };
+
+    /// Whether the response is chunked.
+    bool _isChunked { false };
+
+    /// Whether the socket closed.
+    bool _isClosing { false };
+
+    /// Closes the connections kept alive with no requests.
+    QTimer* _idleTimer;
 };
 
 #endif // hifi_HTTPConnection_h
@@ -35,18 +35,54 @@ HTTPManager::HTTPManager(const QHostAddress& listenAddress, quint16 port, const
     _isListeningTimer = new QTimer(this);
     connect(_isListeningTimer, &QTimer::timeout, this, &HTTPManager::isTcpServerListening);
     _isListeningTimer->start(SOCKET_CHECK_INTERVAL_IN_MS);
+
+    qRegisterMetaType<HTTPConnection*>();
+    _connectionThread.setObjectName("HTTP Connections");
+    _connectionThread.start();
+}
+
+HTTPManager::~HTTPManager() {
+    // close and delete the connections on their own thread, which deletes them when it finishes at the latest
+    {
+        QMutexLocker locker(&_connectionsMutex);
+        for (auto connection : _connections) {
+            connection->deleteLater();
+        }
+    }
+    _connectionThread.quit();
+    _connectionThread.wait();
 }
 
 void HTTPManager::incomingConnection(qintptr socketDescriptor) {
     QTcpSocket* socket = new QTcpSocket(this);
     
     if (socket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPConnection(socket, this);
+        startConnection(new HTTPConnection(socket, this));
     } else {
         delete socket;
     }
 }
 
+void HTTPManager::startConnection(HTTPConnection* connection) {
+    {
+        QMutexLocker locker(&_connectionsMutex);
+        _connections.insert(connection);
+    }
+    connect(connection, &QObject::destroyed, this, [this, connection] {
+        QMutexLocker locker(&_connectionsMutex);
+        _connections.remove(connection);
+    }, Qt::DirectConnection);
+
+    connection->moveToThread(&_connectionThread);
+}
+
+void HTTPManager::handleQueuedRequest(HTTPConnection* connection, const QUrl& url) {
+    handleHTTPRequest(connection, url);
+
+    // the responses were queued to the connection ahead of this
+    QMetaObject::invokeMethod(connection, "requestHandled", Qt::QueuedConnection);
+}
+
 bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
     if (!skipSubHandler && requestHandledByRequestHandler(connection, url)) {
         // this request was handled by our request handler object
@@ -17,6 +17,9 @@
 #define hifi_HTTPManager_h
 
 #include <QtNetwork/QTcpServer>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 class HTTPConnection;
@@ -29,17 +32,23 @@ public:
 };
 
 /// Handles HTTP connections
+///   The connections are read and written on a thread of their own, so that slow clients and large responses don't hold
+///   up the thread of the manager; the requests are handled on the manager's thread.
 class HTTPManager : public QTcpServer, public HTTPRequestHandler {
    Q_OBJECT
 public:
     /// Initializes the manager.
     HTTPManager(const QHostAddress& listenAddress, quint16 port, const QString& documentRoot, HTTPRequestHandler* requestHandler = NULL, QObject* parent = 0);
+    virtual ~HTTPManager();
     
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
 private slots:
     void isTcpServerListening();
     void queuedExit(QString errorMessage);
+
+    /// Handles a request read by a connection, on the manager's thread.
+    void handleQueuedRequest(HTTPConnection* connection, const QUrl& url);
     
 private:
     bool bindSocket();
@@ -48,12 +57,20 @@ protected:
     /// Accepts all pending connections
     virtual void incomingConnection(qintptr socketDescriptor) override;
     virtual bool requestHandledByRequestHandler(HTTPConnection* connection, const QUrl& url);
+
+    /// Hands a new connection over to the connection thread.
+    void startConnection(HTTPConnection* connection);
     
     QHostAddress _listenAddress;
     QString _documentRoot;
     HTTPRequestHandler* _requestHandler;
     QTimer* _isListeningTimer;
     const quint16 _port;
+    QThread _connectionThread;
+
+    /// The connections open on the connection thread, which are deleted along with the manager.
+    QMutex _connectionsMutex;
+    QSet<HTTPConnection*> _connections;
 };
 
 #endif // hifi_HTTPManager_h
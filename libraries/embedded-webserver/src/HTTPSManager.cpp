@@ -33,7 +33,7 @@ void HTTPSManager::incomingConnection(qintptr socketDescriptor) {
     sslSocket->setPeerVerifyMode(QSslSocket::VerifyNone);
     
     if (sslSocket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPSConnection(sslSocket, this);
+        startConnection(new HTTPSConnection(sslSocket, this));
     } else {
         delete sslSocket;
     }
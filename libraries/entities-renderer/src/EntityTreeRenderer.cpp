@@ -138,9 +138,13 @@ void EntityTreeRenderer::clear() {
         qCWarning(entitiesrenderer) << "EntitityTreeRenderer::clear(), Unexpected null scene, possibly during application shutdown";
     }
     _entitiesInScene.clear();
+    _entitiesToAddQueue.clear();
+    _entitiesToAdd.clear();
 
     // reset the zone to the default (while we load the next scene)
     _layeredZones.clear();
+    _zoneCheckCandidates.clear();
+    _zoneCheckCandidatesFound = 0;
     applyZoneAndHasSkybox(nullptr);
 
     OctreeRenderer::clear();
@@ -193,6 +197,8 @@ void EntityTreeRenderer::update() {
         EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
         tree->update();
 
+        addPendingEntitiesToScene();
+
         // Handle enter/leave entity logic
         bool updated = checkEnterLeaveEntities();
 
@@ -218,45 +224,76 @@ void EntityTreeRenderer::update() {
 
 bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar) {
     bool didUpdate = false;
-    float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
-    QVector<EntityItemPointer> foundEntities;
+    QVector<EntityItemPointer>& foundEntities = _foundEntities;
+    auto now = usecTimestampNow();
+    bool avatarMoved = _avatarPosition != _zoneCheckPosition;
+    bool findCandidates = _zoneCheckCandidatesFound == 0 ||
+        (now - _zoneCheckCandidatesFound) > ZONE_CHECK_CANDIDATES_INTERVAL ||
+        glm::distance(_avatarPosition, _zoneCheckCandidatesCenter) > ZONE_CHECK_CANDIDATES_RADIUS;
 
     // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
+        if (findCandidates) {
+            // an entity containing any point of the candidates' sphere touches the sphere, so is found here
+            std::static_pointer_cast<EntityTree>(_tree)->findEntities(_avatarPosition,
+                ZONE_CHECK_CANDIDATES_RADIUS, foundEntities);
+
+            _zoneCheckCandidates.clear();
+            for (auto& entity : foundEntities) {
+                // only consider entities that are zones or have scripts, all other entities can
+                // be ignored because they can have events fired on them.
+                // FIXME - this could be optimized further by determining if the script is loaded
+                // and if it has either an enterEntity or leaveEntity method
+                if (entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty()) {
+                    // now check to see if the point contains our entity, this can be expensive if
+                    // the entity has a collision hull
+                    _zoneCheckCandidates.push_back({ entity, entity->contains(_avatarPosition) });
+                }
+            }
+            _zoneCheckCandidatesCenter = _avatarPosition;
+            _zoneCheckCandidatesFound = now;
 
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        std::static_pointer_cast<EntityTree>(_tree)->findEntities(_avatarPosition, radius, foundEntities);
-
-        LayeredZones oldLayeredZones(std::move(_layeredZones));
-        _layeredZones.clear();
+            // let go of the entities, but keep the buffer for next time
+            foundEntities.resize(0);
+        } else {
+            for (auto& candidate : _zoneCheckCandidates) {
+                auto& entity = candidate.entity;
+                if (avatarMoved || entity->tranlationChangedSince(_zoneCheckTime) ||
+                        entity->rotationChangedSince(_zoneCheckTime) || entity->scaleChangedSince(_zoneCheckTime)) {
+                    candidate.isInside = entity->contains(_avatarPosition);
+                }
+            }
+        }
 
         // create a list of entities that actually contain the avatar's position
-        for (auto& entity : foundEntities) {
-            auto isZone = entity->getType() == EntityTypes::Zone;
-            auto hasScript = !entity->getScript().isEmpty();
-
-            // only consider entities that are zones or have scripts, all other entities can
-            // be ignored because they can have events fired on them.
-            // FIXME - this could be optimized further by determining if the script is loaded
-            // and if it has either an enterEntity or leaveEntity method
-            if (isZone || hasScript) {
-                // now check to see if the point contains our entity, this can be expensive if
-                // the entity has a collision hull
-                if (entity->contains(_avatarPosition)) {
-                    if (entitiesContainingAvatar) {
-                        *entitiesContainingAvatar << entity->getEntityItemID();
-                    }
+        _containingZones.clear();
+        for (auto& candidate : _zoneCheckCandidates) {
+            if (candidate.isInside) {
+                auto& entity = candidate.entity;
+                if (entitiesContainingAvatar) {
+                    *entitiesContainingAvatar << entity->getEntityItemID();
+                }
 
-                    // if this entity is a zone and visible, determine if it is the bestZone
-                    if (isZone && entity->getVisible()) {
-                        auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
-                        _layeredZones.insert(zone);
-                    }
+                // if this entity is a zone and visible, determine if it is the bestZone
+                if (entity->getType() == EntityTypes::Zone && entity->getVisible()) {
+                    _containingZones.push_back(std::static_pointer_cast<ZoneEntityItem>(entity));
                 }
             }
         }
 
+        // most checks find the zones we were already in, which need no re-layering
+        if (_layeredZones.hasZones(_containingZones)) {
+            return;
+        }
+
+        LayeredZones oldLayeredZones(std::move(_layeredZones));
+        _layeredZones.clear();
+        for (auto& zone : _containingZones) {
+            _layeredZones.insert(zone);
+        }
+        _containingZones.clear();
+
         // check if our layered zones have changed
         if (_layeredZones.empty()) {
             if (oldLayeredZones.empty()) {
@@ -270,6 +307,9 @@ bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QVector<EntityIt
         _layeredZones.apply();
         didUpdate = true;
     });
+    _containingZones.clear();
+    _zoneCheckPosition = _avatarPosition;
+    _zoneCheckTime = now;
 
     return didUpdate;
 }
@@ -343,6 +383,7 @@ void EntityTreeRenderer::forceRecheckEntities() {
     // make sure our "last avatar position" is something other than our current position, 
     // so that on our next chance, we'll check for enter/leave entity events.
     _avatarPosition = _viewState->getAvatarPosition() + glm::vec3((float)TREE_SCALE);
+    _zoneCheckCandidatesFound = 0;
 }
 
 bool EntityTreeRenderer::applyZoneAndHasSkybox(const std::shared_ptr<ZoneEntityItem>& zone) {
@@ -948,6 +989,8 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
 
     forceRecheckEntities(); // reset our state to force checking our inside/outsideness of entities
 
+    _entitiesToAdd.remove(entityID);
+
     // here's where we remove the entity payload from the scene
     if (_entitiesInScene.contains(entityID)) {
         auto entity = _entitiesInScene.take(entityID);
@@ -963,34 +1006,49 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
 }
 
 void EntityTreeRenderer::addingEntity(const EntityItemID& entityID) {
-    qDebug() << __FUNCTION__ << "entityID:" << entityID;
     forceRecheckEntities(); // reset our state to force checking our inside/outsideness of entities
     checkAndCallPreload(entityID);
-    auto entity = std::static_pointer_cast<EntityTree>(_tree)->findEntityByID(entityID);
-    if (entity) {
-        addEntityToScene(entity);
+
+    // the payload is added to the scene by the next update()s, within their budget
+    if (!_entitiesToAdd.contains(entityID) && !_entitiesInScene.contains(entityID)) {
+        _entitiesToAdd.insert(entityID);
+        _entitiesToAddQueue.push_back(entityID);
     }
 }
 
-void EntityTreeRenderer::addEntityToScene(EntityItemPointer entity) {
-    qDebug() << __FUNCTION__ << "entity:" << entity->getID();
-    // here's where we add the entity payload to the scene
-    render::PendingChanges pendingChanges;
+void EntityTreeRenderer::addPendingEntitiesToScene() {
+    if (_entitiesToAdd.isEmpty()) {
+        _entitiesToAddQueue.clear();
+        return;
+    }
+    PerformanceTimer perfTimer("addEntitiesToScene");
+
+    // here's where we add the entity payloads to the scene
     auto scene = _viewState->getMain3DScene();
-    if (scene) {
-        qDebug() << __FUNCTION__ << "entity:" << entity->getID() << "line:" << __LINE__;
-        if (entity->addToScene(entity, scene, pendingChanges)) {
-            qDebug() << __FUNCTION__ << "entity:" << entity->getID() << "line:" << __LINE__;
-            _entitiesInScene.insert(entity->getEntityItemID(), entity);
+    if (!scene) {
+        qCWarning(entitiesrenderer) << "EntityTreeRenderer::addPendingEntitiesToScene(), Unexpected null scene, possibly during application shutdown";
+        return;
+    }
+    auto tree = std::static_pointer_cast<EntityTree>(_tree);
+    render::PendingChanges pendingChanges;
+    auto start = usecTimestampNow();
+    while (!_entitiesToAddQueue.empty() && (usecTimestampNow() - start) < ADD_TO_SCENE_BUDGET) {
+        EntityItemID entityID = _entitiesToAddQueue.front();
+        _entitiesToAddQueue.pop_front();
+        if (!_entitiesToAdd.remove(entityID)) {
+            continue; // deleted before its turn
+        }
+        auto entity = tree->findEntityByID(entityID);
+        if (entity && entity->addToScene(entity, scene, pendingChanges)) {
+            _entitiesInScene.insert(entityID, entity);
         }
-        scene->enqueuePendingChanges(pendingChanges);
-    } else {
-        qCWarning(entitiesrenderer) << "EntityTreeRenderer::addEntityToScene(), Unexpected null scene, possibly during application shutdown";
     }
+    scene->enqueuePendingChanges(std::move(pendingChanges));
 }
 
 
 void EntityTreeRenderer::entityScriptChanging(const EntityItemID& entityID, const bool reload) {
+    _zoneCheckCandidatesFound = 0; // it may have become, or stopped being, a candidate for enter/leave events
     checkAndCallPreload(entityID, reload, true);
 }
 
@@ -1093,7 +1151,7 @@ void EntityTreeRenderer::updateEntityRenderStatus(bool shouldRenderEntities) {
         }
         _entityIDsLastInScene.clear();
     } else {
-        _entityIDsLastInScene = _entitiesInScene.keys();
+        _entityIDsLastInScene = _entitiesInScene.keys() + _entitiesToAdd.toList();
         for (auto entityID : _entityIDsLastInScene) {
             // FIXME - is this really right? do we want to do the deletingEntity() code or just remove from the scene.
             deletingEntity(entityID);
@@ -1227,3 +1285,16 @@ bool EntityTreeRenderer::LayeredZones::contains(const LayeredZones& other) {
     }
     return result;
 }
+
+bool EntityTreeRenderer::LayeredZones::hasZones(const std::vector<std::shared_ptr<ZoneEntityItem>>& zones) const {
+    if (zones.size() != size()) {
+        return false;
+    }
+    for (auto& zone : zones) {
+        auto layer = _map.find(zone->getID());
+        if (layer == _map.end() || layer->second->volume != zone->getVolumeEstimate()) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTreeRenderer_h
 #define hifi_EntityTreeRenderer_h
 
+#include <deque>
+
 #include <QSet>
 #include <QStack>
 
@@ -144,7 +146,7 @@ protected:
 private:
     void resetEntitiesScriptEngine();
 
-    void addEntityToScene(EntityItemPointer entity);
+    void addPendingEntitiesToScene();
     bool findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar = nullptr);
 
     bool applyZoneAndHasSkybox(const std::shared_ptr<ZoneEntityItem>& zone);
@@ -219,6 +221,9 @@ private:
 
         bool contains(const LayeredZones& other);
 
+        // whether these are the zones already layered, with the same volumes, so there is nothing to sort or apply
+        bool hasZones(const std::vector<std::shared_ptr<ZoneEntityItem>>& zones) const;
+
         std::shared_ptr<ZoneEntityItem> getZone() { return empty() ? nullptr : begin()->zone; }
 
     private:
@@ -230,6 +235,22 @@ private:
     };
 
     LayeredZones _layeredZones;
+    QVector<EntityItemPointer> _foundEntities; // reused by each zone check
+
+    // The zones and scripted entities near the avatar, among which each zone check looks for those containing it.
+    // They are found again only when the avatar leaves the sphere they were found in, an entity is added, deleted or
+    // has its script changed, or ZONE_CHECK_CANDIDATES_INTERVAL passes (for entities moving in from further away).
+    // In between, a candidate is tested again only if it or the avatar moved since the last check.
+    struct ZoneCheckCandidate {
+        EntityItemPointer entity;
+        bool isInside;
+    };
+    std::vector<ZoneCheckCandidate> _zoneCheckCandidates;
+    glm::vec3 _zoneCheckCandidatesCenter { 0.0f };
+    quint64 _zoneCheckCandidatesFound { 0 }; // 0 when they need finding again
+    glm::vec3 _zoneCheckPosition { 0.0f }; // where the avatar was at the last check
+    quint64 _zoneCheckTime { 0 };
+    std::vector<std::shared_ptr<ZoneEntityItem>> _containingZones; // reused by each zone check
     QString _zoneUserData;
     NetworkTexturePointer _ambientTexture;
     NetworkTexturePointer _skyboxTexture;
@@ -241,8 +262,17 @@ private:
     quint64 _lastZoneCheck { 0 };
     const quint64 ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
     const float ZONE_CHECK_DISTANCE = 0.001f;
+    const float ZONE_CHECK_CANDIDATES_RADIUS = 2.0f; // meters
+    const quint64 ZONE_CHECK_CANDIDATES_INTERVAL = USECS_PER_SECOND;
 
     QHash<EntityItemID, EntityItemPointer> _entitiesInScene;
+
+    // Entities added to the tree but not yet to the scene, in the order they were added. Each update() adds as many
+    // as fit in ADD_TO_SCENE_BUDGET, in one transaction, so a burst of arriving entities is spread over frames.
+    // An ID in the queue but not the set was deleted before it was added.
+    std::deque<EntityItemID> _entitiesToAddQueue;
+    QSet<EntityItemID> _entitiesToAdd;
+    const quint64 ADD_TO_SCENE_BUDGET = USECS_PER_MSEC * 2;
     // For Scene.shouldRenderEntities
     QList<EntityItemID> _entityIDsLastInScene;
 
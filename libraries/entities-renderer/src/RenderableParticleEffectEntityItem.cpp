@@ -39,13 +39,19 @@ public:
         InterpolationData<float> radius;
         InterpolationData<glm::vec4> color; // rgba
         float lifespan;
-        glm::vec3 spare;
+        float time; // the emitter's, which the particles' emit times count from
+        glm::vec2 spare;
     };
     
+    // What a particle was emitted with.  It isn't changed after, since the vertex shader places the particle from
+    // this and the emitter's time.
     struct ParticlePrimitive {
-        ParticlePrimitive(glm::vec3 xyzIn, glm::vec2 uvIn) : xyz(xyzIn), uv(uvIn) {}
+        ParticlePrimitive(glm::vec3 xyzIn, glm::vec3 velocityIn, glm::vec3 accelerationIn, glm::vec2 uvIn) :
+            xyz(xyzIn), velocity(velocityIn), acceleration(accelerationIn), uv(uvIn) {}
         glm::vec3 xyz; // Position
-        glm::vec2 uv; // Lifetime + seed
+        glm::vec3 velocity;
+        glm::vec3 acceleration;
+        glm::vec2 uv; // Emit time + seed
     };
     
     using Payload = render::Payload<ParticlePayloadData>;
@@ -65,6 +71,10 @@ public:
         
         _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
                                     offsetof(ParticlePrimitive, xyz), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element::VEC3F_XYZ,
+                                    offsetof(ParticlePrimitive, velocity), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element::VEC3F_XYZ,
+                                    offsetof(ParticlePrimitive, acceleration), gpu::Stream::PER_INSTANCE);
         _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC2F_UV,
                                     offsetof(ParticlePrimitive, uv), gpu::Stream::PER_INSTANCE);
     }
@@ -172,6 +182,7 @@ bool RenderableParticleEffectEntityItem::addToScene(EntityItemPointer self,
     makeEntityItemStatusGetters(getThisPointer(), statusGetters);
     renderPayload->addStatusGetters(statusGetters);
     pendingChanges.resetItem(_renderItemId, renderPayload);
+    _particlesChanged = true; // the new payload has none of them yet
     return true;
 }
 
@@ -230,14 +241,8 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     particleUniforms.color.finish = glm::vec4(getColorFinishRGB(), getAlphaFinish());
     particleUniforms.color.spread = glm::vec4(getColorSpreadRGB(), getAlphaSpread());
     particleUniforms.lifespan = getLifespan();
+    particleUniforms.time = _particleTime;
     
-    // Build particle primitives
-    auto particlePrimitives = std::make_shared<ParticlePrimitives>();
-    particlePrimitives->reserve(_particles.size()); // Reserve space
-    for (auto& particle : _particles) {
-        particlePrimitives->emplace_back(particle.position, glm::vec2(particle.lifetime, particle.seed));
-    }
-
     bool successb, successp, successr;
     auto bounds = getAABox(successb);
     auto position = getPosition(successp);
@@ -246,6 +251,19 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     if (!success) {
         return;
     }
+
+    // Build particle primitives, only when particles were emitted or died
+    std::shared_ptr<ParticlePrimitives> particlePrimitives;
+    if (_particlesChanged) {
+        particlePrimitives = std::make_shared<ParticlePrimitives>();
+        particlePrimitives->reserve(_particles.size()); // Reserve space
+        for (auto& particle : _particles) {
+            particlePrimitives->emplace_back(particle.position, particle.velocity, particle.acceleration,
+                                             glm::vec2(particle.emitTime, particle.seed));
+        }
+        _particlesChanged = false;
+    }
+
     Transform transform;
     if (!getEmitterShouldTrail()) {
         transform.setTranslation(position);
@@ -262,12 +280,16 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
         
         // Update particle buffer
         auto particleBuffer = payload.getParticleBuffer();
-        size_t numBytes = sizeof(ParticlePrimitive) * particlePrimitives->size();
-        particleBuffer->resize(numBytes);
-        if (numBytes == 0) {
+        if (particlePrimitives) {
+            size_t numBytes = sizeof(ParticlePrimitive) * particlePrimitives->size();
+            particleBuffer->resize(numBytes);
+            if (numBytes > 0) {
+                particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
+            }
+        }
+        if (particleBuffer->getSize() == 0) {
             return;
         }
-        particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
 
         // Update transform and bounds
         payload.setModelTransform(transform);
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <glm/gtx/quaternion.hpp>
 
 #include <GeometryCache.h>
@@ -25,9 +27,13 @@
 
 struct PolyLineUniforms {
     glm::vec3 color;
+    float numPoints;
 };
 
-
+// each instance is a segment of the stroke, a quad between its start and end
+static const int VERTICES_PER_SEGMENT = 4;
+// the start, end and the point after the end of the segment, views of the same buffer one point apart
+static const int NUM_POINT_VIEWS = 3;
 
 EntityItemPointer RenderablePolyLineEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
     EntityItemPointer entity{ new RenderablePolyLineEntityItem(entityID) };
@@ -37,9 +43,8 @@ EntityItemPointer RenderablePolyLineEntityItem::factory(const EntityItemID& enti
 
 RenderablePolyLineEntityItem::RenderablePolyLineEntityItem(const EntityItemID& entityItemID) :
 PolyLineEntityItem(entityItemID),
-_numVertices(0)
+_pointsBuffer(std::make_shared<gpu::Buffer>())
 {
-    _vertices = QVector<glm::vec3>(0.0f);
     PolyLineUniforms uniforms;
     _uniformBuffer = std::make_shared<gpu::Buffer>(sizeof(PolyLineUniforms), (const gpu::Byte*) &uniforms);
 }
@@ -50,13 +55,18 @@ const int32_t RenderablePolyLineEntityItem::PAINTSTROKE_TEXTURE_SLOT;
 const int32_t RenderablePolyLineEntityItem::PAINTSTROKE_UNIFORM_SLOT;
 
 void RenderablePolyLineEntityItem::createPipeline() {
-    static const int NORMAL_OFFSET = 12;
-    static const int TEXTURE_OFFSET = 24;
-
+    // see paintStroke.slv for which point each of the attributes is
     _format.reset(new gpu::Stream::Format());
-    _format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
-    _format->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), NORMAL_OFFSET);
-    _format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), TEXTURE_OFFSET);
+    _format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC4F_XYZW,
+                          offsetof(PolyLinePoint, positionAndWidth), gpu::Stream::PER_INSTANCE);
+    _format->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element::VEC4F_XYZW,
+                          offsetof(PolyLinePoint, normal), gpu::Stream::PER_INSTANCE);
+    _format->setAttribute(gpu::Stream::TEXCOORD0, 1, gpu::Element::VEC4F_XYZW,
+                          offsetof(PolyLinePoint, positionAndWidth), gpu::Stream::PER_INSTANCE);
+    _format->setAttribute(gpu::Stream::TANGENT, 1, gpu::Element::VEC4F_XYZW,
+                          offsetof(PolyLinePoint, normal), gpu::Stream::PER_INSTANCE);
+    _format->setAttribute(gpu::Stream::TEXCOORD1, 2, gpu::Element::VEC4F_XYZW,
+                          offsetof(PolyLinePoint, positionAndWidth), gpu::Stream::PER_INSTANCE);
 
     auto VS = gpu::Shader::createVertex(std::string(paintStroke_vert));
     auto PS = gpu::Shader::createPixel(std::string(paintStroke_frag));
@@ -75,100 +85,42 @@ void RenderablePolyLineEntityItem::createPipeline() {
     _pipeline = gpu::Pipeline::create(program, state);
 }
 
-void RenderablePolyLineEntityItem::updateGeometry() {
-    _numVertices = 0;
-    _verticesBuffer.reset(new gpu::Buffer());
-    int vertexIndex = 0;
-    vec2 uv;
-    float uCoord, vCoord;
-    uCoord = 0.0f;
-    float uCoordInc = 1.0 / (_vertices.size() / 2);
-    for (int i = 0; i < _vertices.size() / 2; i++) {
-        vCoord = 0.0f;
-  
-
-        uv = vec2(uCoord, vCoord);
-
-        _verticesBuffer->append(sizeof(glm::vec3), (const gpu::Byte*)&_vertices.at(vertexIndex));
-        _verticesBuffer->append(sizeof(glm::vec3), (const gpu::Byte*)&_normals.at(i));
-        _verticesBuffer->append(sizeof(glm::vec2), (gpu::Byte*)&uv);
-        vertexIndex++;
-
-        uv.y = 1.0f;
-        _verticesBuffer->append(sizeof(glm::vec3), (const gpu::Byte*)&_vertices.at(vertexIndex));
-        _verticesBuffer->append(sizeof(glm::vec3), (const gpu::Byte*)&_normals.at(i));
-        _verticesBuffer->append(sizeof(glm::vec2), (const gpu::Byte*)&uv);
-        vertexIndex++;
-
-        _numVertices += 2;
-        uCoord += uCoordInc;
-    }
+void RenderablePolyLineEntityItem::updatePoints() {
+    // only the points are uploaded, the vertex shader widens the segments between them into the stroke
+    int numPoints = std::min(std::min(_points.size(), _normals.size()), _strokeWidths.size());
+    _numPoints = numPoints;
+    _empty = numPoints < 2;
+
     _pointsChanged = false;
     _normalsChanged = false;
     _strokeWidthsChanged = false;
-}
 
-void RenderablePolyLineEntityItem::updateVertices() {
-    // Calculate the minimum vector size out of normals, points, and stroke widths
-    int minVectorSize = _normals.size();
-    if (_points.size() < minVectorSize) {
-        minVectorSize = _points.size();
-    }
-    if (_strokeWidths.size() < minVectorSize) {
-        minVectorSize = _strokeWidths.size();
-    }
-
-    _vertices.clear();
-    glm::vec3 v1, v2, tangent, binormal, point;
-
-    int finalIndex = minVectorSize - 1;
-
-    // Guard against an empty polyline
-    if (finalIndex < 0) {
+    if (_empty) {
         return;
     }
 
-    for (int i = 0; i < finalIndex; i++) {
-        float width = _strokeWidths.at(i);
-        point = _points.at(i);
-
-        tangent = _points.at(i);
-
-        tangent = _points.at(i + 1) - point;
-        glm::vec3 normal = _normals.at(i);
-        binormal = glm::normalize(glm::cross(tangent, normal)) * width;
-
-        // Check to make sure binormal is not a NAN. If it is, don't add to vertices vector
-        if (binormal.x != binormal.x) {
-            continue;
-        }
-        v1 = point + binormal;
-        v2 = point - binormal;
-        _vertices << v1 << v2;
+    _pointData.resize(numPoints + 1);
+    for (int i = 0; i < numPoints; i++) {
+        _pointData[i].positionAndWidth = glm::vec4(_points.at(i), _strokeWidths.at(i));
+        _pointData[i].normal = glm::vec4(_normals.at(i), 0.0f);
     }
 
-    // For last point we can assume binormals are the same since it represents the last two vertices of quad
-    point = _points.at(finalIndex);
-    v1 = point + binormal;
-    v2 = point - binormal;
-    _vertices << v1 << v2;
-
+    // the last segment reads the point after its end too, the last point again leaves it the direction it has
+    _pointData[numPoints] = _pointData[numPoints - 1];
 
+    _pointsBuffer->setData(_pointData.size() * sizeof(PolyLinePoint), (const gpu::Byte*)_pointData.data());
 }
 
 void RenderablePolyLineEntityItem::update(const quint64& now) {
-    PolyLineUniforms uniforms;
-    uniforms.color = toGlm(getXColor());
-    memcpy(&_uniformBuffer.edit<PolyLineUniforms>(), &uniforms, sizeof(PolyLineUniforms));
     if (_pointsChanged || _strokeWidthsChanged || _normalsChanged) {
         QWriteLocker lock(&_quadReadWriteLock);
-        _empty = (_points.size() < 2 || _normals.size() < 2 || _strokeWidths.size() < 2);
-        if (!_empty) {
-            updateVertices();
-            updateGeometry();
-        }
+        updatePoints();
     }
 
+    PolyLineUniforms uniforms;
+    uniforms.color = toGlm(getXColor());
+    uniforms.numPoints = (float)_numPoints;
+    memcpy(&_uniformBuffer.edit<PolyLineUniforms>(), &uniforms, sizeof(PolyLineUniforms));
 }
 
 void RenderablePolyLineEntityItem::render(RenderArgs* args) {
@@ -208,7 +160,9 @@ void RenderablePolyLineEntityItem::render(RenderArgs* args) {
     }
    
     batch.setInputFormat(_format);
-    batch.setInputBuffer(0, _verticesBuffer, 0, _format->getChannels().at(0)._stride);
+    for (int i = 0; i < NUM_POINT_VIEWS; i++) {
+        batch.setInputBuffer(i, _pointsBuffer, i * sizeof(PolyLinePoint), sizeof(PolyLinePoint));
+    }
 
     if (_isFading) {
         batch._glColor4f(1.0f, 1.0f, 1.0f, Interpolate::calculateFadeRatio(_fadeStartTime));
@@ -216,5 +170,5 @@ void RenderablePolyLineEntityItem::render(RenderArgs* args) {
         batch._glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
     }
 
-    batch.draw(gpu::TRIANGLE_STRIP, _numVertices, 0);
+    batch.drawInstanced(_numPoints - 1, gpu::TRIANGLE_STRIP, VERTICES_PER_SEGMENT);
 };
@@ -12,6 +12,7 @@
 #ifndef hifi_RenderablePolyLineEntityItem_h
 #define hifi_RenderablePolyLineEntityItem_h
 
+#include <vector>
 
 #include <gpu/Batch.h>
 #include <GeometryCache.h>
@@ -45,13 +46,18 @@ public:
     static const int32_t PAINTSTROKE_UNIFORM_SLOT { 0 };
 
 protected:
-    void updateGeometry();
-    void updateVertices();
-    gpu::BufferPointer _verticesBuffer;
+    // a point of the stroke as paintStroke.slv reads it, which widens the segments between them into a ribbon
+    struct PolyLinePoint {
+        glm::vec4 positionAndWidth;
+        glm::vec4 normal;
+    };
+
+    void updatePoints();
+    std::vector<PolyLinePoint> _pointData;
+    gpu::BufferPointer _pointsBuffer;
     gpu::BufferView _uniformBuffer;
-    unsigned int _numVertices;
+    int _numPoints { 0 };
     bool _empty { true };
-    QVector<glm::vec3> _vertices;
 };
 
 
@@ -86,7 +86,9 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
   decompressVolumeData, recomputeMesh, computeShapeInfoWorker, and compressVolumeDataAndSendEditPacket are too expensive
   to run on a thread that has other things to do.  These use QtConcurrent::run to spawn a thread.  As each thread
-  finishes, it adjusts the dirty flags so that the next call to render() will kick off the next step.
+  finishes, it adjusts the dirty flags so that the next call to render() will kick off the next step.  Only one
+  recomputeMesh and one computeShapeInfoWorker run at a time for an entity; a burst of edits during an extraction
+  is meshed once, after it, and no collision shape is built for a mesh that is already out of date.
 
   polyvoxes are designed to seemlessly fit up against neighbors.  If voxels go right up to the edge of polyvox,
   the resulting mesh wont be closed -- the library assumes you'll have another polyvox next to it to continue the
@@ -624,6 +626,14 @@ bool RenderablePolyVoxEntityItem::isReadyToComputeShape() {
     // we determine if we are ready to compute the physics shape by actually doing so.
     // if _voxelDataDirty or _volDataDirty is set, don't do this yet -- wait for their
     // threads to finish before creating the collision shape.
+    bool shapeInProgress;
+    withReadLock([&] {
+        shapeInProgress = _shapeInProgress;
+    });
+    if (shapeInProgress) {
+        // wait for it, and then for any mesh that arrived meanwhile
+        return false;
+    }
     if (_meshDirty && !_voxelDataDirty && !_volDataDirty) {
         _meshDirty = false;
         computeShapeInfoWorker();
@@ -1224,9 +1234,20 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
 void RenderablePolyVoxEntityItem::recomputeMesh() {
     // use _volData to make a renderable mesh
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    bool inProgress;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        inProgress = _meshInProgress;
+        if (inProgress) {
+            // setMesh will ask for another extraction, with whatever edits arrive before then
+            _meshOwed = true;
+        } else {
+            _meshInProgress = true;
+        }
     });
+    if (inProgress) {
+        return;
+    }
 
     cacheNeighbors();
     copyUpperEdgesFromNeighbors();
@@ -1236,8 +1257,10 @@ void RenderablePolyVoxEntityItem::recomputeMesh() {
     QtConcurrent::run([entity, voxelSurfaceStyle] {
         model::MeshPointer mesh(new model::Mesh());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        // A mesh object to hold the result of surface extraction.  Only one extraction runs at a time, so it
+        // keeps the allocations of the last one.
+        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>& polyVoxMesh = entity->_polyVoxMesh;
+        polyVoxMesh.clear();
 
         entity->withReadLock([&] {
             PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
@@ -1299,6 +1322,7 @@ void RenderablePolyVoxEntityItem::recomputeMesh() {
                                              model::Mesh::TRIANGLES)); // topology
         mesh->setPartBuffer(gpu::BufferView(new gpu::Buffer(parts.size() * sizeof(model::Mesh::Part),
                                                             (gpu::Byte*) parts.data()), gpu::Element::PART_DRAWCALL));
+        polyVoxMesh.clear();
         entity->setMesh(mesh);
     });
 }
@@ -1315,6 +1339,12 @@ void RenderablePolyVoxEntityItem::setMesh(model::MeshPointer mesh) {
         _meshInitialized = true;
         neighborsNeedUpdate = _neighborsNeedUpdate;
         _neighborsNeedUpdate = false;
+        _meshInProgress = false;
+        if (_meshOwed) {
+            // catch up with the edits made during the extraction, before computing a collision shape
+            _meshOwed = false;
+            _volDataDirty = true;
+        }
     });
     if (neighborsNeedUpdate) {
         bonkNeighbors();
@@ -1334,10 +1364,11 @@ void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
     glm::vec3 voxelVolumeSize;
     model::MeshPointer mesh;
 
-    withReadLock([&] {
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
         voxelVolumeSize = _voxelVolumeSize;
         mesh = _mesh;
+        _shapeInProgress = true;
     });
 
     QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
@@ -1456,7 +1487,12 @@ void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
 void RenderablePolyVoxEntityItem::setCollisionPoints(ShapeInfo::PointCollection pointCollection, AABox box) {
     // this catches the payload from computeShapeInfoWorker
     if (pointCollection.isEmpty()) {
-        EntityItem::computeShapeInfo(_shapeInfo);
+        ShapeInfo shapeInfo;
+        EntityItem::computeShapeInfo(shapeInfo);
+        withWriteLock([&] {
+            _shapeInfo = shapeInfo;
+            _shapeInProgress = false;
+        });
         return;
     }
 
@@ -1470,7 +1506,7 @@ void RenderablePolyVoxEntityItem::setCollisionPoints(ShapeInfo::PointCollection
             QString::number(_registrationPoint.z);
         _shapeInfo.setParams(SHAPE_TYPE_COMPOUND, collisionModelDimensions, shapeKey);
         _shapeInfo.setPointCollection(pointCollection);
-        _meshDirty = false;
+        _shapeInProgress = false;
     });
 }
 
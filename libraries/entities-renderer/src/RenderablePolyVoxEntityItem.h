@@ -16,6 +16,7 @@
 #include <atomic>
 
 #include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
 #include <PolyVoxCore/Raycast.h>
 
 #include <TextureCache.h>
@@ -159,6 +160,13 @@ private:
     bool _meshDirty { true }; // does collision-shape need to be recomputed?
     bool _meshInitialized { false };
 
+    // At most one surface extraction and one collision-shape computation run at a time.  Edits that land during an
+    // extraction are caught up by a single extraction after it, rather than each starting their own.
+    bool _meshInProgress { false };
+    bool _meshOwed { false }; // _volData changed while extracting
+    bool _shapeInProgress { false };
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> _polyVoxMesh; // reused by each extraction
+
     NetworkTexturePointer _xTexture;
     NetworkTexturePointer _yTexture;
     NetworkTexturePointer _zTexture;
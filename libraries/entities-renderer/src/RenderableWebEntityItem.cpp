@@ -34,6 +34,14 @@ static uint32_t _currentWebCount { 0 };
 static const uint32_t MAX_CONCURRENT_WEB_VIEWS = 20;
 // If a web-view hasn't been rendered for 30 seconds, de-allocate the framebuffer
 static uint64_t MAX_NO_RENDER_INTERVAL = 30 * USECS_PER_SECOND;
+// If a web-view hasn't been rendered for a second, stop rendering its surface until it is rendered again
+static uint64_t MAX_NO_RENDER_LIVE_INTERVAL = USECS_PER_SECOND;
+
+// A web-view smaller than this on screen, in pixels, shows its last frame and counts as not rendered
+static float MIN_LIVE_SCREEN_HEIGHT = 16.0f;
+// A html web-view is rendered at down to a quarter of its resolution when it is small on screen
+static float MIN_RESOLUTION_SCALE = 0.25f;
+static float RESOLUTION_SCALE_HYSTERESIS = 1.25f;
 
 static int MAX_WINDOW_SIZE = 4096;
 static float OPAQUE_ALPHA_THRESHOLD = 0.99f;
@@ -155,7 +163,7 @@ bool RenderableWebEntityItem::buildWebSurface(QSharedPointer<EntityTreeRenderer>
             QTouchEvent::TouchPoint point;
             point.setId(event.getID());
             point.setState(Qt::TouchPointReleased);
-            glm::vec2 windowPos = event.getPos2D() * (METERS_TO_INCHES * _dpi);
+            glm::vec2 windowPos = event.getPos2D() * (METERS_TO_INCHES * _dpi * _resolutionScale);
             QPointF windowPoint(windowPos.x, windowPos.y);
             point.setScenePos(windowPoint);
             point.setPos(windowPoint);
@@ -185,6 +193,42 @@ glm::vec2 RenderableWebEntityItem::getWindowSize() const {
     return dims;
 }
 
+float RenderableWebEntityItem::getScreenHeight(RenderArgs* args) const {
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    float distance = glm::max(glm::distance(viewFrustum.getPosition(), getPosition()), EPSILON);
+    return getDimensions().y / distance * viewFrustum.getProjection()[1][1] * 0.5f * (float)args->_viewport.w;
+}
+
+static float resolutionScaleForScreenHeight(float screenHeight, float windowHeight) {
+    // halve the resolution each time the web-view covers less than half of its pixels
+    float scale = 1.0f;
+    while (scale > MIN_RESOLUTION_SCALE && screenHeight < 0.5f * scale * windowHeight) {
+        scale *= 0.5f;
+    }
+    return scale;
+}
+
+void RenderableWebEntityItem::updateResolutionScale(float screenHeight, float windowHeight) {
+    // the web-view keeps its layout, its content is zoomed out as much as its resolution is lowered
+    float scale = 1.0f;
+    if (_contentType == htmlContent) {
+        // raise the resolution a little later than it was lowered, so it doesn't flip back and forth
+        float lowerScale = resolutionScaleForScreenHeight(screenHeight, windowHeight);
+        float raiseScale = resolutionScaleForScreenHeight(screenHeight / RESOLUTION_SCALE_HYSTERESIS, windowHeight);
+        scale = lowerScale < _resolutionScale ? lowerScale : glm::max(raiseScale, _resolutionScale);
+    }
+    if (scale == _resolutionScale) {
+        return;
+    }
+    _resolutionScale = scale;
+
+    QQuickItem* rootItem = _webSurface->getRootItem();
+    QObject* webEngineView = rootItem ? rootItem->findChild<QObject*>("webEngineView") : nullptr;
+    if (webEngineView) {
+        webEngineView->setProperty("zoomFactor", _resolutionScale);
+    }
+}
+
 void RenderableWebEntityItem::render(RenderArgs* args) {
     checkFading();
 
@@ -197,7 +241,14 @@ void RenderableWebEntityItem::render(RenderArgs* args) {
     }
     #endif
 
+    float screenHeight = getScreenHeight(args);
+    bool isTooSmall = screenHeight < MIN_LIVE_SCREEN_HEIGHT;
+
     if (!_webSurface) {
+        // not worth a web view until it is closer
+        if (isTooSmall) {
+            return;
+        }
         auto renderer = qSharedPointerCast<EntityTreeRenderer>(args->_renderer);
         if (!buildWebSurface(renderer)) {
             return;
@@ -205,14 +256,26 @@ void RenderableWebEntityItem::render(RenderArgs* args) {
         _fadeStartTime = usecTimestampNow();
     }
 
-    _lastRenderTime = usecTimestampNow();
+    if (isTooSmall) {
+        // The last frame is shown until it is close enough again, or the web-view is de-allocated
+        if (!_webSurface->isPaused()) {
+            _webSurface->pause();
+        }
+    } else {
+        if (_webSurface->isPaused()) {
+            _webSurface->resume();
+        }
+        _lastRenderTime = usecTimestampNow();
 
-    glm::vec2 windowSize = getWindowSize();
+        glm::vec2 windowSize = getWindowSize();
+        updateResolutionScale(screenHeight, windowSize.y);
+        windowSize *= _resolutionScale;
 
-    // The offscreen surface is idempotent for resizes (bails early
-    // if it's a no-op), so it's safe to just call resize every frame
-    // without worrying about excessive overhead.
-    _webSurface->resize(QSize(windowSize.x, windowSize.y));
+        // The offscreen surface is idempotent for resizes (bails early
+        // if it's a no-op), so it's safe to just call resize every frame
+        // without worrying about excessive overhead.
+        _webSurface->resize(QSize(windowSize.x, windowSize.y));
+    }
 
     if (!_texture) {
         auto webSurface = _webSurface;
@@ -253,6 +316,8 @@ void RenderableWebEntityItem::render(RenderArgs* args) {
 }
 
 void RenderableWebEntityItem::loadSourceURL() {
+    _resolutionScale = 1.0f;
+
     QUrl sourceUrl(_sourceUrl);
     if (sourceUrl.scheme() == "http" || sourceUrl.scheme() == "https" ||
         _sourceUrl.toLower().endsWith(".htm") || _sourceUrl.toLower().endsWith(".html")) {
@@ -325,7 +390,7 @@ void RenderableWebEntityItem::handlePointerEvent(const PointerEvent& event) {
         return;
     }
 
-    glm::vec2 windowPos = event.getPos2D() * (METERS_TO_INCHES * _dpi);
+    glm::vec2 windowPos = event.getPos2D() * (METERS_TO_INCHES * _dpi * _resolutionScale);
     QPointF windowPoint(windowPos.x, windowPos.y);
     if (event.getType() == PointerEvent::Move) {
         // Forward a mouse move event to webSurface
@@ -426,6 +491,9 @@ void RenderableWebEntityItem::update(const quint64& now) {
     auto interval = now - _lastRenderTime;
     if (interval > MAX_NO_RENDER_INTERVAL) {
         destroyWebSurface();
+    } else if (interval > MAX_NO_RENDER_LIVE_INTERVAL && _webSurface && !_webSurface->isPaused()) {
+        // out of view, resumed as soon as it is rendered again
+        _webSurface->pause();
     }
 }
 
@@ -61,12 +61,15 @@ private:
     bool buildWebSurface(QSharedPointer<EntityTreeRenderer> renderer);
     void destroyWebSurface();
     glm::vec2 getWindowSize() const;
+    float getScreenHeight(RenderArgs* args) const;
+    void updateResolutionScale(float screenHeight, float windowHeight);
 
     QSharedPointer<OffscreenQmlSurface> _webSurface;
     QMetaObject::Connection _connection;
     gpu::TexturePointer _texture;
     bool _pressed{ false };
     uint64_t _lastRenderTime{ 0 };
+    float _resolutionScale { 1.0f };
     QTouchDevice _touchDevice;
 
     QMetaObject::Connection _mousePressConnection;
@@ -13,8 +13,14 @@
 #include <QUrl>
 
 #include <ResourceManager.h>
+#include <SharedUtil.h>
 #include "EntityEditFilters.h"
 
+EntityEditFilters::EntityEditFilters(EntityTreePointer tree) : _tree(tree) {
+    _slowFilterTimer.setInterval(MAX_FILTER_TIME / USECS_PER_MSEC / 2);
+    connect(&_slowFilterTimer, &QTimer::timeout, this, &EntityEditFilters::abortSlowFilters);
+}
+
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
     QList<EntityItemID> missingZones;
@@ -43,7 +49,6 @@ QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
 
 bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
         EntityTree::FilterType filterType, EntityItemID& itemID) {
-    
     // get the ids of all the zones (plus the global entity edit filter) that the position
     // lies within
     auto zoneIDs = getZonesByPosition(position);
@@ -61,32 +66,7 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
             if (filterData.rejectAll) {
                 return false;
             }
-            auto oldProperties = propertiesIn.getDesiredProperties();
-            auto specifiedProperties = propertiesIn.getChangedProperties();
-            propertiesIn.setDesiredProperties(specifiedProperties);
-            QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
-            propertiesIn.setDesiredProperties(oldProperties);
-
-            auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
-            QScriptValueList args;
-            args << inputValues;
-            args << filterType;
-
-            QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
-            if (filterData.uncaughtExceptions()) {
-                return false;
-            }
-
-            if (result.isObject()){
-                // make propertiesIn reflect the changes, for next filter...
-                propertiesIn.copyFromScriptValue(result, false);
-
-                // and update propertiesOut too.  TODO: this could be more efficient...
-                propertiesOut.copyFromScriptValue(result, false);
-                // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
-                auto out = QJsonValue::fromVariant(result.toVariant());
-                wasChanged |= (in != out);
-            } else {
+            if (!runFilter(*filterData.engines, propertiesIn, propertiesOut, wasChanged, filterType)) {
                 return false;
             }
         }
@@ -96,12 +76,33 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
 }
 
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
-    QWriteLocker writeLock(&_lock);
-    FilterData filterData = _filterDataMap.value(entityID);
-    if (filterData.valid()) {
-        delete filterData.engine;
+    {
+        // the engines go once no edit is being filtered by them
+        QWriteLocker writeLock(&_lock);
+        _filterDataMap.remove(entityID);
+    }
+
+    // the edit lanes remove the filters of zones that are gone, the timer is stopped on our own thread
+    QMetaObject::invokeMethod(this, "updateSlowFilterTimer", Qt::QueuedConnection);
+}
+
+void EntityEditFilters::updateSlowFilterTimer() {
+    bool hasEngines = false;
+    {
+        QReadLocker readLock(&_lock);
+        for (auto& filterData : _filterDataMap) {
+            if (filterData.engines) {
+                hasEngines = true;
+                break;
+            }
+        }
+    }
+
+    if (!hasEngines) {
+        _slowFilterTimer.stop();
+    } else if (!_slowFilterTimer.isActive()) {
+        _slowFilterTimer.start();
     }
-    _filterDataMap.remove(entityID);
 }
 
 void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
@@ -179,6 +180,124 @@ static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName
     return false;
 }
 
+bool EntityEditFilters::runFilter(FilterEngines& filterEngines, EntityItemProperties& propertiesIn,
+        EntityItemProperties& propertiesOut, bool& wasChanged, EntityTree::FilterType filterType) {
+    FilterEngine* filterEngine = filterEngines.acquire();
+    if (!filterEngine) {
+        return false;
+    }
+    QScriptEngine* engine = filterEngine->engine.get();
+
+    auto oldProperties = propertiesIn.getDesiredProperties();
+    auto specifiedProperties = propertiesIn.getChangedProperties();
+    propertiesIn.setDesiredProperties(specifiedProperties);
+    QScriptValue inputValues = propertiesIn.copyToScriptValue(engine, false, true, true);
+    propertiesIn.setDesiredProperties(oldProperties);
+
+    auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
+    QScriptValueList args;
+    args << inputValues;
+    args << filterType;
+
+    {
+        QMutexLocker evaluationLocker(&filterEngine->evaluationMutex);
+        filterEngine->timedOut = false;
+        filterEngine->evaluationStarted = usecTimestampNow();
+    }
+    QScriptValue result = filterEngine->filterFn.call(_nullObjectForFilter, args);
+    bool timedOut;
+    {
+        QMutexLocker evaluationLocker(&filterEngine->evaluationMutex);
+        filterEngine->evaluationStarted = 0;
+        timedOut = filterEngine->timedOut;
+    }
+
+    bool accepted = false;
+    if (timedOut) {
+        qWarning() << "Entity edit filter" << filterEngines.program.fileName() << "took longer than"
+            << MAX_FILTER_TIME / USECS_PER_MSEC << "ms, edit rejected";
+        engine->clearExceptions();
+    } else if (!hadUncaughtExceptions(*engine, filterEngines.program.fileName()) && result.isObject()) {
+        // make propertiesIn reflect the changes, for next filter...
+        propertiesIn.copyFromScriptValue(result, false);
+
+        // and update propertiesOut too.  TODO: this could be more efficient...
+        propertiesOut.copyFromScriptValue(result, false);
+        // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
+        auto out = QJsonValue::fromVariant(result.toVariant());
+        wasChanged |= (in != out);
+        accepted = true;
+    }
+    filterEngines.release(filterEngine);
+    return accepted;
+}
+
+void EntityEditFilters::abortSlowFilters() {
+    // runs on our own thread while the edit lanes filter
+    auto now = usecTimestampNow();
+    QReadLocker readLock(&_lock);
+    for (auto& filterData : _filterDataMap) {
+        if (!filterData.engines) {
+            continue;
+        }
+        QMutexLocker enginesLocker(&filterData.engines->mutex);
+        for (auto& filterEngine : filterData.engines->engines) {
+            QMutexLocker evaluationLocker(&filterEngine->evaluationMutex);
+            quint64 evaluationStarted = filterEngine->evaluationStarted;
+            if (evaluationStarted != 0 && now - evaluationStarted > MAX_FILTER_TIME) {
+                filterEngine->timedOut = true;
+                filterEngine->engine->abortEvaluation();
+            }
+        }
+    }
+}
+
+EntityEditFilters::FilterEngine* EntityEditFilters::FilterEngines::acquire() {
+    {
+        QMutexLocker locker(&mutex);
+        if (!idleEngines.empty()) {
+            FilterEngine* filterEngine = idleEngines.back();
+            idleEngines.pop_back();
+            return filterEngine;
+        }
+    }
+
+    // every engine is busy on another lane, so make one more from the compiled program
+    auto filterEngine = createFilterEngine(program);
+    if (!filterEngine) {
+        return nullptr;
+    }
+    QMutexLocker locker(&mutex);
+    engines.push_back(std::move(filterEngine));
+    return engines.back().get();
+}
+
+void EntityEditFilters::FilterEngines::release(FilterEngine* filterEngine) {
+    QMutexLocker locker(&mutex);
+    idleEngines.push_back(filterEngine);
+}
+
+std::unique_ptr<EntityEditFilters::FilterEngine> EntityEditFilters::createFilterEngine(const QScriptProgram& program) {
+    // create a QScriptEngine for this script
+    std::unique_ptr<FilterEngine> filterEngine(new FilterEngine());
+    filterEngine->engine.reset(new QScriptEngine());
+    QScriptEngine* engine = filterEngine->engine.get();
+    engine->evaluate(program);
+    if (hadUncaughtExceptions(*engine, program.fileName())) {
+        return nullptr;
+    }
+
+    // now get the filter function
+    auto global = engine->globalObject();
+    auto entitiesObject = engine->newObject();
+    entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+    entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+    entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+    global.setProperty("Entities", entitiesObject);
+    filterEngine->filterFn = global.property("filter");
+    return filterEngine;
+}
+
 void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
     qDebug() << "script request completed for entity " << entityID;
     auto scriptRequest = qobject_cast<ResourceRequest*>(sender());
@@ -188,30 +307,18 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         qInfo() << "Downloaded script:" << scriptContents;
         QScriptProgram program(scriptContents, urlString);
         if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->evaluate(scriptContents);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
+            // the first engine checks the script; the edit lanes make more from the same program as they need them
+            auto filterEngine = createFilterEngine(program);
+            if (filterEngine) {
                 FilterData filterData;
-                filterData.engine = engine;
                 filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [this, &engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
-
-                // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
+                if (filterEngine->filterFn.isFunction()) {
+                    filterData.engines = std::make_shared<FilterEngines>();
+                    filterData.engines->program = program;
+                    filterData.engines->idleEngines.push_back(filterEngine.get());
+                    filterData.engines->engines.push_back(std::move(filterEngine));
+                } else {
                     qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
                     filterData.rejectAll=true;
                 }
                
@@ -220,6 +327,8 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 _filterDataMap.insert(entityID, filterData);
                 _lock.unlock();
 
+                updateSlowFilterTimer();
+
                 qDebug() << "script request filter processed for entity id " << entityID;
                 
                 emit filterAdded(entityID, true);
@@ -13,11 +13,17 @@
 
 #include <QObject>
 #include <QMap>
+#include <QMutex>
+#include <QScriptProgram>
 #include <QScriptValue>
 #include <QScriptEngine>
+#include <QTimer>
 #include <glm/glm.hpp>
 
-#include <functional>
+#include <memory>
+#include <vector>
+
+#include <NumericalConstants.h>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
@@ -26,18 +32,39 @@
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
-    struct FilterData {
+    // A filter script evaluated in an engine of its own.  An engine runs one edit's filter at a time.
+    struct FilterEngine {
+        std::unique_ptr<QScriptEngine> engine;
         QScriptValue filterFn;
-        std::function<bool()> uncaughtExceptions;
-        QScriptEngine* engine;
+
+        // held to start and end an evaluation, and to abort it, so that an abort can't land on the next one
+        QMutex evaluationMutex;
+        quint64 evaluationStarted { 0 }; // usecs, 0 when not filtering
+        bool timedOut { false };
+    };
+
+    // The engines of one filter, all made from its compiled program.  Each edit lane takes an idle one, or makes
+    // another, so that edits on different lanes are filtered at once.
+    struct FilterEngines {
+        FilterEngine* acquire();
+        void release(FilterEngine* filterEngine);
+
+        QScriptProgram program;
+        QMutex mutex;
+        std::vector<std::unique_ptr<FilterEngine>> engines;
+        std::vector<FilterEngine*> idleEngines;
+    };
+
+    struct FilterData {
+        std::shared_ptr<FilterEngines> engines; // kept by a filtering edit should the filter be removed meanwhile
         bool rejectAll;
         
-        FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        FilterData(): rejectAll(false) {};
+        bool valid() { return (rejectAll || engines); }
     };
 
-    EntityEditFilters() {};
-    EntityEditFilters(EntityTreePointer tree ): _tree(tree) {};
+    EntityEditFilters() : EntityEditFilters(EntityTreePointer()) {};
+    EntityEditFilters(EntityTreePointer tree);
 
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
@@ -50,9 +77,14 @@ signals:
 
 private slots:
     void scriptRequestFinished(EntityItemID entityID);
+    void abortSlowFilters();
+    void updateSlowFilterTimer();
     
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
+    bool runFilter(FilterEngines& filterEngines, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
+                   bool& wasChanged, EntityTree::FilterType filterType);
+    static std::unique_ptr<FilterEngine> createFilterEngine(const QScriptProgram& program);
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
@@ -60,6 +92,10 @@ private:
     
     QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
+
+    // a filter taking longer than this for an edit is aborted, and the edit rejected
+    static const quint64 MAX_FILTER_TIME = 100 * USECS_PER_MSEC;
+    QTimer _slowFilterTimer;
 };
 
 #endif //hifi_EntityEditFilters_h
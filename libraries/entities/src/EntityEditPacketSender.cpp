@@ -81,14 +81,34 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         return; // bail early
     }
 
+    QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
+    queueEditEntityMessage(type, entityTree, entityItemID, properties, bufferOut);
+}
+
+void EntityEditPacketSender::queueEditEntityMessages(PacketType type, EntityTreePointer entityTree,
+                                                     const std::vector<std::pair<EntityItemID, EntityItemProperties>>& edits) {
+    if (!_shouldSend) {
+        return; // bail early
+    }
+
+    // the encode shrinks the buffer to what it wrote, growing it back keeps its allocation
+    QByteArray bufferOut;
+    int maxPayloadSize = NLPacket::maxPayloadSize(type);
+    for (auto& edit : edits) {
+        bufferOut.resize(maxPayloadSize);
+        queueEditEntityMessage(type, entityTree, edit.first, edit.second, bufferOut);
+    }
+}
+
+void EntityEditPacketSender::queueEditEntityMessage(PacketType type, EntityTreePointer entityTree,
+                                                    EntityItemID entityItemID, const EntityItemProperties& properties,
+                                                    QByteArray& bufferOut) {
     if (properties.getClientOnly() && properties.getOwningAvatarID() == _myAvatar->getID()) {
         // this is an avatar-based entity --> update our avatar-data rather than sending to the entity-server
         queueEditAvatarEntityMessage(type, entityTree, entityItemID, properties);
         return;
     }
 
-    QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
-
     bool success;
     if (properties.parentIDChanged() && properties.getParentID() == AVATAR_SELF_ID) {
         EntityItemProperties propertiesCopy = properties;
@@ -106,7 +126,15 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
             qCDebug(entities) << "    id:" << entityItemID;
             qCDebug(entities) << "    properties:" << properties;
         #endif
-        queueOctreeEditMessage(type, bufferOut);
+        // an entity lives on the server it came from, so the edits of a known entity go to that server alone
+        QUuid serverID;
+        if (type != PacketType::EntityAdd && entityTree) {
+            EntityItemPointer entity = entityTree->findEntityByEntityItemID(entityItemID);
+            if (entity) {
+                serverID = entity->getSourceUUID();
+            }
+        }
+        queueOctreeEditMessage(type, bufferOut, serverID);
     }
 }
 
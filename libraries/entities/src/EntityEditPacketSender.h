@@ -34,6 +34,9 @@ public:
     void queueEditEntityMessage(PacketType type, EntityTreePointer entityTree,
                                 EntityItemID entityItemID, const EntityItemProperties& properties);
 
+    /// Queues several edit messages, as queueEditEntityMessage does, encoding them all in the one buffer
+    void queueEditEntityMessages(PacketType type, EntityTreePointer entityTree,
+                                 const std::vector<std::pair<EntityItemID, EntityItemProperties>>& edits);
 
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
 
@@ -47,6 +50,8 @@ public slots:
 private:
     void queueEditAvatarEntityMessage(PacketType type, EntityTreePointer entityTree,
                                       EntityItemID entityItemID, const EntityItemProperties& properties);
+    void queueEditEntityMessage(PacketType type, EntityTreePointer entityTree, EntityItemID entityItemID,
+                                const EntityItemProperties& properties, QByteArray& bufferOut);
 
 private:
     AvatarData* _myAvatar { nullptr };
@@ -190,9 +190,32 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     }
 
     LevelDetails entityLevel = packetData->startLevel();
+    int startOfEntity = packetData->getUncompressedByteOffset();
 
     quint64 lastEdited = getLastEdited();
 
+    // another send thread may already have encoded this entity as it is now, if so just copy its bytes
+    bool isWholeEncoding = (requestedProperties == getEntityProperties(params));
+    if (isWholeEncoding) {
+        QByteArray cachedBytes;
+        {
+            std::lock_guard<std::mutex> lock(_cachedEncodingMutex);
+            if (_cachedEncoding.lastEdited == lastEdited && _cachedEncoding.lastUpdated == getLastUpdated() &&
+                _cachedEncoding.lastSimulated == getLastSimulated() &&
+                _cachedEncoding.changedOnServer == getLastChangedOnServer() &&
+                _cachedEncoding.properties == requestedProperties) {
+                cachedBytes = _cachedEncoding.bytes;
+            }
+        }
+        if (!cachedBytes.isEmpty() &&
+            packetData->appendRawData((const unsigned char*)cachedBytes.constData(), cachedBytes.size())) {
+            packetData->endLevel(entityLevel);
+            params.trackSend(getID(), lastEdited);
+            return OctreeElement::COMPLETED;
+        }
+        // if it didn't fit, encode what does fit below
+    }
+
     #ifdef WANT_DEBUG
         float editedAgo = getEditedAgo();
         QString agoAsString = formatSecondsElapsed(editedAgo);
@@ -324,6 +347,18 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         }
 
         packetData->endLevel(entityLevel);
+
+        if (isWholeEncoding && appendState == OctreeElement::COMPLETED) {
+            int endOfEntity = packetData->getUncompressedByteOffset();
+            std::lock_guard<std::mutex> lock(_cachedEncodingMutex);
+            _cachedEncoding.lastEdited = lastEdited;
+            _cachedEncoding.lastUpdated = getLastUpdated();
+            _cachedEncoding.lastSimulated = getLastSimulated();
+            _cachedEncoding.changedOnServer = getLastChangedOnServer();
+            _cachedEncoding.properties = requestedProperties;
+            _cachedEncoding.bytes = QByteArray((const char*)packetData->getUncompressedData(startOfEntity),
+                                               endOfEntity - startOfEntity);
+        }
     } else {
         packetData->discardLevel(entityLevel);
         appendState = OctreeElement::NONE; // if we got here, then we didn't include the item
@@ -1018,7 +1053,11 @@ void EntityItem::simulate(const quint64& now) {
         qCDebug(entities) << "     ********** EntityItem::simulate() .... SETTING _lastSimulated=" << _lastSimulated;
     #endif
 
-    if (!stepKinematicMotion(timeElapsed)) {
+    finishSimulate(now, stepKinematicMotion(timeElapsed));
+}
+
+void EntityItem::finishSimulate(const quint64& now, bool isMoving) {
+    if (!isMoving) {
         // this entity is no longer moving
         // flag it to transition from KINEMATIC to STATIC
         _dirtyFlags |= Simulation::DIRTY_MOTION_TYPE;
@@ -1034,6 +1073,31 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
     glm::vec3 angularVelocity;
     getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
 
+    // acceleration is in world-frame but we need it in local-frame
+    glm::vec3 localAcceleration = _acceleration;
+    if (glm::length2(localAcceleration) > 0.0f) {
+        bool success;
+        Transform parentTransform = getParentTransform(success);
+        if (success) {
+            localAcceleration = glm::inverse(parentTransform.getRotation()) * localAcceleration;
+        }
+    }
+
+    glm::vec3 position = transform.getTranslation();
+    glm::quat rotation = transform.getRotation();
+    bool moving = stepKinematicMotion(timeElapsed, _damping, _angularDamping, localAcceleration,
+                                      position, rotation, linearVelocity, angularVelocity);
+    if (moving && timeElapsed > 0.0f) {
+        transform.setTranslation(position);
+        transform.setRotation(rotation);
+        setLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+    }
+    return moving;
+}
+
+bool EntityItem::stepKinematicMotion(float timeElapsed, float damping, float angularDamping,
+                                     const glm::vec3& localAcceleration, glm::vec3& position, glm::quat& rotation,
+                                     glm::vec3& linearVelocity, glm::vec3& angularVelocity) {
     // find out if it is moving
     bool isSpinning = (glm::length2(angularVelocity) > 0.0f);
     float linearSpeedSquared = glm::length2(linearVelocity);
@@ -1057,8 +1121,8 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
 
     if (isSpinning) {
         // angular damping
-        if (_angularDamping > 0.0f) {
-            angularVelocity *= powf(1.0f - _angularDamping, timeElapsed);
+        if (angularDamping > 0.0f) {
+            angularVelocity *= powf(1.0f - angularDamping, timeElapsed);
         }
 
         const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED =
@@ -1068,39 +1132,29 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
         } else {
             // for improved agreement with the way Bullet integrates rotations we use an approximation
             // and break the integration into bullet-sized substeps
-            glm::quat rotation = transform.getRotation();
             float dt = timeElapsed;
             while (dt > 0.0f) {
                 glm::quat  dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
                 rotation = glm::normalize(dQ * rotation);
                 dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
             }
-            transform.setRotation(rotation);
         }
     }
 
-    glm::vec3 position = transform.getTranslation();
     const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED =
         KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
     if (isTranslating) {
         glm::vec3 deltaVelocity = Vectors::ZERO;
 
         // linear damping
-        if (_damping > 0.0f) {
-            deltaVelocity = (powf(1.0f - _damping, timeElapsed) - 1.0f) * linearVelocity;
+        if (damping > 0.0f) {
+            deltaVelocity = (powf(1.0f - damping, timeElapsed) - 1.0f) * linearVelocity;
         }
 
         const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
-        if (glm::length2(_acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
+        if (glm::length2(localAcceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
             // yes acceleration
-            // acceleration is in world-frame but we need it in local-frame
-            glm::vec3 linearAcceleration = _acceleration;
-            bool success;
-            Transform parentTransform = getParentTransform(success);
-            if (success) {
-                linearAcceleration = glm::inverse(parentTransform.getRotation()) * linearAcceleration;
-            }
-            deltaVelocity += linearAcceleration * timeElapsed;
+            deltaVelocity += localAcceleration * timeElapsed;
 
             if (linearSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
                     && glm::length2(deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
@@ -1126,9 +1180,6 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
         }
     }
 
-    transform.setTranslation(position);
-    setLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
-
     return true;
 }
 
@@ -1244,6 +1295,63 @@ EntityItemProperties EntityItem::getProperties(EntityPropertyFlags desiredProper
     return properties;
 }
 
+bool EntityItem::areSpatialProperties(const EntityPropertyFlags& desiredProperties) {
+    if (desiredProperties.isEmpty()) {
+        return false; // that's all of them
+    }
+    for (int flag = desiredProperties.firstFlag(); flag <= desiredProperties.lastFlag(); flag++) {
+        if (!desiredProperties.getHasProperty((EntityPropertyList)flag)) {
+            continue;
+        }
+        // dimensions are left to getProperties, a script asking for them of a model also gets its natural dimensions
+        switch (flag) {
+            case PROP_POSITION:
+            case PROP_ROTATION:
+            case PROP_VELOCITY:
+            case PROP_ANGULAR_VELOCITY:
+            case PROP_PARENT_ID:
+            case PROP_PARENT_JOINT_INDEX:
+            case PROP_LOCAL_POSITION:
+            case PROP_LOCAL_ROTATION:
+            case PROP_LOCAL_VELOCITY:
+            case PROP_LOCAL_ANGULAR_VELOCITY:
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+EntityItemProperties EntityItem::getSpatialProperties(EntityPropertyFlags desiredProperties) const {
+    // as getProperties, for these and what a script always gets back with them (see copyToScriptValue)
+    EntityItemProperties properties(desiredProperties);
+    properties._id = getID();
+    properties._idSet = true;
+    properties._created = _created;
+    properties._lastEdited = _lastEdited;
+    properties.setClientOnly(_clientOnly);
+    properties.setOwningAvatarID(_owningAvatarID);
+
+    properties._type = getType();
+
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(position, getLocalPosition);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(dimensions, getDimensions);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(rotation, getLocalOrientation);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(velocity, getLocalVelocity);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(angularVelocity, getLocalAngularVelocity);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(registrationPoint, getRegistrationPoint);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(lifetime, getLifetime);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(parentID, getParentID);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(parentJointIndex, getParentJointIndex);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(localPosition, getLocalPosition);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(localRotation, getLocalOrientation);
+
+    properties._defaultSettings = false;
+
+    return properties;
+}
+
 void EntityItem::getAllTerseUpdateProperties(EntityItemProperties& properties) const {
     // a TerseUpdate includes the transform and its derivatives
     if (!properties._positionChanged) {
@@ -2263,6 +2371,9 @@ QList<EntityActionPointer> EntityItem::getActionsOfType(EntityActionType typeToG
 
 void EntityItem::locationChanged(bool tellPhysics) {
     requiresRecalcBoxes();
+    if (_element) {
+        _element->entitiesBoundsChanged();
+    }
     if (tellPhysics) {
         _dirtyFlags |= Simulation::DIRTY_TRANSFORM;
         EntityTreePointer tree = getTree();
@@ -2275,6 +2386,9 @@ void EntityItem::locationChanged(bool tellPhysics) {
 
 void EntityItem::dimensionsChanged() {
     requiresRecalcBoxes();
+    if (_element) {
+        _element->entitiesBoundsChanged();
+    }
     SpatiallyNestable::dimensionsChanged(); // Do what you have to do
 }
 
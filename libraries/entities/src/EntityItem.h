@@ -13,6 +13,7 @@
 #define hifi_EntityItem_h
 
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -90,6 +91,11 @@ public:
     // methods for getting/setting all properties of an entity
     virtual EntityItemProperties getProperties(EntityPropertyFlags desiredProperties = EntityPropertyFlags()) const;
 
+    // getSpatialProperties copies just where the entity is and how it moves, for scripts that ask for only that
+    // of many entities, every frame; it can give all of the desired properties if this is true
+    static bool areSpatialProperties(const EntityPropertyFlags& desiredProperties);
+    EntityItemProperties getSpatialProperties(EntityPropertyFlags desiredProperties) const;
+
     /// returns true if something changed
     // This function calls setSubClass properties and detects if any property changes value.
     // If something changed then the "somethingChangedNotification" calls happens
@@ -167,6 +173,13 @@ public:
     // perform linear extrapolation for SimpleEntitySimulation
     void simulate(const quint64& now);
     bool stepKinematicMotion(float timeElapsed); // return 'true' if moving
+    void finishSimulate(const quint64& now, bool isMoving); // what simulate does once the motion has been stepped
+
+    // the integration of stepKinematicMotion, on motion in the parent frame, so that many entities' motion can be
+    // stepped in one sweep (see EntitySimulation::moveSimpleKinematics); returns 'true' if moving
+    static bool stepKinematicMotion(float timeElapsed, float damping, float angularDamping,
+                                    const glm::vec3& localAcceleration, glm::vec3& position, glm::quat& rotation,
+                                    glm::vec3& linearVelocity, glm::vec3& angularVelocity);
 
     virtual bool needsToCallUpdate() const { return false; }
 
@@ -369,6 +382,7 @@ public:
 
     uint32_t getDirtyFlags() const { return _dirtyFlags; }
     void clearDirtyFlags(uint32_t mask = 0xffffffff) { _dirtyFlags &= ~mask; }
+    void markDirtyFlags(uint32_t mask) { _dirtyFlags |= mask; }
 
     bool isMoving() const;
     bool isMovingRelativeToParent() const;
@@ -613,6 +627,19 @@ protected:
     quint64 _fadeStartTime { usecTimestampNow() };
     static std::function<bool()> _entitiesShouldFadeFunction;
     bool _isFading { _entitiesShouldFadeFunction() };
+
+    // The last whole encoding of this entity by appendEntityData, which doesn't depend on the viewer, so the
+    // entity-server's send threads share it until the entity is edited, simulated or changed on the server.
+    struct CachedEncoding {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 changedOnServer { 0 };
+        EntityPropertyFlags properties;
+        QByteArray bytes;
+    };
+    mutable std::mutex _cachedEncodingMutex;
+    mutable CachedEncoding _cachedEncoding;
 };
 
 #endif // hifi_EntityItem_h
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <cfloat>
+
 #include <QDebug>
 #include <QHash>
 #include <QObject>
@@ -21,6 +23,7 @@
 #include "EntitiesLogging.h"
 #include "EntityItem.h"
 #include "EntityItemProperties.h"
+#include "EntityItemPropertiesClass.h"
 #include "ModelEntityItem.h"
 #include "PolyLineEntityItem.h"
 
@@ -31,6 +34,9 @@ KeyLightPropertyGroup EntityItemProperties::_staticKeyLight;
 
 EntityPropertyList PROP_LAST_ITEM = (EntityPropertyList)(PROP_AFTER_LAST_ITEM - 1);
 
+// the size of the cell an add is addressed to, as a fraction of the tree, deeper than the jurisdictions are split
+const float ENTITY_ADD_OCTCODE_SCALE = 1.0f / 256.0f;
+
 EntityItemProperties::EntityItemProperties(EntityPropertyFlags desiredProperties) :
     _id(UNKNOWN_ENTITY_ID),
     _idSet(false),
@@ -356,8 +362,12 @@ QScriptValue EntityItemProperties::copyToScriptValue(QScriptEngine* engine, bool
     // is included in _desiredProperties, or is one of the specially enumerated ALWAYS properties below.
     // (There may be exceptions, but if so, they are bugs.)
     // In all other cases, you are welcome to inspect the code and try to figure out what was intended. I wish you luck. -HRS 1/18/17
-    QScriptValue properties = engine->newObject();
-    EntityItemProperties defaultEntityProperties;
+    static const EntityItemProperties defaultEntityProperties; // only compared against, so made the once
+
+    // Unless every property is wanted, as for an export, the bigger nested ones are only made when a script reads them
+    EntityItemPropertiesClass* lazyProperties = (!skipDefaults && _desiredProperties.isEmpty()) ?
+        EntityItemPropertiesClass::get(engine) : nullptr;
+    QScriptValue properties = lazyProperties ? lazyProperties->newInstance() : engine->newObject();
 
     if (_created == UNKNOWN_CREATED_TIME && !allowUnknownCreateTime) {
         // No entity properties can have been set so return without setting any default, zero property values.
@@ -455,7 +465,7 @@ QScriptValue EntityItemProperties::copyToScriptValue(QScriptEngine* engine, bool
     // Models only
     if (_type == EntityTypes::Model) {
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_MODEL_URL, modelURL);
-        _animation.copyToScriptValue(_desiredProperties, properties, engine, skipDefaults, defaultEntityProperties);
+        COPY_PROPERTY_GROUP_TO_QSCRIPTVALUE(animation);
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_JOINT_ROTATIONS_SET, jointRotationsSet);
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_JOINT_ROTATIONS, jointRotations);
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_JOINT_TRANSLATIONS_SET, jointTranslationsSet);
@@ -504,12 +514,12 @@ QScriptValue EntityItemProperties::copyToScriptValue(QScriptEngine* engine, bool
 
     // Zones only
     if (_type == EntityTypes::Zone) {
-        _keyLight.copyToScriptValue(_desiredProperties, properties, engine, skipDefaults, defaultEntityProperties);
+        COPY_PROPERTY_GROUP_TO_QSCRIPTVALUE(keyLight);
 
         COPY_PROPERTY_TO_QSCRIPTVALUE_GETTER(PROP_BACKGROUND_MODE, backgroundMode, getBackgroundModeAsString());
 
-        _stage.copyToScriptValue(_desiredProperties, properties, engine, skipDefaults, defaultEntityProperties);
-        _skybox.copyToScriptValue(_desiredProperties, properties, engine, skipDefaults, defaultEntityProperties);
+        COPY_PROPERTY_GROUP_TO_QSCRIPTVALUE(stage);
+        COPY_PROPERTY_GROUP_TO_QSCRIPTVALUE(skybox);
 
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_FLYING_ALLOWED, flyingAllowed);
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_GHOSTING_ALLOWED, ghostingAllowed);
@@ -562,21 +572,25 @@ QScriptValue EntityItemProperties::copyToScriptValue(QScriptEngine* engine, bool
  
     if (!skipDefaults && !strictSemantics) {
         AABox aaBox = getAABox();
-        QScriptValue boundingBox = engine->newObject();
-        QScriptValue bottomRightNear = vec3toScriptValue(engine, aaBox.getCorner());
-        QScriptValue topFarLeft = vec3toScriptValue(engine, aaBox.calcTopFarLeft());
-        QScriptValue center = vec3toScriptValue(engine, aaBox.calcCenter());
-        QScriptValue boundingBoxDimensions = vec3toScriptValue(engine, aaBox.getDimensions());
-        boundingBox.setProperty("brn", bottomRightNear);
-        boundingBox.setProperty("tfl", topFarLeft);
-        boundingBox.setProperty("center", center);
-        boundingBox.setProperty("dimensions", boundingBoxDimensions);
-        COPY_PROPERTY_TO_QSCRIPTVALUE_GETTER_NO_SKIP(boundingBox, boundingBox); // gettable, but not settable
-    }
-
-    QString textureNamesStr = QJsonDocument::fromVariant(_textureNames).toJson();
-    if (!skipDefaults && !strictSemantics) {
-        COPY_PROPERTY_TO_QSCRIPTVALUE_GETTER_NO_SKIP(originalTextures, textureNamesStr); // gettable, but not settable
+        auto makeBoundingBox = [aaBox](QScriptEngine* engine) {
+            QScriptValue boundingBox = engine->newObject();
+            QScriptValue bottomRightNear = vec3toScriptValue(engine, aaBox.getCorner());
+            QScriptValue topFarLeft = vec3toScriptValue(engine, aaBox.calcTopFarLeft());
+            QScriptValue center = vec3toScriptValue(engine, aaBox.calcCenter());
+            QScriptValue boundingBoxDimensions = vec3toScriptValue(engine, aaBox.getDimensions());
+            boundingBox.setProperty("brn", bottomRightNear);
+            boundingBox.setProperty("tfl", topFarLeft);
+            boundingBox.setProperty("center", center);
+            boundingBox.setProperty("dimensions", boundingBoxDimensions);
+            return boundingBox;
+        };
+        COPY_LAZY_PROPERTY_TO_QSCRIPTVALUE(boundingBox, makeBoundingBox); // gettable, but not settable
+
+        QVariantMap textureNames = _textureNames;
+        auto makeOriginalTextures = [textureNames](QScriptEngine* engine) {
+            return QScriptValue(QString(QJsonDocument::fromVariant(textureNames).toJson()));
+        };
+        COPY_LAZY_PROPERTY_TO_QSCRIPTVALUE(originalTextures, makeOriginalTextures); // gettable, but not settable
     }
 
     COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_PARENT_ID, parentID);
@@ -593,18 +607,25 @@ QScriptValue EntityItemProperties::copyToScriptValue(QScriptEngine* engine, bool
 
     // Rendering info
     if (!skipDefaults && !strictSemantics) {
-        QScriptValue renderInfo = engine->newObject();
-
         // currently only supported by models
-        if (_type == EntityTypes::Model) {
-            renderInfo.setProperty("verticesCount", (int)getRenderInfoVertexCount()); // FIXME - theoretically the number of vertex could be > max int
-            renderInfo.setProperty("texturesSize", (int)getRenderInfoTextureSize()); // FIXME - theoretically the size of textures could be > max int
-            renderInfo.setProperty("hasTransparent", getRenderInfoHasTransparent());
-            renderInfo.setProperty("drawCalls", getRenderInfoDrawCalls());
-            renderInfo.setProperty("texturesCount", getRenderInfoTextureCount());
-        }
-
-        COPY_PROPERTY_TO_QSCRIPTVALUE_GETTER_NO_SKIP(renderInfo, renderInfo);  // Gettable but not settable
+        bool isModel = _type == EntityTypes::Model;
+        int verticesCount = (int)getRenderInfoVertexCount(); // FIXME - theoretically the number of vertex could be > max int
+        int texturesSize = (int)getRenderInfoTextureSize(); // FIXME - theoretically the size of textures could be > max int
+        bool hasTransparent = getRenderInfoHasTransparent();
+        int drawCalls = getRenderInfoDrawCalls();
+        int texturesCount = getRenderInfoTextureCount();
+        auto makeRenderInfo = [=](QScriptEngine* engine) {
+            QScriptValue renderInfo = engine->newObject();
+            if (isModel) {
+                renderInfo.setProperty("verticesCount", verticesCount);
+                renderInfo.setProperty("texturesSize", texturesSize);
+                renderInfo.setProperty("hasTransparent", hasTransparent);
+                renderInfo.setProperty("drawCalls", drawCalls);
+                renderInfo.setProperty("texturesCount", texturesCount);
+            }
+            return renderInfo;
+        };
+        COPY_LAZY_PROPERTY_TO_QSCRIPTVALUE(renderInfo, makeRenderInfo);  // Gettable but not settable
     }
 
     properties.setProperty("clientOnly", convertScriptValue(engine, getClientOnly()));
@@ -1134,18 +1155,18 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
     bool success = true; // assume the best
     OctreeElement::AppendState appendState = OctreeElement::COMPLETED; // assume the best
 
-    // TODO: We need to review how jurisdictions should be handled for entities. (The old Models and Particles code
-    // didn't do anything special for jurisdictions, so we're keeping that same behavior here.)
-    //
-    // Always include the root octcode. This is only because the OctreeEditPacketSender will check these octcodes
-    // to determine which server to send the changes to in the case of multiple jurisdictions. The root will be sent
-    // to all servers.
-    glm::vec3 rootPosition(0);
-    float rootScale = 0.5f;
-    unsigned char* octcode = pointToOctalCode(rootPosition.x, rootPosition.y, rootPosition.z, rootScale);
-
-    success = packetData->startSubTree(octcode);
-    delete[] octcode;
+    // The OctreeEditPacketSender sends an add to the server whose jurisdiction holds the entity's position. Every other
+    // edit carries the root, and the EntityEditPacketSender sends it to the server the entity came from.
+    if (command == PacketType::EntityAdd) {
+        glm::vec3 unitPosition = glm::clamp((properties.getPosition() + glm::vec3(HALF_TREE_SCALE)) / (float)TREE_SCALE,
+                                            0.0f, 1.0f - FLT_EPSILON);
+        unsigned char* octcode = pointToOctalCode(unitPosition.x, unitPosition.y, unitPosition.z, ENTITY_ADD_OCTCODE_SCALE);
+        success = packetData->startSubTree(octcode);
+        delete[] octcode;
+    } else {
+        const unsigned char ROOT_OCTCODE[] = { 0 };
+        success = packetData->startSubTree(ROOT_OCTCODE);
+    }
 
     // assuming we have room to fit our octalCode, proceed...
     if (success) {
@@ -0,0 +1,134 @@
+//
+//  EntityItemPropertiesClass.cpp
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityItemPropertiesClass.h"
+
+#include <QtScript/QScriptClassPropertyIterator>
+
+Q_DECLARE_METATYPE(std::shared_ptr<EntityItemPropertiesClass::LazyProperties>)
+
+static const QString CLASS_NAME = "Object";
+
+// Enumerates the properties not made yet; the engine enumerates the ones that have been, as ordinary properties.
+class LazyPropertiesIterator : public QScriptClassPropertyIterator {
+public:
+    LazyPropertiesIterator(const QScriptValue& object,
+                           const std::shared_ptr<EntityItemPropertiesClass::LazyProperties>& lazyProperties) :
+        QScriptClassPropertyIterator(object) {
+        if (lazyProperties) {
+            for (uint i = 0; i < (uint)lazyProperties->size(); ++i) {
+                if ((*lazyProperties)[i].make) {
+                    _names.push_back({ (*lazyProperties)[i].name, i });
+                }
+            }
+        }
+    }
+
+    bool hasNext() const override { return _index < (int)_names.size(); }
+    void next() override { _last = _index++; }
+    bool hasPrevious() const override { return _index > 0; }
+    void previous() override { _last = --_index; }
+    void toFront() override { _index = 0; _last = -1; }
+    void toBack() override { _index = (int)_names.size(); _last = -1; }
+
+    QScriptString name() const override { return _names[_last].first; }
+    uint id() const override { return _names[_last].second; }
+
+private:
+    std::vector<std::pair<QScriptString, uint>> _names;
+    int _index { 0 };
+    int _last { -1 };
+};
+
+EntityItemPropertiesClass* EntityItemPropertiesClass::get(QScriptEngine* engine) {
+    auto propertiesClass = engine->findChild<EntityItemPropertiesClass*>(QString(), Qt::FindDirectChildrenOnly);
+    if (!propertiesClass) {
+        // the engine is its parent, so it's deleted with it
+        propertiesClass = new EntityItemPropertiesClass(engine);
+    }
+    return propertiesClass;
+}
+
+EntityItemPropertiesClass::EntityItemPropertiesClass(QScriptEngine* engine) :
+    QObject(engine),
+    QScriptClass(engine) {
+}
+
+QScriptValue EntityItemPropertiesClass::newInstance() {
+    auto lazyProperties = std::make_shared<LazyProperties>();
+    return engine()->newObject(this, engine()->newVariant(QVariant::fromValue(lazyProperties)));
+}
+
+void EntityItemPropertiesClass::addLazyProperty(QScriptValue& object, const QString& name, MakeProperty make) {
+    auto lazyProperties = getLazyProperties(object);
+    if (lazyProperties) {
+        lazyProperties->push_back({ engine()->toStringHandle(name), std::move(make) });
+    } else {
+        object.setProperty(name, make(engine()));
+    }
+}
+
+std::shared_ptr<EntityItemPropertiesClass::LazyProperties> EntityItemPropertiesClass::getLazyProperties(
+        const QScriptValue& object) {
+    return qscriptvalue_cast<std::shared_ptr<LazyProperties>>(object.data());
+}
+
+QScriptClass::QueryFlags EntityItemPropertiesClass::queryProperty(const QScriptValue& object,
+                                                                  const QScriptString& name,
+                                                                  QueryFlags flags, uint* id) {
+    auto lazyProperties = getLazyProperties(object);
+    if (lazyProperties) {
+        for (uint i = 0; i < (uint)lazyProperties->size(); ++i) {
+            const LazyProperty& lazyProperty = (*lazyProperties)[i];
+            if (lazyProperty.make && lazyProperty.name == name) {
+                *id = i;
+                return flags & (HandlesReadAccess | HandlesWriteAccess);
+            }
+        }
+    }
+    return 0; // an ordinary property, or none at all
+}
+
+QScriptValue EntityItemPropertiesClass::property(const QScriptValue& object, const QScriptString& name, uint id) {
+    auto lazyProperties = getLazyProperties(object);
+    if (!lazyProperties || id >= (uint)lazyProperties->size() || !(*lazyProperties)[id].make) {
+        return QScriptValue();
+    }
+    MakeProperty make;
+    std::swap(make, (*lazyProperties)[id].make);
+    QScriptValue value = make(engine());
+
+    // from now on it's an ordinary property of the object
+    QScriptValue(object).setProperty(name, value);
+    return value;
+}
+
+void EntityItemPropertiesClass::setProperty(QScriptValue& object, const QScriptString& name, uint id,
+                                            const QScriptValue& value) {
+    // a property the script sets, or deletes, before reading it need never be made
+    auto lazyProperties = getLazyProperties(object);
+    if (lazyProperties && id < (uint)lazyProperties->size()) {
+        (*lazyProperties)[id].make = nullptr;
+    }
+    object.setProperty(name, value);
+}
+
+QScriptValue::PropertyFlags EntityItemPropertiesClass::propertyFlags(const QScriptValue& object,
+                                                                     const QScriptString& name, uint id) {
+    return 0; // as if it were an ordinary property
+}
+
+QScriptClassPropertyIterator* EntityItemPropertiesClass::newIterator(const QScriptValue& object) {
+    return new LazyPropertiesIterator(object, getLazyProperties(object));
+}
+
+QString EntityItemPropertiesClass::name() const {
+    return CLASS_NAME;
+}
@@ -0,0 +1,58 @@
+//
+//  EntityItemPropertiesClass.h
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityItemPropertiesClass_h
+#define hifi_EntityItemPropertiesClass_h
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtScript/QScriptClass>
+#include <QtScript/QScriptEngine>
+#include <QtScript/QScriptString>
+#include <QtScript/QScriptValue>
+
+// The script class of the objects EntityItemProperties::copyToScriptValue() hands to scripts. Their bigger nested
+// properties (the property groups, boundingBox, renderInfo, ...) aren't made until a script first reads them, so
+// reading props.position doesn't pay for the rest. Once made, or written by the script, one is an ordinary property.
+class EntityItemPropertiesClass : public QObject, public QScriptClass {
+    Q_OBJECT
+public:
+    using MakeProperty = std::function<QScriptValue(QScriptEngine*)>;
+    struct LazyProperty {
+        QScriptString name;
+        MakeProperty make; // empty once made
+    };
+    using LazyProperties = std::vector<LazyProperty>;
+
+    // the engine's instance, made the first time it's asked for
+    static EntityItemPropertiesClass* get(QScriptEngine* engine);
+
+    QScriptValue newInstance();
+    void addLazyProperty(QScriptValue& object, const QString& name, MakeProperty make);
+
+    QueryFlags queryProperty(const QScriptValue& object, const QScriptString& name,
+                             QueryFlags flags, uint* id) override;
+    QScriptValue property(const QScriptValue& object, const QScriptString& name, uint id) override;
+    void setProperty(QScriptValue& object, const QScriptString& name, uint id, const QScriptValue& value) override;
+    QScriptValue::PropertyFlags propertyFlags(const QScriptValue& object, const QScriptString& name, uint id) override;
+    QScriptClassPropertyIterator* newIterator(const QScriptValue& object) override;
+
+    QString name() const override;
+
+private:
+    EntityItemPropertiesClass(QScriptEngine* engine);
+
+    static std::shared_ptr<LazyProperties> getLazyProperties(const QScriptValue& object);
+};
+
+#endif // hifi_EntityItemPropertiesClass_h
@@ -152,6 +152,26 @@ inline QScriptValue convertScriptValue(QScriptEngine* e, const AACube& v) { retu
         properties.setProperty(#g, groupProperties);                                  \
     }
 
+// In copyToScriptValue(), these make the property when a script first reads it, if the properties are lazy
+#define COPY_LAZY_PROPERTY_TO_QSCRIPTVALUE(P, M) \
+    if (lazyProperties) { \
+        lazyProperties->addLazyProperty(properties, #P, M); \
+    } else { \
+        properties.setProperty(#P, (M)(engine)); \
+    }
+
+#define COPY_PROPERTY_GROUP_TO_QSCRIPTVALUE(g) \
+    if (lazyProperties) { \
+        auto group = _##g; \
+        lazyProperties->addLazyProperty(properties, #g, [group](QScriptEngine* engine) { \
+            QScriptValue groupProperties = engine->newObject(); \
+            group.copyToScriptValue(EntityPropertyFlags(), groupProperties, engine, false, defaultEntityProperties); \
+            return groupProperties.property(#g); \
+        }); \
+    } else { \
+        _##g.copyToScriptValue(_desiredProperties, properties, engine, skipDefaults, defaultEntityProperties); \
+    }
+
 #define COPY_PROPERTY_TO_QSCRIPTVALUE(p,P) \
     if ((_desiredProperties.isEmpty() || _desiredProperties.getHasProperty(p)) && \
         (!skipDefaults || defaultEntityProperties._##P != _##P)) { \
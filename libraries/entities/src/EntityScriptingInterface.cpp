@@ -273,128 +273,187 @@ EntityItemProperties EntityScriptingInterface::getEntityProperties(QUuid identit
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
     EntityItemProperties results;
+    bool isScriptSide = false;
     if (_entityTree) {
         _entityTree->withReadLock([&] {
             EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(identity));
             if (entity) {
-                if (desiredProperties.getHasProperty(PROP_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_ROTATION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_ROTATION)) {
-                    // if we are explicitly getting position or rotation, we need parent information to make sense of them.
-                    desiredProperties.setHasProperty(PROP_PARENT_ID);
-                    desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
-                }
+                isScriptSide = getEntityPropertiesWithReadLock(entity, desiredProperties, results);
+            }
+        });
+    }
 
-                if (desiredProperties.isEmpty()) {
-                    // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
-                    // don't end up in json saves, etc.  We still want them here, though.
-                    EncodeBitstreamParams params; // unknown
-                    desiredProperties = entity->getEntityProperties(params);
-                    desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
-                    desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
-                }
+    return isScriptSide ? results : convertLocationToScriptSemantics(results);
+}
+
+bool EntityScriptingInterface::getEntityPropertiesWithReadLock(EntityItemPointer entity, EntityPropertyFlags desiredProperties,
+                                                               EntityItemProperties& results) const {
+    if (desiredProperties.getHasProperty(PROP_POSITION) ||
+        desiredProperties.getHasProperty(PROP_ROTATION) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_ROTATION)) {
+        // if we are explicitly getting position or rotation, we need parent information to make sense of them.
+        desiredProperties.setHasProperty(PROP_PARENT_ID);
+        desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
+    }
+
+    if (EntityItem::areSpatialProperties(desiredProperties)) {
+        // scripts polling where many entities are each frame ask for just this, which the entity
+        // has at hand in both frames, without copying the rest of its properties or looking up its parent
+        results = entity->getSpatialProperties(desiredProperties);
+        results.setLocalPosition(entity->getLocalPosition());
+        results.setLocalRotation(entity->getLocalOrientation());
+        results.setLocalVelocity(entity->getLocalVelocity());
+        results.setLocalAngularVelocity(entity->getLocalAngularVelocity());
+        results.setPosition(entity->getPosition());
+        results.setRotation(entity->getOrientation());
+        results.setVelocity(entity->getVelocity());
+        results.setAngularVelocity(entity->getAngularVelocity());
+        return true;
+    }
 
-                results = entity->getProperties(desiredProperties);
+    if (desiredProperties.isEmpty()) {
+        // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
+        // don't end up in json saves, etc.  We still want them here, though.
+        EncodeBitstreamParams params; // unknown
+        desiredProperties = entity->getEntityProperties(params);
+        desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
+        desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
+    }
 
-                // TODO: improve naturalDimensions in the future,
-                //       for now we've added this hack for setting natural dimensions of models
-                if (entity->getType() == EntityTypes::Model) {
-                    const FBXGeometry* geometry = _entityTree->getGeometryForEntity(entity);
-                    if (geometry) {
-                        Extents meshExtents = geometry->getUnscaledMeshExtents();
-                        results.setNaturalDimensions(meshExtents.maximum - meshExtents.minimum);
-                        results.calculateNaturalPosition(meshExtents.minimum, meshExtents.maximum);
-                    }
-                }
+    results = entity->getProperties(desiredProperties);
 
-            }
-        });
+    // TODO: improve naturalDimensions in the future,
+    //       for now we've added this hack for setting natural dimensions of models
+    if (entity->getType() == EntityTypes::Model) {
+        const FBXGeometry* geometry = _entityTree->getGeometryForEntity(entity);
+        if (geometry) {
+            Extents meshExtents = geometry->getUnscaledMeshExtents();
+            results.setNaturalDimensions(meshExtents.maximum - meshExtents.minimum);
+            results.calculateNaturalPosition(meshExtents.minimum, meshExtents.maximum);
+        }
     }
-
-    return convertLocationToScriptSemantics(results);
+    return false;
 }
 
 QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties& scriptSideProperties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
-    _activityTracking.editedEntityCount++;
+    return editEntitiesWorker({ { id, scriptSideProperties } }).value(0);
+}
 
-    EntityItemProperties properties = scriptSideProperties;
+QVector<QUuid> EntityScriptingInterface::editEntities(const QScriptValue& edits) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
 
-    auto dimensions = properties.getDimensions();
-    float volume = dimensions.x * dimensions.y * dimensions.z;
-    auto density = properties.getDensity();
-    auto newVelocity = properties.getVelocity().length();
-    float oldVelocity = { 0.0f };
+    std::vector<std::pair<QUuid, EntityItemProperties>> scriptSideEdits;
+    quint32 length = edits.property("length").toUInt32();
+    scriptSideEdits.reserve(length);
+    for (quint32 i = 0; i < length; i++) {
+        QScriptValue edit = edits.property(i);
+        EntityItemProperties properties;
+        EntityItemPropertiesFromScriptValueHonorReadOnly(edit.property("properties"), properties);
+        scriptSideEdits.emplace_back(QUuid(edit.property("id").toString()), properties);
+    }
 
-    EntityItemID entityID(id);
-    if (!_entityTree) {
-        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
+    return editEntitiesWorker(scriptSideEdits);
+}
 
-        //if there is no local entity entity tree, no existing velocity, use 0.
-        float cost = calculateCost(density * volume, oldVelocity, newVelocity);
-        cost *= costMultiplier;
+QVector<QUuid> EntityScriptingInterface::editEntitiesWorker(
+        const std::vector<std::pair<QUuid, EntityItemProperties>>& scriptSideEdits) {
+    QVector<QUuid> result;
+    result.reserve((int)scriptSideEdits.size());
 
-        if (cost > _currentAvatarEnergy) {
-            return QUuid();
-        } else {
-            //debit the avatar energy and continue
-            emit debitEnergySource(cost);
-        }
+    _activityTracking.editedEntityCount += (int)scriptSideEdits.size();
 
-        return id;
+    // the costs are of the edits as they came from the script
+    std::vector<float> masses;
+    std::vector<float> newVelocities;
+    std::vector<float> oldVelocities(scriptSideEdits.size(), 0.0f);
+    masses.reserve(scriptSideEdits.size());
+    newVelocities.reserve(scriptSideEdits.size());
+    for (auto& edit : scriptSideEdits) {
+        auto dimensions = edit.second.getDimensions();
+        masses.push_back(dimensions.x * dimensions.y * dimensions.z * edit.second.getDensity());
+        newVelocities.push_back(edit.second.getVelocity().length());
     }
-    // If we have a local entity tree set, then also update it.
 
-    bool updatedEntity = false;
-    _entityTree->withWriteLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
-        }
+    if (!_entityTree) {
+        for (size_t i = 0; i < scriptSideEdits.size(); i++) {
+            queueEntityMessage(PacketType::EntityEdit, scriptSideEdits[i].first, scriptSideEdits[i].second);
 
+            //if there is no local entity entity tree, no existing velocity, use 0.
+            float cost = calculateCost(masses[i], oldVelocities[i], newVelocities[i]);
+            cost *= costMultiplier;
 
-        auto nodeList = DependencyManager::get<NodeList>();
-        if (entity->getClientOnly() && entity->getOwningAvatarID() != nodeList->getSessionUUID()) {
-            // don't edit other avatar's avatarEntities
-            return;
+            if (cost > _currentAvatarEnergy) {
+                result << QUuid();
+            } else {
+                //debit the avatar energy and continue
+                emit debitEnergySource(cost);
+                result << scriptSideEdits[i].first;
+            }
         }
+        return result;
+    }
+    // If we have a local entity tree set, then also update it.
 
-        if (scriptSideProperties.parentRelatedPropertyChanged()) {
-            // All of parentID, parentJointIndex, position, rotation are needed to make sense of any of them.
-            // If any of these changed, pull any missing properties from the entity.
+    std::vector<std::pair<EntityItemID, EntityItemProperties>> edits;
+    edits.reserve(scriptSideEdits.size());
+    for (auto& edit : scriptSideEdits) {
+        edits.emplace_back(edit.first, edit.second);
+    }
 
-            //existing entity, retrieve old velocity for check down below
-            oldVelocity = entity->getVelocity().length();
+    // all of the edits are made under the one lock, a script editing many entities at once would
+    // otherwise take the lock for each of them
+    auto nodeList = DependencyManager::get<NodeList>();
+    _entityTree->withWriteLock([&] {
+        for (size_t i = 0; i < edits.size(); i++) {
+            const EntityItemID& entityID = edits[i].first;
+            const EntityItemProperties& scriptSideProperties = scriptSideEdits[i].second;
+            EntityItemProperties& properties = edits[i].second;
 
-            if (!scriptSideProperties.parentIDChanged()) {
-                properties.setParentID(entity->getParentID());
-            }
-            if (!scriptSideProperties.parentJointIndexChanged()) {
-                properties.setParentJointIndex(entity->getParentJointIndex());
+            EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+            if (!entity) {
+                continue;
             }
-            if (!scriptSideProperties.localPositionChanged() && !scriptSideProperties.positionChanged()) {
-                properties.setPosition(entity->getPosition());
+
+            if (entity->getClientOnly() && entity->getOwningAvatarID() != nodeList->getSessionUUID()) {
+                // don't edit other avatar's avatarEntities
+                continue;
             }
-            if (!scriptSideProperties.localRotationChanged() && !scriptSideProperties.rotationChanged()) {
-                properties.setRotation(entity->getOrientation());
+
+            if (scriptSideProperties.parentRelatedPropertyChanged()) {
+                // All of parentID, parentJointIndex, position, rotation are needed to make sense of any of them.
+                // If any of these changed, pull any missing properties from the entity.
+
+                //existing entity, retrieve old velocity for check down below
+                oldVelocities[i] = entity->getVelocity().length();
+
+                if (!scriptSideProperties.parentIDChanged()) {
+                    properties.setParentID(entity->getParentID());
+                }
+                if (!scriptSideProperties.parentJointIndexChanged()) {
+                    properties.setParentJointIndex(entity->getParentJointIndex());
+                }
+                if (!scriptSideProperties.localPositionChanged() && !scriptSideProperties.positionChanged()) {
+                    properties.setPosition(entity->getPosition());
+                }
+                if (!scriptSideProperties.localRotationChanged() && !scriptSideProperties.rotationChanged()) {
+                    properties.setRotation(entity->getOrientation());
+                }
             }
-        }
-        properties = convertLocationFromScriptSemantics(properties);
-        properties.setClientOnly(entity->getClientOnly());
-        properties.setOwningAvatarID(entity->getOwningAvatarID());
+            properties = convertLocationFromScriptSemantics(properties);
+            properties.setClientOnly(entity->getClientOnly());
+            properties.setOwningAvatarID(entity->getOwningAvatarID());
 
-        float cost = calculateCost(density * volume, oldVelocity, newVelocity);
-        cost *= costMultiplier;
+            float cost = calculateCost(masses[i], oldVelocities[i], newVelocities[i]);
+            cost *= costMultiplier;
 
-        if (cost > _currentAvatarEnergy) {
-            updatedEntity = false;
-        } else {
-            //debit the avatar energy and continue
-            updatedEntity = _entityTree->updateEntity(entityID, properties);
-            if (updatedEntity) {
-                emit debitEnergySource(cost);
+            if (cost <= _currentAvatarEnergy) {
+                //debit the avatar energy and continue
+                if (_entityTree->updateEntity(entityID, properties)) {
+                    emit debitEnergySource(cost);
+                }
             }
         }
     });
@@ -408,66 +467,74 @@ QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties&
     //     return QUuid();
     // }
 
+    // the edits of descendants whose queryAACubes moved go out ahead of the edit that moved them
+    std::vector<std::pair<EntityItemID, EntityItemProperties>> messages;
+    messages.reserve(edits.size());
+    const QUuid myNodeID = nodeList->getSessionUUID();
     _entityTree->withReadLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            // make sure the properties has a type, so that the encode can know which properties to include
-            properties.setType(entity->getType());
-            bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
-            bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
-            if (_bidOnSimulationOwnership && hasPhysicsChanges) {
-                auto nodeList = DependencyManager::get<NodeList>();
-                const QUuid myNodeID = nodeList->getSessionUUID();
+        for (auto& edit : edits) {
+            const EntityItemID& entityID = edit.first;
+            EntityItemProperties& properties = edit.second;
 
-                if (entity->getSimulatorID() == myNodeID) {
-                    // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
-                    if (hasTerseUpdateChanges) {
-                        entity->getAllTerseUpdateProperties(properties);
-                    }
-                    // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
-                    // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
-                    // and instead let the physics simulation decide when to send a terse update.  This would remove
-                    // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
-                    // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
-                    // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
-                    // simulation.
-
-                    if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
-                        // we re-assert our simulation ownership at a higher priority
+            EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+            if (entity) {
+                // make sure the properties has a type, so that the encode can know which properties to include
+                properties.setType(entity->getType());
+                bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
+                bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
+                if (_bidOnSimulationOwnership && hasPhysicsChanges) {
+                    if (entity->getSimulatorID() == myNodeID) {
+                        // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
+                        if (hasTerseUpdateChanges) {
+                            entity->getAllTerseUpdateProperties(properties);
+                        }
+                        // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
+                        // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
+                        // and instead let the physics simulation decide when to send a terse update.  This would remove
+                        // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
+                        // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
+                        // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
+                        // simulation.
+
+                        if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
+                            // we re-assert our simulation ownership at a higher priority
+                            properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
+                        }
+                    } else {
+                        // we make a bid for simulation ownership
                         properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
+                        entity->pokeSimulationOwnership();
+                        entity->rememberHasSimulationOwnershipBid();
                     }
-                } else {
-                    // we make a bid for simulation ownership
-                    properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
-                    entity->pokeSimulationOwnership();
-                    entity->rememberHasSimulationOwnershipBid();
                 }
-            }
-            if (properties.parentRelatedPropertyChanged() && entity->computePuffedQueryAACube()) {
-                properties.setQueryAACube(entity->getQueryAACube());
-            }
-            entity->setLastBroadcast(usecTimestampNow());
-            properties.setLastEdited(entity->getLastEdited());
-
-            // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
-            // if they've changed.
-            entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
-                if (descendant->getNestableType() == NestableType::Entity) {
-                    if (descendant->computePuffedQueryAACube()) {
-                        EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
-                        EntityItemProperties newQueryCubeProperties;
-                        newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                        newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                        queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
-                        entityDescendant->setLastBroadcast(usecTimestampNow());
-                    }
+                if (properties.parentRelatedPropertyChanged() && entity->computePuffedQueryAACube()) {
+                    properties.setQueryAACube(entity->getQueryAACube());
                 }
-            });
+                entity->setLastBroadcast(usecTimestampNow());
+                properties.setLastEdited(entity->getLastEdited());
+
+                // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
+                // if they've changed.
+                entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+                    if (descendant->getNestableType() == NestableType::Entity) {
+                        if (descendant->computePuffedQueryAACube()) {
+                            EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
+                            EntityItemProperties newQueryCubeProperties;
+                            newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                            newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                            messages.emplace_back(descendant->getID(), newQueryCubeProperties);
+                            entityDescendant->setLastBroadcast(usecTimestampNow());
+                        }
+                    }
+                });
+            }
+            messages.emplace_back(entityID, properties);
+            result << entityID;
         }
     });
 
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+    getEntityPacketSender()->queueEditEntityMessages(PacketType::EntityEdit, _entityTree, messages);
+    return result;
 }
 
 void EntityScriptingInterface::deleteEntity(QUuid id) {
@@ -597,11 +664,7 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corn
     return result;
 }
 
-QVector<QUuid> EntityScriptingInterface::findEntitiesInFrustum(QVariantMap frustum) const {
-    PROFILE_RANGE(script_entities, __FUNCTION__);
-
-    QVector<QUuid> result;
-
+bool EntityScriptingInterface::getViewFrustum(const QVariantMap& frustum, ViewFrustum& viewFrustum) {
     const QString POSITION_PROPERTY = "position";
     bool positionOK = frustum.contains(POSITION_PROPERTY);
     glm::vec3 position = positionOK ? qMapToGlmVec3(frustum[POSITION_PROPERTY]) : glm::vec3();
@@ -618,26 +681,108 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInFrustum(QVariantMap frust
     bool centerRadiusOK = frustum.contains(CENTER_RADIUS_PROPERTY);
     float centerRadius = centerRadiusOK ? frustum[CENTER_RADIUS_PROPERTY].toFloat() : 0.0f;
 
-    if (positionOK && orientationOK && projectionOK && centerRadiusOK) {
-        ViewFrustum viewFrustum;
-        viewFrustum.setPosition(position);
-        viewFrustum.setOrientation(orientation);
-        viewFrustum.setProjection(projection);
-        viewFrustum.setCenterRadius(centerRadius);
-        viewFrustum.calculate();
-
-        if (_entityTree) {
-            QVector<EntityItemPointer> entities;
-            _entityTree->withReadLock([&] {
-                _entityTree->findEntities(viewFrustum, entities);
-            });
+    if (!positionOK || !orientationOK || !projectionOK || !centerRadiusOK) {
+        return false;
+    }
+    viewFrustum.setPosition(position);
+    viewFrustum.setOrientation(orientation);
+    viewFrustum.setProjection(projection);
+    viewFrustum.setCenterRadius(centerRadius);
+    viewFrustum.calculate();
+    return true;
+}
 
-            foreach(EntityItemPointer entity, entities) {
-                result << entity->getEntityItemID();
-            }
+QVector<QUuid> EntityScriptingInterface::findEntitiesInFrustum(QVariantMap frustum) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QVector<QUuid> result;
+
+    ViewFrustum viewFrustum;
+    if (getViewFrustum(frustum, viewFrustum) && _entityTree) {
+        QVector<EntityItemPointer> entities;
+        _entityTree->withReadLock([&] {
+            _entityTree->findEntities(viewFrustum, entities);
+        });
+
+        foreach(EntityItemPointer entity, entities) {
+            result << entity->getEntityItemID();
+        }
+    }
+
+    return result;
+}
+
+EntitiesWithProperties EntityScriptingInterface::findEntitiesWithProperties(const glm::vec3& center, float radius,
+                                                                            const QScriptValue& desiredProperties) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    return findEntitiesWithPropertiesWorker([&](QVector<EntityItemPointer>& entities) {
+        _entityTree->findEntities(center, radius, entities);
+    }, desiredProperties);
+}
+
+EntitiesWithProperties EntityScriptingInterface::findEntitiesInBoxWithProperties(const glm::vec3& corner,
+        const glm::vec3& dimensions, const QScriptValue& desiredProperties) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    AABox box(corner, dimensions);
+    return findEntitiesWithPropertiesWorker([&](QVector<EntityItemPointer>& entities) {
+        _entityTree->findEntities(box, entities);
+    }, desiredProperties);
+}
+
+EntitiesWithProperties EntityScriptingInterface::findEntitiesInFrustumWithProperties(QVariantMap frustum,
+                                                                                     const QScriptValue& desiredProperties) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    ViewFrustum viewFrustum;
+    if (!getViewFrustum(frustum, viewFrustum)) {
+        return EntitiesWithProperties();
+    }
+    return findEntitiesWithPropertiesWorker([&](QVector<EntityItemPointer>& entities) {
+        _entityTree->findEntities(viewFrustum, entities);
+    }, desiredProperties);
+}
+
+EntitiesWithProperties EntityScriptingInterface::findEntitiesWithPropertiesWorker(
+        std::function<void(QVector<EntityItemPointer>&)> findEntities, const QScriptValue& desiredProperties) const {
+    EntitiesWithProperties result;
+    if (!_entityTree) {
+        return result;
+    }
+
+    // keep the names the script gave, those of properties there are, to name the arrays handed back
+    EntityPropertyFlags desiredFlags;
+    QStringList names = desiredProperties.isString() ? QStringList(desiredProperties.toString()) :
+        qscriptvalue_cast<QStringList>(desiredProperties);
+    foreach (const QString& name, names) {
+        EntityPropertyFlags flags;
+        EntityPropertyFlagsFromScriptValue(QScriptValue(name), flags);
+        if (!flags.isEmpty() && !result.propertyNames.contains(name)) {
+            result.propertyNames << name;
+            desiredFlags += flags;
         }
     }
 
+    std::vector<bool> isScriptSide;
+    _entityTree->withReadLock([&] {
+        QVector<EntityItemPointer> entities;
+        findEntities(entities);
+
+        result.ids.reserve(entities.size());
+        result.properties.resize(entities.size());
+        isScriptSide.resize(entities.size());
+        for (int i = 0; i < entities.size(); i++) {
+            result.ids << entities[i]->getEntityItemID();
+            isScriptSide[i] = getEntityPropertiesWithReadLock(entities[i], desiredFlags, result.properties[i]);
+        }
+    });
+
+    for (size_t i = 0; i < result.properties.size(); i++) {
+        if (!isScriptSide[i]) {
+            result.properties[i] = convertLocationToScriptSemantics(result.properties[i]);
+        }
+    }
     return result;
 }
 
@@ -897,6 +1042,69 @@ QScriptValue RayToEntityIntersectionResultToScriptValue(QScriptEngine* engine, c
     return obj;
 }
 
+QScriptValue EntitiesWithPropertiesToScriptValue(QScriptEngine* engine, const EntitiesWithProperties& value) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    const int numEntities = value.ids.size();
+    QScriptValue obj = engine->newObject();
+    QScriptValue ids = engine->newArray(numEntities);
+    for (int i = 0; i < numEntities; i++) {
+        ids.setProperty(i, quuidToScriptValue(engine, value.ids[i]));
+    }
+    obj.setProperty("ids", ids);
+
+    static const QString POSITION_PROPERTY = "position";
+    QStringList otherNames;
+    foreach (const QString& name, value.propertyNames) {
+        if (name != POSITION_PROPERTY) {
+            otherNames << name;
+            continue;
+        }
+
+        // packed x, y, z in a Float32Array, where the engine has them
+        QScriptValue float32Array = engine->globalObject().property("Float32Array");
+        if (float32Array.isFunction()) {
+            QByteArray positions(numEntities * 3 * (int)sizeof(float), 0);
+            float* data = reinterpret_cast<float*>(positions.data());
+            for (int i = 0; i < numEntities; i++) {
+                glm::vec3 position = value.properties[i].getPosition();
+                data[3 * i] = position.x;
+                data[3 * i + 1] = position.y;
+                data[3 * i + 2] = position.z;
+            }
+            obj.setProperty(name, float32Array.construct(QScriptValueList() << engine->toScriptValue(positions)));
+        } else {
+            QScriptValue positions = engine->newArray(numEntities);
+            for (int i = 0; i < numEntities; i++) {
+                positions.setProperty(i, vec3toScriptValue(engine, value.properties[i].getPosition()));
+            }
+            obj.setProperty(name, positions);
+        }
+    }
+
+    if (!otherNames.isEmpty()) {
+        QVector<QScriptValue> arrays;
+        arrays.reserve(otherNames.size());
+        foreach (const QString& name, otherNames) {
+            arrays << engine->newArray(numEntities);
+            obj.setProperty(name, arrays.back());
+        }
+        for (int i = 0; i < numEntities; i++) {
+            // just the properties asked for, so this is brief
+            QScriptValue properties = value.properties[i].copyToScriptValue(engine, false, false, true);
+            for (int j = 0; j < otherNames.size(); j++) {
+                arrays[j].setProperty(i, properties.property(otherNames[j]));
+            }
+        }
+    }
+    return obj;
+}
+
+void EntitiesWithPropertiesFromScriptValue(const QScriptValue& object, EntitiesWithProperties& value) {
+    // only the ids can be had back
+    qScriptValueToSequence(object.property("ids"), value.ids);
+}
+
 void RayToEntityIntersectionResultFromScriptValue(const QScriptValue& object, RayToEntityIntersectionResult& value) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
@@ -73,6 +73,20 @@ Q_DECLARE_METATYPE(RayToEntityIntersectionResult)
 QScriptValue RayToEntityIntersectionResultToScriptValue(QScriptEngine* engine, const RayToEntityIntersectionResult& results);
 void RayToEntityIntersectionResultFromScriptValue(const QScriptValue& object, RayToEntityIntersectionResult& results);
 
+// What the find...WithProperties functions found, handed to scripts as packed arrays: ids, and an array for each
+// property asked for, holding its value for each entity in the order of ids (a Float32Array of x, y, z for position)
+class EntitiesWithProperties {
+public:
+    QStringList propertyNames;
+    QVector<QUuid> ids;
+    std::vector<EntityItemProperties> properties; // script-side
+};
+
+Q_DECLARE_METATYPE(EntitiesWithProperties)
+
+QScriptValue EntitiesWithPropertiesToScriptValue(QScriptEngine* engine, const EntitiesWithProperties& value);
+void EntitiesWithPropertiesFromScriptValue(const QScriptValue& object, EntitiesWithProperties& value);
+
 
 /**jsdoc
  * @namespace Entities
@@ -167,10 +181,22 @@ public slots:
      * Updates an entity with the specified properties.
      *
      * @function Entities.editEntity
-     * @return {EntityID} The EntityID of the entity if the edit was successful, otherwise the null {EntityID}.
+     * @return {EntityID} The EntityID of the entity, once the edit is sent to the server. Edits of entities that
+     *     aren't in the local tree are sent too, so this doesn't mean the edit was applied. Only without a local
+     *     tree, when the avatar doesn't have the energy for the edit, is the null {EntityID} returned.
      */
     Q_INVOKABLE QUuid editEntity(QUuid entityID, const EntityItemProperties& properties);
 
+    /**jsdoc
+     * Updates several entities, as editEntity does for each, but locking the tree and queueing the edits for
+     * the server just the once.
+     *
+     * @function Entities.editEntities
+     * @param {Object[]} edits The edits, each an object with the `id` of the entity and the `properties` to set.
+     * @return {EntityID[]} The EntityID of each entity, or the null {EntityID}, as editEntity returns for it.
+     */
+    Q_INVOKABLE QVector<QUuid> editEntities(const QScriptValue& edits);
+
     /**jsdoc
      * Deletes an entity.
      *
@@ -224,6 +250,15 @@ public slots:
     /// this function will not find any models in script engine contexts which don't have access to models
     Q_INVOKABLE QVector<QUuid> findEntitiesInFrustum(QVariantMap frustum) const;
 
+    /// these find models as the functions above do, and get the properties asked for of each of them, while the tree is
+    /// locked the once, rather than the script calling getEntityProperties for each
+    Q_INVOKABLE EntitiesWithProperties findEntitiesWithProperties(const glm::vec3& center, float radius,
+                                                                  const QScriptValue& desiredProperties) const;
+    Q_INVOKABLE EntitiesWithProperties findEntitiesInBoxWithProperties(const glm::vec3& corner, const glm::vec3& dimensions,
+                                                                       const QScriptValue& desiredProperties) const;
+    Q_INVOKABLE EntitiesWithProperties findEntitiesInFrustumWithProperties(QVariantMap frustum,
+                                                                           const QScriptValue& desiredProperties) const;
+
     /// If the scripting context has visible entities, this will determine a ray intersection, the results
     /// may be inaccurate if the engine is unable to access the visible entities, in which case result.accurate
     /// will be false.
@@ -388,6 +423,14 @@ private:
     bool polyVoxWorker(QUuid entityID, std::function<bool(PolyVoxEntityItem&)> actor);
     bool setPoints(QUuid entityID, std::function<bool(LineEntityItem&)> actor);
     void queueEntityMessage(PacketType packetType, EntityItemID entityID, const EntityItemProperties& properties);
+    QVector<QUuid> editEntitiesWorker(const std::vector<std::pair<QUuid, EntityItemProperties>>& scriptSideEdits);
+
+    // with the tree read locked, returns true if the properties are already script-side
+    bool getEntityPropertiesWithReadLock(EntityItemPointer entity, EntityPropertyFlags desiredProperties,
+                                         EntityItemProperties& results) const;
+    EntitiesWithProperties findEntitiesWithPropertiesWorker(std::function<void(QVector<EntityItemPointer>&)> findEntities,
+                                                            const QScriptValue& desiredProperties) const;
+    static bool getViewFrustum(const QVariantMap& frustum, ViewFrustum& viewFrustum);
 
     EntityItemPointer checkForTreeEntityAndTypeMatch(const QUuid& entityID,
                                                      EntityTypes::EntityType entityType = EntityTypes::Unknown);
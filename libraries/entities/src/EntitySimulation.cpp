@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <tbb/parallel_for.h>
+
 #include <AACube.h>
 
 #include "EntitySimulation.h"
@@ -257,7 +259,25 @@ void EntitySimulation::clearEntities() {
     _entitiesToDelete.clear();
 }
 
+void EntitySimulation::KinematicMotions::clear() {
+    entities.clear();
+    timesElapsed.clear();
+    dampings.clear();
+    angularDampings.clear();
+    localAccelerations.clear();
+    positions.clear();
+    rotations.clear();
+    scales.clear();
+    linearVelocities.clear();
+    angularVelocities.clear();
+    isMoving.clear();
+}
+
 void EntitySimulation::moveSimpleKinematics(const quint64& now) {
+    // gather the motion of the entities to step, as EntityItem::simulate and stepKinematicMotion would read it
+    auto& motions = _kinematicMotions;
+    motions.clear();
+
     SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
     while (itemItr != _simpleKinematicEntities.end()) {
         EntityItemPointer entity = *itemItr;
@@ -268,15 +288,76 @@ void EntitySimulation::moveSimpleKinematics(const quint64& now) {
         entity->getMaximumAACube(ancestryIsKnown);
         bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
 
-        if (entity->isMovingRelativeToParent() && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
-            _entitiesToSort.insert(entity);
-            ++itemItr;
-        } else {
+        if (!(entity->isMovingRelativeToParent() && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor)) {
             // the entity is no longer non-physical-kinematic
             itemItr = _simpleKinematicEntities.erase(itemItr);
+            continue;
+        }
+        ++itemItr;
+
+        quint64 lastSimulated = entity->getLastSimulated();
+        float timeElapsed = (lastSimulated == 0) ? 0.0f : (float)(now - lastSimulated) / (float)(USECS_PER_SECOND);
+
+        Transform transform;
+        glm::vec3 linearVelocity;
+        glm::vec3 angularVelocity;
+        entity->getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+
+        // acceleration is in world-frame but we need it in local-frame
+        glm::vec3 localAcceleration = entity->getAcceleration();
+        if (glm::length2(localAcceleration) > 0.0f) {
+            bool success;
+            Transform parentTransform = entity->getParentTransform(success);
+            if (success) {
+                localAcceleration = glm::inverse(parentTransform.getRotation()) * localAcceleration;
+            }
+        }
+
+        motions.entities.push_back(entity);
+        motions.timesElapsed.push_back(timeElapsed);
+        motions.dampings.push_back(entity->getDamping());
+        motions.angularDampings.push_back(entity->getAngularDamping());
+        motions.localAccelerations.push_back(localAcceleration);
+        motions.positions.push_back(transform.getTranslation());
+        motions.rotations.push_back(transform.getRotation());
+        motions.scales.push_back(transform.getScale());
+        motions.linearVelocities.push_back(linearVelocity);
+        motions.angularVelocities.push_back(angularVelocity);
+        motions.isMoving.push_back(0);
+    }
+
+    // the integration touches nothing but the arrays, so it is split across the workers for a large crowd
+    const size_t MOTIONS_PER_TASK = 256;
+    auto stepMotions = [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); i++) {
+            motions.isMoving[i] = EntityItem::stepKinematicMotion(motions.timesElapsed[i], motions.dampings[i],
+                motions.angularDampings[i], motions.localAccelerations[i], motions.positions[i], motions.rotations[i],
+                motions.linearVelocities[i], motions.angularVelocities[i]) ? 1 : 0;
         }
+    };
+    if (motions.size() > MOTIONS_PER_TASK) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, motions.size(), MOTIONS_PER_TASK), stepMotions);
+    } else {
+        stepMotions(tbb::blocked_range<size_t>(0, motions.size()));
     }
+
+    // and write back what moved
+    for (size_t i = 0; i < motions.size(); i++) {
+        EntityItemPointer& entity = motions.entities[i];
+        bool isMoving = motions.isMoving[i] != 0;
+        if (isMoving && motions.timesElapsed[i] > 0.0f) {
+            Transform transform;
+            transform.setTranslation(motions.positions[i]);
+            transform.setRotation(motions.rotations[i]);
+            transform.setScale(motions.scales[i]);
+            entity->setLocalTransformAndVelocities(transform, motions.linearVelocities[i], motions.angularVelocities[i]);
+        }
+        entity->finishSimulate(now, isMoving);
+        _entitiesToSort.insert(entity);
+    }
+
+    // don't hold on to the entities between steps
+    motions.entities.clear();
 }
 
 void EntitySimulation::addAction(EntityActionPointer action) {
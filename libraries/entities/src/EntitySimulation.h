@@ -103,6 +103,27 @@ protected:
 
     SetOfEntities _entitiesToSort; // entities moved by simulation (and might need resort in EntityTree)
     SetOfEntities _simpleKinematicEntities; // entities undergoing non-colliding kinematic motion
+
+    // The motion of the simple kinematic entities, gathered into contiguous arrays indexed by a dense handle so that
+    // the integration is one sweep over them, in parallel for a large crowd.  It is refilled for each step, keeping
+    // its allocations, since scripts and the network also move these entities between steps.
+    struct KinematicMotions {
+        void clear();
+        size_t size() const { return entities.size(); }
+
+        std::vector<EntityItemPointer> entities;
+        std::vector<float> timesElapsed;
+        std::vector<float> dampings;
+        std::vector<float> angularDampings;
+        std::vector<glm::vec3> localAccelerations;
+        std::vector<glm::vec3> positions;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::vec3> scales;
+        std::vector<glm::vec3> linearVelocities;
+        std::vector<glm::vec3> angularVelocities;
+        std::vector<uint8_t> isMoving;
+    };
+    KinematicMotions _kinematicMotions;
     QList<EntityActionPointer> _actionsToAdd;
     QSet<QUuid> _actionsToRemove;
 
@@ -74,7 +74,7 @@ void EntityTree::createRootElement() {
 }
 
 OctreeElementPointer EntityTree::createNewElement(unsigned char* octalCode) {
-    auto newElement = EntityTreeElementPointer(new EntityTreeElement(octalCode));
+    auto newElement = EntityTreeElement::newElement(octalCode);
     newElement->setTree(std::static_pointer_cast<EntityTree>(shared_from_this()));
     return std::static_pointer_cast<OctreeElement>(newElement);
 }
@@ -528,6 +528,9 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             // set up the deleted entities ID
             QWriteLocker locker(&_recentlyDeletedEntitiesLock);
             _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            if (_journalDeletedEntities) {
+                _deletedEntitiesToJournal.insert(theEntity->getEntityItemID());
+            }
         } else {
             // on the client side, we also remember that we deleted this entity, we don't care about the time
             trackDeletedEntity(theEntity->getEntityItemID());
@@ -634,7 +637,7 @@ class FindAllNearPointArgs {
 public:
     glm::vec3 position;
     float targetRadius;
-    QVector<EntityItemPointer> entities;
+    QVector<EntityItemPointer>& entities;
 };
 
 
@@ -656,22 +659,21 @@ bool EntityTree::findInSphereOperation(OctreeElementPointer element, void* extra
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
-    FindAllNearPointArgs args = { center, radius, QVector<EntityItemPointer>() };
+    // collect straight into the caller's vector, keeping its capacity, so that a caller can reuse one for every query
+    foundEntities.resize(0);
+    FindAllNearPointArgs args = { center, radius, foundEntities };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInSphereOperation, &args);
-
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
 }
 
 class FindEntitiesInCubeArgs {
 public:
-    FindEntitiesInCubeArgs(const AACube& cube)
-        : _cube(cube), _foundEntities() {
+    FindEntitiesInCubeArgs(const AACube& cube, QVector<EntityItemPointer>& foundEntities)
+        : _cube(cube), _foundEntities(foundEntities) {
     }
 
     AACube _cube;
-    QVector<EntityItemPointer> _foundEntities;
+    QVector<EntityItemPointer>& _foundEntities;
 };
 
 bool EntityTree::findInCubeOperation(OctreeElementPointer element, void* extraData) {
@@ -686,21 +688,20 @@ bool EntityTree::findInCubeOperation(OctreeElementPointer element, void* extraDa
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
-    FindEntitiesInCubeArgs args(cube);
+    foundEntities.resize(0);
+    FindEntitiesInCubeArgs args(cube, foundEntities);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInCubeOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args._foundEntities);
 }
 
 class FindEntitiesInBoxArgs {
 public:
-    FindEntitiesInBoxArgs(const AABox& box)
-    : _box(box), _foundEntities() {
+    FindEntitiesInBoxArgs(const AABox& box, QVector<EntityItemPointer>& foundEntities)
+    : _box(box), _foundEntities(foundEntities) {
     }
 
     AABox _box;
-    QVector<EntityItemPointer> _foundEntities;
+    QVector<EntityItemPointer>& _foundEntities;
 };
 
 bool EntityTree::findInBoxOperation(OctreeElementPointer element, void* extraData) {
@@ -715,17 +716,16 @@ bool EntityTree::findInBoxOperation(OctreeElementPointer element, void* extraDat
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
-    FindEntitiesInBoxArgs args(box);
+    foundEntities.resize(0);
+    FindEntitiesInBoxArgs args(box, foundEntities);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInBoxOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args._foundEntities);
 }
 
 class FindInFrustumArgs {
 public:
-    ViewFrustum frustum;
-    QVector<EntityItemPointer> entities;
+    const ViewFrustum& frustum;
+    QVector<EntityItemPointer>& entities;
 };
 
 bool EntityTree::findInFrustumOperation(OctreeElementPointer element, void* extraData) {
@@ -740,11 +740,10 @@ bool EntityTree::findInFrustumOperation(OctreeElementPointer element, void* extr
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities) {
-    FindInFrustumArgs args = { frustum, QVector<EntityItemPointer>() };
+    foundEntities.resize(0);
+    FindInFrustumArgs args = { frustum, foundEntities };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInFrustumOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
 }
 
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) {
@@ -948,7 +947,7 @@ void EntityTree::bumpTimestamp(EntityItemProperties& properties) { //fixme put c
 }
 
 int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
-                                     const SharedNodePointer& senderNode) {
+                                     const SharedNodePointer& senderNode, quint64& lockWaitTime) {
 
     if (!getIsServer()) {
         qCDebug(entities) << "UNEXPECTED!!! processEditPacketData() should only be called on a server tree.";
@@ -961,7 +960,11 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     switch (message.getType()) {
         case PacketType::EntityErase: {
             QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-            processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            quint64 startLock = usecTimestampNow();
+            withWriteLock([&] {
+                lockWaitTime += usecTimestampNow() - startLock;
+                processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            });
             break;
         }
 
@@ -1034,6 +1037,11 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
 
             // If we got a valid edit packet, then it could be a new entity or it could be an update to
             // an existing entity... handle appropriately
+            //
+            // Everything up to the update or add itself (decoding, the whitelist, the lookup and the edit filter)
+            // runs without the tree lock, so that the send threads keep encoding while it does. The entity lookup
+            // goes through the entity-to-element map and the element's own locks, and only the update or add that
+            // reshapes the tree takes the write lock.
             if (validEditPacket) {
 
                 // search for the entity by EntityItemID
@@ -1083,8 +1091,15 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                     if (!isPhysics) {
                         properties.setLastEditedBy(senderNode->getUUID());
                     }
-                    updateEntity(entityItemID, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
+                    bool updated = false;
+                    withWriteLock([&] {
+                        lockWaitTime += usecTimestampNow() - startUpdate;
+                        // this fails harmlessly if the entity was deleted since we looked it up
+                        updated = updateEntity(entityItemID, properties, senderNode);
+                    });
+                    if (updated) {
+                        existingEntity->markAsChangedOnServer();
+                    }
                     endUpdate = usecTimestampNow();
                     _totalUpdates++;
                 } else if (isAdd) {
@@ -1101,7 +1116,11 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                         properties.setCreated(properties.getLastEdited());
                         properties.setLastEditedBy(senderNode->getUUID());
                         startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                        EntityItemPointer newEntity;
+                        withWriteLock([&] {
+                            lockWaitTime += usecTimestampNow() - startCreate;
+                            newEntity = addEntity(entityItemID, properties);
+                        });
                         endCreate = usecTimestampNow();
                         _totalCreates++;
                         if (newEntity) {
@@ -1666,6 +1685,10 @@ bool EntityTree::readFromMap(QVariantMap& map) {
             entityItemID = EntityItemID(QUuid::createUuid());
         }
 
+        if (_entitiesReplacedByReplay.contains(entityItemID)) {
+            continue; // deleted or replaced by the changes we'll replay after the load
+        }
+
         EntityItemPointer entity = addEntity(entityItemID, properties);
         if (!entity) {
             qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
@@ -1675,6 +1698,49 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return success;
 }
 
+bool EntityTree::writeChangesToMap(QVariantMap& changes, quint64 changedSince) {
+    // NOTE: callers must lock the tree before using this method
+    QVariantList deletedIDs;
+    {
+        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+        _journalDeletedEntities = true;
+        foreach (const QUuid& entityID, _deletedEntitiesToJournal) {
+            deletedIDs << entityID.toString();
+        }
+        _deletedEntitiesToJournal.clear();
+    }
+    changes["Deleted"] = deletedIDs;
+    changes["Entities"] = QVariantList();
+
+    QScriptEngine scriptEngine;
+    RecurseOctreeToMapOperator theOperator(changes, NULL, &scriptEngine, true, true, changedSince);
+    recurseTreeWithOperator(&theOperator);
+    return true;
+}
+
+void EntityTree::setChangesToReplay(const QVariantMap& changes) {
+    _entitiesToReplay = changes["Entities"].toList();
+    _entitiesReplacedByReplay.clear();
+    foreach (const QVariant& entityID, changes["Deleted"].toList()) {
+        _entitiesReplacedByReplay.insert(QUuid(entityID.toString()));
+    }
+    foreach (const QVariant& entityVariant, _entitiesToReplay) {
+        _entitiesReplacedByReplay.insert(QUuid(entityVariant.toMap()["id"].toString()));
+    }
+}
+
+bool EntityTree::replayChanges() {
+    // NOTE: callers must lock the tree before using this method
+    _entitiesReplacedByReplay.clear();
+    if (_entitiesToReplay.isEmpty()) {
+        return true;
+    }
+    QVariantMap entityDescription;
+    entityDescription["Entities"] = _entitiesToReplay;
+    _entitiesToReplay.clear();
+    return readFromMap(entityDescription);
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+
 #include <QSet>
 #include <QVector>
 
@@ -97,7 +99,7 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const override;
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
-                                      const SharedNodePointer& senderNode) override;
+                                      const SharedNodePointer& senderNode, quint64& lockWaitTime) override;
 
     virtual bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
@@ -149,24 +151,25 @@ public:
     /// \param center the center of the sphere in world-frame (meters)
     /// \param radius the radius of the sphere in world-frame (meters)
     /// \param foundEntities[out] vector of EntityItemPointer
-    /// \remark Side effect: any initial contents in foundEntities will be lost
+    /// \remark Side effect: any initial contents in foundEntities will be lost, but its capacity is kept for reuse
     void findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities);
 
     /// finds all entities that touch a cube
     /// \param cube the query cube in world-frame (meters)
     /// \param foundEntities[out] vector of non-EntityItemPointer
-    /// \remark Side effect: any initial contents in entities will be lost
+    /// \remark Side effect: any initial contents in entities will be lost, but its capacity is kept for reuse
     void findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities);
 
     /// finds all entities that touch a box
     /// \param box the query box in world-frame (meters)
     /// \param foundEntities[out] vector of non-EntityItemPointer
-    /// \remark Side effect: any initial contents in entities will be lost
+    /// \remark Side effect: any initial contents in entities will be lost, but its capacity is kept for reuse
     void findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities);
 
     /// finds all entities within a frustum
     /// \parameter frustum the query frustum
     /// \param foundEntities[out] vector of EntityItemPointer
+    /// \remark Side effect: any initial contents in foundEntities will be lost, but its capacity is kept for reuse
     void findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
 
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
@@ -225,6 +228,9 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
+    virtual bool writeChangesToMap(QVariantMap& changes, quint64 changedSince) override;
+    virtual void setChangesToReplay(const QVariantMap& changes) override;
+    virtual bool replayChanges() override;
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
@@ -306,6 +312,11 @@ protected:
 
     mutable QReadWriteLock _recentlyDeletedEntitiesLock; /// lock of server side recent deletes
     QMultiMap<quint64, QUuid> _recentlyDeletedEntityItemIDs; /// server side recent deletes
+    bool _journalDeletedEntities { false }; /// guarded by _recentlyDeletedEntitiesLock
+    QSet<QUuid> _deletedEntitiesToJournal; /// server side deletes since the last writeChangesToMap()
+
+    QVariantList _entitiesToReplay;
+    QSet<QUuid> _entitiesReplacedByReplay;
 
     mutable QReadWriteLock _deletedEntitiesLock; /// lock of client side recent deletes
     QSet<QUuid> _deletedEntityItemIDs; /// client side recent deletes
@@ -331,16 +342,16 @@ protected:
     bool _wantTerseEditLogging = false;
 
 
-    // some performance tracking properties - only used in server trees
-    int _totalEditMessages = 0;
-    int _totalUpdates = 0;
-    int _totalCreates = 0;
-    quint64 _totalDecodeTime = 0;
-    quint64 _totalLookupTime = 0;
-    quint64 _totalUpdateTime = 0;
-    quint64 _totalCreateTime = 0;
-    quint64 _totalLoggingTime = 0;
-    quint64 _totalFilterTime = 0;
+    // some performance tracking properties - only used in server trees, where edits can be processed on several threads
+    std::atomic<int> _totalEditMessages { 0 };
+    std::atomic<int> _totalUpdates { 0 };
+    std::atomic<int> _totalCreates { 0 };
+    std::atomic<quint64> _totalDecodeTime { 0 };
+    std::atomic<quint64> _totalLookupTime { 0 };
+    std::atomic<quint64> _totalUpdateTime { 0 };
+    std::atomic<quint64> _totalCreateTime { 0 };
+    std::atomic<quint64> _totalLoggingTime { 0 };
+    std::atomic<quint64> _totalFilterTime { 0 };
 
     // these performance statistics are only used in the client
     void resetClientEditStats();
@@ -9,11 +9,14 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <glm/gtx/transform.hpp>
 
 #include <FBXReader.h>
 #include <GeometryUtil.h>
 #include <OctreeUtils.h>
+#include <PoolAllocator.h>
 
 #include "EntitiesLogging.h"
 #include "EntityNodeData.h"
@@ -22,6 +25,10 @@
 #include "EntityTreeElement.h"
 #include "EntityTypes.h"
 
+// entities closer than this are ranked as if they were this far away
+const float MIN_ENTITY_PRIORITY_DISTANCE = 1.0f; // meters
+const float COLLIDABLE_ENTITY_PRIORITY_SCALE = 2.0f;
+
 EntityTreeElement::EntityTreeElement(unsigned char* octalCode) : OctreeElement() {
     init(octalCode);
 };
@@ -30,8 +37,17 @@ EntityTreeElement::~EntityTreeElement() {
     _octreeMemoryUsage -= sizeof(EntityTreeElement);
 }
 
+EntityTreeElementPointer EntityTreeElement::newElement(unsigned char* octalCode) {
+    PoolAllocator<EntityTreeElement> allocator;
+    EntityTreeElement* element = new (allocator.allocate(1)) EntityTreeElement(octalCode);
+    return EntityTreeElementPointer(element, [](EntityTreeElement* element) {
+        element->~EntityTreeElement();
+        PoolAllocator<EntityTreeElement>().deallocate(element, 1);
+    }, allocator);
+}
+
 OctreeElementPointer EntityTreeElement::createNewElement(unsigned char* octalCode) {
-    auto newChild = EntityTreeElementPointer(new EntityTreeElement(octalCode));
+    auto newChild = newElement(octalCode);
     newChild->setTree(_myTree);
     return newChild;
 }
@@ -83,8 +99,11 @@ void EntityTreeElement::initializeExtraEncodeData(EncodeBitstreamParams& params)
                 }
             }
         }
+        // as in appendElementData, only the entities that can be included need their properties snapshotted
         forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            if (params.forceSendScene || entity->getLastChangedOnServer() >= params.lastQuerySent) {
+                entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            }
         });
 
         // TODO: some of these inserts might be redundant!!!
@@ -262,8 +281,12 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 }
             }
         }
+        // only the entities that changed since the last send can be included below (unless the whole scene is sent),
+        // so don't snapshot the properties of the rest
         forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            if (params.forceSendScene || entity->getLastChangedOnServer() >= params.lastQuerySent) {
+                entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            }
         });
     }
 
@@ -279,6 +302,7 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
     int numberOfEntitiesOffset = 0;
     withReadLock([&] {
         QVector<uint16_t> indexesOfEntitiesToInclude;
+        std::vector<float> entityPriorities;
         
         // It's possible that our element has been previous completed. In this case we'll simply not include any of our
         // entities for encoding. This is needed because we encode the element data at the "parent" level, and so we
@@ -294,6 +318,29 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 jsonFilters = entityNodeData->getJSONParameters();
             }
 
+            // the query cubes of the entities are tested against the keyhole all together
+            std::vector<AACube> entityCubes;
+            std::vector<uint8_t> entitiesInView;
+            if (params.usesFrustum) {
+                entityPriorities.resize(_entityItems.size(), 0.0f);
+
+                AABoxArrays entityBoxes;
+                entityBoxes.resize(_entityItems.size());
+                entityCubes.resize(_entityItems.size());
+                entitiesInView.resize(_entityItems.size());
+                for (size_t i = 0; i < _entityItems.size(); i++) {
+                    bool success;
+                    entityCubes[i] = _entityItems[i]->getQueryAACube(success);
+                    entityBoxes.set(i, AABox(entityCubes[i]));
+                    entitiesInView[i] = success ? 1 : 0;
+                }
+                std::vector<uint8_t> inKeyhole(_entityItems.size());
+                params.viewFrustum.boxesIntersectKeyhole(entityBoxes, 0, entityBoxes.size(), inKeyhole.data());
+                for (size_t i = 0; i < entitiesInView.size(); i++) {
+                    entitiesInView[i] &= inKeyhole[i];
+                }
+            }
+
             for (uint16_t i = 0; i < _entityItems.size(); i++) {
                 EntityItemPointer entity = _entityItems[i];
                 bool includeThisEntity = true;
@@ -336,16 +383,15 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                     // simulation changing what's visible. consider the case where the entity contains an angular velocity
                     // the entity may not be in view and then in view a frame later, let the client side handle it's view
                     // frustum culling on rendering.
-                    bool success;
-                    AACube entityCube = entity->getQueryAACube(success);
-                    if (!success || !params.viewFrustum.cubeIntersectsKeyhole(entityCube)) {
+                    const AACube& entityCube = entityCubes[i];
+                    if (!entitiesInView[i]) {
                         includeThisEntity = false; // out of view, don't include it
                     } else {
                         // Check the size of the entity, it's possible that a "too small to see" entity is included in a
                         // larger octree cell because of its position (for example if it crosses the boundary of a cell it
                         // pops to the next higher cell. So we want to check to see that the entity is large enough to be seen
                         // before we consider including it.
-                        success = true;
+                        bool success = true;
                         // we can't cull a parent-entity by its dimensions because the child may be larger.  we need to
                         // avoid sending details about a child but not the parent.  the parent's queryAACube should have
                         // been adjusted to encompass the queryAACube of the child.
@@ -359,6 +405,13 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                                                                       entityBounds,
                                                                       params.octreeElementSizeScale,
                                                                       params.boundaryLevelAdjust);
+                        // the entities that look largest go first, and the ones the viewer can collide with before
+                        // the ones it can't, so that a partial send has the most noticeable ones
+                        float distance = std::max(glm::distance(params.viewFrustum.getPosition(), entityBounds.calcCenter()),
+                                                  MIN_ENTITY_PRIORITY_DISTANCE);
+                        entityPriorities[i] = glm::length(entityBounds.getScale()) / distance *
+                            (entity->getCollisionless() ? 1.0f : COLLIDABLE_ENTITY_PRIORITY_SCALE);
+
                         if (renderAccuracy <= 0.0f) {
                             includeThisEntity = false; // too small, don't include it
 
@@ -390,6 +443,12 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
             }
         }
 
+        if (!entityPriorities.empty()) {
+            std::stable_sort(indexesOfEntitiesToInclude.begin(), indexesOfEntitiesToInclude.end(), [&](uint16_t a, uint16_t b) {
+                return entityPriorities[a] > entityPriorities[b];
+            });
+        }
+
         numberOfEntitiesOffset = packetData->getUncompressedByteOffset();
         bool successAppendEntityCount = packetData->appendValue(numberOfEntities);
 
@@ -589,6 +648,21 @@ bool EntityTreeElement::findRayIntersection(const glm::vec3& origin, const glm::
         return false; // we don't intersect with non-leaves, and we keep searching
     }
 
+    // the element cube holds any entity that fits in it, so it's usually much bigger than its entities (and
+    // contains the origin for every ancestor of the origin's element). Skip the entities if the ray misses all
+    // of them, or can't reach any of them before what we've already found.
+    AABox entitiesBounds;
+    if (getEntitiesBounds(entitiesBounds)) {
+        float distanceToEntitiesBounds;
+        BoxFace boundsFace;
+        glm::vec3 boundsNormal;
+        if (entitiesBounds.isInvalid() || (!entitiesBounds.contains(origin) &&
+                (!entitiesBounds.findRayIntersection(origin, direction, distanceToEntitiesBounds, boundsFace, boundsNormal) ||
+                 distanceToEntitiesBounds >= distance))) {
+            return false; // we don't intersect with these entities, but children might, so keep searching
+        }
+    }
+
     // if the distance to the element cube is not less than the current best distance, then it's not possible
     // for any details inside the cube to be closer so we don't need to consider them.
     if (_cube.contains(origin) || distanceToElementCube < distance) {
@@ -731,6 +805,13 @@ EntityItemPointer EntityTreeElement::getClosestEntity(glm::vec3 position) const
 
 // TODO: change this to use better bounding shape for entity than sphere
 void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searchRadius, QVector<EntityItemPointer>& foundEntities) const {
+    AABox entitiesBounds;
+    glm::vec3 boundsPenetration;
+    if (getEntitiesBounds(entitiesBounds) &&
+        (entitiesBounds.isInvalid() || !entitiesBounds.findSpherePenetration(searchPosition, searchRadius, boundsPenetration))) {
+        return;
+    }
+
     forEachEntity([&](EntityItemPointer entity) {
 
         bool success;
@@ -784,6 +865,11 @@ void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searc
 }
 
 void EntityTreeElement::getEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
+    AABox entitiesBounds;
+    if (getEntitiesBounds(entitiesBounds) && (entitiesBounds.isInvalid() || !entitiesBounds.touches(cube))) {
+        return;
+    }
+
     forEachEntity([&](EntityItemPointer entity) {
         bool success;
         AABox entityBox = entity->getAABox(success);
@@ -810,6 +896,11 @@ void EntityTreeElement::getEntities(const AACube& cube, QVector<EntityItemPointe
 }
 
 void EntityTreeElement::getEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
+    AABox entitiesBounds;
+    if (getEntitiesBounds(entitiesBounds) && (entitiesBounds.isInvalid() || !entitiesBounds.touches(box))) {
+        return;
+    }
+
     forEachEntity([&](EntityItemPointer entity) {
         bool success;
         AABox entityBox = entity->getAABox(success);
@@ -836,6 +927,12 @@ void EntityTreeElement::getEntities(const AABox& box, QVector<EntityItemPointer>
 }
 
 void EntityTreeElement::getEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities) {
+    AABox entitiesBounds;
+    if (getEntitiesBounds(entitiesBounds) && (entitiesBounds.isInvalid() ||
+            !(frustum.boxIntersectsFrustum(entitiesBounds) || frustum.boxIntersectsKeyhole(entitiesBounds)))) {
+        return;
+    }
+
     forEachEntity([&](EntityItemPointer entity) {
         bool success;
         AABox entityBox = entity->getAABox(success);
@@ -846,6 +943,35 @@ void EntityTreeElement::getEntities(const ViewFrustum& frustum, QVector<EntityIt
     });
 }
 
+bool EntityTreeElement::getEntitiesBounds(AABox& bounds) const {
+    std::lock_guard<std::mutex> lock(_entitiesBoundsMutex);
+
+    // clear the flag before looking at the entities, so that a change made while we do is picked up next time
+    if (_entitiesBoundsChanged.exchange(false)) {
+        AABox entitiesBounds;
+        bool entitiesBoundsKnown = true;
+        forEachEntity([&](EntityItemPointer entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (success) {
+                entitiesBounds += entityBox;
+            } else {
+                entitiesBoundsKnown = false;
+            }
+        });
+        _entitiesBounds = entitiesBounds;
+        _entitiesBoundsKnown = entitiesBoundsKnown;
+
+        if (!entitiesBoundsKnown) {
+            // an entity whose parent isn't known yet doesn't tell us when it is, so try again next time
+            _entitiesBoundsChanged = true;
+        }
+    }
+
+    bounds = _entitiesBounds;
+    return _entitiesBoundsKnown;
+}
+
 EntityItemPointer EntityTreeElement::getEntityWithEntityItemID(const EntityItemID& id) const {
     EntityItemPointer foundEntity = NULL;
     withReadLock([&] {
@@ -870,6 +996,7 @@ void EntityTreeElement::cleanupEntities() {
         }
         _entityItems.clear();
     });
+    entitiesBoundsChanged();
 }
 
 bool EntityTreeElement::removeEntityWithEntityItemID(const EntityItemID& id) {
@@ -882,6 +1009,7 @@ bool EntityTreeElement::removeEntityWithEntityItemID(const EntityItemID& id) {
                 foundEntity = true;
                 entity->_element = NULL;
                 _entityItems.removeAt(i);
+                entitiesBoundsChanged();
                 break;
             }
         }
@@ -897,6 +1025,7 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity) {
     if (numEntries > 0) {
         assert(entity->_element.get() == this);
         entity->_element = NULL;
+        entitiesBoundsChanged();
         return true;
     }
     return false;
@@ -1036,6 +1165,7 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
         _entityItems.push_back(entity);
     });
     entity->_element = getThisPointer();
+    entitiesBoundsChanged();
 }
 
 // will average a "common reduced LOD view" from the the child elements...
@@ -12,7 +12,9 @@
 #ifndef hifi_EntityTreeElement_h
 #define hifi_EntityTreeElement_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <OctreeElement.h>
 #include <QList>
@@ -81,6 +83,9 @@ class EntityTreeElement : public OctreeElement, ReadWriteLockable {
 
     EntityTreeElement(unsigned char* octalCode = NULL);
 
+    // the elements, and their shared pointers' control blocks, come from pools of their size
+    static EntityTreeElementPointer newElement(unsigned char* octalCode);
+
     virtual OctreeElementPointer createNewElement(unsigned char* octalCode = NULL) override;
 
 public:
@@ -199,6 +204,13 @@ public:
     /// \param entities[out] vector of non-const EntityItemPointer
     void getEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
 
+    /// the bounds of this element's own entities (not its children's), which the queries above and the ray intersection
+    /// test first so that they can skip all of the entities of an element when they miss all of them
+    /// \param bounds[out] the union of the entities' AABoxes, invalid if there are no entities
+    /// \return false if the bounds of some entity aren't known yet, in which case every entity has to be tested
+    bool getEntitiesBounds(AABox& bounds) const;
+    void entitiesBoundsChanged() { _entitiesBoundsChanged = true; } // an entity was added, removed, moved or resized
+
     EntityItemPointer getEntityWithID(uint32_t id) const;
     EntityItemPointer getEntityWithEntityItemID(const EntityItemID& id) const;
     void getEntitiesInside(const AACube& box, QVector<EntityItemPointer>& foundEntities);
@@ -242,6 +254,11 @@ protected:
     virtual void init(unsigned char * octalCode) override;
     EntityTreePointer _myTree;
     EntityItems _entityItems;
+
+    mutable std::mutex _entitiesBoundsMutex;
+    mutable std::atomic<bool> _entitiesBoundsChanged { true };
+    mutable AABox _entitiesBounds; // guarded by _entitiesBoundsMutex
+    mutable bool _entitiesBoundsKnown { false }; // guarded by _entitiesBoundsMutex
 };
 
 #endif // hifi_EntityTreeElement_h
@@ -41,6 +41,7 @@
 #include "ParticleEffectEntityItem.h"
 
 const float SCRIPT_MAXIMUM_PI = 3.1416f;  // Round up so that reasonable property values work
+const float MAX_PARTICLE_TIME = 1000.0f; // seconds, then the particles' emit times are counted afresh
 
 const xColor ParticleEffectEntityItem::DEFAULT_COLOR = { 255, 255, 255 };
 const xColor ParticleEffectEntityItem::DEFAULT_COLOR_SPREAD = { 0, 0, 0 };
@@ -591,29 +592,26 @@ void ParticleEffectEntityItem::setShapeType(ShapeType type) {
     }
 }
 
-void ParticleEffectEntityItem::integrateParticle(Particle& particle, float deltaTime) {
-    glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * particle.acceleration;
-    glm::vec3 at = particle.acceleration * deltaTime;
-    particle.position += particle.velocity * deltaTime + atSquared;
-    particle.velocity += at;
-}
-
 void ParticleEffectEntityItem::stepSimulation(float deltaTime) {
-    // update particles between head and tail
-    int popCount = 0;
-    for (Particle& particle : _particles) {
-        particle.lifetime += deltaTime;
-
-        // if particle has died.
-        if (particle.lifetime >= _lifespan) {
-            // move head forward
-            popCount++;
-        } else {
-            // Otherwise update it
-            integrateParticle(particle, deltaTime);
+    _particleTime += deltaTime;
+
+    // particles die in the order they were emitted, so move head forward past the dead ones
+    while (!_particles.empty() && _particleTime - _particles.front().emitTime >= _lifespan) {
+        _particles.pop_front();
+        _particlesChanged = true;
+    }
+
+    // count time from the oldest particle, so that it stays small
+    if (_particles.empty()) {
+        _particleTime = 0.0f;
+    } else if (_particleTime > MAX_PARTICLE_TIME) {
+        float oldestEmitTime = _particles.front().emitTime;
+        for (Particle& particle : _particles) {
+            particle.emitTime -= oldestEmitTime;
         }
+        _particleTime -= oldestEmitTime;
+        _particlesChanged = true;
     }
-    _particles.erase(_particles.begin(), _particles.begin() + popCount);
 
     // emit new particles, but only if we are emmitting
     if (getIsEmitting() && _emitRate > 0.0f && _lifespan > 0.0f && _polarStart <= _polarFinish) {
@@ -627,14 +625,11 @@ void ParticleEffectEntityItem::stepSimulation(float deltaTime) {
                 _particles.pop_front();
             }
             
-            // emit a new particle at tail index.
+            // emit a new particle at tail index, timeLeftInFrame before the end of this step.
             _particles.push_back(createParticle(glm::mix(_previousPosition, getPosition(),
                 (deltaTime - timeLeftInFrame) / deltaTime)));
-            auto particle = _particles.back();
-            particle.lifetime += timeLeftInFrame;
-            
-            // Initialize it
-            integrateParticle(particle, deltaTime);
+            _particles.back().emitTime = _particleTime - timeLeftInFrame;
+            _particlesChanged = true;
             
             // Advance in frame
             timeLeftInFrame -= _timeUntilNextEmit;
@@ -727,6 +722,7 @@ void ParticleEffectEntityItem::setMaxParticles(quint32 maxParticles) {
         // Pop all the overflowing oldest particles
         while (_particles.size() > _maxParticles) {
             _particles.pop_front();
+            _particlesChanged = true;
         }
 
         // effectively clear all particles and start emitting new ones from scratch.
@@ -229,18 +229,21 @@ protected:
     
     Particle createParticle(const glm::vec3& position);
     void stepSimulation(float deltaTime);
-    void integrateParticle(Particle& particle, float deltaTime);
     
+    // A particle's acceleration is constant, so where it is at any age follows from how it was emitted, and it
+    // is not integrated step by step; the renderer's vertex shader places it.
     struct Particle {
         float seed { 0.0f };
-        float lifetime { 0.0f };
-        glm::vec3 position { Vectors::ZERO };
-        glm::vec3 velocity { Vectors::ZERO };
+        float emitTime { 0.0f }; // _particleTime when it was emitted
+        glm::vec3 position { Vectors::ZERO }; // when it was emitted
+        glm::vec3 velocity { Vectors::ZERO }; // when it was emitted
         glm::vec3 acceleration { Vectors::ZERO };
     };
     
-    // Particles container
+    // Particles container, in the order they were emitted
     Particles _particles;
+    float _particleTime { 0.0f }; // seconds simulated, kept small for the shader's float arithmetic
+    bool _particlesChanged { true }; // particles emitted or expired since the renderer last uploaded them
     
     // Particles properties
     rgbColor _color;
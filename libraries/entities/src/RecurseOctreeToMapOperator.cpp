@@ -17,13 +17,15 @@ RecurseOctreeToMapOperator::RecurseOctreeToMapOperator(QVariantMap& map,
                                                        OctreeElementPointer top,
                                                        QScriptEngine* engine,
                                                        bool skipDefaultValues,
-                                                       bool skipThoseWithBadParents) :
+                                                       bool skipThoseWithBadParents,
+                                                       quint64 changedSince) :
         RecurseOctreeOperator(),
         _map(map),
         _top(top),
         _engine(engine),
         _skipDefaultValues(skipDefaultValues),
-        _skipThoseWithBadParents(skipThoseWithBadParents)
+        _skipThoseWithBadParents(skipThoseWithBadParents),
+        _changedSince(changedSince)
 {
     // if some element "top" was given, only save information for that element and its children.
     if (_top) {
@@ -52,6 +54,9 @@ bool RecurseOctreeToMapOperator::postRecursion(OctreeElementPointer element) {
         if (_skipThoseWithBadParents && !entityItem->isParentIDValid()) {
             return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
         }
+        if (entityItem->getLastChangedOnServer() < _changedSince) {
+            return;
+        }
 
         EntityItemProperties properties = entityItem->getProperties();
         QScriptValue qScriptValues;
@@ -14,7 +14,7 @@
 class RecurseOctreeToMapOperator : public RecurseOctreeOperator {
 public:
     RecurseOctreeToMapOperator(QVariantMap& map, OctreeElementPointer top, QScriptEngine* engine, bool skipDefaultValues,
-                               bool skipThoseWithBadParents);
+                               bool skipThoseWithBadParents, quint64 changedSince = 0);
     bool preRecursion(OctreeElementPointer element) override;
     bool postRecursion(OctreeElementPointer element) override;
  private:
@@ -24,4 +24,5 @@ public:
     bool _withinTop;
     bool _skipDefaultValues;
     bool _skipThoseWithBadParents;
+    quint64 _changedSince; // only entities last changed on the server since then
 };
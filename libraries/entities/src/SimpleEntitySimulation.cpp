@@ -11,6 +11,8 @@
 
 //#include <PerfStat.h>
 
+#include <tbb/parallel_for.h>
+
 #include "SimpleEntitySimulation.h"
 
 #include <DirtyOctreeElementOperator.h>
@@ -133,10 +135,38 @@ void SimpleEntitySimulation::clearEntitiesInternal() {
 }
 
 void SimpleEntitySimulation::sortEntitiesThatMoved() {
+    // An entity without children writes only its own query cube, so those are puffed in parallel for a large
+    // crowd.  The parents follow, one at a time, since they read their descendants' cubes.
+    auto& childlessEntities = _childlessEntitiesToSort;
+    childlessEntities.clear();
     SetOfEntities::iterator itemItr = _entitiesToSort.begin();
     while (itemItr != _entitiesToSort.end()) {
         EntityItemPointer entity = *itemItr;
-        entity->computePuffedQueryAACube();
+        if (!entity->hasChildren()) {
+            childlessEntities.push_back(entity);
+        }
+        ++itemItr;
+    }
+
+    const size_t ENTITIES_PER_TASK = 256;
+    auto puffEntities = [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); i++) {
+            childlessEntities[i]->computePuffedQueryAACube();
+        }
+    };
+    if (childlessEntities.size() > ENTITIES_PER_TASK) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, childlessEntities.size(), ENTITIES_PER_TASK), puffEntities);
+    } else {
+        puffEntities(tbb::blocked_range<size_t>(0, childlessEntities.size()));
+    }
+    childlessEntities.clear();
+
+    itemItr = _entitiesToSort.begin();
+    while (itemItr != _entitiesToSort.end()) {
+        EntityItemPointer entity = *itemItr;
+        if (entity->hasChildren()) {
+            entity->computePuffedQueryAACube();
+        }
         ++itemItr;
     }
     EntitySimulation::sortEntitiesThatMoved();
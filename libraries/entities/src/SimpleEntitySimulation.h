@@ -38,6 +38,7 @@ protected:
 
     SetOfEntities _entitiesWithSimulationOwner;
     SetOfEntities _entitiesThatNeedSimulationOwner;
+    VectorOfEntities _childlessEntitiesToSort; // reused by each sort
     quint64 _nextOwnerlessExpiry { 0 };
 };
 
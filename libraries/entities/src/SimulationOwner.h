@@ -33,6 +33,10 @@ const quint8 AVATAR_ENTITY_SIMULATION_PRIORITY = SCRIPT_GRAB_SIMULATION_PRIORITY
 // which really just means: things that collide with it will be bid at a priority level one lower
 const quint8 PERSONAL_SIMULATION_PRIORITY = SCRIPT_GRAB_SIMULATION_PRIORITY;
 
+// SERVER priority is the level at which the entity server owns the objects it simulates itself,
+// which no interface can outbid
+const quint8 SERVER_SIMULATION_PRIORITY = 0xff;
+
 
 class SimulationOwner {
 public:
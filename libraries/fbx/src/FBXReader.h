@@ -409,6 +409,8 @@ public:
     ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex);
     QHash<QString, ExtractedMesh> meshes;
     static void buildModelMesh(FBXMesh& extractedMesh, const QString& url);
+    // Simplify the parts of a mesh into coarser levels of detail
+    static void buildModelMeshLODs(const FBXMesh& extractedMesh, model::Mesh& mesh);
 
     FBXTexture getTexture(const QString& textureID);
 
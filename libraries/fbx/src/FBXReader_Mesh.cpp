@@ -20,6 +20,7 @@
 #include <QFileInfo>
 #include <QHash>
 #include <LogHandler.h>
+#include <MeshSimplifier.h>
 #include "ModelFormatLogging.h"
 
 #include "FBXReader.h"
@@ -388,6 +389,59 @@ ExtractedMesh FBXReader::extractMesh(const FBXNode& object, unsigned int& meshIn
     return data.extracted;
 }
 
+// Parts with fewer triangles aren't worth simplifying
+static const size_t MIN_LOD_TRIANGLES = 256;
+// The coarser levels of detail, each with at most half the triangles of the one before, and at most the error allowed,
+// relative to the size of the part: the models draw a level when its error is about a pixel on screen
+static const int NUM_LODS = 3;
+static const float LOD_MAX_ERRORS[NUM_LODS] = { 0.005f, 0.0125f, 0.03f };
+// A level simplified less than that from the one before isn't kept
+static const float MIN_LOD_REDUCTION = 0.75f;
+
+void FBXReader::buildModelMeshLODs(const FBXMesh& extractedMesh, model::Mesh& mesh) {
+    std::vector<uint32_t> lodIndices;
+    model::Mesh::PartLODs partLODs(extractedMesh.parts.size());
+    for (int partNum = 0; partNum < extractedMesh.parts.size(); partNum++) {
+        const FBXMeshPart& part = extractedMesh.parts.at(partNum);
+        std::vector<uint32_t> indices;
+        indices.reserve(part.quadTrianglesIndices.size() + part.triangleIndices.size());
+        indices.insert(indices.end(), part.quadTrianglesIndices.begin(), part.quadTrianglesIndices.end());
+        indices.insert(indices.end(), part.triangleIndices.begin(), part.triangleIndices.end());
+        size_t numTriangles = indices.size() / 3;
+        if (numTriangles < MIN_LOD_TRIANGLES) {
+            continue;
+        }
+
+        glm::vec3 minimum = extractedMesh.vertices.at(indices[0]);
+        glm::vec3 maximum = minimum;
+        for (auto index : indices) {
+            minimum = glm::min(minimum, extractedMesh.vertices.at(index));
+            maximum = glm::max(maximum, extractedMesh.vertices.at(index));
+        }
+        float partSize = glm::length(maximum - minimum);
+
+        MeshSimplifier simplifier(extractedMesh.vertices.constData(), (uint32_t)extractedMesh.vertices.size(), indices);
+        for (int lod = 0; lod < NUM_LODS; lod++) {
+            size_t numLODTriangles = simplifier.simplify(numTriangles / 2, LOD_MAX_ERRORS[lod] * partSize);
+            if ((float)numLODTriangles > MIN_LOD_REDUCTION * (float)numTriangles) {
+                break;
+            }
+            auto simplifiedIndices = simplifier.getIndices();
+            partLODs[partNum].emplace_back((model::Index)lodIndices.size(), (model::Index)simplifiedIndices.size(), 0, model::Mesh::TRIANGLES);
+            lodIndices.insert(lodIndices.end(), simplifiedIndices.begin(), simplifiedIndices.end());
+            numTriangles = numLODTriangles;
+            if (numTriangles < MIN_LOD_TRIANGLES) {
+                break;
+            }
+        }
+    }
+
+    if (!lodIndices.empty()) {
+        auto lodIndexBuffer = std::make_shared<gpu::Buffer>(lodIndices.size() * sizeof(uint32_t), (const gpu::Byte*) lodIndices.data());
+        mesh.setLODs(gpu::BufferView(lodIndexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ)), partLODs);
+    }
+}
+
 void FBXReader::buildModelMesh(FBXMesh& extractedMesh, const QString& url) {
     static QString repeatedMessage = LogHandler::getInstance().addRepeatedMessageRegex("buildModelMesh failed -- .*");
 
@@ -544,6 +598,8 @@ void FBXReader::buildModelMesh(FBXMesh& extractedMesh, const QString& url) {
         return;
     }
 
+    buildModelMeshLODs(extractedMesh, *mesh);
+
     // model::Box box =
     mesh->evalPartBound(0);
 
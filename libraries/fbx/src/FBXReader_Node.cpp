@@ -20,6 +20,9 @@
 #include <QtCore/QDebug>
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
+#include <QtCore/QSet>
+
+#include <zlib.h>
 
 #include <shared/NsightHelpers.h>
 #include "ModelFormatLogging.h"
@@ -32,6 +35,21 @@ template<bool> int streamSize() {
     return 1;
 }
 
+// Inflate the deflate encoded data of an array straight into its destination, which holds exactly the array
+static bool inflateArrayData(const char* compressed, quint32 compressedLength, char* destination, quint32 length) {
+    z_stream stream {};
+    stream.next_in = (Bytef*)compressed;
+    stream.avail_in = compressedLength;
+    stream.next_out = (Bytef*)destination;
+    stream.avail_out = length;
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+    int result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END && stream.total_out == length;
+}
+
 template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
     quint32 arrayLength;
     quint32 encoding;
@@ -44,28 +62,31 @@ template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
 
     QVector<T> values;
     if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
+        // the values are decoded in place in the vector, sized for them up front
         values.resize(arrayLength);
+        char* arrayData = reinterpret_cast<char*>(values.data());
+        quint32 arrayDataLength = sizeof(T) * arrayLength;
         const unsigned int DEFLATE_ENCODING = 1;
-        QByteArray arrayData;
         if (encoding == DEFLATE_ENCODING) {
-            // preface encoded data with uncompressed length
-            QByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
+            // a file read from memory is inflated from where it is, without copying the compressed data out
+            auto buffer = qobject_cast<QBuffer*>(in.device());
+            bool inflated = false;
+            if (buffer && buffer->pos() + compressedLength <= buffer->size()) {
+                const char* compressed = buffer->data().constData() + buffer->pos();
+                inflated = inflateArrayData(compressed, compressedLength, arrayData, arrayDataLength);
+                in.skipRawData(compressedLength);
+            } else {
+                QByteArray compressed(compressedLength, 0);
+                in.readRawData(compressed.data(), compressedLength);
+                inflated = inflateArrayData(compressed.constData(), compressedLength, arrayData, arrayDataLength);
+            }
             position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
+            if (!inflated) {
                 throw QString("corrupt fbx file");
             }
         } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
-
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
+            position += arrayDataLength;
+            in.readRawData(arrayData, arrayDataLength);
         }
     } else {
         values.reserve(arrayLength);
@@ -168,7 +189,9 @@ QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+// Parse a node and its children, or only its name when keptNames doesn't name it, skipping past its contents
+FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false,
+                           const QSet<QByteArray>* keptNames = nullptr) {
     qint64 endOffset;
     quint64 propertyCount;
     quint64 propertyListLength;
@@ -207,6 +230,12 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     node.name = in.device()->read(nameLength);
     position += nameLength;
 
+    if (keptNames && !keptNames->contains(node.name)) {
+        in.skipRawData(endOffset - position);
+        position = endOffset;
+        return node;
+    }
+
     for (quint32 i = 0; i < propertyCount; i++) {
         node.properties.append(parseBinaryFBXProperty(in, position));
     }
@@ -387,14 +416,15 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
     qCDebug(modelformat) << "fileVersion:" << fileVersion;
     bool has64BitPositions = (fileVersion >= VERSION_FBX2016);
 
-    // parse the top-level node
+    // parse the top-level nodes the geometry is extracted from, skipping the rest (takes, definitions...)
+    static const QSet<QByteArray> EXTRACTED_NODES { "FBXHeaderExtension", "GlobalSettings", "Objects", "Connections" };
     FBXNode top;
     while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions, &EXTRACTED_NODES);
         if (next.name.isNull()) {
             return top;
 
-        } else {
+        } else if (EXTRACTED_NODES.contains(next.name)) {
             top.children.append(next);
         }
     }
@@ -410,6 +440,7 @@ glm::vec3 FBXReader::getVec3(const QVariantList& properties, int index) {
 
 QVector<glm::vec4> FBXReader::createVec4Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -423,6 +454,7 @@ QVector<glm::vec4> FBXReader::createVec4Vector(const QVector<double>& doubleVect
 
 QVector<glm::vec4> FBXReader::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -440,6 +472,7 @@ QVector<glm::vec4> FBXReader::createVec4VectorRGBA(const QVector<double>& double
 
 QVector<glm::vec3> FBXReader::createVec3Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec3> values;
+    values.reserve(doubleVector.size() / 3);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -451,6 +484,7 @@ QVector<glm::vec3> FBXReader::createVec3Vector(const QVector<double>& doubleVect
 
 QVector<glm::vec2> FBXReader::createVec2Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec2> values;
+    values.reserve(doubleVector.size() / 2);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
         float s = *it++;
         float t = *it++;
@@ -138,7 +138,8 @@ GLuint compileProgram(const std::vector<GLuint>& glshaders) {
         return 0;
     }
 
-    // glProgramParameteri(glprogram, GL_PROGRAM_, GL_TRUE);
+    // so its binary can be cached
+    glProgramParameteri(glprogram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     // Create the program from the sub shaders
     for (auto so : glshaders) {
         glAttachShader(glprogram, so);
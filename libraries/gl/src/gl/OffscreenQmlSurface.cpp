@@ -8,6 +8,7 @@
 #include "OffscreenQmlSurface.h"
 #include "Config.h"
 
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -19,6 +20,7 @@
 #include <QtQuick/QQuickWindow>
 #include <QtQuick/QQuickRenderControl>
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QtCore/QMutex>
 #include <QtCore/QWaitCondition>
 
@@ -215,6 +217,50 @@ public:
 // This has the effect of capping the framerate at 200
 static const int MIN_TIMER_MS = 5;
 
+// All of the surfaces are updated from one timer, rather than each from its own, and a surface that has nothing new
+// to show, or whose last frame wasn't taken yet because it is off-screen, is passed over without any work
+class OffscreenQmlUpdater {
+public:
+    void add(OffscreenQmlSurface* surface) {
+        assert(QThread::currentThread() == qApp->thread());
+        if (std::find(_surfaces.begin(), _surfaces.end(), surface) != _surfaces.end()) {
+            return;
+        }
+        _surfaces.push_back(surface);
+
+        if (!_timer) {
+            _timer = new QTimer(qApp);
+            _timer->setTimerType(Qt::PreciseTimer);
+            _timer->setInterval(MIN_TIMER_MS); // 5ms, Qt::PreciseTimer required
+            QObject::connect(_timer, &QTimer::timeout, [this] { update(); });
+        }
+        if (!_timer->isActive()) {
+            _timer->start();
+        }
+    }
+
+    void remove(OffscreenQmlSurface* surface) {
+        assert(QThread::currentThread() == qApp->thread());
+        _surfaces.erase(std::remove(_surfaces.begin(), _surfaces.end(), surface), _surfaces.end());
+        if (_surfaces.empty() && _timer) {
+            _timer->stop();
+        }
+    }
+
+private:
+    void update() {
+        offscreenTextures.report();
+
+        // a surface may be removed while it is updated
+        for (size_t i = 0; i < _surfaces.size(); ++i) {
+            _surfaces[i]->updateQuick();
+        }
+    }
+
+    QTimer* _timer { nullptr };
+    std::vector<OffscreenQmlSurface*> _surfaces;
+} offscreenUpdater;
+
 class QMyQuickRenderControl : public QQuickRenderControl {
 protected:
     QWindow* renderWindow(QPoint* offset) Q_DECL_OVERRIDE{
@@ -350,7 +396,7 @@ OffscreenQmlSurface::OffscreenQmlSurface() {
 }
 
 OffscreenQmlSurface::~OffscreenQmlSurface() {
-    QObject::disconnect(&_updateTimer);
+    offscreenUpdater.remove(this);
     QObject::disconnect(qApp);
 
     cleanup();
@@ -364,7 +410,7 @@ OffscreenQmlSurface::~OffscreenQmlSurface() {
 
 void OffscreenQmlSurface::onAboutToQuit() {
     _paused = true;
-    QObject::disconnect(&_updateTimer);
+    offscreenUpdater.remove(this);
 }
 
 void OffscreenQmlSurface::create(QOpenGLContext* shareContext) {
@@ -423,12 +469,9 @@ void OffscreenQmlSurface::create(QOpenGLContext* shareContext) {
     _renderControl->initialize(_canvas->getContext());
 
     // When Quick says there is a need to render, we will not render immediately. Instead,
-    // a timer with a small interval is used to get better performance.
-    QObject::connect(&_updateTimer, &QTimer::timeout, this, &OffscreenQmlSurface::updateQuick);
+    // a timer with a small interval, shared by all of the surfaces, is used to get better performance.
     QObject::connect(qApp, &QCoreApplication::aboutToQuit, this, &OffscreenQmlSurface::onAboutToQuit);
-    _updateTimer.setTimerType(Qt::PreciseTimer);
-    _updateTimer.setInterval(MIN_TIMER_MS); // 5ms, Qt::PreciseTimer required
-    _updateTimer.start();
+    offscreenUpdater.add(this);
 
     auto rootContext = getRootContext();
     rootContext->setContextProperty("urlHandler", new UrlHandler());
@@ -615,12 +658,14 @@ QObject* OffscreenQmlSurface::finishQmlLoad(std::function<void(QQmlContext*, QOb
 }
 
 void OffscreenQmlSurface::updateQuick() {
-    offscreenTextures.report();
     // If we're
-    //   a) not set up
-    //   b) already rendering a frame
+    //   a) paused or unchanged since the last frame
+    //   b) already rendering a frame, or the last one wasn't taken
     //   c) rendering too fast
     // then skip this
+    if (_paused || !(_render || _polish)) {
+        return;
+    }
     if (!allowNewFrame(_maxFps)) {
         return;
     }
@@ -746,6 +791,12 @@ bool OffscreenQmlSurface::eventFilter(QObject* originalDestination, QEvent* even
 
 void OffscreenQmlSurface::pause() {
     _paused = true;
+
+    // The last frame won't be taken while paused, let another surface of the same size have its texture
+    if (_latestTextureAndFence.first) {
+        offscreenTextures.releaseTexture(_latestTextureAndFence);
+        _latestTextureAndFence = { 0, 0 };
+    }
 }
 
 void OffscreenQmlSurface::resume() {
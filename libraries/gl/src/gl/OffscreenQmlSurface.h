@@ -23,6 +23,7 @@
 
 class QWindow;
 class QMyQuickRenderControl;
+class OffscreenQmlUpdater;
 class OffscreenGLCanvas;
 class QOpenGLContext;
 class QQmlEngine;
@@ -122,12 +123,12 @@ private:
     QPointF mapWindowToUi(const QPointF& sourcePosition, QObject* sourceObject);
     void setupFbo();
     bool allowNewFrame(uint8_t fps);
+    void updateQuick();
     void render();
     void cleanup();
     QJsonObject getGLContextData();
 
 private slots:
-    void updateQuick();
     void onFocusObjectChanged(QObject* newFocus);
 
 private:
@@ -139,7 +140,6 @@ private:
     OffscreenGLCanvas* _canvas { nullptr };
     QJsonObject _glData;
 
-    QTimer _updateTimer;
     uint32_t _fbo { 0 };
     uint32_t _depthStencil { 0 };
     uint64_t _lastRenderTime { 0 };
@@ -157,6 +157,8 @@ private:
     QWindow* _proxyWindow { nullptr };
 
     QQuickItem* _currentFocusItem { nullptr };
+
+    friend class OffscreenQmlUpdater;
 };
 
 #endif
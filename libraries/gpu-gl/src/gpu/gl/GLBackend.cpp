@@ -26,10 +26,14 @@
 #include <shared/GlobalAppProperties.h>
 #include <GPUIdent.h>
 #include <gl/QOpenGLContextWrapper.h>
+#include <QtCore/QCoreApplication>
 #include <QtCore/QProcessEnvironment>
+#include <QtCore/QThread>
+#include <QtGui/QOpenGLContext>
 
 #include "GLTexture.h"
 #include "GLShader.h"
+#include "GLProgramCompiler.h"
 
 using namespace gpu;
 using namespace gpu::gl;
@@ -76,6 +80,27 @@ bool GLBackend::makeProgram(Shader& shader, const Shader::BindingSet& slotBindin
     return GLShader::makeProgram(getBackend(), shader, slotBindings);
 }
 
+void GLBackend::makeProgramAsync(const ShaderPointer& shader, const Shader::BindingSet& slotBindings,
+                                 const Shader::MakeProgramCallback& callback) {
+    auto& backend = getBackend();
+    {
+        Lock lock(backend._programCompilerMutex);
+        if (!backend._programCompiler) {
+            // The compiler's context shares the objects of the global share context, and its surface can only be
+            // made on the main thread; anywhere else, the program is made at once
+            QOpenGLContext* shareContext = QOpenGLContext::globalShareContext();
+            if (shareContext && QThread::currentThread() == QCoreApplication::instance()->thread()) {
+                backend._programCompiler.reset(new GLProgramCompiler(backend.shared_from_this(), shareContext));
+            }
+        }
+        if (backend._programCompiler) {
+            backend._programCompiler->queueProgram(shader, slotBindings, callback);
+            return;
+        }
+    }
+    callback(makeProgram(*shader, slotBindings));
+}
+
 GLBackend::CommandCall GLBackend::_commandCalls[Batch::NUM_COMMANDS] = 
 {
     (&::gpu::gl::GLBackend::do_draw),
@@ -185,6 +210,7 @@ GLBackend::GLBackend() {
 
 
 GLBackend::~GLBackend() {
+    _programCompiler.reset();
     resetStages();
 
     killInput();
@@ -622,6 +648,7 @@ void GLBackend::queueLambda(const std::function<void()> lambda) const {
 
 void GLBackend::recycle() const {
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__)
+    GLTexture::nextFrame();
     {
         std::list<std::function<void()>> lamdbasTrash;
         {
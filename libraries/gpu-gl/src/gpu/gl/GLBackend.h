@@ -54,6 +54,8 @@
 
 namespace gpu { namespace gl {
 
+class GLProgramCompiler;
+
 class GLBackend : public Backend, public std::enable_shared_from_this<GLBackend> {
     // Context Backend static interface required
     friend class gpu::Context;
@@ -65,6 +67,8 @@ protected:
     GLBackend();
 public:
     static bool makeProgram(Shader& shader, const Shader::BindingSet& slotBindings = Shader::BindingSet());
+    static void makeProgramAsync(const ShaderPointer& shader, const Shader::BindingSet& slotBindings,
+                                 const Shader::MakeProgramCallback& callback);
 
     ~GLBackend();
 
@@ -82,6 +86,10 @@ public:
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer,
                                      const Vec4i& region, QImage& destImage) final override;
 
+    // The same into a pixel pack buffer, behind a fence, for the caller to read frames later
+    virtual FramebufferReadbackPointer startFramebufferReadback(const FramebufferPointer& srcFramebuffer,
+                                                                const Vec4i& region) final override;
+
 
     // this is the maximum numeber of available input buffers
     size_t getNumInputBuffers() const { return _input._invalidBuffers.size(); }
@@ -219,6 +227,10 @@ protected:
 
     std::list<std::string> profileRanges;
     mutable Mutex _trashMutex;
+
+    // Made by the first makeProgramAsync on the app's main thread
+    Mutex _programCompilerMutex;
+    std::unique_ptr<GLProgramCompiler> _programCompiler;
     mutable std::list<std::pair<GLuint, Size>> _buffersTrash;
     mutable std::list<std::pair<GLuint, Size>> _texturesTrash;
     mutable std::list<std::pair<GLuint, Texture::ExternalRecycler>> _externalTexturesTrash;
@@ -322,6 +334,10 @@ protected:
         GLuint _cameraBuffer { 0 };
         GLuint _drawCallInfoBuffer { 0 };
         GLuint _objectBufferTexture { 0 };
+        // Where the transfer put the batch's cameras and draw call infos, if not at the start of the buffers above
+        mutable GLuint _cameraTransferBuffer { 0 };
+        mutable size_t _cameraTransferOffset { 0 };
+        mutable GLuint _drawCallInfoTransferBuffer { 0 };
         size_t _cameraUboSize { 0 };
         bool _viewIsCamera{ false };
         bool _skybox { false };
@@ -352,6 +368,9 @@ protected:
 
     struct UniformStageState {
         std::array<BufferPointer, MAX_NUM_UNIFORM_BUFFERS> _buffers;
+        // the ranges bound, as several slots can be bound to ranges of one buffer (see BufferHeap)
+        std::array<Offset, MAX_NUM_UNIFORM_BUFFERS> _offsets;
+        std::array<Offset, MAX_NUM_UNIFORM_BUFFERS> _sizes;
         //Buffers _buffers {  };
     } _uniform;
 
@@ -163,3 +163,95 @@ void GLBackend::downloadFramebuffer(const FramebufferPointer& srcFramebuffer, co
 
     (void) CHECK_GL_ERROR();
 }
+
+class GLFramebufferReadback : public FramebufferReadback {
+public:
+    GLFramebufferReadback(const std::weak_ptr<GLBackend>& backend, const Vec4i& region) : _backend(backend), _region(region) {
+        glGenBuffers(1, &_buffer);
+    }
+
+    ~GLFramebufferReadback() {
+        // The buffer and the fence go on the thread executing the batches
+        auto backend = _backend.lock();
+        if (backend) {
+            GLuint buffer = _buffer;
+            GLsync fence = _fence;
+            backend->queueLambda([buffer, fence] {
+                glDeleteBuffers(1, &buffer);
+                if (fence) {
+                    glDeleteSync(fence);
+                }
+            });
+        }
+    }
+
+    void start(GLuint readFBO) {
+        GLsizeiptr size = (GLsizeiptr)_region.z * _region.w * 4;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
+        glReadPixels(_region.x, _region.y, _region.z, _region.w, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        _fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        (void) CHECK_GL_ERROR();
+    }
+
+    bool isReady() override {
+        if (!_fence) {
+            return _ready;
+        }
+        GLenum result = glClientWaitSync(_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            glDeleteSync(_fence);
+            _fence = nullptr;
+            _ready = true;
+        }
+        return _ready;
+    }
+
+    bool read(QImage& destImage) override {
+        if (!isReady()) {
+            return false;
+        }
+        if ((destImage.width() < _region.z) || (destImage.height() < _region.w) || (destImage.format() != QImage::Format_ARGB32)) {
+            qCWarning(gpugllogging) << "GLFramebufferReadback::read : destImage must be FORMAT_ARGB32 and at least the size of the region";
+            return false;
+        }
+
+        int rowSize = _region.z * 4;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _buffer);
+        auto pixels = (const uchar*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)rowSize * _region.w, GL_MAP_READ_BIT);
+        if (pixels) {
+            for (int y = 0; y < _region.w; y++) {
+                memcpy(destImage.scanLine(y), pixels + y * rowSize, rowSize);
+            }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        (void) CHECK_GL_ERROR();
+        return pixels != nullptr;
+    }
+
+private:
+    const std::weak_ptr<GLBackend> _backend;
+    const Vec4i _region;
+    GLuint _buffer { 0 };
+    GLsync _fence { nullptr };
+    bool _ready { false };
+};
+
+FramebufferReadbackPointer GLBackend::startFramebufferReadback(const FramebufferPointer& srcFramebuffer, const Vec4i& region) {
+    auto readFBO = getFramebufferID(srcFramebuffer);
+    if (!srcFramebuffer || !readFBO || region.z <= 0 || region.w <= 0) {
+        return FramebufferReadbackPointer();
+    }
+    if ((srcFramebuffer->getWidth() < (region.x + region.z)) || (srcFramebuffer->getHeight() < (region.y + region.w))) {
+        qCWarning(gpugllogging) << "GLBackend::startFramebufferReadback : srcFramebuffer is too small to provide the region queried";
+        return FramebufferReadbackPointer();
+    }
+
+    auto readback = std::make_shared<GLFramebufferReadback>(shared_from_this(), region);
+    readback->start(readFBO);
+    return readback;
+}
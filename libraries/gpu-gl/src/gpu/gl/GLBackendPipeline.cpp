@@ -103,7 +103,7 @@ void GLBackend::updatePipeline() {
             _pipeline._stateSignatureCache |= _pipeline._state->_signature;
 
             // And perform
-            for (auto command: _pipeline._state->_commands) {
+            for (const auto& command : _pipeline._state->_commands) {
                 command->run(this);
             }
         } else {
@@ -159,7 +159,8 @@ void GLBackend::do_setUniformBuffer(const Batch& batch, size_t paramOffset) {
     }
     
     // check cache before thinking
-    if (_uniform._buffers[slot] == uniformBuffer) {
+    if (_uniform._buffers[slot] == uniformBuffer && _uniform._offsets[slot] == (Offset)rangeStart &&
+            _uniform._sizes[slot] == (Offset)rangeSize) {
         return;
     }
 
@@ -169,6 +170,8 @@ void GLBackend::do_setUniformBuffer(const Batch& batch, size_t paramOffset) {
         glBindBufferRange(GL_UNIFORM_BUFFER, slot, object->_buffer, rangeStart, rangeSize);
 
         _uniform._buffers[slot] = uniformBuffer;
+        _uniform._offsets[slot] = rangeStart;
+        _uniform._sizes[slot] = rangeSize;
         (void) CHECK_GL_ERROR();
     } else {
         releaseUniformBuffer(slot);
@@ -224,6 +227,7 @@ void GLBackend::do_setResourceTexture(const Batch& batch, size_t paramOffset) {
         GLuint target = object->_target;
         glActiveTexture(GL_TEXTURE0 + slot);
         glBindTexture(target, to);
+        object->markUsed();
 
         (void) CHECK_GL_ERROR();
 
@@ -8,6 +8,8 @@
 //  Distributed under the Apache License, Version 2.0.
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
+#include <chrono>
+
 #include "GLBackend.h"
 #include "GLQuery.h"
 #include "GLShared.h"
@@ -24,6 +26,12 @@ const uint32_t MAX_RANGE_QUERY_DEPTH = 10000;
 static bool timeElapsed = false;
 #endif
 
+// The batch elapsed time is taken on the CPU clock: reading GL_TIMESTAMP synchronizes with the driver, and with the
+// engine timing every job, it would be done twice per job
+static GLuint64 batchTimestamp() {
+    return (GLuint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void GLBackend::do_beginQuery(const Batch& batch, size_t paramOffset) {
     auto query = batch._queries.get(batch._params[paramOffset]._uint);
     GLQuery* glquery = syncGPUObject(*query);
@@ -31,7 +39,7 @@ void GLBackend::do_beginQuery(const Batch& batch, size_t paramOffset) {
         PROFILE_RANGE_BEGIN(render_gpu_gl_detail, glquery->_profileRangeId, query->getName().c_str(), 0xFFFF7F00);
 
         ++_queryStage._rangeQueryDepth;
-        glGetInteger64v(GL_TIMESTAMP, (GLint64*)&glquery->_batchElapsedTime);
+        glquery->_batchElapsedTime = batchTimestamp();
 
         if (timeElapsed) {
             if (_queryStage._rangeQueryDepth <= MAX_RANGE_QUERY_DEPTH) {
@@ -58,9 +66,7 @@ void GLBackend::do_endQuery(const Batch& batch, size_t paramOffset) {
         }
 
         --_queryStage._rangeQueryDepth;
-        GLint64 now;
-        glGetInteger64v(GL_TIMESTAMP, &now);
-        glquery->_batchElapsedTime = now - glquery->_batchElapsedTime;
+        glquery->_batchElapsedTime = batchTimestamp() - glquery->_batchElapsedTime;
 
         PROFILE_RANGE_END(render_gpu_gl_detail, glquery->_profileRangeId);
 
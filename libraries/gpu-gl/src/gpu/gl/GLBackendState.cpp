@@ -28,20 +28,7 @@ void GLBackend::resetPipelineState(State::Signature nextSignature) {
             }
         }
     }
-
-    // force a few states regardless
-    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
-
-    // Point size is always on
-    // FIXME CORE
-    //glHint(GL_POINT_SMOOTH_HINT, GL_NICEST);
-    glEnable(GL_PROGRAM_POINT_SIZE_EXT);
-    glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
-
-    // Default line width accross the board
-    glLineWidth(1.0f);
-    glEnable(GL_LINE_SMOOTH);
-
+    // The states forced regardless are set once in syncPipelineStateCache: nothing else changes them
 }
 
 void GLBackend::syncPipelineStateCache() {
@@ -161,7 +161,8 @@ void GLBackend::TransformStageState::update(size_t commandIndex, const StereoSta
 
 void GLBackend::TransformStageState::bindCurrentCamera(int eye) const {
     if (_currentCameraOffset != INVALID_OFFSET) {
-        glBindBufferRange(GL_UNIFORM_BUFFER, TRANSFORM_CAMERA_SLOT, _cameraBuffer, _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
+        GLuint cameraBuffer = _cameraTransferBuffer ? _cameraTransferBuffer : _cameraBuffer;
+        glBindBufferRange(GL_UNIFORM_BUFFER, TRANSFORM_CAMERA_SLOT, cameraBuffer, _cameraTransferOffset + _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
     }
 }
 
@@ -0,0 +1,84 @@
+//
+//  Created by High Fidelity on 2017/10/02
+//  Copyright 2013-2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "GLProgramCompiler.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QSurface>
+
+#include "GLBackend.h"
+#include "GLShader.h"
+
+using namespace gpu;
+using namespace gpu::gl;
+
+GLProgramCompiler::GLProgramCompiler(const std::weak_ptr<GLBackend>& backend, QOpenGLContext* shareContext) :
+    _backend(backend)
+{
+    setObjectName("GL Program Compiler");
+
+    // Creating the canvas releases the context current on this thread, so it's restored after
+    QOpenGLContext* currentContext = QOpenGLContext::currentContext();
+    QSurface* currentSurface = currentContext ? currentContext->surface() : nullptr;
+    _canvas.create(shareContext);
+    _canvas.moveToThreadWithContext(this);
+    if (currentContext) {
+        currentContext->makeCurrent(currentSurface);
+    }
+
+    start(QThread::LowPriority);
+}
+
+GLProgramCompiler::~GLProgramCompiler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _hasRequests.notify_one();
+    wait();
+}
+
+void GLProgramCompiler::queueProgram(const ShaderPointer& shader, const Shader::BindingSet& bindings,
+                                     const Shader::MakeProgramCallback& callback) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _requests.push_back({ shader, bindings, callback });
+    }
+    _hasRequests.notify_one();
+}
+
+void GLProgramCompiler::run() {
+    _canvas.makeCurrent();
+
+    while (true) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _hasRequests.wait(lock, [this] { return _stopped || !_requests.empty(); });
+            if (_stopped) {
+                break;
+            }
+            request = std::move(_requests.front());
+            _requests.pop_front();
+        }
+
+        // the backend is only gone during its destruction, when nothing's drawn with the program anyway
+        auto backend = _backend.lock();
+        bool made = backend && GLShader::makeProgram(*backend, *request.shader, request.bindings);
+        if (backend && !made) {
+            qCWarning(gpugllogging) << "GLProgramCompiler::run - Failed to make a program";
+        }
+        // the rendering context sees the program once this context's commands are done
+        clientWait();
+        request.callback(made);
+    }
+
+    _canvas.doneCurrent();
+    // The context is destroyed with the canvas, on the thread that made it
+    _canvas.moveToThreadWithContext(QCoreApplication::instance()->thread());
+}
@@ -0,0 +1,56 @@
+//
+//  Created by High Fidelity on 2017/10/02
+//  Copyright 2013-2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_gl_GLProgramCompiler_h
+#define hifi_gpu_gl_GLProgramCompiler_h
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QThread>
+
+#include <gl/OffscreenGLCanvas.h>
+
+#include "GLShared.h"
+
+namespace gpu { namespace gl {
+
+// The thread the programs of GLBackend::makeProgramAsync are made on
+//   Its context shares the objects of the rendering one, so a program it links is drawn with as soon as the
+//   callback is called (it waits on a fence for the driver to finish it first). It's made on the app's main
+//   thread, where the offscreen surface of its context has to be created.
+class GLProgramCompiler : public QThread {
+public:
+    GLProgramCompiler(const std::weak_ptr<GLBackend>& backend, QOpenGLContext* shareContext);
+    ~GLProgramCompiler();
+
+    void queueProgram(const ShaderPointer& shader, const Shader::BindingSet& bindings, const Shader::MakeProgramCallback& callback);
+
+protected:
+    void run() override;
+
+private:
+    struct Request {
+        ShaderPointer shader;
+        Shader::BindingSet bindings;
+        Shader::MakeProgramCallback callback;
+    };
+
+    std::weak_ptr<GLBackend> _backend;
+    OffscreenGLCanvas _canvas;
+
+    std::mutex _mutex;
+    std::condition_variable _hasRequests;
+    std::deque<Request> _requests;
+    bool _stopped { false };
+};
+
+} }
+
+#endif
@@ -8,6 +8,15 @@
 #include "GLShader.h"
 #include <gl/GLShaders.h>
 
+#include <mutex>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <PathUtils.h>
+
 #include "GLBackend.h"
 
 using namespace gpu;
@@ -102,6 +111,68 @@ GLShader* compileBackendShader(GLBackend& backend, const Shader& shader) {
     return object;
 }
 
+// The binaries of the programs linked before, under the app's local data directory, by the hash of their sources
+// and of the driver: a program found there is loaded without compiling its shaders or linking it
+static QString getProgramBinaryPath(const Shader& program, int version) {
+    static const QString SHADER_CACHE_DIRECTORY = PathUtils::getAppLocalDataPath() + "shaders/";
+    static const QByteArray DRIVER = QByteArray((const char*)glGetString(GL_VENDOR)) + "/" +
+        QByteArray((const char*)glGetString(GL_RENDERER)) + "/" + QByteArray((const char*)glGetString(GL_VERSION));
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(DRIVER);
+    for (auto subShader : program.getShaders()) {
+        std::string defines = glslVersion + "\n" + DOMAIN_DEFINES[subShader->getType()] + "\n" + VERSION_DEFINES[version];
+        const std::string& source = subShader->getSource().getCode();
+        hash.addData(defines.data(), (int)defines.size());
+        hash.addData(source.data(), (int)source.size());
+    }
+    return SHADER_CACHE_DIRECTORY + hash.result().toHex() + ".bin";
+}
+
+static GLuint loadProgramBinary(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    QByteArray contents = file.readAll();
+    file.close();
+    if (contents.size() <= (int)sizeof(GLenum)) {
+        return 0;
+    }
+    GLenum format;
+    memcpy(&format, contents.constData(), sizeof(GLenum));
+
+    GLuint glprogram = glCreateProgram();
+    glProgramBinary(glprogram, format, contents.constData() + sizeof(GLenum), contents.size() - (int)sizeof(GLenum));
+    GLint linked = 0;
+    glGetProgramiv(glprogram, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // stale, most probably from another driver version: it'll be compiled and saved again
+        glDeleteProgram(glprogram);
+        QFile::remove(path);
+        return 0;
+    }
+    return glprogram;
+}
+
+static void saveProgramBinary(const QString& path, GLuint glprogram) {
+    GLint length = 0;
+    glGetProgramiv(glprogram, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    QByteArray contents(sizeof(GLenum) + length, 0);
+    GLenum format = 0;
+    glGetProgramBinary(glprogram, length, nullptr, &format, contents.data() + sizeof(GLenum));
+    memcpy(contents.data(), &format, sizeof(GLenum));
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(contents);
+    }
+}
+
 GLShader* compileBackendProgram(GLBackend& backend, const Shader& program) {
     if (!program.isProgram()) {
         return nullptr;
@@ -112,6 +183,14 @@ GLShader* compileBackendProgram(GLBackend& backend, const Shader& program) {
     for (int version = 0; version < GLShader::NumVersions; version++) {
         auto& programObject = programObjects[version];
 
+        QString binaryPath = getProgramBinaryPath(program, version);
+        GLuint cachedProgram = loadProgramBinary(binaryPath);
+        if (cachedProgram) {
+            programObject.glprogram = cachedProgram;
+            makeProgramBlockBindings(programObject);
+            continue;
+        }
+
         // Let's go through every shaders and make sure they are ready to go
         std::vector< GLuint > shaderGLObjects;
         for (auto subShader : program.getShaders()) {
@@ -132,6 +211,7 @@ GLShader* compileBackendProgram(GLBackend& backend, const Shader& program) {
         programObject.glprogram = glprogram;
 
         makeProgramBindings(programObject);
+        saveProgramBinary(binaryPath, glprogram);
     }
 
     // So far so good, the program versions have all been created successfully
@@ -141,24 +221,37 @@ GLShader* compileBackendProgram(GLBackend& backend, const Shader& program) {
     return object;
 }
 
+// The GPU objects of the shaders are made on the render thread and on the program compiler's, which share the
+// sub shaders: they're only looked up and set under this lock, the compiling is done outside of it.
+static std::mutex shaderObjectsMutex;
+
 GLShader* GLShader::sync(GLBackend& backend, const Shader& shader) {
-    GLShader* object = Backend::getGPUObject<GLShader>(shader);
+    {
+        std::lock_guard<std::mutex> lock(shaderObjectsMutex);
+        GLShader* object = Backend::getGPUObject<GLShader>(shader);
 
-    // If GPU object already created then good
-    if (object) {
-        return object;
+        // If GPU object already created then good
+        if (object) {
+            return object;
+        }
     }
+
     // need to have a gpu object?
+    GLShader* object = nullptr;
     if (shader.isProgram()) {
-        GLShader* tempObject = compileBackendProgram(backend, shader);
-        if (tempObject) {
-            object = tempObject;
-            Backend::setGPUObject(shader, object);
-        }
+        object = compileBackendProgram(backend, shader);
     } else if (shader.isDomain()) {
-        GLShader* tempObject = compileBackendShader(backend, shader);
-        if (tempObject) {
-            object = tempObject;
+        object = compileBackendShader(backend, shader);
+    }
+
+    if (object) {
+        std::lock_guard<std::mutex> lock(shaderObjectsMutex);
+        GLShader* madeObject = Backend::getGPUObject<GLShader>(shader);
+        if (madeObject) {
+            // the other thread made it meanwhile
+            delete object;
+            object = madeObject;
+        } else {
             Backend::setGPUObject(shader, object);
         }
     }
@@ -757,6 +757,12 @@ void makeProgramBindings(ShaderObject& shaderObject) {
     }
 
     // now assign the ubo binding, then DON't relink!
+    makeProgramBlockBindings(shaderObject);
+}
+
+void makeProgramBlockBindings(ShaderObject& shaderObject) {
+    GLuint glprogram = shaderObject.glprogram;
+    GLint loc = -1;
 
     //Check for gpu specific uniform slotBindings
 #ifdef GPU_SSBO_DRAW_CALL_INFO
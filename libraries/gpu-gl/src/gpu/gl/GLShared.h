@@ -47,6 +47,8 @@ int makeUniformBlockSlots(GLuint glprogram, const Shader::BindingSet& slotBindin
 int makeInputSlots(GLuint glprogram, const Shader::BindingSet& slotBindings, Shader::SlotSet& inputs);
 int makeOutputSlots(GLuint glprogram, const Shader::BindingSet& slotBindings, Shader::SlotSet& outputs);
 void makeProgramBindings(ShaderObject& shaderObject);
+// The bindings that aren't linked in the program, for a program loaded from its binary
+void makeProgramBlockBindings(ShaderObject& shaderObject);
 
 enum GLSyncState {
     // The object is currently undergoing no processing, although it's content
@@ -224,15 +224,21 @@ GLenum GLTexelFormat::evalGLTexelFormatInternal(const gpu::Element& dstFormat) {
                     result = GL_COMPRESSED_SRGB_ALPHA;
                     break;
 
-                    // FIXME: WE will want to support this later
-                    /*
-                    case gpu::COMPRESSED_BC3_RGBA:
+                case gpu::COMPRESSED_BC1_RGB:
+                    result = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                    break;
+                case gpu::COMPRESSED_BC1_SRGB:
+                    result = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+                    break;
+                case gpu::COMPRESSED_BC3_RGBA:
                     result = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
                     break;
-                    case gpu::COMPRESSED_BC3_SRGBA:
+                case gpu::COMPRESSED_BC3_SRGBA:
                     result = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
                     break;
 
+                    // FIXME: WE will want to support this later
+                    /*
                     case gpu::COMPRESSED_BC7_RGBA:
                     result = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
                     break;
@@ -367,15 +373,21 @@ GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const E
 
                 break;
 
-                // FIXME: WE will want to support this later
-                /*
-                case gpu::COMPRESSED_BC3_RGBA:
+            case gpu::COMPRESSED_BC1_RGB:
+                texel.internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                break;
+            case gpu::COMPRESSED_BC1_SRGB:
+                texel.internalFormat = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+                break;
+            case gpu::COMPRESSED_BC3_RGBA:
                 texel.internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
                 break;
-                case gpu::COMPRESSED_BC3_SRGBA:
+            case gpu::COMPRESSED_BC3_SRGBA:
                 texel.internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
                 break;
 
+                // FIXME: WE will want to support this later
+                /*
                 case gpu::COMPRESSED_BC7_RGBA:
                 texel.internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
                 break;
@@ -652,6 +664,20 @@ GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const E
             case gpu::COMPRESSED_SRGBA:
                 texel.internalFormat = GL_COMPRESSED_SRGB_ALPHA;
                 break;
+
+            // The mips are stored compressed, they upload as they are
+            case gpu::COMPRESSED_BC1_RGB:
+                texel.internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                break;
+            case gpu::COMPRESSED_BC1_SRGB:
+                texel.internalFormat = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+                break;
+            case gpu::COMPRESSED_BC3_RGBA:
+                texel.internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                break;
+            case gpu::COMPRESSED_BC3_SRGBA:
+                texel.internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+                break;
             default:
                 qCWarning(gpugllogging) << "Unknown combination of texel format";
             }
@@ -42,11 +42,22 @@ public:
     static const GLFilterMode FILTER_MODES[Sampler::NUM_FILTERS];
     static const GLenum WRAP_MODES[Sampler::NUM_WRAP_MODES];
 
+    // How many frames ago the texture was last bound for drawing, for the memory management to demote what isn't
+    // in use first and promote what is first
+    static void nextFrame() { ++_currentFrame; }
+    void markUsed() const { _lastUsedFrame = _currentFrame; }
+    uint32_t getFramesSinceUse() const { return _currentFrame - _lastUsedFrame; }
+
 protected:
     virtual uint32 size() const = 0;
     virtual void generateMips() const = 0;
 
     GLTexture(const std::weak_ptr<gl::GLBackend>& backend, const Texture& texture, GLuint id);
+
+private:
+    static uint32_t _currentFrame;
+    // a texture counts as used the frame it's made, so that a new one isn't the first demoted
+    mutable uint32_t _lastUsedFrame { _currentFrame };
 };
 
 class GLExternalTexture : public GLTexture {
@@ -83,7 +83,13 @@ GL41Texture::GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture&
                     auto mip = _gpuObject.accessStoredMipFace(mipLevel, face);
                     mipData = mip->readData();
                 }
-                glTexImage2D(target, mipLevel, texelFormat.internalFormat, dimensions.x, dimensions.y, 0, texelFormat.format, texelFormat.type, mipData);
+                if (_gpuObject.getStoredMipFormat().isBlockCompressed()) {
+                    // The compressed mips upload as they are stored
+                    GLsizei mipSize = _gpuObject.getStoredMipFormat().evalTexelsSize(dimensions.x, dimensions.y);
+                    glCompressedTexImage2D(target, mipLevel, texelFormat.internalFormat, dimensions.x, dimensions.y, 0, mipSize, mipData);
+                } else {
+                    glTexImage2D(target, mipLevel, texelFormat.internalFormat, dimensions.x, dimensions.y, 0, texelFormat.format, texelFormat.type, mipData);
+                }
                 (void)CHECK_GL_ERROR();
                 ++face;
             }
@@ -18,6 +18,13 @@ Q_LOGGING_CATEGORY(gpugl45logging, "hifi.gpu.gl45")
 using namespace gpu;
 using namespace gpu::gl45;
 
+GL45Backend::~GL45Backend() {
+    // the base class releases the rest of the transform stage
+    _cameraRing.release();
+    _objectRing.release();
+    _drawCallInfoRing.release();
+}
+
 void GL45Backend::recycle() const {
     Parent::recycle();
     GL45VariableAllocationTexture::manageMemory();
@@ -32,6 +32,7 @@ class GL45Backend : public GLBackend {
 public:
     explicit GL45Backend(bool syncCache) : Parent(syncCache) {}
     GL45Backend() : Parent() {}
+    ~GL45Backend();
 
     class GL45Texture : public GLTexture {
         using Parent = GLTexture;
@@ -113,7 +114,11 @@ public:
             std::vector<uint8_t> _buffer;
             // Indicates if a transfer from backing storage to interal storage has started
             bool _bufferingStarted { false };
-            bool _bufferingCompleted { false };
+            std::atomic<bool> _bufferingCompleted { false };
+            // Where the contents are buffered instead of _buffer, if the staging buffer had room: the transfer
+            // then sources them from the staging buffer, at _stagingOffset
+            GLubyte* _stagingData { nullptr };
+            size_t _stagingOffset { 0 };
             VoidLambda _transferLambda;
             VoidLambda _bufferingLambda;
 #if THREADED_TEXTURE_BUFFERING
@@ -142,6 +147,7 @@ public:
             void startBuffering();
 #endif
             void transfer();
+            void releaseStaging();
         };
 
         using TransferQueue = std::queue<std::unique_ptr<TransferJob>>;
@@ -171,7 +177,7 @@ public:
         //bool canPromoteNoAllocate() const { return _allocatedMip < _populatedMip; }
         bool canPromote() const { return _allocatedMip > 0; }
         bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
-        bool hasPendingTransfers() const { return _populatedMip > _allocatedMip; }
+        bool hasPendingTransfers() const { return _populatedMip > _allocatedMip && _gpuObject.isStoredMipFaceAvailable(_populatedMip - 1); }
         void executeNextTransfer(const TexturePointer& currentTexture);
         uint32 size() const override { return _size; }
         virtual void populateTransferQueue() = 0;
@@ -277,6 +283,39 @@ protected:
     void initTransform() override;
     void updateTransform(const Batch& batch) override;
 
+    // A persistently mapped, coherent buffer the transform stage writes each batch's data in, one after the other,
+    // rather than respecifying a buffer with each batch. It's cut in segments, and a segment isn't written again
+    // before the fence put in the command stream when moving on from it is signaled.
+    class RingBuffer {
+    public:
+        static const uint32_t NUM_SEGMENTS { 3 };
+
+        void init(size_t segmentSize, size_t alignment);
+        void release();
+
+        // Where to write size bytes, at offset in the buffer; the segments grow if it's more than one holds
+        GLubyte* reserve(size_t size, size_t& offset);
+        GLuint getBuffer() const { return _buffer; }
+
+    private:
+        void allocate(size_t segmentSize);
+        void nextSegment();
+
+        GLuint _buffer { 0 };
+        GLubyte* _mapped { nullptr };
+        size_t _segmentSize { 0 };
+        size_t _alignment { 1 };
+        uint32_t _segment { 0 };
+        size_t _used { 0 };
+        GLsync _fences[NUM_SEGMENTS] { 0, 0, 0 };
+    };
+
+    mutable RingBuffer _cameraRing;
+    mutable RingBuffer _objectRing;
+    mutable RingBuffer _drawCallInfoRing;
+    mutable size_t _objectTransferOffset { 0 };
+    mutable size_t _objectTransferSize { 0 };
+
     // Output stage
     void do_blit(const Batch& batch, size_t paramOffset) override;
 
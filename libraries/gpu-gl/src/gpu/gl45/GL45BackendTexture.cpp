@@ -119,6 +119,27 @@ void GL45Texture::generateMips() const {
 }
 
 void GL45Texture::copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum format, GLenum type, const void* sourcePointer) const {
+    const auto& mipFormat = _gpuObject.getStoredMipFormat();
+    if (mipFormat.isBlockCompressed()) {
+        // The lines are whole rows of blocks, uploaded as they are stored
+        GLenum internalFormat = GLTexelFormat::evalGLTexelFormat(_gpuObject.getTexelFormat(), mipFormat).internalFormat;
+        GLsizei imageSize = mipFormat.evalTexelsSize(size.x, size.y);
+        if (GL_TEXTURE_2D == _target) {
+            glCompressedTextureSubImage2D(_id, mip, 0, yOffset, size.x, size.y, internalFormat, imageSize, sourcePointer);
+        } else if (GL_TEXTURE_CUBE_MAP == _target) {
+            if (glCompressedTextureSubImage2DEXT) {
+                auto target = GLTexture::CUBE_FACE_LAYOUT[face];
+                glCompressedTextureSubImage2DEXT(_id, target, mip, 0, yOffset, size.x, size.y, internalFormat, imageSize, sourcePointer);
+            } else {
+                glCompressedTextureSubImage3D(_id, mip, 0, yOffset, face, size.x, size.y, 1, internalFormat, imageSize, sourcePointer);
+            }
+        } else {
+            Q_ASSERT(false);
+        }
+        (void)CHECK_GL_ERROR();
+        return;
+    }
+
     if (GL_TEXTURE_2D == _target) {
         glTextureSubImage2D(_id, mip, 0, yOffset, size.x, size.y, format, type, sourcePointer);
     } else if (GL_TEXTURE_CUBE_MAP == _target) {
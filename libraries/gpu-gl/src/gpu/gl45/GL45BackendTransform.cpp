@@ -13,6 +13,84 @@
 using namespace gpu;
 using namespace gpu::gl45;
 
+// The segments' first sizes; they grow if a batch needs more
+static const size_t CAMERA_SEGMENT_SIZE { 256 * 1024 };
+static const size_t OBJECT_SEGMENT_SIZE { 2 * 1024 * 1024 };
+static const size_t DRAW_CALL_INFO_SEGMENT_SIZE { 256 * 1024 };
+static const GLbitfield RING_BUFFER_FLAGS { GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+static const GLuint64 FENCE_WAIT_NSECS { 1000 * 1000 };
+
+void GL45Backend::RingBuffer::init(size_t segmentSize, size_t alignment) {
+    _alignment = std::max<size_t>(alignment, 1);
+    allocate(segmentSize);
+}
+
+void GL45Backend::RingBuffer::release() {
+    for (auto& fence : _fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+    if (_buffer) {
+        // the GL keeps the storage for the commands still using it
+        glUnmapNamedBuffer(_buffer);
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+    }
+    _mapped = nullptr;
+    _segment = 0;
+    _used = 0;
+}
+
+void GL45Backend::RingBuffer::allocate(size_t segmentSize) {
+    release();
+    _segmentSize = segmentSize;
+    const size_t bufferSize = _segmentSize * NUM_SEGMENTS;
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, bufferSize, nullptr, RING_BUFFER_FLAGS);
+    _mapped = (GLubyte*)glMapNamedBufferRange(_buffer, 0, bufferSize, RING_BUFFER_FLAGS);
+    (void)CHECK_GL_ERROR();
+}
+
+void GL45Backend::RingBuffer::nextSegment() {
+    // the commands reading this segment are all in the stream by now
+    _fences[_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _segment = (_segment + 1) % NUM_SEGMENTS;
+    _used = 0;
+
+    GLsync& fence = _fences[_segment];
+    if (fence) {
+        // it was left NUM_SEGMENTS - 1 segments ago, so this hardly ever waits
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (result == GL_TIMEOUT_EXPIRED) {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_NSECS);
+        }
+        glDeleteSync(fence);
+        fence = 0;
+    }
+}
+
+GLubyte* GL45Backend::RingBuffer::reserve(size_t size, size_t& offset) {
+    if (size > _segmentSize) {
+        size_t segmentSize = _segmentSize;
+        while (segmentSize < size) {
+            segmentSize *= 2;
+        }
+        qCDebug(gpugl45logging) << "Transform ring buffer segments grow from" << _segmentSize << "to" << segmentSize << "bytes";
+        allocate(segmentSize);
+    }
+
+    size_t start = ((_used + _alignment - 1) / _alignment) * _alignment;
+    if (start + size > _segmentSize) {
+        nextSegment();
+        start = 0;
+    }
+    _used = start + size;
+    offset = _segment * _segmentSize + start;
+    return _mapped + offset;
+}
+
 void GL45Backend::initTransform() {
     GLuint transformBuffers[3];
     glCreateBuffers(3, transformBuffers);
@@ -24,41 +102,69 @@ void GL45Backend::initTransform() {
     while (_transform._cameraUboSize < cameraSize) {
         _transform._cameraUboSize += _uboAlignment;
     }
+
+    GLint objectAlignment { 1 };
+#ifdef GPU_SSBO_DRAW_CALL_INFO
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &objectAlignment);
+#else
+    glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &objectAlignment);
+#endif
+    _cameraRing.init(CAMERA_SEGMENT_SIZE, _uboAlignment);
+    _objectRing.init(OBJECT_SEGMENT_SIZE, objectAlignment);
+    _drawCallInfoRing.init(DRAW_CALL_INFO_SEGMENT_SIZE, sizeof(Batch::DrawCallInfo));
 }
 
 void GL45Backend::transferTransformState(const Batch& batch) const {
-    // FIXME not thread safe
-    static std::vector<uint8_t> bufferData;
+    size_t offset { 0 };
+
     if (!_transform._cameras.empty()) {
-        bufferData.resize(_transform._cameraUboSize * _transform._cameras.size());
+        GLubyte* cameras = _cameraRing.reserve(_transform._cameraUboSize * _transform._cameras.size(), offset);
         for (size_t i = 0; i < _transform._cameras.size(); ++i) {
-            memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+            memcpy(cameras + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
         }
-        glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        _transform._cameraTransferBuffer = _cameraRing.getBuffer();
+        _transform._cameraTransferOffset = offset;
     }
 
     if (!batch._objects.empty()) {
-        glNamedBufferData(_transform._objectBuffer, batch._objects.size() * sizeof(Batch::TransformObject), batch._objects.data(), GL_STREAM_DRAW);
+        size_t objectsSize = batch._objects.size() * sizeof(Batch::TransformObject);
+        memcpy(_objectRing.reserve(objectsSize, offset), batch._objects.data(), objectsSize);
+        _objectTransferOffset = offset;
+        _objectTransferSize = objectsSize;
     }
 
     if (!batch._namedData.empty()) {
-        bufferData.clear();
+        size_t drawCallInfosSize { 0 };
+        for (auto& data : batch._namedData) {
+            drawCallInfosSize += data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+        }
+        GLubyte* drawCallInfos = _drawCallInfoRing.reserve(drawCallInfosSize, offset);
         for (auto& data : batch._namedData) {
-            auto currentSize = bufferData.size();
             auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
-            bufferData.resize(currentSize + bytesToCopy);
-            memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
-            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
+            memcpy(drawCallInfos, data.second.drawCallInfos.data(), bytesToCopy);
+            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)offset;
+            drawCallInfos += bytesToCopy;
+            offset += bytesToCopy;
         }
-        glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        _transform._drawCallInfoTransferBuffer = _drawCallInfoRing.getBuffer();
     }
 
+    // Until the first objects are transferred, the empty object buffer stands in for them
+    GLuint objectBuffer = _objectTransferSize ? _objectRing.getBuffer() : _transform._objectBuffer;
 #ifdef GPU_SSBO_DRAW_CALL_INFO
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, _transform._objectBuffer);
+    if (_objectTransferSize) {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, objectBuffer, _objectTransferOffset, _objectTransferSize);
+    } else {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, objectBuffer);
+    }
 #else
     glActiveTexture(GL_TEXTURE0 + TRANSFORM_OBJECT_SLOT);
     glBindTexture(GL_TEXTURE_BUFFER, _transform._objectBufferTexture);
-    glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    if (_objectTransferSize) {
+        glTextureBufferRange(_transform._objectBufferTexture, GL_RGBA32F, objectBuffer, _objectTransferOffset, _objectTransferSize);
+    } else {
+        glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, objectBuffer);
+    }
 #endif
 
     CHECK_GL_ERROR();
@@ -94,7 +200,7 @@ void GL45Backend::updateTransform(const Batch& batch) {
         // NOTE: A stride of zero in BindVertexBuffer signifies that all elements are sourced from the same location,
         //       so we must provide a stride.
         //       This is in contrast to VertexAttrib*Pointer, where a zero signifies tightly-packed elements.
-        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transform._drawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
+        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transform._drawCallInfoTransferBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
     }
 
     (void)CHECK_GL_ERROR();
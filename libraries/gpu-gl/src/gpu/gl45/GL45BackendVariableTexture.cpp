@@ -13,6 +13,7 @@
 #include <mutex>
 #include <algorithm>
 #include <condition_variable>
+#include <deque>
 #include <unordered_set>
 #include <unordered_map>
 #include <glm/gtx/component_wise.hpp>
@@ -52,6 +53,107 @@ using TransferJob = GL45VariableAllocationTexture::TransferJob;
 static const uvec3 MAX_TRANSFER_DIMENSIONS { 1024, 1024, 1 };
 static const size_t MAX_TRANSFER_SIZE = MAX_TRANSFER_DIMENSIONS.x * MAX_TRANSFER_DIMENSIONS.y * 4;
 
+// A persistently mapped pixel unpack buffer the mips are buffered into, so the glTextureSubImage calls of the
+// transfers source them from memory the GPU reads asynchronously, rather than client memory the driver must copy
+// within the call. Its regions are handed out in order, and reused once the fence put after their transfer is
+// signaled. Only the GL thread calls it; the buffering thread only writes the regions it was handed.
+class TransferStagingBuffer {
+public:
+    static const size_t SIZE { 32 * 1024 * 1024 }; // room for eight of the biggest transfers
+    static const size_t ALIGNMENT { 256 };
+
+    // false if there's no room, for now
+    bool allocate(size_t size, size_t& offset, GLubyte*& data);
+    // with the fence after the transfer reading it, or none if it never was
+    void release(size_t offset, GLsync fence);
+    GLuint getBuffer() const { return _buffer; }
+
+private:
+    void reclaim();
+
+    struct Region {
+        size_t offset;
+        size_t size;
+        GLsync fence;
+        bool released;
+    };
+    std::deque<Region> _regions; // oldest first
+    GLuint _buffer { 0 };
+    GLubyte* _mapped { nullptr };
+    size_t _head { 0 };
+};
+
+bool TransferStagingBuffer::allocate(size_t size, size_t& offset, GLubyte*& data) {
+    if (size > SIZE) {
+        return false;
+    }
+    if (!_buffer) {
+        static const GLbitfield FLAGS { GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+        glCreateBuffers(1, &_buffer);
+        glNamedBufferStorage(_buffer, SIZE, nullptr, FLAGS);
+        _mapped = (GLubyte*)glMapNamedBufferRange(_buffer, 0, SIZE, FLAGS);
+        if (!_mapped) {
+            qCWarning(gpugl45logging) << "Failed to map the texture transfer staging buffer";
+            glDeleteBuffers(1, &_buffer);
+            _buffer = 0;
+            return false;
+        }
+    }
+
+    reclaim();
+    size_t start;
+    if (_regions.empty()) {
+        start = 0;
+    } else {
+        size_t tail = _regions.front().offset;
+        bool wrapped = _regions.back().offset < tail;
+        if (wrapped) {
+            if (_head + size > tail) {
+                return false;
+            }
+            start = _head;
+        } else if (_head + size <= SIZE) {
+            start = _head;
+        } else if (size <= tail) {
+            start = 0;
+        } else {
+            return false;
+        }
+    }
+
+    _regions.push_back({ start, size, 0, false });
+    _head = ((start + size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+    offset = start;
+    data = _mapped + start;
+    return true;
+}
+
+void TransferStagingBuffer::release(size_t offset, GLsync fence) {
+    for (auto& region : _regions) {
+        if (region.offset == offset && !region.released) {
+            region.fence = fence;
+            region.released = true;
+            return;
+        }
+    }
+}
+
+void TransferStagingBuffer::reclaim() {
+    while (!_regions.empty() && _regions.front().released) {
+        auto& region = _regions.front();
+        if (region.fence) {
+            GLenum result = glClientWaitSync(region.fence, 0, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+                break;
+            }
+            glDeleteSync(region.fence);
+        }
+        _regions.pop_front();
+    }
+}
+
+static TransferStagingBuffer transferStagingBuffer;
+
 #if THREADED_TEXTURE_BUFFERING
 std::shared_ptr<std::thread> TransferJob::_bufferThread { nullptr };
 std::atomic<bool> TransferJob::_shutdownBufferingThread { false };
@@ -93,21 +195,37 @@ TransferJob::TransferJob(const GL45VariableAllocationTexture& parent, uint16_t s
     if (0 == lines) {
         _transferSize = mipData->getSize();
         _bufferingLambda = [=] {
-            _buffer.resize(_transferSize);
-            memcpy(&_buffer[0], mipData->readData(), _transferSize);
+            GLubyte* destination = _stagingData;
+            if (!destination) {
+                _buffer.resize(_transferSize);
+                destination = _buffer.data();
+            }
+            memcpy(destination, mipData->readData(), _transferSize);
             _bufferingCompleted = true;
         };
 
     } else {
         transferDimensions.y = lines;
         auto dimensions = _parent._gpuObject.evalMipDimensions(sourceMip);
-        auto mipSize = mipData->getSize();
-        auto bytesPerLine = (uint32_t)mipSize / dimensions.y;
-        _transferSize = bytesPerLine * lines;
-        auto sourceOffset = bytesPerLine * lineOffset;
+        const auto& mipFormat = _parent._gpuObject.getStoredMipFormat();
+        uint32_t sourceOffset;
+        if (mipFormat.isBlockCompressed()) {
+            // the lines and their offset are whole rows of blocks
+            _transferSize = mipFormat.evalTexelsSize(dimensions.x, lines);
+            sourceOffset = mipFormat.evalTexelsSize(dimensions.x, lineOffset);
+        } else {
+            auto mipSize = mipData->getSize();
+            auto bytesPerLine = (uint32_t)mipSize / dimensions.y;
+            _transferSize = bytesPerLine * lines;
+            sourceOffset = bytesPerLine * lineOffset;
+        }
         _bufferingLambda = [=] {
-            _buffer.resize(_transferSize);
-            memcpy(&_buffer[0], mipData->readData() + sourceOffset, _transferSize);
+            GLubyte* destination = _stagingData;
+            if (!destination) {
+                _buffer.resize(_transferSize);
+                destination = _buffer.data();
+            }
+            memcpy(destination, mipData->readData() + sourceOffset, _transferSize);
             _bufferingCompleted = true;
         };
     }
@@ -115,7 +233,15 @@ TransferJob::TransferJob(const GL45VariableAllocationTexture& parent, uint16_t s
     Backend::updateTextureTransferPendingSize(0, _transferSize);
 
     _transferLambda = [=] {
-        _parent.copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, format, type, _buffer.data());
+        if (_stagingData) {
+            // with a pixel unpack buffer bound, the source pointer is an offset in it
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, transferStagingBuffer.getBuffer());
+            _parent.copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, format, type, (const void*)_stagingOffset);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            releaseStaging();
+        } else {
+            _parent.copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, format, type, _buffer.data());
+        }
         std::vector<uint8_t> emptyVector;
         _buffer.swap(emptyVector);
     };
@@ -126,9 +252,19 @@ TransferJob::TransferJob(const GL45VariableAllocationTexture& parent, std::funct
 }
 
 TransferJob::~TransferJob() {
+    releaseStaging();
     Backend::updateTextureTransferPendingSize(_transferSize, 0);
 }
 
+void TransferJob::releaseStaging() {
+    if (!_stagingData) {
+        return;
+    }
+    // once the transfer, or whatever is in the stream if it never was, has read it
+    transferStagingBuffer.release(_stagingOffset, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    _stagingData = nullptr;
+}
+
 
 bool TransferJob::tryTransfer() {
     // Disable threaded texture transfer for now
@@ -143,6 +279,9 @@ bool TransferJob::tryTransfer() {
     return false;
 #else
     if (!_bufferingCompleted) {
+        if (_bufferingLambda) {
+            transferStagingBuffer.allocate(_transferSize, _stagingOffset, _stagingData);
+        }
         _bufferingLambda();
         _bufferingCompleted = true;
     }
@@ -158,6 +297,10 @@ void TransferJob::startBuffering() {
         return;
     }
     _bufferingStarted = true;
+    // buffer straight into the staging buffer if it has room, else into _buffer
+    if (!transferStagingBuffer.allocate(_transferSize, _stagingOffset, _stagingData)) {
+        _stagingData = nullptr;
+    }
     {
         Lock lock(_mutex);
         _bufferLambdaQueue.push(_bufferingLambda);
@@ -193,25 +336,27 @@ void GL45VariableAllocationTexture::addMemoryManagedTexture(const TexturePointer
 
 void GL45VariableAllocationTexture::addToWorkQueue(const TexturePointer& texturePointer) {
     GL45VariableAllocationTexture* object = Backend::getGPUObject<GL45VariableAllocationTexture>(*texturePointer);
+    // What was drawn recently is demoted last, and promoted and transferred first
+    float staleness = 1.0f + (float)object->getFramesSinceUse();
     switch (_memoryPressureState) {
         case MemoryPressureState::Oversubscribed:
             if (object->canDemote()) {
-                // Demote largest first
-                _demoteQueue.push({ texturePointer, (float)object->size() });
+                // Demote the largest of the least used first
+                _demoteQueue.push({ texturePointer, staleness * (float)object->size() });
             }
             break;
 
         case MemoryPressureState::Undersubscribed:
             if (object->canPromote()) {
-                // Promote smallest first
-                _promoteQueue.push({ texturePointer, 1.0f / (float)object->size() });
+                // Promote the smallest of the most used first
+                _promoteQueue.push({ texturePointer, 1.0f / (staleness * (float)object->size()) });
             }
             break;
 
         case MemoryPressureState::Transfer:
             if (object->hasPendingTransfers()) {
-                // Transfer priority given to smaller mips first
-                _transferQueue.push({ texturePointer, 1.0f / (float)object->_gpuObject.evalMipSize(object->_populatedMip) });
+                // Transfer priority given to smaller mips of the most used first
+                _transferQueue.push({ texturePointer, 1.0f / (staleness * (float)object->_gpuObject.evalMipSize(object->_populatedMip)) });
             }
             break;
 
@@ -276,6 +421,14 @@ void GL45VariableAllocationTexture::updateMemoryPressure() {
         lastAllowedMemoryAllocation = allowedMemoryAllocation;
     }
 
+    // Mips streamed into any texture may have transfers to resume
+    static Stamp lastStreamedMipsStamp = gpu::Texture::getStreamedMipsStamp();
+    Stamp streamedMipsStamp = gpu::Texture::getStreamedMipsStamp();
+    if (streamedMipsStamp != lastStreamedMipsStamp) {
+        _memoryPressureStateStale = true;
+        lastStreamedMipsStamp = streamedMipsStamp;
+    }
+
     if (!_memoryPressureStateStale.exchange(false)) {
         return;
     }
@@ -571,10 +724,17 @@ void GL45ResourceTexture::populateTransferQueue() {
         --sourceMip;
         auto targetMip = sourceMip - _allocatedMip;
         auto mipDimensions = _gpuObject.evalMipDimensions(sourceMip);
+
+        // Mips still streaming in stop the transfers, until they arrive and the queue is populated again
+        bool isMipAvailable = true;
+        for (uint8_t face = 0; face < maxFace; ++face) {
+            isMipAvailable &= _gpuObject.isStoredMipFaceAvailable(sourceMip, face);
+        }
+        if (!isMipAvailable) {
+            break;
+        }
+
         for (uint8_t face = 0; face < maxFace; ++face) {
-            if (!_gpuObject.isStoredMipFaceAvailable(sourceMip, face)) {
-                continue;
-            }
 
             // If the mip is less than the max transfer size, then just do it in one transfer
             if (glm::all(glm::lessThanEqual(mipDimensions, MAX_TRANSFER_DIMENSIONS))) {
@@ -587,9 +747,17 @@ void GL45ResourceTexture::populateTransferQueue() {
             // consuming more than X bandwidth
             auto mipData = _gpuObject.accessStoredMipFace(sourceMip, face);
             const auto lines = mipDimensions.y;
-            auto bytesPerLine = (uint32_t)mipData->getSize() / lines;
-            Q_ASSERT(0 == (mipData->getSize() % lines));
-            uint32_t linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerLine);
+            const auto& mipFormat = _gpuObject.getStoredMipFormat();
+            uint32_t linesPerTransfer;
+            if (mipFormat.isBlockCompressed()) {
+                // Compressed mips are transferred by whole rows of blocks
+                auto bytesPerBlockRow = mipFormat.evalTexelsSize(mipDimensions.x, Element::BLOCK_DIMENSION);
+                linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerBlockRow) * Element::BLOCK_DIMENSION;
+            } else {
+                auto bytesPerLine = (uint32_t)mipData->getSize() / lines;
+                Q_ASSERT(0 == (mipData->getSize() % lines));
+                linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerLine);
+            }
             uint32_t lineOffset = 0;
             while (lineOffset < lines) {
                 uint32_t linesToCopy = std::min<uint32_t>(lines - lineOffset, linesPerTransfer);
@@ -30,12 +30,12 @@ ProfileRangeBatch::~ProfileRangeBatch() {
 
 using namespace gpu;
 
-size_t Batch::_commandsMax { BATCH_PREALLOCATE_MIN };
-size_t Batch::_commandOffsetsMax { BATCH_PREALLOCATE_MIN };
-size_t Batch::_paramsMax { BATCH_PREALLOCATE_MIN };
-size_t Batch::_dataMax { BATCH_PREALLOCATE_MIN };
-size_t Batch::_objectsMax { BATCH_PREALLOCATE_MIN };
-size_t Batch::_drawCallInfosMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_commandsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_commandOffsetsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_paramsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_dataMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_objectsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_drawCallInfosMax { BATCH_PREALLOCATE_MIN };
 
 Batch::Batch() {
     _commands.reserve(_commandsMax);
@@ -71,24 +71,30 @@ Batch::Batch(const Batch& batch_) {
     _namedData.swap(batch._namedData);
     _enableStereo = batch._enableStereo;
     _enableSkybox = batch._enableSkybox;
+    _boundTextures = batch._boundTextures;
+    _boundUniformBuffers = batch._boundUniformBuffers;
+    _boundTexturesMask = batch._boundTexturesMask;
+    _boundUniformBuffersMask = batch._boundUniformBuffersMask;
+    batch._boundTexturesMask = 0;
+    batch._boundUniformBuffersMask = 0;
 }
 
 Batch::~Batch() {
-    _commandsMax = std::max(_commands.size(), _commandsMax);
-    _commandOffsetsMax = std::max(_commandOffsets.size(), _commandOffsetsMax);
-    _paramsMax = std::max(_params.size(), _paramsMax);
-    _dataMax = std::max(_data.size(), _dataMax);
-    _objectsMax = std::max(_objects.size(), _objectsMax);
-    _drawCallInfosMax = std::max(_drawCallInfos.size(), _drawCallInfosMax);
+    updateMax(_commandsMax, _commands.size());
+    updateMax(_commandOffsetsMax, _commandOffsets.size());
+    updateMax(_paramsMax, _params.size());
+    updateMax(_dataMax, _data.size());
+    updateMax(_objectsMax, _objects.size());
+    updateMax(_drawCallInfosMax, _drawCallInfos.size());
 }
 
 void Batch::clear() {
-    _commandsMax = std::max(_commands.size(), _commandsMax);
-    _commandOffsetsMax = std::max(_commandOffsets.size(), _commandOffsetsMax);
-    _paramsMax = std::max(_params.size(), _paramsMax);
-    _dataMax = std::max(_data.size(), _dataMax);
-    _objectsMax = std::max(_objects.size(), _objectsMax);
-    _drawCallInfosMax = std::max(_drawCallInfos.size(), _drawCallInfosMax);
+    updateMax(_commandsMax, _commands.size());
+    updateMax(_commandOffsetsMax, _commandOffsets.size());
+    updateMax(_paramsMax, _params.size());
+    updateMax(_dataMax, _data.size());
+    updateMax(_objectsMax, _objects.size());
+    updateMax(_drawCallInfosMax, _drawCallInfos.size());
 
     _commands.clear();
     _commandOffsets.clear();
@@ -102,6 +108,8 @@ void Batch::clear() {
     _framebuffers.clear();
     _objects.clear();
     _drawCallInfos.clear();
+    _boundTexturesMask = 0;
+    _boundUniformBuffersMask = 0;
 }
 
 size_t Batch::cacheData(size_t size, const void* data) {
@@ -280,6 +288,18 @@ void Batch::setStateScissorRect(const Vec4i& rect) {
 }
 
 void Batch::setUniformBuffer(uint32 slot, const BufferPointer& buffer, Offset offset, Offset size) {
+    if (slot < NUM_TRACKED_SLOTS) {
+        auto& bound = _boundUniformBuffers[slot];
+        uint32 slotBit = 1 << slot;
+        if ((_boundUniformBuffersMask & slotBit) && bound.buffer == buffer.get() && bound.offset == offset && bound.size == size) {
+            return;
+        }
+        _boundUniformBuffersMask |= slotBit;
+        bound.buffer = buffer.get();
+        bound.offset = offset;
+        bound.size = size;
+    }
+
     ADD_COMMAND(setUniformBuffer);
 
     _params.emplace_back(size);
@@ -293,6 +313,15 @@ void Batch::setUniformBuffer(uint32 slot, const BufferView& view) {
 }
 
 void Batch::setResourceTexture(uint32 slot, const TexturePointer& texture) {
+    if (slot < NUM_TRACKED_SLOTS) {
+        uint32 slotBit = 1 << slot;
+        if ((_boundTexturesMask & slotBit) && _boundTextures[slot] == texture.get()) {
+            return;
+        }
+        _boundTexturesMask |= slotBit;
+        _boundTextures[slot] = texture.get();
+    }
+
     ADD_COMMAND(setResourceTexture);
     _params.emplace_back(_textures.cache(texture));
     _params.emplace_back(slot);
@@ -380,10 +409,15 @@ void Batch::getQuery(const QueryPointer& query) {
 
 void Batch::resetStages() {
     ADD_COMMAND(resetStages);
+    _boundTexturesMask = 0;
+    _boundUniformBuffersMask = 0;
 }
 
 void Batch::runLambda(std::function<void()> f) {
     ADD_COMMAND(runLambda);
+    // it may bind anything
+    _boundTexturesMask = 0;
+    _boundUniformBuffersMask = 0;
     _params.emplace_back(_lambdas.cache(f));
 }
 
@@ -416,13 +450,14 @@ bool Batch::isSkyboxEnabled() const {
     return _enableSkybox;
 }
 
-void Batch::setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function) {
+Batch::NamedBatchData& Batch::setupNamedCalls(const std::string& instanceName, const NamedBatchData::Function& function) {
     NamedBatchData& instance = _namedData[instanceName];
     if (!instance.function) {
         instance.function = function;
     }
 
-    captureNamedDrawCallInfo(instanceName);
+    captureDrawCallInfoImpl(instance.drawCallInfos);
+    return instance;
 }
 
 BufferPointer Batch::getNamedBuffer(const std::string& instanceName, uint8_t index) {
@@ -455,6 +490,10 @@ const Batch::DrawCallInfoBuffer& Batch::getDrawCallInfoBuffer() const {
 }
 
 void Batch::captureDrawCallInfoImpl() {
+    captureDrawCallInfoImpl(getDrawCallInfoBuffer());
+}
+
+void Batch::captureDrawCallInfoImpl(DrawCallInfoBuffer& drawCallInfos) {
     if (_invalidModel) {
         TransformObject object;
         _currentModel.getMatrix(object._model);
@@ -471,7 +510,6 @@ void Batch::captureDrawCallInfoImpl() {
         _invalidModel = false;
     }
 
-    auto& drawCallInfos = getDrawCallInfoBuffer();
     drawCallInfos.emplace_back((uint16)_objects.size() - 1);
 }
 
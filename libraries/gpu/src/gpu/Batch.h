@@ -11,6 +11,8 @@
 #ifndef hifi_gpu_Batch_h
 #define hifi_gpu_Batch_h
 
+#include <array>
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include <functional>
@@ -87,7 +89,7 @@ public:
     using NamedBatchDataMap = std::map<std::string, NamedBatchData>;
 
     DrawCallInfoBuffer _drawCallInfos;
-    static size_t _drawCallInfosMax;
+    static std::atomic<size_t> _drawCallInfosMax;
 
     mutable std::string _currentNamedCall;
 
@@ -124,7 +126,8 @@ public:
     void multiDrawIndirect(uint32 numCommands, Primitive primitiveType);
     void multiDrawIndexedIndirect(uint32 numCommands, Primitive primitiveType);
 
-    void setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function);
+    // The named data is returned so that a caller adding an instance to it needn't look it up again
+    NamedBatchData& setupNamedCalls(const std::string& instanceName, const NamedBatchData::Function& function);
     BufferPointer getNamedBuffer(const std::string& instanceName, uint8_t index = 0);
 
     // Input Stage
@@ -366,7 +369,7 @@ public:
         typedef T Data;
         Data _data;
         Cache<T>(const Data& data) : _data(data) {}
-        static size_t _max;
+        static std::atomic<size_t> _max;
 
         class Vector {
         public:
@@ -377,7 +380,7 @@ public:
             }
 
             ~Vector() {
-                _max = std::max(_items.size(), _max);
+                updateMax(_max, _items.size());
             }
 
 
@@ -431,16 +434,16 @@ public:
     }
 
     Commands _commands;
-    static size_t _commandsMax;
+    static std::atomic<size_t> _commandsMax;
 
     CommandOffsets _commandOffsets;
-    static size_t _commandOffsetsMax;
+    static std::atomic<size_t> _commandOffsetsMax;
 
     Params _params;
-    static size_t _paramsMax;
+    static std::atomic<size_t> _paramsMax;
 
     Bytes _data;
-    static size_t _dataMax;
+    static std::atomic<size_t> _dataMax;
 
     // SSBO class... layout MUST match the layout in Transform.slh
     class TransformObject {
@@ -453,7 +456,7 @@ public:
     bool _invalidModel { true };
     Transform _currentModel;
     TransformObjects _objects;
-    static size_t _objectsMax;
+    static std::atomic<size_t> _objectsMax;
 
     BufferCaches _buffers;
     TextureCaches _textures;
@@ -471,6 +474,19 @@ public:
     bool _enableStereo{ true };
     bool _enableSkybox{ false };
 
+    // The last texture and uniform buffer recorded in the first slots, not to record them again: the material
+    // switches set the same fallback maps over and over. The batch's caches keep them alive, so the pointers are safe.
+    static const uint32 NUM_TRACKED_SLOTS { 16 };
+    struct BoundUniformBuffer {
+        const Buffer* buffer { nullptr };
+        Offset offset { 0 };
+        Offset size { 0 };
+    };
+    std::array<const Texture*, NUM_TRACKED_SLOTS> _boundTextures;
+    std::array<BoundUniformBuffer, NUM_TRACKED_SLOTS> _boundUniformBuffers;
+    uint32 _boundTexturesMask { 0 };
+    uint32 _boundUniformBuffersMask { 0 };
+
 protected:
     friend class Context;
     friend class Frame;
@@ -491,10 +507,17 @@ protected:
     void runLambda(std::function<void()> f);
 
     void captureDrawCallInfoImpl();
+    void captureDrawCallInfoImpl(DrawCallInfoBuffer& drawCallInfos);
+
+    // The preallocation sizes are shared by batches recorded on different threads, so they only ever grow, atomically
+    static void updateMax(std::atomic<size_t>& max, size_t size) {
+        size_t current = max.load();
+        while (size > current && !max.compare_exchange_weak(current, size)) {}
+    }
 };
 
 template <typename T>
-size_t Batch::Cache<T>::_max = BATCH_PREALLOCATE_MIN;
+std::atomic<size_t> Batch::Cache<T>::_max { BATCH_PREALLOCATE_MIN };
 
 }
 
@@ -0,0 +1,127 @@
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "BufferHeap.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace gpu;
+
+const std::shared_ptr<BufferHeap>& BufferHeap::getShared() {
+    static const std::shared_ptr<BufferHeap> heap = create();
+    return heap;
+}
+
+std::shared_ptr<BufferHeap> BufferHeap::create(Size chunkSize, Size alignment) {
+    return std::shared_ptr<BufferHeap>(new BufferHeap(chunkSize, alignment));
+}
+
+BufferHeap::BufferHeap(Size chunkSize, Size alignment) :
+    _chunkSize(chunkSize),
+    _alignment(alignment) {
+}
+
+BufferView BufferHeap::allocate(Size size, const Byte* data) {
+    Size alignedSize = std::max((size + _alignment - 1) / _alignment * _alignment, _alignment);
+    if (alignedSize > _chunkSize / 4) {
+        auto buffer = std::make_shared<Buffer>();
+        buffer->resize(size);
+        if (data) {
+            buffer->setSubData(0, size, data);
+        }
+        return BufferView(buffer, 0, size);
+    }
+
+    size_t chunkIndex = 0;
+    Size offset = 0;
+    BufferPointer chunkBuffer;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // the first range that fits, in the first chunk that has one
+        bool isFound = false;
+        for (chunkIndex = 0; chunkIndex < _chunks.size() && !isFound; ++chunkIndex) {
+            auto& freeRanges = _chunks[chunkIndex].freeRanges;
+            for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+                if (it->second >= alignedSize) {
+                    offset = it->first;
+                    Size remainingSize = it->second - alignedSize;
+                    freeRanges.erase(it);
+                    if (remainingSize > 0) {
+                        freeRanges[offset + alignedSize] = remainingSize;
+                    }
+                    isFound = true;
+                    break;
+                }
+            }
+        }
+        if (isFound) {
+            --chunkIndex;
+        } else {
+            Chunk chunk;
+            chunk.buffer = std::make_shared<Buffer>();
+            chunk.buffer->resize(_chunkSize);
+            chunk.freeRanges[alignedSize] = _chunkSize - alignedSize;
+            _chunks.push_back(chunk);
+            chunkIndex = _chunks.size() - 1;
+            offset = 0;
+        }
+        _allocatedSize += alignedSize;
+        chunkBuffer = _chunks[chunkIndex].buffer;
+    }
+
+    if (data) {
+        chunkBuffer->setSubData(offset, size, data);
+    }
+
+    // the chunk's Buffer, with a count of its own that gives the range back
+    auto self = shared_from_this();
+    BufferPointer buffer(chunkBuffer.get(), [self, chunkBuffer, chunkIndex, offset, alignedSize](Buffer*) {
+        self->free(chunkIndex, offset, alignedSize);
+    });
+    return BufferView(buffer, offset, size);
+}
+
+BufferView BufferHeap::allocate(Size size, const Byte* data, const Element& element) {
+    BufferView view = allocate(size, data);
+    view._element = element;
+    view._stride = element.getSize();
+    return view;
+}
+
+void BufferHeap::free(size_t chunkIndex, Size offset, Size size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _allocatedSize -= size;
+
+    auto& freeRanges = _chunks[chunkIndex].freeRanges;
+    auto next = freeRanges.lower_bound(offset);
+
+    // merge with the free range that ends where this one starts, and the one that starts where it ends
+    if (next != freeRanges.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            freeRanges.erase(previous);
+        }
+    }
+    if (next != freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        freeRanges.erase(next);
+    }
+    freeRanges[offset] = size;
+}
+
+size_t BufferHeap::getNumChunks() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _chunks.size();
+}
+
+BufferHeap::Size BufferHeap::getAllocatedSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _allocatedSize;
+}
@@ -0,0 +1,66 @@
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_BufferHeap_h
+#define hifi_gpu_BufferHeap_h
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Buffer.h"
+
+namespace gpu {
+
+// Ranges of a few large buffers, handed out as the views of the many small buffers of the render items
+//   Each chunk of the heap is one Buffer, and so one GL buffer object, of a fixed size; its free ranges are kept in
+//   offset order and merged with their neighbours when a range comes back. The views' buffer pointers share the
+//   chunk's Buffer but have a reference count of their own: a range comes back once the last copy of its view
+//   (including those held by the batches of the frames in flight) is gone.
+//   A view must only be written within its range, and its buffer's size is the chunk's, not the view's.
+//   Allocate from one thread at a time (the ranges can come back from any thread).
+class BufferHeap : public std::enable_shared_from_this<BufferHeap> {
+public:
+    using Size = Resource::Size;
+
+    static const Size DEFAULT_CHUNK_SIZE = 1024 * 1024;
+    static const Size DEFAULT_ALIGNMENT = 256; // the uniform buffer offset alignment of the GL backends
+
+    // the heap of the small buffers of the render items, of views that can be vertices, indices or uniforms
+    static const std::shared_ptr<BufferHeap>& getShared();
+
+    static std::shared_ptr<BufferHeap> create(Size chunkSize = DEFAULT_CHUNK_SIZE, Size alignment = DEFAULT_ALIGNMENT);
+
+    // A view of size bytes, holding a copy of data if it isn't null; the views larger than a quarter of a chunk get
+    // a buffer of their own
+    BufferView allocate(Size size, const Byte* data = nullptr);
+    BufferView allocate(Size size, const Byte* data, const Element& element);
+
+    size_t getNumChunks() const;
+    Size getAllocatedSize() const;
+
+private:
+    BufferHeap(Size chunkSize, Size alignment);
+
+    struct Chunk {
+        BufferPointer buffer;
+        std::map<Size, Size> freeRanges; // the size of each free range, by offset
+    };
+
+    void free(size_t chunkIndex, Size offset, Size size);
+
+    const Size _chunkSize;
+    const Size _alignment;
+
+    mutable std::mutex _mutex;
+    std::vector<Chunk> _chunks;
+    Size _allocatedSize { 0 };
+};
+
+}
+
+#endif
@@ -10,6 +10,8 @@
 //
 #include "Context.h"
 
+#include <new>
+
 #include <shared/GlobalAppProperties.h>
 
 #include "Frame.h"
@@ -36,6 +38,7 @@ void ContextStats::evalDelta(const ContextStats& begin, const ContextStats& end)
 
 Context::CreateBackend Context::_createBackendCallback = nullptr;
 Context::MakeProgram Context::_makeProgramCallback = nullptr;
+Context::MakeProgramAsync Context::_makeProgramAsyncCallback = nullptr;
 std::once_flag Context::_initialized;
 
 Context::Context() {
@@ -69,6 +72,34 @@ void Context::appendFrameBatch(Batch& batch) {
     _currentFrame->batches.push_back(batch);
 }
 
+size_t Context::reserveFrameBatch() {
+    if (!_frameActive) {
+        qWarning() << "Batch reserved outside of frame boundaries";
+        return INVALID_FRAME_BATCH;
+    }
+    _currentFrame->batches.emplace_back();
+    return _currentFrame->batches.size() - 1;
+}
+
+void Context::setFrameBatch(size_t index, Batch& batch) {
+    if (!_frameActive || index >= _currentFrame->batches.size()) {
+        qWarning() << "Batch set outside of frame boundaries";
+        return;
+    }
+    // Batch has no assignment, only its copy constructor, which takes the other batch's content
+    Batch& placeholder = _currentFrame->batches[index];
+    placeholder.~Batch();
+    new (&placeholder) Batch(batch);
+}
+
+bool Context::cancelFrameBatch(size_t index) {
+    if (!_frameActive || index + 1 != _currentFrame->batches.size()) {
+        return false;
+    }
+    _currentFrame->batches.pop_back();
+    return true;
+}
+
 FramePointer Context::endFrame() {
     assert(_frameActive);
     auto result = _currentFrame;
@@ -137,6 +168,19 @@ bool Context::makeProgram(Shader& shader, const Shader::BindingSet& bindings) {
     return false;
 }
 
+void Context::makeProgramAsync(const ShaderPointer& shader, const Shader::BindingSet& bindings, const Shader::MakeProgramCallback& callback) {
+    // Same as makeProgram, from another DLL context
+    if (!_makeProgramAsyncCallback) {
+        void* rawCallback = qApp->property(hifi::properties::gl::MAKE_PROGRAM_ASYNC_CALLBACK).value<void*>();
+        _makeProgramAsyncCallback = reinterpret_cast<Context::MakeProgramAsync>(rawCallback);
+    }
+    if (_makeProgramAsyncCallback) {
+        _makeProgramAsyncCallback(shader, bindings, callback);
+    } else {
+        callback(makeProgram(*shader, bindings));
+    }
+}
+
 void Context::enableStereo(bool enable) {
     _stereo._enable = enable;
 }
@@ -173,6 +217,10 @@ void Context::downloadFramebuffer(const FramebufferPointer& srcFramebuffer, cons
     _backend->downloadFramebuffer(srcFramebuffer, region, destImage);
 }
 
+FramebufferReadbackPointer Context::startFramebufferReadback(const FramebufferPointer& srcFramebuffer, const Vec4i& region) {
+    return _backend->startFramebufferReadback(srcFramebuffer, region);
+}
+
 void Context::resetStats() const {
     _backend->resetStats();
 }
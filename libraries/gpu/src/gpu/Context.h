@@ -49,6 +49,19 @@ public:
     void evalDelta(const ContextStats& begin, const ContextStats& end); 
 };
 
+// A region of a framebuffer being copied to memory the cpu reads, started and read on the thread executing the batches.
+// The copy runs along with the frames that follow: it's read once ready, without waiting on the gpu.
+class FramebufferReadback {
+public:
+    virtual ~FramebufferReadback() {}
+
+    // Has the gpu finished the copy
+    virtual bool isReady() = 0;
+    // Read the region into destImage, of FORMAT_ARGB32 and at least the region's size, once the copy is ready
+    virtual bool read(QImage& destImage) = 0;
+};
+using FramebufferReadbackPointer = std::shared_ptr<FramebufferReadback>;
+
 class Backend {
 public:
     virtual~ Backend() {};
@@ -59,6 +72,7 @@ public:
     virtual void syncCache() = 0;
     virtual void recycle() const = 0;
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) = 0;
+    virtual FramebufferReadbackPointer startFramebufferReadback(const FramebufferPointer& srcFramebuffer, const Vec4i& region) = 0;
 
     // UBO class... layout MUST match the layout in Transform.slh
     class TransformCamera {
@@ -137,6 +151,7 @@ public:
     using Size = Resource::Size;
     typedef BackendPointer (*CreateBackend)();
     typedef bool (*MakeProgram)(Shader& shader, const Shader::BindingSet& bindings);
+    typedef void (*MakeProgramAsync)(const ShaderPointer& shader, const Shader::BindingSet& bindings, const Shader::MakeProgramCallback& callback);
 
 
     // This one call must happen before any context is created or used (Shader::MakeProgram) in order to setup the Backend and any singleton data needed
@@ -145,6 +160,7 @@ public:
         std::call_once(_initialized, [] {
             _createBackendCallback = T::createBackend;
             _makeProgramCallback = T::makeProgram;
+            _makeProgramAsyncCallback = T::makeProgramAsync;
             T::init();
         });
     }
@@ -154,6 +170,14 @@ public:
 
     void beginFrame(const glm::mat4& renderPose = glm::mat4());
     void appendFrameBatch(Batch& batch);
+    // For a batch recorded after the ones that follow it: reserve its place in the frame, in turn, and later
+    // (before endFrame) fill it with the batch
+    static const size_t INVALID_FRAME_BATCH { (size_t)-1 };
+    size_t reserveFrameBatch();
+    void setFrameBatch(size_t index, Batch& batch);
+    // Drop a reserved batch nothing was added after, returning false and keeping it if anything was
+    bool cancelFrameBatch(size_t index);
+    bool isFrameActive() const { return _frameActive; }
     FramePointer endFrame();
 
     // MUST only be called on the rendering thread
@@ -204,6 +228,10 @@ public:
     // It s here for convenience to easily capture a snapshot
     void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage);
 
+    // Starts an asynchronous download of the region of the Framebuffer, to be read a frame or more later.
+    // Call it from a batch lambda, on the thread executing the batches; returns null if the backend can't.
+    FramebufferReadbackPointer startFramebufferReadback(const FramebufferPointer& srcFramebuffer, const Vec4i& region);
+
      // Repporting stats of the context
     void resetStats() const;
     void getStats(ContextStats& stats) const;
@@ -245,9 +273,11 @@ protected:
     // It compiles the sub shaders, link them and defines the Slots and their bindings.
     // If the shader passed is not a program, nothing happens. 
     static bool makeProgram(Shader& shader, const Shader::BindingSet& bindings);
+    static void makeProgramAsync(const ShaderPointer& shader, const Shader::BindingSet& bindings, const Shader::MakeProgramCallback& callback);
 
     static CreateBackend _createBackendCallback;
     static MakeProgram _makeProgramCallback;
+    static MakeProgramAsync _makeProgramAsyncCallback;
     static std::once_flag _initialized;
 
     friend class Shader;
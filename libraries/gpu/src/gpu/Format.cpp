@@ -20,6 +20,11 @@ const Element Element::COLOR_BGRA_32{ VEC4, NUINT8, BGRA };
 const Element Element::COLOR_SBGRA_32{ VEC4, NUINT8, SBGRA };
 
 const Element Element::COLOR_R11G11B10{ SCALAR, FLOAT, R11G11B10 };
+
+const Element Element::COLOR_COMPRESSED_RGB_BC1{ VEC4, NUINT8, COMPRESSED_BC1_RGB };
+const Element Element::COLOR_COMPRESSED_SRGB_BC1{ VEC4, NUINT8, COMPRESSED_BC1_SRGB };
+const Element Element::COLOR_COMPRESSED_RGBA_BC3{ VEC4, NUINT8, COMPRESSED_BC3_RGBA };
+const Element Element::COLOR_COMPRESSED_SRGBA_BC3{ VEC4, NUINT8, COMPRESSED_BC3_SRGBA };
 const Element Element::VEC4F_COLOR_RGBA{ VEC4, FLOAT, RGBA };
 const Element Element::VEC2F_UV{ VEC2, FLOAT, UV };
 const Element Element::VEC2F_XY{ VEC2, FLOAT, XY };
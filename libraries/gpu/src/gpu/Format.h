@@ -165,11 +165,15 @@ enum Semantic {
     COMPRESSED_SRGB,
     COMPRESSED_SRGBA,
 
-    // FIXME: Will have to be supported later:
-    /*COMPRESSED_BC3_RGBA,  // RGBA_S3TC_DXT5_EXT,
+    // These are block compressed, 4x4 texels in 8 bytes for BC1 and 16 bytes for BC3
+    COMPRESSED_BC1_RGB,  // RGB_S3TC_DXT1_EXT
+    COMPRESSED_BC1_SRGB, // SRGB_S3TC_DXT1_EXT
+
+    COMPRESSED_BC3_RGBA,  // RGBA_S3TC_DXT5_EXT,
     COMPRESSED_BC3_SRGBA, // SRGB_ALPHA_S3TC_DXT5_EXT
 
-    COMPRESSED_BC7_RGBA,
+    // FIXME: Will have to be supported later:
+    /*COMPRESSED_BC7_RGBA,
     COMPRESSED_BC7_SRGBA, */
 
     _LAST_COMPRESSED,
@@ -207,6 +211,7 @@ public:
     Dimension getDimension() const { return (Dimension)_dimension; }
     
     bool isCompressed() const { return uint8(getSemantic() - _FIRST_COMPRESSED) <= uint8(_LAST_COMPRESSED - _FIRST_COMPRESSED); }
+    bool isBlockCompressed() const { return uint8(getSemantic() - COMPRESSED_BC1_RGB) <= uint8(COMPRESSED_BC3_SRGBA - COMPRESSED_BC1_RGB); }
 
     Type getType() const { return (Type)_type; }
     bool isNormalized() const { return (getType() >= NORMALIZED_START); }
@@ -215,6 +220,18 @@ public:
     uint8 getScalarCount() const { return  SCALAR_COUNT[(Dimension)_dimension]; }
     uint32 getSize() const { return SCALAR_COUNT[_dimension] * TYPE_SIZE[_type]; }
 
+    // Size of a 4x4 block of a block compressed format
+    static const uint32 BLOCK_DIMENSION { 4 };
+    uint32 getBlockSize() const { return (getSemantic() <= COMPRESSED_BC1_SRGB ? 8 : 16); }
+
+    // Size of width x height x depth texels, a row of blocks covers BLOCK_DIMENSION rows of texels
+    uint32 evalTexelsSize(uint32 width, uint32 height, uint32 depth = 1) const {
+        if (isBlockCompressed()) {
+            return ((width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION) * ((height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION) * depth * getBlockSize();
+        }
+        return width * height * depth * getSize();
+    }
+
     uint8 getLocationCount() const { return  LOCATION_COUNT[(Dimension)_dimension]; }
     uint8 getLocationScalarCount() const { return  SCALAR_COUNT_PER_LOCATION[(Dimension)_dimension]; }
     uint32 getLocationSize() const { return SCALAR_COUNT_PER_LOCATION[_dimension] * TYPE_SIZE[_type]; }
@@ -236,6 +253,10 @@ public:
     static const Element COLOR_BGRA_32;
     static const Element COLOR_SBGRA_32;
     static const Element COLOR_R11G11B10;
+    static const Element COLOR_COMPRESSED_RGB_BC1;
+    static const Element COLOR_COMPRESSED_SRGB_BC1;
+    static const Element COLOR_COMPRESSED_RGBA_BC3;
+    static const Element COLOR_COMPRESSED_SRGBA_BC3;
     static const Element VEC4F_COLOR_RGBA;
     static const Element VEC2F_UV;
     static const Element VEC2F_XY;
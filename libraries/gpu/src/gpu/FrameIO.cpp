@@ -0,0 +1,665 @@
+//
+//  FrameIO.cpp
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "FrameIO.h"
+
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
+#include <QtCore/QFile>
+
+#include "Frame.h"
+#include "Framebuffer.h"
+#include "GPULogging.h"
+#include "Pipeline.h"
+#include "Query.h"
+#include "Shader.h"
+#include "State.h"
+#include "Texture.h"
+
+using namespace gpu;
+
+namespace {
+    const uint32 FRAME_MAGIC = 0x46555047; // "GPUF"
+    // Bump it whenever the layout changes, or that of the structures written as they are in memory
+    // (the batch commands and params, State::Data, the stereo state...), which also tie a file to the build writing it
+    const uint32 FRAME_VERSION = 1;
+    const uint32 INVALID_INDEX = (uint32)-1;
+
+    // The objects the batches refer to, in the order they are met, each written once then referred to by its index
+    template <typename T>
+    class Table {
+    public:
+        uint32 add(const T* object) {
+            if (!object) {
+                return INVALID_INDEX;
+            }
+            auto result = _indices.emplace(object, (uint32)_objects.size());
+            if (result.second) {
+                _objects.push_back(object);
+            }
+            return result.first->second;
+        }
+
+        const std::vector<const T*>& getObjects() const { return _objects; }
+
+    private:
+        std::unordered_map<const T*, uint32> _indices;
+        std::vector<const T*> _objects;
+    };
+
+    template <typename T>
+    std::shared_ptr<T> getIndexed(const std::vector<std::shared_ptr<T>>& objects, uint32 index) {
+        return index < objects.size() ? objects[index] : std::shared_ptr<T>();
+    }
+}
+
+namespace gpu {
+
+class FrameWriter {
+public:
+    FrameWriter(QFile& file) : _file(file) {}
+
+    bool write(const Frame& frame);
+
+private:
+    void writeData(const void* data, size_t size) {
+        if (_valid && size > 0) {
+            _valid = (_file.write((const char*)data, (qint64)size) == (qint64)size);
+        }
+    }
+    template <typename T> void writeValue(const T& value) { writeData(&value, sizeof(T)); }
+    template <typename T> void writeVector(const std::vector<T>& values) {
+        writeValue((uint64)values.size());
+        writeData(values.data(), values.size() * sizeof(T));
+    }
+    void writeString(const std::string& string) {
+        writeValue((uint64)string.size());
+        writeData(string.data(), string.size());
+    }
+
+    uint32 addTexture(const TexturePointer& texture);
+    uint32 addFramebuffer(const FramebufferPointer& framebuffer);
+    uint32 addShader(const ShaderPointer& shader);
+    void addBatch(const Batch& batch);
+
+    void writeTexture(const Texture& texture);
+    void writeFramebuffer(const Framebuffer& framebuffer);
+    void writeStreamFormat(const Stream::Format& format);
+    void writeShader(const Shader& shader);
+    void writePipeline(const Pipeline& pipeline);
+    void writeBatch(const Batch& batch);
+
+    QFile& _file;
+    bool _valid { true };
+
+    Table<Texture> _textures;
+    Table<Buffer> _buffers;
+    Table<Framebuffer> _framebuffers;
+    Table<Stream::Format> _streamFormats;
+    Table<Shader> _shaders;
+    Table<Pipeline> _pipelines;
+    Table<Query> _queries;
+};
+
+class FrameReader {
+public:
+    FrameReader(QFile& file) : _file(file) {}
+
+    FramePointer read();
+
+private:
+    void readData(void* data, size_t size) {
+        if (_valid && size > 0) {
+            _valid = (_file.read((char*)data, (qint64)size) == (qint64)size);
+        }
+    }
+    template <typename T> T readValue() {
+        T value;
+        readData(&value, sizeof(T));
+        return value;
+    }
+    template <typename T> void readVector(std::vector<T>& values) {
+        uint64 size = readValue<uint64>();
+        if (!_valid || size > (uint64)_file.bytesAvailable() / sizeof(T)) {
+            _valid = false;
+            return;
+        }
+        values.resize((size_t)size);
+        readData(values.data(), values.size() * sizeof(T));
+    }
+    std::string readString() {
+        std::vector<char> chars;
+        readVector(chars);
+        return std::string(chars.begin(), chars.end());
+    }
+    Element readElement() {
+        Element element;
+        uint16 raw = readValue<uint16>();
+        memcpy(&element, &raw, sizeof(uint16));
+        return element;
+    }
+    template <typename T> std::vector<std::shared_ptr<T>> readTable(std::function<std::shared_ptr<T>()> readObject) {
+        std::vector<std::shared_ptr<T>> objects;
+        uint32 count = readValue<uint32>();
+        for (uint32 i = 0; _valid && i < count; ++i) {
+            objects.push_back(readObject());
+        }
+        return objects;
+    }
+
+    TexturePointer readTexture();
+    FramebufferPointer readFramebuffer();
+    Stream::FormatPointer readStreamFormat();
+    ShaderPointer readShader();
+    PipelinePointer readPipeline();
+    void readBatch(Batch& batch);
+
+    QFile& _file;
+    bool _valid { true };
+
+    std::vector<TexturePointer> _textures;
+    std::vector<BufferPointer> _buffers;
+    std::vector<FramebufferPointer> _framebuffers;
+    std::vector<Stream::FormatPointer> _streamFormats;
+    std::vector<ShaderPointer> _shaders;
+    std::vector<PipelinePointer> _pipelines;
+    std::vector<QueryPointer> _queries;
+};
+
+}
+
+uint32 FrameWriter::addTexture(const TexturePointer& texture) {
+    // an external texture belongs to the application that made it
+    if (!texture || texture->getUsageType() == TextureUsageType::EXTERNAL) {
+        return INVALID_INDEX;
+    }
+    return _textures.add(texture.get());
+}
+
+uint32 FrameWriter::addFramebuffer(const FramebufferPointer& framebuffer) {
+    if (!framebuffer || framebuffer->isSwapchain()) {
+        return INVALID_INDEX;
+    }
+    for (uint32 slot = 0; slot < Framebuffer::MAX_NUM_RENDER_BUFFERS; ++slot) {
+        addTexture(framebuffer->getRenderBuffer(slot));
+    }
+    addTexture(framebuffer->getDepthStencilBuffer());
+    return _framebuffers.add(framebuffer.get());
+}
+
+uint32 FrameWriter::addShader(const ShaderPointer& shader) {
+    if (!shader) {
+        return INVALID_INDEX;
+    }
+    // the domain shaders before the programs linking them
+    for (const auto& domainShader : shader->getShaders()) {
+        addShader(domainShader);
+    }
+    return _shaders.add(shader.get());
+}
+
+void FrameWriter::addBatch(const Batch& batch) {
+    for (const auto& item : batch._buffers._items) {
+        _buffers.add(item._data.get());
+    }
+    for (const auto& item : batch._textures._items) {
+        addTexture(item._data);
+    }
+    for (const auto& item : batch._framebuffers._items) {
+        addFramebuffer(item._data);
+    }
+    for (const auto& item : batch._streamFormats._items) {
+        _streamFormats.add(item._data.get());
+    }
+    for (const auto& item : batch._pipelines._items) {
+        if (item._data) {
+            addShader(item._data->getProgram());
+            _pipelines.add(item._data.get());
+        }
+    }
+    for (const auto& item : batch._queries._items) {
+        _queries.add(item._data.get());
+    }
+}
+
+void FrameWriter::writeTexture(const Texture& texture) {
+    writeValue((uint8)texture.getUsageType());
+    writeValue((uint8)texture.getType());
+    writeValue(texture.getTexelFormat().getRaw());
+    writeValue(texture.getStoredMipFormat().getRaw());
+    writeValue(texture.getWidth());
+    writeValue(texture.getHeight());
+    writeValue(texture.getDepth());
+    writeValue(texture.getNumSamples());
+    writeValue((uint16)(texture.isArray() ? texture.getNumSlices() : 0));
+    writeValue(texture.getSampler().getDesc());
+    writeValue((uint32)texture.getUsage()._flags.to_ulong());
+    writeValue(texture.isAutogenerateMips());
+    writeValue(texture.maxMip());
+    writeString(texture.source());
+
+    // the mips it has, which a render buffer hasn't
+    for (uint16 level = 0; level <= texture.maxMip(); ++level) {
+        for (uint8 face = 0; face < texture.getNumFaces(); ++face) {
+            auto mip = texture.isStoredMipFaceAvailable(level, face) ? texture.accessStoredMipFace(level, face) : PixelsPointer();
+            writeValue((uint64)(mip ? mip->getSize() : 0));
+            if (mip) {
+                writeData(mip->readData(), mip->getSize());
+            }
+        }
+    }
+}
+
+void FrameWriter::writeFramebuffer(const Framebuffer& framebuffer) {
+    writeString(framebuffer.getName());
+    for (uint32 slot = 0; slot < Framebuffer::MAX_NUM_RENDER_BUFFERS; ++slot) {
+        writeValue(addTexture(framebuffer.getRenderBuffer(slot)));
+        writeValue(framebuffer.getRenderBufferSubresource(slot));
+    }
+    writeValue(addTexture(framebuffer.getDepthStencilBuffer()));
+    writeValue(framebuffer.getDepthStencilBufferFormat().getRaw());
+    writeValue(framebuffer.getDepthStencilBufferSubresource());
+}
+
+void FrameWriter::writeStreamFormat(const Stream::Format& format) {
+    writeValue((uint32)format.getNumAttributes());
+    for (const auto& item : format.getAttributes()) {
+        const Stream::Attribute& attribute = item.second;
+        writeValue(attribute._slot);
+        writeValue(attribute._channel);
+        writeValue(attribute._element.getRaw());
+        writeValue((uint64)attribute._offset);
+        writeValue(attribute._frequency);
+    }
+}
+
+void FrameWriter::writeShader(const Shader& shader) {
+    writeValue((uint8)shader.getType());
+    if (!shader.isProgram()) {
+        writeString(shader.getSource().getCode());
+        return;
+    }
+    writeValue((uint32)shader.getShaders().size());
+    for (const auto& domainShader : shader.getShaders()) {
+        writeValue(addShader(domainShader));
+    }
+
+    // The slots it was made with, to bind the resources of the batches to the same units when it's made again
+    std::vector<std::pair<std::string, int32>> bindings;
+    for (const auto& slot : shader.getBuffers()) {
+        bindings.emplace_back(slot._name, slot._location);
+    }
+    for (const auto& slot : shader.getTextures()) {
+        bindings.emplace_back(slot._name, slot._location);
+    }
+    writeValue((uint32)bindings.size());
+    for (const auto& binding : bindings) {
+        writeString(binding.first);
+        writeValue(binding.second);
+    }
+}
+
+void FrameWriter::writePipeline(const Pipeline& pipeline) {
+    writeValue(addShader(pipeline.getProgram()));
+    writeValue((bool)pipeline.getState());
+    if (pipeline.getState()) {
+        writeValue(pipeline.getState()->getValues());
+    }
+}
+
+void FrameWriter::writeBatch(const Batch& batch) {
+    writeVector(batch._commands);
+    writeVector(batch._commandOffsets);
+    writeVector(batch._params);
+    writeVector(batch._data);
+    writeVector(batch._drawCallInfos);
+    writeVector(batch._objects);
+
+    writeValue((uint32)batch._buffers.size());
+    for (const auto& item : batch._buffers._items) {
+        writeValue(_buffers.add(item._data.get()));
+    }
+    writeValue((uint32)batch._textures.size());
+    for (const auto& item : batch._textures._items) {
+        writeValue(addTexture(item._data));
+    }
+    writeValue((uint32)batch._streamFormats.size());
+    for (const auto& item : batch._streamFormats._items) {
+        writeValue(_streamFormats.add(item._data.get()));
+    }
+    writeValue((uint32)batch._transforms.size());
+    for (const auto& item : batch._transforms._items) {
+        writeValue(item._data.getTranslation());
+        writeValue(item._data.getRotation());
+        writeValue(item._data.getScale());
+    }
+    writeValue((uint32)batch._pipelines.size());
+    for (const auto& item : batch._pipelines._items) {
+        writeValue(_pipelines.add(item._data.get()));
+    }
+    writeValue((uint32)batch._framebuffers.size());
+    for (const auto& item : batch._framebuffers._items) {
+        writeValue(addFramebuffer(item._data));
+    }
+    writeValue((uint32)batch._queries.size());
+    for (const auto& item : batch._queries._items) {
+        writeValue(_queries.add(item._data.get()));
+    }
+    writeValue((uint32)batch._lambdas.size());
+    writeValue((uint32)batch._profileRanges.size());
+    for (const auto& item : batch._profileRanges._items) {
+        writeString(item._data);
+    }
+    writeValue((uint32)batch._names.size());
+    for (const auto& item : batch._names._items) {
+        writeString(item._data);
+    }
+
+    writeValue(batch._enableStereo);
+    writeValue(batch._enableSkybox);
+}
+
+bool FrameWriter::write(const Frame& frame) {
+    for (const auto& batch : frame.batches) {
+        addBatch(batch);
+    }
+    addFramebuffer(frame.framebuffer);
+    addTexture(frame.overlay);
+
+    writeValue(FRAME_MAGIC);
+    writeValue(FRAME_VERSION);
+    writeValue((uint32)sizeof(Batch::Param));
+
+    // the framebuffers add no texture not already met, nor the programs any shader
+    writeValue((uint32)_textures.getObjects().size());
+    for (auto texture : _textures.getObjects()) {
+        writeTexture(*texture);
+    }
+    writeValue((uint32)_buffers.getObjects().size());
+    for (auto buffer : _buffers.getObjects()) {
+        writeValue((uint64)buffer->getSize());
+        writeData(buffer->getData(), buffer->getSize());
+    }
+    writeValue((uint32)_framebuffers.getObjects().size());
+    for (auto framebuffer : _framebuffers.getObjects()) {
+        writeFramebuffer(*framebuffer);
+    }
+    writeValue((uint32)_streamFormats.getObjects().size());
+    for (auto format : _streamFormats.getObjects()) {
+        writeStreamFormat(*format);
+    }
+    writeValue((uint32)_shaders.getObjects().size());
+    for (auto shader : _shaders.getObjects()) {
+        writeShader(*shader);
+    }
+    writeValue((uint32)_pipelines.getObjects().size());
+    for (auto pipeline : _pipelines.getObjects()) {
+        writePipeline(*pipeline);
+    }
+    writeValue((uint32)_queries.getObjects().size());
+    for (auto query : _queries.getObjects()) {
+        writeString(query->getName());
+    }
+
+    writeValue(frame.stereoState);
+    writeValue(frame.frameIndex);
+    writeValue(frame.pose);
+    writeValue(addFramebuffer(frame.framebuffer));
+    writeValue(addTexture(frame.overlay));
+    writeValue((uint32)frame.batches.size());
+    for (const auto& batch : frame.batches) {
+        writeBatch(batch);
+    }
+    return _valid;
+}
+
+TexturePointer FrameReader::readTexture() {
+    auto usageType = (TextureUsageType)readValue<uint8>();
+    auto type = (Texture::Type)readValue<uint8>();
+    Element texelFormat = readElement();
+    Element storedMipFormat = readElement();
+    uint16 width = readValue<uint16>();
+    uint16 height = readValue<uint16>();
+    uint16 depth = readValue<uint16>();
+    uint16 numSamples = readValue<uint16>();
+    uint16 numSlices = readValue<uint16>();
+    auto samplerDesc = readValue<Sampler::Desc>();
+    auto usageFlags = readValue<uint32>();
+    bool autogenerateMips = readValue<bool>();
+    uint16 maxMip = readValue<uint16>();
+    std::string source = readString();
+    if (!_valid) {
+        return TexturePointer();
+    }
+
+    TexturePointer texture(Texture::create(usageType, type, texelFormat, width, height, depth, numSamples, numSlices,
+                                           Sampler(samplerDesc)));
+    texture->setUsage(Texture::Usage(Texture::Usage::Flags(usageFlags)));
+    texture->setSource(source);
+    texture->setStoredMipFormat(storedMipFormat);
+    if (autogenerateMips) {
+        texture->autoGenerateMips(maxMip);
+    }
+
+    std::vector<Byte> mip;
+    for (uint16 level = 0; _valid && level <= maxMip; ++level) {
+        for (uint8 face = 0; _valid && face < texture->getNumFaces(); ++face) {
+            readVector(mip);
+            if (_valid && !mip.empty()) {
+                texture->assignStoredMipFace(level, face, mip.size(), mip.data());
+            }
+        }
+    }
+    return texture;
+}
+
+FramebufferPointer FrameReader::readFramebuffer() {
+    FramebufferPointer framebuffer(Framebuffer::create(readString()));
+    for (uint32 slot = 0; slot < Framebuffer::MAX_NUM_RENDER_BUFFERS; ++slot) {
+        auto texture = getIndexed(_textures, readValue<uint32>());
+        uint32 subresource = readValue<uint32>();
+        if (texture) {
+            framebuffer->setRenderBuffer(slot, texture, subresource);
+        }
+    }
+    auto depthStencil = getIndexed(_textures, readValue<uint32>());
+    Element depthStencilFormat = readElement();
+    uint32 subresource = readValue<uint32>();
+    if (depthStencil) {
+        framebuffer->setDepthStencilBuffer(depthStencil, depthStencilFormat, subresource);
+    }
+    return framebuffer;
+}
+
+Stream::FormatPointer FrameReader::readStreamFormat() {
+    auto format = std::make_shared<Stream::Format>();
+    uint32 numAttributes = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < numAttributes; ++i) {
+        auto slot = readValue<Stream::Slot>();
+        auto channel = readValue<Stream::Slot>();
+        Element element = readElement();
+        auto offset = (Offset)readValue<uint64>();
+        auto frequency = (Stream::Frequency)readValue<uint32>();
+        format->setAttribute(slot, channel, element, offset, frequency);
+    }
+    return format;
+}
+
+ShaderPointer FrameReader::readShader() {
+    auto type = (Shader::Type)readValue<uint8>();
+    switch (type) {
+        case Shader::VERTEX:
+            return Shader::createVertex(Shader::Source(readString()));
+        case Shader::PIXEL:
+            return Shader::createPixel(Shader::Source(readString()));
+        case Shader::GEOMETRY:
+            return Shader::createGeometry(Shader::Source(readString()));
+        case Shader::PROGRAM:
+            break;
+        default:
+            _valid = false;
+            return ShaderPointer();
+    }
+
+    Shaders domainShaders;
+    uint32 numShaders = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < numShaders; ++i) {
+        domainShaders.push_back(getIndexed(_shaders, readValue<uint32>()));
+    }
+    Shader::BindingSet bindings;
+    uint32 numBindings = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < numBindings; ++i) {
+        std::string name = readString();
+        bindings.insert(Shader::Binding(name, readValue<int32>()));
+    }
+    if (!_valid) {
+        return ShaderPointer();
+    }
+
+    ShaderPointer program;
+    if (domainShaders.size() == 2) {
+        program = Shader::createProgram(domainShaders[0], domainShaders[1]);
+    } else if (domainShaders.size() == 3) {
+        program = Shader::createProgram(domainShaders[0], domainShaders[1], domainShaders[2]);
+    } else {
+        _valid = false;
+        return ShaderPointer();
+    }
+    Shader::makeProgram(*program, bindings);
+    return program;
+}
+
+PipelinePointer FrameReader::readPipeline() {
+    auto program = getIndexed(_shaders, readValue<uint32>());
+    auto state = std::make_shared<State>();
+    if (readValue<bool>()) {
+        state = std::make_shared<State>(readValue<State::Data>());
+    }
+    return program ? Pipeline::create(program, state) : PipelinePointer();
+}
+
+void FrameReader::readBatch(Batch& batch) {
+    readVector(batch._commands);
+    readVector(batch._commandOffsets);
+    readVector(batch._params);
+    readVector(batch._data);
+    readVector(batch._drawCallInfos);
+    readVector(batch._objects);
+
+    uint32 count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._buffers.cache(getIndexed(_buffers, readValue<uint32>()));
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._textures.cache(getIndexed(_textures, readValue<uint32>()));
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._streamFormats.cache(getIndexed(_streamFormats, readValue<uint32>()));
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        Transform transform;
+        transform.setTranslation(readValue<Vec3>());
+        transform.setRotation(readValue<Quat>());
+        transform.setScale(readValue<Vec3>());
+        batch._transforms.cache(transform);
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._pipelines.cache(getIndexed(_pipelines, readValue<uint32>()));
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._framebuffers.cache(getIndexed(_framebuffers, readValue<uint32>()));
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._queries.cache(getIndexed(_queries, readValue<uint32>()));
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._lambdas.cache([] {});
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._profileRanges.cache(readString());
+    }
+    count = readValue<uint32>();
+    for (uint32 i = 0; _valid && i < count; ++i) {
+        batch._names.cache(readString());
+    }
+
+    batch._enableStereo = readValue<bool>();
+    batch._enableSkybox = readValue<bool>();
+}
+
+FramePointer FrameReader::read() {
+    if (readValue<uint32>() != FRAME_MAGIC || readValue<uint32>() != FRAME_VERSION ||
+            readValue<uint32>() != (uint32)sizeof(Batch::Param)) {
+        qCWarning(gpulogging) << "gpu::readFrame - not a frame written by this version, in" << _file.fileName();
+        return FramePointer();
+    }
+
+    _textures = readTable<Texture>([this] { return readTexture(); });
+    _buffers = readTable<Buffer>([this] {
+        std::vector<Byte> contents;
+        readVector(contents);
+        return std::make_shared<Buffer>(contents.size(), contents.data());
+    });
+    _framebuffers = readTable<Framebuffer>([this] { return readFramebuffer(); });
+    _streamFormats = readTable<Stream::Format>([this] { return readStreamFormat(); });
+    // the shaders are read in the order they were met, the domain shaders of a program before it
+    _shaders = readTable<Shader>([this] { return readShader(); });
+    _pipelines = readTable<Pipeline>([this] { return readPipeline(); });
+    _queries = readTable<Query>([this] { return std::make_shared<Query>([](const Query&) {}, readString()); });
+
+    auto frame = std::make_shared<Frame>();
+    frame->stereoState = readValue<StereoState>();
+    frame->frameIndex = readValue<uint32_t>();
+    frame->pose = readValue<Mat4>();
+    frame->framebuffer = getIndexed(_framebuffers, readValue<uint32>());
+    frame->overlay = getIndexed(_textures, readValue<uint32>());
+    uint32 numBatches = readValue<uint32>();
+    frame->batches.resize(_valid ? numBatches : 0);
+    for (auto& batch : frame->batches) {
+        readBatch(batch);
+    }
+
+    if (!_valid) {
+        qCWarning(gpulogging) << "gpu::readFrame - truncated or corrupted frame in" << _file.fileName();
+        return FramePointer();
+    }
+    return frame;
+}
+
+bool gpu::writeFrame(const std::string& filename, const Frame& frame) {
+    QFile file(QString::fromStdString(filename));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(gpulogging) << "gpu::writeFrame - can't open" << file.fileName();
+        return false;
+    }
+    if (!FrameWriter(file).write(frame)) {
+        qCWarning(gpulogging) << "gpu::writeFrame - failed writing" << file.fileName();
+        return false;
+    }
+    return true;
+}
+
+FramePointer gpu::readFrame(const std::string& filename) {
+    QFile file(QString::fromStdString(filename));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(gpulogging) << "gpu::readFrame - can't open" << file.fileName();
+        return FramePointer();
+    }
+    return FrameReader(file).read();
+}
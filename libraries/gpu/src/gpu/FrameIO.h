@@ -0,0 +1,33 @@
+//
+//  FrameIO.h
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_FrameIO_h
+#define hifi_gpu_FrameIO_h
+
+#include <string>
+
+#include "Forward.h"
+
+namespace gpu {
+
+// A captured frame is written with everything its batches refer to, once each: the buffers with their contents,
+// the textures with their stored mips (render buffers with none), the framebuffers, stream formats, and pipelines
+// with their shaders' sources and slot bindings, for it to be replayed away from the application that recorded it.
+// The batches' lambdas can't be written: they are replayed as no-ops, and external textures as missing.
+//
+// writeFrame MUST be called on the thread that recorded the frame, once it's ended and before it's executed
+bool writeFrame(const std::string& filename, const Frame& frame);
+
+// The programs are made as the frame is read, so readFrame MUST be called with the gpu::Context's GL context current.
+// The frame's batches are then meant to be executed with gpu::Context::executeBatch, as often as needed.
+FramePointer readFrame(const std::string& filename);
+
+}
+
+#endif
@@ -87,3 +87,11 @@ bool Shader::makeProgram(Shader& shader, const Shader::BindingSet& bindings) {
     }
     return false;
 }
+
+void Shader::makeProgramAsync(const Pointer& shader, const Shader::BindingSet& bindings, const MakeProgramCallback& callback) {
+    if (shader && shader->isProgram()) {
+        Context::makeProgramAsync(shader, bindings, callback);
+    } else {
+        callback(false);
+    }
+}
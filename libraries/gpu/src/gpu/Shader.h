@@ -14,6 +14,7 @@
 #include "Resource.h"
 #include <string>
 #include <memory>
+#include <functional>
 #include <set>
 
 #include <QUrl>
@@ -163,6 +164,13 @@ public:
     // independant of the graphics api in use underneath (looking at you opengl & vulkan).
     static bool makeProgram(Shader& shader, const Shader::BindingSet& bindings = Shader::BindingSet());
 
+    // makeProgramAsync(...) does the same on a thread of the backend, with a context shared with the rendering one,
+    // for the programs of the content (the procedurals) that can be drawn without until they're made.
+    // The callback is called from that thread with the result of makeProgram, or from the caller's if the backend
+    // has no such thread, and the program is made at once.
+    using MakeProgramCallback = std::function<void(bool)>;
+    static void makeProgramAsync(const Pointer& shader, const Shader::BindingSet& bindings, const MakeProgramCallback& callback);
+
     const GPUObjectPointer gpuObject {};
     
 protected:
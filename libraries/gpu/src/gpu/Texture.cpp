@@ -41,6 +41,8 @@ bool recommendedSparseTextures = (QThread::idealThreadCount() >= MIN_CORES_FOR_I
 
 std::atomic<bool> Texture::_enableSparseTextures { recommendedSparseTextures };
 
+std::atomic<Stamp> Texture::_streamedMipsStamp { 0 };
+
 struct ReportTextureState {
     ReportTextureState() {
         qCDebug(gpulogging) << "[TEXTURE TRANSFER SUPPORT]"
@@ -202,6 +204,69 @@ void Texture::MemoryStorage::assignMipFaceData(uint16 level, uint8 face, const s
     }
 }
 
+using StreamingStorage = Texture::StreamingStorage;
+
+StreamingStorage::StreamingStorage(uint16 numMips, uint8 numFaces) :
+    _mips(numMips, std::vector<PixelsPointer>(numFaces)),
+    _minMipAvailable(numMips) {
+}
+
+PixelsPointer StreamingStorage::getMipFace(uint16 level, uint8 face) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (level < _mips.size() && face < _mips[level].size()) {
+        return _mips[level][face];
+    }
+    return PixelsPointer();
+}
+
+void StreamingStorage::assignMipData(uint16 level, const storage::StoragePointer& storagePointer) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (level >= _mips.size()) {
+            return;
+        }
+        // The bytes of all the faces of the mip, in order
+        auto& mip = _mips[level];
+        auto sizePerFace = storagePointer->size() / mip.size();
+        size_t offset = 0;
+        for (auto& face : mip) {
+            face = storagePointer->createView(sizePerFace, offset);
+            offset += sizePerFace;
+        }
+        updateMinMipAvailable();
+    }
+    bumpStamp();
+}
+
+void StreamingStorage::assignMipFaceData(uint16 level, uint8 face, const storage::StoragePointer& storagePointer) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (level >= _mips.size() || face >= _mips[level].size()) {
+            return;
+        }
+        _mips[level][face] = storagePointer;
+        updateMinMipAvailable();
+    }
+    bumpStamp();
+}
+
+void StreamingStorage::updateMinMipAvailable() {
+    // A mip is available once all its faces are, and the smaller ones before it
+    uint16 minMipAvailable = _minMipAvailable;
+    while (minMipAvailable > 0) {
+        const auto& mip = _mips[minMipAvailable - 1];
+        bool isComplete = std::all_of(mip.begin(), mip.end(), [](const PixelsPointer& face) { return face && face->getSize(); });
+        if (!isComplete) {
+            break;
+        }
+        --minMipAvailable;
+    }
+    if (minMipAvailable != _minMipAvailable) {
+        _minMipAvailable = minMipAvailable;
+        ++Texture::_streamedMipsStamp;
+    }
+}
+
 Texture* Texture::createExternal(const ExternalRecycler& recycler, const Sampler& sampler) {
     Texture* tex = new Texture(TextureUsageType::EXTERNAL);
     tex->_type = TEX_2D;
@@ -311,7 +376,7 @@ Texture::Size Texture::resize(Type type, const Element& texelFormat, uint16 widt
         }
         
         // Evaluate the new size with the new format
-        uint32_t size = NUM_FACES_PER_TYPE[_type] *_width * _height * _depth * _numSamples * texelFormat.getSize();
+        uint32_t size = NUM_FACES_PER_TYPE[_type] * texelFormat.evalTexelsSize(_width, _height, _depth) * _numSamples;
 
         // If size change then we need to reset 
         if (changed || (size != getSize())) {
@@ -512,7 +577,7 @@ uint32 Texture::getStoredMipNumTexels(uint16 level) const {
 uint32 Texture::getStoredMipSize(uint16 level) const {
     PixelsPointer mipFace = accessStoredMipFace(level);
     if (mipFace && mipFace->getSize()) {
-        return evalMipWidth(level) * evalMipHeight(level) * evalMipDepth(level) * getTexelFormat().getSize();
+        return evalMipFaceSize(level);
     }
     return 0;
 }
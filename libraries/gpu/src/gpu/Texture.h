@@ -12,7 +12,9 @@
 #define hifi_gpu_Texture_h
 
 #include <algorithm> //min max and more
+#include <atomic>
 #include <bitset>
+#include <mutex>
 
 #include <QMetaType>
 #include <QUrl>
@@ -160,6 +162,7 @@ class Texture : public Resource {
     static std::atomic<Size> _textureCPUMemoryUsage;
     static std::atomic<Size> _allowedCPUMemoryUsage;
     static std::atomic<bool> _enableSparseTextures;
+    static std::atomic<Stamp> _streamedMipsStamp;
     static void updateTextureCPUMemoryUsage(Size prevObjectSize, Size newObjectSize);
 
 public:
@@ -180,6 +183,9 @@ public:
     static bool getEnableSparseTextures();
     static void setEnableSparseTextures(bool enabled);
 
+    // Bumped as mips stream into any texture, for the backends to look at the transfers they were waiting on
+    static Stamp getStreamedMipsStamp() { return _streamedMipsStamp; }
+
     using ExternalRecycler = std::function<void(uint32, void*)>;
     using ExternalIdAndFence = std::pair<uint32, void*>;
     using ExternalUpdates = std::list<ExternalIdAndFence>;
@@ -316,6 +322,28 @@ public:
         friend class Texture;
     };
 
+    // The storage of a texture whose mips stream in after it is made, from the smallest up.
+    // The mips are assigned on the loading thread while the backend reads them, so only the ones
+    // from the smallest down to the first still missing are available.
+    class StreamingStorage : public Storage {
+    public:
+        StreamingStorage(uint16 numMips, uint8 numFaces);
+        void reset() override {}
+        PixelsPointer getMipFace(uint16 level, uint8 face = 0) const override;
+        void assignMipData(uint16 level, const storage::StoragePointer& storage) override;
+        void assignMipFaceData(uint16 level, uint8 face, const storage::StoragePointer& storage) override;
+        bool isMipAvailable(uint16 level, uint8 face = 0) const override { return level >= _minMipAvailable; }
+
+        uint16 getMinMipAvailable() const { return _minMipAvailable; }
+
+    protected:
+        void updateMinMipAvailable();
+
+        mutable std::mutex _mutex;
+        std::vector<std::vector<PixelsPointer>> _mips;
+        std::atomic<uint16> _minMipAvailable;
+    };
+
     static Texture* create1D(const Element& texelFormat, uint16 width, const Sampler& sampler = Sampler());
     static Texture* create2D(const Element& texelFormat, uint16 width, uint16 height, const Sampler& sampler = Sampler());
     static Texture* create3D(const Element& texelFormat, uint16 width, uint16 height, uint16 depth, const Sampler& sampler = Sampler());
@@ -407,14 +435,14 @@ public:
 
     // Size for each face of a mip at a particular level
     uint32 evalMipFaceNumTexels(uint16 level) const { return evalMipWidth(level) * evalMipHeight(level) * evalMipDepth(level); }
-    uint32 evalMipFaceSize(uint16 level) const { return evalMipFaceNumTexels(level) * getTexelFormat().getSize(); }
+    uint32 evalMipFaceSize(uint16 level) const { return evalStoredMipFaceSize(level, getTexelFormat()); }
     
     // Total size for the mip
     uint32 evalMipNumTexels(uint16 level) const { return evalMipFaceNumTexels(level) * getNumFaces(); }
-    uint32 evalMipSize(uint16 level) const { return evalMipNumTexels(level) * getTexelFormat().getSize(); }
+    uint32 evalMipSize(uint16 level) const { return evalStoredMipSize(level, getTexelFormat()); }
 
-    uint32 evalStoredMipFaceSize(uint16 level, const Element& format) const { return evalMipFaceNumTexels(level) * format.getSize(); }
-    uint32 evalStoredMipSize(uint16 level, const Element& format) const { return evalMipNumTexels(level) * format.getSize(); }
+    uint32 evalStoredMipFaceSize(uint16 level, const Element& format) const { return format.evalTexelsSize(evalMipWidth(level), evalMipHeight(level), evalMipDepth(level)); }
+    uint32 evalStoredMipSize(uint16 level, const Element& format) const { return evalStoredMipFaceSize(level, format) * getNumFaces(); }
 
     uint32 evalTotalSize(uint16 startingMip = 0) const {
         uint32 size = 0;
@@ -518,11 +546,19 @@ public:
 
     // Textures can be serialized directly to  ktx data file, here is how
     static ktx::KTXUniquePointer serialize(const Texture& texture);
+    // Or streamed through a ktx::StreamWriter without the copy into a KTX, from the description of their ktx, whose
+    // images point at their stored mips
+    static bool evalKTXDescription(const Texture& texture, ktx::Header& header, ktx::Images& images, ktx::KeyValues& keyValues);
     static Texture* unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType = TextureUsageType::RESOURCE, Usage usage = Usage(), const Sampler::Desc& sampler = Sampler::Desc());
+    // Or made from the header and key values of their ktx alone, in a StreamingStorage their mips are assigned to as they are read
+    static Texture* unserializeHeader(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType = TextureUsageType::RESOURCE, Usage usage = Usage(), const Sampler::Desc& sampler = Sampler::Desc());
     static bool evalKTXFormat(const Element& mipFormat, const Element& texelFormat, ktx::Header& header);
     static bool evalTextureFormat(const ktx::Header& header, Element& mipFormat, Element& texelFormat);
 
 protected:
+    // Reads the textures of a captured frame back as they were made
+    friend class FrameReader;
+
     const TextureUsageType _usageType;
 
     // Should only be accessed internally or by the backend sync function
@@ -564,6 +600,8 @@ protected:
     bool _defined = false;
    
     static Texture* create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, const Sampler& sampler);
+    // The texture described by the header and key values of a ktx, without its mips
+    static Texture* createFromKTXHeader(const ktx::KTX& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler);
 
     Size resize(Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices);
 };
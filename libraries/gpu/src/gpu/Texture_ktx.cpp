@@ -71,13 +71,49 @@ void Texture::setKtxBacking(ktx::KTXUniquePointer& ktxBacking) {
 
 ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     ktx::Header header;
+    ktx::Images images;
+    ktx::KeyValues keyValues;
+    if (!evalKTXDescription(texture, header, images, keyValues)) {
+        return nullptr;
+    }
 
+    auto ktxBuffer = ktx::KTX::create(header, images, keyValues);
+#if 0
+    auto expectedMipCount = texture.evalNumMips();
+    assert(expectedMipCount == ktxBuffer->_images.size());
+    assert(expectedMipCount == header.numberOfMipmapLevels);
+
+    assert(0 == memcmp(&header, ktxBuffer->getHeader(), sizeof(ktx::Header)));
+    assert(ktxBuffer->_images.size() == images.size());
+    auto start = ktxBuffer->_storage->data();
+    for (size_t i = 0; i < images.size(); ++i) {
+        auto expected = images[i];
+        auto actual = ktxBuffer->_images[i];
+        assert(expected._padding == actual._padding);
+        assert(expected._numFaces == actual._numFaces);
+        assert(expected._imageSize == actual._imageSize);
+        assert(expected._faceSize == actual._faceSize);
+        assert(actual._faceBytes.size() == actual._numFaces);
+        for (uint32_t face = 0; face < expected._numFaces; ++face) {
+            auto expectedFace = expected._faceBytes[face];
+            auto actualFace = actual._faceBytes[face];
+            auto offset = actualFace - start;
+            assert(offset % 4 == 0);
+            assert(expectedFace != actualFace);
+            assert(0 == memcmp(expectedFace, actualFace, expected._faceSize));
+        }
+    }
+#endif
+    return ktxBuffer;
+}
+
+bool Texture::evalKTXDescription(const Texture& texture, ktx::Header& header, ktx::Images& images, ktx::KeyValues& keyValues) {
     // From texture format to ktx format description
     auto texelFormat = texture.getTexelFormat();
     auto mipFormat = texture.getStoredMipFormat();
 
     if (!Texture::evalKTXFormat(mipFormat, texelFormat, header)) {
-        return nullptr;
+        return false;
     }
  
     // Set Dimensions
@@ -117,13 +153,13 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
             break;
         }
     default:
-        return nullptr;
+        return false;
     }
 
     // Number level of mips coming
     header.numberOfMipmapLevels = texture.maxMip() + 1;
 
-    ktx::Images images;
+    images.clear();
     for (uint32_t level = 0; level < header.numberOfMipmapLevels; level++) {
         auto mip = texture.accessStoredMipFace(level);
         if (mip) {
@@ -144,44 +180,13 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     keyval._samplerDesc = texture.getSampler().getDesc();
     keyval._usage = texture.getUsage();
     keyval._usageType = texture.getUsageType();
-    ktx::KeyValues keyValues;
+    keyValues.clear();
     keyValues.emplace_back(ktx::KeyValue(GPUKTXPayload::KEY, sizeof(GPUKTXPayload), (ktx::Byte*) &keyval)); 
-
-    auto ktxBuffer = ktx::KTX::create(header, images, keyValues);
-#if 0
-    auto expectedMipCount = texture.evalNumMips();
-    assert(expectedMipCount == ktxBuffer->_images.size());
-    assert(expectedMipCount == header.numberOfMipmapLevels);
-
-    assert(0 == memcmp(&header, ktxBuffer->getHeader(), sizeof(ktx::Header)));
-    assert(ktxBuffer->_images.size() == images.size());
-    auto start = ktxBuffer->_storage->data();
-    for (size_t i = 0; i < images.size(); ++i) {
-        auto expected = images[i];
-        auto actual = ktxBuffer->_images[i];
-        assert(expected._padding == actual._padding);
-        assert(expected._numFaces == actual._numFaces);
-        assert(expected._imageSize == actual._imageSize);
-        assert(expected._faceSize == actual._faceSize);
-        assert(actual._faceBytes.size() == actual._numFaces);
-        for (uint32_t face = 0; face < expected._numFaces; ++face) {
-            auto expectedFace = expected._faceBytes[face];
-            auto actualFace = actual._faceBytes[face];
-            auto offset = actualFace - start;
-            assert(offset % 4 == 0);
-            assert(expectedFace != actualFace);
-            assert(0 == memcmp(expectedFace, actualFace, expected._faceSize));
-        }
-    }
-#endif
-    return ktxBuffer;
+    return true;
 }
 
-Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
-    if (!srcData) {
-        return nullptr;
-    }
-    const auto& header = *srcData->getHeader();
+Texture* Texture::createFromKTXHeader(const ktx::KTX& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
+    const auto& header = *srcData.getHeader();
 
     Format mipFormat = Format::COLOR_BGRA_32;
     Format texelFormat = Format::COLOR_SRGBA_32;
@@ -209,7 +214,7 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
     
     // If found, use the 
     GPUKTXPayload gpuktxKeyValue;
-    bool isGPUKTXPayload = GPUKTXPayload::findInKeyValues(srcData->_keyValues, gpuktxKeyValue);
+    bool isGPUKTXPayload = GPUKTXPayload::findInKeyValues(srcData._keyValues, gpuktxKeyValue);
 
     auto tex = Texture::create( (isGPUKTXPayload ? gpuktxKeyValue._usageType : usageType),
                                 type,
@@ -222,13 +227,27 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
                                 (isGPUKTXPayload ? gpuktxKeyValue._samplerDesc : sampler));
 
     tex->setUsage((isGPUKTXPayload ? gpuktxKeyValue._usage : usage));
-
-    // Assing the mips availables
     tex->setStoredMipFormat(mipFormat);
+
+    return tex;
+}
+
+Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
+    if (!srcData) {
+        return nullptr;
+    }
+    auto tex = createFromKTXHeader(*srcData, usageType, usage, sampler);
+    if (!tex) {
+        return nullptr;
+    }
+
+    // Assing the mips availables, as views of the ktx storage rather than copies,
+    // so the mips of a ktx mapped from a file stay paged in from it
     uint16_t level = 0;
     for (auto& image : srcData->_images) {
         for (uint32_t face = 0; face < image._numFaces; face++) {
-            tex->assignStoredMipFace(level, face, image._faceSize, image._faceBytes[face]);
+            auto mipFace = srcData->getMipFaceTexelsData(level, face);
+            tex->assignStoredMipFace(level, face, mipFace);
         }
         level++;
     }
@@ -236,6 +255,28 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
     return tex;
 }
 
+Texture* Texture::unserializeHeader(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
+    if (!srcData) {
+        return nullptr;
+    }
+    auto tex = createFromKTXHeader(*srcData, usageType, usage, sampler);
+    if (!tex) {
+        return nullptr;
+    }
+
+    const auto& header = *srcData->getHeader();
+    auto format = tex->getStoredMipFormat();
+    std::unique_ptr<Storage> storage { new StreamingStorage(header.getNumberOfLevels(), tex->getNumFaces()) };
+    storage->assignTexture(tex);
+    storage->setFormat(format);
+    tex->setStorage(storage);
+
+    // All the mips come from the ktx rather than being generated
+    tex->_maxMip = header.getNumberOfLevels() - 1;
+
+    return tex;
+}
+
 bool Texture::evalKTXFormat(const Element& mipFormat, const Element& texelFormat, ktx::Header& header) {
     if (texelFormat == Format::COLOR_RGBA_32 && mipFormat == Format::COLOR_BGRA_32) {
         header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::BGRA, ktx::GLInternalFormat_Uncompressed::RGBA8, ktx::GLBaseInternalFormat::RGBA);
@@ -247,6 +288,14 @@ bool Texture::evalKTXFormat(const Element& mipFormat, const Element& texelFormat
         header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::RGBA, ktx::GLInternalFormat_Uncompressed::SRGB8_ALPHA8, ktx::GLBaseInternalFormat::RGBA);
     } else if (texelFormat == Format::COLOR_R_8 && mipFormat == Format::COLOR_R_8) {
         header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::RED, ktx::GLInternalFormat_Uncompressed::R8, ktx::GLBaseInternalFormat::RED);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_RGB_BC1 && mipFormat == Format::COLOR_COMPRESSED_RGB_BC1) {
+        header.setCompressed(ktx::GLInternalFormat_Compressed::COMPRESSED_RGB_S3TC_DXT1, ktx::GLBaseInternalFormat::RGB);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_SRGB_BC1 && mipFormat == Format::COLOR_COMPRESSED_SRGB_BC1) {
+        header.setCompressed(ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_S3TC_DXT1, ktx::GLBaseInternalFormat::RGB);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_RGBA_BC3 && mipFormat == Format::COLOR_COMPRESSED_RGBA_BC3) {
+        header.setCompressed(ktx::GLInternalFormat_Compressed::COMPRESSED_RGBA_S3TC_DXT5, ktx::GLBaseInternalFormat::RGBA);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_SRGBA_BC3 && mipFormat == Format::COLOR_COMPRESSED_SRGBA_BC3) {
+        header.setCompressed(ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT5, ktx::GLBaseInternalFormat::RGBA);
     } else {
         return false;
     }
@@ -282,6 +331,20 @@ bool Texture::evalTextureFormat(const ktx::Header& header, Element& mipFormat, E
         } else {
             return false;
         }
+    } else if (header.getGLFormat() == ktx::GLFormat::COMPRESSED_FORMAT && header.getGLType() == ktx::GLType::COMPRESSED_TYPE) {
+        // The compressed mips are stored in the format they are sampled with
+        if (header.getGLInternaFormat_Compressed() == ktx::GLInternalFormat_Compressed::COMPRESSED_RGB_S3TC_DXT1) {
+            texelFormat = Format::COLOR_COMPRESSED_RGB_BC1;
+        } else if (header.getGLInternaFormat_Compressed() == ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_S3TC_DXT1) {
+            texelFormat = Format::COLOR_COMPRESSED_SRGB_BC1;
+        } else if (header.getGLInternaFormat_Compressed() == ktx::GLInternalFormat_Compressed::COMPRESSED_RGBA_S3TC_DXT5) {
+            texelFormat = Format::COLOR_COMPRESSED_RGBA_BC3;
+        } else if (header.getGLInternaFormat_Compressed() == ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT5) {
+            texelFormat = Format::COLOR_COMPRESSED_SRGBA_BC3;
+        } else {
+            return false;
+        }
+        mipFormat = texelFormat;
     } else {
         return false;
     }
@@ -47,6 +47,9 @@ public:
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) final { }
+    virtual FramebufferReadbackPointer startFramebufferReadback(const FramebufferPointer& srcFramebuffer, const Vec4i& region) final {
+        return FramebufferReadbackPointer();
+    }
 };
 
 } }
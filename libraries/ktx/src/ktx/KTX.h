@@ -13,6 +13,7 @@
 #define hifi_ktx_KTX_h
 
 #include <array>
+#include <functional>
 #include <list>
 #include <vector>
 #include <cstdint>
@@ -246,6 +247,12 @@ namespace ktx {
         COMPRESSED_SRGB = 0x8C48,
         COMPRESSED_SRGB_ALPHA = 0x8C49,
 
+        // EXT_texture_compression_s3tc and EXT_texture_sRGB
+        COMPRESSED_RGB_S3TC_DXT1 = 0x83F0,
+        COMPRESSED_SRGB_S3TC_DXT1 = 0x8C4C,
+        COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3,
+        COMPRESSED_SRGB_ALPHA_S3TC_DXT5 = 0x8C4F,
+
         COMPRESSED_RED_RGTC1 = 0x8DBB,
         COMPRESSED_SIGNED_RED_RGTC1 = 0x8DBC,
         COMPRESSED_RG_RGTC2 = 0x8DBD,
@@ -268,7 +275,7 @@ namespace ktx {
         COMPRESSED_RG11_EAC = 0x9272,
         COMPRESSED_SIGNED_RG11_EAC = 0x9273,
 
-         NUM_COMPRESSED_GLINTERNALFORMATS = 24,
+         NUM_COMPRESSED_GLINTERNALFORMATS = 28,
     };
  
     enum class GLBaseInternalFormat : uint32_t {
@@ -438,6 +445,35 @@ namespace ktx {
     };
     using Images = std::vector<Image>;
 
+    // Write a KTX to a sink section by section, as the sections come, rather than serialize it whole into a Storage:
+    //   the header and the key values on construction, then every level in order, each as soon as it's produced.
+    //   The sink takes the bytes in order (to a file, or a mapped region) and returns false to stop the writing.
+    class StreamWriter {
+    public:
+        using Sink = std::function<bool(const Byte* bytes, size_t byteSize)>;
+
+        StreamWriter(const Header& header, const KeyValues& keyValues, const Sink& sink);
+
+        // The next level, with as many faces as the header
+        bool writeImage(const Image& image);
+
+        bool isValid() const { return _valid; }
+        // Whether every level of the header was written
+        bool isComplete() const { return _valid && _numWrittenLevels == _numLevels; }
+        size_t getWrittenSize() const { return _writtenSize; }
+
+    private:
+        bool write(const Byte* bytes, size_t byteSize);
+        bool writePadding(uint32_t padding);
+
+        Sink _sink;
+        uint32_t _numLevels;
+        uint32_t _numFaces;
+        uint32_t _numWrittenLevels { 0 };
+        size_t _writtenSize { 0 };
+        bool _valid { true };
+    };
+
     class KTX {
         void resetStorage(const StoragePointer& src);
 
@@ -467,10 +503,19 @@ namespace ktx {
         static size_t writeKeyValues(Byte* destBytes, size_t destByteSize, const KeyValues& keyValues);
         static Images writeImages(Byte* destBytes, size_t destByteSize, const Images& images);
 
+        // Or, without a destination of the whole size, to a StreamWriter sink: the size written, 0 if it failed
+        static size_t write(const StreamWriter::Sink& sink, const Header& header, const Images& images, const KeyValues& keyValues = KeyValues());
+
         // Parse a block of memory and create a KTX object from it
         static std::unique_ptr<KTX> create(const StoragePointer& src);
 
         static bool checkHeaderFromStorage(size_t srcSize, const Byte* srcBytes);
+
+        // Check the header, and the offsets and sizes of the key values and of every level against the size of the
+        // storage, without reading the images (of a mapped file, only the pages of the sizes are touched).
+        // The levels can stop short of the header's count, at the end of one, as KTX::create reads them.
+        static bool validate(size_t srcSize, const Byte* srcBytes);
+        static bool validate(const StoragePointer& src);
         static KeyValues parseKeyValues(size_t srcSize, const Byte* srcBytes);
         static Images parseImages(const Header& header, size_t srcSize, const Byte* srcBytes);
 
@@ -91,6 +91,65 @@ namespace ktx {
         }
     }
 
+    bool KTX::validate(size_t srcSize, const Byte* srcBytes) {
+        if (!checkHeaderFromStorage(srcSize, srcBytes)) {
+            return false;
+        }
+        try {
+            Header header;
+            memcpy(&header, srcBytes, sizeof(Header));
+
+            // Key values, each within their section
+            size_t offset = sizeof(Header);
+            size_t keyValuesEnd = offset + header.bytesOfKeyValueData;
+            while (offset < keyValuesEnd) {
+                if (offset + sizeof(uint32_t) > keyValuesEnd) {
+                    throw ReaderException("key-value size past the key-value data");
+                }
+                uint32_t keyAndValueByteSize;
+                memcpy(&keyAndValueByteSize, srcBytes + offset, sizeof(uint32_t));
+                offset += sizeof(uint32_t);
+                if (keyAndValueByteSize > keyValuesEnd - offset) {
+                    throw ReaderException("key-value past the key-value data");
+                }
+                offset += keyAndValueByteSize + Header::evalPadding(keyAndValueByteSize);
+            }
+
+            // Levels, each within the storage
+            auto numLevels = header.getNumberOfLevels();
+            for (uint32_t level = 0; level < numLevels && offset < srcSize; level++) {
+                if (offset + sizeof(uint32_t) > srcSize) {
+                    throw ReaderException("image size past the end of the data");
+                }
+                uint32_t imageSize;
+                memcpy(&imageSize, srcBytes + offset, sizeof(uint32_t));
+                offset += sizeof(uint32_t);
+                if (header.numberOfFaces == NUM_CUBEMAPFACES && (imageSize % NUM_CUBEMAPFACES) != 0) {
+                    throw ReaderException("cube image size isn't a multiple of its faces");
+                }
+                if (imageSize > srcSize - offset) {
+                    throw ReaderException("image past the end of the data");
+                }
+                offset += imageSize + Header::evalPadding(imageSize);
+            }
+            if (offset > srcSize) {
+                throw ReaderException("image padding past the end of the data");
+            }
+            if (offset < srcSize) {
+                throw ReaderException("data past the last image");
+            }
+            return true;
+        }
+        catch (const ReaderException& e) {
+            qWarning() << e.what();
+            return false;
+        }
+    }
+
+    bool KTX::validate(const StoragePointer& src) {
+        return src && validate(src->size(), src->data());
+    }
+
     KeyValue KeyValue::parseSerializedKeyAndValue(uint32_t srcSize, const Byte* srcBytes) {
         uint32_t keyAndValueByteSize;
         memcpy(&keyAndValueByteSize, srcBytes, sizeof(uint32_t));
@@ -10,6 +10,7 @@
 //
 #include "KTX.h"
 
+#include <algorithm>
 
 #include <QtGlobal>
 #include <QtCore/QDebug>
@@ -87,6 +88,88 @@ namespace ktx {
         return destByteSize;
     }
 
+    size_t KTX::write(const StreamWriter::Sink& sink, const Header& header, const Images& images, const KeyValues& keyValues) {
+        StreamWriter writer(header, keyValues, sink);
+        auto numMips = header.getNumberOfLevels();
+        for (uint32_t l = 0; l < numMips && l < images.size(); l++) {
+            if (!writer.writeImage(images[l])) {
+                return 0;
+            }
+        }
+        return writer.isValid() ? writer.getWrittenSize() : 0;
+    }
+
+    StreamWriter::StreamWriter(const Header& header, const KeyValues& keyValues, const Sink& sink) :
+        _sink(sink),
+        _numLevels(header.getNumberOfLevels()),
+        _numFaces(header.numberOfFaces)
+    {
+        // Header, with the size of the key values that follow it
+        Header destHeader = header;
+        destHeader.bytesOfKeyValueData = keyValues.empty() ? 0 : KeyValue::serializedKeyValuesByteSize(keyValues);
+        if (!write(reinterpret_cast<const Byte*>(&destHeader), sizeof(Header))) {
+            return;
+        }
+
+        // KeyValues, one at a time through a buffer of the largest, padding included
+        std::vector<Byte> keyValueBytes;
+        uint32_t keyValuesSize = 0;
+        for (auto& keyval : keyValues) {
+            uint32_t keyvalSize = keyval.serializedByteSize();
+            keyValueBytes.assign(keyvalSize, 0);
+            KeyValue::writeSerializedKeyAndValue(keyValueBytes.data(), keyvalSize, keyval);
+            if (!write(keyValueBytes.data(), keyvalSize)) {
+                return;
+            }
+            keyValuesSize += keyvalSize;
+        }
+        writePadding(destHeader.bytesOfKeyValueData - keyValuesSize);
+    }
+
+    bool StreamWriter::writeImage(const Image& image) {
+        if (!_valid || _numWrittenLevels >= _numLevels) {
+            _valid = false;
+            return false;
+        }
+        if (image._numFaces != (_numFaces == NUM_CUBEMAPFACES ? NUM_CUBEMAPFACES : 1) || image._faceBytes.size() != image._numFaces) {
+            qWarning() << WriterException("image faces don't match the header").what();
+            _valid = false;
+            return false;
+        }
+
+        uint32_t imageSize = image._imageSize;
+        if (!write(reinterpret_cast<const Byte*>(&imageSize), sizeof(uint32_t))) {
+            return false;
+        }
+        for (uint32_t face = 0; face < image._numFaces; face++) {
+            if (!write(image._faceBytes[face], image._faceSize)) {
+                return false;
+            }
+        }
+        if (!writePadding(Header::evalPadding(imageSize))) {
+            return false;
+        }
+        _numWrittenLevels++;
+        return true;
+    }
+
+    bool StreamWriter::write(const Byte* bytes, size_t byteSize) {
+        if (!_valid) {
+            return false;
+        }
+        if (byteSize > 0 && !_sink(bytes, byteSize)) {
+            _valid = false;
+            return false;
+        }
+        _writtenSize += byteSize;
+        return true;
+    }
+
+    bool StreamWriter::writePadding(uint32_t padding) {
+        static const Byte ZEROS[PACKING_SIZE] { 0 };
+        return write(ZEROS, std::min(padding, PACKING_SIZE));
+    }
+
     uint32_t KeyValue::writeSerializedKeyAndValue(Byte* destBytes, uint32_t destByteSize, const KeyValue& keyval) {
         uint32_t keyvalSize = keyval.serializedByteSize();
         if (keyvalSize > destByteSize) {
@@ -26,6 +26,11 @@ KTXFilePointer KTXCache::writeFile(const char* data, Metadata&& metadata) {
     return std::static_pointer_cast<KTXFile>(file);
 }
 
+KTXFilePointer KTXCache::writeFile(Metadata&& metadata, const DataProducer& produce) {
+    FilePointer file = FileCache::writeFile(std::move(metadata), produce);
+    return std::static_pointer_cast<KTXFile>(file);
+}
+
 KTXFilePointer KTXCache::getFile(const Key& key) {
     return std::static_pointer_cast<KTXFile>(FileCache::getFile(key));
 }
@@ -30,6 +30,7 @@ public:
     KTXCache(const std::string& dir, const std::string& ext);
 
     KTXFilePointer writeFile(const char* data, Metadata&& metadata);
+    KTXFilePointer writeFile(Metadata&& metadata, const DataProducer& produce);
     KTXFilePointer getFile(const Key& key);
 
 protected:
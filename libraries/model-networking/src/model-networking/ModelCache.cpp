@@ -114,6 +114,7 @@ void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
         _fbxGeometry = _geometryResource->_fbxGeometry;
         _meshParts = _geometryResource->_meshParts;
         _meshes = _geometryResource->_meshes;
+        _triangleSetsCache = _geometryResource->_triangleSetsCache;
         _materials = _geometryResource->_materials;
 
         // Avoid holding onto extra references
@@ -206,6 +207,26 @@ void GeometryReader::run() {
     }
 }
 
+// Computes the triangle sets of a geometry for picking, at low priority, after the geometry is read
+class TriangleSetsBuilder : public QRunnable {
+public:
+    TriangleSetsBuilder(std::shared_ptr<const FBXGeometry> fbxGeometry,
+        std::shared_ptr<Geometry::TriangleSetsCache> triangleSetsCache) :
+        _fbxGeometry(fbxGeometry), _triangleSetsCache(triangleSetsCache) {}
+
+    virtual void run() override {
+        QThread::currentThread()->setPriority(QThread::LowPriority);
+        Finally setPriorityBackToNormal([]() {
+            QThread::currentThread()->setPriority(QThread::NormalPriority);
+        });
+        _triangleSetsCache->compute(*_fbxGeometry);
+    }
+
+private:
+    std::shared_ptr<const FBXGeometry> _fbxGeometry;
+    std::shared_ptr<Geometry::TriangleSetsCache> _triangleSetsCache;
+};
+
 class GeometryDefinitionResource : public GeometryResource {
     Q_OBJECT
 public:
@@ -254,6 +275,10 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     }
     _meshes = meshes;
     _meshParts = parts;
+    _triangleSetsCache = std::make_shared<TriangleSetsCache>();
+
+    // the triangles for picking are ready before the first pick, rather than computed by it
+    QThreadPool::globalInstance()->start(new TriangleSetsBuilder(_fbxGeometry, _triangleSetsCache));
 
     finishedLoading(true);
 }
@@ -308,6 +333,7 @@ Geometry::Geometry(const Geometry& geometry) {
     _fbxGeometry = geometry._fbxGeometry;
     _meshes = geometry._meshes;
     _meshParts = geometry._meshParts;
+    _triangleSetsCache = geometry._triangleSetsCache;
 
     _materials.reserve(geometry._materials.size());
     for (const auto& material : geometry._materials) {
@@ -388,6 +414,94 @@ const std::shared_ptr<const NetworkMaterial> Geometry::getShapeMaterial(int part
     return nullptr;
 }
 
+void Geometry::TriangleSetsCache::compute(const FBXGeometry& geometry) {
+    std::call_once(computed, [this, &geometry] {
+        PROFILE_RANGE(render, "calculateTriangleSets");
+
+        int numberOfMeshes = geometry.meshes.size();
+        triangleSets.resize(numberOfMeshes);
+
+        for (int i = 0; i < numberOfMeshes; i++) {
+            const FBXMesh& mesh = geometry.meshes.at(i);
+
+            for (int j = 0; j < mesh.parts.size(); j++) {
+                const FBXMeshPart& part = mesh.parts.at(j);
+
+                const int INDICES_PER_TRIANGLE = 3;
+                const int INDICES_PER_QUAD = 4;
+                const int TRIANGLES_PER_QUAD = 2;
+
+                // tell our triangleSet how many triangles to expect.
+                int numberOfQuads = part.quadIndices.size() / INDICES_PER_QUAD;
+                int numberOfTris = part.triangleIndices.size() / INDICES_PER_TRIANGLE;
+                int totalTriangles = (numberOfQuads * TRIANGLES_PER_QUAD) + numberOfTris;
+                triangleSets[i].reserve(triangleSets[i].size() + totalTriangles);
+
+                auto meshTransform = geometry.offset * mesh.modelTransform;
+
+                if (part.quadIndices.size() > 0) {
+                    int vIndex = 0;
+                    for (int q = 0; q < numberOfQuads; q++) {
+                        int i0 = part.quadIndices[vIndex++];
+                        int i1 = part.quadIndices[vIndex++];
+                        int i2 = part.quadIndices[vIndex++];
+                        int i3 = part.quadIndices[vIndex++];
+
+                        // track the model space version... these points will be transformed by the FST's offset, 
+                        // which includes the scaling, rotation, and translation specified by the FST/FBX, 
+                        // this can't change at runtime, so we can safely store these in our TriangleSet
+                        glm::vec3 v0 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i0], 1.0f));
+                        glm::vec3 v1 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i1], 1.0f));
+                        glm::vec3 v2 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i2], 1.0f));
+                        glm::vec3 v3 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i3], 1.0f));
+
+                        Triangle tri1 = { v0, v1, v3 };
+                        Triangle tri2 = { v1, v2, v3 };
+                        triangleSets[i].insert(tri1);
+                        triangleSets[i].insert(tri2);
+                    }
+                }
+
+                if (part.triangleIndices.size() > 0) {
+                    int vIndex = 0;
+                    for (int t = 0; t < numberOfTris; t++) {
+                        int i0 = part.triangleIndices[vIndex++];
+                        int i1 = part.triangleIndices[vIndex++];
+                        int i2 = part.triangleIndices[vIndex++];
+
+                        // track the model space version... these points will be transformed by the FST's offset, 
+                        // which includes the scaling, rotation, and translation specified by the FST/FBX, 
+                        // this can't change at runtime, so we can safely store these in our TriangleSet
+                        glm::vec3 v0 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i0], 1.0f));
+                        glm::vec3 v1 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i1], 1.0f));
+                        glm::vec3 v2 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i2], 1.0f));
+
+                        Triangle tri = { v0, v1, v2 };
+                        triangleSets[i].insert(tri);
+                    }
+                }
+            }
+        }
+
+        // the hierarchies are built while the sets are only seen by this thread
+        for (auto& triangleSet : triangleSets) {
+            triangleSet.buildBVH();
+        }
+    });
+}
+
+std::shared_ptr<const Geometry::MeshTriangleSets> Geometry::getMeshTriangleSets() const {
+    if (!_fbxGeometry || !_triangleSetsCache) {
+        return std::make_shared<MeshTriangleSets>();
+    }
+
+    auto cache = _triangleSetsCache;
+    cache->compute(*_fbxGeometry);
+
+    // Keep the cache alive for as long as the triangles are used, even if this geometry is gone
+    return std::shared_ptr<const MeshTriangleSets>(cache, &cache->triangleSets);
+}
+
 void GeometryResource::deleter() {
     resetTextures();
     Resource::deleter();
@@ -12,8 +12,11 @@
 #ifndef hifi_ModelCache_h
 #define hifi_ModelCache_h
 
+#include <mutex>
+
 #include <DependencyManager.h>
 #include <ResourceCache.h>
+#include <TriangleSet.h>
 
 #include <model/Material.h>
 #include <model/Asset.h>
@@ -56,13 +59,28 @@ public:
     virtual bool areTexturesLoaded() const;
     const QUrl& getAnimGraphOverrideUrl() const { return _animGraphOverrideUrl; }
 
+    // The model space triangles of each mesh, for picking, computed once for all the copies of the geometry
+    using MeshTriangleSets = std::vector<TriangleSet>;
+    std::shared_ptr<const MeshTriangleSets> getMeshTriangleSets() const;
+
 protected:
     friend class GeometryMappingResource;
+    friend class TriangleSetsBuilder;
+
+    class TriangleSetsCache {
+    public:
+        // computes the triangle sets and their hierarchies the first time it's called, on whichever thread that is
+        void compute(const FBXGeometry& geometry);
+
+        std::once_flag computed;
+        MeshTriangleSets triangleSets;
+    };
 
     // Shared across all geometries, constant throughout lifetime
     std::shared_ptr<const FBXGeometry> _fbxGeometry;
     std::shared_ptr<const GeometryMeshes> _meshes;
     std::shared_ptr<const GeometryMeshParts> _meshParts;
+    std::shared_ptr<TriangleSetsCache> _triangleSetsCache;
 
     // Copied to each geometry, mutable throughout lifetime via setTextures
     NetworkMaterials _materials;
@@ -31,7 +31,9 @@
 
 #include <ktx/KTX.h>
 
+#include <AssetUtils.h>
 #include <NumericalConstants.h>
+#include <ResourceManager.h>
 #include <shared/NsightHelpers.h>
 
 #include <Finally.h>
@@ -346,6 +348,9 @@ NetworkTexture::NetworkTexture(const QUrl& url, Type type, const QByteArray& con
         _loaded = true;
     }
 
+    initBakedUrl();
+    initKTXStreaming();
+
     // if we have content, load it after we have our self pointer
     if (!content.isEmpty()) {
         _startedLoading = true;
@@ -353,6 +358,44 @@ NetworkTexture::NetworkTexture(const QUrl& url, Type type, const QByteArray& con
     }
 }
 
+void NetworkTexture::init() {
+    Resource::init();
+    initBakedUrl();
+    initKTXStreaming();
+}
+
+void NetworkTexture::initBakedUrl() {
+    // The asset-server bakes the images of assets into the compressed textures the color types load them in,
+    // so prefer those for the ATP paths
+    bool isColorTexture = (_type == ALBEDO_TEXTURE || _type == EMISSIVE_TEXTURE || _type == LIGHTMAP_TEXTURE);
+    if (isColorTexture && _url.scheme() == URL_SCHEME_ATP && _url.path().startsWith("/") && isBakeableTexturePath(_url.path())) {
+        _activeUrl.setQuery(BAKED_TEXTURE_QUERY);
+    }
+}
+
+// The KTX made from an image costs decoding, mipping and compressing it again besides its download, so it's kept longer
+static const float KTX_FROM_IMAGE_COST = 4.0f;
+
+// Enough for the header and the key values gpu writes in its KTX files
+static const int64_t KTX_HEADER_REQUEST_SIZE = 1024;
+// The mips at most this size make the texture first seen, as the backends allocate it at them
+static const uint32_t KTX_LOW_MIP_DIMENSION = 64;
+
+void NetworkTexture::initKTXStreaming() {
+    _ktxTexture.reset();
+    _ktxMipRanges.clear();
+
+    // Baked textures come as KTX from the asset-server
+    bool isKTXUrl = _activeUrl.path().endsWith(".ktx", Qt::CaseInsensitive) || _activeUrl.query() == BAKED_TEXTURE_QUERY;
+    if (isKTXUrl) {
+        _ktxLoadState = KTX_LOADING_HEADER;
+        _requestByteRange.fromInclusive = 0;
+        _requestByteRange.toExclusive = KTX_HEADER_REQUEST_SIZE;
+    } else {
+        _ktxLoadState = KTX_NOT_STREAMED;
+    }
+}
+
 NetworkTexture::TextureLoaderFunc NetworkTexture::getTextureLoader() const {
     if (_type == CUSTOM_TEXTURE) {
         return _textureLoader;
@@ -416,7 +459,161 @@ private:
 };
 
 void NetworkTexture::downloadFinished(const QByteArray& data) {
-    loadContent(data);
+    switch (_ktxLoadState) {
+        case KTX_LOADING_HEADER:
+            handleKTXHeader(data);
+            break;
+
+        case KTX_LOADING_LOW_MIPS:
+            handleKTXLowMips(data);
+            break;
+
+        case KTX_LOADING_MIP:
+            handleKTXMip(data);
+            break;
+
+        default:
+            loadContent(data);
+            break;
+    }
+}
+
+float NetworkTexture::getLoadPriority() {
+    if (_ktxLoadState == KTX_LOADING_MIP) {
+        return -(float)_ktxMipRanges[_ktxNextMip].size();
+    }
+    return Resource::getLoadPriority();
+}
+
+void NetworkTexture::handleFailedRequest(ResourceRequest::Result result) {
+    if (_ktxLoadState == KTX_LOADING_MIP) {
+        // The texture was already seen, it keeps the mips it has
+        qCWarning(modelnetworking) << "Stopped streaming" << _url << "at mip" << _ktxNextMip + 1;
+        _ktxLoadState = KTX_STREAMED;
+        _ktxTexture.reset();
+        return;
+    }
+    Resource::handleFailedRequest(result);
+}
+
+void NetworkTexture::requestKTXRange(KTXLoadState state, const ByteRange& byteRange) {
+    _ktxLoadState = state;
+    _requestByteRange = byteRange;
+
+    // Queued, as the request that just finished is still being released
+    QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
+}
+
+void NetworkTexture::requestWholeFile() {
+    _ktxTexture.reset();
+    _ktxMipRanges.clear();
+    requestKTXRange(KTX_NOT_STREAMED, ByteRange());
+}
+
+void NetworkTexture::handleKTXHeader(const QByteArray& data) {
+    // A file shorter than the range came whole
+    if (data.size() < KTX_HEADER_REQUEST_SIZE) {
+        _ktxLoadState = KTX_NOT_STREAMED;
+        loadContent(data);
+        return;
+    }
+
+    // Files that are not KTX, or have more key values than fit the range, load whole
+    auto bytes = reinterpret_cast<const ktx::Byte*>(data.data());
+    if (!ktx::KTX::checkHeaderFromStorage(data.size(), bytes)) {
+        requestWholeFile();
+        return;
+    }
+    auto ktx = ktx::KTX::create(std::make_shared<storage::MemoryStorage>(data.size(), bytes));
+    if (ktx) {
+        _ktxTexture.reset(gpu::Texture::unserializeHeader(ktx));
+    }
+    if (!_ktxTexture) {
+        requestWholeFile();
+        return;
+    }
+
+    const auto& header = *ktx->getHeader();
+    const auto& mipFormat = _ktxTexture->getStoredMipFormat();
+    uint16_t numLevels = (uint16_t)header.getNumberOfLevels();
+    int64_t offset = sizeof(ktx::Header) + header.bytesOfKeyValueData;
+    _ktxMipRanges.resize(numLevels);
+    for (uint16_t level = 0; level < numLevels; level++) {
+        size_t imageSize = _ktxTexture->evalStoredMipSize(level, mipFormat);
+        _ktxMipRanges[level].fromInclusive = offset;
+        _ktxMipRanges[level].toExclusive = offset + sizeof(uint32_t) + imageSize;
+        offset = _ktxMipRanges[level].toExclusive + ktx::Header::evalPadding(imageSize);
+    }
+
+    _ktxLowMip = 0;
+    while (_ktxLowMip < numLevels - 1) {
+        auto dimensions = _ktxTexture->evalMipDimensions(_ktxLowMip);
+        if (dimensions.x <= KTX_LOW_MIP_DIMENSION && dimensions.y <= KTX_LOW_MIP_DIMENSION) {
+            break;
+        }
+        _ktxLowMip++;
+    }
+
+    ByteRange lowMipsRange;
+    lowMipsRange.fromInclusive = _ktxMipRanges[_ktxLowMip].fromInclusive;
+    lowMipsRange.toExclusive = _ktxMipRanges.back().toExclusive;
+    requestKTXRange(KTX_LOADING_LOW_MIPS, lowMipsRange);
+}
+
+bool NetworkTexture::assignKTXMip(uint16_t level, const QByteArray& data, int64_t dataOffset) {
+    const auto& range = _ktxMipRanges[level];
+    int64_t offset = range.fromInclusive - dataOffset;
+    if (offset < 0 || offset + range.size() > data.size()) {
+        return false;
+    }
+
+    // The size written before the image tells whether the ranges were evaluated right
+    uint32_t imageSize = (uint32_t)(range.size() - sizeof(uint32_t));
+    const char* bytes = data.constData() + offset;
+    if (*reinterpret_cast<const uint32_t*>(bytes) != imageSize) {
+        return false;
+    }
+    _ktxTexture->assignStoredMip(level, imageSize, reinterpret_cast<const gpu::Byte*>(bytes + sizeof(uint32_t)));
+    return true;
+}
+
+void NetworkTexture::handleKTXLowMips(const QByteArray& data) {
+    for (uint16_t level = _ktxLowMip; level < _ktxMipRanges.size(); level++) {
+        if (!assignKTXMip(level, data, _requestByteRange.fromInclusive)) {
+            qCWarning(modelnetworking) << "Unexpected mip layout, loading whole" << _url;
+            requestWholeFile();
+            return;
+        }
+    }
+
+    auto texture = _ktxTexture;
+    setImage(texture, texture->getWidth(), texture->getHeight());
+
+    if (_ktxLowMip > 0) {
+        _ktxNextMip = _ktxLowMip - 1;
+        requestKTXRange(KTX_LOADING_MIP, _ktxMipRanges[_ktxNextMip]);
+    } else {
+        _ktxLoadState = KTX_STREAMED;
+        _ktxTexture.reset();
+    }
+}
+
+void NetworkTexture::handleKTXMip(const QByteArray& data) {
+    if (!assignKTXMip(_ktxNextMip, data, _requestByteRange.fromInclusive)) {
+        qCWarning(modelnetworking) << "Unexpected mip layout, stopped streaming" << _url << "at mip" << _ktxNextMip + 1;
+        _ktxLoadState = KTX_STREAMED;
+        _ktxTexture.reset();
+        return;
+    }
+    setSize(_ktxTexture->getStoredSize());
+
+    if (_ktxNextMip > 0) {
+        _ktxNextMip--;
+        requestKTXRange(KTX_LOADING_MIP, _ktxMipRanges[_ktxNextMip]);
+    } else {
+        _ktxLoadState = KTX_STREAMED;
+        _ktxTexture.reset();
+    }
 }
 
 void NetworkTexture::loadContent(const QByteArray& content) {
@@ -437,6 +634,12 @@ void NetworkTexture::loadContent(const QByteArray& content) {
         // If there is no live texture, check if there's an existing KTX file
         if (!texture) {
             KTXFilePointer ktxFile = textureCache->_ktxCache.getFile(hash);
+
+            // Baked textures are downloaded as KTX already, cache them as they are
+            if (!ktxFile && ktx::KTX::validate(content.size(), reinterpret_cast<const ktx::Byte*>(content.data()))) {
+                ktxFile = textureCache->_ktxCache.writeFile(content.data(), KTXCache::Metadata(hash, content.size()));
+            }
+
             if (ktxFile) {
                 // Ensure that the KTX deserialization worked
                 auto ktx = ktxFile->getKTX();
@@ -571,18 +774,25 @@ void ImageReader::read() {
         }
 
         auto textureCache = DependencyManager::get<TextureCache>();
-        // Save the image into a KTXFile
-        auto memKtx = gpu::Texture::serialize(*texture);
-        if (!memKtx) {
+        // Save the image into a KTXFile, its mips streamed to the file rather than copied into a KTX first
+        ktx::Header header;
+        ktx::Images images;
+        ktx::KeyValues keyValues;
+        bool described = gpu::Texture::evalKTXDescription(*texture, header, images, keyValues);
+        if (!described) {
             qCWarning(modelnetworking) << "Unable to serialize texture to KTX " << _url;
         }
 
-        if (memKtx && textureCache) {
-            const char* data = reinterpret_cast<const char*>(memKtx->_storage->data());
-            size_t length = memKtx->_storage->size();
+        if (described && textureCache) {
+            size_t length = ktx::KTX::evalStorageSize(header, images, keyValues);
+            auto writeKTX = [&](const KTXCache::DataWriter& writer) {
+                return ktx::KTX::write([&](const ktx::Byte* bytes, size_t byteSize) {
+                    return writer(reinterpret_cast<const char*>(bytes), byteSize);
+                }, header, images, keyValues) == length;
+            };
             KTXFilePointer file;
             auto& ktxCache = textureCache->_ktxCache;
-            if (!memKtx || !(file = ktxCache.writeFile(data, KTXCache::Metadata(_hash, length)))) {
+            if (!(file = ktxCache.writeFile(KTXCache::Metadata(_hash, length, KTX_FROM_IMAGE_COST), writeKTX))) {
                 qCWarning(modelnetworking) << _url << "file cache failed";
             } else {
                 resource.staticCast<NetworkTexture>()->_file = file;
@@ -82,10 +82,15 @@ signals:
     void networkTextureCreated(const QWeakPointer<NetworkTexture>& self);
 
 protected:
+    virtual void init() override;
     virtual bool isCacheable() const override { return _loaded; }
 
     virtual void downloadFinished(const QByteArray& data) override;
 
+    // The mips streamed in after the texture is seen are requested smallest first, behind the textures waiting to be seen
+    virtual float getLoadPriority() override;
+    virtual void handleFailedRequest(ResourceRequest::Result result) override;
+
     Q_INVOKABLE void loadContent(const QByteArray& content);
     Q_INVOKABLE void setImage(gpu::TexturePointer texture, int originalWidth, int originalHeight);
 
@@ -93,6 +98,26 @@ private:
     friend class KTXReader;
     friend class ImageReader;
 
+    // KTX files are streamed in over ranges of their bytes: the header and key values first, then
+    // the mips small enough for the texture to be seen with, then the larger mips one at a time
+    enum KTXLoadState {
+        KTX_NOT_STREAMED,
+        KTX_LOADING_HEADER,
+        KTX_LOADING_LOW_MIPS,
+        KTX_LOADING_MIP,
+        KTX_STREAMED
+    };
+
+    void initBakedUrl();
+    void initKTXStreaming();
+
+    void handleKTXHeader(const QByteArray& data);
+    void handleKTXLowMips(const QByteArray& data);
+    void handleKTXMip(const QByteArray& data);
+    bool assignKTXMip(uint16_t level, const QByteArray& data, int64_t dataOffset);
+    void requestKTXRange(KTXLoadState state, const ByteRange& byteRange);
+    void requestWholeFile();
+
     Type _type;
     TextureLoaderFunc _textureLoader { [](const QImage&, const std::string&){ return nullptr; } };
     KTXFilePointer _file;
@@ -101,6 +126,13 @@ private:
     int _width { 0 };
     int _height { 0 };
     int _maxNumPixels { ABSOLUTE_MAX_TEXTURE_NUM_PIXELS };
+
+    KTXLoadState _ktxLoadState { KTX_NOT_STREAMED };
+    gpu::TexturePointer _ktxTexture;
+    // The range of each mip in the file, with the size before its image and the padding after
+    std::vector<ByteRange> _ktxMipRanges;
+    uint16_t _ktxLowMip { 0 };
+    uint16_t _ktxNextMip { 0 };
 };
 
 using NetworkTexturePointer = QSharedPointer<NetworkTexture>;
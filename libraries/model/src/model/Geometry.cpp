@@ -26,7 +26,9 @@ Mesh::Mesh(const Mesh& mesh) :
     _vertexBuffer(mesh._vertexBuffer),
     _attributeBuffers(mesh._attributeBuffers),
     _indexBuffer(mesh._indexBuffer),
-    _partBuffer(mesh._partBuffer) {
+    _partBuffer(mesh._partBuffer),
+    _lodIndexBuffer(mesh._lodIndexBuffer),
+    _partLODs(mesh._partLODs) {
 }
 
 Mesh::~Mesh() {
@@ -111,6 +113,25 @@ Box Mesh::evalPartBound(int partNum) const {
     return box;
 }
 
+void Mesh::setLODs(const BufferView& lodIndexBuffer, const PartLODs& partLODs) {
+    _lodIndexBuffer = lodIndexBuffer;
+    _partLODs = partLODs;
+}
+
+int Mesh::getNumPartLODs(int partNum) const {
+    if (partNum >= 0 && partNum < (int)_partLODs.size()) {
+        return 1 + (int)_partLODs[partNum].size();
+    }
+    return 1;
+}
+
+Mesh::Part Mesh::getPartLOD(int partNum, int lod) const {
+    if (lod > 0 && partNum >= 0 && partNum < (int)_partLODs.size() && lod <= (int)_partLODs[partNum].size()) {
+        return _partLODs[partNum][lod - 1];
+    }
+    return _partBuffer.get<Part>(partNum);
+}
+
 Box Mesh::evalPartsBound(int partStart, int partEnd) const {
     Box totalBound;
     auto part = _partBuffer.cbegin<Part>() + partStart;
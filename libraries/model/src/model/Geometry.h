@@ -118,6 +118,14 @@ public:
 
     static gpu::Primitive topologyToPrimitive(Topology topo) { return static_cast<gpu::Primitive>(topo); }
 
+    // Levels of detail of the parts, coarser and coarser triangle lists simplified from them, indexing the same vertices
+    // from an index buffer of their own. Level 0 is the part itself, in the index buffer.
+    using PartLODs = std::vector< std::vector< Part > >;
+    void setLODs(const BufferView& lodIndexBuffer, const PartLODs& partLODs);
+    const BufferView& getLODIndexBuffer() const { return _lodIndexBuffer; }
+    int getNumPartLODs(int partNum) const;
+    Part getPartLOD(int partNum, int lod) const;
+
     // create a copy of this mesh after passing its vertices, normals, and indexes though the provided functions
     MeshPointer map(std::function<glm::vec3(glm::vec3)> vertexFunc,
                     std::function<glm::vec3(glm::vec3)> normalFunc,
@@ -139,6 +147,9 @@ protected:
 
     BufferView _partBuffer;
 
+    BufferView _lodIndexBuffer;
+    PartLODs _partLODs;
+
     void evalVertexFormat();
     void evalVertexStream();
 
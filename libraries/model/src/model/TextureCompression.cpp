@@ -0,0 +1,182 @@
+//
+//  TextureCompression.cpp
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "TextureCompression.h"
+
+#include <algorithm>
+
+#include <QImage>
+
+#include <glm/glm.hpp>
+#include <tbb/parallel_for.h>
+
+using namespace model;
+
+static const int NUM_BLOCK_TEXELS = TextureCompression::BLOCK_DIMENSION * TextureCompression::BLOCK_DIMENSION;
+static const size_t BC1_BLOCK_SIZE = 8;
+static const size_t BC3_BLOCK_SIZE = 16;
+static const int BLOCK_ROWS_PER_TASK = 4;
+static const int NUM_AXIS_ITERATIONS = 4;
+
+// The index of the color at 0, 1/3, 2/3 and 1 of the way from the first end color to the second
+static const uint32_t COLOR_LEVEL_INDICES[4] = { 0, 2, 3, 1 };
+
+static uint16_t toRGB565(const glm::vec3& color) {
+    uint16_t r = (uint16_t)glm::clamp((int)(color.r * 31.0f / 255.0f + 0.5f), 0, 31);
+    uint16_t g = (uint16_t)glm::clamp((int)(color.g * 63.0f / 255.0f + 0.5f), 0, 63);
+    uint16_t b = (uint16_t)glm::clamp((int)(color.b * 31.0f / 255.0f + 0.5f), 0, 31);
+    return (r << 11) | (g << 5) | b;
+}
+
+static glm::vec3 fromRGB565(uint16_t color) {
+    int r = (color >> 11) & 0x1F;
+    int g = (color >> 5) & 0x3F;
+    int b = color & 0x1F;
+    return glm::vec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+static void compressColorBlock(const QRgb* texels, uint8_t* block) {
+    glm::vec3 colors[NUM_BLOCK_TEXELS];
+    glm::vec3 mean(0.0f);
+    glm::vec3 minColor(255.0f);
+    glm::vec3 maxColor(0.0f);
+    for (int i = 0; i < NUM_BLOCK_TEXELS; i++) {
+        colors[i] = glm::vec3(qRed(texels[i]), qGreen(texels[i]), qBlue(texels[i]));
+        mean += colors[i];
+        minColor = glm::min(minColor, colors[i]);
+        maxColor = glm::max(maxColor, colors[i]);
+    }
+    mean /= (float)NUM_BLOCK_TEXELS;
+
+    // The covariance of the colors, xx xy xz yy yz zz
+    float covariance[6] = { 0.0f };
+    for (int i = 0; i < NUM_BLOCK_TEXELS; i++) {
+        glm::vec3 d = colors[i] - mean;
+        covariance[0] += d.x * d.x;
+        covariance[1] += d.x * d.y;
+        covariance[2] += d.x * d.z;
+        covariance[3] += d.y * d.y;
+        covariance[4] += d.y * d.z;
+        covariance[5] += d.z * d.z;
+    }
+
+    // The principal axis, by power iteration from the diagonal of the bounding box
+    glm::vec3 axis = maxColor - minColor;
+    for (int i = 0; i < NUM_AXIS_ITERATIONS; i++) {
+        axis = glm::vec3(covariance[0] * axis.x + covariance[1] * axis.y + covariance[2] * axis.z,
+            covariance[1] * axis.x + covariance[3] * axis.y + covariance[4] * axis.z,
+            covariance[2] * axis.x + covariance[4] * axis.y + covariance[5] * axis.z);
+        float length = glm::length(axis);
+        if (length <= 0.0f) {
+            break;
+        }
+        axis /= length;
+    }
+
+    // The end colors span the colors along the axis, inset a little as the extremes are few
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    for (int i = 0; i < NUM_BLOCK_TEXELS; i++) {
+        float projection = glm::dot(colors[i] - mean, axis);
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+    float inset = (maxProjection - minProjection) / 16.0f;
+    uint16_t color0 = toRGB565(mean + axis * (maxProjection - inset));
+    uint16_t color1 = toRGB565(mean + axis * (minProjection + inset));
+
+    // The first color greater selects the 4 colors mode
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        glm::vec3 end0 = fromRGB565(color0);
+        glm::vec3 direction = fromRGB565(color1) - end0;
+        float scale = 3.0f / glm::dot(direction, direction);
+        for (int i = 0; i < NUM_BLOCK_TEXELS; i++) {
+            int level = glm::clamp((int)(glm::dot(colors[i] - end0, direction) * scale + 0.5f), 0, 3);
+            indices |= COLOR_LEVEL_INDICES[level] << (2 * i);
+        }
+    }
+
+    block[0] = (uint8_t)(color0 & 0xFF);
+    block[1] = (uint8_t)(color0 >> 8);
+    block[2] = (uint8_t)(color1 & 0xFF);
+    block[3] = (uint8_t)(color1 >> 8);
+    for (int i = 0; i < 4; i++) {
+        block[4 + i] = (uint8_t)((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+static void compressAlphaBlock(const QRgb* texels, uint8_t* block) {
+    int minAlpha = 255;
+    int maxAlpha = 0;
+    for (int i = 0; i < NUM_BLOCK_TEXELS; i++) {
+        minAlpha = std::min(minAlpha, qAlpha(texels[i]));
+        maxAlpha = std::max(maxAlpha, qAlpha(texels[i]));
+    }
+
+    // With the first alpha greater, the 6 between them are interpolated at 1/7th steps
+    uint64_t indices = 0;
+    int range = maxAlpha - minAlpha;
+    if (range > 0) {
+        for (int i = 0; i < NUM_BLOCK_TEXELS; i++) {
+            int level = ((maxAlpha - qAlpha(texels[i])) * 7 + range / 2) / range;
+            uint64_t index = (level == 0 ? 0 : (level == 7 ? 1 : level + 1));
+            indices |= index << (3 * i);
+        }
+    }
+
+    block[0] = (uint8_t)maxAlpha;
+    block[1] = (uint8_t)minAlpha;
+    for (int i = 0; i < 6; i++) {
+        block[2 + i] = (uint8_t)((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+std::vector<uint8_t> TextureCompression::compress(const QImage& image, bool withAlpha) {
+    Q_ASSERT(image.format() == QImage::Format_ARGB32);
+    const int width = image.width();
+    const int height = image.height();
+    const int blocksWide = (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    const int blocksHigh = (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    const size_t blockSize = (withAlpha ? BC3_BLOCK_SIZE : BC1_BLOCK_SIZE);
+    std::vector<uint8_t> blocks(blocksWide * blocksHigh * blockSize);
+
+    auto compressRows = [&](const tbb::blocked_range<int>& range) {
+        QRgb texels[NUM_BLOCK_TEXELS];
+        for (int blockY = range.begin(); blockY < range.end(); blockY++) {
+            for (int blockX = 0; blockX < blocksWide; blockX++) {
+                // The blocks past the edges of the smallest mips repeat the last texels
+                for (int y = 0; y < BLOCK_DIMENSION; y++) {
+                    auto line = reinterpret_cast<const QRgb*>(image.constScanLine(std::min(blockY * BLOCK_DIMENSION + y, height - 1)));
+                    for (int x = 0; x < BLOCK_DIMENSION; x++) {
+                        texels[y * BLOCK_DIMENSION + x] = line[std::min(blockX * BLOCK_DIMENSION + x, width - 1)];
+                    }
+                }
+
+                uint8_t* block = &blocks[(blockY * blocksWide + blockX) * blockSize];
+                if (withAlpha) {
+                    compressAlphaBlock(texels, block);
+                    block += BC1_BLOCK_SIZE;
+                }
+                compressColorBlock(texels, block);
+            }
+        }
+    };
+    tbb::parallel_for(tbb::blocked_range<int>(0, blocksHigh, BLOCK_ROWS_PER_TASK), compressRows);
+
+    return blocks;
+}
+
+bool TextureCompression::canCompress(int width, int height) {
+    return (width > 0) && (height > 0) && (width % BLOCK_DIMENSION == 0) && (height % BLOCK_DIMENSION == 0);
+}
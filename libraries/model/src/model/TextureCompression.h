@@ -0,0 +1,37 @@
+//
+//  TextureCompression.h
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_model_TextureCompression_h
+#define hifi_model_TextureCompression_h
+
+#include <cstdint>
+#include <vector>
+
+class QImage;
+
+namespace model {
+
+// Compresses images in blocks of 4x4 texels, in the BC1 and BC3 formats the GPU samples as they are stored.
+// The end colors of a block are fit to the range of its texels along their principal axis,
+// which is fast enough to compress the textures as they load, at some quality short of an exhaustive search.
+class TextureCompression {
+public:
+    static const int BLOCK_DIMENSION { 4 };
+
+    // Compress an image of QImage::Format_ARGB32 in BC3 if withAlpha, or else in BC1 dropping the alpha.
+    // The rows of blocks are compressed in parallel.
+    static std::vector<uint8_t> compress(const QImage& image, bool withAlpha);
+
+    // Whether the top mip of these dimensions can be compressed, in whole blocks
+    static bool canCompress(int width, int height);
+};
+
+}
+
+#endif // hifi_model_TextureCompression_h
@@ -22,6 +22,7 @@
 #include <Profile.h>
 
 #include "ModelLogging.h"
+#include "TextureCompression.h"
 using namespace model;
 using namespace gpu;
 
@@ -241,6 +242,21 @@ void generateFaceMips(gpu::Texture* texture, QImage& image, uint8 face) {
 #endif
 }
 
+void compressMips(gpu::Texture* texture, QImage& image, bool withAlpha, bool generateMips) {
+    PROFILE_RANGE(resource_parse, "compressMips");
+    auto mip = TextureCompression::compress(image, withAlpha);
+    texture->assignStoredMip(0, mip.size(), mip.data());
+    if (generateMips) {
+        auto numMips = texture->evalNumMips();
+        for (uint16 level = 1; level < numMips; ++level) {
+            QSize mipSize(texture->evalMipWidth(level), texture->evalMipHeight(level));
+            QImage mipImage = image.scaled(mipSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            mip = TextureCompression::compress(mipImage, withAlpha);
+            texture->assignStoredMip(level, mip.size(), mip.data());
+        }
+    }
+}
+
 gpu::Texture* TextureUsage::process2DTextureColorFromImage(const QImage& srcImage, const std::string& srcImageName, bool isLinear, bool doCompress, bool generateMips, bool isStrict) {
     PROFILE_RANGE(resource_parse, "process2DTextureColorFromImage");
     bool validAlpha = false;
@@ -250,9 +266,21 @@ gpu::Texture* TextureUsage::process2DTextureColorFromImage(const QImage& srcImag
     gpu::Texture* theTexture = nullptr;
 
     if ((image.width() > 0) && (image.height() > 0)) {
+        // Compress the mips on the CPU, so they are cached and uploaded compressed as they are
+        doCompress = doCompress && !isStrict && TextureCompression::canCompress(image.width(), image.height());
+
         gpu::Element formatGPU;
         gpu::Element formatMip;
-        defineColorTexelFormats(formatGPU, formatMip, image, isLinear, doCompress);
+        if (doCompress) {
+            if (validAlpha) {
+                formatGPU = (isLinear ? gpu::Element::COLOR_COMPRESSED_RGBA_BC3 : gpu::Element::COLOR_COMPRESSED_SRGBA_BC3);
+            } else {
+                formatGPU = (isLinear ? gpu::Element::COLOR_COMPRESSED_RGB_BC1 : gpu::Element::COLOR_COMPRESSED_SRGB_BC1);
+            }
+            formatMip = formatGPU;
+        } else {
+            defineColorTexelFormats(formatGPU, formatMip, image, isLinear, doCompress);
+        }
 
         if (isStrict) {
             theTexture = (gpu::Texture::createStrict(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
@@ -269,10 +297,14 @@ gpu::Texture* TextureUsage::process2DTextureColorFromImage(const QImage& srcImag
         }
         theTexture->setUsage(usage.build());
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
+        if (doCompress) {
+            compressMips(theTexture, image, validAlpha, generateMips);
+        } else {
+            theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
 
-        if (generateMips) {
-            ::generateMips(theTexture, image, false);
+            if (generateMips) {
+                ::generateMips(theTexture, image, false);
+            }
         }
         theTexture->setSource(srcImageName);
     }
@@ -67,6 +67,7 @@ public:
     QUrl currentFacingShareableAddress() const;
     QString currentPath(bool withOrientation = true) const;
     QString currentFacingPath() const;
+    glm::vec3 currentPosition() const { return _positionGetter ? _positionGetter() : glm::vec3(); }
 
     const QUuid& getRootPlaceID() const { return _rootPlaceID; }
     const QString& getPlaceName() const { return _shareablePlaceName.isEmpty() ? _placeName : _shareablePlaceName; }
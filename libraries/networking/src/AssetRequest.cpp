@@ -12,8 +12,10 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <memory>
 
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include "AssetClient.h"
 #include "NetworkLogging.h"
@@ -23,16 +25,22 @@
 
 static int requestID = 0;
 
-AssetRequest::AssetRequest(const QString& hash) :
+static const DataOffset ASSET_CHUNK_SIZE = 1024 * 1024;
+static const int MAX_PARALLEL_CHUNK_REQUESTS = 4;
+static const int MAX_CHUNK_ATTEMPTS = 3;
+static const int CHUNK_RETRY_DELAY_MSECS = 500; // doubled with each attempt
+
+AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
-    _hash(hash)
+    _hash(hash),
+    _byteRange(byteRange)
 {
 }
 
 AssetRequest::~AssetRequest() {
     auto assetClient = DependencyManager::get<AssetClient>();
-    if (_assetRequestID) {
-        assetClient->cancelGetAssetRequest(_assetRequestID);
+    for (auto assetRequestID : _assetRequestIDs) {
+        assetClient->cancelGetAssetRequest(assetRequestID);
     }
     if (_assetInfoRequestID) {
         assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
@@ -64,6 +72,9 @@ void AssetRequest::start() {
     if (!_data.isNull()) {
         _info.hash = _hash;
         _info.size = _data.size();
+        if (_byteRange.isSet()) {
+            _data = _data.mid(_byteRange.fromInclusive, _byteRange.size());
+        }
         _error = NoError;
         
         _state = Finished;
@@ -102,68 +113,138 @@ void AssetRequest::start() {
             return;
         }
         
+        DataOffset start = 0, end = _info.size;
+        if (_byteRange.isSet()) {
+            start = _byteRange.fromInclusive;
+            end = std::min<DataOffset>(_byteRange.toExclusive, _info.size);
+            if (start >= end) {
+                _error = InvalidByteRange;
+                _state = Finished;
+                emit finished(this);
+                return;
+            }
+        }
+
         _state = WaitingForData;
-        _data.resize(info.size);
+        _data.resize(end - start);
+        _dataStart = start;
         
         qCDebug(asset_client) << "Got size of " << _hash << " : " << info.size << " bytes";
-        
-        int start = 0, end = _info.size;
-        
-        auto assetClient = DependencyManager::get<AssetClient>();
+
+        // large assets come in chunks requested in parallel, and a chunk lost to the network is requested again
+        // rather than the whole of the asset
+        for (DataOffset chunkStart = start; chunkStart < end; chunkStart += ASSET_CHUNK_SIZE) {
+            _pendingChunks.push_back({ chunkStart, std::min(chunkStart + ASSET_CHUNK_SIZE, end), 0 });
+        }
+        requestChunks();
+    });
+}
+
+void AssetRequest::requestChunks() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    while (_state == WaitingForData && !_pendingChunks.empty() && _assetRequestIDs.size() < MAX_PARALLEL_CHUNK_REQUESTS) {
+        auto chunk = _pendingChunks.takeFirst();
         auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
         auto hash = _hash;
-        _assetRequestID = assetClient->getAsset(_hash, start, end,
-                [this, that, hash, start, end](bool responseReceived, AssetServerError serverError, const QByteArray& data) {
+        // the reply can come before the ID is known, when the request couldn't be sent
+        auto assetRequestID = std::make_shared<MessageID>(INVALID_MESSAGE_ID);
+        *assetRequestID = assetClient->getAsset(_hash, chunk.start, chunk.end,
+                [this, that, hash, chunk, assetRequestID](bool responseReceived, AssetServerError serverError, const QByteArray& data) {
             if (!that) {
                 qCWarning(asset_client) << "Got reply for dead asset request " << hash << "- error code" << _error;
                 // If the request is dead, return
                 return;
             }
-            _assetRequestID = INVALID_MESSAGE_ID;
-
-            if (!responseReceived) {
-                _error = NetworkError;
-            } else if (serverError != AssetServerError::NoError) {
-                switch (serverError) {
-                    case AssetServerError::AssetNotFound:
-                        _error = NotFound;
-                        break;
-                    case AssetServerError::InvalidByteRange:
-                        _error = InvalidByteRange;
-                        break;
-                    default:
-                        _error = UnknownError;
-                        break;
-                }
-            } else {
-                Q_ASSERT(data.size() == (end - start));
-                
-                // we need to check the hash of the received data to make sure it matches what we expect
-                if (hashData(data).toHex() == _hash) {
-                    memcpy(_data.data() + start, data.constData(), data.size());
-                    _totalReceived += data.size();
-                    emit progress(_totalReceived, _info.size);
-                    
-                    saveToCache(getUrl(), data);
-                } else {
-                    // hash doesn't match - we have an error
-                    _error = HashVerificationFailed;
-                }
-                
-            }
-            
-            if (_error != NoError) {
-                qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
-            }
-            
-            _state = Finished;
-            emit finished(this);
+            _assetRequestIDs.remove(*assetRequestID);
+            handleChunkReply(chunk, responseReceived, serverError, data);
         }, [this, that](qint64 totalReceived, qint64 total) {
             if (!that) {
                 // If the request is dead, return
                 return;
             }
-            emit progress(totalReceived, total);
+            // the progress within chunks only adds up when there is the one
+            if (_data.size() == total) {
+                emit progress(totalReceived, total);
+            }
         });
-    });
+        if (*assetRequestID != INVALID_MESSAGE_ID) {
+            _assetRequestIDs.insert(*assetRequestID);
+        }
+    }
+}
+
+void AssetRequest::handleChunkReply(Chunk chunk, bool responseReceived, AssetServerError serverError, const QByteArray& data) {
+    if (_state != WaitingForData) {
+        return;
+    }
+
+    if (!responseReceived) {
+        if (++chunk.attempts < MAX_CHUNK_ATTEMPTS) {
+            qCDebug(asset_client) << "Requesting data from" << chunk.start << "to" << chunk.end << "of" << _hash << "again";
+            _pendingChunks.push_back(chunk);
+            // not from within this reply: AssetClient fails all of a lost node's requests in one go, and the asset
+            // server needs a moment to be back
+            QTimer::singleShot(CHUNK_RETRY_DELAY_MSECS << (chunk.attempts - 1), this, [this] {
+                requestChunks();
+            });
+            return;
+        }
+        _error = NetworkError;
+    } else if (serverError != AssetServerError::NoError) {
+        switch (serverError) {
+            case AssetServerError::AssetNotFound:
+                _error = NotFound;
+                break;
+            case AssetServerError::InvalidByteRange:
+                _error = InvalidByteRange;
+                break;
+            default:
+                _error = UnknownError;
+                break;
+        }
+    } else if (data.size() != chunk.end - chunk.start) {
+        _error = UnknownError;
+    } else {
+        memcpy(_data.data() + (chunk.start - _dataStart), data.constData(), data.size());
+        _totalReceived += data.size();
+        emit progress(_totalReceived, _data.size());
+    }
+
+    if (_error != NoError) {
+        // the other chunks are of no use anymore, they are cancelled once AssetClient is done with the requests it
+        // may be failing right now
+        auto assetClient = DependencyManager::get<AssetClient>();
+        auto otherRequestIDs = _assetRequestIDs;
+        QTimer::singleShot(0, assetClient.data(), [otherRequestIDs] {
+            auto assetClient = DependencyManager::get<AssetClient>();
+            for (auto assetRequestID : otherRequestIDs) {
+                assetClient->cancelGetAssetRequest(assetRequestID);
+            }
+        });
+        _assetRequestIDs.clear();
+        _pendingChunks.clear();
+        finish();
+    } else if (_pendingChunks.empty() && _assetRequestIDs.empty()) {
+        if (!_byteRange.isSet()) {
+            // we need to check the hash of the received data to make sure it matches what we expect,
+            // a part of the asset can't be checked against it, nor cached as the whole of it
+            if (hashData(_data).toHex() == _hash) {
+                saveToCache(getUrl(), _data);
+            } else {
+                _error = HashVerificationFailed;
+            }
+        }
+        finish();
+    } else {
+        requestChunks();
+    }
+}
+
+void AssetRequest::finish() {
+    if (_error != NoError) {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    }
+
+    _state = Finished;
+    emit finished(this);
 }
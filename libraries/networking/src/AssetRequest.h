@@ -13,7 +13,9 @@
 #define hifi_AssetRequest_h
 
 #include <QByteArray>
+#include <QList>
 #include <QObject>
+#include <QSet>
 #include <QString>
 
 #include "AssetClient.h"
@@ -40,7 +42,7 @@ public:
         UnknownError
     };
 
-    AssetRequest(const QString& hash);
+    AssetRequest(const QString& hash, const ByteRange& byteRange = ByteRange());
     virtual ~AssetRequest() override;
 
     Q_INVOKABLE void start();
@@ -56,15 +58,28 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    // A range of the asset requested on its own
+    struct Chunk {
+        DataOffset start;
+        DataOffset end;
+        int attempts;
+    };
+
+    void requestChunks();
+    void handleChunkReply(Chunk chunk, bool responseReceived, AssetServerError serverError, const QByteArray& data);
+    void finish();
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
     AssetInfo _info;
     uint64_t _totalReceived { 0 };
     QString _hash;
+    ByteRange _byteRange;
     QByteArray _data;
-    int _numPendingRequests { 0 };
-    MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    DataOffset _dataStart { 0 };
+    QList<Chunk> _pendingChunks;
+    QSet<MessageID> _assetRequestIDs;
     MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
 };
 
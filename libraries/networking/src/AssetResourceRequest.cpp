@@ -73,12 +73,19 @@ void AssetResourceRequest::requestMappingForPath(const AssetPath& path) {
         Q_ASSERT(_state == InProgress);
         Q_ASSERT(request == _assetMappingRequest);
 
+        _assetMappingRequest->deleteLater();
+        _assetMappingRequest = nullptr;
+
         switch (request->getError()) {
             case MappingRequest::NoError:
                 // we have no error, we should have a resulting hash - use that to send of a request for that asset
                 qCDebug(networking) << "Got mapping for:" << path << "=>" << request->getHash();
 
-                requestHash(request->getHash());
+                if (_url.query() == BAKED_TEXTURE_QUERY) {
+                    requestBakedMapping(request->getHash());
+                } else {
+                    requestHash(request->getHash());
+                }
 
                 break;
             default: {
@@ -103,9 +110,29 @@ void AssetResourceRequest::requestMappingForPath(const AssetPath& path) {
                 break;
             }
         }
+    });
+
+    _assetMappingRequest->start();
+}
+
+void AssetResourceRequest::requestBakedMapping(const AssetHash& hash) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    _assetMappingRequest = assetClient->createGetMappingRequest(getBakedTexturePath(hash));
+
+    connect(_assetMappingRequest, &GetMappingRequest::finished, this, [this, hash](GetMappingRequest* request){
+        Q_ASSERT(_state == InProgress);
+        Q_ASSERT(request == _assetMappingRequest);
 
         _assetMappingRequest->deleteLater();
         _assetMappingRequest = nullptr;
+
+        // the asset is requested as it is when it has not been baked (yet)
+        if (request->getError() == MappingRequest::NoError) {
+            qCDebug(networking) << "Got baked mapping for:" << _url.path() << "=>" << request->getHash();
+            requestHash(request->getHash());
+        } else {
+            requestHash(hash);
+        }
     });
 
     _assetMappingRequest->start();
@@ -114,7 +141,7 @@ void AssetResourceRequest::requestMappingForPath(const AssetPath& path) {
 void AssetResourceRequest::requestHash(const AssetHash& hash) {
     // Make request to atp
     auto assetClient = DependencyManager::get<AssetClient>();
-    _assetRequest = assetClient->createRequest(hash);
+    _assetRequest = assetClient->createRequest(hash, _byteRange);
 
     connect(_assetRequest, &AssetRequest::progress, this, &AssetResourceRequest::onDownloadProgress);
     connect(_assetRequest, &AssetRequest::finished, this, [this](AssetRequest* req) {
@@ -35,6 +35,7 @@ private:
     bool urlIsAssetHash() const;
 
     void requestMappingForPath(const AssetPath& path);
+    void requestBakedMapping(const AssetHash& hash);
     void requestHash(const AssetHash& hash);
 
     GetMappingRequest* _assetMappingRequest { nullptr };
@@ -84,3 +84,25 @@ bool isValidHash(const AssetHash& hash) {
     QRegExp hashRegex { ASSET_HASH_REGEX_STRING };
     return hashRegex.exactMatch(hash);
 }
+
+AssetPath getBakedTexturePath(const AssetHash& hash) {
+    return HIDDEN_BAKED_CONTENT_FOLDER + hash + "/" + BAKED_TEXTURE_FILENAME;
+}
+
+bool isBakedContentPath(const AssetPath& path) {
+    return path.startsWith(HIDDEN_BAKED_CONTENT_FOLDER);
+}
+
+bool isBakeableTexturePath(const AssetPath& path) {
+    static const QStringList BAKEABLE_TEXTURE_EXTENSIONS { ".png", ".jpg", ".jpeg" };
+
+    if (isBakedContentPath(path)) {
+        return false;
+    }
+    for (const auto& extension : BAKEABLE_TEXTURE_EXTENSIONS) {
+        if (path.endsWith(extension, Qt::CaseInsensitive)) {
+            return true;
+        }
+    }
+    return false;
+}
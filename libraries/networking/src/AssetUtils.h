@@ -34,6 +34,13 @@ const QString ASSET_FILE_PATH_REGEX_STRING = "^(\\/[^\\/\\0]+)+$";
 const QString ASSET_PATH_REGEX_STRING = "^\\/([^\\/\\0]+(\\/)?)+$";
 const QString ASSET_HASH_REGEX_STRING = QString("^[a-fA-F0-9]{%1}$").arg(SHA256_HASH_HEX_LENGTH);
 
+// The asset-server maps the versions it bakes of the assets in this hidden folder, by the hash of the originals
+const QString HIDDEN_BAKED_CONTENT_FOLDER = "/.baked/";
+const QString BAKED_TEXTURE_FILENAME = "texture.ktx";
+
+// The query of an ATP url asking for the baked texture of the asset, when there is one
+const QString BAKED_TEXTURE_QUERY = "baked";
+
 enum AssetServerError : uint8_t {
     NoError = 0,
     AssetNotFound,
@@ -63,4 +70,8 @@ bool isValidFilePath(const AssetPath& path);
 bool isValidPath(const AssetPath& path);
 bool isValidHash(const QString& hashString);
 
+AssetPath getBakedTexturePath(const AssetHash& hash);
+bool isBakedContentPath(const AssetPath& path);
+bool isBakeableTexturePath(const AssetPath& path);
+
 #endif // hifi_AssetUtils_h
@@ -0,0 +1,195 @@
+//
+//  DomainSession.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainSession.h"
+
+#include <QtCore/QDataStream>
+
+#include <SharedUtil.h>
+
+#include "LimitedNodeList.h"
+#include "NodePermissions.h"
+#include "udt/PacketHeaders.h"
+
+DomainSession::DomainSession(const HifiSockAddr& domainSockAddr, const QHostAddress& localAddress, NodeType_t targetType,
+                             bool shouldChangeSocketOptions) :
+    _domainSockAddr(domainSockAddr),
+    _targetType(targetType),
+    _socket(nullptr, shouldChangeSocketOptions)
+{
+    _socket.bind(QHostAddress::AnyIPv4);
+    _localSockAddr = HifiSockAddr(localAddress, _socket.localPort());
+    _socket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+        handlePacket(std::move(packet));
+    });
+    _socket.setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
+        processMessagePacket(std::move(packet));
+    });
+}
+
+void DomainSession::sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& destination,
+                               const QUuid& connectionSecret) {
+    // as LimitedNodeList::fillPacketHeader
+    PacketType type = packet->getType();
+    if (!NON_SOURCED_PACKETS.contains(type)) {
+        packet->writeSourceID(_sessionUUID);
+    }
+    if (!connectionSecret.isNull() && !NON_SOURCED_PACKETS.contains(type) && !NON_VERIFIED_PACKETS.contains(type)) {
+        packet->writeVerificationHashGivenSecret(connectionSecret);
+    }
+
+    if (packet->isReliable()) {
+        _socket.writePacket(std::move(packet), destination);
+    } else {
+        _socket.writePacket(*packet, destination);
+    }
+}
+
+void DomainSession::sendPacketToTarget(std::unique_ptr<NLPacket> packet) {
+    sendPacket(std::move(packet), _targetActiveSockAddr, _targetConnectionSecret);
+}
+
+void DomainSession::checkInWithDomain() {
+    // as NodeList::sendDomainServerCheckIn, for an anonymous client talking to the domain-server directly
+    bool isConnecting = !isConnectedToDomain();
+    auto domainPacket = NLPacket::create(isConnecting ? PacketType::DomainConnectRequest : PacketType::DomainListRequest);
+    QDataStream packetStream(domainPacket.get());
+
+    if (isConnecting) {
+        packetStream << QUuid(); // we are neither an assigned node nor using ICE
+
+        QByteArray protocolVersionSig = protocolVersionsSignature();
+        packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+
+        packetStream << QString(); // hardware address
+        packetStream << _machineFingerprint; // each session is its own machine
+    }
+
+    QList<NodeType_t> nodeTypesOfInterest { _targetType };
+    packetStream << NodeType::Agent << _localSockAddr << _localSockAddr << nodeTypesOfInterest;
+    packetStream << QString(); // place name
+
+    if (isConnecting) {
+        packetStream << QString(); // username
+    }
+
+    sendPacket(std::move(domainPacket), _domainSockAddr);
+}
+
+void DomainSession::handlePacket(std::unique_ptr<udt::Packet> packet) {
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+
+    switch (nlPacket->getType()) {
+        case PacketType::DomainList:
+            processDomainList(*nlPacket);
+            break;
+        case PacketType::DomainServerAddedNode:
+            processDomainServerAddedNode(*nlPacket);
+            break;
+        case PacketType::DomainConnectionDenied:
+            processDomainConnectionDenied(*nlPacket);
+            break;
+        case PacketType::Ping:
+            processPing(*nlPacket);
+            break;
+        default:
+            processPacket(*nlPacket);
+            break;
+    }
+}
+
+void DomainSession::processDomainList(NLPacket& packet) {
+    // as NodeList::processDomainServerList
+    QDataStream packetStream(&packet);
+
+    QUuid domainUUID;
+    QUuid sessionUUID;
+    NodePermissions permissions;
+    packetStream >> domainUUID >> sessionUUID >> permissions;
+
+    if (_sessionUUID.isNull()) {
+        _sessionUUID = sessionUUID;
+        sessionUUIDChanged(_sessionUUID);
+    }
+
+    while (packet.bytesLeftToRead() > 0 && packetStream.status() == QDataStream::Ok) {
+        parseNodeFromPacket(packetStream);
+    }
+}
+
+void DomainSession::processDomainServerAddedNode(NLPacket& packet) {
+    QDataStream packetStream(&packet);
+    parseNodeFromPacket(packetStream);
+}
+
+void DomainSession::parseNodeFromPacket(QDataStream& packetStream) {
+    // as NodeList::parseNodeFromPacketStream
+    qint8 nodeType;
+    QUuid nodeUUID, connectionSecret;
+    HifiSockAddr publicSockAddr, localSockAddr;
+    NodePermissions permissions;
+    packetStream >> nodeType >> nodeUUID >> publicSockAddr >> localSockAddr >> permissions >> connectionSecret;
+
+    if (nodeType != _targetType || nodeUUID == _targetUUID) {
+        return;
+    }
+
+    // a reachable node at the same IP as the domain-server is sent without its address
+    if (publicSockAddr.getAddress().isNull()) {
+        publicSockAddr.setAddress(_domainSockAddr.getAddress());
+    }
+
+    _targetUUID = nodeUUID;
+    _targetConnectionSecret = connectionSecret;
+    _targetPublicSockAddr = publicSockAddr;
+    _targetLocalSockAddr = localSockAddr;
+    _targetActiveSockAddr = HifiSockAddr();
+    targetChanged();
+
+    // punch through to the target, it activates our socket once it has a reply to one of its own pings
+    for (auto pingType : { PingType::Local, PingType::Public }) {
+        auto pingPacket = NLPacket::create(PacketType::Ping, sizeof(PingType_t) + sizeof(quint64));
+        pingPacket->writePrimitive(pingType);
+        pingPacket->writePrimitive(usecTimestampNow());
+        sendPacket(std::move(pingPacket), pingType == PingType::Local ? _targetLocalSockAddr : _targetPublicSockAddr,
+                   _targetConnectionSecret);
+    }
+}
+
+void DomainSession::processDomainConnectionDenied(NLPacket& packet) {
+    uint8_t reasonCode;
+    packet.readPrimitive(&reasonCode);
+    quint16 reasonSize;
+    packet.readPrimitive(&reasonSize);
+    _denialReason = QString::fromUtf8(packet.read(reasonSize));
+}
+
+void DomainSession::processPing(NLPacket& packet) {
+    if (packet.getSourceID() != _targetUUID) {
+        return;
+    }
+
+    // as LimitedNodeList::constructPingReplyPacket
+    PingType_t pingType;
+    quint64 pingTime;
+    packet.readPrimitive(&pingType);
+    packet.readPrimitive(&pingTime);
+
+    auto replyPacket = NLPacket::create(PacketType::PingReply, sizeof(PingType_t) + sizeof(quint64) + sizeof(quint64));
+    replyPacket->writePrimitive(pingType);
+    replyPacket->writePrimitive(pingTime);
+    replyPacket->writePrimitive(usecTimestampNow());
+    sendPacket(std::move(replyPacket), packet.getSenderSockAddr(), _targetConnectionSecret);
+
+    // the target reached us from here, so we use it to reach the target
+    if (_targetActiveSockAddr.isNull()) {
+        _targetActiveSockAddr = packet.getSenderSockAddr();
+    }
+}
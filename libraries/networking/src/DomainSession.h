@@ -0,0 +1,82 @@
+//
+//  DomainSession.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainSession_h
+#define hifi_DomainSession_h
+
+#include <memory>
+
+#include <QtCore/QObject>
+#include <QtCore/QUuid>
+
+#include "HifiSockAddr.h"
+#include "NLPacket.h"
+#include "NodeType.h"
+#include "udt/Socket.h"
+
+// A bare client of a domain, for the tools that stand in for many clients at once without a NodeList each
+//   It has its own socket, checks in with the domain-server and connects to the one node of the target type, speaking
+//   just enough of the protocol to be treated as a client (DomainConnectRequest/DomainList and pings).
+//   Every other packet is handed to the subclass.
+class DomainSession : public QObject {
+    Q_OBJECT
+public:
+    DomainSession(const HifiSockAddr& domainSockAddr, const QHostAddress& localAddress, NodeType_t targetType,
+                  bool shouldChangeSocketOptions = true);
+    virtual ~DomainSession() {}
+
+    const QUuid& getSessionUUID() const { return _sessionUUID; }
+    const QUuid& getTargetUUID() const { return _targetUUID; }
+    bool isConnectedToDomain() const { return !_sessionUUID.isNull(); }
+    bool isConnectedToTarget() const { return !_targetActiveSockAddr.isNull(); }
+    const QString& getDenialReason() const { return _denialReason; }
+
+    void checkInWithDomain();
+
+protected:
+    void sendPacketToTarget(std::unique_ptr<NLPacket> packet);
+
+    // the packets other than the domain-server's and the pings
+    virtual void processPacket(NLPacket& packet) = 0;
+    // the parts of the reliable messages, in order
+    virtual void processMessagePacket(std::unique_ptr<udt::Packet> packet) {}
+    // the domain-server gave the session its ID
+    virtual void sessionUUIDChanged(const QUuid& sessionUUID) {}
+    // a target node was found, which the session isn't connected to yet
+    virtual void targetChanged() {}
+
+private:
+    void sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& destination,
+                    const QUuid& connectionSecret = QUuid());
+    void handlePacket(std::unique_ptr<udt::Packet> packet);
+
+    void processDomainList(NLPacket& packet);
+    void processDomainServerAddedNode(NLPacket& packet);
+    void processDomainConnectionDenied(NLPacket& packet);
+    void processPing(NLPacket& packet);
+    void parseNodeFromPacket(QDataStream& packetStream);
+
+    HifiSockAddr _domainSockAddr;
+    NodeType_t _targetType;
+
+    udt::Socket _socket;
+    HifiSockAddr _localSockAddr;
+    QUuid _machineFingerprint { QUuid::createUuid() };
+    QUuid _sessionUUID;
+    QString _denialReason;
+
+    QUuid _targetUUID;
+    QUuid _targetConnectionSecret;
+    HifiSockAddr _targetPublicSockAddr;
+    HifiSockAddr _targetLocalSockAddr;
+    HifiSockAddr _targetActiveSockAddr;
+};
+
+#endif // hifi_DomainSession_h
@@ -31,6 +31,7 @@ static const size_t BYTES_PER_GIGABYTES = 1024 * BYTES_PER_MEGABYTES;
 const size_t FileCache::DEFAULT_UNUSED_MAX_SIZE = 5 * BYTES_PER_GIGABYTES; // 5GB
 const size_t FileCache::MAX_UNUSED_MAX_SIZE = 100 * BYTES_PER_GIGABYTES; // 100GB
 const size_t FileCache::DEFAULT_OFFLINE_MAX_SIZE = 2 * BYTES_PER_GIGABYTES; // 2GB
+const float FileCache::DEFAULT_COST = 1.0f;
 
 void FileCache::setUnusedFileCacheSize(size_t unusedFilesMaxSize) {
     _unusedFilesMaxSize = std::min(unusedFilesMaxSize, MAX_UNUSED_MAX_SIZE);
@@ -97,6 +98,13 @@ FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath)
 }
 
 FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata) {
+    size_t length = metadata.length;
+    return writeFile(std::move(metadata), [data, length](const DataWriter& writer) {
+        return writer(data, length);
+    });
+}
+
+FilePointer FileCache::writeFile(File::Metadata&& metadata, const DataProducer& produce) {
     assert(_initialized);
 
     std::string filepath = getFilepath(metadata.key);
@@ -112,11 +120,20 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata) {
 
     // write the new file
     FILE* saveFile = fopen(filepath.c_str(), "wb");
-    if (saveFile != nullptr && fwrite(data, metadata.length, 1, saveFile) && fclose(saveFile) == 0) {
+    size_t writtenLength = 0;
+    bool produced = saveFile != nullptr && produce([saveFile, &writtenLength](const char* data, size_t length) {
+        writtenLength += length;
+        return length == 0 || fwrite(data, length, 1, saveFile) == 1;
+    });
+    bool closed = saveFile != nullptr && fclose(saveFile) == 0;
+    if (produced && closed && writtenLength == metadata.length) {
         file = addFile(std::move(metadata), filepath);
     } else {
         qCWarning(file_cache, "[%s] Failed to write %s (%s)", _dirname.c_str(), metadata.key.c_str(), strerror(errno));
         errno = 0;
+        if (saveFile != nullptr) {
+            remove(filepath.c_str());
+        }
     }
 
     return file;
@@ -158,7 +175,7 @@ void FileCache::addUnusedFile(const FilePointer file) {
     }
 
     reserve(file->getLength());
-    file->_LRUKey = ++_lastLRUKey;
+    file->_LRUKey = { _evictedCost + file->getCost(), ++_lastLRUKey };
 
     {
         Lock lock(_unusedFilesMutex);
@@ -187,6 +204,7 @@ void FileCache::reserve(size_t length) {
         auto it = _unusedFiles.begin();
         auto file = it->second;
         auto length = file->getLength();
+        _evictedCost = it->first.first;
 
         unusedLock.unlock();
         {
@@ -232,6 +250,7 @@ void File::deleter() {
 File::File(Metadata&& metadata, const std::string& filepath) :
     _key(std::move(metadata.key)),
     _length(metadata.length),
+    _cost(metadata.cost),
     _filepath(filepath) {}
 
 File::~File() {
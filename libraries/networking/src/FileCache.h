@@ -13,6 +13,7 @@
 #include <atomic>
 #include <memory>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <string>
@@ -56,11 +57,18 @@ public:
 
     using Key = std::string;
     struct Metadata {
-        Metadata(const Key& key, size_t length) :
-            key(key), length(length) {}
+        Metadata(const Key& key, size_t length, float cost = DEFAULT_COST) :
+            key(key), length(length), cost(cost) {}
         Key key;
         size_t length;
+        // what it costs to get a byte of the file again once it is evicted, relative to downloading it
+        float cost;
     };
+    static const float DEFAULT_COST;
+
+    // The data of a file written as it's produced
+    using DataWriter = std::function<bool(const char* data, size_t length)>;
+    using DataProducer = std::function<bool(const DataWriter& writer)>;
 
     // derived classes should implement a setter/getter, for example, for a FileCache backing a network cache:
     //
@@ -81,6 +89,9 @@ protected:
     void initialize();
 
     FilePointer writeFile(const char* data, Metadata&& metadata);
+    // Or with the data written to the file as it's produced, metadata.length bytes of it, through the writer
+    // handed to produce (which returns false if it or the writer failed, and the file isn't kept)
+    FilePointer writeFile(Metadata&& metadata, const DataProducer& produce);
     FilePointer getFile(const Key& key);
 
     /// create a file
@@ -113,10 +124,14 @@ private:
     std::unordered_map<Key, std::weak_ptr<File>> _files;
     Mutex _filesMutex;
 
-    std::map<int, FilePointer> _unusedFiles;
+    // the unused files are evicted lowest key first, by the cost of their bytes added to the key of the last file evicted,
+    // so files costly to get again outlast cheaper ones used after them, though not forever
+    using LRUKey = std::pair<float, int>;
+    std::map<LRUKey, FilePointer> _unusedFiles;
     Mutex _unusedFilesMutex;
     size_t _unusedFilesMaxSize { DEFAULT_UNUSED_MAX_SIZE };
     int _lastLRUKey { 0 };
+    float _evictedCost { 0.0f };
 
     size_t _offlineFilesMaxSize { DEFAULT_OFFLINE_MAX_SIZE };
 };
@@ -130,6 +145,7 @@ public:
 
     Key getKey() const { return _key; }
     size_t getLength() const { return _length; }
+    float getCost() const { return _cost; }
     std::string getFilepath() const { return _filepath; }
 
     virtual ~File();
@@ -145,10 +161,11 @@ private:
 
     const Key _key;
     const size_t _length;
+    const float _cost;
     const std::string _filepath;
 
     FileCache* _cache;
-    int _LRUKey { 0 };
+    FileCache::LRUKey _LRUKey { 0.0f, 0 };
 
     bool _shouldPersist { false };
 };
@@ -25,7 +25,12 @@ void FileResourceRequest::doSend() {
     QFile file(filename);
     if (file.exists()) {
         if (file.open(QFile::ReadOnly)) {
-            _data = file.readAll();
+            if (_byteRange.isSet()) {
+                file.seek(_byteRange.fromInclusive);
+                _data = file.read(_byteRange.size());
+            } else {
+                _data = file.readAll();
+            }
             _result = ResourceRequest::Success;
         } else {
             _result = ResourceRequest::AccessDenied;
@@ -48,6 +48,8 @@ void HTTPResourceRequest::cleanupTimer() {
     _sendTimer = nullptr;
 }
 
+static const int HTTP_PARTIAL_CONTENT = 206;
+
 void HTTPResourceRequest::doSend() {
     QNetworkRequest networkRequest(_url);
     networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
@@ -59,6 +61,12 @@ void HTTPResourceRequest::doSend() {
         networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
     }
 
+    if (_byteRange.isSet()) {
+        // the range header is inclusive of its last byte
+        auto byteRange = QString("bytes=%1-%2").arg(_byteRange.fromInclusive).arg(_byteRange.toExclusive - 1);
+        networkRequest.setRawHeader("Range", byteRange.toLatin1());
+    }
+
     _reply = NetworkAccessManager::getInstance().get(networkRequest);
     
     connect(_reply, &QNetworkReply::finished, this, &HTTPResourceRequest::onRequestFinished);
@@ -76,6 +84,10 @@ void HTTPResourceRequest::onRequestFinished() {
     switch(_reply->error()) {
         case QNetworkReply::NoError:
             _data = _reply->readAll();
+            if (_byteRange.isSet() && _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != HTTP_PARTIAL_CONTENT) {
+                // the server ignored the range and sent the whole resource, keep only the range of it
+                _data = _data.mid(_byteRange.fromInclusive, _byteRange.size());
+            }
             _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
             _result = Success;
             break;
@@ -133,6 +133,11 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     }
 }
 
+LimitedNodeList::~LimitedNodeList() {
+    // the socket's filter worker verifies packets against us, so it must be done before we go
+    _nodeSocket.setPacketFilterOnWorkerThread(false);
+}
+
 void LimitedNodeList::setSessionUUID(const QUuid& sessionUUID) {
     QUuid oldUUID = _sessionUUID;
     _sessionUUID = sessionUUID;
@@ -270,11 +275,8 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
         if (matchingNode) {
             if (!NON_VERIFIED_PACKETS.contains(headerType)) {
 
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash = NLPacket::hashForPacketAndSecret(packet, matchingNode->getConnectionSecret());
-
                 // check if the md5 hash in the header matches the hash we would expect
-                if (packetHeaderHash != expectedHash) {
+                if (!NLPacket::verificationHashMatchesSecret(packet, matchingNode->getConnectionSecret())) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
@@ -338,6 +340,10 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node&
     emit dataSent(destinationNode.getType(), packet.getDataSize());
     destinationNode.recordBytesSent(packet.getDataSize());
 
+    if (shouldCoalescePacket(packet)) {
+        return coalescePacket(packet, destinationNode);
+    }
+
     return sendUnreliablePacket(packet, *destinationNode.getActiveSocket(), destinationNode.getConnectionSecret());
 }
 
@@ -453,6 +459,127 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
     }
 }
 
+qint64 LimitedNodeList::queuePacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode) {
+    Q_ASSERT(!packet->isPartOfMessage());
+    auto activeSocket = destinationNode.getActiveSocket();
+
+    if (activeSocket) {
+        emit dataSent(destinationNode.getType(), packet->getDataSize());
+        destinationNode.recordBytesSent(packet->getDataSize());
+
+        if (shouldCoalescePacket(*packet)) {
+            return coalescePacket(*packet, destinationNode);
+        }
+
+        collectPacketStats(*packet);
+        fillPacketHeader(*packet, destinationNode.getConnectionSecret());
+
+        return _nodeSocket.queuePacket(std::move(packet), *activeSocket);
+    } else {
+        qCDebug(networking) << "LimitedNodeList::queuePacket called without active socket for node" << destinationNode << "- not sending";
+        return ERROR_SENDING_PACKET_BYTES;
+    }
+}
+
+qint64 LimitedNodeList::queuePacketList(std::unique_ptr<NLPacketList> packetList, const Node& destinationNode) {
+    auto activeSocket = destinationNode.getActiveSocket();
+    if (activeSocket) {
+        // close the last packet in the list
+        packetList->closeCurrentPacket();
+
+        for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
+            NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
+            collectPacketStats(*nlPacket);
+            fillPacketHeader(*nlPacket, destinationNode.getConnectionSecret());
+        }
+
+        return _nodeSocket.queuePacketList(std::move(packetList), *activeSocket);
+    } else {
+        qCDebug(networking) << "LimitedNodeList::queuePacketList called without active socket for node. Not sending.";
+        return ERROR_SENDING_PACKET_BYTES;
+    }
+}
+
+qint64 LimitedNodeList::flushQueuedPackets() {
+    {
+        std::lock_guard<std::mutex> locker(_coalescingPacketsMutex);
+        for (auto& pair : _coalescingPackets) {
+            if (pair.second.packet) {
+                sendCoalescingPacket(pair.second);
+            }
+        }
+    }
+
+    return _nodeSocket.flushQueuedPackets();
+}
+
+bool LimitedNodeList::shouldCoalescePacket(const NLPacket& packet) const {
+    // the receiver attributes sub-packets to the source of the CoalescedPackets packet, so they must be sourced
+    return _isPacketCoalescingEnabled
+        && !packet.isReliable() && !packet.isPartOfMessage()
+        && packet.getPayloadSize() <= MAX_COALESCED_PAYLOAD_SIZE
+        && packet.getType() != PacketType::CoalescedPackets
+        && !NON_SOURCED_PACKETS.contains(packet.getType());
+}
+
+qint64 LimitedNodeList::coalescePacket(const NLPacket& packet, const Node& destinationNode) {
+    collectPacketStats(packet);
+
+    std::lock_guard<std::mutex> locker(_coalescingPacketsMutex);
+
+    auto& coalescingPacket = _coalescingPackets[destinationNode.getUUID()];
+
+    auto subPacketSize = COALESCED_SUB_PACKET_HEADER_SIZE + packet.getPayloadSize();
+    if (coalescingPacket.packet && coalescingPacket.packet->bytesAvailableForWrite() < subPacketSize) {
+        // no room left in this one, send it now and start another
+        sendCoalescingPacket(coalescingPacket);
+    }
+
+    if (!coalescingPacket.packet) {
+        coalescingPacket.packet = NLPacket::create(PacketType::CoalescedPackets);
+    }
+
+    coalescingPacket.sockAddr = *destinationNode.getActiveSocket();
+    coalescingPacket.connectionSecret = destinationNode.getConnectionSecret();
+
+    auto& coalescedPacket = *coalescingPacket.packet;
+    coalescedPacket.writePrimitive((CoalescedPacketSize)packet.getPayloadSize());
+    coalescedPacket.writePrimitive(packet.getType());
+    coalescedPacket.writePrimitive(packet.getVersion());
+    coalescedPacket.write(packet.getPayload(), packet.getPayloadSize());
+    ++coalescingPacket.numPackets;
+
+    return packet.getDataSize();
+}
+
+void LimitedNodeList::sendCoalescingPacket(CoalescingPacket& coalescingPacket) {
+    std::unique_ptr<NLPacket> packet;
+
+    if (coalescingPacket.numPackets == 1) {
+        // nothing to coalesce with, send the packet on its own rather than paying for the framing
+        auto& coalescedPacket = *coalescingPacket.packet;
+        coalescedPacket.seek(0);
+
+        CoalescedPacketSize size;
+        PacketType type;
+        PacketVersion version;
+        coalescedPacket.readPrimitive(&size);
+        coalescedPacket.readPrimitive(&type);
+        coalescedPacket.readPrimitive(&version);
+
+        packet = NLPacket::create(type, size, false, false, version);
+        packet->write(coalescedPacket.getPayload() + coalescedPacket.pos(), size);
+    } else {
+        packet = std::move(coalescingPacket.packet);
+    }
+
+    coalescingPacket.packet.reset();
+    coalescingPacket.numPackets = 0;
+
+    fillPacketHeader(*packet, coalescingPacket.connectionSecret);
+    _nodeSocket.queuePacket(std::move(packet), coalescingPacket.sockAddr);
+}
+
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode,
                                    const HifiSockAddr& overridenSockAddr) {
     if (overridenSockAddr.isNull() && !destinationNode.getActiveSocket()) {
@@ -566,6 +693,12 @@ void LimitedNodeList::handleNodeKill(const SharedNodePointer& node) {
     if (auto activeSocket = node->getActiveSocket()) {
         _nodeSocket.cleanupConnection(*activeSocket);
     }
+
+    {
+        // drop anything we were still coalescing for this node
+        std::lock_guard<std::mutex> locker(_coalescingPacketsMutex);
+        _coalescingPackets.erase(node->getUUID());
+    }
 }
 
 SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t nodeType,
@@ -595,7 +728,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         SharedNodePointer newNodePointer(newNode, &QObject::deleteLater);
 
         // if this is a solo node type, we assume that the DS has replaced its assignment and we should kill the previous node
-        if (SOLO_NODE_TYPES.count(newNode->getType())) {
+        if (_soloNodeTypes.count(newNode->getType())) {
             // while we still have the read lock, see if there is a previous solo node we'll need to remove
             auto previousSoloIt = std::find_if(_nodeHash.cbegin(), _nodeHash.cend(), [newNode](const UUIDNodePair& nodePair){
                 return nodePair.second->getType() == newNode->getType();
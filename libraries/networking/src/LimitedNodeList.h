@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -136,6 +137,26 @@ public:
     qint64 sendPacketList(std::unique_ptr<NLPacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 sendPacketList(std::unique_ptr<NLPacketList> packetList, const Node& destinationNode);
 
+    // unreliable packets queued here are held by the socket until flushQueuedPackets is called,
+    // which lets the mixers write a whole frame of packets in as few system calls as possible
+    qint64 queuePacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
+    qint64 queuePacketList(std::unique_ptr<NLPacketList> packetList, const Node& destinationNode);
+    qint64 flushQueuedPackets();
+
+    // When enabled, small sourced unreliable packets given to sendUnreliablePacket or queuePacket for a node are held
+    // and packed into one CoalescedPackets datagram per node, sent by the next flushQueuedPackets.
+    // Only enable this where flushQueuedPackets is called every tick (the mixers) and the receivers understand CoalescedPackets.
+    void setPacketCoalescingEnabled(bool enabled) { _isPacketCoalescingEnabled = enabled; }
+    bool isPacketCoalescingEnabled() const { return _isPacketCoalescingEnabled; }
+
+    // moves source and hash verification of incoming packets off the socket thread, to a worker batching them
+    void setPacketFilterOnWorkerThread(bool enabled) { _nodeSocket.setPacketFilterOnWorkerThread(enabled); }
+
+    // sub-packets in a CoalescedPackets packet are framed as payload size, type and version, followed by the payload
+    using CoalescedPacketSize = uint16_t;
+    static const int COALESCED_SUB_PACKET_HEADER_SIZE = sizeof(CoalescedPacketSize) + sizeof(PacketType) + sizeof(PacketVersion);
+    static const int MAX_COALESCED_PAYLOAD_SIZE = 300;
+
     std::function<void(Node*)> linkedDataCreateCallback;
 
     size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
@@ -162,8 +183,12 @@ public:
     unsigned int broadcastToNodes(std::unique_ptr<NLPacket> packet, const NodeSet& destinationNodeTypes);
     SharedNodePointer soloNodeOfType(NodeType_t nodeType);
 
+    // a new node of a solo type replaces the previous one, unless there can be several of the type in this domain
+    void removeSoloNodeType(NodeType_t nodeType) { _soloNodeTypes.erase(nodeType); }
+
     void getPacketStats(float& packetsInPerSecond, float& bytesInPerSecond, float& packetsOutPerSecond, float& bytesOutPerSecond);
     void resetPacketStats();
+    int getOutPacketCount() const { return _numCollectedPackets; }
 
     std::unique_ptr<NLPacket> constructPingPacket(PingType_t pingType = PingType::Agnostic);
     std::unique_ptr<NLPacket> constructPingReplyPacket(ReceivedMessage& message);
@@ -266,6 +291,9 @@ public:
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    void setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory> ccFactory) {
+        _nodeSocket.setCongestionControlFactory(std::move(ccFactory));
+    }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
@@ -322,6 +350,7 @@ protected slots:
 
 protected:
     LimitedNodeList(int socketListenPort = INVALID_PORT, int dtlsListenPort = INVALID_PORT);
+    virtual ~LimitedNodeList();
     LimitedNodeList(LimitedNodeList const&) = delete; // Don't implement, needed to avoid copies of singleton
     void operator=(LimitedNodeList const&) = delete; // Don't implement, needed to avoid copies of singleton
 
@@ -332,6 +361,17 @@ protected:
     void collectPacketStats(const NLPacket& packet);
     void fillPacketHeader(const NLPacket& packet, const QUuid& connectionSecret = QUuid());
 
+    struct CoalescingPacket {
+        std::unique_ptr<NLPacket> packet;
+        int numPackets { 0 };
+        HifiSockAddr sockAddr;
+        QUuid connectionSecret;
+    };
+
+    bool shouldCoalescePacket(const NLPacket& packet) const;
+    qint64 coalescePacket(const NLPacket& packet, const Node& destinationNode);
+    void sendCoalescingPacket(CoalescingPacket& coalescingPacket);
+
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
     bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet);
@@ -349,6 +389,7 @@ protected:
     QUuid _sessionUUID;
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex;
+    std::set<NodeType_t> _soloNodeTypes { SOLO_NODE_TYPES };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket;
     HifiSockAddr _localSockAddr;
@@ -358,6 +399,10 @@ protected:
 
     PacketReceiver* _packetReceiver;
 
+    std::atomic<bool> _isPacketCoalescingEnabled { false };
+    std::mutex _coalescingPacketsMutex;
+    std::unordered_map<QUuid, CoalescingPacket, UUIDHasher> _coalescingPackets;
+
     std::atomic<int> _numCollectedPackets;
     std::atomic<int> _numCollectedBytes;
 
@@ -36,6 +36,12 @@ void MessagesClient::init() {
     }
 }
 
+QString MessagesClient::decodeMessagesChannel(QSharedPointer<ReceivedMessage> receivedMessage) {
+    quint16 channelLength;
+    receivedMessage->readPrimitive(&channelLength);
+    return QString::fromUtf8(receivedMessage->read(channelLength));
+}
+
 void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                                 bool& isText, QString& message, QByteArray& data, QUuid& senderID) {
     quint16 channelLength;
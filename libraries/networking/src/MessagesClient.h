@@ -36,6 +36,8 @@ public:
     Q_INVOKABLE void subscribe(QString channel);
     Q_INVOKABLE void unsubscribe(QString channel);
 
+    // only the channel, for passing the rest of the message along as it is
+    static QString decodeMessagesChannel(QSharedPointer<ReceivedMessage> receivedMessage);
     static void decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                            bool& isText, QString& message, QByteArray& data, QUuid& senderID);
 
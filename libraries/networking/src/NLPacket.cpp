@@ -11,6 +11,31 @@
 
 #include "NLPacket.h"
 
+#include <openssl/evp.h>
+
+#include <QtCore/QtEndian>
+
+namespace {
+    // EVP digests use the assembly MD5 OpenSSL was built with, and the context is reused for every packet hashed on a thread.
+    // EVP_MD_CTX_create/destroy are available as macros in every OpenSSL version we support.
+    struct DigestContext {
+        DigestContext() : context(EVP_MD_CTX_create()) {}
+        ~DigestContext() { EVP_MD_CTX_destroy(context); }
+
+        EVP_MD_CTX* context;
+    };
+
+    thread_local DigestContext digestContext;
+
+    // same bytes as QUuid::toRfc4122, without allocating a QByteArray
+    void uuidToRfc4122(const QUuid& uuid, unsigned char* bytes) {
+        qToBigEndian(uuid.data1, bytes);
+        qToBigEndian(uuid.data2, bytes + sizeof(uuid.data1));
+        qToBigEndian(uuid.data3, bytes + sizeof(uuid.data1) + sizeof(uuid.data2));
+        memcpy(bytes + sizeof(uuid.data1) + sizeof(uuid.data2) + sizeof(uuid.data3), uuid.data4, sizeof(uuid.data4));
+    }
+}
+
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = NON_SOURCED_PACKETS.contains(type);
     bool nonVerified = NON_VERIFIED_PACKETS.contains(type);
@@ -32,7 +57,7 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
-std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                        const HifiSockAddr& senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -87,7 +112,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
     _sourceID = other._sourceID;
 }
 
-NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
+NLPacket::NLPacket(udt::PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) :
     Packet(std::move(data), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -150,17 +175,33 @@ QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
 }
 
 QByteArray NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    
+    QByteArray hash(NUM_BYTES_MD5_HASH, Qt::Uninitialized);
+    hashForPacketAndSecret(packet, connectionSecret, hash.data());
+    return hash;
+}
+
+void NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret, char* hash) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
         + NUM_BYTES_RFC4122_UUID + NUM_BYTES_MD5_HASH;
-    
+
+    unsigned char secretBytes[NUM_BYTES_RFC4122_UUID];
+    uuidToRfc4122(connectionSecret, secretBytes);
+
     // add the packet payload and the connection UUID
-    hash.addData(packet.getData() + offset, packet.getDataSize() - offset);
-    hash.addData(connectionSecret.toRfc4122());
-    
-    // return the hash
-    return hash.result();
+    auto context = digestContext.context;
+    EVP_DigestInit_ex(context, EVP_md5(), nullptr);
+    EVP_DigestUpdate(context, packet.getData() + offset, packet.getDataSize() - offset);
+    EVP_DigestUpdate(context, secretBytes, NUM_BYTES_RFC4122_UUID);
+    EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(hash), nullptr);
+}
+
+bool NLPacket::verificationHashMatchesSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
+    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_RFC4122_UUID;
+
+    char expectedHash[NUM_BYTES_MD5_HASH];
+    hashForPacketAndSecret(packet, connectionSecret, expectedHash);
+
+    return memcmp(packet.getData() + offset, expectedHash, NUM_BYTES_MD5_HASH) == 0;
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -217,7 +258,5 @@ void NLPacket::writeVerificationHashGivenSecret(const QUuid& connectionSecret) c
     
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_RFC4122_UUID;
-    QByteArray verificationHash = hashForPacketAndSecret(*this, connectionSecret);
-    
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    hashForPacketAndSecret(*this, connectionSecret, _packet.get() + offset);
 }
@@ -40,7 +40,7 @@ public:
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
     
-    static std::unique_ptr<NLPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<NLPacket> fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                         const HifiSockAddr& senderSockAddr);
     static std::unique_ptr<NLPacket> fromBase(std::unique_ptr<Packet> packet);
     
@@ -60,6 +60,10 @@ public:
     static QUuid sourceIDInHeader(const udt::Packet& packet);
     static QByteArray verificationHashInHeader(const udt::Packet& packet);
     static QByteArray hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret);
+
+    // writes the NUM_BYTES_MD5_HASH byte hash to hash, without allocating - uses a per thread OpenSSL digest context
+    static void hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret, char* hash);
+    static bool verificationHashMatchesSecret(const udt::Packet& packet, const QUuid& connectionSecret);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -75,7 +79,7 @@ public:
 protected:
     
     NLPacket(PacketType type, qint64 size = -1, bool forceReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
-    NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr);
+    NLPacket(udt::PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr);
     
     NLPacket(const NLPacket& other);
     NLPacket(NLPacket&& other);
@@ -21,6 +21,7 @@
 #include <QtNetwork/QNetworkInterface>
 
 #include <LogHandler.h>
+#include <StreamUtils.h>
 #include <UUID.h>
 
 #include "AccountManager.h"
@@ -102,6 +103,9 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
+    // the domain-server wouldn't send a node it thinks we have again, so after losing one we ask for the whole list
+    connect(this, &LimitedNodeList::nodeKilled, this, [this] { _domainListVersion = 0; }, Qt::DirectConnection);
+
     // setup our timer to send keepalive pings (it's started and stopped on domain connect/disconnect)
     _keepAlivePingTimer.setInterval(KEEPALIVE_PING_INTERVAL_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_keepAlivePingTimer, &QTimer::timeout, this, &NodeList::sendKeepAlivePings);
@@ -159,6 +163,20 @@ qint64 NodeList::sendStatsToDomainServer(QJsonObject statsObject) {
     return sendStats(statsObject, _domainHandler.getSockAddr());
 }
 
+qint64 NodeList::sendMetricsToDomainServer(QByteArray serializedMetrics) {
+    if (thread() != QThread::currentThread()) {
+        QMetaObject::invokeMethod(this, "sendMetricsToDomainServer", Qt::QueuedConnection,
+                                  Q_ARG(QByteArray, serializedMetrics));
+        return 0;
+    }
+
+    auto metricsPacketList = NLPacketList::create(PacketType::NodeMetrics, QByteArray(), true, true);
+    metricsPacketList->write(serializedMetrics);
+
+    sendPacketList(std::move(metricsPacketList), _domainHandler.getSockAddr());
+    return 0;
+}
+
 void NodeList::timePingReply(ReceivedMessage& message, const SharedNodePointer& sendingNode) {
     PingType_t pingType;
 
@@ -238,6 +256,7 @@ void NodeList::reset() {
     LimitedNodeList::reset();
 
     _numNoReplyDomainCheckIns = 0;
+    _domainListVersion = 0;
 
     // lock and clear our set of radius ignored IDs
     _radiusIgnoredSetLock.lockForWrite();
@@ -397,6 +416,13 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            packetStream << _domainListVersion.load();
+
+            // the domain server picks the audio mixer of our region with it, in a domain split into regions
+            packetStream << DependencyManager::get<AddressManager>()->currentPosition();
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -626,6 +652,11 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
+    // the nodes that follow are only those that changed since the list we acknowledge with this version
+    quint32 domainListVersion;
+    packetStream >> domainListVersion;
+    _domainListVersion = domainListVersion;
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
         parseNodeFromPacketStream(packetStream);
@@ -57,6 +57,7 @@ public:
 
     Q_INVOKABLE qint64 sendStats(QJsonObject statsObject, HifiSockAddr destination);
     Q_INVOKABLE qint64 sendStatsToDomainServer(QJsonObject statsObject);
+    Q_INVOKABLE qint64 sendMetricsToDomainServer(QByteArray serializedMetrics);
 
     int getNumNoReplyDomainCheckIns() const { return _numNoReplyDomainCheckIns; }
     DomainHandler& getDomainHandler() { return _domainHandler; }
@@ -165,6 +166,10 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData;
 
+    // the version of the last list from the domain-server, which only sends the nodes that changed since then;
+    // 0 asks it for all of them again
+    std::atomic<quint32> _domainListVersion { 0 };
+
     mutable QReadWriteLock _radiusIgnoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _radiusIgnoredNodeIDs;
     mutable QReadWriteLock _ignoredSetLock;
@@ -178,6 +178,139 @@ void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object,
     _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
 }
 
+bool PacketReceiver::registerShardedListener(PacketType type, QObject* listener, ShardedListener handler,
+                                             bool deliverPending) {
+    Q_ASSERT_X(listener, "PacketReceiver::registerShardedListener", "No object to register");
+    Q_ASSERT_X(handler, "PacketReceiver::registerShardedListener", "No handler to register");
+
+    if (!listener || !handler) {
+        qCWarning(networking) << "FAILED to Register a sharded packet listener for packet list type" << type;
+        return false;
+    }
+
+    QMutexLocker locker(&_packetListenerLock);
+
+    if (_shardedListenerMap.contains(type) || _messageListenerMap.contains(type)) {
+        qCWarning(networking) << "Registering a sharded packet listener for packet type" << type
+            << "that will take over from a previously registered listener";
+    }
+
+    qCDebug(networking) << "Registering a sharded packet listener for packet list type" << type;
+    _shardedListenerMap[type] = std::make_shared<ShardedListenerEntry>(
+        ShardedListenerEntry { QPointer<QObject>(listener), handler, deliverPending });
+
+    return true;
+}
+
+bool PacketReceiver::registerShardedListenerForTypes(PacketTypeList types, QObject* listener, ShardedListener handler) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerShardedListenerForTypes", "No types to register");
+
+    bool success = true;
+    for (auto type : types) {
+        success = registerShardedListener(type, listener, handler) && success;
+    }
+    return success;
+}
+
+void PacketReceiver::setNumDispatchShards(int numShards) {
+    numShards = std::max(numShards, 0);
+
+    QMutexLocker locker(&_packetListenerLock);
+
+    if ((int)_dispatchShards.size() == numShards) {
+        return;
+    }
+
+    qCDebug(networking) << "Changing number of packet dispatch shards from" << _dispatchShards.size() << "to" << numShards;
+
+    // each shard drains its queue before its thread is joined, so nothing already dispatched is dropped
+    _dispatchShards.clear();
+    _dispatchShards.reserve(numShards);
+    for (int i = 0; i < numShards; ++i) {
+        _dispatchShards.emplace_back(new DispatchShard());
+    }
+}
+
+int PacketReceiver::getNumQueuedShardedMessages() {
+    QMutexLocker locker(&_packetListenerLock);
+
+    int numQueued = 0;
+    for (const auto& shard : _dispatchShards) {
+        numQueued += shard->getNumQueued();
+    }
+    return numQueued;
+}
+
+PacketReceiver::DispatchShard::DispatchShard() :
+    _thread([this] { run(); })
+{
+}
+
+PacketReceiver::DispatchShard::~DispatchShard() {
+    // an empty task tells the shard thread to stop
+    _tasks.push(ShardedTask());
+    _thread.join();
+}
+
+void PacketReceiver::DispatchShard::run() {
+    ShardedTask task;
+    while (true) {
+        _tasks.pop(task);
+
+        if (!task.listener) {
+            return;
+        }
+
+        // one final check on the QPointer before we call the handler
+        if (task.listener->object) {
+            task.listener->handler(task.message, task.node);
+        }
+
+        // release our references now rather than holding them until the next task arrives
+        task = ShardedTask();
+    }
+}
+
+bool PacketReceiver::dispatchToShardedListener(const QSharedPointer<ReceivedMessage>& receivedMessage,
+                                               const QSharedPointer<Node>& matchingNode, bool justReceived) {
+    // the caller holds _packetListenerLock
+    auto it = _shardedListenerMap.find(receivedMessage->getType());
+    if (it == _shardedListenerMap.end()) {
+        return false;
+    }
+
+    auto listener = it.value();
+
+    if (!listener->object) {
+        qCDebug(networking).nospace() << "Sharded listener for packet " << receivedMessage->getType()
+            << " has been destroyed. Removing from listener map.";
+        _shardedListenerMap.erase(it);
+        return true;
+    }
+
+    if ((listener->deliverPending && !justReceived) || (!listener->deliverPending && !receivedMessage->isComplete())) {
+        return true;
+    }
+
+    if (matchingNode) {
+        matchingNode->recordBytesReceived(receivedMessage->getSize());
+    }
+
+    if (_dispatchShards.empty()) {
+        listener->handler(receivedMessage, matchingNode);
+        return true;
+    }
+
+    // pick the shard by source so that everything from one sender lands on the same thread, in order
+    size_t shardKey = receivedMessage->getSourceID().isNull()
+        ? std::hash<HifiSockAddr>()(receivedMessage->getSenderSockAddr())
+        : (size_t)qHash(receivedMessage->getSourceID());
+
+    _dispatchShards[shardKey % _dispatchShards.size()]->push({ listener, receivedMessage, matchingNode });
+
+    return true;
+}
+
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
     
@@ -194,30 +327,91 @@ void PacketReceiver::unregisterListener(QObject* listener) {
                 ++it;
             }
         }
+
+        // and any sharded registrations for it
+        auto shardedIt = _shardedListenerMap.begin();
+
+        while (shardedIt != _shardedListenerMap.end()) {
+            if (shardedIt.value()->object == listener) {
+                shardedIt = _shardedListenerMap.erase(shardedIt);
+            } else {
+                ++shardedIt;
+            }
+        }
     }
     
     QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
     _directlyConnectedObjects.remove(listener);
 }
 
+bool PacketReceiver::startCapture(const QString& path, NodeType_t ownerType) {
+    bool isOpen = _captureWriter.open(path, ownerType);
+    _isCapturing = isOpen;
+    return isOpen;
+}
+
+void PacketReceiver::stopCapture() {
+    _isCapturing = false;
+    _captureWriter.close();
+}
+
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     // if we're supposed to drop this packet then break out here
     if (_shouldDropPackets) {
         return;
     }
     
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
 
     _inPacketCount += 1;
     _inByteCount += nlPacket->size();
 
+    if (nlPacket->getType() == PacketType::CoalescedPackets) {
+        handleCoalescedPacket(*nlPacket);
+        return;
+    }
+
+    // the message takes the packet, so its payload is read in place
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
+
     handleVerifiedMessage(receivedMessage, true);
 }
 
+void PacketReceiver::handleCoalescedPacket(NLPacket& packet) {
+    // the CoalescedPackets packet was verified as a whole, each sub-packet is handled as if it came from its source
+    while (packet.bytesLeftToRead() >= LimitedNodeList::COALESCED_SUB_PACKET_HEADER_SIZE) {
+        LimitedNodeList::CoalescedPacketSize size;
+        PacketType type;
+        PacketVersion version;
+        packet.readPrimitive(&size);
+        packet.readPrimitive(&type);
+        packet.readPrimitive(&version);
+
+        if (size > packet.bytesLeftToRead()) {
+            qCDebug(networking) << "Dropping truncated sub-packet of type" << type << "from a CoalescedPackets packet";
+            return;
+        }
+
+        if (type == PacketType::CoalescedPackets || NON_SOURCED_PACKETS.contains(type)
+            || version != versionForPacketType(type)) {
+            packet.seek(packet.pos() + size);
+            continue;
+        }
+
+        auto subPacket = NLPacket::create(type, size, false, false, version);
+        subPacket->write(packet.getPayload() + packet.pos(), size);
+        subPacket->seek(0);
+        subPacket->writeSourceID(packet.getSourceID());
+        subPacket->getSenderSockAddr() = packet.getSenderSockAddr();
+        subPacket->setReceiveTime(packet.getReceiveTime());
+
+        packet.seek(packet.pos() + size);
+
+        handleVerifiedMessage(QSharedPointer<ReceivedMessage>::create(std::move(subPacket)), true);
+    }
+}
+
 void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> packet) {
     auto nlPacket = NLPacket::fromBase(std::move(packet));
 
@@ -230,14 +424,14 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     if (it == _pendingMessages.end()) {
         // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -257,15 +451,24 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    auto nodeList = DependencyManager::getRaw<LimitedNodeList>();
     
     SharedNodePointer matchingNode;
     
     if (!receivedMessage->getSourceID().isNull()) {
         matchingNode = nodeList->nodeWithUUID(receivedMessage->getSourceID());
     }
+
+    // a message is captured once, when its last packet has arrived
+    if (_isCapturing && receivedMessage->isComplete()) {
+        _captureWriter.write(*receivedMessage, matchingNode ? matchingNode->getType() : NodeType::Unassigned);
+    }
     
     QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+    if (dispatchToShardedListener(receivedMessage, matchingNode, justReceived)) {
+        return;
+    }
     
     bool listenerIsDead = false;
     
@@ -13,6 +13,11 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 
@@ -23,12 +28,16 @@
 #include <QtCore/QPointer>
 #include <QtCore/QSet>
 
+#include <tbb/concurrent_queue.h>
+
 #include "NLPacket.h"
 #include "NLPacketList.h"
 #include "ReceivedMessage.h"
+#include "TrafficCapture.h"
 #include "udt/PacketHeaders.h"
 
 class EntityEditPacketSender;
+class Node;
 class OctreePacketProcessor;
 
 namespace std {
@@ -44,6 +53,7 @@ class PacketReceiver : public QObject {
     Q_OBJECT
 public:
     using PacketTypeList = std::vector<PacketType>;
+    using ShardedListener = std::function<void(QSharedPointer<ReceivedMessage>, QSharedPointer<Node>)>;
     
     PacketReceiver(QObject* parent = 0);
     PacketReceiver(const PacketReceiver&) = delete;
@@ -63,6 +73,20 @@ public:
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
     void unregisterListener(QObject* listener);
+
+    // Sharded listeners are called directly (no QMetaMethod invoke) on one of the dispatch shard threads.
+    // The shard is picked by source node so that messages from one node are always handled in order.
+    // With no shards (the default) the listener is called on the thread that received the message.
+    bool registerShardedListener(PacketType type, QObject* listener, ShardedListener handler, bool deliverPending = false);
+    bool registerShardedListenerForTypes(PacketTypeList types, QObject* listener, ShardedListener handler);
+    void setNumDispatchShards(int numShards);
+    int getNumDispatchShards() const { return (int)_dispatchShards.size(); }
+    // messages waiting on the dispatch shards for their listeners
+    int getNumQueuedShardedMessages();
+
+    // records every complete message handled from now on, with its timing, for replaying it with tools/traffic-replay
+    bool startCapture(const QString& path, NodeType_t ownerType);
+    void stopCapture();
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -75,7 +99,39 @@ private:
         bool deliverPending;
     };
 
+    struct ShardedListenerEntry {
+        QPointer<QObject> object;
+        ShardedListener handler;
+        bool deliverPending;
+    };
+    using SharedShardedListener = std::shared_ptr<ShardedListenerEntry>;
+
+    struct ShardedTask {
+        SharedShardedListener listener;
+        QSharedPointer<ReceivedMessage> message;
+        QSharedPointer<Node> node;
+    };
+
+    class DispatchShard {
+    public:
+        DispatchShard();
+        ~DispatchShard();
+
+        void push(ShardedTask task) { _tasks.push(std::move(task)); }
+        // negative while the shard's thread waits on the empty queue
+        int getNumQueued() const { return std::max((int)_tasks.size(), 0); }
+
+    private:
+        void run();
+
+        tbb::concurrent_bounded_queue<ShardedTask> _tasks;
+        std::thread _thread;
+    };
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
+    void handleCoalescedPacket(NLPacket& packet);
+    bool dispatchToShardedListener(const QSharedPointer<ReceivedMessage>& message, const QSharedPointer<Node>& node,
+                                   bool justReceived);
 
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
     // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
@@ -87,9 +143,13 @@ private:
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
+    QHash<PacketType, SharedShardedListener> _shardedListenerMap;
+    std::vector<std::unique_ptr<DispatchShard>> _dispatchShards;
     int _inPacketCount = 0;
     int _inByteCount = 0;
     bool _shouldDropPackets = false;
+    std::atomic<bool> _isCapturing { false };
+    TrafficCaptureWriter _captureWriter;
     QMutex _directConnectSetMutex;
     QSet<QObject*> _directlyConnectedObjects;
 
@@ -12,7 +12,10 @@
 
 #include "ReceivedMessage.h"
 
-#include "QSharedPointer"
+#include <algorithm>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QSharedPointer>
 
 int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
 int sharedPtrReceivedMessageMetaTypeId = qRegisterMetaType<QSharedPointer<ReceivedMessage>>("QSharedPointer<ReceivedMessage>");
@@ -20,27 +23,44 @@ int sharedPtrReceivedMessageMetaTypeId = qRegisterMetaType<QSharedPointer<Receiv
 static const int HEAD_DATA_SIZE = 512;
 
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
-    : _data(packetList.getMessage()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(packetList.getNumPackets()),
+    : _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr()),
       _isComplete(true)
 {
+    auto message = packetList.getMessage();
+    _headData = message.mid(0, HEAD_DATA_SIZE);
+    appendSegment(nullptr, message, message.constData(), message.size());
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
-    : _data(packet.readAll()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(1),
+    : _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
       _packetVersion(packet.getVersion()),
       _senderSockAddr(packet.getSenderSockAddr()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    auto payload = packet.readAll();
+    _headData = payload.mid(0, HEAD_DATA_SIZE);
+    appendSegment(nullptr, payload, payload.constData(), payload.size());
+}
+
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _numPackets(1),
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
+{
+    const char* data = packet->getPayload() + packet->pos();
+    qint64 size = packet->bytesLeftToRead();
+
+    _headData = QByteArray(data, std::min(size, (qint64)HEAD_DATA_SIZE));
+    appendSegment(std::move(packet), QByteArray(), data, size);
 }
 
 void ReceivedMessage::setFailed() {
@@ -49,17 +69,48 @@ void ReceivedMessage::setFailed() {
     emit completed();
 }
 
+void ReceivedMessage::appendSegment(std::unique_ptr<NLPacket> packet, QByteArray bytes, const char* data, qint64 size) {
+    std::lock_guard<std::mutex> locker(_segmentsLock);
+
+    qint64 offset = _size;
+    _segments.push_back({ std::move(packet), bytes, data, size, offset });
+
+    if (_isCoalesced) {
+        // someone already needed this message in one piece before it was complete, keep that piece up to date
+        _coalesced.append(data, size);
+    }
+
+    _size = offset + size;
+}
+
 void ReceivedMessage::appendPacket(NLPacket& packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
+    auto payload = QByteArray(packet.getPayload(), packet.getPayloadSize());
+    appendSegment(nullptr, payload, payload.constData(), payload.size());
+
+    onPacketAppended(packet);
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
+    Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket",
+               "We should not be appending to a complete message");
+
+    auto& packetRef = *packet;
+    const char* data = packet->getPayload();
+    qint64 size = packet->getPayloadSize();
+    appendSegment(std::move(packet), QByteArray(), data, size);
+
+    onPacketAppended(packetRef);
+}
+
+void ReceivedMessage::onPacketAppended(NLPacket& packet) {
     // Limit progress signal to every X packets
     const int EMIT_PROGRESS_EVERY_X_PACKETS = 50;
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
-
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
@@ -70,14 +121,108 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     }
 }
 
+std::unique_lock<std::mutex> ReceivedMessage::lockIfIncomplete() const {
+    if (_isComplete) {
+        return std::unique_lock<std::mutex>(_segmentsLock, std::defer_lock);
+    } else {
+        return std::unique_lock<std::mutex>(_segmentsLock);
+    }
+}
+
+size_t ReceivedMessage::segmentIndexAt(qint64 position) const {
+    // the last segment starting at or before the position
+    auto it = std::upper_bound(_segments.begin(), _segments.end(), position, [](qint64 position, const Segment& segment) {
+        return position < segment.offset;
+    });
+    return std::max((size_t)std::distance(_segments.begin(), it), (size_t)1) - 1;
+}
+
+qint64 ReceivedMessage::copyOut(char* data, qint64 position, qint64 size) const {
+    auto locker = lockIfIncomplete();
+
+    if (_isCoalesced) {
+        memcpy(data, _coalesced.constData() + position, size);
+        return size;
+    }
+
+    qint64 copied = 0;
+    for (size_t i = segmentIndexAt(position); i < _segments.size() && copied < size; ++i) {
+        const auto& segment = _segments[i];
+        qint64 segmentPosition = position + copied - segment.offset;
+        qint64 toCopy = std::min(segment.size - segmentPosition, size - copied);
+
+        memcpy(data + copied, segment.data + segmentPosition, toCopy);
+        copied += toCopy;
+    }
+
+    return copied;
+}
+
+const char* ReceivedMessage::dataAt(qint64 position, qint64 size) const {
+    {
+        auto locker = lockIfIncomplete();
+
+        if (!_isCoalesced && !_segments.empty()) {
+            const auto& segment = _segments[segmentIndexAt(position)];
+            if (position + size <= segment.offset + segment.size) {
+                return segment.data + (position - segment.offset);
+            }
+        }
+    }
+
+    return contiguousData() + position;
+}
+
+const char* ReceivedMessage::contiguousData() const {
+    if (_isCoalesced) {
+        return _coalesced.constData();
+    }
+
+    std::lock_guard<std::mutex> locker(_segmentsLock);
+
+    if (_segments.empty()) {
+        return nullptr;
+    } else if (_segments.size() == 1) {
+        return _segments.front().data;
+    }
+
+    if (!_isCoalesced) {
+        _coalesced.reserve(_size);
+        for (const auto& segment : _segments) {
+            _coalesced.append(segment.data, segment.size);
+        }
+        _isCoalesced = true;
+    }
+
+    return _coalesced.constData();
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    {
+        auto locker = lockIfIncomplete();
+
+        if (!_isCoalesced && _segments.size() == 1 && !_segments.front().packet) {
+            // already in a QByteArray, share it
+            return _segments.front().bytes;
+        }
+    }
+
+    const char* data = contiguousData();
+
+    if (_isCoalesced) {
+        return _coalesced;
+    } else {
+        return QByteArray(data, _size);
+    }
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
-    return size;
+    return copyOut(data, _position, size);
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
-    _position += size;
+    auto position = _position.fetch_add(size);
+    copyOut(data, position, size);
     return size;
 }
 
@@ -88,12 +233,15 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    size = std::max(std::min(size, getBytesLeftToRead()), (qint64)0);
+    QByteArray data(size, Qt::Uninitialized);
+    copyOut(data.data(), _position, size);
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
-    _position += size;
+    auto data = peek(size);
+    _position += data.size();
     return data;
 }
 
@@ -104,6 +252,13 @@ QByteArray ReceivedMessage::readHead(qint64 size) {
 }
 
 QByteArray ReceivedMessage::readAll() {
+    if (_position == 0) {
+        // the whole message - share the underlying buffer if there is one
+        auto data = getMessage();
+        _position = data.size();
+        return data;
+    }
+
     return read(getBytesLeftToRead());
 }
 
@@ -111,18 +266,66 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
+    auto string = QString::fromUtf8(dataAt(_position, size), size);
     _position += size;
     return string;
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    QByteArray data { QByteArray::fromRawData(dataAt(_position, size), size) };
     _position += size;
     return data;
 }
 
-void ReceivedMessage::onComplete() {
-    _isComplete = true;
-    emit completed();
+qint64 ReceivedMessage::readSegments(qint64 size, const SegmentCallback& callback) {
+    size = std::max(std::min(size, getBytesLeftToRead()), (qint64)0);
+
+    qint64 position = _position;
+    qint64 handedOut = 0;
+
+    auto locker = lockIfIncomplete();
+
+    if (_isCoalesced) {
+        if (size > 0 && callback(_coalesced.constData() + position, size)) {
+            handedOut = size;
+        }
+    } else {
+        for (size_t i = segmentIndexAt(position); i < _segments.size() && handedOut < size; ++i) {
+            const auto& segment = _segments[i];
+            qint64 segmentPosition = position + handedOut - segment.offset;
+            qint64 pieceSize = std::min(segment.size - segmentPosition, size - handedOut);
+
+            if (!callback(segment.data + segmentPosition, pieceSize)) {
+                break;
+            }
+            handedOut += pieceSize;
+        }
+    }
+
+    _position = position + handedOut;
+    return handedOut;
+}
+
+qint64 ReceivedMessage::readInto(QIODevice& device, qint64 size) {
+    return readSegments(size, [&device](const char* data, qint64 size) {
+        return device.write(data, size) == size;
+    });
+}
+
+void ReceivedMessage::releaseReadSegments() {
+    std::lock_guard<std::mutex> locker(_segmentsLock);
+    if (_isCoalesced) {
+        return;
+    }
+
+    // the segments keep their offsets, so the ones after them are still found by position
+    for (; _numReleasedSegments < _segments.size(); ++_numReleasedSegments) {
+        auto& segment = _segments[_numReleasedSegments];
+        if (segment.offset + segment.size > _position) {
+            break;
+        }
+        segment.packet.reset();
+        segment.bytes = QByteArray();
+        segment.data = nullptr;
+    }
 }
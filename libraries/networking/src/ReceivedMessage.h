@@ -16,17 +16,30 @@
 #include <QObject>
 
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
+class QIODevice;
+
+// The payloads of a multi packet message are kept in the packets they arrived in (a scatter list) instead of
+// being copied into one buffer. read/peek copy straight out of the packets, readSegments/readInto hand them out
+// without a copy, and the accessors that need one contiguous buffer (getMessage, getRawMessage, readWithoutCopy)
+// coalesce the message the first time they are used.
 class ReceivedMessage : public QObject {
     Q_OBJECT
 public:
+    using SegmentCallback = std::function<bool(const char* data, qint64 size)>;
+
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+    ReceivedMessage(std::unique_ptr<NLPacket> packet); // takes the packet, without copying its payload
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    QByteArray getMessage() const;
+    const char* getRawMessage() const { return contiguousData(); }
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
@@ -34,6 +47,7 @@ public:
     void setFailed();
 
     void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet); // takes the packet, without copying its payload
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -46,9 +60,9 @@ public:
     // Get the number of packets that were used to send this message
     qint64 getNumPackets() const { return _numPackets; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size -  _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -72,6 +86,17 @@ public:
     // exceed that of the ReceivedMessage.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Calls back with each contiguous piece of the next size bytes, in order and without copying them.
+    // Stops early if the callback returns false, and returns the number of bytes that were handed out.
+    qint64 readSegments(qint64 size, const SegmentCallback& callback);
+
+    // Writes the next size bytes to the device (a file for large transfers), returns the number of bytes written
+    qint64 readInto(QIODevice& device, qint64 size);
+
+    // Frees the packets read past, for large messages consumed as they arrive.
+    // Nothing before the position can be read after this.
+    void releaseReadSegments();
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -81,11 +106,36 @@ signals:
     void progress(qint64 size);
     void completed();
 
-private slots:
-    void onComplete();
-
 private:
-    QByteArray _data;
+    struct Segment {
+        std::unique_ptr<NLPacket> packet; // the packet the data lives in, or null if it is in bytes
+        QByteArray bytes;
+        const char* data;
+        qint64 size;
+        qint64 offset; // from the start of the message
+    };
+
+    void appendSegment(std::unique_ptr<NLPacket> packet, QByteArray bytes, const char* data, qint64 size);
+    void onPacketAppended(NLPacket& packet);
+
+    // segments are only appended to until the message is complete, after that they can be read without locking
+    std::unique_lock<std::mutex> lockIfIncomplete() const;
+
+    size_t segmentIndexAt(qint64 position) const;
+    qint64 copyOut(char* data, qint64 position, qint64 size) const;
+
+    // returns a pointer to size bytes at position, coalescing the message if they span segments
+    const char* dataAt(qint64 position, qint64 size) const;
+    const char* contiguousData() const;
+
+    mutable std::mutex _segmentsLock;
+    std::vector<Segment> _segments;
+    size_t _numReleasedSegments { 0 };
+    std::atomic<qint64> _size { 0 };
+
+    mutable QByteArray _coalesced;
+    mutable std::atomic<bool> _isCoalesced { false };
+
     QByteArray _headData;
 
     std::atomic<qint64> _position { 0 };
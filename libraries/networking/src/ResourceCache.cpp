@@ -9,12 +9,14 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
 #include <QThread>
 #include <QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <assert.h>
 
@@ -35,16 +37,25 @@ void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resour
     _loadingRequests.append(resource);
 }
 
+// The load priorities change as their owners move, but taking them from thousands of pending resources
+// on every request completed costs more than following those changes closely is worth
+static const quint64 PENDING_PRIORITIES_UPDATE_INTERVAL = 100 * USECS_PER_MSEC;
+
 void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    float priority = strongResource ? strongResource->getLoadPriority() : -FLT_MAX;
+
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+    _pendingRequests.push_back({ resource, priority });
+    std::push_heap(_pendingRequests.begin(), _pendingRequests.end(), isLowerPriority);
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _pendingRequests) {
+    for (const auto& request : _pendingRequests) {
+        auto resource = request.resource.lock();
         if (resource) {
             result.append(resource);
         }
@@ -93,36 +104,40 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
-QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
-    Lock lock(_mutex);
-
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+void ResourceCacheSharedItems::updatePendingPriorities() {
+    // Clear any freed resources, and take the priorities of the others again
+    auto end = std::remove_if(_pendingRequests.begin(), _pendingRequests.end(), [](PendingRequest& request) {
+        auto resource = request.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
-            continue;
+            return true;
         }
+        request.priority = resource->getLoadPriority();
+        return false;
+    });
+    _pendingRequests.erase(end, _pendingRequests.end());
+    std::make_heap(_pendingRequests.begin(), _pendingRequests.end(), isLowerPriority);
+}
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        if (priority >= highestPriority) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-        }
-        i++;
+QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
+    Lock lock(_mutex);
+
+    auto now = usecTimestampNow();
+    if (now - _pendingPrioritiesUpdated > PENDING_PRIORITIES_UPDATE_INTERVAL) {
+        _pendingPrioritiesUpdated = now;
+        updatePendingPriorities();
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    // look for the highest priority pending request still alive
+    while (!_pendingRequests.empty()) {
+        std::pop_heap(_pendingRequests.begin(), _pendingRequests.end(), isLowerPriority);
+        auto resource = _pendingRequests.back().resource.lock();
+        _pendingRequests.pop_back();
+        if (resource) {
+            return resource;
+        }
     }
 
-    return highestResource;
+    return QSharedPointer<Resource>();
 }
 
 ScriptableResource::ScriptableResource(const QUrl& url) :
@@ -476,7 +491,9 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
 
-    if (_requestsActive >= _requestLimit) {
+    // Local files don't wait on the downloads, nor hold them up for long
+    bool isLocalRequest = (ResourceManager::normalizeURL(resource->_activeUrl).scheme() == URL_SCHEME_FILE);
+    if (_requestsActive >= _requestLimit && !isLocalRequest) {
         // wait until a slot becomes available
         sharedItems->appendPendingRequest(resource);
         return false;
@@ -612,6 +629,7 @@ void Resource::init() {
     _loaded = false;
     _attempts = 0;
     _activeUrl = _url;
+    _requestByteRange = ByteRange();
     
     if (_url.isEmpty()) {
         _startedLoading = _loaded = true;
@@ -675,6 +693,8 @@ void Resource::makeRequest() {
         PROFILE_ASYNC_END(resource, "Resource:" + getType(), QString::number(_requestID));
         return;
     }
+
+    _request->setByteRange(_requestByteRange);
     
     qCDebug(resourceLog).noquote() << "Starting request for:" << _url.toDisplayString();
     emit loading();
@@ -722,39 +742,43 @@ void Resource::handleReplyFinished() {
         emit loaded(data);
         downloadFinished(data);
     } else {
-        switch (result) {
-            case ResourceRequest::Result::Timeout: {
-                qCDebug(networking) << "Timed out loading" << _url << "received" << _bytesReceived << "total" << _bytesTotal;
-                // Fall through to other cases
-            }
-            case ResourceRequest::Result::ServerUnavailable: {
-                // retry with increasing delays
-                const int BASE_DELAY_MS = 1000;
-                if (_attempts++ < MAX_ATTEMPTS) {
-                    auto waitTime = BASE_DELAY_MS * (int)pow(2.0, _attempts);
+        handleFailedRequest(result);
+    }
+    
+    _request->disconnect(this);
+    _request->deleteLater();
+    _request = nullptr;
+}
 
-                    qCDebug(networking).noquote() << "Server unavailable for" << _url << "- may retry in" << waitTime << "ms"
-                        << "if resource is still needed";
+void Resource::handleFailedRequest(ResourceRequest::Result result) {
+    switch (result) {
+        case ResourceRequest::Result::Timeout: {
+            qCDebug(networking) << "Timed out loading" << _url << "received" << _bytesReceived << "total" << _bytesTotal;
+            // Fall through to other cases
+        }
+        case ResourceRequest::Result::ServerUnavailable: {
+            // retry with increasing delays
+            const int BASE_DELAY_MS = 1000;
+            if (_attempts++ < MAX_ATTEMPTS) {
+                auto waitTime = BASE_DELAY_MS * (int)pow(2.0, _attempts);
 
-                    QTimer::singleShot(waitTime, this, &Resource::attemptRequest);
-                    break;
-                }
-                // fall through to final failure
-            }
-            default: {
-                qCDebug(networking) << "Error loading " << _url;
-                auto error = (result == ResourceRequest::Timeout) ? QNetworkReply::TimeoutError
-                                                                  : QNetworkReply::UnknownNetworkError;
-                emit failed(error);
-                finishedLoading(false);
+                qCDebug(networking).noquote() << "Server unavailable for" << _url << "- may retry in" << waitTime << "ms"
+                    << "if resource is still needed";
+
+                QTimer::singleShot(waitTime, this, &Resource::attemptRequest);
                 break;
             }
+            // fall through to final failure
+        }
+        default: {
+            qCDebug(networking) << "Error loading " << _url;
+            auto error = (result == ResourceRequest::Timeout) ? QNetworkReply::TimeoutError
+                                                              : QNetworkReply::UnknownNetworkError;
+            emit failed(error);
+            finishedLoading(false);
+            break;
         }
     }
-    
-    _request->disconnect(this);
-    _request->deleteLater();
-    _request = nullptr;
 }
 
 uint qHash(const QPointer<QObject>& value, uint seed) {
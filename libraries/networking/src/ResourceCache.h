@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -33,6 +34,7 @@
 #include <DependencyManager.h>
 
 #include "ResourceManager.h"
+#include "ResourceRequest.h"
 
 Q_DECLARE_METATYPE(size_t)
 
@@ -78,8 +80,18 @@ public:
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        float priority;
+    };
+
+    static bool isLowerPriority(const PendingRequest& a, const PendingRequest& b) { return a.priority < b.priority; }
+    void updatePendingPriorities();
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
+    // a heap of the pending requests by their load priority when last taken
+    std::vector<PendingRequest> _pendingRequests;
+    quint64 _pendingPrioritiesUpdated { 0 };
     QList<QWeakPointer<Resource>> _loadingRequests;
 };
 
@@ -364,7 +376,7 @@ public:
     virtual void clearLoadPriority(const QPointer<QObject>& owner);
     
     /// Returns the highest load priority across all owners.
-    float getLoadPriority();
+    virtual float getLoadPriority();
 
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
@@ -431,6 +443,10 @@ protected:
     /// This should be overridden by subclasses that need to process the data once it is downloaded.
     virtual void downloadFinished(const QByteArray& data) { finishedLoading(true); }
 
+    /// Called when the download has failed, retries the requests the server was unavailable for or else fails the load.
+    /// This can be overridden by subclasses whose later requests failing shouldn't fail what they already loaded.
+    virtual void handleFailedRequest(ResourceRequest::Result result);
+
     /// Called when the download is finished and processed, sets the number of actual bytes.
     void setSize(const qint64& bytes);
 
@@ -442,6 +458,7 @@ protected:
 
     QUrl _url;
     QUrl _activeUrl;
+    ByteRange _requestByteRange;
     bool _startedLoading = false;
     bool _failedToLoad = false;
     bool _loaded = false;
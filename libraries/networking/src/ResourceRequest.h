@@ -17,6 +17,15 @@
 
 #include <cstdint>
 
+// The bytes [fromInclusive, toExclusive) of a resource, or all of it when not set
+struct ByteRange {
+    int64_t fromInclusive { 0 };
+    int64_t toExclusive { 0 };
+
+    bool isSet() const { return fromInclusive < toExclusive; }
+    int64_t size() const { return toExclusive - fromInclusive; }
+};
+
 class ResourceRequest : public QObject {
     Q_OBJECT
 public:
@@ -48,6 +57,7 @@ public:
     bool loadedFromCache() const { return _loadedFromCache; }
 
     void setCacheEnabled(bool value) { _cacheEnabled = value; }
+    void setByteRange(ByteRange byteRange) { _byteRange = byteRange; }
 
 public slots:
     void send();
@@ -65,6 +75,7 @@ protected:
     QByteArray _data;
     bool _cacheEnabled { true };
     bool _loadedFromCache { false };
+    ByteRange _byteRange;
 };
 
 #endif
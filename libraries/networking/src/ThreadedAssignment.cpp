@@ -9,22 +9,48 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <atomic>
+#include <csignal>
+
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <Metrics.h>
+#include <SharedUtil.h>
 
 #include "ThreadedAssignment.h"
 
 #include "NetworkLogging.h"
+#include "TrafficCapture.h"
+#include "udt/PacketPool.h"
+
+namespace {
+    std::atomic<bool> frameStatsDumpRequested { false };
+
+#ifndef Q_OS_WIN
+    void requestFrameStatsDump(int signal) {
+        frameStatsDumpRequested = true;
+    }
+#endif
+}
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
     _isFinished(false),
     _domainServerTimer(this),
-    _statsTimer(this)
+    _statsTimer(this),
+    _frameUsecsMetric(metrics::Registry::getInstance().histogram("assignment_frame_usecs",
+        { 1000, 2500, 5000, 10000, 15000, 20000, 50000, 100000 })),
+    _packetsInMetric(metrics::Registry::getInstance().counter("assignment_packets_received_total")),
+    _packetsOutMetric(metrics::Registry::getInstance().counter("assignment_packets_sent_total"))
 {
     static const int STATS_TIMEOUT_MS = 1000;
     _statsTimer.setInterval(STATS_TIMEOUT_MS); // 1s, Qt::CoarseTimer acceptable
@@ -55,6 +81,7 @@ void ThreadedAssignment::setFinished(bool isFinished) {
 
             // we should also tell the packet receiver to drop packets while we're cleaning up
             packetReceiver.setShouldDropPackets(true);
+            packetReceiver.stopCapture();
 
             // send a disconnect packet to the domain
             nodeList->getDomainHandler().disconnect();
@@ -66,6 +93,9 @@ void ThreadedAssignment::setFinished(bool isFinished) {
             // call our virtual aboutToFinish method - this gives the ThreadedAssignment subclass a chance to cleanup
             aboutToFinish();
 
+            // the next assignment this process runs registers the metrics of its own
+            metrics::Registry::getInstance().clear();
+
             emit finished();
         }
     }
@@ -78,6 +108,14 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->setOwnerType(nodeType);
 
+    // capture what the assignment receives, to replay it into another one with tools/traffic-replay
+    QString captureDirectory = QProcessEnvironment::systemEnvironment().value(TRAFFIC_CAPTURE_DIRECTORY_ENV);
+    if (!captureDirectory.isEmpty()) {
+        QString fileName = QString("%1-%2-%3.%4").arg(getTypeName()).arg(QCoreApplication::applicationPid())
+            .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")).arg(TRAFFIC_CAPTURE_FILE_EXTENSION);
+        nodeList->getPacketReceiver().startCapture(QDir(captureDirectory).filePath(fileName), nodeType);
+    }
+
     // send a domain-server check in immediately and start the timer to fire them every DOMAIN_SERVER_CHECK_IN_MSECS
     checkInWithDomainServerOrExit();
     _domainServerTimer.start();
@@ -87,6 +125,53 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
 
     // stop sending stats if we disconnect
     connect(&nodeList->getDomainHandler(), &DomainHandler::disconnectedFromDomain, &_statsTimer, &QTimer::stop);
+
+#ifndef Q_OS_WIN
+    // kill -USR1 dumps the latest frames of a stuttering assignment
+    signal(SIGUSR1, requestFrameStatsDump);
+#endif
+}
+
+void ThreadedAssignment::recordFrame(quint64 frameUsecs) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto& packetReceiver = nodeList->getPacketReceiver();
+
+    // the counters are reset with every stats packet
+    int inPacketCount = packetReceiver.getInPacketCount();
+    int outPacketCount = nodeList->getOutPacketCount();
+
+    FrameStats frame;
+    frame.timestamp = usecTimestampNow();
+    frame.frameUsecs = (uint32_t)frameUsecs;
+    frame.packetsIn = (uint32_t)(inPacketCount >= _lastInPacketCount ? inPacketCount - _lastInPacketCount : inPacketCount);
+    frame.packetsOut = (uint32_t)(outPacketCount >= _lastOutPacketCount ? outPacketCount - _lastOutPacketCount : outPacketCount);
+    frame.queuedPackets = (uint32_t)packetReceiver.getNumQueuedShardedMessages();
+    _frameStats.record(frame);
+
+    _frameUsecsMetric.observe((double)frame.frameUsecs);
+    _packetsInMetric.increment(frame.packetsIn);
+    _packetsOutMetric.increment(frame.packetsOut);
+
+    _lastInPacketCount = inPacketCount;
+    _lastOutPacketCount = outPacketCount;
+
+    if (frameStatsDumpRequested.exchange(false)) {
+        dumpFrameStats();
+    }
+}
+
+void ThreadedAssignment::dumpFrameStats() {
+    QString fileName = QString("%1-frames-%2-%3.json").arg(getTypeName())
+        .arg(QCoreApplication::applicationPid()).arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+    QString path = QDir::temp().filePath(fileName);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(networking) << "Could not write the frame stats to" << path;
+        return;
+    }
+    file.write(QJsonDocument(_frameStats.getHistory()).toJson(QJsonDocument::Compact));
+    qCDebug(networking) << "Wrote the frame stats to" << path;
 }
 
 void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObject) {
@@ -104,7 +189,26 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
 
     statsObject["io_stats"] = ioStats;
 
+    auto poolStats = udt::PacketPool::getStats();
+    auto poolAllocations = poolStats.hits + poolStats.misses;
+
+    QJsonObject packetPoolStats;
+    packetPoolStats["hits"] = (double)poolStats.hits;
+    packetPoolStats["misses"] = (double)poolStats.misses;
+    packetPoolStats["recycled"] = (double)poolStats.recycled;
+    packetPoolStats["unpooled"] = (double)poolStats.unpooled;
+    packetPoolStats["hit_rate"] = poolAllocations > 0 ? (double)poolStats.hits / (double)poolAllocations : 0.0;
+
+    statsObject["packet_pool"] = packetPoolStats;
+
+    // percentiles of the frames since the last stats packet, for the assignments that run in frames
+    if (_frameStats.getIntervalFrameCount() > 0) {
+        statsObject["frame_stats"] = _frameStats.getIntervalStats();
+        _frameStats.resetInterval();
+    }
+
     nodeList->sendStatsToDomainServer(statsObject);
+    nodeList->sendMetricsToDomainServer(metrics::Registry::getInstance().serialize());
 }
 
 void ThreadedAssignment::sendStatsPacket() {
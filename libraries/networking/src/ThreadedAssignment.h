@@ -14,10 +14,17 @@
 
 #include <QtCore/QSharedPointer>
 
+#include <FrameStatsRecorder.h>
+
 #include "ReceivedMessage.h"
 
 #include "Assignment.h"
 
+namespace metrics {
+    class Counter;
+    class Histogram;
+}
+
 class ThreadedAssignment : public Assignment {
     Q_OBJECT
 public:
@@ -40,6 +47,10 @@ signals:
 
 protected:
     void commonInit(const QString& targetName, NodeType_t nodeType);
+
+    // called by the assignments that run in frames, at the end of each, with how long its work took
+    void recordFrame(quint64 frameUsecs);
+
     bool _isFinished;
     QTimer _domainServerTimer;
     QTimer _statsTimer;
@@ -50,6 +61,18 @@ protected slots:
     
 private slots:
     void checkInWithDomainServerOrExit();
+
+private:
+    // writes the latest frames to a JSON file in the temporary directory, on SIGUSR1
+    void dumpFrameStats();
+
+    FrameStatsRecorder _frameStats;
+    int _lastInPacketCount { 0 };
+    int _lastOutPacketCount { 0 };
+
+    metrics::Histogram& _frameUsecsMetric;
+    metrics::Counter& _packetsInMetric;
+    metrics::Counter& _packetsOutMetric;
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
@@ -0,0 +1,137 @@
+//
+//  TrafficCapture.cpp
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TrafficCapture.h"
+
+#include <SharedUtil.h>
+
+#include "NetworkLogging.h"
+#include "ReceivedMessage.h"
+#include "UUID.h"
+
+namespace {
+    const quint32 CAPTURE_MAGIC = 0x48464350; // "HFCP"
+    const quint32 CAPTURE_FORMAT_VERSION = 1;
+
+    const qint64 MAX_CAPTURED_MESSAGE_SIZE = 64 * 1024;
+    const qint64 RECORD_HEADER_SIZE = sizeof(quint64) + 3 * sizeof(quint8) + NUM_BYTES_RFC4122_UUID + sizeof(quint32);
+    const qint64 MAX_CAPTURE_SIZE = 2LL * 1024 * 1024 * 1024; // stop rather than fill the disk of a busy server
+}
+
+bool TrafficCaptureWriter::open(const QString& path, NodeType_t ownerType) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_file.isOpen()) {
+        _stream.setDevice(nullptr);
+        _file.close();
+    }
+
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(networking) << "Could not open the traffic capture" << path;
+        return false;
+    }
+
+    _startUsecs = usecTimestampNow();
+    _captureSize = 0;
+    _stream.setDevice(&_file);
+    _stream << CAPTURE_MAGIC << CAPTURE_FORMAT_VERSION << ownerType << _startUsecs;
+
+    qCDebug(networking) << "Capturing the inbound traffic to" << path;
+    return true;
+}
+
+void TrafficCaptureWriter::close() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_file.isOpen()) {
+        _stream.setDevice(nullptr);
+        _file.close();
+        qCDebug(networking) << "Finished the traffic capture" << _file.fileName();
+    }
+}
+
+void TrafficCaptureWriter::write(ReceivedMessage& message, NodeType_t sourceType) {
+    qint64 size = message.getSize();
+    if (size > MAX_CAPTURED_MESSAGE_SIZE) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_file.isOpen()) {
+        return;
+    }
+
+    quint64 usecsSinceStart = usecTimestampNow() - _startUsecs;
+
+    _captureSize += RECORD_HEADER_SIZE + size;
+    if (_captureSize > MAX_CAPTURE_SIZE) {
+        qCWarning(networking) << "The traffic capture" << _file.fileName() << "is full, stopping it";
+        _stream.setDevice(nullptr);
+        _file.close();
+        return;
+    }
+
+    _stream << usecsSinceStart << (quint8)message.getType() << (quint8)message.getVersion() << sourceType;
+    _stream.writeRawData(message.getSourceID().toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+    _stream << (quint32)size;
+    _stream.writeRawData(message.getRawMessage(), (int)size);
+}
+
+bool TrafficCaptureReader::open(const QString& path) {
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(networking) << "Could not open the traffic capture" << path;
+        return false;
+    }
+
+    _stream.setDevice(&_file);
+
+    quint32 magic;
+    quint32 formatVersion;
+    _stream >> magic >> formatVersion >> _ownerType >> _startUsecs;
+
+    if (_stream.status() != QDataStream::Ok || magic != CAPTURE_MAGIC || formatVersion != CAPTURE_FORMAT_VERSION) {
+        qCWarning(networking) << path << "is not a traffic capture this build can read";
+        _stream.setDevice(nullptr);
+        _file.close();
+        return false;
+    }
+
+    return true;
+}
+
+bool TrafficCaptureReader::readNext(TrafficCaptureRecord& record) {
+    if (!_file.isOpen() || _stream.atEnd()) {
+        return false;
+    }
+
+    quint8 type;
+    quint8 version;
+    _stream >> record.usecsSinceStart >> type >> version >> record.sourceType;
+    record.type = (PacketType)type;
+    record.version = (PacketVersion)version;
+
+    char sourceID[NUM_BYTES_RFC4122_UUID];
+    if (_stream.readRawData(sourceID, NUM_BYTES_RFC4122_UUID) != NUM_BYTES_RFC4122_UUID) {
+        return false;
+    }
+    record.sourceID = QUuid::fromRfc4122(QByteArray::fromRawData(sourceID, NUM_BYTES_RFC4122_UUID));
+
+    quint32 size;
+    _stream >> size;
+    if (_stream.status() != QDataStream::Ok || size > MAX_CAPTURED_MESSAGE_SIZE) {
+        return false;
+    }
+
+    record.payload.resize((int)size);
+    return _stream.readRawData(record.payload.data(), (int)size) == (int)size;
+}
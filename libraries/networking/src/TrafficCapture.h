@@ -0,0 +1,80 @@
+//
+//  TrafficCapture.h
+//  libraries/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TrafficCapture_h
+#define hifi_TrafficCapture_h
+
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QSet>
+#include <QtCore/QUuid>
+
+#include "NodeType.h"
+#include "udt/PacketHeaders.h"
+
+class ReceivedMessage;
+
+// A capture is the inbound messages of an assignment, with when they were handled, for tools/traffic-replay
+//   It is a header (the magic, the format version, the type of the node that captured and the time the capture
+//   started) followed by a record per message, in the order they were handled: the usecs since the start, the type
+//   and version of the message, its source's ID and node type, and its payload.
+struct TrafficCaptureRecord {
+    quint64 usecsSinceStart { 0 };
+    PacketType type { PacketType::Unknown };
+    PacketVersion version { 0 };
+    QUuid sourceID;
+    NodeType_t sourceType { NodeType::Unassigned };
+    QByteArray payload;
+};
+
+// set to a directory, an assignment captures what it receives into a file there
+const QString TRAFFIC_CAPTURE_DIRECTORY_ENV = "HIFI_CAPTURE_TRAFFIC_DIR";
+const QString TRAFFIC_CAPTURE_FILE_EXTENSION = "hfcap";
+
+// Appends the messages handled by the PacketReceiver to a capture, from whichever thread handles them
+class TrafficCaptureWriter {
+public:
+    ~TrafficCaptureWriter() { close(); }
+
+    bool open(const QString& path, NodeType_t ownerType);
+    void close();
+
+    // the large transfers (asset uploads and the like) are left out, they would dwarf the traffic being replayed
+    void write(ReceivedMessage& message, NodeType_t sourceType);
+
+private:
+    std::mutex _mutex;
+    QFile _file;
+    QDataStream _stream;
+    quint64 _startUsecs { 0 };
+    qint64 _captureSize { 0 }; // the bytes of the records, without a flush of the file to ask it
+};
+
+class TrafficCaptureReader {
+public:
+    bool open(const QString& path);
+
+    NodeType_t getOwnerType() const { return _ownerType; }
+    quint64 getStartUsecs() const { return _startUsecs; }
+
+    // false at the end of the capture, or at a record that was cut short
+    bool readNext(TrafficCaptureRecord& record);
+
+private:
+    QFile _file;
+    QDataStream _stream;
+    NodeType_t _ownerType { NodeType::Unassigned };
+    quint64 _startUsecs { 0 };
+};
+
+#endif // hifi_TrafficCapture_h
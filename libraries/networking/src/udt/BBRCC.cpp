@@ -0,0 +1,321 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtCore/QtGlobal>
+
+#include "ConnectionStats.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2/ln(2), the smallest gain that lets the sending rate double every round trip during startup
+static const double BBR_HIGH_GAIN = 2.885;
+static const double BBR_PROBE_BANDWIDTH_CWND_GAIN = 2.0;
+
+// probe for more bandwidth for one min RTT, drain the queue that may have built for one, then cruise for six
+static const int BBR_GAIN_CYCLE_LENGTH = 8;
+static const double BBR_PACING_GAIN_CYCLE[BBR_GAIN_CYCLE_LENGTH] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+// startup is over once three rounds in a row fail to grow the bandwidth estimate by 25%
+static const double BBR_FULL_BANDWIDTH_GROWTH = 1.25;
+static const int BBR_FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int BBR_MIN_CWND_PACKETS = 4;
+static const int BBR_MIN_RTT_WINDOW_USECS = 10000000;
+static const int BBR_PROBE_RTT_DURATION_USECS = 200000;
+
+BBRCC::BBRCC() {
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = BBR_MIN_CWND_PACKETS;
+    _mss = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+    setAckInterval(1); // the delivery rate model needs an ACK for every packet received
+
+    _bandwidthSamples.fill(0.0);
+
+    // we can't do this as a member initializer until our VS has support for constexpr
+    _minRTT = std::numeric_limits<int>::max();
+
+    _pacingGain = BBR_HIGH_GAIN;
+    _congestionWindowGain = BBR_HIGH_GAIN;
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+
+    int newlyDelivered = std::max(seqoff(_lastACK, ack), 0);
+
+    if (newlyDelivered > 0) {
+        _lastACK = ack;
+
+        auto it = _sentPackets.find(ack);
+        if (it != _sentPackets.end()) {
+            const auto& sent = it->second;
+
+            updateRTT(duration_cast<microseconds>(receiveTime - sent.sentTime).count(), receiveTime);
+
+            _delivered += newlyDelivered;
+            _deliveredTime = receiveTime;
+
+            // a new round trip starts once a packet sent after the previous round started has been delivered
+            _isRoundStart = sent.delivered >= _nextRoundDelivered;
+            if (_isRoundStart) {
+                _nextRoundDelivered = _delivered;
+                ++_roundCount;
+                _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS] = 0.0;
+            }
+
+            // the delivery rate is taken over the longer of the send and ACK intervals,
+            // so that ACK compression can not make the path look faster than it is
+            auto sendElapsed = duration_cast<microseconds>(sent.sentTime - sent.firstSentTime).count();
+            auto ackElapsed = duration_cast<microseconds>(receiveTime - sent.deliveredTime).count();
+            auto interval = std::max(sendElapsed, ackElapsed);
+
+            if (interval > 0) {
+                updateBandwidth((_delivered - sent.delivered) * USECS_PER_SECOND / interval);
+            }
+
+            _firstSentTime = sent.sentTime;
+        } else {
+            _delivered += newlyDelivered;
+            _deliveredTime = receiveTime;
+            _isRoundStart = false;
+        }
+
+        // everything up to and including this ACK has been delivered
+        _sentPackets.erase(_sentPackets.begin(), _sentPackets.upper_bound(ack));
+
+        updateMode(receiveTime);
+    }
+
+    updateControlParameters(newlyDelivered);
+
+    ++_numACKSinceFastRetransmit;
+
+    // loss does not change the model, but we still re-send ACK + 1 the way TCPVegasCC does
+    // if this is a duplicate ACK or one of the first ACKs after a previous fast re-transmit
+    if (ack == previousAck || _numACKSinceFastRetransmit < 3) {
+        auto it = _sentPackets.find(ack + 1);
+        if (it != _sentPackets.end() && _ewmaRTT != -1) {
+            auto estimatedTimeout = _ewmaRTT + _rttVariance * 4;
+            auto sinceSend = duration_cast<microseconds>(p_high_resolution_clock::now() - it->second.sentTime).count();
+
+            if (sinceSend >= estimatedTimeout) {
+                _numACKSinceFastRetransmit = 0;
+                return true;
+            }
+        }
+
+        static const int RENO_FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+        ++_duplicateACKCount;
+
+        if (ack == previousAck && _duplicateACKCount == RENO_FAST_RETRANSMIT_DUPLICATE_COUNT) {
+            _numACKSinceFastRetransmit = 0;
+            _duplicateACKCount = 0;
+            return true;
+        }
+    } else {
+        _duplicateACKCount = 0;
+    }
+
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    // the model is likely stale, fall back to the minimum window until ACKs start flowing again
+    _congestionWindowSize = BBR_MIN_CWND_PACKETS;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPackets.find(seqNum) != _sentPackets.end()) {
+        // this is a re-send, keep the state from the original send
+        return;
+    }
+
+    if (_sentPackets.empty()) {
+        // nothing in flight, so the delivery rate interval for this packet starts now
+        _deliveredTime = timePoint;
+        _firstSentTime = timePoint;
+    }
+
+    _sentPackets[seqNum] = { timePoint, _delivered, _deliveredTime, _firstSentTime };
+}
+
+void BBRCC::recordStats(ConnectionStats& stats) const {
+    stats.recordCongestionControlState((int)_mode, (int)_bottleneckBandwidth,
+                                       _minRTT == std::numeric_limits<int>::max() ? 0 : _minRTT,
+                                       (int)(_pacingGain * 100));
+}
+
+void BBRCC::updateRTT(int rtt, time_point now) {
+    const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+    if (rtt < 0) {
+        Q_ASSERT_X(false, __FUNCTION__, "calculated an RTT that is not > 0");
+        return;
+    }
+
+    rtt = std::min(std::max(rtt, 1), MAX_RTT_SAMPLE_MICROSECONDS);
+
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        // Jacobson's RTT estimation, same as TCPVegasCC
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    // windowed min RTT - once it has not been refreshed for the whole window we take whatever we see
+    // and go measure it again in ProbeRTT
+    _isMinRTTExpired = _minRTT != std::numeric_limits<int>::max()
+        && duration_cast<microseconds>(now - _minRTTTimestamp).count() > BBR_MIN_RTT_WINDOW_USECS;
+
+    if (rtt <= _minRTT || _isMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTimestamp = now;
+    }
+}
+
+void BBRCC::updateBandwidth(double deliveryRate) {
+    auto& sample = _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+    sample = std::max(sample, deliveryRate);
+
+    // windowed max over the last BANDWIDTH_FILTER_ROUNDS round trips
+    _bottleneckBandwidth = *std::max_element(_bandwidthSamples.begin(), _bandwidthSamples.end());
+}
+
+void BBRCC::updateMode(time_point now) {
+    if (_mode == Mode::Startup && _isRoundStart && _bottleneckBandwidth > 0.0) {
+        if (_bottleneckBandwidth >= _fullBandwidth * BBR_FULL_BANDWIDTH_GROWTH) {
+            _fullBandwidth = _bottleneckBandwidth;
+            _fullBandwidthCount = 0;
+        } else if (++_fullBandwidthCount >= BBR_FULL_BANDWIDTH_ROUNDS) {
+            _isPipeFilled = true;
+            _mode = Mode::Drain;
+        }
+    }
+
+    if (_mode == Mode::Drain && packetsInFlight() <= bandwidthDelayProduct()) {
+        enterProbeBandwidth(now);
+    }
+
+    if (_mode == Mode::ProbeBandwidth && duration_cast<microseconds>(now - _cycleTimestamp).count() > _minRTT) {
+        _cycleIndex = (_cycleIndex + 1) % BBR_GAIN_CYCLE_LENGTH;
+        _cycleTimestamp = now;
+    }
+
+    if (_mode != Mode::ProbeRTT && _isMinRTTExpired) {
+        _modeBeforeProbeRTT = _isPipeFilled ? Mode::ProbeBandwidth : Mode::Startup;
+        _mode = Mode::ProbeRTT;
+        _probeRTTDoneTimestamp = time_point();
+        _isProbeRTTRoundDone = false;
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTimestamp == time_point()) {
+            if (packetsInFlight() <= BBR_MIN_CWND_PACKETS) {
+                // the queue is drained, hold here for the probe duration and at least one round trip
+                _probeRTTDoneTimestamp = now + microseconds(BBR_PROBE_RTT_DURATION_USECS);
+                _nextRoundDelivered = _delivered;
+            }
+        } else {
+            _isProbeRTTRoundDone = _isProbeRTTRoundDone || _isRoundStart;
+
+            if (_isProbeRTTRoundDone && now >= _probeRTTDoneTimestamp) {
+                _minRTTTimestamp = now;
+
+                if (_modeBeforeProbeRTT == Mode::ProbeBandwidth) {
+                    enterProbeBandwidth(now);
+                } else {
+                    _mode = Mode::Startup;
+                }
+            }
+        }
+    }
+
+    _isMinRTTExpired = false;
+}
+
+void BBRCC::updateControlParameters(int newlyDelivered) {
+    switch (_mode) {
+        case Mode::Startup:
+            _pacingGain = BBR_HIGH_GAIN;
+            _congestionWindowGain = BBR_HIGH_GAIN;
+            break;
+        case Mode::Drain:
+            _pacingGain = 1.0 / BBR_HIGH_GAIN;
+            _congestionWindowGain = BBR_HIGH_GAIN;
+            break;
+        case Mode::ProbeBandwidth:
+            _pacingGain = BBR_PACING_GAIN_CYCLE[_cycleIndex];
+            _congestionWindowGain = BBR_PROBE_BANDWIDTH_CWND_GAIN;
+            break;
+        case Mode::ProbeRTT:
+            _pacingGain = 1.0;
+            _congestionWindowGain = 1.0;
+            break;
+    }
+
+    if (_bottleneckBandwidth <= 0.0) {
+        // no delivery rate sample yet - grow the window like slow start and do not pace
+        _congestionWindowSize += newlyDelivered;
+    } else {
+        setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+
+        int targetWindowSize = (int)std::ceil(_congestionWindowGain * bandwidthDelayProduct()) + BBR_MIN_CWND_PACKETS;
+
+        if (_mode == Mode::ProbeRTT) {
+            _congestionWindowSize = BBR_MIN_CWND_PACKETS;
+        } else if (_isPipeFilled) {
+            _congestionWindowSize = std::min(_congestionWindowSize + newlyDelivered, targetWindowSize);
+        } else if (_congestionWindowSize < targetWindowSize) {
+            _congestionWindowSize += newlyDelivered;
+        }
+    }
+
+    _congestionWindowSize = std::min(std::max(_congestionWindowSize, BBR_MIN_CWND_PACKETS), udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+void BBRCC::enterProbeBandwidth(time_point now) {
+    _mode = Mode::ProbeBandwidth;
+
+    // start anywhere but the draining phase, so that connections sharing a bottleneck do not probe in lock step
+    _cycleIndex = (int)(_roundCount % (BBR_GAIN_CYCLE_LENGTH - 1));
+    if (_cycleIndex > 0) {
+        ++_cycleIndex;
+    }
+    _cycleTimestamp = now;
+}
+
+int BBRCC::packetsInFlight() const {
+    return std::max(seqoff(_lastACK, _sendCurrSeqNum), 0);
+}
+
+int BBRCC::bandwidthDelayProduct() const {
+    if (_minRTT == std::numeric_limits<int>::max()) {
+        return BBR_MIN_CWND_PACKETS;
+    }
+
+    return (int)std::ceil(_bottleneckBandwidth * _minRTT / USECS_PER_SECOND);
+}
@@ -0,0 +1,123 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <array>
+#include <map>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Model based congestion control after BBR (https://queue.acm.org/detail.cfm?id=3022184)
+// Paces at an estimate of the bottleneck bandwidth and sizes the window from the bandwidth-delay product,
+// instead of reacting to every change in RTT like TCPVegasCC or to loss like DefaultCC.
+class BBRCC : public CongestionControl {
+public:
+    enum class Mode {
+        Startup = 1,
+        Drain,
+        ProbeBandwidth,
+        ProbeRTT
+    };
+
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) override {};
+    virtual void onTimeout() override;
+
+    virtual bool shouldNAK() override { return false; }
+    virtual bool shouldACK2() override { return false; }
+    virtual bool shouldProbe() override { return false; }
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual void recordStats(ConnectionStats& stats) const override;
+
+    Mode getMode() const { return _mode; }
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    using time_point = p_high_resolution_clock::time_point;
+
+    struct SentPacket {
+        time_point sentTime;
+        int64_t delivered; // packets delivered when this one was sent
+        time_point deliveredTime; // time of the last delivery when this one was sent
+        time_point firstSentTime; // send time of the last delivered packet when this one was sent
+    };
+
+    void updateRTT(int rtt, time_point now);
+    void updateBandwidth(double deliveryRate);
+    void updateMode(time_point now);
+    void updateControlParameters(int newlyDelivered);
+
+    void enterProbeBandwidth(time_point now);
+
+    int packetsInFlight() const;
+    int bandwidthDelayProduct() const;
+
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+
+    using SentPacketMap = std::map<SequenceNumber, SentPacket>;
+    SentPacketMap _sentPackets;
+
+    Mode _mode { Mode::Startup };
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+
+    int64_t _delivered { 0 }; // Total packets delivered
+    time_point _deliveredTime; // Time of the last delivery
+    time_point _firstSentTime; // Send time of the last delivered packet
+
+    int64_t _nextRoundDelivered { 0 }; // Delivered count that marks the end of the current round trip
+    int64_t _roundCount { 0 };
+    bool _isRoundStart { false };
+
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _bandwidthSamples; // max delivery rate per round, packets per second
+    double _bottleneckBandwidth { 0.0 }; // windowed max of _bandwidthSamples
+
+    int _minRTT; // windowed min RTT, in microseconds
+    time_point _minRTTTimestamp;
+    bool _isMinRTTExpired { false };
+
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT, used for fast re-transmit timing
+    int _rttVariance { 0 };
+
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    // startup ends when the bandwidth estimate stops growing
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthCount { 0 };
+    bool _isPipeFilled { false };
+
+    int _cycleIndex { 0 };
+    time_point _cycleTimestamp;
+
+    time_point _probeRTTDoneTimestamp;
+    bool _isProbeRTTRoundDone { false };
+    Mode _modeBeforeProbeRTT { Mode::Startup };
+
+    int _numACKSinceFastRetransmit { 3 }; // Number of ACKs received since fast re-transmit, default avoids immediate re-transmit
+    int _duplicateACKCount { 0 };
+};
+
+}
+
+#endif // hifi_BBRCC_h
@@ -22,6 +22,7 @@
 
 #include "../HifiSockAddr.h"
 #include "Constants.h"
+#include "PacketPool.h"
 
 namespace udt {
     
@@ -31,7 +32,7 @@ public:
     static const qint64 PACKET_WRITE_ERROR;
     
     static std::unique_ptr<BasePacket> create(qint64 size = -1);
-    static std::unique_ptr<BasePacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<BasePacket> fromReceivedPacket(PacketBuffer data, qint64 size,
                                                           const HifiSockAddr& senderSockAddr);
     
     // Current level's header size
@@ -92,7 +93,7 @@ public:
     
 protected:
     BasePacket(qint64 size);
-    BasePacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr);
+    BasePacket(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr);
     BasePacket(const BasePacket& other);
     BasePacket& operator=(const BasePacket& other);
     BasePacket(BasePacket&& other);
@@ -105,7 +106,7 @@ protected:
     void adjustPayloadStartAndCapacity(qint64 headerSize, bool shouldDecreasePayloadSize = false);
     
     qint64 _packetSize = 0;        // Total size of the allocated memory
-    std::unique_ptr<char[]> _packet; // Allocated memory
+    PacketBuffer _packet; // Allocated memory (from the PacketPool)
     
     char* _payloadStart = nullptr; // Start of the payload
     qint64 _payloadCapacity = 0;          // Total capacity of the payload
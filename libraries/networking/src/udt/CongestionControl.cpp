@@ -13,7 +13,9 @@
 
 #include <random>
 
+#include "BBRCC.h"
 #include "Packet.h"
+#include "TCPVegasCC.h"
 
 using namespace udt;
 using namespace std::chrono;
@@ -21,6 +23,18 @@ using namespace std::chrono;
 static const double USECS_PER_SECOND = 1000000.0;
 static const int BITS_PER_BYTE = 8;
 
+std::unique_ptr<CongestionControlVirtualFactory> udt::congestionControlFactoryForName(const std::string& name) {
+    if (name == "vegas") {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<TCPVegasCC>());
+    } else if (name == "bbr") {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>());
+    } else if (name == "default") {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<DefaultCC>());
+    } else {
+        return nullptr;
+    }
+}
+
 void CongestionControl::setMaxBandwidth(int maxBandwidth) {
     _maxBandwidth = maxBandwidth;
     setPacketSendPeriod(_packetSendPeriod);
@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <PortableHighResolutionClock.h>
@@ -26,6 +27,7 @@ namespace udt {
 static const int32_t DEFAULT_SYN_INTERVAL = 10000; // 10 ms
 
 class Connection;
+class ConnectionStats;
 class Packet;
 
 class CongestionControl {
@@ -52,6 +54,9 @@ public:
     virtual bool shouldProbe() { return true; }
 
     virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {}
+
+    // lets a congestion control with an internal model report its state alongside the window and send period
+    virtual void recordStats(ConnectionStats& stats) const {}
 protected:
     void setAckInterval(int ackInterval) { _ackInterval = ackInterval; }
     void setRTO(int rto) { _userDefinedRTO = true; _rto = rto; }
@@ -106,6 +111,10 @@ public:
     virtual std::unique_ptr<CongestionControl> create() override { return std::unique_ptr<T>(new T()); }
 };
 
+// returns the factory for a congestion control named in the domain settings ("vegas", "bbr" or "default"),
+// or nullptr if the name is not known
+std::unique_ptr<CongestionControlVirtualFactory> congestionControlFactoryForName(const std::string& name);
+
 class DefaultCC: public CongestionControl {
 public:
     DefaultCC();
@@ -946,6 +946,7 @@ void Connection::updateCongestionControlAndSendQueue(std::function<void ()> cong
     // record connection stats
     _stats.recordPacketSendPeriod(_congestionControl->_packetSendPeriod);
     _stats.recordCongestionWindowSize(_congestionControl->_congestionWindowSize);
+    _congestionControl->recordStats(_stats);
 }
 
 void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
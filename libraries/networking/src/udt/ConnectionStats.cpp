@@ -11,6 +11,8 @@
 
 #include "ConnectionStats.h"
 
+#include "PacketPool.h"
+
 using namespace udt;
 using namespace std::chrono;
 
@@ -27,6 +29,10 @@ ConnectionStats::Stats ConnectionStats::sample() {
     auto now = duration_cast<microseconds>(system_clock::now().time_since_epoch());
     sample.endTime = now;
     _currentSample.startTime = now;
+
+    auto poolStats = PacketPool::getStats();
+    sample.packetPoolHits = poolStats.hits;
+    sample.packetPoolMisses = poolStats.misses;
     
     return sample;
 }
@@ -112,3 +118,17 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
     _total.packetSendPeriod = (int)((_total.packetSendPeriod * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
 }
+
+void ConnectionStats::recordCongestionControlState(int mode, int bottleneckBandwidth, int minRTT, int pacingGain) {
+    _currentSample.congestionControlMode = mode;
+    _total.congestionControlMode = mode;
+
+    _currentSample.bottleneckBandwidth = bottleneckBandwidth;
+    _total.bottleneckBandwidth = (int)((_total.bottleneckBandwidth * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (bottleneckBandwidth * EWMA_CURRENT_SAMPLE_WEIGHT));
+
+    _currentSample.minRTT = minRTT;
+    _total.minRTT = minRTT;
+
+    _currentSample.pacingGain = pacingGain;
+    _total.pacingGain = pacingGain;
+}
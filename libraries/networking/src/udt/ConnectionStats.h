@@ -14,6 +14,7 @@
 
 #include <chrono>
 #include <array>
+#include <cstdint>
 
 namespace udt {
 
@@ -69,6 +70,16 @@ public:
         int rtt { 0 };
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
+
+        // congestion control model state, only reported by model based controllers (BBRCC)
+        int congestionControlMode { 0 };
+        int bottleneckBandwidth { 0 }; // packets per second
+        int minRTT { 0 }; // microseconds
+        int pacingGain { 0 }; // percent
+
+        // process wide PacketPool totals at the time of the sample, shared by every connection
+        uint64_t packetPoolHits { 0 };
+        uint64_t packetPoolMisses { 0 };
         
         // TODO: Remove once Win build supports brace initialization: `Events events {{ 0 }};`
         Stats() { events.fill(0); }
@@ -93,6 +104,7 @@ public:
     void recordRTT(int sample);
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+    void recordCongestionControlState(int mode, int bottleneckBandwidth, int minRTT, int pacingGain);
     
 private:
     Stats _currentSample;
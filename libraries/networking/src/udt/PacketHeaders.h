@@ -113,7 +113,12 @@ public:
         EntityPhysics,
         EntityServerScriptLog,
         AdjustAvatarSorting,
-        LAST_PACKET_TYPE = AdjustAvatarSorting
+        CoalescedPackets, // several small unreliable packets for one node, see LimitedNodeList::setPacketCoalescingEnabled
+        EntityCompressionDictionary,
+        AudioMixerBed,
+        ForwardedAvatarData,
+        NodeMetrics,
+        LAST_PACKET_TYPE = NodeMetrics
     };
 };
 
@@ -210,7 +215,8 @@ const PacketVersion VERSION_ENTITIES_ZONE_FILTERS = 68;
 
 enum class EntityQueryPacketVersion: PacketVersion {
     JSONFilter = 18,
-    JSONFilterWithFamilyTree = 19
+    JSONFilterWithFamilyTree = 19,
+    CompressionDictionary = 20
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
@@ -229,7 +235,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     Unignore,
     ImmediateSessionDisplayNameUpdates,
     VariableAvatarData,
-    AvatarAsChildFixes
+    AvatarAsChildFixes,
+    VariablePrecisionJointRotations
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -255,7 +262,14 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    HasListVersion
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreAckedListVersion = 17,
+    HasAckedListVersion,
+    HasPosition
 };
 
 enum class AudioVersion : PacketVersion {
@@ -0,0 +1,165 @@
+//
+//  PacketPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketPool.h"
+
+#include <mutex>
+#include <vector>
+
+#include "Constants.h"
+
+using namespace udt;
+
+std::atomic<quint64> PacketPool::_hits { 0 };
+std::atomic<quint64> PacketPool::_misses { 0 };
+std::atomic<quint64> PacketPool::_recycled { 0 };
+std::atomic<quint64> PacketPool::_unpooled { 0 };
+
+namespace {
+    // most of what the mixers send is either tiny (silent frames, kills, acks), mid sized (compressed audio) or a full MTU
+    const int NUM_SIZE_CLASSES = 3;
+    const int SIZE_CLASSES[NUM_SIZE_CLASSES] = { 128, 512, MAX_PACKET_SIZE };
+
+    // buffers move between a thread's cache and the shared depot a block at a time
+    const size_t BLOCK_SIZE = 64;
+    const size_t MAX_CACHED_PER_THREAD = 2 * BLOCK_SIZE;
+    const size_t MAX_DEPOT_BLOCKS = 64;
+
+    using Block = std::vector<char*>;
+
+    void deleteBlock(Block& block) {
+        for (auto data : block) {
+            delete[] data;
+        }
+        block.clear();
+    }
+
+    struct Depot {
+        std::mutex mutex;
+        std::vector<Block> blocks[NUM_SIZE_CLASSES];
+
+        void put(Block block, int sizeClass) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (blocks[sizeClass].size() < MAX_DEPOT_BLOCKS) {
+                    blocks[sizeClass].push_back(std::move(block));
+                    return;
+                }
+            }
+            deleteBlock(block);
+        }
+
+        bool take(Block& block, int sizeClass) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (blocks[sizeClass].empty()) {
+                return false;
+            }
+            block.swap(blocks[sizeClass].back());
+            blocks[sizeClass].pop_back();
+            return true;
+        }
+    };
+
+    // intentionally leaked so that threads exiting during shutdown can still hand their buffers back
+    Depot& depot() {
+        static Depot* depot = new Depot();
+        return *depot;
+    }
+
+    thread_local bool threadCacheDestroyed { false };
+
+    struct ThreadCache {
+        Block free[NUM_SIZE_CLASSES];
+
+        ~ThreadCache() {
+            threadCacheDestroyed = true;
+            for (int i = 0; i < NUM_SIZE_CLASSES; ++i) {
+                if (!free[i].empty()) {
+                    depot().put(std::move(free[i]), i);
+                }
+            }
+        }
+    };
+
+    thread_local ThreadCache threadCache;
+
+    int sizeClassForSize(qint64 size) {
+        for (int i = 0; i < NUM_SIZE_CLASSES; ++i) {
+            if (size <= SIZE_CLASSES[i]) {
+                return i;
+            }
+        }
+        return PacketBufferDeleter::UNPOOLED;
+    }
+}
+
+void PacketBufferDeleter::operator()(char* data) const {
+    if (sizeClass == UNPOOLED) {
+        delete[] data;
+    } else {
+        PacketPool::release(data, sizeClass);
+    }
+}
+
+PacketBuffer PacketPool::allocate(qint64 size) {
+    int sizeClass = sizeClassForSize(size);
+
+    if (sizeClass == PacketBufferDeleter::UNPOOLED) {
+        _unpooled.fetch_add(1, std::memory_order_relaxed);
+        return PacketBuffer(new char[size]);
+    }
+
+    if (!threadCacheDestroyed) {
+        auto& cache = threadCache.free[sizeClass];
+
+        if (cache.empty()) {
+            depot().take(cache, sizeClass);
+        }
+
+        if (!cache.empty()) {
+            char* data = cache.back();
+            cache.pop_back();
+
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return PacketBuffer(data, PacketBufferDeleter(sizeClass));
+        }
+    }
+
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return PacketBuffer(new char[SIZE_CLASSES[sizeClass]], PacketBufferDeleter(sizeClass));
+}
+
+void PacketPool::release(char* data, int sizeClass) {
+    if (threadCacheDestroyed) {
+        delete[] data;
+        return;
+    }
+
+    auto& cache = threadCache.free[sizeClass];
+
+    if (cache.size() >= MAX_CACHED_PER_THREAD) {
+        // this thread frees more than it allocates (likely the socket) - pass a block on for the allocating threads
+        Block block(cache.end() - BLOCK_SIZE, cache.end());
+        cache.resize(cache.size() - BLOCK_SIZE);
+        depot().put(std::move(block), sizeClass);
+    }
+
+    cache.push_back(data);
+    _recycled.fetch_add(1, std::memory_order_relaxed);
+}
+
+PacketPool::Stats PacketPool::getStats() {
+    Stats stats;
+    stats.hits = _hits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.recycled = _recycled.load(std::memory_order_relaxed);
+    stats.unpooled = _unpooled.load(std::memory_order_relaxed);
+    return stats;
+}
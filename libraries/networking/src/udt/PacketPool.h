@@ -0,0 +1,67 @@
+//
+//  PacketPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketPool_h
+#define hifi_PacketPool_h
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+namespace udt {
+
+// Returns a buffer to the PacketPool size class it came from, or deletes it if it did not come from the pool
+struct PacketBufferDeleter {
+    static const int UNPOOLED = -1;
+
+    PacketBufferDeleter() {}
+    explicit PacketBufferDeleter(int sizeClass) : sizeClass(sizeClass) {}
+
+    void operator()(char* data) const;
+
+    int sizeClass { UNPOOLED };
+};
+
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+// Size classed packet buffer pool. Every thread keeps a small cache of free buffers per size class and trades
+// blocks of buffers with a shared depot, so buffers allocated on one thread (a mixer slave) and released on
+// another (the socket) still get recycled.
+class PacketPool {
+public:
+    struct Stats {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 recycled { 0 };
+        quint64 unpooled { 0 };
+    };
+
+    // returns a buffer with room for at least size bytes - the contents are not initialized
+    static PacketBuffer allocate(qint64 size);
+
+    static Stats getStats();
+
+private:
+    friend struct PacketBufferDeleter;
+
+    static void release(char* data, int sizeClass);
+
+    static std::atomic<quint64> _hits;
+    static std::atomic<quint64> _misses;
+    static std::atomic<quint64> _recycled;
+    static std::atomic<quint64> _unpooled;
+};
+
+}
+
+#endif // hifi_PacketPool_h
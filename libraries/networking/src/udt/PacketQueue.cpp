@@ -15,33 +15,103 @@
 
 using namespace udt;
 
-PacketQueue::PacketQueue() {
-    _channels.emplace_back(new std::list<PacketPointer>());
+// so that a steady stream of small messages can not starve bulk transfers completely
+static const int MAX_HIGH_PRIORITY_BURST = 16;
+
+PacketQueue::PacketQueue() :
+    _incomingHead(&_incomingStub),
+    _incomingTail(&_incomingStub)
+{
+    for (auto& channels : _channels) {
+        channels.emplace_back(new std::list<PacketPointer>());
+    }
+}
+
+PacketQueue::~PacketQueue() {
+    drainIncoming();
+
+    if (_incomingTail != &_incomingStub) {
+        delete _incomingTail;
+    }
 }
 
 MessageNumber PacketQueue::getNextMessageNumber() {
     static const MessageNumber MAX_MESSAGE_NUMBER = MessageNumber(1) << MESSAGE_NUMBER_SIZE;
-    _currentMessageNumber = (_currentMessageNumber + 1) % MAX_MESSAGE_NUMBER;
-    return _currentMessageNumber;
+    return (_currentMessageNumber.fetch_add(1) + 1) % MAX_MESSAGE_NUMBER;
+}
+
+void PacketQueue::push(Node* node) {
+    Node* previous = _incomingHead.exchange(node);
+    previous->next.store(node);
+}
+
+void PacketQueue::drainIncoming() {
+    while (true) {
+        Node* tail = _incomingTail;
+        Node* next = tail->next.load();
+
+        if (!next) {
+            // empty, or a producer is between swapping the head and linking its node - we'll see it next time
+            return;
+        }
+
+        // the tail is the last node we took packets from (or the stub), its successor holds the next packets
+        _incomingTail = next;
+        if (tail != &_incomingStub) {
+            delete tail;
+        }
+
+        auto& channels = _channels[next->priority];
+        if (next->packets.size() == 1) {
+            // single packets go to the main channel of their priority
+            channels.front()->push_back(std::move(next->packets.front()));
+            next->packets.clear();
+        } else {
+            channels.emplace_back(new std::list<PacketPointer>());
+            channels.back()->swap(next->packets);
+        }
+    }
 }
 
 bool PacketQueue::isEmpty() const {
-    LockGuard locker(_packetsLock);
-    // Only the main channel and it is empty
-    return (_channels.size() == 1) && _channels.front()->empty();
+    for (auto& channels : _channels) {
+        // Only the main channel and it is empty
+        if (channels.size() != 1 || !channels.front()->empty()) {
+            return false;
+        }
+    }
+
+    return _incomingTail->next.load() == nullptr;
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
-    LockGuard locker(_packetsLock);
-    if (isEmpty()) {
-        return PacketPointer();
+    drainIncoming();
+
+    auto isChannelsEmpty = [](const Channels& channels) {
+        return channels.size() == 1 && channels.front()->empty();
+    };
+
+    bool hasHighPriority = !isChannelsEmpty(_channels[HighPriority]);
+    bool hasNormalPriority = !isChannelsEmpty(_channels[NormalPriority]);
+
+    if (hasHighPriority && (!hasNormalPriority || _highPriorityBurst < MAX_HIGH_PRIORITY_BURST)) {
+        _highPriorityBurst = hasNormalPriority ? _highPriorityBurst + 1 : 0;
+        return takePacketFromChannels(_channels[HighPriority], _currentIndex[HighPriority]);
+    } else if (hasNormalPriority) {
+        _highPriorityBurst = 0;
+        return takePacketFromChannels(_channels[NormalPriority], _currentIndex[NormalPriority]);
     }
 
-    // Find next non empty channel
-    if (_channels[nextIndex()]->empty()) {
-        nextIndex();
+    return PacketPointer();
+}
+
+PacketQueue::PacketPointer PacketQueue::takePacketFromChannels(Channels& channels, unsigned int& currentIndex) {
+    // Find next non empty channel, channels other than the main one are never left empty
+    currentIndex = (currentIndex + 1) % channels.size();
+    if (channels[currentIndex]->empty()) {
+        currentIndex = (currentIndex + 1) % channels.size();
     }
-    auto& channel = _channels[_currentIndex];
+    auto& channel = channels[currentIndex];
     Q_ASSERT(!channel->empty());
 
     // Take front packet
@@ -49,23 +119,20 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
     channel->pop_front();
 
     // Remove now empty channel (Don't remove the main channel)
-    if (channel->empty() && _currentIndex != 0) {
-        channel->swap(*_channels.back());
-        _channels.pop_back();
-        --_currentIndex;
+    if (channel->empty() && currentIndex != 0) {
+        channel->swap(*channels.back());
+        channels.pop_back();
+        --currentIndex;
     }
 
     return packet;
 }
 
-unsigned int PacketQueue::nextIndex() {
-    _currentIndex = (_currentIndex + 1) % _channels.size();
-    return _currentIndex;
-}
-
 void PacketQueue::queuePacket(PacketPointer packet) {
-    LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    Node* node = new Node();
+    node->packets.push_back(std::move(packet));
+    node->priority = HighPriority;
+    push(node);
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -73,7 +140,12 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
         packetList->preparePackets(getNextMessageNumber());
     }
 
-    LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    if (packetList->_packets.empty()) {
+        return;
+    }
+
+    Node* node = new Node();
+    node->priority = packetList->_packets.size() > MAX_HIGH_PRIORITY_LIST_PACKETS ? NormalPriority : HighPriority;
+    node->packets.swap(packetList->_packets);
+    push(node);
 }
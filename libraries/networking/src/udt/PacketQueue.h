@@ -12,6 +12,7 @@
 #ifndef hifi_PacketQueue_h
 #define hifi_PacketQueue_h
 
+#include <atomic>
 #include <list>
 #include <vector>
 #include <memory>
@@ -20,11 +21,14 @@
 #include "Packet.h"
 
 namespace udt {
-    
+
 class PacketList;
-    
+
 using MessageNumber = uint32_t;
-    
+
+// Packets are handed over from any thread through a lock free multiple producer, single consumer queue.
+// Only the SendQueue thread takes packets, and it keeps them in per priority channels:
+// single packets and small packet lists (kills, edits) are sent ahead of bulk packet lists (asset transfers).
 class PacketQueue {
     using Mutex = std::recursive_mutex;
     using LockGuard = std::lock_guard<Mutex>;
@@ -32,29 +36,67 @@ class PacketQueue {
     using PacketListPointer = std::unique_ptr<PacketList>;
     using Channel = std::unique_ptr<std::list<PacketPointer>>;
     using Channels = std::vector<Channel>;
-    
+
 public:
+    enum Priority {
+        HighPriority = 0,
+        NormalPriority,
+        NumPriorities
+    };
+
+    // packet lists with more packets than this are considered bulk transfers
+    static const size_t MAX_HIGH_PRIORITY_LIST_PACKETS = 4;
+
     PacketQueue();
+    ~PacketQueue();
+
+    // safe to call from any thread
     void queuePacket(PacketPointer packet);
     void queuePacketList(PacketListPointer packetList);
-    
+
+    // only to be called from the thread taking packets
     bool isEmpty() const;
     PacketPointer takePacket();
-    
+
+    // held by the sending thread while it waits for packets, see setConsumerWaiting
     Mutex& getLock() { return _packetsLock; }
-    
+
+    // set by the sending thread around waiting on a condition with getLock() held, so producers only need to take
+    // the lock (to avoid a lost wake up) when the sending thread may actually be asleep
+    void setConsumerWaiting(bool waiting) { _isConsumerWaiting.store(waiting); }
+    bool isConsumerWaiting() const { return _isConsumerWaiting.load(); }
+
 private:
+    struct Node {
+        std::atomic<Node*> next { nullptr };
+        std::list<PacketPointer> packets;
+        Priority priority { HighPriority };
+    };
+
     MessageNumber getNextMessageNumber();
-    unsigned int nextIndex();
-    
-    MessageNumber _currentMessageNumber { 0 };
-    
-    mutable Mutex _packetsLock; // Protects the packets to be sent.
-    Channels _channels; // One channel per packet list + Main channel
-    unsigned int _currentIndex { 0 };
+
+    void push(Node* node);
+    void drainIncoming();
+
+    PacketPointer takePacketFromChannels(Channels& channels, unsigned int& currentIndex);
+
+    std::atomic<MessageNumber> _currentMessageNumber { 0 };
+
+    // intrusive MPSC queue (Vyukov) - producers swap the head, the consumer follows next pointers from the tail
+    std::atomic<Node*> _incomingHead;
+    Node* _incomingTail;
+    Node _incomingStub;
+
+    mutable Mutex _packetsLock;
+    std::atomic<bool> _isConsumerWaiting { false };
+
+    // below is only touched by the consuming thread
+    Channels _channels[NumPriorities]; // One channel per packet list + Main channel, for each priority
+    unsigned int _currentIndex[NumPriorities] { 0, 0 };
+    int _highPriorityBurst { 0 }; // high priority packets in a row while normal priority packets were waiting
 };
 
 }
 
 
-#endif // hifi_PacketQueue_h
\ No newline at end of file
+#endif // hifi_PacketQueue_h
@@ -110,9 +110,8 @@ SendQueue::~SendQueue() {
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
-    
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+
+    wakeIfWaiting();
     
     if (!this->thread()->isRunning() && _state == State::NotStarted) {
         this->thread()->start();
@@ -121,15 +120,25 @@ void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
-    
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+
+    wakeIfWaiting();
     
     if (!this->thread()->isRunning() && _state == State::NotStarted) {
         this->thread()->start();
     }
 }
 
+void SendQueue::wakeIfWaiting() {
+    if (_packets.isConsumerWaiting()) {
+        // the send thread may be between checking for packets and sleeping,
+        // take the lock it holds while it does that so the notify can not be lost
+        std::lock_guard<std::recursive_mutex> locker(_packets.getLock());
+    }
+
+    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
+    _emptyCondition.notify_one();
+}
+
 void SendQueue::stop() {
     
     _state = State::Stopped;
@@ -567,7 +576,11 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
         using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
         DoubleLock doubleLock(_packets.getLock(), _naksLock);
         DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
+
+        // packets are queued without taking the lock, so producers need to know we may be
+        // going to sleep before we check if their queue is empty
+        _packets.setConsumerWaiting(locker.owns_lock());
+
         if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
             // The packets queue and loss list mutexes are now both locked and they're both empty
             
@@ -619,6 +632,8 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
                 }
             }
         }
+
+        _packets.setConsumerWaiting(false);
     }
     
     return false;
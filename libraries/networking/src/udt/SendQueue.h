@@ -105,6 +105,7 @@ private:
     
     bool isInactive(bool attemptedToSendPacket);
     void deactivate(); // makes the queue inactive and cleans it up
+    void wakeIfWaiting(); // wakes the send thread after packets are queued, if it may be sleeping
 
     bool isFlowWindowFull() const;
     
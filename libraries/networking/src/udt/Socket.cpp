@@ -15,6 +15,15 @@
 #include <sys/socket.h>
 #endif
 
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#include <algorithm>
+
 #include <QtCore/QThread>
 
 #include <LogHandler.h>
@@ -55,6 +64,10 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
 }
 
+Socket::~Socket() {
+    stopPacketFilterWorker();
+}
+
 void Socket::bind(const QHostAddress& address, quint16 port) {
     _udpSocket.bind(address, port);
 
@@ -238,6 +251,159 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+qint64 Socket::queuePacket(std::unique_ptr<Packet> packet, const HifiSockAddr& sockAddr) {
+    if (packet->isReliable()) {
+        // reliable packets are owned by their connection's send queue, there is nothing to batch
+        return writePacket(std::move(packet), sockAddr);
+    }
+
+    SequenceNumber sequenceNumber;
+    {
+        Lock lock(_unreliableSequenceNumbersMutex);
+        sequenceNumber = ++_unreliableSequenceNumbers[sockAddr];
+    }
+
+    // write the correct sequence number to the Packet now so that it goes out in the order it was queued
+    packet->writeSequenceNumber(sequenceNumber);
+
+    auto size = packet->getDataSize();
+
+    Lock lock(_queuedPacketsMutex);
+    _queuedPackets.emplace_back(std::move(packet), sockAddr);
+
+    return size;
+}
+
+qint64 Socket::queuePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr) {
+    if (packetList->isReliable()) {
+        return writePacketList(std::move(packetList), sockAddr);
+    }
+
+    qint64 totalBytesQueued = 0;
+    while (!packetList->_packets.empty()) {
+        totalBytesQueued += queuePacket(packetList->takeFront<Packet>(), sockAddr);
+    }
+
+    return totalBytesQueued;
+}
+
+qint64 Socket::flushQueuedPackets() {
+    std::vector<QueuedPacket> queuedPackets;
+    {
+        Lock lock(_queuedPacketsMutex);
+        queuedPackets.swap(_queuedPackets);
+    }
+
+    if (queuedPackets.empty()) {
+        return 0;
+    }
+
+    auto bytesWritten = writeQueuedPackets(queuedPackets);
+
+    // hand the (now empty) vector back so the next batch doesn't need to re-grow it
+    queuedPackets.clear();
+    {
+        Lock lock(_queuedPacketsMutex);
+        if (_queuedPackets.empty()) {
+            _queuedPackets.swap(queuedPackets);
+        }
+    }
+
+    return bytesWritten;
+}
+
+#ifdef Q_OS_LINUX
+
+qint64 Socket::writeQueuedPackets(std::vector<QueuedPacket>& queuedPackets) {
+    // sendmmsg caps a single call at UIO_MAXIOV (1024) messages, we use smaller chunks to keep this on the stack
+    static const size_t MAX_DATAGRAMS_PER_BATCH = 256;
+
+    auto socketDescriptor = _udpSocket.socketDescriptor();
+    qint64 bytesWritten = 0;
+
+    mmsghdr messages[MAX_DATAGRAMS_PER_BATCH];
+    iovec datagrams[MAX_DATAGRAMS_PER_BATCH];
+    sockaddr_in addresses[MAX_DATAGRAMS_PER_BATCH];
+
+    auto it = queuedPackets.begin();
+    while (it != queuedPackets.end()) {
+        size_t numMessages = 0;
+
+        for (; it != queuedPackets.end() && numMessages < MAX_DATAGRAMS_PER_BATCH; ++it) {
+            const Packet& packet = *it->first;
+            const HifiSockAddr& sockAddr = it->second;
+
+            if (socketDescriptor < 0 || sockAddr.getAddress().protocol() != QAbstractSocket::IPv4Protocol) {
+                // we only batch for bound IPv4 destinations, let QUdpSocket deal with anything else
+                bytesWritten += std::max(writeDatagram(packet.getData(), packet.getDataSize(), sockAddr), (qint64)0);
+                continue;
+            }
+
+            sockaddr_in& address = addresses[numMessages];
+            memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+            address.sin_port = htons(sockAddr.getPort());
+
+            iovec& datagram = datagrams[numMessages];
+            datagram.iov_base = const_cast<char*>(packet.getData());
+            datagram.iov_len = packet.getDataSize();
+
+            mmsghdr& message = messages[numMessages];
+            memset(&message, 0, sizeof(message));
+            message.msg_hdr.msg_name = &address;
+            message.msg_hdr.msg_namelen = sizeof(address);
+            message.msg_hdr.msg_iov = &datagram;
+            message.msg_hdr.msg_iovlen = 1;
+
+            ++numMessages;
+        }
+
+        size_t numSent = 0;
+        while (numSent < numMessages) {
+            int result = ::sendmmsg(socketDescriptor, messages + numSent, numMessages - numSent, 0);
+
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (result <= 0) {
+                // when saturating a link this isn't an uncommon message - suppress it so it doesn't bomb the debug
+                static const QString WRITE_ERROR_REGEX = "Socket::writeQueuedPackets sendmmsg error - ";
+                static QString repeatedMessage
+                    = LogHandler::getInstance().addRepeatedMessageRegex(WRITE_ERROR_REGEX);
+
+                qCDebug(networking) << "Socket::writeQueuedPackets sendmmsg error -" << strerror(errno)
+                    << "- dropping" << (numMessages - numSent) << "datagrams";
+                break;
+            }
+
+            for (size_t i = numSent; i < numSent + (size_t)result; ++i) {
+                bytesWritten += messages[i].msg_len;
+            }
+
+            numSent += result;
+        }
+    }
+
+    return bytesWritten;
+}
+
+#else
+
+qint64 Socket::writeQueuedPackets(std::vector<QueuedPacket>& queuedPackets) {
+    qint64 bytesWritten = 0;
+
+    for (auto& queuedPacket : queuedPackets) {
+        const Packet& packet = *queuedPacket.first;
+        bytesWritten += std::max(writeDatagram(packet.getData(), packet.getDataSize(), queuedPacket.second), (qint64)0);
+    }
+
+    return bytesWritten;
+}
+
+#endif
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr) {
     auto it = _connectionsHash.find(sockAddr);
 
@@ -342,7 +508,7 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
@@ -358,67 +524,256 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+
+#ifdef Q_OS_LINUX
+        // the read through QUdpSocket above re-arms its read notifier, now drain whatever else is waiting in batches
+        readPendingDatagramsBatched();
+#endif
+    }
+}
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+#ifdef Q_OS_LINUX
+
+void Socket::readPendingDatagramsBatched() {
+    auto socketDescriptor = _udpSocket.socketDescriptor();
+    if (socketDescriptor < 0) {
+        return;
+    }
+
+    if (_receiveBuffers.empty()) {
+        _receiveBuffers.resize(RECEIVE_BATCH_SIZE);
+    }
+
+    mmsghdr messages[RECEIVE_BATCH_SIZE];
+    iovec datagrams[RECEIVE_BATCH_SIZE];
+    sockaddr_in addresses[RECEIVE_BATCH_SIZE];
+
+    while (true) {
+        for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+            // slots whose buffer was handed off to a packet in the last batch get a fresh one
+            if (!_receiveBuffers[i]) {
+                _receiveBuffers[i] = PacketPool::allocate(MAX_PACKET_SIZE);
             }
 
-            continue;
+            datagrams[i].iov_base = _receiveBuffers[i].get();
+            datagrams[i].iov_len = MAX_PACKET_SIZE;
+
+            memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_name = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            messages[i].msg_hdr.msg_iov = &datagrams[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        int numReceived = ::recvmmsg(socketDescriptor, messages, RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        if (numReceived < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr);
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                qCDebug(networking) << "Socket::readPendingDatagramsBatched recvmmsg error -" << strerror(errno);
+            }
+
+            return;
+        }
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+        _readyReadBackupTimer->start();
+
+        auto receiveTime = p_high_resolution_clock::now();
+
+        for (int i = 0; i < numReceived; ++i) {
+            int sizeRead = messages[i].msg_len;
+
+            if (sizeRead <= 0 || (messages[i].msg_hdr.msg_flags & MSG_TRUNC) || addresses[i].sin_family != AF_INET) {
+                // nothing useful in this slot (or a datagram too large for our buffers) - leave its buffer for re-use
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
-
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
-
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
-                    auto connection = findOrCreateConnection(senderSockAddr);
-
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
-                        continue;
-                    }
-                }
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&addresses[i]));
+
+            // save information for this packet, in case it is the one that sticks readyRead
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
+            // the buffer is moved into the packet, the slot is refilled before the next recvmmsg
+            processDatagram(std::move(_receiveBuffers[i]), sizeRead, senderSockAddr, receiveTime);
+        }
+
+        if (numReceived < RECEIVE_BATCH_SIZE) {
+            // the socket has been drained
+            return;
+        }
+    }
+}
+
+#endif
+
+void Socket::processDatagram(PacketBuffer buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        if (_packetFilterThread) {
+            // the worker thread runs the filter and hands verified packets back to processFilteredPackets
+            {
+                Lock lock(_packetsToFilterMutex);
+                _packetsToFilter.push_back(std::move(packet));
+            }
+            _packetsToFilterCondition.notify_one();
+            return;
+        }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            processFilteredPacket(std::move(packet));
+        }
+    }
+}
+
+void Socket::processFilteredPacket(std::unique_ptr<Packet> packet) {
+    const auto& senderSockAddr = packet->getSenderSockAddr();
+
+    if (packet->isReliable()) {
+        // if this was a reliable packet then signal the matching connection with the sequence number
+        auto connection = findOrCreateConnection(senderSockAddr);
+
+        if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                      packet->getDataSize(),
+                                                                      packet->getPayloadSize())) {
+            // the connection could not be created or indicated that we should not continue processing this packet
+            return;
+        }
+    }
+
+    if (packet->isPartOfMessage()) {
+        auto connection = findOrCreateConnection(senderSockAddr);
+        if (connection) {
+            connection->queueReceivedMessagePacket(std::move(packet));
+        }
+    } else if (_packetHandler) {
+        // call the verified packet callback to let it handle this packet
+        _packetHandler(std::move(packet));
+    }
+}
+
+void Socket::setPacketFilterOnWorkerThread(bool enabled) {
+    if (enabled && !_packetFilterThread) {
+        _shouldStopPacketFilterThread = false;
+        _packetFilterThread.reset(new std::thread([this] { runPacketFilterWorker(); }));
+    } else if (!enabled) {
+        stopPacketFilterWorker();
+    }
+}
+
+void Socket::stopPacketFilterWorker() {
+    if (_packetFilterThread) {
+        {
+            Lock lock(_packetsToFilterMutex);
+            _shouldStopPacketFilterThread = true;
+        }
+        _packetsToFilterCondition.notify_one();
+
+        _packetFilterThread->join();
+        _packetFilterThread.reset();
+
+        // anything the worker had not filtered yet is dropped, like a datagram lost on the wire
+        Lock lock(_packetsToFilterMutex);
+        _packetsToFilter.clear();
+    }
+}
+
+void Socket::runPacketFilterWorker() {
+    std::vector<std::unique_ptr<Packet>> batch;
+
+    while (true) {
+        {
+            Lock lock(_packetsToFilterMutex);
+            _packetsToFilterCondition.wait(lock, [this] {
+                return _shouldStopPacketFilterThread || !_packetsToFilter.empty();
+            });
+
+            if (_shouldStopPacketFilterThread) {
+                return;
+            }
+
+            // take everything received since the last batch
+            batch.swap(_packetsToFilter);
+        }
+
+        for (auto& packet : batch) {
+            if (_packetFilterOperator && !_packetFilterOperator(*packet)) {
+                packet.reset();
+            }
+        }
+
+        bool shouldQueueCall = false;
+        {
+            Lock lock(_filteredPacketsMutex);
+            for (auto& packet : batch) {
+                if (packet) {
+                    _filteredPackets.push_back(std::move(packet));
                 }
             }
+
+            // one queued call handles everything filtered until it runs
+            shouldQueueCall = !_hasQueuedFilteredPacketsCall && !_filteredPackets.empty();
+            _hasQueuedFilteredPacketsCall = _hasQueuedFilteredPacketsCall || shouldQueueCall;
+        }
+
+        if (shouldQueueCall) {
+            QMetaObject::invokeMethod(this, "processFilteredPackets", Qt::QueuedConnection);
         }
+
+        batch.clear();
+    }
+}
+
+void Socket::processFilteredPackets() {
+    std::vector<std::unique_ptr<Packet>> filteredPackets;
+    {
+        Lock lock(_filteredPacketsMutex);
+        filteredPackets.swap(_filteredPackets);
+        _hasQueuedFilteredPacketsCall = false;
+    }
+
+    for (auto& packet : filteredPackets) {
+        processFilteredPacket(std::move(packet));
     }
 }
 
@@ -14,8 +14,11 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <condition_variable>
 #include <functional>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
 
 #include <QtCore/QObject>
@@ -55,6 +58,7 @@ public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -65,12 +69,23 @@ public:
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+
+    // Batched writes - unreliable packets are held until the next flushQueuedPackets and then written together
+    // (with a single sendmmsg per batch where supported). Reliable packets are handed straight to their connection.
+    qint64 queuePacket(std::unique_ptr<Packet> packet, const HifiSockAddr& sockAddr);
+    qint64 queuePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
+    qint64 flushQueuedPackets();
     
     void bind(const QHostAddress& address, quint16 port = 0);
     void rebind(quint16 port);
     void rebind();
 
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
+
+    // When enabled the packet filter for data packets runs on a worker thread, in batches, and only packets that pass it
+    // come back to the socket thread to be handled (in the order they were received).
+    // The filter operator must then be safe to call from that thread.
+    void setPacketFilterOnWorkerThread(bool enabled);
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
@@ -101,6 +116,7 @@ public slots:
     
 private slots:
     void readPendingDatagrams();
+    void processFilteredPackets();
     void checkForReadyReadBackup();
     void rateControlSync();
 
@@ -109,8 +125,20 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void processDatagram(PacketBuffer buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+#ifdef Q_OS_LINUX
+    void readPendingDatagramsBatched();
+#endif
+    void processFilteredPacket(std::unique_ptr<Packet> packet);
+    void runPacketFilterWorker();
+    void stopPacketFilterWorker();
+
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr);
     bool socketMatchesNodeOrDomain(const HifiSockAddr& sockAddr);
+
+    using QueuedPacket = std::pair<std::unique_ptr<Packet>, HifiSockAddr>;
+    qint64 writeQueuedPackets(std::vector<QueuedPacket>& queuedPackets);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
@@ -133,6 +161,19 @@ private:
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
     std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
+
+    Mutex _queuedPacketsMutex;
+    std::vector<QueuedPacket> _queuedPackets;
+
+    // packets waiting for, and packets that passed, the packet filter on the worker thread
+    std::unique_ptr<std::thread> _packetFilterThread;
+    Mutex _packetsToFilterMutex;
+    std::condition_variable _packetsToFilterCondition;
+    std::vector<std::unique_ptr<Packet>> _packetsToFilter;
+    bool _shouldStopPacketFilterThread { false };
+    Mutex _filteredPacketsMutex;
+    std::vector<std::unique_ptr<Packet>> _filteredPackets;
+    bool _hasQueuedFilteredPacketsCall { false };
     
     int _synInterval { 10 }; // 10ms
     QTimer* _synTimer { nullptr };
@@ -145,6 +186,12 @@ private:
 
     bool _shouldChangeSocketOptions { true };
 
+#ifdef Q_OS_LINUX
+    // ring of MTU sized receive buffers for recvmmsg - a buffer is moved into the Packet built from it
+    static const int RECEIVE_BATCH_SIZE = 64;
+    std::vector<PacketBuffer> _receiveBuffers;
+#endif
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
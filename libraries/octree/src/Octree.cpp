@@ -17,6 +17,8 @@
 #include <cstdio>
 #include <cmath>
 #include <fstream> // to load voxels from file
+#include <limits>
+#include <vector>
 
 #include <QDataStream>
 #include <QDebug>
@@ -31,6 +33,7 @@
 #include <QJsonDocument>
 #include <QFileInfo>
 #include <QString>
+#include <QStringList>
 
 #include <GeometryUtil.h>
 #include <Gzip.h>
@@ -50,7 +53,7 @@
 #include "OctreeLogging.h"
 
 
-QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -1169,6 +1172,18 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
         }
     }
 
+    // when the parent intersects, its children are tested against the keyhole all together, which is the same test as
+    // OctreeElement::isInView
+    uint8_t childrenInView[NUMBER_OF_CHILDREN] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    if (params.usesFrustum && !params.recurseEverything && nodeLocationThisView == ViewFrustum::INTERSECT) {
+        thread_local AABoxArrays childBoxes;
+        childBoxes.resize(currentCount);
+        for (int i = 0; i < currentCount; i++) {
+            childBoxes.set(i, sortedChildren[i] ? AABox(sortedChildren[i]->getAACube()) : AABox());
+        }
+        params.viewFrustum.boxesIntersectKeyhole(childBoxes, 0, currentCount, childrenInView);
+    }
+
     // for each child element in Distance sorted order..., check to see if they exist, are colored, and in view, and if so
     // add them to our distance ordered array of children
     for (int i = 0; i < currentCount; i++) {
@@ -1179,7 +1194,7 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
                 (params.recurseEverything || !params.usesFrustum ||
                  (nodeLocationThisView == ViewFrustum::INSIDE) || // parent was fully in view, we can assume ALL children are
                   (nodeLocationThisView == ViewFrustum::INTERSECT &&
-                        childElement->isInView(params.viewFrustum)) // the parent intersects and the child is in view
+                        childrenInView[i]) // the parent intersects and the child is in view
                 ));
 
         if (!childIsInView) {
@@ -1245,9 +1260,13 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
                     // If our child wasn't in view (or we're ignoring wasInView) then we add it to our sending items.
                     // Or if we were previously in the view, but this element has changed since it was last sent, then we do
                     // need to send it.
-                    if (!childWasInView ||
-                        (params.deltaView &&
-                         childElement->hasChangedSince(params.lastQuerySent - CHANGE_FUDGE))){
+                    // Outside of delta views and forced scenes only the children that changed since they were last sent
+                    // have any data to send: every change dirties the element and its ancestors, so the unchanged
+                    // siblings along a changed branch can be skipped rather than have each of their items checked.
+                    bool childHasChanged = childElement->hasChangedSince(params.lastQuerySent - CHANGE_FUDGE);
+                    bool childHasDataToSend = params.deltaView ? (!childWasInView || childHasChanged) :
+                                                                 (params.forceSendScene || childHasChanged);
+                    if (childHasDataToSend) {
 
                         childrenDataBits += (1 << (7 - originalIndex));
                         inViewWithColorCount++;
@@ -1628,6 +1647,10 @@ bool Octree::readFromFile(const char* fileName) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith(".bin")) {
+        return readFromBinaryFile(qFileName);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -1882,6 +1905,8 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin") {
+        success = writeToBinaryFile(cFileName, element);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -1936,6 +1961,217 @@ bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
     return success;
 }
 
+// The binary persist format holds the same entity descriptions as the JSON one, laid out so that it can be mapped
+// and each entity decoded on its own:
+//
+//     header:   magic, format version, bitstream version
+//               property table: count, then each top-level property name
+//     records:  for each entity, a count of its properties, then (property table index, QVariant value) pairs
+//     index:    entity count, then for each entity the offset and size of its record
+//     trailer:  the offset of the index
+//
+// Everything is written with a QDataStream at BINARY_PERSIST_DATA_STREAM_VERSION.
+const quint32 BINARY_PERSIST_MAGIC = 0x48464250; // "HFBP"
+const quint32 BINARY_PERSIST_FORMAT_VERSION = 1;
+const QDataStream::Version BINARY_PERSIST_DATA_STREAM_VERSION = QDataStream::Qt_5_6;
+const int BINARY_PERSIST_TRAILER_SIZE = sizeof(quint64);
+const int BINARY_PERSIST_INDEX_ENTRY_SIZE = sizeof(quint64) + sizeof(quint32);
+const int ENTITIES_PER_BINARY_READ_BATCH = 1000;
+
+bool Octree::writeToBinaryFile(const char* fileName, OctreeElementPointer element) {
+    QVariantMap entityDescription;
+
+    qCDebug(octree, "Saving binary SVO to file %s...", fileName);
+
+    OctreeElementPointer top;
+    if (element) {
+        top = element;
+    } else {
+        top = _rootElement;
+    }
+
+    // store the entity data
+    bool entityDescriptionSuccess = writeToMap(entityDescription, top, true, true);
+    if (!entityDescriptionSuccess) {
+        qCritical("Failed to convert Entities to QVariantMap while saving to binary.");
+        return false;
+    }
+    QVariantList entities = entityDescription["Entities"].toList();
+    entityDescription.clear();
+
+    // every entity refers to its properties by their index in the property table
+    QStringList propertyNames;
+    QHash<QString, quint16> propertyIndices;
+    for (const auto& entity : entities) {
+        const QVariantMap entityMap = entity.toMap();
+        for (auto it = entityMap.constBegin(); it != entityMap.constEnd(); ++it) {
+            if (!propertyIndices.contains(it.key())) {
+                if (propertyNames.size() > std::numeric_limits<quint16>::max()) {
+                    qCritical("Too many distinct entity properties while saving to binary.");
+                    return false;
+                }
+                propertyIndices[it.key()] = (quint16)propertyNames.size();
+                propertyNames << it.key();
+            }
+        }
+    }
+
+    QFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical("Could not write to binary description of entities.");
+        return false;
+    }
+
+    QDataStream stream(&persistFile);
+    stream.setVersion(BINARY_PERSIST_DATA_STREAM_VERSION);
+
+    // include the "bitstream" version
+    PacketType expectedType = expectedDataPacketType();
+    PacketVersion expectedVersion = versionForPacketType(expectedType);
+    stream << BINARY_PERSIST_MAGIC << BINARY_PERSIST_FORMAT_VERSION << (quint32)expectedVersion;
+    stream << propertyNames;
+
+    std::vector<std::pair<quint64, quint32>> index;
+    index.reserve(entities.size());
+    for (const auto& entity : entities) {
+        quint64 recordOffset = persistFile.pos();
+
+        const QVariantMap entityMap = entity.toMap();
+        stream << (quint16)entityMap.size();
+        for (auto it = entityMap.constBegin(); it != entityMap.constEnd(); ++it) {
+            stream << propertyIndices[it.key()] << it.value();
+        }
+
+        index.emplace_back(recordOffset, (quint32)(persistFile.pos() - recordOffset));
+    }
+
+    quint64 indexOffset = persistFile.pos();
+    stream << (quint32)index.size();
+    for (const auto& entry : index) {
+        stream << entry.first << entry.second;
+    }
+    stream << indexOffset;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool Octree::readFromBinaryFile(QString qFileName) {
+    QFile file(qFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open binary file for reading: " << qFileName;
+        return false;
+    }
+
+    // map the file rather than reading it, so that only the records being decoded need to be in memory
+    qint64 fileSize = file.size();
+    uchar* fileData = fileSize > BINARY_PERSIST_TRAILER_SIZE ? file.map(0, fileSize) : nullptr;
+    if (!fileData) {
+        qCritical() << "Cannot map binary file for reading: " << qFileName;
+        return false;
+    }
+    auto unmapFile = [&] { file.unmap(fileData); };
+
+    // a QByteArray only holds up to 2GB, so the records are read from the map but the header, trailer and index,
+    // which are bigger or reach further into the file, are streamed from the file itself
+    auto dataAt = [&](qint64 offset, int size) {
+        return QByteArray::fromRawData(reinterpret_cast<const char*>(fileData) + offset, size);
+    };
+    QDataStream fileStream(&file);
+    fileStream.setVersion(BINARY_PERSIST_DATA_STREAM_VERSION);
+
+    quint32 magic = 0, formatVersion = 0, bitstreamVersion = 0;
+    QStringList propertyNames;
+    fileStream >> magic >> formatVersion >> bitstreamVersion;
+    if (magic != BINARY_PERSIST_MAGIC || formatVersion != BINARY_PERSIST_FORMAT_VERSION) {
+        qCritical() << "Binary file" << qFileName << "is not in a format we can read (format version"
+            << formatVersion << ")";
+        unmapFile();
+        return false;
+    }
+    fileStream >> propertyNames;
+
+    qint64 indexOffset = 0;
+    file.seek(fileSize - BINARY_PERSIST_TRAILER_SIZE);
+    fileStream >> indexOffset;
+    if (fileStream.status() != QDataStream::Ok || indexOffset < 0 ||
+            indexOffset + (qint64)sizeof(quint32) > fileSize - BINARY_PERSIST_TRAILER_SIZE) {
+        qCritical() << "Binary file" << qFileName << "has a bad index offset";
+        unmapFile();
+        return false;
+    }
+
+    file.seek(indexOffset);
+    quint32 numEntities = 0;
+    fileStream >> numEntities;
+    if ((qint64)numEntities * BINARY_PERSIST_INDEX_ENTRY_SIZE >
+            fileSize - BINARY_PERSIST_TRAILER_SIZE - indexOffset - (qint64)sizeof(quint32)) {
+        qCritical() << "Binary file" << qFileName << "has a truncated index";
+        unmapFile();
+        return false;
+    }
+
+    qCDebug(octree) << "Loading binary file" << qFileName << "with" << numEntities << "entities...";
+    emit importSize(1.0f, 1.0f, 1.0f);
+    emit importProgress(0);
+
+    // decode the entities a batch at a time, so that only one batch of descriptions is ever in memory
+    bool success = numEntities > 0;
+    QVariantList batch;
+    auto readBatch = [&] {
+        QVariantMap batchDescription;
+        batchDescription["Version"] = bitstreamVersion;
+        batchDescription["Entities"] = batch;
+        batch.clear();
+        success = readFromMap(batchDescription) && success;
+    };
+
+    for (quint32 i = 0; i < numEntities; ++i) {
+        qint64 recordOffset;
+        quint32 recordSize;
+        fileStream >> recordOffset >> recordSize;
+        if (recordOffset < 0 || recordSize > (quint32)std::numeric_limits<int>::max() ||
+                recordOffset + recordSize > indexOffset) {
+            qCritical() << "Binary file" << qFileName << "has a bad record for entity" << i;
+            success = false;
+            continue;
+        }
+
+        QDataStream recordStream(dataAt(recordOffset, (int)recordSize));
+        recordStream.setVersion(BINARY_PERSIST_DATA_STREAM_VERSION);
+
+        quint16 numProperties = 0;
+        recordStream >> numProperties;
+        QVariantMap entityMap;
+        for (quint16 j = 0; j < numProperties; ++j) {
+            quint16 propertyIndex;
+            QVariant value;
+            recordStream >> propertyIndex >> value;
+            if (propertyIndex < propertyNames.size()) {
+                entityMap[propertyNames[propertyIndex]] = value;
+            }
+        }
+        if (recordStream.status() != QDataStream::Ok) {
+            qCritical() << "Binary file" << qFileName << "has a bad record for entity" << i;
+            success = false;
+            continue;
+        }
+        batch << entityMap;
+
+        if (batch.size() >= ENTITIES_PER_BINARY_READ_BATCH) {
+            readBatch();
+            emit importProgress((int)((100ULL * (i + 1)) / numEntities));
+        }
+    }
+    if (!batch.isEmpty()) {
+        readBatch();
+    }
+
+    emit importProgress(100);
+    unmapFile();
+
+    return success;
+}
+
 bool Octree::writeToSVOFile(const char* fileName, OctreeElementPointer element) {
     qWarning() << "SVO file format deprecated. Support for reading SVO files is no longer support and will be removed soon.";
     bool success = false;
@@ -223,8 +223,10 @@ public:
                     return thisVersion == versionForPacketType(expectedDataPacketType()); }
     virtual PacketVersion expectedVersion() const { return versionForPacketType(expectedDataPacketType()); }
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
+    // called without the tree locked: take the write lock only around the changes to the tree, and add the time
+    // spent waiting for it to lockWaitTime
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
-                                      const SharedNodePointer& sourceNode) { return 0; }
+                                      const SharedNodePointer& sourceNode, quint64& lockWaitTime) { return 0; }
                     
     virtual bool recurseChildrenWithData() const { return true; }
     virtual bool rootElementHasData() const { return false; }
@@ -309,6 +311,7 @@ public:
     bool writeToFile(const char* filename, OctreeElementPointer element = NULL, QString persistAsFileType = "svo");
     bool writeToJSONFile(const char* filename, OctreeElementPointer element = NULL, bool doGzip = false);
     bool writeToSVOFile(const char* filename, OctreeElementPointer element = NULL);
+    bool writeToBinaryFile(const char* filename, OctreeElementPointer element = NULL);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
 
@@ -319,8 +322,18 @@ public:
     bool readSVOFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readFromBinaryFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
 
+    // Incremental persists (see OctreePersistThread). A tree that supports them describes what changed since a time, in
+    // the form writeToMap() uses plus a "Deleted" list of IDs, and returns false if it doesn't. Deletions are remembered
+    // from the first call, and each call takes those since the one before.
+    virtual bool writeChangesToMap(QVariantMap& changes, quint64 changedSince) { return false; }
+    // Changes to replay over the persist file on load: readFromMap() skips whatever they delete or replace, then
+    // replayChanges() adds their versions.
+    virtual void setChangesToReplay(const QVariantMap& changes) { }
+    virtual bool replayChanges() { return true; }
+
     unsigned long getOctreeElementsCount();
 
     bool getShouldReaverage() const { return _shouldReaverage; }
@@ -180,7 +180,8 @@ void OctreeEditPacketSender::queuePacketToNodes(std::unique_ptr<NLPacket> packet
             // here we need to get the "pending packet" for this server
             _serverJurisdictions->withReadLock([&] {
                 const JurisdictionMap& map = (*_serverJurisdictions)[nodeUUID];
-                isMyJurisdiction = (map.isMyJurisdiction(octCode, CHECK_NODE_ONLY) == JurisdictionMap::WITHIN);
+                // the octcodes above the jurisdiction, such as the root, are for all of the servers
+                isMyJurisdiction = (map.isMyJurisdiction(octCode, CHECK_NODE_ONLY) != JurisdictionMap::BELOW);
             });
 
             if (isMyJurisdiction) {
@@ -194,7 +195,7 @@ void OctreeEditPacketSender::queuePacketToNodes(std::unique_ptr<NLPacket> packet
 
 
 // NOTE: editMessage - is JUST the octcode/color and does not contain the packet header
-void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray& editMessage) {
+void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray& editMessage, const QUuid& serverID) {
 
     if (!_shouldSend) {
         return; // bail early
@@ -223,15 +224,21 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
     // But we can't really do that with a packed message, since each edit message could be destined
     // for a different server... So we need to actually manage multiple queued packets... one
     // for each server
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer server = serverID.isNull() ? SharedNodePointer() : nodeList->nodeWithUUID(serverID);
+    bool sendToServer = server && server->getActiveSocket() && server->getType() == getMyNodeType();
+
     _packetsQueueLock.lock();
 
-    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node){
+    nodeList->eachNode([&](const SharedNodePointer& node){
         // only send to the NodeTypes that are getMyNodeType()
         if (node->getActiveSocket() && node->getType() == getMyNodeType()) {
             QUuid nodeUUID = node->getUUID();
             bool isMyJurisdiction = true;
 
-            if (type == PacketType::EntityErase) {
+            if (sendToServer) {
+                isMyJurisdiction = (nodeUUID == serverID);
+            } else if (type == PacketType::EntityErase) {
                 isMyJurisdiction = true; // send erase messages to all servers
             } else if (_serverJurisdictions) {
                 // we need to get the jurisdiction for this
@@ -239,8 +246,9 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
                 _serverJurisdictions->withReadLock([&] {
                     if ((*_serverJurisdictions).find(nodeUUID) != (*_serverJurisdictions).end()) {
                         const JurisdictionMap& map = (*_serverJurisdictions)[nodeUUID];
+                        // the octcodes above the jurisdiction, such as the root, are for all of the servers
                         isMyJurisdiction = (map.isMyJurisdiction(reinterpret_cast<const unsigned char*>(editMessage.data()),
-                            CHECK_NODE_ONLY) == JurisdictionMap::WITHIN);
+                            CHECK_NODE_ONLY) != JurisdictionMap::BELOW);
                     } else {
                         isMyJurisdiction = false;
                     }
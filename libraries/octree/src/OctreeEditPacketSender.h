@@ -29,8 +29,9 @@ public:
 
     /// Queues a single edit message. Will potentially send a pending multi-command packet. Determines which server
     /// node or nodes the packet should be sent to. Can be called even before servers are known, in which case up to
-    /// MaxPendingMessages will be buffered and processed when servers are known.
-    void queueOctreeEditMessage(PacketType type, QByteArray& editMessage);
+    /// MaxPendingMessages will be buffered and processed when servers are known. If serverID names a known server, the
+    /// message goes to that server alone.
+    void queueOctreeEditMessage(PacketType type, QByteArray& editMessage, const QUuid& serverID = QUuid());
 
     /// Releases all queued messages even if those messages haven't filled an MTU packet. This will move the packed message
     /// packets onto the send queue. If running in threaded mode, the caller does not need to do any further processing to
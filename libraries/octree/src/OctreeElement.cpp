@@ -70,28 +70,12 @@ void OctreeElement::init(unsigned char * octalCode) {
         delete[] octalCode;
     }
 
-    // set up the _children union
+    // no children to start with
     _childBitmask = 0;
-    _childrenExternal = false;
-
+    _children.reset();
 
     _childrenCount[0]++;
 
-    // default pointers to child nodes to NULL
-#ifdef SIMPLE_CHILD_ARRAY
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        _simpleChildArray[i] = NULL;
-    }
-#endif
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    _childrenSingle.reset();
-#endif
-
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-        _externalChildren[i].reset();
-    }
-
     _isDirty = true;
     _shouldRender = false;
     _sourceUUIDKey = 0;
@@ -252,130 +236,73 @@ AtomicUIntStat OctreeElement::_setChildAtIndexCalls { 0 };
 AtomicUIntStat OctreeElement::_externalChildrenCount { 0 };
 AtomicUIntStat OctreeElement::_childrenCount[NUMBER_OF_CHILDREN + 1];
 
-OctreeElementPointer OctreeElement::getChildAtIndex(int childIndex) const {
-#ifdef SIMPLE_CHILD_ARRAY
-    return _simpleChildArray[childIndex];
-#endif // SIMPLE_CHILD_ARRAY
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    int childCount = getChildCount();
-
-    switch (childCount) {
-        case 0: {
-            return NULL;
-        } break;
-
-        case 1: {
-            // if our single child is the one being requested, return it, otherwise
-            // return null
-            int firstIndex = getNthBit(_childBitmask, 1);
-            if (firstIndex == childIndex) {
-                return _childrenSingle;
-            } else {
-                return NULL;
-            }
-        } break;
+int OctreeElement::getChildSlot(int childIndex) const {
+    // the bits of the lower indices are the higher bits of the mask
+    return numberOfOnes(_childBitmask & (unsigned char)(0xFF00 >> childIndex));
+}
 
-        default : {
-            return _externalChildren[childIndex];
-        } break;
+OctreeElementPointer OctreeElement::getChildAtIndex(int childIndex) const {
+    if (!oneAtBit(_childBitmask, childIndex)) {
+        return OctreeElementPointer();
     }
-#endif // def SIMPLE_EXTERNAL_CHILDREN
+    return _children[getChildSlot(childIndex)];
 }
 
 void OctreeElement::deleteAllChildren() {
-    // first delete all the OctreeElement objects...
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        OctreeElementPointer childAt = getChildAtIndex(i);
-        if (childAt) {
-            childAt.reset();
-        }
-    }
-
-    if (_childrenExternal) {
-        // if the children_t union represents _children.external we need to delete it here
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
+    // the child array holds the only references the tree has to the children
+    if (_children) {
+        _externalChildrenMemoryUsage -= getChildCount() * sizeof(OctreeElementPointer);
+        _children.reset();
     }
 }
 
 void OctreeElement::setChildAtIndex(int childIndex, OctreeElementPointer child) {
-#ifdef SIMPLE_CHILD_ARRAY
-    int previousChildCount = getChildCount();
-    if (child) {
-        setAtBit(_childBitmask, childIndex);
-    } else {
-        clearAtBit(_childBitmask, childIndex);
-    }
-    int newChildCount = getChildCount();
-
-    // store the child in our child array
-    _simpleChildArray[childIndex] = child;
+    bool hadChild = oneAtBit(_childBitmask, childIndex);
+    int slot = getChildSlot(childIndex);
 
-    // track our population data
-    if (previousChildCount != newChildCount) {
-        _childrenCount[previousChildCount]--;
-        _childrenCount[newChildCount]++;
+    if (hadChild && child) {
+        _children[slot] = child;
+        return;
+    }
+    if (!hadChild && !child) {
+        return;
     }
-#endif
 
-#ifdef SIMPLE_EXTERNAL_CHILDREN
+    // the children are added and removed far less often than they are visited,
+    // so the array is reallocated to fit them exactly each time
+    int previousChildCount = getChildCount();
+    int newChildCount = child ? previousChildCount + 1 : previousChildCount - 1;
 
-    int firstIndex = getNthBit(_childBitmask, 1);
-    int secondIndex = getNthBit(_childBitmask, 2);
+    std::unique_ptr<OctreeElementPointer[]> newChildren;
+    if (newChildCount > 0) {
+        newChildren.reset(new OctreeElementPointer[newChildCount]);
+        for (int i = 0; i < slot; i++) {
+            newChildren[i] = std::move(_children[i]);
+        }
+        if (child) {
+            newChildren[slot] = child;
+            for (int i = slot; i < previousChildCount; i++) {
+                newChildren[i + 1] = std::move(_children[i]);
+            }
+        } else {
+            for (int i = slot + 1; i < previousChildCount; i++) {
+                newChildren[i - 1] = std::move(_children[i]);
+            }
+        }
+    }
+    _children = std::move(newChildren);
 
-    int previousChildCount = getChildCount();
     if (child) {
         setAtBit(_childBitmask, childIndex);
     } else {
         clearAtBit(_childBitmask, childIndex);
     }
-    int newChildCount = getChildCount();
 
     // track our population data
-    if (previousChildCount != newChildCount) {
-        _childrenCount[previousChildCount]--;
-        _childrenCount[newChildCount]++;
-    }
-
-    if ((previousChildCount == 0 || previousChildCount == 1) && newChildCount == 0) {
-        _childrenSingle.reset();
-    } else if (previousChildCount == 0 && newChildCount == 1) {
-        _childrenSingle = child;
-    } else if (previousChildCount == 1 && newChildCount == 2) {
-        OctreeElementPointer previousChild = _childrenSingle;
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
-        _externalChildren[firstIndex] = previousChild;
-        _externalChildren[childIndex] = child;
-
-        _childrenExternal = true;
-
-        _externalChildrenMemoryUsage += NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-
-    } else if (previousChildCount == 2 && newChildCount == 1) {
-        assert(!child); // we are removing a child, so this must be true!
-        OctreeElementPointer previousFirstChild = _externalChildren[firstIndex];
-        OctreeElementPointer previousSecondChild = _externalChildren[secondIndex];
-
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
-        _childrenExternal = false;
-
-        _externalChildrenMemoryUsage -= NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-        if (childIndex == firstIndex) {
-            _childrenSingle = previousSecondChild;
-        } else {
-            _childrenSingle = previousFirstChild;
-        }
-    } else {
-        _externalChildren[childIndex] = child;
-    }
-
-#endif // def SIMPLE_EXTERNAL_CHILDREN
+    _childrenCount[previousChildCount]--;
+    _childrenCount[newChildCount]++;
+    _externalChildrenMemoryUsage += newChildCount * sizeof(OctreeElementPointer);
+    _externalChildrenMemoryUsage -= previousChildCount * sizeof(OctreeElementPointer);
 }
 
 
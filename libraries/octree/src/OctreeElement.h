@@ -12,10 +12,8 @@
 #ifndef hifi_OctreeElement_h
 #define hifi_OctreeElement_h
 
-//#define SIMPLE_CHILD_ARRAY
-#define SIMPLE_EXTERNAL_CHILDREN
-
 #include <atomic>
+#include <memory>
 
 #include <QReadWriteLock>
 
@@ -223,6 +221,7 @@ protected:
 
     void deleteAllChildren();
     void setChildAtIndex(int childIndex, OctreeElementPointer child);
+    int getChildSlot(int childIndex) const; // of a child in _children, the number of children with a lower index
 
     void calculateAACube();
 
@@ -236,17 +235,9 @@ protected:
 
     quint64 _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
 
-    /// Client and server, pointers to child nodes, various encodings
-#ifdef SIMPLE_CHILD_ARRAY
-    OctreeElementPointer _simpleChildArray[8]; /// Only used when SIMPLE_CHILD_ARRAY is enabled
-#endif
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    // union children_t {
-    OctreeElementPointer _childrenSingle;
-    OctreeElementPointer _externalChildren[NUMBER_OF_CHILDREN];
-    // } _children;
-#endif
+    /// Client and server, pointers to the child nodes there are, in the order of their index, 8 bytes
+    /// (most elements are leaves, the children of the others are sized to fit in getChildSlot() order)
+    std::unique_ptr<OctreeElementPointer[]> _children;
 
     uint16_t _sourceUUIDKey; /// Client only, stores node id of voxel server that sent his voxel, 2 bytes
 
@@ -263,8 +254,7 @@ protected:
          _isDirty : 1, /// Client only, has this voxel changed since being rendered, 1 bit
          _shouldRender : 1, /// Client only, should this voxel render at this time, 1 bit
          _octcodePointer : 1, /// Client and Server only, is this voxel's octal code a pointer or buffer, 1 bit
-         _unknownBufferIndex : 1,
-         _childrenExternal : 1; /// Client only, is this voxel's VBO buffer the unknown buffer index, 1 bit
+         _unknownBufferIndex : 1; /// Client only, is this voxel's VBO buffer the unknown buffer index, 1 bit
 
     static AtomicUIntStat _voxelNodeCount;
     static AtomicUIntStat _voxelNodeLeafCount;
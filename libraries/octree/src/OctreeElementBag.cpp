@@ -14,6 +14,7 @@
 
 void OctreeElementBag::deleteAll() {
     _bagElements = Bag();
+    _queue = std::priority_queue<Entry, std::vector<Entry>>();
 }
 
 /// does the bag contain elements?
@@ -24,17 +25,27 @@ bool OctreeElementBag::isEmpty() {
 }
 
 void OctreeElementBag::insert(OctreeElementPointer element) {
-    _bagElements[element.get()] = element;
+    auto inserted = _bagElements.insert({ element.get(), element });
+    if (!inserted.second) {
+        // already in the bag, keep its place in line
+        inserted.first->second = element;
+        return;
+    }
+    float priority = _priorityFunction ? _priorityFunction(element) : 0.0f;
+    _queue.push({ priority, _nextOrder++, element.get() });
 }
 
 OctreeElementPointer OctreeElementBag::extract() {
     OctreeElementPointer result;
 
     // Find the first element still alive
-    Bag::iterator it = _bagElements.begin();
-    while (it != _bagElements.end() && !result) {
-        result = it->second.lock();
-        it = _bagElements.erase(it);
+    while (!_queue.empty() && !result) {
+        Bag::iterator it = _bagElements.find(_queue.top().element);
+        _queue.pop();
+        if (it != _bagElements.end()) {
+            result = it->second.lock();
+            _bagElements.erase(it);
+        }
     }
     return result;
 }
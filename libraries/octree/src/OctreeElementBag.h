@@ -7,7 +7,8 @@
 //
 //  This class is used by the Octree:encodeTreeBitstream() functions to store elements and element data that need to be sent.
 //  It's a generic bag style storage mechanism. But It has the property that you can't put the same element into the bag
-//  more than once (in other words, it de-dupes automatically).
+//  more than once (in other words, it de-dupes automatically). Elements come out highest priority first, in the order they
+//  went in among equal priorities, so that a send pass spends its budget on what matters most to the viewer first.
 //
 //  Distributed under the Apache License, Version 2.0.
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
@@ -16,7 +17,10 @@
 #ifndef hifi_OctreeElementBag_h
 #define hifi_OctreeElementBag_h
 
+#include <functional>
+#include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "OctreeElement.h"
 
@@ -24,6 +28,11 @@ class OctreeElementBag {
     using Bag = std::unordered_map<OctreeElement*, OctreeElementWeakPointer>;
     
 public:
+    using PriorityFunction = std::function<float(const OctreeElementPointer&)>;
+
+    // how to rank the elements inserted from now on, elements are all equal without one
+    void setPriorityFunction(PriorityFunction priorityFunction) { _priorityFunction = priorityFunction; }
+
     void insert(OctreeElementPointer element); // put a element into the bag
 
     OctreeElementPointer extract(); /// pull a element out of the bag (could come in any order) and if all of the
@@ -37,7 +46,19 @@ public:
     size_t size() const { return _bagElements.size(); }
 
 private:
+    struct Entry {
+        float priority;
+        uint64_t order;
+        OctreeElement* element;
+        bool operator<(const Entry& other) const {
+            return priority < other.priority || (priority == other.priority && order > other.order);
+        }
+    };
+
     Bag _bagElements;
+    std::priority_queue<Entry, std::vector<Entry>> _queue; // may hold entries for elements already extracted
+    uint64_t _nextOrder { 0 };
+    PriorityFunction _priorityFunction;
 };
 
 class OctreeElementExtraEncodeDataBase {
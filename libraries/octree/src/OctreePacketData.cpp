@@ -9,8 +9,12 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QtCore/QtEndian>
+
 #include <GLMHelpers.h>
+#include <Gzip.h>
 #include <PerfStat.h>
+#include <UUID.h>
 
 #include "OctreeLogging.h"
 #include "OctreePacketData.h"
@@ -20,9 +24,6 @@ bool OctreePacketData::_debug = false;
 AtomicUIntStat OctreePacketData::_totalBytesOfOctalCodes { 0 };
 AtomicUIntStat OctreePacketData::_totalBytesOfBitMasks { 0 };
 AtomicUIntStat OctreePacketData::_totalBytesOfColor { 0 };
-AtomicUIntStat OctreePacketData::_totalBytesOfValues { 0 };
-AtomicUIntStat OctreePacketData::_totalBytesOfPositions { 0 };
-AtomicUIntStat OctreePacketData::_totalBytesOfRawData { 0 };
 
 struct aaCubeData {
     glm::vec3 corner;
@@ -33,8 +34,10 @@ OctreePacketData::OctreePacketData(bool enableCompression, int targetSize) {
     changeSettings(enableCompression, targetSize); // does reset...
 }
 
-void OctreePacketData::changeSettings(bool enableCompression, unsigned int targetSize) {
+void OctreePacketData::changeSettings(bool enableCompression, unsigned int targetSize,
+                                      const QByteArray& compressionDictionary) {
     _enableCompression = enableCompression;
+    _compressionDictionary = compressionDictionary;
     _targetSize = std::min(MAX_OCTREE_UNCOMRESSED_PACKET_SIZE, targetSize);
     reset();
 }
@@ -57,6 +60,17 @@ void OctreePacketData::reset() {
 OctreePacketData::~OctreePacketData() {
 }
 
+unsigned char* OctreePacketData::appendSpace(int length) {
+    if (length > _bytesAvailable) {
+        return nullptr;
+    }
+    unsigned char* space = &_uncompressed[_bytesInUse];
+    _bytesInUse += length;
+    _bytesAvailable -= length;
+    _dirty = true;
+    return space;
+}
+
 bool OctreePacketData::append(const unsigned char* data, int length) {
     bool success = false;
 
@@ -318,172 +332,72 @@ bool OctreePacketData::appendColor(colorPart red, colorPart green, colorPart blu
     return success;
 }
 
-bool OctreePacketData::appendValue(uint8_t value) {
-    bool success = append(value); // used unsigned char version
-    if (success) {
-        _bytesOfValues++;
-        _totalBytesOfValues++;
-    }
-    return success;
-}
-
-bool OctreePacketData::appendValue(uint16_t value) {
-    const unsigned char* data = (const unsigned char*)&value;
-    
-    int length = sizeof(value);
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfValues += length;
-        _totalBytesOfValues += length;
-    }
-    return success;
-}
-
-bool OctreePacketData::appendValue(uint32_t value) {
-    const unsigned char* data = (const unsigned char*)&value;
-    int length = sizeof(value);
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfValues += length;
-        _totalBytesOfValues += length;
-    }
-    return success;
-}
-
-bool OctreePacketData::appendValue(quint64 value) {
-    const unsigned char* data = (const unsigned char*)&value;
-    int length = sizeof(value);
-    bool success = append(data, length);
-
-    if (success) {
-        _bytesOfValues += length;
-        _totalBytesOfValues += length;
-    }
-    return success;
-}
-
-bool OctreePacketData::appendValue(float value) {
-    
-    const unsigned char* data = (const unsigned char*)&value;
-    int length = sizeof(value);
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfValues += length;
-        _totalBytesOfValues += length;
-    }
-    return success;
-}
-
-bool OctreePacketData::appendValue(const glm::vec3& value) {
-    const unsigned char* data = (const unsigned char*)&value;
-    int length = sizeof(value);
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfValues += length;
-        _totalBytesOfValues += length;
-    }
-    return success;
-}
-
 bool OctreePacketData::appendValue(const QVector<glm::vec3>& value) {
     uint16_t qVecSize = value.size();
-    bool success = appendValue(qVecSize);
-    if (success) {
-        success = append((const unsigned char*)value.constData(), qVecSize * sizeof(glm::vec3));
-        if (success) {
-            _bytesOfValues += qVecSize * sizeof(glm::vec3);
-            _totalBytesOfValues += qVecSize * sizeof(glm::vec3);
-        }
+    int length = qVecSize * sizeof(glm::vec3);
+    unsigned char* destinationBuffer = appendSpace(sizeof(qVecSize) + length);
+    if (!destinationBuffer) {
+        return false;
     }
-    return success;
+    memcpy(destinationBuffer, &qVecSize, sizeof(qVecSize));
+    memcpy(destinationBuffer + sizeof(qVecSize), value.constData(), length);
+    return true;
 }
 
 bool OctreePacketData::appendValue(const QVector<glm::quat>& value) {
+    const int PACKED_QUAT_SIZE = 4 * sizeof(uint16_t);
     uint16_t qVecSize = value.size();
-    bool success = appendValue(qVecSize);
-
-    if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
-        unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
-        unsigned char* destinationBuffer = start;
-        for (int index = 0; index < value.size(); index++) {
-            destinationBuffer += packOrientationQuatToBytes(destinationBuffer, value[index]);
-        }
-        int quatsSize = destinationBuffer - start;
-        success = append(start, quatsSize);
-        if (success) {
-            _bytesOfValues += quatsSize;
-            _totalBytesOfValues += quatsSize;
-        }
+    unsigned char* destinationBuffer = appendSpace(sizeof(qVecSize) + qVecSize * PACKED_QUAT_SIZE);
+    if (!destinationBuffer) {
+        return false;
     }
-
-    return success;
+    memcpy(destinationBuffer, &qVecSize, sizeof(qVecSize));
+    destinationBuffer += sizeof(qVecSize);
+    for (int index = 0; index < qVecSize; index++) {
+        destinationBuffer += packOrientationQuatToBytes(destinationBuffer, value[index]);
+    }
+    return true;
 }
 
 bool OctreePacketData::appendValue(const QVector<float>& value) {
     uint16_t qVecSize = value.size();
-    bool success = appendValue(qVecSize);
-    if (success) {
-        success = append((const unsigned char*)value.constData(), qVecSize * sizeof(float));
-        if (success) {
-            _bytesOfValues += qVecSize * sizeof(float);
-            _totalBytesOfValues += qVecSize * sizeof(float);
-        }
+    int length = qVecSize * sizeof(float);
+    unsigned char* destinationBuffer = appendSpace(sizeof(qVecSize) + length);
+    if (!destinationBuffer) {
+        return false;
     }
-    return success;
+    memcpy(destinationBuffer, &qVecSize, sizeof(qVecSize));
+    memcpy(destinationBuffer + sizeof(qVecSize), value.constData(), length);
+    return true;
 }
 
 bool OctreePacketData::appendValue(const QVector<bool>& value) {
     uint16_t qVecSize = value.size();
-    bool success = appendValue(qVecSize);
-
-    if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
-        unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
-        unsigned char* destinationBuffer = start;
-        int bit = 0;
-        for (int index = 0; index < value.size(); index++) {
-            if (value[index]) {
-                (*destinationBuffer) |= (1 << bit);
-            }
-            if (++bit == BITS_IN_BYTE) {
-                destinationBuffer++;
-                bit = 0;
-            }
-        }
-        if (bit != 0) {
-            destinationBuffer++;
-        }
-        int boolsSize = destinationBuffer - start;
-        success = append(start, boolsSize);
-        if (success) {
-            _bytesOfValues += boolsSize;
-            _totalBytesOfValues += boolsSize;
+    int length = (qVecSize + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    unsigned char* destinationBuffer = appendSpace(sizeof(qVecSize) + length);
+    if (!destinationBuffer) {
+        return false;
+    }
+    memcpy(destinationBuffer, &qVecSize, sizeof(qVecSize));
+    destinationBuffer += sizeof(qVecSize);
+    memset(destinationBuffer, 0, length);
+    for (int index = 0; index < qVecSize; index++) {
+        if (value[index]) {
+            destinationBuffer[index / BITS_IN_BYTE] |= (1 << (index % BITS_IN_BYTE));
         }
     }
-    return success;
+    return true;
 }
 
 bool OctreePacketData::appendValue(const glm::quat& value) {
     const size_t VALUES_PER_QUAT = 4;
     const size_t PACKED_QUAT_SIZE = sizeof(uint16_t) * VALUES_PER_QUAT;
-    unsigned char data[PACKED_QUAT_SIZE];
-    int length = packOrientationQuatToBytes(data, value);
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfValues += length;
-        _totalBytesOfValues += length;
+    unsigned char* destinationBuffer = appendSpace(PACKED_QUAT_SIZE);
+    if (!destinationBuffer) {
+        return false;
     }
-    return success;
-}
-
-bool OctreePacketData::appendValue(bool value) {
-    bool success = append((uint8_t)value); // used unsigned char version
-    if (success) {
-        _bytesOfValues++;
-        _totalBytesOfValues++;
-    }
-    return success;
+    packOrientationQuatToBytes(destinationBuffer, value);
+    return true;
 }
 
 bool OctreePacketData::appendValue(const QString& string) {
@@ -497,17 +411,23 @@ bool OctreePacketData::appendValue(const QString& string) {
 }
 
 bool OctreePacketData::appendValue(const QUuid& uuid) {
-    QByteArray bytes = uuid.toRfc4122();
     if (uuid.isNull()) {
         return appendValue((uint16_t)0); // zero length for null uuid
-    } else {
-        uint16_t length = bytes.size();
-        bool success = appendValue(length);
-        if (success) {
-            success = appendRawData((const unsigned char*)bytes.constData(), bytes.size());
-        }
-        return success;
     }
+
+    // the RFC 4122 bytes, written in place rather than through a QByteArray
+    uint16_t length = NUM_BYTES_RFC4122_UUID;
+    unsigned char* destinationBuffer = appendSpace(sizeof(length) + length);
+    if (!destinationBuffer) {
+        return false;
+    }
+    memcpy(destinationBuffer, &length, sizeof(length));
+    destinationBuffer += sizeof(length);
+    qToBigEndian(uuid.data1, destinationBuffer);
+    qToBigEndian(uuid.data2, destinationBuffer + 4);
+    qToBigEndian(uuid.data3, destinationBuffer + 6);
+    memcpy(destinationBuffer + 8, uuid.data4, sizeof(uuid.data4));
+    return true;
 }
 
 bool OctreePacketData::appendValue(const QByteArray& bytes) {
@@ -522,41 +442,57 @@ bool OctreePacketData::appendValue(const QByteArray& bytes) {
 
 bool OctreePacketData::appendValue(const AACube& aaCube) {
     aaCubeData cube { aaCube.getCorner(), aaCube.getScale() };
-    const unsigned char* data = (const unsigned char*)&cube;
-    int length = sizeof(aaCubeData);
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfValues += length;
-        _totalBytesOfValues += length;
-    }
-    return success;
+    return appendFixedSize(cube);
 }
 
-bool OctreePacketData::appendPosition(const glm::vec3& value) {
-    const unsigned char* data = (const unsigned char*)&value;
-    int length = sizeof(value);
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfPositions += length;
-        _totalBytesOfPositions += length;
-    }
-    return success;
+bool OctreePacketData::appendRawData(const unsigned char* data, int length) {
+    return append(data, length);
 }
 
-bool OctreePacketData::appendRawData(const unsigned char* data, int length) {
-    bool success = append(data, length);
-    if (success) {
-        _bytesOfRawData += length;
-        _totalBytesOfRawData += length;
-    }
-    return success;
+bool OctreePacketData::appendRawData(const QByteArray& data) {
+    return append((const unsigned char*)data.constData(), data.size());
 }
 
 
-bool OctreePacketData::appendRawData(QByteArray data) {
-    return appendRawData((unsigned char *)data.data(), data.size());
+QMutex OctreePacketData::_compressionDictionariesMutex;
+QHash<QUuid, OctreePacketData::CompressionDictionaries> OctreePacketData::_compressionDictionaries;
+
+void OctreePacketData::setCompressionDictionary(const QUuid& serverID, const QByteArray& dictionary) {
+    QMutexLocker locker(&_compressionDictionariesMutex);
+    CompressionDictionaries& dictionaries = _compressionDictionaries[serverID];
+    quint32 dictionaryID = compressionDictionaryID(dictionary);
+    if (dictionaryID == dictionaries.currentID) {
+        return;
+    }
+    // the server keeps compressing with the old dictionary until our query tells it we have the new one, so keep the
+    // old one around for the content already on its way
+    dictionaries.previousID = dictionaries.currentID;
+    dictionaries.previous = dictionaries.current;
+    dictionaries.currentID = dictionaryID;
+    dictionaries.current = dictionary;
 }
 
+quint32 OctreePacketData::getCompressionDictionaryID(const QUuid& serverID) {
+    QMutexLocker locker(&_compressionDictionariesMutex);
+    auto it = _compressionDictionaries.constFind(serverID);
+    return it != _compressionDictionaries.constEnd() ? it->currentID : 0;
+}
+
+QByteArray OctreePacketData::findCompressionDictionary(quint32 dictionaryID) {
+    QMutexLocker locker(&_compressionDictionariesMutex);
+    for (auto& dictionaries : _compressionDictionaries) {
+        if (dictionaries.currentID == dictionaryID) {
+            // the server has switched to the new dictionary, so it won't send content using the old one again
+            dictionaries.previousID = 0;
+            dictionaries.previous.clear();
+            return dictionaries.current;
+        }
+        if (dictionaries.previousID != 0 && dictionaries.previousID == dictionaryID) {
+            return dictionaries.previous;
+        }
+    }
+    return QByteArray();
+}
 
 AtomicUIntStat OctreePacketData::_compressContentTime { 0 };
 AtomicUIntStat OctreePacketData::_compressContentCalls { 0 };
@@ -578,7 +514,11 @@ bool OctreePacketData::compressContent() {
     const uchar* uncompressedData = &_uncompressed[0];
     int uncompressedSize = _bytesInUse;
 
-    QByteArray compressedData = qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+    QByteArray compressedData;
+    if (!compressWithDictionary(reinterpret_cast<const char*>(uncompressedData), uncompressedSize, _compressionDictionary,
+                                compressedData, MAX_COMPRESSION)) {
+        return false;
+    }
 
     if (compressedData.size() < (int)MAX_OCTREE_PACKET_DATA_SIZE) {
         _compressedBytes = compressedData.size();
@@ -598,14 +538,13 @@ void OctreePacketData::loadFinalizedContent(const unsigned char* data, int lengt
     if (data && length > 0) {
 
         if (_enableCompression) {
-            QByteArray compressedData;
-            for (int i = 0; i < length; i++) {
-                compressedData[i] = data[i];
-                _compressed[i] = compressedData[i];
-            }
+            memcpy(_compressed, data, std::min(length, (int)sizeof(_compressed)));
             _compressedBytes = length;
-            QByteArray uncompressedData = qUncompress(compressedData);
-            if (uncompressedData.size() <= _bytesAvailable) {
+            QByteArray uncompressedData;
+            if (!uncompressWithDictionary(reinterpret_cast<const char*>(data), length, &findCompressionDictionary,
+                                          uncompressedData, (int)MAX_OCTREE_UNCOMRESSED_PACKET_SIZE)) {
+                qCDebug(octree) << "OctreePacketData::loadFinalizedContent()... unable to uncompress" << length << "bytes";
+            } else if (uncompressedData.size() <= _bytesAvailable) {
                 _bytesInUse = uncompressedData.size();
                 _bytesAvailable -= uncompressedData.size();
 
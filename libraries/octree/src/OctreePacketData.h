@@ -23,8 +23,11 @@
 #define hifi_OctreePacketData_h
 
 #include <atomic>
+#include <cstring>
 
 #include <QByteArray>
+#include <QHash>
+#include <QMutex>
 #include <QString>
 #include <QUuid>
 
@@ -86,8 +89,9 @@ public:
     OctreePacketData(bool enableCompression = false, int maxFinalizedSize = MAX_OCTREE_PACKET_DATA_SIZE);
     ~OctreePacketData();
 
-    /// change compression and target size settings
-    void changeSettings(bool enableCompression = false, unsigned int targetSize = MAX_OCTREE_PACKET_DATA_SIZE);
+    /// change compression and target size settings, and optionally the dictionary content is compressed with
+    void changeSettings(bool enableCompression = false, unsigned int targetSize = MAX_OCTREE_PACKET_DATA_SIZE,
+                        const QByteArray& compressionDictionary = QByteArray());
 
     /// reset completely, all data is discarded
     void reset();
@@ -149,22 +153,22 @@ public:
     bool appendValue(const rgbColor& color);
 
     /// appends a unsigned 8 bit int to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendValue(uint8_t value);
+    bool appendValue(uint8_t value) { return appendFixedSize(value); }
 
     /// appends a unsigned 16 bit int to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendValue(uint16_t value);
+    bool appendValue(uint16_t value) { return appendFixedSize(value); }
 
     /// appends a unsigned 32 bit int to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendValue(uint32_t value);
+    bool appendValue(uint32_t value) { return appendFixedSize(value); }
 
     /// appends a unsigned 64 bit int to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendValue(quint64 value);
+    bool appendValue(quint64 value) { return appendFixedSize(value); }
 
     /// appends a float value to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendValue(float value);
+    bool appendValue(float value) { return appendFixedSize(value); }
 
     /// appends a non-position vector to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendValue(const glm::vec3& value);
+    bool appendValue(const glm::vec3& value) { return appendFixedSize(value); }
 
     /// appends a QVector of vec3s to the end of the stream, may fail if new data stream is too long to fit in packet
     bool appendValue(const QVector<glm::vec3>& value);
@@ -182,7 +186,7 @@ public:
     bool appendValue(const glm::quat& value);
 
     /// appends a bool value to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendValue(bool value);
+    bool appendValue(bool value) { return appendFixedSize((uint8_t)value); }
 
     /// appends a string value to the end of the stream, may fail if new data stream is too long to fit in packet
     bool appendValue(const QString& string);
@@ -197,11 +201,11 @@ public:
     bool appendValue(const AACube& aaCube);
 
     /// appends a position to the end of the stream, may fail if new data stream is too long to fit in packet
-    bool appendPosition(const glm::vec3& value);
+    bool appendPosition(const glm::vec3& value) { return appendFixedSize(value); }
 
     /// appends raw bytes, might fail if byte would cause packet to be too large
     bool appendRawData(const unsigned char* data, int length);
-    bool appendRawData(QByteArray data);
+    bool appendRawData(const QByteArray& data);
 
     /// returns a byte offset from beginning of the uncompressed stream based on offset from end.
     /// Positive offsetFromEnd returns that many bytes before the end of uncompressed stream
@@ -241,6 +245,11 @@ public:
     /// displays contents for debugging
     void debugContent();
     
+    /// the compression dictionaries of the servers we receive content from, which compressed content names by ID
+    static void setCompressionDictionary(const QUuid& serverID, const QByteArray& dictionary);
+    static quint32 getCompressionDictionaryID(const QUuid& serverID); /// 0 if we have none from that server
+    static QByteArray findCompressionDictionary(quint32 dictionaryID);
+
     static quint64 getCompressContentTime() { return _compressContentTime; } /// total time spent compressing content
     static quint64 getCompressContentCalls() { return _compressContentCalls; } /// total calls to compress content
     static quint64 getTotalBytesOfOctalCodes() { return _totalBytesOfOctalCodes; }  /// total bytes for octal codes
@@ -269,6 +278,22 @@ public:
     static int unpackDataFromBytes(const unsigned char* dataBytes, AACube& result);
 
 private:
+    /// appends the bytes of a value as they are in memory, might fail if they would cause packet to be too large
+    template <typename T>
+    bool appendFixedSize(const T& value) {
+        if ((int)sizeof(T) > _bytesAvailable) {
+            return false;
+        }
+        memcpy(&_uncompressed[_bytesInUse], &value, sizeof(T));
+        _bytesInUse += sizeof(T);
+        _bytesAvailable -= sizeof(T);
+        _dirty = true;
+        return true;
+    }
+
+    /// makes room for length bytes at the end of the stream and returns where they start, or nullptr if they don't fit
+    unsigned char* appendSpace(int length);
+
     /// appends raw bytes, might fail if byte would cause packet to be too large
     bool append(const unsigned char* data, int length);
     
@@ -277,6 +302,7 @@ private:
 
     unsigned int _targetSize;
     bool _enableCompression;
+    QByteArray _compressionDictionary;
     
     unsigned char _uncompressed[MAX_OCTREE_UNCOMRESSED_PACKET_SIZE];
     int _bytesInUse;
@@ -296,23 +322,26 @@ private:
     int _bytesOfOctalCodes;
     int _bytesOfBitMasks;
     int _bytesOfColor;
-    int _bytesOfValues;
-    int _bytesOfPositions;
-    int _bytesOfRawData;
 
     int _bytesOfOctalCodesCurrentSubTree;
 
     static bool _debug;
 
+    static QMutex _compressionDictionariesMutex;
+    struct CompressionDictionaries {
+        quint32 currentID { 0 };
+        QByteArray current;
+        quint32 previousID { 0 }; // until the server switches to the current one
+        QByteArray previous;
+    };
+    static QHash<QUuid, CompressionDictionaries> _compressionDictionaries; // by server
+
     static AtomicUIntStat _compressContentTime;
     static AtomicUIntStat _compressContentCalls;
 
     static AtomicUIntStat _totalBytesOfOctalCodes;
     static AtomicUIntStat _totalBytesOfBitMasks;
     static AtomicUIntStat _totalBytesOfColor;
-    static AtomicUIntStat _totalBytesOfValues;
-    static AtomicUIntStat _totalBytesOfPositions;
-    static AtomicUIntStat _totalBytesOfRawData;
 };
 
 #endif // hifi_OctreePacketData_h
@@ -14,16 +14,20 @@
 
 #include <cstdio>
 #include <fstream>
+#include <limits>
 #include <time.h>
 
+#include <QDataStream>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QSet>
 
 #include <NumericalConstants.h>
 #include <PerfStat.h>
@@ -33,6 +37,14 @@
 #include "OctreePersistThread.h"
 
 const int OctreePersistThread::DEFAULT_PERSIST_INTERVAL = 1000 * 30; // every 30 seconds
+const int OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL = 1000 * 60 * 10; // every 10 minutes
+
+// each journal record is the magic, the size of the changes that follow, and the changes as a QVariantMap
+const quint32 JOURNAL_RECORD_MAGIC = 0x48464a52; // "HFJR"
+const int JOURNAL_DATA_STREAM_VERSION = QDataStream::Qt_5_6;
+
+// how far each journal record reaches back into the one before, for edits that were stamped as it was written
+const quint64 JOURNAL_OVERLAP_USECS = USECS_PER_SECOND;
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory, int persistInterval,
                                          bool wantBackup, const QJsonObject& settings, bool debugTimestampNow,
@@ -47,7 +59,8 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _wantBackup(wantBackup),
     _debugTimestampNow(debugTimestampNow),
     _lastTimeDebug(0),
-    _persistAsFileType(persistAsFileType)
+    _persistAsFileType(persistAsFileType),
+    _snapshotInterval(DEFAULT_SNAPSHOT_INTERVAL)
 {
     parseSettings(settings);
 
@@ -61,11 +74,24 @@ QString OctreePersistThread::getPersistFileMimeType() const {
         return "application/json";
     } if (_persistAsFileType == "json.gz") {
         return "application/zip";
+    } if (_persistAsFileType == "bin") {
+        return "application/octet-stream";
     }
     return "";
 }
 
 void OctreePersistThread::parseSettings(const QJsonObject& settings) {
+    QJsonValue journalVal = settings["persistJournal"];
+    _wantJournal = journalVal.isString() ? journalVal.toString() == "true" : journalVal.toBool();
+
+    QJsonValue snapshotIntervalVal = settings["persistSnapshotInterval"];
+    int snapshotInterval = snapshotIntervalVal.isString() ? snapshotIntervalVal.toString().toInt()
+                                                          : snapshotIntervalVal.toInt();
+    if (snapshotInterval > 0) {
+        _snapshotInterval = snapshotInterval;
+    }
+    qCDebug(octree) << "persistJournal=" << _wantJournal << "persistSnapshotInterval=" << _snapshotInterval;
+
     if (settings["backups"].isArray()) {
         const QJsonArray& backupRules = settings["backups"].toArray();
         qCDebug(octree) << "BACKUP RULES:";
@@ -139,6 +165,7 @@ bool OctreePersistThread::process() {
         qCDebug(octree) << "loading Octrees from file: " << _filename << "...";
 
         bool persistantFileRead;
+        bool journalRead = false;
 
         _tree->withWriteLock([&] {
             PerformanceWarning warn(true, "Loading Octree File", true);
@@ -161,7 +188,22 @@ bool OctreePersistThread::process() {
                 qCDebug(octree) << "Loading Octree... lock file removed:" << lockFileName;
             }
 
+            // a journal put aside for a persist is older than the file, whether or not it was written
+            QFile::remove(getStaleJournalFilename());
+
+            // the journal has whatever changed since the persist file was last written, so we load the file
+            // without what the journal deletes or replaces, and then add the journal's versions
+            QVariantMap journaledChanges;
+            journalRead = readJournal(journaledChanges);
+            if (journalRead) {
+                _tree->setChangesToReplay(journaledChanges);
+            }
+
             persistantFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
+
+            if (journalRead) {
+                _tree->replayChanges();
+            }
             _tree->pruneTree();
         });
 
@@ -169,7 +211,8 @@ bool OctreePersistThread::process() {
         _loadTimeUSecs = loadDone - loadStarted;
 
         _tree->clearDirtyBit(); // the tree is clean since we just loaded it
-        qCDebug(octree, "DONE loading Octrees from file... fileRead=%s", debug::valueOf(persistantFileRead));
+        qCDebug(octree, "DONE loading Octrees from file... fileRead=%s journalRead=%s",
+                debug::valueOf(persistantFileRead), debug::valueOf(journalRead));
 
         unsigned long nodeCount = OctreeElement::getNodeCount();
         unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
@@ -193,6 +236,16 @@ bool OctreePersistThread::process() {
 
         // Since we just loaded the persistent file, we can consider ourselves as having "just checked" for persistance.
         _lastCheck = usecTimestampNow(); // we just loaded, no need to save again
+        _lastSnapshot = _lastCheck;
+        _lastJournaled = loadDone;
+
+        if (_wantJournal) {
+            // start the tree remembering its deletions for the journal
+            QVariantMap noChanges;
+            _tree->withReadLock([&] {
+                _tree->writeChangesToMap(noChanges, std::numeric_limits<quint64>::max());
+            });
+        }
         
         // This last persist time is not really used until the file is actually persisted. It is only
         // used in formatting the backup filename in cases of non-rolling backup names. However, we don't
@@ -254,6 +307,15 @@ QByteArray OctreePersistThread::getPersistFileContents() const {
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
 
+        if (_wantJournal && usecTimestampNow() - _lastSnapshot < (quint64)_snapshotInterval * USECS_PER_MSEC
+                && !journalOutgrewPersistFile()) {
+            if (appendChangesToJournal()) {
+                return;
+            }
+            qCDebug(octree) << "couldn't journal the Octree's changes, saving all of it instead...";
+        }
+        quint64 snapshotStarted = usecTimestampNow();
+
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
             _tree->pruneTree();
@@ -271,11 +333,28 @@ void OctreePersistThread::persist() {
         if(lockFile.is_open()) {
             qCDebug(octree) << "saving Octree lock file created at:" << lockFileName;
 
+            if (_wantJournal) {
+                // the file will have the deletions so far, and any after this go in the next journal
+                QVariantMap noChanges;
+                _tree->withReadLock([&] {
+                    _tree->writeChangesToMap(noChanges, std::numeric_limits<quint64>::max());
+                });
+            }
+
+            // the file will have everything the journal did, so start it over. It is put aside before the file is
+            // written rather than removed after, so a crash in between can't leave it to be replayed over the file.
+            QFile::remove(getStaleJournalFilename());
+            QFile::rename(getJournalFilename(), getStaleJournalFilename());
+
             _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
             time(&_lastPersistTime);
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE saving Octree to file...";
 
+            QFile::remove(getStaleJournalFilename());
+            _lastSnapshot = snapshotStarted;
+            _lastJournaled = snapshotStarted;
+
             lockFile.close();
             qCDebug(octree) << "saving Octree lock file closed:" << lockFileName;
             remove(qPrintable(lockFileName));
@@ -284,6 +363,109 @@ void OctreePersistThread::persist() {
     }
 }
 
+bool OctreePersistThread::appendChangesToJournal() {
+    QVariantMap changes;
+    bool haveChanges = false;
+    quint64 journalStarted = usecTimestampNow();
+    _tree->withReadLock([&] {
+        quint64 changedSince = _lastJournaled > JOURNAL_OVERLAP_USECS ? _lastJournaled - JOURNAL_OVERLAP_USECS : 0;
+        haveChanges = _tree->writeChangesToMap(changes, changedSince);
+    });
+    if (!haveChanges) {
+        return false;
+    }
+
+    QByteArray record;
+    {
+        QDataStream recordStream(&record, QIODevice::WriteOnly);
+        recordStream.setVersion(JOURNAL_DATA_STREAM_VERSION);
+        recordStream << changes;
+    }
+
+    QFile journal(getJournalFilename());
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(octree) << "Unable to open the Octree journal" << journal.fileName();
+        return false;
+    }
+    QDataStream journalStream(&journal);
+    journalStream.setVersion(JOURNAL_DATA_STREAM_VERSION);
+    journalStream << JOURNAL_RECORD_MAGIC << (quint32)record.size();
+    journalStream.writeRawData(record.constData(), record.size());
+    if (journalStream.status() != QDataStream::Ok || !journal.flush()) {
+        qCWarning(octree) << "Unable to write to the Octree journal" << journal.fileName();
+        return false;
+    }
+
+    _lastJournaled = journalStarted;
+    _tree->clearDirtyBit(); // tree is clean after journaling its changes
+    qCDebug(octree) << "DONE journaling Octree changes..." << changes["Entities"].toList().size() << "changed,"
+        << changes["Deleted"].toList().size() << "deleted";
+    return true;
+}
+
+bool OctreePersistThread::readJournal(QVariantMap& changes) {
+    QFile journal(getJournalFilename());
+    if (!journal.exists() || !journal.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream journalStream(&journal);
+    journalStream.setVersion(JOURNAL_DATA_STREAM_VERSION);
+
+    // merge the records, later ones winning, into what changed since the persist file was written
+    QVariantMap changedByID;
+    QSet<QString> deletedIDs;
+    int numRecords = 0;
+    while (!journalStream.atEnd()) {
+        quint32 magic = 0;
+        quint32 size = 0;
+        journalStream >> magic >> size;
+        if (journalStream.status() != QDataStream::Ok || magic != JOURNAL_RECORD_MAGIC
+                || size > journal.size() - journal.pos()) {
+            // the last record was cut short, by a crash while it was written
+            qCWarning(octree) << "Ignoring an incomplete record at the end of the Octree journal" << journal.fileName();
+            break;
+        }
+        QByteArray record(size, 0);
+        journalStream.readRawData(record.data(), size);
+
+        QDataStream recordStream(record);
+        recordStream.setVersion(JOURNAL_DATA_STREAM_VERSION);
+        QVariantMap recordChanges;
+        recordStream >> recordChanges;
+        if (recordStream.status() != QDataStream::Ok) {
+            qCWarning(octree) << "Ignoring a bad record at the end of the Octree journal" << journal.fileName();
+            break;
+        }
+
+        foreach (const QVariant& deletedID, recordChanges["Deleted"].toList()) {
+            changedByID.remove(deletedID.toString());
+            deletedIDs.insert(deletedID.toString());
+        }
+        foreach (const QVariant& changed, recordChanges["Entities"].toList()) {
+            QString changedID = changed.toMap()["id"].toString();
+            deletedIDs.remove(changedID);
+            changedByID[changedID] = changed;
+        }
+        numRecords++;
+    }
+
+    QVariantList deleted;
+    foreach (const QString& deletedID, deletedIDs) {
+        deleted << deletedID;
+    }
+    changes["Entities"] = changedByID.values();
+    changes["Deleted"] = deleted;
+
+    qCDebug(octree) << "Read" << numRecords << "records from the Octree journal:" << changedByID.size() << "changed,"
+        << deletedIDs.size() << "deleted";
+    return numRecords > 0;
+}
+
+bool OctreePersistThread::journalOutgrewPersistFile() const {
+    // past this, replaying the journal on load costs more than the full persist we're putting off
+    return QFileInfo(getJournalFilename()).size() > QFileInfo(_filename).size();
+}
+
 void OctreePersistThread::restoreFromMostRecentBackup() {
     qCDebug(octree) << "Restoring from most recent backup...";
     
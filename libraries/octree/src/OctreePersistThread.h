@@ -32,6 +32,7 @@ public:
     };
 
     static const int DEFAULT_PERSIST_INTERVAL;
+    static const int DEFAULT_SNAPSHOT_INTERVAL;
 
     OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory,
                         int persistInterval = DEFAULT_PERSIST_INTERVAL, bool wantBackup = false,
@@ -54,6 +55,11 @@ protected:
     virtual bool process() override;
 
     void persist();
+    bool appendChangesToJournal();
+    bool readJournal(QVariantMap& changes);
+    bool journalOutgrewPersistFile() const;
+    QString getJournalFilename() const { return _filename + ".journal"; }
+    QString getStaleJournalFilename() const { return _filename + ".journal.stale"; }
     void backup();
     void rollOldBackupVersions(const BackupRule& rule);
     void restoreFromMostRecentBackup();
@@ -79,6 +85,13 @@ private:
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
+
+    // with a journal, persists append the tree's changes to it, and only every snapshot interval (or once the
+    // journal is bigger than the persist file) is the whole tree written and the journal started over
+    bool _wantJournal { false };
+    int _snapshotInterval;
+    quint64 _lastSnapshot { 0 };
+    quint64 _lastJournaled { 0 };
 };
 
 #endif // hifi_OctreePersistThread_h
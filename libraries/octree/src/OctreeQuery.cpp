@@ -59,6 +59,9 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
 
     memcpy(destinationBuffer, &_cameraCenterRadius, sizeof(_cameraCenterRadius));
     destinationBuffer += sizeof(_cameraCenterRadius);
+
+    memcpy(destinationBuffer, &_compressionDictionaryID, sizeof(_compressionDictionaryID));
+    destinationBuffer += sizeof(_compressionDictionaryID);
     
     // create a QByteArray that holds the binary representation of the JSON parameters
     QByteArray binaryParametersDocument;
@@ -119,6 +122,9 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
     
     memcpy(&_cameraCenterRadius, sourceBuffer, sizeof(_cameraCenterRadius));
     sourceBuffer += sizeof(_cameraCenterRadius);
+
+    memcpy(&_compressionDictionaryID, sourceBuffer, sizeof(_compressionDictionaryID));
+    sourceBuffer += sizeof(_compressionDictionaryID);
     
     // check if we have a packed JSON filter
     uint16_t binaryParametersBytes;
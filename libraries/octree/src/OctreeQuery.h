@@ -82,6 +82,10 @@ public:
     bool getUsesFrustum() { return _usesFrustum; }
     void setUsesFrustum(bool usesFrustum) { _usesFrustum = usesFrustum; }
 
+    // the ID of the server's compression dictionary we have, 0 for none
+    quint32 getCompressionDictionaryID() const { return _compressionDictionaryID; }
+    void setCompressionDictionaryID(quint32 dictionaryID) { _compressionDictionaryID = dictionaryID; }
+
 public slots:
     void setMaxQueryPacketsPerSecond(int maxQueryPPS) { _maxQueryPPS = maxQueryPPS; }
     void setOctreeSizeScale(float octreeSizeScale) { _octreeElementSizeScale = octreeSizeScale; }
@@ -104,6 +108,7 @@ protected:
     int _boundaryLevelAdjust = 0; /// used for LOD calculations
     
     uint8_t _usesFrustum = true;
+    quint32 _compressionDictionaryID { 0 };
     
     QJsonObject _jsonParameters;
     QReadWriteLock _jsonParametersLock;
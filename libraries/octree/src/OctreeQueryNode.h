@@ -106,6 +106,16 @@ public:
     bool shouldForceFullScene() const { return _shouldForceFullScene; }
     void setShouldForceFullScene(bool shouldForceFullScene) { _shouldForceFullScene = shouldForceFullScene; }
 
+    // call only from OctreeSendThread for the given node - the compression dictionary we last sent the node, which we
+    // compress its packets with once its query says it has it
+    quint32 getSentCompressionDictionaryID() const { return _sentCompressionDictionaryID; }
+    void setSentCompressionDictionary(quint32 dictionaryID, const QByteArray& dictionary)
+        { _sentCompressionDictionaryID = dictionaryID; _sentCompressionDictionary = dictionary; }
+    QByteArray getCompressionDictionary() const {
+        return _sentCompressionDictionaryID != 0 && _sentCompressionDictionaryID == getCompressionDictionaryID() ?
+            _sentCompressionDictionary : QByteArray();
+    }
+
 private:
     OctreeQueryNode(const OctreeQueryNode &);
     OctreeQueryNode& operator= (const OctreeQueryNode&);
@@ -153,6 +163,9 @@ private:
     QJsonObject _lastCheckJSONParameters;
 
     bool _shouldForceFullScene { false };
+
+    quint32 _sentCompressionDictionaryID { 0 };
+    QByteArray _sentCompressionDictionary;
 };
 
 #endif // hifi_OctreeQueryNode_h
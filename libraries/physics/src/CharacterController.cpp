@@ -176,12 +176,24 @@ void CharacterController::preStep(btCollisionWorld* collisionWorld) {
     btScalar rayLength = _radius + FLOOR_PROXIMITY_THRESHOLD;
     btVector3 rayEnd = rayStart - rayLength * _currentUp;
 
-    // scan down for nearby floor
-    ClosestNotMe rayCallback(_rigidBody);
-    rayCallback.m_closestHitFraction = 1.0f;
-    collisionWorld->rayTest(rayStart, rayEnd, rayCallback);
-    if (rayCallback.hasHit()) {
-        _floorDistance = rayLength * rayCallback.m_closestHitFraction - _radius;
+    // an avatar at rest casts the same ray every substep: reuse the last one when the start barely moved
+    const btScalar FLOOR_RAY_REUSE_DISTANCE = 0.005f; // meters
+    if (_hasFloorRay && (rayStart - _floorRayStart).length2() < FLOOR_RAY_REUSE_DISTANCE * FLOOR_RAY_REUSE_DISTANCE) {
+        if (_floorRayHit) {
+            _floorDistance = _floorRayDistance + (rayStart - _floorRayStart).dot(_currentUp);
+        }
+    } else {
+        // scan down for nearby floor
+        ClosestNotMe rayCallback(_rigidBody);
+        rayCallback.m_closestHitFraction = 1.0f;
+        collisionWorld->rayTest(rayStart, rayEnd, rayCallback);
+        _floorRayHit = rayCallback.hasHit();
+        if (_floorRayHit) {
+            _floorDistance = rayLength * rayCallback.m_closestHitFraction - _radius;
+        }
+        _floorRayStart = rayStart;
+        _floorRayDistance = _floorDistance;
+        _hasFloorRay = true;
     }
 
     _hasSupport = checkForSupport(collisionWorld);
@@ -524,6 +536,8 @@ void CharacterController::computeNewVelocity(btScalar dt, glm::vec3& velocity) {
 }
 
 void CharacterController::preSimulation() {
+    // the floor may have moved since the last step
+    _hasFloorRay = false;
     if (_enabled && _dynamicsWorld && _rigidBody) {
         quint64 now = usecTimestampNow();
 
@@ -161,6 +161,12 @@ protected:
     btScalar _floorDistance;
     bool _hasSupport;
 
+    // the floor ray of the last substep, reused by the substeps of the same step that barely moved
+    btVector3 _floorRayStart;
+    btScalar _floorRayDistance;
+    bool _hasFloorRay { false };
+    bool _floorRayHit { false };
+
     btScalar _gravity;
 
     btScalar _jumpSpeed;
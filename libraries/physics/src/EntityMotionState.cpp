@@ -13,7 +13,6 @@
 
 #include <EntityItem.h>
 #include <EntityItemProperties.h>
-#include <EntityEditPacketSender.h>
 #include <PhysicsCollisionGroups.h>
 #include <LogHandler.h>
 
@@ -502,7 +501,7 @@ bool EntityMotionState::shouldSendUpdate(uint32_t simulationStep) {
     return remoteSimulationOutOfSync(simulationStep);
 }
 
-void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step) {
+void EntityMotionState::sendUpdate(std::vector<std::pair<EntityItemID, EntityItemProperties>>& edits, uint32_t step) {
     assert(_entity);
     assert(entityTreeIsLocked());
 
@@ -614,18 +613,14 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     }
 
     EntityItemID id(_entity->getID());
-    EntityEditPacketSender* entityPacketSender = static_cast<EntityEditPacketSender*>(packetSender);
     #ifdef WANT_DEBUG
-        qCDebug(physics) << "EntityMotionState::sendUpdate()... calling queueEditEntityMessage()...";
+        qCDebug(physics) << "EntityMotionState::sendUpdate()... adding edit...";
     #endif
 
-    EntityTreeElementPointer element = _entity->getElement();
-    EntityTreePointer tree = element ? element->getTree() : nullptr;
-
     properties.setClientOnly(_entity->getClientOnly());
     properties.setOwningAvatarID(_entity->getOwningAvatarID());
 
-    entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree, id, properties);
+    edits.emplace_back(id, properties);
     _entity->setLastBroadcast(now);
 
     // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
@@ -641,8 +636,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
                 newQueryCubeProperties.setClientOnly(entityDescendant->getClientOnly());
                 newQueryCubeProperties.setOwningAvatarID(entityDescendant->getOwningAvatarID());
 
-                entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree,
-                                                           descendant->getID(), newQueryCubeProperties);
+                edits.emplace_back(descendant->getID(), newQueryCubeProperties);
                 entityDescendant->setLastBroadcast(now);
             }
         }
@@ -12,7 +12,11 @@
 #ifndef hifi_EntityMotionState_h
 #define hifi_EntityMotionState_h
 
+#include <vector>
+
 #include <EntityTypes.h>
+#include <EntityItemID.h>
+#include <EntityItemProperties.h>
 #include <AACube.h>
 
 #include "ObjectMotionState.h"
@@ -47,7 +51,8 @@ public:
     bool isCandidateForOwnership() const;
     bool remoteSimulationOutOfSync(uint32_t simulationStep);
     bool shouldSendUpdate(uint32_t simulationStep);
-    void sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step);
+    // appends the update to the edits, so that those of all the objects updated in a step are queued together
+    void sendUpdate(std::vector<std::pair<EntityItemID, EntityItemProperties>>& edits, uint32_t step);
 
     virtual uint32_t getIncomingDirtyFlags() override;
     virtual void clearIncomingDirtyFlags() override;
@@ -11,6 +11,10 @@
 
 
 
+#include <EntityEditPacketSender.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
 #include "ShapeManager.h"
@@ -61,6 +65,8 @@ void PhysicalEntitySimulation::removeEntityInternal(EntityItemPointer entity) {
         EntitySimulation::removeEntityInternal(entity);
         QMutexLocker lock(&_mutex);
         _entitiesToAddToPhysics.remove(entity);
+        _shapeInfosBuilding.remove(entity);
+        _entitiesOutOfScope.remove(entity);
 
         EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
         if (motionState) {
@@ -110,6 +116,7 @@ void PhysicalEntitySimulation::changeEntityInternal(EntityItemPointer entity) {
         // The intent is for this object to be in the PhysicsEngine, but it has no MotionState yet.
         // Perhaps it's shape has changed and it can now be added?
         _entitiesToAddToPhysics.insert(entity);
+        _shapeInfosBuilding.remove(entity); // its shape may have changed since
         _simpleKinematicEntities.remove(entity); // just in case it's non-physical-kinematic
     } else if (entity->isMovingRelativeToParent()) {
         _simpleKinematicEntities.insert(entity);
@@ -148,6 +155,8 @@ void PhysicalEntitySimulation::clearEntitiesInternal() {
     _entitiesToRemoveFromPhysics.clear();
     _entitiesToRelease.clear();
     _entitiesToAddToPhysics.clear();
+    _shapeInfosBuilding.clear();
+    _entitiesOutOfScope.clear();
     _pendingChanges.clear();
     _outgoingChanges.clear();
 }
@@ -161,9 +170,46 @@ void PhysicalEntitySimulation::prepareEntityForDelete(EntityItemPointer entity)
 }
 // end EntitySimulation overrides
 
+void PhysicalEntitySimulation::setPhysicsScope(const glm::vec3& center, float radius) {
+    QMutexLocker lock(&_mutex);
+    _physicsScopeCenter = center;
+    _physicsScopeRadius = radius;
+}
+
+bool PhysicalEntitySimulation::isInPhysicsScope(const EntityItemPointer& entity, float radius) const {
+    if (_physicsScopeRadius <= 0.0f) {
+        return true;
+    }
+    bool success;
+    AACube queryCube = entity->getQueryAACube(success);
+    return !success || queryCube.touchesSphere(_physicsScopeCenter, radius);
+}
+
+void PhysicalEntitySimulation::removeObjectsOutOfScope() {
+    const quint64 PHYSICS_SCOPE_CHECK_INTERVAL = USECS_PER_SECOND / 2;
+    quint64 now = usecTimestampNow();
+    if (_physicsScopeRadius <= 0.0f || now < _nextPhysicsScopeCheck) {
+        return;
+    }
+    _nextPhysicsScopeCheck = now + PHYSICS_SCOPE_CHECK_INTERVAL;
+
+    // what we simulate, or bid for, stays in physics wherever it goes
+    const float PHYSICS_SCOPE_HYSTERESIS = 1.25f;
+    for (auto stateItr : _physicalObjects) {
+        EntityMotionState* motionState = static_cast<EntityMotionState*>(&(*stateItr));
+        EntityItemPointer entity = motionState->getEntity();
+        if (entity && !motionState->isCandidateForOwnership() && !entity->hasActions() &&
+                !isInPhysicsScope(entity, PHYSICS_SCOPE_HYSTERESIS * _physicsScopeRadius)) {
+            _entitiesToRemoveFromPhysics.insert(entity);
+            _entitiesOutOfScope.insert(entity);
+        }
+    }
+}
+
 void PhysicalEntitySimulation::getObjectsToRemoveFromPhysics(VectorOfMotionStates& result) {
     result.clear();
     QMutexLocker lock(&_mutex);
+    removeObjectsOutOfScope();
     for (auto entity: _entitiesToRemoveFromPhysics) {
         // make sure it isn't on any side lists
         _entitiesToAddToPhysics.remove(entity);
@@ -192,8 +238,11 @@ void PhysicalEntitySimulation::deleteObjectsRemovedFromPhysics() {
         entity->setPhysicsInfo(nullptr);
         delete motionState;
 
+        bool wasOutOfScope = _entitiesOutOfScope.remove(entity);
         if (entity->isDead()) {
             _entitiesToDelete.insert(entity);
+        } else if (wasOutOfScope) {
+            _entitiesToAddToPhysics.insert(entity);
         }
     }
     _entitiesToRelease.clear();
@@ -212,21 +261,39 @@ void PhysicalEntitySimulation::getObjectsToAddToPhysics(VectorOfMotionStates& re
         } else if (!entity->shouldBePhysical()) {
             // this entity should no longer be on the internal _entitiesToAddToPhysics
             entityItr = _entitiesToAddToPhysics.erase(entityItr);
+            _shapeInfosBuilding.remove(entity);
             if (entity->isMovingRelativeToParent()) {
                 _simpleKinematicEntities.insert(entity);
             }
+        } else if (!isInPhysicsScope(entity, _physicsScopeRadius)) {
+            // it waits on the list until it comes in scope
+            ++entityItr;
         } else if (entity->isReadyToComputeShape()) {
+            // an entity waits for its shape to build with the info it was started from, rather than compute it again
             ShapeInfo shapeInfo;
-            entity->computeShapeInfo(shapeInfo);
-            int numPoints = shapeInfo.getLargestSubshapePointCount();
-            if (shapeInfo.getType() == SHAPE_TYPE_COMPOUND) {
-                if (numPoints > MAX_HULL_POINTS) {
-                    qWarning() << "convex hull with" << numPoints
-                        << "points for entity" << entity->getName()
-                        << "at" << entity->getPosition() << " will be reduced";
+            auto shapeInfoItr = _shapeInfosBuilding.find(entity);
+            if (shapeInfoItr != _shapeInfosBuilding.end()) {
+                shapeInfo = shapeInfoItr.value();
+            } else {
+                entity->computeShapeInfo(shapeInfo);
+                int numPoints = shapeInfo.getLargestSubshapePointCount();
+                if (shapeInfo.getType() == SHAPE_TYPE_COMPOUND) {
+                    if (numPoints > MAX_HULL_POINTS) {
+                        qWarning() << "convex hull with" << numPoints
+                            << "points for entity" << entity->getName()
+                            << "at" << entity->getPosition() << " will be reduced";
+                    }
                 }
             }
-            btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+            bool isBuilding = false;
+            btCollisionShape* shape = const_cast<btCollisionShape*>(
+                ObjectMotionState::getShapeManager()->getShapeWhenBuilt(shapeInfo, isBuilding));
+            if (isBuilding) {
+                _shapeInfosBuilding.insert(entity, shapeInfo);
+                ++entityItr;
+                continue;
+            }
+            _shapeInfosBuilding.remove(entity);
             if (shape) {
                 EntityMotionState* motionState = new EntityMotionState(shape, entity);
                 entity->setPhysicsInfo(static_cast<void*>(motionState));
@@ -301,7 +368,8 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
             return;
         }
 
-        // look for entities to prune or update
+        // look for entities to prune or update, the updates are queued together after
+        std::vector<std::pair<EntityItemID, EntityItemProperties>> edits;
         QSet<EntityMotionState*>::iterator stateItr = _outgoingChanges.begin();
         while (stateItr != _outgoingChanges.end()) {
             EntityMotionState* state = *stateItr;
@@ -310,12 +378,15 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
                 stateItr = _outgoingChanges.erase(stateItr);
             } else if (state->shouldSendUpdate(numSubsteps)) {
                 // update
-                state->sendUpdate(_entityPacketSender, numSubsteps);
+                state->sendUpdate(edits, numSubsteps);
                 ++stateItr;
             } else {
                 ++stateItr;
             }
         }
+        if (!edits.empty()) {
+            _entityPacketSender->queueEditEntityMessages(PacketType::EntityPhysics, getEntityTree(), edits);
+        }
     }
 }
 
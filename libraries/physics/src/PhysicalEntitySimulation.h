@@ -27,6 +27,8 @@ class PhysicalEntitySimulation;
 using PhysicalEntitySimulationPointer = std::shared_ptr<PhysicalEntitySimulation>;
 using SetOfEntityMotionStates = QSet<EntityMotionState*>;
 
+const float DEFAULT_PHYSICS_SCOPE_RADIUS = 100.0f; // meters
+
 class PhysicalEntitySimulation : public EntitySimulation {
 public:
     PhysicalEntitySimulation();
@@ -56,6 +58,10 @@ public:
     void setObjectsToChange(const VectorOfMotionStates& objectsToChange);
     void getObjectsToChange(VectorOfMotionStates& result);
 
+    // Entities are only added to physics while they touch the sphere of the scope, and are taken out again
+    // once they are further than the hysteresis, unless they are ours to simulate.  A radius of zero is unlimited.
+    void setPhysicsScope(const glm::vec3& center, float radius);
+
     void handleDeactivatedMotionStates(const VectorOfMotionStates& motionStates);
     void handleChangedMotionStates(const VectorOfMotionStates& motionStates);
     void handleCollisionEvents(const CollisionEvents& collisionEvents);
@@ -66,6 +72,8 @@ private:
     SetOfEntities _entitiesToRemoveFromPhysics;
     SetOfEntities _entitiesToRelease;
     SetOfEntities _entitiesToAddToPhysics;
+    QHash<EntityItemPointer, ShapeInfo> _shapeInfosBuilding; // of the entities to add waiting for their shapes to build
+    SetOfEntities _entitiesOutOfScope; // removed from physics to be added again once back in scope
 
     SetOfEntityMotionStates _pendingChanges; // EntityMotionStates already in PhysicsEngine that need their physics changed
     SetOfEntityMotionStates _outgoingChanges; // EntityMotionStates for which we may need to send updates to entity-server
@@ -76,6 +84,13 @@ private:
     EntityEditPacketSender* _entityPacketSender = nullptr;
 
     uint32_t _lastStepSendPackets { 0 };
+
+    bool isInPhysicsScope(const EntityItemPointer& entity, float radius) const;
+    void removeObjectsOutOfScope();
+
+    glm::vec3 _physicsScopeCenter;
+    float _physicsScopeRadius { 0.0f };
+    quint64 _nextPhysicsScopeCheck { 0 };
 };
 
 
@@ -9,9 +9,12 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <PhysicsCollisionGroups.h>
 
 #include <PerfStat.h>
+#include <SharedUtil.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
@@ -261,6 +264,7 @@ void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
 void PhysicsEngine::stepSimulation() {
     CProfileManager::Reset();
     BT_PROFILE("stepSimulation");
+    quint64 startTime = usecTimestampNow();
     // NOTE: the grand order of operations is:
     // (1) pull incoming changes
     // (2) step simulation
@@ -296,7 +300,15 @@ void PhysicsEngine::stepSimulation() {
         this->updateContactMap();
     };
 
-    int numSubsteps = _dynamicsWorld->stepSimulationWithSubstepCallback(timeStep, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
+    // the substeps of a slow step would make the next step slower still: the substeps beyond what the budget
+    // affords at the recent cost of a substep are dropped, and the simulation loses that time instead
+    int maxSubsteps = PHYSICS_ENGINE_MAX_NUM_SUBSTEPS;
+    if (_substepTime > 0.0f) {
+        int affordedSubsteps = (int)((float)PHYSICS_ENGINE_STEP_BUDGET / _substepTime);
+        maxSubsteps = glm::clamp(affordedSubsteps, 1, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS);
+    }
+
+    int numSubsteps = _dynamicsWorld->stepSimulationWithSubstepCallback(timeStep, maxSubsteps,
                                                                         PHYSICS_ENGINE_FIXED_SUBSTEP, onSubStep);
     if (numSubsteps > 0) {
         BT_PROFILE("postSimulation");
@@ -309,6 +321,39 @@ void PhysicsEngine::stepSimulation() {
 
         _hasOutgoingChanges = true;
     }
+    int numSimulatedSubsteps = std::min(numSubsteps, maxSubsteps);
+    updateStepStats(numSimulatedSubsteps);
+    _stats.stepTime = usecTimestampNow() - startTime;
+    if (numSimulatedSubsteps > 0) {
+        const float SUBSTEP_TIME_BLEND = 0.25f; // weight of the newest cost
+        float substepTime = (float)_stats.stepTime / (float)numSimulatedSubsteps;
+        _substepTime = (_substepTime > 0.0f) ? glm::mix(_substepTime, substepTime, SUBSTEP_TIME_BLEND) : substepTime;
+    }
+}
+
+void PhysicsEngine::updateStepStats(int numSubsteps) {
+    _stats.numSubsteps = (uint32_t)numSubsteps;
+    _stats.numSolverIterations = (uint32_t)(numSubsteps * _dynamicsWorld->getSolverInfo().m_numIterations);
+    _stats.numOverlappingPairs = (uint32_t)_dynamicsWorld->getPairCache()->getNumOverlappingPairs();
+    _stats.numBodies = (uint32_t)_dynamicsWorld->getNumCollisionObjects();
+
+    uint32_t numContacts = 0;
+    int numManifolds = _collisionDispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; ++i) {
+        numContacts += (uint32_t)_collisionDispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+    }
+    _stats.numContacts = numContacts;
+
+    // the islands of the active bodies are told apart by their tags
+    _islandTags.clear();
+    const btCollisionObjectArray& objects = _dynamicsWorld->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        if (objects[i]->isActive() && !objects[i]->isStaticObject()) {
+            _islandTags.push_back(objects[i]->getIslandTag());
+        }
+    }
+    std::sort(_islandTags.begin(), _islandTags.end());
+    _stats.numIslands = (uint32_t)(std::unique(_islandTags.begin(), _islandTags.end()) - _islandTags.begin());
 }
 
 void PhysicsEngine::harvestPerformanceStats() {
@@ -480,9 +525,21 @@ const VectorOfMotionStates& PhysicsEngine::getChangedMotionStates() {
         _activeStaticBodies[i]->forceActivationState(ISLAND_SLEEPING);
     }
     _activeStaticBodies.clear();
+    quint64 startTime = usecTimestampNow();
     _dynamicsWorld->synchronizeMotionStates();
+    _stats.synchronizeTime = usecTimestampNow() - startTime;
     _hasOutgoingChanges = false;
-    return _dynamicsWorld->getChangedMotionStates();
+
+    const VectorOfMotionStates& changedMotionStates = _dynamicsWorld->getChangedMotionStates();
+    uint32_t numOwnedBodies = 0;
+    for (auto motionState : changedMotionStates) {
+        if (motionState->getSimulatorID() == Physics::getSessionUUID()) {
+            ++numOwnedBodies;
+        }
+    }
+    _stats.numActiveBodies = (uint32_t)changedMotionStates.size();
+    _stats.numOwnedBodies = numOwnedBodies;
+    return changedMotionStates;
 }
 
 void PhysicsEngine::dumpStatsIfNecessary() {
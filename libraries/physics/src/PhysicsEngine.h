@@ -43,6 +43,21 @@ public:
 typedef std::map<ContactKey, ContactInfo> ContactMap;
 typedef std::vector<Collision> CollisionEvents;
 
+// counters of the last step, gathered always and cheaply, unlike the timings of Bullet's profiler
+class PhysicsStats {
+public:
+    uint64_t stepTime { 0 }; // usec
+    uint64_t synchronizeTime { 0 }; // usec spent synchronizing the motion states after the step
+    uint32_t numSubsteps { 0 }; // simulated, those dropped over budget aren't counted
+    uint32_t numSolverIterations { 0 };
+    uint32_t numOverlappingPairs { 0 }; // found by the broadphase
+    uint32_t numContacts { 0 }; // found by the narrowphase
+    uint32_t numIslands { 0 }; // of active bodies
+    uint32_t numBodies { 0 };
+    uint32_t numActiveBodies { 0 };
+    uint32_t numOwnedBodies { 0 }; // active bodies we simulate
+};
+
 class PhysicsEngine {
 public:
     PhysicsEngine(const glm::vec3& offset);
@@ -71,6 +86,9 @@ public:
     /// \return reference to list of Collision events.  The list is only valid until beginning of next simulation loop.
     const CollisionEvents& getCollisionEvents();
 
+    /// \return counters of the last step, valid once its changed MotionStates were gotten
+    const PhysicsStats& getStats() const { return _stats; }
+
     /// \brief prints timings for last frame if stats have been requested.
     void dumpStatsIfNecessary();
 
@@ -99,6 +117,7 @@ private:
     void removeContacts(ObjectMotionState* motionState);
 
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
+    void updateStepStats(int numSubsteps);
 
     btClock _clock;
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
@@ -110,6 +129,8 @@ private:
 
     ContactMap _contactMap;
     CollisionEvents _collisionEvents;
+    PhysicsStats _stats;
+    std::vector<int> _islandTags;
     QHash<QUuid, EntityActionPointer> _objectActions;
     std::vector<btRigidBody*> _activeStaticBodies;
 
@@ -119,6 +140,7 @@ private:
 
     uint32_t _numContactFrames = 0;
     uint32_t _numSubsteps;
+    float _substepTime { 0.0f }; // usec, recent average cost of a substep
 
     bool _dumpNextStats = false;
     bool _hasOutgoingChanges = false;
@@ -0,0 +1,63 @@
+//
+//  PhysicsThread.cpp
+//  libraries/physics/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsThread.h"
+
+#include <assert.h>
+
+void PhysicsThread::beginStep(Step step) {
+    if (!isThreaded()) {
+        step();
+        return;
+    }
+
+    lock();
+    assert(!_isStepping);
+    _step = step;
+    _isStepping = true;
+    unlock();
+    _stepBegun.wakeAll();
+}
+
+void PhysicsThread::waitForStep() {
+    lock();
+    while (_isStepping) {
+        _stepDone.wait(&_mutex);
+    }
+    unlock();
+}
+
+bool PhysicsThread::process() {
+    lock();
+    while (!_step && isStillRunning()) {
+        _stepBegun.wait(&_mutex);
+    }
+    Step step;
+    step.swap(_step);
+    unlock();
+
+    if (step) {
+        step();
+    }
+
+    lock();
+    _isStepping = false;
+    unlock();
+    _stepDone.wakeAll();
+
+    return isStillRunning();
+}
+
+void PhysicsThread::terminating() {
+    // the thread is either yet to see it's stopping or already waiting, never in between
+    lock();
+    unlock();
+    _stepBegun.wakeAll();
+}
@@ -0,0 +1,42 @@
+//
+//  PhysicsThread.h
+//  libraries/physics/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsThread_h
+#define hifi_PhysicsThread_h
+
+#include <functional>
+
+#include <QWaitCondition>
+
+#include <GenericThread.h>
+
+/// Steps the simulation on a thread of its own, while its caller carries on with work that touches neither the
+/// PhysicsEngine nor the objects in it.  The caller must wait for the step before touching them again.
+class PhysicsThread : public GenericThread {
+public:
+    using Step = std::function<void()>;
+
+    /// Starts the step on the thread, or runs it before returning when not threaded.
+    void beginStep(Step step);
+
+    /// Blocks until the step begun last is done.
+    void waitForStep();
+
+    virtual bool process() override;
+    virtual void terminating() override;
+
+private:
+    QWaitCondition _stepBegun;
+    QWaitCondition _stepDone;
+    Step _step;
+    bool _isStepping { false };
+};
+
+#endif // hifi_PhysicsThread_h
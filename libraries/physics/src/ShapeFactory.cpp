@@ -11,6 +11,8 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "ShapeFactory.h"
@@ -392,6 +394,22 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
     return shape;
 }
 
+const btCollisionShape* ShapeFactory::createMeshInstance(const btCollisionShape* unitMesh, const glm::vec3& scale,
+        const glm::vec3& offset) {
+    assert(unitMesh && unitMesh->getShapeType() == (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    btBvhTriangleMeshShape* mesh = static_cast<btBvhTriangleMeshShape*>(const_cast<btCollisionShape*>(unitMesh));
+    btCollisionShape* shape = new btScaledBvhTriangleMeshShape(mesh, glmToBullet(scale));
+    if (glm::length2(offset) > MIN_SHAPE_OFFSET * MIN_SHAPE_OFFSET) {
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(glmToBullet(offset));
+        auto compound = new btCompoundShape();
+        compound->addChildShape(transform, shape);
+        shape = compound;
+    }
+    return shape;
+}
+
 void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     assert(shape);
     // ShapeFactory is responsible for deleting all shapes, even the const ones that are stored
@@ -23,6 +23,11 @@ namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // an instance of the unitMesh (a StaticMeshShape) scaled then offset, which shares the unitMesh's triangles
+    // and BVH: the unitMesh must outlive the instance, which doesn't delete it
+    const btCollisionShape* createMeshInstance(const btCollisionShape* unitMesh, const glm::vec3& scale,
+            const glm::vec3& offset);
+
     //btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info);
     //void deleteStaticMeshArray(btTriangleIndexVertexArray* dataArray);
 
@@ -9,17 +9,85 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <glm/gtx/norm.hpp>
 
 #include "ShapeFactory.h"
 #include "ShapeManager.h"
 
+// Static meshes of the same model differ only by the scale and offset of their entities: each is an instance
+// that shares the triangles and BVH of one mesh of the model fit to a unit cube, which is built once.
+static bool isMeshInstance(const ShapeInfo& info) {
+    return info.getType() == SHAPE_TYPE_STATIC_MESH && !info.getURL().isEmpty();
+}
+
+static void computeMeshBounds(const ShapeInfo& info, glm::vec3& center, glm::vec3& halfSize) {
+    center = glm::vec3(0.0f);
+    halfSize = glm::vec3(1.0f);
+    const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
+    if (pointCollection.size() == 0 || pointCollection[0].size() == 0) {
+        return;
+    }
+    const ShapeInfo::PointList& points = pointCollection[0];
+    glm::vec3 minCorner = points[0];
+    glm::vec3 maxCorner = points[0];
+    for (const auto& point : points) {
+        minCorner = glm::min(minCorner, point);
+        maxCorner = glm::max(maxCorner, point);
+    }
+    center = 0.5f * (maxCorner + minCorner);
+    halfSize = 0.5f * (maxCorner - minCorner);
+    const float MIN_HALF_SIZE = 1.0e-4f;
+    for (int i = 0; i < 3; ++i) {
+        // a flat mesh stays flat in the unit mesh
+        if (halfSize[i] < MIN_HALF_SIZE) {
+            halfSize[i] = 1.0f;
+        }
+    }
+}
+
+// the params of the unit mesh hash apart from those of any instance, whose halfExtents are never zero
+static ShapeInfo getUnitMeshParams(const ShapeInfo& info) {
+    ShapeInfo unitInfo;
+    unitInfo.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.0f), info.getURL().toString());
+    return unitInfo;
+}
+
+static ShapeInfo getUnitMeshInfo(const ShapeInfo& info) {
+    glm::vec3 center, halfSize;
+    computeMeshBounds(info, center, halfSize);
+    ShapeInfo::PointList unitPoints;
+    const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
+    if (pointCollection.size() > 0) {
+        for (const auto& point : pointCollection[0]) {
+            unitPoints.push_back((point - center) / halfSize);
+        }
+    }
+    ShapeInfo::PointCollection unitPointCollection;
+    unitPointCollection.push_back(unitPoints);
+
+    ShapeInfo unitInfo;
+    unitInfo.setPointCollection(unitPointCollection);
+    unitInfo.getTriangleIndices() = info.getTriangleIndices();
+    unitInfo.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.0f), info.getURL().toString());
+    return unitInfo;
+}
+
 ShapeManager::ShapeManager() {
 }
 
 ShapeManager::~ShapeManager() {
+    for (auto& build : _shapeBuilds) {
+        const btCollisionShape* shape = build.shape.result();
+        if (shape) {
+            ShapeFactory::deleteShape(shape);
+        }
+    }
+    _shapeBuilds.clear();
     int numShapes = _shapeMap.size();
     for (int i = 0; i < numShapes; ++i) {
         ShapeReference* shapeRef = _shapeMap.getAtIndex(i);
@@ -28,27 +96,23 @@ ShapeManager::~ShapeManager() {
     _shapeMap.clear();
 }
 
-const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
-    if (info.getType() == SHAPE_TYPE_NONE) {
-        return nullptr;
-    }
+bool ShapeManager::isTooSmall(const ShapeInfo& info) const {
     const float MIN_SHAPE_DIAGONAL_SQUARED = 3.0e-4f; // 1 cm cube
-    if (4.0f * glm::length2(info.getHalfExtents()) < MIN_SHAPE_DIAGONAL_SQUARED) {
-        // tiny shapes are not supported
-        // qCDebug(physics) << "ShapeManager::getShape -- not making shape due to size" << diagonal;
-        return nullptr;
-    }
+    // tiny shapes are not supported
+    return 4.0f * glm::length2(info.getHalfExtents()) < MIN_SHAPE_DIAGONAL_SQUARED;
+}
 
-    DoubleHashKey key = info.getHash();
+const btCollisionShape* ShapeManager::insertShape(const DoubleHashKey& key, const btCollisionShape* shape) {
     ShapeReference* shapeRef = _shapeMap.find(key);
     if (shapeRef) {
-        shapeRef->refCount++;
+        // built meanwhile by getShape()
+        if (shape && shape != shapeRef->shape) {
+            ShapeFactory::deleteShape(shape);
+        }
         return shapeRef->shape;
     }
-    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
     if (shape) {
         ShapeReference newRef;
-        newRef.refCount = 1;
         newRef.shape = shape;
         newRef.key = key;
         _shapeMap.insert(key, newRef);
@@ -56,6 +120,116 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     return shape;
 }
 
+const btCollisionShape* ShapeManager::addReference(const DoubleHashKey& key, const btCollisionShape* shape) {
+    shape = insertShape(key, shape);
+    if (shape) {
+        _shapeMap.find(key)->refCount++;
+    }
+    return shape;
+}
+
+const btCollisionShape* ShapeManager::addMeshInstance(const DoubleHashKey& key, const ShapeInfo& info,
+        const DoubleHashKey& unitKey) {
+    ShapeReference* unitRef = _shapeMap.find(unitKey);
+    assert(unitRef);
+    glm::vec3 center, halfSize;
+    computeMeshBounds(info, center, halfSize);
+    const btCollisionShape* shape = ShapeFactory::createMeshInstance(unitRef->shape, halfSize,
+            center + info.getOffset());
+    // the instance holds a reference to its unit mesh until it is deleted
+    unitRef->refCount++;
+
+    ShapeReference newRef;
+    newRef.refCount = 1;
+    newRef.shape = shape;
+    newRef.key = key;
+    newRef.unitKey = unitKey;
+    _shapeMap.insert(key, newRef);
+    return shape;
+}
+
+const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+    if (info.getType() == SHAPE_TYPE_NONE || isTooSmall(info)) {
+        return nullptr;
+    }
+
+    DoubleHashKey key = info.getHash();
+    ShapeReference* shapeRef = _shapeMap.find(key);
+    if (shapeRef) {
+        shapeRef->refCount++;
+        return shapeRef->shape;
+    }
+    if (isMeshInstance(info)) {
+        DoubleHashKey unitKey = getUnitMeshParams(info).getHash();
+        if (!_shapeMap.find(unitKey)) {
+            const btCollisionShape* unitMesh = ShapeFactory::createShapeFromInfo(getUnitMeshInfo(info));
+            if (!insertShape(unitKey, unitMesh)) {
+                return nullptr;
+            }
+        }
+        return addMeshInstance(key, info, unitKey);
+    }
+    return addReference(key, ShapeFactory::createShapeFromInfo(info));
+}
+
+const btCollisionShape* ShapeManager::getShapeWhenBuilt(const ShapeInfo& info, bool& isBuilding) {
+    isBuilding = false;
+    ShapeType type = info.getType();
+    if (type != SHAPE_TYPE_COMPOUND && type != SHAPE_TYPE_STATIC_MESH) {
+        return getShape(info);
+    }
+    if (isTooSmall(info)) {
+        return nullptr;
+    }
+
+    DoubleHashKey key = info.getHash();
+    ShapeReference* shapeRef = _shapeMap.find(key);
+    if (shapeRef) {
+        shapeRef->refCount++;
+        return shapeRef->shape;
+    }
+
+    // a mesh instance waits for the build of its unit mesh, if that isn't already built
+    bool isInstance = isMeshInstance(info);
+    DoubleHashKey buildKey = key;
+    if (isInstance) {
+        buildKey = getUnitMeshParams(info).getHash();
+        if (_shapeMap.find(buildKey)) {
+            return addMeshInstance(key, info, buildKey);
+        }
+    }
+
+    auto buildItr = std::find_if(_shapeBuilds.begin(), _shapeBuilds.end(), [&](const ShapeBuild& build) {
+        return build.key.equals(buildKey);
+    });
+    if (buildItr == _shapeBuilds.end()) {
+        // the hulls and triangles are copied along with the info, the build doesn't depend on the caller's
+        ShapeBuild build;
+        build.key = buildKey;
+        ShapeInfo buildInfo = isInstance ? getUnitMeshInfo(info) : info;
+        build.shape = QtConcurrent::run([buildInfo] {
+            return ShapeFactory::createShapeFromInfo(buildInfo);
+        });
+        _shapeBuilds.push_back(build);
+        isBuilding = true;
+        return nullptr;
+    }
+    if (!buildItr->shape.isFinished()) {
+        isBuilding = true;
+        return nullptr;
+    }
+
+    const btCollisionShape* shape = buildItr->shape.result();
+    _shapeBuilds.erase(buildItr);
+    if (isInstance) {
+        if (!insertShape(buildKey, shape)) {
+            return nullptr;
+        }
+        return addMeshInstance(key, info, buildKey);
+    }
+    return addReference(key, shape);
+}
+
 // private helper method
 bool ShapeManager::releaseShapeByKey(const DoubleHashKey& key) {
     ShapeReference* shapeRef = _shapeMap.find(key);
@@ -93,13 +267,20 @@ bool ShapeManager::releaseShape(const btCollisionShape* shape) {
 }
 
 void ShapeManager::collectGarbage() {
-    int numShapes = _pendingGarbage.size();
-    for (int i = 0; i < numShapes; ++i) {
-        DoubleHashKey& key = _pendingGarbage[i];
+    // a unit mesh released by the deletion of its last instance is collected in the same pass
+    for (int i = 0; i < _pendingGarbage.size(); ++i) {
+        DoubleHashKey key = _pendingGarbage[i];
         ShapeReference* shapeRef = _shapeMap.find(key);
         if (shapeRef && shapeRef->refCount == 0) {
+            DoubleHashKey unitKey = shapeRef->unitKey;
             ShapeFactory::deleteShape(shapeRef->shape);
             _shapeMap.remove(key);
+            if (!unitKey.isNull()) {
+                ShapeReference* unitRef = _shapeMap.find(unitKey);
+                if (unitRef && unitRef->refCount > 0 && --unitRef->refCount == 0) {
+                    _pendingGarbage.push_back(unitKey);
+                }
+            }
         }
     }
     _pendingGarbage.clear();
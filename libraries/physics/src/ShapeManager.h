@@ -12,6 +12,10 @@
 #ifndef hifi_ShapeManager_h
 #define hifi_ShapeManager_h
 
+#include <vector>
+
+#include <QtCore/QFuture>
+
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
@@ -28,6 +32,10 @@ public:
     /// \return pointer to shape
     const btCollisionShape* getShape(const ShapeInfo& info);
 
+    /// Like getShape(), but the meshes and compounds that are slow to build are built on the thread pool
+    /// \return pointer to shape, or nullptr while it is still being built: ask again later with the same info
+    const btCollisionShape* getShapeWhenBuilt(const ShapeInfo& info, bool& isBuilding);
+
     /// \return true if shape was found and released
     bool releaseShape(const btCollisionShape* shape);
 
@@ -42,17 +50,30 @@ public:
 
 private:
     bool releaseShapeByKey(const DoubleHashKey& key);
+    const btCollisionShape* insertShape(const DoubleHashKey& key, const btCollisionShape* shape);
+    const btCollisionShape* addReference(const DoubleHashKey& key, const btCollisionShape* shape);
+    const btCollisionShape* addMeshInstance(const DoubleHashKey& key, const ShapeInfo& info,
+            const DoubleHashKey& unitKey);
+    bool isTooSmall(const ShapeInfo& info) const;
 
     class ShapeReference {
     public:
         int refCount;
         const btCollisionShape* shape;
         DoubleHashKey key;
+        DoubleHashKey unitKey; // of the unit mesh a mesh instance references, null otherwise
         ShapeReference() : refCount(0), shape(nullptr) {}
     };
 
     btHashMap<DoubleHashKey, ShapeReference> _shapeMap;
     btAlignedObjectArray<DoubleHashKey> _pendingGarbage;
+
+    class ShapeBuild {
+    public:
+        DoubleHashKey key;
+        QFuture<const btCollisionShape*> shape;
+    };
+    std::vector<ShapeBuild> _shapeBuilds;
 };
 
 #endif // hifi_ShapeManager_h
@@ -10,12 +10,18 @@
 //
 #pragma once
 
+#include <QtCore/QVariantMap>
+
 #include "Plugin.h"
 
 class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // whether the encoder keeps no state between frames and is handed to every client, and costs enough that a
+    // frame is worth encoding once for all the clients it is the same for
+    virtual bool isShareable() const { return false; }
 };
 
 class Decoder {
@@ -32,4 +38,7 @@ public:
     virtual Decoder* createDecoder(int sampleRate, int numChannels) = 0;
     virtual void releaseEncoder(Encoder* encoder) = 0;
     virtual void releaseDecoder(Decoder* decoder) = 0;
+
+    // the settings of the deployment for the encoders created after, for the codecs that have any
+    virtual void configure(const QVariantMap& settings) {}
 };
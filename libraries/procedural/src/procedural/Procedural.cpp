@@ -224,6 +224,12 @@ bool Procedural::ready() {
         }
     }
 
+    // Is the program made? Until it is, the callers draw without the procedural
+    updateProgram();
+    if (!_shader) {
+        return false;
+    }
+
     if (!_hasStartedFade) {
         _hasStartedFade = true;
         _isFading = true;
@@ -236,6 +242,43 @@ void Procedural::prepare(gpu::Batch& batch, const glm::vec3& position, const glm
     _entityDimensions = size;
     _entityPosition = position;
     _entityOrientation = glm::mat3_cast(orientation);
+    batch.setPipeline(isFading() ? _transparentPipeline : _opaquePipeline);
+
+    // A new program dirties both
+    if (_uniformsDirty) {
+        setupUniforms();
+    }
+
+    if (_uniformsDirty || _channelsDirty) {
+        setupChannels(_uniformsDirty);
+    }
+
+    _uniformsDirty = _channelsDirty = false;
+
+    for (auto lambda : _uniforms) {
+        lambda(batch);
+    }
+
+    static gpu::Sampler sampler;
+    static std::once_flag once;
+    std::call_once(once, [&] {
+        gpu::Sampler::Desc desc;
+        desc._filter = gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR;
+    });
+    
+    for (size_t i = 0; i < MAX_PROCEDURAL_TEXTURE_CHANNELS; ++i) {
+        if (_channels[i] && _channels[i]->isLoaded()) {
+            auto gpuTexture = _channels[i]->getGPUTexture();
+            if (gpuTexture) {
+                gpuTexture->setSampler(sampler);
+                gpuTexture->autoGenerateMips(-1);
+            }
+            batch.setResourceTexture((gpu::uint32)i, gpuTexture);
+        }
+    }
+}
+
+void Procedural::updateProgram() {
     if (_shaderUrl.isLocalFile()) {
         auto lastModified = (quint64)QFileInfo(_shaderPath).lastModified().toMSecsSinceEpoch();
         if (lastModified > _shaderModified) {
@@ -249,7 +292,9 @@ void Procedural::prepare(gpu::Batch& batch, const glm::vec3& position, const glm
         _shaderSource = _networkShader->_source;
     }
 
-    if (!_opaquePipeline || !_transparentPipeline || _shaderDirty) {
+    if (_shaderDirty) {
+        _shaderDirty = false;
+
         if (!_vertexShader) {
             _vertexShader = gpu::Shader::createVertex(_vertexSource);
         }
@@ -278,57 +323,38 @@ void Procedural::prepare(gpu::Batch& batch, const glm::vec3& position, const glm
         // qCDebug(procedural) << "FragmentShader:\n" << fragmentShaderSource.c_str();
 
         _fragmentShader = gpu::Shader::createPixel(fragmentShaderSource);
-        _shader = gpu::Shader::createProgram(_vertexShader, _fragmentShader);
 
         gpu::Shader::BindingSet slotBindings;
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel0"), 0));
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel1"), 1));
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel2"), 2));
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel3"), 3));
-        gpu::Shader::makeProgram(*_shader, slotBindings);
-
-        _opaquePipeline = gpu::Pipeline::create(_shader, _opaqueState);
-        _transparentPipeline = gpu::Pipeline::create(_shader, _transparentState);
-        for (size_t i = 0; i < NUM_STANDARD_UNIFORMS; ++i) {
-            const std::string& name = STANDARD_UNIFORM_NAMES[i];
-            _standardUniformSlots[i] = _shader->getUniforms().findLocation(name);
-        }
-        _start = usecTimestampNow();
-        _frameCount = 0;
-    }
-
-    batch.setPipeline(isFading() ? _transparentPipeline : _opaquePipeline);
 
-    if (_shaderDirty || _uniformsDirty) {
-        setupUniforms();
-    }
-
-    if (_shaderDirty || _uniformsDirty || _channelsDirty) {
-        setupChannels(_shaderDirty || _uniformsDirty);
-    }
-
-    _shaderDirty = _uniformsDirty = _channelsDirty = false;
-
-    for (auto lambda : _uniforms) {
-        lambda(batch);
+        // A program still being made for an older source is dropped when it's done
+        auto pendingProgram = std::make_shared<PendingProgram>();
+        pendingProgram->shader = gpu::Shader::createProgram(_vertexShader, _fragmentShader);
+        _pendingProgram = pendingProgram;
+        gpu::Shader::makeProgramAsync(pendingProgram->shader, slotBindings, [pendingProgram](bool made) {
+            pendingProgram->status = made ? PendingProgram::Made : PendingProgram::Failed;
+        });
     }
 
-    static gpu::Sampler sampler;
-    static std::once_flag once;
-    std::call_once(once, [&] {
-        gpu::Sampler::Desc desc;
-        desc._filter = gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR;
-    });
-    
-    for (size_t i = 0; i < MAX_PROCEDURAL_TEXTURE_CHANNELS; ++i) {
-        if (_channels[i] && _channels[i]->isLoaded()) {
-            auto gpuTexture = _channels[i]->getGPUTexture();
-            if (gpuTexture) {
-                gpuTexture->setSampler(sampler);
-                gpuTexture->autoGenerateMips(-1);
+    if (_pendingProgram && _pendingProgram->status != PendingProgram::Pending) {
+        if (_pendingProgram->status == PendingProgram::Made) {
+            _shader = _pendingProgram->shader;
+            _opaquePipeline = gpu::Pipeline::create(_shader, _opaqueState);
+            _transparentPipeline = gpu::Pipeline::create(_shader, _transparentState);
+            for (size_t i = 0; i < NUM_STANDARD_UNIFORMS; ++i) {
+                const std::string& name = STANDARD_UNIFORM_NAMES[i];
+                _standardUniformSlots[i] = _shader->getUniforms().findLocation(name);
             }
-            batch.setResourceTexture((gpu::uint32)i, gpuTexture);
+            _start = usecTimestampNow();
+            _frameCount = 0;
+            _uniformsDirty = _channelsDirty = true;
+        } else {
+            qCWarning(procedural) << "Failed to make the program of" << _shaderUrl;
         }
+        _pendingProgram.reset();
     }
 }
 
@@ -98,6 +98,15 @@ protected:
     gpu::ShaderPointer _fragmentShader;
     gpu::ShaderPointer _shader;
 
+    // The program of the last source, made off the render thread; the procedural isn't ready until there's one,
+    // and the program of the previous source keeps being drawn with until it's replaced
+    struct PendingProgram {
+        enum Status { Pending = 0, Made, Failed };
+        gpu::ShaderPointer shader;
+        std::atomic<int> status { Pending };
+    };
+    std::shared_ptr<PendingProgram> _pendingProgram;
+
     // Entity metadata
     glm::vec3 _entityDimensions;
     glm::vec3 _entityPosition;
@@ -111,6 +120,8 @@ private:
     bool parseUniforms(const QJsonObject& uniforms);
     bool parseTextures(const QJsonArray& channels);
 
+    void updateProgram();
+
     void setupUniforms();
     void setupChannels(bool shouldCreate);
 
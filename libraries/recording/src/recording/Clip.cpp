@@ -14,6 +14,9 @@
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
 
+#include <algorithm>
+#include <map>
+
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
@@ -92,6 +95,103 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FRAME_CHUNKED_FLAG = QStringLiteral("chunked");
+
+template <typename T>
+void appendValue(QByteArray& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+const size_t Clip::CHUNK_SIZE;
+const quint64 Clip::CHUNK_TRAILER_MAGIC;
+
+void Clip::applyFrameDelta(QByteArray& data, const QByteArray& previousData) {
+    int size = std::min(data.size(), previousData.size());
+    char* bytes = data.data();
+    const char* previousBytes = previousData.constData();
+    for (int i = 0; i < size; ++i) {
+        bytes[i] ^= previousBytes[i];
+    }
+}
+
+class ChunkWriter {
+public:
+    ChunkWriter(QIODevice& output) : _output(output) {}
+
+    bool addFrame(const Frame& frame) {
+        QByteArray data = frame.data;
+        auto previous = _previousFrames.find(frame.type);
+        if (previous != _previousFrames.end()) {
+            Clip::applyFrameDelta(data, previous->second);
+        }
+        _previousFrames[frame.type] = frame.data;
+
+        appendValue(_chunk, frame.type);
+        appendValue(_chunk, frame.timeOffset);
+        appendValue(_chunk, (uint32_t)data.size());
+        _chunk.append(data);
+
+        appendValue(_frameIndex, frame.type);
+        appendValue(_frameIndex, frame.timeOffset);
+        appendValue(_frameIndex, (uint32_t)_numChunks);
+        ++_numFrames;
+
+        if ((size_t)_chunk.size() >= Clip::CHUNK_SIZE) {
+            return flushChunk();
+        }
+        return true;
+    }
+
+    bool finish() {
+        if (!flushChunk()) {
+            return false;
+        }
+
+        QByteArray seekTable;
+        appendValue(seekTable, _numChunks);
+        seekTable.append(_chunkIndex);
+        appendValue(seekTable, _numFrames);
+        seekTable.append(_frameIndex);
+        seekTable = qCompress(seekTable);
+
+        quint64 seekTableOffset = (quint64)_output.pos();
+        QByteArray trailer;
+        appendValue(trailer, (uint32_t)seekTable.size());
+        trailer.append(seekTable);
+        appendValue(trailer, seekTableOffset);
+        appendValue(trailer, Clip::CHUNK_TRAILER_MAGIC);
+        return _output.write(trailer) == trailer.size();
+    }
+
+private:
+    bool flushChunk() {
+        if (_chunk.isEmpty()) {
+            return true;
+        }
+        QByteArray compressed = qCompress(_chunk);
+        QByteArray record;
+        appendValue(record, (uint32_t)compressed.size());
+        record.append(compressed);
+
+        // the offset of the chunk is that of its compressed data
+        appendValue(_chunkIndex, (quint64)_output.pos() + sizeof(uint32_t));
+        appendValue(_chunkIndex, (uint32_t)compressed.size());
+        ++_numChunks;
+
+        // the chunks decode on their own
+        _chunk.clear();
+        _previousFrames.clear();
+        return _output.write(record) == record.size();
+    }
+
+    QIODevice& _output;
+    QByteArray _chunk;
+    std::map<FrameType, QByteArray> _previousFrames;
+    QByteArray _chunkIndex;
+    QByteArray _frameIndex;
+    uint32_t _numChunks { 0 };
+    uint32_t _numFrames { 0 };
+};
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -102,8 +202,9 @@ bool Clip::write(QIODevice& output) {
 
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
+    // Always mark new files as compressed, in chunks
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    rootObject.insert(FRAME_CHUNKED_FLAG, true);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
     if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
@@ -112,10 +213,15 @@ bool Clip::write(QIODevice& output) {
 
     seek(0);
 
+    ChunkWriter chunkWriter(output);
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (frame->type == Frame::TYPE_INVALID) {
+            qWarning() << "Attempting to write invalid frame";
+            continue;
+        }
+        if (!chunkWriter.addFrame(*frame)) {
             return false;
         }
     }
-    return true;
+    return chunkWriter.finish();
 }
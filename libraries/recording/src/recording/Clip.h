@@ -56,6 +56,18 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    static const QString FRAME_CHUNKED_FLAG;
+
+    // Clips are written in chunks of frames, each compressed on its own, followed by a seek table of the chunks and
+    // frames and then by a trailer pointing at it, so that a clip opens without reading its frames.  Within a chunk
+    // every frame is stored as its difference to the previous frame of the same type, which for the frames of
+    // an avatar is mostly zeros.
+    static const size_t CHUNK_SIZE = 64 * 1024; // bytes of frame data before compression
+    static const quint64 CHUNK_TRAILER_MAGIC = 0x4b4e484350494c43; // "CLIPCHNK"
+
+    // XORs the bytes of a frame with those of the previous frame of its type, as far as they both go, which both
+    // encodes and decodes the difference
+    static void applyFrameDelta(QByteArray& data, const QByteArray& previousData);
 
 protected:
     friend class WrapperClip;
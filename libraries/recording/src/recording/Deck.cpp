@@ -8,6 +8,8 @@
 
 #include "Deck.h"
  
+#include <chrono>
+
 #include <QtCore/QThread>
 
 #include <NumericalConstants.h>
@@ -21,7 +23,18 @@
 using namespace recording;
 
 Deck::Deck(QObject* parent) 
-    : QObject(parent) {}
+    : QObject(parent) {
+    _schedulerThread = std::thread([this] { runScheduler(); });
+}
+
+Deck::~Deck() {
+    {
+        Locker lock(_mutex);
+        _quit = true;
+    }
+    _schedulerCondition.notify_all();
+    _schedulerThread.join();
+}
 
 void Deck::queueClip(ClipPointer clip, float timeOffset) {
     Locker lock(_mutex);
@@ -31,18 +44,17 @@ void Deck::queueClip(ClipPointer clip, float timeOffset) {
         return;
     }
 
-    // FIXME disabling multiple clips for now
-    _clips.clear();
-    _length = 0.0f;
-
     // if the time offset is not zero, wrap in an OffsetClip
     if (timeOffset != 0.0f) {
         clip = std::make_shared<OffsetClip>(clip, timeOffset);
     }
 
+    // the clip joins the others where they are
+    clip->seekFrameTime(Frame::secondsToFrameTime(position()));
     _clips.push_back(clip);
 
     _length = std::max(_length, clip->duration());
+    scheduleClips();
 }
 
 void Deck::play() { 
@@ -51,31 +63,20 @@ void Deck::play() {
         _pause = false;
         _startEpoch = Frame::epochForFrameTime(_position);
         emit playbackStateChanged();
-        processFrames();
+        _schedulerCondition.notify_all();
     }
 }
 
 void Deck::pause() { 
     Locker lock(_mutex);
     if (!_pause) {
+        _position = Frame::frameTimeFromEpoch(_startEpoch);
         _pause = true;
         emit playbackStateChanged();
+        _schedulerCondition.notify_all();
     }
 }
 
-Clip::Pointer Deck::getNextClip() {
-    Clip::Pointer result;
-    auto soonestFramePosition = Frame::INVALID_TIME;
-    for (const auto& clip : _clips) {
-        auto nextFramePosition = clip->positionFrameTime();
-        if (nextFramePosition < soonestFramePosition) {
-            result = clip;
-            soonestFramePosition = nextFramePosition;
-        }
-    }
-    return result;
-}
-
 void Deck::seek(float position) {
     Locker lock(_mutex);
     _position = Frame::secondsToFrameTime(position);
@@ -88,10 +89,9 @@ void Deck::seek(float position) {
         clip->seekFrameTime(_position);
     }
 
-    if (!_pause) {
-        // FIXME what if the timer is already running?
-        processFrames();
-    }
+    // the frames read ahead of the seek are not played
+    _readyFrames.clear();
+    scheduleClips();
 }
 
 float Deck::position() const {
@@ -104,49 +104,85 @@ float Deck::position() const {
 }
 
 static const Frame::Time MIN_FRAME_WAIT_INTERVAL = Frame::secondsToFrameTime(0.001f);
-static const Frame::Time MAX_FRAME_PROCESSING_TIME = Frame::secondsToFrameTime(0.004f);
 
-void Deck::processFrames() {
-    if (qApp->thread() != QThread::currentThread()) {
-        qWarning() << "Processing frames must only happen on the main thread.";
-        return;
+void Deck::scheduleClips() {
+    _scheduledClips = std::priority_queue<ScheduledClip>();
+    for (const auto& clip : _clips) {
+        auto nextFramePosition = clip->positionFrameTime();
+        if (nextFramePosition != Frame::INVALID_TIME) {
+            _scheduledClips.push({ nextFramePosition, clip });
+        }
     }
+    _reachedEnd = false;
+    _schedulerCondition.notify_all();
+}
+
+void Deck::runScheduler() {
     Locker lock(_mutex);
-    if (_pause) {
-        return;
-    }
+    while (!_quit) {
+        if (_pause || _reachedEnd) {
+            _schedulerCondition.wait(lock);
+            continue;
+        }
+
+        if (_scheduledClips.empty()) {
+            // every clip has played out, the deck's thread loops or stops
+            _reachedEnd = true;
+            QMetaObject::invokeMethod(this, "deliverFrames", Qt::QueuedConnection);
+            continue;
+        }
+
+        // sleep until the soonest frame is due, the frames are read a little ahead as they were on a timer
+        quint64 now = usecTimestampNow();
+        quint64 dueTime = _startEpoch + (quint64)(_scheduledClips.top().time) * USECS_PER_MSEC;
+        quint64 triggerTime = now + (quint64)MIN_FRAME_WAIT_INTERVAL * USECS_PER_MSEC;
+        if (dueTime > triggerTime) {
+            _schedulerCondition.wait_for(lock, std::chrono::microseconds(dueTime - triggerTime));
+            continue;
+        }
 
-    auto startingPosition = Frame::frameTimeFromEpoch(_startEpoch);
-    auto triggerPosition = startingPosition + MIN_FRAME_WAIT_INTERVAL;
-    Clip::Pointer nextClip;
-    // FIXME add code to start dropping frames if we fall behind.
-    // Alternatively, add code to cache frames here and then process only the last frame of a given type
-    // ... the latter will work for Avatar, but not well for audio I suspect.
-    bool overLimit = false;
-    for (nextClip = getNextClip(); nextClip; nextClip = getNextClip()) {
-        auto currentPosition = Frame::frameTimeFromEpoch(_startEpoch);
-        if ((currentPosition - startingPosition) >= MAX_FRAME_PROCESSING_TIME) {
-            qCWarning(recordingLog) << "Exceeded maximum frame processing time, breaking early";
-#ifdef WANT_RECORDING_DEBUG            
-            qCDebug(recordingLog) << "Starting: " << currentPosition;
-            qCDebug(recordingLog) << "Current:  " << startingPosition;
-            qCDebug(recordingLog) << "Trigger:  " << triggerPosition;
-#endif
-            overLimit = true;
-            break;
+        // every frame due by then, across all the clips in the order of their time
+        Frame::Time triggerPosition = Frame::frameTimeFromEpoch(_startEpoch) + MIN_FRAME_WAIT_INTERVAL;
+        bool wasWaiting = !_readyFrames.empty();
+        while (!_scheduledClips.empty() && _scheduledClips.top().time <= triggerPosition) {
+            ScheduledClip scheduled = _scheduledClips.top();
+            _scheduledClips.pop();
+            auto frame = scheduled.clip->nextFrame();
+            if (frame) {
+                _readyFrames.push_back(frame);
+            }
+            auto nextFramePosition = scheduled.clip->positionFrameTime();
+            if (nextFramePosition != Frame::INVALID_TIME) {
+                _scheduledClips.push({ nextFramePosition, scheduled.clip });
+            }
         }
 
-        // If the clip is too far in the future, just break out of the handling loop
-        Frame::Time framePosition = nextClip->positionFrameTime();
-        if (framePosition > triggerPosition) {
-            break;
+        // a batch still waiting on the deck's thread takes these along
+        if (!wasWaiting && !_readyFrames.empty()) {
+            QMetaObject::invokeMethod(this, "deliverFrames", Qt::QueuedConnection);
         }
-        // Handle the frame and advance the clip
-        Frame::handleFrame(nextClip->nextFrame());
+    }
+}
+
+void Deck::deliverFrames() {
+    std::deque<FrameConstPointer> frames;
+    bool reachedEnd;
+    {
+        Locker lock(_mutex);
+        frames.swap(_readyFrames);
+        reachedEnd = _reachedEnd && !_pause;
+    }
+
+    for (const auto& frame : frames) {
+        Frame::handleFrame(frame);
     }
 
-    if (!nextClip) {
-        // No more frames available, so handle the end of playback
+    if (reachedEnd) {
+        Locker lock(_mutex);
+        if (!_reachedEnd) {
+            // seeked meanwhile
+            return;
+        }
         if (_loop) {
             // If we have looping enabled, start the playback over
             seek(0);
@@ -157,45 +193,31 @@ void Deck::processFrames() {
             // otherwise stop playback
             stop();
         }
-        return;
-    } 
-
-    // If we have more clip frames available, set the timer for the next one
-    _position = Frame::frameTimeFromEpoch(_startEpoch);
-    int nextInterval = 1;
-    if (!overLimit) {
-        auto nextFrameTime = nextClip->positionFrameTime();
-        nextInterval = (int)Frame::frameTimeToMilliseconds(nextFrameTime - _position);
-#ifdef WANT_RECORDING_DEBUG
-        qCDebug(recordingLog) << "Now " << _position;
-        qCDebug(recordingLog) << "Next frame time " << nextInterval;
-#endif
     }
-#ifdef WANT_RECORDING_DEBUG
-    qCDebug(recordingLog) << "Setting timer for next processing " << nextInterval;
-#endif
-    _timer.singleShot(nextInterval, [this] {
-        processFrames();
-    });
 }
 
 void Deck::removeClip(const ClipConstPointer& clip) {
     Locker lock(_mutex);
-    std::remove_if(_clips.begin(), _clips.end(), [&](const Clip::ConstPointer& testClip)->bool {
+    _clips.remove_if([&](const Clip::ConstPointer& testClip)->bool {
         return (clip == testClip);
     });
+    scheduleClips();
 }
 
 void Deck::removeClip(const QString& clipName) {
     Locker lock(_mutex);
-    std::remove_if(_clips.begin(), _clips.end(), [&](const Clip::ConstPointer& clip)->bool {
+    _clips.remove_if([&](const Clip::ConstPointer& clip)->bool {
         return (clip->getName() == clipName);
     });
+    scheduleClips();
 }
 
 void Deck::removeAllClips() {
     Locker lock(_mutex);
     _clips.clear();
+    _length = 0.0f;
+    _readyFrames.clear();
+    scheduleClips();
 }
 
 Deck::ClipList Deck::getClips(const QString& clipName) const {
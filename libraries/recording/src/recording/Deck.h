@@ -10,12 +10,16 @@
 #ifndef hifi_Recording_Deck_h
 #define hifi_Recording_Deck_h
 
-#include <utility>
+#include <condition_variable>
+#include <deque>
 #include <list>
 #include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QObject>
-#include <QtCore/QTimer>
 #include <QtCore/QList>
 
 #include <DependencyManager.h>
@@ -26,6 +30,9 @@
 
 namespace recording {
 
+// Plays any number of clips at once.  A scheduler thread of the deck's own keeps the next frame of every clip in one
+// heap by time, sleeps until the soonest is due, reads all those due by then and hands them over in a batch to the
+// deck's thread, where the frame handlers run.
 class Deck : public QObject, public ::Dependency {
     Q_OBJECT
 public:
@@ -33,6 +40,7 @@ public:
     using Pointer = std::shared_ptr<Deck>;
 
     Deck(QObject* parent = nullptr);
+    ~Deck();
 
     // Place a clip on the deck for recording or playback
     void queueClip(ClipPointer clip, float timeOffset = 0.0f);
@@ -61,15 +69,31 @@ signals:
     void playbackStateChanged();
     void looped();
 
+private slots:
+    void deliverFrames();
+
 private:
     using Mutex = std::recursive_mutex;
     using Locker = std::unique_lock<Mutex>;
 
-    ClipPointer getNextClip();
-    void processFrames();
+    struct ScheduledClip {
+        Frame::Time time;
+        ClipPointer clip;
+
+        // the soonest on top of the heap
+        bool operator<(const ScheduledClip& other) const { return time > other.time; }
+    };
+
+    void runScheduler();
+    void scheduleClips();
 
     mutable Mutex _mutex;
-    QTimer _timer;
+    std::condition_variable_any _schedulerCondition;
+    std::thread _schedulerThread;
+    bool _quit { false };
+    std::priority_queue<ScheduledClip> _scheduledClips;
+    std::deque<FrameConstPointer> _readyFrames;
+    bool _reachedEnd { false };
     ClipList _clips;
     quint64 _startEpoch { 0 };
     Frame::Time _position { 0 };
@@ -9,6 +9,7 @@
 #include "PointerClip.h"
 
 #include <algorithm>
+#include <map>
 
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
@@ -45,13 +46,13 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size, size_t maxFrames = SIZE_MAX) {
     PointerFrameHeaderList results;
     auto current = start;
     auto end = current + size;
     // Read all the frame headers
     // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
+    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE && results.size() < maxFrames) {
         PointerFrameHeader header;
         memcpy(&(header.type), current, sizeof(FrameType));
         current += sizeof(FrameType);
@@ -75,11 +76,123 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
     return results;
 }
 
+template <typename T>
+bool readValue(const char*& current, const char* end, T& value) {
+    if (end - current < (ptrdiff_t)sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, current, sizeof(T));
+    current += sizeof(T);
+    return true;
+}
+
 void PointerClip::reset() {
     _frames.clear();
     _data = nullptr;
     _size = 0;
     _header = QJsonDocument();
+    _chunked = false;
+    _chunks.clear();
+    _cachedChunkIndex = -1;
+    _cachedChunkFrames.clear();
+}
+
+bool PointerClip::readSeekTable(PointerFrameHeaderList& frameHeaders) {
+    const size_t TRAILER_SIZE = 2 * sizeof(quint64);
+    if (_size < TRAILER_SIZE) {
+        return false;
+    }
+    const char* trailer = reinterpret_cast<const char*>(_data) + _size - TRAILER_SIZE;
+    const char* trailerEnd = trailer + TRAILER_SIZE;
+    quint64 seekTableOffset;
+    quint64 magic;
+    readValue(trailer, trailerEnd, seekTableOffset);
+    readValue(trailer, trailerEnd, magic);
+    if (magic != CHUNK_TRAILER_MAGIC || seekTableOffset + sizeof(uint32_t) > _size - TRAILER_SIZE) {
+        return false;
+    }
+
+    const char* current = reinterpret_cast<const char*>(_data) + seekTableOffset;
+    const char* end = reinterpret_cast<const char*>(_data) + _size - TRAILER_SIZE;
+    uint32_t compressedSize;
+    readValue(current, end, compressedSize);
+    if (compressedSize > (size_t)(end - current)) {
+        return false;
+    }
+    QByteArray seekTable = qUncompress(QByteArray::fromRawData(current, compressedSize));
+    current = seekTable.constData();
+    end = current + seekTable.size();
+
+    uint32_t numChunks;
+    if (!readValue(current, end, numChunks)) {
+        return false;
+    }
+    _chunks.reserve(numChunks);
+    for (uint32_t i = 0; i < numChunks; ++i) {
+        Chunk chunk;
+        if (!readValue(current, end, chunk.fileOffset) || !readValue(current, end, chunk.size) ||
+                chunk.fileOffset + chunk.size > _size) {
+            return false;
+        }
+        _chunks.push_back(chunk);
+    }
+
+    uint32_t numFrames;
+    if (!readValue(current, end, numFrames)) {
+        return false;
+    }
+    uint32_t chunkFrameIndex = 0;
+    for (uint32_t i = 0; i < numFrames; ++i) {
+        PointerFrameHeader header;
+        header.size = 0;
+        header.fileOffset = 0;
+        uint32_t chunkIndex;
+        if (!readValue(current, end, header.type) || !readValue(current, end, header.timeOffset) ||
+                !readValue(current, end, chunkIndex) || chunkIndex >= numChunks) {
+            return false;
+        }
+        if (frameHeaders.empty() || chunkIndex != frameHeaders.back().chunkIndex) {
+            chunkFrameIndex = 0;
+        }
+        header.chunkIndex = chunkIndex;
+        header.chunkFrameIndex = chunkFrameIndex++;
+        frameHeaders.push_back(header);
+    }
+    qDebug(recordingLog) << "Read the seek table of " << frameHeaders.size() << " frames in " << numChunks << " chunks";
+    return true;
+}
+
+const std::vector<QByteArray>& PointerClip::readChunk(uint32_t chunkIndex) const {
+    if (_cachedChunkIndex == (int)chunkIndex) {
+        return _cachedChunkFrames;
+    }
+    _cachedChunkIndex = (int)chunkIndex;
+    _cachedChunkFrames.clear();
+
+    const Chunk& chunk = _chunks[chunkIndex];
+    QByteArray chunkData = qUncompress(QByteArray::fromRawData(reinterpret_cast<const char*>(_data) + chunk.fileOffset, chunk.size));
+    const char* current = chunkData.constData();
+    const char* end = current + chunkData.size();
+
+    // each frame is stored as its difference to the previous one of its type
+    std::map<FrameType, QByteArray> previousFrames;
+    FrameType type;
+    Frame::Time timeOffset;
+    uint32_t size;
+    while (readValue(current, end, type) && readValue(current, end, timeOffset) && readValue(current, end, size)) {
+        if (size > (size_t)(end - current)) {
+            break;
+        }
+        QByteArray frameData(current, size);
+        current += size;
+        auto previous = previousFrames.find(type);
+        if (previous != previousFrames.end()) {
+            applyFrameDelta(frameData, previous->second);
+        }
+        previousFrames[type] = frameData;
+        _cachedChunkFrames.push_back(frameData);
+    }
+    return _cachedChunkFrames;
 }
 
 void PointerClip::init(uchar* data, size_t size) {
@@ -88,7 +201,8 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    // only the header first, the chunked clips have a seek table of their other frames
+    auto parsedFrameHeaders = parseFrameHeaders(data, size, 1);
     // Verify that at least one frame exists and that the first frame is a header
     if (0 == parsedFrameHeaders.size()) {
         qWarning() << "No frames found, invalid file";
@@ -113,6 +227,19 @@ void PointerClip::init(uchar* data, size_t size) {
     // Check for compression
     {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+        _chunked = _header.object()[FRAME_CHUNKED_FLAG].toBool();
+    }
+
+    if (_chunked) {
+        if (!readSeekTable(parsedFrameHeaders)) {
+            qWarning() << "Missing or damaged seek table, invalid file";
+            reset();
+            return;
+        }
+    } else {
+        // the frames of older clips follow one another to the end of the file
+        parsedFrameHeaders = parseFrameHeaders(data, size);
+        parsedFrameHeaders.pop_front();
     }
 
     // Find the type enum translation map and fix up the frame headers
@@ -145,7 +272,12 @@ FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
         const auto& header = _frames[frameIndex];
         result->type = header.type;
         result->timeOffset = header.timeOffset;
-        if (header.size) {
+        if (_chunked) {
+            const auto& chunkFrames = readChunk(header.chunkIndex);
+            if (header.chunkFrameIndex < chunkFrames.size()) {
+                result->data = chunkFrames[header.chunkFrameIndex];
+            }
+        } else if (header.size) {
             result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
             if (_compressed) {
                 result->data = qUncompress(result->data);
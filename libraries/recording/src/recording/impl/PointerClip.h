@@ -25,6 +25,9 @@ struct PointerFrameHeader : public FrameHeader {
     Frame::Time timeOffset;
     uint16_t size;
     quint64 fileOffset;
+    // for the clips written in chunks, where the frame is rather than its size and offset
+    uint32_t chunkIndex { 0 };
+    uint32_t chunkFrameIndex { 0 };
 };
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
@@ -45,12 +48,25 @@ public:
     // FIXME move to frame?
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
 protected:
+    struct Chunk {
+        quint64 fileOffset;
+        uint32_t size;
+    };
+
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+    bool readSeekTable(PointerFrameHeaderList& frameHeaders);
+    const std::vector<QByteArray>& readChunk(uint32_t chunkIndex) const;
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+    bool _chunked { false };
+    std::vector<Chunk> _chunks;
+    // the frames of the chunk read last, the one playback is most likely to read from next
+    mutable int _cachedChunkIndex { -1 };
+    mutable std::vector<QByteArray> _cachedChunkFrames;
 };
 
 }
@@ -44,6 +44,7 @@ void DeferredFrameTransform::update(RenderArgs* args) {
         frameTransformBuffer.projection[0] = frameTransformBuffer.projectionMono;
         frameTransformBuffer.stereoInfo = glm::vec4(0.0f, (float)args->_viewport.z, 0.0f, 0.0f);
         frameTransformBuffer.invpixelInfo = glm::vec4(1.0f / args->_viewport.z, 1.0f / args->_viewport.w, 0.0f, 0.0f);
+        frameTransformBuffer.foveationInfo = glm::vec4(0.0f);
     } else {
 
         mat4 projMats[2];
@@ -60,12 +61,21 @@ void DeferredFrameTransform::update(RenderArgs* args) {
         frameTransformBuffer.stereoInfo = glm::vec4(1.0f, (float)(args->_viewport.z >> 1), 0.0f, 1.0f);
         frameTransformBuffer.invpixelInfo = glm::vec4(1.0f / (float)(args->_viewport.z >> 1), 1.0f / args->_viewport.w, 0.0f, 0.0f);
 
+        // Only the main view in the HMD is foveated
+        bool isFoveated = _foveated && (args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE);
+        frameTransformBuffer.foveationInfo = glm::vec4((isFoveated ? 1.0f : 0.0f), _foveaRadius, 0.0f, 0.0f);
     }
 }
 
+void GenerateDeferredFrameTransform::configure(const Config& config) {
+    _foveated = config.foveated;
+    _foveaRadius = config.foveaRadius;
+}
+
 void GenerateDeferredFrameTransform::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, DeferredFrameTransformPointer& frameTransform) {
     if (!frameTransform) {
         frameTransform = std::make_shared<DeferredFrameTransform>();
     }
+    frameTransform->setFoveation(_foveated, _foveaRadius);
     frameTransform->update(renderContext->args);
 }
@@ -27,6 +27,11 @@ public:
 
     void update(RenderArgs* args);
 
+    // Out of a fovea of this radius around the view axis of each eye, in its clip space, the lighting is shaded
+    // once per 2x2 pixels. Only applies to stereo frames.
+    void setFoveation(bool foveated, float foveaRadius) { _foveated = foveated; _foveaRadius = foveaRadius; }
+    bool isFoveated() const { return _frameTransformBuffer.get<FrameTransform>().foveationInfo.x > 0.0f; }
+
     UniformBufferView getFrameTransformBuffer() const { return _frameTransformBuffer; }
 
 protected:
@@ -51,12 +56,15 @@ protected:
         glm::mat4 invView;
         // View matrix from world space to eye space (mono)
         glm::mat4 view;
+        // Foveation info is { isFoveated, fovea radius in the clip space of an eye }
+        glm::vec4 foveationInfo{ 0.0f };
 
         FrameTransform() {}
     };
     UniformBufferView _frameTransformBuffer;
 
-   
+    bool _foveated { false };
+    float _foveaRadius { 0.0f };
 };
 
 using DeferredFrameTransformPointer = std::shared_ptr<DeferredFrameTransform>;
@@ -64,15 +72,32 @@ using DeferredFrameTransformPointer = std::shared_ptr<DeferredFrameTransform>;
 
 
 
+class GenerateDeferredFrameTransformConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool foveated MEMBER foveated NOTIFY dirty)
+    Q_PROPERTY(float foveaRadius MEMBER foveaRadius NOTIFY dirty)
+public:
+    // Shade the periphery of the eyes at a lower rate in stereo
+    bool foveated{ false };
+    float foveaRadius{ 0.6f };
+
+signals:
+    void dirty();
+};
+
 class GenerateDeferredFrameTransform {
 public:
-    using JobModel = render::Job::ModelO<GenerateDeferredFrameTransform, DeferredFrameTransformPointer>;
+    using Config = GenerateDeferredFrameTransformConfig;
+    using JobModel = render::Job::ModelO<GenerateDeferredFrameTransform, DeferredFrameTransformPointer, Config>;
 
     GenerateDeferredFrameTransform() {}
 
+    void configure(const Config& config);
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, DeferredFrameTransformPointer& frameTransform);
 
 private:
+    bool _foveated { false };
+    float _foveaRadius { 0.6f };
 };
 
 #endif // hifi_DeferredFrameTransform_h
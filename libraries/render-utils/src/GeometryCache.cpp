@@ -25,6 +25,7 @@
 #include "TextureCache.h"
 #include "RenderUtilsLogging.h"
 
+#include "gpu/BufferHeap.h"
 #include "gpu/StandardShaderLib.h"
 
 #include "model/TextureMap.h"
@@ -524,10 +525,11 @@ void GeometryCache::renderGrid(gpu::Batch& batch, const glm::vec2& minCorner, co
     // Make the gridbuffer
     if (registered && (!_registeredGridBuffers.contains(id) || _lastRegisteredGridBuffer[id] != key)) {
         GridSchema gridSchema;
-        GridBuffer gridBuffer = std::make_shared<gpu::Buffer>(sizeof(GridSchema), (const gpu::Byte*) &gridSchema);
-
+        GridBuffer gridBuffer;
         if (registered && _registeredGridBuffers.contains(id)) {
             gridBuffer = _registeredGridBuffers[id];
+        } else {
+            gridBuffer = gpu::BufferHeap::getShared()->allocate(sizeof(GridSchema), (const gpu::Byte*) &gridSchema);
         }
 
         _registeredGridBuffers[id] = gridBuffer;
@@ -1874,46 +1876,55 @@ uint32_t toCompactColor(const glm::vec4& color) {
 
 static const size_t INSTANCE_COLOR_BUFFER = 0;
 
-void renderInstances(gpu::Batch& batch, const glm::vec4& color, bool isWire,
-    const render::ShapePipelinePointer& pipeline, GeometryCache::Shape shape) {
-    // Add pipeline to name
-    std::string instanceName = (isWire ? "wire_shapes_" : "solid_shapes_") + std::to_string(shape) + "_" + std::to_string(std::hash<render::ShapePipelinePointer>()(pipeline));
-
-    // Add color to named buffer
-    {
-        gpu::BufferPointer instanceColorBuffer = batch.getNamedBuffer(instanceName, INSTANCE_COLOR_BUFFER);
-        auto compactColor = toCompactColor(color);
-        instanceColorBuffer->append(compactColor);
+const GeometryCache::ShapeInstanceCall& GeometryCache::getShapeInstanceCall(Shape shape, bool isWire,
+    const render::ShapePipelinePointer& pipeline) {
+    std::lock_guard<std::mutex> lock(_shapeInstanceCallsMutex);
+    auto& call = _shapeInstanceCalls[ShapeInstanceKey(pipeline.get(), shape, isWire)];
+    if (!call.function) {
+        // the function keeps the pipeline, so its address isn't reused for another bucket
+        call.name = (isWire ? "wire_shapes_" : "solid_shapes_") + std::to_string(shape) + "_" +
+            std::to_string(std::hash<render::ShapePipelinePointer>()(pipeline));
+        call.function = [isWire, pipeline, shape](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+            batch.setPipeline(pipeline->pipeline);
+            pipeline->prepare(batch);
+
+            if (isWire) {
+                DependencyManager::get<GeometryCache>()->renderWireShapeInstances(batch, shape, data.count(), data.buffers[INSTANCE_COLOR_BUFFER]);
+            } else {
+                DependencyManager::get<GeometryCache>()->renderShapeInstances(batch, shape, data.count(), data.buffers[INSTANCE_COLOR_BUFFER]);
+            }
+        };
     }
+    return call;
+}
 
-    // Add call to named buffer
-    batch.setupNamedCalls(instanceName, [isWire, pipeline, shape](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
-        batch.setPipeline(pipeline->pipeline);
-        pipeline->prepare(batch);
+void GeometryCache::renderShapeInstance(gpu::Batch& batch, Shape shape, bool isWire, const glm::vec4& color,
+    const render::ShapePipelinePointer& pipeline) {
+    const auto& call = getShapeInstanceCall(shape, isWire, pipeline);
 
-        if (isWire) {
-            DependencyManager::get<GeometryCache>()->renderWireShapeInstances(batch, shape, data.count(), data.buffers[INSTANCE_COLOR_BUFFER]);
-        } else {
-            DependencyManager::get<GeometryCache>()->renderShapeInstances(batch, shape, data.count(), data.buffers[INSTANCE_COLOR_BUFFER]);
-        }
-    });
+    // Add call and color to the named data of the bucket
+    auto& data = batch.setupNamedCalls(call.name, call.function);
+    if (data.buffers.empty()) {
+        data.buffers.push_back(std::make_shared<gpu::Buffer>());
+    }
+    data.buffers[INSTANCE_COLOR_BUFFER]->append(toCompactColor(color));
 }
 
 void GeometryCache::renderSolidShapeInstance(gpu::Batch& batch, GeometryCache::Shape shape, const glm::vec4& color, const render::ShapePipelinePointer& pipeline) {
-    renderInstances(batch, color, false, pipeline, shape);
+    renderShapeInstance(batch, shape, false, color, pipeline);
 }
 
 void GeometryCache::renderWireShapeInstance(gpu::Batch& batch, GeometryCache::Shape shape, const glm::vec4& color, const render::ShapePipelinePointer& pipeline) {
-    renderInstances(batch, color, true, pipeline, shape);
+    renderShapeInstance(batch, shape, true, color, pipeline);
 }
 
 
 void GeometryCache::renderSolidSphereInstance(gpu::Batch& batch, const glm::vec4& color, const render::ShapePipelinePointer& pipeline) {
-    renderInstances(batch, color, false, pipeline, GeometryCache::Sphere);
+    renderShapeInstance(batch, Sphere, false, color, pipeline);
 }
 
 void GeometryCache::renderWireSphereInstance(gpu::Batch& batch, const glm::vec4& color, const render::ShapePipelinePointer& pipeline) {
-    renderInstances(batch, color, true, pipeline, GeometryCache::Sphere);
+    renderShapeInstance(batch, Sphere, true, color, pipeline);
 }
 
 // Enable this in a debug build to cause 'box' entities to iterate through all the
@@ -1954,11 +1965,11 @@ void GeometryCache::renderSolidCubeInstance(gpu::Batch& batch, const glm::vec4&
         }
     });
 #else
-    renderInstances(batch, color, false, pipeline, GeometryCache::Cube);
+    renderShapeInstance(batch, Cube, false, color, pipeline);
 #endif
 }
 
 void GeometryCache::renderWireCubeInstance(gpu::Batch& batch, const glm::vec4& color, const render::ShapePipelinePointer& pipeline) {
     static const std::string INSTANCE_NAME = __FUNCTION__;
-    renderInstances(batch, color, true, pipeline, GeometryCache::Cube);
+    renderShapeInstance(batch, Cube, true, color, pipeline);
 }
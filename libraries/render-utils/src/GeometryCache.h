@@ -15,6 +15,9 @@
 #include "model-networking/ModelCache.h"
 
 #include <array>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 #include <QMap>
 #include <QRunnable>
@@ -345,6 +348,23 @@ private:
     typedef QPair<int, int> IntPair;
     typedef QPair<unsigned int, unsigned int> VerticesIndices;
 
+    // The named call of the instances of a shape, wire or solid, with a pipeline
+    //   Every draw of a shape instance into a batch lands in the call of its bucket, whichever item it came from, and
+    //   the call draws them all with one instanced draw of their colors; the name and function of a bucket are made
+    //   the first time it's drawn rather than on every draw.
+    struct ShapeInstanceCall {
+        std::string name;
+        gpu::Batch::NamedBatchData::Function function;
+    };
+    using ShapeInstanceKey = std::tuple<const render::ShapePipeline*, Shape, bool>;
+
+    void renderShapeInstance(gpu::Batch& batch, Shape shape, bool isWire, const glm::vec4& color,
+        const render::ShapePipelinePointer& pipeline);
+    const ShapeInstanceCall& getShapeInstanceCall(Shape shape, bool isWire, const render::ShapePipelinePointer& pipeline);
+
+    std::mutex _shapeInstanceCallsMutex;
+    std::map<ShapeInstanceKey, ShapeInstanceCall> _shapeInstanceCalls;
+
     gpu::PipelinePointer _standardDrawPipeline;
     gpu::PipelinePointer _standardDrawPipelineNoBlend;
 
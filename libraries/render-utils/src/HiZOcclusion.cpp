@@ -0,0 +1,327 @@
+//
+//  HiZOcclusion.cpp
+//  libraries/render-utils/src/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "HiZOcclusion.h"
+
+#include <QtGui/QImage>
+
+#include <NumericalConstants.h>
+#include <ViewFrustum.h>
+#include <gpu/Context.h>
+#include <gpu/StandardShaderLib.h>
+
+#include "hiZOcclusion_makeLevel_frag.h"
+#include "hiZOcclusion_testBounds_vert.h"
+#include "hiZOcclusion_testBounds_frag.h"
+
+const int HiZOcclusion_ParamsSlot = 0;
+const int HiZOcclusion_SourceMapSlot = 0;
+const int HiZOcclusion_LevelMapSlot = 0;
+
+// The results are only used while the eye stays about where it was when tested, they lag a couple of frames
+const float MAX_EYE_TRANSLATION = 0.01f; // meters
+const float MAX_EYE_ROTATION = 0.25f * RADIANS_PER_DEGREE;
+
+const size_t MAX_PENDING_TESTS = 3;
+
+
+void HiZOcclusionResults::setEnabled(bool enabled) {
+    _enabled = enabled;
+    if (!enabled) {
+        clear();
+    }
+}
+
+void HiZOcclusionResults::startReadback(const gpu::ContextPointer& context, const gpu::FramebufferPointer& framebuffer,
+                                        const TestPointer& test) {
+    // One texel per item, row after row
+    int numItems = (int)test->items.size();
+    int width = std::min(numItems, HiZOcclusion::RESULTS_WIDTH);
+    int height = (numItems + HiZOcclusion::RESULTS_WIDTH - 1) / HiZOcclusion::RESULTS_WIDTH;
+    test->readback = context->startFramebufferReadback(framebuffer, glm::ivec4(0, 0, width, height));
+    if (!test->readback) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pendingTests.push_back(test);
+    // Past a few frames behind, the results would hardly ever be used
+    while (_pendingTests.size() > MAX_PENDING_TESTS) {
+        _pendingTests.pop_front();
+    }
+}
+
+void HiZOcclusionResults::readFinishedTests() {
+    TestPointer test;
+    {
+        // The gpu finishes the tests in order: only the latest finished one is of use
+        std::lock_guard<std::mutex> lock(_mutex);
+        while (!_pendingTests.empty() && _pendingTests.front()->readback->isReady()) {
+            test = _pendingTests.front();
+            _pendingTests.pop_front();
+        }
+    }
+    if (!test) {
+        return;
+    }
+
+    int numItems = (int)test->items.size();
+    int height = (numItems + HiZOcclusion::RESULTS_WIDTH - 1) / HiZOcclusion::RESULTS_WIDTH;
+    QImage visibility(HiZOcclusion::RESULTS_WIDTH, height, QImage::Format_ARGB32);
+    if (!test->readback->read(visibility)) {
+        return;
+    }
+
+    std::unordered_set<render::ItemID> occludedItems;
+    for (int i = 0; i < numItems; i++) {
+        const QRgb* row = reinterpret_cast<const QRgb*>(visibility.constScanLine(i / HiZOcclusion::RESULTS_WIDTH));
+        if (qRed(row[i % HiZOcclusion::RESULTS_WIDTH]) < 128) {
+            occludedItems.insert(test->items[i]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_enabled) {
+        return;
+    }
+    _occludedItems.swap(occludedItems);
+    _eyePosition = test->eyePosition;
+    _eyeOrientation = test->eyeOrientation;
+    _valid = true;
+}
+
+int HiZOcclusionResults::filterOccluded(const ViewFrustum& view, const render::ItemBounds& inItems, render::ItemBounds& outItems) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    bool useResults = _valid && !_occludedItems.empty() &&
+        glm::distance(view.getPosition(), _eyePosition) <= MAX_EYE_TRANSLATION &&
+        glm::angle(view.getOrientation() * glm::inverse(_eyeOrientation)) <= MAX_EYE_ROTATION;
+    if (!useResults) {
+        outItems = inItems;
+        return 0;
+    }
+
+    outItems.clear();
+    outItems.reserve(inItems.size());
+    for (const auto& itemBound : inItems) {
+        if (_occludedItems.find(itemBound.id) == _occludedItems.end()) {
+            outItems.emplace_back(itemBound);
+        }
+    }
+    return (int)(inItems.size() - outItems.size());
+}
+
+void HiZOcclusionResults::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pendingTests.clear();
+    _occludedItems.clear();
+    _valid = false;
+}
+
+
+void HiZOcclusion::configure(const Config& config) {
+    _cullOccluded = config.cullOccluded;
+    _results->setEnabled(_cullOccluded);
+}
+
+void HiZOcclusion::allocatePyramid(const glm::ivec2& frameSize) {
+    _frameSize = frameSize;
+    glm::ivec2 levelSize = frameSize;
+    for (int level = 0; level < NUM_LEVELS; level++) {
+        // Round up so the last texel of an odd level covers its last source texel
+        levelSize = glm::max((levelSize + glm::ivec2(1)) >> 1, glm::ivec2(1));
+        _levelTextures[level] = gpu::TexturePointer(gpu::Texture::createRenderBuffer(gpu::Element(gpu::SCALAR, gpu::FLOAT, gpu::RGB),
+            levelSize.x, levelSize.y, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT)));
+        _levelFramebuffers[level] = gpu::FramebufferPointer(gpu::Framebuffer::create("hiZLevel" + std::to_string(level)));
+        _levelFramebuffers[level]->setRenderBuffer(0, _levelTextures[level]);
+    }
+}
+
+void HiZOcclusion::allocateResults(int numItems) {
+    if (_resultsFramebuffer && numItems <= _resultsCapacity) {
+        return;
+    }
+    // Grow by whole rows, with room to spare
+    int height = (3 * numItems / 2 + RESULTS_WIDTH - 1) / RESULTS_WIDTH;
+    _resultsCapacity = height * RESULTS_WIDTH;
+    auto resultsTexture = gpu::TexturePointer(gpu::Texture::createRenderBuffer(gpu::Element::COLOR_RGBA_32, RESULTS_WIDTH, height,
+        gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT)));
+    _resultsFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("hiZOcclusionResults"));
+    _resultsFramebuffer->setRenderBuffer(0, resultsTexture);
+}
+
+void HiZOcclusion::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    RenderArgs* args = renderContext->args;
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+
+    // The pyramid is of the linear depth of both eyes side by side in stereo, which the test doesn't project to: skip
+    if (!_cullOccluded || args->_context->isStereo()) {
+        _results->clear();
+        config->numTested = 0;
+        return;
+    }
+
+    const auto& inItems = inputs.get0();
+    const auto& linearDepthFramebuffer = inputs.get1();
+
+    if (!_gpuTimer) {
+        _gpuTimer = std::make_shared<gpu::RangeTimer>(__FUNCTION__);
+    }
+    if (!_boundsFormat) {
+        _boundsFormat = std::make_shared<gpu::Stream::Format>();
+        _boundsFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ, offsetof(TestedBound, corner));
+        _boundsFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element::VEC3F_XYZ, offsetof(TestedBound, scale));
+        _boundsBuffer = std::make_shared<gpu::Buffer>();
+    }
+
+    auto frameSize = linearDepthFramebuffer->getDepthFrameSize();
+    if (_frameSize != frameSize) {
+        allocatePyramid(frameSize);
+    }
+
+    int numItems = (int)inItems.size();
+    allocateResults(numItems);
+
+    auto test = std::make_shared<HiZOcclusionResults::Test>();
+    test->items.reserve(numItems);
+    std::vector<TestedBound> bounds;
+    bounds.reserve(numItems);
+    for (const auto& itemBound : inItems) {
+        test->items.push_back(itemBound.id);
+        bounds.push_back({ itemBound.bound.getCorner(), itemBound.bound.getScale() });
+    }
+    test->eyePosition = args->getViewFrustum().getPosition();
+    test->eyeOrientation = args->getViewFrustum().getOrientation();
+    if (numItems > 0) {
+        _boundsBuffer->setData(numItems * sizeof(TestedBound), (const gpu::Byte*)bounds.data());
+    }
+
+    int resultsHeight = (numItems + RESULTS_WIDTH - 1) / RESULTS_WIDTH;
+    _parametersBuffer.edit().viewport = args->_viewport;
+    _parametersBuffer.edit().levelsAndResults.z = resultsHeight;
+    config->numTested = numItems;
+
+    auto linearDepthTexture = linearDepthFramebuffer->getLinearDepthTexture();
+    auto makeLevelPipeline = getMakeLevelPipeline();
+    auto testBoundsPipeline = getTestBoundsPipeline();
+    auto results = _results;
+    auto context = args->_context;
+
+    gpu::doInBatch(args->_context, [=](gpu::Batch& batch) {
+        _gpuTimer->begin(batch);
+
+        // Take the results of the earlier tests the gpu is done with, without waiting on the ones it isn't
+        batch.runLambda([results] {
+            results->readFinishedTests();
+        });
+
+        batch.enableStereo(false);
+        batch.setProjectionTransform(glm::mat4());
+        batch.resetViewTransform();
+        batch.setModelTransform(Transform());
+
+        // Each level is the farthest depth of the 2 by 2 texels of the level before
+        batch.setPipeline(makeLevelPipeline);
+        for (int level = 0; level < NUM_LEVELS; level++) {
+            auto levelSize = glm::ivec2(_levelTextures[level]->getDimensions());
+            batch.setViewportTransform(glm::ivec4(0, 0, levelSize));
+            batch.setFramebuffer(_levelFramebuffers[level]);
+            batch.setResourceTexture(HiZOcclusion_SourceMapSlot, (level == 0 ? linearDepthTexture : _levelTextures[level - 1]));
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+        }
+        batch.setResourceTexture(HiZOcclusion_SourceMapSlot, nullptr);
+
+        if (numItems > 0) {
+            // One point per item bound, writing its visibility in its texel of the results
+            Transform viewMat;
+            glm::mat4 projMat;
+            args->getViewFrustum().evalProjectionMatrix(projMat);
+            args->getViewFrustum().evalViewTransform(viewMat);
+            batch.setProjectionTransform(projMat);
+            batch.setViewTransform(viewMat);
+
+            batch.setViewportTransform(glm::ivec4(0, 0, RESULTS_WIDTH, resultsHeight));
+            batch.setFramebuffer(_resultsFramebuffer);
+            batch.setPipeline(testBoundsPipeline);
+            batch.setUniformBuffer(HiZOcclusion_ParamsSlot, _parametersBuffer);
+            for (int level = 0; level < NUM_LEVELS; level++) {
+                batch.setResourceTexture(HiZOcclusion_LevelMapSlot + level, _levelTextures[level]);
+            }
+            batch.setInputFormat(_boundsFormat);
+            batch.setInputBuffer(0, _boundsBuffer, 0, sizeof(TestedBound));
+            batch.draw(gpu::POINTS, numItems);
+
+            for (int level = 0; level < NUM_LEVELS; level++) {
+                batch.setResourceTexture(HiZOcclusion_LevelMapSlot + level, nullptr);
+            }
+
+            // Copied out before the next frame's test draws over them, read when the gpu is done
+            auto resultsFramebuffer = _resultsFramebuffer;
+            batch.runLambda([results, context, resultsFramebuffer, test] {
+                results->startReadback(context, resultsFramebuffer, test);
+            });
+        }
+
+        _gpuTimer->end(batch);
+    });
+
+    config->setGPUBatchRunTime(_gpuTimer->getGPUAverage(), _gpuTimer->getBatchAverage());
+}
+
+const gpu::PipelinePointer& HiZOcclusion::getMakeLevelPipeline() {
+    if (!_makeLevelPipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawViewportQuadTransformTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(hiZOcclusion_makeLevel_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("sourceMap"), HiZOcclusion_SourceMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+        state->setColorWriteMask(true, false, false, false);
+
+        _makeLevelPipeline = gpu::Pipeline::create(program, state);
+    }
+
+    return _makeLevelPipeline;
+}
+
+const gpu::PipelinePointer& HiZOcclusion::getTestBoundsPipeline() {
+    if (!_testBoundsPipeline) {
+        auto vs = gpu::Shader::createVertex(std::string(hiZOcclusion_testBounds_vert));
+        auto ps = gpu::Shader::createPixel(std::string(hiZOcclusion_testBounds_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("hiZParametersBuffer"), HiZOcclusion_ParamsSlot));
+        for (int level = 0; level < NUM_LEVELS; level++) {
+            slotBindings.insert(gpu::Shader::Binding(std::string("hiZLevel") + std::to_string(level), HiZOcclusion_LevelMapSlot + level));
+        }
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+
+        _testBoundsPipeline = gpu::Pipeline::create(program, state);
+    }
+
+    return _testBoundsPipeline;
+}
+
+
+void FilterOccludedItems::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const render::ItemBounds& inItems, render::ItemBounds& outItems) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    config->numItems = (int)inItems.size();
+    config->numOccluded = _results->filterOccluded(renderContext->args->getViewFrustum(), inItems, outItems);
+}
@@ -0,0 +1,167 @@
+//
+//  HiZOcclusion.h
+//  libraries/render-utils/src/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HiZOcclusion_h
+#define hifi_HiZOcclusion_h
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "render/DrawTask.h"
+#include "SurfaceGeometryPass.h"
+
+
+// HiZOcclusionResults gathers the opaque items found occluded by the last Hi-Z test read back from the gpu,
+// and the view they were tested from.
+// The thread executing the batches reads them back from the gpu once the gpu is done with a test, a frame or more
+// after it was drawn, and the filter reads them at the start of a later frame.
+class HiZOcclusionResults {
+public:
+    class Test {
+    public:
+        render::ItemIDs items;
+        gpu::FramebufferReadbackPointer readback;
+        glm::vec3 eyePosition;
+        glm::quat eyeOrientation;
+    };
+    using TestPointer = std::shared_ptr<Test>;
+
+    // Is the culling on, as configured on the test
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    // Batch thread: the test of the bounds of items has been drawn in the framebuffer, start reading it back
+    void startReadback(const gpu::ContextPointer& context, const gpu::FramebufferPointer& framebuffer, const TestPointer& test);
+    // Batch thread: read back the latest of the pending tests the gpu has finished, if any, and update the results
+    void readFinishedTests();
+
+    // Filter the items the last test found occluded out of inItems, if the view is still close to the tested one
+    // Returns the number of items culled
+    int filterOccluded(const ViewFrustum& view, const render::ItemBounds& inItems, render::ItemBounds& outItems) const;
+
+    void clear();
+
+protected:
+    mutable std::mutex _mutex;
+    std::atomic<bool> _enabled { false };
+    std::deque<TestPointer> _pendingTests;
+    std::unordered_set<render::ItemID> _occludedItems;
+    glm::vec3 _eyePosition;
+    glm::quat _eyeOrientation;
+    bool _valid { false };
+};
+using HiZOcclusionResultsPointer = std::shared_ptr<HiZOcclusionResults>;
+
+
+class HiZOcclusionConfig : public render::GPUJobConfig {
+    Q_OBJECT
+    Q_PROPERTY(bool cullOccluded MEMBER cullOccluded NOTIFY dirty)
+    Q_PROPERTY(int numTested READ getNumTested)
+public:
+    bool cullOccluded{ true };
+
+    int numTested{ 0 };
+    int getNumTested() { return numTested; }
+
+signals:
+    void dirty();
+};
+
+// HiZOcclusion builds the hierarchical Z pyramid, the farthest linear depth per texel halving the resolution level
+// after level, from the linear depth of the frame, and tests the bounds of the opaque items against it
+class HiZOcclusion {
+public:
+    using Inputs = render::VaryingSet2<render::ItemBounds, LinearDepthFramebufferPointer>;
+    using Config = HiZOcclusionConfig;
+    using JobModel = render::Job::ModelI<HiZOcclusion, Inputs, Config>;
+
+    HiZOcclusion(const HiZOcclusionResultsPointer& results) : _results(results) {}
+
+    void configure(const Config& config);
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+    static const int NUM_LEVELS { 6 };
+    static const int RESULTS_WIDTH { 256 };
+
+private:
+    // Class describing the uniform buffer with the parameters of the test
+    class Parameters {
+    public:
+        // viewport of the frame in the linear depth
+        glm::ivec4 viewport { 0 };
+        // x: number of levels, y: results width, z: results height
+        glm::ivec4 levelsAndResults { NUM_LEVELS, RESULTS_WIDTH, 0, 0 };
+
+        Parameters() {}
+    };
+    gpu::StructBuffer<Parameters> _parametersBuffer;
+
+    void allocatePyramid(const glm::ivec2& frameSize);
+    void allocateResults(int numItems);
+
+    const gpu::PipelinePointer& getMakeLevelPipeline();
+    const gpu::PipelinePointer& getTestBoundsPipeline();
+
+    class TestedBound {
+    public:
+        glm::vec3 corner;
+        glm::vec3 scale;
+    };
+
+    HiZOcclusionResultsPointer _results;
+
+    glm::ivec2 _frameSize { 0 };
+    std::array<gpu::TexturePointer, NUM_LEVELS> _levelTextures;
+    std::array<gpu::FramebufferPointer, NUM_LEVELS> _levelFramebuffers;
+    gpu::FramebufferPointer _resultsFramebuffer;
+    int _resultsCapacity { 0 };
+
+    gpu::Stream::FormatPointer _boundsFormat;
+    gpu::BufferPointer _boundsBuffer;
+
+    gpu::PipelinePointer _makeLevelPipeline;
+    gpu::PipelinePointer _testBoundsPipeline;
+
+    gpu::RangeTimerPointer _gpuTimer;
+    bool _cullOccluded { true };
+};
+
+
+class FilterOccludedItemsConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(int numItems READ getNumItems)
+    Q_PROPERTY(int numOccluded READ getNumOccluded)
+public:
+    int numItems{ 0 };
+    int getNumItems() { return numItems; }
+    int numOccluded{ 0 };
+    int getNumOccluded() { return numOccluded; }
+};
+
+// FilterOccludedItems drops the items the last HiZOcclusion test found occluded, before they are drawn
+class FilterOccludedItems {
+public:
+    using Config = FilterOccludedItemsConfig;
+    using JobModel = render::Job::ModelIO<FilterOccludedItems, render::ItemBounds, render::ItemBounds, Config>;
+
+    FilterOccludedItems(const HiZOcclusionResultsPointer& results) : _results(results) {}
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const render::ItemBounds& inItems, render::ItemBounds& outItems);
+
+private:
+    HiZOcclusionResultsPointer _results;
+};
+
+#endif // hifi_HiZOcclusion_h
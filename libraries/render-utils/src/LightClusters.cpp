@@ -12,6 +12,8 @@
 #include "RenderUtilsLogging.h"
 
 
+#include <tbb/parallel_for.h>
+
 #include <gpu/Context.h>
 
 #include <gpu/StandardShaderLib.h>
@@ -236,15 +238,15 @@ bool reduceSphereToPlane(const glm::vec4& sphere, const glm::vec4& plane, glm::v
 }
 
 
-uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
+uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    LightClusters::ClusterEntries& entries) {
     glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
 
     for (auto y = yMin; (y <= yMax); y++) {
         for (auto x = xMin; (x <= xMax); x++) {
             auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * zSlice;
-            clusterGrid[index].emplace_back(lightId);
+            entries.push_back({ LightClusters::toClusterEntryBin(index, isSpot), (LightClusters::LightIndex)lightId });
             numClustersTouched++;
         }
     }
@@ -252,8 +254,8 @@ uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes pl
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
+uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    LightClusters::ClusterEntries& entries) {
     glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
 
@@ -261,7 +263,7 @@ uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[
         for (auto y = yMin; (y <= yMax); y++) {
             for (auto x = xMin; (x <= xMax); x++) {
                 auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * z;
-                clusterGrid[index].emplace_back(lightId);
+                entries.push_back({ LightClusters::toClusterEntryBin(index, isSpot), (LightClusters::LightIndex)lightId });
                 numClustersTouched++;
             }
         }
@@ -270,10 +272,11 @@ uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
+uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    LightClusters::ClusterEntries& entries) {
     glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
+    int numClusters = grid.frustumGrid_numClusters();
     const auto& xPlanes = planes[0];
     const auto& yPlanes = planes[1];
     const auto& zPlanes = planes[2];
@@ -324,11 +327,11 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
 
             for (; (x <= xs); x++) {
                 auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
-                if (index < (int)clusterGrid.size()) {
-                    clusterGrid[index].emplace_back(lightId);
+                if (index < numClusters) {
+                    entries.push_back({ LightClusters::toClusterEntryBin(index, isSpot), (LightClusters::LightIndex)lightId });
                     numClustersTouched++;
                 } else {
-                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
+                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << numClusters << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
                 }
             }
         }
@@ -337,181 +340,210 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
     return numClustersTouched;
 }
 
-glm::ivec3 LightClusters::updateClusters() {
-    // Make sure resource are in good shape
-    updateClusterResource();
+bool LightClusters::clusterLight(FrustumGrid& theFrustumGrid, LightID lightId, ClusterEntries& entries) const {
+    auto light = _lightStage->getLight(lightId);
+    if (!light) {
+        return false;
+    }
 
-    // Clean up last info
-    uint32_t numClusters = (uint32_t)_clusterGrid.size();
+    auto worldOri = light->getPosition();
+    auto radius = light->getMaximumRadius();
+    bool isSpot = light->isSpot();
 
-    std::vector< std::vector< LightIndex > > clusterGridPoint(numClusters);
-    std::vector< std::vector< LightIndex > > clusterGridSpot(numClusters);
+    // Bring into frustum eye space
+    auto eyeOri = theFrustumGrid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
 
-    _clusterGrid.clear();
-    _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
+    // Remove light that slipped through and is not in the z range
+    float eyeZMax = eyeOri.z - radius;
+    if (eyeZMax > -theFrustumGrid.rangeNear) {
+        return false;
+    }
+    float eyeZMin = eyeOri.z + radius;
+    bool beyondFar = false;
+    if (eyeZMin < -theFrustumGrid.rangeFar) {
+        beyondFar = true;
+    }
 
-    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
-    _clusterContent.clear();
-    _clusterContent.resize(maxNumIndices, INVALID_LIGHT);
+    // Get z slices
+    int zMin = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
+    int zMax = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
+    // That should never happen
+    if (zMin == -2 && zMax == -2) {
+        return false;
+    }
 
+    // Before Range NEar just apss, range neatr == true near for now
+    if ((zMin == -1) && (zMax == -1)) {
+        return false;
+    }
 
-    auto theFrustumGrid(_frustumGridBuffer.get());
+    // CLamp the z range 
+    zMin = std::max(0, zMin);
 
-    glm::ivec3 gridPosToOffset(1, theFrustumGrid.dims.x, theFrustumGrid.dims.x * theFrustumGrid.dims.y);
+    auto xLeftDistance = radius - distanceToPlane(eyeOri, _gridPlanes[0][0]);
+    auto xRightDistance = radius + distanceToPlane(eyeOri, _gridPlanes[0].back());
 
-    uint32_t numClusterTouched = 0;
-    uint32_t numLightsIn = _visibleLightIndices[0];
-    uint32_t numClusteredLights = 0;
-    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
-        auto lightId = _visibleLightIndices[lightNum];
-        auto light = _lightStage->getLight(lightId);
-        if (!light) {
-            continue;
-        }
+    auto yBottomDistance = radius - distanceToPlane(eyeOri, _gridPlanes[1][0]);
+    auto yTopDistance = radius + distanceToPlane(eyeOri, _gridPlanes[1].back());
 
-        auto worldOri = light->getPosition();
-        auto radius = light->getMaximumRadius();
-        bool isSpot = light->isSpot();
+    if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
+        return false;
+    }
 
-        // Bring into frustum eye space
-        auto eyeOri = theFrustumGrid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
+    // find 2D corners of the sphere in grid
+    int xMin { 0 };
+    int xMax { theFrustumGrid.dims.x - 1 };
+    int yMin { 0 };
+    int yMax { theFrustumGrid.dims.y - 1 };
 
-        // Remove light that slipped through and is not in the z range
-        float eyeZMax = eyeOri.z - radius;
-        if (eyeZMax > -theFrustumGrid.rangeNear) {
-            continue;
-        }
-        float eyeZMin = eyeOri.z + radius;
-        bool beyondFar = false;
-        if (eyeZMin < -theFrustumGrid.rangeFar) {
-            beyondFar = true;
-        }
+    float radius2 = radius * radius;
 
-        // Get z slices
-        int zMin = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
-        int zMax = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
-        // That should never happen
-        if (zMin == -2 && zMax == -2) {
-            continue;
-        }
+    auto eyeOriH = glm::vec3(eyeOri);
+    auto eyeOriV = glm::vec3(eyeOri);
 
-        // Before Range NEar just apss, range neatr == true near for now
-        if ((zMin == -1) && (zMax == -1)) {
-            continue;
-        }
+    eyeOriH.y = 0.0f;
+    eyeOriV.x = 0.0f;
 
-        // CLamp the z range 
-        zMin = std::max(0, zMin);
+    float eyeOriLen2H = glm::length2(eyeOriH);
+    float eyeOriLen2V = glm::length2(eyeOriV);
 
-        auto xLeftDistance = radius - distanceToPlane(eyeOri, _gridPlanes[0][0]);
-        auto xRightDistance = radius + distanceToPlane(eyeOri, _gridPlanes[0].back());
+    if ((eyeOriLen2H > radius2)) {
+        float eyeOriLenH = sqrt(eyeOriLen2H);
 
-        auto yBottomDistance = radius - distanceToPlane(eyeOri, _gridPlanes[1][0]);
-        auto yTopDistance = radius + distanceToPlane(eyeOri, _gridPlanes[1].back());
+        auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
 
-        if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
-            continue;
-        }
+        float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
 
-        // find 2D corners of the sphere in grid
-        int xMin { 0 };
-        int xMax { theFrustumGrid.dims.x - 1 };
-        int yMin { 0 };
-        int yMax { theFrustumGrid.dims.y - 1 };
+        float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
 
-        float radius2 = radius * radius;
+        float eyeToTangentCircleSinH = radius / eyeOriLenH;
 
-        auto eyeOriH = glm::vec3(eyeOri);
-        auto eyeOriV = glm::vec3(eyeOri);
 
-        eyeOriH.y = 0.0f;
-        eyeOriV.x = 0.0f;
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
+        glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
 
-        float eyeOriLen2H = glm::length2(eyeOriH);
-        float eyeOriLen2V = glm::length2(eyeOriV);
+        auto lc = theFrustumGrid.frustumGrid_eyeToClusterDirH(leftDir);
+        if (lc > xMax) {
+            lc = xMin;
+        }
+        auto rc = theFrustumGrid.frustumGrid_eyeToClusterDirH(rightDir);
+        if (rc < 0) {
+            rc = xMax;
+        }
+        xMin = std::max(xMin, lc);
+        xMax = std::min(rc, xMax);
+        assert(xMin <= xMax);
+    }
 
-        if ((eyeOriLen2H > radius2)) {
-            float eyeOriLenH = sqrt(eyeOriLen2H);
+    if ((eyeOriLen2V > radius2)) {
+        float eyeOriLenV = sqrt(eyeOriLen2V);
 
-            auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
+        auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
 
-            float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
+        float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
 
-            float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
+        float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
 
-            float eyeToTangentCircleSinH = radius / eyeOriLenH;
+        float eyeToTangentCircleSinV = radius / eyeOriLenV;
 
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
-            glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+        glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
 
-            auto lc = theFrustumGrid.frustumGrid_eyeToClusterDirH(leftDir);
-            if (lc > xMax) {
-                lc = xMin;
-            }
-            auto rc = theFrustumGrid.frustumGrid_eyeToClusterDirH(rightDir);
-            if (rc < 0) {
-                rc = xMax;
-            }
-            xMin = std::max(xMin, lc);
-            xMax = std::min(rc, xMax);
-            assert(xMin <= xMax);
+        auto bc = theFrustumGrid.frustumGrid_eyeToClusterDirV(bottomDir);
+        auto tc = theFrustumGrid.frustumGrid_eyeToClusterDirV(topDir);
+        if (bc > yMax) {
+            bc = yMin;
+        }
+        if (tc < 0) {
+            tc = yMax;
         }
+        yMin = std::max(yMin, bc);
+        yMax =std::min(tc, yMax);
+        assert(yMin <= yMax);
+    }
 
-        if ((eyeOriLen2V > radius2)) {
-            float eyeOriLenV = sqrt(eyeOriLen2V);
+    // now voxelize
+    auto eyePosRadius = glm::vec4(glm::vec3(eyeOri), radius);
+    if (beyondFar) {
+        scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, isSpot, eyePosRadius, entries);
+    } else {
+        scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, isSpot, eyePosRadius, entries);
+    }
 
-            auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
+    return true;
+}
 
-            float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
+glm::ivec3 LightClusters::updateClusters() {
+    // Make sure resource are in good shape
+    updateClusterResource();
 
-            float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
+    // Clean up last info
+    uint32_t numClusters = (uint32_t)_clusterGrid.size();
 
-            float eyeToTangentCircleSinV = radius / eyeOriLenV;
+    _clusterGrid.clear();
+    _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
 
+    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
-            glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+    auto theFrustumGrid(_frustumGridBuffer.get());
 
-            auto bc = theFrustumGrid.frustumGrid_eyeToClusterDirV(bottomDir);
-            auto tc = theFrustumGrid.frustumGrid_eyeToClusterDirV(topDir);
-            if (bc > yMax) {
-                bc = yMin;
-            }
-            if (tc < 0) {
-                tc = yMax;
+    uint32_t numLightsIn = _visibleLightIndices[0];
+    uint32_t numVisibleLights = (uint32_t)_visibleLightIndices.size() - 1;
+
+    // Voxelize the lights in chunks, across workers when there are many, each chunk gathering the clusters its lights touch
+    uint32_t numChunks = (numVisibleLights + LIGHTS_PER_TASK - 1) / LIGHTS_PER_TASK;
+    if (_chunkEntries.size() < numChunks) {
+        _chunkEntries.resize(numChunks);
+    }
+    _chunkNumClusteredLights.assign(numChunks, 0);
+
+    auto clusterChunks = [&](const tbb::blocked_range<uint32_t>& range) {
+        for (auto chunk = range.begin(); chunk != range.end(); ++chunk) {
+            auto& entries = _chunkEntries[chunk];
+            entries.clear();
+            auto lightEnd = std::min(numVisibleLights, (chunk + 1) * LIGHTS_PER_TASK);
+            for (auto lightNum = chunk * LIGHTS_PER_TASK; lightNum < lightEnd; ++lightNum) {
+                if (clusterLight(theFrustumGrid, _visibleLightIndices[lightNum + 1], entries)) {
+                    _chunkNumClusteredLights[chunk]++;
+                }
             }
-            yMin = std::max(yMin, bc);
-            yMax =std::min(tc, yMax);
-            assert(yMin <= yMax);
         }
+    };
+    if (numChunks > 1) {
+        tbb::parallel_for(tbb::blocked_range<uint32_t>(0, numChunks, 1), clusterChunks);
+    } else {
+        clusterChunks(tbb::blocked_range<uint32_t>(0, numChunks));
+    }
 
-        // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
-        if (beyondFar) {
-            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        } else {
-            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
+    // Count the point then the spot lights of each cluster
+    _clusterBinOffsets.assign(numClusters * 2, 0);
+    _clusterBinEnds.assign(numClusters * 2, 0);
+    uint32_t numClusterTouched = 0;
+    uint32_t numClusteredLights = 0;
+    for (uint32_t chunk = 0; chunk < numChunks; ++chunk) {
+        for (const auto& entry : _chunkEntries[chunk]) {
+            _clusterBinOffsets[entry.bin]++;
         }
-
-        numClusteredLights++;
+        numClusterTouched += (uint32_t)_chunkEntries[chunk].size();
+        numClusteredLights += _chunkNumClusteredLights[chunk];
     }
 
     // Lights have been gathered now reexpress in terms of 2 sequential buffers
-    // Start filling from near to far and stops if it overflows
+    // Start filling from near to far and stops if it overflows,
+    // the counts become the offsets where the lights of each cluster are written next
     bool checkBudget = false;
     if (numClusterTouched > maxNumIndices) {
         checkBudget = true;
     }
     uint16_t indexOffset = 0;
-    for (int i = 0; i < (int) clusterGridPoint.size(); i++) {
-        auto& clusterPoint = clusterGridPoint[i];
-        auto& clusterSpot = clusterGridSpot[i];
-
-        uint8_t numLightsPoint = ((uint8_t)clusterPoint.size());
-        uint8_t numLightsSpot = ((uint8_t)clusterSpot.size());
+    uint32_t numFilledClusters = 0;
+    for (uint32_t i = 0; i < numClusters; i++) {
+        // More than 255 lights of a kind in a cluster can't be encoded, the extra ones are dropped
+        uint8_t numLightsPoint = (uint8_t)std::min(_clusterBinOffsets[i * 2], (uint32_t)MAX_CLUSTER_LIGHTS);
+        uint8_t numLightsSpot = (uint8_t)std::min(_clusterBinOffsets[i * 2 + 1], (uint32_t)MAX_CLUSTER_LIGHTS);
         uint16_t numLights = numLightsPoint + numLightsSpot;
         uint16_t offset = indexOffset;
 
@@ -525,14 +557,21 @@ glm::ivec3 LightClusters::updateClusters() {
         // Encode the cluster grid: [ ContentOffset - 16bits, Num Point LIghts - 8bits, Num Spot Lights - 8bits] 
         _clusterGrid[i] = (uint32_t)((0xFF000000 & (numLightsSpot << 24)) | (0x00FF0000 & (numLightsPoint << 16)) | (0x0000FFFF & offset));
 
+        _clusterBinOffsets[i * 2] = offset;
+        _clusterBinEnds[i * 2] = offset + numLightsPoint;
+        _clusterBinOffsets[i * 2 + 1] = offset + numLightsPoint;
+        _clusterBinEnds[i * 2 + 1] = offset + numLights;
+        indexOffset += numLights;
+        numFilledClusters++;
+    }
 
-        if (numLightsPoint) {
-            memcpy(_clusterContent.data() + indexOffset, clusterPoint.data(), numLightsPoint * sizeof(LightIndex));
-            indexOffset += numLightsPoint;
-        }
-        if (numLightsSpot) {
-            memcpy(_clusterContent.data() + indexOffset, clusterSpot.data(), numLightsSpot * sizeof(LightIndex));
-            indexOffset += numLightsSpot;
+    // Write the lights of the clusters filled in, in the order they were voxelized
+    for (uint32_t chunk = 0; chunk < numChunks; ++chunk) {
+        for (const auto& entry : _chunkEntries[chunk]) {
+            auto& binOffset = _clusterBinOffsets[entry.bin];
+            if ((entry.bin / 2 < numFilledClusters) && (binOffset < _clusterBinEnds[entry.bin])) {
+                _clusterContent[binOffset++] = entry.light;
+            }
         }
     }
 
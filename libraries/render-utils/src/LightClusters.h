@@ -83,6 +83,9 @@ public:
 
     glm::ivec3  updateClusters();
 
+    // The bin of a light in a cluster, its point lights then its spot lights
+    static uint32_t toClusterEntryBin(int cluster, bool isSpot) { return (uint32_t)cluster * 2 + (isSpot ? 1 : 0); }
+
 
     ViewFrustum _frustum;
 
@@ -111,6 +114,24 @@ public:
 
     bool _clusterResourcesInvalid { true };
     void updateClusterResource();
+
+    // The clusters touched by the lights, voxelized in chunks of lights across workers, then sorted per cluster
+    class ClusterEntry {
+    public:
+        uint32_t bin;
+        LightIndex light;
+    };
+    using ClusterEntries = std::vector<ClusterEntry>;
+    static const uint32_t LIGHTS_PER_TASK { 32 };
+    static const uint32_t MAX_CLUSTER_LIGHTS { 0xFF };
+
+    std::vector<ClusterEntries> _chunkEntries;
+    std::vector<uint32_t> _chunkNumClusteredLights;
+    std::vector<uint32_t> _clusterBinOffsets;
+    std::vector<uint32_t> _clusterBinEnds;
+
+    // Voxelize a light in the grid, returns false if it's out of it
+    bool clusterLight(FrustumGrid& grid, LightID lightId, ClusterEntries& entries) const;
 };
 
 using LightClustersPointer = std::shared_ptr<LightClusters>;
@@ -37,8 +37,12 @@ void LightStage::Shadow::setKeylightFrustum(const ViewFrustum& viewFrustum, floa
     }
     _frustum->setOrientation(orientation);
 
-    // Position the keylight frustum
-    _frustum->setPosition(viewFrustum.getPosition() - (nearDepth + farDepth)*direction);
+    // Position the keylight frustum, snapped on a grid aligned with it so it stays put while the view moves a little,
+    // and the static casters rendered in its map can be reused
+    const float SNAP_SIZE = 0.5f;
+    auto position = glm::inverse(orientation) * (viewFrustum.getPosition() - (nearDepth + farDepth)*direction);
+    position = glm::floor(position / SNAP_SIZE) * SNAP_SIZE;
+    _frustum->setPosition(orientation * position);
 
     const Transform view{ _frustum->getView()};
     const Transform viewInverse{ view.getInverseMatrix() };
@@ -67,6 +71,8 @@ void LightStage::Shadow::setKeylightFrustum(const ViewFrustum& viewFrustum, floa
     fitFrustum(farCorners.bottomRight);
     fitFrustum(farCorners.topLeft);
     fitFrustum(farCorners.topRight);
+    min = glm::floor(min / SNAP_SIZE) * SNAP_SIZE;
+    max = glm::ceil(max / SNAP_SIZE) * SNAP_SIZE;
 
     glm::mat4 ortho = glm::ortho<float>(min.x, max.x, min.y, max.y, -max.z, -min.z);
     _frustum->setProjection(ortho);
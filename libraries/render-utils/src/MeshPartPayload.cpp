@@ -131,18 +131,20 @@ void MeshPartPayload::bindMesh(gpu::Batch& batch) const {
     }
 }
 
-void MeshPartPayload::bindMaterial(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, bool enableTextures) const {
-    if (!_drawMaterial) {
+// Also used by the instanced model parts' named calls, which outlive their payload's render()
+static void bindMaterialToBatch(gpu::Batch& batch, const std::shared_ptr<const model::Material>& material,
+                                const ShapePipeline::LocationsPointer& locations, bool enableTextures) {
+    if (!material) {
         return;
     }
 
-    auto textureCache = DependencyManager::get<TextureCache>();
+    auto textureCache = DependencyManager::getRaw<TextureCache>();
 
-    batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::MATERIAL, _drawMaterial->getSchemaBuffer());
-    batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::TEXMAPARRAY, _drawMaterial->getTexMapArrayBuffer());
+    batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::MATERIAL, material->getSchemaBuffer());
+    batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::TEXMAPARRAY, material->getTexMapArrayBuffer());
 
-    const auto& materialKey = _drawMaterial->getKey();
-    const auto& textureMaps = _drawMaterial->getTextureMaps();
+    const auto& materialKey = material->getKey();
+    const auto& textureMaps = material->getTextureMaps();
 
     int numUnlit = 0;
     if (materialKey.isUnlit()) {
@@ -264,6 +266,10 @@ void MeshPartPayload::bindMaterial(gpu::Batch& batch, const ShapePipeline::Locat
     }
 }
 
+void MeshPartPayload::bindMaterial(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, bool enableTextures) const {
+    bindMaterialToBatch(batch, _drawMaterial, locations, enableTextures);
+}
+
 void MeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, RenderArgs::RenderMode renderMode) const {
     batch.setModelTransform(_drawTransform);
 }
@@ -366,6 +372,9 @@ void ModelMeshPartPayload::initCache() {
     if (networkMaterial) {
         _drawMaterial = networkMaterial;
     }
+
+    _instanceNamePrefix = "model_parts_" + std::to_string((size_t)_drawMesh.get()) + "_" + std::to_string(_partIndex) +
+        "_" + std::to_string((size_t)_drawMaterial.get());
 }
 
 void ModelMeshPartPayload::notifyLocationChanged() {
@@ -373,7 +382,7 @@ void ModelMeshPartPayload::notifyLocationChanged() {
 }
 
 void ModelMeshPartPayload::updateTransformForSkinnedMesh(const Transform& renderTransform, const Transform& boundTransform,
-        const gpu::BufferPointer& buffer) {
+        const gpu::BufferView& buffer) {
     _transform = renderTransform;
     _worldBound = _adjustedLocalBound;
     _worldBound.transform(boundTransform);
@@ -500,14 +509,16 @@ ShapeKey ModelMeshPartPayload::getShapeKey() const {
 }
 
 void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) const {
-    if (!_isBlendShaped) {
-        batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
+    const auto& indexBuffer = (_lod > 0 ? _drawMesh->getLODIndexBuffer() : _drawMesh->getIndexBuffer())._buffer;
+    // Until the model is blended, its vertices are the ones of the geometry
+    if (!_isBlendShaped || _model->_blendedVertexBuffers[_meshIndex]->getSize() == 0) {
+        batch.setIndexBuffer(gpu::UINT32, indexBuffer, 0);
 
         batch.setInputFormat((_drawMesh->getVertexFormat()));
 
         batch.setInputStream(0, _drawMesh->getVertexStream());
     } else {
-        batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
+        batch.setIndexBuffer(gpu::UINT32, indexBuffer, 0);
 
         batch.setInputFormat((_drawMesh->getVertexFormat()));
 
@@ -525,7 +536,7 @@ void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) const {
 
 void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, RenderArgs::RenderMode renderMode) const {
     // Still relying on the raw data from the model
-    if (_clusterBuffer) {
+    if (_clusterBuffer._buffer) {
         batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::SKINNING, _clusterBuffer);
     }
     batch.setModelTransform(_transform);
@@ -574,7 +585,23 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     if (!args) {
         return;
     }
-    if (!getShapeKey().isValid()) {
+    const ShapeKey key = getShapeKey();
+    if (!key.isValid()) {
+        return;
+    }
+
+    // Pick the level of detail from the size of the part in the main view, the other views reuse the last one picked
+    if (args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE) {
+        _lod = evalLOD(args);
+    } else if (_lod >= _drawMesh->getNumPartLODs(_partIndex)) {
+        _lod = 0;
+    }
+    const auto drawPart = _drawMesh->getPartLOD(_partIndex, _lod);
+
+    const int INDICES_PER_TRIANGLE = 3;
+    if (canRenderInstanced(args, key)) {
+        renderInstanced(args, drawPart);
+        args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
         return;
     }
 
@@ -595,11 +622,85 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     // Draw!
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        batch.drawIndexed(gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
     }
 
-    const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
+}
+
+// The sizes of a part, relative to the height of the view, below which its levels of detail are drawn:
+// their simplification errors, from 0.5% to 3% of the part size, make about a pixel at these sizes
+static const float LOD_VIEW_SIZES[] = { 0.25f, 0.1f, 0.04f };
+
+int ModelMeshPartPayload::evalLOD(RenderArgs* args) const {
+    int numLODs = _drawMesh->getNumPartLODs(_partIndex);
+    if (numLODs <= 1 || !args->hasViewFrustum()) {
+        return 0;
+    }
+
+    const auto& frustum = args->getViewFrustum();
+    float distance = glm::distance(frustum.getPosition(), _worldBound.calcCenter());
+    float viewHeight = 2.0f * distance * tanf(glm::radians(frustum.getFieldOfView()) * 0.5f);
+    float viewSize = glm::length(_worldBound.getScale()) / std::max(viewHeight, EPSILON);
+
+    int lod = 0;
+    const int NUM_LOD_VIEW_SIZES = sizeof(LOD_VIEW_SIZES) / sizeof(LOD_VIEW_SIZES[0]);
+    while (lod + 1 < numLODs && lod < NUM_LOD_VIEW_SIZES && viewSize < LOD_VIEW_SIZES[lod]) {
+        lod++;
+    }
+    return lod;
+}
+
+bool ModelMeshPartPayload::canRenderInstanced(RenderArgs* args, const ShapeKey& key) const {
+    // Skinned, blend shaped and fading parts have per model state, and translucent ones must be drawn in order
+    return args->_enableInstancing && !_clusterBuffer._buffer && !_isBlendShaped && _fadeState == FADE_COMPLETE &&
+        !key.isTranslucent();
+}
+
+const std::string& ModelMeshPartPayload::getInstanceName(RenderArgs* args) const {
+    auto& instanceName = _instanceNames[args->_renderMode];
+    if (instanceName.lod != _lod || instanceName.pipeline != args->_pipeline.get() ||
+            instanceName.enableTexturing != args->_enableTexturing) {
+        instanceName.lod = _lod;
+        instanceName.pipeline = args->_pipeline.get();
+        instanceName.enableTexturing = args->_enableTexturing;
+        instanceName.name = _instanceNamePrefix + "_" + std::to_string(_lod) +
+            "_" + std::to_string((size_t)args->_pipeline.get()) + (args->_enableTexturing ? "" : "_untextured");
+    }
+    return instanceName.name;
+}
+
+void ModelMeshPartPayload::renderInstanced(RenderArgs* args, const model::Mesh::Part& drawPart) const {
+    gpu::Batch& batch = *(args->_batch);
+
+    // The parts drawing the same mesh part, with the same material and pipeline, in any number of models, make one
+    // instanced draw at the end of the batch, each instance fetching its transform through its draw call info
+    const auto& instanceName = getInstanceName(args);
+
+    batch.setModelTransform(_transform);
+
+    auto mesh = _drawMesh;
+    auto material = _drawMaterial;
+    auto part = drawPart;
+    auto indexBuffer = (_lod > 0 ? _drawMesh->getLODIndexBuffer() : _drawMesh->getIndexBuffer())._buffer;
+    auto pipeline = args->_pipeline;
+    bool enableTextures = args->_enableTexturing;
+    bool hasColorAttrib = _hasColorAttrib;
+    batch.setupNamedCalls(instanceName, [mesh, material, part, indexBuffer, pipeline, enableTextures, hasColorAttrib](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        batch.setPipeline(pipeline->pipeline);
+        pipeline->prepare(batch);
+
+        batch.setIndexBuffer(gpu::UINT32, indexBuffer, 0);
+        batch.setInputFormat((mesh->getVertexFormat()));
+        batch.setInputStream(0, mesh->getVertexStream());
+        if (!hasColorAttrib) {
+            batch._glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        }
+
+        bindMaterialToBatch(batch, material, pipeline->locations, enableTextures);
+
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, part._numIndices, part._startIndex);
+    });
 }
 
 void ModelMeshPartPayload::computeAdjustedLocalBound(const QVector<glm::mat4>& clusterMatrices) {
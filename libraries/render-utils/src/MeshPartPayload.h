@@ -12,6 +12,9 @@
 #ifndef hifi_MeshPartPayload_h
 #define hifi_MeshPartPayload_h
 
+#include <array>
+#include <string>
+
 #include <Interpolate.h>
 
 #include <gpu/Batch.h>
@@ -91,7 +94,7 @@ public:
     void notifyLocationChanged() override;
     void updateTransformForSkinnedMesh(const Transform& renderTransform,
             const Transform& boundTransform,
-            const gpu::BufferPointer& buffer);
+            const gpu::BufferView& buffer);
 
     float computeFadeAlpha() const;
 
@@ -109,7 +112,14 @@ public:
 
     void computeAdjustedLocalBound(const QVector<glm::mat4>& clusterMatrices);
 
-    gpu::BufferPointer _clusterBuffer;
+    bool canRenderInstanced(RenderArgs* args, const render::ShapeKey& key) const;
+    void renderInstanced(RenderArgs* args, const model::Mesh::Part& drawPart) const;
+    const std::string& getInstanceName(RenderArgs* args) const;
+
+    // The level of detail of the part fitting its size in the view
+    int evalLOD(RenderArgs* args) const;
+
+    gpu::BufferView _clusterBuffer;
     Model* _model;
 
     int _meshIndex;
@@ -121,6 +131,18 @@ public:
 private:
     mutable quint64 _fadeStartTime { 0 };
     mutable uint8_t _fadeState { FADE_WAITING_TO_START };
+    mutable int _lod { 0 };
+
+    // The name of the instanced named call the part joins, from its mesh part and material, and the level of detail,
+    // pipeline and texturing it was last drawn with in each render mode, so it is only rebuilt when those change
+    struct InstanceName {
+        int lod { -1 };
+        const render::ShapePipeline* pipeline { nullptr };
+        bool enableTexturing { false };
+        std::string name;
+    };
+    std::string _instanceNamePrefix;
+    mutable std::array<InstanceName, RenderArgs::MIRROR_RENDER_MODE + 1> _instanceNames;
 };
 
 namespace render {
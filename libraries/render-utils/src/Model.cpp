@@ -266,7 +266,7 @@ void Model::updateRenderItems() {
             });
         }
 
-        scene->enqueuePendingChanges(pendingChanges);
+        scene->enqueuePendingChanges(std::move(pendingChanges));
     });
 }
 
@@ -287,6 +287,22 @@ void Model::reset() {
     }
 }
 
+// the first and number of the vertices that any of the blendshapes of the mesh moves
+static QPair<int, int> computeBlendedVertexRange(const FBXMesh& mesh) {
+    int firstVertex = mesh.vertices.size();
+    int lastVertex = -1;
+    foreach (const FBXBlendshape& blendshape, mesh.blendshapes) {
+        foreach (int index, blendshape.indices) {
+            firstVertex = std::min(firstVertex, index);
+            lastVertex = std::max(lastVertex, index);
+        }
+    }
+    if (lastVertex < firstVertex) {
+        return QPair<int, int>(0, 0);
+    }
+    return QPair<int, int>(firstVertex, lastVertex - firstVertex + 1);
+}
+
 bool Model::updateGeometry() {
     bool needFullUpdate = false;
 
@@ -308,15 +324,10 @@ bool Model::updateGeometry() {
 
             // Note: we add empty buffers for meshes that lack blendshapes so we can access the buffers by index
             // later in ModelMeshPayload, however the vast majority of meshes will not have them.
-            // TODO? make _blendedVertexBuffers a map instead of vector and only add for meshes with blendshapes?
-            auto buffer = std::make_shared<gpu::Buffer>();
-            if (!mesh.blendshapes.isEmpty()) {
-                buffer->resize((mesh.vertices.size() + mesh.normals.size()) * sizeof(glm::vec3));
-                buffer->setSubData(0, mesh.vertices.size() * sizeof(glm::vec3), (gpu::Byte*) mesh.vertices.constData());
-                buffer->setSubData(mesh.vertices.size() * sizeof(glm::vec3),
-                                   mesh.normals.size() * sizeof(glm::vec3), (gpu::Byte*) mesh.normals.constData());
-            }
-            _blendedVertexBuffers.push_back(buffer);
+            // The buffers of the meshes with blendshapes stay empty until the first blend, drawing the vertices
+            // of the geometry shared by all its models until then, so the models never blended don't copy them.
+            _blendedVertexBuffers.push_back(std::make_shared<gpu::Buffer>());
+            _blendedVertexRanges.push_back(computeBlendedVertexRange(mesh));
         }
         needFullUpdate = true;
     }
@@ -378,7 +389,7 @@ bool Model::findRayIntersectionAgainstSubMeshes(const glm::vec3& origin, const g
         glm::vec3 meshFrameOrigin = glm::vec3(worldToMeshMatrix * glm::vec4(origin, 1.0f));
         glm::vec3 meshFrameDirection = glm::vec3(worldToMeshMatrix * glm::vec4(direction, 0.0f));
 
-        for (const auto& triangleSet : _modelSpaceMeshTriangleSets) {
+        for (const auto& triangleSet : *_modelSpaceMeshTriangleSets) {
             float triangleSetDistance = 0.0f;
             BoxFace triangleSetFace;
             glm::vec3 triangleSetNormal;
@@ -445,7 +456,7 @@ bool Model::convexHullContains(glm::vec3 point) {
         glm::mat4 worldToMeshMatrix = glm::inverse(meshToWorldMatrix);
         glm::vec3 meshFramePoint = glm::vec3(worldToMeshMatrix * glm::vec4(point, 1.0f));
 
-        for (const auto& triangleSet : _modelSpaceMeshTriangleSets) {
+        for (const auto& triangleSet : *_modelSpaceMeshTriangleSets) {
             const AABox& box = triangleSet.getBounds();
             if (box.contains(meshFramePoint)) {
                 if (triangleSet.convexHullContains(meshFramePoint)) {
@@ -462,76 +473,9 @@ bool Model::convexHullContains(glm::vec3 point) {
 }
 
 void Model::calculateTriangleSets() {
-    PROFILE_RANGE(render, __FUNCTION__);
-
-    const FBXGeometry& geometry = getFBXGeometry();
-    int numberOfMeshes = geometry.meshes.size();
-
+    // They only depend on the geometry: computed by the first model to pick it, and shared with all the others
+    _modelSpaceMeshTriangleSets = _renderGeometry->getMeshTriangleSets();
     _triangleSetsValid = true;
-    _modelSpaceMeshTriangleSets.clear();
-    _modelSpaceMeshTriangleSets.resize(numberOfMeshes);
-
-    for (int i = 0; i < numberOfMeshes; i++) {
-        const FBXMesh& mesh = geometry.meshes.at(i);
-
-        for (int j = 0; j < mesh.parts.size(); j++) {
-            const FBXMeshPart& part = mesh.parts.at(j);
-
-            const int INDICES_PER_TRIANGLE = 3;
-            const int INDICES_PER_QUAD = 4;
-            const int TRIANGLES_PER_QUAD = 2;
-
-            // tell our triangleSet how many triangles to expect.
-            int numberOfQuads = part.quadIndices.size() / INDICES_PER_QUAD;
-            int numberOfTris = part.triangleIndices.size() / INDICES_PER_TRIANGLE;
-            int totalTriangles = (numberOfQuads * TRIANGLES_PER_QUAD) + numberOfTris;
-            _modelSpaceMeshTriangleSets[i].reserve(totalTriangles);
-
-            auto meshTransform = getFBXGeometry().offset * mesh.modelTransform;
-
-            if (part.quadIndices.size() > 0) {
-                int vIndex = 0;
-                for (int q = 0; q < numberOfQuads; q++) {
-                    int i0 = part.quadIndices[vIndex++];
-                    int i1 = part.quadIndices[vIndex++];
-                    int i2 = part.quadIndices[vIndex++];
-                    int i3 = part.quadIndices[vIndex++];
-
-                    // track the model space version... these points will be transformed by the FST's offset, 
-                    // which includes the scaling, rotation, and translation specified by the FST/FBX, 
-                    // this can't change at runtime, so we can safely store these in our TriangleSet
-                    glm::vec3 v0 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i0], 1.0f));
-                    glm::vec3 v1 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i1], 1.0f));
-                    glm::vec3 v2 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i2], 1.0f));
-                    glm::vec3 v3 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i3], 1.0f));
-
-                    Triangle tri1 = { v0, v1, v3 };
-                    Triangle tri2 = { v1, v2, v3 };
-                    _modelSpaceMeshTriangleSets[i].insert(tri1);
-                    _modelSpaceMeshTriangleSets[i].insert(tri2);
-                }
-            }
-
-            if (part.triangleIndices.size() > 0) {
-                int vIndex = 0;
-                for (int t = 0; t < numberOfTris; t++) {
-                    int i0 = part.triangleIndices[vIndex++];
-                    int i1 = part.triangleIndices[vIndex++];
-                    int i2 = part.triangleIndices[vIndex++];
-
-                    // track the model space version... these points will be transformed by the FST's offset, 
-                    // which includes the scaling, rotation, and translation specified by the FST/FBX, 
-                    // this can't change at runtime, so we can safely store these in our TriangleSet
-                    glm::vec3 v0 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i0], 1.0f));
-                    glm::vec3 v1 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i1], 1.0f));
-                    glm::vec3 v2 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i2], 1.0f));
-
-                    Triangle tri = { v0, v1, v2 };
-                    _modelSpaceMeshTriangleSets[i].insert(tri);
-                }
-            }
-        }
-    }
 }
 
 void Model::setVisibleInScene(bool newValue, std::shared_ptr<render::Scene> scene) {
@@ -646,6 +590,10 @@ void Model::removeFromScene(std::shared_ptr<render::Scene> scene, render::Pendin
 void Model::renderDebugMeshBoxes(gpu::Batch& batch) {
     int colorNdx = 0;
     _mutex.lock();
+    if (!_modelSpaceMeshTriangleSets) {
+        _mutex.unlock();
+        return;
+    }
 
     glm::mat4 meshToModelMatrix = glm::scale(_scale) * glm::translate(_offset);
     glm::mat4 meshToWorldMatrix = createMatFromQuatAndPos(_rotation, _translation) * meshToModelMatrix;
@@ -654,7 +602,7 @@ void Model::renderDebugMeshBoxes(gpu::Batch& batch) {
 
     DependencyManager::get<GeometryCache>()->bindSimpleProgram(batch, false, false, false, true, true);
 
-    for(const auto& triangleSet : _modelSpaceMeshTriangleSets) {
+    for(const auto& triangleSet : *_modelSpaceMeshTriangleSets) {
         auto box = triangleSet.getBounds();
 
         if (_debugMeshBoxesID == GeometryCache::UNKNOWN_ID) {
@@ -878,7 +826,8 @@ class Blender : public QRunnable {
 public:
 
     Blender(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients);
+        const QVector<FBXMesh>& meshes, const QVector<QPair<int, int>>& blendedVertexRanges,
+        const QVector<float>& blendshapeCoefficients);
 
     virtual void run() override;
 
@@ -888,15 +837,18 @@ private:
     int _blendNumber;
     Geometry::WeakPointer _geometry;
     QVector<FBXMesh> _meshes;
+    QVector<QPair<int, int>> _blendedVertexRanges;
     QVector<float> _blendshapeCoefficients;
 };
 
 Blender::Blender(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients) :
+        const QVector<FBXMesh>& meshes, const QVector<QPair<int, int>>& blendedVertexRanges,
+        const QVector<float>& blendshapeCoefficients) :
     _model(model),
     _blendNumber(blendNumber),
     _geometry(geometry),
     _meshes(meshes),
+    _blendedVertexRanges(blendedVertexRanges),
     _blendshapeCoefficients(blendshapeCoefficients) {
 }
 
@@ -904,16 +856,20 @@ void Blender::run() {
     PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
     QVector<glm::vec3> vertices, normals;
     if (_model) {
+        // only the vertices the blendshapes move are blended, in the order of the meshes
         int offset = 0;
-        foreach (const FBXMesh& mesh, _meshes) {
+        for (int meshIndex = 0; meshIndex < _meshes.size(); meshIndex++) {
+            const FBXMesh& mesh = _meshes.at(meshIndex);
             if (mesh.blendshapes.isEmpty()) {
                 continue;
             }
-            vertices += mesh.vertices;
-            normals += mesh.normals;
+            int firstVertex = _blendedVertexRanges.at(meshIndex).first;
+            int numVertices = _blendedVertexRanges.at(meshIndex).second;
+            vertices += mesh.vertices.mid(firstVertex, numVertices);
+            normals += mesh.normals.mid(firstVertex, numVertices);
             glm::vec3* meshVertices = vertices.data() + offset;
             glm::vec3* meshNormals = normals.data() + offset;
-            offset += mesh.vertices.size();
+            offset += numVertices;
             const float NORMAL_COEFFICIENT_SCALE = 0.01f;
             for (int i = 0, n = qMin(_blendshapeCoefficients.size(), mesh.blendshapes.size()); i < n; i++) {
                 float vertexCoefficient = _blendshapeCoefficients.at(i);
@@ -924,7 +880,7 @@ void Blender::run() {
                 float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
                 const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
                 for (int j = 0; j < blendshape.indices.size(); j++) {
-                    int index = blendshape.indices.at(j);
+                    int index = blendshape.indices.at(j) - firstVertex;
                     meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
                     meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
                 }
@@ -1059,14 +1015,21 @@ void Model::computeMeshPartLocalBounds() {
     }
 }
 
+void Model::MeshState::updateClusterBuffer() {
+    if (!clusterSlot) {
+        clusterSlot = SkinningBuffer::instance().allocateSlot();
+    }
+    clusterSlot->update(clusterMatrices);
+    clusterBuffer = clusterSlot->getView();
+}
+
 // virtual
-void Model::updateClusterMatrices() {
-    PerformanceTimer perfTimer("Model::updateClusterMatrices");
+void Model::computeClusterMatrices() {
+    PerformanceTimer perfTimer("Model::computeClusterMatrices");
 
     if (!_needsUpdateClusterMatrices || !isLoaded()) {
         return;
     }
-    _needsUpdateClusterMatrices = false;
     const FBXGeometry& geometry = getFBXGeometry();
     for (int i = 0; i < _meshStates.size(); i++) {
         MeshState& state = _meshStates[i];
@@ -1076,16 +1039,27 @@ void Model::updateClusterMatrices() {
             auto jointMatrix = _rig->getJointTransform(cluster.jointIndex);
             glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
         }
+    }
+    _hasComputedClusterMatrices = true;
+}
+
+// virtual
+void Model::updateClusterMatrices() {
+    PerformanceTimer perfTimer("Model::updateClusterMatrices");
 
+    if (!_needsUpdateClusterMatrices || !isLoaded()) {
+        return;
+    }
+    if (!_hasComputedClusterMatrices) {
+        computeClusterMatrices();
+    }
+    _needsUpdateClusterMatrices = false;
+    _hasComputedClusterMatrices = false;
+    const FBXGeometry& geometry = getFBXGeometry();
+    for (int i = 0; i < _meshStates.size(); i++) {
         // Once computed the cluster matrices, update the buffer(s)
-        if (mesh.clusters.size() > 1) {
-            if (!state.clusterBuffer) {
-                state.clusterBuffer = std::make_shared<gpu::Buffer>(state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                                    (const gpu::Byte*) state.clusterMatrices.constData());
-            } else {
-                state.clusterBuffer->setSubData(0, state.clusterMatrices.size() * sizeof(glm::mat4),
-                                                (const gpu::Byte*) state.clusterMatrices.constData());
-            }
+        if (geometry.meshes.at(i).clusters.size() > 1) {
+            _meshStates[i].updateClusterBuffer();
         }
     }
 
@@ -1120,7 +1094,7 @@ bool Model::maybeStartBlender() {
         const FBXGeometry& fbxGeometry = getFBXGeometry();
         if (fbxGeometry.hasBlendedMeshes()) {
             QThreadPool::globalInstance()->start(new Blender(getThisPointer(), ++_blendNumber, _renderGeometry,
-                fbxGeometry.meshes, _blendshapeCoefficients));
+                fbxGeometry.meshes, _blendedVertexRanges, _blendshapeCoefficients));
             return true;
         }
     }
@@ -1143,17 +1117,28 @@ void Model::setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geo
         }
 
         gpu::BufferPointer& buffer = _blendedVertexBuffers[i];
-        buffer->setSubData(0, mesh.vertices.size() * sizeof(glm::vec3), (gpu::Byte*) vertices.constData() + index*sizeof(glm::vec3));
-        buffer->setSubData(mesh.vertices.size() * sizeof(glm::vec3),
-            mesh.normals.size() * sizeof(glm::vec3), (gpu::Byte*) normals.constData() + index*sizeof(glm::vec3));
-
-        index += mesh.vertices.size();
+        if (buffer->getSize() == 0) {
+            // the vertices no blendshape moves are copied once, only the others change from then on
+            buffer->resize((mesh.vertices.size() + mesh.normals.size()) * sizeof(glm::vec3));
+            buffer->setSubData(0, mesh.vertices.size() * sizeof(glm::vec3), (gpu::Byte*) mesh.vertices.constData());
+            buffer->setSubData(mesh.vertices.size() * sizeof(glm::vec3),
+                mesh.normals.size() * sizeof(glm::vec3), (gpu::Byte*) mesh.normals.constData());
+        }
+        int firstVertex = _blendedVertexRanges.at(i).first;
+        int numVertices = _blendedVertexRanges.at(i).second;
+        buffer->setSubData(firstVertex * sizeof(glm::vec3), numVertices * sizeof(glm::vec3),
+            (gpu::Byte*) vertices.constData() + index*sizeof(glm::vec3));
+        buffer->setSubData((mesh.vertices.size() + firstVertex) * sizeof(glm::vec3), numVertices * sizeof(glm::vec3),
+            (gpu::Byte*) normals.constData() + index*sizeof(glm::vec3));
+
+        index += numVertices;
     }
 }
 
 void Model::deleteGeometry() {
     _deleteGeometryCounter++;
     _blendedVertexBuffers.clear();
+    _blendedVertexRanges.clear();
     _meshStates.clear();
     _rig->destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
@@ -33,6 +33,7 @@
 #include "GeometryCache.h"
 #include "TextureCache.h"
 #include "Rig.h"
+#include "SkinningBuffer.h"
 
 class AbstractViewStateInterface;
 class QScriptEngine;
@@ -130,6 +131,10 @@ public:
     virtual void simulate(float deltaTime, bool fullUpdate = true);
     virtual void updateClusterMatrices();
 
+    // the products of the cluster matrices, which touch nothing but this model and its rig so that several models may
+    // compute theirs concurrently; updateClusterMatrices uploads them instead of computing them again
+    virtual void computeClusterMatrices();
+
     /// Returns a reference to the shared geometry.
     const Geometry::Pointer& getGeometry() const { return _renderGeometry; }
     /// Returns a reference to the shared collision geometry.
@@ -242,7 +247,11 @@ public:
     class MeshState {
     public:
         QVector<glm::mat4> clusterMatrices;
-        gpu::BufferPointer clusterBuffer;
+        // the slot of the shared skinning buffer holding the cluster matrices, and its range to bind
+        SkinningBuffer::SlotPointer clusterSlot;
+        gpu::BufferView clusterBuffer;
+
+        void updateClusterBuffer();
     };
 
     const MeshState& getMeshState(int index) { return _meshStates.at(index); }
@@ -347,6 +356,8 @@ protected:
     bool _isVisible;
 
     gpu::Buffers _blendedVertexBuffers;
+    // the first and number of the vertices of each mesh that its blendshapes move, the only ones blended and uploaded
+    QVector<QPair<int, int>> _blendedVertexRanges;
 
     QVector<QVector<QSharedPointer<Texture> > > _dilatedTextures;
 
@@ -358,7 +369,7 @@ protected:
 
     bool _triangleSetsValid { false };
     void calculateTriangleSets();
-    QVector<TriangleSet> _modelSpaceMeshTriangleSets; // model space triangles for all sub meshes
+    std::shared_ptr<const Geometry::MeshTriangleSets> _modelSpaceMeshTriangleSets; // model space triangles for all sub meshes, shared by the models of the geometry
 
 
     void createRenderItemSet();
@@ -385,6 +396,7 @@ protected:
     bool _needsFixupInScene { true }; // needs to be removed/re-added to scene
     bool _needsReload { true };
     bool _needsUpdateClusterMatrices { true };
+    bool _hasComputedClusterMatrices { false };
     mutable bool _needsUpdateTextures { true };
 
     friend class ModelMeshPartPayload;
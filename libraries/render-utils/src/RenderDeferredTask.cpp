@@ -27,9 +27,11 @@
 
 #include "LightingModel.h"
 #include "DebugDeferredBuffer.h"
+#include "DeferredFrameTransform.h"
 #include "DeferredFramebuffer.h"
 #include "DeferredLightingEffect.h"
 #include "SurfaceGeometryPass.h"
+#include "HiZOcclusion.h"
 #include "FramebufferCache.h"
 #include "HitEffect.h"
 #include "TextureCache.h"
@@ -42,6 +44,7 @@
 #include <gpu/StandardShaderLib.h>
 
 #include "drawOpaqueStencil_frag.h"
+#include "drawFoveationStencil_frag.h"
 
 
 using namespace render;
@@ -82,13 +85,21 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
     const auto deferredFramebuffer = prepareDeferredOutputs.getN<PrepareDeferred::Outputs>(0);
     const auto lightingFramebuffer = prepareDeferredOutputs.getN<PrepareDeferred::Outputs>(1);
 
+    // Drop the opaques the last Hi-Z occlusion test found hidden
+    auto occlusionResults = std::make_shared<HiZOcclusionResults>();
+    const auto visibleOpaques = addJob<FilterOccludedItems>("FilterOccludedOpaques", opaques, occlusionResults);
+
     // Render opaque objects in DeferredBuffer
-    const auto opaqueInputs = DrawStateSortDeferred::Inputs(opaques, lightingModel).hasVarying();
+    const auto opaqueInputs = DrawStateSortDeferred::Inputs(visibleOpaques, lightingModel).hasVarying();
     addJob<DrawStateSortDeferred>("DrawOpaqueDeferred", opaqueInputs, shapePlumber);
 
     // Once opaque is all rendered create stencil background
     addJob<DrawStencilDeferred>("DrawOpaqueStencil", deferredFramebuffer);
 
+    // Out of the fovea in the HMD, keep the lighting to one pixel per quad
+    const auto foveationStencilInputs = DrawFoveationStencil::Inputs(deferredFrameTransform, deferredFramebuffer).hasVarying();
+    addJob<DrawFoveationStencil>("DrawFoveationStencil", foveationStencilInputs);
+
     addJob<EndGPURangeTimer>("OpaqueRangeTimer", opaqueRangeTimer);
 
 
@@ -98,6 +109,10 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
     const auto linearDepthPassInputs = LinearDepthPass::Inputs(deferredFrameTransform, deferredFramebuffer).hasVarying();
     const auto linearDepthPassOutputs = addJob<LinearDepthPass>("LinearDepth", linearDepthPassInputs);
     const auto linearDepthTarget = linearDepthPassOutputs.getN<LinearDepthPass::Outputs>(0);
+
+    // Hi-Z occlusion test of all the opaques against this frame's depth, for the frames to come
+    const auto hiZOcclusionInputs = HiZOcclusion::Inputs(opaques, linearDepthTarget).hasVarying();
+    addJob<HiZOcclusion>("HiZOcclusion", hiZOcclusionInputs, occlusionResults);
     
     // Curvature pass
     const auto surfaceGeometryPassInputs = SurfaceGeometryPass::Inputs(deferredFrameTransform, deferredFramebuffer, linearDepthTarget).hasVarying();
@@ -150,7 +165,7 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
     const auto toneAndPostRangeTimer = addJob<BeginGPURangeTimer>("BeginToneAndPostRangeTimer", "PostToneOverlaysAntialiasing");
 
     // Lighting Buffer ready for tone mapping
-    const auto toneMappingInputs = render::Varying(ToneMappingDeferred::Inputs(lightingFramebuffer, primaryFramebuffer));
+    const auto toneMappingInputs = ToneMappingDeferred::Inputs(lightingFramebuffer, primaryFramebuffer, deferredFrameTransform).hasVarying();
     addJob<ToneMappingDeferred>("ToneMapping", toneMappingInputs);
 
     { // DEbug the bounds of the rendered items, still look at the zbuffer
@@ -425,6 +440,52 @@ void DrawStencilDeferred::run(const SceneContextPointer& sceneContext, const Ren
     args->_batch = nullptr;
 }
 
+const int DrawFoveationStencil_FrameTransformSlot = 0;
+
+gpu::PipelinePointer DrawFoveationStencil::getFoveationPipeline() {
+    if (!_foveationPipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(drawFoveationStencil_frag));
+        auto program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("deferredFrameTransformBuffer"), DrawFoveationStencil_FrameTransformSlot));
+        gpu::Shader::makeProgram((*program), slotBindings);
+
+        // The pixels not discarded lose their opaque stencil, skipped by the lighting passes
+        auto state = std::make_shared<gpu::State>();
+        state->setStencilTest(true, 0xFF, gpu::State::StencilTest(0, 0xFF, gpu::ALWAYS, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_REPLACE));
+        state->setColorWriteMask(0);
+
+        _foveationPipeline = gpu::Pipeline::create(program, state);
+    }
+    return _foveationPipeline;
+}
+
+void DrawFoveationStencil::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Inputs& inputs) {
+    assert(renderContext->args);
+
+    const auto& frameTransform = inputs.get0();
+    const auto& deferredFramebuffer = inputs.get1();
+    if (!frameTransform->isFoveated()) {
+        return;
+    }
+
+    RenderArgs* args = renderContext->args;
+    doInBatch(args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+
+        batch.setFramebuffer(deferredFramebuffer->getDeferredFramebufferDepthColor());
+        batch.setViewportTransform(args->_viewport);
+        batch.setStateScissorRect(args->_viewport);
+
+        batch.setPipeline(getFoveationPipeline());
+        batch.setUniformBuffer(DrawFoveationStencil_FrameTransformSlot, frameTransform->getFrameTransformBuffer());
+
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+    });
+}
+
 void DrawBackgroundDeferred::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -133,6 +133,22 @@ protected:
     gpu::PipelinePointer getOpaquePipeline();
 };
 
+class DeferredFrameTransform;
+// In a foveated frame, clear the opaque stencil of all but the first pixel of each 2x2 quad out of the fovea of the eyes,
+// for the lighting passes to shade those once per quad, the tone mapping filling in the other pixels
+class DrawFoveationStencil {
+public:
+    using Inputs = render::VaryingSet2<std::shared_ptr<DeferredFrameTransform>, std::shared_ptr<DeferredFramebuffer>>;
+    using JobModel = render::Job::ModelI<DrawFoveationStencil, Inputs>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+protected:
+    gpu::PipelinePointer _foveationPipeline;
+
+    gpu::PipelinePointer getFoveationPipeline();
+};
+
 using DrawBackgroundDeferredConfig = render::GPUJobConfig;
 
 class DrawBackgroundDeferred {
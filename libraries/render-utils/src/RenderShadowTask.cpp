@@ -12,6 +12,7 @@
 #include "RenderShadowTask.h"
 
 #include <gpu/Context.h>
+#include <gpu/StandardShaderLib.h>
 
 #include <ViewFrustum.h>
 
@@ -28,9 +29,19 @@
 
 #include "model_shadow_frag.h"
 #include "skin_model_shadow_frag.h"
+#include "shadow_copy_frag.h"
 
 using namespace render;
 
+void RenderShadowMap::configure(const Config& config) {
+    _cacheStatic = config.cacheStatic;
+    if (!_cacheStatic) {
+        _staticFramebuffer.reset();
+        _staticGenerations.clear();
+        _numStatic = 0;
+    }
+}
+
 void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
                           const render::ShapeBounds& inShapes) {
     assert(renderContext->args);
@@ -45,49 +56,191 @@ void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const
     if (!shadow) return;
 
     const auto& fbo = shadow->framebuffer;
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
 
     RenderArgs* args = renderContext->args;
+    glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
+
+    if (!_cacheStatic) {
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+
+            batch.setViewportTransform(viewport);
+            batch.setStateScissorRect(viewport);
+
+            batch.setFramebuffer(fbo);
+            batch.clearFramebuffer(
+                gpu::Framebuffer::BUFFER_COLOR0 | gpu::Framebuffer::BUFFER_DEPTH,
+                vec4(vec3(1.0, 1.0, 1.0), 0.0), 1.0, 0, true);
+
+            batch.setProjectionTransform(shadow->getProjection());
+            batch.setViewTransform(shadow->getView(), false);
+
+            renderShapes(sceneContext, renderContext, inShapes);
+
+            args->_batch = nullptr;
+        });
+        config->numStatic = 0;
+        config->numDynamic = 0;
+        for (const auto& items : inShapes) {
+            config->numDynamic += (int)items.second.size();
+        }
+        return;
+    }
+
+    // Split the casters not updated for a while, cached, from the moving ones and the skinned ones, drawn every frame.
+    // The cache is rendered again when the keylight frustum moves, or a caster changes from one kind to the other:
+    // an update makes a cached caster dynamic, and a caster standing still long enough becomes static.
+    // A cached caster gone from the selection, removed or changed, drops the count of the cached ones still there.
+    const auto& scene = sceneContext->_scene;
+    const auto changeFrame = scene->getChangeFrame();
+    if (_staticGenerations.size() < scene->getNumItems()) {
+        _staticGenerations.resize(scene->getNumItems(), 0);
+    }
+
+    ShapeBounds staticShapes;
+    ShapeBounds dynamicShapes;
+    size_t numStatic { 0 };
+    size_t numCachedStatic { 0 };
+    bool staticChanged = !_staticFramebuffer || (shadow->getView() != _staticView) || (shadow->getProjection() != _staticProjection);
+    for (const auto& items : inShapes) {
+        if (items.first.isSkinned()) {
+            dynamicShapes.insert(items);
+            continue;
+        }
+        for (const auto& item : items.second) {
+            bool isStatic = (changeFrame - scene->getItemChangeFrame(item.id)) > STATIC_CHANGE_FRAMES;
+            bool wasStatic = (item.id < _staticGenerations.size()) && (_staticGenerations[item.id] == _staticGeneration);
+            if (isStatic) {
+                staticShapes[items.first].push_back(item);
+                numStatic++;
+                numCachedStatic += wasStatic ? 1 : 0;
+            } else {
+                dynamicShapes[items.first].push_back(item);
+            }
+            staticChanged = staticChanged || (isStatic != wasStatic);
+        }
+    }
+    staticChanged = staticChanged || (numCachedStatic != _numStatic);
+
+    if (staticChanged) {
+        if (!_staticFramebuffer) {
+            auto depthFormat = gpu::Element(gpu::SCALAR, gpu::FLOAT, gpu::DEPTH);
+            auto depthTexture = gpu::TexturePointer(gpu::Texture::createRenderBuffer(depthFormat, fbo->getWidth(), fbo->getHeight()));
+            _staticFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("StaticShadowmap"));
+            _staticFramebuffer->setDepthStencilBuffer(depthTexture, depthFormat);
+        }
+        _staticView = shadow->getView();
+        _staticProjection = shadow->getProjection();
+
+        if (++_staticGeneration == 0) {
+            std::fill(_staticGenerations.begin(), _staticGenerations.end(), 0);
+            _staticGeneration = 1;
+        }
+        for (const auto& items : staticShapes) {
+            for (const auto& item : items.second) {
+                _staticGenerations[item.id] = _staticGeneration;
+            }
+        }
+        _numStatic = numStatic;
+        config->numStaticRenders++;
+    }
+
+    auto copyPipeline = getCopyPipeline();
+
     gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
 
-        glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
         batch.setViewportTransform(viewport);
         batch.setStateScissorRect(viewport);
 
-        batch.setFramebuffer(fbo);
-        batch.clearFramebuffer(
-            gpu::Framebuffer::BUFFER_COLOR0 | gpu::Framebuffer::BUFFER_DEPTH,
-            vec4(vec3(1.0, 1.0, 1.0), 0.0), 1.0, 0, true);
+        if (staticChanged) {
+            batch.setFramebuffer(_staticFramebuffer);
+            batch.clearFramebuffer(gpu::Framebuffer::BUFFER_DEPTH, vec4(vec3(1.0, 1.0, 1.0), 0.0), 1.0, 0, true);
 
+            batch.setProjectionTransform(shadow->getProjection());
+            batch.setViewTransform(shadow->getView(), false);
+
+            renderShapes(sceneContext, renderContext, staticShapes);
+        }
+
+        // Start the shadow map from the static casters...
+        batch.setFramebuffer(fbo);
+        batch.setProjectionTransform(glm::mat4());
+        batch.resetViewTransform();
+        batch.setModelTransform(Transform());
+        batch.setPipeline(copyPipeline);
+        batch.setResourceTexture(0, _staticFramebuffer->getDepthStencilBuffer());
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+        batch.setResourceTexture(0, nullptr);
+
+        // ...and render the dynamic ones over them
         batch.setProjectionTransform(shadow->getProjection());
         batch.setViewTransform(shadow->getView(), false);
 
-        auto shadowPipeline = _shapePlumber->pickPipeline(args, ShapeKey());
-        auto shadowSkinnedPipeline = _shapePlumber->pickPipeline(args, ShapeKey::Builder().withSkinned());
+        renderShapes(sceneContext, renderContext, dynamicShapes);
 
-        std::vector<ShapeKey> skinnedShapeKeys{};
+        args->_batch = nullptr;
+    });
 
-        // Iterate through all inShapes and render the unskinned
-        args->_pipeline = shadowPipeline;
-        batch.setPipeline(shadowPipeline->pipeline);
-        for (auto items : inShapes) {
-            if (items.first.isSkinned()) {
-                skinnedShapeKeys.push_back(items.first);
-            } else {
-                renderItems(sceneContext, renderContext, items.second);
-            }
-        }
+    config->numStatic = (int)numStatic;
+    config->numDynamic = 0;
+    for (const auto& items : dynamicShapes) {
+        config->numDynamic += (int)items.second.size();
+    }
+}
+
+void RenderShadowMap::renderShapes(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
+                                   const render::ShapeBounds& shapes) {
+    RenderArgs* args = renderContext->args;
+    auto& batch = *args->_batch;
+
+    auto shadowPipeline = _shapePlumber->pickPipeline(args, ShapeKey());
+    auto shadowSkinnedPipeline = _shapePlumber->pickPipeline(args, ShapeKey::Builder().withSkinned());
 
-        // Reiterate to render the skinned
-        args->_pipeline = shadowSkinnedPipeline;
-        batch.setPipeline(shadowSkinnedPipeline->pipeline);
-        for (const auto& key : skinnedShapeKeys) {
-            renderItems(sceneContext, renderContext, inShapes.at(key));
+    std::vector<ShapeKey> skinnedShapeKeys{};
+
+    // Only depth is drawn, in any order
+    args->_enableInstancing = true;
+
+    // Iterate through all shapes and render the unskinned
+    args->_pipeline = shadowPipeline;
+    batch.setPipeline(shadowPipeline->pipeline);
+    for (auto items : shapes) {
+        if (items.first.isSkinned()) {
+            skinnedShapeKeys.push_back(items.first);
+        } else {
+            renderItems(sceneContext, renderContext, items.second);
         }
+    }
 
-        args->_pipeline = nullptr;
-        args->_batch = nullptr;
-    });
+    // Reiterate to render the skinned
+    args->_pipeline = shadowSkinnedPipeline;
+    batch.setPipeline(shadowSkinnedPipeline->pipeline);
+    for (const auto& key : skinnedShapeKeys) {
+        renderItems(sceneContext, renderContext, shapes.at(key));
+    }
+
+    args->_enableInstancing = false;
+    args->_pipeline = nullptr;
+}
+
+const gpu::PipelinePointer& RenderShadowMap::getCopyPipeline() {
+    if (!_copyPipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(shadow_copy_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("depthMap"), 0));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        auto state = std::make_shared<gpu::State>();
+        state->setDepthTest(true, true, gpu::ALWAYS);
+
+        _copyPipeline = gpu::Pipeline::create(program, state);
+    }
+    return _copyPipeline;
 }
 
 RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) {
@@ -19,16 +19,59 @@
 
 class ViewFrustum;
 
+class RenderShadowMapConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool cacheStatic MEMBER cacheStatic NOTIFY dirty)
+    Q_PROPERTY(int numStatic READ getNumStatic)
+    Q_PROPERTY(int numDynamic READ getNumDynamic)
+    Q_PROPERTY(int numStaticRenders READ getNumStaticRenders)
+public:
+    bool cacheStatic{ true };
+
+    int numStatic{ 0 };
+    int getNumStatic() { return numStatic; }
+    int numDynamic{ 0 };
+    int getNumDynamic() { return numDynamic; }
+    int numStaticRenders{ 0 };
+    int getNumStaticRenders() { return numStaticRenders; }
+
+signals:
+    void dirty();
+};
+
+// RenderShadowMap caches the casters standing still in a map of their own, rendered again only when the keylight frustum
+// or these casters change, and starts the shadow map from it every frame before rendering the moving casters over it
 class RenderShadowMap {
 public:
-    using JobModel = render::Job::ModelI<RenderShadowMap, render::ShapeBounds>;
+    using Config = RenderShadowMapConfig;
+    using JobModel = render::Job::ModelI<RenderShadowMap, render::ShapeBounds, Config>;
+
+    // Number of change frames a caster must not have been updated for to be cached
+    static const uint32_t STATIC_CHANGE_FRAMES { 30 };
 
     RenderShadowMap(render::ShapePlumberPointer shapePlumber) : _shapePlumber{ shapePlumber } {}
+    void configure(const Config& config);
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
              const render::ShapeBounds& inShapes);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
+
+    void renderShapes(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
+                      const render::ShapeBounds& shapes);
+    const gpu::PipelinePointer& getCopyPipeline();
+
+    bool _cacheStatic { true };
+
+    // The static casters cached, marked with the generation of the cache
+    gpu::FramebufferPointer _staticFramebuffer;
+    glm::mat4 _staticView;
+    glm::mat4 _staticProjection;
+    std::vector<uint32_t> _staticGenerations;
+    uint32_t _staticGeneration { 0 };
+    size_t _numStatic { 0 };
+
+    gpu::PipelinePointer _copyPipeline;
 };
 
 class RenderShadowTaskConfig : public render::Task::Config::Persistent {
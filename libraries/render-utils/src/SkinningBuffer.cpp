@@ -0,0 +1,60 @@
+//
+//  SkinningBuffer.cpp
+//  libraries/render-utils/src/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SkinningBuffer.h"
+
+#include <algorithm>
+
+SkinningBuffer& SkinningBuffer::instance() {
+    // never destroyed, the mesh states of models outliving the statics still give their slots back
+    static SkinningBuffer* skinningBuffer = new SkinningBuffer();
+    return *skinningBuffer;
+}
+
+SkinningBuffer::SkinningBuffer() :
+    _buffer(std::make_shared<gpu::Buffer>()) {
+}
+
+SkinningBuffer::SlotPointer SkinningBuffer::allocateSlot() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_freeSlots.empty()) {
+        // the slots handed out keep their offset, the buffer only grows
+        for (uint32_t i = 0; i < SLOTS_PER_GROWTH; i++) {
+            _freeSlots.push_back(_numSlots + SLOTS_PER_GROWTH - 1 - i);
+        }
+        _numSlots += SLOTS_PER_GROWTH;
+        _buffer->resize(_numSlots * SLOT_SIZE);
+    }
+    uint32_t index = _freeSlots.back();
+    _freeSlots.pop_back();
+
+    return std::make_shared<Slot>(index);
+}
+
+void SkinningBuffer::releaseSlot(uint32_t index) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _freeSlots.push_back(index);
+}
+
+SkinningBuffer::Slot::~Slot() {
+    SkinningBuffer::instance().releaseSlot(_index);
+}
+
+void SkinningBuffer::Slot::update(const QVector<glm::mat4>& clusterMatrices) {
+    auto& skinningBuffer = SkinningBuffer::instance();
+    gpu::Size offset = _index * SLOT_SIZE;
+    gpu::Size size = std::min(clusterMatrices.size(), (int)MAX_CLUSTERS) * sizeof(glm::mat4);
+
+    std::lock_guard<std::mutex> lock(skinningBuffer._mutex);
+    skinningBuffer._buffer->setSubData(offset, size, (const gpu::Byte*) clusterMatrices.constData());
+    if (!_view._buffer) {
+        _view = gpu::BufferView(skinningBuffer._buffer, offset, SLOT_SIZE);
+    }
+}
@@ -0,0 +1,69 @@
+//
+//  SkinningBuffer.h
+//  libraries/render-utils/src/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SkinningBuffer_h
+#define hifi_SkinningBuffer_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QVector>
+
+#include <glm/glm.hpp>
+
+#include <gpu/Buffer.h>
+
+// SkinningBuffer holds the cluster matrices of the skinned meshes of all the models in one uniform buffer,
+// each mesh in a slot of its own, so only the pages of the slots written in a frame are uploaded
+// and the draws bind the range of their slot rather than a buffer per mesh.
+class SkinningBuffer {
+public:
+    // as many matrices as the skinClusterBuffer of Skinning.slh
+    static const int MAX_CLUSTERS { 128 };
+    static const gpu::Size SLOT_SIZE { MAX_CLUSTERS * sizeof(glm::mat4) };
+
+    // A slot of the buffer, given back when the last mesh state holding it is gone
+    class Slot {
+    public:
+        Slot(uint32_t index) : _index(index) {}
+        ~Slot();
+
+        // Write the cluster matrices, as many as fit in a slot
+        void update(const QVector<glm::mat4>& clusterMatrices);
+
+        // The range of the slot to bind for the skinning
+        const gpu::BufferView& getView() const { return _view; }
+
+    private:
+        uint32_t _index;
+        gpu::BufferView _view;
+    };
+    using SlotPointer = std::shared_ptr<Slot>;
+
+    static SkinningBuffer& instance();
+
+    SlotPointer allocateSlot();
+
+private:
+    SkinningBuffer();
+
+    void releaseSlot(uint32_t index);
+
+    // the buffer grows by this many slots when they are all used
+    static const uint32_t SLOTS_PER_GROWTH { 32 };
+
+    std::mutex _mutex;
+    gpu::BufferPointer _buffer;
+    std::vector<uint32_t> _freeSlots;
+    uint32_t _numSlots { 0 };
+};
+
+#endif // hifi_SkinningBuffer_h
@@ -21,6 +21,7 @@
 #include "toneMapping_frag.h"
 
 const int ToneMappingEffect_ParamsSlot = 0;
+const int ToneMappingEffect_FrameTransformSlot = 1;
 const int ToneMappingEffect_LightingMapSlot = 0;
 
 ToneMappingEffect::ToneMappingEffect() {
@@ -36,6 +37,7 @@ void ToneMappingEffect::init() {
 
     gpu::Shader::BindingSet slotBindings;
     slotBindings.insert(gpu::Shader::Binding(std::string("toneMappingParamsBuffer"), ToneMappingEffect_ParamsSlot));
+    slotBindings.insert(gpu::Shader::Binding(std::string("deferredFrameTransformBuffer"), ToneMappingEffect_FrameTransformSlot));
     slotBindings.insert(gpu::Shader::Binding(std::string("colorMap"), ToneMappingEffect_LightingMapSlot));
     gpu::Shader::makeProgram(*blitProgram, slotBindings);
     auto blitState = std::make_shared<gpu::State>();
@@ -58,7 +60,8 @@ void ToneMappingEffect::setToneCurve(ToneCurve curve) {
     }
 }
 
-void ToneMappingEffect::render(RenderArgs* args, const gpu::TexturePointer& lightingBuffer, const gpu::FramebufferPointer& destinationFramebuffer) {
+void ToneMappingEffect::render(RenderArgs* args, const gpu::TexturePointer& lightingBuffer, const gpu::FramebufferPointer& destinationFramebuffer,
+        const DeferredFrameTransformPointer& frameTransform) {
     if (!_blitLightBuffer) {
         init();
     }
@@ -77,6 +80,7 @@ void ToneMappingEffect::render(RenderArgs* args, const gpu::TexturePointer& ligh
         batch.setPipeline(_blitLightBuffer);
 
         batch.setUniformBuffer(ToneMappingEffect_ParamsSlot, _parametersBuffer);
+        batch.setUniformBuffer(ToneMappingEffect_FrameTransformSlot, frameTransform->getFrameTransformBuffer());
         batch.setResourceTexture(ToneMappingEffect_LightingMapSlot, lightingBuffer);
         batch.draw(gpu::TRIANGLE_STRIP, 4);
     });
@@ -92,5 +96,6 @@ void ToneMappingDeferred::run(const render::SceneContextPointer& sceneContext, c
 
     auto lightingBuffer = inputs.get0()->getRenderBuffer(0);
     auto destFbo = inputs.get1();
-    _toneMappingEffect.render(renderContext->args, lightingBuffer, destFbo);
+    auto frameTransform = inputs.get2();
+    _toneMappingEffect.render(renderContext->args, lightingBuffer, destFbo, frameTransform);
 }
@@ -19,6 +19,8 @@
 #include <gpu/Pipeline.h>
 #include <render/DrawTask.h>
 
+#include "DeferredFrameTransform.h"
+
 
 class RenderArgs;
 
@@ -27,7 +29,9 @@ public:
     ToneMappingEffect();
     virtual ~ToneMappingEffect() {}
 
-    void render(RenderArgs* args, const gpu::TexturePointer& lightingBuffer, const gpu::FramebufferPointer& destinationBuffer);
+    // The frame transform tells the pixels out of the fovea, to fill in from the first pixel of their quad
+    void render(RenderArgs* args, const gpu::TexturePointer& lightingBuffer, const gpu::FramebufferPointer& destinationBuffer,
+        const DeferredFrameTransformPointer& frameTransform);
 
     void setExposure(float exposure);
     float getExposure() const { return _parametersBuffer.get<Parameters>()._exposure; }
@@ -83,8 +87,8 @@ signals:
 
 class ToneMappingDeferred {
 public:
-    // Inputs: lightingFramebuffer, destinationFramebuffer
-    using Inputs = render::VaryingSet2<gpu::FramebufferPointer, gpu::FramebufferPointer>;
+    // Inputs: lightingFramebuffer, destinationFramebuffer, frameTransform
+    using Inputs = render::VaryingSet3<gpu::FramebufferPointer, gpu::FramebufferPointer, DeferredFrameTransformPointer>;
     using Config = ToneMappingConfig;
     using JobModel = render::Job::ModelI<ToneMappingDeferred, Inputs, Config>;
 
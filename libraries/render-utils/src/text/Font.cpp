@@ -1,9 +1,12 @@
 #include "Font.h"
 
+#include <vector>
+
 #include <QFile>
 #include <QImage>
 
 #include <ColorUtils.h>
+#include <gpu/BufferHeap.h>
 
 #include <StreamHelpers.h>
 
@@ -14,38 +17,27 @@
 #include "../RenderUtilsLogging.h"
 #include "FontFamilies.h"
 
-struct TextureVertex {
-    glm::vec2 pos;
-    glm::vec2 tex;
-    TextureVertex() {}
-    TextureVertex(const glm::vec2& pos, const glm::vec2& tex) : pos(pos), tex(tex) {}
+// a glyph is drawn as an instance of a quad
+struct GlyphInstance {
+    glm::vec2 min; // bottom left
+    glm::vec2 size;
+    glm::vec2 texMin;
+    glm::vec2 texSize;
+    GlyphInstance() {}
+    GlyphInstance(const Glyph& glyph, const glm::vec2& offset) :
+        min(offset + glm::vec2(glyph.offset.x, glyph.offset.y - glyph.size.y)), size(glyph.size),
+        texMin(glyph.texOffset), texSize(glyph.texSize) {}
 };
 
-static const int NUMBER_OF_INDICES_PER_QUAD = 6; // 1 quad = 2 triangles
-static const int VERTICES_PER_QUAD = 4; // 1 quad = 4 vertices
-
-struct QuadBuilder {
-    TextureVertex vertices[VERTICES_PER_QUAD];
-
-    QuadBuilder(const glm::vec2& min, const glm::vec2& size,
-                const glm::vec2& texMin, const glm::vec2& texSize) {
-        // min = bottomLeft
-        vertices[0] = TextureVertex(min,
-                                    texMin + glm::vec2(0.0f, texSize.y));
-        vertices[1] = TextureVertex(min + glm::vec2(size.x, 0.0f),
-                                    texMin + texSize);
-        vertices[2] = TextureVertex(min + glm::vec2(0.0f, size.y),
-                                    texMin);
-        vertices[3] = TextureVertex(min + size,
-                                    texMin + glm::vec2(texSize.x, 0.0f));
-    }
-    QuadBuilder(const Glyph& glyph, const glm::vec2& offset) :
-    QuadBuilder(offset + glm::vec2(glyph.offset.x, glyph.offset.y - glyph.size.y), glyph.size,
-                    glyph.texOffset, glyph.texSize) {}
-
-};
+static const int VERTICES_PER_QUAD = 4; // 1 quad = 1 triangle strip of 4 vertices
 
+// the strings drawn in a frame are usually drawn again in the next, those that weren't drawn lately are let go
+static const int MAX_CACHED_STRINGS = 1024;
 
+uint qHash(const Font::DrawParams& params, uint seed) {
+    return qHash(params.str, seed) ^ qHash(params.origin.x) ^ qHash(params.origin.y) ^
+        qHash(params.bounds.x) ^ qHash(params.bounds.y);
+}
 
 static QHash<QString, Font::Pointer> LOADED_FONTS;
 
@@ -248,27 +240,28 @@ void Font::setupGPU() {
         }
 
         // Sanity checks
-        static const int OFFSET = offsetof(TextureVertex, tex);
-        assert(OFFSET == sizeof(glm::vec2));
-        assert(sizeof(glm::vec2) == 2 * sizeof(float));
-        assert(sizeof(TextureVertex) == 2 * sizeof(glm::vec2));
-        assert(sizeof(QuadBuilder) == 4 * sizeof(TextureVertex));
+        static const int TEX_OFFSET = offsetof(GlyphInstance, texMin);
+        assert(offsetof(GlyphInstance, size) == sizeof(glm::vec2));
+        assert(TEX_OFFSET == 2 * sizeof(glm::vec2));
+        assert(sizeof(GlyphInstance) == 4 * sizeof(glm::vec2));
 
-        // Setup rendering structures
+        // Setup rendering structures, the shader makes the quads of the glyphs
         _format = std::make_shared<gpu::Stream::Format>();
-        _format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), 0);
-        _format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), OFFSET);
+        _format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::XYZW), 0,
+                              gpu::Stream::PER_INSTANCE);
+        _format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::XYZW), TEX_OFFSET,
+                              gpu::Stream::PER_INSTANCE);
     }
 }
 
-void Font::rebuildVertices(float x, float y, const QString& str, const glm::vec2& bounds) {
-    _verticesBuffer = std::make_shared<gpu::Buffer>();
-    _numVertices = 0;
-    _indicesBuffer = std::make_shared<gpu::Buffer>();
-    _numIndices = 0;
+void Font::buildGlyphs(DrawInfo& drawInfo, const DrawParams& params) {
+    const QString& str = params.str;
+    const glm::vec2& bounds = params.bounds;
+    float x = params.origin.x;
+    float y = params.origin.y;
 
-    _lastStringRendered = str;
-    _lastBounds = bounds;
+    std::vector<GlyphInstance> glyphs;
+    glyphs.reserve(str.size());
 
     // Top left of text
     glm::vec2 advance = glm::vec2(x, y);
@@ -301,40 +294,9 @@ void Font::rebuildVertices(float x, float y, const QString& str, const glm::vec2
         // Draw the token
         if (!isNewLine) {
             for (auto c : token) {
-                auto glyph = _glyphs[c];
-                quint16 verticesOffset = _numVertices;
-
-                QuadBuilder qd(glyph, advance - glm::vec2(0.0f, _ascent));
-                _verticesBuffer->append(sizeof(QuadBuilder), (const gpu::Byte*)&qd);
-                _numVertices += 4;
-                
-                // Sam's recommended triangle slices
-                // Triangle tri1 = { v0, v1, v3 };
-                // Triangle tri2 = { v1, v2, v3 };
-                // NOTE: Random guy on the internet's recommended triangle slices
-                // Triangle tri1 = { v0, v1, v2 };
-                // Triangle tri2 = { v2, v3, v0 };
-
-                // The problem here being that the 4 vertices are { ll, lr, ul, ur }, a Z pattern
-                // Additionally, you want to ensure that the shared side vertices are used sequentially
-                // to improve cache locality
-                //
-                //  2 -- 3
-                //  |    |
-                //  |    |
-                //  0 -- 1
-                //
-                //  { 0, 1, 2 } -> { 2, 1, 3 }
-                quint16 indices[NUMBER_OF_INDICES_PER_QUAD];
-                indices[0] = verticesOffset + 0;
-                indices[1] = verticesOffset + 1;
-                indices[2] = verticesOffset + 2;
-                indices[3] = verticesOffset + 2;
-                indices[4] = verticesOffset + 1;
-                indices[5] = verticesOffset + 3;
-                _indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
-                _numIndices += NUMBER_OF_INDICES_PER_QUAD;
-                
+                const Glyph& glyph = getGlyph(c);
+
+                glyphs.emplace_back(glyph, advance - glm::vec2(0.0f, _ascent));
 
                 // Advance by glyph size
                 advance.x += glyph.d;
@@ -344,6 +306,10 @@ void Font::rebuildVertices(float x, float y, const QString& str, const glm::vec2
             advance.x += _spaceWidth;
         }
     }
+
+    drawInfo.numGlyphs = (unsigned int)glyphs.size();
+    drawInfo.glyphs = gpu::BufferHeap::getShared()->allocate(glyphs.size() * sizeof(GlyphInstance),
+                                                             (const gpu::Byte*)glyphs.data());
 }
 
 void Font::drawString(gpu::Batch& batch, float x, float y, const QString& str, const glm::vec4* color,
@@ -352,8 +318,32 @@ void Font::drawString(gpu::Batch& batch, float x, float y, const QString& str, c
         return;
     }
 
-    if (str != _lastStringRendered || bounds != _lastBounds) {
-        rebuildVertices(x, y, str, bounds);
+    ++_numDraws;
+
+    // the glyphs of a string are only laid out the first time it is drawn
+    DrawParams params { str, glm::vec2(x, y), bounds };
+    DrawInfo& drawInfo = _drawInfos[params];
+    if (!drawInfo.glyphs._buffer) {
+        buildGlyphs(drawInfo, params);
+    }
+    drawInfo.lastDraw = _numDraws;
+
+    // keep the instances for drawing, the cache can let go of them below
+    gpu::BufferView glyphs = drawInfo.glyphs;
+    unsigned int numGlyphs = drawInfo.numGlyphs;
+
+    if (_drawInfos.size() >= 2 * MAX_CACHED_STRINGS) {
+        for (auto it = _drawInfos.begin(); it != _drawInfos.end();) {
+            if (it->lastDraw + MAX_CACHED_STRINGS < _numDraws) {
+                it = _drawInfos.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (numGlyphs == 0) {
+        return;
     }
 
     setupGPU();
@@ -367,7 +357,6 @@ void Font::drawString(gpu::Batch& batch, float x, float y, const QString& str, c
     batch._glUniform4fv(_colorLoc, 1, (const float*)&lrgba);
 
     batch.setInputFormat(_format);
-    batch.setInputBuffer(0, _verticesBuffer, 0, _format->getChannels().at(0)._stride);
-    batch.setIndexBuffer(gpu::UINT16, _indicesBuffer, 0);
-    batch.drawIndexed(gpu::TRIANGLES, _numIndices, 0);
+    batch.setInputBuffer(0, glyphs._buffer, glyphs._offset, sizeof(GlyphInstance));
+    batch.drawInstanced(numGlyphs, gpu::TRIANGLE_STRIP, VERTICES_PER_QUAD);
 }
@@ -39,8 +39,24 @@ private:
     QStringList splitLines(const QString& str) const;
     glm::vec2 computeTokenExtent(const QString& str) const;
 
+    // the glyphs of a string laid out at a position within bounds, one instance each, and the last draw using them
+    struct DrawParams {
+        QString str;
+        glm::vec2 origin;
+        glm::vec2 bounds;
+        bool operator==(const DrawParams& other) const {
+            return str == other.str && origin == other.origin && bounds == other.bounds;
+        }
+    };
+    struct DrawInfo {
+        gpu::BufferView glyphs; // a range of the shared buffer heap
+        unsigned int numGlyphs = 0;
+        quint64 lastDraw = 0;
+    };
+    friend uint qHash(const DrawParams& params, uint seed);
+
     const Glyph& getGlyph(const QChar& c) const;
-    void rebuildVertices(float x, float y, const QString& str, const glm::vec2& bounds);
+    void buildGlyphs(DrawInfo& drawInfo, const DrawParams& params);
 
     void setupGPU();
 
@@ -66,19 +82,14 @@ private:
     gpu::PipelinePointer _layeredPipeline;
     gpu::TexturePointer _texture;
     gpu::Stream::FormatPointer _format;
-    gpu::BufferPointer _verticesBuffer;
-    gpu::BufferPointer _indicesBuffer;
-    gpu::BufferStreamPointer _stream;
-    unsigned int _numVertices = 0;
-    unsigned int _numIndices = 0;
 
     int _fontLoc = -1;
     int _outlineLoc = -1;
     int _colorLoc = -1;
 
-    // last string render characteristics
-    QString _lastStringRendered;
-    glm::vec2 _lastBounds;
+    // the strings drawn lately, a font is shared by all of the text of its family
+    QHash<DrawParams, DrawInfo> _drawInfos;
+    quint64 _numDraws = 0;
 };
 
 #endif
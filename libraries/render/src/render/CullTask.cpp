@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <tbb/parallel_for.h>
+
 #include <OctreeUtils.h>
 #include <PerfStat.h>
 #include <ViewFrustum.h>
@@ -21,6 +23,17 @@
 
 using namespace render;
 
+namespace {
+    enum CullResult : uint8_t {
+        FILTERED_OUT = 0,
+        OUT_OF_VIEW,
+        TOO_SMALL,
+        VISIBLE,
+    };
+
+    const size_t ITEMS_PER_TASK = 256;
+}
+
 void render::cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
                        const ItemBounds& inItems, ItemBounds& outItems) {
     assert(renderContext->args);
@@ -133,167 +146,103 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
         args->pushViewFrustum(_frozenFrutstum); // replace the true view frustum by the frozen one
     }
 
-    // Culling Frustum / solidAngle test helper class
-    struct Test {
-        CullFunctor _functor;
-        RenderArgs* _args;
-        RenderDetails::Item& _renderDetails;
-        glm::vec3 _eyePos;
-        float _squareTanAlpha;
-
-        Test(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails) :
-            _functor(functor),
-            _args(pargs),
-            _renderDetails(renderDetails)
-        {
-            // FIXME: Keep this code here even though we don't use it yet
-            /*_eyePos = _args->getViewFrustum().getPosition();
-            float a = glm::degrees(Octree::getAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
-            auto angle = std::min(glm::radians(45.0f), a); // no worse than 45 degrees
-            angle = std::max(glm::radians(1.0f / 60.0f), a); // no better than 1 minute of degree
-            auto tanAlpha = tan(angle);
-            _squareTanAlpha = (float)(tanAlpha * tanAlpha);
-            */
-        }
-
-        bool frustumTest(const AABox& bound) {
-            if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-                _renderDetails._outOfView++;
-                return false;
-            }
-            return true;
-        }
-
-        bool solidAngleTest(const AABox& bound) {
-            // FIXME: Keep this code here even though we don't use it yet
-            //auto eyeToPoint = bound.calcCenter() - _eyePos;
-            //auto boundSize = bound.getDimensions();
-            //float test = (glm::dot(boundSize, boundSize) / glm::dot(eyeToPoint, eyeToPoint)) - squareTanAlpha;
-            //if (test < 0.0f) {
-            if (!_functor(_args, bound)) {
-                _renderDetails._tooSmall++;
-                return false;
-            }
-            return true;
-        }
-    };
-    Test test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
 
-    // Now get the bound, and
-    // filter individually against the _filter
-    // visibility cull if partially selected ( octree cell contianing it was partial)
-    // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
+    const ViewFrustum& frustum = args->getViewFrustum();
 
-    if (_skipCulling) {
-        // inside & fit items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+    // Each list is culled in bulk: the filtered items' bounds gathered as arrays, tested against the frustum four at
+    // a time, then against the solid angle, split across the workers when there are many. They're then added to the
+    // out items in the order they were selected, as if culled one at a time.
+    auto cullItems = [&](const ItemIDs& itemIDs, bool frustumCull, bool solidAngleCull) {
+        size_t numItems = itemIDs.size();
+        _itemBounds.resize(numItems, ItemBound(Item::INVALID_ITEM_ID));
+        _results.resize(numItems);
+        if (frustumCull) {
+            _boxes.resize(numItems);
+            _inFrustum.resize(numItems);
         }
 
-        // inside & subcell items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
+        auto cullRange = [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); i++) {
+                auto& item = scene->getItem(itemIDs[i]);
+                if (!_filter.test(item.getKey())) {
+                    _results[i] = FILTERED_OUT;
+                    continue;
+                }
+                _itemBounds[i] = ItemBound(itemIDs[i], item.getBound());
+                _results[i] = VISIBLE;
+                if (frustumCull) {
+                    _boxes.set(i, _itemBounds[i].bound);
                 }
             }
-        }
-
-        // partial & fit items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
+            if (frustumCull) {
+                frustum.boxesIntersectFrustum(_boxes, range.begin(), range.end(), _inFrustum.data());
+            }
+            for (size_t i = range.begin(); i != range.end(); i++) {
+                if (_results[i] != VISIBLE) {
+                    continue;
+                }
+                if (frustumCull && !_inFrustum[i]) {
+                    _results[i] = OUT_OF_VIEW;
+                } else if (solidAngleCull && !_cullFunctor(args, _itemBounds[i].bound)) {
+                    _results[i] = TOO_SMALL;
                 }
             }
+        };
+        if (numItems > ITEMS_PER_TASK) {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, numItems, ITEMS_PER_TASK), cullRange);
+        } else {
+            cullRange(tbb::blocked_range<size_t>(0, numItems));
         }
 
-        // partial & subcell items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
+        for (size_t i = 0; i < numItems; i++) {
+            switch (_results[i]) {
+                case VISIBLE:
+                    outItems.emplace_back(_itemBounds[i]);
+                    break;
+                case OUT_OF_VIEW:
+                    details._outOfView++;
+                    break;
+                case TOO_SMALL:
+                    details._tooSmall++;
+                    break;
+                default:
+                    break;
             }
         }
+    };
 
-    } else {
+    // Now get the bound, and
+    // filter individually against the _filter
+    // visibility cull if partially selected ( octree cell contianing it was partial)
+    // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
+    // or only filter, if culling is disabled
+    bool cull = !_skipCulling;
 
-        // inside & fit items: easy, just filter
-        {
-            PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
+    // inside & fit items: easy, just filter
+    {
+        PerformanceTimer perfTimer("insideFitItems");
+        cullItems(inSelection.insideItems, false, false);
+    }
 
-        // inside & subcell items: filter & distance cull
-        {
-            PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.solidAngleTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
-        }
+    // inside & subcell items: filter & distance cull
+    {
+        PerformanceTimer perfTimer("insideSmallItems");
+        cullItems(inSelection.insideSubcellItems, false, cull);
+    }
 
-        // partial & fit items: filter & frustum cull
-        {
-            PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
-        }
+    // partial & fit items: filter & frustum cull
+    {
+        PerformanceTimer perfTimer("partialFitItems");
+        cullItems(inSelection.partialItems, cull, false);
+    }
 
-        // partial & subcell items:: filter & frutum cull & solidangle cull
-        {
-            PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                        }
-                    }
-                }
-            }
-        }
+    // partial & subcell items:: filter & frutum cull & solidangle cull
+    {
+        PerformanceTimer perfTimer("partialSmallItems");
+        cullItems(inSelection.partialSubcellItems, cull, cull);
     }
 
     details._rendered += (int)outItems.size();
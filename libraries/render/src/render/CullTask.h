@@ -107,6 +107,13 @@ namespace render {
 
         void configure(const Config& config);
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemSpatialTree::ItemSelection& inSelection, ItemBounds& outItems);
+
+    protected:
+        // Scratch space of the bulk cull, kept from frame to frame
+        ItemBounds _itemBounds;
+        AABoxArrays _boxes;
+        std::vector<uint8_t> _inFrustum;
+        std::vector<uint8_t> _results;
     };
 
     class FilterItemSelectionConfig : public Job::Config {
@@ -106,7 +106,8 @@ void render::renderStateSortShapes(const SceneContextPointer& sceneContext, cons
         }
     }
 
-    // Then render
+    // Then render, the shapes are already out of depth order
+    args->_enableInstancing = true;
     for (auto& pipelineKey : sortedPipelines) {
         auto& bucket = sortedShapes[pipelineKey];
         args->_pipeline = shapeContext->pickPipeline(args, pipelineKey);
@@ -117,6 +118,7 @@ void render::renderStateSortShapes(const SceneContextPointer& sceneContext, cons
             item.render(args);
         }
     }
+    args->_enableInstancing = false;
     args->_pipeline = nullptr;
     for (auto& item : ownPipelineBucket) {
         item.render(args);
@@ -10,6 +10,8 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
+#include <iterator>
 #include <numeric>
 #include <gpu/Batch.h>
 #include "Logging.h"
@@ -43,6 +45,27 @@ void PendingChanges::merge(const PendingChanges& changes) {
     _updateFunctors.insert(_updateFunctors.end(), changes._updateFunctors.begin(), changes._updateFunctors.end());
 }
 
+template <class T> void moveAppend(std::vector<T>& dest, std::vector<T>& source) {
+    if (dest.empty()) {
+        dest.swap(source);
+    } else {
+        dest.insert(dest.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+    }
+}
+
+void PendingChanges::merge(PendingChanges&& changes) {
+    // Move the payloads and functors rather than copy their pointers
+    moveAppend(_resetItems, changes._resetItems);
+    moveAppend(_resetPayloads, changes._resetPayloads);
+    moveAppend(_removedItems, changes._removedItems);
+    moveAppend(_updatedItems, changes._updatedItems);
+    moveAppend(_updateFunctors, changes._updateFunctors);
+}
+
+bool PendingChanges::empty() const {
+    return _resetItems.empty() && _removedItems.empty() && _updatedItems.empty();
+}
+
 Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
@@ -51,6 +74,12 @@ Scene::Scene(glm::vec3 origin, float size) :
 
 Scene::~Scene() {
     qCDebug(renderlogging) << "Scene::~Scene()";
+    auto node = _pendingChangesHead.exchange(nullptr);
+    while (node) {
+        auto next = node->_next;
+        delete node;
+        node = next;
+    }
 }
 
 ItemID Scene::allocateID() {
@@ -64,26 +93,43 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueuePendingChanges(const PendingChanges& pendingChanges) {
-    _changeQueueMutex.lock();
-    _changeQueue.push(pendingChanges);
-    _changeQueueMutex.unlock();
+    if (!pendingChanges.empty()) {
+        pushPendingChanges(new PendingChangesNode(PendingChanges(pendingChanges)));
+    }
 }
 
-void consolidateChangeQueue(PendingChangesQueue& queue, PendingChanges& singleBatch) {
-    while (!queue.empty()) {
-        const auto& pendingChanges = queue.front();
-        singleBatch.merge(pendingChanges);
-        queue.pop();
-    };
+void Scene::enqueuePendingChanges(PendingChanges&& pendingChanges) {
+    if (!pendingChanges.empty()) {
+        pushPendingChanges(new PendingChangesNode(std::move(pendingChanges)));
+    }
 }
- 
+
+void Scene::pushPendingChanges(PendingChangesNode* node) {
+    node->_next = _pendingChangesHead.load(std::memory_order_relaxed);
+    while (!_pendingChangesHead.compare_exchange_weak(node->_next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
 void Scene::processPendingChangesQueue() {
     PROFILE_RANGE(render, __FUNCTION__);
     PendingChanges consolidatedPendingChanges;
 
     {
-        std::unique_lock<std::mutex> lock(_changeQueueMutex);
-        consolidateChangeQueue(_changeQueue, consolidatedPendingChanges);
+        // Take all the batches enqueued so far, newest first, and merge them oldest first
+        PendingChangesNode* node = _pendingChangesHead.exchange(nullptr, std::memory_order_acquire);
+        PendingChangesNode* oldest = nullptr;
+        while (node) {
+            auto next = node->_next;
+            node->_next = oldest;
+            oldest = node;
+            node = next;
+        }
+        while (oldest) {
+            consolidatedPendingChanges.merge(std::move(oldest->_changes));
+            auto next = oldest->_next;
+            delete oldest;
+            oldest = next;
+        }
     }
     
     {
@@ -94,6 +140,8 @@ void Scene::processPendingChangesQueue() {
         if (maxID > _items.size()) {
             _items.resize(maxID + 100); // allocate the maxId and more
         }
+        _itemChangeFrames.resize(_items.size(), 0);
+        _changeFrame++;
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the pendingChanges
 
@@ -124,6 +172,7 @@ void Scene::resetItems(const ItemIDs& ids, Payloads& payloads) {
 
         // Reset the item with a new payload
         item.resetPayload(*resetPayload);
+        _itemChangeFrames[resetID] = _changeFrame;
         auto newKey = item.getKey();
 
         // Update the item's container
@@ -160,6 +209,15 @@ void Scene::removeItems(const ItemIDs& ids) {
 }
 
 void Scene::updateItems(const ItemIDs& ids, UpdateFunctors& functors) {
+    // Apply all the updates first, then move each updated item in its containers once
+    if (_updateStamps.size() < _items.size()) {
+        _updateStamps.resize(_items.size(), 0);
+    }
+    if (++_updateStamp == 0) {
+        std::fill(_updateStamps.begin(), _updateStamps.end(), 0);
+        _updateStamp = 1;
+    }
+    _updatedItems.clear();
 
     auto updateFunctor = functors.begin();
     for (auto updateID : ids) {
@@ -170,35 +228,46 @@ void Scene::updateItems(const ItemIDs& ids, UpdateFunctors& functors) {
 
         // Access the true item
         auto& item = _items[updateID];
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+        if (_updateStamps[updateID] != _updateStamp) {
+            _updateStamps[updateID] = _updateStamp;
+            _updatedItems.emplace_back(updateID, item.getKey());
+            _itemChangeFrames[updateID] = _changeFrame;
+        }
 
         // Update the item
         item.update((*updateFunctor));
-        auto newKey = item.getKey();
 
-        // Update the item's container
-        if (oldKey.isSpatial() == newKey.isSpatial()) {
-            if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            }
-        } else {
-            if (newKey.isSpatial()) {
-                _masterNonspatialSet.erase(updateID);
+        // next loop
+        updateFunctor++;
+    }
+
+    for (const auto& updatedItem : _updatedItems) {
+        updateItemContainers(updatedItem.first, updatedItem.second);
+    }
+}
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            } else {
-                _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
-                item.resetCell();
+void Scene::updateItemContainers(ItemID id, const ItemKey& oldKey) {
+    auto& item = _items[id];
+    auto oldCell = item.getCell();
+    auto newKey = item.getKey();
 
-                _masterNonspatialSet.insert(updateID);
-            }
+    // Update the item's container
+    if (oldKey.isSpatial() == newKey.isSpatial()) {
+        if (newKey.isSpatial()) {
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), id, newKey);
+            item.resetCell(newCell, newKey.isSmall());
         }
+    } else {
+        if (newKey.isSpatial()) {
+            _masterNonspatialSet.erase(id);
 
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), id, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        } else {
+            _masterSpatialTree.removeItem(oldCell, oldKey, id);
+            item.resetCell();
 
-        // next loop
-        updateFunctor++;
+            _masterNonspatialSet.insert(id);
+        }
     }
 }
@@ -35,6 +35,9 @@ public:
     void updateItem(ItemID id) { updateItem(id, nullptr); }
 
     void merge(const PendingChanges& changes);
+    void merge(PendingChanges&& changes);
+
+    bool empty() const;
 
     ItemIDs _resetItems; 
     Payloads _resetPayloads;
@@ -44,7 +47,6 @@ public:
 
 protected:
 };
-typedef std::queue<PendingChanges> PendingChangesQueue;
 
 
 // Scene is a container for Items
@@ -66,8 +68,9 @@ public:
     // THis is the total number of allocated items, this a threadsafe call
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
-    // Enqueue change batch to the scene
+    // Enqueue change batch to the scene, this is a lock free call
     void enqueuePendingChanges(const PendingChanges& pendingChanges);
+    void enqueuePendingChanges(PendingChanges&& pendingChanges);
 
     // Process the penging changes equeued
     void processPendingChangesQueue();
@@ -87,12 +90,25 @@ public:
     // Access non-spatialized items (overlays, backgrounds)
     const ItemIDSet& getNonspatialSet() const { return _masterNonspatialSet; }
 
+    // The count of the pending changes queue processed so far, the frame of the changes
+    uint32_t getChangeFrame() const { return _changeFrame; }
+    // The change frame an item was last reset or updated at
+    uint32_t getItemChangeFrame(const ItemID& id) const { return (id < _itemChangeFrames.size() ? _itemChangeFrames[id] : _changeFrame); }
+
 protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _changeQueueMutex;
-    PendingChangesQueue _changeQueue;
+
+    // The change batches enqueued, pushed on a lock free list in reverse order and all taken at once when processed
+    class PendingChangesNode {
+    public:
+        PendingChangesNode(PendingChanges&& changes) : _changes(std::move(changes)) {}
+        PendingChanges _changes;
+        PendingChangesNode* _next { nullptr };
+    };
+    std::atomic<PendingChangesNode*> _pendingChangesHead { nullptr };
+    void pushPendingChanges(PendingChangesNode* node);
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -101,9 +117,20 @@ protected:
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
+    // The items updated by the changes being processed, with their key before the first update,
+    // to move each in its containers once however many times it's updated
+    std::vector<uint32_t> _updateStamps;
+    uint32_t _updateStamp { 0 };
+    std::vector<std::pair<ItemID, ItemKey>> _updatedItems;
+
+    // The change frame of the last reset or update of each item, to tell the items standing still from the moving ones
+    uint32_t _changeFrame { 0 };
+    std::vector<uint32_t> _itemChangeFrames;
+
     void resetItems(const ItemIDs& ids, Payloads& payloads);
     void removeItems(const ItemIDs& ids);
     void updateItems(const ItemIDs& ids, UpdateFunctors& functors);
+    void updateItemContainers(ItemID id, const ItemKey& oldKey);
 
     friend class Engine;
 };
@@ -9,12 +9,29 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
+#include <gpu/Context.h>
+#include <Profile.h>
+
 #include "Task.h"
 
 using namespace render;
 
+namespace {
+    // The Mac backend times with GL_TIME_ELAPSED queries, which don't nest, and a job's would hide those of the jobs
+    // timing themselves within it. Elsewhere they're timestamps, and cost a batch on either side of the job's.
+    bool isJobGPUTimingEnabled() {
+#ifdef Q_OS_MAC
+        return false;
+#else
+        static const bool enabled = !QProcessEnvironment::systemEnvironment().contains("HIFI_DISABLE_JOB_GPU_TIMERS");
+        return enabled;
+#endif
+    }
+}
+
 void TaskConfig::refresh() {
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "refresh", Qt::BlockingQueuedConnection);
@@ -24,3 +41,40 @@ void TaskConfig::refresh() {
     _task->configure(*this);
 }
 
+
+size_t Job::Concept::beginGPURange(const RenderContextPointer& renderContext) {
+    auto config = std::static_pointer_cast<Config>(_config);
+    RenderArgs* args = renderContext->args;
+    if (!isJobGPUTimingEnabled() || config->isGPUTimedByJob() || !args || !args->_context || !args->_context->isFrameActive()) {
+        return gpu::Context::INVALID_FRAME_BATCH;
+    }
+    return args->_context->reserveFrameBatch();
+}
+
+void Job::Concept::endGPURange(const RenderContextPointer& renderContext, size_t rangeBatch, const std::string& name) {
+    if (rangeBatch == gpu::Context::INVALID_FRAME_BATCH) {
+        return;
+    }
+    const auto& context = renderContext->args->_context;
+    // Nothing to time
+    if (context->cancelFrameBatch(rangeBatch)) {
+        return;
+    }
+
+    if (!_gpuTimer) {
+        _gpuTimer = std::make_shared<gpu::RangeTimer>(name);
+    }
+    gpu::Batch beginBatch;
+    _gpuTimer->begin(beginBatch);
+    context->setFrameBatch(rangeBatch, beginBatch);
+    gpu::Batch endBatch;
+    _gpuTimer->end(endBatch);
+    context->appendFrameBatch(endBatch);
+
+    double gpuTime = _gpuTimer->getGPUAverage();
+    double batchTime = _gpuTimer->getBatchAverage();
+    std::static_pointer_cast<Config>(_config)->setGPUBatchRunTime(gpuTime, batchTime);
+    if (trace_render_gpu().isDebugEnabled()) {
+        PROFILE_COUNTER(render_gpu, QString::fromStdString(name), { { "gpuTime", gpuTime }, { "batchTime", batchTime } });
+    }
+}
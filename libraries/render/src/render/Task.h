@@ -371,9 +371,13 @@ protected:
 class JobConfig : public QObject {
     Q_OBJECT
     Q_PROPERTY(double cpuRunTime READ getCPURunTime NOTIFY newStats()) //ms
+    Q_PROPERTY(double gpuRunTime READ getGPURunTime NOTIFY newStats()) //ms
+    Q_PROPERTY(double batchRunTime READ getBatchRunTime NOTIFY newStats()) //ms
     Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled)
 
     double _msCPURunTime{ 0.0 };
+    double _msGPURunTime { 0.0 };
+    double _msBatchRunTime { 0.0 };
 public:
     using Persistent = PersistentConfig<JobConfig>;
 
@@ -404,12 +408,22 @@ public:
     void setCPURunTime(double mstime) { _msCPURunTime = mstime; emit newStats(); }
     double getCPURunTime() const { return _msCPURunTime; }
 
+    // Running Time measurement on GPU and for Batch execution, of the batches the job adds to the frame,
+    // timed by the engine unless the job times them itself
+    void setGPUBatchRunTime(double msGpuTime, double msBatchTime) { _msGPURunTime = msGpuTime; _msBatchRunTime = msBatchTime; }
+    double getGPURunTime() const { return _msGPURunTime; }
+    double getBatchRunTime() const { return _msBatchRunTime; }
+    bool isGPUTimedByJob() const { return _isGPUTimedByJob; }
+
 public slots:
     void load(const QJsonObject& val) { qObjectFromJsonValue(val, *this); emit loaded(); }
 
 signals:
     void loaded();
     void newStats();
+
+protected:
+    bool _isGPUTimedByJob { false };
 };
 
 class TaskConfig : public JobConfig {
@@ -458,32 +472,18 @@ template <class T, class I, class O> void jobRun(T& data, const SceneContextPoin
     data.run(sceneContext, renderContext, input, output);
 }
 
+// The config of a job running its own gpu::RangeTimer, which the engine then doesn't time
 class GPUJobConfig : public JobConfig {
     Q_OBJECT
-    Q_PROPERTY(double gpuRunTime READ getGPURunTime)
-    Q_PROPERTY(double batchRunTime READ getBatchRunTime)
-
-    double _msGPURunTime { 0.0 };
-    double _msBatchRunTime { 0.0 };
 public:
     using Persistent = PersistentConfig<GPUJobConfig>;
 
-    GPUJobConfig() = default;
-    GPUJobConfig(bool enabled) : JobConfig(enabled) {}
-
-    // Running Time measurement on GPU and for Batch execution
-    void setGPUBatchRunTime(double msGpuTime, double msBatchTime) { _msGPURunTime = msGpuTime; _msBatchRunTime = msBatchTime; }
-    double getGPURunTime() const { return _msGPURunTime; }
-    double getBatchRunTime() const { return _msBatchRunTime; }
+    GPUJobConfig() { _isGPUTimedByJob = true; }
+    GPUJobConfig(bool enabled) : JobConfig(enabled) { _isGPUTimedByJob = true; }
 };
 
 class GPUTaskConfig : public TaskConfig {
     Q_OBJECT
-    Q_PROPERTY(double gpuRunTime READ getGPURunTime)
-    Q_PROPERTY(double batchRunTime READ getBatchRunTime)
-
-    double _msGPURunTime { 0.0 };
-    double _msBatchRunTime { 0.0 };
 public:
 
     using Persistent = PersistentConfig<GPUTaskConfig>;
@@ -491,11 +491,6 @@ public:
 
     GPUTaskConfig() = default;
     GPUTaskConfig(bool enabled) : TaskConfig(enabled) {}
-
-    // Running Time measurement on GPU and for Batch execution
-    void setGPUBatchRunTime(double msGpuTime, double msBatchTime) { _msGPURunTime = msGpuTime; _msBatchRunTime = msBatchTime; }
-    double getGPURunTime() const { return _msGPURunTime; }
-    double getBatchRunTime() const { return _msBatchRunTime; }
 };
 
 class Job {
@@ -521,7 +516,13 @@ public:
     protected:
         void setCPURunTime(double mstime) { std::static_pointer_cast<Config>(_config)->setCPURunTime(mstime); }
 
+        // Time on the GPU the batches the job adds to the frame, between a batch reserved before it runs and one
+        // appended after; the timer's queries are read back a few frames later, so the times lag as much
+        size_t beginGPURange(const RenderContextPointer& renderContext);
+        void endGPURange(const RenderContextPointer& renderContext, size_t rangeBatch, const std::string& name);
+
         QConfigPointer _config;
+        gpu::RangeTimerPointer _gpuTimer;
 
         friend class Job;
     };
@@ -579,9 +580,11 @@ public:
         PerformanceTimer perfTimer(_name.c_str());
         PROFILE_RANGE(render, _name.c_str());
         auto start = usecTimestampNow();
+        size_t gpuRangeBatch = _concept->beginGPURange(renderContext);
 
         _concept->run(sceneContext, renderContext);
 
+        _concept->endGPURange(renderContext, gpuRangeBatch, _name);
         _concept->setCPURunTime((double)(usecTimestampNow() - start) / 1000.0);
     }
 
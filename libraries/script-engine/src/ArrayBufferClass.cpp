@@ -72,14 +72,15 @@ QScriptValue ArrayBufferClass::newInstance(qint32 size) {
         return QScriptValue();
     }
     
-    engine()->reportAdditionalMemoryCost(size);
     QScriptEngine* eng = engine();
     QVariant variant = QVariant::fromValue(QByteArray(size, 0));
     QScriptValue data =  eng->newVariant(variant);
+    _scriptEngine->addArrayBufferMemoryCost(data, size);
     return engine()->newObject(this, data);
 }
 
 QScriptValue ArrayBufferClass::newInstance(const QByteArray& ba) {
+    // the data is shared with whoever made it, so it isn't counted as the script's
     QScriptValue data = engine()->newVariant(QVariant::fromValue(ba));
     return engine()->newObject(this, data);
 }
@@ -149,6 +150,14 @@ QScriptValue ArrayBufferClass::toScriptValue(QScriptEngine* engine, const QByteA
     return cls->newInstance(ba);
 }
 
+bool ArrayBufferClass::toByteArray(const QScriptValue& value, QByteArray& bytes) {
+    if (!value.isObject() || !value.scriptClass() || value.scriptClass()->name() != CLASS_NAME) {
+        return false;
+    }
+    fromScriptValue(value, bytes);
+    return true;
+}
+
 void ArrayBufferClass::fromScriptValue(const QScriptValue& obj, QByteArray& ba) {
     ba = qvariant_cast<QByteArray>(obj.data().toVariant());
 }
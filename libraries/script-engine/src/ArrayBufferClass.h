@@ -42,6 +42,11 @@ public:
 
     ScriptEngine* getEngine() { return _scriptEngine; }
 
+    // ArrayBuffers are backed by an implicitly shared QByteArray, so wrapping C++ data in one, or taking the data out
+    // of one as here, doesn't copy it; a copy is only made if either side then writes to it.
+    // Returns false if the value isn't an ArrayBuffer.
+    static bool toByteArray(const QScriptValue& value, QByteArray& bytes);
+
 private:
     static QScriptValue construct(QScriptContext* context, QScriptEngine* engine);
 
@@ -19,13 +19,18 @@
 #include <NetworkLogging.h>
 #include <NodeList.h>
 
+#include "ArrayBufferClass.h"
+
 AssetScriptingInterface::AssetScriptingInterface(QScriptEngine* engine) :
     _engine(engine)
 {
 }
 
-void AssetScriptingInterface::uploadData(QString data, QScriptValue callback) {
-    QByteArray dataByteArray = data.toUtf8();
+void AssetScriptingInterface::uploadData(QScriptValue data, QScriptValue callback) {
+    QByteArray dataByteArray;
+    if (!ArrayBufferClass::toByteArray(data, dataByteArray)) {
+        dataByteArray = data.toString().toUtf8();
+    }
     auto upload = DependencyManager::get<AssetClient>()->createUpload(dataByteArray);
 
     QObject::connect(upload, &AssetUpload::finished, this, [this, callback](AssetUpload* upload, const QString& hash) mutable {
@@ -53,7 +58,7 @@ void AssetScriptingInterface::setMapping(QString path, QString hash, QScriptValu
 }
 
 
-void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callback) {
+void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callback, bool asArrayBuffer) {
     const QString ATP_SCHEME { "atp:" };
 
     if (!urlString.startsWith(ATP_SCHEME)) {
@@ -70,12 +75,13 @@ void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callb
 
     _pendingRequests << assetRequest;
 
-    connect(assetRequest, &AssetRequest::finished, this, [this, callback](AssetRequest* request) mutable {
+    connect(assetRequest, &AssetRequest::finished, this, [this, callback, asArrayBuffer](AssetRequest* request) mutable {
         Q_ASSERT(request->getState() == AssetRequest::Finished);
 
         if (request->getError() == AssetRequest::Error::NoError) {
             if (callback.isFunction()) {
-                QString data = QString::fromUtf8(request->getData());
+                QScriptValue data = asArrayBuffer ? _engine->toScriptValue(request->getData()) :
+                    QScriptValue(QString::fromUtf8(request->getData()));
                 QScriptValueList args { data };
                 callback.call(_engine->currentContext()->thisObject(), args);
             }
@@ -31,7 +31,7 @@ public:
      * Upload content to the connected domain's asset server.
      * @function Assets.uploadData
      * @static
-     * @param data {string} content to upload
+     * @param data {string|ArrayBuffer} content to upload
      * @param callback {Assets~uploadDataCallback} called when upload is complete
      */
 
@@ -42,7 +42,7 @@ public:
      * @param {string} hash
      */
 
-    Q_INVOKABLE void uploadData(QString data, QScriptValue callback);
+    Q_INVOKABLE void uploadData(QScriptValue data, QScriptValue callback);
 
     /**jsdoc
      * Download data from the connected domain's asset server.
@@ -50,15 +50,17 @@ public:
      * @static
      * @param url {string} url of asset to download, must be atp scheme url.
      * @param callback {Assets~downloadDataCallback}
+     * @param [asArrayBuffer=false] {bool} pass the content as an ArrayBuffer, sharing the downloaded data, rather
+     *     than as a string
      */
 
     /**jsdoc
      * Called when downloadData is complete
      * @callback Assets~downloadDataCallback
-     * @param data {string} content that was downloaded
+     * @param data {string|ArrayBuffer} content that was downloaded
      */
 
-    Q_INVOKABLE void downloadData(QString url, QScriptValue downloadComplete);
+    Q_INVOKABLE void downloadData(QString url, QScriptValue downloadComplete, bool asArrayBuffer = false);
 
     /**jsdoc
      * Sets up a path to hash mapping within the connected domain's asset server
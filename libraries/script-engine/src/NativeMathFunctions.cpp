@@ -0,0 +1,227 @@
+//
+//  NativeMathFunctions.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NativeMathFunctions.h"
+
+#include <QtScript/QScriptContext>
+#include <QtScript/QScriptString>
+
+#include <GLMHelpers.h>
+
+namespace {
+
+// the property names as engine string handles, which skip the name lookup each access does with a QString
+struct PropertyNames {
+    QScriptEngine* engine { nullptr };
+    QScriptString x, y, z, w;
+    QScriptString matrix[4][4]; // [column][row], as in glm
+};
+
+// an engine only ever runs on one thread, so this is only rebuilt when a thread switches engines
+thread_local PropertyNames propertyNames;
+
+const PropertyNames& getPropertyNames(QScriptEngine* engine) {
+    if (propertyNames.engine != engine || !propertyNames.x.isValid()) {
+        propertyNames.engine = engine;
+        propertyNames.x = engine->toStringHandle("x");
+        propertyNames.y = engine->toStringHandle("y");
+        propertyNames.z = engine->toStringHandle("z");
+        propertyNames.w = engine->toStringHandle("w");
+        for (int column = 0; column < 4; column++) {
+            for (int row = 0; row < 4; row++) {
+                propertyNames.matrix[column][row] = engine->toStringHandle(QString("r%1c%2").arg(row).arg(column));
+            }
+        }
+    }
+    return propertyNames;
+}
+
+// matches the metatype converters, which read a missing or non-numeric property through QVariant
+float toFloat(const QScriptValue& value) {
+    return value.isNumber() ? (float)value.toNumber() : value.toVariant().toFloat();
+}
+
+glm::vec3 toVec3(const PropertyNames& names, const QScriptValue& object) {
+    return glm::vec3(toFloat(object.property(names.x)), toFloat(object.property(names.y)),
+        toFloat(object.property(names.z)));
+}
+
+glm::quat toQuat(const PropertyNames& names, const QScriptValue& object) {
+    glm::quat quat(toFloat(object.property(names.w)), toFloat(object.property(names.x)),
+        toFloat(object.property(names.y)), toFloat(object.property(names.z)));
+
+    // enforce normalized quaternion, as quatFromScriptValue does
+    float length = glm::length(quat);
+    return length > FLT_EPSILON ? quat / length : glm::quat();
+}
+
+glm::mat4 toMat4(const PropertyNames& names, const QScriptValue& object) {
+    glm::mat4 mat4;
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            mat4[column][row] = toFloat(object.property(names.matrix[column][row]));
+        }
+    }
+    return mat4;
+}
+
+QScriptValue toScriptValue(QScriptEngine* engine, const PropertyNames& names, const glm::vec3& vec3) {
+    QScriptValue object = engine->newObject();
+    if (isNaN(vec3)) {
+        // if vec3 contains a NaN don't try to convert it
+        return object;
+    }
+    object.setProperty(names.x, vec3.x);
+    object.setProperty(names.y, vec3.y);
+    object.setProperty(names.z, vec3.z);
+    return object;
+}
+
+QScriptValue toScriptValue(QScriptEngine* engine, const PropertyNames& names, const glm::quat& quat) {
+    QScriptValue object = engine->newObject();
+    if (isNaN(quat)) {
+        // if quat contains a NaN don't try to convert it
+        return object;
+    }
+    object.setProperty(names.x, quat.x);
+    object.setProperty(names.y, quat.y);
+    object.setProperty(names.z, quat.z);
+    object.setProperty(names.w, quat.w);
+    return object;
+}
+
+QScriptValue toScriptValue(QScriptEngine* engine, const PropertyNames& names, const glm::mat4& mat4) {
+    QScriptValue object = engine->newObject();
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            object.setProperty(names.matrix[column][row], mat4[column][row]);
+        }
+    }
+    return object;
+}
+
+bool hasArguments(QScriptContext* context, int numArguments) {
+    if (context->argumentCount() < numArguments) {
+        context->throwError(QScriptContext::SyntaxError, QString("expected %1 arguments").arg(numArguments));
+        return false;
+    }
+    return true;
+}
+
+// defines a native function of numArguments taking (names, context) and returning the value to hand back to the script
+#define NATIVE_MATH_FUNCTION(name, numArguments, expression)                                \
+    QScriptValue name(QScriptContext* context, QScriptEngine* engine) {                    \
+        if (!hasArguments(context, numArguments)) {                                        \
+            return QScriptValue();                                                          \
+        }                                                                                   \
+        const PropertyNames& names = getPropertyNames(engine);                              \
+        auto arg = [&](int i) { return context->argument(i); };                             \
+        return toScriptValue(engine, names, expression);                                    \
+    }
+
+#define NATIVE_MATH_NUMBER_FUNCTION(name, numArguments, expression)                         \
+    QScriptValue name(QScriptContext* context, QScriptEngine* engine) {                    \
+        if (!hasArguments(context, numArguments)) {                                        \
+            return QScriptValue();                                                          \
+        }                                                                                   \
+        const PropertyNames& names = getPropertyNames(engine);                              \
+        auto arg = [&](int i) { return context->argument(i); };                             \
+        return QScriptValue((qsreal)(expression));                                          \
+    }
+
+#define V(i) toVec3(names, arg(i))
+#define Q(i) toQuat(names, arg(i))
+#define M(i) toMat4(names, arg(i))
+#define F(i) toFloat(arg(i))
+
+NATIVE_MATH_FUNCTION(vec3Sum, 2, V(0) + V(1))
+NATIVE_MATH_FUNCTION(vec3Subtract, 2, V(0) - V(1))
+NATIVE_MATH_FUNCTION(vec3Multiply, 2, arg(0).isNumber() ? V(1) * F(0) : V(0) * F(1))
+NATIVE_MATH_FUNCTION(vec3MultiplyVbyV, 2, V(0) * V(1))
+NATIVE_MATH_FUNCTION(vec3MultiplyQbyV, 2, Q(0) * V(1))
+NATIVE_MATH_FUNCTION(vec3Cross, 2, glm::cross(V(0), V(1)))
+NATIVE_MATH_FUNCTION(vec3Normalize, 1, glm::normalize(V(0)))
+NATIVE_MATH_FUNCTION(vec3Mix, 3, glm::mix(V(0), V(1), F(2)))
+NATIVE_MATH_NUMBER_FUNCTION(vec3Dot, 2, glm::dot(V(0), V(1)))
+NATIVE_MATH_NUMBER_FUNCTION(vec3Length, 1, glm::length(V(0)))
+NATIVE_MATH_NUMBER_FUNCTION(vec3Distance, 2, glm::distance(V(0), V(1)))
+
+NATIVE_MATH_FUNCTION(quatMultiply, 2, Q(0) * Q(1))
+NATIVE_MATH_FUNCTION(quatInverse, 1, glm::inverse(Q(0)))
+NATIVE_MATH_FUNCTION(quatConjugate, 1, glm::conjugate(Q(0)))
+NATIVE_MATH_FUNCTION(quatGetForward, 1, Q(0) * Vectors::FRONT)
+NATIVE_MATH_FUNCTION(quatGetRight, 1, Q(0) * Vectors::RIGHT)
+NATIVE_MATH_FUNCTION(quatGetUp, 1, Q(0) * Vectors::UP)
+NATIVE_MATH_FUNCTION(quatSlerp, 3, glm::slerp(Q(0), Q(1), F(2)))
+NATIVE_MATH_NUMBER_FUNCTION(quatDot, 2, glm::dot(Q(0), Q(1)))
+
+NATIVE_MATH_FUNCTION(mat4Multiply, 2, M(0) * M(1))
+NATIVE_MATH_FUNCTION(mat4TransformPoint, 2, transformPoint(M(0), V(1)))
+NATIVE_MATH_FUNCTION(mat4TransformVector, 2, transformVectorFast(M(0), V(1)))
+
+#undef V
+#undef Q
+#undef M
+#undef F
+#undef NATIVE_MATH_FUNCTION
+#undef NATIVE_MATH_NUMBER_FUNCTION
+
+struct NativeFunction {
+    const char* name;
+    QScriptEngine::FunctionSignature function;
+    int numArguments;
+};
+
+void replaceLibrary(QScriptEngine* engine, const QString& name, std::initializer_list<NativeFunction> functions) {
+    QScriptValue slotLibrary = engine->globalObject().property(name);
+    if (!slotLibrary.isQObject()) {
+        return;
+    }
+    QScriptValue library = engine->newObject();
+    library.setPrototype(slotLibrary);
+    for (auto& function : functions) {
+        library.setProperty(function.name, engine->newFunction(function.function, function.numArguments));
+    }
+    engine->globalObject().setProperty(name, library);
+}
+
+}
+
+void registerNativeMathFunctions(QScriptEngine* engine) {
+    replaceLibrary(engine, "Vec3", {
+        { "sum", vec3Sum, 2 },
+        { "subtract", vec3Subtract, 2 },
+        { "multiply", vec3Multiply, 2 },
+        { "multiplyVbyV", vec3MultiplyVbyV, 2 },
+        { "multiplyQbyV", vec3MultiplyQbyV, 2 },
+        { "cross", vec3Cross, 2 },
+        { "normalize", vec3Normalize, 1 },
+        { "mix", vec3Mix, 3 },
+        { "dot", vec3Dot, 2 },
+        { "length", vec3Length, 1 },
+        { "distance", vec3Distance, 2 }
+    });
+    replaceLibrary(engine, "Quat", {
+        { "multiply", quatMultiply, 2 },
+        { "inverse", quatInverse, 1 },
+        { "conjugate", quatConjugate, 1 },
+        { "getFront", quatGetForward, 1 },
+        { "getForward", quatGetForward, 1 },
+        { "getRight", quatGetRight, 1 },
+        { "getUp", quatGetUp, 1 },
+        { "slerp", quatSlerp, 3 },
+        { "dot", quatDot, 2 }
+    });
+    replaceLibrary(engine, "Mat4", {
+        { "multiply", mat4Multiply, 2 },
+        { "transformPoint", mat4TransformPoint, 2 },
+        { "transformVector", mat4TransformVector, 2 }
+    });
+}
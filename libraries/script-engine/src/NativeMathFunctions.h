@@ -0,0 +1,23 @@
+//
+//  NativeMathFunctions.h
+//  libraries/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_NativeMathFunctions_h
+#define hifi_NativeMathFunctions_h
+
+#include <QtScript/QScriptEngine>
+
+// Replaces the global Vec3, Quat and Mat4 objects' hottest methods with native functions.  These read their {x,y,z}
+// arguments' properties directly, where a slot call marshals each argument through QVariant and the metatype
+// converters, which dominates math-heavy scripts.  Each library object becomes a plain object whose prototype is the
+// registered QObject, so its other methods and constants are unchanged.  Call after registering the three objects.
+void registerNativeMathFunctions(QScriptEngine* engine);
+
+#endif // hifi_NativeMathFunctions_h
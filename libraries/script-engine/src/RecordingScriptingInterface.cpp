@@ -73,6 +73,7 @@ bool RecordingScriptingInterface::loadRecording(const QString& url) {
         return false;
     }
 
+    _player->removeAllClips();
     _player->queueClip(loader->getClip());
     return true;
 }
@@ -238,6 +239,7 @@ void RecordingScriptingInterface::loadLastRecording() {
         return;
     }
 
+    _player->removeAllClips();
     _player->queueClip(_lastClip);
     _player->play();
 }
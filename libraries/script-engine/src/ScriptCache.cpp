@@ -20,6 +20,7 @@
 #include <QThread>
 #include <QRegularExpression>
 #include <QMetaEnum>
+#include <QCryptographicHash>
 
 #include <assert.h>
 #include <SharedUtil.h>
@@ -41,6 +42,7 @@ void ScriptCache::clearCache() {
         qCDebug(scriptengine) << "clearing cache: " << url;
     }
     _scriptCache.clear();
+    _checkedEntityScripts.clear();
 }
 
 void ScriptCache::clearATPScriptsFromCache() {
@@ -65,6 +67,22 @@ void ScriptCache::deleteScript(const QUrl& unnormalizedURL) {
     }
 }
 
+static QByteArray hashScriptContents(const QString& contents) {
+    return QCryptographicHash::hash(contents.toUtf8(), QCryptographicHash::Sha1);
+}
+
+bool ScriptCache::isCheckedEntityScript(const QString& fileName, const QString& contents) {
+    auto hash = hashScriptContents(contents);
+    Lock lock(_containerLock);
+    return _checkedEntityScripts.value(fileName) == hash;
+}
+
+void ScriptCache::setCheckedEntityScript(const QString& fileName, const QString& contents) {
+    auto hash = hashScriptContents(contents);
+    Lock lock(_containerLock);
+    _checkedEntityScripts.insert(fileName, hash);
+}
+
 void ScriptCache::getScriptContents(const QString& scriptOrURL, contentAvailableCallback contentAvailable, bool forceDownload, int maxRetries) {
     #ifdef THREAD_DEBUGGING
     qCDebug(scriptengine) << "ScriptCache::getScriptContents() on thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
@@ -53,6 +53,10 @@ public:
 
     void deleteScript(const QUrl& unnormalizedURL);
 
+    // entity script source that has passed the syntax and constructor checks, which any engine loading it again skips
+    bool isCheckedEntityScript(const QString& fileName, const QString& contents);
+    void setCheckedEntityScript(const QString& fileName, const QString& contents);
+
 private:
     void scriptContentAvailable(int maxRetries); // new version
     ScriptCache(QObject* parent = NULL);
@@ -62,6 +66,7 @@ private:
     
     QHash<QUrl, QString> _scriptCache;
     QMultiMap<QUrl, ScriptUser*> _scriptUsers;
+    QHash<QString, QByteArray> _checkedEntityScripts; // file name to the hash of its checked contents
 };
 
 #endif // hifi_ScriptCache_h
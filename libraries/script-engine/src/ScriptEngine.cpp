@@ -58,10 +58,12 @@
 #include "EventTypes.h"
 #include "FileScriptingInterface.h" // unzip project
 #include "MenuItemProperties.h"
+#include "NativeMathFunctions.h"
 #include "ScriptAudioInjector.h"
 #include "ScriptCache.h"
 #include "ScriptEngineLogging.h"
 #include "ScriptEngine.h"
+#include "ScriptProfiler.h"
 #include "TypedArrays.h"
 #include "XMLHttpRequestClass.h"
 #include "WebSocketClass.h"
@@ -161,12 +163,18 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
+    _timersTimer(new QTimer(this)),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this))
 {
     DependencyManager::get<ScriptEngines>()->addScriptEngine(this);
 
+    _timersTimer->setSingleShot(true);
+    _timersTimer->setTimerType(Qt::PreciseTimer);
+    connect(_timersTimer, &QTimer::timeout, this, &ScriptEngine::timersFired);
+    // make sure the timers stop when the script does
+    connect(this, &ScriptEngine::scriptEnding, _timersTimer, &QTimer::stop);
+
     connect(this, &QScriptEngine::signalHandlerException, this, [this](const QScriptValue& exception) {
         if (hasUncaughtException()) {
             // the engine's uncaughtException() seems to produce much better stack traces here
@@ -317,6 +325,10 @@ void ScriptEngine::runDebuggable() {
         }
         _lastUpdate = now;
 
+        if (_bytesSinceGarbageCollection > _garbageCollectionThreshold) {
+            collectGarbageNow();
+        }
+
         // only clear exceptions if we are not in the middle of evaluating
         if (!isEvaluating() && hasUncaughtException()) {
             qCWarning(scriptengine) << __FUNCTION__ << "---------- UNCAUGHT EXCEPTION --------";
@@ -599,6 +611,7 @@ void ScriptEngine::init() {
     qScriptRegisterMetaType(this, EntityItemPropertiesToScriptValue, EntityItemPropertiesFromScriptValueHonorReadOnly);
     qScriptRegisterMetaType(this, EntityItemIDtoScriptValue, EntityItemIDfromScriptValue);
     qScriptRegisterMetaType(this, RayToEntityIntersectionResultToScriptValue, RayToEntityIntersectionResultFromScriptValue);
+    qScriptRegisterMetaType(this, EntitiesWithPropertiesToScriptValue, EntitiesWithPropertiesFromScriptValue);
     qScriptRegisterMetaType(this, RayToAvatarIntersectionResultToScriptValue, RayToAvatarIntersectionResultFromScriptValue);
     qScriptRegisterMetaType(this, AvatarEntityMapToScriptValue, AvatarEntityMapFromScriptValue);
     qScriptRegisterSequenceMetaType<QVector<QUuid>>(this);
@@ -647,6 +660,7 @@ void ScriptEngine::init() {
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
     registerGlobalObject("Mat4", &_mat4Library);
+    registerNativeMathFunctions(this);
     registerGlobalObject("Uuid", &_uuidLibrary);
     registerGlobalObject("Messages", DependencyManager::get<MessagesClient>().data());
 
@@ -938,23 +952,31 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
         return result;
     }
 
-    // Check syntax
-    auto syntaxError = lintScript(sourceCode, fileName);
-    if (syntaxError.isError()) {
-        if (!isEvaluating()) {
-            syntaxError.setProperty("detail", "evaluate");
+    // reuse the program already checked and compiled for this file, while its source is unchanged
+    bool isCacheable = !fileName.isEmpty() && lineNumber == 1;
+    QScriptProgram program = isCacheable ? _programCache.value(fileName) : QScriptProgram();
+    if (program.isNull() || program.sourceCode() != sourceCode) {
+        // Check syntax
+        auto syntaxError = lintScript(sourceCode, fileName);
+        if (syntaxError.isError()) {
+            if (!isEvaluating()) {
+                syntaxError.setProperty("detail", "evaluate");
+            }
+            raiseException(syntaxError);
+            maybeEmitUncaughtException("lint");
+            return syntaxError;
+        }
+        program = QScriptProgram(sourceCode, fileName, lineNumber);
+        if (program.isNull()) {
+            // can this happen?
+            auto err = makeError("could not create QScriptProgram for " + fileName);
+            raiseException(err);
+            maybeEmitUncaughtException("compile");
+            return err;
+        }
+        if (isCacheable) {
+            _programCache.insert(fileName, program);
         }
-        raiseException(syntaxError);
-        maybeEmitUncaughtException("lint");
-        return syntaxError;
-    }
-    QScriptProgram program { sourceCode, fileName, lineNumber };
-    if (program.isNull()) {
-        // can this happen?
-        auto err = makeError("could not create QScriptProgram for " + fileName);
-        raiseException(err);
-        maybeEmitUncaughtException("compile");
-        return err;
     }
 
     QScriptValue result;
@@ -1111,6 +1133,10 @@ void ScriptEngine::run() {
         }
         _lastUpdate = now;
 
+        if (_bytesSinceGarbageCollection > _garbageCollectionThreshold) {
+            collectGarbageNow();
+        }
+
         // only clear exceptions if we are not in the middle of evaluating
         if (!isEvaluating() && hasUncaughtException()) {
             qCWarning(scriptengine) << __FUNCTION__ << "---------- UNCAUGHT EXCEPTION --------";
@@ -1150,11 +1176,8 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timer : _timers.keys()) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
         stopTimer(timer);
     }
@@ -1162,15 +1185,12 @@ void ScriptEngine::stopAllTimers() {
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
      // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
+    QVector<QObject*> toDelete;
+    for (auto i = _timers.cbegin(); i != _timers.cend(); ++i) {
+        if (i.value().callback.definingEntityIdentifier != entityID) {
             continue;
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
+        toDelete << i.key(); // don't delete while we're iterating. save it.
     }
     for (auto timer:toDelete) { // now reap 'em
         stopTimer(timer);
@@ -1220,12 +1240,93 @@ void ScriptEngine::callAnimationStateHandler(QScriptValue callback, AnimVariantM
 }
 
 void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
+    _resourceBytes += deltaSize;
     if (deltaSize > 0) {
         reportAdditionalMemoryCost(deltaSize);
+        _bytesSinceGarbageCollection += deltaSize;
+        if (_profiler) {
+            _profiler->addMemoryCost(deltaSize);
+        }
+    }
+}
+
+namespace {
+    // held by an ArrayBuffer's data value, with script ownership, so that its bytes are counted down once the
+    // collector frees it
+    class ArrayBufferMemoryCost : public QObject {
+    public:
+        ArrayBufferMemoryCost(std::shared_ptr<std::atomic<qint64>> arrayBufferBytes, qint64 bytes) :
+            _arrayBufferBytes(arrayBufferBytes), _bytes(bytes) {
+            *_arrayBufferBytes += _bytes;
+        }
+        ~ArrayBufferMemoryCost() { *_arrayBufferBytes -= _bytes; }
+
+    private:
+        std::shared_ptr<std::atomic<qint64>> _arrayBufferBytes;
+        qint64 _bytes;
+    };
+}
+
+void ScriptEngine::addArrayBufferMemoryCost(QScriptValue& bufferData, qint64 bytes) {
+    if (bytes > 0) {
+        reportAdditionalMemoryCost(bytes);
+        auto memoryCost = new ArrayBufferMemoryCost(_arrayBufferBytes, bytes);
+        bufferData.setProperty("memoryCost", newQObject(memoryCost, QScriptEngine::ScriptOwnership),
+                               READONLY_HIDDEN_PROP_FLAGS);
+        _bytesSinceGarbageCollection += bytes;
+        if (_profiler) {
+            _profiler->addMemoryCost(bytes);
+        }
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::collectGarbageNow() {
+    PROFILE_RANGE(script, __FUNCTION__);
+    quint64 start = usecTimestampNow();
+    collectGarbage();
+    _garbageCollectionUsecs += usecTimestampNow() - start;
+    _numGarbageCollections++;
+    _bytesSinceGarbageCollection = 0;
+}
+
+QVariantMap ScriptEngine::getMemoryStats() const {
+    QVariantMap stats;
+    stats.insert("resourceBytes", (qint64)_resourceBytes);
+    stats.insert("arrayBufferBytes", (qint64)*_arrayBufferBytes);
+    stats.insert("bytesSinceGarbageCollection", (qint64)_bytesSinceGarbageCollection);
+    stats.insert("garbageCollectionThreshold", (qint64)_garbageCollectionThreshold);
+    stats.insert("garbageCollections", (int)_numGarbageCollections);
+    stats.insert("garbageCollectionUsecs", (quint64)_garbageCollectionUsecs);
+    return stats;
+}
+
+void ScriptEngine::startProfiling() {
+    if (_debuggable) {
+        // the debugger is already this engine's agent
+        scriptWarningMessage("Script.startProfiling() is not available while debugging:" + getFilename());
+        return;
+    }
+    if (!_profiler) {
+        _profiler = new ScriptProfiler(this);
+        setAgent(_profiler);
+    }
+}
+
+QVariantMap ScriptEngine::profile() const {
+    return _profiler ? _profiler->getProfile() : QVariantMap();
+}
+
+QVariantMap ScriptEngine::stopProfiling() {
+    QVariantMap result = profile();
+    if (_profiler) {
+        setAgent(nullptr);
+        delete _profiler;
+        _profiler = nullptr;
+    }
+    return result;
+}
+
+void ScriptEngine::timersFired() {
     {
         auto engine = DependencyManager::get<ScriptEngines>();
         if (!engine || engine->isStopped()) {
@@ -1234,47 +1335,81 @@ void ScriptEngine::timerFired() {
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    // timers due within this of each other fire together, as coarse QTimers would have
+    static const std::chrono::milliseconds TIMER_COALESCING { 1 };
+    auto now = TimerClock::now();
+    std::vector<QObject*> dueTimers;
+    while (!_timersByDue.empty() && _timersByDue.begin()->first <= now + TIMER_COALESCING) {
+        dueTimers.push_back(_timersByDue.begin()->second);
+        _timersByDue.erase(_timersByDue.begin());
+    }
+
+    for (auto timer : dueTimers) {
+        // an earlier callback in this pass may have stopped this timer
+        auto i = _timers.find(timer);
+        if (i == _timers.end()) {
+            continue;
+        }
+        CallbackData timerData = i.value().callback;
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
+        if (i.value().isSingleShot) {
+            // this timer is done, we can kill it
+            _timers.erase(i);
+            _numTimers = _timers.size();
+            delete timer;
+        } else {
+            // keep to the interval, but don't try to catch up on the calls a late pass missed
+            auto& due = i.value().due;
+            due += i.value().interval;
+            if (due < now) {
+                due = now + i.value().interval;
+            }
+            _timersByDue.emplace(due, timer);
+        }
+
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(postTimer - preTimer);
+            _totalTimerExecution += elapsed;
+            _timerExecutionUsecs += elapsed.count();
+            _numTimerCallbacks++;
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+    scheduleTimers();
+}
+
+void ScriptEngine::scheduleTimers() {
+    if (_timersByDue.empty()) {
+        _timersTimer->stop();
+        return;
     }
+    auto untilDue = std::chrono::duration_cast<std::chrono::milliseconds>(_timersByDue.begin()->first - TimerClock::now());
+    _timersTimer->start(std::max(0, (int)untilDue.count()));
 }
 
 QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+    // the timer is only a handle for the script, and the key to its callback
+    QObject* newTimer = new QObject(this);
+
+    ScriptTimer timer;
+    timer.callback = { function, currentEntityIdentifier, currentSandboxURL };
+    timer.interval = std::chrono::milliseconds(std::max(0, intervalMS));
+    timer.isSingleShot = isSingleShot;
+    timer.due = TimerClock::now() + timer.interval;
+    _timers.insert(newTimer, timer);
+    _timersByDue.emplace(timer.due, newTimer);
+    _numTimers = _timers.size();
+
+    // restart the QTimer if this is now the first due
+    if (_timersByDue.begin()->second == newTimer) {
+        scheduleTimers();
     }
-
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
-
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
-
-    newTimer->start(intervalMS);
     return newTimer;
 }
 
@@ -1296,13 +1431,21 @@ QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
+void ScriptEngine::stopTimer(QObject* timer) {
+    auto i = _timers.find(timer);
+    if (i != _timers.end()) {
+        auto range = _timersByDue.equal_range(i.value().due);
+        for (auto due = range.first; due != range.second; ++due) {
+            if (due->second == timer) {
+                _timersByDue.erase(due);
+                break;
+            }
+        }
+        _timers.erase(i);
+        _numTimers = _timers.size();
         delete timer;
     } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+        qCDebug(scriptengine) << "stopTimer -- not in _timers" << timer;
     }
 }
 
@@ -2163,85 +2306,91 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         return;
     }
 
-    // SYNTAX ERRORS
-    auto syntaxError = lintScript(contents, fileName);
-    if (syntaxError.isError()) {
-        auto message = syntaxError.property("formatted").toString();
-        if (message.isEmpty()) {
-            message = syntaxError.toString();
+    // entities sharing a script, in this engine or any other, only check it the first time it loads
+    bool isChecked = scriptCache->isCheckedEntityScript(fileName, contents);
+    if (!isChecked) {
+        // SYNTAX ERRORS
+        auto syntaxError = lintScript(contents, fileName);
+        if (syntaxError.isError()) {
+            auto message = syntaxError.property("formatted").toString();
+            if (message.isEmpty()) {
+                message = syntaxError.toString();
+            }
+            setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            syntaxError.setProperty("detail", entityID.toString());
+            emit unhandledException(syntaxError);
+            return;
+        }
+        QScriptProgram program { contents, fileName };
+        if (program.isNull()) {
+            setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(makeError("program.isNull"));
+            return; // done processing script
         }
-        setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        syntaxError.setProperty("detail", entityID.toString());
-        emit unhandledException(syntaxError);
-        return;
-    }
-    QScriptProgram program { contents, fileName };
-    if (program.isNull()) {
-        setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(makeError("program.isNull"));
-        return; // done processing script
-    }
 
-    if (isURL) {
-        setParentURL(scriptOrURL);
-    }
+        // SANITY/PERFORMANCE CHECK USING SANDBOX
+        const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
+        BaseScriptEngine sandbox;
+        sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
+        QScriptValue testConstructor, exception;
+        {
+            QTimer timeout;
+            timeout.setSingleShot(true);
+            timeout.start(SANDBOX_TIMEOUT);
+            connect(&timeout, &QTimer::timeout, [&sandbox, SANDBOX_TIMEOUT, scriptOrURL]{
+                    qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout(" << scriptOrURL << ")";
+
+                    // Guard against infinite loops and non-performant code
+                    sandbox.raiseException(
+                        sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
+                    );
+            });
 
-    // SANITY/PERFORMANCE CHECK USING SANDBOX
-    const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
-    BaseScriptEngine sandbox;
-    sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
-    QScriptValue testConstructor, exception;
-    {
-        QTimer timeout;
-        timeout.setSingleShot(true);
-        timeout.start(SANDBOX_TIMEOUT);
-        connect(&timeout, &QTimer::timeout, [&sandbox, SANDBOX_TIMEOUT, scriptOrURL]{
-                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout(" << scriptOrURL << ")";
-
-                // Guard against infinite loops and non-performant code
-                sandbox.raiseException(
-                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
-                );
-        });
+            testConstructor = sandbox.evaluate(program);
 
-        testConstructor = sandbox.evaluate(program);
+            if (sandbox.hasUncaughtException()) {
+                exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
+                sandbox.clearExceptions();
+            } else if (testConstructor.isError()) {
+                exception = testConstructor;
+            }
+        }
 
-        if (sandbox.hasUncaughtException()) {
-            exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
-            sandbox.clearExceptions();
-        } else if (testConstructor.isError()) {
-            exception = testConstructor;
+        if (exception.isError()) {
+            // create a local copy using makeError to decouple from the sandbox engine
+            exception = makeError(exception);
+            setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(exception);
+            return;
         }
-    }
 
-    if (exception.isError()) {
-        // create a local copy using makeError to decouple from the sandbox engine
-        exception = makeError(exception);
-        setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(exception);
-        return;
-    }
+        // CONSTRUCTOR VIABILITY
+        if (!testConstructor.isFunction()) {
+            QString testConstructorType = QString(testConstructor.toVariant().typeName());
+            if (testConstructorType == "") {
+                testConstructorType = "empty";
+            }
+            QString testConstructorValue = testConstructor.toString();
+            if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
+                testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+            }
+            auto message = QString("failed to load entity script -- expected a function, got %1, %2")
+                .arg(testConstructorType).arg(testConstructorValue);
 
-    // CONSTRUCTOR VIABILITY
-    if (!testConstructor.isFunction()) {
-        QString testConstructorType = QString(testConstructor.toVariant().typeName());
-        if (testConstructorType == "") {
-            testConstructorType = "empty";
-        }
-        QString testConstructorValue = testConstructor.toString();
-        if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
-            testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+            auto err = makeError(message);
+            err.setProperty("fileName", scriptOrURL);
+            err.setProperty("detail", "(constructor " + entityID.toString() + ")");
+
+            setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(err);
+            return; // done processing script
         }
-        auto message = QString("failed to load entity script -- expected a function, got %1, %2")
-            .arg(testConstructorType).arg(testConstructorValue);
 
-        auto err = makeError(message);
-        err.setProperty("fileName", scriptOrURL);
-        err.setProperty("detail", "(constructor " + entityID.toString() + ")");
+        scriptCache->setCheckedEntityScript(fileName, contents);
+    }
 
-        setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(err);
-        return; // done processing script
+    if (isURL) {
+        setParentURL(scriptOrURL);
     }
 
     // (this feeds into refreshFileScript)
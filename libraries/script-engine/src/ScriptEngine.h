@@ -12,6 +12,7 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <map>
 #include <vector>
 
 #include <QtCore/QObject>
@@ -44,6 +45,7 @@
 #include "SettingHandle.h"
 
 class QScriptEngineDebugger;
+class ScriptProfiler;
 
 static const QString NO_SCRIPT("");
 
@@ -172,8 +174,18 @@ public:
 
     Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
     Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(timer); }
+    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(timer); }
+
+    int getNumTimers() const { return _numTimers; }
+    quint64 getNumTimerCallbacks() const { return _numTimerCallbacks; }
+    quint64 getTimerExecutionUsecs() const { return _timerExecutionUsecs; }
+
+    // Times every function call until stopped, to find where the script spends its time.  profile() returns the
+    // functions by self time, with their call counts, and the totals.  Not available while debugging the script.
+    Q_INVOKABLE void startProfiling();
+    Q_INVOKABLE QVariantMap profile() const;
+    Q_INVOKABLE QVariantMap stopProfiling();
 
     Q_INVOKABLE void print(const QString& message);
     Q_INVOKABLE QUrl resolvePath(const QString& path) const;
@@ -193,7 +205,15 @@ public:
     Q_INVOKABLE void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const PointerEvent& event);
     Q_INVOKABLE void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const EntityItemID& otherID, const Collision& collision);
 
-    Q_INVOKABLE void requestGarbageCollection() { collectGarbage(); }
+    Q_INVOKABLE void requestGarbageCollection() { collectGarbageNow(); }
+
+    // The engine's heap doesn't see the native memory its script's objects hold: its ArrayBuffers' data and the
+    // resources it tracks.  Those are counted here, and once more than the threshold has been made since the last
+    // collection the engine collects garbage, so a long running script's native memory is bounded.
+    //   An ArrayBuffer's bytes are counted until the collector frees the data value they are held by.
+    void addArrayBufferMemoryCost(QScriptValue& bufferData, qint64 bytes);
+    Q_INVOKABLE QVariantMap getMemoryStats() const; // can be called from other threads
+    Q_INVOKABLE void setGarbageCollectionThreshold(qint64 bytes) { _garbageCollectionThreshold = bytes; }
 
     Q_INVOKABLE QUuid generateUUID() { return QUuid::createUuid(); }
 
@@ -257,7 +277,8 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void timersFired();
+    void scheduleTimers();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -267,7 +288,7 @@ protected:
     void processDeferredEntityLoads(const QString& entityScript, const EntityItemID& leaderID);
 
     QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    void stopTimer(QObject* timer);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -285,14 +306,28 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+
+    // The script's timers all run off one QTimer, started for whichever is due first, which calls every timer due by
+    // then in one pass.  Each timer is just a handle object to the script.
+    using TimerClock = std::chrono::steady_clock;
+    struct ScriptTimer {
+        CallbackData callback;
+        std::chrono::milliseconds interval;
+        bool isSingleShot;
+        TimerClock::time_point due;
+    };
+    QTimer* _timersTimer;
+    QHash<QObject*, ScriptTimer> _timers;
+    std::multimap<TimerClock::time_point, QObject*> _timersByDue;
     QSet<QUrl> _includedURLs;
+    QHash<QString, QScriptProgram> _programCache; // by file name, so entities sharing a script compile it once
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     QHash<QString, EntityItemID> _occupiedScriptURLs;
     QList<DeferredLoadEntity> _deferredEntityLoads;
 
     bool _isThreaded { false };
     QScriptEngineDebugger* _debugger { nullptr };
+    ScriptProfiler* _profiler { nullptr };
     bool _debuggable { false };
     qint64 _lastUpdate;
 
@@ -314,6 +349,23 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    void collectGarbageNow();
+
+    // memory stats, for getMemoryStats from other threads
+    std::atomic<qint64> _resourceBytes { 0 }; // of the resources this engine tracks
+    // of the ArrayBuffers this engine allocated that are still alive, shared with their data values since the last of
+    // those are freed as the engine is destroyed
+    std::shared_ptr<std::atomic<qint64>> _arrayBufferBytes { std::make_shared<std::atomic<qint64>>(0) };
+    std::atomic<qint64> _bytesSinceGarbageCollection { 0 };
+    std::atomic<qint64> _garbageCollectionThreshold { 32 * 1024 * 1024 };
+    std::atomic<int> _numGarbageCollections { 0 };
+    std::atomic<quint64> _garbageCollectionUsecs { 0 };
+
+    // timer stats, for ScriptEngines::getTimerStats from other threads
+    std::atomic<int> _numTimers { 0 };
+    std::atomic<quint64> _numTimerCallbacks { 0 };
+    std::atomic<quint64> _timerExecutionUsecs { 0 };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
@@ -254,6 +254,31 @@ QVariantList ScriptEngines::getLocal() {
     return result;
 }
 
+QVariantList ScriptEngines::getTimerStats() {
+    QVariantList result;
+    QMutexLocker locker(&_allScriptsMutex);
+    for (auto engine : _allKnownScriptEngines) {
+        QVariantMap resultNode;
+        resultNode.insert("name", engine->getFilename());
+        resultNode.insert("timers", engine->getNumTimers());
+        resultNode.insert("callbacks", engine->getNumTimerCallbacks());
+        resultNode.insert("usecs", engine->getTimerExecutionUsecs());
+        result.append(resultNode);
+    }
+    return result;
+}
+
+QVariantList ScriptEngines::getMemoryStats() {
+    QVariantList result;
+    QMutexLocker locker(&_allScriptsMutex);
+    for (auto engine : _allKnownScriptEngines) {
+        QVariantMap resultNode = engine->getMemoryStats();
+        resultNode.insert("name", engine->getFilename());
+        result.append(resultNode);
+    }
+    return result;
+}
+
 QVariantList ScriptEngines::getRunning() {
     QVariantList result;
     auto runningScripts = getRunningScripts();
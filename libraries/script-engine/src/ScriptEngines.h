@@ -65,6 +65,10 @@ public:
     Q_INVOKABLE QVariantList getPublic();
     Q_INVOKABLE QVariantList getLocal();
 
+    // for each script: its number of timers, the timer callbacks it has run and the usecs they took
+    Q_INVOKABLE QVariantList getTimerStats();
+    Q_INVOKABLE QVariantList getMemoryStats();
+
     Q_PROPERTY(QString defaultScriptsPath READ getDefaultScriptsLocation)
 
     // Called at shutdown time
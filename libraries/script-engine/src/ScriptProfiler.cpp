@@ -0,0 +1,122 @@
+//
+//  ScriptProfiler.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+
+#include <QtScript/QScriptContext>
+#include <QtScript/QScriptContextInfo>
+#include <QtScript/QScriptEngine>
+
+#include <Profile.h>
+#include <SharedUtil.h>
+
+ScriptProfiler::ScriptProfiler(QScriptEngine* engine) :
+    QScriptEngineAgent(engine),
+    _profileStart(usecTimestampNow())
+{
+}
+
+size_t ScriptProfiler::getFunction() {
+    // look the function up by its object, and only work out its name the first time it's called
+    QScriptContext* context = engine()->currentContext();
+    qint64 objectID = context ? context->callee().objectId() : -1;
+    auto i = _functionsByObject.find(objectID);
+    if (i != _functionsByObject.end()) {
+        return i->second;
+    }
+
+    FunctionStats function;
+    if (context) {
+        QScriptContextInfo info(context);
+        function.name = info.functionName().isEmpty() ? QString("(anonymous)") : info.functionName();
+        function.fileName = info.fileName();
+        function.lineNumber = info.functionStartLineNumber();
+        if (info.functionType() != QScriptContextInfo::ScriptFunction) {
+            function.name += " [native]";
+        }
+    } else {
+        function.name = "(unknown)";
+    }
+    _functions.push_back(function);
+    _functionsByObject[objectID] = _functions.size() - 1;
+    return _functions.size() - 1;
+}
+
+void ScriptProfiler::functionEntry(qint64 scriptId) {
+    size_t function = getFunction();
+    _calls.push_back({ function, usecTimestampNow(), 0 });
+
+    if (trace_script().isDebugEnabled() && tracing::enabled()) {
+        auto& stats = _functions[function];
+        tracing::traceEvent(trace_script(), stats.name, tracing::DurationBegin, "",
+            { { "file", stats.fileName }, { "line", stats.lineNumber } });
+    }
+}
+
+void ScriptProfiler::functionExit(qint64 scriptId, const QScriptValue& returnValue) {
+    if (_calls.empty()) {
+        // we were attached partway into this call
+        return;
+    }
+    Call call = _calls.back();
+    _calls.pop_back();
+
+    quint64 elapsed = usecTimestampNow() - call.start;
+    auto& stats = _functions[call.function];
+    stats.calls++;
+    stats.totalUsecs += elapsed;
+    stats.selfUsecs += elapsed - std::min(elapsed, call.childUsecs);
+    if (_calls.empty()) {
+        _numCallbacks++;
+        _callbackUsecs += elapsed;
+    } else {
+        _calls.back().childUsecs += elapsed;
+    }
+
+    if (trace_script().isDebugEnabled() && tracing::enabled()) {
+        tracing::traceEvent(trace_script(), stats.name, tracing::DurationEnd);
+    }
+}
+
+QVariantMap ScriptProfiler::getProfile() const {
+    std::vector<size_t> hottest(_functions.size());
+    for (size_t i = 0; i < hottest.size(); i++) {
+        hottest[i] = i;
+    }
+    std::sort(hottest.begin(), hottest.end(), [this](size_t a, size_t b) {
+        return _functions[a].selfUsecs > _functions[b].selfUsecs;
+    });
+
+    QVariantList functions;
+    for (auto i : hottest) {
+        auto& stats = _functions[i];
+        if (stats.calls == 0) {
+            continue;
+        }
+        QVariantMap function;
+        function["name"] = stats.name;
+        function["fileName"] = stats.fileName;
+        function["lineNumber"] = stats.lineNumber;
+        function["calls"] = stats.calls;
+        function["totalUsecs"] = stats.totalUsecs;
+        function["selfUsecs"] = stats.selfUsecs;
+        functions.append(function);
+    }
+
+    QVariantMap profile;
+    profile["durationUsecs"] = usecTimestampNow() - _profileStart;
+    profile["callbacks"] = _numCallbacks;
+    profile["callbackUsecs"] = _callbackUsecs;
+    profile["memoryCost"] = _memoryCost;
+    profile["functions"] = functions;
+    return profile;
+}
@@ -0,0 +1,64 @@
+//
+//  ScriptProfiler.h
+//  libraries/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_ScriptProfiler_h
+#define hifi_ScriptProfiler_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QVariantList>
+#include <QtScript/QScriptEngineAgent>
+
+// Times every script function an engine calls, while attached as its agent, and keeps per-function call counts and
+// total and self usecs, plus how many callbacks into the script (calls from C++) there were and the memory cost the
+// engine was told about.  If tracing is enabled the calls are also recorded as trace_script durations, so they show
+// up in the Chrome trace next to the rest of the frame.
+class ScriptProfiler : public QScriptEngineAgent {
+public:
+    ScriptProfiler(QScriptEngine* engine);
+
+    void functionEntry(qint64 scriptId) override;
+    void functionExit(qint64 scriptId, const QScriptValue& returnValue) override;
+
+    void addMemoryCost(qint64 bytes) { _memoryCost += bytes; }
+
+    // the functions, hottest by self time first, and the totals
+    QVariantMap getProfile() const;
+
+private:
+    struct FunctionStats {
+        QString name;
+        QString fileName;
+        int lineNumber { -1 };
+        quint64 calls { 0 };
+        quint64 totalUsecs { 0 };
+        quint64 selfUsecs { 0 };
+    };
+
+    struct Call {
+        size_t function;
+        quint64 start;
+        quint64 childUsecs;
+    };
+
+    size_t getFunction();
+
+    quint64 _profileStart;
+    std::vector<FunctionStats> _functions;
+    std::unordered_map<qint64, size_t> _functionsByObject; // by the function object's id
+    std::vector<Call> _calls;
+    quint64 _numCallbacks { 0 };
+    quint64 _callbackUsecs { 0 };
+    qint64 _memoryCost { 0 };
+};
+
+#endif // hifi_ScriptProfiler_h
@@ -11,6 +11,8 @@
 
 #include <glm/glm.hpp>
 
+#include <QtCore/QtEndian>
+
 #include "ScriptEngine.h"
 #include "TypedArrayPrototype.h"
 
@@ -206,13 +208,9 @@ QScriptValue propertyHelper(const QByteArray* arrayBuffer, const QScriptString&
     bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        
-        stream.setByteOrder(QDataStream::LittleEndian);
-        T result;
-        stream >> result;
+    if (ok && arrayBuffer && id + sizeof(T) <= (uint)arrayBuffer->size()) {
+        // read in place, rather than through a QDataStream's QBuffer, and without detaching a buffer shared with C++
+        T result = qFromLittleEndian<T>(reinterpret_cast<const uchar*>(arrayBuffer->constData() + id));
         return result;
     }
     return QScriptValue();
@@ -33,6 +33,7 @@ WebSocketClass::WebSocketClass(QScriptEngine* engine, QWebSocket* qWebSocket) :
 void WebSocketClass::initialize() {
     connect(_webSocket, &QWebSocket::disconnected, this, &WebSocketClass::handleOnClose);
     connect(_webSocket, &QWebSocket::textMessageReceived, this, &WebSocketClass::handleOnMessage);
+    connect(_webSocket, &QWebSocket::binaryMessageReceived, this, &WebSocketClass::handleOnBinaryMessage);
     connect(_webSocket, &QWebSocket::connected, this, &WebSocketClass::handleOnOpen);
     connect(_webSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this,
         &WebSocketClass::handleOnError);
@@ -52,7 +53,12 @@ WebSocketClass::~WebSocketClass() {
 }
 
 void WebSocketClass::send(QScriptValue message) {
-    _webSocket->sendTextMessage(message.toString());
+    QByteArray binaryMessage;
+    if (ArrayBufferClass::toByteArray(message, binaryMessage)) {
+        _webSocket->sendBinaryMessage(binaryMessage);
+    } else {
+        _webSocket->sendTextMessage(message.toString());
+    }
 }
 
 void WebSocketClass::close() {
@@ -96,6 +102,17 @@ void WebSocketClass::handleOnMessage(const QString& message) {
     }
 }
 
+void WebSocketClass::handleOnBinaryMessage(const QByteArray& message) {
+    if (_onMessageEvent.isFunction()) {
+        // an ArrayBuffer sharing the message's data, whatever the binaryType
+        QScriptValueList args;
+        QScriptValue arg = _engine->newObject();
+        arg.setProperty("data", _engine->toScriptValue(message));
+        args << arg;
+        _onMessageEvent.call(QScriptValue(), args);
+    }
+}
+
 void WebSocketClass::handleOnOpen() {
     if (_onOpenEvent.isFunction()) {
         _onOpenEvent.call();
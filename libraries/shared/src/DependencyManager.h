@@ -17,6 +17,7 @@
 #include <QSharedPointer>
 #include <QWeakPointer>
 
+#include <atomic>
 #include <functional>
 #include <typeinfo>
 
@@ -41,6 +42,7 @@ protected:
 
 // usage:
 //     auto instance = DependencyManager::get<T>();
+//     T* instance = DependencyManager::getRaw<T>();
 //     auto instance = DependencyManager::set<T>(Args... args);
 //     DependencyManager::destroy<T>();
 //     DependencyManager::registerInheritance<Base, Derived>();
@@ -48,6 +50,12 @@ class DependencyManager {
 public:
     template<typename T>
     static QSharedPointer<T> get();
+
+    // For the hot paths, per packet or per draw: no hash lookup and no reference counting once the instance is
+    // cached, only a compare against the generation of the registrations.  The pointer is not owned, it must not be
+    // kept past the current call nor used across a set<T>() or destroy<T>() of its type.
+    template<typename T>
+    static T* getRaw();
     
     template<typename T>
     static bool isSet();
@@ -74,6 +82,9 @@ private:
     
     QHash<size_t, QSharedPointer<Dependency>> _instanceHash;
     QHash<size_t, size_t> _inheritanceHash;
+
+    // bumped by every set and destroy, so the pointers cached by getRaw() know to look their instance up again
+    std::atomic<uint32_t> _generation { 1 };
 };
 
 template <typename T>
@@ -92,6 +103,25 @@ QSharedPointer<T> DependencyManager::get() {
     return instance.toStrongRef();
 }
 
+template <typename T>
+T* DependencyManager::getRaw() {
+    static size_t hashCode = manager().getHashCode<T>();
+    static std::atomic<T*> instance { nullptr };
+    static std::atomic<uint32_t> instanceGeneration { 0 };
+
+    uint32_t generation = manager()._generation.load(std::memory_order_acquire);
+    if (instanceGeneration.load(std::memory_order_acquire) != generation) {
+        T* pointer = qSharedPointerCast<T>(manager().safeGet(hashCode)).data();
+        if (!pointer) {
+            qWarning() << "DependencyManager::getRaw(): No instance available for" << typeid(T).name();
+        }
+        instance.store(pointer, std::memory_order_relaxed);
+        instanceGeneration.store(generation, std::memory_order_release);
+        return pointer;
+    }
+    return instance.load(std::memory_order_relaxed);
+}
+
 template <typename T>
 bool DependencyManager::isSet() {
     static size_t hashCode = manager().getHashCode<T>();
@@ -109,6 +139,7 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
     QSharedPointer<T> newInstance(new T(args...), &T::customDeleter);
     QSharedPointer<Dependency> storedInstance = qSharedPointerCast<Dependency>(newInstance);
     instance.swap(storedInstance);
+    manager()._generation++;
 
     return newInstance;
 }
@@ -122,6 +153,7 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
     QSharedPointer<T> newInstance(new I(args...), &I::customDeleter);
     QSharedPointer<Dependency> storedInstance = qSharedPointerCast<Dependency>(newInstance);
     instance.swap(storedInstance);
+    manager()._generation++;
 
     return newInstance;
 }
@@ -130,6 +162,7 @@ template <typename T>
 void DependencyManager::destroy() {
     static size_t hashCode = manager().getHashCode<T>();
     manager().safeGet(hashCode).clear();
+    manager()._generation++;
 }
 
 template<typename Base, typename Derived>
@@ -0,0 +1,57 @@
+//
+//  FrameStatsRecorder.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameStatsRecorder.h"
+
+#include <QtCore/QJsonArray>
+
+void FrameStatsRecorder::record(const FrameStats& frame) {
+    _history.insert(frame);
+    _frameUsecs.record(frame.frameUsecs);
+    _packetsIn.record(frame.packetsIn);
+    _packetsOut.record(frame.packetsOut);
+    _queuedPackets.record(frame.queuedPackets);
+}
+
+QJsonObject FrameStatsRecorder::getIntervalStats() const {
+    QJsonObject stats;
+    stats["frame_usecs"] = _frameUsecs.toJson();
+    stats["packets_in_per_frame"] = _packetsIn.toJson();
+    stats["packets_out_per_frame"] = _packetsOut.toJson();
+    stats["queued_packets"] = _queuedPackets.toJson();
+    return stats;
+}
+
+void FrameStatsRecorder::resetInterval() {
+    _frameUsecs.reset();
+    _packetsIn.reset();
+    _packetsOut.reset();
+    _queuedPackets.reset();
+}
+
+QJsonObject FrameStatsRecorder::getHistory() const {
+    QJsonArray frames;
+    for (int age = _history.getNumEntries() - 1; age >= 0; --age) {
+        const FrameStats* frame = _history.get(age);
+        frames.append(QJsonArray {
+            (double)frame->timestamp,
+            (double)frame->frameUsecs,
+            (double)frame->packetsIn,
+            (double)frame->packetsOut,
+            (double)frame->queuedPackets
+        });
+    }
+
+    QJsonObject history;
+    history["columns"] = QJsonArray { "timestamp", "frame_usecs", "packets_in", "packets_out", "queued_packets" };
+    history["frames"] = frames;
+    history["interval"] = getIntervalStats();
+    return history;
+}
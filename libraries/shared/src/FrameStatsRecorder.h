@@ -0,0 +1,54 @@
+//
+//  FrameStatsRecorder.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameStatsRecorder_h
+#define hifi_FrameStatsRecorder_h
+
+#include <cstdint>
+
+#include <QtCore/QJsonObject>
+
+#include "HdrHistogram.h"
+#include "RingBufferHistory.h"
+
+struct FrameStats {
+    quint64 timestamp { 0 }; // usecs
+    uint32_t frameUsecs { 0 };
+    uint32_t packetsIn { 0 };
+    uint32_t packetsOut { 0 };
+    uint32_t queuedPackets { 0 };
+};
+
+// Keeps the stats of every frame of a loop, at a fixed memory cost: the latest frames one by one, and histograms
+// of the frames since the interval was last reset, to report the stutters that averages smooth over.
+class FrameStatsRecorder {
+public:
+    static const int DEFAULT_HISTORY_FRAMES = 1000;
+
+    FrameStatsRecorder(int historyFrames = DEFAULT_HISTORY_FRAMES) : _history(historyFrames) {}
+
+    void record(const FrameStats& frame);
+
+    uint64_t getIntervalFrameCount() const { return _frameUsecs.getCount(); }
+    QJsonObject getIntervalStats() const;
+    void resetInterval();
+
+    // the latest frames, oldest first, with the stats of the interval
+    QJsonObject getHistory() const;
+
+private:
+    RingBufferHistory<FrameStats> _history;
+    HdrHistogram _frameUsecs;
+    HdrHistogram _packetsIn;
+    HdrHistogram _packetsOut;
+    HdrHistogram _queuedPackets;
+};
+
+#endif // hifi_FrameStatsRecorder_h
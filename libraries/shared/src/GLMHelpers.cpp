@@ -10,6 +10,9 @@
 //
 
 #include "GLMHelpers.h"
+
+#include <algorithm>
+
 #include <glm/gtc/matrix_transform.hpp>
 #include "NumericalConstants.h"
 
@@ -217,6 +220,61 @@ int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& qu
     return 6;
 }
 
+uint64_t quantizeOrientationQuat(const glm::quat& quatInput, int bitsPerComponent) {
+    // find largest component
+    uint8_t largestComponent = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabs(quatInput[i]) > fabs(quatInput[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+
+    // ensure that the sign of the dropped component is always negative.
+    glm::quat q = quatInput[largestComponent] > 0 ? -quatInput : quatInput;
+
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const uint32_t RANGE = (1 << bitsPerComponent) - 1;
+
+    // quantize the smallest three components, rounding to the nearest step since there are few of them
+    uint64_t value = largestComponent;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            float component = glm::clamp((q[i] + MAGNITUDE) / (2.0f * MAGNITUDE), 0.0f, 1.0f);
+            value = (value << bitsPerComponent) | (uint32_t)(component * RANGE + 0.5f);
+        }
+    }
+    return value;
+}
+
+glm::quat dequantizeOrientationQuat(uint64_t value, int bitsPerComponent) {
+    const uint32_t MASK = (1 << bitsPerComponent) - 1;
+    const float RANGE = (float)MASK;
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+
+    float floatComponents[3];
+    for (int i = 2; i >= 0; i--) {
+        floatComponents[i] = ((float)(value & MASK) / RANGE) * (2.0f * MAGNITUDE) - MAGNITUDE;
+        value >>= bitsPerComponent;
+    }
+    uint8_t largestComponent = (uint8_t)(value & 0x03);
+
+    // missingComponent is always negative (rounding may push the others slightly past unit length)
+    float sumOfSquares = floatComponents[0] * floatComponents[0] + floatComponents[1] * floatComponents[1] +
+        floatComponents[2] * floatComponents[2];
+    float missingComponent = -sqrtf(std::max(1.0f - sumOfSquares, 0.0f));
+
+    glm::quat quatOutput;
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            quatOutput[i] = floatComponents[j];
+            j++;
+        } else {
+            quatOutput[i] = missingComponent;
+        }
+    }
+    return glm::normalize(quatOutput);
+}
+
 
 //  Safe version of glm::eulerAngles; uses the factorization method described in David Eberly's
 //  http://www.geometrictools.com/Documentation/EulerAngles.pdf (via Clyde,
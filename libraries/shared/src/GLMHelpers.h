@@ -107,6 +107,12 @@ int unpackOrientationQuatFromBytes(const unsigned char* buffer, glm::quat& quatO
 int packOrientationQuatToSixBytes(unsigned char* buffer, const glm::quat& quatInput);
 int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& quatOutput);
 
+// the same smallest three encoding with a variable number of bits per component (at most 15), as a
+// 2 + 3 * bitsPerComponent bit value for bit packed streams. Each fewer bit doubles the maximum error.
+uint64_t quantizeOrientationQuat(const glm::quat& quatInput, int bitsPerComponent);
+glm::quat dequantizeOrientationQuat(uint64_t value, int bitsPerComponent);
+inline int numBitsForQuantizedOrientationQuat(int bitsPerComponent) { return 2 + 3 * bitsPerComponent; }
+
 // Ratios need the be highly accurate when less than 10, but not very accurate above 10, and they
 // are never greater than 1000 to 1, this allows us to encode each component in 16bits
 int packFloatRatioToTwoByte(unsigned char* buffer, float ratio);
@@ -151,3 +151,101 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+const int UNCOMPRESSED_SIZE_BYTES = 4;
+const int MAX_UNCOMPRESSED_SIZE = 0x7fffffff;
+
+quint32 compressionDictionaryID(const QByteArray& dictionary) {
+    // the ID zlib records in a stream is the dictionary's adler32
+    uLong adler = adler32(0L, Z_NULL, 0);
+    return (quint32)adler32(adler, (const Bytef*)dictionary.constData(), dictionary.size());
+}
+
+bool compressWithDictionary(const char* source, int sourceLength, const QByteArray& dictionary,
+                            QByteArray& destination, int compressionLevel) {
+    destination.clear();
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    if (deflateInit(&strm, qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel))) != Z_OK) {
+        return false;
+    }
+    if (!dictionary.isEmpty() &&
+        deflateSetDictionary(&strm, (const Bytef*)dictionary.constData(), dictionary.size()) != Z_OK) {
+        deflateEnd(&strm);
+        return false;
+    }
+
+    int bound = (int)deflateBound(&strm, sourceLength);
+    destination.resize(UNCOMPRESSED_SIZE_BYTES + bound);
+    unsigned char* header = (unsigned char*)destination.data();
+    header[0] = (sourceLength >> 24) & 0xff;
+    header[1] = (sourceLength >> 16) & 0xff;
+    header[2] = (sourceLength >> 8) & 0xff;
+    header[3] = sourceLength & 0xff;
+
+    strm.next_in = (Bytef*)source;
+    strm.avail_in = sourceLength;
+    strm.next_out = (Bytef*)destination.data() + UNCOMPRESSED_SIZE_BYTES;
+    strm.avail_out = bound;
+
+    int status = deflate(&strm, Z_FINISH);
+    deflateEnd(&strm);
+    if (status != Z_STREAM_END) {
+        destination.clear();
+        return false;
+    }
+    destination.resize(UNCOMPRESSED_SIZE_BYTES + bound - strm.avail_out);
+    return true;
+}
+
+bool uncompressWithDictionary(const char* source, int sourceLength, const CompressionDictionaryLookup& lookup,
+                              QByteArray& destination, int maxSize) {
+    destination.clear();
+    if (sourceLength <= UNCOMPRESSED_SIZE_BYTES) {
+        return false;
+    }
+
+    const unsigned char* header = (const unsigned char*)source;
+    quint32 expectedSize = (header[0] << 24) | (header[1] << 16) | (header[2] << 8) | header[3];
+    if (expectedSize > (quint32)qMin(maxSize, MAX_UNCOMPRESSED_SIZE)) {
+        return false;
+    }
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = (Bytef*)source + UNCOMPRESSED_SIZE_BYTES;
+    strm.avail_in = sourceLength - UNCOMPRESSED_SIZE_BYTES;
+
+    if (inflateInit(&strm) != Z_OK) {
+        return false;
+    }
+
+    destination.resize(expectedSize);
+    strm.next_out = (Bytef*)destination.data();
+    strm.avail_out = expectedSize;
+
+    int status = inflate(&strm, Z_FINISH);
+    if (status == Z_NEED_DICT) {
+        QByteArray dictionary = lookup ? lookup((quint32)strm.adler) : QByteArray();
+        if (dictionary.isEmpty() ||
+            inflateSetDictionary(&strm, (const Bytef*)dictionary.constData(), dictionary.size()) != Z_OK) {
+            inflateEnd(&strm);
+            destination.clear();
+            return false;
+        }
+        status = inflate(&strm, Z_FINISH);
+    }
+    inflateEnd(&strm);
+
+    if (status != Z_STREAM_END || strm.avail_out != 0) {
+        destination.clear();
+        return false;
+    }
+    return true;
+}
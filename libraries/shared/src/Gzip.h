@@ -12,6 +12,8 @@
 #ifndef GZIP_H
 #define GZIP_H
 
+#include <functional>
+
 #include <QByteArray>
 
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
@@ -24,4 +26,18 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// zlib streams in the qCompress() format (the uncompressed size, big-endian, then the stream) that can be compressed with
+// a preset dictionary of content the data is likely to share. The stream only records the dictionary's ID, so
+// uncompressing it needs a lookup that finds the dictionary by that ID.
+using CompressionDictionaryLookup = std::function<QByteArray(quint32 dictionaryID)>;
+
+quint32 compressionDictionaryID(const QByteArray& dictionary);
+
+bool compressWithDictionary(const char* source, int sourceLength, const QByteArray& dictionary,
+                            QByteArray& destination, int compressionLevel = -1);
+
+// fails, before allocating anything, on streams whose header claims more than maxSize bytes
+bool uncompressWithDictionary(const char* source, int sourceLength, const CompressionDictionaryLookup& lookup,
+                              QByteArray& destination, int maxSize = 0x7fffffff);
+
 #endif
@@ -0,0 +1,82 @@
+//
+//  HdrHistogram.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HdrHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+int HdrHistogram::indexOf(uint64_t value) {
+    if (value < 2 * SUB_BUCKET_COUNT) {
+        return (int)value;
+    }
+    int highestBit = 63;
+    while (!(value >> highestBit)) {
+        --highestBit;
+    }
+    // the bits below the top SUB_BUCKET_BITS + 1 are dropped, what is left is in [SUB_BUCKET_COUNT, 2 * SUB_BUCKET_COUNT)
+    int shift = highestBit - SUB_BUCKET_BITS;
+    return shift * SUB_BUCKET_COUNT + (int)(value >> shift);
+}
+
+uint64_t HdrHistogram::highestValueOf(int index) {
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return (uint64_t)index;
+    }
+    int shift = index / SUB_BUCKET_COUNT - 1;
+    uint64_t subBucket = (uint64_t)(index - shift * SUB_BUCKET_COUNT);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void HdrHistogram::record(uint64_t value) {
+    ++_buckets[indexOf(value)];
+    ++_count;
+    _sum += value;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+void HdrHistogram::reset() {
+    _buckets.fill(0);
+    _count = 0;
+    _sum = 0;
+    _min = UINT64_MAX;
+    _max = 0;
+}
+
+uint64_t HdrHistogram::getValueAtPercentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+    uint64_t countAtPercentile = (uint64_t)std::ceil(std::min(std::max(percentile, 0.0), 100.0) / 100.0 * _count);
+    countAtPercentile = std::max(countAtPercentile, (uint64_t)1);
+
+    uint64_t count = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        count += _buckets[i];
+        if (count >= countAtPercentile) {
+            return std::min(highestValueOf(i), _max);
+        }
+    }
+    return _max;
+}
+
+QJsonObject HdrHistogram::toJson() const {
+    QJsonObject json;
+    json["count"] = (double)_count;
+    json["min"] = (double)getMin();
+    json["mean"] = getMean();
+    json["max"] = (double)_max;
+    json["p50"] = (double)getValueAtPercentile(50.0);
+    json["p90"] = (double)getValueAtPercentile(90.0);
+    json["p99"] = (double)getValueAtPercentile(99.0);
+    json["p99.9"] = (double)getValueAtPercentile(99.9);
+    return json;
+}
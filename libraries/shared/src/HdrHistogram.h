@@ -0,0 +1,53 @@
+//
+//  HdrHistogram.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HdrHistogram_h
+#define hifi_HdrHistogram_h
+
+#include <array>
+#include <cstdint>
+
+#include <QtCore/QJsonObject>
+
+// A histogram of high dynamic range at a fixed memory cost: every power of two is split into the same number of
+// buckets, so that any value up to 2^64 is counted to within 1/64 of itself, and its percentiles are as good.
+class HdrHistogram {
+public:
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t getCount() const { return _count; }
+    uint64_t getMin() const { return _count > 0 ? _min : 0; }
+    uint64_t getMax() const { return _max; }
+    double getMean() const { return _count > 0 ? (double)_sum / (double)_count : 0.0; }
+
+    // the highest value that counts the same as the one at the percentile, from 0 to 100
+    uint64_t getValueAtPercentile(double percentile) const;
+
+    // the count, min, mean, max and the 50th, 90th, 99th and 99.9th percentiles
+    QJsonObject toJson() const;
+
+private:
+    static const int SUB_BUCKET_BITS = 6;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    // the values below 2 * SUB_BUCKET_COUNT are exact, every power of two above that has SUB_BUCKET_COUNT buckets
+    static const int BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    static int indexOf(uint64_t value);
+    static uint64_t highestValueOf(int index);
+
+    std::array<uint32_t, BUCKET_COUNT> _buckets {};
+    uint64_t _count { 0 };
+    uint64_t _sum { 0 };
+    uint64_t _min { UINT64_MAX };
+    uint64_t _max { 0 };
+};
+
+#endif // hifi_HdrHistogram_h
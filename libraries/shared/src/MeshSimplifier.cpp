@@ -0,0 +1,214 @@
+//
+//  MeshSimplifier.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+static const float MIN_COLLAPSED_NORMAL_DOT = 0.2f;
+
+void MeshSimplifier::Quadric::addPlane(const glm::vec3& normal, float distance) {
+    double x = normal.x;
+    double y = normal.y;
+    double z = normal.z;
+    double d = distance;
+    a[0] += x * x; a[1] += x * y; a[2] += x * z; a[3] += x * d;
+    a[4] += y * y; a[5] += y * z; a[6] += y * d;
+    a[7] += z * z; a[8] += z * d;
+    a[9] += d * d;
+}
+
+MeshSimplifier::Quadric& MeshSimplifier::Quadric::operator+=(const Quadric& other) {
+    for (int i = 0; i < 10; i++) {
+        a[i] += other.a[i];
+    }
+    return *this;
+}
+
+double MeshSimplifier::Quadric::evaluate(const glm::vec3& point) const {
+    double x = point.x;
+    double y = point.y;
+    double z = point.z;
+    return a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x +
+        a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y +
+        a[7] * z * z + 2.0 * a[8] * z +
+        a[9];
+}
+
+MeshSimplifier::MeshSimplifier(const glm::vec3* positions, uint32_t numPositions, const std::vector<uint32_t>& indices) :
+    _positions(positions),
+    _triangles(indices.begin(), indices.begin() + (indices.size() / 3) * 3),
+    _quadrics(numPositions),
+    _vertexTriangles(numPositions),
+    _versions(numPositions, 0),
+    _locked(numPositions, false) {
+
+    uint32_t numTriangles = (uint32_t)(_triangles.size() / 3);
+    _removedTriangles.resize(numTriangles, false);
+
+    // The edges used by other than two triangles are on a border, or a seam where the vertices are split,
+    // or where the surface isn't a manifold: their vertices stay put
+    std::unordered_map<uint64_t, uint32_t> edgeUses;
+    auto edgeKey = [](uint32_t a, uint32_t b) {
+        return (a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a);
+    };
+
+    for (uint32_t t = 0; t < numTriangles; t++) {
+        const uint32_t* triangle = &_triangles[t * 3];
+        if (triangle[0] >= numPositions || triangle[1] >= numPositions || triangle[2] >= numPositions ||
+            triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+            _removedTriangles[t] = true;
+            continue;
+        }
+        _numTriangles++;
+
+        const auto& p0 = _positions[triangle[0]];
+        auto normal = glm::cross(_positions[triangle[1]] - p0, _positions[triangle[2]] - p0);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normal /= length;
+            Quadric quadric;
+            quadric.addPlane(normal, -glm::dot(normal, p0));
+            for (int i = 0; i < 3; i++) {
+                _quadrics[triangle[i]] += quadric;
+            }
+        }
+
+        for (int i = 0; i < 3; i++) {
+            _vertexTriangles[triangle[i]].push_back(t);
+            edgeUses[edgeKey(triangle[i], triangle[(i + 1) % 3])]++;
+        }
+    }
+
+    for (const auto& edge : edgeUses) {
+        if (edge.second != 2) {
+            _locked[(uint32_t)(edge.first >> 32)] = true;
+            _locked[(uint32_t)(edge.first & 0xFFFFFFFF)] = true;
+        }
+    }
+
+    for (const auto& edge : edgeUses) {
+        auto a = (uint32_t)(edge.first >> 32);
+        auto b = (uint32_t)(edge.first & 0xFFFFFFFF);
+        pushCollapse(a, b);
+        pushCollapse(b, a);
+    }
+}
+
+void MeshSimplifier::pushCollapse(uint32_t from, uint32_t to) {
+    if (_locked[from]) {
+        return;
+    }
+    Quadric quadric = _quadrics[from];
+    quadric += _quadrics[to];
+    _collapses.push({ quadric.evaluate(_positions[to]), from, to, _versions[from], _versions[to] });
+}
+
+bool MeshSimplifier::canCollapse(uint32_t from, uint32_t to) const {
+    bool isEdge = false;
+    for (auto t : _vertexTriangles[from]) {
+        if (_removedTriangles[t]) {
+            continue;
+        }
+        const uint32_t* triangle = &_triangles[t * 3];
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+            // collapsed with the edge
+            isEdge = true;
+            continue;
+        }
+
+        // The triangles moved with the vertex must not flip nor become degenerate
+        glm::vec3 points[3];
+        glm::vec3 movedPoints[3];
+        for (int i = 0; i < 3; i++) {
+            points[i] = _positions[triangle[i]];
+            movedPoints[i] = (triangle[i] == from ? _positions[to] : points[i]);
+        }
+        auto normal = glm::cross(points[1] - points[0], points[2] - points[0]);
+        auto movedNormal = glm::cross(movedPoints[1] - movedPoints[0], movedPoints[2] - movedPoints[0]);
+        float lengths = glm::length(normal) * glm::length(movedNormal);
+        if (lengths <= 0.0f || glm::dot(normal, movedNormal) < MIN_COLLAPSED_NORMAL_DOT * lengths) {
+            return false;
+        }
+    }
+    return isEdge;
+}
+
+void MeshSimplifier::collapse(uint32_t from, uint32_t to) {
+    auto& toTriangles = _vertexTriangles[to];
+    for (auto t : _vertexTriangles[from]) {
+        if (_removedTriangles[t]) {
+            continue;
+        }
+        uint32_t* triangle = &_triangles[t * 3];
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+            _removedTriangles[t] = true;
+            _numTriangles--;
+            continue;
+        }
+        for (int i = 0; i < 3; i++) {
+            if (triangle[i] == from) {
+                triangle[i] = to;
+            }
+        }
+        toTriangles.push_back(t);
+    }
+    _vertexTriangles[from].clear();
+    _locked[from] = true;
+    _versions[from]++;
+
+    _quadrics[to] += _quadrics[from];
+    _versions[to]++;
+
+    // The collapses onto and from the vertex collapsed onto have changed
+    toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [&](uint32_t t) {
+        return _removedTriangles[t];
+    }), toTriangles.end());
+    for (auto t : toTriangles) {
+        const uint32_t* triangle = &_triangles[t * 3];
+        for (int i = 0; i < 3; i++) {
+            if (triangle[i] != to) {
+                pushCollapse(to, triangle[i]);
+                pushCollapse(triangle[i], to);
+            }
+        }
+    }
+}
+
+size_t MeshSimplifier::simplify(size_t targetNumTriangles, float maxError) {
+    double maxCost = (double)maxError * (double)maxError;
+    while (_numTriangles > targetNumTriangles && !_collapses.empty()) {
+        auto next = _collapses.top();
+        if (next.cost > maxCost) {
+            break;
+        }
+        _collapses.pop();
+
+        if (next.fromVersion != _versions[next.from] || next.toVersion != _versions[next.to] || _locked[next.from]) {
+            continue;
+        }
+        if (canCollapse(next.from, next.to)) {
+            collapse(next.from, next.to);
+        }
+    }
+    return _numTriangles;
+}
+
+std::vector<uint32_t> MeshSimplifier::getIndices() const {
+    std::vector<uint32_t> indices;
+    indices.reserve(_numTriangles * 3);
+    for (size_t t = 0; t < _removedTriangles.size(); t++) {
+        if (!_removedTriangles[t]) {
+            indices.insert(indices.end(), _triangles.begin() + t * 3, _triangles.begin() + t * 3 + 3);
+        }
+    }
+    return indices;
+}
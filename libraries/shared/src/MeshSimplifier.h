@@ -0,0 +1,77 @@
+//
+//  MeshSimplifier.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshSimplifier_h
+#define hifi_MeshSimplifier_h
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Simplifies a list of triangles by collapsing its edges, the one adding the least quadric error first,
+// each onto one of its ends. No vertex is moved or added, so the simplified triangles index the same vertices,
+// and the vertices on the borders and the seams of the surface are kept where they are.
+class MeshSimplifier {
+public:
+    MeshSimplifier(const glm::vec3* positions, uint32_t numPositions, const std::vector<uint32_t>& indices);
+
+    // Collapse edges until no more than targetNumTriangles are left, or the next collapse would move the surface
+    // further than about maxError. Can be called again with a lower target to simplify further.
+    // Returns the number of triangles left.
+    size_t simplify(size_t targetNumTriangles, float maxError);
+
+    size_t getNumTriangles() const { return _numTriangles; }
+
+    // The indices of the triangles left
+    std::vector<uint32_t> getIndices() const;
+
+private:
+    // The symmetric matrix of the sum of the squared distances to planes
+    class Quadric {
+    public:
+        double a[10] { 0.0 };
+
+        void addPlane(const glm::vec3& normal, float distance);
+        Quadric& operator+=(const Quadric& other);
+        double evaluate(const glm::vec3& point) const;
+    };
+
+    class Collapse {
+    public:
+        double cost;
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    void pushCollapse(uint32_t from, uint32_t to);
+    bool canCollapse(uint32_t from, uint32_t to) const;
+    void collapse(uint32_t from, uint32_t to);
+
+    const glm::vec3* _positions;
+    std::vector<uint32_t> _triangles;
+    std::vector<bool> _removedTriangles;
+    size_t _numTriangles { 0 };
+
+    std::vector<Quadric> _quadrics;
+    std::vector<std::vector<uint32_t>> _vertexTriangles;
+    std::vector<uint32_t> _versions;
+    std::vector<bool> _locked;
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> _collapses;
+};
+
+#endif // hifi_MeshSimplifier_h
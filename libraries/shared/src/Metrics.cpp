@@ -0,0 +1,248 @@
+//
+//  Metrics.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Metrics.h"
+
+#include <algorithm>
+
+#include <QtCore/QDataStream>
+
+using namespace metrics;
+
+static const quint8 SERIALIZED_METRICS_VERSION = 1;
+
+enum class MetricType : quint8 {
+    Counter,
+    Gauge,
+    Histogram
+};
+
+Histogram::Histogram(const std::vector<double>& upperBounds) :
+    _upperBounds(upperBounds),
+    _bucketCounts(new std::atomic<uint64_t>[upperBounds.size() + 1])
+{
+    std::sort(_upperBounds.begin(), _upperBounds.end());
+    for (size_t i = 0; i <= _upperBounds.size(); ++i) {
+        _bucketCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value) {
+    // the bounds are inclusive, and the values above the last one go in the bucket after it
+    size_t bucket = std::lower_bound(_upperBounds.begin(), _upperBounds.end(), value) - _upperBounds.begin();
+    _bucketCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    double sum = _sum.load(std::memory_order_relaxed);
+    while (!_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+    }
+}
+
+std::vector<uint64_t> Histogram::getBucketCounts() const {
+    std::vector<uint64_t> counts(_upperBounds.size() + 1);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = _bucketCounts[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+void Histogram::reset() {
+    for (size_t i = 0; i <= _upperBounds.size(); ++i) {
+        _bucketCounts[i].store(0, std::memory_order_relaxed);
+    }
+    _sum.store(0.0, std::memory_order_relaxed);
+}
+
+Registry& Registry::getInstance() {
+    // never destroyed, for the metrics updated by the threads that outlive the statics
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+template <typename Metric, typename... Args>
+Metric& Registry::findOrMake(Metrics<Metric>& metrics, Metrics<Metric>& clearedMetrics, const QByteArray& name,
+                             Args&&... args) {
+    auto& metric = metrics[name];
+    if (!metric) {
+        // a cleared metric is never freed, as a thread of the assignment that finished may still update it
+        auto cleared = clearedMetrics.find(name);
+        if (cleared != clearedMetrics.end()) {
+            metric = std::move(cleared->second);
+            clearedMetrics.erase(cleared);
+            metric->reset();
+        } else {
+            metric.reset(new Metric(std::forward<Args>(args)...));
+        }
+    }
+    return *metric;
+}
+
+Counter& Registry::counter(const QByteArray& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return findOrMake(_counters, _clearedCounters, name);
+}
+
+Gauge& Registry::gauge(const QByteArray& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return findOrMake(_gauges, _clearedGauges, name);
+}
+
+Histogram& Registry::histogram(const QByteArray& name, const std::vector<double>& upperBounds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return findOrMake(_histograms, _clearedHistograms, name, upperBounds);
+}
+
+void Registry::addCollectedCounter(const QByteArray& name, std::function<uint64_t()> collect) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _collectedCounters[name] = collect;
+}
+
+void Registry::addCollectedGauge(const QByteArray& name, std::function<int64_t()> collect) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _collectedGauges[name] = collect;
+}
+
+void Registry::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& counter : _counters) {
+        _clearedCounters[counter.first] = std::move(counter.second);
+    }
+    _counters.clear();
+    for (auto& gauge : _gauges) {
+        _clearedGauges[gauge.first] = std::move(gauge.second);
+    }
+    _gauges.clear();
+    for (auto& histogram : _histograms) {
+        _clearedHistograms[histogram.first] = std::move(histogram.second);
+    }
+    _histograms.clear();
+    _collectedCounters.clear();
+    _collectedGauges.clear();
+}
+
+QByteArray Registry::serialize() const {
+    QByteArray serialized;
+    QDataStream stream(&serialized, QIODevice::WriteOnly);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    stream << SERIALIZED_METRICS_VERSION;
+    stream << (quint32)(_counters.size() + _gauges.size() + _histograms.size() +
+        _collectedCounters.size() + _collectedGauges.size());
+
+    for (const auto& counter : _counters) {
+        stream << (quint8)MetricType::Counter << counter.first << (quint64)counter.second->get();
+    }
+    for (const auto& counter : _collectedCounters) {
+        stream << (quint8)MetricType::Counter << counter.first << (quint64)counter.second();
+    }
+    for (const auto& gauge : _gauges) {
+        stream << (quint8)MetricType::Gauge << gauge.first << (qint64)gauge.second->get();
+    }
+    for (const auto& gauge : _collectedGauges) {
+        stream << (quint8)MetricType::Gauge << gauge.first << (qint64)gauge.second();
+    }
+    for (const auto& histogram : _histograms) {
+        stream << (quint8)MetricType::Histogram << histogram.first;
+
+        const auto& upperBounds = histogram.second->getUpperBounds();
+        stream << (quint32)upperBounds.size();
+        for (double upperBound : upperBounds) {
+            stream << upperBound;
+        }
+        for (uint64_t count : histogram.second->getBucketCounts()) {
+            stream << (quint64)count;
+        }
+        stream << histogram.second->getSum();
+    }
+    return serialized;
+}
+
+TextWriter::Family& TextWriter::family(const QByteArray& name, const char* type) {
+    Family& family = _families[name];
+    if (family.type.isEmpty()) {
+        family.type = type;
+    }
+    return family;
+}
+
+bool TextWriter::add(const QByteArray& serializedMetrics, const QByteArray& labels) {
+    QDataStream stream(serializedMetrics);
+
+    quint8 version;
+    quint32 numMetrics;
+    stream >> version >> numMetrics;
+    if (stream.status() != QDataStream::Ok || version != SERIALIZED_METRICS_VERSION) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < numMetrics; ++i) {
+        quint8 type;
+        QByteArray name;
+        stream >> type >> name;
+        if (stream.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        switch ((MetricType)type) {
+            case MetricType::Counter: {
+                quint64 value;
+                stream >> value;
+                family(name, "counter").samples += name + '{' + labels + "} " + QByteArray::number(value) + '\n';
+                break;
+            }
+            case MetricType::Gauge: {
+                qint64 value;
+                stream >> value;
+                family(name, "gauge").samples += name + '{' + labels + "} " + QByteArray::number(value) + '\n';
+                break;
+            }
+            case MetricType::Histogram: {
+                quint32 numBounds;
+                stream >> numBounds;
+                if (stream.status() != QDataStream::Ok || numBounds > (quint32)stream.device()->bytesAvailable()) {
+                    return false;
+                }
+                std::vector<double> upperBounds(numBounds);
+                for (auto& upperBound : upperBounds) {
+                    stream >> upperBound;
+                }
+
+                // the buckets of the text format are cumulative
+                QByteArray& samples = family(name, "histogram").samples;
+                quint64 count = 0;
+                for (quint32 bucket = 0; bucket <= numBounds; ++bucket) {
+                    quint64 bucketCount;
+                    stream >> bucketCount;
+                    count += bucketCount;
+
+                    QByteArray upperBound = bucket < numBounds ? QByteArray::number(upperBounds[bucket]) : "+Inf";
+                    samples += name + "_bucket{" + labels + (labels.isEmpty() ? "" : ",") + "le=\"" + upperBound + "\"} " +
+                        QByteArray::number(count) + '\n';
+                }
+                double sum;
+                stream >> sum;
+                samples += name + "_sum{" + labels + "} " + QByteArray::number(sum) + '\n';
+                samples += name + "_count{" + labels + "} " + QByteArray::number(count) + '\n';
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+QByteArray TextWriter::toText() const {
+    QByteArray text;
+    for (const auto& family : _families) {
+        text += "# TYPE " + family.first + ' ' + family.second.type + '\n';
+        text += family.second.samples;
+    }
+    return text;
+}
@@ -0,0 +1,133 @@
+//
+//  Metrics.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_Metrics_h
+#define hifi_Metrics_h
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+// The counters, gauges and histograms of a process, cheap enough to update from the hot loops of the servers
+//   A metric is made once, by name, and updated through the reference the registry gave out; the updates are
+//   relaxed atomics, the registry is only locked to make a metric or to serialize them all. The serialized form is a
+//   compact binary one, that the assignments send to the domain-server, which serves the metrics of all of them as
+//   text in the Prometheus exposition format.
+//   The names are those of Prometheus: letters, digits and underscores, and the counters end with _total.
+//   The assignment-client runs one assignment after another in the same process, so the registry is cleared as each
+//   finishes and the next registers the metrics it updates.
+namespace metrics {
+
+class Counter {
+public:
+    void increment(uint64_t count = 1) { _value.fetch_add(count, std::memory_order_relaxed); }
+    uint64_t get() const { return _value.load(std::memory_order_relaxed); }
+    void reset() { _value.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> _value { 0 };
+};
+
+class Gauge {
+public:
+    void set(int64_t value) { _value.store(value, std::memory_order_relaxed); }
+    void add(int64_t value) { _value.fetch_add(value, std::memory_order_relaxed); }
+    int64_t get() const { return _value.load(std::memory_order_relaxed); }
+    void reset() { set(0); }
+
+private:
+    std::atomic<int64_t> _value { 0 };
+};
+
+// The count of the values observed in each of a set of buckets, given by their inclusive upper bounds, and their sum
+class Histogram {
+public:
+    Histogram(const std::vector<double>& upperBounds);
+
+    void observe(double value);
+
+    const std::vector<double>& getUpperBounds() const { return _upperBounds; }
+    // the counts of each bucket, and of the values above the last bound
+    std::vector<uint64_t> getBucketCounts() const;
+    double getSum() const { return _sum.load(std::memory_order_relaxed); }
+    void reset();
+
+private:
+    std::vector<double> _upperBounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> _bucketCounts;
+    std::atomic<double> _sum { 0.0 };
+};
+
+class Registry {
+public:
+    static Registry& getInstance();
+
+    // the metric of the name, made the first time it's asked for
+    Counter& counter(const QByteArray& name);
+    Gauge& gauge(const QByteArray& name);
+    Histogram& histogram(const QByteArray& name, const std::vector<double>& upperBounds);
+
+    // the counters and gauges already kept elsewhere, read when the metrics are serialized
+    void addCollectedCounter(const QByteArray& name, std::function<uint64_t()> collect);
+    void addCollectedGauge(const QByteArray& name, std::function<int64_t()> collect);
+
+    QByteArray serialize() const;
+
+    // forgets the metrics, when an assignment finishes: they are no longer serialized, and the collected ones no
+    // longer read. The references given out stay valid, and a metric asked for again by name starts over from zero.
+    void clear();
+
+private:
+    template <typename Metric>
+    using Metrics = std::map<QByteArray, std::unique_ptr<Metric>>;
+
+    template <typename Metric, typename... Args>
+    static Metric& findOrMake(Metrics<Metric>& metrics, Metrics<Metric>& clearedMetrics, const QByteArray& name,
+                              Args&&... args);
+
+    mutable std::mutex _mutex;
+    Metrics<Counter> _counters;
+    Metrics<Gauge> _gauges;
+    Metrics<Histogram> _histograms;
+    Metrics<Counter> _clearedCounters;
+    Metrics<Gauge> _clearedGauges;
+    Metrics<Histogram> _clearedHistograms;
+    std::map<QByteArray, std::function<uint64_t()>> _collectedCounters;
+    std::map<QByteArray, std::function<int64_t()>> _collectedGauges;
+};
+
+// The text exposition of the serialized metrics of several processes, each with its own labels, grouped by metric
+class TextWriter {
+public:
+    // labels like: type="audio-mixer",uuid="..."; returns false if the metrics couldn't be read
+    bool add(const QByteArray& serializedMetrics, const QByteArray& labels);
+
+    QByteArray toText() const;
+
+private:
+    struct Family {
+        QByteArray type;
+        QByteArray samples;
+    };
+
+    Family& family(const QByteArray& name, const char* type);
+
+    std::map<QByteArray, Family> _families;
+};
+
+}
+
+#endif // hifi_Metrics_h
@@ -0,0 +1,118 @@
+//
+//  PoolAllocator.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PoolAllocator_h
+#define hifi_PoolAllocator_h
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// The blocks of one size and alignment, carved out of chunks and kept on a free list once freed
+//   The chunks are never given back, so a pool is as large as the most blocks it had out at once; that suits the
+//   objects there are many of, of a few sizes, that come and go all the time, like the elements of a tree.
+//   A pool is shared by every type of its size and alignment, and lives until the process exits, for the objects
+//   released by static destructors.
+template <size_t BlockSize, size_t BlockAlignment>
+class BlockPool {
+public:
+    static BlockPool& get() {
+        static BlockPool* instance = new BlockPool();
+        return *instance;
+    }
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_freeList) {
+            addChunk();
+        }
+        FreeBlock* block = _freeList;
+        _freeList = block->next;
+        return block;
+    }
+
+    void deallocate(void* pointer) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = _freeList;
+        _freeList = block;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static const size_t BLOCKS_PER_CHUNK = 256;
+    static const size_t SIZE = BlockSize > sizeof(FreeBlock) ? BlockSize : sizeof(FreeBlock);
+    static const size_t ALIGNMENT = BlockAlignment > alignof(FreeBlock) ? BlockAlignment : alignof(FreeBlock);
+    using Block = typename std::aligned_storage<SIZE, ALIGNMENT>::type;
+
+    void addChunk() {
+        _chunks.emplace_back(new Block[BLOCKS_PER_CHUNK]);
+        Block* chunk = _chunks.back().get();
+        for (size_t i = BLOCKS_PER_CHUNK; i > 0; --i) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(&chunk[i - 1]);
+            block->next = _freeList;
+            _freeList = block;
+        }
+    }
+
+    std::mutex _mutex;
+    FreeBlock* _freeList { nullptr };
+    std::vector<std::unique_ptr<Block[]>> _chunks;
+};
+
+// An allocator of single objects from the BlockPool of their size, for std::allocate_shared and the containers
+// of nodes; arrays go to the heap as usual
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n != 1) {
+            return std::allocator<T>().allocate(n);
+        }
+        return static_cast<T*>(BlockPool<sizeof(T), alignof(T)>::get().allocate());
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        if (n != 1) {
+            std::allocator<T>().deallocate(pointer, n);
+            return;
+        }
+        BlockPool<sizeof(T), alignof(T)>::get().deallocate(pointer);
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U>;
+    };
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return false;
+}
+
+#endif // hifi_PoolAllocator_h
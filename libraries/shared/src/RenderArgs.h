@@ -124,6 +124,9 @@ public:
     std::shared_ptr<gpu::Texture> _whiteTexture;
     uint32_t _globalShapeKey { 0 };
     bool _enableTexturing { true };
+    // set by the passes whose draw order doesn't matter, in which repeated shapes may be drawn instanced at the end of
+    // the batch rather than where they are sorted
+    bool _enableInstancing { false };
 
     RenderDetails _details;
 };
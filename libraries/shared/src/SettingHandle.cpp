@@ -23,6 +23,12 @@ Settings::Settings() : _manager(DependencyManager::get<Setting::Manager>())
 {
 }
 
+QString Settings::fullKey(const QString& name) const {
+    // the groups and the array indices are part of the key the handles know it by
+    QString group = _manager->group();
+    return group.isEmpty() ? name : group + "/" + name;
+}
+
 QString Settings::fileName() const {
     return _manager->fileName();
 }
@@ -32,6 +38,7 @@ void Settings::remove(const QString& key) {
     // when the key is a valid child group with child keys.
     // However, calling remove() without checking will do the right thing.
     _manager->remove(key);
+    _manager->removeValues(fullKey(key));
 }
 
 QStringList Settings::childGroups() const {
@@ -76,13 +83,15 @@ void Settings::endGroup() {
 }
 
 void Settings::setValue(const QString& name, const QVariant& value) {
-    if (_manager->value(name) != value) {
+    QString key = fullKey(name);
+    if (_manager->getValue(key, QVariant()) != value) {
         _manager->setValue(name, value);
+        _manager->updateValue(key, value);
     }
 }
 
 QVariant Settings::value(const QString& name, const QVariant& defaultValue) const {
-    return _manager->value(name, defaultValue);
+    return _manager->getValue(fullKey(name), defaultValue);
 }
 
 
@@ -60,6 +60,8 @@ public:
     void getQuatValueIfValid(const QString& name, glm::quat& quatValue);
 
 private:
+    QString fullKey(const QString& name) const;
+
     QSharedPointer<Setting::Manager> _manager;
 };
 
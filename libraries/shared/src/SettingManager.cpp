@@ -13,12 +13,22 @@
 
 #include <QtCore/QThread>
 #include <QtCore/QDebug>
-#include <QtCore/QUuid>
 
 #include "SettingInterface.h"
 
 namespace Setting {
 
+    static const int SAVE_DELAY_MSEC = 1000; // the writes within a second of the first are saved together
+
+    Manager::Manager() {
+        // the QSettings have already read the whole file, the handles won't ever ask them again
+        auto values = std::make_shared<Values>();
+        for (const auto& key : allKeys()) {
+            values->insert(key, value(key));
+        }
+        _values = values;
+    }
+
     Manager::~Manager() {
         // Cleanup timer
         stopTimer();
@@ -49,44 +59,80 @@ namespace Setting {
         });
     }
 
-    void Manager::loadSetting(Interface* handle) {
-        const auto& key = handle->getKey();
-        withWriteLock([&] {
-            QVariant loadedValue;
-            if (_pendingChanges.contains(key) && _pendingChanges[key] != UNSET_VALUE) {
-                loadedValue = _pendingChanges[key];
-            } else {
-                loadedValue = value(key);
-            }
-            if (loadedValue.isValid()) {
-                handle->setVariant(loadedValue);
-            }
-        });
+    template <typename F>
+    void Manager::withValuesWrite(F&& f) {
+        std::unique_lock<std::mutex> lock(_valuesMutex);
+        // the readers keep the snapshot they loaded, the writers copy it
+        auto values = std::make_shared<Values>(*std::atomic_load(&_values));
+        f(*values);
+        std::atomic_store(&_values, ValuesPointer(values));
     }
 
+    void Manager::loadSetting(Interface* handle) {
+        auto values = std::atomic_load(&_values);
+        auto loadedValue = values->value(handle->getKey());
+        if (loadedValue.isValid()) {
+            handle->setVariant(loadedValue);
+        }
+    }
 
     void Manager::saveSetting(Interface* handle) {
         const auto& key = handle->getKey();
-        QVariant handleValue = UNSET_VALUE;
+        QVariant handleValue;
         if (handle->isSet()) {
             handleValue = handle->getVariant();
         }
 
-        withWriteLock([&] {
-            _pendingChanges[key] = handleValue;
+        withValuesWrite([&](Values& values) {
+            if (handleValue.isValid()) {
+                values.insert(key, handleValue);
+            } else {
+                values.remove(key);
+            }
+            _dirtyKeys.insert(key);
+        });
+
+        if (!_saveScheduled.exchange(true)) {
+            QMetaObject::invokeMethod(this, "scheduleSave", Qt::QueuedConnection);
+        }
+    }
+
+    QVariant Manager::getValue(const QString& key, const QVariant& defaultValue) const {
+        auto values = std::atomic_load(&_values);
+        return values->value(key, defaultValue);
+    }
+
+    void Manager::updateValue(const QString& key, const QVariant& newValue) {
+        withValuesWrite([&](Values& values) {
+            values.insert(key, newValue);
+        });
+    }
+
+    void Manager::removeValues(const QString& key) {
+        // the key may be a group, its children go with it
+        QString groupPrefix = key + "/";
+        withValuesWrite([&](Values& values) {
+            for (auto it = values.begin(); it != values.end();) {
+                if (it.key() == key || it.key().startsWith(groupPrefix)) {
+                    it = values.erase(it);
+                } else {
+                    ++it;
+                }
+            }
         });
     }
 
-    static const int SAVE_INTERVAL_MSEC = 5 * 1000; // 5 sec
     void Manager::startTimer() {
         if (!_saveTimer) {
             _saveTimer = new QTimer(this);
             Q_CHECK_PTR(_saveTimer);
-            _saveTimer->setSingleShot(true); // We will restart it once settings are saved.
-            _saveTimer->setInterval(SAVE_INTERVAL_MSEC); // 5s, Qt::CoarseTimer acceptable
+            _saveTimer->setSingleShot(true); // We will restart it once settings are changed again.
+            _saveTimer->setInterval(SAVE_DELAY_MSEC); // Qt::CoarseTimer acceptable
             connect(_saveTimer, SIGNAL(timeout()), this, SLOT(saveAll()));
         }
-        _saveTimer->start();
+        if (_saveScheduled) {
+            _saveTimer->start();
+        }
     }
 
     void Manager::stopTimer() {
@@ -95,33 +141,40 @@ namespace Setting {
         }
     }
 
+    void Manager::scheduleSave() {
+        if (_saveTimer && !_saveTimer->isActive()) {
+            _saveTimer->start();
+        }
+    }
+
     void Manager::saveAll() {
+        QSet<QString> dirtyKeys;
+        ValuesPointer values;
+        {
+            std::unique_lock<std::mutex> lock(_valuesMutex);
+            dirtyKeys.swap(_dirtyKeys);
+            values = std::atomic_load(&_values);
+            _saveScheduled = false;
+        }
+
         bool forceSync = false;
         withWriteLock([&] {
-            for (auto key : _pendingChanges.keys()) {
-                auto newValue = _pendingChanges[key];
-                auto savedValue = value(key, UNSET_VALUE);
-                if (newValue == savedValue) {
+            for (const auto& key : dirtyKeys) {
+                auto newValue = values->value(key);
+                if (newValue == value(key)) {
                     continue;
                 }
-                if (newValue == UNSET_VALUE || !newValue.isValid()) {
-                    forceSync = true;
-                    remove(key);
-                } else {
-                    forceSync = true;
+                forceSync = true;
+                if (newValue.isValid()) {
                     setValue(key, newValue);
+                } else {
+                    remove(key);
                 }
             }
-            _pendingChanges.clear();
         });
 
         if (forceSync) {
             sync();
         }
-
-        // Restart timer
-        if (_saveTimer) {
-            _saveTimer->start();
-        }
     }
 }
@@ -12,24 +12,35 @@
 #ifndef hifi_SettingManager_h
 #define hifi_SettingManager_h
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtCore/QSettings>
 #include <QtCore/QTimer>
-#include <QtCore/QUuid>
 
 #include "DependencyManager.h"
 #include "shared/ReadWriteLockable.h"
 
+class Settings;
+
 namespace Setting {
     class Interface;
 
+    // The handles read and write an in-memory copy of the settings, never the QSettings.  Reads load a snapshot of
+    // the values without locking; writes replace the snapshot and mark their key dirty, and the dirty keys are written
+    // behind, together, by the settings thread a little later.
     class Manager : public QSettings, public ReadWriteLockable, public Dependency {
         Q_OBJECT
+        SINGLETON_DEPENDENCY
 
     public:
         void customDeleter() override;
 
     protected:
+        Manager();
         ~Manager();
         void registerHandle(Interface* handle);
         void removeHandle(const QString& key);
@@ -37,19 +48,35 @@ namespace Setting {
         void loadSetting(Interface* handle);
         void saveSetting(Interface* handle);
 
+        // for the keys read and written straight by the Settings of old
+        QVariant getValue(const QString& key, const QVariant& defaultValue) const;
+        void updateValue(const QString& key, const QVariant& newValue);
+        void removeValues(const QString& key);
+
     private slots:
         void startTimer();
         void stopTimer();
+        void scheduleSave();
 
         void saveAll();
 
     private:
+        using Values = QHash<QString, QVariant>;
+        using ValuesPointer = std::shared_ptr<const Values>;
+
+        template <typename F>
+        void withValuesWrite(F&& f);
+
         QHash<QString, Interface*> _handles;
         QPointer<QTimer> _saveTimer = nullptr;
-        const QVariant UNSET_VALUE { QUuid::createUuid() };
-        QHash<QString, QVariant> _pendingChanges;
+
+        ValuesPointer _values; // accessed with std::atomic_load and std::atomic_store only
+        std::mutex _valuesMutex; // for the writers of _values and _dirtyKeys
+        QSet<QString> _dirtyKeys;
+        std::atomic<bool> _saveScheduled { false };
 
         friend class Interface;
+        friend class ::Settings;
         friend void cleanupPrivateInstance();
         friend void setupPrivateInstance();
     };
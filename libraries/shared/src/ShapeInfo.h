@@ -70,6 +70,7 @@ public:
 
     const glm::vec3& getHalfExtents() const { return _halfExtents; }
     const glm::vec3& getOffset() const { return _offset; }
+    const QUrl& getURL() const { return _url; }
     uint32_t getNumSubShapes() const;
 
     PointCollection& getPointCollection() { return _pointCollection; }
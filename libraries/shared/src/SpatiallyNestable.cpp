@@ -33,6 +33,7 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 
 SpatiallyNestable::~SpatiallyNestable() {
     forEachChild([&](SpatiallyNestablePointer object) {
+        object->markWorldTransformsDirty();
         object->parentDeleted();
     });
 }
@@ -64,12 +65,17 @@ const QUuid SpatiallyNestable::getParentID() const {
 }
 
 void SpatiallyNestable::setParentID(const QUuid& parentID) {
+    bool changed = false;
     _idLock.withWriteLock([&] {
         if (_parentID != parentID) {
             _parentID = parentID;
             _parentKnowsMe = false;
+            changed = true;
         }
     });
+    if (changed) {
+        markWorldTransformsDirty();
+    }
 
     bool success = false;
     getParentPointer(success);
@@ -149,7 +155,10 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 }
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
-    _parentJointIndex = parentJointIndex;
+    if (_parentJointIndex != parentJointIndex) {
+        _parentJointIndex = parentJointIndex;
+        markWorldTransformsDirty();
+    }
 }
 
 glm::vec3 SpatiallyNestable::worldToLocal(const glm::vec3& position,
@@ -408,6 +417,9 @@ void SpatiallyNestable::setPosition(const glm::vec3& position, bool& success, bo
             _translationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        markWorldTransformsDirty();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -461,6 +473,9 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation, bool& succe
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        markWorldTransformsDirty();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -596,14 +611,64 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    uint32_t generation = _worldTransformGeneration.load(std::memory_order_acquire);
+    if (_worldTransformCacheable.load(std::memory_order_acquire) && readCachedWorldTransform(generation, result)) {
+        success = true;
+        return result;
+    }
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    // the joints of a parent move without telling its children, so only what hangs from the parent's origin
+    // all the way up is cached
+    if (success) {
+        bool parentSuccess;
+        SpatiallyNestablePointer parent = getParentPointer(parentSuccess);
+        bool cacheable = !parent ||
+            (_parentJointIndex == INVALID_JOINT_INDEX && parent->_worldTransformCacheable.load(std::memory_order_acquire));
+        _worldTransformCacheable.store(cacheable, std::memory_order_release);
+        if (cacheable) {
+            writeCachedWorldTransform(generation, result);
+        }
+    }
     return result;
 }
 
+void SpatiallyNestable::markWorldTransformsDirty() {
+    _worldTransformGeneration.fetch_add(1, std::memory_order_acq_rel);
+    forEachDescendant([&](SpatiallyNestablePointer object) {
+        object->_worldTransformGeneration.fetch_add(1, std::memory_order_acq_rel);
+    });
+}
+
+bool SpatiallyNestable::readCachedWorldTransform(uint32_t generation, Transform& transform) const {
+    // a sequence lock: odd while the cache is being written, and read again to find out whether it was meanwhile
+    uint32_t sequence = _worldTransformSequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+    transform = _cachedWorldTransform;
+    uint32_t cachedGeneration = _cachedWorldTransformGeneration;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return _worldTransformSequence.load(std::memory_order_relaxed) == sequence && cachedGeneration == generation;
+}
+
+void SpatiallyNestable::writeCachedWorldTransform(uint32_t generation, const Transform& transform) const {
+    uint32_t sequence = _worldTransformSequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) || !_worldTransformSequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        // another thread is caching it
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    _cachedWorldTransform = transform;
+    _cachedWorldTransformGeneration = generation;
+    _worldTransformSequence.store(sequence + 2, std::memory_order_release);
+}
+
 const Transform SpatiallyNestable::getTransform() const {
     bool success;
     Transform result = getTransform(success);
@@ -661,6 +726,9 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        markWorldTransformsDirty();
+    }
     if (success && changed) {
         locationChanged();
     }
@@ -703,6 +771,7 @@ void SpatiallyNestable::setScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        markWorldTransformsDirty();
         dimensionsChanged();
     }
 }
@@ -726,6 +795,7 @@ void SpatiallyNestable::setScale(float value) {
     });
 
     if (changed) {
+        markWorldTransformsDirty();
         dimensionsChanged();
     }
 }
@@ -757,6 +827,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        markWorldTransformsDirty();
         locationChanged();
     }
 }
@@ -784,6 +855,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        markWorldTransformsDirty();
         locationChanged(tellPhysics);
     }
 }
@@ -811,6 +883,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        markWorldTransformsDirty();
         locationChanged();
     }
 }
@@ -869,6 +942,7 @@ void SpatiallyNestable::setLocalScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        markWorldTransformsDirty();
         dimensionsChanged();
     }
 }
@@ -1123,6 +1197,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        markWorldTransformsDirty();
         locationChanged(false);
     }
 }
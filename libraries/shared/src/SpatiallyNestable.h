@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -208,6 +210,11 @@ protected:
     quint64 _rotationChanged { 0 };
 
 private:
+    // bumps the generation of this world transform and of those of all the descendants, whose cached ones are stale
+    void markWorldTransformsDirty();
+    bool readCachedWorldTransform(uint32_t generation, Transform& transform) const;
+    void writeCachedWorldTransform(uint32_t generation, const Transform& transform) const;
+
     QUuid _parentID; // what is this thing's transform relative to?
     quint16 _parentJointIndex { INVALID_JOINT_INDEX }; // which joint of the parent is this relative to?
 
@@ -220,6 +227,13 @@ private:
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
     bool _isDead { false };
+
+    // the world transform, read without locks for as long as its generation is current
+    std::atomic<uint32_t> _worldTransformGeneration { 1 };
+    mutable std::atomic<uint32_t> _worldTransformSequence { 0 };
+    mutable std::atomic<bool> _worldTransformCacheable { false };
+    mutable Transform _cachedWorldTransform;
+    mutable uint32_t _cachedWorldTransformGeneration { 0 };
 };
 
 
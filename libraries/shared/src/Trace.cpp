@@ -8,6 +8,7 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QtCore/QDebug>
@@ -30,28 +31,278 @@
 #include <BuildInfo.h>
 
 #include "Gzip.h"
+#include "NumericalConstants.h"
 #include "PortableHighResolutionClock.h"
 #include "shared/GlobalAppProperties.h"
 
 using namespace tracing;
 
+namespace {
+    const uint32_t TRACE_CHUNK_SIZE = 1024; // records
+    // the ring of a thread while flight recording, some 9 MB for a thread that traces that much
+    const size_t MAX_FLIGHT_RECORDING_CHUNKS = 128;
+
+    std::atomic<uint64_t> nextTracerInstanceID { 1 };
+
+    struct TraceStrings {
+        std::mutex mutex;
+        QHash<QString, uint32_t> ids;
+        std::vector<QString> strings { QString() }; // ID 0 is the empty string
+    };
+
+    TraceStrings& traceStrings() {
+        static TraceStrings strings;
+        return strings;
+    }
+
+    // the strings are interned for the whole process, each thread caches the IDs it has already looked up
+    uint32_t internString(const QString& string) {
+        if (string.isEmpty()) {
+            return 0;
+        }
+        thread_local QHash<QString, uint32_t> cachedIDs;
+        auto cached = cachedIDs.constFind(string);
+        if (cached != cachedIDs.constEnd()) {
+            return cached.value();
+        }
+
+        uint32_t id;
+        {
+            auto& strings = traceStrings();
+            std::lock_guard<std::mutex> guard(strings.mutex);
+            auto found = strings.ids.constFind(string);
+            if (found != strings.ids.constEnd()) {
+                id = found.value();
+            } else {
+                id = (uint32_t)strings.strings.size();
+                strings.strings.push_back(string);
+                strings.ids.insert(string, id);
+            }
+        }
+        cachedIDs.insert(string, id);
+        return id;
+    }
+
+    uint32_t internCategory(const QLoggingCategory& category) {
+        thread_local QHash<const QLoggingCategory*, uint32_t> cachedIDs;
+        auto cached = cachedIDs.constFind(&category);
+        if (cached != cachedIDs.constEnd()) {
+            return cached.value();
+        }
+        uint32_t id = internString(QString(category.categoryName()));
+        cachedIDs.insert(&category, id);
+        return id;
+    }
+
+    std::vector<QString> copyInternedStrings() {
+        auto& strings = traceStrings();
+        std::lock_guard<std::mutex> guard(strings.mutex);
+        return strings.strings;
+    }
+
+    bool isNumber(const QVariant& value) {
+        switch (value.userType()) {
+            case QMetaType::Bool:
+            case QMetaType::Int:
+            case QMetaType::UInt:
+            case QMetaType::LongLong:
+            case QMetaType::ULongLong:
+            case QMetaType::Float:
+            case QMetaType::Double:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void addRecordArg(TraceRecord& record, const QString& key, const QVariant& value, bool extra) {
+        uint8_t arg = record.numArgs++;
+        record.argKeyIDs[arg] = internString(key);
+        if (isNumber(value)) {
+            record.argValues[arg].number = value.toDouble();
+        } else {
+            record.argValues[arg].stringID = internString(value.toString());
+            record.stringArgs |= (1 << arg);
+        }
+        if (extra) {
+            record.extraArgs |= (1 << arg);
+        }
+    }
+
+    void addRecordArgsToJson(QJsonObject& ev, const TraceRecord& record, const std::vector<QString>& strings) {
+        QJsonObject args = ev.value("args").toObject();
+        for (uint8_t arg = 0; arg < record.numArgs; ++arg) {
+            QJsonValue value = (record.stringArgs & (1 << arg)) ?
+                QJsonValue(strings[record.argValues[arg].stringID]) : QJsonValue(record.argValues[arg].number);
+            const QString& key = strings[record.argKeyIDs[arg]];
+            if (record.extraArgs & (1 << arg)) {
+                ev[key] = value;
+            } else {
+                args[key] = value;
+            }
+        }
+        if (!args.empty()) {
+            ev["args"] = args;
+        }
+    }
+
+    // the event of the record at index, along with the args of the records that continue it
+    QJsonObject recordToJson(const std::vector<TraceRecord>& records, size_t index, qint64 processID, qint64 threadID,
+                             const std::vector<QString>& strings) {
+        const TraceRecord& record = records[index];
+        QJsonObject ev {
+            { "name", strings[record.nameID] },
+            { "cat", strings[record.categoryID] },
+            { "ph", QString(QChar(record.type)) },
+            { "ts", (qint64)record.timestamp },
+            { "pid", processID },
+            { "tid", threadID }
+        };
+        if (record.idID != 0) {
+            ev["id"] = strings[record.idID];
+        }
+        addRecordArgsToJson(ev, record, strings);
+        for (size_t i = index; records[i].continued && i + 1 < records.size() && records[i + 1].continuation; ++i) {
+            addRecordArgsToJson(ev, records[i + 1], strings);
+        }
+        return ev;
+    }
+}
+
+// The records of one thread, in chunks.  Only the thread itself appends, without a lock within a chunk:
+// the count of a chunk is published after its record is written, so a reader sees whole records only.
+// Moving on to the next chunk, and reading, take the mutex.  The chunks are never freed while the thread
+// may still be writing to them, and only the thread itself clears them, when it sees that the tracer has
+// moved on to a new generation of buffers.
+class tracing::ThreadTraceBuffer {
+public:
+    ThreadTraceBuffer(uint32_t generation) : _threadID(int64_t(QThread::currentThreadId())), _generation(generation) {
+        _chunks.push_back(std::unique_ptr<Chunk>(new Chunk()));
+        _current = _chunks.front().get();
+    }
+
+    qint64 getThreadID() const { return _threadID; }
+
+    // maxChunks of 0 keeps them all, otherwise they make a ring that overwrites the oldest
+    void append(const TraceRecord& record, size_t maxChunks, uint32_t generation) {
+        if (generation != _generation) {
+            clear(generation);
+        }
+        Chunk* chunk = _current;
+        uint32_t count = chunk->count.load(std::memory_order_relaxed);
+        if (count == TRACE_CHUNK_SIZE) {
+            chunk = nextChunk(maxChunks);
+            count = 0;
+        }
+        chunk->records[count] = record;
+        chunk->count.store(count + 1, std::memory_order_release);
+    }
+
+    // from the oldest, leaving out those before since, and all of them if the thread hasn't cleared them yet
+    void copyRecords(std::vector<TraceRecord>& records, TraceTimestamp since, uint32_t generation) {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if (generation != _generation) {
+            return;
+        }
+        for (size_t i = 1; i <= _chunks.size(); ++i) {
+            const Chunk& chunk = *_chunks[(_currentIndex + i) % _chunks.size()];
+            uint32_t count = chunk.count.load(std::memory_order_acquire);
+            for (uint32_t j = 0; j < count; ++j) {
+                if (chunk.records[j].timestamp >= since) {
+                    records.push_back(chunk.records[j]);
+                }
+            }
+        }
+    }
+
+private:
+    struct Chunk {
+        std::atomic<uint32_t> count { 0 };
+        TraceRecord records[TRACE_CHUNK_SIZE];
+    };
+
+    Chunk* nextChunk(size_t maxChunks) {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if (_currentIndex + 1 < _chunks.size()) {
+            ++_currentIndex;
+        } else if (maxChunks > 0 && _chunks.size() >= maxChunks) {
+            _currentIndex = 0;
+        } else {
+            _chunks.push_back(std::unique_ptr<Chunk>(new Chunk()));
+            _currentIndex = _chunks.size() - 1;
+        }
+        _current = _chunks[_currentIndex].get();
+        _current->count.store(0, std::memory_order_relaxed);
+        return _current;
+    }
+
+    void clear(uint32_t generation) {
+        std::lock_guard<std::mutex> guard(_mutex);
+        for (auto& chunk : _chunks) {
+            chunk->count.store(0, std::memory_order_relaxed);
+        }
+        _currentIndex = 0;
+        _current = _chunks.front().get();
+        _generation = generation;
+    }
+
+    const qint64 _threadID;
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<Chunk>> _chunks;
+    size_t _currentIndex { 0 };
+    Chunk* _current;
+    uint32_t _generation; // written by the thread itself, under the mutex
+};
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+Tracer::Tracer() : _instanceID(nextTracerInstanceID++) {
+}
+
+ThreadTraceBufferPointer Tracer::getThreadBuffer() {
+    // each thread registers its buffer with a tracer the first time it traces to it
+    thread_local uint64_t threadTracerID { 0 };
+    thread_local ThreadTraceBufferPointer threadBuffer;
+    if (threadTracerID != _instanceID) {
+        threadBuffer = std::make_shared<ThreadTraceBuffer>(_bufferGeneration.load());
+        threadTracerID = _instanceID;
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        _threadBuffers.push_back(threadBuffer);
+    }
+    return threadBuffer;
+}
+
+void Tracer::clearThreadBuffers() {
+    // the threads may be appending to their buffers right now, so each clears its own before its next event
+    ++_bufferGeneration;
+}
+
 void Tracer::startTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
         qWarning() << "Tried to enable tracer, but already enabled";
         return;
     }
 
-    _events.clear();
+    clearThreadBuffers();
+    _flightRecording = false;
+    _enabled = true;
+}
+
+void Tracer::startFlightRecording(float durationSeconds) {
+    if (_enabled) {
+        qWarning() << "Tried to start flight recording, but the tracer is already enabled";
+        return;
+    }
+
+    clearThreadBuffers();
+    _flightRecordingDuration = (TraceTimestamp)(std::max(durationSeconds, 0.0f) * USECS_PER_SECOND);
+    _flightRecording = true;
     _enabled = true;
 }
 
 void Tracer::stopTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (!_enabled) {
         qWarning() << "Cannot stop tracing, already disabled";
         return;
@@ -128,14 +379,30 @@ void Tracer::serialize(const QString& originalPath) {
 
 
 
-    std::list<TraceEvent> currentEvents;
+    // the flight recording carries on, while a full trace is handed over to the file
+    bool flightRecording = _enabled && _flightRecording;
+    TraceTimestamp since = 0;
+    if (flightRecording) {
+        auto now = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+        since = (TraceTimestamp)now > _flightRecordingDuration ? (TraceTimestamp)now - _flightRecordingDuration : 0;
+    }
+
+    std::list<TraceEvent> metadataEvents;
+    std::vector<std::pair<qint64, std::vector<TraceRecord>>> threadRecords;
     {
         std::lock_guard<std::mutex> guard(_eventsMutex);
-        currentEvents.swap(_events);
-        for (auto& event : _metadataEvents) {
-            currentEvents.push_back(event);
+        metadataEvents = _metadataEvents;
+        uint32_t generation = _bufferGeneration;
+        for (auto& buffer : _threadBuffers) {
+            threadRecords.emplace_back(buffer->getThreadID(), std::vector<TraceRecord>());
+            buffer->copyRecords(threadRecords.back().second, since, generation);
         }
     }
+    if (!flightRecording) {
+        clearThreadBuffers();
+    }
+    std::vector<QString> strings = copyInternedStrings();
+    auto processID = QCoreApplication::applicationPid();
 
     // If the file exists and we can't remove it, fail early
     if (QFileInfo(path).exists() && !QFile::remove(path)) {
@@ -148,7 +415,7 @@ void Tracer::serialize(const QString& originalPath) {
         QTextStream out(&data);
         out << "[\n";
         bool first = true;
-        for (const auto& event : currentEvents) {
+        for (const auto& event : metadataEvents) {
             if (first) {
                 first = false;
             } else {
@@ -156,6 +423,21 @@ void Tracer::serialize(const QString& originalPath) {
             }
             event.writeJson(out);
         }
+        for (const auto& thread : threadRecords) {
+            const auto& records = thread.second;
+            for (size_t i = 0; i < records.size(); ++i) {
+                if (records[i].continuation) {
+                    // already merged into the event it continues, or lost with it to the flight recording's ring
+                    continue;
+                }
+                if (first) {
+                    first = false;
+                } else {
+                    out << ",\n";
+                }
+                out << QJsonDocument(recordToJson(records, i, processID, thread.first, strings)).toJson(QJsonDocument::Compact);
+            }
+        }
         out << "\n]";
     }
 
@@ -197,13 +479,9 @@ void Tracer::serialize(const QString& originalPath) {
 #endif
 }
 
-void Tracer::traceEvent(const QLoggingCategory& category,
-    const QString& name, EventType type,
-    qint64 timestamp, qint64 processID, qint64 threadID,
-    const QString& id,
+void Tracer::traceEvent(const QLoggingCategory& category, 
+    const QString& name, EventType type, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
-
     // We always want to store metadata events even if tracing is not enabled so that when
     // tracing is enabled we will be able to associate that metadata with that trace.
     // Metadata events should be used sparingly - as of 12/30/16 the Chrome Tracing
@@ -213,7 +491,12 @@ void Tracer::traceEvent(const QLoggingCategory& category,
         return;
     }
 
+    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+
     if (type == Metadata) {
+        auto processID = QCoreApplication::applicationPid();
+        auto threadID = int64_t(QThread::currentThreadId());
+        std::lock_guard<std::mutex> guard(_eventsMutex);
         _metadataEvents.push_back({
             id,
             name,
@@ -225,31 +508,41 @@ void Tracer::traceEvent(const QLoggingCategory& category,
             args,
             extra
         });
-    } else {
-        _events.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
-            args,
-            extra
-        });
-    }
-}
-
-void Tracer::traceEvent(const QLoggingCategory& category, 
-    const QString& name, EventType type, const QString& id, 
-    const QVariantMap& args, const QVariantMap& extra) {
-    if (!_enabled && type != Metadata) {
         return;
     }
 
-    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
-    auto processID = QCoreApplication::applicationPid();
-    auto threadID = int64_t(QThread::currentThreadId());
+    TraceRecord record;
+    record.timestamp = (TraceTimestamp)timestamp;
+    record.nameID = internString(name);
+    record.categoryID = internCategory(category);
+    record.idID = internString(id);
+    record.type = type;
+    record.numArgs = 0;
+    record.stringArgs = 0;
+    record.extraArgs = 0;
+    record.continued = false;
+    record.continuation = false;
+
+    auto buffer = getThreadBuffer();
+    size_t maxChunks = _flightRecording ? MAX_FLIGHT_RECORDING_CHUNKS : 0;
+    uint32_t generation = _bufferGeneration;
+    auto addArgs = [&](const QVariantMap& recordArgs, bool isExtra) {
+        for (auto it = recordArgs.begin(); it != recordArgs.end(); ++it) {
+            if (record.numArgs == MAX_TRACE_RECORD_ARGS) {
+                // spill the rest into a record that continues this one
+                record.continued = true;
+                buffer->append(record, maxChunks, generation);
+                record.continued = false;
+                record.continuation = true;
+                record.numArgs = 0;
+                record.stringArgs = 0;
+                record.extraArgs = 0;
+            }
+            addRecordArg(record, it.key(), it.value(), isExtra);
+        }
+    };
+    addArgs(args, false);
+    addArgs(extra, true);
 
-    traceEvent(category, name, type, timestamp, processID, threadID, id, args, extra);
+    buffer->append(record, maxChunks, generation);
 }
@@ -10,8 +10,12 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -76,27 +80,62 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+const int MAX_TRACE_RECORD_ARGS = 4;
+
+// An event as the thread that traced it keeps it: fixed size, with its strings interned, so that
+// recording one takes neither a lock nor an allocation.  The numeric args are kept as numbers, the
+// others as the interned strings of their values.  An event with more args than fit spills the rest
+// into the records that follow it.
+struct TraceRecord {
+    TraceTimestamp timestamp;
+    uint32_t nameID;
+    uint32_t categoryID;
+    uint32_t idID; // 0 for no id
+    EventType type;
+    uint8_t numArgs;
+    uint8_t stringArgs; // a bit for each arg whose value is a string ID
+    uint8_t extraArgs; // a bit for each arg that is an extra field of the event rather than one of its args
+    bool continued; // the next record holds more of this event's args
+    bool continuation; // holds only more args of the event of the record before it
+    uint32_t argKeyIDs[MAX_TRACE_RECORD_ARGS];
+    union {
+        double number;
+        uint32_t stringID;
+    } argValues[MAX_TRACE_RECORD_ARGS];
+};
+
+class ThreadTraceBuffer;
+using ThreadTraceBufferPointer = std::shared_ptr<ThreadTraceBuffer>;
+
+// Each thread records its events into a buffer of its own.  While tracing, every event is kept until the
+// trace is serialized; while flight recording, each thread keeps a bounded ring of its latest events and
+// serializing dumps those of the last seconds without stopping the recording.
 class Tracer : public Dependency {
 public:
+    Tracer();
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         const QString& id = "", 
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
     void startTracing();
+    void startFlightRecording(float durationSeconds);
     void stopTracing();
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
+    bool isFlightRecording() const { return _enabled && _flightRecording; }
 
 private:
-    void traceEvent(const QLoggingCategory& category, 
-        const QString& name, EventType type,
-        qint64 timestamp, qint64 processID, qint64 threadID,
-        const QString& id = "",
-        const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
-
-    bool _enabled { false };
-    std::list<TraceEvent> _events;
+    ThreadTraceBufferPointer getThreadBuffer();
+    void clearThreadBuffers();
+
+    const uint64_t _instanceID;
+    std::atomic<bool> _enabled { false };
+    std::atomic<bool> _flightRecording { false };
+    std::atomic<uint32_t> _bufferGeneration { 0 }; // bumped to have every thread clear its buffer before its next event
+    TraceTimestamp _flightRecordingDuration { 0 }; // usecs
+    std::vector<ThreadTraceBufferPointer> _threadBuffers;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
 };
@@ -9,11 +9,61 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <cfloat>
+
 #include "GLMHelpers.h"
 #include "TriangleSet.h"
 
+namespace {
+    // the leaves are split only if the surface area heuristic finds it pays, and always above this many triangles
+    const uint32_t MAX_LEAF_TRIANGLES = 8;
+    const uint32_t MIN_SPLIT_TRIANGLES = 2;
+    const int NUM_SAH_BINS = 16;
+    const float NODE_TRAVERSAL_COST = 1.0f; // relative to testing a triangle
+    const int MAX_BVH_DEPTH = 48;
+
+    struct Bounds {
+        glm::vec3 minimum { FLT_MAX };
+        glm::vec3 maximum { -FLT_MAX };
+
+        void grow(const glm::vec3& point) {
+            minimum = glm::min(minimum, point);
+            maximum = glm::max(maximum, point);
+        }
+        void grow(const Bounds& bounds) {
+            minimum = glm::min(minimum, bounds.minimum);
+            maximum = glm::max(maximum, bounds.maximum);
+        }
+        float getHalfArea() const {
+            glm::vec3 extents = glm::max(maximum - minimum, glm::vec3(0.0f));
+            return extents.x * extents.y + extents.y * extents.z + extents.z * extents.x;
+        }
+    };
+
+    // the slab test, with the reciprocal of the direction computed once for all of the boxes; the three axes go
+    // through the same vector operations
+    inline bool findRayBoxIntersection(const glm::vec3& origin, const glm::vec3& inverseDirection,
+            const glm::vec3& minimum, const glm::vec3& maximum, float maxDistance, float& entryDistance) {
+        glm::vec3 t0 = (minimum - origin) * inverseDirection;
+        glm::vec3 t1 = (maximum - origin) * inverseDirection;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        entryDistance = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        float exitDistance = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        return entryDistance <= exitDistance;
+    }
+}
+
+struct TriangleSet::BVHBuild {
+    std::vector<uint32_t> indices;
+    std::vector<glm::vec3> centroids;
+    std::vector<Bounds> bounds;
+};
+
 void TriangleSet::insert(const Triangle& t) {
     _triangles.push_back(t);
+    _nodes.clear();
 
     _bounds += t.v0;
     _bounds += t.v1;
@@ -22,9 +72,216 @@ void TriangleSet::insert(const Triangle& t) {
 
 void TriangleSet::clear() {
     _triangles.clear();
+    _nodes.clear();
     _bounds.clear();
 }
 
+void TriangleSet::buildBVH() {
+    _nodes.clear();
+    if (_triangles.empty()) {
+        return;
+    }
+
+    BVHBuild build;
+    uint32_t numTriangles = (uint32_t)_triangles.size();
+    build.indices.resize(numTriangles);
+    build.centroids.resize(numTriangles);
+    build.bounds.resize(numTriangles);
+    for (uint32_t i = 0; i < numTriangles; ++i) {
+        const Triangle& triangle = _triangles[i];
+        build.indices[i] = i;
+        build.centroids[i] = (triangle.v0 + triangle.v1 + triangle.v2) / 3.0f;
+        build.bounds[i].grow(triangle.v0);
+        build.bounds[i].grow(triangle.v1);
+        build.bounds[i].grow(triangle.v2);
+    }
+
+    // a binary tree of leaves of at least one triangle has fewer than twice as many nodes
+    _nodes.reserve(2 * numTriangles / MIN_SPLIT_TRIANGLES + 1);
+    buildBVHNode(build, 0, numTriangles, 0);
+    _nodes.shrink_to_fit();
+
+    // the triangles of each leaf are next to each other
+    std::vector<Triangle> triangles;
+    triangles.reserve(numTriangles);
+    for (uint32_t index : build.indices) {
+        triangles.push_back(_triangles[index]);
+    }
+    _triangles.swap(triangles);
+}
+
+void TriangleSet::buildBVHNode(BVHBuild& build, uint32_t begin, uint32_t end, int depth) {
+    uint32_t nodeIndex = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+
+    Bounds bounds;
+    Bounds centroidBounds;
+    for (uint32_t i = begin; i < end; ++i) {
+        uint32_t index = build.indices[i];
+        bounds.grow(build.bounds[index]);
+        centroidBounds.grow(build.centroids[index]);
+    }
+    _nodes[nodeIndex].minimum = bounds.minimum;
+    _nodes[nodeIndex].maximum = bounds.maximum;
+
+    auto makeLeaf = [&] {
+        _nodes[nodeIndex].start = begin;
+        _nodes[nodeIndex].count = end - begin;
+    };
+
+    uint32_t count = end - begin;
+    if (count < MIN_SPLIT_TRIANGLES || depth >= MAX_BVH_DEPTH) {
+        makeLeaf();
+        return;
+    }
+
+    // bin the centroids along each axis, and find the split of the lowest surface area cost
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = FLT_MAX;
+    glm::vec3 centroidExtents = centroidBounds.maximum - centroidBounds.minimum;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (centroidExtents[axis] <= 0.0f) {
+            continue;
+        }
+        float binScale = NUM_SAH_BINS / centroidExtents[axis];
+
+        Bounds binBounds[NUM_SAH_BINS];
+        uint32_t binCounts[NUM_SAH_BINS] = { 0 };
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t index = build.indices[i];
+            int bin = std::min((int)((build.centroids[index][axis] - centroidBounds.minimum[axis]) * binScale), NUM_SAH_BINS - 1);
+            binBounds[bin].grow(build.bounds[index]);
+            ++binCounts[bin];
+        }
+
+        // the costs of the right sides, swept from the right, then those of the left sides from the left
+        float rightCosts[NUM_SAH_BINS];
+        Bounds rightBounds;
+        uint32_t rightCount = 0;
+        for (int bin = NUM_SAH_BINS - 1; bin > 0; --bin) {
+            rightBounds.grow(binBounds[bin]);
+            rightCount += binCounts[bin];
+            rightCosts[bin] = rightCount > 0 ? rightBounds.getHalfArea() * rightCount : 0.0f;
+        }
+        Bounds leftBounds;
+        uint32_t leftCount = 0;
+        for (int split = 1; split < NUM_SAH_BINS; ++split) {
+            leftBounds.grow(binBounds[split - 1]);
+            leftCount += binCounts[split - 1];
+            if (leftCount == 0 || leftCount == count) {
+                continue;
+            }
+            float cost = leftBounds.getHalfArea() * leftCount + rightCosts[split];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = split;
+            }
+        }
+    }
+
+    float leafCost = (float)count;
+    float splitCost = NODE_TRAVERSAL_COST + bestCost / std::max(bounds.getHalfArea(), FLT_MIN);
+    if (bestAxis < 0 || (splitCost >= leafCost && count <= MAX_LEAF_TRIANGLES)) {
+        // the triangles are all in one place, or not worth splitting
+        if (bestAxis < 0 && count > MAX_LEAF_TRIANGLES && depth < MAX_BVH_DEPTH) {
+            // split the coincident ones in halves anyway, so that no leaf is too large to test
+            uint32_t middle = begin + count / 2;
+            _nodes[nodeIndex].count = 0;
+            buildBVHNode(build, begin, middle, depth + 1);
+            _nodes[nodeIndex].start = (uint32_t)_nodes.size();
+            buildBVHNode(build, middle, end, depth + 1);
+            return;
+        }
+        makeLeaf();
+        return;
+    }
+
+    float binScale = NUM_SAH_BINS / centroidExtents[bestAxis];
+    float minimum = centroidBounds.minimum[bestAxis];
+    auto middleIt = std::partition(build.indices.begin() + begin, build.indices.begin() + end, [&](uint32_t index) {
+        int bin = std::min((int)((build.centroids[index][bestAxis] - minimum) * binScale), NUM_SAH_BINS - 1);
+        return bin < bestSplit;
+    });
+    uint32_t middle = (uint32_t)(middleIt - build.indices.begin());
+
+    _nodes[nodeIndex].count = 0;
+    buildBVHNode(build, begin, middle, depth + 1);
+    _nodes[nodeIndex].start = (uint32_t)_nodes.size();
+    buildBVHNode(build, middle, end, depth + 1);
+}
+
+bool TriangleSet::findBVHRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance,
+                                         glm::vec3& surfaceNormal) const {
+    glm::vec3 inverseDirection = 1.0f / direction;
+    float bestDistance = FLT_MAX;
+    const Triangle* bestTriangle = nullptr;
+
+    struct StackEntry {
+        uint32_t node;
+        float entryDistance;
+    };
+    StackEntry stack[MAX_BVH_DEPTH + 2];
+    int stackSize = 0;
+
+    float rootEntryDistance;
+    if (!findRayBoxIntersection(origin, inverseDirection, _nodes[0].minimum, _nodes[0].maximum, bestDistance,
+            rootEntryDistance)) {
+        return false;
+    }
+    stack[stackSize++] = { 0, rootEntryDistance };
+
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        if (entry.entryDistance >= bestDistance) {
+            continue;
+        }
+
+        const BVHNode& node = _nodes[entry.node];
+        if (node.count > 0) {
+            for (uint32_t i = node.start, end = node.start + node.count; i < end; ++i) {
+                float triangleDistance;
+                if (findRayTriangleIntersection(origin, direction, _triangles[i], triangleDistance) &&
+                        triangleDistance < bestDistance) {
+                    bestDistance = triangleDistance;
+                    bestTriangle = &_triangles[i];
+                }
+            }
+            continue;
+        }
+
+        // the nearer child is walked first
+        uint32_t first = entry.node + 1;
+        uint32_t second = node.start;
+        float firstDistance, secondDistance;
+        bool hitsFirst = findRayBoxIntersection(origin, inverseDirection, _nodes[first].minimum, _nodes[first].maximum,
+            bestDistance, firstDistance);
+        bool hitsSecond = findRayBoxIntersection(origin, inverseDirection, _nodes[second].minimum, _nodes[second].maximum,
+            bestDistance, secondDistance);
+        if (hitsFirst && hitsSecond) {
+            if (firstDistance < secondDistance) {
+                stack[stackSize++] = { second, secondDistance };
+                stack[stackSize++] = { first, firstDistance };
+            } else {
+                stack[stackSize++] = { first, firstDistance };
+                stack[stackSize++] = { second, secondDistance };
+            }
+        } else if (hitsFirst) {
+            stack[stackSize++] = { first, firstDistance };
+        } else if (hitsSecond) {
+            stack[stackSize++] = { second, secondDistance };
+        }
+    }
+
+    if (!bestTriangle) {
+        return false;
+    }
+    distance = bestDistance;
+    surfaceNormal = bestTriangle->getNormal();
+    return true;
+}
+
 // Determine of the given ray (origin/direction) in model space intersects with any triangles
 // in the set. If an intersection occurs, the distance and surface normal will be provided.
 bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
@@ -35,7 +292,9 @@ bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3&
     float bestDistance = std::numeric_limits<float>::max();
 
     if (_bounds.findRayIntersection(origin, direction, boxDistance, face, surfaceNormal)) {
-        if (precision) {
+        if (precision && hasBVH()) {
+            intersectedSomething = findBVHRayIntersection(origin, direction, distance, surfaceNormal);
+        } else if (precision) {
             for (const auto& triangle : _triangles) {
                 float thisTriangleDistance;
                 if (findRayTriangleIntersection(origin, direction, triangle, thisTriangleDistance)) {
@@ -56,6 +315,94 @@ bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3&
     return intersectedSomething;
 }
 
+void TriangleSet::findRayIntersections(const std::vector<glm::vec3>& origins, const std::vector<glm::vec3>& directions,
+                                       std::vector<RayIntersection>& intersections) const {
+    size_t numRays = std::min(origins.size(), directions.size());
+    intersections.assign(numRays, RayIntersection());
+
+    if (!hasBVH()) {
+        for (size_t i = 0; i < numRays; ++i) {
+            BoxFace face;
+            RayIntersection& intersection = intersections[i];
+            intersection.intersects = findRayIntersection(origins[i], directions[i], intersection.distance, face,
+                intersection.surfaceNormal, true);
+        }
+        return;
+    }
+
+    std::vector<glm::vec3> inverseDirections(numRays);
+    std::vector<float> bestDistances(numRays, FLT_MAX);
+    std::vector<const Triangle*> bestTriangles(numRays, nullptr);
+    for (size_t i = 0; i < numRays; ++i) {
+        inverseDirections[i] = 1.0f / directions[i];
+    }
+
+    // the rays still going down each node on the stack are a range of the active rays; the ranges of the nodes pushed
+    // later follow those of the nodes pushed before, so a node's range is the last one when it's popped
+    struct StackEntry {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+    };
+    std::vector<StackEntry> stack;
+    std::vector<uint32_t> activeRays;
+
+    auto pushNode = [&](uint32_t nodeIndex, uint32_t begin, uint32_t end) {
+        const BVHNode& node = _nodes[nodeIndex];
+        uint32_t childBegin = (uint32_t)activeRays.size();
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t ray = activeRays[i];
+            float entryDistance;
+            if (findRayBoxIntersection(origins[ray], inverseDirections[ray], node.minimum, node.maximum,
+                    bestDistances[ray], entryDistance)) {
+                activeRays.push_back(ray);
+            }
+        }
+        if ((uint32_t)activeRays.size() > childBegin) {
+            stack.push_back({ nodeIndex, childBegin, (uint32_t)activeRays.size() });
+        }
+    };
+
+    activeRays.reserve(numRays * 4);
+    for (uint32_t i = 0; i < (uint32_t)numRays; ++i) {
+        activeRays.push_back(i);
+    }
+    pushNode(0, 0, (uint32_t)numRays);
+
+    while (!stack.empty()) {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        activeRays.resize(entry.end);
+
+        const BVHNode& node = _nodes[entry.node];
+        if (node.count > 0) {
+            for (uint32_t i = entry.begin; i < entry.end; ++i) {
+                uint32_t ray = activeRays[i];
+                for (uint32_t t = node.start, end = node.start + node.count; t < end; ++t) {
+                    float triangleDistance;
+                    if (findRayTriangleIntersection(origins[ray], directions[ray], _triangles[t], triangleDistance) &&
+                            triangleDistance < bestDistances[ray]) {
+                        bestDistances[ray] = triangleDistance;
+                        bestTriangles[ray] = &_triangles[t];
+                    }
+                }
+            }
+            continue;
+        }
+
+        // the second child is pushed first, so the first one is walked first
+        pushNode(node.start, entry.begin, entry.end);
+        pushNode(entry.node + 1, entry.begin, entry.end);
+    }
+
+    for (size_t i = 0; i < numRays; ++i) {
+        if (bestTriangles[i]) {
+            intersections[i].intersects = true;
+            intersections[i].distance = bestDistances[i];
+            intersections[i].surfaceNormal = bestTriangles[i]->getNormal();
+        }
+    }
+}
 
 bool TriangleSet::convexHullContains(const glm::vec3& point) const {
     if (!_bounds.contains(point)) {
@@ -73,4 +420,3 @@ bool TriangleSet::convexHullContains(const glm::vec3& point) const {
     }
     return insideMesh;
 }
-
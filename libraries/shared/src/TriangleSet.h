@@ -9,6 +9,10 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#ifndef hifi_TriangleSet_h
+#define hifi_TriangleSet_h
+
+#include <cstdint>
 #include <vector>
 
 #include "AABox.h"
@@ -16,6 +20,13 @@
 
 class TriangleSet {
 public:
+    // the result of one of a batch of rays
+    struct RayIntersection {
+        bool intersects { false };
+        float distance { 0.0f };
+        glm::vec3 surfaceNormal;
+    };
+
     void reserve(size_t size) { _triangles.reserve(size); } // reserve space in the datastructure for size number of triangles
     size_t size() const { return _triangles.size(); } 
 
@@ -24,11 +35,22 @@ public:
     void insert(const Triangle& t);
     void clear();
 
+    // Build the bounding volume hierarchy the rays are tested against, once all of the triangles are inserted; until it
+    // is built (or after a triangle is inserted), every triangle is tested. This reorders the triangles.
+    // Not thread safe: the set is to be built before it's shared.
+    void buildBVH();
+    bool hasBVH() const { return !_nodes.empty(); }
+
     // Determine if the given ray (origin/direction) in model space intersects with any triangles in the set. If an 
     // intersection occurs, the distance and surface normal will be provided.
     bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, 
         float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision) const;
 
+    // The precise intersections of several rays at once, like those cast together by the hand controllers, that share
+    // the walk down the hierarchy as long as they go the same way.
+    void findRayIntersections(const std::vector<glm::vec3>& origins, const std::vector<glm::vec3>& directions,
+        std::vector<RayIntersection>& intersections) const;
+
     // Determine if a point is "inside" all the triangles of a convex hull. It is the responsibility of the caller to
     // determine that the triangle set is indeed a convex hull. If the triangles added to this set are not in fact a 
     // convex hull, the result of this method is meaningless and undetermined.
@@ -36,6 +58,24 @@ public:
     const AABox& getBounds() const { return _bounds; }
 
 private:
+    // A node of the hierarchy, in depth first order: an inner node's first child follows it, and start is the index of
+    // its second one; a leaf has the count triangles from start.
+    struct BVHNode {
+        glm::vec3 minimum;
+        uint32_t start;
+        glm::vec3 maximum;
+        uint32_t count;
+    };
+
+    struct BVHBuild;
+    void buildBVHNode(BVHBuild& build, uint32_t begin, uint32_t end, int depth);
+
+    bool findBVHRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance,
+        glm::vec3& surfaceNormal) const;
+
     std::vector<Triangle> _triangles;
+    std::vector<BVHNode> _nodes;
     AABox _bounds;
 };
+
+#endif // hifi_TriangleSet_h
@@ -11,6 +11,11 @@
 
 #include <algorithm>
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define VIEW_FRUSTUM_SSE
+#endif
+
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
@@ -280,6 +285,135 @@ bool ViewFrustum::boxIntersectsFrustum(const AABox& box) const {
     return true;
 }
 
+void AABoxArrays::resize(size_t size) {
+    cornerX.resize(size);
+    cornerY.resize(size);
+    cornerZ.resize(size);
+    scaleX.resize(size);
+    scaleY.resize(size);
+    scaleZ.resize(size);
+}
+
+void AABoxArrays::set(size_t index, const AABox& box) {
+    const glm::vec3& corner = box.getCorner();
+    const glm::vec3& scale = box.getScale();
+    cornerX[index] = corner.x;
+    cornerY[index] = corner.y;
+    cornerZ[index] = corner.z;
+    scaleX[index] = scale.x;
+    scaleY[index] = scale.y;
+    scaleZ[index] = scale.z;
+}
+
+#ifdef VIEW_FRUSTUM_SSE
+namespace {
+    // The planes of a frustum splatted for testing four boxes at a time, with the same farthest vertex and distance as
+    // boxIntersectsFrustum, computed in the same order
+    class FrustumPlanesSSE {
+    public:
+        FrustumPlanesSSE(const ::Plane* planes) {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 allOnes = _mm_cmpeq_ps(zero, zero);
+            for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+                const glm::vec3& normal = planes[p].getNormal();
+                normalX[p] = _mm_set1_ps(normal.x);
+                normalY[p] = _mm_set1_ps(normal.y);
+                normalZ[p] = _mm_set1_ps(normal.z);
+                positiveX[p] = normal.x > 0.0f ? allOnes : zero;
+                positiveY[p] = normal.y > 0.0f ? allOnes : zero;
+                positiveZ[p] = normal.z > 0.0f ? allOnes : zero;
+                dCoefficient[p] = _mm_set1_ps(planes[p].getDCoefficient());
+            }
+        }
+
+        // all ones in the lanes of the boxes that are behind any of the planes
+        __m128 outside(__m128 cornerX, __m128 cornerY, __m128 cornerZ,
+                       __m128 scaleX, __m128 scaleY, __m128 scaleZ) const {
+            const __m128 zero = _mm_setzero_ps();
+            __m128 result = zero;
+            for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+                __m128 farthestX = _mm_add_ps(cornerX, _mm_and_ps(scaleX, positiveX[p]));
+                __m128 farthestY = _mm_add_ps(cornerY, _mm_and_ps(scaleY, positiveY[p]));
+                __m128 farthestZ = _mm_add_ps(cornerZ, _mm_and_ps(scaleZ, positiveZ[p]));
+                __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX[p], farthestX), _mm_mul_ps(normalY[p], farthestY)),
+                                        _mm_mul_ps(normalZ[p], farthestZ));
+                __m128 distance = _mm_add_ps(dCoefficient[p], dot);
+                result = _mm_or_ps(result, _mm_cmplt_ps(distance, zero));
+            }
+            return result;
+        }
+
+    private:
+        __m128 normalX[NUM_FRUSTUM_PLANES], normalY[NUM_FRUSTUM_PLANES], normalZ[NUM_FRUSTUM_PLANES];
+        __m128 positiveX[NUM_FRUSTUM_PLANES], positiveY[NUM_FRUSTUM_PLANES], positiveZ[NUM_FRUSTUM_PLANES];
+        __m128 dCoefficient[NUM_FRUSTUM_PLANES];
+    };
+
+    void storeMask(int mask, uint8_t* results) {
+        results[0] = (mask & 0x1) ? 1 : 0;
+        results[1] = (mask & 0x2) ? 1 : 0;
+        results[2] = (mask & 0x4) ? 1 : 0;
+        results[3] = (mask & 0x8) ? 1 : 0;
+    }
+}
+#endif
+
+void ViewFrustum::boxesIntersectFrustum(const AABoxArrays& boxes, size_t begin, size_t end, uint8_t* inFrustum) const {
+    size_t i = begin;
+#ifdef VIEW_FRUSTUM_SSE
+    FrustumPlanesSSE planes(_planes);
+    for (; i + 4 <= end; i += 4) {
+        __m128 outside = planes.outside(_mm_loadu_ps(&boxes.cornerX[i]), _mm_loadu_ps(&boxes.cornerY[i]),
+                                        _mm_loadu_ps(&boxes.cornerZ[i]), _mm_loadu_ps(&boxes.scaleX[i]),
+                                        _mm_loadu_ps(&boxes.scaleY[i]), _mm_loadu_ps(&boxes.scaleZ[i]));
+        storeMask(~_mm_movemask_ps(outside), &inFrustum[i]);
+    }
+#endif
+    for (; i < end; i++) {
+        AABox box(glm::vec3(boxes.cornerX[i], boxes.cornerY[i], boxes.cornerZ[i]),
+                  glm::vec3(boxes.scaleX[i], boxes.scaleY[i], boxes.scaleZ[i]));
+        inFrustum[i] = boxIntersectsFrustum(box) ? 1 : 0;
+    }
+}
+
+void ViewFrustum::boxesIntersectKeyhole(const AABoxArrays& boxes, size_t begin, size_t end, uint8_t* inKeyhole) const {
+    size_t i = begin;
+#ifdef VIEW_FRUSTUM_SSE
+    FrustumPlanesSSE planes(_planes);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 centerX = _mm_set1_ps(_position.x);
+    const __m128 centerY = _mm_set1_ps(_position.y);
+    const __m128 centerZ = _mm_set1_ps(_position.z);
+    const __m128 radiusSquared = _mm_set1_ps(_centerSphereRadius * _centerSphereRadius);
+    for (; i + 4 <= end; i += 4) {
+        __m128 cornerX = _mm_loadu_ps(&boxes.cornerX[i]);
+        __m128 cornerY = _mm_loadu_ps(&boxes.cornerY[i]);
+        __m128 cornerZ = _mm_loadu_ps(&boxes.cornerZ[i]);
+        __m128 scaleX = _mm_loadu_ps(&boxes.scaleX[i]);
+        __m128 scaleY = _mm_loadu_ps(&boxes.scaleY[i]);
+        __m128 scaleZ = _mm_loadu_ps(&boxes.scaleZ[i]);
+
+        // as AABox::touchesSphere, the distance from the center of the sphere to the box
+        __m128 eX = _mm_add_ps(_mm_max_ps(_mm_sub_ps(cornerX, centerX), zero),
+                               _mm_max_ps(_mm_sub_ps(_mm_sub_ps(centerX, cornerX), scaleX), zero));
+        __m128 eY = _mm_add_ps(_mm_max_ps(_mm_sub_ps(cornerY, centerY), zero),
+                               _mm_max_ps(_mm_sub_ps(_mm_sub_ps(centerY, cornerY), scaleY), zero));
+        __m128 eZ = _mm_add_ps(_mm_max_ps(_mm_sub_ps(cornerZ, centerZ), zero),
+                               _mm_max_ps(_mm_sub_ps(_mm_sub_ps(centerZ, cornerZ), scaleZ), zero));
+        __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(eX, eX), _mm_mul_ps(eY, eY)), _mm_mul_ps(eZ, eZ));
+        __m128 touchesSphere = _mm_cmple_ps(distanceSquared, radiusSquared);
+
+        __m128 outside = planes.outside(cornerX, cornerY, cornerZ, scaleX, scaleY, scaleZ);
+        storeMask(_mm_movemask_ps(touchesSphere) | ~_mm_movemask_ps(outside), &inKeyhole[i]);
+    }
+#endif
+    for (; i < end; i++) {
+        AABox box(glm::vec3(boxes.cornerX[i], boxes.cornerY[i], boxes.cornerZ[i]),
+                  glm::vec3(boxes.scaleX[i], boxes.scaleY[i], boxes.scaleZ[i]));
+        inKeyhole[i] = boxIntersectsKeyhole(box) ? 1 : 0;
+    }
+}
+
 bool ViewFrustum::sphereIntersectsKeyhole(const glm::vec3& center, float radius) const {
     // check positive touch against central sphere
     if (glm::length(center - _position) <= (radius + _centerSphereRadius)) {
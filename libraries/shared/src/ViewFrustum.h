@@ -14,6 +14,8 @@
 #ifndef hifi_ViewFrustum_h
 #define hifi_ViewFrustum_h
 
+#include <vector>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -33,6 +35,17 @@ const float DEFAULT_ASPECT_RATIO = 16.0f/9.0f;
 const float DEFAULT_NEAR_CLIP = 0.08f;
 const float DEFAULT_FAR_CLIP = 16384.0f;
 
+// Boxes laid out as arrays of each coordinate of their corners and scales, for a frustum to test many at once
+class AABoxArrays {
+public:
+    size_t size() const { return cornerX.size(); }
+    void resize(size_t size);
+    void set(size_t index, const AABox& box);
+
+    std::vector<float> cornerX, cornerY, cornerZ;
+    std::vector<float> scaleX, scaleY, scaleZ;
+};
+
 // the "ViewFrustum" has a "keyhole" shape: a regular frustum for stuff that is "visible" with
 // a central sphere for stuff that is nearby (for physics simulation).
 
@@ -102,10 +115,14 @@ public:
     bool sphereIntersectsFrustum(const glm::vec3& center, float radius) const;
     bool cubeIntersectsFrustum(const AACube& box) const;
     bool boxIntersectsFrustum(const AABox& box) const;
+    // As boxIntersectsFrustum, for the boxes [begin, end): inFrustum[i] is 1 if box i intersects, 0 if not
+    void boxesIntersectFrustum(const AABoxArrays& boxes, size_t begin, size_t end, uint8_t* inFrustum) const;
 
     bool sphereIntersectsKeyhole(const glm::vec3& center, float radius) const;
     bool cubeIntersectsKeyhole(const AACube& cube) const;
     bool boxIntersectsKeyhole(const AABox& box) const;
+    // As boxIntersectsKeyhole, for the boxes [begin, end): inKeyhole[i] is 1 if box i intersects, 0 if not
+    void boxesIntersectKeyhole(const AABoxArrays& boxes, size_t begin, size_t end, uint8_t* inKeyhole) const;
 
     // some frustum comparisons
     bool matches(const ViewFrustum& compareTo, bool debug = false) const;
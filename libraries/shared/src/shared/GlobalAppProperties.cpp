@@ -20,6 +20,7 @@ namespace hifi { namespace properties {
     namespace gl {
         const char* BACKEND = "com.highfidelity.gl.backend";
         const char* MAKE_PROGRAM_CALLBACK = "com.highfidelity.gl.makeProgram";
+        const char* MAKE_PROGRAM_ASYNC_CALLBACK = "com.highfidelity.gl.makeProgramAsync";
         const char* PRIMARY_CONTEXT = "com.highfidelity.gl.primaryContext";
     }
 
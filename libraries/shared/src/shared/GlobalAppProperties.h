@@ -22,6 +22,7 @@ namespace hifi { namespace properties {
     namespace gl {
         extern const char* BACKEND;
         extern const char* MAKE_PROGRAM_CALLBACK;
+        extern const char* MAKE_PROGRAM_ASYNC_CALLBACK;
         extern const char* PRIMARY_CONTEXT;
     }
 
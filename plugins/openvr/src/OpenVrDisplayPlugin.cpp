@@ -632,6 +632,14 @@ void OpenVrDisplayPlugin::compositeLayers() {
     }
 }
 
+bool OpenVrDisplayPlugin::reprojectLastFrame() {
+    if (_threadedSubmit) {
+        // the submit thread keeps warping the last composite to the latest poses, so it has nothing to be redrawn
+        return true;
+    }
+    return Parent::reprojectLastFrame();
+}
+
 void OpenVrDisplayPlugin::hmdPresent() {
     PROFILE_RANGE_EX(render, __FUNCTION__, 0xff00ff00, (uint64_t)_currentFrame->frameIndex)
 
@@ -64,6 +64,8 @@ protected:
     void updatePresentPose() override;
 
     void compositeLayers() override;
+    bool reprojectLastFrame() override;
+    bool wantsReprojection() const override { return !_threadedSubmit && Parent::wantsReprojection(); }
     void hmdPresent() override;
     bool isHmdMounted() const override;
     void postPreview() override;
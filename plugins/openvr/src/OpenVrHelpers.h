@@ -9,6 +9,7 @@
 
 #include <openvr.h>
 #include <GLMHelpers.h>
+#include <NumericalConstants.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -66,17 +67,31 @@ struct PoseData {
     mat4 poses[vr::k_unMaxTrackedDeviceCount];
     vec3 linearVelocities[vr::k_unMaxTrackedDeviceCount];
     vec3 angularVelocities[vr::k_unMaxTrackedDeviceCount];
+    mat4 resetMat;
 
     PoseData() {
         memset(vrPoses, 0, sizeof(vr::TrackedDevicePose_t) * vr::k_unMaxTrackedDeviceCount);
     }
 
-    void update(const glm::mat4& resetMat) {
+    // predictionTime moves the poses along their velocities, for the poses sampled ahead of when they are shown
+    void update(const glm::mat4& resetMat, float predictionTime = 0.0f) {
+        this->resetMat = resetMat;
         for (int i = 0; i < vr::k_unMaxTrackedDeviceCount; i++) {
             if (!vrPoses[i].bPoseIsValid) {
                 continue;
             }
-            poses[i] = resetMat * toGlm(vrPoses[i].mDeviceToAbsoluteTracking);
+            mat4 pose = toGlm(vrPoses[i].mDeviceToAbsoluteTracking);
+            if (predictionTime > 0.0f) {
+                vec3 angularVelocity = toGlm(vrPoses[i].vAngularVelocity);
+                float angle = glm::length(angularVelocity) * predictionTime;
+                quat rotation = glm::quat_cast(pose);
+                if (angle > EPSILON) {
+                    rotation = glm::angleAxis(angle, glm::normalize(angularVelocity)) * rotation;
+                }
+                vec3 translation = vec3(pose[3]) + toGlm(vrPoses[i].vVelocity) * predictionTime;
+                pose = createMatFromQuatAndPos(rotation, translation);
+            }
+            poses[i] = resetMat * pose;
             linearVelocities[i] = transformVectorFast(resetMat, toGlm(vrPoses[i].vVelocity));
             angularVelocities[i] = transformVectorFast(resetMat, toGlm(vrPoses[i].vAngularVelocity));
         }
@@ -0,0 +1,83 @@
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "OpenVrPoseSampler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <SharedUtil.h>
+
+// the controllers are tracked at a few hundred Hz or more
+static const unsigned long SAMPLE_INTERVAL_USECS = 1000;
+// past that, extrapolating from the velocities is worse than showing a late pose
+static const float MAX_PREDICTION_TIME = 0.1f;
+static const float DEFAULT_DISPLAY_FREQUENCY = 90.0f;
+
+OpenVrPoseSampler::OpenVrPoseSampler(vr::IVRSystem* system) : _system(system) {
+    setObjectName("OpenVR Pose Sampler");
+    if (vr::VRCompositor()) {
+        // the same space the display plugin gets its poses in
+        _trackingSpace = vr::VRCompositor()->GetTrackingSpace();
+    }
+}
+
+void OpenVrPoseSampler::stop() {
+    _quit = true;
+    wait();
+}
+
+void OpenVrPoseSampler::run() {
+    while (!_quit) {
+        uint32_t sampleCount = _sampleCount.load(std::memory_order_relaxed);
+        Sample& sample = _ring[sampleCount % RING_SIZE];
+        sample.timestamp = usecTimestampNow();
+        _system->GetDeviceToAbsoluteTrackingPose(_trackingSpace, 0.0f, sample.poses, vr::k_unMaxTrackedDeviceCount);
+        _sampleCount.store(sampleCount + 1, std::memory_order_release);
+
+        QThread::usleep(SAMPLE_INTERVAL_USECS);
+    }
+}
+
+bool OpenVrPoseSampler::getPredictedPoses(uint64_t targetTime, const mat4& resetMat, PoseData& poseData) const {
+    Sample sample;
+    uint32_t sampleCount;
+    do {
+        sampleCount = _sampleCount.load(std::memory_order_acquire);
+        if (sampleCount == 0) {
+            return false;
+        }
+        sample = _ring[(sampleCount - 1) % RING_SIZE];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // the writer only reaches the slot that was read after writing all the others
+    } while (_sampleCount.load(std::memory_order_relaxed) - sampleCount >= RING_SIZE - 1);
+
+    memcpy(poseData.vrPoses, sample.poses, sizeof(sample.poses));
+    float predictionTime = 0.0f;
+    if (targetTime > sample.timestamp) {
+        predictionTime = std::min((float)(targetTime - sample.timestamp) / USECS_PER_SECOND, MAX_PREDICTION_TIME);
+    }
+    poseData.update(resetMat, predictionTime);
+    return true;
+}
+
+uint64_t OpenVrPoseSampler::getNextFrameDisplayTime() const {
+    float secondsSinceLastVsync { 0.0f };
+    uint64_t frameCounter { 0 };
+    _system->GetTimeSinceLastVsync(&secondsSinceLastVsync, &frameCounter);
+
+    float displayFrequency = _system->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float);
+    if (displayFrequency <= 0.0f) {
+        displayFrequency = DEFAULT_DISPLAY_FREQUENCY;
+    }
+    float frameDuration = 1.0f / displayFrequency;
+    float vsyncToPhotons = _system->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd,
+        vr::Prop_SecondsFromVsyncToPhotons_Float);
+
+    // the frame is rendered over the next display frame, and shown from the vsync after that
+    float secondsToPhotons = (frameDuration - secondsSinceLastVsync) + frameDuration + vsyncToPhotons;
+    return usecTimestampNow() + (uint64_t)(std::max(secondsToPhotons, 0.0f) * USECS_PER_SECOND);
+}
@@ -0,0 +1,49 @@
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <QtCore/QThread>
+
+#include "OpenVrHelpers.h"
+
+// Samples the poses of the tracked devices on a thread of its own, at about the rate they are tracked at
+//   The samples go into a ring that only the sampling thread writes, and that is read without locks: a reader copies
+//   the latest sample, then checks that the writer didn't come around to that slot meanwhile. The controllers get the
+//   poses predicted for when the frame being simulated is displayed, rather than those the display plugin got when it
+//   last presented, however late the frame is.
+class OpenVrPoseSampler : public QThread {
+public:
+    OpenVrPoseSampler(vr::IVRSystem* system);
+
+    void stop();
+
+    // the poses of the latest sample, predicted to the given time, returns false until there's a sample
+    bool getPredictedPoses(uint64_t targetTime, const mat4& resetMat, PoseData& poseData) const;
+
+    // when a frame the main thread begins simulating now will reach the display
+    uint64_t getNextFrameDisplayTime() const;
+
+protected:
+    void run() override;
+
+private:
+    struct Sample {
+        uint64_t timestamp { 0 };
+        vr::TrackedDevicePose_t poses[vr::k_unMaxTrackedDeviceCount];
+    };
+
+    static const uint32_t RING_SIZE = 32;
+
+    vr::IVRSystem* _system;
+    vr::ETrackingUniverseOrigin _trackingSpace { vr::TrackingUniverseStanding };
+    std::atomic<bool> _quit { false };
+    std::array<Sample, RING_SIZE> _ring;
+    std::atomic<uint32_t> _sampleCount { 0 };
+};
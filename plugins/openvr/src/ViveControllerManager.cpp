@@ -28,6 +28,7 @@
 #include <controllers/StandardControls.h>
 
 #include "OpenVrHelpers.h"
+#include "OpenVrPoseSampler.h"
 
 extern PoseData _nextSimPoseData;
 
@@ -116,6 +117,9 @@ bool ViveControllerManager::activate() {
     }
     */
 
+    _inputDevice->_poseSampler.reset(new OpenVrPoseSampler(_system));
+    _inputDevice->_poseSampler->start(QThread::HighPriority);
+
     // register with UserInputMapper
     auto userInputMapper = DependencyManager::get<controller::UserInputMapper>();
     userInputMapper->registerDevice(_inputDevice);
@@ -131,6 +135,11 @@ void ViveControllerManager::deactivate() {
     _container->removeMenuItem(MENU_NAME, RENDER_CONTROLLERS);
     _container->removeMenu(MENU_PATH);
 
+    if (_inputDevice->_poseSampler) {
+        _inputDevice->_poseSampler->stop();
+        _inputDevice->_poseSampler.reset();
+    }
+
     if (_system) {
         _container->makeRenderingContextCurrent();
         releaseOpenVrSystem();
@@ -239,10 +248,23 @@ void ViveControllerManager::pluginUpdate(float deltaTime, const controller::Inpu
     }
 }
 
+ViveControllerManager::InputDevice::InputDevice(vr::IVRSystem*& system) : controller::InputDevice("Vive"), _system(system) {
+}
+
+ViveControllerManager::InputDevice::~InputDevice() {
+}
+
 void ViveControllerManager::InputDevice::update(float deltaTime, const controller::InputCalibrationData& inputCalibrationData) {
     _poseStateMap.clear();
     _buttonPressedMap.clear();
 
+    // the poses are predicted for when this frame is displayed, from the latest sample of the sampling thread; until
+    // there's one, they are those the display plugin got for it
+    if (!_poseSampler ||
+        !_poseSampler->getPredictedPoses(_poseSampler->getNextFrameDisplayTime(), _nextSimPoseData.resetMat, _poseData)) {
+        _poseData = _nextSimPoseData;
+    }
+
     // While the keyboard is open, we defer strictly to the keyboard values
     if (isOpenVrKeyboardShown()) {
         _axisStateMap.clear();
@@ -282,12 +304,12 @@ void ViveControllerManager::InputDevice::handleHandController(float deltaTime, u
 
     if (_system->IsTrackedDeviceConnected(deviceIndex) &&
         _system->GetTrackedDeviceClass(deviceIndex) == vr::TrackedDeviceClass_Controller &&
-        _nextSimPoseData.vrPoses[deviceIndex].bPoseIsValid) {
+        _poseData.vrPoses[deviceIndex].bPoseIsValid) {
 
         // process pose
-        const mat4& mat = _nextSimPoseData.poses[deviceIndex];
-        const vec3 linearVelocity = _nextSimPoseData.linearVelocities[deviceIndex];
-        const vec3 angularVelocity = _nextSimPoseData.angularVelocities[deviceIndex];
+        const mat4& mat = _poseData.poses[deviceIndex];
+        const vec3 linearVelocity = _poseData.linearVelocities[deviceIndex];
+        const vec3 angularVelocity = _poseData.angularVelocities[deviceIndex];
         handlePoseEvent(deltaTime, inputCalibrationData, mat, linearVelocity, angularVelocity, isLeftHand);
 
         vr::VRControllerState_t controllerState = vr::VRControllerState_t();
@@ -431,7 +453,7 @@ void ViveControllerManager::InputDevice::hapticsHelper(float deltaTime, bool lef
 
     if (_system->IsTrackedDeviceConnected(deviceIndex) &&
         _system->GetTrackedDeviceClass(deviceIndex) == vr::TrackedDeviceClass_Controller &&
-        _nextSimPoseData.vrPoses[deviceIndex].bPoseIsValid) {
+        _poseData.vrPoses[deviceIndex].bPoseIsValid) {
         float strength = leftHand ? _leftHapticStrength : _rightHapticStrength;
         float duration = leftHand ? _leftHapticDuration : _rightHapticDuration;
 
@@ -24,6 +24,10 @@
 #include <RenderArgs.h>
 #include <render/Scene.h>
 
+#include "OpenVrHelpers.h"
+
+class OpenVrPoseSampler;
+
 namespace vr {
     class IVRSystem;
 }
@@ -50,7 +54,8 @@ public:
 private:
     class InputDevice : public controller::InputDevice {
     public:
-        InputDevice(vr::IVRSystem*& system) : controller::InputDevice("Vive"), _system(system) {}
+        InputDevice(vr::IVRSystem*& system);
+        ~InputDevice();
     private:
         // Device functions
         controller::Input::NamedVector getAvailableInputs() const override;
@@ -102,6 +107,8 @@ private:
 
         int _trackedControllers { 0 };
         vr::IVRSystem*& _system;
+        std::unique_ptr<OpenVrPoseSampler> _poseSampler;
+        PoseData _poseData; // the poses of this update
         float _leftHapticStrength { 0.0f };
         float _leftHapticDuration { 0.0f };
         float _rightHapticStrength { 0.0f };
@@ -0,0 +1,243 @@
+//
+//  OpusCodec.cpp
+//  plugins/opusCodec/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QDebug>
+
+#include <opus/opus.h>
+
+#include <AudioConstants.h>
+
+#include "OpusCodec.h"
+
+const char* OpusCodec::NAME { "opus" };
+
+// the largest packet of a frame, from the Opus spec
+static const int MAX_PACKET_BYTES = 1275;
+
+class OpusCodecEncoder : public Encoder {
+public:
+    OpusCodecEncoder(int sampleRate, int numChannels) : _sampleRate(sampleRate), _numChannels(numChannels) {
+        int error = OPUS_OK;
+        _encoder = opus_encoder_create(sampleRate, numChannels, OPUS_APPLICATION_AUDIO, &error);
+        if (error != OPUS_OK) {
+            qWarning() << "Failed to create the Opus encoder:" << opus_strerror(error);
+            _encoder = nullptr;
+        }
+        _repacketizer = opus_repacketizer_create();
+    }
+
+    virtual ~OpusCodecEncoder() {
+        if (_encoder) {
+            opus_encoder_destroy(_encoder);
+        }
+        if (_repacketizer) {
+            opus_repacketizer_destroy(_repacketizer);
+        }
+    }
+
+    bool isValid() const { return _encoder && _repacketizer; }
+    bool isCompatible(int sampleRate, int numChannels) const {
+        return _sampleRate == sampleRate && _numChannels == numChannels;
+    }
+
+    // for a stream that starts over, with the settings of now
+    void reset(const OpusEncoderSettings& settings) {
+        opus_encoder_ctl(_encoder, OPUS_RESET_STATE);
+
+        opus_encoder_ctl(_encoder, OPUS_SET_COMPLEXITY(settings.complexity));
+        opus_encoder_ctl(_encoder, OPUS_SET_BITRATE(settings.bitrate));
+        _frameSamples = (int)(_sampleRate * settings.frameSizeMsecs / 1000.0f);
+
+        // the frames of a network frame are sent as one packet, which the frames of other bandwidths can't join;
+        // the frames shorter than 10 msecs are all of the same mode, so only the bandwidth has to be held
+        opus_encoder_ctl(_encoder, OPUS_SET_BANDWIDTH(_frameSamples < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL ?
+            OPUS_BANDWIDTH_SUPERWIDEBAND : OPUS_AUTO));
+    }
+
+    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
+        const opus_int16* samples = (const opus_int16*)decodedBuffer.constData();
+        int numFrames = decodedBuffer.size() / (int)(sizeof(opus_int16) * _numChannels);
+
+        int frameSamples = _frameSamples;
+        if (frameSamples <= 0 || frameSamples >= numFrames || numFrames % frameSamples != 0) {
+            frameSamples = numFrames;
+        }
+        int numPackets = numFrames / frameSamples;
+
+        if (numPackets == 1) {
+            encodedBuffer.resize(MAX_PACKET_BYTES);
+            int packetBytes = opus_encode(_encoder, samples, numFrames, (unsigned char*)encodedBuffer.data(), MAX_PACKET_BYTES);
+            encodedBuffer.resize(std::max(packetBytes, 0));
+            return;
+        }
+
+        // the repacketizer keeps pointers into the packets until they are out
+        _packets.resize(numPackets * MAX_PACKET_BYTES);
+        opus_repacketizer_init(_repacketizer);
+        for (int i = 0; i < numPackets; ++i) {
+            unsigned char* packet = _packets.data() + i * MAX_PACKET_BYTES;
+            int packetBytes = opus_encode(_encoder, samples + i * frameSamples * _numChannels, frameSamples,
+                packet, MAX_PACKET_BYTES);
+            if (packetBytes < 0 || opus_repacketizer_cat(_repacketizer, packet, packetBytes) != OPUS_OK) {
+                // the frame doesn't fit with the others, so the network frame goes as a single one instead
+                encodedBuffer.resize(MAX_PACKET_BYTES);
+                packetBytes = opus_encode(_encoder, samples, numFrames, (unsigned char*)encodedBuffer.data(), MAX_PACKET_BYTES);
+                encodedBuffer.resize(std::max(packetBytes, 0));
+                return;
+            }
+        }
+
+        int maxBytes = numPackets * MAX_PACKET_BYTES;
+        encodedBuffer.resize(maxBytes);
+        int packetBytes = opus_repacketizer_out(_repacketizer, (unsigned char*)encodedBuffer.data(), maxBytes);
+        encodedBuffer.resize(std::max(packetBytes, 0));
+    }
+
+private:
+    const int _sampleRate;
+    const int _numChannels;
+    int _frameSamples { 0 };
+
+    OpusEncoder* _encoder { nullptr };
+    OpusRepacketizer* _repacketizer { nullptr };
+    std::vector<unsigned char> _packets;
+};
+
+class OpusCodecDecoder : public Decoder {
+public:
+    OpusCodecDecoder(int sampleRate, int numChannels) {
+        _decodedSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * sizeof(opus_int16) * numChannels;
+
+        int error = OPUS_OK;
+        _decoder = opus_decoder_create(sampleRate, numChannels, &error);
+        if (error != OPUS_OK) {
+            qWarning() << "Failed to create the Opus decoder:" << opus_strerror(error);
+            _decoder = nullptr;
+        }
+    }
+
+    virtual ~OpusCodecDecoder() {
+        if (_decoder) {
+            opus_decoder_destroy(_decoder);
+        }
+    }
+
+    bool isValid() const { return _decoder != nullptr; }
+
+    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
+        decodedBuffer.resize(_decodedSize);
+        int decodedFrames = opus_decode(_decoder, (const unsigned char*)encodedBuffer.constData(), encodedBuffer.size(),
+            (opus_int16*)decodedBuffer.data(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, 0);
+        if (decodedFrames < 0) {
+            lostFrame(decodedBuffer);
+        }
+    }
+
+    virtual void lostFrame(QByteArray& decodedBuffer) override {
+        decodedBuffer.resize(_decodedSize);
+        // this performs packet loss concealment
+        int decodedFrames = opus_decode(_decoder, nullptr, 0, (opus_int16*)decodedBuffer.data(),
+            AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, 0);
+        if (decodedFrames < 0) {
+            memset(decodedBuffer.data(), 0, decodedBuffer.size());
+        }
+    }
+
+private:
+    int _decodedSize;
+    OpusDecoder* _decoder { nullptr };
+};
+
+OpusCodec::~OpusCodec() {
+}
+
+void OpusCodec::init() {
+}
+
+void OpusCodec::deinit() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _encoderPool.clear();
+}
+
+bool OpusCodec::activate() {
+    CodecPlugin::activate();
+    return true;
+}
+
+void OpusCodec::deactivate() {
+    CodecPlugin::deactivate();
+}
+
+bool OpusCodec::isSupported() const {
+    return true;
+}
+
+void OpusCodec::configure(const QVariantMap& settings) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (settings.contains("complexity")) {
+        _settings.complexity = std::min(std::max(settings["complexity"].toInt(), 0), 10);
+    }
+    if (settings.contains("bitrate")) {
+        _settings.bitrate = std::min(std::max(settings["bitrate"].toInt(), 6000), 510000);
+    }
+    if (settings.contains("frameSizeMsecs")) {
+        float frameSizeMsecs = settings["frameSizeMsecs"].toFloat();
+        if (frameSizeMsecs == 2.5f || frameSizeMsecs == 5.0f || frameSizeMsecs == 10.0f) {
+            _settings.frameSizeMsecs = frameSizeMsecs;
+        } else {
+            qWarning() << "Ignoring the Opus frame size of" << frameSizeMsecs << "msecs, it can be 2.5, 5 or 10";
+        }
+    }
+}
+
+Encoder* OpusCodec::createEncoder(int sampleRate, int numChannels) {
+    std::unique_ptr<OpusCodecEncoder> encoder;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = std::find_if(_encoderPool.begin(), _encoderPool.end(), [&](const std::unique_ptr<OpusCodecEncoder>& pooled) {
+        return pooled->isCompatible(sampleRate, numChannels);
+    });
+    if (it != _encoderPool.end()) {
+        encoder = std::move(*it);
+        _encoderPool.erase(it);
+    } else {
+        encoder.reset(new OpusCodecEncoder(sampleRate, numChannels));
+        if (!encoder->isValid()) {
+            return nullptr;
+        }
+    }
+
+    encoder->reset(_settings);
+    return encoder.release();
+}
+
+Decoder* OpusCodec::createDecoder(int sampleRate, int numChannels) {
+    auto decoder = new OpusCodecDecoder(sampleRate, numChannels);
+    if (!decoder->isValid()) {
+        delete decoder;
+        return nullptr;
+    }
+    return decoder;
+}
+
+void OpusCodec::releaseEncoder(Encoder* encoder) {
+    if (!encoder) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _encoderPool.emplace_back(static_cast<OpusCodecEncoder*>(encoder));
+}
+
+void OpusCodec::releaseDecoder(Decoder* decoder) {
+    delete decoder;
+}
@@ -0,0 +1,65 @@
+//
+//  OpusCodec.h
+//  plugins/opusCodec/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OpusCodec_h
+#define hifi_OpusCodec_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <plugins/CodecPlugin.h>
+
+class OpusCodecEncoder;
+
+// The settings a deployment can give the encoders, through the audio mixer's settings
+struct OpusEncoderSettings {
+    int complexity { 5 }; // 0 to 10, the CPU spent for the quality at a bitrate
+    int bitrate { 64000 }; // in bits per second, for all of the channels
+    float frameSizeMsecs { 10.0f }; // 2.5, 5 or 10, the shorter the lower the latency, and the higher the bitrate
+};
+
+// The Opus codec, with the encoders that are released kept in a pool for the next ones
+//   The mixer makes an encoder for each listener that connects, and drops it when the listener leaves; the pooled
+//   encoders are reset and given the current settings instead of being made anew.
+class OpusCodec : public CodecPlugin {
+    Q_OBJECT
+
+public:
+    virtual ~OpusCodec();
+
+    // Plugin functions
+    bool isSupported() const override;
+    const QString getName() const override { return NAME; }
+
+    void init() override;
+    void deinit() override;
+
+    /// Called when a plugin is being activated for use.  May be called multiple times.
+    bool activate() override;
+    /// Called when a plugin is no longer being used.  May be called multiple times.
+    void deactivate() override;
+
+    virtual Encoder* createEncoder(int sampleRate, int numChannels) override;
+    virtual Decoder* createDecoder(int sampleRate, int numChannels) override;
+    virtual void releaseEncoder(Encoder* encoder) override;
+    virtual void releaseDecoder(Decoder* decoder) override;
+
+    virtual void configure(const QVariantMap& settings) override;
+
+private:
+    static const char* NAME;
+
+    std::mutex _mutex;
+    OpusEncoderSettings _settings;
+    std::vector<std::unique_ptr<OpusCodecEncoder>> _encoderPool;
+};
+
+#endif // hifi_OpusCodec_h
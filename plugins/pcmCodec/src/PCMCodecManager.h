@@ -76,6 +76,8 @@ public:
         encodedBuffer = qCompress(decodedBuffer);
     }
 
+    virtual bool isShareable() const override { return true; }
+
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
         decodedBuffer = qUncompress(encodedBuffer);
     }
@@ -52,14 +52,8 @@ Column {
                     MovingValue { label: "Network (down)"; source: AudioStats.pingMs / 2; showGraphs: stats.showGraphs; decimals: 1 }
                     MovingValue { label: "Output Ring"; source: AudioStats.clientStream.unplayedMsMax; showGraphs: stats.showGraphs }
                     MovingValue { label: "Output Read"; source: AudioStats.outputUnplayedMsMax; showGraphs: stats.showGraphs }
-                    MovingValue { label: "TOTAL"; color: "black"; showGraphs: stats.showGraphs
-                        source: AudioStats.inputReadMsMax +
-                            AudioStats.inputUnplayedMsMax +
-                            AudioStats.outputUnplayedMsMax +
-                            AudioStats.mixerStream.unplayedMsMax +
-                            AudioStats.clientStream.unplayedMsMax +
-                            AudioStats.pingMs
-                    }
+                    MovingValue { label: "TOTAL"; color: "black"; source: AudioStats.mouthToEarMs; showGraphs: stats.showGraphs }
+                    MovingValue { label: "Device Jitter"; source: AudioStats.outputCallbackJitterMsMax; showGraphs: stats.showGraphs; decimals: 1 }
                 }
             }
 
@@ -0,0 +1,95 @@
+//
+//  BenchmarkUtils.h
+//  tests/
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BenchmarkUtils_h
+#define hifi_BenchmarkUtils_h
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+// Shared by the benchmark testcases, which are configured through the environment and write what they measure as
+// JSON to the path in their HIFI_<NAME>_BENCHMARK_JSON variable, and by the perf-suite that runs them.
+namespace benchmark {
+
+// the variables the perf-suite names the JSON output of each benchmark by
+const char* const HRTF_BENCHMARK_JSON = "HIFI_HRTF_BENCHMARK_JSON";
+const char* const AVATAR_BENCHMARK_JSON = "HIFI_AVATAR_BENCHMARK_JSON";
+const char* const ENTITY_BENCHMARK_JSON = "HIFI_ENTITY_BENCHMARK_JSON";
+const char* const ANIM_BENCHMARK_JSON = "HIFI_ANIM_BENCHMARK_JSON";
+const char* const PHYSICS_BENCHMARK_JSON = "HIFI_PHYSICS_BENCHMARK_JSON";
+const char* const TEXTURE_BENCHMARK_JSON = "HIFI_TEXTURE_BENCHMARK_JSON";
+const char* const UDT_BENCHMARK_JSON = "HIFI_UDT_BENCHMARK_JSON";
+
+inline int intFromEnvironment(const char* name, int defaultValue) {
+    bool ok = false;
+    int value = qgetenv(name).toInt(&ok);
+    return ok ? value : defaultValue;
+}
+
+// a comma separated list of counts, each at least 1, or defaultValues when the variable isn't set
+inline QVector<int> countsFromEnvironment(const char* name, const QVector<int>& defaultValues) {
+    QString counts = QString::fromLocal8Bit(qgetenv(name));
+    if (counts.isEmpty()) {
+        return defaultValues;
+    }
+    QVector<int> values;
+    for (const auto& count : counts.split(',', QString::SkipEmptyParts)) {
+        values.push_back(std::max(1, count.trimmed().toInt()));
+    }
+    return values;
+}
+
+// of values sorted from the smallest, 0 for none
+inline double percentile(const std::vector<quint64>& sortedValues, double fraction) {
+    if (sortedValues.empty()) {
+        return 0.0;
+    }
+    auto index = std::min(sortedValues.size() - 1, (size_t)(fraction * sortedValues.size()));
+    return (double)sortedValues[index];
+}
+
+// The results of a benchmark, logged as they are added and written as the "results" of a JSON object, along with
+// the settings of the run, to the path in the benchmark's variable when it is set.
+class BenchmarkResults {
+public:
+    BenchmarkResults(const char* jsonVariable) : _jsonOutputPath(QString::fromLocal8Bit(qgetenv(jsonVariable))) { }
+
+    void add(const QJsonObject& result) {
+        qDebug().noquote() << QJsonDocument(result).toJson(QJsonDocument::Compact);
+        _results.append(result);
+    }
+
+    // returns false if the results could not be written
+    bool write(QJsonObject root) const {
+        if (_jsonOutputPath.isEmpty()) {
+            return true;
+        }
+        root["results"] = _results;
+
+        QFile file(_jsonOutputPath);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(QJsonDocument(root).toJson()) >= 0;
+    }
+
+private:
+    QString _jsonOutputPath;
+    QJsonArray _results;
+};
+
+}
+
+#endif // hifi_BenchmarkUtils_h
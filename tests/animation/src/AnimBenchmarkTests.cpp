@@ -0,0 +1,227 @@
+//
+//  AnimBenchmarkTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimBenchmarkTests.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <AnimationCache.h>
+#include <FBXReader.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <PerfStat.h>
+#include <ResourceCache.h>
+#include <ResourceManager.h>
+#include <Rig.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AnimBenchmarkTests)
+
+using namespace benchmark;
+
+namespace {
+    const float FRAME_DT = 1.0f / 90.0f; // seconds
+    const int RIG_PHASE_FRAMES = 37; // how much further along the recorded walk each rig is than the last
+    const int LOAD_TIMEOUT_MSECS = (int)(30 * MSECS_PER_SECOND);
+
+    bool waitUntil(std::function<bool()> condition, int timeoutMsecs) {
+        QElapsedTimer timer;
+        timer.start();
+        while (!condition()) {
+            if (timer.elapsed() > timeoutMsecs) {
+                return false;
+            }
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            QThread::msleep(1);
+        }
+        return true;
+    }
+
+    // what MyAvatar would hand the Rig in a frame
+    struct RecordedInput {
+        glm::vec3 position;
+        glm::vec3 velocity;
+        glm::quat rotation;
+        glm::quat headRotation;
+    };
+
+    // a walk through the states of the graph's locomotion, at the rate of the frames
+    std::vector<RecordedInput> recordWalk() {
+        struct Segment {
+            float duration; // seconds
+            float forwardSpeed; // meters per second
+            float lateralSpeed; // meters per second, positive to the right
+            float turnRate; // degrees per second, positive to the left
+        };
+        const Segment SEGMENTS[] = {
+            { 2.0f, 0.0f, 0.0f, 0.0f },     // idle
+            { 3.0f, 1.4f, 0.0f, 0.0f },     // walk
+            { 2.0f, 1.4f, 0.0f, 45.0f },    // walk around a corner
+            { 2.0f, 0.0f, 1.0f, 0.0f },     // strafe right
+            { 2.0f, 0.0f, -1.0f, 0.0f },    // strafe left
+            { 2.0f, -1.0f, 0.0f, 0.0f },    // walk backward
+            { 1.5f, 0.0f, 0.0f, -90.0f },   // turn in place
+            { 2.0f, 4.5f, 0.0f, 0.0f },     // run
+            { 1.0f, 0.0f, 0.0f, 0.0f }      // idle
+        };
+
+        std::vector<RecordedInput> inputs;
+        glm::vec3 position;
+        float yaw = 0.0f;
+        float time = 0.0f;
+        for (const auto& segment : SEGMENTS) {
+            int numFrames = (int)(segment.duration / FRAME_DT);
+            for (int i = 0; i < numFrames; ++i) {
+                yaw += glm::radians(segment.turnRate) * FRAME_DT;
+                glm::quat rotation = glm::angleAxis(yaw, Vectors::UNIT_Y);
+                glm::vec3 localVelocity(segment.lateralSpeed, 0.0f, -segment.forwardSpeed);
+                glm::vec3 velocity = rotation * localVelocity;
+                position += velocity * FRAME_DT;
+                time += FRAME_DT;
+
+                // the head looks around a little, as a desktop user's mouse would have it
+                glm::quat headRotation = glm::angleAxis(0.3f * sinf(0.5f * time), Vectors::UNIT_Y) *
+                    glm::angleAxis(0.1f * sinf(0.8f * time), Vectors::UNIT_X);
+                inputs.push_back({ position, velocity, rotation, headRotation });
+            }
+        }
+        return inputs;
+    }
+}
+
+void AnimBenchmarkTests::initTestCase() {
+    ResourceManager::init();
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+
+    _numRigs = countsFromEnvironment("HIFI_ANIM_BENCHMARK_RIGS", _numRigs);
+    _numFrames = std::max(1, intFromEnvironment("HIFI_ANIM_BENCHMARK_FRAMES", _numFrames));
+
+    QString graphUrl = QString::fromLocal8Bit(qgetenv("HIFI_ANIM_BENCHMARK_GRAPH"));
+    if (graphUrl.isEmpty()) {
+        _graphUrl = QUrl::fromLocalFile(QFINDTESTDATA("../../../interface/resources/avatar/avatar-animation.json"));
+    } else {
+        _graphUrl = QUrl::fromUserInput(graphUrl);
+    }
+    _skeletonPath = QString::fromLocal8Bit(qgetenv("HIFI_ANIM_BENCHMARK_SKELETON"));
+    if (_skeletonPath.isEmpty()) {
+        _skeletonPath = QFINDTESTDATA("../../../interface/resources/meshes/being_of_light/being_of_light.fbx");
+    }
+    _profileNodes = !qgetenv("HIFI_ANIM_BENCHMARK_NODES").isEmpty();
+}
+
+void AnimBenchmarkTests::updateRigsBenchmark() {
+    QFile skeletonFile(_skeletonPath);
+    QVERIFY2(skeletonFile.open(QIODevice::ReadOnly), "could not open the skeleton's FBX");
+    std::unique_ptr<FBXGeometry> geometry(readFBX(skeletonFile.readAll(), QVariantHash(), _skeletonPath));
+    QVERIFY((bool)geometry);
+
+    std::vector<RecordedInput> inputs = recordWalk();
+
+    for (int numRigs : _numRigs) {
+        std::vector<RigPointer> rigs;
+        int numGraphsLoaded = 0;
+        for (int i = 0; i < numRigs; ++i) {
+            auto rig = std::make_shared<Rig>();
+            rig->initJointStates(*geometry, glm::mat4());
+            connect(rig.get(), &Rig::onLoadComplete, [&] { ++numGraphsLoaded; });
+            rig->initAnimGraph(_graphUrl);
+            rigs.push_back(rig);
+        }
+
+        // the clips are shared by the rigs, which are all ready once the cache has every one of them
+        auto animationCache = DependencyManager::get<AnimationCache>();
+        bool loaded = waitUntil([&] {
+            if (numGraphsLoaded < numRigs) {
+                return false;
+            }
+            for (const auto& url : animationCache->getResourceList()) {
+                AnimationPointer animation = animationCache->getAnimation(url.toUrl());
+                if (animation && !animation->isLoaded() && !animation->isFailed()) {
+                    return false;
+                }
+            }
+            return true;
+        }, LOAD_TIMEOUT_MSECS);
+        QVERIFY2(loaded, "the anim graph and its clips did not load in time");
+
+        int neckJointIndex = rigs[0]->indexOfJoint("Neck");
+        const glm::mat4 rootTransform;
+
+        PerformanceTimer::setActive(_profileNodes);
+        std::vector<quint64> frameTimes;
+        frameTimes.reserve(_numFrames);
+        for (int frame = 0; frame < _numFrames; ++frame) {
+            quint64 frameStart = usecTimestampNow();
+            for (int i = 0; i < numRigs; ++i) {
+                const RecordedInput& input = inputs[(frame + i * RIG_PHASE_FRAMES) % inputs.size()];
+                Rig::HeadParameters headParams;
+                headParams.rigHeadOrientation = input.headRotation;
+                headParams.worldHeadOrientation = input.rotation * input.headRotation;
+                headParams.neckJointIndex = neckJointIndex;
+
+                auto& rig = rigs[i];
+                rig->computeMotionAnimationState(FRAME_DT, input.position, input.velocity, input.rotation,
+                    Rig::CharacterControllerState::Ground);
+                rig->updateFromHeadParameters(headParams, FRAME_DT);
+                rig->updateAnimations(FRAME_DT, rootTransform);
+            }
+            frameTimes.push_back(usecTimestampNow() - frameStart);
+            if (_profileNodes) {
+                PerformanceTimer::tallyAllTimerRecords();
+            }
+        }
+
+        quint64 totalFrameTime = 0;
+        for (auto frameTime : frameTimes) {
+            totalFrameTime += frameTime;
+        }
+        std::sort(frameTimes.begin(), frameTimes.end());
+
+        QJsonObject result;
+        result["rigs"] = numRigs;
+        result["frames"] = _numFrames;
+        result["joints"] = rigs[0]->getJointStateCount();
+        result["meanUsecsPerRigFrame"] = (double)totalFrameTime / (double)(_numFrames * numRigs);
+        result["p50UsecsPerRigFrame"] = percentile(frameTimes, 0.50) / numRigs;
+        result["p99UsecsPerRigFrame"] = percentile(frameTimes, 0.99) / numRigs;
+        result["p99FrameMsecs"] = percentile(frameTimes, 0.99) / USECS_PER_MSEC;
+        if (_profileNodes) {
+            // the timers nest, so the nodes are named by their path down the graph
+            QJsonObject nodes;
+            const auto& records = PerformanceTimer::getAllTimerRecords();
+            for (auto record = records.begin(); record != records.end(); ++record) {
+                nodes[record.key()] = (double)record.value().getAverage() / numRigs;
+            }
+            result["nodeUsecsPerRigFrame"] = nodes;
+            PerformanceTimer::setActive(false);
+        }
+        _results.add(result);
+
+        QCOMPARE(rigs[0]->getJointStateCount(), geometry->joints.size());
+    }
+}
+
+void AnimBenchmarkTests::cleanupTestCase() {
+    DependencyManager::destroy<AnimationCache>();
+    ResourceManager::cleanup();
+
+    QJsonObject root;
+    root["frames"] = _numFrames;
+    root["graph"] = _graphUrl.toString();
+    QVERIFY2(_results.write(root), "could not write the JSON output file");
+}
@@ -0,0 +1,44 @@
+//
+//  AnimBenchmarkTests.h
+//  tests/animation/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimBenchmarkTests_h
+#define hifi_AnimBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <../BenchmarkUtils.h>
+
+// Cost of updating the animations of Rigs running the default avatar-animation.json graph on the being of light
+// skeleton, all driven through the same recorded walk of idling, walking, strafing, turning and running, each rig
+// a little further along it than the last.  Configured through the environment:
+//   HIFI_ANIM_BENCHMARK_RIGS        comma separated numbers of rigs updated per frame (default 1,10,50)
+//   HIFI_ANIM_BENCHMARK_FRAMES      frames updated per number of rigs, at 90 Hz of animation time (default 900)
+//   HIFI_ANIM_BENCHMARK_GRAPH       url of the anim graph (default the interface's avatar-animation.json)
+//   HIFI_ANIM_BENCHMARK_SKELETON    path to the FBX of the skeleton (default the interface's being_of_light.fbx)
+//   HIFI_ANIM_BENCHMARK_NODES       when set, also reports the time of every node of the graph, which slows the rest
+//   HIFI_ANIM_BENCHMARK_JSON        path to write the results to as JSON (default is log output only)
+class AnimBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void updateRigsBenchmark();
+    void cleanupTestCase();
+
+private:
+    QVector<int> _numRigs { 1, 10, 50 };
+    int _numFrames { 900 };
+    QUrl _graphUrl;
+    QString _skeletonPath;
+    bool _profileNodes { false };
+
+    benchmark::BenchmarkResults _results { benchmark::ANIM_BENCHMARK_JSON };
+};
+
+#endif // hifi_AnimBenchmarkTests_h
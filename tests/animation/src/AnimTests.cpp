@@ -422,6 +422,66 @@ void AnimTests::testAnimPose() {
     }
 }
 
+void AnimTests::testAnimPoseCompose() {
+    const float PI = (float)M_PI;
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_30 = glm::angleAxis(PI / 6.0f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+    std::vector<glm::vec3> scaleVec = {
+        glm::vec3(1.0f),
+        glm::vec3(2.0f),
+        glm::vec3(-0.5f),
+        glm::vec3(2.0f, 0.5f, 1.5f)
+    };
+
+    const float EPSILON = 0.001f;
+
+    for (auto& scaleA : scaleVec) {
+        for (auto& scaleB : scaleVec) {
+            AnimPose poseA(scaleA, ROT_X_90, glm::vec3(1.0f, 2.0f, 3.0f));
+            AnimPose poseB(scaleB, ROT_Y_30 * ROT_X_90, glm::vec3(-4.0f, 0.5f, 2.0f));
+
+            // the products and inverses of the parts must match those of the matrices
+            glm::mat4 matA = poseA;
+            glm::mat4 matB = poseB;
+            glm::mat4 productMat = poseA * poseB;
+            QCOMPARE_WITH_ABS_ERROR(matA * matB, productMat, EPSILON);
+
+            glm::mat4 inverseMat = poseA.inverse();
+            QCOMPARE_WITH_ABS_ERROR(glm::inverse(matA), inverseMat, EPSILON);
+        }
+    }
+}
+
+void AnimTests::testBlend() {
+    const float PI = (float)M_PI;
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const float EPSILON = 0.001f;
+
+    std::vector<AnimPose> a = {
+        AnimPose(glm::vec3(1.0f), glm::quat(), glm::vec3(0.0f)),
+        AnimPose(glm::vec3(1.0f), ROT_X_90, glm::vec3(2.0f, 0.0f, 0.0f))
+    };
+    // the second rotation is ROT_X_90 on the far side of the hypersphere, which must blend the short way
+    std::vector<AnimPose> b = {
+        AnimPose(glm::vec3(3.0f), ROT_X_90, glm::vec3(4.0f, 2.0f, 0.0f)),
+        AnimPose(glm::vec3(1.0f), -ROT_X_90, glm::vec3(2.0f, 0.0f, 0.0f))
+    };
+    std::vector<AnimPose> result(a.size());
+
+    ::blend(a.size(), &a[0], &b[0], 0.5f, &result[0]);
+    QVERIFY(glm::distance(result[0].scale(), glm::vec3(2.0f)) < EPSILON);
+    QVERIFY(fabsf(glm::dot(result[0].rot(), glm::angleAxis(PI / 4.0f, glm::vec3(1.0f, 0.0f, 0.0f)))) > 1.0f - EPSILON);
+    QVERIFY(glm::distance(result[0].trans(), glm::vec3(2.0f, 1.0f, 0.0f)) < EPSILON);
+    QVERIFY(fabsf(glm::dot(result[1].rot(), ROT_X_90)) > 1.0f - EPSILON);
+    QVERIFY(glm::length(result[1].rot()) > 1.0f - EPSILON);
+
+    // the ends of the blend are copies, also into the poses being blended
+    ::blend(a.size(), &a[0], &b[0], 1.0f, &a[0]);
+    QVERIFY(a[0].trans() == b[0].trans());
+    QVERIFY(a[1].rot() == b[1].rot());
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
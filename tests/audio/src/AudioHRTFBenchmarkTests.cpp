@@ -0,0 +1,112 @@
+//
+//  AudioHRTFBenchmarkTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFBenchmarkTests.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AudioHRTFBenchmarkTests)
+
+using namespace benchmark;
+
+namespace {
+    const float MAX_SOURCE_DISTANCE = 20.0f; // meters
+    const float AZIMUTH_STEP = 0.02f; // radians a source moves around the listener per block
+}
+
+void AudioHRTFBenchmarkTests::initTestCase() {
+    _numSources = countsFromEnvironment("HIFI_HRTF_BENCHMARK_SOURCES", _numSources);
+    _numBlocks = std::max(1, intFromEnvironment("HIFI_HRTF_BENCHMARK_BLOCKS", _numBlocks));
+}
+
+void AudioHRTFBenchmarkTests::renderSourcesBenchmark() {
+    std::mt19937 generator { 240 }; // fixed seed so runs mix the same audio
+    std::uniform_int_distribution<int> sampleDistribution { -8192, 8191 };
+    std::uniform_real_distribution<float> unitDistribution { 0.0f, 1.0f };
+
+    for (int numSources : _numSources) {
+        std::vector<std::unique_ptr<AudioHRTF>> hrtfs;
+        std::vector<std::vector<int16_t>> sourceSamples;
+        std::vector<float> azimuths;
+        std::vector<float> distances;
+        std::vector<float> gains;
+        for (int i = 0; i < numSources; ++i) {
+            hrtfs.emplace_back(new AudioHRTF());
+            std::vector<int16_t> samples(HRTF_BLOCK);
+            for (auto& sample : samples) {
+                sample = (int16_t)sampleDistribution(generator);
+            }
+            sourceSamples.push_back(samples);
+            azimuths.push_back(TWO_PI * unitDistribution(generator) - PI);
+            distances.push_back(1.0f + (MAX_SOURCE_DISTANCE - 1.0f) * unitDistribution(generator));
+            gains.push_back(1.0f / distances.back());
+        }
+
+        std::vector<float> mix(AudioConstants::STEREO * HRTF_BLOCK);
+        std::vector<quint64> blockTimes;
+        blockTimes.reserve(_numBlocks);
+        quint64 totalBlockTime = 0;
+
+        for (int block = 0; block < _numBlocks; ++block) {
+            // every source circles the listener, so that each block interpolates to a new azimuth
+            for (int i = 0; i < numSources; ++i) {
+                azimuths[i] += (i % 2 ? AZIMUTH_STEP : -AZIMUTH_STEP);
+                if (azimuths[i] > PI) {
+                    azimuths[i] -= TWO_PI;
+                } else if (azimuths[i] < -PI) {
+                    azimuths[i] += TWO_PI;
+                }
+            }
+            std::fill(mix.begin(), mix.end(), 0.0f);
+
+            quint64 blockStart = usecTimestampNow();
+            for (int i = 0; i < numSources; ++i) {
+                hrtfs[i]->render(sourceSamples[i].data(), mix.data(), 0, azimuths[i], distances[i], gains[i], HRTF_BLOCK);
+            }
+            quint64 blockTime = usecTimestampNow() - blockStart;
+            blockTimes.push_back(blockTime);
+            totalBlockTime += blockTime;
+        }
+
+        double mixEnergy = 0.0;
+        for (float sample : mix) {
+            mixEnergy += sample * sample;
+        }
+        std::sort(blockTimes.begin(), blockTimes.end());
+
+        QJsonObject result;
+        result["sources"] = numSources;
+        result["blocks"] = _numBlocks;
+        result["meanUsecsPerBlock"] = (double)totalBlockTime / (double)_numBlocks;
+        result["p50UsecsPerBlock"] = percentile(blockTimes, 0.50);
+        result["p99UsecsPerBlock"] = percentile(blockTimes, 0.99);
+        result["meanUsecsPerSource"] = (double)totalBlockTime / (double)(_numBlocks * numSources);
+        _results.add(result);
+
+        QVERIFY2(mixEnergy > 0.0, "the sources were not mixed");
+    }
+}
+
+void AudioHRTFBenchmarkTests::cleanupTestCase() {
+    QJsonObject root;
+    root["blocks"] = _numBlocks;
+    root["blockFrames"] = HRTF_BLOCK;
+    QVERIFY2(_results.write(root), "could not write the JSON output file");
+}
@@ -0,0 +1,38 @@
+//
+//  AudioHRTFBenchmarkTests.h
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioHRTFBenchmarkTests_h
+#define hifi_AudioHRTFBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <../BenchmarkUtils.h>
+
+// Cost of spatializing mono sources into a listener's stereo mix with the AudioHRTF, a block at a time as the audio
+// mixer does, for sources moving around the listener.
+// Configured through the environment:
+//   HIFI_HRTF_BENCHMARK_SOURCES   comma separated numbers of sources mixed (default 16,64,256)
+//   HIFI_HRTF_BENCHMARK_BLOCKS    blocks mixed per number of sources (default 1000)
+//   HIFI_HRTF_BENCHMARK_JSON      path to write the results to as JSON (default is log output only)
+class AudioHRTFBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void renderSourcesBenchmark();
+    void cleanupTestCase();
+
+private:
+    QVector<int> _numSources { 16, 64, 256 };
+    int _numBlocks { 1000 };
+
+    benchmark::BenchmarkResults _results { benchmark::HRTF_BENCHMARK_JSON };
+};
+
+#endif // hifi_AudioHRTFBenchmarkTests_h
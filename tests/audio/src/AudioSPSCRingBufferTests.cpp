@@ -0,0 +1,96 @@
+//
+//  AudioSPSCRingBufferTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSPSCRingBufferTests.h"
+
+#include <thread>
+
+#include "AudioSPSCRingBuffer.h"
+
+QTEST_MAIN(AudioSPSCRingBufferTests)
+
+void AudioSPSCRingBufferTests::wrapAround() {
+    AudioSPSCRingBuffer buffer(10);
+    QCOMPARE(buffer.getSampleCapacity(), 10);
+    QVERIFY(buffer.isLockFree());
+
+    int16_t source[16];
+    int16_t destination[16];
+    for (int i = 0; i < 16; i++) {
+        source[i] = i;
+    }
+
+    // writes are truncated to the free space
+    QCOMPARE(buffer.writeSamples(source, 16), 10);
+    QCOMPARE(buffer.samplesFree(), 0);
+    QCOMPARE(buffer.writeSamples(source, 1), 0);
+
+    QCOMPARE(buffer.readSamples(destination, 7), 7);
+    QCOMPARE(buffer.writeSamples(source + 10, 6), 6);
+    QCOMPARE(buffer.samplesAvailable(), 9);
+
+    // reads across the end of the buffer are in order
+    QCOMPARE(buffer.readSamples(destination, 16), 9);
+    for (int i = 0; i < 9; i++) {
+        QCOMPARE(destination[i], (int16_t)(7 + i));
+    }
+
+    buffer.writeSamples(source, 5);
+    buffer.skipSamples(3);
+    QCOMPARE(buffer.samplesAvailable(), 2);
+    buffer.clear();
+    QCOMPARE(buffer.samplesAvailable(), 0);
+}
+
+void AudioSPSCRingBufferTests::appendSamples() {
+    AudioSPSCMixRingBuffer buffer(4);
+
+    float source[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    float destination[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    buffer.writeSamples(source, 4);
+    QCOMPARE(buffer.appendSamples(destination, 4), 4);
+    for (int i = 0; i < 4; i++) {
+        QCOMPARE(destination[i], source[i] + 1.0f);
+    }
+}
+
+void AudioSPSCRingBufferTests::producerConsumer() {
+    const int NUM_SAMPLES = 1000000;
+    AudioSPSCRingBuffer buffer(97);
+
+    // a producer and consumer with mismatched block sizes, so that every wrap offset is exercised
+    std::thread producer([&] {
+        int16_t block[13];
+        int written = 0;
+        while (written < NUM_SAMPLES) {
+            int numSamples = std::min(13, NUM_SAMPLES - written);
+            for (int i = 0; i < numSamples; i++) {
+                block[i] = (int16_t)(written + i);
+            }
+            written += buffer.writeSamples(block, numSamples);
+        }
+    });
+
+    int16_t block[29];
+    int read = 0;
+    int numErrors = 0;
+    while (read < NUM_SAMPLES) {
+        int numSamples = buffer.readSamples(block, 29);
+        for (int i = 0; i < numSamples; i++) {
+            numErrors += (block[i] != (int16_t)(read + i));
+        }
+        read += numSamples;
+    }
+    producer.join();
+
+    QCOMPARE(numErrors, 0);
+    QCOMPARE(buffer.samplesAvailable(), 0);
+}
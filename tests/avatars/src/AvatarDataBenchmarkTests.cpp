@@ -0,0 +1,142 @@
+//
+//  AvatarDataBenchmarkTests.cpp
+//  tests/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarDataBenchmarkTests.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <AvatarData.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AvatarDataBenchmarkTests)
+
+using namespace benchmark;
+
+namespace {
+    const int MAX_JOINTS = 255; // the joint count is sent as a byte
+    const float AVATAR_SPACING = 2.0f; // meters
+    const float JOINT_SWING = 0.3f; // radians a joint swings through
+    const glm::vec3 VIEWER_POSITION(0.0f, 1.7f, -5.0f);
+
+    // every joint of every avatar swings a little each frame, at its own phase, so no two frames encode the same
+    QVector<JointData> posedJoints(int numJoints, int avatarIndex, int frame) {
+        QVector<JointData> joints(numJoints);
+        for (int i = 0; i < numJoints; ++i) {
+            float angle = JOINT_SWING * sinf(0.1f * (float)frame + 0.7f * (float)i + 1.3f * (float)avatarIndex);
+            joints[i].rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)(i % 3), 0.5f)));
+            joints[i].rotationSet = true;
+            joints[i].translation = glm::vec3(0.0f, 0.1f, 0.0f);
+            joints[i].translationSet = (i % 4 == 0); // as most rigs, only some joints are translated
+        }
+        return joints;
+    }
+
+    const char* detailName(AvatarData::AvatarDataDetail detail) {
+        switch (detail) {
+            case AvatarData::SendAllData:
+                return "SendAllData";
+            case AvatarData::CullSmallData:
+                return "CullSmallData";
+            case AvatarData::MinimumData:
+                return "MinimumData";
+            default:
+                return "Other";
+        }
+    }
+}
+
+void AvatarDataBenchmarkTests::initTestCase() {
+    _numAvatars = std::max(1, intFromEnvironment("HIFI_AVATAR_BENCHMARK_AVATARS", _numAvatars));
+    _numJoints = std::min(MAX_JOINTS, std::max(1, intFromEnvironment("HIFI_AVATAR_BENCHMARK_JOINTS", _numJoints)));
+    _numFrames = std::max(1, intFromEnvironment("HIFI_AVATAR_BENCHMARK_FRAMES", _numFrames));
+}
+
+void AvatarDataBenchmarkTests::encodeDecodeBenchmark() {
+    for (auto detail : { AvatarData::SendAllData, AvatarData::CullSmallData, AvatarData::MinimumData }) {
+        std::vector<std::unique_ptr<AvatarData>> senders;
+        std::vector<std::unique_ptr<AvatarData>> receivers;
+        std::vector<QVector<JointData>> lastSentJointData;
+        for (int i = 0; i < _numAvatars; ++i) {
+            senders.emplace_back(new AvatarData());
+            senders.back()->setSessionUUID(QUuid::createUuid());
+            senders.back()->setPosition(glm::vec3(AVATAR_SPACING * (float)(i % 10), 0.0f, AVATAR_SPACING * (float)(i / 10)));
+            receivers.emplace_back(new AvatarData());
+            lastSentJointData.emplace_back(_numJoints);
+        }
+
+        std::vector<quint64> encodeTimes;
+        std::vector<quint64> decodeTimes;
+        encodeTimes.reserve(_numFrames);
+        decodeTimes.reserve(_numFrames);
+        quint64 totalEncodeTime = 0;
+        quint64 totalDecodeTime = 0;
+        qint64 totalBytes = 0;
+        std::vector<QByteArray> encoded(_numAvatars);
+
+        for (int frame = 0; frame < _numFrames; ++frame) {
+            for (int i = 0; i < _numAvatars; ++i) {
+                senders[i]->setRawJointData(posedJoints(_numJoints, i, frame));
+            }
+
+            quint64 encodeStart = usecTimestampNow();
+            for (int i = 0; i < _numAvatars; ++i) {
+                // as the mixer does, with the joints last sent to the viewer updated to the joints sent
+                AvatarDataPacket::HasFlags hasFlags;
+                encoded[i] = senders[i]->toByteArray(detail, 0, lastSentJointData[i], hasFlags, false, true,
+                                                     VIEWER_POSITION, &lastSentJointData[i]);
+            }
+            quint64 encodeTime = usecTimestampNow() - encodeStart;
+
+            quint64 decodeStart = usecTimestampNow();
+            for (int i = 0; i < _numAvatars; ++i) {
+                receivers[i]->parseDataFromBuffer(encoded[i]);
+            }
+            quint64 decodeTime = usecTimestampNow() - decodeStart;
+
+            for (const auto& bytes : encoded) {
+                totalBytes += bytes.size();
+            }
+            encodeTimes.push_back(encodeTime);
+            decodeTimes.push_back(decodeTime);
+            totalEncodeTime += encodeTime;
+            totalDecodeTime += decodeTime;
+        }
+
+        QVERIFY2(totalBytes > 0, "no avatar data was encoded");
+        std::sort(encodeTimes.begin(), encodeTimes.end());
+        std::sort(decodeTimes.begin(), decodeTimes.end());
+
+        double numEncoded = (double)_numFrames * (double)_numAvatars;
+        QJsonObject result;
+        result["detail"] = detailName(detail);
+        result["avatars"] = _numAvatars;
+        result["joints"] = _numJoints;
+        result["meanEncodeUsecsPerAvatar"] = (double)totalEncodeTime / numEncoded;
+        result["p50EncodeUsecsPerFrame"] = percentile(encodeTimes, 0.50);
+        result["p99EncodeUsecsPerFrame"] = percentile(encodeTimes, 0.99);
+        result["meanDecodeUsecsPerAvatar"] = (double)totalDecodeTime / numEncoded;
+        result["p50DecodeUsecsPerFrame"] = percentile(decodeTimes, 0.50);
+        result["p99DecodeUsecsPerFrame"] = percentile(decodeTimes, 0.99);
+        result["meanBytesPerAvatar"] = (double)totalBytes / numEncoded;
+        _results.add(result);
+    }
+}
+
+void AvatarDataBenchmarkTests::cleanupTestCase() {
+    QJsonObject root;
+    root["frames"] = _numFrames;
+    QVERIFY2(_results.write(root), "could not write the JSON output file");
+}
@@ -0,0 +1,41 @@
+//
+//  AvatarDataBenchmarkTests.h
+//  tests/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarDataBenchmarkTests_h
+#define hifi_AvatarDataBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <../BenchmarkUtils.h>
+
+// Cost of encoding avatars for a viewer with AvatarData::toByteArray, as the avatar mixer does every frame, and of
+// decoding what was sent with AvatarData::parseDataFromBuffer, as every client does, for avatars whose joints all
+// move a little each frame, at each of the details the mixer sends at.
+// Configured through the environment:
+//   HIFI_AVATAR_BENCHMARK_AVATARS  number of avatars encoded per frame (default 100)
+//   HIFI_AVATAR_BENCHMARK_JOINTS   number of joints of each avatar (default 60)
+//   HIFI_AVATAR_BENCHMARK_FRAMES   frames encoded per detail (default 200)
+//   HIFI_AVATAR_BENCHMARK_JSON     path to write the results to as JSON (default is log output only)
+class AvatarDataBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void encodeDecodeBenchmark();
+    void cleanupTestCase();
+
+private:
+    int _numAvatars { 100 };
+    int _numJoints { 60 };
+    int _numFrames { 200 };
+
+    benchmark::BenchmarkResults _results { benchmark::AVATAR_BENCHMARK_JSON };
+};
+
+#endif // hifi_AvatarDataBenchmarkTests_h
@@ -0,0 +1,115 @@
+//
+//  TextureProcessingBenchmarkTests.cpp
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingBenchmarkTests.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtGui/QImage>
+
+#include <gpu/Texture.h>
+#include <model/TextureMap.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(TextureProcessingBenchmarkTests)
+
+using namespace benchmark;
+
+namespace {
+    using TextureFactory = std::function<gpu::Texture*(const QImage&, const std::string&)>;
+
+    struct TexturePath {
+        const char* name;
+        bool isGrayscale;
+        TextureFactory factory;
+    };
+
+    // gradients with noise over them, so that no mip is uniform and every texel goes through the filters
+    QImage makeImage(int size, bool isGrayscale) {
+        std::mt19937 generator { (unsigned int)size };
+        std::uniform_int_distribution<int> noise { -24, 24 };
+        QImage image(size, size, QImage::Format_RGB32);
+        for (int y = 0; y < size; ++y) {
+            QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+            for (int x = 0; x < size; ++x) {
+                int red = glm::clamp(255 * x / size + noise(generator), 0, 255);
+                if (isGrayscale) {
+                    line[x] = qRgb(red, red, red);
+                } else {
+                    int green = glm::clamp(255 * y / size + noise(generator), 0, 255);
+                    int blue = glm::clamp(128 + noise(generator), 0, 255);
+                    line[x] = qRgb(red, green, blue);
+                }
+            }
+        }
+        return image;
+    }
+}
+
+void TextureProcessingBenchmarkTests::initTestCase() {
+    _sizes = countsFromEnvironment("HIFI_TEXTURE_BENCHMARK_SIZES", _sizes);
+    _numRepetitions = std::max(1, intFromEnvironment("HIFI_TEXTURE_BENCHMARK_REPETITIONS", _numRepetitions));
+}
+
+void TextureProcessingBenchmarkTests::processImageBenchmark() {
+    const std::vector<TexturePath> paths {
+        { "albedo", false, model::TextureUsage::createAlbedoTextureFromImage },
+        { "normalFromBump", true, model::TextureUsage::createNormalTextureFromBumpImage },
+        { "roughness", true, model::TextureUsage::createRoughnessTextureFromImage }
+    };
+
+    for (int size : _sizes) {
+        QImage colorImage = makeImage(size, false);
+        QImage grayscaleImage = makeImage(size, true);
+
+        for (const auto& path : paths) {
+            const QImage& image = path.isGrayscale ? grayscaleImage : colorImage;
+            std::string imageName = QString("%1-%2").arg(path.name).arg(size).toStdString();
+
+            std::vector<quint64> processTimes;
+            processTimes.reserve(_numRepetitions);
+            quint64 totalProcessTime = 0;
+            int numMips = 0;
+
+            for (int i = 0; i < _numRepetitions; ++i) {
+                quint64 start = usecTimestampNow();
+                gpu::Texture* texture = path.factory(image, imageName);
+                quint64 processTime = usecTimestampNow() - start;
+
+                QVERIFY2(texture, "the image was not processed into a texture");
+                numMips = texture->evalNumMips();
+                delete texture;
+
+                processTimes.push_back(processTime);
+                totalProcessTime += processTime;
+            }
+            std::sort(processTimes.begin(), processTimes.end());
+
+            QJsonObject result;
+            result["path"] = path.name;
+            result["size"] = size;
+            result["mips"] = numMips;
+            result["meanProcessMsecs"] = (double)totalProcessTime / (double)(_numRepetitions * USECS_PER_MSEC);
+            result["p50ProcessMsecs"] = percentile(processTimes, 0.50) / (double)USECS_PER_MSEC;
+            result["maxProcessMsecs"] = (double)processTimes.back() / (double)USECS_PER_MSEC;
+            _results.add(result);
+        }
+    }
+}
+
+void TextureProcessingBenchmarkTests::cleanupTestCase() {
+    QJsonObject root;
+    root["repetitions"] = _numRepetitions;
+    QVERIFY2(_results.write(root), "could not write the JSON output file");
+}
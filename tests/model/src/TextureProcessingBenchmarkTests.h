@@ -0,0 +1,39 @@
+//
+//  TextureProcessingBenchmarkTests.h
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureProcessingBenchmarkTests_h
+#define hifi_TextureProcessingBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <../BenchmarkUtils.h>
+
+// Cost of turning a downloaded image into a gpu::Texture with its mips, as model::TextureUsage does on the resource
+// threads for every texture of a model, for square images of each size through the albedo, normal from bump and
+// roughness paths.
+// Configured through the environment:
+//   HIFI_TEXTURE_BENCHMARK_SIZES        comma separated sizes of the images in texels (default 1024,2048)
+//   HIFI_TEXTURE_BENCHMARK_REPETITIONS  times each image is processed (default 5)
+//   HIFI_TEXTURE_BENCHMARK_JSON         path to write the results to as JSON (default is log output only)
+class TextureProcessingBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void processImageBenchmark();
+    void cleanupTestCase();
+
+private:
+    QVector<int> _sizes { 1024, 2048 };
+    int _numRepetitions { 5 };
+
+    benchmark::BenchmarkResults _results { benchmark::TEXTURE_BENCHMARK_JSON };
+};
+
+#endif // hifi_TextureProcessingBenchmarkTests_h
@@ -18,7 +18,7 @@ QTEST_MAIN(PacketTests)
 
 std::unique_ptr<NLPacket> copyToReadPacket(std::unique_ptr<NLPacket>& packet) {
     auto size = packet->getDataSize();
-    auto data = std::unique_ptr<char[]>(new char[size]);
+    auto data = udt::PacketPool::allocate(size);
     memcpy(data.get(), packet->getData(), size);
     return NLPacket::fromReceivedPacket(std::move(data), size, HifiSockAddr());
 }
@@ -180,3 +180,25 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::packetPoolRecycleTest() {
+    const char* firstData = nullptr;
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+        firstData = packet->getData();
+    }
+
+    auto statsBefore = udt::PacketPool::getStats();
+
+    // the buffer of the packet we just dropped should be the next one out of this thread's cache
+    auto packet = NLPacket::create(PacketType::Unknown);
+    QVERIFY(packet->getData() == firstData);
+
+    auto statsAfter = udt::PacketPool::getStats();
+    QCOMPARE(statsAfter.hits, statsBefore.hits + 1);
+    QCOMPARE(statsAfter.misses, statsBefore.misses);
+
+    // a recycled buffer still starts out zeroed
+    QByteArray zeroes(packet->getPayloadCapacity(), 0);
+    COMPARE_DATA(packet->getPayload(), zeroes.constData(), packet->getPayloadCapacity());
+}
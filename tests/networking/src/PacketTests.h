@@ -36,6 +36,9 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test that released packet buffers are handed out again
+    void packetPoolRecycleTest();
 };
 
 #endif // hifi_PacketTests_h
@@ -0,0 +1,230 @@
+//
+//  UDTBenchmarkTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UDTBenchmarkTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <QtCore/QJsonObject>
+
+#include <SharedUtil.h>
+#include <udt/Packet.h>
+#include <udt/PacketList.h>
+#include <udt/Socket.h>
+
+QTEST_MAIN(UDTBenchmarkTests)
+
+using namespace benchmark;
+
+namespace {
+    const int UNRELIABLE_PACKET_SIZE = 512;
+    const int SEND_BURST_PACKETS = 64;
+    const int PACKETS_PER_MESSAGE = 100;
+    const int MESSAGE_SIZE = 64 * 1024;
+
+    // how long we wait for stragglers once everything has been sent
+    const quint64 UNRELIABLE_IDLE_TIMEOUT_USECS = USECS_PER_SECOND;
+    const quint64 RELIABLE_TIMEOUT_USECS = 60 * USECS_PER_SECOND;
+
+    // A sending and a receiving socket on the loopback interface, with loss injected on the receiving side.
+    // Every payload starts with its send time, so latency is measured on a single clock.
+    class LoopbackPair {
+    public:
+        LoopbackPair(int lossPercentage) : _lossPercentage(lossPercentage) {
+            _sender.bind(QHostAddress::LocalHost);
+            _receiver.bind(QHostAddress::LocalHost);
+            _destination = HifiSockAddr(QHostAddress::LocalHost, _receiver.localPort());
+
+            // connections are created for any address, there is no node list here
+            _receiver.setPacketFilterOperator([this](const udt::Packet&) {
+                return _lossPercentage == 0 || _lossDistribution(_generator) >= _lossPercentage;
+            });
+        }
+
+        udt::Socket& sender() { return _sender; }
+        udt::Socket& receiver() { return _receiver; }
+        const HifiSockAddr& destination() const { return _destination; }
+
+        void start() { _startTime = usecTimestampNow(); }
+
+        void recordSendTime(quint64 sendTime) {
+            auto now = usecTimestampNow();
+            _latencies.push_back(now - sendTime);
+            _lastReceiveTime = now;
+        }
+
+        int received() const { return (int)_latencies.size(); }
+        quint64 lastReceiveTime() const { return _lastReceiveTime; }
+
+        // runs the event loop until done returns true or timeoutUsecs have passed since whatever idleSince returns
+        template <typename Done, typename IdleSince>
+        bool waitFor(Done done, IdleSince idleSince, quint64 timeoutUsecs) {
+            while (!done()) {
+                if (usecTimestampNow() - idleSince() > timeoutUsecs) {
+                    return false;
+                }
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+            }
+            return true;
+        }
+
+        QJsonObject results(const QString& name, int sent) {
+            std::sort(_latencies.begin(), _latencies.end());
+
+            double seconds = (double)(std::max(_lastReceiveTime, _startTime) - _startTime) / USECS_PER_SECOND;
+
+            QJsonObject result;
+            result["name"] = name;
+            result["lossPercentage"] = _lossPercentage;
+            result["sent"] = sent;
+            result["received"] = received();
+            result["seconds"] = seconds;
+            result["perSecond"] = seconds > 0.0 ? received() / seconds : 0.0;
+            result["p50LatencyUsecs"] = percentile(_latencies, 0.50);
+            result["p99LatencyUsecs"] = percentile(_latencies, 0.99);
+
+            auto stats = _sender.sampleStatsForAllConnections();
+            if (!stats.empty()) {
+                const auto& connectionStats = stats.front().second;
+                result["retransmittedPackets"] =
+                    connectionStats.events[udt::ConnectionStats::Stats::Retransmission];
+            }
+
+            return result;
+        }
+
+    private:
+        udt::Socket _sender;
+        udt::Socket _receiver;
+        HifiSockAddr _destination;
+
+        int _lossPercentage;
+        std::mt19937 _generator { 742272 }; // fixed seed so runs drop the same packets
+        std::uniform_int_distribution<int> _lossDistribution { 0, 99 };
+
+        std::vector<quint64> _latencies;
+        quint64 _startTime { 0 };
+        quint64 _lastReceiveTime { 0 };
+    };
+
+    std::unique_ptr<udt::Packet> createTimestampedPacket(bool isReliable) {
+        auto packet = udt::Packet::create(UNRELIABLE_PACKET_SIZE, isReliable);
+        packet->writePrimitive(usecTimestampNow());
+        packet->setPayloadSize(packet->getPayloadCapacity());
+        return packet;
+    }
+}
+
+void UDTBenchmarkTests::initTestCase() {
+    _numPackets = std::max(1, intFromEnvironment("HIFI_UDT_BENCHMARK_PACKETS", _numPackets));
+    _lossPercentage = std::min(std::max(intFromEnvironment("HIFI_UDT_BENCHMARK_LOSS", _lossPercentage), 0), 99);
+}
+
+void UDTBenchmarkTests::unreliablePacketsBenchmark() {
+    LoopbackPair pair(_lossPercentage);
+
+    pair.receiver().setPacketHandler([&pair](std::unique_ptr<udt::Packet> packet) {
+        quint64 sendTime;
+        packet->readPrimitive(&sendTime);
+        pair.recordSendTime(sendTime);
+    });
+
+    pair.start();
+
+    int sent = 0;
+    quint64 lastSendTime = usecTimestampNow();
+    while (sent < _numPackets) {
+        for (int i = 0; i < SEND_BURST_PACKETS && sent < _numPackets; ++i, ++sent) {
+            pair.sender().writePacket(*createTimestampedPacket(false), pair.destination());
+        }
+        lastSendTime = usecTimestampNow();
+
+        // let the receiver keep up, we are measuring the stack and not the size of the socket buffers
+        QCoreApplication::processEvents();
+    }
+
+    // without loss everything should arrive, with it we wait until nothing has arrived for a while
+    pair.waitFor([&] { return pair.received() >= _numPackets; },
+                 [&] { return std::max(lastSendTime, pair.lastReceiveTime()); },
+                 UNRELIABLE_IDLE_TIMEOUT_USECS);
+
+    _results.add(pair.results("unreliablePackets", sent));
+}
+
+void UDTBenchmarkTests::reliablePacketsBenchmark() {
+    LoopbackPair pair(_lossPercentage);
+
+    pair.receiver().setPacketHandler([&pair](std::unique_ptr<udt::Packet> packet) {
+        quint64 sendTime;
+        packet->readPrimitive(&sendTime);
+        pair.recordSendTime(sendTime);
+    });
+
+    pair.start();
+
+    for (int i = 0; i < _numPackets; ++i) {
+        pair.sender().writePacket(createTimestampedPacket(true), pair.destination());
+    }
+
+    auto startTime = usecTimestampNow();
+    bool allReceived = pair.waitFor([&] { return pair.received() >= _numPackets; },
+                                    [&] { return startTime; }, RELIABLE_TIMEOUT_USECS);
+
+    _results.add(pair.results("reliablePackets", _numPackets));
+
+    QVERIFY2(allReceived, "reliable packets were not all received");
+    QCOMPARE(pair.received(), _numPackets);
+}
+
+void UDTBenchmarkTests::packetListBenchmark() {
+    LoopbackPair pair(_lossPercentage);
+
+    int numMessages = std::max(1, _numPackets / PACKETS_PER_MESSAGE);
+
+    // reliable ordered messages are handed over packet by packet, in order
+    quint64 messageSendTime = 0;
+    pair.receiver().setMessageHandler([&](std::unique_ptr<udt::Packet> packet) {
+        auto position = packet->getPacketPosition();
+        if (position == udt::Packet::ONLY || position == udt::Packet::FIRST) {
+            packet->readPrimitive(&messageSendTime);
+        }
+        if (position == udt::Packet::ONLY || position == udt::Packet::LAST) {
+            pair.recordSendTime(messageSendTime);
+        }
+    });
+
+    QByteArray filler(MESSAGE_SIZE, 'x');
+
+    pair.start();
+
+    for (int i = 0; i < numMessages; ++i) {
+        auto packetList = udt::PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+        packetList->writePrimitive(usecTimestampNow());
+        packetList->write(filler);
+        pair.sender().writePacketList(std::move(packetList), pair.destination());
+    }
+
+    auto startTime = usecTimestampNow();
+    bool allReceived = pair.waitFor([&] { return pair.received() >= numMessages; },
+                                    [&] { return startTime; }, RELIABLE_TIMEOUT_USECS);
+
+    _results.add(pair.results("packetListMessages", numMessages));
+
+    QVERIFY2(allReceived, "packet list messages were not all received");
+    QCOMPARE(pair.received(), numMessages);
+}
+
+void UDTBenchmarkTests::cleanupTestCase() {
+    QJsonObject root;
+    root["packets"] = _numPackets;
+    root["lossPercentage"] = _lossPercentage;
+    QVERIFY2(_results.write(root), "could not write the JSON output file");
+}
@@ -0,0 +1,39 @@
+//
+//  UDTBenchmarkTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UDTBenchmarkTests_h
+#define hifi_UDTBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <../BenchmarkUtils.h>
+
+// Throughput and latency of the UDT stack through a pair of loopback sockets.
+// Configured through the environment so that it can run unattended between releases:
+//   HIFI_UDT_BENCHMARK_PACKETS   packets (or messages, for packet lists) sent per benchmark (default 10000)
+//   HIFI_UDT_BENCHMARK_LOSS      percentage of data packets dropped on the receiving side (default 0)
+//   HIFI_UDT_BENCHMARK_JSON      path to write the results to as JSON (default is log output only)
+class UDTBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void unreliablePacketsBenchmark();
+    void reliablePacketsBenchmark();
+    void packetListBenchmark();
+    void cleanupTestCase();
+
+private:
+    int _numPackets { 10000 };
+    int _lossPercentage { 0 };
+
+    benchmark::BenchmarkResults _results { benchmark::UDT_BENCHMARK_JSON };
+};
+
+#endif // hifi_UDTBenchmarkTests_h
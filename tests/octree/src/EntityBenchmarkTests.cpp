@@ -0,0 +1,189 @@
+//
+//  EntityBenchmarkTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBenchmarkTests.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <AABox.h>
+#include <DependencyManager.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityBenchmarkTests)
+
+using namespace benchmark;
+
+namespace {
+    const float REGION_HALF_SIZE = 250.0f; // meters, the entities are scattered through a region this far from the origin
+    const float QUERY_RADIUS = 10.0f; // meters
+    const glm::vec3 ENTITY_DIMENSIONS(1.0f);
+
+    glm::vec3 randomPosition(std::mt19937& generator) {
+        std::uniform_real_distribution<float> distribution { -REGION_HALF_SIZE, REGION_HALF_SIZE };
+        return glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+
+    EntityItemProperties boxProperties(std::mt19937& generator, int index) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setName(QString("box %1").arg(index));
+        properties.setPosition(randomPosition(generator));
+        properties.setDimensions(ENTITY_DIMENSIONS);
+        properties.setColor({ (unsigned char)(index % 256), 128, 255 });
+        return properties;
+    }
+
+    bool countElement(OctreeElementPointer element, void* extraData) {
+        (*static_cast<int*>(extraData))++;
+        return true; // keep recursing
+    }
+}
+
+void EntityBenchmarkTests::initTestCase() {
+    _numEntities = countsFromEnvironment("HIFI_ENTITY_BENCHMARK_ENTITIES", _numEntities);
+    _numQueries = std::max(1, intFromEnvironment("HIFI_ENTITY_BENCHMARK_QUERIES", _numQueries));
+
+    // the tree asks the NodeList whether it may add entities
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+void EntityBenchmarkTests::editPacketBenchmark() {
+    std::mt19937 generator { 16384 }; // fixed seed so runs encode the same entities
+    int numEntities = _numEntities.back();
+
+    std::vector<EntityItemProperties> properties;
+    std::vector<EntityItemID> entityIDs;
+    for (int i = 0; i < numEntities; ++i) {
+        properties.push_back(boxProperties(generator, i));
+        entityIDs.push_back(EntityItemID(QUuid::createUuid()));
+    }
+
+    std::vector<QByteArray> encoded(numEntities);
+    quint64 encodeStart = usecTimestampNow();
+    for (int i = 0; i < numEntities; ++i) {
+        encoded[i] = QByteArray(NLPacket::maxPayloadSize(PacketType::EntityAdd), 0);
+        QVERIFY(EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entityIDs[i], properties[i], encoded[i]));
+    }
+    quint64 encodeTime = usecTimestampNow() - encodeStart;
+
+    qint64 totalBytes = 0;
+    quint64 decodeStart = usecTimestampNow();
+    for (int i = 0; i < numEntities; ++i) {
+        int processedBytes = 0;
+        EntityItemID decodedID;
+        EntityItemProperties decodedProperties;
+        EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(encoded[i].constData()),
+                                                     encoded[i].size(), processedBytes, decodedID, decodedProperties);
+        totalBytes += processedBytes;
+    }
+    quint64 decodeTime = usecTimestampNow() - decodeStart;
+    QVERIFY2(totalBytes > 0, "no edit packet was decoded");
+
+    QJsonObject result;
+    result["operation"] = "editPacket";
+    result["entities"] = numEntities;
+    result["meanEncodeUsecsPerEntity"] = (double)encodeTime / (double)numEntities;
+    result["meanDecodeUsecsPerEntity"] = (double)decodeTime / (double)numEntities;
+    result["meanBytesPerEntity"] = (double)totalBytes / (double)numEntities;
+    _results.add(result);
+}
+
+void EntityBenchmarkTests::treeQueryBenchmark() {
+    for (int numEntities : _numEntities) {
+        std::mt19937 generator { 32768 }; // fixed seed so runs build the same tree and make the same queries
+
+        EntityTreePointer tree(new EntityTree(true));
+        tree->createRootElement();
+        tree->setIsServer(true);
+
+        quint64 addStart = usecTimestampNow();
+        tree->withWriteLock([&] {
+            for (int i = 0; i < numEntities; ++i) {
+                tree->addEntity(EntityItemID(QUuid::createUuid()), boxProperties(generator, i));
+            }
+        });
+        quint64 addTime = usecTimestampNow() - addStart;
+
+        std::vector<glm::vec3> queryCenters;
+        for (int i = 0; i < _numQueries; ++i) {
+            queryCenters.push_back(randomPosition(generator));
+        }
+
+        std::vector<quint64> sphereTimes;
+        std::vector<quint64> boxTimes;
+        sphereTimes.reserve(_numQueries);
+        boxTimes.reserve(_numQueries);
+        quint64 totalSphereTime = 0;
+        quint64 totalBoxTime = 0;
+        int numFound = 0;
+        int numElements = 0;
+        quint64 traversalTime = 0;
+
+        tree->withReadLock([&] {
+            for (const auto& center : queryCenters) {
+                QVector<EntityItemPointer> found;
+                quint64 start = usecTimestampNow();
+                tree->findEntities(center, QUERY_RADIUS, found);
+                quint64 time = usecTimestampNow() - start;
+                sphereTimes.push_back(time);
+                totalSphereTime += time;
+                numFound += found.size();
+            }
+
+            for (const auto& center : queryCenters) {
+                QVector<EntityItemPointer> found;
+                AABox box(center - glm::vec3(QUERY_RADIUS), 2.0f * QUERY_RADIUS);
+                quint64 start = usecTimestampNow();
+                tree->findEntities(box, found);
+                quint64 time = usecTimestampNow() - start;
+                boxTimes.push_back(time);
+                totalBoxTime += time;
+                numFound += found.size();
+            }
+
+            quint64 start = usecTimestampNow();
+            tree->recurseTreeWithOperation(countElement, &numElements);
+            traversalTime = usecTimestampNow() - start;
+        });
+
+        QVERIFY2(numElements > 0, "the tree has no elements");
+        std::sort(sphereTimes.begin(), sphereTimes.end());
+        std::sort(boxTimes.begin(), boxTimes.end());
+
+        QJsonObject result;
+        result["operation"] = "treeQuery";
+        result["entities"] = numEntities;
+        result["elements"] = numElements;
+        result["meanAddUsecsPerEntity"] = (double)addTime / (double)numEntities;
+        result["meanSphereQueryUsecs"] = (double)totalSphereTime / (double)_numQueries;
+        result["p50SphereQueryUsecs"] = percentile(sphereTimes, 0.50);
+        result["p99SphereQueryUsecs"] = percentile(sphereTimes, 0.99);
+        result["meanBoxQueryUsecs"] = (double)totalBoxTime / (double)_numQueries;
+        result["p50BoxQueryUsecs"] = percentile(boxTimes, 0.50);
+        result["p99BoxQueryUsecs"] = percentile(boxTimes, 0.99);
+        result["meanFoundPerQuery"] = (double)numFound / (double)(2 * _numQueries);
+        result["traversalUsecs"] = (double)traversalTime;
+        _results.add(result);
+    }
+}
+
+void EntityBenchmarkTests::cleanupTestCase() {
+    QJsonObject root;
+    root["queries"] = _numQueries;
+    QVERIFY2(_results.write(root), "could not write the JSON output file");
+}
@@ -0,0 +1,39 @@
+//
+//  EntityBenchmarkTests.h
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBenchmarkTests_h
+#define hifi_EntityBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <../BenchmarkUtils.h>
+
+// Cost of the entity-server's hot paths on a tree of box entities scattered through a region: encoding and decoding
+// the edit packets of the entities, finding the entities near a point and within a box, and traversing the octree.
+// Configured through the environment:
+//   HIFI_ENTITY_BENCHMARK_ENTITIES   comma separated numbers of entities in the tree (default 1000,10000)
+//   HIFI_ENTITY_BENCHMARK_QUERIES    queries made of each kind per tree (default 1000)
+//   HIFI_ENTITY_BENCHMARK_JSON       path to write the results to as JSON (default is log output only)
+class EntityBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void editPacketBenchmark();
+    void treeQueryBenchmark();
+    void cleanupTestCase();
+
+private:
+    QVector<int> _numEntities { 1000, 10000 };
+    int _numQueries { 1000 };
+
+    benchmark::BenchmarkResults _results { benchmark::ENTITY_BENCHMARK_JSON };
+};
+
+#endif // hifi_EntityBenchmarkTests_h
@@ -827,3 +827,46 @@ void OctreeTests::elementAddChildTests() {
         }
     }
 }
+
+void OctreeTests::packetDataValueTests() {
+    OctreePacketData packetData(false);
+
+    glm::vec3 position(1.0f, -2.0f, 3.5f);
+    QVector<bool> flags { true, false, false, true, true, false, true, false, true };
+    QVector<float> weights { 0.25f, 0.5f };
+    QUuid id = QUuid::createUuid();
+    QVERIFY(packetData.appendValue(position));
+    QVERIFY(packetData.appendValue(flags));
+    QVERIFY(packetData.appendValue(weights));
+    QVERIFY(packetData.appendValue(id));
+    QVERIFY(packetData.appendValue(QUuid()));
+    QVERIFY(packetData.appendValue((quint64)12345678901234ULL));
+
+    const unsigned char* dataAt = packetData.getUncompressedData();
+    glm::vec3 positionRead;
+    QVector<bool> flagsRead;
+    QVector<float> weightsRead;
+    QUuid idRead;
+    QUuid nullIDRead = QUuid::createUuid();
+    quint64 numberRead;
+    dataAt += OctreePacketData::unpackDataFromBytes(dataAt, positionRead);
+    dataAt += OctreePacketData::unpackDataFromBytes(dataAt, flagsRead);
+    dataAt += OctreePacketData::unpackDataFromBytes(dataAt, weightsRead);
+    dataAt += OctreePacketData::unpackDataFromBytes(dataAt, idRead);
+    dataAt += OctreePacketData::unpackDataFromBytes(dataAt, nullIDRead);
+    dataAt += OctreePacketData::unpackDataFromBytes(dataAt, numberRead);
+
+    QCOMPARE(positionRead, position);
+    QCOMPARE(flagsRead, flags);
+    QCOMPARE(weightsRead, weights);
+    QCOMPARE(idRead, id);
+    QVERIFY(nullIDRead.isNull());
+    QCOMPARE(numberRead, (quint64)12345678901234ULL);
+    QCOMPARE((int)(dataAt - packetData.getUncompressedData()), packetData.getUncompressedSize());
+
+    // a value that doesn't fit leaves the stream as it was
+    int bytesAvailable = packetData.getBytesAvailable();
+    QVector<glm::vec3> tooMany(bytesAvailable / sizeof(glm::vec3) + 1);
+    QVERIFY(!packetData.appendValue(tooMany));
+    QCOMPARE(packetData.getBytesAvailable(), bytesAvailable);
+}
@@ -11,6 +11,9 @@
 
 #include "ViewFrustumTests.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include <GLMHelpers.h>
@@ -790,6 +793,67 @@ void ViewFrustumTests::testBoxIntersectsFrustum() {
     QCOMPARE(view.boxIntersectsFrustum(box), false); // outside
 }
 
+void ViewFrustumTests::testBoxesIntersectFrustum() {
+    float aspect = 1.0f;
+    float fovX = PI / 2.0f;
+    float nearClip = 1.0f;
+    float farClip = 100.0f;
+    float holeRadius = 10.0f;
+
+    glm::vec3 center = glm::vec3(12.3f, 4.56f, 89.7f);
+    glm::quat rotation = glm::angleAxis(PI / 7.0f, Vectors::UNIT_Y);
+
+    ViewFrustum view;
+    view.setProjection(glm::perspective(fovX, aspect, nearClip, farClip));
+    view.setPosition(center);
+    view.setOrientation(rotation);
+    view.setCenterRadius(holeRadius);
+    view.calculate();
+
+    // a grid of boxes all around the view, straddling its planes, and not a multiple of 4 of them
+    glm::vec3 boxScale = glm::vec3(2.68f, 1.78f, 0.431f);
+    std::vector<AABox> boxes;
+    const int GRID_SIZE = 11;
+    const float GRID_STEP = 2.0f * farClip / (float)(GRID_SIZE - 1);
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            for (int k = 0; k < GRID_SIZE; ++k) {
+                glm::vec3 offset = glm::vec3((float)i, (float)j, (float)k) * GRID_STEP - glm::vec3(farClip);
+                boxes.emplace_back(center + offset - 0.5f * boxScale, boxScale);
+            }
+        }
+    }
+    // and some exactly on the planes
+    boxes.emplace_back(center + rotation * (farClip * localForward) - 0.5f * boxScale, boxScale);
+    boxes.emplace_back(center + rotation * (nearClip * localForward) - 0.5f * boxScale, boxScale);
+    boxes.emplace_back(center + rotation * ((farClip + boxScale.x) * localForward) - 0.5f * boxScale, boxScale);
+
+    AABoxArrays arrays;
+    arrays.resize(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        arrays.set(i, boxes[i]);
+    }
+
+    std::vector<uint8_t> inFrustum(boxes.size(), 2);
+    view.boxesIntersectFrustum(arrays, 0, boxes.size(), inFrustum.data());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        QCOMPARE((bool)inFrustum[i], view.boxIntersectsFrustum(boxes[i]));
+    }
+
+    // a range not starting at 0 only writes its own results
+    const size_t BEGIN = 5;
+    const size_t END = 18;
+    std::fill(inFrustum.begin(), inFrustum.end(), 2);
+    view.boxesIntersectFrustum(arrays, BEGIN, END, inFrustum.data());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (i < BEGIN || i >= END) {
+            QCOMPARE(inFrustum[i], (uint8_t)2);
+        } else {
+            QCOMPARE((bool)inFrustum[i], view.boxIntersectsFrustum(boxes[i]));
+        }
+    }
+}
+
 void ViewFrustumTests::testSphereIntersectsKeyhole() {
     float aspect = 1.0f;
     float fovX = PI / 2.0f;
@@ -1345,3 +1409,65 @@ void ViewFrustumTests::testBoxIntersectsKeyhole() {
     box.setBox(boxCenter - halfScaleOffset, boxScale);
     QCOMPARE(view.boxIntersectsKeyhole(box), false); // outside back
 }
+
+void ViewFrustumTests::testBoxesIntersectKeyhole() {
+    float aspect = 1.0f;
+    float fovX = PI / 2.0f;
+    float nearClip = 1.0f;
+    float farClip = 100.0f;
+    float holeRadius = 10.0f;
+
+    glm::vec3 center = glm::vec3(12.3f, 4.56f, 89.7f);
+    glm::quat rotation = glm::angleAxis(PI / 7.0f, Vectors::UNIT_Y);
+
+    ViewFrustum view;
+    view.setProjection(glm::perspective(fovX, aspect, nearClip, farClip));
+    view.setPosition(center);
+    view.setOrientation(rotation);
+    view.setCenterRadius(holeRadius);
+    view.calculate();
+
+    // a grid of boxes all around the view, and a finer one around the hole, not a multiple of 4 of them
+    glm::vec3 boxScale = glm::vec3(2.68f, 1.78f, 0.431f);
+    std::vector<AABox> boxes;
+    const int GRID_SIZE = 11;
+    const float GRID_STEP = 2.0f * farClip / (float)(GRID_SIZE - 1);
+    const float HOLE_GRID_STEP = 3.0f * holeRadius / (float)(GRID_SIZE - 1);
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            for (int k = 0; k < GRID_SIZE; ++k) {
+                glm::vec3 index = glm::vec3((float)i, (float)j, (float)k);
+                boxes.emplace_back(center + index * GRID_STEP - glm::vec3(farClip) - 0.5f * boxScale, boxScale);
+                boxes.emplace_back(center + index * HOLE_GRID_STEP - glm::vec3(1.5f * holeRadius) - 0.5f * boxScale,
+                                   boxScale);
+            }
+        }
+    }
+    // and one exactly on the back of the hole
+    boxes.emplace_back(center - rotation * (holeRadius * localForward), boxScale);
+
+    AABoxArrays arrays;
+    arrays.resize(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        arrays.set(i, boxes[i]);
+    }
+
+    std::vector<uint8_t> inKeyhole(boxes.size(), 2);
+    view.boxesIntersectKeyhole(arrays, 0, boxes.size(), inKeyhole.data());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        QCOMPARE((bool)inKeyhole[i], view.boxIntersectsKeyhole(boxes[i]));
+    }
+
+    // a range not starting at 0 only writes its own results
+    const size_t BEGIN = 7;
+    const size_t END = 30;
+    std::fill(inKeyhole.begin(), inKeyhole.end(), 2);
+    view.boxesIntersectKeyhole(arrays, BEGIN, END, inKeyhole.data());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (i < BEGIN || i >= END) {
+            QCOMPARE(inKeyhole[i], (uint8_t)2);
+        } else {
+            QCOMPARE((bool)inKeyhole[i], view.boxIntersectsKeyhole(boxes[i]));
+        }
+    }
+}
@@ -24,9 +24,11 @@ private slots:
     void testPointIntersectsFrustum();
     void testSphereIntersectsFrustum();
     void testBoxIntersectsFrustum();
+    void testBoxesIntersectFrustum();
     void testSphereIntersectsKeyhole();
     void testCubeIntersectsKeyhole();
     void testBoxIntersectsKeyhole();
+    void testBoxesIntersectKeyhole();
 };
 
 #endif // hifi_ViewFruxtumTests_h
@@ -0,0 +1,305 @@
+//
+//  PerfSuite.cpp
+//  tests/perf-suite/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PerfSuite.h"
+
+#include <algorithm>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QProcess>
+#include <QtCore/QSysInfo>
+#include <QtCore/QThread>
+
+#include <NumericalConstants.h>
+
+#include <../BenchmarkUtils.h>
+
+namespace {
+    const QString METRICS_KEY = "metrics";
+    const QString HOST_KEY = "host";
+    const QString BENCHMARKS_KEY = "benchmarks";
+
+    QString hostDescription() {
+        return QString("%1 %2, %3 threads").arg(QSysInfo::prettyProductName(), QSysInfo::currentCpuArchitecture())
+            .arg(QThread::idealThreadCount());
+    }
+}
+
+const std::map<QString, PerfSuite::BenchmarkKind>& PerfSuite::benchmarkKinds() {
+    static const std::map<QString, BenchmarkKind> kinds {
+        { "hrtf", { benchmark::HRTF_BENCHMARK_JSON, { "sources" } } },
+        { "avatars", { benchmark::AVATAR_BENCHMARK_JSON, { "detail", "avatars", "joints" } } },
+        { "entities", { benchmark::ENTITY_BENCHMARK_JSON, { "operation", "entities" } } },
+        { "anim", { benchmark::ANIM_BENCHMARK_JSON, { "rigs" } } },
+        { "physics", { benchmark::PHYSICS_BENCHMARK_JSON, { "bodies" } } },
+        { "textures", { benchmark::TEXTURE_BENCHMARK_JSON, { "path", "size" } } }
+    };
+    return kinds;
+}
+
+bool PerfSuite::isGatedField(const QString& field) {
+    // averages only, the tails of the distributions move too much from run to run to fail on
+    if (!field.startsWith("mean") && !field.startsWith("p50")) {
+        return false;
+    }
+    return field.contains("Usecs") || field.contains("Msecs") || field.contains("Bytes");
+}
+
+int PerfSuite::run(const QStringList& arguments) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity performance regression suite");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    QStringList benchmarkNames;
+    for (const auto& kind : benchmarkKinds()) {
+        benchmarkNames << kind.first;
+    }
+    const QCommandLineOption benchmarkOption("benchmark", "a benchmark to run, one of " + benchmarkNames.join(", "),
+                                             "name=executable");
+    parser.addOption(benchmarkOption);
+
+    const QCommandLineOption outputOption("output", "directory to write the results and logs of the benchmarks to",
+                                          "directory", "perf-suite-results");
+    parser.addOption(outputOption);
+
+    const QCommandLineOption baselineOption("baseline", "results of an earlier run to compare to", "path");
+    parser.addOption(baselineOption);
+
+    const QCommandLineOption updateBaselineOption("update-baseline", "write the results as the new baseline");
+    parser.addOption(updateBaselineOption);
+
+    const QCommandLineOption toleranceOption("tolerance", "percent a metric may grow over the baseline",
+                                             "percent", QString::number(_tolerance * 100.0));
+    parser.addOption(toleranceOption);
+
+    const QCommandLineOption timeoutOption("timeout", "seconds a benchmark may run for", "seconds",
+                                           QString::number(_timeoutSeconds));
+    parser.addOption(timeoutOption);
+
+    if (!parser.parse(arguments)) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp(1);
+    }
+
+    if (parser.isSet(helpOption) || !parser.isSet(benchmarkOption)) {
+        parser.showHelp();
+    }
+
+    for (const auto& value : parser.values(benchmarkOption)) {
+        int equalsIndex = value.indexOf('=');
+        Benchmark benchmark { value.left(equalsIndex), value.mid(equalsIndex + 1) };
+        if (equalsIndex <= 0 || benchmarkKinds().find(benchmark.name) == benchmarkKinds().end()) {
+            qCritical() << "Unknown benchmark" << value;
+            parser.showHelp(1);
+        }
+        _benchmarks.push_back(benchmark);
+    }
+    _outputDirectory = QDir(parser.value(outputOption)).absolutePath();
+    _baselinePath = parser.value(baselineOption);
+    _tolerance = std::max(parser.value(toleranceOption).toDouble(), 0.0) / 100.0;
+    _timeoutSeconds = std::max(parser.value(timeoutOption).toInt(), 1);
+    bool isUpdatingBaseline = parser.isSet(updateBaselineOption);
+
+    if (!QDir().mkpath(_outputDirectory)) {
+        qCritical() << "Could not create the output directory" << _outputDirectory;
+        return 1;
+    }
+
+    bool isPassing = true;
+    QJsonObject benchmarkResults;
+    for (const auto& benchmark : _benchmarks) {
+        QJsonObject results;
+        if (runBenchmark(benchmark, results)) {
+            addMetrics(benchmark.name, results);
+            benchmarkResults[benchmark.name] = results;
+        } else {
+            isPassing = false;
+        }
+    }
+
+    QJsonObject metrics;
+    for (const auto& metric : _metrics) {
+        metrics[metric.first] = metric.second;
+    }
+    QJsonObject suiteResults;
+    suiteResults["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    suiteResults[HOST_KEY] = hostDescription();
+    suiteResults[METRICS_KEY] = metrics;
+    suiteResults[BENCHMARKS_KEY] = benchmarkResults;
+    isPassing = writeJson(_outputDirectory + "/perf-suite.json", suiteResults) && isPassing;
+
+    if (isUpdatingBaseline) {
+        if (!isPassing) {
+            qCritical() << "Not updating the baseline, a benchmark failed";
+            return 1;
+        }
+        if (_baselinePath.isEmpty() || !writeJson(_baselinePath, suiteResults)) {
+            qCritical() << "Could not write the baseline" << _baselinePath;
+            return 1;
+        }
+        qInfo().noquote() << "Wrote the baseline" << _baselinePath;
+        return 0;
+    }
+
+    QFile baselineFile(_baselinePath);
+    if (_baselinePath.isEmpty() || !baselineFile.open(QIODevice::ReadOnly)) {
+        // nothing to compare to yet, the results stand as they are
+        qInfo().noquote() << "No baseline at" << _baselinePath << "to compare to, record one with --update-baseline";
+        for (const auto& metric : _metrics) {
+            qInfo().noquote() << QString("%1 %2").arg(metric.first, -72).arg(metric.second, 12, 'f', 3);
+        }
+        return isPassing ? 0 : 1;
+    }
+
+    QJsonParseError error;
+    QJsonObject baseline = QJsonDocument::fromJson(baselineFile.readAll(), &error).object();
+    if (error.error != QJsonParseError::NoError) {
+        qCritical() << "Could not parse the baseline" << _baselinePath << error.errorString();
+        return 1;
+    }
+    if (baseline[HOST_KEY].toString() != hostDescription()) {
+        qWarning().noquote() << "The baseline was recorded on" << baseline[HOST_KEY].toString()
+                             << "and this is" << hostDescription() << "- the timings may not compare";
+    }
+
+    isPassing = compareToBaseline(baseline) && isPassing;
+    qInfo().noquote() << (isPassing ? "PASSED" : "FAILED");
+    return isPassing ? 0 : 1;
+}
+
+bool PerfSuite::runBenchmark(const Benchmark& benchmark, QJsonObject& resultsOut) {
+    const auto& kind = benchmarkKinds().at(benchmark.name);
+    QString jsonPath = _outputDirectory + "/" + benchmark.name + ".json";
+    QString logPath = _outputDirectory + "/" + benchmark.name + ".log";
+    QFile::remove(jsonPath);
+
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert(kind.jsonEnvironmentVariable, jsonPath);
+    if (!environment.contains("QT_QPA_PLATFORM")) {
+        // the benchmarks run headless, on build machines without a display
+        environment.insert("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QProcess process;
+    process.setProcessEnvironment(environment);
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.setStandardOutputFile(logPath);
+
+    qInfo().noquote() << "Running" << benchmark.name << benchmark.executablePath;
+    QElapsedTimer timer;
+    timer.start();
+    process.start(benchmark.executablePath, QStringList());
+    if (!process.waitForFinished(_timeoutSeconds * (int)MSECS_PER_SECOND)) {
+        qCritical().noquote() << benchmark.name << "did not finish:" << process.errorString() << "- see" << logPath;
+        process.kill();
+        process.waitForFinished();
+        return false;
+    }
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+        qCritical().noquote() << benchmark.name << "failed with exit code" << process.exitCode() << "- see" << logPath;
+        return false;
+    }
+
+    QFile jsonFile(jsonPath);
+    if (!jsonFile.open(QIODevice::ReadOnly)) {
+        qCritical().noquote() << benchmark.name << "wrote no results to" << jsonPath;
+        return false;
+    }
+    resultsOut = QJsonDocument::fromJson(jsonFile.readAll()).object();
+    qInfo().noquote() << benchmark.name << "finished in" << (timer.elapsed() / (qint64)MSECS_PER_SECOND) << "seconds";
+    return !resultsOut.isEmpty();
+}
+
+void PerfSuite::addMetrics(const QString& benchmarkName, const QJsonObject& results) {
+    const auto& keyFields = benchmarkKinds().at(benchmarkName).keyFields;
+    for (const auto& resultValue : results["results"].toArray()) {
+        QJsonObject result = resultValue.toObject();
+
+        QStringList key;
+        for (const auto& keyField : keyFields) {
+            if (result.contains(keyField)) {
+                key << keyField + "=" + result[keyField].toVariant().toString();
+            }
+        }
+        QString prefix = benchmarkName + "/" + key.join(",") + "/";
+
+        for (auto field = result.begin(); field != result.end(); ++field) {
+            if (field.value().isDouble() && !keyFields.contains(field.key())) {
+                _metrics[prefix + field.key()] = field.value().toDouble();
+            }
+        }
+    }
+}
+
+bool PerfSuite::compareToBaseline(const QJsonObject& baseline) {
+    QJsonObject baselineMetrics = baseline[METRICS_KEY].toObject();
+    bool isPassing = true;
+    int numRegressions = 0;
+
+    qInfo().noquote() << QString("%1 %2 %3 %4").arg("metric", -72).arg("baseline", 12).arg("current", 12).arg("change", 9);
+    for (const auto& metric : _metrics) {
+        const QString& name = metric.first;
+        double current = metric.second;
+        if (!baselineMetrics.contains(name)) {
+            qInfo().noquote() << QString("%1 %2 %3").arg(name, -72).arg("-", 12).arg(current, 12, 'f', 3) << "(new)";
+            continue;
+        }
+
+        double previous = baselineMetrics[name].toDouble();
+        double change = previous > 0.0 ? (current - previous) / previous : 0.0;
+        QString line = QString("%1 %2 %3 %4%").arg(name, -72).arg(previous, 12, 'f', 3).arg(current, 12, 'f', 3)
+            .arg(100.0 * change, 8, 'f', 1);
+
+        if (isGatedField(name.section('/', -1)) && change > _tolerance) {
+            qCritical().noquote() << line << "REGRESSED";
+            numRegressions++;
+            isPassing = false;
+        } else {
+            qInfo().noquote() << line;
+        }
+    }
+
+    // a metric that went missing is a benchmark that no longer measures what the baseline holds it to
+    for (auto metric = baselineMetrics.begin(); metric != baselineMetrics.end(); ++metric) {
+        if (_metrics.find(metric.key()) == _metrics.end() && isGatedField(metric.key().section('/', -1))) {
+            QString benchmarkName = metric.key().section('/', 0, 0);
+            bool wasRun = std::any_of(_benchmarks.begin(), _benchmarks.end(), [&](const Benchmark& benchmark) {
+                return benchmark.name == benchmarkName;
+            });
+            if (wasRun) {
+                qWarning().noquote() << metric.key() << "is in the baseline but was not measured";
+            }
+        }
+    }
+
+    if (numRegressions > 0) {
+        qCritical().noquote() << numRegressions << "metrics regressed by more than"
+                              << QString::number(100.0 * _tolerance) + "%";
+    }
+    return isPassing;
+}
+
+bool PerfSuite::writeJson(const QString& path, const QJsonObject& object) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical() << "Could not write" << path;
+        return false;
+    }
+    file.write(QJsonDocument(object).toJson());
+    return true;
+}
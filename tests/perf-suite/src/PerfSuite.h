@@ -0,0 +1,60 @@
+//
+//  PerfSuite.h
+//  tests/perf-suite/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PerfSuite_h
+#define hifi_PerfSuite_h
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+// Runs the benchmark testcases of the hot paths (HRTF mixing, avatar and entity encoding, octree queries, anim graph
+// evaluation, physics stepping and texture processing), each writing its results as JSON, and compares them to a
+// baseline recorded on the same machine: a mean or median time, or mean size, that grew past the tolerance fails it.
+//   A metric is named <benchmark>/<key>=<value>,.../<field>, by the fields that tell a result of a benchmark apart
+//   (the number of sources, of bodies, ...) and the field measured. The p99 and max times are reported, but too
+//   noisy to fail on.
+class PerfSuite {
+public:
+    // returns the exit code: non-zero if a benchmark failed or regressed
+    int run(const QStringList& arguments);
+
+private:
+    struct Benchmark {
+        QString name;
+        QString executablePath;
+    };
+
+    struct BenchmarkKind {
+        const char* jsonEnvironmentVariable;
+        QStringList keyFields;
+    };
+
+    static const std::map<QString, BenchmarkKind>& benchmarkKinds();
+    static bool isGatedField(const QString& field);
+
+    bool runBenchmark(const Benchmark& benchmark, QJsonObject& resultsOut);
+    void addMetrics(const QString& benchmarkName, const QJsonObject& results);
+    bool compareToBaseline(const QJsonObject& baseline);
+    bool writeJson(const QString& path, const QJsonObject& object);
+
+    std::vector<Benchmark> _benchmarks;
+    QString _outputDirectory;
+    QString _baselinePath;
+    double _tolerance { 0.15 };
+    int _timeoutSeconds { 1800 };
+
+    std::map<QString, double> _metrics;
+};
+
+#endif // hifi_PerfSuite_h
@@ -0,0 +1,19 @@
+//
+//  main.cpp
+//  tests/perf-suite/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QtCore/QCoreApplication>
+
+#include "PerfSuite.h"
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    PerfSuite suite;
+    return suite.run(app.arguments());
+}
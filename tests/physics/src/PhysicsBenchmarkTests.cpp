@@ -0,0 +1,224 @@
+//
+//  PhysicsBenchmarkTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsBenchmarkTests.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
+#include <BulletUtil.h>
+#include <ObjectMotionState.h>
+#include <PhysicsCollisionGroups.h>
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <ShapeManager.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(PhysicsBenchmarkTests)
+
+using namespace benchmark;
+
+namespace {
+    const int BODIES_PER_ROW = 10;
+    const float BODY_SPACING = 1.5f; // meters
+    const float FLOOR_HALF_SIZE = 50.0f; // meters
+    const glm::vec3 GRAVITY(0.0f, -9.8f, 0.0f);
+
+    // a body that isn't anything but itself, the ObjectMotionState of no entity nor avatar
+    class BenchmarkMotionState : public ObjectMotionState {
+    public:
+        BenchmarkMotionState(const btCollisionShape* shape, PhysicsMotionType motionType, const glm::vec3& position) :
+            ObjectMotionState(shape),
+            _position(position),
+            _id(QUuid::createUuid())
+        {
+            _motionType = motionType;
+            if (motionType == MOTION_TYPE_DYNAMIC) {
+                _mass = 1.0f;
+            }
+        }
+
+        virtual uint32_t getIncomingDirtyFlags() override { return 0; }
+        virtual void clearIncomingDirtyFlags() override { }
+
+        virtual PhysicsMotionType computePhysicsMotionType() const override { return _motionType; }
+        virtual bool isMoving() const override { return _motionType == MOTION_TYPE_DYNAMIC; }
+
+        virtual void getWorldTransform(btTransform& worldTrans) const override {
+            worldTrans.setOrigin(glmToBullet(_position - ObjectMotionState::getWorldOffset()));
+            worldTrans.setRotation(glmToBullet(_rotation));
+        }
+
+        virtual void setWorldTransform(const btTransform& worldTrans) override {
+            _position = bulletToGLM(worldTrans.getOrigin()) + ObjectMotionState::getWorldOffset();
+            _rotation = bulletToGLM(worldTrans.getRotation());
+        }
+
+        virtual float getObjectRestitution() const override { return 0.5f; }
+        virtual float getObjectFriction() const override { return 0.5f; }
+        virtual float getObjectLinearDamping() const override { return 0.1f; }
+        virtual float getObjectAngularDamping() const override { return 0.1f; }
+
+        virtual glm::vec3 getObjectPosition() const override { return _position; }
+        virtual glm::quat getObjectRotation() const override { return _rotation; }
+        virtual glm::vec3 getObjectLinearVelocity() const override { return glm::vec3(0.0f); }
+        virtual glm::vec3 getObjectAngularVelocity() const override { return glm::vec3(0.0f); }
+        virtual glm::vec3 getObjectGravity() const override {
+            return _motionType == MOTION_TYPE_DYNAMIC ? GRAVITY : glm::vec3(0.0f);
+        }
+
+        virtual const QUuid getObjectID() const override { return _id; }
+        virtual QUuid getSimulatorID() const override { return QUuid(); }
+
+        virtual void computeCollisionGroupAndMask(int16_t& group, int16_t& mask) const override {
+            group = _motionType == MOTION_TYPE_DYNAMIC ? BULLET_COLLISION_GROUP_DYNAMIC : BULLET_COLLISION_GROUP_STATIC;
+            mask = Physics::getDefaultCollisionMask(group);
+        }
+
+    protected:
+        virtual bool isReadyToComputeShape() const override { return true; }
+        // the bodies of the benchmark are never reshaped
+        virtual const btCollisionShape* computeNewShape() override { return nullptr; }
+
+    private:
+        glm::vec3 _position;
+        glm::quat _rotation;
+        QUuid _id;
+    };
+
+    // the four kinds of shapes the bodies take in turn
+    std::vector<ShapeInfo> createBodyShapeInfos() {
+        std::vector<ShapeInfo> infos(4);
+        infos[0].setBox(glm::vec3(0.25f, 0.25f, 0.25f));
+        infos[1].setSphere(0.3f);
+        infos[2].setCapsuleY(0.2f, 0.2f);
+
+        // two tetrahedral hulls side by side
+        ShapeInfo::PointCollection pointCollection;
+        for (float offset : { -0.2f, 0.2f }) {
+            ShapeInfo::PointList hull;
+            hull.push_back(glm::vec3(offset + 0.2f, 0.2f, 0.2f));
+            hull.push_back(glm::vec3(offset + 0.2f, -0.2f, -0.2f));
+            hull.push_back(glm::vec3(offset - 0.2f, 0.2f, -0.2f));
+            hull.push_back(glm::vec3(offset - 0.2f, -0.2f, 0.2f));
+            pointCollection.push_back(hull);
+        }
+        infos[3].setParams(SHAPE_TYPE_COMPOUND, glm::vec3(0.4f, 0.2f, 0.2f));
+        infos[3].setPointCollection(pointCollection);
+        return infos;
+    }
+}
+
+void PhysicsBenchmarkTests::initTestCase() {
+    _numBodies = countsFromEnvironment("HIFI_PHYSICS_BENCHMARK_BODIES", _numBodies);
+    _numFrames = std::max(1, intFromEnvironment("HIFI_PHYSICS_BENCHMARK_FRAMES", _numFrames));
+}
+
+void PhysicsBenchmarkTests::stepScenesBenchmark() {
+    std::vector<ShapeInfo> shapeInfos = createBodyShapeInfos();
+    ShapeInfo floorInfo;
+    floorInfo.setBox(glm::vec3(FLOOR_HALF_SIZE, 0.5f, FLOOR_HALF_SIZE));
+
+    for (int numBodies : _numBodies) {
+        MemoryInfo memoryBefore;
+        bool hasMemoryInfo = getMemoryInfo(memoryBefore);
+
+        // the ShapeManager outlives the MotionStates, which release their shapes to it
+        ShapeManager shapeManager;
+        ObjectMotionState::setShapeManager(&shapeManager);
+        PhysicsEngine engine(glm::vec3(0.0f));
+        engine.init();
+
+        VectorOfMotionStates motionStates;
+        motionStates.push_back(new BenchmarkMotionState(shapeManager.getShape(floorInfo), MOTION_TYPE_STATIC,
+                glm::vec3(0.0f, -0.5f, 0.0f)));
+        for (int i = 0; i < numBodies; ++i) {
+            int row = i % BODIES_PER_ROW;
+            int column = (i / BODIES_PER_ROW) % BODIES_PER_ROW;
+            int layer = i / (BODIES_PER_ROW * BODIES_PER_ROW);
+            glm::vec3 position = BODY_SPACING * glm::vec3(row - BODIES_PER_ROW / 2, layer + 1, column - BODIES_PER_ROW / 2);
+            const btCollisionShape* shape = shapeManager.getShape(shapeInfos[i % shapeInfos.size()]);
+            QVERIFY(shape != nullptr);
+            motionStates.push_back(new BenchmarkMotionState(shape, MOTION_TYPE_DYNAMIC, position));
+        }
+        engine.addObjects(motionStates);
+
+        MemoryInfo memoryAfter;
+        hasMemoryInfo = hasMemoryInfo && getMemoryInfo(memoryAfter);
+
+        // frames come at the rate of the substeps, as they would at 90 Hz, so that every step simulates one
+        const quint64 FRAME_USECS = (quint64)(PHYSICS_ENGINE_FIXED_SUBSTEP * USECS_PER_SECOND);
+        std::vector<quint64> stepTimes;
+        std::vector<quint64> synchronizeTimes;
+        uint32_t numSubsteps = 0;
+        uint32_t maxContacts = 0;
+        for (int frame = 0; frame < _numFrames; ++frame) {
+            quint64 frameStart = usecTimestampNow();
+            engine.stepSimulation();
+            if (engine.hasOutgoingChanges()) {
+                engine.getChangedMotionStates();
+                engine.getCollisionEvents();
+                const PhysicsStats& stats = engine.getStats();
+                stepTimes.push_back(stats.stepTime);
+                synchronizeTimes.push_back(stats.synchronizeTime);
+                numSubsteps += stats.numSubsteps;
+                maxContacts = std::max(maxContacts, stats.numContacts);
+            }
+            quint64 elapsed = usecTimestampNow() - frameStart;
+            if (elapsed < FRAME_USECS) {
+                QThread::usleep((unsigned long)(FRAME_USECS - elapsed));
+            }
+        }
+
+        engine.removeObjects(motionStates);
+        for (auto motionState : motionStates) {
+            delete motionState;
+        }
+        shapeManager.collectGarbage();
+
+        std::sort(stepTimes.begin(), stepTimes.end());
+        quint64 totalStepTime = 0;
+        for (auto stepTime : stepTimes) {
+            totalStepTime += stepTime;
+        }
+        quint64 totalSynchronizeTime = 0;
+        for (auto synchronizeTime : synchronizeTimes) {
+            totalSynchronizeTime += synchronizeTime;
+        }
+        double numSteps = (double)std::max((size_t)1, stepTimes.size());
+
+        QJsonObject result;
+        result["bodies"] = numBodies;
+        result["frames"] = _numFrames;
+        result["steps"] = (int)stepTimes.size();
+        result["substeps"] = (int)numSubsteps;
+        result["meanStepMsecs"] = (double)totalStepTime / numSteps / USECS_PER_MSEC;
+        result["p50StepMsecs"] = percentile(stepTimes, 0.50) / USECS_PER_MSEC;
+        result["p99StepMsecs"] = percentile(stepTimes, 0.99) / USECS_PER_MSEC;
+        result["meanSynchronizeMsecs"] = (double)totalSynchronizeTime / numSteps / USECS_PER_MSEC;
+        result["maxContacts"] = (int)maxContacts;
+        if (hasMemoryInfo) {
+            result["sceneMemoryBytes"] =
+                (double)memoryAfter.processUsedMemoryBytes - (double)memoryBefore.processUsedMemoryBytes;
+        }
+        _results.add(result);
+
+        QVERIFY2(!stepTimes.empty(), "the simulation was never stepped");
+        QCOMPARE(shapeManager.getNumShapes(), 0);
+    }
+}
+
+void PhysicsBenchmarkTests::cleanupTestCase() {
+    QJsonObject root;
+    root["frames"] = _numFrames;
+    QVERIFY2(_results.write(root), "could not write the JSON output file");
+}
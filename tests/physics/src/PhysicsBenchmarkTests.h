@@ -0,0 +1,38 @@
+//
+//  PhysicsBenchmarkTests.h
+//  tests/physics/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsBenchmarkTests_h
+#define hifi_PhysicsBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <../BenchmarkUtils.h>
+
+// Cost of stepping the PhysicsEngine through scenes of dynamic boxes, spheres, capsules and hull compounds
+// piling up on a floor, at growing numbers of bodies.  Configured through the environment:
+//   HIFI_PHYSICS_BENCHMARK_BODIES   comma separated numbers of bodies of the scenes (default 100,400,1600)
+//   HIFI_PHYSICS_BENCHMARK_FRAMES   frames stepped per scene, at the rate of the fixed substep (default 300)
+//   HIFI_PHYSICS_BENCHMARK_JSON     path to write the results to as JSON (default is log output only)
+// The engines run one at a time: Bullet's profiler is global, so they can't be stepped on several threads.
+class PhysicsBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void stepScenesBenchmark();
+    void cleanupTestCase();
+
+private:
+    QVector<int> _numBodies { 100, 400, 1600 };
+    int _numFrames { 300 };
+
+    benchmark::BenchmarkResults _results { benchmark::PHYSICS_BENCHMARK_JSON };
+};
+
+#endif // hifi_PhysicsBenchmarkTests_h
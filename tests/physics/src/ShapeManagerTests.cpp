@@ -243,3 +243,58 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::addStaticMeshInstances() {
+    // a tetrahedron of triangles
+    ShapeInfo::PointList points;
+    points.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+    points.push_back(glm::vec3(1.0f, -1.0f, -1.0f));
+    points.push_back(glm::vec3(-1.0f, 1.0f, -1.0f));
+    points.push_back(glm::vec3(-1.0f, -1.0f, 1.0f));
+    ShapeInfo::TriangleIndices triangleIndices = { 0, 1, 2, 0, 3, 1, 0, 2, 3, 1, 3, 2 };
+
+    // the same model at two scales
+    const QString url("http://example.com/tetrahedron.fbx");
+    ShapeInfo infoA;
+    ShapeInfo infoB;
+    float scales[] = { 1.0f, 3.0f };
+    ShapeInfo* infos[] = { &infoA, &infoB };
+    for (int i = 0; i < 2; ++i) {
+        ShapeInfo::PointList scaledPoints;
+        for (const auto& point : points) {
+            scaledPoints.push_back(scales[i] * point);
+        }
+        ShapeInfo::PointCollection pointCollection;
+        pointCollection.push_back(scaledPoints);
+        infos[i]->setPointCollection(pointCollection);
+        infos[i]->getTriangleIndices() = triangleIndices;
+        infos[i]->setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(scales[i]), url);
+    }
+
+    ShapeManager shapeManager;
+    const btCollisionShape* shapeA = shapeManager.getShape(infoA);
+    const btCollisionShape* shapeB = shapeManager.getShape(infoB);
+    QVERIFY(shapeA != nullptr);
+    QVERIFY(shapeB != nullptr);
+    QVERIFY(shapeA != shapeB);
+    QCOMPARE(shapeA->getShapeType(), (int)SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE);
+
+    // both are instances of the one unit mesh
+    const btTriangleMeshShape* meshA = static_cast<const btScaledBvhTriangleMeshShape*>(shapeA)->getChildShape();
+    const btTriangleMeshShape* meshB = static_cast<const btScaledBvhTriangleMeshShape*>(shapeB)->getChildShape();
+    QCOMPARE(meshA, meshB);
+    QCOMPARE(shapeManager.getNumShapes(), 3);
+    QCOMPARE(shapeManager.getNumReferences(meshA), 2);
+    QCOMPARE(shapeManager.getNumReferences(infoA), 1);
+
+    // the unit mesh outlives the first instance to be collected...
+    shapeManager.releaseShape(shapeA);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 2);
+    QCOMPARE(shapeManager.getNumReferences(meshB), 1);
+
+    // ...but not the last
+    shapeManager.releaseShape(shapeB);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+}
@@ -1,5 +1,6 @@
 #include <QtGlobal>
 #include <QtTest/QtTest>
+#include <QtCore/QFileInfo>
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QString>
 
@@ -97,6 +98,44 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testChunkedPersist() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // enough slowly changing frames, like those of an avatar, for several chunks
+    auto writeClip = Clip::newClip();
+    const int FRAME_COUNT = 5000;
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        QByteArray data(200 + (i % 3), 'a');
+        data[i % data.size()] = (char)i;
+        data.append(QByteArray::number(i));
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i / 90.0f, data));
+    }
+    Clip::toFile(fileName, writeClip);
+    QVERIFY(QFileInfo(fileName).size() < (qint64)(FRAME_COUNT * 200 / 4));
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == (size_t)FRAME_COUNT);
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    // seeking into the middle of a chunk reads the frame out of the differences of those before it
+    readClip->seek(3000.0f / 90.0f);
+    writeClip->seek(3000.0f / 90.0f);
+    size_t count = 0;
+    for (auto readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(); readFrame && writeFrame;
+        readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(), ++count) {
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+    QVERIFY(count > 0);
+}
+
 #ifdef Q_OS_WIN32
 void myMessageHandler(QtMsgType type, const QMessageLogContext & context, const QString & msg) {
     OutputDebugStringA(msg.toLocal8Bit().toStdString().c_str());
@@ -111,4 +150,5 @@ int main(int, const char**) {
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testChunkedPersist();
 }
\ No newline at end of file
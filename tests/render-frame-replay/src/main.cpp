@@ -0,0 +1,191 @@
+//
+//  main.cpp
+//  tests/render-frame-replay/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include <QtGui/QGuiApplication>
+#include <QtGui/QWindow>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <gl/Config.h>
+#include <gl/Context.h>
+#include <gl/GLHelpers.h>
+
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/FrameIO.h>
+#include <gpu/Framebuffer.h>
+#include <gpu/Query.h>
+#include <gpu/StandardShaderLib.h>
+#include <gpu/gl/GLBackend.h>
+
+extern QThread* RENDER_THREAD;
+
+static const int DEFAULT_ITERATIONS { 200 };
+// as many as the samples gpu::RangeTimer averages
+static const int MEASURED_ITERATIONS { 8 };
+
+// Replays a frame captured with Developer > Render > Capture Frame as often as asked, then reports the CPU time
+// the backend spent on each of its batches, and the GPU time they took, averaged over the last replays
+class ReplayWindow : public QWindow {
+public:
+    ReplayWindow(const QString& filename, int iterations) : _iterations(iterations) {
+        setSurfaceType(QSurface::OpenGLSurface);
+        setGeometry(QRect(QPoint(), QSize(800, 600)));
+        create();
+        show();
+        QCoreApplication::processEvents();
+
+        RENDER_THREAD = QThread::currentThread();
+        _context.setWindow(this);
+        _context.create();
+        _context.makeCurrent();
+        gpu::Context::init<gpu::gl::GLBackend>();
+        _gpuContext = std::make_shared<gpu::Context>();
+
+        // the frame's programs are made as it's read, with the context current
+        _frame = gpu::readFrame(filename.toStdString());
+        if (!_frame) {
+            qWarning() << "Can't replay" << filename;
+            QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+            return;
+        }
+        qDebug() << "Replaying frame" << _frame->frameIndex << "with" << _frame->batches.size() << "batches," << _iterations << "times";
+
+        for (size_t i = 0; i < _frame->batches.size(); ++i) {
+            _batchTimers.emplace_back(new gpu::RangeTimer("batch " + std::to_string(i)));
+        }
+        _batchCPUTimes.resize(_frame->batches.size(), 0);
+
+        {
+            auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+            auto ps = gpu::StandardShaderLib::getDrawTexturePS();
+            gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+            gpu::Shader::makeProgram(*program);
+            _presentPipeline = gpu::Pipeline::create(program, std::make_shared<gpu::State>());
+        }
+
+        QTimer* timer = new QTimer(this);
+        timer->setInterval(0);
+        connect(timer, &QTimer::timeout, this, [this] {
+            replay();
+        });
+        timer->start();
+    }
+
+    virtual ~ReplayWindow() {
+        _batchTimers.clear();
+        _frame.reset();
+        _presentPipeline.reset();
+        _gpuContext.reset();
+    }
+
+private:
+    void replay() {
+        _context.makeCurrent();
+        auto& backend = _gpuContext->getBackend();
+        backend->recycle();
+        backend->syncCache();
+        backend->setStereoState(_frame->stereoState);
+
+        // Time the replays of the last few iterations, not those filling the caches and making the GL objects
+        bool measured = (_iteration >= _iterations - MEASURED_ITERATIONS);
+        for (size_t i = 0; i < _frame->batches.size(); ++i) {
+            gpu::Batch beginBatch;
+            _batchTimers[i]->begin(beginBatch);
+            _gpuContext->executeBatch(beginBatch);
+
+            auto start = usecTimestampNow();
+            _gpuContext->executeBatch(_frame->batches[i]);
+            if (measured) {
+                _batchCPUTimes[i] += usecTimestampNow() - start;
+            }
+
+            gpu::Batch endBatch;
+            _batchTimers[i]->end(endBatch);
+            _gpuContext->executeBatch(endBatch);
+        }
+        if (measured) {
+            ++_measuredIterations;
+        }
+
+        present();
+        (void)CHECK_GL_ERROR();
+
+        if (++_iteration == _iterations) {
+            report();
+            qApp->quit();
+        }
+    }
+
+    void present() {
+        auto framebuffer = _frame->framebuffer;
+        if (framebuffer && framebuffer->getRenderBuffer(0)) {
+            gpu::Batch presentBatch;
+            presentBatch.setViewportTransform({ 0, 0, width(), height() });
+            presentBatch.enableStereo(false);
+            presentBatch.resetViewTransform();
+            presentBatch.setFramebuffer(gpu::FramebufferPointer());
+            presentBatch.setResourceTexture(0, framebuffer->getRenderBuffer(0));
+            presentBatch.setPipeline(_presentPipeline);
+            presentBatch.draw(gpu::TRIANGLE_STRIP, 4);
+            _gpuContext->executeBatch(presentBatch);
+        }
+        _context.swapBuffers();
+    }
+
+    void report() {
+        double totalCPU { 0.0 };
+        double totalGPU { 0.0 };
+        qDebug() << "batch, commands, CPU msecs, GPU msecs";
+        for (size_t i = 0; i < _frame->batches.size(); ++i) {
+            double cpu = (double)_batchCPUTimes[i] / (double)std::max(_measuredIterations, 1) / (double)USECS_PER_MSEC;
+            double gpu = _batchTimers[i]->getGPUAverage();
+            qDebug().nospace() << i << ", " << _frame->batches[i].getCommands().size() << ", " << cpu << ", " << gpu;
+            totalCPU += cpu;
+            totalGPU += gpu;
+        }
+        qDebug().nospace() << "total, , " << totalCPU << ", " << totalGPU;
+    }
+
+    gl::Context _context;
+    gpu::ContextPointer _gpuContext;
+    gpu::PipelinePointer _presentPipeline;
+    gpu::FramePointer _frame;
+    std::vector<std::unique_ptr<gpu::RangeTimer>> _batchTimers;
+    std::vector<quint64> _batchCPUTimes;
+    const int _iterations;
+    int _iteration { 0 };
+    int _measuredIterations { 0 };
+};
+
+int main(int argc, char** argv) {
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("RenderFrameReplay");
+    QCoreApplication::setOrganizationName("High Fidelity");
+    QCoreApplication::setOrganizationDomain("highfidelity.com");
+
+    if (argc < 2) {
+        qWarning() << "Usage: render-frame-replay <frame file> [iterations]";
+        return 1;
+    }
+    int iterations = (argc > 2) ? std::max(atoi(argv[2]), 1) : DEFAULT_ITERATIONS;
+
+    ReplayWindow window(QString::fromLocal8Bit(argv[1]), iterations);
+    return app.exec();
+}
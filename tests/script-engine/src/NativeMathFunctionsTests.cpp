@@ -0,0 +1,97 @@
+//
+//  NativeMathFunctionsTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NativeMathFunctionsTests.h"
+
+#include <QtTest/QtTest>
+#include <QtScript/QScriptEngine>
+
+#include <Mat4.h>
+#include <NativeMathFunctions.h>
+#include <Quat.h>
+#include <RegisteredMetaTypes.h>
+#include <Vec3.h>
+
+QTEST_MAIN(NativeMathFunctionsTests)
+
+// a flocking-style inner loop, returning a number summarizing its results
+static const QString MATH_SCRIPT =
+    "(function () {"
+    "    var position = { x: 1, y: 2, z: 3 };"
+    "    var velocity = { x: 0.5, y: -0.25, z: 0.125 };"
+    "    var rotation = Quat.fromPitchYawRollDegrees(10, 20, 30);"
+    "    var transform = Mat4.createFromRotAndTrans(rotation, { x: 4, y: 5, z: 6 });"
+    "    var total = 0;"
+    "    for (var i = 0; i < 1000; i++) {"
+    "        var offset = Vec3.subtract(position, { x: i % 7, y: i % 5, z: i % 3 });"
+    "        var steer = Vec3.multiply(Vec3.normalize(offset), 0.01);"
+    "        velocity = Vec3.sum(velocity, Vec3.multiplyQbyV(rotation, steer));"
+    "        position = Vec3.sum(position, Vec3.multiply(0.1, velocity));"
+    "        rotation = Quat.multiply(rotation, Quat.fromPitchYawRollDegrees(0, 1, 0));"
+    "        total += Vec3.dot(offset, velocity) + Vec3.length(Mat4.transformPoint(transform, position));"
+    "    }"
+    "    return total + Vec3.distance(position, Quat.getForward(rotation));"
+    "})()";
+
+static Vec3 vec3Library;
+static Quat quatLibrary;
+static Mat4 mat4Library;
+
+static void setUpEngine(QScriptEngine& engine, bool isNative) {
+    registerMetaTypes(&engine);
+    engine.globalObject().setProperty("Vec3", engine.newQObject(&vec3Library));
+    engine.globalObject().setProperty("Quat", engine.newQObject(&quatLibrary));
+    engine.globalObject().setProperty("Mat4", engine.newQObject(&mat4Library));
+    if (isNative) {
+        registerNativeMathFunctions(&engine);
+    }
+}
+
+void NativeMathFunctionsTests::initTestCase() {
+    qRegisterMetaType<glm::vec3>("glm::vec3");
+    qRegisterMetaType<glm::quat>("glm::quat");
+    qRegisterMetaType<glm::mat4>("glm::mat4");
+}
+
+void NativeMathFunctionsTests::testMatchesSlots() {
+    QScriptEngine slotEngine;
+    setUpEngine(slotEngine, false);
+    QScriptEngine nativeEngine;
+    setUpEngine(nativeEngine, true);
+
+    QScriptValue slotResult = slotEngine.evaluate(MATH_SCRIPT);
+    QScriptValue nativeResult = nativeEngine.evaluate(MATH_SCRIPT);
+    QVERIFY(!slotEngine.hasUncaughtException());
+    QVERIFY(!nativeEngine.hasUncaughtException());
+    QCOMPARE((float)nativeResult.toNumber(), (float)slotResult.toNumber());
+
+    // the unreplaced methods and constants still come from the QObject
+    QCOMPARE(nativeEngine.evaluate("Vec3.UNIT_X.x").toNumber(), 1.0);
+    QCOMPARE(nativeEngine.evaluate("Vec3.getAngle(Vec3.UNIT_X, Vec3.UNIT_X)").toNumber(), 0.0);
+
+    // a NaN result is still an empty object
+    QVERIFY(!nativeEngine.evaluate("Vec3.normalize(Vec3.ZERO)").property("x").isValid());
+}
+
+void NativeMathFunctionsTests::benchmarkSlots() {
+    QScriptEngine engine;
+    setUpEngine(engine, false);
+    QBENCHMARK {
+        engine.evaluate(MATH_SCRIPT);
+    }
+}
+
+void NativeMathFunctionsTests::benchmarkNative() {
+    QScriptEngine engine;
+    setUpEngine(engine, true);
+    QBENCHMARK {
+        engine.evaluate(MATH_SCRIPT);
+    }
+}
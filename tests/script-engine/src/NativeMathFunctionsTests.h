@@ -0,0 +1,25 @@
+//
+//  NativeMathFunctionsTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NativeMathFunctionsTests_h
+#define hifi_NativeMathFunctionsTests_h
+
+#include <QtCore/QObject>
+
+class NativeMathFunctionsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testMatchesSlots();
+    void benchmarkSlots();
+    void benchmarkNative();
+};
+
+#endif // hifi_NativeMathFunctionsTests_h
@@ -73,6 +73,24 @@ static void testQuatCompression(glm::quat testQuat) {
     QCOMPARE_WITH_ABS_ERROR(q.w, testQuat.w, MAX_COMPONENT_ERROR);
 }
 
+static void testVariablePrecisionQuatCompression(glm::quat testQuat, int bitsPerComponent) {
+
+    // rounded components are off by at most half a step, the missing component adds to that
+    float MAX_COMPONENT_ERROR = 1.5f / (float)((1 << bitsPerComponent) - 1);
+
+    uint64_t value = quantizeOrientationQuat(testQuat, bitsPerComponent);
+    QVERIFY(value < ((uint64_t)1 << numBitsForQuantizedOrientationQuat(bitsPerComponent)));
+
+    glm::quat q = dequantizeOrientationQuat(value, bitsPerComponent);
+    if (glm::dot(q, testQuat) < 0.0f) {
+        q = -q;
+    }
+    QCOMPARE_WITH_ABS_ERROR(q.x, testQuat.x, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.y, testQuat.y, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.z, testQuat.z, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.w, testQuat.w, MAX_COMPONENT_ERROR);
+}
+
 void GLMHelpersTests::testSixByteOrientationCompression() {
     const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
     const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
@@ -105,6 +123,22 @@ void GLMHelpersTests::testSixByteOrientationCompression() {
     testQuatCompression(-(ROT_Z_30 * ROT_X_90 * ROT_Y_180));
 }
 
+void GLMHelpersTests::testVariablePrecisionOrientationCompression() {
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
+    const glm::quat ROT_Z_30 = glm::angleAxis(PI / 6.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    for (int bits = 8; bits <= 15; bits++) {
+        testVariablePrecisionQuatCompression(glm::quat(), bits);
+        testVariablePrecisionQuatCompression(ROT_X_90, bits);
+        testVariablePrecisionQuatCompression(ROT_Y_180, bits);
+        testVariablePrecisionQuatCompression(ROT_Z_30, bits);
+        testVariablePrecisionQuatCompression(ROT_X_90 * ROT_Y_180 * ROT_Z_30, bits);
+        testVariablePrecisionQuatCompression(-(ROT_Y_180 * ROT_Z_30 * ROT_X_90), bits);
+        testVariablePrecisionQuatCompression(-(ROT_Z_30 * ROT_X_90), bits);
+    }
+}
+
 #define LOOPS 500000
 
 void GLMHelpersTests::testSimd() {
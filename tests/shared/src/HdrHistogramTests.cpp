@@ -0,0 +1,53 @@
+//
+//  HdrHistogramTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HdrHistogramTests.h"
+
+#include <HdrHistogram.h>
+
+QTEST_MAIN(HdrHistogramTests)
+
+void HdrHistogramTests::testExactSmallValues() {
+    HdrHistogram histogram;
+    for (uint64_t i = 1; i <= 100; ++i) {
+        histogram.record(i);
+    }
+    QCOMPARE(histogram.getCount(), (uint64_t)100);
+    QCOMPARE(histogram.getMin(), (uint64_t)1);
+    QCOMPARE(histogram.getMax(), (uint64_t)100);
+    QCOMPARE(histogram.getValueAtPercentile(50.0), (uint64_t)50);
+    QCOMPARE(histogram.getValueAtPercentile(99.0), (uint64_t)99);
+    QCOMPARE(histogram.getValueAtPercentile(100.0), (uint64_t)100);
+
+    histogram.reset();
+    QCOMPARE(histogram.getCount(), (uint64_t)0);
+    QCOMPARE(histogram.getValueAtPercentile(50.0), (uint64_t)0);
+}
+
+void HdrHistogramTests::testPercentilesWithinPrecision() {
+    // frame times of 10 ms, with one frame in a hundred stuttering to 50 ms
+    HdrHistogram histogram;
+    for (int i = 0; i < 10000; ++i) {
+        histogram.record(i % 100 == 0 ? 50000 : 10000 + (i % 7));
+    }
+    const double PRECISION = 1.0 / 64.0;
+    QVERIFY(fabs((double)histogram.getValueAtPercentile(50.0) - 10003.0) <= 10003.0 * PRECISION);
+    QVERIFY(fabs((double)histogram.getValueAtPercentile(99.0) - 10006.0) <= 10006.0 * PRECISION);
+    QVERIFY(fabs((double)histogram.getValueAtPercentile(99.9) - 50000.0) <= 50000.0 * PRECISION);
+    QCOMPARE(histogram.getMax(), (uint64_t)50000);
+}
+
+void HdrHistogramTests::testFullRange() {
+    HdrHistogram histogram;
+    histogram.record(0);
+    histogram.record(UINT64_MAX);
+    QCOMPARE(histogram.getValueAtPercentile(0.0), (uint64_t)0);
+    QCOMPARE(histogram.getValueAtPercentile(100.0), UINT64_MAX);
+}
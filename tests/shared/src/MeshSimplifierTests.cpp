@@ -0,0 +1,99 @@
+//
+//  MeshSimplifierTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshSimplifierTests.h"
+
+#include <MeshSimplifier.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(MeshSimplifierTests)
+
+static float evalArea(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    float area = 0.0f;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const auto& p0 = positions[indices[i]];
+        area += 0.5f * glm::length(glm::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0));
+    }
+    return area;
+}
+
+void MeshSimplifierTests::testFlatGrid() {
+    // A flat square of 20 by 20 quads collapses down to a fan of its border vertices, which stay put
+    const int SIZE = 20;
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (int i = 0; i <= SIZE; i++) {
+        for (int j = 0; j <= SIZE; j++) {
+            positions.push_back(glm::vec3((float)i, (float)j, 0.0f));
+        }
+    }
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            uint32_t a = i * (SIZE + 1) + j;
+            uint32_t b = a + SIZE + 1;
+            indices.insert(indices.end(), { a, b, b + 1, a, b + 1, a + 1 });
+        }
+    }
+
+    MeshSimplifier simplifier(positions.data(), (uint32_t)positions.size(), indices);
+    QCOMPARE(simplifier.getNumTriangles(), (size_t)(SIZE * SIZE * 2));
+
+    const size_t NUM_BORDER_VERTICES = SIZE * 4;
+    auto numTriangles = simplifier.simplify(0, 0.001f);
+    QVERIFY(numTriangles <= NUM_BORDER_VERTICES);
+
+    auto simplified = simplifier.getIndices();
+    QCOMPARE(simplified.size(), numTriangles * 3);
+    QVERIFY(fabsf(evalArea(positions, simplified) - (float)(SIZE * SIZE)) < 0.001f);
+    for (size_t i = 0; i + 2 < simplified.size(); i += 3) {
+        const auto& p0 = positions[simplified[i]];
+        auto normal = glm::cross(positions[simplified[i + 1]] - p0, positions[simplified[i + 2]] - p0);
+        QVERIFY(normal.z > 0.0f);
+    }
+}
+
+void MeshSimplifierTests::testTorus() {
+    // A closed surface simplifies to the target until collapsing costs more than the error allowed
+    const int NUM_RINGS = 64;
+    const int NUM_SIDES = 32;
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (int i = 0; i < NUM_RINGS; i++) {
+        for (int j = 0; j < NUM_SIDES; j++) {
+            float u = (float)i * TWO_PI / (float)NUM_RINGS;
+            float v = (float)j * TWO_PI / (float)NUM_SIDES;
+            positions.push_back(glm::vec3((2.0f + cosf(v)) * cosf(u), (2.0f + cosf(v)) * sinf(u), sinf(v)));
+        }
+    }
+    auto vertex = [&](int i, int j) {
+        return (uint32_t)((i % NUM_RINGS) * NUM_SIDES + (j % NUM_SIDES));
+    };
+    for (int i = 0; i < NUM_RINGS; i++) {
+        for (int j = 0; j < NUM_SIDES; j++) {
+            indices.insert(indices.end(), { vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1) });
+            indices.insert(indices.end(), { vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1) });
+        }
+    }
+    const size_t NUM_TRIANGLES = NUM_RINGS * NUM_SIDES * 2;
+
+    MeshSimplifier simplifier(positions.data(), (uint32_t)positions.size(), indices);
+    QCOMPARE(simplifier.simplify(NUM_TRIANGLES / 2, 0.05f), NUM_TRIANGLES / 2);
+
+    // Collapsing further is bounded by the error allowed
+    auto numTriangles = simplifier.simplify(0, 0.1f);
+    QVERIFY(numTriangles < NUM_TRIANGLES / 2);
+    QVERIFY(numTriangles > 0);
+
+    auto simplified = simplifier.getIndices();
+    QCOMPARE(simplified.size(), numTriangles * 3);
+    for (auto index : simplified) {
+        QVERIFY(index < positions.size());
+    }
+}
@@ -0,0 +1,23 @@
+//
+//  MeshSimplifierTests.h
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshSimplifierTests_h
+#define hifi_MeshSimplifierTests_h
+
+#include <QtTest/QtTest>
+
+class MeshSimplifierTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testFlatGrid();
+    void testTorus();
+};
+
+#endif // hifi_MeshSimplifierTests_h
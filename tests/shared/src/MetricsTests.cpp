@@ -0,0 +1,84 @@
+//
+//  MetricsTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsTests.h"
+
+#include <Metrics.h>
+
+QTEST_MAIN(MetricsTests)
+
+void MetricsTests::testHistogramBuckets() {
+    metrics::Histogram histogram({ 10, 1, 5 });
+    histogram.observe(0.5);
+    histogram.observe(1.0);
+    histogram.observe(3.0);
+    histogram.observe(10.0);
+    histogram.observe(20.0);
+
+    // the bounds are sorted and inclusive, with a last bucket above them
+    QCOMPARE(histogram.getUpperBounds(), std::vector<double>({ 1, 5, 10 }));
+    QCOMPARE(histogram.getBucketCounts(), std::vector<uint64_t>({ 2, 1, 1, 1 }));
+    QCOMPARE(histogram.getSum(), 34.5);
+}
+
+void MetricsTests::testTextExposition() {
+    auto& registry = metrics::Registry::getInstance();
+    registry.counter("test_frames_total").increment(3);
+    registry.gauge("test_listeners").set(7);
+    registry.histogram("test_frame_usecs", { 100, 1000 }).observe(500);
+    registry.addCollectedCounter("test_packets_total", [] { return (uint64_t)42; });
+
+    metrics::TextWriter writer;
+    QVERIFY(writer.add(registry.serialize(), "type=\"audio-mixer\""));
+    QVERIFY(writer.add(registry.serialize(), "type=\"avatar-mixer\""));
+    QByteArray text = writer.toText();
+
+    // each metric is typed once, with the samples of every process under it
+    QCOMPARE(text.count("# TYPE test_frames_total counter\n"), 1);
+    QVERIFY(text.contains("test_frames_total{type=\"audio-mixer\"} 3\n"));
+    QVERIFY(text.contains("test_frames_total{type=\"avatar-mixer\"} 3\n"));
+    QVERIFY(text.contains("# TYPE test_listeners gauge\ntest_listeners{type=\"audio-mixer\"} 7\n"));
+    QVERIFY(text.contains("test_packets_total{type=\"audio-mixer\"} 42\n"));
+
+    // the buckets are cumulative
+    QVERIFY(text.contains("test_frame_usecs_bucket{type=\"audio-mixer\",le=\"100\"} 0\n"));
+    QVERIFY(text.contains("test_frame_usecs_bucket{type=\"audio-mixer\",le=\"1000\"} 1\n"));
+    QVERIFY(text.contains("test_frame_usecs_bucket{type=\"audio-mixer\",le=\"+Inf\"} 1\n"));
+    QVERIFY(text.contains("test_frame_usecs_sum{type=\"audio-mixer\"} 500\n"));
+    QVERIFY(text.contains("test_frame_usecs_count{type=\"audio-mixer\"} 1\n"));
+}
+
+void MetricsTests::testTruncatedMetrics() {
+    auto& registry = metrics::Registry::getInstance();
+    registry.histogram("test_truncated_usecs", { 1, 2, 3 }).observe(2);
+    QByteArray serialized = registry.serialize();
+
+    metrics::TextWriter writer;
+    QVERIFY(!writer.add(serialized.left(serialized.size() - 4), ""));
+    QVERIFY(!writer.add(QByteArray(), ""));
+}
+
+void MetricsTests::testClear() {
+    auto& registry = metrics::Registry::getInstance();
+    auto& counter = registry.counter("test_cleared_total");
+    counter.increment(5);
+    registry.addCollectedGauge("test_cleared_collected", [] { return (int64_t)1; });
+    registry.clear();
+
+    // a finished assignment's metrics are gone, though what it still holds can be updated
+    counter.increment();
+    metrics::TextWriter writer;
+    QVERIFY(writer.add(registry.serialize(), ""));
+    QVERIFY(!writer.toText().contains("test_cleared"));
+
+    // and the next one starts them over
+    QCOMPARE(&registry.counter("test_cleared_total"), &counter);
+    QCOMPARE(counter.get(), (uint64_t)0);
+}
@@ -0,0 +1,80 @@
+//
+//  PoolAllocatorTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PoolAllocatorTests.h"
+
+#include <cstdint>
+#include <set>
+
+#include <PoolAllocator.h>
+
+QTEST_MAIN(PoolAllocatorTests)
+
+struct Element {
+    double values[5];
+};
+
+struct alignas(32) AlignedElement {
+    float values[3];
+};
+
+void PoolAllocatorTests::testBlocksAreReused() {
+    PoolAllocator<Element> allocator;
+    const int NUM_ELEMENTS = 1000;
+
+    std::set<Element*> allocated;
+    for (int i = 0; i < NUM_ELEMENTS; ++i) {
+        allocated.insert(allocator.allocate(1));
+    }
+    QCOMPARE((int)allocated.size(), NUM_ELEMENTS);
+
+    for (auto element : allocated) {
+        allocator.deallocate(element, 1);
+    }
+
+    // the freed blocks are given out again before any new ones
+    for (int i = 0; i < NUM_ELEMENTS; ++i) {
+        QVERIFY(allocated.count(allocator.allocate(1)) == 1);
+    }
+    for (auto element : allocated) {
+        allocator.deallocate(element, 1);
+    }
+}
+
+void PoolAllocatorTests::testAlignment() {
+    PoolAllocator<AlignedElement> allocator;
+    std::vector<AlignedElement*> allocated;
+    for (int i = 0; i < 300; ++i) {
+        AlignedElement* element = allocator.allocate(1);
+        QCOMPARE((uintptr_t)element % alignof(AlignedElement), (uintptr_t)0);
+        allocated.push_back(element);
+    }
+    for (auto element : allocated) {
+        allocator.deallocate(element, 1);
+    }
+
+    // arrays aren't pooled
+    AlignedElement* elements = allocator.allocate(4);
+    QVERIFY(elements != nullptr);
+    allocator.deallocate(elements, 4);
+}
+
+void PoolAllocatorTests::testSharedPointers() {
+    std::weak_ptr<Element> weakElement;
+    {
+        auto element = std::allocate_shared<Element>(PoolAllocator<Element>());
+        element->values[0] = 1.0;
+        weakElement = element;
+        auto copy = element;
+        QCOMPARE(copy->values[0], 1.0);
+        QCOMPARE(weakElement.use_count(), (long)2);
+    }
+    QVERIFY(weakElement.expired());
+}
@@ -10,6 +10,10 @@
 
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
 
 #include <Profile.h>
 
@@ -45,3 +49,34 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testFlightRecording() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.path() + "/flightRecording.json";
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startFlightRecording(0.2f);
+    tracer->traceEvent(trace_test(), "Old", tracing::Instant);
+    QThread::msleep(500);
+    tracer->traceEvent(trace_test(), "New", tracing::Instant, "", { { "count", 3 }, { "label", "recent" } });
+    tracer->serialize(path);
+    QVERIFY(tracer->isEnabled());
+    tracer->stopTracing();
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonArray events = QJsonDocument::fromJson(file.readAll()).array();
+    QSet<QString> names;
+    for (const auto& event : events) {
+        QJsonObject object = event.toObject();
+        names.insert(object["name"].toString());
+        if (object["name"].toString() == "New") {
+            QCOMPARE(object["cat"].toString(), QString("trace.test"));
+            QCOMPARE(object["args"].toObject()["count"].toInt(), 3);
+            QCOMPARE(object["args"].toObject()["label"].toString(), QString("recent"));
+        }
+    }
+    QVERIFY(names.contains("New"));
+    QVERIFY(!names.contains("Old"));
+}
@@ -0,0 +1,125 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleSetTests.h"
+
+#include <random>
+
+#include <TriangleSet.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+namespace {
+    const int NUM_TRIANGLES = 2000;
+    const int NUM_RAYS = 500;
+    const float EPSILON = 1.0e-5f;
+
+    std::mt19937 generator(42);
+
+    glm::vec3 randomPoint(float extent) {
+        std::uniform_real_distribution<float> distribution(-extent, extent);
+        return glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+
+    // small triangles scattered through a box, with a few large ones across it
+    TriangleSet makeTriangleSet() {
+        TriangleSet triangleSet;
+        for (int i = 0; i < NUM_TRIANGLES; ++i) {
+            glm::vec3 center = randomPoint(10.0f);
+            float size = (i % 100 == 0) ? 10.0f : 0.5f;
+            triangleSet.insert({ center + randomPoint(size), center + randomPoint(size), center + randomPoint(size) });
+        }
+        return triangleSet;
+    }
+
+    void makeRays(std::vector<glm::vec3>& origins, std::vector<glm::vec3>& directions) {
+        for (int i = 0; i < NUM_RAYS; ++i) {
+            origins.push_back(randomPoint(20.0f));
+            directions.push_back(glm::normalize(randomPoint(1.0f) - origins.back() * 0.05f));
+        }
+        // along the axes, where the reciprocals of the directions are infinite
+        origins.push_back(glm::vec3(0.0f, 0.0f, -20.0f));
+        directions.push_back(glm::vec3(0.0f, 0.0f, 1.0f));
+        origins.push_back(glm::vec3(-20.0f, 1.0f, 1.0f));
+        directions.push_back(glm::vec3(1.0f, 0.0f, 0.0f));
+    }
+}
+
+void TriangleSetTests::testBVHMatchesLinearScan() {
+    TriangleSet linear = makeTriangleSet();
+    TriangleSet hierarchy = linear;
+    hierarchy.buildBVH();
+    QVERIFY(hierarchy.hasBVH());
+    QCOMPARE(hierarchy.size(), linear.size());
+
+    std::vector<glm::vec3> origins;
+    std::vector<glm::vec3> directions;
+    makeRays(origins, directions);
+
+    int numHits = 0;
+    for (size_t i = 0; i < origins.size(); ++i) {
+        float linearDistance, hierarchyDistance;
+        BoxFace face;
+        glm::vec3 linearNormal, hierarchyNormal;
+        bool linearHit = linear.findRayIntersection(origins[i], directions[i], linearDistance, face, linearNormal, true);
+        bool hierarchyHit = hierarchy.findRayIntersection(origins[i], directions[i], hierarchyDistance, face,
+            hierarchyNormal, true);
+        QCOMPARE(hierarchyHit, linearHit);
+        if (linearHit) {
+            ++numHits;
+            QVERIFY(fabsf(hierarchyDistance - linearDistance) < EPSILON);
+            QVERIFY(glm::distance(hierarchyNormal, linearNormal) < EPSILON);
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+void TriangleSetTests::testBatchedRays() {
+    TriangleSet triangleSet = makeTriangleSet();
+    triangleSet.buildBVH();
+
+    std::vector<glm::vec3> origins;
+    std::vector<glm::vec3> directions;
+    makeRays(origins, directions);
+
+    std::vector<TriangleSet::RayIntersection> intersections;
+    triangleSet.findRayIntersections(origins, directions, intersections);
+    QCOMPARE(intersections.size(), origins.size());
+
+    for (size_t i = 0; i < origins.size(); ++i) {
+        float distance;
+        BoxFace face;
+        glm::vec3 normal;
+        bool hit = triangleSet.findRayIntersection(origins[i], directions[i], distance, face, normal, true);
+        QCOMPARE(intersections[i].intersects, hit);
+        if (hit) {
+            QVERIFY(fabsf(intersections[i].distance - distance) < EPSILON);
+            QVERIFY(glm::distance(intersections[i].surfaceNormal, normal) < EPSILON);
+        }
+    }
+}
+
+void TriangleSetTests::testInsertDropsBVH() {
+    TriangleSet triangleSet;
+    triangleSet.insert({ glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) });
+    triangleSet.buildBVH();
+    QVERIFY(triangleSet.hasBVH());
+
+    // a triangle nearer the ray's origin, that the old hierarchy doesn't have
+    triangleSet.insert({ glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, -1.0f, -1.0f), glm::vec3(0.0f, 1.0f, -1.0f) });
+    QVERIFY(!triangleSet.hasBVH());
+
+    float distance;
+    BoxFace face;
+    glm::vec3 normal;
+    QVERIFY(triangleSet.findRayIntersection(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f), distance, face,
+        normal, true));
+    QVERIFY(fabsf(distance - 4.0f) < EPSILON);
+}
@@ -0,0 +1,305 @@
+//
+//  AvatarMixerBotsApp.cpp
+//  tools/avatar-mixer-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarMixerBotsApp.h"
+
+#include <algorithm>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonDocument>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <DomainHandler.h>
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <NodeType.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+namespace {
+    const int FRUSTUMS_PER_SECOND = 5; // about what an interface sends while looking around
+    const int ADD_BOTS_INTERVAL_MSECS = 100;
+
+    // the value below which the given fraction of the (sorted) samples fall, in msecs
+    float percentile(const std::vector<quint64>& sortedSamples, float fraction) {
+        if (sortedSamples.empty()) {
+            return 0.0f;
+        }
+        size_t index = std::min((size_t)(fraction * sortedSamples.size()), sortedSamples.size() - 1);
+        return (float)sortedSamples[index] / USECS_PER_MSEC;
+    }
+}
+
+AvatarMixerBotsApp::AvatarMixerBotsApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity avatar mixer load generator");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "host[:port]",
+                                                 QString("127.0.0.1:%1").arg(DEFAULT_DOMAIN_SERVER_PORT));
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption domainHTTPPortOption("http-port", "domain-server HTTP port, for the mixer's stats", "port",
+                                                  QString::number(DOMAIN_SERVER_HTTP_PORT));
+    parser.addOption(domainHTTPPortOption);
+
+    const QCommandLineOption localAddressOption("local-address", "address the domain-server and mixer reach the bots at",
+                                                "address", "127.0.0.1");
+    parser.addOption(localAddressOption);
+
+    const QCommandLineOption botsOption("bots", "number of bots in the crowd", "count", QString::number(_numBots));
+    parser.addOption(botsOption);
+
+    const QCommandLineOption observersOption("observers", "number of bots measuring what they receive", "count",
+                                             QString::number(_numObservers));
+    parser.addOption(observersOption);
+
+    const QCommandLineOption rampOption("ramp", "bots connected per second", "count", QString::number(_numBotsPerSecond));
+    parser.addOption(rampOption);
+
+    const QCommandLineOption radiusOption("radius", "radius of the crowd", "meters", "20");
+    parser.addOption(radiusOption);
+
+    const QCommandLineOption jointsOption("joints", "joints per avatar", "count", "60");
+    parser.addOption(jointsOption);
+
+    const QCommandLineOption talkingOption("talking", "fraction of the time a bot is talking", "ratio", "0.1");
+    parser.addOption(talkingOption);
+
+    const QCommandLineOption rateOption("rate", "avatar data sends per second", "Hz", QString::number(_framesPerSecond));
+    parser.addOption(rateOption);
+
+    const QCommandLineOption intervalOption("interval", "seconds between reports", "seconds",
+                                            QString::number(_reportIntervalSeconds));
+    parser.addOption(intervalOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run for, 0 to run until killed", "seconds", "0");
+    parser.addOption(durationOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    QString domainAddress = parser.value(domainAddressOption);
+    quint16 domainPort = DEFAULT_DOMAIN_SERVER_PORT;
+    int colonIndex = domainAddress.indexOf(':');
+    if (colonIndex > 0) {
+        domainPort = domainAddress.mid(colonIndex + 1).toUShort();
+        domainAddress = domainAddress.left(colonIndex);
+    }
+    _settings.domainSockAddr = HifiSockAddr(domainAddress, domainPort, true);
+    if (_settings.domainSockAddr.getAddress().isNull()) {
+        qCritical() << "Could not resolve domain-server address" << domainAddress;
+        parser.showHelp(1);
+    }
+    _domainHTTPPort = parser.value(domainHTTPPortOption).toUShort();
+
+    _settings.localAddress = QHostAddress(parser.value(localAddressOption));
+    _settings.crowdRadius = parser.value(radiusOption).toFloat();
+    _settings.numJoints = std::max(parser.value(jointsOption).toInt(), 0);
+    _settings.talkingRatio = glm::clamp(parser.value(talkingOption).toFloat(), 0.0f, 1.0f);
+
+    _numBots = std::max(parser.value(botsOption).toInt(), 1);
+    _numObservers = glm::clamp(parser.value(observersOption).toInt(), 0, _numBots);
+    _numBotsPerSecond = std::max(parser.value(rampOption).toInt(), 1);
+    _framesPerSecond = std::max(parser.value(rateOption).toInt(), 1);
+    _frustumFrameInterval = std::max(_framesPerSecond / FRUSTUMS_PER_SECOND, 1);
+    _reportIntervalSeconds = std::max(parser.value(intervalOption).toInt(), 1);
+    _durationSeconds = std::max(parser.value(durationOption).toInt(), 0);
+
+    NodeType::init();
+
+    qDebug() << "Connecting" << _numBots << "bots (" << _numObservers << "observers ) to" << _settings.domainSockAddr
+        << "at" << _numBotsPerSecond << "per second";
+
+    _bots.reserve(_numBots);
+
+    connect(&_addBotsTimer, &QTimer::timeout, this, &AvatarMixerBotsApp::addBots);
+    _addBotsTimer.start(ADD_BOTS_INTERVAL_MSECS);
+
+    connect(&_frameTimer, &QTimer::timeout, this, &AvatarMixerBotsApp::simulateFrame);
+    _frameTimer.setTimerType(Qt::PreciseTimer);
+    _frameTimer.start((int)MSECS_PER_SECOND / _framesPerSecond);
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &AvatarMixerBotsApp::checkInWithDomain);
+    _checkInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    connect(&_reportTimer, &QTimer::timeout, this, &AvatarMixerBotsApp::report);
+    _reportTimer.start(_reportIntervalSeconds * (int)MSECS_PER_SECOND);
+
+    if (_durationSeconds > 0) {
+        QTimer::singleShot(_durationSeconds * (int)MSECS_PER_SECOND, this, [this] {
+            report();
+            quit();
+        });
+    }
+
+    _runTime.start();
+    _frameTime.start();
+}
+
+AvatarMixerBotsApp::~AvatarMixerBotsApp() {
+    _bots.clear();
+}
+
+void AvatarMixerBotsApp::addBots() {
+    // connect the crowd gradually, all at once would flood the domain-server with connect requests
+    int numToAdd = std::max(_numBotsPerSecond * ADD_BOTS_INTERVAL_MSECS / (int)MSECS_PER_SECOND, 1);
+    int end = std::min((int)_bots.size() + numToAdd, _numBots);
+
+    auto sendTimeLookup = [this](const QUuid& sessionUUID, const glm::vec3& position) {
+        return sendTimeForPosition(sessionUUID, position);
+    };
+
+    for (int i = (int)_bots.size(); i < end; i++) {
+        // the first bots are the observers, so that they see the whole crowd arrive
+        _bots.emplace_back(new BotSession(i, _settings, i < _numObservers, sendTimeLookup));
+        _bots.back()->checkInWithDomain();
+    }
+
+    if ((int)_bots.size() == _numBots) {
+        _addBotsTimer.stop();
+    }
+}
+
+void AvatarMixerBotsApp::simulateFrame() {
+    float deltaTime = (float)_frameTime.nsecsElapsed() / (USECS_PER_SECOND * NSECS_PER_USEC);
+    _frameTime.start();
+
+    bool sendViewFrustums = (_frame++ % _frustumFrameInterval) == 0;
+
+    for (auto& bot : _bots) {
+        if (bot->isConnectedToDomain() && _botsBySessionUUID.find(bot->getSessionUUID()) == _botsBySessionUUID.end()) {
+            _botsBySessionUUID[bot->getSessionUUID()] = bot.get();
+        }
+
+        bot->simulate(deltaTime);
+
+        if (sendViewFrustums) {
+            bot->sendViewFrustum();
+        }
+    }
+}
+
+void AvatarMixerBotsApp::checkInWithDomain() {
+    for (auto& bot : _bots) {
+        bot->checkInWithDomain();
+    }
+}
+
+quint64 AvatarMixerBotsApp::sendTimeForPosition(const QUuid& sessionUUID, const glm::vec3& position) const {
+    auto it = _botsBySessionUUID.find(sessionUUID);
+    return it != _botsBySessionUUID.end() ? it->second->sendTimeForPosition(position) : 0;
+}
+
+void AvatarMixerBotsApp::requestMixerStats() {
+    QUuid mixerUUID;
+    for (auto& bot : _bots) {
+        if (!bot->getMixerUUID().isNull()) {
+            mixerUUID = bot->getMixerUUID();
+            break;
+        }
+    }
+    if (mixerUUID.isNull()) {
+        return;
+    }
+
+    // the domain-server keeps the stats each assignment sends it, the mixer's are its frame timing
+    QUrl statsURL;
+    statsURL.setScheme("http");
+    statsURL.setHost(_settings.domainSockAddr.getAddress().toString());
+    statsURL.setPort(_domainHTTPPort);
+    statsURL.setPath(QString("/nodes/%1.json").arg(uuidStringWithoutCurlyBraces(mixerUUID)));
+
+    QNetworkReply* reply = _networkAccessManager.get(QNetworkRequest(statsURL));
+    connect(reply, &QNetworkReply::finished, this, [this, reply] {
+        if (reply->error() == QNetworkReply::NoError) {
+            _mixerStats = QJsonDocument::fromJson(reply->readAll()).object();
+        } else {
+            _mixerStats = QJsonObject();
+        }
+        reply->deleteLater();
+    });
+}
+
+void AvatarMixerBotsApp::report() {
+    int numConnectedToDomain = 0;
+    int numConnectedToMixer = 0;
+    QString denialReason;
+
+    int numObserversReporting = 0;
+    BotSession::ReceiveStats observerStats;
+    for (auto& bot : _bots) {
+        numConnectedToDomain += bot->isConnectedToDomain() ? 1 : 0;
+        numConnectedToMixer += bot->isConnectedToMixer() ? 1 : 0;
+        if (denialReason.isEmpty()) {
+            denialReason = bot->getDenialReason();
+        }
+
+        if (bot->isObserver()) {
+            auto stats = bot->takeReceiveStats();
+            numObserversReporting += stats.numPackets > 0 ? 1 : 0;
+            observerStats.numPackets += stats.numPackets;
+            observerStats.numBytes += stats.numBytes;
+            observerStats.numAvatarUpdates += stats.numAvatarUpdates;
+            observerStats.latencies.insert(observerStats.latencies.end(),
+                                           stats.latencies.begin(), stats.latencies.end());
+        }
+    }
+
+    float elapsedSeconds = (float)_runTime.elapsed() / MSECS_PER_SECOND;
+    qDebug().noquote() << QString("[%1s] %2 bots, %3 in the domain, %4 with the mixer")
+        .arg(elapsedSeconds, 0, 'f', 1).arg(_bots.size()).arg(numConnectedToDomain).arg(numConnectedToMixer);
+    if (!denialReason.isEmpty()) {
+        qDebug().noquote() << "    domain-server denied a connection:" << denialReason;
+    }
+
+    // the stats are per observer per second, averaged over the observers that received anything
+    if (numObserversReporting > 0) {
+        float divisor = (float)(numObserversReporting * _reportIntervalSeconds);
+        float kbps = (float)observerStats.numBytes * BITS_IN_BYTE / BYTES_PER_KILOBYTE / divisor;
+        float updatesPerSecond = (float)observerStats.numAvatarUpdates / divisor;
+        float bytesPerUpdate = observerStats.numAvatarUpdates > 0 ?
+            (float)observerStats.numBytes / observerStats.numAvatarUpdates : 0.0f;
+
+        auto& latencies = observerStats.latencies;
+        std::sort(latencies.begin(), latencies.end());
+        qDebug().noquote() << QString("    observer: %1 kbps, %2 avatar updates/s, %3 bytes/update,"
+                                      " latency p50 %4 ms p95 %5 ms p99 %6 ms (%7 samples)")
+            .arg(kbps, 0, 'f', 1).arg(updatesPerSecond, 0, 'f', 0).arg(bytesPerUpdate, 0, 'f', 1)
+            .arg(percentile(latencies, 0.50f), 0, 'f', 1).arg(percentile(latencies, 0.95f), 0, 'f', 1)
+            .arg(percentile(latencies, 0.99f), 0, 'f', 1).arg(latencies.size());
+    }
+
+    if (_mixerStats.isEmpty()) {
+        qDebug().noquote() << "    mixer: stats unavailable";
+    } else {
+        auto broadcastTiming = _mixerStats["parallelTasks"].toObject()["broadcastAvatarData"].toObject();
+        qDebug().noquote() << QString("    mixer: %1 Hz broadcast loop, %2 us broadcasting per frame")
+            .arg(_mixerStats["broadcast_loop_rate"].toDouble(), 0, 'f', 1)
+            .arg(broadcastTiming["1_total"].toDouble(), 0, 'f', 0);
+    }
+
+    // ask for the next report's mixer stats now, they are sent to the domain-server about once a second
+    requestMixerStats();
+}
@@ -0,0 +1,72 @@
+//
+//  AvatarMixerBotsApp.h
+//  tools/avatar-mixer-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarMixerBotsApp_h
+#define hifi_AvatarMixerBotsApp_h
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkAccessManager>
+
+#include <UUIDHasher.h>
+
+#include "BotSession.h"
+
+// Loads an avatar mixer with a crowd of synthetic avatar sessions, and reports what it costs the mixer
+// (its frame time and loop rate, from the domain-server's stats for it) and what the crowd gets back from it
+// (bytes per avatar update and broadcast latency percentiles, as measured by a few observer bots).
+class AvatarMixerBotsApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    AvatarMixerBotsApp(int argc, char* argv[]);
+    ~AvatarMixerBotsApp();
+
+private slots:
+    void addBots();
+    void simulateFrame();
+    void checkInWithDomain();
+    void report();
+
+private:
+    quint64 sendTimeForPosition(const QUuid& sessionUUID, const glm::vec3& position) const;
+    void requestMixerStats();
+
+    BotSession::Settings _settings;
+    int _numBots { 100 };
+    int _numObservers { 4 };
+    int _numBotsPerSecond { 50 };
+    int _framesPerSecond { 45 };
+    int _frustumFrameInterval { 9 };
+    int _reportIntervalSeconds { 5 };
+    int _durationSeconds { 0 };
+    quint16 _domainHTTPPort { 0 };
+
+    std::vector<std::unique_ptr<BotSession>> _bots;
+    std::unordered_map<QUuid, BotSession*> _botsBySessionUUID;
+
+    QTimer _addBotsTimer;
+    QTimer _frameTimer;
+    QTimer _checkInTimer;
+    QTimer _reportTimer;
+    QElapsedTimer _runTime;
+    QElapsedTimer _frameTime;
+    int _frame { 0 };
+
+    QNetworkAccessManager _networkAccessManager;
+    QJsonObject _mixerStats;
+};
+
+#endif // hifi_AvatarMixerBotsApp_h
@@ -0,0 +1,232 @@
+//
+//  BotSession.cpp
+//  tools/avatar-mixer-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BotSession.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <GLMHelpers.h>
+#include <NodeType.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+#include <udt/PacketHeaders.h>
+
+namespace {
+    const float MIN_WALKING_SPEED = 0.5f; // meters per second
+    const float MAX_WALKING_SPEED = 1.5f;
+    const float MAX_TURN_RATE = 1.0f; // radians per second
+    const float GESTURE_FREQUENCY = 1.5f; // Hz, about a walking stride
+    const float GESTURE_AMPLITUDE = 0.3f; // radians
+    const float EYE_HEIGHT = 0.6f; // meters above the avatar position
+
+    const float TALKING_LOUDNESS = 200.0f; // comfortably above the mixer's talking threshold
+    const float MEAN_TALKING_TIME = 4.0f; // seconds
+
+    const int MAX_SEND_HISTORY = 90; // two seconds of sends at the usual rate
+
+    // A script-less avatar, sending what an interface client would (see MyAvatar::toByteArrayStateful)
+    class BotAvatar : public AvatarData {
+    public:
+        BotAvatar() {
+            lazyInitHeadData(); // the head data carries the audio loudness
+
+            // about the character controller capsule of a default avatar
+            _globalBoundingBoxDimensions = glm::vec3(0.3f, 0.9f, 0.3f);
+            _globalBoundingBoxOffset = glm::vec3(0.0f, -0.2f, 0.0f);
+        }
+
+        QByteArray toByteArrayStateful(AvatarDataDetail dataDetail) override {
+            _globalPosition = getPosition();
+            return AvatarData::toByteArrayStateful(dataDetail);
+        }
+    };
+}
+
+BotSession::BotSession(int index, const Settings& settings, bool isObserver, SendTimeLookup sendTimeLookup) :
+    // only observers, which take in the whole crowd, need the larger socket buffers
+    DomainSession(settings.domainSockAddr, settings.localAddress, NodeType::AvatarMixer, isObserver),
+    _settings(settings),
+    _isObserver(isObserver),
+    _sendTimeLookup(sendTimeLookup),
+    _avatar(std::make_shared<BotAvatar>())
+{
+    _avatar->setDisplayName(QString("bot_%1").arg(index));
+
+    float angle = randFloatInRange(0.0f, TWO_PI);
+    float distance = _settings.crowdRadius * sqrtf(randFloat());
+    _avatar->setPosition(glm::vec3(distance * cosf(angle), 0.0f, distance * sinf(angle)));
+    _heading = randFloatInRange(0.0f, TWO_PI);
+    _speed = randFloatInRange(MIN_WALKING_SPEED, MAX_WALKING_SPEED);
+    _time = randFloatInRange(0.0f, 1.0f / GESTURE_FREQUENCY);
+    _silentTimeLeft = randFloatInRange(0.0f, MEAN_TALKING_TIME);
+
+    _jointRotations.resize(_settings.numJoints);
+}
+
+BotSession::~BotSession() {
+}
+
+void BotSession::processPacket(NLPacket& packet) {
+    if (packet.getType() == PacketType::BulkAvatarData && _isObserver) {
+        processBulkAvatarData(packet);
+    }
+}
+
+void BotSession::sessionUUIDChanged(const QUuid& sessionUUID) {
+    _avatar->setSessionUUID(sessionUUID);
+}
+
+void BotSession::targetChanged() {
+    _hasSentIdentity = false;
+}
+
+void BotSession::processBulkAvatarData(NLPacket& packet) {
+    // as AvatarHashMap::processAvatarDataPacket
+    quint64 now = usecTimestampNow();
+    _receiveStats.numPackets++;
+    _receiveStats.numBytes += packet.getDataSize();
+
+    while (packet.bytesLeftToRead() >= NUM_BYTES_RFC4122_UUID) {
+        QUuid sessionUUID = QUuid::fromRfc4122(packet.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+        auto& otherAvatar = _otherAvatars[sessionUUID];
+        if (!otherAvatar) {
+            otherAvatar = std::make_shared<AvatarData>();
+            otherAvatar->setSessionUUID(sessionUUID);
+        }
+
+        glm::vec3 lastPosition = otherAvatar->getClientGlobalPosition();
+
+        qint64 positionBeforeRead = packet.pos();
+        QByteArray byteArray = packet.readWithoutCopy(packet.bytesLeftToRead());
+        int bytesRead = otherAvatar->parseDataFromBuffer(byteArray);
+        packet.seek(positionBeforeRead + bytesRead);
+
+        _receiveStats.numAvatarUpdates++;
+
+        // every bot is always walking, so a new position is a new update and tells us when it was sent
+        glm::vec3 position = otherAvatar->getClientGlobalPosition();
+        if (position != lastPosition && _sendTimeLookup) {
+            quint64 sendTime = _sendTimeLookup(sessionUUID, position);
+            if (sendTime != 0 && sendTime <= now) {
+                _receiveStats.latencies.push_back(now - sendTime);
+            }
+        }
+    }
+}
+
+BotSession::ReceiveStats BotSession::takeReceiveStats() {
+    ReceiveStats stats;
+    std::swap(stats, _receiveStats);
+    return stats;
+}
+
+quint64 BotSession::sendTimeForPosition(const glm::vec3& position) const {
+    for (auto it = _sendHistory.rbegin(); it != _sendHistory.rend(); ++it) {
+        if (it->first == position) {
+            return it->second;
+        }
+    }
+    return 0;
+}
+
+void BotSession::simulate(float deltaTime) {
+    _time += deltaTime;
+
+    // wander around the crowd, turning back towards its middle past its edge
+    glm::vec3 position = _avatar->getPosition();
+    if (glm::length(glm::vec2(position.x, position.z)) > _settings.crowdRadius) {
+        _heading = atan2f(position.x, position.z); // see the FRONT of the orientation below
+    } else {
+        _heading += randFloatInRange(-MAX_TURN_RATE, MAX_TURN_RATE) * deltaTime;
+    }
+
+    glm::quat orientation = glm::angleAxis(_heading, Vectors::UP);
+    position += orientation * Vectors::FRONT * (_speed * deltaTime);
+    _avatar->setPosition(position);
+    _avatar->setOrientation(orientation);
+
+    // swing the joints as if walking, so that joint data is sent like for a moving avatar
+    float swing = GESTURE_AMPLITUDE * sinf(TWO_PI * GESTURE_FREQUENCY * _time);
+    for (int i = 0; i < _jointRotations.size(); i++) {
+        float jointSwing = (i % 2 == 0) ? swing : -swing;
+        _jointRotations[i] = glm::angleAxis(jointSwing, Vectors::UNIT_X);
+    }
+    _avatar->setJointRotations(_jointRotations);
+
+    // talk in spells, for the given fraction of the time
+    if (_talkingTimeLeft > 0.0f) {
+        _talkingTimeLeft -= deltaTime;
+        if (_talkingTimeLeft <= 0.0f) {
+            float talkingRatio = glm::clamp(_settings.talkingRatio, 0.01f, 1.0f);
+            _silentTimeLeft = randFloatInRange(0.0f, 2.0f * MEAN_TALKING_TIME * (1.0f - talkingRatio) / talkingRatio);
+        }
+    } else {
+        _silentTimeLeft -= deltaTime;
+        if (_silentTimeLeft <= 0.0f && _settings.talkingRatio > 0.0f) {
+            _talkingTimeLeft = randFloatInRange(0.0f, 2.0f * MEAN_TALKING_TIME);
+        }
+    }
+    _avatar->setAudioLoudness(_talkingTimeLeft > 0.0f ? TALKING_LOUDNESS : 0.0f);
+
+    if (isConnectedToMixer()) {
+        if (!_hasSentIdentity) {
+            sendIdentity();
+        }
+        sendAvatarData();
+    }
+}
+
+void BotSession::sendIdentity() {
+    // the mixer only ever wants the latest identity, a reliable packet is enough for it
+    QByteArray identityData = _avatar->identityByteArray();
+    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, identityData.size(), true);
+    identityPacket->write(identityData);
+    sendPacketToTarget(std::move(identityPacket));
+    _hasSentIdentity = true;
+}
+
+void BotSession::sendAvatarData() {
+    // as AvatarData::sendAvatarDataPacket
+    bool cullSmallData = (randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO);
+    auto dataDetail = cullSmallData ? AvatarData::SendAllData : AvatarData::CullSmallData;
+    QByteArray avatarByteArray = _avatar->toByteArrayStateful(dataDetail);
+    _avatar->doneEncoding(cullSmallData);
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarData, avatarByteArray.size() + sizeof(_sequenceNumber));
+    avatarPacket->writePrimitive(_sequenceNumber++);
+    avatarPacket->write(avatarByteArray);
+    sendPacketToTarget(std::move(avatarPacket));
+
+    _sendHistory.emplace_back(_avatar->getPosition(), usecTimestampNow());
+    if (_sendHistory.size() > MAX_SEND_HISTORY) {
+        _sendHistory.pop_front();
+    }
+}
+
+void BotSession::sendViewFrustum() {
+    if (!isConnectedToMixer()) {
+        return;
+    }
+
+    // as Application::sendAvatarViewFrustum, looking where the avatar walks
+    ViewFrustum viewFrustum;
+    viewFrustum.setPosition(_avatar->getPosition() + glm::vec3(0.0f, EYE_HEIGHT, 0.0f));
+    viewFrustum.setOrientation(_avatar->getOrientation());
+    viewFrustum.setProjection(glm::perspective(glm::radians(DEFAULT_FIELD_OF_VIEW_DEGREES), DEFAULT_ASPECT_RATIO,
+                                               DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP));
+    viewFrustum.calculate();
+
+    QByteArray viewFrustumByteArray = viewFrustum.toByteArray();
+    auto viewFrustumPacket = NLPacket::create(PacketType::ViewFrustum, viewFrustumByteArray.size());
+    viewFrustumPacket->write(viewFrustumByteArray);
+    sendPacketToTarget(std::move(viewFrustumPacket));
+}
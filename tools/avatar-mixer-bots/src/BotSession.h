@@ -0,0 +1,102 @@
+//
+//  BotSession.h
+//  tools/avatar-mixer-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BotSession_h
+#define hifi_BotSession_h
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QUuid>
+
+#include <AvatarData.h>
+#include <DomainSession.h>
+#include <HifiSockAddr.h>
+#include <NLPacket.h>
+#include <UUIDHasher.h>
+
+// One fake interface session in the crowd, connected to the avatar-mixer as a DomainSession.
+//   It sends what a client does (AvatarIdentity, AvatarData and ViewFrustum), and its avatar wanders, gestures
+//   and talks.
+//   Observer sessions also parse the BulkAvatarData they receive, to measure what a listener gets from the mixer.
+class BotSession : public DomainSession {
+    Q_OBJECT
+public:
+    struct Settings {
+        HifiSockAddr domainSockAddr;
+        QHostAddress localAddress;
+        float crowdRadius;
+        int numJoints;
+        float talkingRatio; // fraction of the time a bot is talking
+    };
+
+    // when the session with this ID sent its avatar at this position, 0 if it isn't in its recent history
+    using SendTimeLookup = std::function<quint64(const QUuid& sessionUUID, const glm::vec3& position)>;
+
+    struct ReceiveStats {
+        int numPackets { 0 };
+        qint64 numBytes { 0 };
+        int numAvatarUpdates { 0 };
+        std::vector<quint64> latencies; // usecs from another bot sending a position to this one receiving it
+    };
+
+    BotSession(int index, const Settings& settings, bool isObserver, SendTimeLookup sendTimeLookup);
+    ~BotSession();
+
+    const QUuid& getMixerUUID() const { return getTargetUUID(); }
+    bool isConnectedToMixer() const { return isConnectedToTarget(); }
+    bool isObserver() const { return _isObserver; }
+
+    void simulate(float deltaTime); // moves the avatar and sends its AvatarData
+    void sendViewFrustum();
+
+    quint64 sendTimeForPosition(const glm::vec3& position) const;
+
+    // what this (observer) session received since the last call
+    ReceiveStats takeReceiveStats();
+
+protected:
+    void processPacket(NLPacket& packet) override;
+    void sessionUUIDChanged(const QUuid& sessionUUID) override;
+    void targetChanged() override;
+
+private:
+    void processBulkAvatarData(NLPacket& packet);
+
+    void sendIdentity();
+    void sendAvatarData();
+
+    Settings _settings;
+    bool _isObserver;
+    SendTimeLookup _sendTimeLookup;
+
+    bool _hasSentIdentity { false };
+
+    AvatarSharedPointer _avatar;
+    AvatarDataSequenceNumber _sequenceNumber { 0 };
+    float _heading { 0.0f };
+    float _speed { 1.0f };
+    float _time { 0.0f };
+    float _talkingTimeLeft { 0.0f };
+    float _silentTimeLeft { 0.0f };
+    QVector<glm::quat> _jointRotations;
+
+    // the positions last sent, newest at the back, for measuring the broadcast latency
+    std::deque<std::pair<glm::vec3, quint64>> _sendHistory;
+
+    std::unordered_map<QUuid, AvatarSharedPointer> _otherAvatars; // observers only
+    ReceiveStats _receiveStats;
+};
+
+#endif // hifi_BotSession_h
@@ -0,0 +1,18 @@
+//
+//  main.cpp
+//  tools/avatar-mixer-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QtCore/QCoreApplication>
+
+#include "AvatarMixerBotsApp.h"
+
+int main(int argc, char* argv[]) {
+    AvatarMixerBotsApp app(argc, argv);
+    return app.exec();
+}
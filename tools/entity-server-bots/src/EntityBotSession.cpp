@@ -0,0 +1,298 @@
+//
+//  EntityBotSession.cpp
+//  tools/entity-server-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBotSession.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <EntityItemProperties.h>
+#include <GLMHelpers.h>
+#include <NodeType.h>
+#include <NumericalConstants.h>
+#include <OctreePacketData.h>
+#include <OctreeSceneStats.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+#include <udt/PacketHeaders.h>
+#include <udt/PacketPool.h>
+
+namespace {
+    const float MAX_TURN_RATE = 0.5f; // radians per second
+    const float EYE_HEIGHT = 1.6f; // meters above the ground
+    const float MIN_ENTITY_SIZE = 0.2f; // meters
+    const float MAX_ENTITY_SIZE = 2.0f;
+
+    // the models share a few directories on one server, as the models in a real domain tend to
+    const QString MODEL_URL_PREFIX = "http://mpassets.highfidelity.com/entity-server-bots/models/";
+    const int NUM_MODEL_DIRECTORIES = 8;
+    const int NUM_MODELS_PER_DIRECTORY = 32;
+}
+
+EntityBotSession::EntityBotSession(const Settings& settings, Role role) :
+    // only observers, which take in the whole scene, need the larger socket buffers
+    DomainSession(settings.domainSockAddr, settings.localAddress, NodeType::EntityServer, role == Role::Observer),
+    _settings(settings),
+    _role(role)
+{
+    float angle = randFloatInRange(0.0f, TWO_PI);
+    float distance = _settings.sceneRadius * sqrtf(randFloat());
+    _position = glm::vec3(distance * cosf(angle), EYE_HEIGHT, distance * sinf(angle));
+    _heading = randFloatInRange(0.0f, TWO_PI);
+    _turnRate = randFloatInRange(-MAX_TURN_RATE, MAX_TURN_RATE);
+
+    // observers want every entity, wherever they are looking
+    _query.setUsesFrustum(role != Role::Observer);
+
+    if (role == Role::Observer) {
+        _viewer.reset(new EntityTreeHeadlessViewer());
+        _viewer->init();
+    }
+}
+
+EntityBotSession::~EntityBotSession() {
+}
+
+void EntityBotSession::processPacket(NLPacket& packet) {
+    switch (packet.getType()) {
+        case PacketType::OctreeStats:
+            processOctreeStats(packet);
+            break;
+        case PacketType::EntityData:
+            processEntityData(packet);
+            break;
+        default:
+            break;
+    }
+}
+
+void EntityBotSession::processMessagePacket(std::unique_ptr<udt::Packet> packet) {
+    // the only reliable message the entity server sends a client is its compression dictionary,
+    // whose parts arrive in order, as for the PacketReceiver
+    auto position = packet->getPacketPosition();
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+
+    if (position == udt::Packet::PacketPosition::ONLY || position == udt::Packet::PacketPosition::FIRST) {
+        _messageData.clear();
+    }
+    _messageData.append(nlPacket->getPayload(), nlPacket->getPayloadSize());
+
+    if (position == udt::Packet::PacketPosition::ONLY || position == udt::Packet::PacketPosition::LAST) {
+        const QUuid& serverUUID = getTargetUUID();
+        if (nlPacket->getType() == PacketType::EntityCompressionDictionary && nlPacket->getSourceID() == serverUUID) {
+            OctreePacketData::setCompressionDictionary(serverUUID, _messageData);
+        }
+        _messageData.clear();
+    }
+}
+
+void EntityBotSession::targetChanged() {
+    _firstQuerySentAt = 0;
+    _timeToFullScene = 0;
+}
+
+void EntityBotSession::processOctreeStats(NLPacket& packet) {
+    if (packet.getSourceID() != getTargetUUID()) {
+        return;
+    }
+
+    // the server sends its stats for a scene once it has sent all of the scene
+    _receiveStats.numPackets++;
+    _receiveStats.numBytes += packet.getDataSize();
+
+    ReceivedMessage message(packet);
+    OctreeSceneStats sceneStats;
+    int statsMessageLength = sceneStats.unpackFromPacket(message);
+
+    _receiveStats.numScenes++;
+    _receiveStats.serverEncodeTime += sceneStats.getTotalEncodeTime();
+    if (_timeToFullScene == 0 && _firstQuerySentAt != 0) {
+        _timeToFullScene = usecTimestampNow() - _firstQuerySentAt;
+    }
+
+    // as OctreePacketProcessor::processPacket, entity data can follow the stats in the same packet
+    int piggybackBytes = message.getSize() - statsMessageLength;
+    if (piggybackBytes > 0) {
+        auto buffer = udt::PacketPool::allocate(piggybackBytes);
+        memcpy(buffer.get(), message.getRawMessage() + statsMessageLength, piggybackBytes);
+
+        auto piggybackPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggybackBytes,
+                                                            packet.getSenderSockAddr());
+        if (piggybackPacket->getType() == PacketType::EntityData &&
+            piggybackPacket->getVersion() == versionForPacketType(PacketType::EntityData)) {
+            // its bytes are already counted with the stats
+            _receiveStats.numPackets--;
+            _receiveStats.numBytes -= piggybackPacket->getDataSize();
+            processEntityData(*piggybackPacket);
+        }
+    }
+}
+
+void EntityBotSession::processEntityData(NLPacket& packet) {
+    if (packet.getSourceID() != getTargetUUID()) {
+        return;
+    }
+
+    _receiveStats.numPackets++;
+    _receiveStats.numBytes += packet.getDataSize();
+
+    if (!_viewer) {
+        return;
+    }
+
+    quint64 now = usecTimestampNow();
+    ReceivedMessage message(packet);
+    _viewer->processDatagram(message, SharedNodePointer());
+
+    // an edit has reached us once its entity has the name it gave it
+    if (!_expectedEdits.empty()) {
+        auto tree = _viewer->getTree();
+        tree->withReadLock([&] {
+            for (auto it = _expectedEdits.begin(); it != _expectedEdits.end();) {
+                auto entity = tree->findEntityByID(it->first);
+                if (entity && entity->getName() == it->second.first) {
+                    _receiveStats.editLatencies.push_back(now - it->second.second);
+                    it = _expectedEdits.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        });
+    }
+}
+
+EntityBotSession::ReceiveStats EntityBotSession::takeReceiveStats() {
+    ReceiveStats stats;
+    std::swap(stats, _receiveStats);
+    return stats;
+}
+
+void EntityBotSession::expectEdit(const QUuid& entityID, const QString& name, quint64 sentAt) {
+    // a later edit of the same entity replaces this one, the earlier is never seen
+    _expectedEdits[entityID] = { name, sentAt };
+}
+
+void EntityBotSession::simulate(float deltaTime) {
+    _heading += _turnRate * deltaTime;
+}
+
+void EntityBotSession::sendQuery() {
+    if (!isConnectedToServer() || _role == Role::Editor) {
+        return;
+    }
+
+    // as Application::queryOctree, for a view at our position and heading
+    ViewFrustum viewFrustum;
+    viewFrustum.setPosition(_position);
+    viewFrustum.setOrientation(glm::angleAxis(_heading, Vectors::UP));
+    viewFrustum.setProjection(glm::perspective(glm::radians(DEFAULT_FIELD_OF_VIEW_DEGREES), DEFAULT_ASPECT_RATIO,
+                                               DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP));
+    viewFrustum.calculate();
+
+    _query.setCameraPosition(viewFrustum.getPosition());
+    _query.setCameraOrientation(viewFrustum.getOrientation());
+    _query.setCameraFov(viewFrustum.getFieldOfView());
+    _query.setCameraAspectRatio(viewFrustum.getAspectRatio());
+    _query.setCameraNearClip(viewFrustum.getNearClip());
+    _query.setCameraFarClip(viewFrustum.getFarClip());
+    _query.setCameraEyeOffsetPosition(glm::vec3());
+    _query.setCameraCenterRadius(viewFrustum.getCenterRadius());
+    _query.setCompressionDictionaryID(OctreePacketData::getCompressionDictionaryID(getTargetUUID()));
+
+    auto queryPacket = NLPacket::create(PacketType::EntityQuery);
+    int packetSize = _query.getBroadcastData(reinterpret_cast<unsigned char*>(queryPacket->getPayload()));
+    queryPacket->setPayloadSize(packetSize);
+    sendPacketToTarget(std::move(queryPacket));
+
+    if (_firstQuerySentAt == 0) {
+        _firstQuerySentAt = usecTimestampNow();
+    }
+}
+
+void EntityBotSession::sendEditPacket(PacketType type, const QUuid& entityID, const EntityItemProperties& properties) {
+    // as OctreeEditPacketSender::initializePacket, one edit per packet
+    QByteArray editMessage;
+    if (!EntityItemProperties::encodeEntityEditPacket(type, entityID, properties, editMessage)) {
+        qWarning() << "Could not encode an edit of" << entityID;
+        return;
+    }
+
+    auto editPacket = NLPacket::create(type, sizeof(quint16) + sizeof(quint64) + editMessage.size());
+    editPacket->writePrimitive(_editSequenceNumber++);
+    editPacket->writePrimitive(usecTimestampNow());
+    editPacket->write(editMessage);
+    sendPacketToTarget(std::move(editPacket));
+}
+
+std::vector<QUuid> EntityBotSession::addEntities(int numEntities) {
+    std::vector<QUuid> addedEntities;
+    if (!isConnectedToServer() || _role != Role::Editor) {
+        return addedEntities;
+    }
+
+    addedEntities.reserve(numEntities);
+    for (int i = 0; i < numEntities; i++) {
+        QUuid entityID = QUuid::createUuid();
+        int entityNumber = (int)_addedEntities.size();
+
+        float angle = randFloatInRange(0.0f, TWO_PI);
+        float distance = _settings.sceneRadius * sqrtf(randFloat());
+        float size = randFloatInRange(MIN_ENTITY_SIZE, MAX_ENTITY_SIZE);
+
+        EntityItemProperties properties;
+        properties.setName(QString("entity %1").arg(entityNumber));
+        properties.setPosition(glm::vec3(distance * cosf(angle), size / 2.0f, distance * sinf(angle)));
+        properties.setDimensions(glm::vec3(size));
+        properties.setLifetime(_settings.lifetime);
+        properties.setUserData(QString("{\"entityServerBots\":{\"number\":%1}}").arg(entityNumber));
+
+        if (randFloat() < _settings.modelRatio) {
+            int directory = randIntInRange(0, NUM_MODEL_DIRECTORIES - 1);
+            int model = randIntInRange(0, NUM_MODELS_PER_DIRECTORY - 1);
+            properties.setType(EntityTypes::Model);
+            properties.setModelURL(MODEL_URL_PREFIX + QString("set%1/model%2.fbx").arg(directory).arg(model));
+        } else {
+            properties.setType(EntityTypes::Box);
+            properties.setColor({ (uint8_t)randIntInRange(0, 255), (uint8_t)randIntInRange(0, 255),
+                                  (uint8_t)randIntInRange(0, 255) });
+        }
+        properties.setLastEdited(usecTimestampNow());
+
+        sendEditPacket(PacketType::EntityAdd, entityID, properties);
+        _addedEntities.push_back(entityID);
+        addedEntities.push_back(entityID);
+    }
+    return addedEntities;
+}
+
+std::vector<std::pair<QUuid, QString>> EntityBotSession::editEntities(int numEdits) {
+    std::vector<std::pair<QUuid, QString>> editedEntities;
+    if (!isConnectedToServer() || _role != Role::Editor || _addedEntities.empty()) {
+        return editedEntities;
+    }
+
+    editedEntities.reserve(numEdits);
+    for (int i = 0; i < numEdits; i++) {
+        const QUuid& entityID = _addedEntities[randIntInRange(0, (int)_addedEntities.size() - 1)];
+
+        // a move, which changes the elements the entity is in, and a name that tells the observers which edit they have
+        float angle = randFloatInRange(0.0f, TWO_PI);
+        float distance = _settings.sceneRadius * sqrtf(randFloat());
+        QString name = QString("edit %1").arg(_numEdits++);
+
+        EntityItemProperties properties;
+        properties.setName(name);
+        properties.setPosition(glm::vec3(distance * cosf(angle), MAX_ENTITY_SIZE / 2.0f, distance * sinf(angle)));
+        properties.setLastEdited(usecTimestampNow());
+
+        sendEditPacket(PacketType::EntityEdit, entityID, properties);
+        editedEntities.emplace_back(entityID, name);
+    }
+    return editedEntities;
+}
@@ -0,0 +1,108 @@
+//
+//  EntityBotSession.h
+//  tools/entity-server-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBotSession_h
+#define hifi_EntityBotSession_h
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QUuid>
+
+#include <DomainSession.h>
+#include <EntityTreeHeadlessViewer.h>
+#include <HifiSockAddr.h>
+#include <NLPacket.h>
+#include <OctreeQuery.h>
+#include <UUIDHasher.h>
+
+// One fake interface session, connected to the entity server as a DomainSession.
+//   A viewer stands somewhere in the scene, looking around, and counts what it is sent for its view.
+//   An observer queries the whole scene and reads it into its own tree, to see when the editor's edits reach it.
+//   The editor adds entities to the scene, then edits them at a steady rate.
+class EntityBotSession : public DomainSession {
+    Q_OBJECT
+public:
+    enum class Role { Viewer, Observer, Editor };
+
+    struct Settings {
+        HifiSockAddr domainSockAddr;
+        QHostAddress localAddress;
+        float sceneRadius;
+        float modelRatio; // fraction of the added entities that are models, with URLs, rather than boxes
+        float lifetime; // seconds the added entities live for
+    };
+
+    struct ReceiveStats {
+        int numPackets { 0 };
+        qint64 numBytes { 0 };
+        int numScenes { 0 }; // scenes the server finished sending
+        quint64 serverEncodeTime { 0 }; // usecs the server spent encoding those scenes
+        std::vector<quint64> editLatencies; // usecs from the editor sending an edit to an observer reading it
+    };
+
+    EntityBotSession(const Settings& settings, Role role);
+    ~EntityBotSession();
+
+    Role getRole() const { return _role; }
+    bool isConnectedToServer() const { return isConnectedToTarget(); }
+
+    // usecs from the first query to the end of the first scene, 0 until then
+    quint64 getTimeToFullScene() const { return _timeToFullScene; }
+
+    void simulate(float deltaTime); // turns a viewer's view around
+    void sendQuery();
+
+    // editor only, these return the entities they added or edited
+    std::vector<QUuid> addEntities(int numEntities);
+    std::vector<std::pair<QUuid, QString>> editEntities(int numEdits); // with the name each edit gave the entity
+
+    // observer only, watch for an entity to have the name an edit gave it
+    void expectEdit(const QUuid& entityID, const QString& name, quint64 sentAt);
+
+    // what this session received since the last call
+    ReceiveStats takeReceiveStats();
+
+protected:
+    void processPacket(NLPacket& packet) override;
+    void processMessagePacket(std::unique_ptr<udt::Packet> packet) override;
+    void targetChanged() override;
+
+private:
+    void sendEditPacket(PacketType type, const QUuid& entityID, const EntityItemProperties& properties);
+
+    void processOctreeStats(NLPacket& packet);
+    void processEntityData(NLPacket& packet);
+
+    Settings _settings;
+    Role _role;
+
+    OctreeQuery _query;
+    glm::vec3 _position;
+    float _heading { 0.0f };
+    float _turnRate { 0.0f };
+    quint64 _firstQuerySentAt { 0 };
+    quint64 _timeToFullScene { 0 };
+
+    quint16 _editSequenceNumber { 0 };
+    std::vector<QUuid> _addedEntities;
+    int _numEdits { 0 };
+
+    std::unique_ptr<EntityTreeHeadlessViewer> _viewer; // observers only
+    std::unordered_map<QUuid, std::pair<QString, quint64>> _expectedEdits;
+
+    QByteArray _messageData; // the reliable message being received, for the compression dictionary
+
+    ReceiveStats _receiveStats;
+};
+
+#endif // hifi_EntityBotSession_h
@@ -0,0 +1,317 @@
+//
+//  EntityServerBotsApp.cpp
+//  tools/entity-server-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityServerBotsApp.h"
+
+#include <algorithm>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <DomainHandler.h>
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <NodeType.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+namespace {
+    const int QUERIES_PER_SECOND = 10; // about what an interface sends while looking around
+    const int ADD_VIEWERS_INTERVAL_MSECS = 100;
+    const int ADD_ENTITIES_INTERVAL_MSECS = 100;
+    const int ENTITIES_PER_ADD_INTERVAL = 100; // as many as the server takes in without dropping edit packets
+
+    // the value below which the given fraction of the (sorted) samples fall, in msecs
+    float percentile(const std::vector<quint64>& sortedSamples, float fraction) {
+        if (sortedSamples.empty()) {
+            return 0.0f;
+        }
+        size_t index = std::min((size_t)(fraction * sortedSamples.size()), sortedSamples.size() - 1);
+        return (float)sortedSamples[index] / USECS_PER_MSEC;
+    }
+}
+
+EntityServerBotsApp::EntityServerBotsApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity entity server load generator");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "host[:port]",
+                                                 QString("127.0.0.1:%1").arg(DEFAULT_DOMAIN_SERVER_PORT));
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption localAddressOption("local-address", "address the domain-server and server reach the bots at",
+                                                "address", "127.0.0.1");
+    parser.addOption(localAddressOption);
+
+    const QCommandLineOption entitiesOption("entities", "number of entities to add to the scene", "count",
+                                            QString::number(_numEntities));
+    parser.addOption(entitiesOption);
+
+    const QCommandLineOption modelsOption("models", "fraction of the entities that are models", "ratio", "0.5");
+    parser.addOption(modelsOption);
+
+    const QCommandLineOption viewersOption("viewers", "number of bots viewing the scene", "count",
+                                           QString::number(_numViewers));
+    parser.addOption(viewersOption);
+
+    const QCommandLineOption observersOption("observers", "number of viewers measuring the edit latency", "count",
+                                             QString::number(_numObservers));
+    parser.addOption(observersOption);
+
+    const QCommandLineOption rampOption("ramp", "viewers connected per second", "count",
+                                        QString::number(_numViewersPerSecond));
+    parser.addOption(rampOption);
+
+    const QCommandLineOption editsOption("edits", "entity edits per second", "count", QString::number(_editsPerSecond));
+    parser.addOption(editsOption);
+
+    const QCommandLineOption radiusOption("radius", "radius of the scene", "meters", "100");
+    parser.addOption(radiusOption);
+
+    const QCommandLineOption lifetimeOption("lifetime", "seconds the added entities live for", "seconds", "3600");
+    parser.addOption(lifetimeOption);
+
+    const QCommandLineOption intervalOption("interval", "seconds between reports", "seconds",
+                                            QString::number(_reportIntervalSeconds));
+    parser.addOption(intervalOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run for, 0 to run until killed", "seconds", "0");
+    parser.addOption(durationOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    QString domainAddress = parser.value(domainAddressOption);
+    quint16 domainPort = DEFAULT_DOMAIN_SERVER_PORT;
+    int colonIndex = domainAddress.indexOf(':');
+    if (colonIndex > 0) {
+        domainPort = domainAddress.mid(colonIndex + 1).toUShort();
+        domainAddress = domainAddress.left(colonIndex);
+    }
+    _settings.domainSockAddr = HifiSockAddr(domainAddress, domainPort, true);
+    if (_settings.domainSockAddr.getAddress().isNull()) {
+        qCritical() << "Could not resolve domain-server address" << domainAddress;
+        parser.showHelp(1);
+    }
+
+    _settings.localAddress = QHostAddress(parser.value(localAddressOption));
+    _settings.sceneRadius = std::max(parser.value(radiusOption).toFloat(), 1.0f);
+    _settings.modelRatio = glm::clamp(parser.value(modelsOption).toFloat(), 0.0f, 1.0f);
+    _settings.lifetime = std::max(parser.value(lifetimeOption).toFloat(), 1.0f);
+
+    _numEntities = std::max(parser.value(entitiesOption).toInt(), 0);
+    _numViewers = std::max(parser.value(viewersOption).toInt(), 0);
+    _numObservers = glm::clamp(parser.value(observersOption).toInt(), 0, _numViewers);
+    _numViewersPerSecond = std::max(parser.value(rampOption).toInt(), 1);
+    _editsPerSecond = std::max(parser.value(editsOption).toInt(), 0);
+    _reportIntervalSeconds = std::max(parser.value(intervalOption).toInt(), 1);
+    _durationSeconds = std::max(parser.value(durationOption).toInt(), 0);
+
+    NodeType::init();
+
+    // the observers' trees read entities as an interface does, and that looks to the NodeList for our session
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>([&]{ return QString("Mozilla/5.0 (HighFidelityEntityServerBots)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+
+    qDebug() << "Adding" << _numEntities << "entities, then connecting" << _numViewers << "viewers (" << _numObservers
+        << "observers ) to" << _settings.domainSockAddr << "and making" << _editsPerSecond << "edits per second";
+
+    // the editor adds the scene before the viewers arrive, so that each of them is sent all of it
+    _editor.reset(new EntityBotSession(_settings, EntityBotSession::Role::Editor));
+    _editor->checkInWithDomain();
+    _viewers.reserve(_numViewers);
+
+    connect(&_addEntitiesTimer, &QTimer::timeout, this, &EntityServerBotsApp::addEntities);
+    _addEntitiesTimer.start(ADD_ENTITIES_INTERVAL_MSECS);
+
+    connect(&_addViewersTimer, &QTimer::timeout, this, &EntityServerBotsApp::addViewers);
+
+    connect(&_frameTimer, &QTimer::timeout, this, &EntityServerBotsApp::simulateFrame);
+    _frameTimer.start((int)MSECS_PER_SECOND / QUERIES_PER_SECOND);
+
+    connect(&_editTimer, &QTimer::timeout, this, &EntityServerBotsApp::editEntities);
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &EntityServerBotsApp::checkInWithDomain);
+    _checkInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    connect(&_reportTimer, &QTimer::timeout, this, &EntityServerBotsApp::report);
+    _reportTimer.start(_reportIntervalSeconds * (int)MSECS_PER_SECOND);
+
+    if (_durationSeconds > 0) {
+        QTimer::singleShot(_durationSeconds * (int)MSECS_PER_SECOND, this, [this] {
+            report();
+            quit();
+        });
+    }
+
+    _runTime.start();
+    _frameTime.start();
+}
+
+EntityServerBotsApp::~EntityServerBotsApp() {
+    _viewers.clear();
+    _editor.reset();
+}
+
+void EntityServerBotsApp::addEntities() {
+    if (!_editor->isConnectedToServer()) {
+        return;
+    }
+
+    // add the scene in batches, all at once would overflow the server's edit queue
+    int numToAdd = std::min(ENTITIES_PER_ADD_INTERVAL, _numEntities - _numEntitiesAdded);
+    _numEntitiesAdded += (int)_editor->addEntities(numToAdd).size();
+
+    if (_numEntitiesAdded >= _numEntities) {
+        _addEntitiesTimer.stop();
+        qDebug() << "Added" << _numEntitiesAdded << "entities";
+
+        _addViewersTimer.start(ADD_VIEWERS_INTERVAL_MSECS);
+        if (_editsPerSecond > 0) {
+            _editTimer.start((int)MSECS_PER_SECOND / QUERIES_PER_SECOND);
+        }
+    }
+}
+
+void EntityServerBotsApp::addViewers() {
+    // connect the crowd gradually, all at once would flood the domain-server with connect requests
+    int numToAdd = std::max(_numViewersPerSecond * ADD_VIEWERS_INTERVAL_MSECS / (int)MSECS_PER_SECOND, 1);
+    int end = std::min((int)_viewers.size() + numToAdd, _numViewers);
+
+    for (int i = (int)_viewers.size(); i < end; i++) {
+        auto role = i < _numObservers ? EntityBotSession::Role::Observer : EntityBotSession::Role::Viewer;
+        _viewers.emplace_back(new EntityBotSession(_settings, role));
+        _viewers.back()->checkInWithDomain();
+    }
+
+    if ((int)_viewers.size() == _numViewers) {
+        _addViewersTimer.stop();
+    }
+}
+
+void EntityServerBotsApp::simulateFrame() {
+    float deltaTime = (float)_frameTime.nsecsElapsed() / (USECS_PER_SECOND * NSECS_PER_USEC);
+    _frameTime.start();
+
+    for (auto& viewer : _viewers) {
+        viewer->simulate(deltaTime);
+        viewer->sendQuery();
+    }
+}
+
+void EntityServerBotsApp::editEntities() {
+    // spread the edits evenly over the second, rounding carried over to the next tick
+    _editsOwed += (float)_editsPerSecond / QUERIES_PER_SECOND;
+    int numEdits = (int)_editsOwed;
+    _editsOwed -= numEdits;
+
+    quint64 sentAt = usecTimestampNow();
+    auto edits = _editor->editEntities(numEdits);
+    _numEditsSent += (int)edits.size();
+
+    for (auto& viewer : _viewers) {
+        if (viewer->getRole() == EntityBotSession::Role::Observer && viewer->getTimeToFullScene() != 0) {
+            for (auto& edit : edits) {
+                viewer->expectEdit(edit.first, edit.second, sentAt);
+            }
+        }
+    }
+}
+
+void EntityServerBotsApp::checkInWithDomain() {
+    _editor->checkInWithDomain();
+    for (auto& viewer : _viewers) {
+        viewer->checkInWithDomain();
+    }
+}
+
+void EntityServerBotsApp::report() {
+    int numConnectedToDomain = 0;
+    int numConnectedToServer = 0;
+    QString denialReason = _editor->getDenialReason();
+
+    int numViewersReporting = 0;
+    EntityBotSession::ReceiveStats viewerStats;
+    std::vector<quint64> editLatencies;
+    std::vector<quint64> timesToFullScene;
+    for (auto& viewer : _viewers) {
+        numConnectedToDomain += viewer->isConnectedToDomain() ? 1 : 0;
+        numConnectedToServer += viewer->isConnectedToServer() ? 1 : 0;
+        if (denialReason.isEmpty()) {
+            denialReason = viewer->getDenialReason();
+        }
+        if (viewer->getTimeToFullScene() != 0) {
+            timesToFullScene.push_back(viewer->getTimeToFullScene());
+        }
+
+        auto stats = viewer->takeReceiveStats();
+        editLatencies.insert(editLatencies.end(), stats.editLatencies.begin(), stats.editLatencies.end());
+
+        // the observers' whole-scene queries cost the server more than a view does, they aren't counted as viewers
+        if (viewer->getRole() == EntityBotSession::Role::Viewer) {
+            numViewersReporting += stats.numPackets > 0 ? 1 : 0;
+            viewerStats.numPackets += stats.numPackets;
+            viewerStats.numBytes += stats.numBytes;
+            viewerStats.numScenes += stats.numScenes;
+            viewerStats.serverEncodeTime += stats.serverEncodeTime;
+        }
+    }
+
+    float elapsedSeconds = (float)_runTime.elapsed() / MSECS_PER_SECOND;
+    qDebug().noquote() << QString("[%1s] %2 entities added, %3 edits sent, %4 viewers, %5 in the domain, %6 with the server")
+        .arg(elapsedSeconds, 0, 'f', 1).arg(_numEntitiesAdded).arg(_numEditsSent).arg(_viewers.size())
+        .arg(numConnectedToDomain).arg(numConnectedToServer);
+    if (!denialReason.isEmpty()) {
+        qDebug().noquote() << "    domain-server denied a connection:" << denialReason;
+    }
+
+    // the stats are per viewer per second, averaged over the viewers that received anything
+    if (numViewersReporting > 0) {
+        float divisor = (float)(numViewersReporting * _reportIntervalSeconds);
+        float kbps = (float)viewerStats.numBytes * BITS_IN_BYTE / BYTES_PER_KILOBYTE / divisor;
+        float packetsPerSecond = (float)viewerStats.numPackets / divisor;
+        float scenesPerSecond = (float)viewerStats.numScenes / divisor;
+        float encodeMsecsPerSecond = (float)viewerStats.serverEncodeTime / USECS_PER_MSEC / divisor;
+        qDebug().noquote() << QString("    viewer: %1 kbps, %2 packets/s, %3 scenes/s, %4 ms/s of server encode time")
+            .arg(kbps, 0, 'f', 1).arg(packetsPerSecond, 0, 'f', 1).arg(scenesPerSecond, 0, 'f', 2)
+            .arg(encodeMsecsPerSecond, 0, 'f', 1);
+    }
+
+    if (!timesToFullScene.empty()) {
+        std::sort(timesToFullScene.begin(), timesToFullScene.end());
+        qDebug().noquote() << QString("    time to full scene: p50 %1 ms p95 %2 ms (%3 viewers)")
+            .arg(percentile(timesToFullScene, 0.50f), 0, 'f', 0).arg(percentile(timesToFullScene, 0.95f), 0, 'f', 0)
+            .arg(timesToFullScene.size());
+    }
+
+    if (!editLatencies.empty()) {
+        std::sort(editLatencies.begin(), editLatencies.end());
+        qDebug().noquote() << QString("    edit latency: p50 %1 ms p95 %2 ms p99 %3 ms (%4 samples)")
+            .arg(percentile(editLatencies, 0.50f), 0, 'f', 1).arg(percentile(editLatencies, 0.95f), 0, 'f', 1)
+            .arg(percentile(editLatencies, 0.99f), 0, 'f', 1).arg(editLatencies.size());
+    }
+}
@@ -0,0 +1,66 @@
+//
+//  EntityServerBotsApp.h
+//  tools/entity-server-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityServerBotsApp_h
+#define hifi_EntityServerBotsApp_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+
+#include "EntityBotSession.h"
+
+// Loads an entity server with a synthetic scene, a crowd of viewers and an editor changing the scene, and reports
+// what it costs the server to send the viewers their views (its encode time, bytes and packets per viewer, and how
+// long a viewer waits for its first full scene) and how long the edits take to reach a few observer bots.
+class EntityServerBotsApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    EntityServerBotsApp(int argc, char* argv[]);
+    ~EntityServerBotsApp();
+
+private slots:
+    void addEntities();
+    void addViewers();
+    void simulateFrame();
+    void editEntities();
+    void checkInWithDomain();
+    void report();
+
+private:
+    EntityBotSession::Settings _settings;
+    int _numEntities { 10000 };
+    int _numViewers { 50 };
+    int _numObservers { 2 };
+    int _numViewersPerSecond { 20 };
+    int _editsPerSecond { 20 };
+    int _reportIntervalSeconds { 5 };
+    int _durationSeconds { 0 };
+
+    std::unique_ptr<EntityBotSession> _editor;
+    std::vector<std::unique_ptr<EntityBotSession>> _viewers; // the observers first
+    int _numEntitiesAdded { 0 };
+
+    QTimer _addEntitiesTimer;
+    QTimer _addViewersTimer;
+    QTimer _frameTimer;
+    QTimer _editTimer;
+    QTimer _checkInTimer;
+    QTimer _reportTimer;
+    QElapsedTimer _runTime;
+    QElapsedTimer _frameTime;
+    float _editsOwed { 0.0f };
+    int _numEditsSent { 0 };
+};
+
+#endif // hifi_EntityServerBotsApp_h
@@ -0,0 +1,18 @@
+//
+//  main.cpp
+//  tools/entity-server-bots/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QtCore/QCoreApplication>
+
+#include "EntityServerBotsApp.h"
+
+int main(int argc, char* argv[]) {
+    EntityServerBotsApp app(argc, argv);
+    return app.exec();
+}
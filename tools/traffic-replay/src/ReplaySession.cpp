@@ -0,0 +1,50 @@
+//
+//  ReplaySession.cpp
+//  tools/traffic-replay/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReplaySession.h"
+
+ReplaySession::ReplaySession(const Settings& settings) :
+    DomainSession(settings.domainSockAddr, settings.localAddress, settings.targetType)
+{
+}
+
+ReplaySession::~ReplaySession() {
+}
+
+bool ReplaySession::sendRecord(const TrafficCaptureRecord& record) {
+    if (!isConnectedToTarget() || record.payload.size() > NLPacket::maxPayloadSize(record.type)) {
+        return false;
+    }
+
+    // the payload goes out as its client sent it, under this session's ID and with the version it was captured at
+    auto packet = NLPacket::create(record.type, record.payload.size(), false, false, record.version);
+    packet->write(record.payload);
+    sendPacketToTarget(std::move(packet));
+    return true;
+}
+
+void ReplaySession::processPacket(NLPacket& packet) {
+    if (packet.getSourceID() == getTargetUUID()) {
+        _receiveStats.numPackets++;
+        _receiveStats.numBytes += packet.getDataSize();
+    }
+}
+
+void ReplaySession::processMessagePacket(std::unique_ptr<udt::Packet> packet) {
+    // the target's reliable messages only count towards what it sends, nothing here reads them
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+    processPacket(*nlPacket);
+}
+
+ReplaySession::ReceiveStats ReplaySession::takeReceiveStats() {
+    ReceiveStats stats;
+    std::swap(stats, _receiveStats);
+    return stats;
+}
@@ -0,0 +1,58 @@
+//
+//  ReplaySession.h
+//  tools/traffic-replay/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReplaySession_h
+#define hifi_ReplaySession_h
+
+#include <memory>
+
+#include <QtCore/QObject>
+#include <QtCore/QUuid>
+
+#include <DomainSession.h>
+#include <HifiSockAddr.h>
+#include <NLPacket.h>
+#include <NodeType.h>
+#include <TrafficCapture.h>
+
+// Stands in for one of the clients of a capture, connected as a DomainSession to the assignment being replayed into.
+//   It sends the messages its client sent, as they come due, and counts what the assignment sends back to it.
+class ReplaySession : public DomainSession {
+    Q_OBJECT
+public:
+    struct Settings {
+        HifiSockAddr domainSockAddr;
+        QHostAddress localAddress;
+        NodeType_t targetType;
+    };
+
+    struct ReceiveStats {
+        int numPackets { 0 };
+        qint64 numBytes { 0 };
+    };
+
+    ReplaySession(const Settings& settings);
+    ~ReplaySession();
+
+    // false if the session isn't connected to the target yet, or the message doesn't fit in one packet
+    bool sendRecord(const TrafficCaptureRecord& record);
+
+    // what the target sent this session since the last call
+    ReceiveStats takeReceiveStats();
+
+protected:
+    void processPacket(NLPacket& packet) override;
+    void processMessagePacket(std::unique_ptr<udt::Packet> packet) override;
+
+private:
+    ReceiveStats _receiveStats;
+};
+
+#endif // hifi_ReplaySession_h
@@ -0,0 +1,366 @@
+//
+//  TrafficReplayApp.cpp
+//  tools/traffic-replay/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TrafficReplayApp.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonDocument>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <DomainHandler.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+namespace {
+    const int SESSIONS_PER_SECOND = 50;
+    const int ADD_SESSIONS_INTERVAL_MSECS = 100;
+    const int CONNECT_CHECK_INTERVAL_MSECS = 100;
+    const int REPLAY_INTERVAL_MSECS = 1;
+
+    bool isReplayable(const TrafficCaptureRecord& record) {
+        // the sessions answer the pings themselves, and only what the clients sent is replayed
+        return record.sourceType == NodeType::Agent && !record.sourceID.isNull()
+            && record.type != PacketType::Ping && record.type != PacketType::PingReply
+            && !NON_SOURCED_PACKETS.contains(record.type)
+            && record.version == versionForPacketType(record.type);
+    }
+
+    float kbps(qint64 bytes, float seconds) {
+        return seconds > 0.0f ? (float)bytes * BITS_IN_BYTE / BYTES_PER_KILOBYTE / seconds : 0.0f;
+    }
+}
+
+TrafficReplayApp::TrafficReplayApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity traffic capture replayer");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    parser.addPositionalArgument("capture", "the ." + TRAFFIC_CAPTURE_FILE_EXTENSION + " file an assignment wrote with "
+                                 + TRAFFIC_CAPTURE_DIRECTORY_ENV + " set");
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "host[:port]",
+                                                 QString("127.0.0.1:%1").arg(DEFAULT_DOMAIN_SERVER_PORT));
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption domainHTTPPortOption("http-port", "domain-server HTTP port, for the assignment's stats",
+                                                  "port", QString::number(DOMAIN_SERVER_HTTP_PORT));
+    parser.addOption(domainHTTPPortOption);
+
+    const QCommandLineOption localAddressOption("local-address",
+                                                "address the domain-server and assignment reach the sessions at",
+                                                "address", "127.0.0.1");
+    parser.addOption(localAddressOption);
+
+    const QCommandLineOption speedOption("speed", "how many times faster than it was captured to replay", "factor",
+                                         "1");
+    parser.addOption(speedOption);
+
+    const QCommandLineOption connectTimeoutOption("connect-timeout",
+                                                  "seconds to wait for the sessions to connect before replaying",
+                                                  "seconds", QString::number(_connectTimeoutSeconds));
+    parser.addOption(connectTimeoutOption);
+
+    const QCommandLineOption intervalOption("interval", "seconds between reports", "seconds",
+                                            QString::number(_reportIntervalSeconds));
+    parser.addOption(intervalOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption) || parser.positionalArguments().size() != 1) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    QString domainAddress = parser.value(domainAddressOption);
+    quint16 domainPort = DEFAULT_DOMAIN_SERVER_PORT;
+    int colonIndex = domainAddress.indexOf(':');
+    if (colonIndex > 0) {
+        domainPort = domainAddress.mid(colonIndex + 1).toUShort();
+        domainAddress = domainAddress.left(colonIndex);
+    }
+    _settings.domainSockAddr = HifiSockAddr(domainAddress, domainPort, true);
+    if (_settings.domainSockAddr.getAddress().isNull()) {
+        qCritical() << "Could not resolve domain-server address" << domainAddress;
+        parser.showHelp(1);
+    }
+    _domainHTTPPort = parser.value(domainHTTPPortOption).toUShort();
+    _settings.localAddress = QHostAddress(parser.value(localAddressOption));
+
+    _speed = std::max(parser.value(speedOption).toFloat(), 0.01f);
+    _connectTimeoutSeconds = std::max(parser.value(connectTimeoutOption).toInt(), 1);
+    _reportIntervalSeconds = std::max(parser.value(intervalOption).toInt(), 1);
+
+    NodeType::init();
+
+    _capturePath = parser.positionalArguments().first();
+    if (!scanCapture(_capturePath)) {
+        parser.showHelp(1);
+    }
+    _settings.targetType = _reader.getOwnerType();
+
+    qDebug().noquote() << QString("Replaying %1 (%2 s of traffic from %3 clients) into the %4 of %5 at %6x")
+        .arg(_capturePath).arg((float)_captureDurationUsecs / USECS_PER_SECOND, 0, 'f', 1).arg(_clientIDs.size())
+        .arg(NodeType::getNodeTypeName(_settings.targetType)).arg(_settings.domainSockAddr.toString()).arg(_speed);
+
+    connect(&_addSessionsTimer, &QTimer::timeout, this, &TrafficReplayApp::addSessions);
+    _addSessionsTimer.start(ADD_SESSIONS_INTERVAL_MSECS);
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &TrafficReplayApp::checkInWithDomain);
+    _checkInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    connect(&_connectTimer, &QTimer::timeout, this, &TrafficReplayApp::startReplayWhenConnected);
+    _connectTimer.start(CONNECT_CHECK_INTERVAL_MSECS);
+    _connectTime.start();
+
+    connect(&_replayTimer, &QTimer::timeout, this, &TrafficReplayApp::replayDueRecords);
+    _replayTimer.setTimerType(Qt::PreciseTimer);
+
+    connect(&_reportTimer, &QTimer::timeout, this, &TrafficReplayApp::report);
+    _reportTimer.start(_reportIntervalSeconds * (int)MSECS_PER_SECOND);
+    _intervalTime.start();
+}
+
+TrafficReplayApp::~TrafficReplayApp() {
+    _sessions.clear();
+}
+
+bool TrafficReplayApp::scanCapture(const QString& path) {
+    // a first pass for the clients to stand in for, so that they are all connected before their messages come due
+    TrafficCaptureReader scanner;
+    if (!scanner.open(path)) {
+        return false;
+    }
+
+    std::unordered_set<QUuid> clientIDs;
+    TrafficCaptureRecord record;
+    bool isFirst = true;
+    while (scanner.readNext(record)) {
+        if (isFirst) {
+            _firstRecordUsecs = record.usecsSinceStart;
+            isFirst = false;
+        }
+        _captureDurationUsecs = record.usecsSinceStart - _firstRecordUsecs;
+
+        if (isReplayable(record) && clientIDs.insert(record.sourceID).second) {
+            _clientIDs.push_back(record.sourceID);
+        }
+    }
+
+    if (_clientIDs.empty()) {
+        qCritical() << path << "has nothing from a client to replay";
+        return false;
+    }
+
+    if (!_reader.open(path)) {
+        return false;
+    }
+    _hasNextRecord = _reader.readNext(_nextRecord);
+    return true;
+}
+
+void TrafficReplayApp::addSessions() {
+    // connect the clients gradually, all at once would flood the domain-server with connect requests
+    int numToAdd = std::max(SESSIONS_PER_SECOND * ADD_SESSIONS_INTERVAL_MSECS / (int)MSECS_PER_SECOND, 1);
+    size_t end = std::min(_sessions.size() + numToAdd, _clientIDs.size());
+
+    for (size_t i = _sessions.size(); i < end; i++) {
+        auto& session = _sessions[_clientIDs[i]];
+        session.reset(new ReplaySession(_settings));
+        session->checkInWithDomain();
+    }
+
+    if (_sessions.size() == _clientIDs.size()) {
+        _addSessionsTimer.stop();
+    }
+}
+
+void TrafficReplayApp::checkInWithDomain() {
+    for (auto& session : _sessions) {
+        session.second->checkInWithDomain();
+    }
+}
+
+void TrafficReplayApp::startReplayWhenConnected() {
+    int numConnected = 0;
+    for (auto& session : _sessions) {
+        numConnected += session.second->isConnectedToTarget() ? 1 : 0;
+    }
+
+    bool isTimedOut = _connectTime.elapsed() > _connectTimeoutSeconds * (int)MSECS_PER_SECOND;
+    if (numConnected < (int)_clientIDs.size() && !isTimedOut) {
+        return;
+    }
+
+    if (numConnected < (int)_clientIDs.size()) {
+        qWarning() << "Only" << numConnected << "of" << _clientIDs.size()
+            << "sessions connected in time, the messages of the others are dropped";
+    }
+
+    qDebug() << "Starting the replay";
+    _connectTimer.stop();
+    _replayTime.start();
+    _replayTimer.start(REPLAY_INTERVAL_MSECS);
+}
+
+void TrafficReplayApp::replayDueRecords() {
+    quint64 elapsedUsecs = (quint64)_replayTime.nsecsElapsed() / NSECS_PER_USEC;
+
+    while (_hasNextRecord) {
+        quint64 dueUsecs = (quint64)((float)(_nextRecord.usecsSinceStart - _firstRecordUsecs) / _speed);
+        if (dueUsecs > elapsedUsecs) {
+            break;
+        }
+
+        if (isReplayable(_nextRecord)) {
+            auto it = _sessions.find(_nextRecord.sourceID);
+            if (it != _sessions.end() && it->second->sendRecord(_nextRecord)) {
+                _intervalStats.numMessages++;
+                _intervalStats.numBytes += _nextRecord.payload.size();
+                _intervalStats.maxLagUsecs = std::max(_intervalStats.maxLagUsecs, elapsedUsecs - dueUsecs);
+            } else {
+                _intervalStats.numDropped++;
+            }
+        } else {
+            _intervalStats.numSkipped++;
+        }
+
+        _hasNextRecord = _reader.readNext(_nextRecord);
+    }
+
+    if (!_hasNextRecord) {
+        finishReplay();
+    }
+}
+
+void TrafficReplayApp::finishReplay() {
+    _replayTimer.stop();
+    qDebug() << "Replayed the whole capture in" << (float)_replayTime.elapsed() / MSECS_PER_SECOND << "s";
+
+    // one more report, for the assignment's stats to catch up with the end of the replay
+    QTimer::singleShot(_reportIntervalSeconds * (int)MSECS_PER_SECOND, this, [this] {
+        report();
+        qDebug().noquote() << QString("Total: %1 messages, %2 KB sent, %3 skipped, %4 dropped, max lag %5 ms")
+            .arg(_totalStats.numMessages).arg(_totalStats.numBytes / BYTES_PER_KILOBYTE)
+            .arg(_totalStats.numSkipped).arg(_totalStats.numDropped)
+            .arg((float)_totalStats.maxLagUsecs / USECS_PER_MSEC, 0, 'f', 1);
+        quit();
+    });
+}
+
+void TrafficReplayApp::requestTargetStats() {
+    QUuid targetUUID;
+    for (auto& session : _sessions) {
+        if (!session.second->getTargetUUID().isNull()) {
+            targetUUID = session.second->getTargetUUID();
+            break;
+        }
+    }
+    if (targetUUID.isNull()) {
+        return;
+    }
+
+    // the domain-server keeps the stats each assignment sends it, with the percentiles of its frame times
+    QUrl statsURL;
+    statsURL.setScheme("http");
+    statsURL.setHost(_settings.domainSockAddr.getAddress().toString());
+    statsURL.setPort(_domainHTTPPort);
+    statsURL.setPath(QString("/nodes/%1.json").arg(uuidStringWithoutCurlyBraces(targetUUID)));
+
+    QNetworkReply* reply = _networkAccessManager.get(QNetworkRequest(statsURL));
+    connect(reply, &QNetworkReply::finished, this, [this, reply] {
+        if (reply->error() == QNetworkReply::NoError) {
+            _targetStats = QJsonDocument::fromJson(reply->readAll()).object();
+        } else {
+            _targetStats = QJsonObject();
+        }
+        reply->deleteLater();
+    });
+}
+
+void TrafficReplayApp::report() {
+    float intervalSeconds = (float)_intervalTime.restart() / MSECS_PER_SECOND;
+
+    int numConnectedToDomain = 0;
+    int numConnectedToTarget = 0;
+    QString denialReason;
+    ReplaySession::ReceiveStats receiveStats;
+    for (auto& session : _sessions) {
+        numConnectedToDomain += session.second->isConnectedToDomain() ? 1 : 0;
+        numConnectedToTarget += session.second->isConnectedToTarget() ? 1 : 0;
+        if (denialReason.isEmpty()) {
+            denialReason = session.second->getDenialReason();
+        }
+
+        auto stats = session.second->takeReceiveStats();
+        receiveStats.numPackets += stats.numPackets;
+        receiveStats.numBytes += stats.numBytes;
+    }
+
+    auto& stats = _intervalStats;
+    _totalStats.numMessages += stats.numMessages;
+    _totalStats.numBytes += stats.numBytes;
+    _totalStats.numSkipped += stats.numSkipped;
+    _totalStats.numDropped += stats.numDropped;
+    _totalStats.maxLagUsecs = std::max(_totalStats.maxLagUsecs, stats.maxLagUsecs);
+
+    float progress = 1.0f;
+    if (_hasNextRecord && _captureDurationUsecs > 0) {
+        progress = (float)(_nextRecord.usecsSinceStart - _firstRecordUsecs) / _captureDurationUsecs;
+    }
+
+    qDebug().noquote() << QString("[%1%] %2 sessions, %3 in the domain, %4 with the %5")
+        .arg(_replayTime.isValid() ? progress * 100.0f : 0.0f, 0, 'f', 0).arg(_sessions.size())
+        .arg(numConnectedToDomain).arg(numConnectedToTarget).arg(NodeType::getNodeTypeName(_settings.targetType));
+    if (!denialReason.isEmpty()) {
+        qDebug().noquote() << "    domain-server denied a connection:" << denialReason;
+    }
+
+    if (_replayTime.isValid()) {
+        qDebug().noquote() << QString("    replayed: %1 messages/s, %2 kbps, %3 skipped, %4 dropped, max lag %5 ms")
+            .arg((float)stats.numMessages / intervalSeconds, 0, 'f', 0)
+            .arg(kbps(stats.numBytes, intervalSeconds), 0, 'f', 1)
+            .arg(stats.numSkipped).arg(stats.numDropped).arg((float)stats.maxLagUsecs / USECS_PER_MSEC, 0, 'f', 1);
+
+        float receivedKbps = kbps(receiveStats.numBytes, intervalSeconds);
+        float perSessionKbps = numConnectedToTarget > 0 ? receivedKbps / numConnectedToTarget : 0.0f;
+        qDebug().noquote() << QString("    received: %1 packets/s, %2 kbps (%3 kbps per session)")
+            .arg((float)receiveStats.numPackets / intervalSeconds, 0, 'f', 0)
+            .arg(receivedKbps, 0, 'f', 1).arg(perSessionKbps, 0, 'f', 1);
+    }
+    _intervalStats = ReplayStats();
+
+    if (_targetStats.isEmpty()) {
+        qDebug().noquote() << "    target: stats unavailable";
+    } else {
+        auto frameUsecs = _targetStats["frame_stats"].toObject()["frame_usecs"].toObject();
+        auto ioStats = _targetStats["io_stats"].toObject();
+        qDebug().noquote() << QString("    target: frame p50 %1 us p99 %2 us max %3 us, %4 kbps out")
+            .arg(frameUsecs["p50"].toDouble(), 0, 'f', 0).arg(frameUsecs["p99"].toDouble(), 0, 'f', 0)
+            .arg(frameUsecs["max"].toDouble(), 0, 'f', 0)
+            .arg(ioStats["outbound_bytes_per_s"].toDouble() * BITS_IN_BYTE / BYTES_PER_KILOBYTE, 0, 'f', 1);
+    }
+
+    // ask for the next report's stats now, they are sent to the domain-server about once a second
+    requestTargetStats();
+}
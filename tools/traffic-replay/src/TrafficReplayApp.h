@@ -0,0 +1,92 @@
+//
+//  TrafficReplayApp.h
+//  tools/traffic-replay/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TrafficReplayApp_h
+#define hifi_TrafficReplayApp_h
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkAccessManager>
+
+#include <TrafficCapture.h>
+#include <UUIDHasher.h>
+
+#include "ReplaySession.h"
+
+// Replays a capture of an assignment's inbound traffic (see TrafficCaptureWriter) into a fresh assignment of the
+// same type, at the speed it was captured at or faster, and reports what it costs the assignment (its frame time,
+// from the domain-server's stats for it) and what the assignment sends back (the output bandwidth to the clients).
+//   Each client of the capture is stood in for by a ReplaySession, which sends the messages that client sent;
+//   the messages of the other nodes (the domain-server, the other assignments) aren't replayed.
+class TrafficReplayApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    TrafficReplayApp(int argc, char* argv[]);
+    ~TrafficReplayApp();
+
+private slots:
+    void addSessions();
+    void checkInWithDomain();
+    void startReplayWhenConnected();
+    void replayDueRecords();
+    void report();
+
+private:
+    bool scanCapture(const QString& path);
+    void finishReplay();
+    void requestTargetStats();
+
+    QString _capturePath;
+    TrafficCaptureReader _reader;
+    ReplaySession::Settings _settings;
+    float _speed { 1.0f };
+    int _reportIntervalSeconds { 5 };
+    int _connectTimeoutSeconds { 30 };
+    quint16 _domainHTTPPort { 0 };
+
+    // the clients of the capture, and the session standing in for each
+    std::vector<QUuid> _clientIDs;
+    std::unordered_map<QUuid, std::unique_ptr<ReplaySession>> _sessions;
+    quint64 _captureDurationUsecs { 0 };
+
+    TrafficCaptureRecord _nextRecord;
+    bool _hasNextRecord { false };
+    quint64 _firstRecordUsecs { 0 };
+
+    struct ReplayStats {
+        int numMessages { 0 };
+        qint64 numBytes { 0 };
+        int numSkipped { 0 }; // from the other nodes, or too large or too old a version to send
+        int numDropped { 0 }; // for a session that isn't connected to the target
+        quint64 maxLagUsecs { 0 }; // how far behind its schedule a message was sent
+    };
+    ReplayStats _intervalStats;
+    ReplayStats _totalStats;
+
+    QTimer _addSessionsTimer;
+    QTimer _checkInTimer;
+    QTimer _connectTimer;
+    QTimer _replayTimer;
+    QTimer _reportTimer;
+    QElapsedTimer _connectTime;
+    QElapsedTimer _replayTime;
+    QElapsedTimer _intervalTime;
+
+    QNetworkAccessManager _networkAccessManager;
+    QJsonObject _targetStats;
+};
+
+#endif // hifi_TrafficReplayApp_h